@@ -148,6 +148,10 @@ if (PKG_CONFIG_FOUND)
   if (Simbody_FOUND)
     message (STATUS "Looking for Simbody - found")
     set (HAVE_SIMBODY TRUE)
+    # GeneralForceSubsystem evaluates forces in parallel since 3.6
+    if (NOT Simbody_VERSION VERSION_LESS 3.6)
+      add_definitions( -DLIBSIMBODY_VERSION_GT_35 )
+    endif()
   else()
     message (STATUS "Looking for Simbody - not found")
     BUILD_WARNING ("Simbody not found, for simbody physics engine option, please install libsimbody-dev.")
@@ -558,6 +562,19 @@ if (PKG_CONFIG_FOUND)
     BUILD_WARNING ("GNU Triangulation Surface library not found - Gazebo will not have CSG support.")
   endif ()
 
+  ########################################
+  # Find EGL, to render without an X server
+  if (NOT APPLE AND NOT WIN32)
+    pkg_check_modules(EGL egl)
+    if (EGL_FOUND)
+      message (STATUS "Looking for EGL - found")
+      set (HAVE_EGL TRUE)
+    else ()
+      set (HAVE_EGL FALSE)
+      BUILD_WARNING ("EGL not found - Gazebo will need an X server to render.")
+    endif ()
+  endif ()
+
   #################################################
   # Find bullet
   # First and preferred option is to look for bullet standard pkgconfig,
@@ -581,6 +598,11 @@ if (PKG_CONFIG_FOUND)
     add_definitions( -DLIBBULLET_VERSION_GT_282 )
   endif()
 
+  # btDiscreteDynamicsWorldMt and its solvers take their final form in 2.88
+  if (BULLET_VERSION VERSION_GREATER 2.87)
+    add_definitions( -DLIBBULLET_VERSION_GT_287 )
+  endif()
+
   ########################################
   # Find libusb
   pkg_check_modules(libusb-1.0 libusb-1.0)
@@ -637,6 +659,13 @@ if (NOT Boost_FOUND)
   BUILD_ERROR ("Boost not found. Please install thread system filesystem program_options regex iostreams date_time boost version ${MIN_BOOST_VERSION} or higher.")
 endif()
 
+########################################
+# Find zlib, used to compress the messages sent to remote subscribers
+find_package(ZLIB)
+if (NOT ZLIB_FOUND)
+  BUILD_ERROR ("Missing: zlib. Required for transport compression.")
+endif()
+
 ########################################
 # Find libdl
 find_path(libdl_include_dir dlfcn.h /usr/include /usr/local/include)
@@ -49,7 +49,9 @@ enum {
   dContactApprox1_2  = 0x2000,
   dContactApprox1  = 0x3000,
   dContactApprox3  = 0x4000,
-  dContactEM            = 0x8000
+  dContactEM            = 0x8000,
+  /* a negative depth is a gap the bodies may close in one step */
+  dContactSpeculative   = 0x10000
 };
 
 
@@ -561,6 +561,38 @@ ODE_API dReal *dWorldGetQuickStepRMSConstraintResidual (dWorldID);
  */
 ODE_API int dWorldGetQuickStepNumContacts (dWorldID);
 
+/**
+ * @brief Convergence of the quickstep solve of one island.
+ * @ingroup world
+ */
+typedef struct dIslandStatistics {
+  int bodies;       /* number of bodies */
+  int joints;       /* number of joints with constraint rows */
+  int contacts;     /* number of contact joints */
+  int rows;         /* number of constraint rows */
+  int iterations;   /* PGS iterations done, including precon and friction */
+  dReal residual;   /* RMS of the constraint residuals at the end */
+} dIslandStatistics;
+
+/**
+ * @brief Get the number of islands solved by the last quickstep.
+ * @ingroup world
+ * @returns the number of islands, 0 after a dWorldStep.
+ */
+ODE_API int dWorldGetIslandCount (dWorldID);
+
+/**
+ * @brief Get the convergence of an island solved by the last quickstep.
+ * Islands are in the order of the body list, whether or not they were
+ * solved in parallel.
+ * @ingroup world
+ * @param island index of the island, see dWorldGetIslandCount
+ * @param stats filled with the statistics of the island
+ * @returns 1 on success, 0 if the index is out of range.
+ */
+ODE_API int dWorldGetIslandStatistics (dWorldID, int island,
+  dIslandStatistics *stats);
+
 /* PGS experimental parameters */
 
 /**
@@ -594,6 +626,13 @@ ODE_API bool dWorldGetQuickStepThreadPositionCorrection (dWorldID);
  */
 ODE_API bool dWorldGetQuickStepExperimentalRowReordering (dWorldID);
 
+/**
+ * @brief Get option to make threaded quickstep results deterministic.
+ * see dWorldSetQuickStepDeterministicThreads for details.
+ * @ingroup world
+ */
+ODE_API bool dWorldGetQuickStepDeterministicThreads (dWorldID);
+
 /**
  * @brief Get warm start scaling coefficient
  * @ingroup world
@@ -661,6 +700,25 @@ ODE_API void dWorldSetQuickStepThreadPositionCorrection (dWorldID, bool thread);
  */
 ODE_API void dWorldSetQuickStepExperimentalRowReordering (dWorldID, bool order);
 
+/**
+ * @brief Make the results of threaded quickstep independent of thread
+ * scheduling.
+ *
+ * Islands are always built by walking the body list in order and never
+ * share bodies or joints, but by default every island and the position
+ * correction thread report their convergence statistics to the same world
+ * parameters, and the PGS iterations stop as soon as that shared residual
+ * falls below the tolerance. The result then depends on which thread wrote
+ * last. In deterministic mode every island solves with its own copy of the
+ * parameters, the iterations stop on the residual of their own rows, and
+ * the statistics of the last island in body order are reported. With
+ * position correction inline, the result is bit for bit identical to
+ * solving the islands serially.
+ * @ingroup world
+ * @param deterministic set to true to turn on deterministic threading
+ */
+ODE_API void dWorldSetQuickStepDeterministicThreads (dWorldID, bool deterministic);
+
 /**
  * @brief Set warm start scaling coefficient
  * @ingroup world
@@ -2131,6 +2189,27 @@ ODE_API void dJointSetFeedback (dJointID, dJointFeedback *);
  */
 ODE_API dJointFeedback *dJointGetFeedback (dJointID);
 
+/**
+ * @brief Get the constraint impulses of the rows of the joint, as solved by
+ * the last quickstep. Quickstep starts from them when the warm start factor
+ * is positive.
+ * @ingroup joints
+ * @param lambda Receives the 6 row impulses.
+ * @param lambda_erp Receives the 6 row impulses of the error reduction
+ * pass.
+ */
+ODE_API void dJointGetLambda (dJointID, dReal *lambda, dReal *lambda_erp);
+
+/**
+ * @brief Set the constraint impulses quickstep starts from, for instance
+ * with the impulses of a contact joint of the previous step.
+ * @ingroup joints
+ * @param lambda The 6 row impulses.
+ * @param lambda_erp The 6 row impulses of the error reduction pass.
+ */
+ODE_API void dJointSetLambda (dJointID, const dReal *lambda,
+    const dReal *lambda_erp);
+
 /**
  * @brief Set the joint anchor point.
  * @ingroup joints
@@ -146,6 +146,10 @@ dxJointContact::getInfo2( dxJoint::Info2 *info )
       min_min_depth = world->contactp.min_depth;
       depth = contact.geom.depth - min_min_depth;
     }
+    // a speculative contact lets the bodies close the gap in one step,
+    // but not more
+    const bool speculative = (contact.surface.mode & dContactSpeculative) &&
+        contact.geom.depth < 0;
     if ( depth < 0 ) depth = 0;
 
     if ( contact.surface.mode & dContactSoftCFM )
@@ -236,8 +240,15 @@ dxJointContact::getInfo2( dxJoint::Info2 *info )
 
     info->c_v_max[0] = maxvel;
 
+    if ( speculative )
+    {
+        info->c[0] = contact.geom.depth * info->fps + motionN;
+        // the gap is not a correcting velocity, it must not be capped
+        info->c_v_max[0] = dInfinity;
+    }
+
     // deal with bounce
-    if ( contact.surface.mode & dContactBounce )
+    if ( !speculative && ( contact.surface.mode & dContactBounce ) )
     {
         // calculate outgoing velocity (-ve for incoming contact)
         dReal outgoing = dCalcVectorDot3( info->J1l, node[0].body->lvel )
@@ -116,11 +116,13 @@ struct dxQuickStepParameters {
   // rms_constraint_residual[3]: total (sum of previous 3)
   dReal rms_constraint_residual[4];     // all constraint errors
   int num_contacts;           // for monitoring number of contacts
+  int iterations_used;        // PGS iterations done by the last solve
   bool dynamic_inertia_reduction;  // turn on/off quickstep inertia reduction.
   dReal smooth_contacts;  // control quickstep smoothing for contact solution.
   dReal contact_sor_scale;  // sor scaling factor for contacts only
   bool thread_position_correction;  // threaded position correction computations
   bool row_reorder1;  // control quickstep row reordering
+  bool deterministic_threads;  // make threaded results independent of scheduling
   dReal warm_start;  // warm start factor, 0: no warm start, 1: full warm start
   int friction_iterations;  // extra quickstep iterations friction.
   Friction_Model friction_model;  // friction model, enum type Friction_Model
@@ -204,6 +206,13 @@ struct dxWorld : public dBase {
   dReal max_angular_speed;      // limit the angular velocity to this magnitude
   boost::threadpool::pool *threadpool;
   boost::threadpool::pool *row_threadpool;
+  // with deterministic_threads, body list of the island whose quickstep
+  // statistics are stored in qs, see dxQuickStepper
+  dxBody *const *qs_stats_island;
+  boost::mutex qs_stats_mutex;
+  // convergence of each island solved by the last quickstep, with the body
+  // list of the island to sort them, guarded by qs_stats_mutex
+  std::vector<std::pair<dxBody *const *, dIslandStatistics> > island_stats;
 };
 
 
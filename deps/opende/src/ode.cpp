@@ -1542,6 +1542,21 @@ dJointFeedback *dJointGetFeedback (dxJoint *joint)
   return joint->feedback;
 }
 
+void dJointGetLambda (dxJoint *joint, dReal *lambda, dReal *lambda_erp)
+{
+  dAASSERT (joint && lambda && lambda_erp);
+  memcpy (lambda, joint->lambda, 6 * sizeof(dReal));
+  memcpy (lambda_erp, joint->lambda_erp, 6 * sizeof(dReal));
+}
+
+void dJointSetLambda (dxJoint *joint, const dReal *lambda,
+    const dReal *lambda_erp)
+{
+  dAASSERT (joint && lambda && lambda_erp);
+  memcpy (joint->lambda, lambda, 6 * sizeof(dReal));
+  memcpy (joint->lambda_erp, lambda_erp, 6 * sizeof(dReal));
+}
+
 
 
 dJointID dConnectingJoint (dBodyID in_b1, dBodyID in_b2)
@@ -1662,11 +1677,13 @@ dxWorld * dWorldCreate()
   w->qs.rms_constraint_residual[2] = 0;
   w->qs.rms_constraint_residual[3] = 0;
   w->qs.num_contacts = 0;
+  w->qs.iterations_used = 0;
   w->qs.dynamic_inertia_reduction = true;
   w->qs.smooth_contacts = 0.01;
   w->qs.contact_sor_scale = 0.25;
   w->qs.thread_position_correction = false;
   w->qs.row_reorder1 = true;
+  w->qs.deterministic_threads = false;
   w->qs.warm_start = 0.5;
   w->qs.friction_iterations = 10;
   w->qs.friction_model = pyramid_friction;
@@ -1683,6 +1700,7 @@ dxWorld * dWorldCreate()
 
   w->threadpool = NULL; // new boost::threadpool::pool(0);
   w->row_threadpool = NULL; // new boost::threadpool::pool(0);
+  w->qs_stats_island = NULL;
 
   return w;
 }
@@ -2282,6 +2300,22 @@ int dWorldGetQuickStepNumContacts (dWorldID w)
   return w->qs.num_contacts;
 }
 
+int dWorldGetIslandCount (dWorldID w)
+{
+  dAASSERT(w);
+  return (int)w->island_stats.size();
+}
+
+int dWorldGetIslandStatistics (dWorldID w, int island,
+  dIslandStatistics *stats)
+{
+  dAASSERT(w && stats);
+  if (island < 0 || island >= (int)w->island_stats.size())
+    return 0;
+  *stats = w->island_stats[island].second;
+  return 1;
+}
+
 /* experimental PGS */
 bool dWorldGetQuickStepInertiaRatioReduction (dWorldID w)
 {
@@ -2313,6 +2347,12 @@ bool  dWorldGetQuickStepExperimentalRowReordering (dWorldID w)
   return w->qs.row_reorder1;
 }
 
+bool  dWorldGetQuickStepDeterministicThreads (dWorldID w)
+{
+  dAASSERT(w);
+  return w->qs.deterministic_threads;
+}
+
 dReal  dWorldGetQuickStepWarmStartFactor (dWorldID w)
 {
   dAASSERT(w);
@@ -2367,6 +2407,12 @@ void dWorldSetQuickStepExperimentalRowReordering (dWorldID w, bool order)
   w->qs.row_reorder1 = order;
 }
 
+void dWorldSetQuickStepDeterministicThreads (dWorldID w, bool deterministic)
+{
+  dAASSERT(w);
+  w->qs.deterministic_threads = deterministic;
+}
+
 void dWorldSetQuickStepWarmStartFactor (dWorldID w, dReal warm)
 {
   dAASSERT(w);
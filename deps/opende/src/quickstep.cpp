@@ -108,6 +108,19 @@ void dxQuickStepper (dxWorldProcessContext *context,
 
   const dReal stepsize1 = dRecip(stepsize);
 
+  // when islands run on the threadpool, solve with a private copy of the
+  // parameters so the convergence statistics written by the LCP solver are
+  // not shared with other islands.
+  dxQuickStepParameters *qs = &world->qs;
+  dxQuickStepParameters island_qs;
+  const bool island_copy =
+    world->threadpool && world->threadpool->size() > 0;
+  if (island_copy) {
+    island_qs = world->qs;
+    qs = &island_qs;
+  }
+  qs->iterations_used = 0;
+
   {
     // number all bodies in the body list - set their tag values
     for (int i=0; i<nb; i++) body[i]->tag = i;
@@ -219,9 +232,10 @@ void dxQuickStepper (dxWorldProcessContext *context,
 
   int m;
   int mfb; // number of rows of Jacobian we will have to save for joint feedback
+  int ncontacts; // number of contact joints, for the island statistics
 
   {
-    int mcurr = 0, mfbcurr = 0;
+    int mcurr = 0, mfbcurr = 0, ncontactscurr = 0;
     const dJointWithInfo1 *jicurr = jointiinfos;
     const dJointWithInfo1 *const jiend = jicurr + nj;
     for (; jicurr != jiend; jicurr++) {
@@ -229,10 +243,13 @@ void dxQuickStepper (dxWorldProcessContext *context,
       mcurr += jm;
       if (jicurr->joint->feedback)
         mfbcurr += jm;
+      if (jicurr->joint->type() == dJointTypeContact)
+        ncontactscurr++;
     }
 
     m = mcurr;
     mfb = mfbcurr;
+    ncontacts = ncontactscurr;
   }
 
   // if there are constraints, compute the constraint force
@@ -512,7 +529,7 @@ void dxQuickStepper (dxWorldProcessContext *context,
                caccel,caccel_erp,cforce,
                rhs,rhs_erp,rhs_precon,
                lo,hi,cfm,findex,
-               &world->qs
+               qs
 #ifdef USE_TPROW
                , world->row_threadpool
 #endif
@@ -524,8 +541,9 @@ void dxQuickStepper (dxWorldProcessContext *context,
     {
       // warm starting
       // save lambda for the next iteration
-      //@@@ note that this doesn't work for contact joints yet, as they are
-      // recreated every iteration
+      // contact joints are recreated every iteration, their lambda only
+      // carries over if the caller copies it to the new contact joints,
+      // see dJointGetLambda and dJointSetLambda
       const dReal *lambdacurr = lambda;
       const dReal *lambda_erpcurr = lambda_erp;
       const dJointWithInfo1 *jicurr = jointiinfos;
@@ -549,6 +567,34 @@ void dxQuickStepper (dxWorldProcessContext *context,
                  m, mfb, body, nb, jointiinfos, nj, stepsize,
                  lambda, caccel, caccel_erp, Jcopy, invMOI);
 
+  {
+    dIslandStatistics stats;
+    stats.bodies = nb;
+    stats.joints = nj;
+    stats.contacts = ncontacts;
+    stats.rows = m;
+    stats.iterations = m > 0 ? qs->iterations_used : 0;
+    stats.residual = m > 0 ? qs->rms_constraint_residual[3] : 0;
+
+    boost::mutex::scoped_lock lock(world->qs_stats_mutex);
+    world->island_stats.push_back(std::make_pair(body, stats));
+  }
+
+  if (island_copy && m > 0) {
+    // islands are laid out in body list order, so keeping the statistics of
+    // the island with the last body list reports the same values as the
+    // serial solver, which processes that island last.
+    boost::mutex::scoped_lock lock(world->qs_stats_mutex);
+    if (!world->qs_stats_island || body > world->qs_stats_island) {
+      world->qs_stats_island = body;
+      memcpy(world->qs.rms_dlambda, island_qs.rms_dlambda,
+        sizeof(island_qs.rms_dlambda));
+      memcpy(world->qs.rms_constraint_residual,
+        island_qs.rms_constraint_residual,
+        sizeof(island_qs.rms_constraint_residual));
+      world->qs.num_contacts = island_qs.num_contacts;
+    }
+  }
 }
 
 size_t dxEstimateQuickStepMemoryRequirements (
@@ -19,6 +19,7 @@
 * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
 *                                                                       *
 *************************************************************************/
+#include <algorithm>
 #include <thread>
 
 #include <gazebo/ode/common.h>
@@ -205,8 +206,10 @@ static void* ComputeRows(void *p)
   dRealMutablePtr cforce_ptr2;
   int total_iterations = precon_iterations + num_iterations +
     friction_iterations;
+  int iterations_done = 0;
   for (int iteration = 0; iteration < total_iterations; ++iteration)
   {
+    iterations_done = iteration + 1;
     // reset rms_dlambda at beginning of iteration
     rms_dlambda[2] = 0;
     // reset rms_error at beginning of iteration
@@ -828,10 +831,18 @@ static void* ComputeRows(void *p)
       dlambda_total_mean = (rms_dlambda[0] + rms_dlambda[1] + rms_dlambda[2])/
         ((dReal)(m_rms_dlambda[0] + m_rms_dlambda[1] + m_rms_dlambda[2]));
 
-    qs->rms_dlambda[0] = sqrt(dlambda_bilateral_mean);
-    qs->rms_dlambda[1] = sqrt(dlambda_contact_normal_mean);
-    qs->rms_dlambda[2] = sqrt(dlambda_contact_friction_mean);
-    qs->rms_dlambda[3] = sqrt(dlambda_total_mean);
+    // in deterministic mode only the velocity solve reports statistics, a
+    // concurrent position correction thread would overwrite them at random.
+    const bool report_stats =
+      !(qs->deterministic_threads && position_correction_thread);
+
+    if (report_stats)
+    {
+      qs->rms_dlambda[0] = sqrt(dlambda_bilateral_mean);
+      qs->rms_dlambda[1] = sqrt(dlambda_contact_normal_mean);
+      qs->rms_dlambda[2] = sqrt(dlambda_contact_friction_mean);
+      qs->rms_dlambda[3] = sqrt(dlambda_total_mean);
+    }
 
     dReal residual_bilateral_mean = 0.0;
     dReal residual_contact_normal_mean = 0.0;
@@ -848,11 +859,20 @@ static void* ComputeRows(void *p)
       residual_total_mean = (rms_error[0] + rms_error[1] + rms_error[2])/
         ((dReal)(m_rms_dlambda[0] + m_rms_dlambda[1] + m_rms_dlambda[2]));
 
-    qs->rms_constraint_residual[0] = sqrt(residual_bilateral_mean);
-    qs->rms_constraint_residual[1] = sqrt(residual_contact_normal_mean);
-    qs->rms_constraint_residual[2] = sqrt(residual_contact_friction_mean);
-    qs->rms_constraint_residual[3] = sqrt(residual_total_mean);
-    qs->num_contacts = m_rms_dlambda[1];
+    if (report_stats)
+    {
+      qs->rms_constraint_residual[0] = sqrt(residual_bilateral_mean);
+      qs->rms_constraint_residual[1] = sqrt(residual_contact_normal_mean);
+      qs->rms_constraint_residual[2] = sqrt(residual_contact_friction_mean);
+      qs->rms_constraint_residual[3] = sqrt(residual_total_mean);
+      qs->num_contacts = m_rms_dlambda[1];
+    }
+
+    // by default the shared residual decides when to stop, in deterministic
+    // mode only the residual of the rows solved here.
+    dReal residual_total = qs->rms_constraint_residual[3];
+    if (qs->deterministic_threads)
+      residual_total = sqrt(residual_total_mean);
 
 #ifdef HDF5_INSTRUMENT
     errors[iteration] = residual_total_mean;
@@ -886,7 +906,7 @@ static void* ComputeRows(void *p)
 
     // option to stop when tolerance has been met
     if (iteration >= precon_iterations &&
-        qs->rms_constraint_residual[3] < pgs_lcp_tolerance)
+        residual_total < pgs_lcp_tolerance)
     {
       #ifdef DEBUG_CONVERGENCE_TOLERANCE
         printf("CONVERGED: id: %d steps: %d,"
@@ -911,6 +931,7 @@ static void* ComputeRows(void *p)
       #endif
     }
   } // end of for loop on iterations
+  params->iterations = iterations_done;
 
 #ifdef SHOW_CONVERGENCE
   // show starting lambda
@@ -1415,6 +1436,11 @@ void quickstep::PGS_LCP (dxWorldProcessContext *context,
   IFTIMING (dTimerNow ("threads done"));
 #endif
 
+  // the slowest chunk decides how many iterations the solve took
+  qs->iterations_used = 0;
+  for (int i = 0; i < thread_id; ++i)
+    qs->iterations_used = std::max(qs->iterations_used, params[i].iterations);
+
 
   #ifdef REPORT_THREAD_TIMING
   gettimeofday(&tv,NULL);
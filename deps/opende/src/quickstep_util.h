@@ -129,6 +129,7 @@ struct dxPGSLCPParameters {
     bool inline_position_correction;
     bool position_correction_thread;
     dxQuickStepParameters *qs;
+    int iterations;  // output: PGS iterations done by this chunk
     int nStart;   // 0
     int nChunkSize;
     int m; // m
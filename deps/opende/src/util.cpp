@@ -20,6 +20,8 @@
  *                                                                       *
  *************************************************************************/
 
+#include <algorithm>
+
 #include <gazebo/ode/ode.h>
 #include "config.h"
 #include "objects.h"
@@ -614,6 +616,9 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
 
   IFTIMING(dTimerStart("preprocessing islands"));
   int island_index = 0;
+  world->qs_stats_island = NULL;
+  world->island_stats.clear();
+  world->island_stats.reserve(islandcount);
   int const *const sizesend = islandsizes + islandcount * sizeelements;
 
 #ifdef REPORT_THREAD_TIMING
@@ -663,6 +668,12 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
   printf("<<<<<<<<<<<< all island threads stopped at time %f with duration %f\n",end_time,end_time - cur_time);
 #endif
 
+  // islands solved on the threadpool finish in any order
+  std::sort(world->island_stats.begin(), world->island_stats.end(),
+    [](const std::pair<dxBody *const *, dIslandStatistics> &a,
+       const std::pair<dxBody *const *, dIslandStatistics> &b)
+    { return a.first < b.first; });
+
   for (auto &m : world->island_wmems)
   {
     m->GetWorldProcessingContext()->CleanupContext();
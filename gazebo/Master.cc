@@ -23,6 +23,7 @@
 #include <boost/make_shared.hpp>
 #include <google/protobuf/descriptor.h>
 #include <set>
+#include <unordered_map>
 #include "gazebo/transport/IOManager.hh"
 
 #include "Master.hh"
@@ -35,15 +36,26 @@ namespace gazebo
 {
   struct MasterPrivate
   {
-    /// \brief All the known publishers.
-    gazebo::Master::PubList publishers;
+    /// \brief All the known publishers, by topic. A publisher is
+    /// identified by its topic, host and port.
+    std::unordered_map<std::string, gazebo::Master::PubList> publishers;
 
-    /// \brief All the known subscribers.
-    gazebo::Master::SubList subscribers;
+    /// \brief All the known subscribers, by topic. A subscriber is
+    /// identified by its topic, host and port.
+    std::unordered_map<std::string, gazebo::Master::SubList> subscribers;
+
+    /// \brief Topics advertised through each connection, by connection id.
+    std::unordered_map<unsigned int, std::set<std::string>> connectionPubs;
+
+    /// \brief Topics subscribed through each connection, by connection id.
+    std::unordered_map<unsigned int, std::set<std::string>> connectionSubs;
 
     /// \brief All the known connections.
     gazebo::Master::Connection_M connections;
 
+    /// \brief Index of the next accepted connection.
+    unsigned int connectionIndex = 0;
+
     /// \brief All the worlds.
     std::list<std::string> worldNames;
 
@@ -117,14 +129,13 @@ void Master::OnAccept(transport::ConnectionPtr _newConnection)
   _newConnection->EnqueueMsg(msgs::Package("topic_namepaces_init",
                               namespacesMsg), true);
 
-  // Send all the publishers
+  // Send all the publishers. Later changes are sent as publisher_add and
+  // publisher_del updates.
   msgs::Publishers publishersMsg;
-  PubList::iterator pubiter;
-  for (pubiter = this->dataPtr->publishers.begin();
-       pubiter != this->dataPtr->publishers.end(); ++pubiter)
+  for (auto const &topic : this->dataPtr->publishers)
   {
-    msgs::Publish *pub = publishersMsg.add_publisher();
-    pub->CopyFrom(pubiter->first);
+    for (auto const &publisher : topic.second)
+      publishersMsg.add_publisher()->CopyFrom(publisher.first);
   }
   _newConnection->EnqueueMsg(
       msgs::Package("publishers_init", publishersMsg), true);
@@ -132,7 +143,8 @@ void Master::OnAccept(transport::ConnectionPtr _newConnection)
   // Add the connection to our list
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
-    int index = this->dataPtr->connections.size();
+    // Indices are never reused, since removed connections leave holes.
+    unsigned int index = this->dataPtr->connectionIndex++;
 
     this->dataPtr->connections[index] = _newConnection;
 
@@ -180,11 +192,14 @@ void Master::OnRead(const unsigned int _connectionIndex,
 void Master::SendSubscribers(const std::string &_topic,
                              const std::string &_buffer)
 {
+  auto subs = this->dataPtr->subscribers.find(_topic);
+  if (subs == this->dataPtr->subscribers.end())
+    return;
+
   // Find all subscribers for this topic
   std::set<transport::ConnectionPtr> uniqueConnections;
-  for (auto const &subscriber : this->dataPtr->subscribers)
-    if (subscriber.first.topic() == _topic)
-      uniqueConnections.insert(subscriber.second);
+  for (auto const &subscriber : subs->second)
+    uniqueConnections.insert(subscriber.second);
 
   // Send message to all unique connections
   for (auto &conn : uniqueConnections)
@@ -233,6 +248,18 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
     msgs::Publish pub;
     pub.ParseFromString(packet.serialized_data());
 
+    // A repeated advertisement only updates the known publisher.
+    PubList &pubs = this->dataPtr->publishers[pub.topic()];
+    for (auto &publisher : pubs)
+    {
+      if (publisher.first.host() == pub.host() &&
+          publisher.first.port() == pub.port())
+      {
+        publisher = std::make_pair(pub, conn);
+        return;
+      }
+    }
+
     Connection_M::iterator iter2;
     for (iter2 = this->dataPtr->connections.begin();
          iter2 != this->dataPtr->connections.end(); ++iter2)
@@ -240,7 +267,8 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
       iter2->second->EnqueueMsg(msgs::Package("publisher_add", pub));
     }
 
-    this->dataPtr->publishers.push_back(std::make_pair(pub, conn));
+    pubs.push_back(std::make_pair(pub, conn));
+    this->dataPtr->connectionPubs[conn->GetId()].insert(pub.topic());
 
     this->SendSubscribers(pub.topic(),
         msgs::Package("publisher_advertise", pub));
@@ -262,17 +290,33 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
     msgs::Subscribe sub;
     sub.ParseFromString(packet.serialized_data());
 
-    this->dataPtr->subscribers.push_back(std::make_pair(sub, conn));
+    SubList &subs = this->dataPtr->subscribers[sub.topic()];
+    bool known = false;
+    for (auto &subscriber : subs)
+    {
+      if (subscriber.first.host() == sub.host() &&
+          subscriber.first.port() == sub.port())
+      {
+        subscriber = std::make_pair(sub, conn);
+        known = true;
+        break;
+      }
+    }
 
-    PubList::iterator iter;
+    if (!known)
+    {
+      subs.push_back(std::make_pair(sub, conn));
+      this->dataPtr->connectionSubs[conn->GetId()].insert(sub.topic());
+    }
 
     // Find all publishers of the topic
-    for (iter = this->dataPtr->publishers.begin();
-        iter != this->dataPtr->publishers.end(); ++iter)
+    auto pubs = this->dataPtr->publishers.find(sub.topic());
+    if (pubs != this->dataPtr->publishers.end())
     {
-      if (iter->first.topic() == sub.topic())
+      for (auto const &publisher : pubs->second)
       {
-        conn->EnqueueMsg(msgs::Package("publisher_subscribe", iter->first));
+        conn->EnqueueMsg(
+            msgs::Package("publisher_subscribe", publisher.first));
       }
     }
   }
@@ -284,12 +328,10 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
     if (req.request() == "get_publishers")
     {
       msgs::Publishers msg;
-      PubList::iterator iter;
-      for (iter = this->dataPtr->publishers.begin();
-          iter != this->dataPtr->publishers.end(); ++iter)
+      for (auto const &topic : this->dataPtr->publishers)
       {
-        msgs::Publish *pub = msg.add_publisher();
-        pub->CopyFrom(iter->first);
+        for (auto const &publisher : topic.second)
+          msg.add_publisher()->CopyFrom(publisher.first);
       }
       conn->EnqueueMsg(msgs::Package("publisher_list", msg), true);
     }
@@ -299,18 +341,12 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
       msgs::GzString_V msg;
 
       // Add all topics that are published
-      for (PubList::iterator iter = this->dataPtr->publishers.begin();
-          iter != this->dataPtr->publishers.end(); ++iter)
-      {
-        topics.insert(iter->first.topic());
-      }
+      for (auto const &topic : this->dataPtr->publishers)
+        topics.insert(topic.first);
 
       // Add all topics that are subscribed
-      for (SubList::iterator iter = this->dataPtr->subscribers.begin();
-           iter != this->dataPtr->subscribers.end(); ++iter)
-      {
-        topics.insert(iter->first.topic());
-      }
+      for (auto const &topic : this->dataPtr->subscribers)
+        topics.insert(topic.first);
 
       // Construct the message of only unique names
       for (std::set<std::string>::iterator iter =
@@ -328,33 +364,26 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
       msgs::TopicInfo ti;
       ti.set_msg_type(pub.msg_type());
 
-      PubList::iterator piter;
-      SubList::iterator siter;
-
       // Find all publishers of the topic
-      for (piter = this->dataPtr->publishers.begin();
-          piter != this->dataPtr->publishers.end(); ++piter)
+      auto pubs = this->dataPtr->publishers.find(req.data());
+      if (pubs != this->dataPtr->publishers.end())
       {
-        if (piter->first.topic() == req.data())
-        {
-          msgs::Publish *pubPtr = ti.add_publisher();
-          pubPtr->CopyFrom(piter->first);
-        }
+        for (auto const &publisher : pubs->second)
+          ti.add_publisher()->CopyFrom(publisher.first);
       }
 
       // Find all subscribers of the topic
-      for (siter = this->dataPtr->subscribers.begin();
-          siter != this->dataPtr->subscribers.end(); ++siter)
+      auto subs = this->dataPtr->subscribers.find(req.data());
+      if (subs != this->dataPtr->subscribers.end())
       {
-        if (siter->first.topic() == req.data())
+        for (auto const &subscriber : subs->second)
         {
           // If the topic info message type has not been set or the
           // topic info message type is an empty string, then set the topic
           // info message type based on a subscriber's message type.
           if (!ti.has_msg_type() || ti.msg_type().empty())
-            ti.set_msg_type(siter->first.msg_type());
-          msgs::Subscribe *sub = ti.add_subscriber();
-          sub->CopyFrom(siter->first);
+            ti.set_msg_type(subscriber.first.msg_type());
+          ti.add_subscriber()->CopyFrom(subscriber.first);
         }
       }
 
@@ -453,44 +482,54 @@ void Master::RemoveConnection(Connection_M::iterator _connIter)
     }
   }
 
+  unsigned int id = _connIter->second->GetId();
+
   // Remove all publishers for this connection
-  bool done = false;
-  while (!done)
+  auto connPubs = this->dataPtr->connectionPubs.find(id);
+  if (connPubs != this->dataPtr->connectionPubs.end())
   {
-    done = true;
-    PubList::iterator pubIter = this->dataPtr->publishers.begin();
-    while (pubIter != this->dataPtr->publishers.end())
+    std::set<std::string> topics;
+    std::swap(topics, connPubs->second);
+    for (auto const &topic : topics)
     {
-      if ((*pubIter).second->GetId() == _connIter->second->GetId())
+      auto pubs = this->dataPtr->publishers.find(topic);
+      if (pubs == this->dataPtr->publishers.end())
+        continue;
+
+      std::list<msgs::Publish> toRemove;
+      for (auto const &publisher : pubs->second)
       {
-        this->RemovePublisher((*pubIter).first);
-        done = false;
-        break;
+        if (publisher.second->GetId() == id)
+          toRemove.push_back(publisher.first);
       }
-      else
-        ++pubIter;
+      for (auto const &pub : toRemove)
+        this->RemovePublisher(pub);
     }
+    this->dataPtr->connectionPubs.erase(id);
   }
 
-
-  done = false;
-  while (!done)
+  // Remove all subscribers for this connection
+  auto connSubs = this->dataPtr->connectionSubs.find(id);
+  if (connSubs != this->dataPtr->connectionSubs.end())
   {
-    done = true;
-
-    // Remove all subscribers for this connection
-    SubList::iterator subIter = this->dataPtr->subscribers.begin();
-    while (subIter != this->dataPtr->subscribers.end())
+    std::set<std::string> topics;
+    std::swap(topics, connSubs->second);
+    for (auto const &topic : topics)
     {
-      if ((*subIter).second->GetId() == _connIter->second->GetId())
+      auto subs = this->dataPtr->subscribers.find(topic);
+      if (subs == this->dataPtr->subscribers.end())
+        continue;
+
+      std::list<msgs::Subscribe> toRemove;
+      for (auto const &subscriber : subs->second)
       {
-        this->RemoveSubscriber((*subIter).first);
-        done = false;
-        break;
+        if (subscriber.second->GetId() == id)
+          toRemove.push_back(subscriber.first);
       }
-      else
-        ++subIter;
+      for (auto const &sub : toRemove)
+        this->RemoveSubscriber(sub);
     }
+    this->dataPtr->connectionSubs.erase(id);
   }
 
   this->dataPtr->connections.erase(_connIter);
@@ -511,46 +550,64 @@ void Master::RemovePublisher(const msgs::Publish _pub)
 
   this->SendSubscribers(_pub.topic(), msgs::Package("unadvertise", _pub));
 
-  PubList::iterator pubIter = this->dataPtr->publishers.begin();
-  while (pubIter != this->dataPtr->publishers.end())
+  auto pubs = this->dataPtr->publishers.find(_pub.topic());
+  if (pubs == this->dataPtr->publishers.end())
+    return;
+
+  PubList::iterator pubIter = pubs->second.begin();
+  while (pubIter != pubs->second.end())
   {
-    if (pubIter->first.topic() == _pub.topic() &&
-        pubIter->first.host() == _pub.host() &&
+    if (pubIter->first.host() == _pub.host() &&
         pubIter->first.port() == _pub.port())
     {
-      pubIter = this->dataPtr->publishers.erase(pubIter);
+      auto connPubs =
+          this->dataPtr->connectionPubs.find(pubIter->second->GetId());
+      if (connPubs != this->dataPtr->connectionPubs.end())
+        connPubs->second.erase(_pub.topic());
+      pubIter = pubs->second.erase(pubIter);
     }
     else
       ++pubIter;
   }
+
+  if (pubs->second.empty())
+    this->dataPtr->publishers.erase(pubs);
 }
 
 /////////////////////////////////////////////////
 void Master::RemoveSubscriber(const msgs::Subscribe _sub)
 {
   // Find all publishers of the topic, and remove the subscriptions
-  for (PubList::iterator iter = this->dataPtr->publishers.begin();
-      iter != this->dataPtr->publishers.end(); ++iter)
+  auto pubs = this->dataPtr->publishers.find(_sub.topic());
+  if (pubs != this->dataPtr->publishers.end())
   {
-    if (iter->first.topic() == _sub.topic())
-    {
-      iter->second->EnqueueMsg(msgs::Package("unsubscribe", _sub));
-    }
+    for (auto const &publisher : pubs->second)
+      publisher.second->EnqueueMsg(msgs::Package("unsubscribe", _sub));
   }
 
+  auto subs = this->dataPtr->subscribers.find(_sub.topic());
+  if (subs == this->dataPtr->subscribers.end())
+    return;
+
   // Remove the subscribers from our list
-  SubList::iterator subiter = this->dataPtr->subscribers.begin();
-  while (subiter != this->dataPtr->subscribers.end())
+  SubList::iterator subiter = subs->second.begin();
+  while (subiter != subs->second.end())
   {
-    if (subiter->first.topic() == _sub.topic() &&
-        subiter->first.host() == _sub.host() &&
+    if (subiter->first.host() == _sub.host() &&
         subiter->first.port() == _sub.port())
     {
-      subiter = this->dataPtr->subscribers.erase(subiter);
+      auto connSubs =
+          this->dataPtr->connectionSubs.find(subiter->second->GetId());
+      if (connSubs != this->dataPtr->connectionSubs.end())
+        connSubs->second.erase(_sub.topic());
+      subiter = subs->second.erase(subiter);
     }
     else
       ++subiter;
   }
+
+  if (subs->second.empty())
+    this->dataPtr->subscribers.erase(subs);
 }
 
 //////////////////////////////////////////////////
@@ -583,6 +640,8 @@ void Master::Fini()
   this->dataPtr->connections.clear();
   this->dataPtr->subscribers.clear();
   this->dataPtr->publishers.clear();
+  this->dataPtr->connectionSubs.clear();
+  this->dataPtr->connectionPubs.clear();
 }
 
 //////////////////////////////////////////////////
@@ -590,18 +649,9 @@ msgs::Publish Master::GetPublisher(const std::string &_topic)
 {
   msgs::Publish msg;
 
-  PubList::iterator iter;
-
-  // Find all publishers of the topic
-  for (iter = this->dataPtr->publishers.begin();
-       iter != this->dataPtr->publishers.end(); ++iter)
-  {
-    if (iter->first.topic() == _topic)
-    {
-      msg = iter->first;
-      break;
-    }
-  }
+  auto pubs = this->dataPtr->publishers.find(_topic);
+  if (pubs != this->dataPtr->publishers.end() && !pubs->second.empty())
+    msg = pubs->second.front().first;
 
   return msg;
 }
@@ -24,7 +24,14 @@
 
 #include <stdio.h>
 #include <signal.h>
+#include <tinyxml.h>
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include <mutex>
+#include <set>
+#include <string>
+#include <vector>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
@@ -35,7 +42,6 @@
 
 #include <ignition/math/Rand.hh>
 #include <ignition/math/SemanticVersion.hh>
-#include <ignition/common/Profiler.hh>
 #include <ignition/common/Filesystem.hh>
 #include <ignition/common/URI.hh>
 #ifdef _WIN32
@@ -45,6 +51,7 @@
 #endif
 #include <ignition/fuel_tools/Interface.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/gazebo.hh"
 #include "gazebo/transport/transport.hh"
 
@@ -56,6 +63,7 @@
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/ThreadRoles.hh"
 
 #include "gazebo/msgs/msgs.hh"
 
@@ -99,9 +107,25 @@ namespace gazebo
               << "This can lead to an unexpected behaviour." << "\n";
     }
 
+    /// \brief Open plugin libraries in the background, while the world
+    /// loads. Off by default, set GAZEBO_PLUGIN_PRELOAD to 1 to enable it.
+    /// \param[in] _filenames File names of the plugin libraries.
+    void PreloadPlugins(const std::vector<std::string> &_filenames)
+    {
+      const char *env = common::getEnv("GAZEBO_PLUGIN_PRELOAD");
+      if (_filenames.empty() || !env || std::string(env) != "1")
+        return;
+
+      this->pluginPreloads.push_back(std::async(std::launch::async,
+            [_filenames]() {return common::PreloadPlugins(_filenames);}));
+    }
+
     /// \brief Boolean used to stop the server.
     static bool stop;
 
+    /// \brief Set by SIGUSR1 to start or stop a trace capture.
+    static std::atomic<bool> traceToggle;
+
     /// \brief Communication node.
     transport::NodePtr node;
 
@@ -134,10 +158,43 @@ namespace gazebo
 
     /// \brief Set whether to lockstep physics and rendering
     bool lockstep = false;
+
+    /// \brief Number of copies of the world to load.
+    unsigned int worldCopies = 1;
+
+    /// \brief Worlds loaded by LoadImpl.
+    std::vector<physics::WorldPtr> worlds;
+
+    /// \brief Plugin libraries being opened in the background.
+    std::vector<std::future<unsigned int>> pluginPreloads;
+
+    /// \brief State of a world captured in warm mode.
+    struct WarmWorld
+    {
+      /// \brief The world.
+      physics::WorldPtr world;
+
+      /// \brief Snapshot of the world, from World::StateSnapshot.
+      std::string snapshot;
+
+      /// \brief Names of the models of the world.
+      std::set<std::string> models;
+
+      /// \brief True if the world was paused.
+      bool paused = false;
+    };
+
+    /// \brief True to capture the loaded worlds, and restore them on
+    /// warm_restart control messages.
+    bool warm = false;
+
+    /// \brief States captured in warm mode.
+    std::vector<WarmWorld> warmWorlds;
   };
 }
 
 bool ServerPrivate::stop = true;
+std::atomic<bool> ServerPrivate::traceToggle(false);
 
 /////////////////////////////////////////////////
 Server::Server()
@@ -184,12 +241,30 @@ bool Server::ParseArgs(int _argc, char **_argv)
     ("help,h", "Produce this help message.")
     ("pause,u", "Start the server in a paused state.")
     ("lockstep", "Lockstep simulation so sensor update rates are respected.")
+    ("world_copies", po::value<unsigned int>(),
+     "Load this many isolated copies of the world, each stepped by its own "
+     "thread on its own CPU.")
+    ("real_time", "Step the world on absolute deadlines to reduce jitter.")
+    ("rt_priority", po::value<int>(),
+     "Run the world update thread with SCHED_FIFO at this priority (1-99). "
+     "Implies --real_time.")
+    ("threads", po::value<std::string>(),
+     "Thread roles configuration, such as "
+     "\"world:cpus=0,priority=50;sensors:cpus=1-3,tbb=3\". Roles are world, "
+     "log_worker, sensors, io, log_update, log_write, log_cleanup, "
+     "log_upload and video_encoder.")
     ("physics,e", po::value<std::string>(),
      "Specify a physics engine (ode|bullet|dart|simbody).")
     ("play,p", po::value<std::string>(), "Play a log file.")
+    ("play_start", po::value<double>(),
+     "Start playing the log at this simulation time (seconds).")
+    ("play_end", po::value<double>(),
+     "Stop playing the log after this simulation time (seconds). With "
+     "--play_start and --lockstep, servers with their own master re-render "
+     "the sensors of separate log segments in parallel.")
     ("record,r", "Record state data.")
     ("record_encoding", po::value<std::string>()->default_value("zlib"),
-     "Compression encoding format for log data (zlib|bz2|txt).")
+     "Compression encoding format for log data (zlib|bz2|txt|bin).")
     ("record_path", po::value<std::string>()->default_value(""),
      "Absolute path in which to store state data")
     ("record_period", po::value<double>()->default_value(-1),
@@ -197,15 +272,39 @@ bool Server::ParseArgs(int _argc, char **_argv)
     ("record_filter", po::value<std::string>()->default_value(""),
      "Recording filter (supports wildcard and regular expression).")
     ("record_resources", "Recording with model meshes and materials.")
+    ("record_overflow", po::value<std::string>()->default_value("block"),
+     "Action when recording falls behind simulation (block|drop).")
+    ("record_topic", po::value<std::vector<std::string>>()->composing(),
+     "Sensor topic to record next to the state log, may be repeated.")
+    ("record_segment_size", po::value<double>(),
+     "Start a new log segment once the current one reaches this size (MB).")
+    ("record_segment_duration", po::value<double>(),
+     "Start a new log segment after this wall time (seconds).")
+    ("record_upload", po::value<std::string>(),
+     "Command run on each completed log segment, {} is replaced by the "
+     "segment path, e.g. \"aws s3 cp {} s3://bucket/logs/\".")
+    ("record_max_disk", po::value<double>(),
+     "Bound the disk space of completed log segments (MB). Uploaded "
+     "segments are deleted first.")
     ("seed",  po::value<double>(), "Start with a given random number seed.")
     ("initial_sim_time", po::value<double>(),
      "Initial simulation time (seconds).")
     ("iters",  po::value<unsigned int>(), "Number of iterations to simulate.")
     ("minimal_comms", "Reduce the TCP/IP traffic output by gzserver")
+    ("warm", "Keep the loaded world warm: its state is captured once loaded, "
+     "and a server control message with warm_restart restores it, so "
+     "successive sessions reuse the loaded world.")
     ("server-plugin,s", po::value<std::vector<std::string> >(),
      "Load a plugin.")
     ("profile,o", po::value<std::string>(),
-     "Physics preset profile name from the options in the world file.");
+     "Physics preset profile name from the options in the world file.")
+    ("trace", po::value<std::string>()->implicit_value(""),
+     "Capture the profiler zones to a Chrome trace file, by default under "
+     "the traces directory of the log path. SIGUSR1 also starts or stops "
+     "a capture.")
+    ("trace_duration", po::value<double>(),
+     "Duration of trace captures (seconds), 0 to capture until stopped. "
+     "Default 10.");
 
   po::options_description hiddenDesc("Hidden options");
   hiddenDesc.add_options()
@@ -262,6 +361,22 @@ bool Server::ParseArgs(int _argc, char **_argv)
     gazebo::common::Console::SetQuiet(false);
   }
 
+  // Set GAZEBO_CONSOLE_ASYNC to 1 to write the console messages from a
+  // background thread.
+  const char *asyncConsole = common::getEnv("GAZEBO_CONSOLE_ASYNC");
+  if (asyncConsole && std::string(asyncConsole) == "1")
+    gazebo::common::Console::SetAsync(true);
+
+  // Start the trace capture first, so that it covers loading
+  if (this->dataPtr->vm.count("trace"))
+  {
+    double duration = common::TraceCapture::kDefaultDuration;
+    if (this->dataPtr->vm.count("trace_duration"))
+      duration = this->dataPtr->vm["trace_duration"].as<double>();
+    common::TraceCapture::Instance()->Start(
+        this->dataPtr->vm["trace"].as<std::string>(), duration);
+  }
+
   if (this->dataPtr->vm.count("minimal_comms"))
     gazebo::transport::setMinimalComms(true);
   else
@@ -323,8 +438,26 @@ bool Server::ParseArgs(int _argc, char **_argv)
   {
     this->dataPtr->lockstep = true;
   }
+
+  if (this->dataPtr->vm.count("warm"))
+    this->dataPtr->warm = true;
+
+  if (this->dataPtr->vm.count("world_copies"))
+  {
+    this->dataPtr->worldCopies =
+      std::max(this->dataPtr->vm["world_copies"].as<unsigned int>(), 1u);
+  }
   rendering::set_lockstep_enabled(this->dataPtr->lockstep);
 
+  // Before the transport starts its IO threads
+  if (this->dataPtr->vm.count("threads") &&
+      !common::ThreadRoles::Instance()->Parse(
+      this->dataPtr->vm["threads"].as<std::string>()))
+  {
+    gzerr << "Invalid --threads configuration\n";
+    return false;
+  }
+
   if (!this->PreLoad())
   {
     gzerr << "Unable to load gazebo\n";
@@ -362,6 +495,20 @@ bool Server::ParseArgs(int _argc, char **_argv)
     // Load the server
     if (!this->LoadString(sdfString))
       return false;
+
+    // Play a segment of the log. Physics is disabled during playback, so
+    // the rendering sensors are only limited by the rendering itself.
+    if (this->dataPtr->vm.count("play_start"))
+    {
+      util::LogPlay::Instance()->Seek(
+          common::Time(this->dataPtr->vm["play_start"].as<double>()));
+    }
+    if (this->dataPtr->vm.count("play_end"))
+    {
+      const common::Time end(this->dataPtr->vm["play_end"].as<double>());
+      for (auto const &world : this->dataPtr->worlds)
+        world->SetLogPlayEndTime(end);
+    }
   }
   else
   {
@@ -394,16 +541,19 @@ bool Server::ParseArgs(int _argc, char **_argv)
     if (this->dataPtr->vm.count("profile"))
     {
       std::string profileName = this->dataPtr->vm["profile"].as<std::string>();
-      if (physics::get_world()->PresetMgr()->HasProfile(profileName))
+      for (auto const &world : this->dataPtr->worlds)
       {
-        physics::get_world()->PresetMgr()->CurrentProfile(profileName);
-        gzmsg << "Setting physics profile to [" << profileName << "]."
-              << std::endl;
-      }
-      else
-      {
-        gzerr << "Specified profile [" << profileName << "] was not found."
-              << std::endl;
+        if (world->PresetMgr()->HasProfile(profileName))
+        {
+          world->PresetMgr()->CurrentProfile(profileName);
+          gzmsg << "Setting physics profile to [" << profileName << "]."
+                << std::endl;
+        }
+        else
+        {
+          gzerr << "Specified profile [" << profileName << "] was not found."
+                << std::endl;
+        }
       }
     }
   }
@@ -412,8 +562,11 @@ bool Server::ParseArgs(int _argc, char **_argv)
   {
     try
     {
-      physics::get_world()->SetSimTime(
-          common::Time(this->dataPtr->vm["initial_sim_time"].as<double>()));
+      for (auto const &world : this->dataPtr->worlds)
+      {
+        world->SetSimTime(
+            common::Time(this->dataPtr->vm["initial_sim_time"].as<double>()));
+      }
       gzmsg << "Setting initial sim time to [" <<
         physics::get_world()->SimTime() << "]\n" << std::endl;
     }
@@ -425,6 +578,17 @@ bool Server::ParseArgs(int _argc, char **_argv)
     }
   }
 
+  if (this->dataPtr->vm.count("real_time") ||
+      this->dataPtr->vm.count("rt_priority"))
+  {
+    for (auto const &world : this->dataPtr->worlds)
+    {
+      world->SetRealTimeMode(true);
+      if (this->dataPtr->vm.count("rt_priority"))
+        world->SetRealTimePriority(this->dataPtr->vm["rt_priority"].as<int>());
+    }
+  }
+
   this->ProcessParams();
 
   return true;
@@ -436,6 +600,77 @@ bool Server::GetInitialized() const
   return !this->dataPtr->stop && this->dataPtr->initialized;
 }
 
+/////////////////////////////////////////////////
+/// \brief Collect the URIs of the <include> elements of a world file.
+/// \param[in] _elem Root of the XML subtree.
+/// \param[out] _uris URIs of the included models.
+static void CollectIncludeUris(const TiXmlElement *_elem,
+    std::vector<std::string> &_uris)
+{
+  for (const TiXmlElement *child = _elem->FirstChildElement(); child;
+       child = child->NextSiblingElement())
+  {
+    if (child->ValueStr() == "include")
+    {
+      const TiXmlElement *uriElem = child->FirstChildElement("uri");
+      if (uriElem && uriElem->GetText())
+        _uris.push_back(boost::algorithm::trim_copy(
+              std::string(uriElem->GetText())));
+    }
+    else
+      CollectIncludeUris(child, _uris);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Collect the file names of the world, model and actor plugins of
+/// a world file. Sensor and visual plugins are left out, their libraries may
+/// depend on rendering, which must not be initialized from other threads.
+/// \param[in] _elem Root of the XML subtree.
+/// \param[out] _filenames File names of the plugin libraries.
+static void CollectPluginFilenames(const TiXmlElement *_elem,
+    std::vector<std::string> &_filenames)
+{
+  const bool owner = _elem->ValueStr() == "world" ||
+      _elem->ValueStr() == "model" || _elem->ValueStr() == "actor" ||
+      _elem->ValueStr() == "include";
+  for (const TiXmlElement *child = _elem->FirstChildElement(); child;
+       child = child->NextSiblingElement())
+  {
+    const char *filename = child->Attribute("filename");
+    if (child->ValueStr() == "plugin")
+    {
+      if (owner && filename)
+        _filenames.push_back(filename);
+    }
+    else
+      CollectPluginFilenames(child, _filenames);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Collect the file names of the world, model and actor plugins of
+/// an SDF tree, including the ones of the included models.
+/// \param[in] _elem Root of the SDF subtree.
+/// \param[out] _filenames File names of the plugin libraries.
+static void CollectPluginFilenames(const sdf::ElementPtr &_elem,
+    std::vector<std::string> &_filenames)
+{
+  const bool owner = _elem->GetName() == "world" ||
+      _elem->GetName() == "model" || _elem->GetName() == "actor";
+  for (sdf::ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    if (child->GetName() == "plugin")
+    {
+      if (owner && child->HasAttribute("filename"))
+        _filenames.push_back(child->Get<std::string>("filename"));
+    }
+    else
+      CollectPluginFilenames(child, _filenames);
+  }
+}
+
 /////////////////////////////////////////////////
 bool Server::LoadFile(const std::string &_filename,
                       const std::string &_physics)
@@ -493,6 +728,21 @@ bool Server::LoadFile(const std::string &_filename,
     }
     fclose(test);
 
+    // Download the included models in one batch, before the parser
+    // resolves the includes one at a time.
+    TiXmlDocument xmlDoc;
+    if (xmlDoc.LoadFile(foundFile) && xmlDoc.RootElement())
+    {
+      std::vector<std::string> uris;
+      CollectIncludeUris(xmlDoc.RootElement(), uris);
+      common::prefetch_uris(uris);
+
+      // The plugins of the world file open while the includes are parsed
+      std::vector<std::string> plugins;
+      CollectPluginFilenames(xmlDoc.RootElement(), plugins);
+      this->dataPtr->PreloadPlugins(plugins);
+    }
+
     if (!sdf::readFile(foundFile, sdf))
     {
       gzerr << "Unable to read sdf file[" << filename << "]\n";
@@ -565,16 +815,37 @@ bool Server::LoadImpl(sdf::ElementPtr _elem,
   sdf::ElementPtr worldElem = _elem->GetElement("world");
   if (worldElem)
   {
-    physics::WorldPtr world = physics::create_world();
-
-    // Create the world
-    try
+    // The plugins of the included models open while the world loads
+    std::vector<std::string> plugins;
+    CollectPluginFilenames(worldElem, plugins);
+    this->dataPtr->PreloadPlugins(plugins);
+
+    // Copies of the world get a suffix, so their topics do not collide.
+    // They share the mesh and material caches of the process.
+    const unsigned int copies = this->dataPtr->worldCopies;
+    const std::string worldName = worldElem->Get<std::string>("name");
+    for (unsigned int i = 0; i < copies; ++i)
     {
-      physics::load_world(world, worldElem);
-    }
-    catch(common::Exception &e)
-    {
-      gzthrow("Failed to load the World\n"  << e);
+      sdf::ElementPtr copyElem = worldElem;
+      if (copies > 1)
+      {
+        copyElem = worldElem->Clone();
+        copyElem->GetAttribute("name")->Set(
+            worldName + "_" + std::to_string(i));
+      }
+
+      physics::WorldPtr world = physics::create_world();
+
+      // Create the world
+      try
+      {
+        physics::load_world(world, copyElem);
+      }
+      catch(common::Exception &e)
+      {
+        gzthrow("Failed to load the World\n"  << e);
+      }
+      this->dataPtr->worlds.push_back(world);
     }
   }
 
@@ -604,11 +875,35 @@ bool Server::LoadImpl(sdf::ElementPtr _elem,
       << " seconds for namespaces. Giving up.\n";
   }
 
+  // Preloads still running finish before the first plugin loads
+  for (auto &preload : this->dataPtr->pluginPreloads)
+    preload.wait();
+  this->dataPtr->pluginPreloads.clear();
+
   if (this->dataPtr->lockstep)
     physics::init_worlds(rendering::update_scene_poses);
   else
     physics::init_worlds(nullptr);
 
+  if (this->dataPtr->worlds.size() > 1)
+    physics::spread_worlds();
+
+  // The state of the worlds once loaded, which warm restarts go back to
+  if (this->dataPtr->warm)
+  {
+    this->dataPtr->warmWorlds.clear();
+    for (auto const &world : this->dataPtr->worlds)
+    {
+      ServerPrivate::WarmWorld warm;
+      warm.world = world;
+      warm.snapshot = world->StateSnapshot();
+      warm.paused = world->IsPaused();
+      for (auto const &model : world->Models())
+        warm.models.insert(model->GetName());
+      this->dataPtr->warmWorlds.push_back(warm);
+    }
+  }
+
   this->dataPtr->stop = false;
 
   return true;
@@ -624,6 +919,13 @@ void Server::SigInt(int)
   event::Events::sigInt();
 }
 
+/////////////////////////////////////////////////
+void Server::SigUsr1(int)
+{
+  // The capture is started or stopped by Run, outside of the handler
+  ServerPrivate::traceToggle = true;
+}
+
 /////////////////////////////////////////////////
 void Server::Stop()
 {
@@ -635,6 +937,7 @@ void Server::Stop()
 void Server::Fini()
 {
   this->Stop();
+  this->dataPtr->worlds.clear();
   gazebo::shutdown();
 }
 
@@ -660,6 +963,20 @@ void Server::Run()
   //   std::cerr << "sigaction(15) failed while setting up for SIGTERM"
   //             << std::endl;
   // }
+
+  struct sigaction traceSigact;
+  traceSigact.sa_flags = 0;
+  traceSigact.sa_handler = Server::SigUsr1;
+  if (sigemptyset(&traceSigact.sa_mask) != 0)
+  {
+    std::cerr << "sigemptyset failed while setting up for SIGUSR1"
+              << std::endl;
+  }
+  if (sigaction(SIGUSR1, &traceSigact, NULL))
+  {
+    std::cerr << "sigaction(10) failed while setting up for SIGUSR1"
+              << std::endl;
+  }
 #endif
 
   if (this->dataPtr->stop)
@@ -709,6 +1026,18 @@ void Server::Run()
     this->ProcessControlMsgs();
     IGN_PROFILE_END();
 
+    if (ServerPrivate::traceToggle.exchange(false))
+    {
+      common::TraceCapture *trace = common::TraceCapture::Instance();
+      if (!trace->Stop())
+      {
+        double duration = common::TraceCapture::kDefaultDuration;
+        if (this->dataPtr->vm.count("trace_duration"))
+          duration = this->dataPtr->vm["trace_duration"].as<double>();
+        trace->Start("", duration);
+      }
+    }
+
     if (physics::worlds_running())
     {
       IGN_PROFILE_BEGIN("run_once");
@@ -726,7 +1055,11 @@ void Server::Run()
       common::Time::MSleep(1);
   }
 
+  // Write the trace of a capture still running
+  common::TraceCapture::Instance()->Stop();
+
   // Shutdown gazebo
+  this->dataPtr->worlds.clear();
   gazebo::shutdown();
 }
 
@@ -750,6 +1083,33 @@ void Server::ProcessParams()
       params.filter = this->dataPtr->vm["record_filter"].as<std::string>();
       params.recordResources =
           this->dataPtr->params.count("record_resources") > 0;
+      params.overflowPolicy =
+          this->dataPtr->vm["record_overflow"].as<std::string>();
+      if (this->dataPtr->vm.count("record_topic"))
+      {
+        params.topics =
+          this->dataPtr->vm["record_topic"].as<std::vector<std::string>>();
+      }
+      if (this->dataPtr->vm.count("record_segment_size"))
+      {
+        params.segmentSize = static_cast<uint64_t>(
+            this->dataPtr->vm["record_segment_size"].as<double>() * 1e6);
+      }
+      if (this->dataPtr->vm.count("record_segment_duration"))
+      {
+        params.segmentDuration =
+          this->dataPtr->vm["record_segment_duration"].as<double>();
+      }
+      if (this->dataPtr->vm.count("record_upload"))
+      {
+        params.uploadCommand =
+          this->dataPtr->vm["record_upload"].as<std::string>();
+      }
+      if (this->dataPtr->vm.count("record_max_disk"))
+      {
+        params.maxDiskUsage = static_cast<uint64_t>(
+            this->dataPtr->vm["record_max_disk"].as<double>() * 1e6);
+      }
       util::LogRecord::Instance()->Start(params);
     }
   }
@@ -854,6 +1214,10 @@ void Server::ProcessControlMsgs()
         worldMsg.set_cloned_uri("http://" + host + ":" + port);
       this->dataPtr->worldModPub->Publish(worldMsg);
     }
+    else if ((*iter).has_warm_restart() && (*iter).warm_restart())
+    {
+      this->WarmRestart();
+    }
     else if ((*iter).has_save_world_name())
     {
       // Get the world pointer.
@@ -889,6 +1253,51 @@ void Server::ProcessControlMsgs()
   this->dataPtr->controlMsgs.clear();
 }
 
+/////////////////////////////////////////////////
+void Server::WarmRestart()
+{
+  if (!this->dataPtr->warm)
+  {
+    gzerr << "Warm restart requested, but the server was not started with "
+          << "--warm\n";
+    return;
+  }
+
+  for (auto const &warm : this->dataPtr->warmWorlds)
+  {
+    physics::WorldPtr world = warm.world;
+    world->SetPaused(true);
+
+    // Models inserted by the previous session
+    std::vector<std::string> inserted;
+    for (auto const &model : world->Models())
+    {
+      if (warm.models.count(model->GetName()) == 0)
+        inserted.push_back(model->GetName());
+    }
+    for (auto const &name : inserted)
+      world->RemoveModel(name);
+
+    // The reset covers the time and the plugins, the snapshot the state of
+    // the models at the end of the load. The snapshot is refused when the
+    // previous session removed a model, since the world cannot get it back.
+    world->Reset();
+    const bool success = world->RestoreStateSnapshot(warm.snapshot);
+    if (!success)
+    {
+      gzerr << "Unable to restore the warm state of world ["
+            << world->Name() << "], restart the server\n";
+    }
+    world->SetPaused(warm.paused);
+
+    // Notify the result.
+    msgs::WorldModify worldMsg;
+    worldMsg.set_world_name(world->Name());
+    worldMsg.set_warm_restarted(success);
+    this->dataPtr->worldModPub->Publish(worldMsg);
+  }
+}
+
 /////////////////////////////////////////////////
 bool Server::OpenWorld(const std::string & /*_filename*/)
 {
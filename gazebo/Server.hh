@@ -98,6 +98,10 @@ namespace gazebo
     /// \param[in] _v Unused.
     private: static void SigInt(int _v);
 
+    /// \brief SIGUSR1 handler, starts or stops a trace capture.
+    /// \param[in] _v Unused.
+    private: static void SigUsr1(int _v);
+
     /// \brief Process all command line parameters.
     private: void ProcessParams();
 
@@ -113,6 +117,10 @@ namespace gazebo
     /// \brief Handle all control messages.
     private: void ProcessControlMsgs();
 
+    /// \brief Bring the worlds back to the state captured after they were
+    /// loaded, in warm mode. Models inserted since are removed.
+    private: void WarmRestart();
+
     /// \internal
     /// \brief Pointer to private data.
     private: std::unique_ptr<ServerPrivate> dataPtr;
@@ -22,6 +22,7 @@
 #include <cstring>
 #include <string>
 #include <fstream>
+#include <future>
 #include <vector>
 
 #include <fcntl.h>
@@ -45,6 +46,7 @@
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/FuelModelDatabase.hh"
+#include "gazebo/common/ModelDatabase.hh"
 #include "gazebo/common/SystemPaths.hh"
 
 #ifdef _WIN32
@@ -200,6 +202,17 @@ std::string common::find_file_path(const std::string &_file)
   }
 }
 
+/////////////////////////////////////////////////
+void common::prefetch_uris(const std::vector<std::string> &_uris)
+{
+  auto fuel = std::async(std::launch::async, [&_uris]()
+      {
+        common::FuelModelDatabase::Instance()->Prefetch(_uris);
+      });
+  common::ModelDatabase::Instance()->Prefetch(_uris);
+  fuel.wait();
+}
+
 /////////////////////////////////////////////////
 const char *common::getEnv(const char *_name)
 {
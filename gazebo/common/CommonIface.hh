@@ -72,6 +72,14 @@ namespace gazebo
     GZ_COMMON_VISIBLE
     std::string find_file_path(const std::string &_file);
 
+    /// \brief Download, in one batch, the models referenced by the given
+    /// URIs that are not available locally yet. model:// URIs are fetched
+    /// from the model database and http(s) URIs from Ignition Fuel, both
+    /// at the same time.
+    /// \param[in] _uris URIs of models or of files inside models.
+    GZ_COMMON_VISIBLE
+    void prefetch_uris(const std::vector<std::string> &_uris);
+
     /// \brief Compute the SHA1 hash of an array of bytes.
     /// \param[in] _buffer Input sequence. The permitted data types for this
     /// function are std::string and any STL container.
@@ -14,7 +14,17 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string/regex.hpp>
@@ -29,6 +39,331 @@
 using namespace gazebo;
 using namespace common;
 
+/// \brief Destination of a message.
+enum ConsoleTarget
+{
+  /// \brief Standard output.
+  TARGET_STDOUT,
+
+  /// \brief Standard error.
+  TARGET_STDERR,
+
+  /// \brief Log file.
+  TARGET_FILE
+};
+
+/// \brief A message to write.
+struct ConsoleEntry
+{
+  /// \brief Destination.
+  ConsoleTarget target;
+
+  /// \brief Terminal color.
+  int color;
+
+  /// \brief Text, usually complete lines.
+  std::string text;
+
+  /// \brief Log file stream, for TARGET_FILE.
+  std::ostream *file;
+};
+
+/// \brief Serializes the writes to the terminal and to the log file.
+static std::mutex g_writeMutex;
+
+/// \brief Write a message. g_writeMutex must be locked.
+/// \param[in] _entry Message to write.
+static void WriteEntry(const ConsoleEntry &_entry)
+{
+  if (_entry.target == TARGET_FILE)
+  {
+    if (_entry.file)
+      *_entry.file << _entry.text;
+    return;
+  }
+
+  std::ostream &out = _entry.target == TARGET_STDOUT ? std::cout : std::cerr;
+#ifndef _WIN32
+  out << "\033[1;" << _entry.color << "m" << _entry.text << "\033[0m";
+#else
+  out << _entry.text;
+#endif
+}
+
+/// \brief Last message of a logger, for the duplicate suppression.
+struct ConsoleLine
+{
+  /// \brief Text of the message.
+  std::string text;
+
+  /// \brief Time the message was last written.
+  std::chrono::steady_clock::time_point written;
+
+  /// \brief Number of copies suppressed since then.
+  uint64_t repeats = 0;
+};
+
+/// \brief Writes the messages from a background thread, for the
+/// asynchronous output. Without the thread, messages are written by the
+/// calling thread.
+class ConsoleWriter
+{
+  /// \brief Start the background thread.
+  public: void Start()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->running)
+      return;
+    this->running = true;
+    this->thread = std::thread(&ConsoleWriter::Run, this);
+  }
+
+  /// \brief Write the queued messages and stop the background thread.
+  public: void Stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (!this->running)
+        return;
+      this->running = false;
+    }
+    this->queueCond.notify_all();
+    this->spaceCond.notify_all();
+    this->thread.join();
+  }
+
+  /// \brief Tell whether the background thread runs.
+  /// \return True if messages are queued.
+  public: bool Running() const
+  {
+    return this->running;
+  }
+
+  /// \brief Queue a message, or write it if the background thread does not
+  /// run.
+  /// \param[in] _entry Message.
+  public: void Write(ConsoleEntry &&_entry)
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if (this->running && this->queue.size() >= this->capacity)
+    {
+      switch (this->policy)
+      {
+        case Console::OVERFLOW_BLOCK:
+          this->spaceCond.wait(lock, [this]
+              {return !this->running || this->queue.size() < this->capacity;});
+          break;
+        case Console::OVERFLOW_DROP_NEWEST:
+          ++this->dropped;
+          return;
+        case Console::OVERFLOW_DROP_OLDEST:
+        default:
+          this->queue.pop_front();
+          ++this->dropped;
+          break;
+      }
+    }
+
+    if (!this->running)
+    {
+      lock.unlock();
+      std::lock_guard<std::mutex> writeLock(g_writeMutex);
+      WriteEntry(_entry);
+      if (_entry.file)
+        _entry.file->flush();
+      return;
+    }
+
+    this->queue.push_back(std::move(_entry));
+    lock.unlock();
+    this->queueCond.notify_one();
+  }
+
+  /// \brief Check a message of a logger against its previous message.
+  /// \param[in] _logger Logger.
+  /// \param[in] _text Message.
+  /// \param[out] _note Report of the suppressed copies of the previous
+  /// message, to write before _text.
+  /// \return False if the message is a duplicate to suppress.
+  public: bool Admit(const void *_logger, const std::string &_text,
+      std::string &_note)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->window <= std::chrono::steady_clock::duration::zero())
+      return true;
+
+    const auto now = std::chrono::steady_clock::now();
+    ConsoleLine &line = this->lines[_logger];
+    if (line.text == _text && now - line.written < this->window)
+    {
+      ++line.repeats;
+      ++this->suppressed;
+      return false;
+    }
+
+    if (line.repeats > 0)
+    {
+      _note = "(last message repeated " + std::to_string(line.repeats) +
+        " times)\n";
+    }
+    line.text = _text;
+    line.written = now;
+    line.repeats = 0;
+    return true;
+  }
+
+  /// \brief Wait until the queued messages are written.
+  public: void Flush()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->flushCond.wait(lock, [this]
+        {return this->queue.empty() && !this->writing;});
+  }
+
+  /// \brief Background thread.
+  private: void Run()
+  {
+    std::deque<ConsoleEntry> batch;
+    std::vector<std::ostream *> files;
+    uint64_t reported = 0;
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true)
+    {
+      this->queueCond.wait(lock, [this]
+          {return !this->queue.empty() || !this->running;});
+      if (this->queue.empty())
+        break;
+
+      batch.swap(this->queue);
+      const uint64_t dropped = this->dropped;
+      this->writing = true;
+      lock.unlock();
+      this->spaceCond.notify_all();
+
+      {
+        std::lock_guard<std::mutex> writeLock(g_writeMutex);
+        for (const auto &entry : batch)
+        {
+          WriteEntry(entry);
+          if (entry.file &&
+              std::find(files.begin(), files.end(), entry.file) == files.end())
+          {
+            files.push_back(entry.file);
+          }
+        }
+
+        if (dropped != reported)
+        {
+          WriteEntry({TARGET_STDERR, 33, "[Wrn] " +
+              std::to_string(dropped - reported) +
+              " console messages dropped, the queue was full\n", nullptr});
+          reported = dropped;
+        }
+
+        // One flush per batch instead of one per message
+        std::cout.flush();
+        std::cerr.flush();
+        for (auto file : files)
+          file->flush();
+      }
+      batch.clear();
+      files.clear();
+
+      lock.lock();
+      this->writing = false;
+      this->flushCond.notify_all();
+    }
+
+    this->flushCond.notify_all();
+  }
+
+  /// \brief Maximum number of queued messages.
+  public: size_t capacity = 4096;
+
+  /// \brief Overflow policy.
+  public: Console::OverflowPolicy policy = Console::OVERFLOW_DROP_OLDEST;
+
+  /// \brief Duplicate suppression period.
+  public: std::chrono::steady_clock::duration window =
+    std::chrono::seconds(1);
+
+  /// \brief Number of messages dropped.
+  public: uint64_t dropped = 0;
+
+  /// \brief Number of duplicate messages suppressed.
+  public: uint64_t suppressed = 0;
+
+  /// \brief Protects the members, except running.
+  public: std::mutex mutex;
+
+  /// \brief True while the background thread runs.
+  private: std::atomic<bool> running{false};
+
+  /// \brief True while the background thread writes a batch.
+  private: bool writing = false;
+
+  /// \brief Queued messages.
+  private: std::deque<ConsoleEntry> queue;
+
+  /// \brief Last message of each logger.
+  private: std::unordered_map<const void *, ConsoleLine> lines;
+
+  /// \brief Signaled when a message is queued.
+  private: std::condition_variable queueCond;
+
+  /// \brief Signaled when the queue has room.
+  private: std::condition_variable spaceCond;
+
+  /// \brief Signaled when a batch is written.
+  private: std::condition_variable flushCond;
+
+  /// \brief Background thread.
+  private: std::thread thread;
+};
+
+/// \brief Get the writer. It is never destroyed, so that messages logged
+/// by static destructors are still written.
+/// \return The writer.
+static ConsoleWriter &Writer()
+{
+  static ConsoleWriter *writer = new ConsoleWriter();
+  return *writer;
+}
+
+/// \brief Text written to the loggers by a thread and not output yet.
+struct PendingTexts
+{
+  /// \brief Destructor.
+  ~PendingTexts();
+
+  /// \brief Text of each logger buffer.
+  std::unordered_map<const std::streambuf *, std::string> texts;
+};
+
+/// \brief True once the pending texts of the thread are destroyed.
+static thread_local bool t_pendingGone = false;
+
+/// \brief Pending texts of the thread.
+static thread_local PendingTexts t_pending;
+
+//////////////////////////////////////////////////
+PendingTexts::~PendingTexts()
+{
+  t_pendingGone = true;
+}
+
+/// \brief Get the text of a logger buffer not output yet by the calling
+/// thread. The buffers of the threads need no lock.
+/// \param[in] _buf Logger buffer.
+/// \return The text, or null while the thread exits.
+static std::string *PendingText(const std::streambuf *_buf)
+{
+  if (t_pendingGone)
+    return nullptr;
+  return &t_pending.texts[_buf];
+}
+
 FileLogger gazebo::common::Console::log("");
 Logger Console::msg("[Msg] ", 32, Logger::STDOUT);
 Logger Console::err("[Err] ", 31, Logger::STDERR);
@@ -37,6 +372,17 @@ Logger Console::warn("[Wrn] ", 33, Logger::STDERR);
 
 bool Console::quiet = true;
 
+/// \brief Writes the queued messages at exit, before the loggers above are
+/// destroyed.
+static struct ConsoleWriterGuard
+{
+  /// \brief Destructor.
+  ~ConsoleWriterGuard()
+  {
+    Writer().Stop();
+  }
+} g_writerGuard;
+
 //////////////////////////////////////////////////
 void Console::SetQuiet(bool _quiet)
 {
@@ -49,6 +395,64 @@ bool Console::GetQuiet()
   return quiet;
 }
 
+//////////////////////////////////////////////////
+void Console::SetAsync(const bool _async)
+{
+  if (_async)
+    Writer().Start();
+  else
+    Writer().Stop();
+}
+
+//////////////////////////////////////////////////
+bool Console::Async()
+{
+  return Writer().Running();
+}
+
+//////////////////////////////////////////////////
+void Console::SetQueueSize(const size_t _size)
+{
+  std::lock_guard<std::mutex> lock(Writer().mutex);
+  Writer().capacity = std::max<size_t>(_size, 1);
+}
+
+//////////////////////////////////////////////////
+void Console::SetOverflowPolicy(const OverflowPolicy _policy)
+{
+  std::lock_guard<std::mutex> lock(Writer().mutex);
+  Writer().policy = _policy;
+}
+
+//////////////////////////////////////////////////
+void Console::SetDuplicateWindow(const double _seconds)
+{
+  std::lock_guard<std::mutex> lock(Writer().mutex);
+  Writer().window = std::chrono::duration_cast<
+    std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(std::max(_seconds, 0.0)));
+}
+
+//////////////////////////////////////////////////
+void Console::Flush()
+{
+  Writer().Flush();
+}
+
+//////////////////////////////////////////////////
+uint64_t Console::DroppedCount()
+{
+  std::lock_guard<std::mutex> lock(Writer().mutex);
+  return Writer().dropped;
+}
+
+//////////////////////////////////////////////////
+uint64_t Console::SuppressedCount()
+{
+  std::lock_guard<std::mutex> lock(Writer().mutex);
+  return Writer().suppressed;
+}
+
 /////////////////////////////////////////////////
 Logger::Logger(const std::string &_prefix, int _color, LogType _type)
   : std::ostream(new Buffer(_type, _color)), color(_color), prefix(_prefix)
@@ -62,9 +466,31 @@ Logger::~Logger()
   delete this->rdbuf();
 }
 
+/////////////////////////////////////////////////
+/// \brief Output the text of a logger buffer left without a newline by the
+/// calling thread, so that a new message starts on its own line.
+/// \param[in] _buf Logger buffer.
+/// \param[in] _output Function outputting the text.
+template<typename F>
+static void OutputUnfinishedLine(const std::streambuf *_buf, const F &_output)
+{
+  std::string *pending = PendingText(_buf);
+  if (!pending || pending->empty())
+    return;
+
+  std::string text;
+  text.swap(*pending);
+  text += '\n';
+  _output(text);
+}
+
 /////////////////////////////////////////////////
 Logger &Logger::operator()()
 {
+  Buffer *buf = static_cast<Buffer *>(this->rdbuf());
+  OutputUnfinishedLine(buf, [buf](const std::string &_text)
+      {buf->Output(_text);});
+
   Console::log << "(" << Time::GetWallTime() << ") ";
   (*this) << this->prefix;
 
@@ -74,6 +500,10 @@ Logger &Logger::operator()()
 /////////////////////////////////////////////////
 Logger &Logger::operator()(const std::string &_file, int _line)
 {
+  Buffer *buf = static_cast<Buffer *>(this->rdbuf());
+  OutputUnfinishedLine(buf, [buf](const std::string &_text)
+      {buf->Output(_text);});
+
   int index = _file.find_last_of("/") + 1;
 
   Console::log << "(" << Time::GetWallTime() << ") ";
@@ -106,36 +536,78 @@ Logger::Buffer::~Buffer()
   }
 }
 
+/////////////////////////////////////////////////
+std::streamsize Logger::Buffer::xsputn(const char *_s, std::streamsize _n)
+{
+  std::string *pending = PendingText(this);
+  if (pending)
+    pending->append(_s, _n);
+  else
+    this->Output(std::string(_s, _n));
+  return _n;
+}
+
+/////////////////////////////////////////////////
+Logger::Buffer::int_type Logger::Buffer::overflow(int_type _c)
+{
+  if (traits_type::eq_int_type(_c, traits_type::eof()))
+    return traits_type::not_eof(_c);
+
+  const char c = traits_type::to_char_type(_c);
+  this->xsputn(&c, 1);
+  return _c;
+}
+
 /////////////////////////////////////////////////
 int Logger::Buffer::sync()
 {
+  std::string *pending = PendingText(this);
+  if (!pending || pending->empty())
+    return 0;
+
+  std::string text;
+  if (!Writer().Running())
+  {
+    text.swap(*pending);
+  }
+  else
+  {
+    // Queue complete lines only, so that the messages of several threads do
+    // not mix
+    const size_t end = pending->rfind('\n');
+    if (end == std::string::npos)
+      return 0;
+    text = pending->substr(0, end + 1);
+    pending->erase(0, end + 1);
+  }
+
+  this->Output(text);
+  return 0;
+}
+
+/////////////////////////////////////////////////
+void Logger::Buffer::Output(const std::string &_text)
+{
+  std::string note;
+  if (Writer().Running() && !Writer().Admit(this, _text, note))
+  {
+    // Drop the time stamp of the suppressed message from the log file
+    std::string *stamp = PendingText(Console::log.rdbuf());
+    if (stamp)
+      stamp->clear();
+    return;
+  }
+
   // Log messages to disk
-  Console::log << this->str();
+  Console::log << note << _text;
   Console::log.flush();
 
   // Output to terminal
   if (!Console::GetQuiet())
   {
-    if (this->type == Logger::STDOUT)
-    {
-      #ifndef _WIN32
-      std::cout << "\033[1;" << this->color << "m" << this->str() << "\033[0m";
-      #else
-      std::cout << this->str();
-      #endif
-    }
-    else
-    {
-      #ifndef _WIN32
-      std::cerr << "\033[1;" << this->color << "m" << this->str() << "\033[0m";
-      #else
-      std::cerr << this->str();
-      #endif
-    }
+    Writer().Write({this->type == Logger::STDOUT ? TARGET_STDOUT :
+        TARGET_STDERR, this->color, note + _text, nullptr});
   }
-
-  this->str("");
-  return 0;
 }
 
 /////////////////////////////////////////////////
@@ -165,6 +637,9 @@ void FileLogger::Init(const std::string &_prefix, const std::string &_filename)
   FileLogger::Buffer *buf = static_cast<FileLogger::Buffer*>(
       this->rdbuf());
 
+  // Write the queued messages to the current file first
+  Console::Flush();
+
   boost::filesystem::path logPath(getenv("HOME"));
 
   // Create a subdirectory for the informational log. The name of the directory
@@ -180,6 +655,9 @@ void FileLogger::Init(const std::string &_prefix, const std::string &_filename)
 
   logPath /= _filename;
 
+  // The background writer does not use the stream meanwhile
+  std::lock_guard<std::mutex> lock(g_writeMutex);
+
   // Check if the Init method has been already called, and if so
   // remove current buffer.
   if (buf->stream && buf->stream->is_open())
@@ -226,6 +704,9 @@ void FileLogger::Init(const std::string &_prefix, const std::string &_filename)
 /////////////////////////////////////////////////
 FileLogger &FileLogger::operator()()
 {
+  OutputUnfinishedLine(this->rdbuf(), [this](const std::string &_text)
+      {(*this) << _text;});
+
   (*this) << "(" << Time::GetWallTime() << ") ";
   return (*this);
 }
@@ -233,6 +714,9 @@ FileLogger &FileLogger::operator()()
 /////////////////////////////////////////////////
 FileLogger &FileLogger::operator()(const std::string &_file, int _line)
 {
+  OutputUnfinishedLine(this->rdbuf(), [this](const std::string &_text)
+      {(*this) << _text;});
+
   int index = _file.find_last_of("/") + 1;
   (*this) << "(" << Time::GetWallTime() << ") ["
     << _file.substr(index , _file.size() - index) << ":" << _line << "]";
@@ -288,16 +772,60 @@ FileLogger::Buffer::~Buffer()
   }
 }
 
+/////////////////////////////////////////////////
+std::streamsize FileLogger::Buffer::xsputn(const char *_s,
+    std::streamsize _n)
+{
+  std::string *pending = PendingText(this);
+  if (pending)
+  {
+    pending->append(_s, _n);
+  }
+  else if (this->stream)
+  {
+    std::lock_guard<std::mutex> lock(g_writeMutex);
+    this->stream->write(_s, _n);
+  }
+  return _n;
+}
+
+/////////////////////////////////////////////////
+FileLogger::Buffer::int_type FileLogger::Buffer::overflow(int_type _c)
+{
+  if (traits_type::eq_int_type(_c, traits_type::eof()))
+    return traits_type::not_eof(_c);
+
+  const char c = traits_type::to_char_type(_c);
+  this->xsputn(&c, 1);
+  return _c;
+}
+
 /////////////////////////////////////////////////
 int FileLogger::Buffer::sync()
 {
-  if (!this->stream)
-    return -1;
+  std::string *pending = PendingText(this);
+  if (!pending || pending->empty())
+    return 0;
 
-  *this->stream << this->str();
+  if (!Writer().Running())
+  {
+    // The text is kept until the log file is opened
+    if (!this->stream)
+      return -1;
+
+    std::lock_guard<std::mutex> lock(g_writeMutex);
+    *this->stream << *pending;
+    this->stream->flush();
+    pending->clear();
+    return !(*this->stream);
+  }
 
-  this->stream->flush();
+  const size_t end = pending->rfind('\n');
+  if (end == std::string::npos)
+    return 0;
 
-  this->str("");
-  return !(*this->stream);
+  Writer().Write({TARGET_FILE, 0, pending->substr(0, end + 1),
+      this->stream});
+  pending->erase(0, end + 1);
+  return 0;
 }
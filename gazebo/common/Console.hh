@@ -18,6 +18,8 @@
 #ifndef _GAZEBO_CONSOLE_HH_
 #define _GAZEBO_CONSOLE_HH_
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -107,7 +109,8 @@ namespace gazebo
       /// \return The port of the master.
       private: static std::string GetMasterPort();
 
-      /// \brief String buffer for the file logger.
+      /// \brief String buffer for the file logger. The text is kept in a
+      /// buffer of the calling thread until the stream is synced.
       protected: class Buffer : public std::stringbuf
                  {
                    /// \brief Constructor.
@@ -118,10 +121,25 @@ namespace gazebo
                    public: virtual ~Buffer();
 
                    /// \brief Sync the stream (output the string buffer
-                   /// contents).
+                   /// contents). With asynchronous output, the complete
+                   /// lines are queued for the background writer.
                    /// \return Return 0 on success.
                    public: virtual int sync();
 
+                   /// \brief Append characters to the buffer of the
+                   /// calling thread.
+                   /// \param[in] _s Characters.
+                   /// \param[in] _n Number of characters.
+                   /// \return _n.
+                   protected: virtual std::streamsize xsputn(const char *_s,
+                                  std::streamsize _n);
+
+                   /// \brief Append a character to the buffer of the
+                   /// calling thread.
+                   /// \param[in] _c Character.
+                   /// \return _c, or not_eof(_c) for an end of file.
+                   protected: virtual int_type overflow(int_type _c);
+
                    /// \brief Stream to output information into.
                    public: std::ofstream *stream;
                  };
@@ -166,7 +184,8 @@ namespace gazebo
       public: virtual Logger &operator()(
                   const std::string &_file, int _line);
 
-      /// \brief String buffer for the base logger.
+      /// \brief String buffer for the base logger. The text is kept in a
+      /// buffer of the calling thread until the stream is synced.
       protected: class Buffer : public std::stringbuf
                  {
                    /// \brief Constructor.
@@ -179,10 +198,30 @@ namespace gazebo
                    public: virtual ~Buffer();
 
                    /// \brief Sync the stream (output the string buffer
-                   /// contents).
+                   /// contents). With asynchronous output, the complete
+                   /// lines are queued for the background writer.
                    /// \return Return 0 on success.
                    public: virtual int sync();
 
+                   /// \brief Append characters to the buffer of the
+                   /// calling thread.
+                   /// \param[in] _s Characters.
+                   /// \param[in] _n Number of characters.
+                   /// \return _n.
+                   protected: virtual std::streamsize xsputn(const char *_s,
+                                  std::streamsize _n);
+
+                   /// \brief Append a character to the buffer of the
+                   /// calling thread.
+                   /// \param[in] _c Character.
+                   /// \return _c, or not_eof(_c) for an end of file.
+                   protected: virtual int_type overflow(int_type _c);
+
+                   /// \brief Output text, or queue it with asynchronous
+                   /// output.
+                   /// \param[in] _text Text to output.
+                   public: void Output(const std::string &_text);
+
                    /// \brief Destination type for the messages.
                    public: LogType type;
 
@@ -204,6 +243,18 @@ namespace gazebo
     /// (such as verbose vs. quiet output).
     class GZ_COMMON_VISIBLE Console
     {
+      /// \brief What happens to a message when the queue of the
+      /// asynchronous output is full.
+      public: enum OverflowPolicy
+              {
+                /// \brief Wait for the writer to make room.
+                OVERFLOW_BLOCK,
+                /// \brief Drop the new message.
+                OVERFLOW_DROP_NEWEST,
+                /// \brief Drop the oldest queued message.
+                OVERFLOW_DROP_OLDEST
+              };
+
       /// \brief Set quiet output.
       /// \param[in] q True to prevent warning.
       public: static void SetQuiet(bool _q);
@@ -212,6 +263,48 @@ namespace gazebo
       /// \return True to if quiet output is set.
       public: static bool GetQuiet();
 
+      /// \brief Write the messages from a background thread, so that the
+      /// threads logging do not wait for the terminal or the disk. Messages
+      /// are then output line by line: a line is queued once it ends with
+      /// a newline, or when the next message of the same logger and thread
+      /// starts. Disabling it writes the queued messages first.
+      /// \param[in] _async True to enable asynchronous output.
+      public: static void SetAsync(const bool _async);
+
+      /// \brief Get whether the output is asynchronous.
+      /// \return True if the messages are written by a background thread.
+      public: static bool Async();
+
+      /// \brief Set the number of queued messages above which the overflow
+      /// policy applies. The default is 4096.
+      /// \param[in] _size Maximum number of queued messages.
+      public: static void SetQueueSize(const size_t _size);
+
+      /// \brief Set what happens to a message when the queue is full. The
+      /// default is OVERFLOW_DROP_OLDEST.
+      /// \param[in] _policy Overflow policy.
+      public: static void SetOverflowPolicy(const OverflowPolicy _policy);
+
+      /// \brief Set the period during which a message equal to the
+      /// previous message of the same logger is counted instead of being
+      /// written, with asynchronous output. The count is reported with the
+      /// next message written. The default is 1 second, and 0 disables the
+      /// suppression.
+      /// \param[in] _seconds Suppression period in seconds.
+      public: static void SetDuplicateWindow(const double _seconds);
+
+      /// \brief Wait until the queued messages are written.
+      public: static void Flush();
+
+      /// \brief Get the number of messages dropped because the queue was
+      /// full.
+      /// \return Number of dropped messages.
+      public: static uint64_t DroppedCount();
+
+      /// \brief Get the number of duplicate messages suppressed.
+      /// \return Number of suppressed messages.
+      public: static uint64_t SuppressedCount();
+
       /// \brief Global instance of the message logger.
       public: static Logger msg;
 
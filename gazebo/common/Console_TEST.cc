@@ -19,6 +19,10 @@
 #include <boost/filesystem.hpp>
 #include <stdlib.h>
 
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/Console.hh"
 #include "test/util.hh"
@@ -274,6 +278,88 @@ TEST_F(Console_TEST, ColorErr)
   EXPECT_TRUE(logContent.find(logString) != std::string::npos);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test the asynchronous output
+TEST_F(Console_TEST, Async)
+{
+  gazebo::common::Console::SetAsync(true);
+  EXPECT_TRUE(gazebo::common::Console::Async());
+
+  // Messages from several threads reach the log file as whole lines
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.push_back(std::thread([t]()
+    {
+      for (int i = 0; i < 50; ++i)
+        gzwarn << "async test " << t << " line " << i << std::endl;
+    }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+  gazebo::common::Console::Flush();
+
+  std::string logContent = this->GetLogContent();
+  for (int t = 0; t < 4; ++t)
+  {
+    for (int i = 0; i < 50; ++i)
+    {
+      std::ostringstream stream;
+      stream << "async test " << t << " line " << i << "\n";
+      EXPECT_TRUE(logContent.find(stream.str()) != std::string::npos)
+          << stream.str();
+    }
+  }
+
+  // Copies of a message are suppressed, then counted in the next message
+  const uint64_t suppressed = gazebo::common::Console::SuppressedCount();
+  for (int i = 0; i < 20; ++i)
+    gzwarn << "duplicate test" << std::endl;
+  gzwarn << "after duplicates" << std::endl;
+  gazebo::common::Console::Flush();
+
+  EXPECT_EQ(suppressed + 19, gazebo::common::Console::SuppressedCount());
+  logContent = this->GetLogContent();
+  const size_t first = logContent.find("duplicate test");
+  ASSERT_NE(std::string::npos, first);
+  EXPECT_EQ(std::string::npos, logContent.find("duplicate test", first + 1));
+  EXPECT_NE(std::string::npos,
+      logContent.find("(last message repeated 19 times)"));
+
+  // Without suppression, every copy is written
+  gazebo::common::Console::SetDuplicateWindow(0);
+  for (int i = 0; i < 3; ++i)
+    gzwarn << "repeated test" << std::endl;
+  gazebo::common::Console::Flush();
+  logContent = this->GetLogContent();
+  size_t count = 0;
+  for (size_t pos = logContent.find("repeated test");
+      pos != std::string::npos; pos = logContent.find("repeated test", pos + 1))
+  {
+    ++count;
+  }
+  EXPECT_EQ(3u, count);
+
+  // A small queue blocking on overflow drops nothing
+  const uint64_t dropped = gazebo::common::Console::DroppedCount();
+  gazebo::common::Console::SetQueueSize(2);
+  gazebo::common::Console::SetOverflowPolicy(
+      gazebo::common::Console::OVERFLOW_BLOCK);
+  for (int i = 0; i < 100; ++i)
+    gzlog << "blocking test " << i << std::endl;
+  gazebo::common::Console::Flush();
+  EXPECT_EQ(dropped, gazebo::common::Console::DroppedCount());
+  EXPECT_NE(std::string::npos,
+      this->GetLogContent().find("blocking test 99\n"));
+
+  gazebo::common::Console::SetQueueSize(4096);
+  gazebo::common::Console::SetOverflowPolicy(
+      gazebo::common::Console::OVERFLOW_DROP_OLDEST);
+  gazebo::common::Console::SetDuplicateWindow(1.0);
+  gazebo::common::Console::SetAsync(false);
+  EXPECT_FALSE(gazebo::common::Console::Async());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
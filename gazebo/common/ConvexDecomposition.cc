@@ -0,0 +1,720 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#include "gazebo/common/ConvexDecomposition.hh"
+#include "gazebo/common/Mesh.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace
+{
+  /// \brief Largest number of surface points used to measure the
+  /// concavity of a piece.
+  const size_t kMaxConcavitySamples = 4096u;
+
+  /// \brief Number of cut positions tried along each axis when a piece is
+  /// split.
+  const unsigned int kCutsPerAxis = 3u;
+
+  /// \brief A triangle of a hull under construction.
+  class HullFace
+  {
+    /// \brief Point indices, counter clockwise seen from outside.
+    public: int v[3];
+
+    /// \brief Outward unit normal.
+    public: ignition::math::Vector3d normal;
+
+    /// \brief Plane offset, normal.Dot(x) == offset on the plane.
+    public: double offset = 0.0;
+
+    /// \brief Points above this face that are not on the hull yet.
+    public: std::vector<int> outside;
+
+    /// \brief The outside point furthest from the face, -1 if none.
+    public: int furthest = -1;
+
+    /// \brief Distance of the furthest outside point.
+    public: double furthestDistance = 0.0;
+
+    /// \brief False once the face is inside the hull.
+    public: bool valid = true;
+  };
+
+  /// \brief A closed convex hull.
+  class Hull
+  {
+    /// \brief Hull vertices.
+    public: std::vector<ignition::math::Vector3d> vertices;
+
+    /// \brief Triangle indices into vertices.
+    public: std::vector<unsigned int> indices;
+
+    /// \brief Outward unit normal of each triangle.
+    public: std::vector<ignition::math::Vector3d> normals;
+
+    /// \brief Plane offset of each triangle.
+    public: std::vector<double> offsets;
+  };
+
+  /// \brief Compute a convex hull with the quickhull algorithm. The point
+  /// furthest from the current hull is added first, so a vertex limit
+  /// keeps the points that matter most.
+  /// \param[in] _points The points.
+  /// \param[in] _maxVertices Largest number of hull vertices, 0 for no
+  /// limit.
+  /// \param[out] _hull The hull.
+  /// \return False if the points are flat.
+  bool ComputeHull(const std::vector<ignition::math::Vector3d> &_points,
+      const unsigned int _maxVertices, Hull &_hull)
+  {
+    if (_points.size() < 4u)
+      return false;
+
+    ignition::math::Vector3d min = _points[0];
+    ignition::math::Vector3d max = _points[0];
+    for (const auto &p : _points)
+    {
+      min.Min(p);
+      max.Max(p);
+    }
+    const double diagonal = (max - min).Length();
+    if (diagonal <= 0.0)
+      return false;
+    const double eps = diagonal * 1e-9;
+
+    // Start from a tetrahedron of extreme points.
+    int extremes[6] = {0, 0, 0, 0, 0, 0};
+    for (size_t i = 0; i < _points.size(); ++i)
+    {
+      for (int a = 0; a < 3; ++a)
+      {
+        if (_points[i][a] < _points[extremes[2*a]][a])
+          extremes[2*a] = static_cast<int>(i);
+        if (_points[i][a] > _points[extremes[2*a+1]][a])
+          extremes[2*a+1] = static_cast<int>(i);
+      }
+    }
+
+    int i0 = extremes[0];
+    int i1 = extremes[1];
+    double best = 0.0;
+    for (int i = 0; i < 6; ++i)
+    {
+      for (int j = i + 1; j < 6; ++j)
+      {
+        double d = _points[extremes[i]].Distance(_points[extremes[j]]);
+        if (d > best)
+        {
+          best = d;
+          i0 = extremes[i];
+          i1 = extremes[j];
+        }
+      }
+    }
+
+    const ignition::math::Vector3d dir =
+        (_points[i1] - _points[i0]).Normalized();
+    int i2 = -1;
+    best = eps;
+    for (size_t i = 0; i < _points.size(); ++i)
+    {
+      double d = (_points[i] - _points[i0]).Cross(dir).Length();
+      if (d > best)
+      {
+        best = d;
+        i2 = static_cast<int>(i);
+      }
+    }
+    if (i2 < 0)
+      return false;
+
+    const ignition::math::Vector3d baseNormal =
+        (_points[i1] - _points[i0]).Cross(_points[i2] - _points[i0])
+        .Normalized();
+    int i3 = -1;
+    best = eps;
+    for (size_t i = 0; i < _points.size(); ++i)
+    {
+      double d = std::abs(baseNormal.Dot(_points[i] - _points[i0]));
+      if (d > best)
+      {
+        best = d;
+        i3 = static_cast<int>(i);
+      }
+    }
+    if (i3 < 0)
+      return false;
+
+    std::vector<HullFace> faces;
+    std::map<std::pair<int, int>, int> edges;
+
+    auto addFace = [&](const int _a, const int _b, const int _c) -> int
+    {
+      HullFace face;
+      face.v[0] = _a;
+      face.v[1] = _b;
+      face.v[2] = _c;
+      face.normal = (_points[_b] - _points[_a]).Cross(
+          _points[_c] - _points[_a]).Normalized();
+      face.offset = face.normal.Dot(_points[_a]);
+      int index = static_cast<int>(faces.size());
+      faces.push_back(face);
+      edges[std::make_pair(_a, _b)] = index;
+      edges[std::make_pair(_b, _c)] = index;
+      edges[std::make_pair(_c, _a)] = index;
+      return index;
+    };
+
+    std::vector<int> candidates;
+    if (baseNormal.Dot(_points[i3] - _points[i0]) > 0.0)
+    {
+      candidates.push_back(addFace(i0, i2, i1));
+      candidates.push_back(addFace(i0, i1, i3));
+      candidates.push_back(addFace(i1, i2, i3));
+      candidates.push_back(addFace(i2, i0, i3));
+    }
+    else
+    {
+      candidates.push_back(addFace(i0, i1, i2));
+      candidates.push_back(addFace(i0, i3, i1));
+      candidates.push_back(addFace(i1, i3, i2));
+      candidates.push_back(addFace(i2, i3, i0));
+    }
+
+    // Give a point to the face it is furthest above, drop it if it is
+    // inside.
+    auto assign = [&](const int _point, const std::vector<int> &_faces)
+    {
+      int bestFace = -1;
+      double bestDistance = eps;
+      for (int f : _faces)
+      {
+        double d = faces[f].normal.Dot(_points[_point]) - faces[f].offset;
+        if (d > bestDistance)
+        {
+          bestDistance = d;
+          bestFace = f;
+        }
+      }
+      if (bestFace < 0)
+        return;
+
+      HullFace &face = faces[bestFace];
+      face.outside.push_back(_point);
+      if (bestDistance > face.furthestDistance)
+      {
+        face.furthestDistance = bestDistance;
+        face.furthest = _point;
+      }
+    };
+
+    for (size_t i = 0; i < _points.size(); ++i)
+    {
+      int p = static_cast<int>(i);
+      if (p != i0 && p != i1 && p != i2 && p != i3)
+        assign(p, candidates);
+    }
+
+    unsigned int vertexCount = 4u;
+    while (_maxVertices == 0u || vertexCount < _maxVertices)
+    {
+      int start = -1;
+      double startDistance = 0.0;
+      for (size_t f = 0; f < faces.size(); ++f)
+      {
+        if (faces[f].valid && faces[f].furthest >= 0 &&
+            faces[f].furthestDistance > startDistance)
+        {
+          startDistance = faces[f].furthestDistance;
+          start = static_cast<int>(f);
+        }
+      }
+      if (start < 0)
+        break;
+
+      const int apex = faces[start].furthest;
+      const ignition::math::Vector3d &point = _points[apex];
+
+      // Find the faces that the new point sees.
+      std::vector<char> visible(faces.size(), 0);
+      std::vector<int> visibleFaces;
+      std::vector<int> stack = {start};
+      visible[start] = 1;
+      while (!stack.empty())
+      {
+        int f = stack.back();
+        stack.pop_back();
+        visibleFaces.push_back(f);
+        for (int e = 0; e < 3; ++e)
+        {
+          int n = edges[std::make_pair(faces[f].v[(e+1) % 3], faces[f].v[e])];
+          if (!visible[n] &&
+              faces[n].normal.Dot(point) - faces[n].offset > eps)
+          {
+            visible[n] = 1;
+            stack.push_back(n);
+          }
+        }
+      }
+
+      // The horizon separates the visible faces from the others.
+      std::vector<std::pair<int, int>> horizon;
+      for (int f : visibleFaces)
+      {
+        for (int e = 0; e < 3; ++e)
+        {
+          int a = faces[f].v[e];
+          int b = faces[f].v[(e+1) % 3];
+          if (!visible[edges[std::make_pair(b, a)]])
+            horizon.push_back(std::make_pair(a, b));
+        }
+      }
+
+      std::vector<int> orphans;
+      for (int f : visibleFaces)
+      {
+        for (int p : faces[f].outside)
+        {
+          if (p != apex)
+            orphans.push_back(p);
+        }
+        faces[f].outside.clear();
+        faces[f].valid = false;
+        for (int e = 0; e < 3; ++e)
+          edges.erase(std::make_pair(faces[f].v[e], faces[f].v[(e+1) % 3]));
+      }
+
+      candidates.clear();
+      for (const auto &edge : horizon)
+        candidates.push_back(addFace(edge.first, edge.second, apex));
+
+      for (int p : orphans)
+        assign(p, candidates);
+
+      ++vertexCount;
+    }
+
+    // Copy the faces, keeping only the points they use.
+    _hull = Hull();
+    std::map<int, unsigned int> remap;
+    for (const auto &face : faces)
+    {
+      if (!face.valid)
+        continue;
+
+      for (int i = 0; i < 3; ++i)
+      {
+        auto iter = remap.find(face.v[i]);
+        if (iter == remap.end())
+        {
+          iter = remap.insert(std::make_pair(face.v[i],
+              static_cast<unsigned int>(_hull.vertices.size()))).first;
+          _hull.vertices.push_back(_points[face.v[i]]);
+        }
+        _hull.indices.push_back(iter->second);
+      }
+      _hull.normals.push_back(face.normal);
+      _hull.offsets.push_back(face.offset);
+    }
+
+    return true;
+  }
+
+  /// \brief Volume of a hull.
+  /// \param[in] _hull The hull.
+  /// \return The volume.
+  double HullVolume(const Hull &_hull)
+  {
+    double volume = 0.0;
+    for (size_t i = 0; i + 2 < _hull.indices.size(); i += 3)
+    {
+      const auto &a = _hull.vertices[_hull.indices[i]];
+      const auto &b = _hull.vertices[_hull.indices[i+1]];
+      const auto &c = _hull.vertices[_hull.indices[i+2]];
+      volume += a.Dot(b.Cross(c));
+    }
+    return volume / 6.0;
+  }
+
+  /// \brief A part of the surface of the mesh being decomposed.
+  class Piece
+  {
+    /// \brief Triangle corners, three per triangle.
+    public: std::vector<ignition::math::Vector3d> corners;
+
+    /// \brief Hull of the triangles.
+    public: Hull hull;
+
+    /// \brief False if the triangles are flat.
+    public: bool hasHull = false;
+
+    /// \brief Depth of the deepest surface point inside the hull.
+    public: double concavity = 0.0;
+  };
+
+  /// \brief Compute the hull of a piece, and optionally its concavity.
+  /// \param[in] _maxVertices Largest number of hull vertices.
+  /// \param[in] _concavity True to measure the concavity.
+  /// \param[in,out] _piece The piece.
+  void BuildPiece(const unsigned int _maxVertices, const bool _concavity,
+      Piece &_piece)
+  {
+    _piece.hasHull = ComputeHull(_piece.corners, _maxVertices, _piece.hull);
+    _piece.concavity = 0.0;
+    if (!_piece.hasHull || !_concavity)
+      return;
+
+    // Corners and triangle centroids sample the surface.
+    std::vector<ignition::math::Vector3d> samples = _piece.corners;
+    for (size_t i = 0; i + 2 < _piece.corners.size(); i += 3)
+    {
+      samples.push_back((_piece.corners[i] + _piece.corners[i+1] +
+          _piece.corners[i+2]) / 3.0);
+    }
+
+    size_t stride =
+        std::max<size_t>(1u, samples.size() / kMaxConcavitySamples);
+    for (size_t i = 0; i < samples.size(); i += stride)
+    {
+      double depth = std::numeric_limits<double>::max();
+      for (size_t f = 0; f < _piece.hull.normals.size(); ++f)
+      {
+        depth = std::min(depth,
+            _piece.hull.offsets[f] - _piece.hull.normals[f].Dot(samples[i]));
+      }
+      _piece.concavity = std::max(_piece.concavity, depth);
+    }
+  }
+
+  /// \brief Clip the triangles of a piece by an axis aligned plane. The
+  /// surface on each side keeps the outline of the cut, so the hull of each
+  /// side is the hull of that side of the solid.
+  /// \param[in] _piece Piece to clip.
+  /// \param[in] _axis Axis of the plane normal.
+  /// \param[in] _cut Position of the plane along the axis.
+  /// \param[in] _eps Distance below which a point is on the plane.
+  /// \param[out] _below Part of the piece below the plane.
+  /// \param[out] _above Part of the piece above the plane.
+  void ClipPiece(const Piece &_piece, const int _axis, const double _cut,
+      const double _eps, Piece &_below, Piece &_above)
+  {
+    for (size_t t = 0; t + 2 < _piece.corners.size(); t += 3)
+    {
+      const ignition::math::Vector3d *tri = &_piece.corners[t];
+      double d[3];
+      bool anyBelow = false;
+      bool anyAbove = false;
+      for (int k = 0; k < 3; ++k)
+      {
+        d[k] = tri[k][_axis] - _cut;
+        if (std::abs(d[k]) <= _eps)
+          d[k] = 0.0;
+        anyBelow = anyBelow || d[k] < 0.0;
+        anyAbove = anyAbove || d[k] > 0.0;
+      }
+
+      if (!anyBelow || !anyAbove)
+      {
+        // A triangle in the plane bounds the side its normal points away
+        // from.
+        bool toBelow = anyBelow;
+        if (!anyBelow && !anyAbove)
+          toBelow = (tri[1] - tri[0]).Cross(tri[2] - tri[0])[_axis] > 0.0;
+        Piece &side = toBelow ? _below : _above;
+        side.corners.insert(side.corners.end(), tri, tri + 3);
+        continue;
+      }
+
+      // Sutherland-Hodgman against each side, then fan the polygons.
+      for (int s = 0; s < 2; ++s)
+      {
+        const double sign = s == 0 ? 1.0 : -1.0;
+        std::vector<ignition::math::Vector3d> polygon;
+        for (int k = 0; k < 3; ++k)
+        {
+          const int n = (k+1) % 3;
+          if (sign * d[k] <= 0.0)
+            polygon.push_back(tri[k]);
+          if (d[k] * d[n] < 0.0)
+          {
+            double u = d[k] / (d[k] - d[n]);
+            polygon.push_back(tri[k] + (tri[n] - tri[k]) * u);
+          }
+        }
+
+        Piece &side = s == 0 ? _below : _above;
+        for (size_t k = 1; k + 1 < polygon.size(); ++k)
+        {
+          side.corners.push_back(polygon[0]);
+          side.corners.push_back(polygon[k]);
+          side.corners.push_back(polygon[k+1]);
+        }
+      }
+    }
+  }
+}
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for the ConvexDecomposition class
+    class ConvexDecompositionPrivate
+    {
+      /// \brief Largest number of hulls.
+      public: unsigned int maxHulls = 16u;
+
+      /// \brief Largest number of vertices of a hull.
+      public: unsigned int maxHullVertices = 64u;
+
+      /// \brief Largest concavity, relative to the mesh size.
+      public: double concavity = 0.01;
+
+      /// \brief Decompose a set of triangles.
+      /// \param[in] _surface The triangles.
+      /// \return The hulls, or nullptr if there are none.
+      public: Mesh *Decompose(Piece &_surface) const;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+Mesh *ConvexDecompositionPrivate::Decompose(Piece &_surface) const
+{
+  if (_surface.corners.size() < 3u)
+    return nullptr;
+
+  ignition::math::Vector3d min = _surface.corners[0];
+  ignition::math::Vector3d max = min;
+  for (const auto &c : _surface.corners)
+  {
+    min.Min(c);
+    max.Max(c);
+  }
+  const double diagonal = (max - min).Length();
+  const double threshold = this->concavity * diagonal;
+  const double eps = diagonal * 1e-9;
+
+  std::vector<Piece> pieces(1);
+  pieces[0].corners.swap(_surface.corners);
+  BuildPiece(this->maxHullVertices, true, pieces[0]);
+
+  while (pieces.size() < this->maxHulls)
+  {
+    size_t worst = 0;
+    for (size_t i = 1; i < pieces.size(); ++i)
+    {
+      if (pieces[i].concavity > pieces[worst].concavity)
+        worst = i;
+    }
+    if (pieces[worst].concavity <= threshold)
+      break;
+
+    // Try a few axis aligned cuts, keep the one with the least hull volume.
+    Piece &piece = pieces[worst];
+    ignition::math::Vector3d low = piece.corners[0];
+    ignition::math::Vector3d high = low;
+    for (const auto &c : piece.corners)
+    {
+      low.Min(c);
+      high.Max(c);
+    }
+
+    double bestCost = std::numeric_limits<double>::max();
+    int bestAxis = -1;
+    double bestCut = 0.0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      for (unsigned int k = 1; k <= kCutsPerAxis; ++k)
+      {
+        double cut = low[axis] +
+            (high[axis] - low[axis]) * k / (kCutsPerAxis + 1);
+        Piece below, above;
+        ClipPiece(piece, axis, cut, eps, below, above);
+        if (below.corners.empty() || above.corners.empty())
+          continue;
+
+        BuildPiece(this->maxHullVertices, false, below);
+        BuildPiece(this->maxHullVertices, false, above);
+        double cost = (below.hasHull ? HullVolume(below.hull) : 0.0) +
+            (above.hasHull ? HullVolume(above.hull) : 0.0);
+        if (cost < bestCost)
+        {
+          bestCost = cost;
+          bestAxis = axis;
+          bestCut = cut;
+        }
+      }
+    }
+
+    if (bestAxis < 0)
+    {
+      // The piece can not be cut, accept it as it is.
+      piece.concavity = 0.0;
+      continue;
+    }
+
+    Piece below, above;
+    ClipPiece(piece, bestAxis, bestCut, eps, below, above);
+    BuildPiece(this->maxHullVertices, true, below);
+    BuildPiece(this->maxHullVertices, true, above);
+    pieces[worst] = std::move(below);
+    pieces.push_back(std::move(above));
+  }
+
+  Mesh *mesh = new Mesh();
+  for (const auto &piece : pieces)
+  {
+    if (!piece.hasHull)
+      continue;
+
+    SubMesh *subMesh = new SubMesh();
+    subMesh->SetName("hull_" + std::to_string(mesh->GetSubMeshCount()));
+    subMesh->SetPrimitiveType(SubMesh::TRIANGLES);
+    for (const auto &v : piece.hull.vertices)
+      subMesh->AddVertex(v);
+    for (unsigned int i : piece.hull.indices)
+      subMesh->AddIndex(i);
+    mesh->AddSubMesh(subMesh);
+  }
+
+  if (mesh->GetSubMeshCount() == 0u)
+  {
+    delete mesh;
+    return nullptr;
+  }
+  return mesh;
+}
+
+//////////////////////////////////////////////////
+ConvexDecomposition::ConvexDecomposition()
+  : dataPtr(new ConvexDecompositionPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+ConvexDecomposition::~ConvexDecomposition()
+{
+}
+
+//////////////////////////////////////////////////
+void ConvexDecomposition::SetMaxHulls(const unsigned int _count)
+{
+  this->dataPtr->maxHulls = std::max(1u, _count);
+}
+
+//////////////////////////////////////////////////
+unsigned int ConvexDecomposition::MaxHulls() const
+{
+  return this->dataPtr->maxHulls;
+}
+
+//////////////////////////////////////////////////
+void ConvexDecomposition::SetMaxHullVertices(const unsigned int _count)
+{
+  this->dataPtr->maxHullVertices = std::max(4u, _count);
+}
+
+//////////////////////////////////////////////////
+unsigned int ConvexDecomposition::MaxHullVertices() const
+{
+  return this->dataPtr->maxHullVertices;
+}
+
+//////////////////////////////////////////////////
+void ConvexDecomposition::SetConcavity(const double _concavity)
+{
+  this->dataPtr->concavity = std::max(0.0, _concavity);
+}
+
+//////////////////////////////////////////////////
+double ConvexDecomposition::Concavity() const
+{
+  return this->dataPtr->concavity;
+}
+
+//////////////////////////////////////////////////
+std::string ConvexDecomposition::ParameterKey() const
+{
+  std::ostringstream stream;
+  stream << "convex_decomposition " << this->dataPtr->maxHulls << ' '
+         << this->dataPtr->maxHullVertices << ' ' << this->dataPtr->concavity;
+  return stream.str();
+}
+
+//////////////////////////////////////////////////
+Mesh *ConvexDecomposition::Decompose(const Mesh *_mesh) const
+{
+  if (!_mesh)
+    return nullptr;
+
+  Piece surface;
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh->GetSubMesh(i);
+    if (subMesh->GetPrimitiveType() != SubMesh::TRIANGLES)
+      continue;
+
+    unsigned int count = subMesh->GetIndexCount() / 3 * 3;
+    for (unsigned int k = 0; k < count; ++k)
+      surface.corners.push_back(subMesh->Vertex(subMesh->GetIndex(k)));
+  }
+
+  return this->dataPtr->Decompose(surface);
+}
+
+//////////////////////////////////////////////////
+Mesh *ConvexDecomposition::Decompose(const SubMesh *_subMesh) const
+{
+  if (!_subMesh || _subMesh->GetPrimitiveType() != SubMesh::TRIANGLES)
+    return nullptr;
+
+  Piece surface;
+  unsigned int count = _subMesh->GetIndexCount() / 3 * 3;
+  for (unsigned int k = 0; k < count; ++k)
+    surface.corners.push_back(_subMesh->Vertex(_subMesh->GetIndex(k)));
+
+  return this->dataPtr->Decompose(surface);
+}
+
+//////////////////////////////////////////////////
+SubMesh *ConvexDecomposition::ConvexHull(
+    const std::vector<ignition::math::Vector3d> &_points,
+    const unsigned int _maxVertices)
+{
+  Hull hull;
+  if (!ComputeHull(_points, _maxVertices, hull))
+    return nullptr;
+
+  SubMesh *subMesh = new SubMesh();
+  subMesh->SetName("hull");
+  subMesh->SetPrimitiveType(SubMesh::TRIANGLES);
+  for (const auto &v : hull.vertices)
+    subMesh->AddVertex(v);
+  for (unsigned int i : hull.indices)
+    subMesh->AddIndex(i);
+  return subMesh;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_CONVEXDECOMPOSITION_HH_
+#define GAZEBO_COMMON_CONVEXDECOMPOSITION_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+    class SubMesh;
+    class ConvexDecompositionPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class ConvexDecomposition ConvexDecomposition.hh common/common.hh
+    /// \brief Approximates a triangle mesh by a set of convex hulls.
+    ///
+    /// The triangles are split recursively, in the spirit of V-HACD: the
+    /// piece whose hull is furthest from its surface is cut by the axis
+    /// aligned plane that gives the smallest total hull volume, until every
+    /// piece is shallow enough or the hull budget is used up.
+    class GZ_COMMON_VISIBLE ConvexDecomposition
+    {
+      /// \brief Constructor
+      public: ConvexDecomposition();
+
+      /// \brief Destructor
+      public: ~ConvexDecomposition();
+
+      /// \brief Set the largest number of hulls. The default is 16.
+      /// \param[in] _count Number of hulls, at least 1.
+      public: void SetMaxHulls(const unsigned int _count);
+
+      /// \brief Get the largest number of hulls.
+      /// \return Number of hulls.
+      public: unsigned int MaxHulls() const;
+
+      /// \brief Set the largest number of vertices of a hull. Hulls of
+      /// pieces with more vertices keep the points furthest out. The
+      /// default is 64.
+      /// \param[in] _count Number of vertices, at least 4.
+      public: void SetMaxHullVertices(const unsigned int _count);
+
+      /// \brief Get the largest number of vertices of a hull.
+      /// \return Number of vertices.
+      public: unsigned int MaxHullVertices() const;
+
+      /// \brief Set the largest accepted concavity, relative to the
+      /// diagonal of the mesh bounding box. A piece is split while a point
+      /// of its surface lies deeper than this inside its hull. The default
+      /// is 0.01.
+      /// \param[in] _concavity Relative concavity.
+      public: void SetConcavity(const double _concavity);
+
+      /// \brief Get the largest accepted concavity.
+      /// \return Relative concavity.
+      public: double Concavity() const;
+
+      /// \brief Get a string that identifies the parameters, to key cached
+      /// decompositions.
+      /// \return Parameter string.
+      public: std::string ParameterKey() const;
+
+      /// \brief Decompose a mesh. All submeshes with triangle primitives
+      /// are decomposed together.
+      /// \param[in] _mesh Mesh to decompose.
+      /// \return A new mesh with one submesh per hull, or nullptr if the
+      /// mesh is flat or empty. The caller owns the mesh.
+      public: Mesh *Decompose(const Mesh *_mesh) const;
+
+      /// \brief Decompose a submesh.
+      /// \param[in] _subMesh Submesh to decompose.
+      /// \return A new mesh with one submesh per hull, or nullptr if the
+      /// submesh is flat or empty. The caller owns the mesh.
+      public: Mesh *Decompose(const SubMesh *_subMesh) const;
+
+      /// \brief Compute the convex hull of a set of points.
+      /// \param[in] _points The points.
+      /// \param[in] _maxVertices Largest number of hull vertices, 0 for no
+      /// limit.
+      /// \return A new submesh with the hull triangles, wound counter
+      /// clockwise seen from outside, or nullptr if the points are flat.
+      /// The caller owns the submesh.
+      public: static SubMesh *ConvexHull(
+                  const std::vector<ignition::math::Vector3d> &_points,
+                  const unsigned int _maxVertices = 0);
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<ConvexDecompositionPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "gazebo/common/ConvexDecomposition.hh"
+#include "gazebo/common/Mesh.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ConvexDecomposition : public gazebo::testing::AutoLogFixture { };
+
+/// \brief Volume of a closed triangle mesh.
+/// \param[in] _subMesh The triangles.
+/// \return The enclosed volume.
+static double Volume(const common::SubMesh *_subMesh)
+{
+  double volume = 0.0;
+  for (unsigned int i = 0; i + 2 < _subMesh->GetIndexCount(); i += 3)
+  {
+    ignition::math::Vector3d a = _subMesh->Vertex(_subMesh->GetIndex(i));
+    ignition::math::Vector3d b = _subMesh->Vertex(_subMesh->GetIndex(i+1));
+    ignition::math::Vector3d c = _subMesh->Vertex(_subMesh->GetIndex(i+2));
+    volume += a.Dot(b.Cross(c));
+  }
+  return volume / 6.0;
+}
+
+/// \brief Build an L shaped prism made of two unit cubes side by side
+/// along x and one on top of the first along y.
+/// \return The prism.
+static common::SubMesh *LShape()
+{
+  const double outline[6][2] =
+      {{0, 0}, {2, 0}, {2, 1}, {1, 1}, {1, 2}, {0, 2}};
+  const unsigned int caps[4][3] = {{0, 1, 2}, {0, 2, 3}, {0, 3, 4}, {0, 4, 5}};
+
+  common::SubMesh *subMesh = new common::SubMesh();
+  subMesh->SetPrimitiveType(common::SubMesh::TRIANGLES);
+  for (unsigned int z = 0; z < 2; ++z)
+  {
+    for (unsigned int i = 0; i < 6; ++i)
+      subMesh->AddVertex(outline[i][0], outline[i][1], z);
+  }
+
+  for (const auto &cap : caps)
+  {
+    subMesh->AddIndex(cap[2]);
+    subMesh->AddIndex(cap[1]);
+    subMesh->AddIndex(cap[0]);
+    subMesh->AddIndex(6 + cap[0]);
+    subMesh->AddIndex(6 + cap[1]);
+    subMesh->AddIndex(6 + cap[2]);
+  }
+
+  for (unsigned int i = 0; i < 6; ++i)
+  {
+    unsigned int j = (i + 1) % 6;
+    subMesh->AddIndex(i);
+    subMesh->AddIndex(j);
+    subMesh->AddIndex(6 + j);
+    subMesh->AddIndex(i);
+    subMesh->AddIndex(6 + j);
+    subMesh->AddIndex(6 + i);
+  }
+  return subMesh;
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecomposition, ConvexHull)
+{
+  // Corners of a unit cube, and its center.
+  std::vector<ignition::math::Vector3d> points;
+  for (unsigned int i = 0; i < 8; ++i)
+    points.push_back(ignition::math::Vector3d(i & 1, (i >> 1) & 1, i >> 2));
+  points.push_back(ignition::math::Vector3d(0.5, 0.5, 0.5));
+
+  std::unique_ptr<common::SubMesh> hull(
+      common::ConvexDecomposition::ConvexHull(points));
+  ASSERT_TRUE(hull != nullptr);
+  EXPECT_EQ(8u, hull->GetVertexCount());
+  EXPECT_EQ(36u, hull->GetIndexCount());
+  EXPECT_NEAR(1.0, Volume(hull.get()), 1e-9);
+
+  // Flat points have no hull.
+  std::vector<ignition::math::Vector3d> flat;
+  for (unsigned int i = 0; i < 8; ++i)
+    flat.push_back(ignition::math::Vector3d(i, i * i, 0));
+  EXPECT_TRUE(common::ConvexDecomposition::ConvexHull(flat) == nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecomposition, Parameters)
+{
+  common::ConvexDecomposition decomposition;
+  EXPECT_EQ(16u, decomposition.MaxHulls());
+  EXPECT_EQ(64u, decomposition.MaxHullVertices());
+  EXPECT_DOUBLE_EQ(0.01, decomposition.Concavity());
+
+  std::string key = decomposition.ParameterKey();
+  decomposition.SetMaxHulls(0u);
+  EXPECT_EQ(1u, decomposition.MaxHulls());
+  decomposition.SetMaxHullVertices(2u);
+  EXPECT_EQ(4u, decomposition.MaxHullVertices());
+  decomposition.SetConcavity(0.1);
+  EXPECT_DOUBLE_EQ(0.1, decomposition.Concavity());
+  EXPECT_NE(key, decomposition.ParameterKey());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecomposition, Decompose)
+{
+  std::unique_ptr<common::SubMesh> shape(LShape());
+  common::ConvexDecomposition decomposition;
+
+  std::unique_ptr<common::Mesh> hulls(decomposition.Decompose(shape.get()));
+  ASSERT_TRUE(hulls != nullptr);
+  ASSERT_EQ(2u, hulls->GetSubMeshCount());
+
+  double volume = 0.0;
+  for (unsigned int i = 0; i < hulls->GetSubMeshCount(); ++i)
+  {
+    EXPECT_EQ(8u, hulls->GetSubMesh(i)->GetVertexCount());
+    volume += Volume(hulls->GetSubMesh(i));
+  }
+  EXPECT_NEAR(3.0, volume, 1e-9);
+
+  // A single hull fills the corner of the L.
+  decomposition.SetMaxHulls(1u);
+  hulls.reset(decomposition.Decompose(shape.get()));
+  ASSERT_TRUE(hulls != nullptr);
+  ASSERT_EQ(1u, hulls->GetSubMeshCount());
+  EXPECT_NEAR(3.5, Volume(hulls->GetSubMesh(0)), 1e-9);
+
+  // A mesh decomposes all its submeshes together.
+  common::Mesh mesh;
+  mesh.AddSubMesh(LShape());
+  decomposition.SetMaxHulls(16u);
+  hulls.reset(decomposition.Decompose(&mesh));
+  ASSERT_TRUE(hulls != nullptr);
+  EXPECT_EQ(2u, hulls->GetSubMeshCount());
+
+  EXPECT_TRUE(decomposition.Decompose(
+      static_cast<const common::Mesh *>(nullptr)) == nullptr);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
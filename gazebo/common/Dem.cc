@@ -15,7 +15,19 @@
  *
 */
 
+#ifdef _WIN32
+  #include <process.h>
+  #define getpid _getpid
+#else
+  #include <unistd.h>
+#endif
+
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
 #include <boost/filesystem.hpp>
 #include <gazebo/gazebo_config.h>
 
@@ -38,12 +50,271 @@ using namespace common;
 
 #ifdef HAVE_GDAL
 
+/// \brief Number of samples per row of a block of a paged grid.
+static const unsigned int kBlockSize = 256;
+
+/// \brief Largest number of samples per row of the coarse copy of a paged
+/// grid used to find the elevation range.
+static const unsigned int kPreviewSize = 1025;
+
+/// \brief Version of the block cache, part of the name of the cache
+/// directory of a file.
+static const char kCacheVersion[] = "1";
+
+/////////////////////////////////////////////////
+/// \brief Get the key of a block.
+/// \param[in] _column Column of the block.
+/// \param[in] _row Row of the block.
+/// \return Key of the block in DemPrivate::blocks.
+static uint64_t BlockKey(const unsigned int _column, const unsigned int _row)
+{
+  return (static_cast<uint64_t>(_row) << 32) | _column;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a window of the raster, resampled to a buffer.
+/// \param[in] _band Raster band.
+/// \param[in] _x First column of the window, in raster pixels.
+/// \param[in] _y First row of the window, in raster pixels.
+/// \param[in] _width Width of the window, in raster pixels.
+/// \param[in] _height Height of the window, in raster pixels.
+/// \param[out] _buffer First sample of the buffer.
+/// \param[in] _bufWidth Number of columns of the buffer.
+/// \param[in] _bufHeight Number of rows of the buffer.
+/// \param[in] _lineSpace Bytes between two rows of the buffer.
+/// \return True on success.
+static bool ReadWindow(GDALRasterBand *_band, const double _x,
+    const double _y, const double _width, const double _height,
+    float *_buffer, const unsigned int _bufWidth,
+    const unsigned int _bufHeight, const size_t _lineSpace)
+{
+  // Whole pixels covering the window. With a fractional window, GDAL
+  // samples the same raster pixels for a block as for the whole grid.
+  const int xSize = _band->GetXSize();
+  const int ySize = _band->GetYSize();
+  const int x0 = std::max(static_cast<int>(std::floor(_x)), 0);
+  const int y0 = std::max(static_cast<int>(std::floor(_y)), 0);
+  const int x1 = std::min(static_cast<int>(std::ceil(_x + _width)), xSize);
+  const int y1 = std::min(static_cast<int>(std::ceil(_y + _height)), ySize);
+  if (x1 <= x0 || y1 <= y0)
+    return false;
+
+#if GDAL_VERSION_NUM >= 2000000
+  // GDAL picks the overview matching the decimation of the window
+  GDALRasterIOExtraArg extraArg;
+  INIT_RASTERIO_EXTRA_ARG(extraArg);
+  extraArg.eResampleAlg = GRIORA_NearestNeighbour;
+  extraArg.bFloatingPointWindowValidity = TRUE;
+  extraArg.dfXOff = _x;
+  extraArg.dfYOff = _y;
+  extraArg.dfXSize = _width;
+  extraArg.dfYSize = _height;
+  return _band->RasterIO(GF_Read, x0, y0, x1 - x0, y1 - y0, _buffer,
+      _bufWidth, _bufHeight, GDT_Float32, sizeof(float), _lineSpace,
+      &extraArg) == CE_None;
+#else
+  return _band->RasterIO(GF_Read, x0, y0, x1 - x0, y1 - y0, _buffer,
+      _bufWidth, _bufHeight, GDT_Float32, sizeof(float), _lineSpace) ==
+      CE_None;
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the path of a block in the block cache.
+/// \param[in] _data Private data of the Dem.
+/// \param[in] _column Column of the block.
+/// \param[in] _row Row of the block.
+/// \return Path of the block, empty if the cache is disabled.
+static std::string BlockPath(const DemPrivate &_data,
+    const unsigned int _column, const unsigned int _row)
+{
+  if (_data.cachePath.empty() || _data.cacheKey.empty())
+    return std::string();
+
+  return (boost::filesystem::path(_data.cachePath) / _data.cacheKey /
+      (std::to_string(_column) + "_" + std::to_string(_row) + ".f32"))
+      .string();
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a block of a paged grid, from the block cache or from the
+/// data set. The caller holds the mutex.
+/// \param[in] _data Private data of the Dem.
+/// \param[in] _column Column of the block.
+/// \param[in] _row Row of the block.
+/// \return The heights of the block. Samples of the padding are 0.
+static std::shared_ptr<const std::vector<float>> ReadBlock(
+    DemPrivate &_data, const unsigned int _column, const unsigned int _row)
+{
+  const size_t blockBytes = kBlockSize * kBlockSize * sizeof(float);
+  std::shared_ptr<std::vector<float>> heights =
+    std::make_shared<std::vector<float>>(kBlockSize * kBlockSize, 0.0f);
+
+  const std::string path = BlockPath(_data, _column, _row);
+  if (!path.empty())
+  {
+    std::ifstream in(path, std::ios::binary);
+    if (in && in.read(reinterpret_cast<char *>(heights->data()), blockBytes) &&
+        in.gcount() == static_cast<std::streamsize>(blockBytes))
+    {
+      return heights;
+    }
+    std::fill(heights->begin(), heights->end(), 0.0f);
+  }
+
+  // Samples of the block inside of the resampled raster
+  const unsigned int x = _column * kBlockSize;
+  const unsigned int y = _row * kBlockSize;
+  if (x < _data.destWidth && y < _data.destHeight)
+  {
+    const unsigned int width = std::min(kBlockSize, _data.destWidth - x);
+    const unsigned int height = std::min(kBlockSize, _data.destHeight - y);
+    const double ratioX =
+      static_cast<double>(_data.dataSet->GetRasterXSize()) / _data.destWidth;
+    const double ratioY =
+      static_cast<double>(_data.dataSet->GetRasterYSize()) / _data.destHeight;
+
+    if (!ReadWindow(_data.band, x * ratioX, y * ratioY, width * ratioX,
+          height * ratioY, heights->data(), width, height,
+          kBlockSize * sizeof(float)))
+    {
+      gzerr << "Failure calling RasterIO while reading block [" << _column
+            << ", " << _row << "] of a DEM file\n";
+      return heights;
+    }
+  }
+
+  if (!path.empty())
+  {
+    // Write a temporary file and rename it, so other processes sharing the
+    // cache never see a partial block.
+    const std::string tmp = path + "." + std::to_string(getpid()) + ".tmp";
+    try
+    {
+      boost::filesystem::create_directories(
+          boost::filesystem::path(path).parent_path());
+      std::ofstream out(tmp, std::ios::binary);
+      out.write(reinterpret_cast<const char *>(heights->data()), blockBytes);
+      out.close();
+      if (out)
+        boost::filesystem::rename(tmp, path);
+      else
+        std::remove(tmp.c_str());
+    }
+    catch(const boost::filesystem::filesystem_error &_e)
+    {
+      gzwarn << "Unable to write DEM block cache entry[" << path << "]: "
+             << _e.what() << std::endl;
+      std::remove(tmp.c_str());
+    }
+  }
+
+  return heights;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get a block of a paged grid, reading it if it is not resident,
+/// and release the least recently used blocks beyond the budget.
+/// \param[in] _data Private data of the Dem.
+/// \param[in] _column Column of the block.
+/// \param[in] _row Row of the block.
+/// \return The heights of the block.
+static std::shared_ptr<const std::vector<float>> GetBlock(
+    DemPrivate &_data, const unsigned int _column, const unsigned int _row)
+{
+  std::lock_guard<std::mutex> lock(_data.mutex);
+
+  const uint64_t key = BlockKey(_column, _row);
+  auto iter = _data.blocks.find(key);
+  if (iter == _data.blocks.end())
+  {
+    while (!_data.blocks.empty() && _data.blocks.size() >= _data.blockBudget)
+    {
+      auto oldest = _data.blocks.begin();
+      for (auto it = _data.blocks.begin(); it != _data.blocks.end(); ++it)
+      {
+        if (it->second.lastUse < oldest->second.lastUse)
+          oldest = it;
+      }
+      _data.blocks.erase(oldest);
+    }
+
+    DemPrivate::Block block;
+    block.heights = ReadBlock(_data, _column, _row);
+    iter = _data.blocks.emplace(key, block).first;
+  }
+
+  iter->second.lastUse = ++_data.useCount;
+  return iter->second.heights;
+}
+
+/// \brief Reads samples of the grid, paged or not. The blocks that are
+/// used are kept alive while the sampler exists, even if the Dem releases
+/// them.
+class DemSampler
+{
+  /// \brief Constructor.
+  /// \param[in] _data Private data of the Dem.
+  public: explicit DemSampler(DemPrivate &_data)
+    : data(_data)
+  {
+  }
+
+  /// \brief Get a sample of the grid.
+  /// \param[in] _x Column of the sample.
+  /// \param[in] _y Row of the sample.
+  /// \return The height.
+  public: float operator()(const unsigned int _x, const unsigned int _y)
+  {
+    if (!this->data.paged)
+      return this->data.demData[_y * this->data.side + _x];
+
+    const uint64_t key = BlockKey(_x / kBlockSize, _y / kBlockSize);
+    if (!this->last || key != this->lastKey)
+    {
+      auto iter = this->pinned.find(key);
+      if (iter == this->pinned.end())
+      {
+        // Rows are filled in order, so only the blocks of the current rows
+        // are worth keeping.
+        const size_t blocksPerRow = this->data.side / kBlockSize + 1;
+        if (this->pinned.size() > 2 * blocksPerRow + 2)
+          this->pinned.clear();
+
+        iter = this->pinned.emplace(key, GetBlock(this->data,
+              _x / kBlockSize, _y / kBlockSize)).first;
+      }
+      this->last = iter->second.get();
+      this->lastKey = key;
+    }
+
+    return (*this->last)[(_y % kBlockSize) * kBlockSize + _x % kBlockSize];
+  }
+
+  /// \brief Private data of the Dem.
+  private: DemPrivate &data;
+
+  /// \brief Blocks used by this sampler.
+  private: std::unordered_map<uint64_t,
+           std::shared_ptr<const std::vector<float>>> pinned;
+
+  /// \brief Heights of the last block used.
+  private: const std::vector<float> *last = nullptr;
+
+  /// \brief Key of the last block used.
+  private: uint64_t lastKey = 0;
+};
+
 //////////////////////////////////////////////////
 Dem::Dem()
   : dataPtr(new DemPrivate)
 {
   this->dataPtr->dataSet = nullptr;
   GDALAllRegister();
+
+  const char *cachePath = std::getenv("GAZEBO_DEM_CACHE_PATH");
+  if (cachePath)
+    this->dataPtr->cachePath = cachePath;
 }
 
 //////////////////////////////////////////////////
@@ -66,6 +337,65 @@ void Dem::SetSphericalCoordinates(
 }
 
 
+//////////////////////////////////////////////////
+void Dem::SetPagingThreshold(const uint64_t _samples)
+{
+  this->dataPtr->pagingThreshold = _samples;
+}
+
+//////////////////////////////////////////////////
+uint64_t Dem::PagingThreshold() const
+{
+  return this->dataPtr->pagingThreshold;
+}
+
+//////////////////////////////////////////////////
+bool Dem::Paged() const
+{
+  return this->dataPtr->paged;
+}
+
+//////////////////////////////////////////////////
+void Dem::SetBlockBudget(const unsigned int _budget)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->blockBudget = std::max(_budget, 1u);
+}
+
+//////////////////////////////////////////////////
+unsigned int Dem::BlockBudget() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->blockBudget;
+}
+
+//////////////////////////////////////////////////
+unsigned int Dem::ResidentBlockCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return static_cast<unsigned int>(this->dataPtr->blocks.size());
+}
+
+//////////////////////////////////////////////////
+unsigned int Dem::BlockSize()
+{
+  return kBlockSize;
+}
+
+//////////////////////////////////////////////////
+void Dem::SetCachePath(const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->cachePath = _path;
+}
+
+//////////////////////////////////////////////////
+std::string Dem::CachePath() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->cachePath;
+}
+
 //////////////////////////////////////////////////
 int Dem::Load(const std::string &_filename)
 {
@@ -160,6 +490,58 @@ int Dem::Load(const std::string &_filename)
   if (this->LoadData() != 0)
     return -1;
 
+  // Identify the file and its resampling for the block cache
+  this->dataPtr->cacheKey.clear();
+  if (this->dataPtr->paged)
+  {
+    try
+    {
+      std::ostringstream id;
+      id << kCacheVersion << "|"
+         << boost::filesystem::canonical(fullName).string() << "|"
+         << boost::filesystem::file_size(fullName) << "|"
+         << boost::filesystem::last_write_time(fullName) << "|"
+         << xSize << "x" << ySize << "|" << this->dataPtr->destWidth << "x"
+         << this->dataPtr->destHeight << "|" << kBlockSize;
+      this->dataPtr->cacheKey = common::get_sha1<std::string>(id.str());
+    }
+    catch(const boost::filesystem::filesystem_error &)
+    {
+      gzwarn << "Unable to identify DEM file[" << fullName
+             << "], its blocks are not cached" << std::endl;
+    }
+  }
+
+  // The elevation range of a paged grid is found on a coarse copy, read
+  // from the overviews of the file when there are some.
+  std::vector<float> preview;
+  if (this->dataPtr->paged)
+  {
+    const double ratio = std::max(1.0, static_cast<double>(
+          std::max(this->dataPtr->destWidth, this->dataPtr->destHeight)) /
+        kPreviewSize);
+    const unsigned int previewWidth = std::max(1u, static_cast<unsigned int>(
+          this->dataPtr->destWidth / ratio));
+    const unsigned int previewHeight = std::max(1u,
+        static_cast<unsigned int>(this->dataPtr->destHeight / ratio));
+    preview.resize(static_cast<size_t>(previewWidth) * previewHeight);
+    if (!ReadWindow(this->dataPtr->band, 0, 0, xSize, ySize, preview.data(),
+          previewWidth, previewHeight, previewWidth * sizeof(float)))
+    {
+      gzerr << "Failure calling RasterIO while loading a DEM file\n";
+      return -1;
+    }
+
+    // The padding of the grid counts, as it does for a grid read whole
+    if (this->dataPtr->destWidth < this->dataPtr->side ||
+        this->dataPtr->destHeight < this->dataPtr->side)
+    {
+      preview.push_back(0.0f);
+    }
+  }
+  const std::vector<float> &elevations =
+    this->dataPtr->paged ? preview : this->dataPtr->demData;
+
   // Check for nodata value in dem data. This is used when computing the
   // min elevation. If nodata value is not defined, we assume it will be one
   // of the commonly used values such as -9999, -32768, etc.
@@ -173,7 +555,7 @@ int Dem::Load(const std::string &_filename)
 
   double min = ignition::math::MAX_D;
   double max = -ignition::math::MAX_D;
-  for (auto d : this->dataPtr->demData)
+  for (auto d : elevations)
   {
     if (d < min && d > noDataValue)
       min = d;
@@ -202,6 +584,13 @@ double Dem::GetElevation(double _x, double _y)
            " x " << this->GetHeight() << "]\n");
   }
 
+  if (this->dataPtr->paged)
+  {
+    const unsigned int x = static_cast<unsigned int>(_x);
+    const unsigned int y = static_cast<unsigned int>(_y);
+    return DemSampler(*this->dataPtr)(x, y);
+  }
+
   return this->dataPtr->demData.at(_y * this->GetWidth() + _x);
 }
 
@@ -326,12 +715,38 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
     return;
   }
 
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
+  this->FillHeightMapRegion(_subSampling, _vertSize, _size, _scale, _flipY,
+      0, 0, _vertSize, _vertSize, _heights);
+}
+
+//////////////////////////////////////////////////
+void Dem::FillHeightMapRegion(const int _subSampling,
+    const unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, const bool _flipY,
+    const unsigned int _x, const unsigned int _y,
+    unsigned int _width, unsigned int _height,
+    std::vector<float> &_heights)
+{
+  _heights.clear();
+  if (_subSampling <= 0)
+  {
+    gzerr << "Illegal subsampling value (" << _subSampling << ")\n";
+    return;
+  }
+
+  if (_x >= _vertSize || _y >= _vertSize)
+    return;
+  _width = std::min(_width, _vertSize - _x);
+  _height = std::min(_height, _vertSize - _y);
 
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  // Resize the vector to match the size of the region.
+  _heights.resize(static_cast<size_t>(_width) * _height);
+  DemSampler sample(*this->dataPtr);
+
+  // Iterate over the vertices of the region
+  for (unsigned int row = _y; row < _y + _height; ++row)
   {
+    unsigned int y = _flipY ? _vertSize - row - 1 : row;
     double yf = y / static_cast<double>(_subSampling);
     unsigned int y1 = floor(yf);
     unsigned int y2 = ceil(yf);
@@ -339,7 +754,7 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
       y2 = this->dataPtr->side - 1;
     double dy = yf - y1;
 
-    for (unsigned int x = 0; x < _vertSize; ++x)
+    for (unsigned int x = _x; x < _x + _width; ++x)
     {
       double xf = x / static_cast<double>(_subSampling);
       unsigned int x1 = floor(xf);
@@ -348,12 +763,12 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
         x2 = this->dataPtr->side - 1;
       double dx = xf - x1;
 
-      double px1 = this->dataPtr->demData[y1 * this->dataPtr->side + x1];
-      double px2 = this->dataPtr->demData[y1 * this->dataPtr->side + x2];
+      double px1 = sample(x1, y1);
+      double px2 = sample(x2, y1);
       float h1 = (px1 - ((px1 - px2) * dx));
 
-      double px3 = this->dataPtr->demData[y2 * this->dataPtr->side + x1];
-      double px4 = this->dataPtr->demData[y2 * this->dataPtr->side + x2];
+      double px3 = sample(x1, y2);
+      double px4 = sample(x2, y2);
       float h2 = (px3 - ((px3 - px4) * dx));
 
       float h = this->dataPtr->minElevation +
@@ -370,10 +785,7 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
         h = this->dataPtr->minElevation;
 
       // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
+      _heights[(row - _y) * _width + (x - _x)] = h;
     }
   }
 }
@@ -411,6 +823,23 @@ int Dem::LoadData()
       destWidth = static_cast<float>(destHeight) / static_cast<float>(ratio);
     }
 
+    this->dataPtr->destWidth = destWidth;
+    this->dataPtr->destHeight = destHeight;
+
+    // Large grids are read block by block, when their heights are needed
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      this->dataPtr->blocks.clear();
+    }
+    this->dataPtr->paged = static_cast<uint64_t>(this->dataPtr->side) *
+      this->dataPtr->side > this->dataPtr->pagingThreshold;
+    if (this->dataPtr->paged)
+    {
+      this->dataPtr->demData.clear();
+      this->dataPtr->demData.shrink_to_fit();
+      return 0;
+    }
+
     // Read the whole raster data and convert it to a GDT_Float32 array.
     // In this step the DEM is scaled to destWidth x destHeight
     buffer.resize(destWidth * destHeight);
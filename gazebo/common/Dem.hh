@@ -25,6 +25,7 @@
 #include <gazebo/util/system.hh>
 
 #ifdef HAVE_GDAL
+# include <cstdint>
 # include <string>
 # include <vector>
 
@@ -41,6 +42,14 @@ namespace gazebo
 
     /// \class DEM DEM.hh common/common.hh
     /// \brief Encapsulates a DEM (Digital Elevation Model) file.
+    ///
+    /// The raster is resampled to a square grid whose side is a power of
+    /// two plus one. Small grids are read whole when the file is loaded.
+    /// Larger grids are paged: they are split in square blocks that are
+    /// read with windowed RasterIO calls when a height of the block is
+    /// needed, and GDAL reads them from the overviews of the file that
+    /// match the resampling. At most BlockBudget() blocks stay in memory,
+    /// and blocks read once are cached on disk, see SetCachePath.
     class GZ_COMMON_VISIBLE Dem : public HeightmapData
     {
       /// \brief Constructor.
@@ -56,6 +65,50 @@ namespace gazebo
       public: void SetSphericalCoordinates(
                   common::SphericalCoordinatesPtr _worldSphericalCoordinates);
 
+      /// \brief Set the number of samples of the resampled grid above which
+      /// the grid is paged instead of read whole. Call it before Load.
+      /// \param[in] _samples Number of samples, 0 pages every grid.
+      /// \sa Paged()
+      public: void SetPagingThreshold(const uint64_t _samples);
+
+      /// \brief Get the number of samples above which grids are paged.
+      /// \return Number of samples.
+      public: uint64_t PagingThreshold() const;
+
+      /// \brief Get whether the grid of the loaded file is paged.
+      /// \return True if blocks of the grid are read on demand.
+      public: bool Paged() const;
+
+      /// \brief Set the largest number of blocks of a paged grid kept in
+      /// memory.
+      /// \param[in] _budget Number of blocks, at least 1.
+      public: void SetBlockBudget(const unsigned int _budget);
+
+      /// \brief Get the largest number of blocks kept in memory.
+      /// \return Number of blocks.
+      public: unsigned int BlockBudget() const;
+
+      /// \brief Get the number of blocks of a paged grid in memory.
+      /// \return Number of resident blocks.
+      public: unsigned int ResidentBlockCount() const;
+
+      /// \brief Get the number of samples per row of a block.
+      /// \return Block size.
+      public: static unsigned int BlockSize();
+
+      /// \brief Set the directory where the blocks of paged grids are
+      /// cached. A block is read from the cache when the file, its
+      /// modification time and the resampling match, so later loads skip
+      /// GDAL. Servers on a host that use the same directory share its
+      /// blocks. The initial value is taken from GAZEBO_DEM_CACHE_PATH.
+      /// \param[in] _path Cache directory, or an empty string to disable
+      /// the cache.
+      public: void SetCachePath(const std::string &_path);
+
+      /// \brief Get the directory where blocks are cached.
+      /// \return Cache directory, or an empty string if disabled.
+      public: std::string CachePath() const;
+
       /// \brief Load a DEM file.
       /// \param[in] _filename the path to the terrain file.
       /// \return 0 when the operation succeeds to open a file.
@@ -125,6 +178,16 @@ namespace gazebo
                   const bool _flipY,
                   std::vector<float> &_heights);
 
+      // Documentation inherited.
+      public: void FillHeightMapRegion(const int _subSampling,
+                  const unsigned int _vertSize,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale,
+                  const bool _flipY,
+                  const unsigned int _x, const unsigned int _y,
+                  unsigned int _width, unsigned int _height,
+                  std::vector<float> &_heights);
+
       /// \brief Get the georeferenced coordinates (lat, long) of a terrain's
       /// pixel in WGS84.
       /// \param[in] _x X coordinate of the terrain.
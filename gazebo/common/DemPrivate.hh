@@ -24,6 +24,11 @@
 
 #ifdef HAVE_GDAL
 # include <gdal_priv.h>
+# include <cstdint>
+# include <memory>
+# include <mutex>
+# include <string>
+# include <unordered_map>
 # include <vector>
 
 namespace gazebo
@@ -61,6 +66,50 @@ namespace gazebo
       /// \brief DEM data converted to be OGRE-compatible.
       public: std::vector<float> demData;
 
+      /// \brief A block of a paged grid.
+      public: class Block
+      {
+        /// \brief Heights, BlockSize() rows of BlockSize() samples.
+        public: std::shared_ptr<const std::vector<float>> heights;
+
+        /// \brief Value of useCount when the block was last used.
+        public: uint64_t lastUse = 0;
+      };
+
+      /// \brief Width of the resampled raster, before the padding.
+      public: unsigned int destWidth = 0;
+
+      /// \brief Height of the resampled raster, before the padding.
+      public: unsigned int destHeight = 0;
+
+      /// \brief Number of samples above which the grid is paged.
+      public: uint64_t pagingThreshold = 4097ull * 4097ull;
+
+      /// \brief True if blocks of the grid are read on demand, in which
+      /// case demData is empty.
+      public: bool paged = false;
+
+      /// \brief Largest number of resident blocks.
+      public: unsigned int blockBudget = 256;
+
+      /// \brief Resident blocks, by row and column of the block.
+      public: std::unordered_map<uint64_t, Block> blocks;
+
+      /// \brief Number of block lookups, used to find the least recently
+      /// used block.
+      public: uint64_t useCount = 0;
+
+      /// \brief Directory of the block cache, empty if disabled.
+      public: std::string cachePath;
+
+      /// \brief Name of the cache directory of the loaded file, empty if
+      /// the file could not be identified.
+      public: std::string cacheKey;
+
+      /// \brief Protects the blocks and the data set, which is read from
+      /// the threads that fill heightmap tiles.
+      public: std::mutex mutex;
+
       /// \brief Holds the spherical coordinates object from the world.
       public: common::SphericalCoordinatesPtr sphericalCoordinates =
               boost::make_shared<common::SphericalCoordinates>();
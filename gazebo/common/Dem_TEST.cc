@@ -15,6 +15,10 @@
  *
 */
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <boost/filesystem.hpp>
 #include <gtest/gtest.h>
 #include <ignition/math/Angle.hh>
@@ -225,6 +229,83 @@ TEST_F(DemTest, UnfinishedDem)
   EXPECT_FLOAT_EQ(2932, demNoData.GetMaxElevation());
 }
 
+/////////////////////////////////////////////////
+/// \brief Fill the whole height table of a DEM.
+/// \param[in] _dem The DEM.
+/// \param[out] _heights The heights.
+static void FillDem(common::Dem &_dem, std::vector<float> &_heights)
+{
+  const int subsampling = 2;
+  const unsigned int vertSize = _dem.GetWidth() * subsampling - 1;
+  ignition::math::Vector3d size(_dem.GetWorldWidth(), _dem.GetWorldHeight(),
+      _dem.GetMaxElevation() - _dem.GetMinElevation());
+  ignition::math::Vector3d scale(size.X() / vertSize, size.Y() / vertSize,
+      1.0);
+  _dem.FillHeightMap(subsampling, vertSize, size, scale, true, _heights);
+}
+
+/////////////////////////////////////////////////
+TEST_F(DemTest, Paged)
+{
+  boost::filesystem::path cache = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_dem_cache_%%%%-%%%%");
+
+  for (const std::string file : {"dem_squared.tif", "dem_portrait.tif"})
+  {
+    boost::filesystem::path path = TEST_PATH;
+    path /= "data/" + file;
+
+    common::Dem whole;
+    whole.SetCachePath("");
+    ASSERT_EQ(0, whole.Load(path.string()));
+    EXPECT_FALSE(whole.Paged());
+    EXPECT_EQ(0u, whole.ResidentBlockCount());
+
+    common::Dem paged;
+    paged.SetPagingThreshold(0);
+    paged.SetBlockBudget(1);
+    paged.SetCachePath(cache.string());
+    EXPECT_EQ(cache.string(), paged.CachePath());
+    ASSERT_EQ(0, paged.Load(path.string()));
+    EXPECT_TRUE(paged.Paged());
+    EXPECT_EQ(0u, paged.ResidentBlockCount());
+
+    // The paged grid matches the grid read whole
+    EXPECT_EQ(whole.GetWidth(), paged.GetWidth());
+    EXPECT_FLOAT_EQ(whole.GetMinElevation(), paged.GetMinElevation());
+    EXPECT_FLOAT_EQ(whole.GetMaxElevation(), paged.GetMaxElevation());
+    const unsigned int last = whole.GetWidth() - 1;
+    for (const auto &point : {std::make_pair(0u, 0u),
+        std::make_pair(last, 0u), std::make_pair(0u, last),
+        std::make_pair(last / 2, last / 3), std::make_pair(last, last)})
+    {
+      EXPECT_FLOAT_EQ(whole.GetElevation(point.first, point.second),
+          paged.GetElevation(point.first, point.second)) << file;
+    }
+    EXPECT_LE(paged.ResidentBlockCount(), 1u);
+
+    std::vector<float> wholeHeights;
+    std::vector<float> pagedHeights;
+    FillDem(whole, wholeHeights);
+    FillDem(paged, pagedHeights);
+    ASSERT_EQ(wholeHeights.size(), pagedHeights.size());
+    for (size_t i = 0; i < wholeHeights.size(); ++i)
+      ASSERT_FLOAT_EQ(wholeHeights[i], pagedHeights[i]) << file << " " << i;
+
+    // A second load reads the blocks from the disk cache
+    EXPECT_TRUE(boost::filesystem::exists(cache));
+    common::Dem cached;
+    cached.SetPagingThreshold(0);
+    cached.SetCachePath(cache.string());
+    ASSERT_EQ(0, cached.Load(path.string()));
+    std::vector<float> cachedHeights;
+    FillDem(cached, cachedHeights);
+    EXPECT_EQ(pagedHeights, cachedHeights);
+  }
+
+  boost::filesystem::remove_all(cache);
+}
+
 /////////////////////////////////////////////////
 TEST_F(DemTest, LunarDemLoad)
 {
@@ -15,6 +15,9 @@
  *
  */
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Event.hh"
 
@@ -27,11 +30,29 @@ Event::Event()
 {
 }
 
+//////////////////////////////////////////////////
+Event::Event(const std::string &_name)
+  : signaled(false), name(_name)
+{
+}
+
 //////////////////////////////////////////////////
 Event::~Event()
 {
 }
 
+//////////////////////////////////////////////////
+const std::string &Event::Name() const
+{
+  return this->name;
+}
+
+//////////////////////////////////////////////////
+void Event::SetName(const std::string &_name)
+{
+  this->name = _name;
+}
+
 //////////////////////////////////////////////////
 bool Event::Signaled() const
 {
@@ -44,6 +65,24 @@ void Event::SetSignaled(const bool _sig)
   this->signaled = _sig;
 }
 
+//////////////////////////////////////////////////
+void Event::ParallelFor(const size_t _count,
+    const std::function<void (size_t)> &_func)
+{
+  if (_count == 1)
+  {
+    _func(0);
+    return;
+  }
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, _count, 1),
+      [&_func](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+          _func(i);
+      });
+}
+
 //////////////////////////////////////////////////
 Connection::Connection(Event *_e, const int _i)
   : event(_e), id(_i)
@@ -17,20 +17,23 @@
 #ifndef GAZEBO_COMMON_EVENT_HH_
 #define GAZEBO_COMMON_EVENT_HH_
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/gazebo_config.h"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/CommonTypes.hh"
+#include "gazebo/common/PluginStats.hh"
 #include "gazebo/util/system.hh"
 
-#include "ignition/common/Profiler.hh"
-
 namespace gazebo
 {
   /// \ingroup gazebo_event
@@ -47,9 +50,23 @@ namespace gazebo
       /// \brief Constructor
       public: Event();
 
+      /// \brief Constructor.
+      /// \param[in] _name Name of the event, see Name.
+      public: explicit Event(const std::string &_name);
+
       /// \brief Destructor
       public: virtual ~Event();
 
+      /// \brief Get the name of the event, under which PluginStats
+      /// reports the time spent by plugins in its callbacks.
+      /// \return The name, empty if not set.
+      public: const std::string &Name() const;
+
+      /// \brief Set the name of the event. Callbacks connected before
+      /// keep the previous name.
+      /// \param[in] _name Name of the event.
+      public: void SetName(const std::string &_name);
+
       /// \brief Disconnect
       /// \param[in] _id Integer ID of a connection
       public: virtual void Disconnect(int _id) = 0;
@@ -62,8 +79,18 @@ namespace gazebo
       /// \param[in] _sig True if the event has been signaled.
       public: void SetSignaled(const bool _sig);
 
+      /// \brief Call a function for every index, in parallel on the TBB
+      /// thread pool. Returns once all the calls have returned.
+      /// \param[in] _count Number of indices.
+      /// \param[in] _func Function called with each index below _count.
+      protected: static void ParallelFor(const size_t _count,
+                     const std::function<void (size_t)> &_func);
+
       /// \brief True if the event has been signaled.
       private: bool signaled;
+
+      /// \brief Name of the event.
+      private: std::string name;
     };
 
     /// \brief A class that encapsulates a connection.
@@ -101,6 +128,10 @@ namespace gazebo
       /// \brief Constructor.
       public: EventT();
 
+      /// \brief Constructor.
+      /// \param[in] _name Name of the event, see Event::Name.
+      public: explicit EventT(const std::string &_name);
+
       /// \brief Destructor.
       public: virtual ~EventT();
 
@@ -272,15 +303,19 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+
+        // Walk a snapshot, callbacks may connect or disconnect.
+        const auto connections = std::atomic_load(&this->connections);
+        if (!connections)
+          return;
+
+        for (const auto &conn : *connections)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback0");
-            iter.second->callback();
+            Call(*conn);
             IGN_PROFILE_END();
           }
         }
@@ -293,20 +328,48 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+
+        // Walk a snapshot, callbacks may connect or disconnect.
+        const auto connections = std::atomic_load(&this->connections);
+        if (!connections)
+          return;
+
+        for (const auto &conn : *connections)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback1");
-            iter.second->callback(_p);
+            Call(*conn, _p);
             IGN_PROFILE_END();
           }
         }
       }
 
+      /// \brief Signal the event with one parameter, calling the
+      /// subscribers in parallel. The subscribers must not depend on each
+      /// other or on the order of the calls. Returns once all of them have
+      /// returned.
+      /// \param[in] _p the parameter.
+      public: template<typename P>
+              void SignalParallel(const P &_p)
+      {
+        IGN_PROFILE("Event::SignalParallel");
+
+        this->SetSignaled(true);
+
+        const auto connections = std::atomic_load(&this->connections);
+        if (!connections || connections->empty())
+          return;
+
+        ParallelFor(connections->size(), [&connections, &_p](const size_t _i)
+            {
+              const auto &conn = (*connections)[_i];
+              if (conn->on)
+                Call(*conn, _p);
+            });
+      }
+
       /// \brief Signal the event with two parameter.
       /// \param[in] _p1 the first parameter.
       /// \param[in] _p2 the second parameter.
@@ -315,15 +378,19 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+
+        // Walk a snapshot, callbacks may connect or disconnect.
+        const auto connections = std::atomic_load(&this->connections);
+        if (!connections)
+          return;
+
+        for (const auto &conn : *connections)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback2");
-            iter.second->callback(_p1, _p2);
+            Call(*conn, _p1, _p2);
             IGN_PROFILE_END();
           }
         }
@@ -338,15 +405,19 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+
+        // Walk a snapshot, callbacks may connect or disconnect.
+        const auto connections = std::atomic_load(&this->connections);
+        if (!connections)
+          return;
+
+        for (const auto &conn : *connections)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback3");
-            iter.second->callback(_p1, _p2, _p3);
+            Call(*conn, _p1, _p2, _p3);
             IGN_PROFILE_END();
           }
         }
@@ -363,15 +434,19 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+
+        // Walk a snapshot, callbacks may connect or disconnect.
+        const auto connections = std::atomic_load(&this->connections);
+        if (!connections)
+          return;
+
+        for (const auto &conn : *connections)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback4");
-            iter.second->callback(_p1, _p2, _p3, _p4);
+            Call(*conn, _p1, _p2, _p3, _p4);
             IGN_PROFILE_END();
           }
         }
@@ -390,15 +465,19 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+
+        // Walk a snapshot, callbacks may connect or disconnect.
+        const auto connections = std::atomic_load(&this->connections);
+        if (!connections)
+          return;
+
+        for (const auto &conn : *connections)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback5");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5);
+            Call(*conn, _p1, _p2, _p3, _p4, _p5);
             IGN_PROFILE_END();
           }
         }
@@ -418,15 +497,19 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+
+        // Walk a snapshot, callbacks may connect or disconnect.
+        const auto connections = std::atomic_load(&this->connections);
+        if (!connections)
+          return;
+
+        for (const auto &conn : *connections)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback6");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6);
+            Call(*conn, _p1, _p2, _p3, _p4, _p5, _p6);
             IGN_PROFILE_END();
           }
         }
@@ -447,15 +530,19 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+
+        // Walk a snapshot, callbacks may connect or disconnect.
+        const auto connections = std::atomic_load(&this->connections);
+        if (!connections)
+          return;
+
+        for (const auto &conn : *connections)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback7");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
+            Call(*conn, _p1, _p2, _p3, _p4, _p5, _p6, _p7);
             IGN_PROFILE_END();
           }
         }
@@ -478,15 +565,19 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+
+        // Walk a snapshot, callbacks may connect or disconnect.
+        const auto connections = std::atomic_load(&this->connections);
+        if (!connections)
+          return;
+
+        for (const auto &conn : *connections)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback8");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
+            Call(*conn, _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
             IGN_PROFILE_END();
           }
         }
@@ -511,16 +602,19 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+
+        // Walk a snapshot, callbacks may connect or disconnect.
+        const auto connections = std::atomic_load(&this->connections);
+        if (!connections)
+          return;
+
+        for (const auto &conn : *connections)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback9");
-            iter.second->callback(
-                _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9);
+            Call(*conn, _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9);
             IGN_PROFILE_END();
           }
         }
@@ -546,32 +640,31 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+
+        // Walk a snapshot, callbacks may connect or disconnect.
+        const auto connections = std::atomic_load(&this->connections);
+        if (!connections)
+          return;
+
+        for (const auto &conn : *connections)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback10");
-            iter.second->callback(
-                _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9, _p10);
+            Call(*conn, _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9, _p10);
             IGN_PROFILE_END();
           }
         }
       }
 
-      /// \internal
-      /// \brief Removes queued connections.
-      /// We assume that this function is called from a Signal function.
-      private: void Cleanup();
-
       /// \brief A private helper class used in maintaining connections.
       private: class EventConnection
       {
         /// \brief Constructor
-        public: EventConnection(const bool _on, const std::function<T> &_cb)
-                : callback(_cb)
+        public: EventConnection(const bool _on, const std::function<T> &_cb,
+                    const int _id, common::PluginCounter *_counter)
+                : callback(_cb), id(_id), counter(_counter)
         {
           // Windows Visual Studio 2012 does not have atomic_bool constructor,
           // so we have to set "on" using operator=
@@ -583,21 +676,48 @@ namespace gazebo
 
         /// \brief Callback function
         public: std::function<T> callback;
+
+        /// \brief Id of the connection.
+        public: int id;
+
+        /// \brief Time spent in the callback, null if no plugin connected
+        /// it.
+        public: common::PluginCounter *counter;
       };
 
-      /// \def EvtConnectionMap
-      /// \brief Event Connection map typedef.
-      typedef std::map<int, std::unique_ptr<EventConnection>> EvtConnectionMap;
+      /// \brief Call the callback of a connection. The callbacks connected
+      /// by a plugin run in its PluginScope.
+      /// \param[in] _conn The connection.
+      /// \param[in] _args Parameters of the event.
+      private: template<typename... Args>
+               static void Call(const EventConnection &_conn,
+                   const Args &... _args)
+      {
+        if (!_conn.counter)
+        {
+          _conn.callback(_args...);
+          return;
+        }
+
+        common::PluginScope scope(_conn.counter);
+        _conn.callback(_args...);
+      }
 
-      /// \brief Array of connection callbacks.
-      private: EvtConnectionMap connections;
+      /// \def EvtConnectionList
+      /// \brief Event connection list typedef, in connection order.
+      typedef std::vector<std::shared_ptr<EventConnection>> EvtConnectionList;
 
-      /// \brief A thread lock.
+      /// \brief Connection callbacks. Connect and Disconnect publish a new
+      /// list instead of modifying it, so Signal walks its snapshot without
+      /// locking or allocating. A disconnected callback is destroyed once
+      /// the signals that hold it return.
+      private: std::shared_ptr<const EvtConnectionList> connections;
+
+      /// \brief Serializes Connect and Disconnect.
       private: mutable std::mutex mutex;
 
-      /// \brief List of connections to remove
-      private: std::list<typename EvtConnectionMap::const_iterator>
-              connectionsToRemove;
+      /// \brief Id of the next connection.
+      private: int nextId = 0;
     };
 
     /// \brief Constructor.
@@ -607,12 +727,21 @@ namespace gazebo
     {
     }
 
+    /// \brief Constructor.
+    /// \param[in] _name Name of the event.
+    template<typename T>
+    EventT<T>::EventT(const std::string &_name)
+    : Event(_name)
+    {
+    }
+
     /// \brief Destructor. Deletes all the associated connections.
     template<typename T>
     EventT<T>::~EventT()
     {
       std::lock_guard<std::mutex> lock(this->mutex);
-      this->connections.clear();
+      std::atomic_store(&this->connections,
+          std::shared_ptr<const EvtConnectionList>());
     }
 
     /// \brief Adds a connection.
@@ -620,14 +749,30 @@ namespace gazebo
     template<typename T>
     ConnectionPtr EventT<T>::Connect(const std::function<T> &_subscriber)
     {
+      // Callbacks connected while a plugin loads or runs belong to it
+      common::PluginCounter *counter = nullptr;
+      const unsigned int plugin = common::PluginStats::CurrentPlugin();
+      if (plugin != common::PluginStats::kNoPlugin)
+      {
+        counter =
+          common::PluginStats::Instance()->Counter(plugin, this->Name());
+      }
+
       std::lock_guard<std::mutex> lock(this->mutex);
-      int index = 0;
-      if (!this->connections.empty())
+      const int index = this->nextId++;
+
+      auto list = std::make_shared<EvtConnectionList>();
+      auto current = std::atomic_load(&this->connections);
+      if (current)
       {
-        auto const &iter = this->connections.rbegin();
-        index = iter->first + 1;
+        list->reserve(current->size() + 1);
+        *list = *current;
       }
-      this->connections[index].reset(new EventConnection(true, _subscriber));
+      list->push_back(std::make_shared<EventConnection>(
+            true, _subscriber, index, counter));
+
+      std::atomic_store(&this->connections,
+          std::shared_ptr<const EvtConnectionList>(std::move(list)));
       return ConnectionPtr(new Connection(this, index));
     }
 
@@ -636,8 +781,8 @@ namespace gazebo
     template<typename T>
     unsigned int EventT<T>::ConnectionCount() const
     {
-      std::lock_guard<std::mutex> lock(this->mutex);
-      return this->connections.size();
+      auto current = std::atomic_load(&this->connections);
+      return current ? current->size() : 0u;
     }
 
     /// \brief Removes a connection.
@@ -646,26 +791,28 @@ namespace gazebo
     void EventT<T>::Disconnect(int _id)
     {
       std::lock_guard<std::mutex> lock(this->mutex);
-      // Find the connection
-      auto const &it = this->connections.find(_id);
-
-      if (it != this->connections.end())
-      {
-        it->second->on = false;
-        this->connectionsToRemove.push_back(it);
-      }
-    }
+      auto current = std::atomic_load(&this->connections);
+      if (!current)
+        return;
 
-    /////////////////////////////////////////////
-    /// \brief Erases all connections from connectionsToRemove.
-    template<typename T>
-    void EventT<T>::Cleanup()
-    {
-      std::lock_guard<std::mutex> lock(this->mutex);
-      // Remove all queue connections.
-      for (auto &conn : this->connectionsToRemove)
-        this->connections.erase(conn);
-      this->connectionsToRemove.clear();
+      // Find the connection
+      auto it = std::find_if(current->begin(), current->end(),
+          [_id](const std::shared_ptr<EventConnection> &_conn)
+          {
+            return _conn->id == _id;
+          });
+      if (it == current->end())
+        return;
+
+      // Signals in progress skip the callback from now on.
+      (*it)->on = false;
+
+      auto list = std::make_shared<EvtConnectionList>();
+      list->reserve(current->size() - 1);
+      list->insert(list->end(), current->begin(), it);
+      list->insert(list->end(), it + 1, current->end());
+      std::atomic_store(&this->connections,
+          std::shared_ptr<const EvtConnectionList>(std::move(list)));
     }
     /// \}
   }
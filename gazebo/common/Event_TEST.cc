@@ -18,6 +18,7 @@
 #include <functional>
 #include <future>
 #include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 #include <gazebo/common/Time.hh>
 #include <gazebo/common/Event.hh>
@@ -59,10 +60,9 @@ void callbackDisconnect()
 // Used by the CallbackDisconnect test.
 void callbackDisconnect2()
 {
-  // This function should still be called, even though it was disconnected
-  // in the callDisconnect function. The mutex in Event.hh prevents
-  // a callback from deleting active connections until the event is
-  // complete.
+  // This function is skipped once disconnected in the callbackDisconnect
+  // function. The signal walks a snapshot of the connections, which keeps
+  // them alive until the event is complete.
   ASSERT_TRUE(true);
 }
 
@@ -222,6 +222,60 @@ TEST_F(EventTest, ManyChanges)
   EXPECT_EQ(g_callback1, 2);
 }
 
+/////////////////////////////////////////////////
+// Connections made or removed by a callback apply from the next signal.
+TEST_F(EventTest, ConnectDuringSignal)
+{
+  event::EventT<void ()> evt;
+  event::ConnectionPtr added;
+  event::ConnectionPtr other;
+  int addedCount = 0;
+  int otherCount = 0;
+
+  event::ConnectionPtr conn = evt.Connect([&]()
+      {
+        if (!added)
+          added = evt.Connect([&]() {addedCount++;});
+        other.reset();
+      });
+  other = evt.Connect([&]() {otherCount++;});
+  EXPECT_EQ(2u, evt.ConnectionCount());
+
+  // The new connection is not called, the removed one is skipped
+  evt();
+  EXPECT_EQ(0, addedCount);
+  EXPECT_EQ(0, otherCount);
+  EXPECT_EQ(2u, evt.ConnectionCount());
+
+  evt();
+  EXPECT_EQ(1, addedCount);
+  EXPECT_EQ(0, otherCount);
+
+  conn.reset();
+  added.reset();
+  EXPECT_EQ(0u, evt.ConnectionCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, SignalParallel)
+{
+  event::EventT<void (int)> evt;
+
+  // Nothing connected
+  evt.SignalParallel(1);
+
+  std::vector<int> counts(100, 0);
+  std::vector<event::ConnectionPtr> conns;
+  for (auto &count : counts)
+    conns.push_back(evt.Connect([&count](int _inc) {count += _inc;}));
+  conns[10].reset();
+
+  evt.SignalParallel(2);
+  evt.SignalParallel(3);
+
+  for (unsigned int i = 0; i < counts.size(); ++i)
+    EXPECT_EQ(i == 10 ? 0 : 5, counts[i]);
+}
 
 /////////////////////////////////////////////////
 // Race condition helper functions
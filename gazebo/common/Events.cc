@@ -19,33 +19,39 @@
 using namespace gazebo;
 using namespace event;
 
-EventT<void (bool)> Events::pause;
-EventT<void ()> Events::step;
-EventT<void ()> Events::stop;
-EventT<void ()> Events::sigInt;
-
-EventT<void (std::string)> Events::worldCreated;
-EventT<void (std::string)> Events::entityCreated;
-EventT<void (std::string, std::string)> Events::setSelectedEntity;
-EventT<void (std::string)> Events::addEntity;
-EventT<void (std::string)> Events::deleteEntity;
-
-EventT<void (const common::UpdateInfo &)> Events::worldUpdateBegin;
-EventT<void (const common::UpdateInfo &)> Events::beforePhysicsUpdate;
-
-EventT<void ()> Events::worldUpdateEnd;
-EventT<void ()> Events::worldReset;
-EventT<void ()> Events::timeReset;
-
-EventT<void ()> Events::preRender;
-EventT<void ()> Events::preRenderEnded;
-EventT<void ()> Events::render;
-EventT<void ()> Events::postRender;
-
-EventT<void (std::string)> Events::diagTimerStart;
-EventT<void (std::string)> Events::diagTimerStop;
-
-EventT<void (std::string)> Events::removeSensor;
+EventT<void (bool)> Events::pause("pause");
+EventT<void ()> Events::step("step");
+EventT<void ()> Events::stop("stop");
+EventT<void ()> Events::sigInt("sigInt");
+
+EventT<void (std::string)> Events::worldCreated("worldCreated");
+EventT<void (std::string)> Events::entityCreated("entityCreated");
+EventT<void (std::string, std::string)> Events::setSelectedEntity(
+    "setSelectedEntity");
+EventT<void (std::string)> Events::addEntity("addEntity");
+EventT<void (std::string)> Events::deleteEntity("deleteEntity");
+
+EventT<void (const common::UpdateInfo &)> Events::worldUpdateBegin(
+    "worldUpdateBegin");
+EventT<void (const common::UpdateInfo &)> Events::worldUpdateBeginModelLocal(
+    "worldUpdateBeginModelLocal");
+EventT<void (const common::UpdateInfo &)> Events::beforePhysicsUpdate(
+    "beforePhysicsUpdate");
+
+EventT<void ()> Events::worldUpdateEnd("worldUpdateEnd");
+EventT<void ()> Events::worldReset("worldReset");
+EventT<void ()> Events::timeReset("timeReset");
+
+EventT<void ()> Events::preRender("preRender");
+EventT<void ()> Events::preRenderEnded("preRenderEnded");
+EventT<void ()> Events::render("render");
+EventT<void ()> Events::postRender("postRender");
+
+EventT<void (std::string)> Events::diagTimerStart("diagTimerStart");
+EventT<void (std::string)> Events::diagTimerStop("diagTimerStop");
+
+EventT<void (std::string)> Events::removeSensor("removeSensor");
 
 EventT<void (sdf::ElementPtr, const std::string &,
-    const std::string &, const uint32_t)> Events::createSensor;
+    const std::string &, const uint32_t)> Events::createSensor(
+    "createSensor");
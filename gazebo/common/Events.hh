@@ -108,6 +108,21 @@ namespace gazebo
               static ConnectionPtr ConnectWorldUpdateBegin(T _subscriber)
               { return worldUpdateBegin.Connect(_subscriber); }
 
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Connect a model-local callback to the world update start
+      /// signal.
+      /// \param[in] _subscriber the subscriber to this event
+      /// \return a connection
+      ///
+      /// A model-local callback reads and changes only the state of its own
+      /// model, so it may run in parallel with the other model-local
+      /// callbacks. They all run after the callbacks connected with
+      /// ConnectWorldUpdateBegin, and return before the world update goes on.
+      public: template<typename T>
+              static ConnectionPtr ConnectWorldUpdateBeginModelLocal(
+                  T _subscriber)
+              { return worldUpdateBeginModelLocal.Connect(_subscriber); }
+
       //////////////////////////////////////////////////////////////////////////
       /// \brief Connect a callback to the before physics update signal
       /// \param[in] _subscriber the subscriber to this event
@@ -246,6 +261,10 @@ namespace gazebo
       /// \brief World update has started
       public: static EventT<void (const common::UpdateInfo &)> worldUpdateBegin;
 
+      /// \brief World update has started, for model-local callbacks
+      public: static EventT<void (const common::UpdateInfo &)>
+                worldUpdateBeginModelLocal;
+
       /// \brief Collision detection has been done, physics update not yet
       public: static EventT<void (const common::UpdateInfo &)>
                 beforePhysicsUpdate;
@@ -18,8 +18,11 @@
 #include <sys/stat.h>
 #include <tinyxml.h>
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <set>
 #include <string>
 #include <thread>
 #include <vector>
@@ -53,6 +56,9 @@ class gazebo::common::FuelModelDatabasePrivate
 {
   /// \brief A client to interact with Ignition Fuel.
   public: std::unique_ptr<ignition::fuel_tools::FuelClient> fuelClient;
+
+  /// \brief Maximum number of simultaneous downloads.
+  public: unsigned int maxDownloads = 8;
 };
 
 /////////////////////////////////////////////////
@@ -80,6 +86,10 @@ FuelModelDatabase::FuelModelDatabase()
   conf.SetUserAgent(userAgent);
   this->dataPtr->fuelClient.reset(new ignition::fuel_tools::FuelClient(conf));
 
+  const char *maxDownloads = getenv("GAZEBO_MAX_DOWNLOADS");
+  if (maxDownloads && atoi(maxDownloads) > 0)
+    this->dataPtr->maxDownloads = atoi(maxDownloads);
+
   common::SystemPaths::Instance()->AddFindFileCallback(std::bind(
       &FuelModelDatabase::CachedFilePath, this, std::placeholders::_1));
 }
@@ -322,3 +332,69 @@ std::string FuelModelDatabase::CachedFilePath(const std::string &_uri)
 
   return path;
 }
+
+/////////////////////////////////////////////////
+void FuelModelDatabase::Prefetch(const std::vector<std::string> &_uris)
+{
+  // URIs of the models that are not cached yet
+  std::vector<std::string> models;
+  std::set<std::string> names;
+  for (auto const &uri : _uris)
+  {
+    auto fuelUri = ignition::common::URI(uri);
+    if (fuelUri.Scheme() != "http" && fuelUri.Scheme() != "https")
+      continue;
+
+    std::string modelUri;
+    std::string fileUrl;
+    ignition::fuel_tools::ModelIdentifier model;
+    if (this->dataPtr->fuelClient->ParseModelUrl(fuelUri, model))
+      modelUri = uri;
+    else if (this->dataPtr->fuelClient->ParseModelFileUrl(
+          fuelUri, model, fileUrl))
+    {
+      modelUri = uri.substr(0, uri.find("files", model.UniqueName().size())-1);
+    }
+    else
+      continue;
+
+    std::string path;
+    if (!names.insert(model.UniqueName()).second ||
+        this->dataPtr->fuelClient->CachedModel(
+          ignition::common::URI(modelUri), path))
+    {
+      continue;
+    }
+    models.push_back(modelUri);
+  }
+
+  if (models.empty())
+    return;
+
+  gzmsg << "Downloading " << models.size() << " models from Fuel\n";
+
+  // Each worker downloads models until none are left
+  std::atomic<size_t> next(0);
+  auto download = [this, &models, &next]()
+  {
+    for (size_t i = next++; i < models.size(); i = next++)
+    {
+      std::string path;
+      if (!this->dataPtr->fuelClient->DownloadModel(
+            ignition::common::URI(models[i]), path))
+      {
+        gzwarn << "Unable to prefetch model[" << models[i] << "]\n";
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  const size_t workerCount = std::min(models.size(),
+      static_cast<size_t>(this->dataPtr->maxDownloads));
+  for (size_t i = 1; i < workerCount; ++i)
+    workers.emplace_back(download);
+  download();
+
+  for (auto &worker : workers)
+    worker.join();
+}
@@ -123,6 +123,16 @@ namespace gazebo
       /// \return Local path to the file
       public: std::string CachedFilePath(const std::string &_uri);
 
+      /// \brief Download the models of the given URIs that are not in the
+      /// local cache, with simultaneous downloads.
+      ///
+      /// Later calls to ModelPath find the models in the cache. This is a
+      /// blocking call. The number of simultaneous downloads is set by the
+      /// GAZEBO_MAX_DOWNLOADS environment variable, 8 by default.
+      /// \param[in] _uris Model or model file URIs. URIs that are not Fuel
+      /// URIs are ignored.
+      public: void Prefetch(const std::vector<std::string> &_uris);
+
       /// \brief Private data.
       private: std::unique_ptr<FuelModelDatabasePrivate> dataPtr;
 
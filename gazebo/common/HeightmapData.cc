@@ -15,6 +15,8 @@
  *
 */
 
+#include <algorithm>
+
 #include <gazebo/gazebo_config.h>
 
 #ifdef HAVE_GDAL
@@ -35,6 +37,33 @@
 using namespace gazebo;
 using namespace common;
 
+//////////////////////////////////////////////////
+void HeightmapData::FillHeightMapRegion(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _width,
+    unsigned int _height, std::vector<float> &_heights)
+{
+  _heights.clear();
+  if (_x >= _vertSize || _y >= _vertSize)
+    return;
+  _width = std::min(_width, _vertSize - _x);
+  _height = std::min(_height, _vertSize - _y);
+
+  // Formats without a region fill build the whole table.
+  std::vector<float> all;
+  this->FillHeightMap(_subSampling, _vertSize, _size, _scale, _flipY, all);
+  if (all.size() < static_cast<size_t>(_vertSize) * _vertSize)
+    return;
+
+  _heights.reserve(static_cast<size_t>(_width) * _height);
+  for (unsigned int row = _y; row < _y + _height; ++row)
+  {
+    auto begin = all.begin() + static_cast<size_t>(row) * _vertSize + _x;
+    _heights.insert(_heights.end(), begin, begin + _width);
+  }
+}
+
 //////////////////////////////////////////////////
 HeightmapData *HeightmapDataLoader::LoadImageAsTerrain(
     const std::string &_filename)
@@ -57,6 +57,27 @@ namespace gazebo
           const ignition::math::Vector3d &_scale, bool _flipY,
           std::vector<float> &_heights) = 0;
 
+      /// \brief Fill a rectangle of the lookup table of the terrain's
+      /// height, without building the whole table. The rectangle is given
+      /// in the coordinates of the table filled by FillHeightMap, so its
+      /// values match that table.
+      /// \param[in] _subSampling Multiplier used to increase the resolution.
+      /// \param[in] _vertSize Number of points per row of the whole table.
+      /// \param[in] _size Real dimmensions of the terrain.
+      /// \param[in] _scale Vector3 used to scale the height.
+      /// \param[in] _flipY If true, the rows of the table are inverted.
+      /// \param[in] _x First column of the rectangle.
+      /// \param[in] _y First row of the rectangle.
+      /// \param[in] _width Number of columns of the rectangle.
+      /// \param[in] _height Number of rows of the rectangle.
+      /// \param[out] _heights Heights of the rectangle, row by row.
+      public: virtual void FillHeightMapRegion(int _subSampling,
+          unsigned int _vertSize, const ignition::math::Vector3d &_size,
+          const ignition::math::Vector3d &_scale, bool _flipY,
+          unsigned int _x, unsigned int _y,
+          unsigned int _width, unsigned int _height,
+          std::vector<float> &_heights);
+
       /// \brief Get the terrain's height.
       /// \return The terrain's height.
       public: virtual unsigned int GetHeight() const = 0;
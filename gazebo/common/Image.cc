@@ -21,12 +21,14 @@
 
 #include <FreeImage.h>
 #include <boost/filesystem.hpp>
+#include <cstring>
 #include <string>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Image.hh"
+#include "gazebo/common/PixelConversions.hh"
 
 using namespace gazebo;
 using namespace common;
@@ -369,12 +371,43 @@ ignition::math::Color Image::MaxColor() const
 //////////////////////////////////////////////////
 void Image::Rescale(int _width, int _height)
 {
+  if (!this->Valid() || _width <= 0 || _height <= 0)
+    return;
+
+  FIBITMAP *scaled = nullptr;
 #ifndef _WIN32
-  this->bitmap = FreeImage_Rescale(this->bitmap, _width, _height,
-      FILTER_LANCZOS3);
+  scaled = FreeImage_Rescale(this->bitmap, _width, _height, FILTER_LANCZOS3);
 #else
-  gzerr << "Image::Rescale is not implemented on Windows.\n";
+  // Bilinear filtering of 8 bit channels
+  unsigned int bpp = FreeImage_GetBPP(this->bitmap);
+  if (FreeImage_GetImageType(this->bitmap) == FIT_BITMAP &&
+      (bpp == 8 || bpp == 24 || bpp == 32))
+  {
+    scaled = FreeImage_Allocate(_width, _height, bpp, FI_RGBA_RED_MASK,
+        FI_RGBA_GREEN_MASK, FI_RGBA_BLUE_MASK);
+    if (scaled && bpp == 8)
+    {
+      std::memcpy(FreeImage_GetPalette(scaled),
+          FreeImage_GetPalette(this->bitmap), 256 * sizeof(RGBQUAD));
+    }
+    if (scaled)
+    {
+      ResizeImage(FreeImage_GetBits(this->bitmap), this->GetWidth(),
+          this->GetHeight(), FreeImage_GetPitch(this->bitmap),
+          FreeImage_GetBits(scaled), _width, _height,
+          FreeImage_GetPitch(scaled), bpp / 8);
+    }
+  }
 #endif
+
+  if (!scaled)
+  {
+    gzerr << "Unable to rescale image [" << this->fullName << "]\n";
+    return;
+  }
+
+  FreeImage_Unload(this->bitmap);
+  this->bitmap = scaled;
 }
 
 //////////////////////////////////////////////////
@@ -15,6 +15,8 @@
  *
  */
 
+#include <algorithm>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/ImageHeightmap.hh"
@@ -45,8 +47,25 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
     const ignition::math::Vector3d &_scale, bool _flipY,
     std::vector<float> &_heights)
 {
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
+  this->FillHeightMapRegion(_subSampling, _vertSize, _size, _scale, _flipY,
+      0, 0, _vertSize, _vertSize, _heights);
+}
+
+//////////////////////////////////////////////////
+void ImageHeightmap::FillHeightMapRegion(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _width,
+    unsigned int _height, std::vector<float> &_heights)
+{
+  _heights.clear();
+  if (_x >= _vertSize || _y >= _vertSize)
+    return;
+  _width = std::min(_width, _vertSize - _x);
+  _height = std::min(_height, _vertSize - _y);
+
+  // Resize the vector to match the size of the region.
+  _heights.resize(static_cast<size_t>(_width) * _height);
 
   int imgHeight = this->GetHeight();
   int imgWidth = this->GetWidth();
@@ -63,9 +82,11 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
   unsigned int count;
   this->img.GetData(&data, count);
 
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  // Iterate over the vertices of the region
+  for (unsigned int row = _y; row < _y + _height; ++row)
   {
+    unsigned int y = _flipY ? _vertSize - row - 1 : row;
+
     // yf ranges between 0 and 4
     double yf = y / static_cast<double>(_subSampling);
     int y1 = floor(yf);
@@ -74,7 +95,7 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
       y2 = imgHeight-1;
     double dy = yf - y1;
 
-    for (unsigned int x = 0; x < _vertSize; ++x)
+    for (unsigned int x = _x; x < _x + _width; ++x)
     {
       double xf = x / static_cast<double>(_subSampling);
       int x1 = floor(xf);
@@ -100,10 +121,7 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
         h = 1.0 - h;
 
       // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
+      _heights[(row - _y) * _width + (x - _x)] = h;
     }
   }
 
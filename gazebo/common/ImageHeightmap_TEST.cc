@@ -103,6 +103,50 @@ TEST_F(ImageHeightmapTest, FillHeightmap)
   EXPECT_NEAR(5.0, elevations.at(elevations.size() / 2), ELEVATION_TOL);
 }
 
+/////////////////////////////////////////////////
+TEST_F(ImageHeightmapTest, FillHeightmapRegion)
+{
+  common::ImageHeightmap img;
+  EXPECT_EQ(0, img.Load("file://media/materials/textures/heightmap_bowl.png"));
+
+  int subsampling = 2;
+  unsigned int vertSize = (img.GetWidth() * subsampling) - subsampling + 1;
+  ignition::math::Vector3d size(129, 129, 10);
+  ignition::math::Vector3d scale(size.X() / vertSize, size.Y() / vertSize,
+      size.Z() / img.GetMaxElevation());
+
+  for (bool flipY : {false, true})
+  {
+    std::vector<float> elevations;
+    img.FillHeightMap(subsampling, vertSize, size, scale, flipY, elevations);
+    ASSERT_EQ(vertSize * vertSize, elevations.size());
+
+    // A region has the values of the whole table.
+    std::vector<float> region;
+    img.FillHeightMapRegion(subsampling, vertSize, size, scale, flipY,
+        30, 200, 40, 20, region);
+    ASSERT_EQ(40u * 20u, region.size());
+    for (unsigned int y = 0; y < 20; ++y)
+    {
+      for (unsigned int x = 0; x < 40; ++x)
+      {
+        EXPECT_FLOAT_EQ(elevations[(200 + y) * vertSize + 30 + x],
+            region[y * 40 + x]);
+      }
+    }
+
+    // Regions are clipped to the table.
+    img.FillHeightMapRegion(subsampling, vertSize, size, scale, flipY,
+        vertSize - 10, vertSize - 5, 40, 40, region);
+    EXPECT_EQ(10u * 5u, region.size());
+    EXPECT_FLOAT_EQ(elevations.back(), region.back());
+
+    img.FillHeightMapRegion(subsampling, vertSize, size, scale, flipY,
+        vertSize, 0, 40, 40, region);
+    EXPECT_TRUE(region.empty());
+  }
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
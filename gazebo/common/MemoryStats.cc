@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/MemoryStats.hh"
+
+using namespace gazebo;
+using namespace common;
+
+const unsigned int MemoryStats::kMaxTags;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for MemoryStats.
+    class MemoryStatsPrivate
+    {
+      /// \brief Names of the tags, indexed by tag id.
+      public: std::vector<std::string> names;
+
+      /// \brief Protects names.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+/// \brief Counters of a tag. Kept outside of the singleton, their storage
+/// is trivially destructible and stays valid during static destruction.
+struct TagCounters
+{
+  /// \brief Bytes held.
+  std::atomic<int64_t> bytes;
+
+  /// \brief Peak bytes held.
+  std::atomic<int64_t> peak;
+
+  /// \brief Objects held.
+  std::atomic<int64_t> objects;
+};
+
+/// \brief Counters of every tag, the last one collects unregistered tags.
+static TagCounters tagCounters[MemoryStats::kMaxTags + 1];
+
+//////////////////////////////////////////////////
+MemoryStats::MemoryStats()
+  : dataPtr(new MemoryStatsPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+MemoryStats::~MemoryStats()
+{
+}
+
+//////////////////////////////////////////////////
+unsigned int MemoryStats::Tag(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto iter = std::find(this->dataPtr->names.begin(),
+      this->dataPtr->names.end(), _name);
+  if (iter != this->dataPtr->names.end())
+    return static_cast<unsigned int>(iter - this->dataPtr->names.begin());
+
+  if (this->dataPtr->names.size() >= kMaxTags)
+  {
+    gzerr << "Too many memory tags, [" << _name << "] is not reported"
+      << std::endl;
+    return kMaxTags;
+  }
+
+  this->dataPtr->names.push_back(_name);
+  return static_cast<unsigned int>(this->dataPtr->names.size() - 1);
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> MemoryStats::TagNames() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->names;
+}
+
+//////////////////////////////////////////////////
+void MemoryStats::Add(const unsigned int _tag, const int64_t _bytes,
+    const int64_t _objects)
+{
+  TagCounters &counters = tagCounters[std::min(_tag, kMaxTags)];
+
+  const int64_t bytes = counters.bytes.fetch_add(_bytes) + _bytes;
+  if (_objects != 0)
+    counters.objects.fetch_add(_objects);
+
+  int64_t peak = counters.peak.load();
+  while (bytes > peak && !counters.peak.compare_exchange_weak(peak, bytes))
+  {
+  }
+}
+
+//////////////////////////////////////////////////
+int64_t MemoryStats::Bytes(const unsigned int _tag)
+{
+  return tagCounters[std::min(_tag, kMaxTags)].bytes.load();
+}
+
+//////////////////////////////////////////////////
+int64_t MemoryStats::PeakBytes(const unsigned int _tag)
+{
+  return tagCounters[std::min(_tag, kMaxTags)].peak.load();
+}
+
+//////////////////////////////////////////////////
+int64_t MemoryStats::Objects(const unsigned int _tag)
+{
+  return tagCounters[std::min(_tag, kMaxTags)].objects.load();
+}
+
+//////////////////////////////////////////////////
+uint64_t MemoryStats::ResidentBytes()
+{
+#ifdef __linux__
+  // The second field is the resident set size in pages
+  std::ifstream statm("/proc/self/statm");
+  uint64_t size = 0;
+  uint64_t resident = 0;
+  if (statm >> size >> resident)
+    return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+  return 0;
+}
+
+//////////////////////////////////////////////////
+MemoryCharge::MemoryCharge(const std::string &_tag)
+  : tag(MemoryStats::Instance()->Tag(_tag))
+{
+}
+
+//////////////////////////////////////////////////
+MemoryCharge::~MemoryCharge()
+{
+  this->Clear();
+}
+
+//////////////////////////////////////////////////
+void MemoryCharge::Add(const int64_t _bytes, const int64_t _objects)
+{
+  this->bytes += _bytes;
+  this->objects += _objects;
+  MemoryStats::Add(this->tag, _bytes, _objects);
+}
+
+//////////////////////////////////////////////////
+void MemoryCharge::Set(const int64_t _bytes, const int64_t _objects)
+{
+  if (_bytes != this->bytes || _objects != this->objects)
+    this->Add(_bytes - this->bytes, _objects - this->objects);
+}
+
+//////////////////////////////////////////////////
+void MemoryCharge::Set(const int64_t _bytes)
+{
+  this->Set(_bytes, this->objects);
+}
+
+//////////////////////////////////////////////////
+void MemoryCharge::Clear()
+{
+  this->Set(0, 0);
+}
+
+//////////////////////////////////////////////////
+int64_t MemoryCharge::Bytes() const
+{
+  return this->bytes;
+}
+
+//////////////////////////////////////////////////
+int64_t MemoryCharge::Objects() const
+{
+  return this->objects;
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MEMORYSTATS_HH_
+#define GAZEBO_COMMON_MEMORYSTATS_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, MemoryStats)
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class MemoryStatsPrivate;
+
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class MemoryStats MemoryStats.hh common/common.hh
+    /// \brief Bytes held by the large buffers of each subsystem, by named
+    /// tag, e.g. "MeshManager/meshes".
+    ///
+    /// The resident memory of the process does not tell which subsystem
+    /// holds it. Subsystems charge their large buffers to a tag with a
+    /// MemoryCharge: mesh data, contact pools, transport write queues, log
+    /// buffers and camera images. Counters are atomic, charging does not
+    /// lock, and they stay valid until the process exits so that static
+    /// objects may release their charges when destroyed.
+    class GZ_COMMON_VISIBLE MemoryStats : public SingletonT<MemoryStats>
+    {
+      /// \brief Maximum number of tags.
+      public: static const unsigned int kMaxTags = 64;
+
+      /// \brief Get the id of a tag, registering it on first use.
+      /// \param[in] _name Name of the tag.
+      /// \return Tag id, kMaxTags if too many tags were registered.
+      public: unsigned int Tag(const std::string &_name);
+
+      /// \brief Get the names of the registered tags.
+      /// \return Names, indexed by tag id.
+      public: std::vector<std::string> TagNames() const;
+
+      /// \brief Change the memory charged to a tag. Does not lock.
+      /// \param[in] _tag Tag id returned by Tag.
+      /// \param[in] _bytes Bytes allocated, negative when released.
+      /// \param[in] _objects Objects allocated, negative when released.
+      public: static void Add(const unsigned int _tag, const int64_t _bytes,
+                  const int64_t _objects = 0);
+
+      /// \brief Get the bytes charged to a tag.
+      /// \param[in] _tag Tag id.
+      /// \return Bytes currently held.
+      public: static int64_t Bytes(const unsigned int _tag);
+
+      /// \brief Get the most bytes ever charged to a tag at once.
+      /// \param[in] _tag Tag id.
+      /// \return Peak bytes.
+      public: static int64_t PeakBytes(const unsigned int _tag);
+
+      /// \brief Get the number of objects charged to a tag, e.g. meshes or
+      /// queued messages.
+      /// \param[in] _tag Tag id.
+      /// \return Objects currently held.
+      public: static int64_t Objects(const unsigned int _tag);
+
+      /// \brief Get the resident memory of the process.
+      /// \return Resident memory in bytes, 0 if unknown on this platform.
+      public: static uint64_t ResidentBytes();
+
+      /// \brief Constructor.
+      private: MemoryStats();
+
+      /// \brief Destructor.
+      private: virtual ~MemoryStats();
+
+      /// \brief This is a singleton.
+      private: friend class SingletonT<MemoryStats>;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MemoryStatsPrivate> dataPtr;
+    };
+
+    /// \class MemoryCharge MemoryStats.hh common/common.hh
+    /// \brief Memory charged to a MemoryStats tag by one owner. The charge
+    /// is released when the owner is destroyed.
+    class GZ_COMMON_VISIBLE MemoryCharge
+    {
+      /// \brief Constructor.
+      /// \param[in] _tag Name of the tag, see MemoryStats::Tag.
+      public: explicit MemoryCharge(const std::string &_tag);
+
+      /// \brief Destructor, releases the charge.
+      public: ~MemoryCharge();
+
+      /// \brief Change the charge.
+      /// \param[in] _bytes Bytes allocated, negative when released.
+      /// \param[in] _objects Objects allocated, negative when released.
+      public: void Add(const int64_t _bytes, const int64_t _objects = 0);
+
+      /// \brief Set the charge, e.g. to the capacity of a buffer.
+      /// \param[in] _bytes Bytes held.
+      /// \param[in] _objects Objects held.
+      public: void Set(const int64_t _bytes, const int64_t _objects);
+
+      /// \brief Set the bytes of the charge, keeping the objects.
+      /// \param[in] _bytes Bytes held.
+      public: void Set(const int64_t _bytes);
+
+      /// \brief Release the charge.
+      public: void Clear();
+
+      /// \brief Get the bytes of the charge.
+      /// \return Bytes held.
+      public: int64_t Bytes() const;
+
+      /// \brief Get the objects of the charge.
+      /// \return Objects held.
+      public: int64_t Objects() const;
+
+      /// \brief Not copyable, the charge has one owner.
+      private: MemoryCharge(const MemoryCharge &) = delete;
+
+      /// \brief Not copyable, the charge has one owner.
+      private: MemoryCharge &operator=(const MemoryCharge &) = delete;
+
+      /// \brief Tag id.
+      private: unsigned int tag;
+
+      /// \brief Bytes held.
+      private: int64_t bytes = 0;
+
+      /// \brief Objects held.
+      private: int64_t objects = 0;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/MemoryStats.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MemoryStatsTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(MemoryStatsTest, Tags)
+{
+  common::MemoryStats *stats = common::MemoryStats::Instance();
+
+  const unsigned int a = stats->Tag("MemoryStatsTest/a");
+  const unsigned int b = stats->Tag("MemoryStatsTest/b");
+  EXPECT_NE(a, b);
+  EXPECT_EQ(a, stats->Tag("MemoryStatsTest/a"));
+
+  std::vector<std::string> names = stats->TagNames();
+  ASSERT_LT(b, names.size());
+  EXPECT_EQ("MemoryStatsTest/a", names[a]);
+  EXPECT_EQ("MemoryStatsTest/b", names[b]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MemoryStatsTest, Charge)
+{
+  const unsigned int tag =
+    common::MemoryStats::Instance()->Tag("MemoryStatsTest/charge");
+  EXPECT_EQ(0, common::MemoryStats::Bytes(tag));
+
+  {
+    common::MemoryCharge first("MemoryStatsTest/charge");
+    first.Add(100, 1);
+    EXPECT_EQ(100, first.Bytes());
+    EXPECT_EQ(1, first.Objects());
+
+    std::unique_ptr<common::MemoryCharge> second(
+        new common::MemoryCharge("MemoryStatsTest/charge"));
+    second->Set(50, 2);
+    EXPECT_EQ(150, common::MemoryStats::Bytes(tag));
+    EXPECT_EQ(3, common::MemoryStats::Objects(tag));
+
+    // Released with its owner
+    second.reset();
+    EXPECT_EQ(100, common::MemoryStats::Bytes(tag));
+    EXPECT_EQ(1, common::MemoryStats::Objects(tag));
+
+    first.Set(20);
+    EXPECT_EQ(20, common::MemoryStats::Bytes(tag));
+    EXPECT_EQ(1, common::MemoryStats::Objects(tag));
+    EXPECT_EQ(150, common::MemoryStats::PeakBytes(tag));
+
+    first.Clear();
+    EXPECT_EQ(0, common::MemoryStats::Bytes(tag));
+  }
+  EXPECT_EQ(0, common::MemoryStats::Bytes(tag));
+  EXPECT_EQ(0, common::MemoryStats::Objects(tag));
+  EXPECT_EQ(150, common::MemoryStats::PeakBytes(tag));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MemoryStatsTest, Threads)
+{
+  const unsigned int tag =
+    common::MemoryStats::Instance()->Tag("MemoryStatsTest/threads");
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.push_back(std::thread([tag]()
+    {
+      for (int j = 0; j < 10000; ++j)
+        common::MemoryStats::Add(tag, 3, 1);
+    }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(4 * 10000 * 3, common::MemoryStats::Bytes(tag));
+  EXPECT_EQ(4 * 10000, common::MemoryStats::Objects(tag));
+  EXPECT_EQ(common::MemoryStats::Bytes(tag),
+      common::MemoryStats::PeakBytes(tag));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MemoryStatsTest, ResidentBytes)
+{
+#ifdef __linux__
+  EXPECT_GT(common::MemoryStats::ResidentBytes(), 0u);
+#endif
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,319 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshBVH.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace
+{
+  /// \brief Largest number of triangles in a leaf.
+  const uint32_t kLeafSize = 4;
+
+  /// \brief Node of the hierarchy.
+  struct Node
+  {
+    /// \brief Minimum corner of the bounding box.
+    ignition::math::Vector3d min;
+
+    /// \brief Maximum corner of the bounding box.
+    ignition::math::Vector3d max;
+
+    /// \brief Index of the first triangle for a leaf, of the second child
+    /// for an inner node. The first child follows the node.
+    uint32_t index = 0;
+
+    /// \brief Number of triangles, zero for an inner node.
+    uint32_t count = 0;
+  };
+}
+
+/// \internal
+/// \brief Private data for MeshBVH
+class gazebo::common::MeshBVHPrivate
+{
+  /// \brief Build the node of a range of triangles.
+  /// \param[in] _first First triangle.
+  /// \param[in] _count Number of triangles.
+  public: void Build(const uint32_t _first, const uint32_t _count);
+
+  /// \brief Get the centroid of a triangle.
+  /// \param[in] _triangle Triangle index.
+  /// \return Sum of the vertices.
+  public: ignition::math::Vector3d Centroid(const uint32_t _triangle) const
+  {
+    return this->vertices[this->indices[_triangle * 3]] +
+        this->vertices[this->indices[_triangle * 3 + 1]] +
+        this->vertices[this->indices[_triangle * 3 + 2]];
+  }
+
+  /// \brief Vertices of all submeshes.
+  public: std::vector<ignition::math::Vector3d> vertices;
+
+  /// \brief Three vertex indices per triangle.
+  public: std::vector<uint32_t> indices;
+
+  /// \brief Order of the triangles in the leaves.
+  public: std::vector<uint32_t> triangles;
+
+  /// \brief Nodes, the root first.
+  public: std::vector<Node> nodes;
+};
+
+/////////////////////////////////////////////////
+void MeshBVHPrivate::Build(const uint32_t _first, const uint32_t _count)
+{
+  const size_t nodeIndex = this->nodes.size();
+  this->nodes.emplace_back();
+
+  ignition::math::Vector3d min(std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+  ignition::math::Vector3d max = -min;
+  ignition::math::Vector3d centroidMin = min;
+  ignition::math::Vector3d centroidMax = max;
+  for (uint32_t i = _first; i < _first + _count; ++i)
+  {
+    const uint32_t triangle = this->triangles[i];
+    for (int j = 0; j < 3; ++j)
+    {
+      const ignition::math::Vector3d &v =
+          this->vertices[this->indices[triangle * 3 + j]];
+      min.Min(v);
+      max.Max(v);
+    }
+    const ignition::math::Vector3d centroid = this->Centroid(triangle);
+    centroidMin.Min(centroid);
+    centroidMax.Max(centroid);
+  }
+  this->nodes[nodeIndex].min = min;
+  this->nodes[nodeIndex].max = max;
+
+  if (_count <= kLeafSize)
+  {
+    this->nodes[nodeIndex].index = _first;
+    this->nodes[nodeIndex].count = _count;
+    return;
+  }
+
+  // Split at the median centroid along the longest axis of the centroids
+  const ignition::math::Vector3d extent = centroidMax - centroidMin;
+  int axis = 0;
+  if (extent.Y() > extent[axis])
+    axis = 1;
+  if (extent.Z() > extent[axis])
+    axis = 2;
+
+  const uint32_t half = _count / 2;
+  auto begin = this->triangles.begin() + _first;
+  std::nth_element(begin, begin + half, begin + _count,
+      [this, axis](const uint32_t _a, const uint32_t _b)
+      {
+        return this->Centroid(_a)[axis] < this->Centroid(_b)[axis];
+      });
+
+  this->Build(_first, half);
+  this->nodes[nodeIndex].index = static_cast<uint32_t>(this->nodes.size());
+  this->Build(_first + half, _count - half);
+}
+
+/////////////////////////////////////////////////
+MeshBVH::MeshBVH(const Mesh *_mesh)
+  : dataPtr(new MeshBVHPrivate)
+{
+  if (!_mesh)
+    return;
+
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh->GetSubMesh(i);
+    if (subMesh->GetPrimitiveType() != SubMesh::TRIANGLES)
+      continue;
+
+    const uint32_t offset =
+        static_cast<uint32_t>(this->dataPtr->vertices.size());
+    const unsigned int vertexCount = subMesh->GetVertexCount();
+    for (unsigned int j = 0; j < vertexCount; ++j)
+      this->dataPtr->vertices.push_back(subMesh->Vertex(j));
+
+    const unsigned int indexCount = subMesh->GetIndexCount() / 3 * 3;
+    for (unsigned int j = 0; j < indexCount; j += 3)
+    {
+      const unsigned int a = subMesh->GetIndex(j);
+      const unsigned int b = subMesh->GetIndex(j + 1);
+      const unsigned int c = subMesh->GetIndex(j + 2);
+      if (a >= vertexCount || b >= vertexCount || c >= vertexCount)
+        continue;
+
+      this->dataPtr->indices.push_back(offset + a);
+      this->dataPtr->indices.push_back(offset + b);
+      this->dataPtr->indices.push_back(offset + c);
+    }
+  }
+
+  const uint32_t count =
+      static_cast<uint32_t>(this->dataPtr->indices.size() / 3);
+  if (count == 0)
+    return;
+
+  this->dataPtr->triangles.resize(count);
+  for (uint32_t i = 0; i < count; ++i)
+    this->dataPtr->triangles[i] = i;
+  this->dataPtr->nodes.reserve(2 * (count / kLeafSize + 1));
+  this->dataPtr->Build(0, count);
+}
+
+/////////////////////////////////////////////////
+MeshBVH::~MeshBVH()
+{
+}
+
+/////////////////////////////////////////////////
+size_t MeshBVH::TriangleCount() const
+{
+  return this->dataPtr->triangles.size();
+}
+
+/////////////////////////////////////////////////
+size_t MeshBVH::NodeCount() const
+{
+  return this->dataPtr->nodes.size();
+}
+
+/////////////////////////////////////////////////
+bool MeshBVH::Intersect(const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_dir, double &_distance,
+    ignition::math::Triangle3d &_triangle, const bool _backFaces) const
+{
+  const auto &nodes = this->dataPtr->nodes;
+  const auto &vertices = this->dataPtr->vertices;
+  const auto &indices = this->dataPtr->indices;
+  if (nodes.empty())
+    return false;
+
+  const double inf = std::numeric_limits<double>::infinity();
+  const ignition::math::Vector3d invDir(
+      _dir.X() != 0 ? 1.0 / _dir.X() : inf,
+      _dir.Y() != 0 ? 1.0 / _dir.Y() : inf,
+      _dir.Z() != 0 ? 1.0 / _dir.Z() : inf);
+
+  // Slab test, returns the entry distance or infinity on a miss.
+  auto boxEntry = [&](const Node &_node, const double _maxDist)
+  {
+    double tMin = 0;
+    double tMax = _maxDist;
+    for (int i = 0; i < 3; ++i)
+    {
+      double t1 = (_node.min[i] - _origin[i]) * invDir[i];
+      double t2 = (_node.max[i] - _origin[i]) * invDir[i];
+      // 0 * inf for a ray in the plane of a face of the box
+      if (std::isnan(t1) || std::isnan(t2))
+      {
+        if (_origin[i] < _node.min[i] || _origin[i] > _node.max[i])
+          return inf;
+        continue;
+      }
+      if (t1 > t2)
+        std::swap(t1, t2);
+      tMin = std::max(tMin, t1);
+      tMax = std::min(tMax, t2);
+      if (tMin > tMax)
+        return inf;
+    }
+    return tMin;
+  };
+
+  double closest = inf;
+  uint32_t closestTriangle = 0;
+
+  uint32_t stack[64];
+  int stackSize = 0;
+  stack[stackSize++] = 0;
+  while (stackSize > 0)
+  {
+    const Node &node = nodes[stack[--stackSize]];
+    if (boxEntry(node, closest) == inf)
+      continue;
+
+    if (node.count == 0)
+    {
+      // Visit the nearer child first
+      const uint32_t first = static_cast<uint32_t>(&node - nodes.data()) + 1;
+      const uint32_t second = node.index;
+      if (boxEntry(nodes[first], closest) <= boxEntry(nodes[second], closest))
+      {
+        stack[stackSize++] = second;
+        stack[stackSize++] = first;
+      }
+      else
+      {
+        stack[stackSize++] = first;
+        stack[stackSize++] = second;
+      }
+      continue;
+    }
+
+    for (uint32_t i = node.index; i < node.index + node.count; ++i)
+    {
+      // Moller-Trumbore
+      const uint32_t triangle = this->dataPtr->triangles[i];
+      const ignition::math::Vector3d &a = vertices[indices[triangle * 3]];
+      const ignition::math::Vector3d &b = vertices[indices[triangle * 3 + 1]];
+      const ignition::math::Vector3d &c = vertices[indices[triangle * 3 + 2]];
+      const ignition::math::Vector3d edge1 = b - a;
+      const ignition::math::Vector3d edge2 = c - a;
+      const ignition::math::Vector3d p = _dir.Cross(edge2);
+      const double det = edge1.Dot(p);
+      if (std::abs(det) < 1e-12 || (!_backFaces && det < 0))
+        continue;
+
+      const double invDet = 1.0 / det;
+      const ignition::math::Vector3d s = _origin - a;
+      const double u = s.Dot(p) * invDet;
+      if (u < 0 || u > 1)
+        continue;
+
+      const ignition::math::Vector3d q = s.Cross(edge1);
+      const double v = _dir.Dot(q) * invDet;
+      if (v < 0 || u + v > 1)
+        continue;
+
+      const double t = edge2.Dot(q) * invDet;
+      if (t >= 0 && t < closest)
+      {
+        closest = t;
+        closestTriangle = triangle;
+      }
+    }
+  }
+
+  if (closest == inf)
+    return false;
+
+  _distance = closest;
+  _triangle.Set(vertices[indices[closestTriangle * 3]],
+      vertices[indices[closestTriangle * 3 + 1]],
+      vertices[indices[closestTriangle * 3 + 2]]);
+  return true;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MESHBVH_HH_
+#define GAZEBO_COMMON_MESHBVH_HH_
+
+#include <cstddef>
+#include <memory>
+
+#include <ignition/math/Triangle3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+    class MeshBVHPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class MeshBVH MeshBVH.hh common/common.hh
+    /// \brief Bounding volume hierarchy of the triangles of a mesh, for
+    /// ray casts against meshes with many triangles.
+    ///
+    /// The hierarchy is built once in the frame of the mesh, from the
+    /// triangles of all its submeshes. Rays are cast in that frame, so a
+    /// hierarchy can be shared by every visual that shows the mesh:
+    /// transform the ray with the inverse of the world transform of the
+    /// visual instead of transforming the vertices.
+    /// \sa MeshManager::BVH
+    class GZ_COMMON_VISIBLE MeshBVH
+    {
+      /// \brief Constructor, builds the hierarchy.
+      /// \param[in] _mesh The mesh.
+      public: explicit MeshBVH(const Mesh *_mesh);
+
+      /// \brief Destructor
+      public: ~MeshBVH();
+
+      /// \brief Get the number of triangles in the hierarchy.
+      /// \return Triangle count.
+      public: size_t TriangleCount() const;
+
+      /// \brief Get the number of nodes of the hierarchy.
+      /// \return Node count.
+      public: size_t NodeCount() const;
+
+      /// \brief Find the closest triangle hit by a ray.
+      /// \param[in] _origin Origin of the ray, in the frame of the mesh.
+      /// \param[in] _dir Direction of the ray, in the frame of the mesh. It
+      /// does not need to be normalized.
+      /// \param[out] _distance Distance to the hit, in multiples of the
+      /// length of _dir.
+      /// \param[out] _triangle The triangle hit, in the frame of the mesh.
+      /// \param[in] _backFaces True to also hit triangles from behind.
+      /// \return True if a triangle was hit.
+      public: bool Intersect(const ignition::math::Vector3d &_origin,
+                  const ignition::math::Vector3d &_dir, double &_distance,
+                  ignition::math::Triangle3d &_triangle,
+                  const bool _backFaces = true) const;
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<MeshBVHPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <ignition/math/Rand.hh>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshBVH.hh"
+#include "gazebo/common/MeshManager.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshBVH : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(MeshBVH, Box)
+{
+  common::MeshManager::Instance()->CreateBox("bvh_box",
+      ignition::math::Vector3d(1, 2, 3), ignition::math::Vector2d(1, 1));
+  std::shared_ptr<const common::MeshBVH> bvh =
+      common::MeshManager::Instance()->BVH("bvh_box");
+  ASSERT_TRUE(bvh != nullptr);
+  EXPECT_EQ(12u, bvh->TriangleCount());
+  EXPECT_GT(bvh->NodeCount(), 1u);
+
+  // The hierarchy is built once
+  EXPECT_EQ(bvh, common::MeshManager::Instance()->BVH("bvh_box"));
+  EXPECT_TRUE(common::MeshManager::Instance()->BVH("no_such_mesh") ==
+      nullptr);
+
+  double distance = 0;
+  ignition::math::Triangle3d triangle;
+  EXPECT_TRUE(bvh->Intersect(ignition::math::Vector3d(0, 0, 5),
+      ignition::math::Vector3d(0, 0, -1), distance, triangle));
+  EXPECT_NEAR(3.5, distance, 1e-9);
+  for (unsigned int i = 0; i < 3; ++i)
+    EXPECT_NEAR(1.5, triangle[i].Z(), 1e-9);
+
+  // The distance is in multiples of the direction length
+  EXPECT_TRUE(bvh->Intersect(ignition::math::Vector3d(5, 0, 0),
+      ignition::math::Vector3d(-2, 0, 0), distance, triangle));
+  EXPECT_NEAR(2.25, distance, 1e-9);
+
+  // Misses, and a ray pointing away
+  EXPECT_FALSE(bvh->Intersect(ignition::math::Vector3d(2, 0, 5),
+      ignition::math::Vector3d(0, 0, -1), distance, triangle));
+  EXPECT_FALSE(bvh->Intersect(ignition::math::Vector3d(0, 0, 5),
+      ignition::math::Vector3d(0, 0, 1), distance, triangle));
+
+  // From inside, only the back faces are hit
+  EXPECT_TRUE(bvh->Intersect(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d(0, 0, 1), distance, triangle));
+  EXPECT_NEAR(1.5, distance, 1e-9);
+  EXPECT_FALSE(bvh->Intersect(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d(0, 0, 1), distance, triangle, false));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshBVH, MatchesBruteForce)
+{
+  common::MeshManager::Instance()->CreateSphere("bvh_sphere", 1.0, 32, 32);
+  const common::Mesh *mesh =
+      common::MeshManager::Instance()->GetMesh("bvh_sphere");
+  ASSERT_TRUE(mesh != nullptr);
+  common::MeshBVH bvh(mesh);
+
+  const common::SubMesh *subMesh = mesh->GetSubMesh(0);
+  ignition::math::Rand::Seed(42);
+  for (int i = 0; i < 200; ++i)
+  {
+    ignition::math::Vector3d origin(ignition::math::Rand::DblUniform(-3, 3),
+        ignition::math::Rand::DblUniform(-3, 3), 3);
+    ignition::math::Vector3d dir(ignition::math::Rand::DblUniform(-0.5, 0.5),
+        ignition::math::Rand::DblUniform(-0.5, 0.5), -1);
+
+    double expected = -1;
+    for (unsigned int j = 0; j + 2 < subMesh->GetIndexCount(); j += 3)
+    {
+      const ignition::math::Vector3d a =
+          subMesh->Vertex(subMesh->GetIndex(j));
+      const ignition::math::Vector3d edge1 =
+          subMesh->Vertex(subMesh->GetIndex(j + 1)) - a;
+      const ignition::math::Vector3d edge2 =
+          subMesh->Vertex(subMesh->GetIndex(j + 2)) - a;
+      const ignition::math::Vector3d p = dir.Cross(edge2);
+      const double det = edge1.Dot(p);
+      if (std::abs(det) < 1e-12)
+        continue;
+      const ignition::math::Vector3d s = origin - a;
+      const double u = s.Dot(p) / det;
+      const ignition::math::Vector3d q = s.Cross(edge1);
+      const double v = dir.Dot(q) / det;
+      const double t = edge2.Dot(q) / det;
+      if (u >= 0 && v >= 0 && u + v <= 1 && t >= 0 &&
+          (expected < 0 || t < expected))
+      {
+        expected = t;
+      }
+    }
+
+    double distance = 0;
+    ignition::math::Triangle3d triangle;
+    EXPECT_EQ(expected >= 0, bvh.Intersect(origin, dir, distance, triangle));
+    if (expected >= 0)
+      EXPECT_NEAR(expected, distance, 1e-9);
+  }
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,525 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef _WIN32
+  #include <process.h>
+  #define getpid _getpid
+#else
+  #include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+
+using namespace gazebo;
+using namespace common;
+
+const uint32_t MeshCache::kVersion = 2u;
+
+namespace
+{
+  /// \brief Magic bytes at the start of every cache entry.
+  const char kMagic[8] = {'G', 'Z', 'M', 'E', 'S', 'H', 'C', '\0'};
+
+  /// \brief Extension of cache entries.
+  const char kExtension[] = ".gzmesh";
+
+  /// \brief Hash a block of bytes with 64 bit FNV-1a.
+  /// \param[in] _data Bytes to hash.
+  /// \param[in] _size Number of bytes.
+  /// \param[in] _hash Hash to continue from.
+  /// \return The new hash.
+  uint64_t Fnv1a(const char *_data, const size_t _size,
+      uint64_t _hash = 14695981039346656037ull)
+  {
+    for (size_t i = 0; i < _size; ++i)
+    {
+      _hash ^= static_cast<unsigned char>(_data[i]);
+      _hash *= 1099511628211ull;
+    }
+    return _hash;
+  }
+
+  /// \brief Appends values to an entry.
+  class Writer
+  {
+    /// \brief Append a value.
+    /// \param[in] _value Value to append.
+    public: template<typename T> void Put(const T &_value)
+    {
+      const char *bytes = reinterpret_cast<const char *>(&_value);
+      this->data.insert(this->data.end(), bytes, bytes + sizeof(T));
+    }
+
+    /// \brief Append a string, prefixed by its size.
+    /// \param[in] _value String to append.
+    public: void PutString(const std::string &_value)
+    {
+      this->Put(static_cast<uint32_t>(_value.size()));
+      this->data.insert(this->data.end(), _value.begin(), _value.end());
+    }
+
+    /// \brief Entry bytes.
+    public: std::vector<char> data;
+  };
+
+  /// \brief Reads values from a mapped entry, with bounds checks.
+  class Reader
+  {
+    /// \brief Constructor
+    /// \param[in] _data Start of the entry.
+    /// \param[in] _size Size of the entry.
+    public: Reader(const char *_data, const size_t _size)
+            : data(_data), size(_size)
+    {
+    }
+
+    /// \brief Read a value.
+    /// \param[out] _value Value read.
+    /// \return False if the entry is too short.
+    public: template<typename T> bool Get(T &_value)
+    {
+      if (this->size - this->offset < sizeof(T))
+        return false;
+      std::memcpy(&_value, this->data + this->offset, sizeof(T));
+      this->offset += sizeof(T);
+      return true;
+    }
+
+    /// \brief Read a size prefixed string.
+    /// \param[out] _value String read.
+    /// \return False if the entry is too short.
+    public: bool GetString(std::string &_value)
+    {
+      uint32_t length;
+      if (!this->Get(length) || this->size - this->offset < length)
+        return false;
+      _value.assign(this->data + this->offset, length);
+      this->offset += length;
+      return true;
+    }
+
+    /// \brief Check that a number of elements fits in the rest of the entry.
+    /// \param[in] _count Number of elements.
+    /// \param[in] _elementSize Size of an element in bytes.
+    /// \return True if the elements fit.
+    public: bool Fits(const uint64_t _count, const size_t _elementSize) const
+    {
+      return _count <= (this->size - this->offset) / _elementSize;
+    }
+
+    /// \brief Start of the entry.
+    private: const char *data;
+
+    /// \brief Size of the entry.
+    private: size_t size;
+
+    /// \brief Offset of the next value.
+    private: size_t offset = 0u;
+  };
+
+  /// \brief Append a path, relative to a directory if it is inside it.
+  /// \param[in] _writer Entry writer.
+  /// \param[in] _path Path to append.
+  /// \param[in] _dir Directory of the source mesh file.
+  void PutPath(Writer &_writer, const std::string &_path,
+      const std::string &_dir)
+  {
+    const bool relative = !_dir.empty() &&
+      _path.compare(0, _dir.size(), _dir) == 0 &&
+      (_path.size() == _dir.size() || _path[_dir.size()] == '/' ||
+       _path[_dir.size()] == '\\');
+    _writer.Put(static_cast<uint8_t>(relative));
+    _writer.PutString(relative ? _path.substr(_dir.size()) : _path);
+  }
+
+  /// \brief Read a path written by PutPath.
+  /// \param[in] _reader Entry reader.
+  /// \param[in] _dir Directory of the mesh file being loaded.
+  /// \param[out] _path Path read.
+  /// \return False if the entry is too short.
+  bool GetPath(Reader &_reader, const std::string &_dir, std::string &_path)
+  {
+    uint8_t relative;
+    if (!_reader.Get(relative) || !_reader.GetString(_path))
+      return false;
+    if (relative)
+      _path = _dir + _path;
+    return true;
+  }
+
+  /// \brief Get the directory of a mesh file, as used by the loaders.
+  /// \param[in] _filename Full path of the mesh file.
+  /// \return Directory of the file.
+  std::string Directory(const std::string &_filename)
+  {
+    return boost::filesystem::path(_filename).parent_path().generic_string();
+  }
+
+  /// \brief Append a color.
+  /// \param[in] _writer Entry writer.
+  /// \param[in] _color Color to append.
+  void PutColor(Writer &_writer, const ignition::math::Color &_color)
+  {
+    _writer.Put(_color.R());
+    _writer.Put(_color.G());
+    _writer.Put(_color.B());
+    _writer.Put(_color.A());
+  }
+
+  /// \brief Read a color.
+  /// \param[in] _reader Entry reader.
+  /// \param[out] _color Color read.
+  /// \return False if the entry is too short.
+  bool GetColor(Reader &_reader, ignition::math::Color &_color)
+  {
+    float r, g, b, a;
+    if (!_reader.Get(r) || !_reader.Get(g) || !_reader.Get(b) ||
+        !_reader.Get(a))
+    {
+      return false;
+    }
+    _color.Set(r, g, b, a);
+    return true;
+  }
+}
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for the MeshCache class
+    class MeshCachePrivate
+    {
+      /// \brief Cache directory.
+      public: std::string path;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+MeshCache::MeshCache(const std::string &_path)
+  : dataPtr(new MeshCachePrivate)
+{
+  this->dataPtr->path = _path;
+}
+
+//////////////////////////////////////////////////
+MeshCache::~MeshCache()
+{
+}
+
+//////////////////////////////////////////////////
+std::string MeshCache::Path() const
+{
+  return this->dataPtr->path;
+}
+
+//////////////////////////////////////////////////
+std::string MeshCache::EntryPath(const std::string &_filename,
+    const std::string &_variant) const
+{
+  uint64_t hash = Fnv1a(_variant.c_str(), _variant.size() + 1);
+
+  try
+  {
+    if (boost::filesystem::file_size(_filename) > 0u)
+    {
+      boost::interprocess::file_mapping file(_filename.c_str(),
+          boost::interprocess::read_only);
+      boost::interprocess::mapped_region region(file,
+          boost::interprocess::read_only);
+      hash = Fnv1a(static_cast<const char *>(region.get_address()),
+          region.get_size(), hash);
+    }
+  }
+  catch(...)
+  {
+    return std::string();
+  }
+
+  std::ostringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << hash
+         << kExtension;
+  return (boost::filesystem::path(this->dataPtr->path) / stream.str())
+      .string();
+}
+
+//////////////////////////////////////////////////
+Mesh *MeshCache::Load(const std::string &_filename,
+    const std::string &_variant)
+{
+  std::string entry = this->EntryPath(_filename, _variant);
+  if (entry.empty() || !boost::filesystem::exists(entry))
+    return nullptr;
+
+  const std::string dir = Directory(_filename);
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  try
+  {
+    boost::interprocess::file_mapping file(entry.c_str(),
+        boost::interprocess::read_only);
+    boost::interprocess::mapped_region region(file,
+        boost::interprocess::read_only);
+    Reader reader(static_cast<const char *>(region.get_address()),
+        region.get_size());
+
+    char magic[sizeof(kMagic)];
+    uint32_t version;
+    if (!reader.Get(magic) || std::memcmp(magic, kMagic, sizeof(kMagic)) ||
+        !reader.Get(version) || version != kVersion)
+    {
+      return nullptr;
+    }
+
+    std::string path;
+    uint32_t materialCount;
+    if (!GetPath(reader, dir, path) || !reader.Get(materialCount))
+      return nullptr;
+    mesh->SetPath(path);
+
+    for (uint32_t i = 0; i < materialCount; ++i)
+    {
+      std::string texture;
+      ignition::math::Color ambient, diffuse, specular, emissive;
+      double transparency, shininess, srcFactor, dstFactor, pointSize;
+      uint32_t blendMode, shadeMode;
+      uint8_t depthWrite, lighting;
+      if (!GetPath(reader, dir, texture) || !GetColor(reader, ambient) ||
+          !GetColor(reader, diffuse) || !GetColor(reader, specular) ||
+          !GetColor(reader, emissive) || !reader.Get(transparency) ||
+          !reader.Get(shininess) || !reader.Get(srcFactor) ||
+          !reader.Get(dstFactor) || !reader.Get(blendMode) ||
+          !reader.Get(shadeMode) || !reader.Get(pointSize) ||
+          !reader.Get(depthWrite) || !reader.Get(lighting) ||
+          blendMode >= Material::BLEND_COUNT ||
+          shadeMode >= Material::SHADE_COUNT)
+      {
+        return nullptr;
+      }
+
+      Material *material = new Material();
+      material->SetTextureImage(texture);
+      material->SetAmbient(ambient);
+      material->SetDiffuse(diffuse);
+      material->SetSpecular(specular);
+      material->SetEmissive(emissive);
+      material->SetTransparency(transparency);
+      material->SetShininess(shininess);
+      material->SetBlendFactors(srcFactor, dstFactor);
+      material->SetBlendMode(static_cast<Material::BlendMode>(blendMode));
+      material->SetShadeMode(static_cast<Material::ShadeMode>(shadeMode));
+      material->SetPointSize(pointSize);
+      material->SetDepthWrite(depthWrite != 0u);
+      material->SetLighting(lighting != 0u);
+      mesh->AddMaterial(material);
+    }
+
+    uint32_t subMeshCount;
+    if (!reader.Get(subMeshCount))
+      return nullptr;
+
+    for (uint32_t i = 0; i < subMeshCount; ++i)
+    {
+      std::string name;
+      uint32_t primitiveType;
+      int32_t materialIndex;
+      if (!reader.GetString(name) || !reader.Get(primitiveType) ||
+          !reader.Get(materialIndex) || primitiveType > SubMesh::TRISTRIPS)
+      {
+        return nullptr;
+      }
+
+      std::unique_ptr<SubMesh> subMesh(new SubMesh());
+      subMesh->SetName(name);
+      subMesh->SetPrimitiveType(
+          static_cast<SubMesh::PrimitiveType>(primitiveType));
+      subMesh->SetMaterialIndex(materialIndex);
+
+      uint32_t count;
+      double v[3];
+      if (!reader.Get(count) || !reader.Fits(count, sizeof(v)))
+        return nullptr;
+      for (uint32_t k = 0; k < count; ++k)
+      {
+        reader.Get(v);
+        subMesh->AddVertex(v[0], v[1], v[2]);
+      }
+
+      if (!reader.Get(count) || !reader.Fits(count, sizeof(v)))
+        return nullptr;
+      for (uint32_t k = 0; k < count; ++k)
+      {
+        reader.Get(v);
+        subMesh->AddNormal(v[0], v[1], v[2]);
+      }
+
+      if (!reader.Get(count) || !reader.Fits(count, 2 * sizeof(double)))
+        return nullptr;
+      for (uint32_t k = 0; k < count; ++k)
+      {
+        double uv[2];
+        reader.Get(uv);
+        subMesh->AddTexCoord(uv[0], uv[1]);
+      }
+
+      if (!reader.Get(count) || !reader.Fits(count, sizeof(uint32_t)))
+        return nullptr;
+      for (uint32_t k = 0; k < count; ++k)
+      {
+        uint32_t index;
+        reader.Get(index);
+        subMesh->AddIndex(index);
+      }
+
+      mesh->AddSubMesh(subMesh.release());
+    }
+  }
+  catch(...)
+  {
+    gzwarn << "Unable to read mesh cache entry[" << entry << "]\n";
+    return nullptr;
+  }
+
+  return mesh.release();
+}
+
+//////////////////////////////////////////////////
+bool MeshCache::Save(const Mesh *_mesh, const std::string &_filename,
+    const std::string &_variant)
+{
+  if (!_mesh || _mesh->HasSkeleton())
+    return false;
+
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    if (_mesh->GetSubMesh(i)->GetNodeAssignmentsCount() > 0u)
+      return false;
+  }
+
+  std::string entry = this->EntryPath(_filename, _variant);
+  if (entry.empty())
+    return false;
+
+  const std::string dir = Directory(_filename);
+  Writer writer;
+  writer.Put(kMagic);
+  writer.Put(kVersion);
+  PutPath(writer, _mesh->GetPath(), dir);
+
+  writer.Put(static_cast<uint32_t>(_mesh->GetMaterialCount()));
+  for (unsigned int i = 0; i < _mesh->GetMaterialCount(); ++i)
+  {
+    const Material *material = _mesh->GetMaterial(i);
+    double srcFactor, dstFactor;
+    material->GetBlendFactors(srcFactor, dstFactor);
+
+    PutPath(writer, material->GetTextureImage(), dir);
+    PutColor(writer, material->Ambient());
+    PutColor(writer, material->Diffuse());
+    PutColor(writer, material->Specular());
+    PutColor(writer, material->Emissive());
+    writer.Put(material->GetTransparency());
+    writer.Put(material->GetShininess());
+    writer.Put(srcFactor);
+    writer.Put(dstFactor);
+    writer.Put(static_cast<uint32_t>(material->GetBlendMode()));
+    writer.Put(static_cast<uint32_t>(material->GetShadeMode()));
+    writer.Put(material->GetPointSize());
+    writer.Put(static_cast<uint8_t>(material->GetDepthWrite()));
+    writer.Put(static_cast<uint8_t>(material->GetLighting()));
+  }
+
+  writer.Put(static_cast<uint32_t>(_mesh->GetSubMeshCount()));
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh->GetSubMesh(i);
+    writer.PutString(subMesh->GetName());
+    writer.Put(static_cast<uint32_t>(subMesh->GetPrimitiveType()));
+    writer.Put(static_cast<int32_t>(subMesh->GetMaterialIndex()));
+
+    writer.Put(static_cast<uint32_t>(subMesh->GetVertexCount()));
+    for (unsigned int k = 0; k < subMesh->GetVertexCount(); ++k)
+    {
+      ignition::math::Vector3d v = subMesh->Vertex(k);
+      writer.Put(v.X());
+      writer.Put(v.Y());
+      writer.Put(v.Z());
+    }
+
+    writer.Put(static_cast<uint32_t>(subMesh->GetNormalCount()));
+    for (unsigned int k = 0; k < subMesh->GetNormalCount(); ++k)
+    {
+      ignition::math::Vector3d n = subMesh->Normal(k);
+      writer.Put(n.X());
+      writer.Put(n.Y());
+      writer.Put(n.Z());
+    }
+
+    writer.Put(static_cast<uint32_t>(subMesh->GetTexCoordCount()));
+    for (unsigned int k = 0; k < subMesh->GetTexCoordCount(); ++k)
+    {
+      ignition::math::Vector2d uv = subMesh->TexCoord(k);
+      writer.Put(uv.X());
+      writer.Put(uv.Y());
+    }
+
+    writer.Put(static_cast<uint32_t>(subMesh->GetIndexCount()));
+    for (unsigned int k = 0; k < subMesh->GetIndexCount(); ++k)
+      writer.Put(static_cast<uint32_t>(subMesh->GetIndex(k)));
+  }
+
+  // Write a temporary file and rename it, so readers in other processes
+  // never see a partial entry.
+  std::string tmp = entry + "." + std::to_string(getpid()) + ".tmp";
+  try
+  {
+    boost::filesystem::create_directories(this->dataPtr->path);
+
+    std::ofstream out(tmp, std::ios::binary);
+    out.write(writer.data.data(), writer.data.size());
+    out.close();
+    if (!out)
+    {
+      std::remove(tmp.c_str());
+      return false;
+    }
+    boost::filesystem::rename(tmp, entry);
+  }
+  catch(const boost::filesystem::filesystem_error &_e)
+  {
+    gzwarn << "Unable to write mesh cache entry[" << entry << "]: "
+           << _e.what() << std::endl;
+    std::remove(tmp.c_str());
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MESHCACHE_HH_
+#define GAZEBO_COMMON_MESHCACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+    class MeshCachePrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class MeshCache MeshCache.hh common/common.hh
+    /// \brief A directory of meshes stored in a compact binary format.
+    ///
+    /// Each entry is keyed by a hash of the content of the source mesh
+    /// file, so an edited file never hits a stale entry, and identical files
+    /// share one entry wherever they are installed. Paths inside the
+    /// directory of the source file, such as texture images, are stored
+    /// relative to it and resolved again for the file being loaded. Loading
+    /// an entry maps the file into memory and copies the vertex data out,
+    /// without any XML or text parsing. Entries are written to a temporary
+    /// file and renamed, so every process on a host can share one directory
+    /// and read the entries through the page cache. Meshes with a skeleton
+    /// are not cached.
+    class GZ_COMMON_VISIBLE MeshCache
+    {
+      /// \brief Version of the binary format. Entries with another version
+      /// are ignored and rewritten.
+      public: static const uint32_t kVersion;
+
+      /// \brief Constructor
+      /// \param[in] _path Cache directory. It is created on the first save.
+      public: explicit MeshCache(const std::string &_path);
+
+      /// \brief Destructor
+      public: ~MeshCache();
+
+      /// \brief Get the cache directory.
+      /// \return Path of the cache directory.
+      public: std::string Path() const;
+
+      /// \brief Load the cached copy of a mesh file.
+      /// \param[in] _filename Full path of the source mesh file.
+      /// \param[in] _variant Name of a mesh derived from the file, such as
+      /// a convex decomposition with given parameters. Empty for the mesh
+      /// parsed from the file itself.
+      /// \return A new mesh, or nullptr if the cache has no valid entry for
+      /// the current content of the file.
+      public: Mesh *Load(const std::string &_filename,
+                  const std::string &_variant = "");
+
+      /// \brief Store a mesh in the cache.
+      /// \param[in] _mesh Mesh loaded from _filename.
+      /// \param[in] _filename Full path of the source mesh file.
+      /// \param[in] _variant Name of a mesh derived from the file, or an
+      /// empty string for the mesh parsed from the file itself.
+      /// \return True if the entry was written.
+      public: bool Save(const Mesh *_mesh, const std::string &_filename,
+                  const std::string &_variant = "");
+
+      /// \brief Get the path of the cache entry for a mesh file.
+      /// \param[in] _filename Full path of the source mesh file.
+      /// \param[in] _variant Name of a mesh derived from the file, or an
+      /// empty string for the mesh parsed from the file itself.
+      /// \return Path of the entry, or an empty string if the source file
+      /// could not be read.
+      public: std::string EntryPath(const std::string &_filename,
+                  const std::string &_variant = "") const;
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<MeshCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
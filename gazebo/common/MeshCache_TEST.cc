@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <memory>
+#include <boost/filesystem.hpp>
+
+#include "test_config.h"
+
+#include "gazebo/common/ColladaLoader.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshCache : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Create an empty cache directory.
+  public: void SetUp() override
+  {
+    gazebo::testing::AutoLogFixture::SetUp();
+    this->path = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path("gazebo_mesh_cache_%%%%-%%%%");
+  }
+
+  /// \brief Remove the cache directory.
+  public: void TearDown() override
+  {
+    boost::filesystem::remove_all(this->path);
+    gazebo::testing::AutoLogFixture::TearDown();
+  }
+
+  /// \brief Cache directory.
+  public: boost::filesystem::path path;
+};
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, SaveLoad)
+{
+  std::string filename =
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae";
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(filename));
+  ASSERT_TRUE(mesh != nullptr);
+
+  common::MeshCache cache(this->path.string());
+  EXPECT_EQ(this->path.string(), cache.Path());
+  EXPECT_TRUE(cache.Load(filename) == nullptr);
+
+  EXPECT_TRUE(cache.Save(mesh.get(), filename));
+  EXPECT_TRUE(boost::filesystem::exists(cache.EntryPath(filename)));
+
+  std::unique_ptr<common::Mesh> cached(cache.Load(filename));
+  ASSERT_TRUE(cached != nullptr);
+
+  EXPECT_EQ(mesh->GetPath(), cached->GetPath());
+  EXPECT_EQ(mesh->GetVertexCount(), cached->GetVertexCount());
+  EXPECT_EQ(mesh->GetNormalCount(), cached->GetNormalCount());
+  EXPECT_EQ(mesh->GetTexCoordCount(), cached->GetTexCoordCount());
+  EXPECT_EQ(mesh->GetIndexCount(), cached->GetIndexCount());
+  EXPECT_EQ(mesh->Max(), cached->Max());
+  EXPECT_EQ(mesh->Min(), cached->Min());
+
+  ASSERT_EQ(mesh->GetSubMeshCount(), cached->GetSubMeshCount());
+  for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *subMesh = mesh->GetSubMesh(i);
+    const common::SubMesh *cachedSubMesh = cached->GetSubMesh(i);
+    EXPECT_EQ(subMesh->GetName(), cachedSubMesh->GetName());
+    EXPECT_EQ(subMesh->GetPrimitiveType(), cachedSubMesh->GetPrimitiveType());
+    EXPECT_EQ(subMesh->GetMaterialIndex(), cachedSubMesh->GetMaterialIndex());
+    for (unsigned int k = 0; k < subMesh->GetVertexCount(); ++k)
+      EXPECT_EQ(subMesh->Vertex(k), cachedSubMesh->Vertex(k));
+    for (unsigned int k = 0; k < subMesh->GetIndexCount(); ++k)
+      EXPECT_EQ(subMesh->GetIndex(k), cachedSubMesh->GetIndex(k));
+  }
+
+  ASSERT_EQ(mesh->GetMaterialCount(), cached->GetMaterialCount());
+  for (unsigned int i = 0; i < mesh->GetMaterialCount(); ++i)
+  {
+    EXPECT_EQ(mesh->GetMaterial(i)->Ambient(),
+        cached->GetMaterial(i)->Ambient());
+    EXPECT_EQ(mesh->GetMaterial(i)->Diffuse(),
+        cached->GetMaterial(i)->Diffuse());
+    EXPECT_EQ(mesh->GetMaterial(i)->GetTextureImage(),
+        cached->GetMaterial(i)->GetTextureImage());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, ContentChange)
+{
+  boost::filesystem::create_directories(this->path);
+  boost::filesystem::path copy = this->path / "box.dae";
+  boost::filesystem::copy_file(
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae", copy);
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(copy.string()));
+  ASSERT_TRUE(mesh != nullptr);
+
+  common::MeshCache cache((this->path / "cache").string());
+  std::string entry = cache.EntryPath(copy.string());
+  EXPECT_FALSE(entry.empty());
+  EXPECT_TRUE(cache.Save(mesh.get(), copy.string()));
+  std::unique_ptr<common::Mesh> cached(cache.Load(copy.string()));
+  EXPECT_TRUE(cached != nullptr);
+
+  // An edited file gets a new entry.
+  {
+    std::ofstream out(copy.string(), std::ios::app);
+    out << "<!-- edited -->\n";
+  }
+  EXPECT_NE(entry, cache.EntryPath(copy.string()));
+  EXPECT_TRUE(cache.Load(copy.string()) == nullptr);
+
+  // A truncated entry is rejected.
+  EXPECT_TRUE(cache.Save(mesh.get(), copy.string()));
+  entry = cache.EntryPath(copy.string());
+  boost::filesystem::resize_file(entry,
+      boost::filesystem::file_size(entry) / 2);
+  EXPECT_TRUE(cache.Load(copy.string()) == nullptr);
+
+  // Missing files have no entry.
+  EXPECT_TRUE(cache.EntryPath((this->path / "missing.dae").string()).empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, SharedContent)
+{
+  // Two installs of the same mesh, as in two model directories
+  boost::filesystem::path first = this->path / "first";
+  boost::filesystem::path second = this->path / "second";
+  boost::filesystem::create_directories(first);
+  boost::filesystem::create_directories(second);
+  const std::string source =
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae";
+  boost::filesystem::copy_file(source, first / "box.dae");
+  boost::filesystem::copy_file(source, second / "box.dae");
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(
+      loader.Load((first / "box.dae").string()));
+  ASSERT_TRUE(mesh != nullptr);
+  std::unique_ptr<common::Mesh> secondMesh(
+      loader.Load((second / "box.dae").string()));
+  ASSERT_TRUE(secondMesh != nullptr);
+
+  // Both files share the entry
+  common::MeshCache cache((this->path / "cache").string());
+  EXPECT_EQ(cache.EntryPath((first / "box.dae").string()),
+      cache.EntryPath((second / "box.dae").string()));
+  EXPECT_TRUE(cache.Save(mesh.get(), (first / "box.dae").string()));
+
+  // Paths are resolved for the file being loaded
+  std::unique_ptr<common::Mesh> cached(
+      cache.Load((second / "box.dae").string()));
+  ASSERT_TRUE(cached != nullptr);
+  EXPECT_EQ(secondMesh->GetPath(), cached->GetPath());
+  EXPECT_EQ(mesh->GetVertexCount(), cached->GetVertexCount());
+
+  // Variants have their own entries
+  EXPECT_NE(cache.EntryPath((first / "box.dae").string()),
+      cache.EntryPath((first / "box.dae").string(), "variant"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, Skeleton)
+{
+  std::string filename = std::string(PROJECT_SOURCE_PATH) +
+      "/test/data/box_with_animation_outside_skeleton.dae";
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(filename));
+  ASSERT_TRUE(mesh != nullptr);
+  ASSERT_TRUE(mesh->HasSkeleton());
+
+  common::MeshCache cache(this->path.string());
+  EXPECT_FALSE(cache.Save(mesh.get(), filename));
+  EXPECT_TRUE(cache.Load(filename) == nullptr);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -16,8 +16,20 @@
  */
 
 #include <sys/stat.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <string>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Matrix3.hh>
@@ -30,11 +42,14 @@
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MemoryStats.hh"
 #include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshBVH.hh"
 #include "gazebo/common/ColladaLoader.hh"
 #include "gazebo/common/ColladaExporter.hh"
 #include "gazebo/common/STLLoader.hh"
 #include "gazebo/common/OBJLoader.hh"
+#include "gazebo/common/MeshCache.hh"
 #include "gazebo/gazebo_config.h"
 
 #ifdef HAVE_GTS
@@ -51,15 +66,9 @@ namespace common
 //////////////////////////////////////////////////
 class MeshManagerPrivate
 {
-  /// \brief 3D mesh loader for COLLADA files
-  public: ColladaLoader *colladaLoader = nullptr;
-
   /// \brief 3D mesh exporter for COLLADA files
   public: ColladaExporter *colladaExporter = nullptr;
 
-  /// \brief 3D mesh loader for STL files
-  public: STLLoader *stlLoader = nullptr;
-
   // \brief 3D mesh loader for FBX files
   // \todo The FBX loader needs to be implemented.
   // public: FBXLoader *fbxLoader = nullptr;
@@ -73,19 +82,85 @@ class MeshManagerPrivate
   /// \brief Mutex to protect from loading the same mesh in different threads
   /// at the same time.
   public: boost::mutex mutex;
+
+  /// \brief Names of the meshes that are being parsed.
+  public: std::set<std::string> loading;
+
+  /// \brief Notified when a mesh is no longer being parsed.
+  public: boost::condition_variable loadingCondition;
+
+  /// \brief Binary cache of parsed mesh files, nullptr if disabled.
+  public: std::shared_ptr<MeshCache> cache;
+
+  /// \brief Name of the first mesh extruded from each set of polylines,
+  /// indexed by the exact polylines and height, see ExtrusionKey.
+  public: std::map<std::string, std::string> extrusions;
+
+  /// \brief Bounding volume hierarchies of the meshes, indexed by mesh
+  /// name.
+  public: std::map<std::string, std::shared_ptr<const MeshBVH>> bvhs;
+
+  /// \brief Protects bvhs.
+  public: std::mutex bvhMutex;
+
+  /// \brief MemoryStats tag of the mesh data.
+  public: unsigned int memoryTag =
+      MemoryStats::Instance()->Tag("MeshManager/meshes");
 };
 
-// added here for ABI compatibility
-// TODO move to header / private class when merging forward.
-static OBJLoader objLoader;
+//////////////////////////////////////////////////
+/// \brief Estimate the memory held by the geometry of a mesh.
+/// \param[in] _mesh The mesh.
+/// \return Size of the vertex, normal, texture coordinate, index and
+/// skinning data in bytes.
+static int64_t MeshBytes(const Mesh *_mesh)
+{
+  int64_t bytes = 0;
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh->GetSubMesh(i);
+    bytes += static_cast<int64_t>(subMesh->GetVertexCount() +
+        subMesh->GetNormalCount()) * sizeof(ignition::math::Vector3d);
+    bytes += static_cast<int64_t>(subMesh->GetTexCoordCount()) *
+        sizeof(ignition::math::Vector2d);
+    bytes += static_cast<int64_t>(subMesh->GetIndexCount()) *
+        sizeof(unsigned int);
+    bytes += static_cast<int64_t>(subMesh->GetNodeAssignmentsCount()) *
+        sizeof(NodeAssignment);
+  }
+  return bytes;
+}
+
+/// \brief Charges a mesh to MemoryStats once it is complete, when leaving
+/// the function that creates it.
+class ScopedMeshCharge
+{
+  /// \brief Constructor.
+  /// \param[in] _tag MemoryStats tag.
+  /// \param[in] _mesh Mesh being created.
+  public: ScopedMeshCharge(const unsigned int _tag, const Mesh *_mesh)
+    : tag(_tag), mesh(_mesh)
+  {
+  }
+
+  /// \brief Destructor, charges the mesh.
+  public: ~ScopedMeshCharge()
+  {
+    MemoryStats::Add(this->tag, MeshBytes(this->mesh), 1);
+  }
+
+  /// \brief MemoryStats tag.
+  private: unsigned int tag;
+
+  /// \brief Mesh being created.
+  private: const Mesh *mesh;
+};
 
 //////////////////////////////////////////////////
 MeshManager::MeshManager()
   : dataPtr(new MeshManagerPrivate)
 {
-  this->dataPtr->colladaLoader = new ColladaLoader();
   this->dataPtr->colladaExporter = new ColladaExporter();
-  this->dataPtr->stlLoader = new STLLoader();
 
   // Create some basic shapes
   this->CreatePlane("unit_plane",
@@ -119,16 +194,20 @@ MeshManager::MeshManager()
   this->dataPtr->fileExtensions.push_back("stlb");
   this->dataPtr->fileExtensions.push_back("dae");
   this->dataPtr->fileExtensions.push_back("obj");
+
+  const char *cachePath = std::getenv("GAZEBO_MESH_CACHE_PATH");
+  if (cachePath)
+    this->SetCachePath(cachePath);
 }
 
 //////////////////////////////////////////////////
 MeshManager::~MeshManager()
 {
-  delete this->dataPtr->colladaLoader;
   delete this->dataPtr->colladaExporter;
-  delete this->dataPtr->stlLoader;
   for (auto &pairNameMesh : this->dataPtr->meshes)
   {
+    MemoryStats::Add(this->dataPtr->memoryTag,
+        -MeshBytes(pairNameMesh.second), -1);
     delete pairNameMesh.second;
   }
   this->dataPtr->meshes.clear();
@@ -150,6 +229,7 @@ const Mesh *MeshManager::Load(const std::string &_filename)
 
   std::string extension;
 
+  boost::mutex::scoped_lock findLock(this->dataPtr->mutex);
   if (this->HasMesh(_filename))
   {
     return this->dataPtr->meshes[_filename];
@@ -166,6 +246,7 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     this->dataPtr->meshes.erase(iter);
     */
   }
+  findLock.unlock();
 
   std::string fullname = common::find_file(_filename);
 
@@ -174,14 +255,16 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
     std::transform(extension.begin(), extension.end(),
         extension.begin(), ::tolower);
-    MeshLoader *loader = nullptr;
+    // Loaders keep per-file state while parsing, so every call gets its own
+    // instance and different files can be parsed on different threads.
+    std::unique_ptr<MeshLoader> loader;
 
     if (extension == "stl" || extension == "stlb" || extension == "stla")
-      loader = this->dataPtr->stlLoader;
+      loader.reset(new STLLoader());
     else if (extension == "dae")
-      loader = this->dataPtr->colladaLoader;
+      loader.reset(new ColladaLoader());
     else if (extension == "obj")
-      loader = &objLoader;
+      loader.reset(new OBJLoader());
     else
     {
       gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
@@ -190,15 +273,47 @@ const Mesh *MeshManager::Load(const std::string &_filename)
 
     try
     {
-      // This mutex prevents two threads from loading the same mesh at the
-      // same time.
+      // Only one thread parses a given file. Other threads asking for the
+      // same file wait for it, while different files are parsed in
+      // parallel.
       boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+      while (this->dataPtr->loading.count(_filename) > 0)
+        this->dataPtr->loadingCondition.wait(lock);
+
       if (!this->HasMesh(_filename))
       {
-        if ((mesh = loader->Load(fullname)) != nullptr)
+        this->dataPtr->loading.insert(_filename);
+        std::shared_ptr<MeshCache> cache = this->dataPtr->cache;
+        lock.unlock();
+
+        try
+        {
+          if (cache)
+            mesh = cache->Load(fullname);
+
+          if (mesh == nullptr && (mesh = loader->Load(fullname)) != nullptr &&
+              cache)
+          {
+            cache->Save(mesh, fullname);
+          }
+        }
+        catch(...)
+        {
+          lock.lock();
+          this->dataPtr->loading.erase(_filename);
+          this->dataPtr->loadingCondition.notify_all();
+          throw;
+        }
+
+        lock.lock();
+        this->dataPtr->loading.erase(_filename);
+        this->dataPtr->loadingCondition.notify_all();
+
+        if (mesh != nullptr)
         {
           mesh->SetName(_filename);
           this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
+          MemoryStats::Add(this->dataPtr->memoryTag, MeshBytes(mesh), 1);
         }
         else
           gzerr << "Unable to load mesh[" << fullname << "]\n";
@@ -221,6 +336,32 @@ const Mesh *MeshManager::Load(const std::string &_filename)
   return mesh;
 }
 
+//////////////////////////////////////////////////
+void MeshManager::SetCachePath(const std::string &_path)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  if (_path.empty())
+    this->dataPtr->cache.reset();
+  else
+    this->dataPtr->cache.reset(new MeshCache(_path));
+}
+
+//////////////////////////////////////////////////
+std::string MeshManager::CachePath() const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  if (!this->dataPtr->cache)
+    return std::string();
+  return this->dataPtr->cache->Path();
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<MeshCache> MeshManager::Cache() const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  return this->dataPtr->cache;
+}
+
 //////////////////////////////////////////////////
 void MeshManager::Export(const Mesh *_mesh, const std::string &_filename,
     const std::string &_extension, bool _exportTextures)
@@ -273,7 +414,10 @@ void MeshManager::GenSphericalTexCoord(const Mesh *_mesh,
 void MeshManager::AddMesh(Mesh *_mesh)
 {
   if (!this->HasMesh(_mesh->GetName()))
+  {
     this->dataPtr->meshes[_mesh->GetName()] = _mesh;
+    MemoryStats::Add(this->dataPtr->memoryTag, MeshBytes(_mesh), 1);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -301,6 +445,23 @@ bool MeshManager::HasMesh(const std::string &_name) const
   return iter != this->dataPtr->meshes.end();
 }
 
+//////////////////////////////////////////////////
+std::shared_ptr<const MeshBVH> MeshManager::BVH(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->bvhMutex);
+  auto iter = this->dataPtr->bvhs.find(_name);
+  if (iter != this->dataPtr->bvhs.end())
+    return iter->second;
+
+  const Mesh *mesh = this->GetMesh(_name);
+  if (!mesh)
+    return nullptr;
+
+  auto bvh = std::make_shared<const MeshBVH>(mesh);
+  this->dataPtr->bvhs[_name] = bvh;
+  return bvh;
+}
+
 //////////////////////////////////////////////////
 void MeshManager::CreateSphere(const std::string &name, float radius,
     int rings, int segments)
@@ -319,6 +480,7 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
   this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  ScopedMeshCharge charge(this->dataPtr->memoryTag, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -387,6 +549,7 @@ void MeshManager::CreatePlane(const std::string &_name,
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
   this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  ScopedMeshCharge charge(this->dataPtr->memoryTag, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -467,6 +630,7 @@ void MeshManager::CreateBox(const std::string &_name,
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
   this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  ScopedMeshCharge charge(this->dataPtr->memoryTag, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -554,6 +718,48 @@ void MeshManager::CreateBox(const std::string &_name,
     subMesh->AddIndex(ind[i]);
 }
 
+//////////////////////////////////////////////////
+/// \brief Build a key that identifies an extrusion exactly.
+/// \param[in] _polys Closed polylines.
+/// \param[in] _height Height of the extrusion.
+/// \return Raw bytes of the height, and of the size and the points of each
+/// polyline.
+static std::string ExtrusionKey(
+    const std::vector<std::vector<ignition::math::Vector2d> > &_polys,
+    const double _height)
+{
+  std::string key(reinterpret_cast<const char *>(&_height), sizeof(_height));
+  for (auto const &poly : _polys)
+  {
+    const uint64_t size = poly.size();
+    key.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    for (auto const &point : poly)
+    {
+      const double xy[2] = {point.X(), point.Y()};
+      key.append(reinterpret_cast<const char *>(xy), sizeof(xy));
+    }
+  }
+  return key;
+}
+
+//////////////////////////////////////////////////
+/// \brief Key of an undirected edge between two points.
+typedef std::array<double, 4> EdgeKey;
+
+//////////////////////////////////////////////////
+/// \brief Get the key of the edge between two points, which doesn't
+/// depend on their order.
+/// \param[in] _a First point.
+/// \param[in] _b Second point.
+/// \return The key.
+static EdgeKey MakeEdgeKey(const ignition::math::Vector2d &_a,
+    const ignition::math::Vector2d &_b)
+{
+  if (std::make_pair(_a.X(), _a.Y()) < std::make_pair(_b.X(), _b.Y()))
+    return EdgeKey{{_a.X(), _a.Y(), _b.X(), _b.Y()}};
+  return EdgeKey{{_b.X(), _b.Y(), _a.X(), _a.Y()}};
+}
+
 //////////////////////////////////////////////////
 void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     const std::vector<std::vector<ignition::math::Vector2d> > &_polys,
@@ -589,6 +795,26 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     return;
   }
 
+  // Models often hold many copies of the same shape, such as the walls of
+  // a building. Copying an earlier extrusion skips the triangulation.
+  const std::string key = ExtrusionKey(polys, _height);
+  auto extrusion = this->dataPtr->extrusions.find(key);
+  if (extrusion != this->dataPtr->extrusions.end())
+  {
+    const Mesh *source = this->GetMesh(extrusion->second);
+    if (source)
+    {
+      Mesh *mesh = new Mesh();
+      mesh->SetName(_name);
+      for (unsigned int i = 0; i < source->GetSubMeshCount(); ++i)
+        mesh->AddSubMesh(new SubMesh(source->GetSubMesh(i)));
+      this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+      ScopedMeshCharge charge(this->dataPtr->memoryTag, mesh);
+      return;
+    }
+    this->dataPtr->extrusions.erase(extrusion);
+  }
+
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
 
@@ -610,6 +836,26 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
   }
   #endif
 
+  // Triangles that hold each edge, in order, so that each exterior edge
+  // only looks at its own triangle instead of all of them.
+  std::map<EdgeKey, std::vector<unsigned int> > edgeTriangles;
+  for (unsigned int j = 0; j < subMesh->GetIndexCount(); j+=3)
+  {
+    ignition::math::Vector2d corners[3];
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      ignition::math::Vector3d v = subMesh->Vertex(subMesh->GetIndex(j+k));
+      corners[k].Set(v.X(), v.Y());
+    }
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      auto &triangles =
+        edgeTriangles[MakeEdgeKey(corners[k], corners[(k + 1) % 3])];
+      if (triangles.empty() || triangles.back() != j)
+        triangles.push_back(j);
+    }
+  }
+
   std::vector<ignition::math::Vector3d> normals;
   for (unsigned int i  = 0; i < edges.size(); ++i)
   {
@@ -619,8 +865,13 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     ignition::math::Vector2d edgeV0 = vertices[i0];
     ignition::math::Vector2d edgeV1 = vertices[i1];
 
-    // we look for those points in the subMesh (where indices may have changed)
-    for (unsigned int j = 0; j < subMesh->GetIndexCount(); j+=3)
+    auto edgeIter = edgeTriangles.find(MakeEdgeKey(edgeV0, edgeV1));
+    if (edgeIter == edgeTriangles.end())
+      continue;
+
+    // we look for those points in the triangles that hold the edge (where
+    // indices may have changed)
+    for (const unsigned int j : edgeIter->second)
     {
       ignition::math::Vector3d v0 = subMesh->Vertex(subMesh->GetIndex(j));
       ignition::math::Vector3d v1 = subMesh->Vertex(subMesh->GetIndex(j+1));
@@ -768,6 +1019,8 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
   }
 
   this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->extrusions[key] = _name;
+  ScopedMeshCharge charge(this->dataPtr->memoryTag, mesh);
   return;
 }
 
@@ -784,6 +1037,7 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
   this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  ScopedMeshCharge charge(this->dataPtr->memoryTag, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -885,6 +1139,7 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
   this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  ScopedMeshCharge charge(this->dataPtr->memoryTag, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -1002,6 +1257,7 @@ void MeshManager::CreateCone(const std::string &name, float radius,
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
   this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  ScopedMeshCharge charge(this->dataPtr->memoryTag, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -1119,6 +1375,7 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
   this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  ScopedMeshCharge charge(this->dataPtr->memoryTag, mesh);
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
 
@@ -1340,6 +1597,7 @@ void MeshManager::CreateBoolean(const std::string &_name, const Mesh *_m1,
   Mesh *mesh = csg.CreateBoolean(_m1, _m2, _operation, _offset);
   mesh->SetName(_name);
   this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  ScopedMeshCharge charge(this->dataPtr->memoryTag, mesh);
 }
 #endif
 
@@ -1371,16 +1629,61 @@ void MeshManager::ConvertPolylinesToVerticesAndEdges(
     std::vector<ignition::math::Vector2d> &_vertices,
     std::vector<ignition::math::Vector2i> &edges)
 {
-  for (auto poly : _polys)
+  // The points are bucketed in cells as large as the tolerance, so that a
+  // point is only compared with the points of the neighbouring cells
+  // instead of the whole table. Like AddUniquePointToVerticesTable, the
+  // first point of the table within the tolerance is returned.
+  typedef std::pair<int64_t, int64_t> Cell;
+  std::map<Cell, std::vector<size_t> > cells;
+  const double sqrTol = _tol * _tol;
+  auto cellOf = [&](const ignition::math::Vector2d &_p)
+  {
+    return Cell(static_cast<int64_t>(std::floor(_p.X() / _tol)),
+        static_cast<int64_t>(std::floor(_p.Y() / _tol)));
+  };
+  if (_tol > 0)
+  {
+    for (size_t i = 0; i < _vertices.size(); ++i)
+      cells[cellOf(_vertices[i])].push_back(i);
+  }
+  auto addUniquePoint = [&](const ignition::math::Vector2d &_p) -> size_t
+  {
+    if (!(_tol > 0))
+      return AddUniquePointToVerticesTable(_vertices, _p, _tol);
+
+    const Cell cell = cellOf(_p);
+    size_t result = _vertices.size();
+    for (int64_t dx = -1; dx <= 1; ++dx)
+    {
+      for (int64_t dy = -1; dy <= 1; ++dy)
+      {
+        auto iter = cells.find(Cell(cell.first + dx, cell.second + dy));
+        if (iter == cells.end())
+          continue;
+        for (const size_t i : iter->second)
+        {
+          auto v = _vertices[i] - _p;
+          if (i < result && v.X() * v.X() + v.Y() * v.Y() < sqrTol)
+            result = i;
+        }
+      }
+    }
+    if (result < _vertices.size())
+      return result;
+
+    _vertices.push_back(_p);
+    cells[cell].push_back(result);
+    return result;
+  };
+
+  for (auto const &poly : _polys)
   {
     ignition::math::Vector2d previous = poly[0];
     for (auto i = 1u; i != poly.size(); ++i)
     {
       auto p = poly[i];
-      auto startPointIndex = AddUniquePointToVerticesTable(_vertices,
-          previous, _tol);
-      auto endPointIndex = AddUniquePointToVerticesTable(_vertices,
-          p, _tol);
+      auto startPointIndex = addUniquePoint(previous);
+      auto endPointIndex = addUniquePoint(p);
       // current end point is now the starting point for the next edge
       previous = p;
       if (startPointIndex == endPointIndex)
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_COMMON_MESHMANAGER_HH_
 #define GAZEBO_COMMON_MESHMANAGER_HH_
 
+#include <memory>
 #include <utility>
 #include <string>
 #include <vector>
@@ -40,6 +41,8 @@ namespace gazebo
     // Forward declarations.
     class MeshManagerPrivate;
     class Mesh;
+    class MeshBVH;
+    class MeshCache;
     class SubMesh;
 
     /// \addtogroup gazebo_common Common
@@ -71,6 +74,26 @@ namespace gazebo
       public: void Export(const Mesh *_mesh, const std::string &_filename,
           const std::string &_extension, bool _exportTextures = false);
 
+      /// \brief Set the directory of the binary mesh cache. Mesh files
+      /// loaded after this call are read from the cache when it holds an
+      /// entry for their current content, and added to it otherwise. The
+      /// initial value is taken from GAZEBO_MESH_CACHE_PATH. Servers on a
+      /// host that use the same directory share its entries.
+      /// \param[in] _path Cache directory, or an empty string to disable
+      /// the cache.
+      /// \sa MeshCache
+      public: void SetCachePath(const std::string &_path);
+
+      /// \brief Get the directory of the binary mesh cache.
+      /// \return Cache directory, or an empty string if the cache is
+      /// disabled.
+      public: std::string CachePath() const;
+
+      /// \brief Get the binary mesh cache, to store meshes derived from
+      /// mesh files next to the parsed files.
+      /// \return The cache, or nullptr if the cache is disabled.
+      public: std::shared_ptr<MeshCache> Cache() const;
+
       /// \brief Checks a path extension against the list of valid extensions.
       /// \return true if the file extension is loadable
       public: bool IsValidFilename(const std::string &_filename);
@@ -107,6 +130,13 @@ namespace gazebo
       /// \param[in] _name the name of the mesh
       public: bool HasMesh(const std::string &_name) const;
 
+      /// \brief Get the bounding volume hierarchy of the triangles of a
+      /// mesh, for ray casts. It is built on the first call and kept for
+      /// the lifetime of the mesh.
+      /// \param[in] _name Name of the mesh.
+      /// \return The hierarchy, or nullptr if there is no such mesh.
+      public: std::shared_ptr<const MeshBVH> BVH(const std::string &_name);
+
       /// \brief Create a sphere mesh.
       /// \param[in] _name the name of the mesh
       /// \param[in] _radius radius of the sphere in meter
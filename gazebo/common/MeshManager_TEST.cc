@@ -17,7 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <vector>
+
 #include "test_config.h"
+#include "gazebo/common/MemoryStats.hh"
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/MeshManager.hh"
 #include "gazebo/gazebo_config.h"
@@ -243,6 +247,56 @@ TEST_F(MeshManager, CreateExtrudedPolylineClosedPath)
     }
   }
 }
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, CreateExtrudedPolylineRepeated)
+{
+  // an L shaped outline with many points along its edges
+  std::vector<ignition::math::Vector2d> subpath;
+  for (int i = 0; i <= 100; ++i)
+    subpath.push_back(ignition::math::Vector2d(i * 0.02, 0));
+  subpath.push_back(ignition::math::Vector2d(2, 1));
+  subpath.push_back(ignition::math::Vector2d(1, 1));
+  subpath.push_back(ignition::math::Vector2d(1, 2));
+  subpath.push_back(ignition::math::Vector2d(0, 2));
+  std::vector<std::vector<ignition::math::Vector2d> > path = {subpath};
+
+  common::MeshManager *mgr = common::MeshManager::Instance();
+  mgr->CreateExtrudedPolyline("extruded_repeated_0", path, 3.0);
+  const common::Mesh *mesh0 = mgr->GetMesh("extruded_repeated_0");
+  ASSERT_TRUE(mesh0 != nullptr);
+
+  // the same outline is copied rather than triangulated again
+  mgr->CreateExtrudedPolyline("extruded_repeated_1", path, 3.0);
+  const common::Mesh *mesh1 = mgr->GetMesh("extruded_repeated_1");
+  ASSERT_TRUE(mesh1 != nullptr);
+  EXPECT_NE(mesh0, mesh1);
+  EXPECT_EQ("extruded_repeated_1", mesh1->GetName());
+  ASSERT_EQ(mesh0->GetSubMeshCount(), mesh1->GetSubMeshCount());
+
+  const common::SubMesh *submesh0 = mesh0->GetSubMesh(0);
+  const common::SubMesh *submesh1 = mesh1->GetSubMesh(0);
+  EXPECT_NE(submesh0, submesh1);
+  ASSERT_EQ(submesh0->GetVertexCount(), submesh1->GetVertexCount());
+  ASSERT_EQ(submesh0->GetIndexCount(), submesh1->GetIndexCount());
+  EXPECT_EQ(submesh0->GetVertexCount(), submesh0->GetNormalCount());
+  for (unsigned int i = 0; i < submesh0->GetVertexCount(); ++i)
+  {
+    EXPECT_EQ(submesh0->Vertex(i), submesh1->Vertex(i));
+    EXPECT_EQ(submesh0->Normal(i), submesh1->Normal(i));
+  }
+  for (unsigned int i = 0; i < submesh0->GetIndexCount(); ++i)
+    EXPECT_EQ(submesh0->GetIndex(i), submesh1->GetIndex(i));
+
+  EXPECT_EQ(ignition::math::Vector3d(0, 0, 0), submesh0->Min());
+  EXPECT_EQ(ignition::math::Vector3d(2, 2, 3), submesh0->Max());
+
+  // a different height is a different extrusion
+  mgr->CreateExtrudedPolyline("extruded_repeated_2", path, 4.0);
+  const common::Mesh *mesh2 = mgr->GetMesh("extruded_repeated_2");
+  ASSERT_TRUE(mesh2 != nullptr);
+  EXPECT_EQ(ignition::math::Vector3d(2, 2, 4), mesh2->Max());
+}
 #endif
 
 /////////////////////////////////////////////////
@@ -266,6 +320,62 @@ TEST_F(MeshManager, CreateExtrudedPolylineInvalid)
   EXPECT_TRUE(!common::MeshManager::Instance()->HasMesh(meshName));
 }
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, ParallelLoad)
+{
+  std::vector<std::string> filenames = {
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae",
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box_offset.dae",
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.obj"};
+
+  // Every file is requested by several threads at once.
+  std::vector<const common::Mesh *> meshes(filenames.size() * 4, nullptr);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < meshes.size(); ++i)
+  {
+    threads.push_back(std::thread([&meshes, &filenames, i]()
+        {
+          meshes[i] = common::MeshManager::Instance()->Load(
+              filenames[i % filenames.size()]);
+        }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (size_t i = 0; i < meshes.size(); ++i)
+  {
+    ASSERT_TRUE(meshes[i] != nullptr);
+    EXPECT_EQ(meshes[i], meshes[i % filenames.size()]);
+    EXPECT_EQ(meshes[i], common::MeshManager::Instance()->GetMesh(
+        filenames[i % filenames.size()]));
+  }
+  EXPECT_NE(meshes[0], meshes[1]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, MemoryStats)
+{
+  common::MeshManager *mgr = common::MeshManager::Instance();
+  const unsigned int tag =
+      common::MemoryStats::Instance()->Tag("MeshManager/meshes");
+
+  // The built in shapes are counted
+  const int64_t bytes = common::MemoryStats::Bytes(tag);
+  const int64_t objects = common::MemoryStats::Objects(tag);
+  EXPECT_GT(bytes, 0);
+  EXPECT_GT(objects, 0);
+
+  // A box has 24 vertices, normals and texture coordinates, 36 indices
+  mgr->CreateBox("memory_stats_box", ignition::math::Vector3d(1, 2, 3),
+      ignition::math::Vector2d(1, 1));
+  ASSERT_TRUE(mgr->HasMesh("memory_stats_box"));
+  EXPECT_EQ(objects + 1, common::MemoryStats::Objects(tag));
+  EXPECT_EQ(bytes + static_cast<int64_t>(
+        24 * 2 * sizeof(ignition::math::Vector3d) +
+        24 * sizeof(ignition::math::Vector2d) + 36 * sizeof(unsigned int)),
+      common::MemoryStats::Bytes(tag));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
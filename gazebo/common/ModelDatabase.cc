@@ -23,8 +23,12 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <iostream>
+#include <set>
+#include <vector>
 
+#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/algorithm/string/replace.hpp>
+#include <boost/algorithm/string/trim.hpp>
 #include <boost/bind/bind.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/function.hpp>
@@ -65,11 +69,249 @@ size_t get_models_cb(void *_buffer, size_t _size, size_t _nmemb, void *_userp)
   return _size;
 }
 
+/// \brief One download in a batch of simultaneous downloads.
+class ModelDatabaseTransfer
+{
+  /// \brief URL to download, the transfer is skipped if empty.
+  public: std::string url;
+
+  /// \brief File to write the response to. The response is kept in body
+  /// if empty.
+  public: std::string filename;
+
+  /// \brief Response, when there is no filename.
+  public: std::string body;
+
+  /// \brief Value of the If-None-Match request header, if not empty.
+  public: std::string ifNoneMatch;
+
+  /// \brief Value of the If-Modified-Since request header, if not empty.
+  public: std::string ifModifiedSince;
+
+  /// \brief ETag header of the response.
+  public: std::string etag;
+
+  /// \brief Last-Modified header of the response.
+  public: std::string lastModified;
+
+  /// \brief Response code, 0 for file URLs.
+  public: long status = 0;  // NOLINT(runtime/int)
+
+  /// \brief True if the transfer completed with a usable response.
+  public: bool ok = false;
+
+  /// \brief Open output file while the transfer runs.
+  public: FILE *file = nullptr;
+
+  /// \brief Request headers while the transfer runs.
+  public: struct curl_slist *headers = nullptr;
+};
+
+/////////////////////////////////////////////////
+size_t get_header_cb(char *_buffer, size_t _size, size_t _nitems,
+    void *_userp)
+{
+  ModelDatabaseTransfer *transfer = static_cast<ModelDatabaseTransfer*>(_userp);
+  _size *= _nitems;
+
+  const std::string line(_buffer, _size);
+  const size_t colon = line.find(':');
+  if (colon != std::string::npos)
+  {
+    const std::string name =
+      boost::algorithm::to_lower_copy(line.substr(0, colon));
+    if (name == "etag")
+      transfer->etag = boost::algorithm::trim_copy(line.substr(colon + 1));
+    else if (name == "last-modified")
+    {
+      transfer->lastModified =
+        boost::algorithm::trim_copy(line.substr(colon + 1));
+    }
+  }
+  return _size;
+}
+
+/////////////////////////////////////////////////
+/// \brief Run a batch of transfers with a bounded number of simultaneous
+/// connections.
+/// \param[in,out] _transfers Transfers to run.
+/// \param[in] _maxConnections Maximum number of simultaneous connections.
+/// \param[in] _stop Transfers not started yet are skipped once true.
+static void perform_transfers(std::vector<ModelDatabaseTransfer> &_transfers,
+    const unsigned int _maxConnections, const bool &_stop)
+{
+  CURLM *multi = curl_multi_init();
+  if (!multi)
+  {
+    gzerr << "Unable to initialize libcurl\n";
+    return;
+  }
+  curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS,
+      static_cast<long>(_maxConnections));
+
+  size_t next = 0;
+  unsigned int active = 0;
+
+  // Start transfers until the pool is full
+  auto startTransfers = [&]()
+  {
+    for (; next < _transfers.size() && active < _maxConnections && !_stop;
+         ++next)
+    {
+      ModelDatabaseTransfer &transfer = _transfers[next];
+      if (transfer.url.empty())
+        continue;
+
+      CURL *curl = curl_easy_init();
+      if (!curl)
+      {
+        gzerr << "Unable to initialize libcurl\n";
+        continue;
+      }
+
+      curl_easy_setopt(curl, CURLOPT_URL, transfer.url.c_str());
+      curl_easy_setopt(curl, CURLOPT_PRIVATE, &transfer);
+      curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, get_header_cb);
+      curl_easy_setopt(curl, CURLOPT_HEADERDATA, &transfer);
+
+      if (!transfer.filename.empty())
+      {
+        transfer.file = fopen(transfer.filename.c_str(), "wb");
+        if (!transfer.file)
+        {
+          gzerr << "Unable to write to file[" << transfer.filename << "]\n";
+          curl_easy_cleanup(curl);
+          continue;
+        }
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, transfer.file);
+      }
+      else
+      {
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, get_models_cb);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer.body);
+      }
+
+      if (!transfer.ifNoneMatch.empty())
+      {
+        transfer.headers = curl_slist_append(transfer.headers,
+            ("If-None-Match: " + transfer.ifNoneMatch).c_str());
+      }
+      if (!transfer.ifModifiedSince.empty())
+      {
+        transfer.headers = curl_slist_append(transfer.headers,
+            ("If-Modified-Since: " + transfer.ifModifiedSince).c_str());
+      }
+      if (transfer.headers)
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, transfer.headers);
+
+      curl_multi_add_handle(multi, curl);
+      ++active;
+    }
+  };
+
+  startTransfers();
+  while (active > 0)
+  {
+    int running = 0;
+    curl_multi_perform(multi, &running);
+
+    CURLMsg *msg;
+    int left = 0;
+    while ((msg = curl_multi_info_read(multi, &left)))
+    {
+      if (msg->msg != CURLMSG_DONE)
+        continue;
+
+      CURL *curl = msg->easy_handle;
+      char *info = nullptr;
+      curl_easy_getinfo(curl, CURLINFO_PRIVATE, &info);
+      ModelDatabaseTransfer *transfer =
+        reinterpret_cast<ModelDatabaseTransfer *>(info);
+      curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &transfer->status);
+
+      transfer->ok = msg->data.result == CURLE_OK &&
+        (transfer->status == 0 || transfer->status == 200 ||
+         transfer->status == 304);
+
+      curl_multi_remove_handle(multi, curl);
+      curl_easy_cleanup(curl);
+      curl_slist_free_all(transfer->headers);
+      transfer->headers = nullptr;
+      if (transfer->file)
+      {
+        fclose(transfer->file);
+        transfer->file = nullptr;
+      }
+      --active;
+    }
+
+    startTransfers();
+    if (active > 0)
+      curl_multi_wait(multi, nullptr, 0, 100, nullptr);
+  }
+
+  curl_multi_cleanup(multi);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the name of a model from its manifest.
+/// \param[in] _xmlStr Contents of the model manifest.
+/// \param[in] _uri URI of the model, for error messages.
+/// \return The model's name, empty on error.
+static std::string model_name(const std::string &_xmlStr,
+    const std::string &_uri)
+{
+  std::string result;
+
+  if (!_xmlStr.empty())
+  {
+    TiXmlDocument xmlDoc;
+    if (xmlDoc.Parse(_xmlStr.c_str()))
+    {
+      TiXmlElement *modelElem = xmlDoc.FirstChildElement("model");
+      if (modelElem)
+      {
+        TiXmlElement *nameElem = modelElem->FirstChildElement("name");
+        if (nameElem)
+          result = nameElem->GetText();
+        else
+          gzerr << "No <name> element in " << GZ_MODEL_MANIFEST_FILENAME
+                << " for model[" << _uri << "]\n";
+      }
+      else
+        gzerr << "No <model> element in " << GZ_MODEL_MANIFEST_FILENAME
+              << " for model[" << _uri << "]\n";
+    }
+    else
+      gzerr << "Unable to parse " << GZ_MODEL_MANIFEST_FILENAME
+            << " for model[" << _uri << "]\n";
+  }
+  else
+    gzerr << "Unable to get model name[" << _uri << "]\n";
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the directory where downloaded models are installed.
+/// \return ~/.gazebo/models
+static std::string install_path()
+{
+  std::string outputPath = getenv("HOME");
+  outputPath += "/.gazebo/models";
+  return outputPath;
+}
+
 /////////////////////////////////////////////////
 ModelDatabase::ModelDatabase()
   : dataPtr(new ModelDatabasePrivate)
 {
   this->dataPtr->updateCacheThread = nullptr;
+
+  const char *maxDownloads = getenv("GAZEBO_MAX_DOWNLOADS");
+  if (maxDownloads && atoi(maxDownloads) > 0)
+    this->dataPtr->maxDownloads = atoi(maxDownloads);
   this->Start();
 }
 
@@ -197,26 +439,70 @@ std::string ModelDatabase::GetModelConfig(const std::string &_uri)
 /////////////////////////////////////////////////
 std::string ModelDatabase::GetManifestImpl(const std::string &_uri)
 {
-  std::string xmlString;
-  if (!_uri.empty())
+  return this->GetManifestsImpl({_uri})[0];
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> ModelDatabase::GetManifestsImpl(
+    const std::vector<std::string> &_uris)
+{
+  std::vector<ModelDatabaseTransfer> transfers(_uris.size());
   {
-    CURL *curl = curl_easy_init();
-    curl_easy_setopt(curl, CURLOPT_URL, _uri.c_str());
+    std::lock_guard<std::mutex> lock(this->dataPtr->manifestsMutex);
+    for (size_t i = 0; i < _uris.size(); ++i)
+    {
+      transfers[i].url = _uris[i];
+
+      // Only download the manifest again if it changed
+      auto iter = this->dataPtr->manifests.find(_uris[i]);
+      if (iter != this->dataPtr->manifests.end())
+      {
+        transfers[i].ifNoneMatch = iter->second.etag;
+        transfers[i].ifModifiedSince = iter->second.lastModified;
+      }
+    }
+  }
 
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, get_models_cb);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &xmlString);
+  perform_transfers(transfers, this->dataPtr->maxDownloads,
+      this->dataPtr->stop);
+
+  std::vector<std::string> result(_uris.size());
+  std::lock_guard<std::mutex> lock(this->dataPtr->manifestsMutex);
+  for (size_t i = 0; i < _uris.size(); ++i)
+  {
+    ModelDatabaseTransfer &transfer = transfers[i];
+    if (transfer.url.empty())
+      continue;
 
-    CURLcode success = curl_easy_perform(curl);
-    if (success != CURLE_OK)
+    auto iter = this->dataPtr->manifests.find(_uris[i]);
+    if (!transfer.ok)
     {
-      gzwarn << "Unable to connect to model database using [" << _uri
+      gzwarn << "Unable to connect to model database using [" << _uris[i]
         << "]. Only locally installed models will be available.\n";
     }
+    else if (transfer.status == 304)
+    {
+      if (iter != this->dataPtr->manifests.end())
+        result[i] = iter->second.body;
+    }
+    else
+    {
+      result[i] = transfer.body;
 
-    curl_easy_cleanup(curl);
+      // Keep the manifests that can be revalidated
+      if (!transfer.etag.empty() || !transfer.lastModified.empty())
+      {
+        CachedManifest &manifest = this->dataPtr->manifests[_uris[i]];
+        manifest.body = transfer.body;
+        manifest.etag = transfer.etag;
+        manifest.lastModified = transfer.lastModified;
+      }
+      else if (iter != this->dataPtr->manifests.end())
+        this->dataPtr->manifests.erase(iter);
+    }
   }
 
-  return xmlString;
+  return result;
 }
 
 /////////////////////////////////////////////////
@@ -247,6 +533,9 @@ bool ModelDatabase::UpdateModelCacheImpl()
       return false;
     }
 
+    std::vector<std::string> fullURIs;
+    std::vector<std::string> manifestURIs;
+
     TiXmlElement *uriElem;
     for (uriElem = modelsElem->FirstChildElement("uri");
          uriElem != nullptr && !this->dataPtr->stop;
@@ -261,11 +550,17 @@ bool ModelDatabase::UpdateModelCacheImpl()
         suffix = uri.substr(index + 3, uri.size() - index - 3);
       }
 
-      std::string fullURI = ModelDatabase::GetURI() + suffix;
-      std::string modelName = ModelDatabase::GetModelName(fullURI);
-
-      this->dataPtr->modelCache[fullURI] = modelName;
+      fullURIs.push_back(ModelDatabase::GetURI() + suffix);
+      manifestURIs.push_back(
+          fullURIs.back() + "/" + GZ_MODEL_MANIFEST_FILENAME);
     }
+
+    // Get the model names with one batch of downloads
+    std::vector<std::string> manifests =
+      this->GetManifestsImpl(manifestURIs);
+    for (size_t i = 0; i < fullURIs.size() && !this->dataPtr->stop; ++i)
+      this->dataPtr->modelCache[fullURIs[i]] =
+        model_name(manifests[i], fullURIs[i]);
   }
 
   return true;
@@ -364,36 +659,7 @@ event::ConnectionPtr ModelDatabase::GetModels(
 /////////////////////////////////////////////////
 std::string ModelDatabase::GetModelName(const std::string &_uri)
 {
-  std::string result;
-  std::string xmlStr = ModelDatabase::GetModelConfig(_uri);
-
-  if (!xmlStr.empty())
-  {
-    TiXmlDocument xmlDoc;
-    if (xmlDoc.Parse(xmlStr.c_str()))
-    {
-      TiXmlElement *modelElem = xmlDoc.FirstChildElement("model");
-      if (modelElem)
-      {
-        TiXmlElement *nameElem = modelElem->FirstChildElement("name");
-        if (nameElem)
-          result = nameElem->GetText();
-        else
-          gzerr << "No <name> element in " << GZ_MODEL_MANIFEST_FILENAME
-                << " for model[" << _uri << "]\n";
-      }
-      else
-        gzerr << "No <model> element in " << GZ_MODEL_MANIFEST_FILENAME
-              << " for model[" << _uri << "]\n";
-    }
-    else
-      gzerr << "Unable to parse " << GZ_MODEL_MANIFEST_FILENAME
-            << " for model[" << _uri << "]\n";
-  }
-  else
-    gzerr << "Unable to get model name[" << _uri << "]\n";
-
-  return result;
+  return model_name(ModelDatabase::GetModelConfig(_uri), _uri);
 }
 
 /////////////////////////////////////////////////
@@ -484,47 +750,14 @@ std::string ModelDatabase::GetModelPath(const std::string &_uri,
 
       fclose(fp);
 
-      try
-      {
-        // Unzip model tarball
-        std::ifstream file(tgzfilename.c_str(),
-            std::ios_base::in | std::ios_base::binary);
-        std::ofstream out(tarfilename.c_str(),
-            std::ios_base::out | std::ios_base::binary);
-        boost::iostreams::filtering_streambuf<boost::iostreams::input> in;
-        in.push(boost::iostreams::gzip_decompressor());
-        in.push(file);
-        boost::iostreams::copy(in, out);
-      }
-      catch(...)
+      if (!this->InstallModel(tgzfilename, tarfilename))
       {
         gzerr << "Failed to unzip model tarball. Trying again...\n";
         retry = true;
         continue;
       }
 
-      std::string outputPath = getenv("HOME");
-      outputPath += "/.gazebo/models";
-
-#ifndef _WIN32
-      TAR *tar;
-      tar_open(&tar, const_cast<char*>(tarfilename.c_str()),
-          nullptr, O_RDONLY, 0644, TAR_GNU);
-
-      tar_extract_all(tar, const_cast<char*>(outputPath.c_str()));
-#else
-      // Tar now is a built-in tool since Windows 10 build 17063.
-      std::string cmdline = "tar xzf \"";
-      cmdline += tarfilename + "\" -C \"";
-      cmdline += outputPath + "\"";
-      auto ret = system(cmdline.c_str());
-      if (ret != 0)
-      {
-        gzerr << "tar extract ret = " << ret << ", cmdline = " << cmdline
-              << std::endl;
-      }
-#endif
-      path = outputPath + "/" + modelName;
+      path = install_path() + "/" + modelName;
       ModelDatabase::DownloadDependencies(path);
     }
 
@@ -551,6 +784,133 @@ std::string ModelDatabase::GetModelPath(const std::string &_uri,
   return path + suffix;
 }
 
+/////////////////////////////////////////////////
+bool ModelDatabase::InstallModel(const std::string &_tgzFilename,
+    const std::string &_tarFilename)
+{
+  try
+  {
+    // Unzip model tarball
+    std::ifstream file(_tgzFilename.c_str(),
+        std::ios_base::in | std::ios_base::binary);
+    std::ofstream out(_tarFilename.c_str(),
+        std::ios_base::out | std::ios_base::binary);
+    boost::iostreams::filtering_streambuf<boost::iostreams::input> in;
+    in.push(boost::iostreams::gzip_decompressor());
+    in.push(file);
+    boost::iostreams::copy(in, out);
+  }
+  catch(...)
+  {
+    return false;
+  }
+
+  std::string outputPath = install_path();
+
+#ifndef _WIN32
+  TAR *tar;
+  tar_open(&tar, const_cast<char*>(_tarFilename.c_str()),
+      nullptr, O_RDONLY, 0644, TAR_GNU);
+
+  tar_extract_all(tar, const_cast<char*>(outputPath.c_str()));
+#else
+  // Tar now is a built-in tool since Windows 10 build 17063.
+  std::string cmdline = "tar xzf \"";
+  cmdline += _tarFilename + "\" -C \"";
+  cmdline += outputPath + "\"";
+  auto ret = system(cmdline.c_str());
+  if (ret != 0)
+  {
+    gzerr << "tar extract ret = " << ret << ", cmdline = " << cmdline
+          << std::endl;
+  }
+#endif
+  return true;
+}
+
+/////////////////////////////////////////////////
+void ModelDatabase::Prefetch(const std::vector<std::string> &_uris)
+{
+  // Names of the models that are not installed locally
+  std::set<std::string> names;
+  for (auto const &uri : _uris)
+  {
+    if (uri.compare(0, 8, "model://") != 0)
+      continue;
+
+    const std::string name = uri.substr(8, uri.find('/', 8) - 8);
+    if (name.empty() || names.count(name))
+      continue;
+
+    bool found = false;
+    for (auto const &modelPath : SystemPaths::Instance()->GetModelPaths())
+    {
+      if (boost::filesystem::exists(boost::filesystem::path(modelPath) / name))
+      {
+        found = true;
+        break;
+      }
+    }
+
+    if (!found)
+      names.insert(name);
+  }
+
+  if (names.empty())
+    return;
+
+  // Only download the models the database has
+  const std::map<std::string, std::string> models = this->GetModels();
+  std::vector<std::string> modelNames;
+  std::vector<ModelDatabaseTransfer> transfers;
+  for (auto const &name : names)
+  {
+    if (!models.count(ModelDatabase::GetURI() + name))
+      continue;
+
+    boost::filesystem::path tmppath = boost::filesystem::temp_directory_path();
+    tmppath /= boost::filesystem::unique_path("gz_model-%%%%-%%%%-%%%%-%%%%");
+
+    ModelDatabaseTransfer transfer;
+    transfer.url = ModelDatabase::GetURI() + "/" + name + "/model.tar.gz";
+    transfer.filename = tmppath.string() + ".tar.gz";
+    transfers.push_back(transfer);
+    modelNames.push_back(name);
+  }
+
+  if (transfers.empty())
+    return;
+
+  gzmsg << "Downloading " << transfers.size() << " models from ["
+        << ModelDatabase::GetURI() << "]\n";
+  perform_transfers(transfers, this->dataPtr->maxDownloads,
+      this->dataPtr->stop);
+
+  for (size_t i = 0; i < transfers.size(); ++i)
+  {
+    const std::string &tgzfilename = transfers[i].filename;
+    const std::string tarfilename =
+      tgzfilename.substr(0, tgzfilename.size() - 3);
+
+    // Failed models are downloaded again when they load
+    if (transfers[i].ok && this->InstallModel(tgzfilename, tarfilename))
+      this->DownloadDependencies(install_path() + "/" + modelNames[i]);
+    else
+      gzwarn << "Unable to prefetch model[" << modelNames[i] << "]\n";
+
+    // Clean up
+    try
+    {
+      boost::filesystem::remove(tarfilename);
+      boost::filesystem::remove(tgzfilename);
+    }
+    catch(...)
+    {
+      gzwarn << "Failed to remove temporary model files after download.";
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 void ModelDatabase::DownloadDependencies(const std::string &_path)
 {
@@ -20,6 +20,7 @@
 #include <string>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include <boost/function.hpp>
 #include "gazebo/common/Event.hh"
@@ -136,11 +137,40 @@ namespace gazebo
       /// \return True if the model was found.
       public: bool HasModel(const std::string &_modelName);
 
+      /// \brief Download the models of the given URIs that are not
+      /// installed locally, with one batch of simultaneous downloads.
+      ///
+      /// Later calls to GetModelPath find the models on disk. This is a
+      /// blocking call.
+      /// \param[in] _uris Model URIs, such as model://ground_plane or
+      /// model://ground_plane/meshes/plane.dae. URIs of other schemes are
+      /// ignored.
+      public: void Prefetch(const std::vector<std::string> &_uris);
+
       /// \brief A helper function that uses CURL to get a manifest file.
       /// \param[in] _uri URI of a manifest XML file.
       /// \return The contents of the manifest file.
       private: std::string GetManifestImpl(const std::string &_uri);
 
+      /// \brief Get a batch of manifest files with simultaneous downloads.
+      /// A manifest downloaded before is revalidated, and only downloaded
+      /// again if it changed on the server.
+      /// \param[in] _uris URIs of manifest XML files.
+      /// \return The contents of the manifest files, in the order of
+      /// _uris. The contents are empty for a file that could not be
+      /// downloaded.
+      private: std::vector<std::string> GetManifestsImpl(
+                   const std::vector<std::string> &_uris);
+
+      /// \brief Decompress a model tarball and extract it in the local
+      /// model path.
+      /// \param[in] _tgzFilename Downloaded model.tar.gz file.
+      /// \param[in] _tarFilename Temporary file for the decompressed
+      /// tarball.
+      /// \return False if the tarball could not be decompressed.
+      private: bool InstallModel(const std::string &_tgzFilename,
+                   const std::string &_tarFilename);
+
       /// \brief Used by a thread to update the model cache.
       /// \param[in] _fetchImmediately True to fetch the models without
       /// waiting.
@@ -19,6 +19,7 @@
 
 #include <list>
 #include <map>
+#include <mutex>
 #include <string>
 
 #include <boost/function.hpp>
@@ -32,6 +33,21 @@ namespace gazebo
 {
   namespace common
   {
+    /// \brief A manifest kept between downloads. It is revalidated with
+    /// the ETag and Last-Modified headers of the response that delivered it.
+    class GZ_COMMON_VISIBLE CachedManifest
+    {
+      /// \brief Contents of the manifest.
+      public: std::string body;
+
+      /// \brief ETag header of the response, empty if there was none.
+      public: std::string etag;
+
+      /// \brief Last-Modified header of the response, empty if there was
+      /// none.
+      public: std::string lastModified;
+    };
+
     /// \brief Private class attributes for ModelDatabase.
     class GZ_COMMON_VISIBLE ModelDatabasePrivate
     {
@@ -41,6 +57,16 @@ namespace gazebo
       /// \brief A dictionary of all model names indexed by their uri.
       public: std::map<std::string, std::string> modelCache;
 
+      /// \brief Downloaded manifests indexed by their uri.
+      public: std::map<std::string, CachedManifest> manifests;
+
+      /// \brief Protects the manifests.
+      public: std::mutex manifestsMutex;
+
+      /// \brief Maximum number of simultaneous downloads, set by the
+      /// GAZEBO_MAX_DOWNLOADS environment variable.
+      public: unsigned int maxDownloads = 8;
+
       /// \brief True to stop the background thread
       public: bool stop;
 
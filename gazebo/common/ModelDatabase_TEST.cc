@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <fstream>
+#include <map>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include "gazebo/common/ModelDatabase.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ModelDatabaseTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _content Content of the file.
+void writeFile(const boost::filesystem::path &_path,
+    const std::string &_content)
+{
+  std::ofstream out(_path.string());
+  out << _content;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the model manifests of a database served from disk.
+TEST_F(ModelDatabaseTest, FileDatabase)
+{
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gz_model_db-%%%%-%%%%");
+  boost::filesystem::create_directories(dir / "model_a");
+  boost::filesystem::create_directories(dir / "model_b");
+
+  writeFile(dir / GZ_MODEL_DB_MANIFEST_FILENAME,
+      "<?xml version='1.0'?>\n"
+      "<database>\n"
+      "  <name>test</name>\n"
+      "  <models>\n"
+      "    <uri>file://model_a</uri>\n"
+      "    <uri>file://model_b</uri>\n"
+      "  </models>\n"
+      "</database>\n");
+  writeFile(dir / "model_a" / GZ_MODEL_MANIFEST_FILENAME,
+      "<?xml version='1.0'?><model><name>Model A</name></model>\n");
+  writeFile(dir / "model_b" / GZ_MODEL_MANIFEST_FILENAME,
+      "<?xml version='1.0'?><model><name>Model B</name></model>\n");
+
+  setenv("GAZEBO_MODEL_DATABASE_URI", ("file://" + dir.string()).c_str(), 1);
+  common::ModelDatabase *db = common::ModelDatabase::Instance();
+  const std::string uri = db->GetURI();
+
+  // The manifests of all the models are fetched in one batch
+  std::map<std::string, std::string> models = db->GetModels();
+  EXPECT_EQ(2u, models.size());
+  EXPECT_EQ("Model A", models[uri + "model_a"]);
+  EXPECT_EQ("Model B", models[uri + "model_b"]);
+  EXPECT_EQ("Model B", db->GetModelName("model://model_b"));
+
+  // The model has no tarball, and other schemes are ignored
+  db->Prefetch({"model://model_a/meshes/mesh.dae", "https://example.com/a"});
+  EXPECT_TRUE(db->HasModel("model://model_a"));
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
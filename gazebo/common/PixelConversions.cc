@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/PixelConversions.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Number of bytes below which a conversion runs on the calling
+/// thread. Starting a thread costs about as much as converting this many
+/// bytes.
+static const size_t kParallelBytes = 1u << 20;
+
+/// \brief Largest number of threads used by a conversion.
+static const unsigned int kMaxThreads = 8;
+
+/// \brief Bilinear weights are fixed point numbers with this many bits.
+static const int kWeightBits = 8;
+
+/// \brief Fixed point weight of 1.
+static const int kWeightOne = 1 << kWeightBits;
+
+/////////////////////////////////////////////////
+/// \brief Split a range of items into bands, converted on several threads
+/// when the work is large enough.
+/// \param[in] _count Number of items.
+/// \param[in] _bytesPerItem Bytes touched for each item.
+/// \param[in] _func Function converting the items in [begin, end).
+template<typename F>
+static void ParallelFor(const size_t _count, const size_t _bytesPerItem,
+    const F &_func)
+{
+  const size_t bytes = _count * _bytesPerItem;
+  size_t threads = std::min<size_t>(
+      std::max(std::thread::hardware_concurrency(), 1u), kMaxThreads);
+  threads = std::min(threads, std::max<size_t>(bytes / kParallelBytes, 1));
+  threads = std::min(threads, std::max<size_t>(_count, 1));
+
+  if (threads <= 1)
+  {
+    _func(0, _count);
+    return;
+  }
+
+  const size_t band = (_count + threads - 1) / threads;
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (size_t begin = band; begin < _count; begin += band)
+  {
+    const size_t end = std::min(begin + band, _count);
+    workers.emplace_back([&_func, begin, end]() {_func(begin, end);});
+  }
+
+  // The calling thread converts the first band
+  _func(0, std::min(band, _count));
+
+  for (auto &worker : workers)
+    worker.join();
+}
+
+/////////////////////////////////////////////////
+void common::ConvertRGBToBGR(const unsigned char *_src, unsigned char *_dst,
+    const size_t _count)
+{
+  if (!_src || !_dst)
+    return;
+
+  ParallelFor(_count, 3, [_src, _dst](const size_t _begin, const size_t _end)
+  {
+    const unsigned char *src = _src + 3 * _begin;
+    unsigned char *dst = _dst + 3 * _begin;
+    for (size_t i = 0; i < _end - _begin; ++i)
+    {
+      // Read the whole pixel first, so the conversion may run in place
+      const unsigned char r = src[3 * i];
+      const unsigned char g = src[3 * i + 1];
+      const unsigned char b = src[3 * i + 2];
+      dst[3 * i] = b;
+      dst[3 * i + 1] = g;
+      dst[3 * i + 2] = r;
+    }
+  });
+}
+
+/////////////////////////////////////////////////
+void common::ConvertRGBAToRGB(const unsigned char *_src, unsigned char *_dst,
+    const size_t _count, const bool _swapRedBlue)
+{
+  if (!_src || !_dst)
+    return;
+
+  const unsigned int first = _swapRedBlue ? 2 : 0;
+  const unsigned int last = 2 - first;
+  ParallelFor(_count, 4,
+      [_src, _dst, first, last](const size_t _begin, const size_t _end)
+  {
+    const unsigned char *src = _src + 4 * _begin;
+    unsigned char *dst = _dst + 3 * _begin;
+    for (size_t i = 0; i < _end - _begin; ++i)
+    {
+      dst[3 * i] = src[4 * i + first];
+      dst[3 * i + 1] = src[4 * i + 1];
+      dst[3 * i + 2] = src[4 * i + last];
+    }
+  });
+}
+
+/////////////////////////////////////////////////
+bool common::ConvertRGBToBayer(const unsigned char *_src, unsigned char *_dst,
+    const unsigned int _width, const unsigned int _height,
+    const std::string &_format)
+{
+  // Channel sampled at each position of the 2x2 tile, indexed by the
+  // parity of the row and of the column.
+  unsigned char tile[2][2];
+  if (_format == "BAYER_RGGB8")
+  {
+    tile[0][0] = 0; tile[0][1] = 1;
+    tile[1][0] = 1; tile[1][1] = 2;
+  }
+  else if (_format == "BAYER_BGGR8")
+  {
+    tile[0][0] = 2; tile[0][1] = 1;
+    tile[1][0] = 1; tile[1][1] = 0;
+  }
+  else if (_format == "BAYER_GBRG8")
+  {
+    tile[0][0] = 1; tile[0][1] = 0;
+    tile[1][0] = 2; tile[1][1] = 1;
+  }
+  else if (_format == "BAYER_GRBG8")
+  {
+    tile[0][0] = 1; tile[0][1] = 2;
+    tile[1][0] = 0; tile[1][1] = 1;
+  }
+  else
+  {
+    return false;
+  }
+
+  if (!_src || !_dst)
+    return true;
+
+  const size_t width = _width;
+  ParallelFor(_height, 3 * width,
+      [_src, _dst, width, &tile](const size_t _begin, const size_t _end)
+  {
+    for (size_t y = _begin; y < _end; ++y)
+    {
+      const unsigned char *src = _src + 3 * width * y;
+      unsigned char *dst = _dst + width * y;
+      const unsigned int even = tile[y & 1][0];
+      const unsigned int odd = 3 + tile[y & 1][1];
+
+      // Two pixels at a time, so each column of the tile has a fixed
+      // channel and the loop has no branch
+      size_t x = 0;
+      for (; x + 1 < width; x += 2)
+      {
+        dst[x] = src[3 * x + even];
+        dst[x + 1] = src[3 * x + odd];
+      }
+      if (x < width)
+        dst[x] = src[3 * x + even];
+    }
+  });
+  return true;
+}
+
+/////////////////////////////////////////////////
+void common::ConvertDepthToUInt16(const float *_src, uint16_t *_dst,
+    const size_t _count, const float _scale, const float _min,
+    const float _max)
+{
+  if (!_src || !_dst)
+    return;
+
+  ParallelFor(_count, sizeof(float) + sizeof(uint16_t),
+      [=](const size_t _begin, const size_t _end)
+  {
+    for (size_t i = _begin; i < _end; ++i)
+    {
+      const float depth = _src[i];
+
+      // Comparisons with NaN are false, so NaN is invalid as well
+      const bool valid = depth > _min && depth < _max;
+      const float scaled = std::min(std::max(depth * _scale + 0.5f, 0.0f),
+          65535.0f);
+      _dst[i] = valid ? static_cast<uint16_t>(scaled) : 0;
+    }
+  });
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the two source samples around each destination sample.
+/// \param[in] _srcSize Number of source samples.
+/// \param[in] _dstSize Number of destination samples.
+/// \param[in] _stride Distance between two source samples.
+/// \param[out] _first Offset of the first source sample.
+/// \param[out] _second Offset of the second source sample.
+/// \param[out] _weight Fixed point weight of the second sample.
+static void BilinearTaps(const unsigned int _srcSize,
+    const unsigned int _dstSize, const size_t _stride,
+    std::vector<size_t> &_first, std::vector<size_t> &_second,
+    std::vector<int> &_weight)
+{
+  _first.resize(_dstSize);
+  _second.resize(_dstSize);
+  _weight.resize(_dstSize);
+
+  // Align the centers of the pixels of both images
+  const double ratio = static_cast<double>(_srcSize) / _dstSize;
+  for (unsigned int i = 0; i < _dstSize; ++i)
+  {
+    const double pos = std::min(std::max((i + 0.5) * ratio - 0.5, 0.0),
+        static_cast<double>(_srcSize - 1));
+    const unsigned int index = static_cast<unsigned int>(pos);
+    const unsigned int next = std::min(index + 1, _srcSize - 1);
+    _first[i] = index * _stride;
+    _second[i] = next * _stride;
+    _weight[i] = static_cast<int>(std::lround((pos - index) * kWeightOne));
+  }
+}
+
+/////////////////////////////////////////////////
+bool common::ResizeImage(const unsigned char *_src,
+    const unsigned int _srcWidth, const unsigned int _srcHeight,
+    const size_t _srcStep, unsigned char *_dst, const unsigned int _dstWidth,
+    const unsigned int _dstHeight, const size_t _dstStep,
+    const unsigned int _channels)
+{
+  if (!_src || !_dst || _srcWidth == 0 || _srcHeight == 0 ||
+      _dstWidth == 0 || _dstHeight == 0 || _channels == 0 || _channels > 4)
+  {
+    return false;
+  }
+
+  const size_t rowBytes = static_cast<size_t>(_dstWidth) * _channels;
+  if (_srcWidth == _dstWidth && _srcHeight == _dstHeight)
+  {
+    for (unsigned int y = 0; y < _dstHeight; ++y)
+      std::memcpy(_dst + y * _dstStep, _src + y * _srcStep, rowBytes);
+    return true;
+  }
+
+  std::vector<size_t> left, right, top, bottom;
+  std::vector<int> weightX, weightY;
+  BilinearTaps(_srcWidth, _dstWidth, _channels, left, right, weightX);
+  BilinearTaps(_srcHeight, _dstHeight, _srcStep, top, bottom, weightY);
+
+  ParallelFor(_dstHeight, 2 * rowBytes, [&](const size_t _begin,
+        const size_t _end)
+  {
+    for (size_t y = _begin; y < _end; ++y)
+    {
+      const unsigned char *row0 = _src + top[y];
+      const unsigned char *row1 = _src + bottom[y];
+      const int wy = weightY[y];
+      unsigned char *dst = _dst + y * _dstStep;
+
+      for (unsigned int x = 0; x < _dstWidth; ++x)
+      {
+        const size_t l = left[x];
+        const size_t r = right[x];
+        const int wx = weightX[x];
+        for (unsigned int c = 0; c < _channels; ++c)
+        {
+          const int up = row0[l + c] * (kWeightOne - wx) + row0[r + c] * wx;
+          const int down = row1[l + c] * (kWeightOne - wx) +
+              row1[r + c] * wx;
+          const int value = up * (kWeightOne - wy) + down * wy;
+          dst[x * _channels + c] = static_cast<unsigned char>(
+              (value + (1 << (2 * kWeightBits - 1))) >> (2 * kWeightBits));
+        }
+      }
+    }
+  });
+  return true;
+}
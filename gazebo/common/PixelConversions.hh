@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_PIXELCONVERSIONS_HH_
+#define GAZEBO_COMMON_PIXELCONVERSIONS_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// The conversions below work on tightly packed 8 bit pixels, unless a
+    /// row step is given. Their inner loops are free of branches so that
+    /// the compiler vectorizes them, and large images are split into bands
+    /// of rows converted on several threads.
+
+    /// \brief Swap the red and blue channels of 3 byte pixels, which
+    /// converts RGB to BGR and BGR to RGB.
+    /// \param[in] _src Source pixels.
+    /// \param[out] _dst Destination pixels, may be equal to _src.
+    /// \param[in] _count Number of pixels.
+    GZ_COMMON_VISIBLE
+    void ConvertRGBToBGR(const unsigned char *_src, unsigned char *_dst,
+        const size_t _count);
+
+    /// \brief Drop the alpha channel of 4 byte pixels.
+    /// \param[in] _src Source RGBA or BGRA pixels.
+    /// \param[out] _dst Destination pixels, must not overlap _src.
+    /// \param[in] _count Number of pixels.
+    /// \param[in] _swapRedBlue True to also swap the red and blue
+    /// channels, which converts BGRA to RGB.
+    GZ_COMMON_VISIBLE
+    void ConvertRGBAToRGB(const unsigned char *_src, unsigned char *_dst,
+        const size_t _count, const bool _swapRedBlue = false);
+
+    /// \brief Sample an RGB image into a Bayer mosaic, one byte per pixel.
+    /// \param[in] _src Source RGB pixels.
+    /// \param[out] _dst Destination pixels, _width * _height bytes.
+    /// \param[in] _width Image width.
+    /// \param[in] _height Image height.
+    /// \param[in] _format One of BAYER_RGGB8, BAYER_BGGR8, BAYER_GBRG8 and
+    /// BAYER_GRBG8.
+    /// \return False if the format is not a Bayer format.
+    GZ_COMMON_VISIBLE
+    bool ConvertRGBToBayer(const unsigned char *_src, unsigned char *_dst,
+        const unsigned int _width, const unsigned int _height,
+        const std::string &_format);
+
+    /// \brief Convert float depths to 16 bit unsigned integers, as in the
+    /// 16UC1 images of ROS. Depths outside of (_min, _max) and NaN become
+    /// 0, which marks an invalid depth; the others are scaled, rounded and
+    /// saturated at 65535.
+    /// \param[in] _src Source depths, usually in meters.
+    /// \param[out] _dst Destination depths.
+    /// \param[in] _count Number of depths.
+    /// \param[in] _scale Factor applied to the depths, 1000 converts
+    /// meters to millimeters.
+    /// \param[in] _min Depths at or below this value are invalid.
+    /// \param[in] _max Depths at or above this value are invalid.
+    GZ_COMMON_VISIBLE
+    void ConvertDepthToUInt16(const float *_src, uint16_t *_dst,
+        const size_t _count, const float _scale, const float _min,
+        const float _max);
+
+    /// \brief Resize an 8 bit image with bilinear filtering.
+    /// \param[in] _src Source pixels.
+    /// \param[in] _srcWidth Source width.
+    /// \param[in] _srcHeight Source height.
+    /// \param[in] _srcStep Bytes between the start of two source rows.
+    /// \param[out] _dst Destination pixels, must not overlap _src.
+    /// \param[in] _dstWidth Destination width.
+    /// \param[in] _dstHeight Destination height.
+    /// \param[in] _dstStep Bytes between the start of two destination rows.
+    /// \param[in] _channels Bytes per pixel, from 1 to 4.
+    /// \return False if a size is zero or the channel count is invalid.
+    GZ_COMMON_VISIBLE
+    bool ResizeImage(const unsigned char *_src, const unsigned int _srcWidth,
+        const unsigned int _srcHeight, const size_t _srcStep,
+        unsigned char *_dst, const unsigned int _dstWidth,
+        const unsigned int _dstHeight, const size_t _dstStep,
+        const unsigned int _channels);
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/PixelConversions.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class PixelConversionsTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Create an image whose bytes depend on their position.
+/// \param[in] _size Number of bytes.
+/// \return The bytes.
+static std::vector<unsigned char> Pattern(const size_t _size)
+{
+  std::vector<unsigned char> result(_size);
+  for (size_t i = 0; i < _size; ++i)
+    result[i] = static_cast<unsigned char>((i * 7 + i / 251) & 0xff);
+  return result;
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelConversionsTest, RGBToBGR)
+{
+  // Large enough to be converted on several threads
+  const size_t count = 1024 * 1024 + 3;
+  const std::vector<unsigned char> rgb = Pattern(count * 3);
+  std::vector<unsigned char> bgr(count * 3);
+  common::ConvertRGBToBGR(rgb.data(), bgr.data(), count);
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    ASSERT_EQ(rgb[3 * i], bgr[3 * i + 2]) << i;
+    ASSERT_EQ(rgb[3 * i + 1], bgr[3 * i + 1]) << i;
+    ASSERT_EQ(rgb[3 * i + 2], bgr[3 * i]) << i;
+  }
+
+  // In place, twice gives the original back
+  common::ConvertRGBToBGR(bgr.data(), bgr.data(), count);
+  EXPECT_EQ(rgb, bgr);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelConversionsTest, RGBAToRGB)
+{
+  const size_t count = 640 * 480;
+  const std::vector<unsigned char> rgba = Pattern(count * 4);
+  std::vector<unsigned char> rgb(count * 3);
+  std::vector<unsigned char> swapped(count * 3);
+  common::ConvertRGBAToRGB(rgba.data(), rgb.data(), count);
+  common::ConvertRGBAToRGB(rgba.data(), swapped.data(), count, true);
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t c = 0; c < 3; ++c)
+    {
+      ASSERT_EQ(rgba[4 * i + c], rgb[3 * i + c]) << i;
+      ASSERT_EQ(rgba[4 * i + 2 - c], swapped[3 * i + c]) << i;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelConversionsTest, RGBToBayer)
+{
+  // An odd width leaves half a tile at the end of the rows
+  const unsigned int width = 7;
+  const unsigned int height = 4;
+  const std::vector<unsigned char> rgb = Pattern(width * height * 3);
+  std::vector<unsigned char> bayer(width * height);
+
+  // Channel of each position of the 2x2 tile
+  const std::vector<std::pair<std::string, std::vector<unsigned int>>>
+    formats = {
+      {"BAYER_RGGB8", {0, 1, 1, 2}},
+      {"BAYER_BGGR8", {2, 1, 1, 0}},
+      {"BAYER_GBRG8", {1, 0, 2, 1}},
+      {"BAYER_GRBG8", {1, 2, 0, 1}}};
+
+  for (const auto &format : formats)
+  {
+    ASSERT_TRUE(common::ConvertRGBToBayer(rgb.data(), bayer.data(), width,
+          height, format.first));
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      for (unsigned int x = 0; x < width; ++x)
+      {
+        const unsigned int channel = format.second[(y % 2) * 2 + x % 2];
+        EXPECT_EQ(rgb[(y * width + x) * 3 + channel], bayer[y * width + x])
+            << format.first << " " << x << " " << y;
+      }
+    }
+  }
+
+  EXPECT_FALSE(common::ConvertRGBToBayer(rgb.data(), bayer.data(), width,
+        height, "R8G8B8"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelConversionsTest, DepthToUInt16)
+{
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float inf = std::numeric_limits<float>::infinity();
+  const std::vector<float> depths =
+    {0.05f, 0.1f, 0.1004f, 1.0f, 2.3456f, 9.9999f, 10.0f, nan, inf, -inf,
+     70.0f};
+  std::vector<uint16_t> result(depths.size());
+
+  common::ConvertDepthToUInt16(depths.data(), result.data(), depths.size(),
+      1000.0f, 0.1f, 10.0f);
+  const std::vector<uint16_t> expected =
+    {0, 0, 100, 1000, 2346, 10000, 0, 0, 0, 0, 0};
+  EXPECT_EQ(expected, result);
+
+  // Depths too large for 16 bits saturate
+  common::ConvertDepthToUInt16(depths.data(), result.data(), depths.size(),
+      1000.0f, 0.0f, 100.0f);
+  EXPECT_EQ(65535u, result.back());
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelConversionsTest, Resize)
+{
+  EXPECT_FALSE(common::ResizeImage(nullptr, 1, 1, 3, nullptr, 1, 1, 3, 3));
+
+  // Same size is a copy, with different row steps
+  const std::vector<unsigned char> src = Pattern(5 * 16);
+  std::vector<unsigned char> dst(4 * 5 * 3, 0);
+  ASSERT_TRUE(common::ResizeImage(src.data(), 4, 5, 16, dst.data(), 4, 5,
+        12, 3));
+  for (unsigned int y = 0; y < 5; ++y)
+  {
+    for (unsigned int x = 0; x < 12; ++x)
+      EXPECT_EQ(src[y * 16 + x], dst[y * 12 + x]);
+  }
+
+  // A constant image stays constant
+  std::vector<unsigned char> gray(33 * 17 * 2, 77);
+  std::vector<unsigned char> scaled(100 * 10 * 2, 0);
+  ASSERT_TRUE(common::ResizeImage(gray.data(), 33, 17, 66, scaled.data(),
+        100, 10, 200, 2));
+  for (const unsigned char value : scaled)
+    EXPECT_EQ(77, value);
+
+  // Doubling a ramp interpolates between the samples, and the edges are
+  // held
+  const std::vector<unsigned char> ramp = {0, 100, 200};
+  std::vector<unsigned char> wide(6, 0);
+  ASSERT_TRUE(common::ResizeImage(ramp.data(), 3, 1, 3, wide.data(), 6, 1,
+        6, 1));
+  const std::vector<unsigned char> expectedWide = {0, 25, 75, 125, 175, 200};
+  EXPECT_EQ(expectedWide, wide);
+
+  // Halving averages pairs of samples
+  const std::vector<unsigned char> pairs = {10, 20, 30, 40, 50, 60, 70, 80};
+  std::vector<unsigned char> narrow(2, 0);
+  ASSERT_TRUE(common::ResizeImage(pairs.data(), 4, 2, 4, narrow.data(), 2, 1,
+        2, 1));
+  const std::vector<unsigned char> expectedNarrow = {35, 55};
+  EXPECT_EQ(expectedNarrow, narrow);
+
+  // Large images are resized on several threads, the result matches the
+  // resize of each channel alone
+  const unsigned int width = 1280;
+  const unsigned int height = 960;
+  const std::vector<unsigned char> big = Pattern(width * height * 3);
+  std::vector<unsigned char> half(640 * 480 * 3);
+  ASSERT_TRUE(common::ResizeImage(big.data(), width, height, width * 3,
+        half.data(), 640, 480, 640 * 3, 3));
+
+  std::vector<unsigned char> red(width * height);
+  for (size_t i = 0; i < red.size(); ++i)
+    red[i] = big[3 * i];
+  std::vector<unsigned char> halfRed(640 * 480);
+  ASSERT_TRUE(common::ResizeImage(red.data(), width, height, width,
+        halfRed.data(), 640, 480, 640, 1));
+  for (size_t i = 0; i < halfRed.size(); ++i)
+    ASSERT_EQ(halfRed[i], half[3 * i]) << i;
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,8 +15,147 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
 
 #include "gazebo/common/Plugin.hh"
 
-
 using namespace gazebo;
+
+/// \brief Largest number of threads opening plugins.
+static const unsigned int kMaxPreloadThreads = 8;
+
+/// \brief File names given to PreloadPlugins.
+static std::set<std::string> g_preloaded;
+
+/// \brief Protects g_preloaded.
+static std::mutex g_preloadedMutex;
+
+/////////////////////////////////////////////////
+/// \brief Find a plugin library in the plugin paths and open it.
+/// \param[in] _filename File name of the library.
+/// \param[in,out] _errorStream Stream receiving the reason of a failure.
+/// \return Handle of the library, or nullptr on failure.
+static void *FindAndDlopenPluginFile(const std::string &_filename,
+    std::ostringstream &_errorStream)
+{
+  std::string fullname =
+    common::SystemPaths::Instance()->FindPluginFile(_filename);
+  if (fullname.empty())
+    fullname = _filename;
+
+  void *dlHandle = dlopen(fullname.c_str(), RTLD_LAZY|RTLD_GLOBAL);
+  if (!dlHandle)
+  {
+    _errorStream << "Failed to load plugin " << fullname << ": "
+      << dlerror() << "\n";
+  }
+  return dlHandle;
+}
+
+/////////////////////////////////////////////////
+void *common::OpenPluginLibrary(std::string &_filename, std::string &_error)
+{
+  std::ostringstream errorStream;
+
+  // This logic is to support different extensions on each OS
+  // see issue #800
+  //
+  // Linux: lib*.so
+  // macOS: lib*.so, lib*.dylib
+  // Windows: *.dll
+  //
+  // Assuming that most plugin names are specified as lib*.so,
+  // replace prefix and suffix depending on the OS.
+  // On macOS, first try the lib*.so name, then try lib*.dylib
+#ifdef _WIN32
+  {
+    // replace .so with .dll
+    size_t soSuffix = _filename.rfind(".so");
+    if (soSuffix != std::string::npos)
+    {
+      const std::string winSuffix(".dll");
+      _filename.replace(soSuffix, winSuffix.length(), winSuffix);
+    }
+    size_t libPrefix = _filename.find("lib");
+    if (libPrefix == 0)
+    {
+      // remove the lib prefix
+      _filename.erase(0, 3);
+    }
+  }
+#endif  // ifdef _WIN32
+
+  // Try to find and dlopen plugin with the following pattern:
+  // Linux: lib*.so
+  // macOS: lib*.so
+  // Windows: *.dll
+  void *dlHandle = FindAndDlopenPluginFile(_filename, errorStream);
+#ifdef __APPLE__
+  if (!dlHandle)
+  {
+    // lib*.so file could not be found or opened, try lib*.dylib
+    size_t soSuffix = _filename.rfind(".so");
+    if (soSuffix != std::string::npos)
+    {
+      const std::string macSuffix(".dylib");
+      _filename.replace(soSuffix, macSuffix.length(), macSuffix);
+    }
+
+    // macOS: lib*.dylib
+    dlHandle = FindAndDlopenPluginFile(_filename, errorStream);
+  }
+#endif  // ifdef __APPLE__
+
+  if (!dlHandle)
+    _error = errorStream.str();
+  return dlHandle;
+}
+
+/////////////////////////////////////////////////
+unsigned int common::PreloadPlugins(const std::vector<std::string> &_filenames)
+{
+  std::vector<std::string> filenames;
+  {
+    std::lock_guard<std::mutex> lock(g_preloadedMutex);
+    for (const auto &filename : _filenames)
+    {
+      if (!filename.empty() && g_preloaded.insert(filename).second)
+        filenames.push_back(filename);
+    }
+  }
+
+  if (filenames.empty())
+    return 0;
+
+  // The dynamic loader serializes part of each dlopen, the threads overlap
+  // the file system lookups and the reads of the libraries.
+  std::atomic<size_t> next(0);
+  std::atomic<unsigned int> opened(0);
+  auto worker = [&filenames, &next, &opened]()
+  {
+    for (size_t i = next++; i < filenames.size(); i = next++)
+    {
+      std::string filename = filenames[i];
+      std::string error;
+      if (common::OpenPluginLibrary(filename, error))
+        ++opened;
+    }
+  };
+
+  const size_t threadCount = std::min<size_t>(filenames.size(),
+      std::min(std::max(std::thread::hardware_concurrency(), 1u),
+        kMaxPreloadThreads));
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < threadCount; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto &thread : threads)
+    thread.join();
+
+  return opened;
+}
@@ -29,6 +29,7 @@
 
 #include <list>
 #include <string>
+#include <vector>
 
 #include <sdf/sdf.hh>
 #include <boost/filesystem.hpp>
@@ -69,6 +70,32 @@ namespace gazebo
   };
 
 
+  namespace common
+  {
+    /// \brief Find a plugin library in the plugin paths and open it with
+    /// dlopen. The file name is adapted to the OS first: lib*.so becomes
+    /// *.dll on Windows, and lib*.dylib is tried after lib*.so on macOS.
+    /// Libraries which are not in the plugin paths are left to the search
+    /// of dlopen. Opening a library which is already open returns the same
+    /// handle, so libraries opened by PreloadPlugins are not loaded twice.
+    /// \param[in,out] _filename File name of the library, replaced by the
+    /// name adapted to the OS.
+    /// \param[out] _error Reason of the failure, if any.
+    /// \return Handle of the library, or nullptr on failure.
+    GZ_COMMON_VISIBLE
+    void *OpenPluginLibrary(std::string &_filename, std::string &_error);
+
+    /// \brief Open plugin libraries ahead of PluginT::Create, on several
+    /// threads. Libraries which fail to open are skipped, and PluginT::Create
+    /// reports the error when the plugin is created. Libraries stay open
+    /// until the process exits, as the ones opened by PluginT::Create.
+    /// \param[in] _filenames File names of the libraries, duplicates and
+    /// libraries given to a previous call are opened once.
+    /// \return Number of libraries opened by this call.
+    GZ_COMMON_VISIBLE
+    unsigned int PreloadPlugins(const std::vector<std::string> &_filenames);
+  }
+
   /// \class PluginT Plugin.hh common/common.hh
   /// \brief A class which all plugins must inherit from
   template<class T>
@@ -115,101 +142,13 @@ namespace gazebo
                 const std::string &_name)
             {
               TPtr result;
-              // PluginPtr result;
               std::string filename(_filename);
-              std::list<std::string> pluginPaths =
-                common::SystemPaths::Instance()->GetPluginPaths();
-              std::ostringstream errorStream;
-
-              // helper function to find and dlopen a plugin file
-              // returns void * dlHandle
-              auto findAndDlopenPluginFile = [](
-                  const std::string &_pluginFilename,
-                  const std::list<std::string> &_pluginPaths,
-                  std::ostringstream &_errorStream) -> void *
-              {
-                struct stat st;
-                bool found = false;
-                std::string fullname;
-                std::list<std::string>::const_iterator iter;
-
-                for (iter = _pluginPaths.begin();
-                     iter!= _pluginPaths.end(); ++iter)
-                {
-                  fullname = (*iter)+std::string("/")+_pluginFilename;
-                  fullname = boost::filesystem::path(fullname)
-                      .make_preferred().string();
-                  if (stat(fullname.c_str(), &st) == 0)
-                  {
-                    found = true;
-                    break;
-                  }
-                }
-
-                if (!found)
-                  fullname = _pluginFilename;
-
-                void *dlHandle = dlopen(fullname.c_str(), RTLD_LAZY|RTLD_GLOBAL);
-                if (!dlHandle)
-                {
-                  _errorStream << "Failed to load plugin " << fullname << ": "
-                    << dlerror() << "\n";
-                }
-                return dlHandle;
-              };
-
-              // This logic is to support different extensions on each OS
-              // see issue #800
-              //
-              // Linux: lib*.so
-              // macOS: lib*.so, lib*.dylib
-              // Windows: *.dll
-              //
-              // Assuming that most plugin names are specified as lib*.so,
-              // replace prefix and suffix depending on the OS.
-              // On macOS, first try the lib*.so name, then try lib*.dylib
-#ifdef _WIN32
-              {
-                // replace .so with .dll
-                size_t soSuffix = filename.rfind(".so");
-                if (soSuffix != std::string::npos)
-                {
-                  const std::string winSuffix(".dll");
-                  filename.replace(soSuffix, winSuffix.length(), winSuffix);
-                }
-                size_t libPrefix = filename.find("lib");
-                if (libPrefix == 0)
-                {
-                  // remove the lib prefix
-                  filename.erase(0, 3);
-                }
-              }
-#endif  // ifdef _WIN32
-
-              // Try to find and dlopen plugin with the following pattern:
-              // Linux: lib*.so
-              // macOS: lib*.so
-              // Windows: *.dll
-              void *dlHandle = findAndDlopenPluginFile(filename, pluginPaths,
-                                                       errorStream);
-#ifdef __APPLE__
-              if (!dlHandle)
-              {
-                // lib*.so file could not be found or opened, try lib*.dylib
-                size_t soSuffix = filename.rfind(".so");
-                if (soSuffix != std::string::npos)
-                {
-                  const std::string macSuffix(".dylib");
-                  filename.replace(soSuffix, macSuffix.length(), macSuffix);
-                }
-              }
-              // macOS: lib*.dylib
-              dlHandle = findAndDlopenPluginFile(filename, pluginPaths, errorStream);
-#endif  // ifdef __APPLE__
+              std::string error;
 
+              void *dlHandle = common::OpenPluginLibrary(filename, error);
               if (!dlHandle)
               {
-                gzerr << errorStream.str();
+                gzerr << error;
                 return result;
               }
 
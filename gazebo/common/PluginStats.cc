@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "gazebo/common/PluginStats.hh"
+
+using namespace gazebo;
+using namespace common;
+
+const unsigned int PluginStats::kNoPlugin = ~0u;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Time spent by the callbacks of one plugin on one event.
+    class PluginCounter
+    {
+      /// \brief Constructor.
+      /// \param[in] _plugin Plugin id.
+      /// \param[in] _event Name of the event.
+      public: PluginCounter(const unsigned int _plugin,
+                  const std::string &_event)
+              : plugin(_plugin), event(_event)
+      {
+      }
+
+      /// \brief Plugin id.
+      public: const unsigned int plugin;
+
+      /// \brief Name of the event.
+      public: const std::string event;
+
+      /// \brief Number of timed calls.
+      public: std::atomic<uint64_t> calls{0};
+
+      /// \brief Time spent in the timed calls, in nanoseconds.
+      public: std::atomic<uint64_t> ns{0};
+
+      /// \brief Number of calls at the previous collection.
+      public: uint64_t previousCalls = 0;
+
+      /// \brief Time spent at the previous collection, in nanoseconds.
+      public: uint64_t previousNs = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for PluginStats.
+    class PluginStatsPrivate
+    {
+      /// \brief File name and instance name of each plugin, by id.
+      public: std::vector<std::pair<std::string, std::string>> plugins;
+
+      /// \brief Counters, the deque keeps their address.
+      public: std::deque<PluginCounter> counters;
+
+      /// \brief Counters by plugin id and event name.
+      public: std::map<std::pair<unsigned int, std::string>, PluginCounter *>
+              counterIndex;
+
+      /// \brief Time of the previous collection.
+      public: std::chrono::steady_clock::time_point previousTime =
+              std::chrono::steady_clock::now();
+
+      /// \brief Protects the members above.
+      public: std::mutex mutex;
+    };
+  }
+}
+
+/// \brief Number of Enable calls not matched by a Disable call.
+static std::atomic<int> enableCount(0);
+
+/// \brief Innermost scope of this thread.
+static thread_local PluginScope *currentScope = nullptr;
+
+//////////////////////////////////////////////////
+PluginStats::PluginStats()
+  : dataPtr(new PluginStatsPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+PluginStats::~PluginStats()
+{
+}
+
+//////////////////////////////////////////////////
+unsigned int PluginStats::Plugin(const std::string &_filename,
+    const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  const auto key = std::make_pair(_filename, _name);
+  auto iter = std::find(this->dataPtr->plugins.begin(),
+      this->dataPtr->plugins.end(), key);
+  if (iter != this->dataPtr->plugins.end())
+    return static_cast<unsigned int>(iter - this->dataPtr->plugins.begin());
+
+  this->dataPtr->plugins.push_back(key);
+  return static_cast<unsigned int>(this->dataPtr->plugins.size() - 1);
+}
+
+//////////////////////////////////////////////////
+PluginCounter *PluginStats::Counter(const unsigned int _plugin,
+    const std::string &_event)
+{
+  if (_plugin == kNoPlugin)
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  PluginCounter *&counter =
+    this->dataPtr->counterIndex[std::make_pair(_plugin, _event)];
+  if (!counter)
+  {
+    this->dataPtr->counters.emplace_back(_plugin, _event);
+    counter = &this->dataPtr->counters.back();
+  }
+  return counter;
+}
+
+//////////////////////////////////////////////////
+unsigned int PluginStats::CurrentPlugin()
+{
+  return currentScope ? currentScope->plugin : kNoPlugin;
+}
+
+//////////////////////////////////////////////////
+void PluginStats::Enable()
+{
+  ++enableCount;
+}
+
+//////////////////////////////////////////////////
+void PluginStats::Disable()
+{
+  --enableCount;
+}
+
+//////////////////////////////////////////////////
+bool PluginStats::Enabled()
+{
+  return enableCount.load(std::memory_order_relaxed) > 0;
+}
+
+//////////////////////////////////////////////////
+std::vector<PluginSample> PluginStats::Collect(double &_interval)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  const auto now = std::chrono::steady_clock::now();
+  _interval = std::chrono::duration<double>(
+      now - this->dataPtr->previousTime).count();
+  this->dataPtr->previousTime = now;
+
+  std::vector<PluginSample> samples;
+  for (auto &counter : this->dataPtr->counters)
+  {
+    const uint64_t calls = counter.calls.load();
+    const uint64_t ns = counter.ns.load();
+    if (calls == 0)
+      continue;
+
+    PluginSample sample;
+    sample.filename = this->dataPtr->plugins[counter.plugin].first;
+    sample.name = this->dataPtr->plugins[counter.plugin].second;
+    sample.event = counter.event;
+    sample.calls = calls;
+    sample.ns = ns;
+    sample.intervalCalls = calls - counter.previousCalls;
+    sample.intervalNs = ns - counter.previousNs;
+    samples.push_back(sample);
+
+    counter.previousCalls = calls;
+    counter.previousNs = ns;
+  }
+
+  std::stable_sort(samples.begin(), samples.end(),
+      [](const PluginSample &_a, const PluginSample &_b)
+      {
+        return _a.intervalNs > _b.intervalNs;
+      });
+  return samples;
+}
+
+//////////////////////////////////////////////////
+PluginScope::PluginScope(const std::string &_filename,
+    const std::string &_name)
+  : plugin(PluginStats::Instance()->Plugin(_filename, _name)),
+    previous(currentScope)
+{
+  currentScope = this;
+}
+
+//////////////////////////////////////////////////
+PluginScope::PluginScope(PluginCounter *_counter)
+  : plugin(_counter->plugin), previous(currentScope)
+{
+  currentScope = this;
+  if (PluginStats::Enabled())
+  {
+    this->counter = _counter;
+    this->start = std::chrono::steady_clock::now();
+  }
+}
+
+//////////////////////////////////////////////////
+PluginScope::~PluginScope()
+{
+  currentScope = this->previous;
+  if (!this->counter)
+    return;
+
+  const uint64_t ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - this->start).count());
+
+  // The enclosing callback is only charged with its own time
+  if (this->previous)
+    this->previous->nestedNs += ns;
+
+  this->counter->calls.fetch_add(1, std::memory_order_relaxed);
+  this->counter->ns.fetch_add(ns - std::min(ns, this->nestedNs),
+      std::memory_order_relaxed);
+}
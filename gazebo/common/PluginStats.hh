@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_PLUGINSTATS_HH_
+#define GAZEBO_COMMON_PLUGINSTATS_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, PluginStats)
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data classes
+    class PluginCounter;
+    class PluginStatsPrivate;
+
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class PluginSample PluginStats.hh common/common.hh
+    /// \brief Time spent by the callbacks of one plugin on one event.
+    class GZ_COMMON_VISIBLE PluginSample
+    {
+      /// \brief File name of the plugin library.
+      public: std::string filename;
+
+      /// \brief Name of the plugin instance.
+      public: std::string name;
+
+      /// \brief Name of the event, empty for unnamed events.
+      public: std::string event;
+
+      /// \brief Number of calls since the server started.
+      public: uint64_t calls = 0;
+
+      /// \brief Time spent since the server started, in nanoseconds.
+      public: uint64_t ns = 0;
+
+      /// \brief Number of calls since the previous collection.
+      public: uint64_t intervalCalls = 0;
+
+      /// \brief Time spent since the previous collection, in nanoseconds.
+      public: uint64_t intervalNs = 0;
+    };
+
+    /// \class PluginStats PluginStats.hh common/common.hh
+    /// \brief Wall time spent by each plugin in the event callbacks it
+    /// connected, per event.
+    ///
+    /// A callback belongs to the plugin whose PluginScope is active on the
+    /// thread that connects it: while the plugin loads, initializes or
+    /// resets, or while one of its own callbacks runs. The callbacks are
+    /// only timed while PluginStats is enabled, otherwise running them
+    /// costs an extra check. The time of a callback excludes the callbacks
+    /// of other plugins that it signals.
+    class GZ_COMMON_VISIBLE PluginStats : public SingletonT<PluginStats>
+    {
+      /// \brief Plugin id of the code that runs outside of any plugin.
+      public: static const unsigned int kNoPlugin;
+
+      /// \brief Get the id of a plugin instance, registering it on first
+      /// use.
+      /// \param[in] _filename File name of the plugin library.
+      /// \param[in] _name Name of the plugin instance.
+      /// \return Plugin id.
+      public: unsigned int Plugin(const std::string &_filename,
+                  const std::string &_name);
+
+      /// \brief Get the counter of a plugin on an event, creating it on
+      /// first use. Counters live as long as PluginStats.
+      /// \param[in] _plugin Plugin id returned by Plugin.
+      /// \param[in] _event Name of the event.
+      /// \return The counter, null for kNoPlugin.
+      public: PluginCounter *Counter(const unsigned int _plugin,
+                  const std::string &_event);
+
+      /// \brief Get the plugin of the PluginScope active on this thread.
+      /// \return Plugin id, kNoPlugin if no scope is active.
+      public: static unsigned int CurrentPlugin();
+
+      /// \brief Start timing the callbacks. Calls nest, the callbacks are
+      /// timed until Disable was called as many times.
+      public: static void Enable();
+
+      /// \brief Stop timing the callbacks, see Enable.
+      public: static void Disable();
+
+      /// \brief Get whether the callbacks are timed.
+      /// \return True if Enable was called more times than Disable.
+      public: static bool Enabled();
+
+      /// \brief Get the time spent by every plugin on every event, and
+      /// start a new interval.
+      /// \param[out] _interval Wall clock time since the previous call, in
+      /// seconds.
+      /// \return Samples of the counters that were called, from the most
+      /// time spent during the interval to the least.
+      public: std::vector<PluginSample> Collect(double &_interval);
+
+      /// \brief Constructor.
+      private: PluginStats();
+
+      /// \brief Destructor.
+      private: virtual ~PluginStats();
+
+      /// \brief This is a singleton.
+      private: friend class SingletonT<PluginStats>;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PluginStatsPrivate> dataPtr;
+    };
+
+    /// \class PluginScope PluginStats.hh common/common.hh
+    /// \brief Marks the code run on behalf of a plugin on this thread, so
+    /// that the event callbacks it connects are charged to the plugin.
+    /// Scopes nest.
+    class GZ_COMMON_VISIBLE PluginScope
+    {
+      /// \brief Constructor, for the code that loads, initializes or
+      /// resets a plugin.
+      /// \param[in] _filename File name of the plugin library.
+      /// \param[in] _name Name of the plugin instance.
+      public: PluginScope(const std::string &_filename,
+                  const std::string &_name);
+
+      /// \brief Constructor, for a callback. Times the scope if
+      /// PluginStats is enabled.
+      /// \param[in] _counter Counter charged with the time, see
+      /// PluginStats::Counter.
+      public: explicit PluginScope(PluginCounter *_counter);
+
+      /// \brief Destructor, charges the time of the scope to the counter.
+      public: ~PluginScope();
+
+      /// \brief Not copyable.
+      private: PluginScope(const PluginScope &) = delete;
+
+      /// \brief Not copyable.
+      private: PluginScope &operator=(const PluginScope &) = delete;
+
+      /// \brief PluginStats reads the plugin of the current scope.
+      private: friend class PluginStats;
+
+      /// \brief Plugin id.
+      private: unsigned int plugin;
+
+      /// \brief Counter charged with the time, null if not timed.
+      private: PluginCounter *counter = nullptr;
+
+      /// \brief Scope that was active on this thread before this one.
+      private: PluginScope *previous;
+
+      /// \brief Time spent in the timed scopes nested in this one, in
+      /// nanoseconds.
+      private: uint64_t nestedNs = 0;
+
+      /// \brief Start of the scope, if timed.
+      private: std::chrono::steady_clock::time_point start;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/Event.hh"
+#include "gazebo/common/PluginStats.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class PluginStatsTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Get the samples of a plugin library.
+/// \param[in] _filename File name of the plugin library.
+/// \return Samples of the plugin, in the order of the ranking.
+static std::vector<common::PluginSample> Samples(const std::string &_filename)
+{
+  double interval = 0;
+  std::vector<common::PluginSample> samples;
+  for (auto const &sample : common::PluginStats::Instance()->Collect(interval))
+  {
+    if (sample.filename == _filename)
+      samples.push_back(sample);
+  }
+  return samples;
+}
+
+/////////////////////////////////////////////////
+TEST_F(PluginStatsTest, Scopes)
+{
+  common::PluginStats *stats = common::PluginStats::Instance();
+
+  const unsigned int a = stats->Plugin("libscopes.so", "a");
+  const unsigned int b = stats->Plugin("libscopes.so", "b");
+  EXPECT_NE(a, b);
+  EXPECT_EQ(a, stats->Plugin("libscopes.so", "a"));
+
+  EXPECT_EQ(common::PluginStats::kNoPlugin,
+      common::PluginStats::CurrentPlugin());
+  EXPECT_EQ(nullptr,
+      stats->Counter(common::PluginStats::kNoPlugin, "event"));
+  {
+    common::PluginScope scopeA("libscopes.so", "a");
+    EXPECT_EQ(a, common::PluginStats::CurrentPlugin());
+    {
+      common::PluginScope scopeB("libscopes.so", "b");
+      EXPECT_EQ(b, common::PluginStats::CurrentPlugin());
+    }
+    EXPECT_EQ(a, common::PluginStats::CurrentPlugin());
+
+    // Scopes are per thread
+    std::thread([]()
+    {
+      EXPECT_EQ(common::PluginStats::kNoPlugin,
+          common::PluginStats::CurrentPlugin());
+    }).join();
+  }
+  EXPECT_EQ(common::PluginStats::kNoPlugin,
+      common::PluginStats::CurrentPlugin());
+}
+
+/////////////////////////////////////////////////
+TEST_F(PluginStatsTest, Callbacks)
+{
+  event::EventT<void ()> outer("outer");
+  event::EventT<void ()> inner("inner");
+
+  // The callback of a is connected while it loads, the one of b while its
+  // first callback runs.
+  event::ConnectionPtr outerConn;
+  {
+    common::PluginScope scope("libcallbacks.so", "a");
+    outerConn = outer.Connect([&inner]()
+        {
+          std::this_thread::sleep_for(std::chrono::milliseconds(5));
+          inner();
+        });
+  }
+  event::ConnectionPtr lateConn;
+  event::ConnectionPtr firstConn;
+  {
+    common::PluginScope scope("libcallbacks.so", "b");
+    firstConn = inner.Connect([&inner, &lateConn]()
+        {
+          if (!lateConn)
+          {
+            lateConn = inner.Connect([]()
+                {
+                  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                });
+          }
+        });
+  }
+  event::ConnectionPtr otherConn = inner.Connect([]() {});
+
+  // Not timed while disabled
+  EXPECT_FALSE(common::PluginStats::Enabled());
+  outer();
+  EXPECT_TRUE(Samples("libcallbacks.so").empty());
+
+  common::PluginStats::Enable();
+  EXPECT_TRUE(common::PluginStats::Enabled());
+  outer();
+  outer();
+  common::PluginStats::Disable();
+  EXPECT_FALSE(common::PluginStats::Enabled());
+
+  // b spent its 20 ms sleeps in inner, a only its own 5 ms sleeps in
+  // outer.
+  std::vector<common::PluginSample> samples = Samples("libcallbacks.so");
+  ASSERT_EQ(2u, samples.size());
+  EXPECT_EQ("b", samples[0].name);
+  EXPECT_EQ("inner", samples[0].event);
+  EXPECT_EQ(4u, samples[0].calls);
+  EXPECT_GE(samples[0].ns, 40000000u);
+  EXPECT_EQ(samples[0].calls, samples[0].intervalCalls);
+  EXPECT_EQ(samples[0].ns, samples[0].intervalNs);
+
+  EXPECT_EQ("a", samples[1].name);
+  EXPECT_EQ("outer", samples[1].event);
+  EXPECT_EQ(2u, samples[1].calls);
+  EXPECT_GE(samples[1].ns, 10000000u);
+  EXPECT_LT(samples[1].ns, samples[0].ns);
+
+  // The next interval is empty
+  samples = Samples("libcallbacks.so");
+  ASSERT_EQ(2u, samples.size());
+  EXPECT_EQ(0u, samples[0].intervalCalls);
+  EXPECT_EQ(0u, samples[0].intervalNs);
+  EXPECT_EQ(0u, samples[1].intervalCalls);
+  EXPECT_EQ(0u, samples[1].intervalNs);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PluginStatsTest, EnableNests)
+{
+  EXPECT_FALSE(common::PluginStats::Enabled());
+  common::PluginStats::Enable();
+  common::PluginStats::Enable();
+  common::PluginStats::Disable();
+  EXPECT_TRUE(common::PluginStats::Enabled());
+  common::PluginStats::Disable();
+  EXPECT_FALSE(common::PluginStats::Enabled());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
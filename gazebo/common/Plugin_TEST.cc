@@ -103,6 +103,21 @@ TEST_F(PluginTest, LoadVisualPlugin)
 }
 
 
+TEST_F(PluginTest, PreloadPlugins)
+{
+  // Duplicates and missing libraries are skipped
+  EXPECT_EQ(2u, common::PreloadPlugins({"libArrangePlugin.so",
+        "libBuoyancyPlugin.so", "libArrangePlugin.so",
+        "libNotAPlugin.so"}));
+  EXPECT_EQ(0u, common::PreloadPlugins({"libBuoyancyPlugin.so"}));
+
+  // Plugins are created from the preloaded libraries
+  ModelPluginPtr plugin = ModelPlugin::Create("libBuoyancyPlugin.so",
+                                              "pluginInterfaceTest");
+  ASSERT_TRUE(plugin != nullptr);
+  EXPECT_EQ(plugin->GetFilename(), expectedFilename("BuoyancyPlugin"));
+}
+
 // TODO: The following test actually fails due to current unsafe implementation
 // of plugin loading.
 // See https://github.com/osrf/gazebo/issues/2267 for details.
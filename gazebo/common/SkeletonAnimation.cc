@@ -304,6 +304,13 @@ std::map<std::string, ignition::math::Matrix4d> SkeletonAnimation::PoseAt(
 //////////////////////////////////////////////////
 std::map<std::string, ignition::math::Matrix4d> SkeletonAnimation::PoseAtX(
     const double _x, const std::string &_node, const bool _loop) const
+{
+  return this->PoseAt(this->TimeAtX(_x, _node, _loop), _loop);
+}
+
+//////////////////////////////////////////////////
+double SkeletonAnimation::TimeAtX(const double _x, const std::string &_node,
+    const bool _loop) const
 {
   std::map<std::string, NodeAnimation*>::const_iterator nodeAnim =
       this->animations.find(_node);
@@ -323,9 +330,18 @@ std::map<std::string, ignition::math::Matrix4d> SkeletonAnimation::PoseAtX(
   while (x > lastX)
     x -= lastX;
 
-  double time = nodeAnim->second->GetTimeAtX(x);
+  return nodeAnim->second->GetTimeAtX(x);
+}
+
+//////////////////////////////////////////////////
+const NodeAnimation *SkeletonAnimation::NodeAnimationByName(
+    const std::string &_node) const
+{
+  auto iter = this->animations.find(_node);
+  if (iter == this->animations.end())
+    return nullptr;
 
-  return this->PoseAt(time, _loop);
+  return iter->second;
 }
 
 //////////////////////////////////////////////////
@@ -200,6 +200,25 @@ namespace gazebo
                   const double _x, const std::string &_node,
                   const bool _loop = true) const;
 
+      /// \brief Returns the time at which a named node transformation's
+      /// translational value along the X axis is equal to _x. PoseAtX
+      /// returns the pose at this time.
+      /// \param[in] _x the value along x. You must ensure that _x is within a
+      /// valid range.
+      /// \param[in] _node the name of the animation node
+      /// \param[in] _loop when true, the time is divided by the duration
+      /// (see GetLength)
+      /// \return the time
+      public: double TimeAtX(const double _x, const std::string &_node,
+                  const bool _loop = true) const;
+
+      /// \brief Returns the animation of a named node, to sample it with
+      /// NodeAnimation::FrameAt without a name lookup.
+      /// \param[in] _node the name of the animation node
+      /// \return the node animation, or nullptr if the node is not animated
+      public: const NodeAnimation *NodeAnimationByName(
+                  const std::string &_node) const;
+
 
       /// \brief Scales every animation in the animations list
       /// \param[in] _scale the scaling factor
@@ -270,6 +270,67 @@ void SystemPaths::UpdatePluginPaths()
   }
 }
 
+/////////////////////////////////////////////////
+void SystemPaths::IndexPluginPaths()
+{
+  this->pluginIndex.clear();
+  this->pluginIndexPaths = this->pluginPaths;
+
+  for (const auto &dir : this->pluginIndexPaths)
+  {
+    boost::system::error_code ec;
+    boost::filesystem::directory_iterator iter(dir, ec), end;
+    for (; !ec && iter != end; iter.increment(ec))
+    {
+      // The first plugin path which has a file wins, as when probing the
+      // plugin paths in order
+      const boost::filesystem::path &file = iter->path();
+      this->pluginIndex.emplace(file.filename().string(),
+          boost::filesystem::path(dir + "/" + file.filename().string())
+          .make_preferred().string());
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+std::string SystemPaths::FindPluginFile(const std::string &_filename)
+{
+  std::lock_guard<std::mutex> lock(this->pluginIndexMutex);
+
+  const std::list<std::string> &paths = this->GetPluginPaths();
+  struct stat st;
+
+  // Relative paths, such as subdir/libFoo.so, are not in the index
+  if (_filename.find_first_of("/\\") == std::string::npos)
+  {
+    if (paths != this->pluginIndexPaths)
+      this->IndexPluginPaths();
+
+    auto iter = this->pluginIndex.find(_filename);
+    if (iter != this->pluginIndex.end())
+    {
+      if (stat(iter->second.c_str(), &st) == 0)
+        return iter->second;
+
+      // The file was removed since the paths were listed
+      this->IndexPluginPaths();
+      iter = this->pluginIndex.find(_filename);
+      if (iter != this->pluginIndex.end())
+        return iter->second;
+    }
+  }
+
+  for (const auto &dir : paths)
+  {
+    const std::string fullname =
+      boost::filesystem::path(dir + "/" + _filename).make_preferred().string();
+    if (stat(fullname.c_str(), &st) == 0)
+      return fullname;
+  }
+
+  return std::string();
+}
+
 //////////////////////////////////////////////////
 void SystemPaths::UpdateOgrePaths()
 {
@@ -30,6 +30,8 @@
 
 #include <boost/filesystem.hpp>
 #include <list>
+#include <map>
+#include <mutex>
 #include <string>
 
 #include "gazebo/common/CommonTypes.hh"
@@ -116,6 +118,17 @@ namespace gazebo
       public: std::string FindFile(const std::string &_filename,
                                    bool _searchLocalPath = true);
 
+      /// \brief Find a plugin library in the plugin paths. The content of
+      /// the plugin directories is listed once and kept in an index, so
+      /// finding a plugin does not probe every directory. The index is
+      /// rebuilt when the plugin paths change, and files which are not in it
+      /// are still probed, so libraries added later are found. This function
+      /// is thread safe.
+      /// \param[in] _filename File name of the library, e.g. libFoo.so.
+      /// \return Full path of the library in the first plugin path that has
+      /// it, or an empty string if no plugin path has it.
+      public: std::string FindPluginFile(const std::string &_filename);
+
       /// \brief Add a callback to use when Gazebo can't find a file.
       /// The callback should return a full local path to the requested file, or
       /// and empty string if the file was not found in the callback.
@@ -175,6 +188,10 @@ namespace gazebo
       /// \brief re-read SystemPaths#ogrePaths from environment variable
       private: void UpdateOgrePaths();
 
+      /// \brief List the plugin paths into SystemPaths#pluginIndex.
+      /// The caller holds SystemPaths#pluginIndexMutex.
+      private: void IndexPluginPaths();
+
       /// \brief adds a path to the list if not already present
       /// \param[in]_path the path
       /// \param[in]_list the list
@@ -190,6 +207,16 @@ namespace gazebo
       /// \brief Paths to plugins
       private: std::list<std::string> pluginPaths;
 
+      /// \brief Full path of each file in the plugin paths, indexed by
+      /// file name.
+      private: std::map<std::string, std::string> pluginIndex;
+
+      /// \brief Plugin paths listed in SystemPaths#pluginIndex.
+      private: std::list<std::string> pluginIndexPaths;
+
+      /// \brief Protects the plugin paths and the plugin index.
+      private: std::mutex pluginIndexMutex;
+
       private: std::list<std::string> suffixPaths;
 
       private: std::list<std::string> modelPaths;
@@ -16,9 +16,12 @@
 */
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <string>
 #include <vector>
 
+#include <boost/filesystem.hpp>
+
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/SystemPaths.hh"
 #include "test/util.hh"
@@ -190,6 +193,57 @@ TEST_F(SystemPathsTest, SystemPaths)
   putenv(const_cast<char*>(pluginPathBackup.c_str()));
 }
 
+/////////////////////////////////////////////////
+TEST_F(SystemPathsTest, FindPluginFile)
+{
+  common::SystemPaths *paths = common::SystemPaths::Instance();
+  const bool fromEnv = paths->pluginPathsFromEnv;
+  paths->pluginPathsFromEnv = false;
+  paths->ClearPluginPaths();
+
+  const boost::filesystem::path root =
+    boost::filesystem::path(paths->TmpPath()) /
+    boost::filesystem::unique_path("find_plugin-%%%%%%");
+  const boost::filesystem::path first = root / "first";
+  const boost::filesystem::path second = root / "second";
+  boost::filesystem::create_directories(first);
+  boost::filesystem::create_directories(second);
+  std::ofstream((first / "libBoth.so").string());
+  std::ofstream((second / "libBoth.so").string());
+  std::ofstream((second / "libSecond.so").string());
+
+  paths->AddPluginPaths(first.string() + ":" + second.string());
+
+  // The first path which has the file wins
+  EXPECT_EQ((first / "libBoth.so").make_preferred().string(),
+      paths->FindPluginFile("libBoth.so"));
+  EXPECT_EQ((second / "libSecond.so").make_preferred().string(),
+      paths->FindPluginFile("libSecond.so"));
+  EXPECT_EQ("", paths->FindPluginFile("libMissing.so"));
+
+  // Files added or removed after the paths were listed
+  std::ofstream((first / "libLater.so").string());
+  EXPECT_EQ((first / "libLater.so").make_preferred().string(),
+      paths->FindPluginFile("libLater.so"));
+  boost::filesystem::remove(first / "libBoth.so");
+  EXPECT_EQ((second / "libBoth.so").make_preferred().string(),
+      paths->FindPluginFile("libBoth.so"));
+
+  // Paths relative to a plugin path
+  EXPECT_EQ(boost::filesystem::path(first.string() +
+        "/../second/libSecond.so").make_preferred().string(),
+      paths->FindPluginFile("../second/libSecond.so"));
+
+  // Changing the paths lists them again
+  paths->ClearPluginPaths();
+  paths->AddPluginPaths(second.string());
+  EXPECT_EQ("", paths->FindPluginFile("libLater.so"));
+
+  boost::filesystem::remove_all(root);
+  paths->ClearPluginPaths();
+  paths->pluginPathsFromEnv = fromEnv;
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
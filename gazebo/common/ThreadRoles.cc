@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/ThreadRoles.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \brief Private data for ThreadRoles.
+    class ThreadRolesPrivate
+    {
+      /// \brief Protects roles and arenas.
+      public: mutable std::mutex mutex;
+
+      /// \brief Settings by role.
+      public: std::map<std::string, ThreadRole> roles;
+
+      /// \brief TBB arenas by role. Shared so that an arena replaced by Set
+      /// outlives the loops running in it.
+      public: std::map<std::string, std::shared_ptr<tbb::task_arena>> arenas;
+    };
+  }
+}
+
+/// \brief Parse a list of CPUs such as "0,2-3".
+/// \param[in] _list List of CPUs.
+/// \param[out] _cpus Parsed CPUs.
+/// \return True if the list is valid.
+static bool ParseCpus(const std::string &_list, std::vector<int> &_cpus)
+{
+  std::istringstream stream(_list);
+  std::string item;
+  while (std::getline(stream, item, ','))
+  {
+    try
+    {
+      const size_t dash = item.find('-');
+      const int first = std::stoi(item.substr(0, dash));
+      const int last = dash == std::string::npos ? first :
+          std::stoi(item.substr(dash + 1));
+      if (first < 0 || last < first)
+        return false;
+      for (int cpu = first; cpu <= last; ++cpu)
+        _cpus.push_back(cpu);
+    }
+    catch(...)
+    {
+      return false;
+    }
+  }
+  return !_cpus.empty();
+}
+
+//////////////////////////////////////////////////
+ThreadRoles::ThreadRoles()
+  : dataPtr(new ThreadRolesPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+ThreadRoles::~ThreadRoles()
+{
+}
+
+//////////////////////////////////////////////////
+void ThreadRoles::Set(const std::string &_role, const ThreadRole &_settings)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  ThreadRole &role = this->dataPtr->roles[_role];
+  role = _settings;
+  role.priority = std::min(std::max(role.priority, 0), 99);
+
+  if (role.tbbConcurrency > 0)
+  {
+    this->dataPtr->arenas[_role].reset(
+        new tbb::task_arena(static_cast<int>(role.tbbConcurrency)));
+  }
+  else
+    this->dataPtr->arenas.erase(_role);
+}
+
+//////////////////////////////////////////////////
+ThreadRole ThreadRoles::Get(const std::string &_role) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->roles.find(_role);
+  return iter == this->dataPtr->roles.end() ? ThreadRole() : iter->second;
+}
+
+//////////////////////////////////////////////////
+bool ThreadRoles::Parse(const std::string &_config)
+{
+  std::istringstream stream(_config);
+  std::string entry;
+  while (std::getline(stream, entry, ';'))
+  {
+    if (entry.empty())
+      continue;
+
+    const size_t colon = entry.find(':');
+    const std::string name = entry.substr(0, colon);
+    if (name.empty())
+    {
+      gzerr << "Missing thread role in [" << entry << "]" << std::endl;
+      return false;
+    }
+
+    ThreadRole role = this->Get(name);
+    const std::string settings = colon == std::string::npos ? std::string() :
+        entry.substr(colon + 1);
+
+    // The commas of a list of CPUs split it too, so a token without a key
+    // continues the previous value.
+    std::vector<std::string> pairs;
+    std::istringstream settingsStream(settings);
+    std::string token;
+    while (std::getline(settingsStream, token, ','))
+    {
+      if (token.find('=') == std::string::npos && !pairs.empty())
+        pairs.back() += "," + token;
+      else
+        pairs.push_back(token);
+    }
+
+    for (auto const &pair : pairs)
+    {
+      const size_t equal = pair.find('=');
+      const std::string key = pair.substr(0, equal);
+      const std::string value = equal == std::string::npos ? std::string() :
+          pair.substr(equal + 1);
+
+      bool valid = true;
+      try
+      {
+        if (key == "cpus")
+        {
+          role.cpus.clear();
+          valid = ParseCpus(value, role.cpus);
+        }
+        else if (key == "priority")
+          role.priority = std::stoi(value);
+        else if (key == "tbb")
+          role.tbbConcurrency = std::stoul(value);
+        else
+          valid = false;
+      }
+      catch(...)
+      {
+        valid = false;
+      }
+
+      if (!valid)
+      {
+        gzerr << "Invalid setting [" << pair << "] of thread role [" << name
+              << "]" << std::endl;
+        return false;
+      }
+    }
+
+    this->Set(name, role);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ThreadRoles::Apply(const std::string &_role)
+{
+  const ThreadRole role = this->Get(_role);
+
+#ifdef __linux__
+  // Thread names are limited to 15 characters
+  const std::string name = ("gz:" + _role).substr(0, 15);
+  pthread_setname_np(pthread_self(), name.c_str());
+
+  if (!role.cpus.empty())
+  {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (auto const cpu : role.cpus)
+      CPU_SET(cpu, &cpus);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0)
+    {
+      gzwarn << "Unable to set the CPU affinity of thread role [" << _role
+             << "]" << std::endl;
+    }
+  }
+
+  if (role.priority > 0)
+  {
+    sched_param param;
+    param.sched_priority = role.priority;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0)
+    {
+      gzwarn << "Unable to run thread role [" << _role << "] with "
+             << "SCHED_FIFO priority [" << role.priority << "], check the "
+             << "rtprio limit" << std::endl;
+    }
+  }
+#else
+  (void)role;
+#endif
+}
+
+//////////////////////////////////////////////////
+void ThreadRoles::Execute(const std::string &_role,
+    const std::function<void()> &_func)
+{
+  std::shared_ptr<tbb::task_arena> arena;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->arenas.find(_role);
+    if (iter != this->dataPtr->arenas.end())
+      arena = iter->second;
+  }
+
+  if (arena)
+    arena->execute(_func);
+  else
+    _func();
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_THREADROLES_HH_
+#define GAZEBO_COMMON_THREADROLES_HH_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, ThreadRoles)
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declarations.
+    class ThreadRolesPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \brief Scheduling settings of a thread role.
+    class GZ_COMMON_VISIBLE ThreadRole
+    {
+      /// \brief CPUs the threads of the role may run on, all if empty.
+      public: std::vector<int> cpus;
+
+      /// \brief SCHED_FIFO priority from 1 to 99, or 0 for the default
+      /// policy.
+      public: int priority = 0;
+
+      /// \brief Maximum number of TBB workers for the parallel loops run
+      /// by the role, or 0 to share the default pool.
+      public: unsigned int tbbConcurrency = 0;
+    };
+
+    /// \class ThreadRoles ThreadRoles.hh common/common.hh
+    /// \brief Names the threads of the server after their role, and pins
+    /// them and sets their priority from a per-role configuration. The
+    /// roles are:
+    ///
+    ///   world        Update loop of a world, see physics::World::RunLoop.
+    ///   log_worker   World state logging.
+    ///   sensors      Update loops of the sensor containers.
+    ///   io           Transport IO threads.
+    ///   log_update   Log recording update thread.
+    ///   log_write    Log recording write thread.
+    ///   log_cleanup  Log recording cleanup thread.
+    ///   log_upload   Upload of completed log segments.
+    ///   video_encoder  Encoding of the videos recorded by cameras, see
+    ///                VideoEncoder.
+    ///   transport_flush  Parallel flush of the node publishers, see
+    ///                transport::TopicManager::ProcessNodes.
+    ///
+    /// Only supported on Linux, elsewhere the settings are ignored.
+    class GZ_COMMON_VISIBLE ThreadRoles : public SingletonT<ThreadRoles>
+    {
+      /// \brief Constructor.
+      private: ThreadRoles();
+
+      /// \brief Destructor.
+      private: virtual ~ThreadRoles();
+
+      /// \brief Set the settings of a role. Threads already started keep
+      /// their settings.
+      /// \param[in] _role Name of the role.
+      /// \param[in] _settings Settings of the role.
+      public: void Set(const std::string &_role, const ThreadRole &_settings);
+
+      /// \brief Get the settings of a role.
+      /// \param[in] _role Name of the role.
+      /// \return Settings of the role, the defaults if not set.
+      public: ThreadRole Get(const std::string &_role) const;
+
+      /// \brief Set the settings of several roles from a string such as
+      /// "world:cpus=0-1,priority=50,tbb=2;sensors:cpus=2,4-5". Each role
+      /// is followed by a list of key=value pairs, where cpus takes a list
+      /// of CPUs and ranges.
+      /// \param[in] _config Configuration string.
+      /// \return True if the whole string was valid. Roles before an error
+      /// are set.
+      public: bool Parse(const std::string &_config);
+
+      /// \brief Apply the settings of a role to the calling thread, and
+      /// name it "gz:<role>". Called at the start of each server thread.
+      /// \param[in] _role Name of the role.
+      public: void Apply(const std::string &_role);
+
+      /// \brief Run a function that starts TBB parallel loops, in the TBB
+      /// arena of a role when its tbbConcurrency is set. The arena limits
+      /// the workers of the loops, and keeps them away from the loops of
+      /// the other roles.
+      /// \param[in] _role Name of the role.
+      /// \param[in] _func Function to run.
+      public: void Execute(const std::string &_role,
+                  const std::function<void()> &_func);
+
+      /// \brief This is a singleton class.
+      private: friend class SingletonT<ThreadRoles>;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ThreadRolesPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include <tbb/task_arena.h>
+
+#include "gazebo/common/ThreadRoles.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+using namespace common;
+
+class ThreadRolesTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(ThreadRolesTest, Parse)
+{
+  ThreadRoles *roles = ThreadRoles::Instance();
+
+  // Defaults for a role never set
+  ThreadRole role = roles->Get("unknown_role");
+  EXPECT_TRUE(role.cpus.empty());
+  EXPECT_EQ(0, role.priority);
+  EXPECT_EQ(0u, role.tbbConcurrency);
+
+  EXPECT_TRUE(roles->Parse("test_a:cpus=0,2-3,priority=150;test_b:tbb=2"));
+
+  role = roles->Get("test_a");
+  ASSERT_EQ(3u, role.cpus.size());
+  EXPECT_EQ(0, role.cpus[0]);
+  EXPECT_EQ(2, role.cpus[1]);
+  EXPECT_EQ(3, role.cpus[2]);
+  EXPECT_EQ(99, role.priority);
+  EXPECT_EQ(0u, role.tbbConcurrency);
+
+  role = roles->Get("test_b");
+  EXPECT_TRUE(role.cpus.empty());
+  EXPECT_EQ(2u, role.tbbConcurrency);
+
+  // Later settings only change the keys they name
+  EXPECT_TRUE(roles->Parse("test_a:priority=0"));
+  role = roles->Get("test_a");
+  EXPECT_EQ(3u, role.cpus.size());
+  EXPECT_EQ(0, role.priority);
+
+  EXPECT_FALSE(roles->Parse("test_c:cpus=3-1"));
+  EXPECT_FALSE(roles->Parse("test_c:cpus=a"));
+  EXPECT_FALSE(roles->Parse("test_c:speed=1"));
+  EXPECT_FALSE(roles->Parse(":priority=1"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ThreadRolesTest, Execute)
+{
+  ThreadRoles *roles = ThreadRoles::Instance();
+
+  ThreadRole role;
+  role.tbbConcurrency = 1;
+  roles->Set("test_arena", role);
+
+  // A single worker arena runs the whole loop on the calling thread
+  std::atomic<int> concurrency(0);
+  roles->Execute("test_arena", [&]()
+  {
+    concurrency = tbb::this_task_arena::max_concurrency();
+  });
+  EXPECT_EQ(1, concurrency);
+
+  // Roles without an arena run in place
+  bool ran = false;
+  roles->Execute("test_no_arena", [&]() { ran = true; });
+  EXPECT_TRUE(ran);
+
+  // Applying a role to a thread must not fail without privileges
+  std::thread thread([&roles]() { roles->Apply("test_arena"); });
+  thread.join();
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
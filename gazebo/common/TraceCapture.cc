@@ -0,0 +1,489 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/common/TraceCapture.hh"
+
+using namespace gazebo;
+using namespace common;
+
+const unsigned int TraceCapture::kMaxDepth;
+const unsigned int TraceCapture::kMaxNameLength;
+const size_t TraceCapture::kMaxEventsPerThread;
+const double TraceCapture::kDefaultDuration = 10.0;
+
+/// \brief Number of zones in a chunk of a thread buffer.
+static const size_t kChunkEvents = 4096;
+
+/// \brief Number of chunks of a thread buffer.
+static const size_t kMaxChunks =
+  TraceCapture::kMaxEventsPerThread / kChunkEvents;
+
+/// \brief A zone recorded by a thread.
+struct TraceEvent
+{
+  /// \brief Start time, in nanoseconds of the steady clock.
+  int64_t start;
+
+  /// \brief Duration in nanoseconds.
+  int64_t duration;
+
+  /// \brief Name of the zone.
+  char name[TraceCapture::kMaxNameLength + 1];
+};
+
+/// \brief Zones recorded by one thread. The thread appends zones and then
+/// publishes the new count, the writer of the trace file only reads the
+/// published zones.
+class ThreadBuffer
+{
+  /// \brief Chunks of zones, allocated by the thread as it needs them and
+  /// kept for the next captures.
+  public: std::unique_ptr<TraceEvent[]> chunks[kMaxChunks];
+
+  /// \brief Number of zones recorded during the capture.
+  public: std::atomic<size_t> count{0};
+
+  /// \brief Number of zones dropped during the capture.
+  public: std::atomic<size_t> dropped{0};
+
+  /// \brief Capture that the zones belong to.
+  public: std::atomic<uint64_t> generation{0};
+
+  /// \brief Id of the thread in the trace.
+  public: uint64_t id = 0;
+
+  /// \brief Name of the thread, protected by the registry mutex.
+  public: std::string name;
+};
+
+/// \brief A zone that is open on a thread.
+struct OpenZone
+{
+  /// \brief Capture during which the zone began, 0 if not recorded.
+  uint64_t generation;
+
+  /// \brief Start time, in nanoseconds of the steady clock.
+  int64_t start;
+
+  /// \brief Name of the zone.
+  char name[TraceCapture::kMaxNameLength + 1];
+};
+
+/// \brief Zones of the current thread.
+struct ThreadState
+{
+  /// \brief Open zones, innermost last.
+  OpenZone zones[TraceCapture::kMaxDepth];
+
+  /// \brief Number of open zones, including the ones too deep to record.
+  unsigned int depth = 0;
+
+  /// \brief Buffer of the thread, created by its first recorded zone.
+  std::shared_ptr<ThreadBuffer> buffer;
+
+  /// \brief Name of the thread.
+  std::string name;
+};
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for TraceCapture.
+    class TraceCapturePrivate
+    {
+      /// \brief Buffers of the threads that recorded zones. Buffers are
+      /// kept after their thread exits.
+      public: std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+      /// \brief Protects buffers and the names of the threads.
+      public: std::mutex registryMutex;
+
+      /// \brief Serializes Start and Stop.
+      public: std::mutex controlMutex;
+
+      /// \brief Ends the capture after its duration.
+      public: std::thread timer;
+
+      /// \brief Protects stopRequested.
+      public: std::mutex waitMutex;
+
+      /// \brief Wakes the timer when Stop is called.
+      public: std::condition_variable waitCondition;
+
+      /// \brief True when Stop is called.
+      public: bool stopRequested = false;
+
+      /// \brief Trace file of the last capture.
+      public: std::string filename;
+
+      /// \brief Start of the last capture, in nanoseconds of the steady
+      /// clock.
+      public: int64_t startTime = 0;
+    };
+  }
+}
+
+/// \brief True while a capture is running.
+static std::atomic<bool> capturing(false);
+
+/// \brief Number of the current or last capture.
+static std::atomic<uint64_t> generation(0);
+
+/// \brief Zones of this thread.
+static thread_local ThreadState threadState;
+
+/// \brief Get the time of the steady clock.
+/// \return Time in nanoseconds.
+static int64_t Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// \brief Write a string as a JSON string.
+/// \param[in] _out Stream to write to.
+/// \param[in] _str The string.
+static void WriteJsonString(std::ostream &_out, const std::string &_str)
+{
+  _out << '"';
+  for (const char c : _str)
+  {
+    if (c == '"' || c == '\\')
+      _out << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      char escaped[8];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      _out << escaped;
+    }
+    else
+      _out << c;
+  }
+  _out << '"';
+}
+
+//////////////////////////////////////////////////
+TraceCapture::TraceCapture()
+  : dataPtr(new TraceCapturePrivate)
+{
+}
+
+//////////////////////////////////////////////////
+TraceCapture::~TraceCapture()
+{
+  this->Stop();
+}
+
+//////////////////////////////////////////////////
+bool TraceCapture::Start(const std::string &_filename,
+    const double _duration)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->controlMutex);
+  if (capturing)
+  {
+    gzwarn << "A trace is already being captured to ["
+      << this->dataPtr->filename << "]" << std::endl;
+    return false;
+  }
+
+  // The previous capture has been written
+  if (this->dataPtr->timer.joinable())
+    this->dataPtr->timer.join();
+
+  this->dataPtr->filename = _filename.empty() ? DefaultFilename() : _filename;
+  this->dataPtr->stopRequested = false;
+  this->dataPtr->startTime = Now();
+  ++generation;
+  capturing = true;
+
+  gzmsg << "Capturing a trace to [" << this->dataPtr->filename << "]";
+  if (_duration > 0)
+    gzmsg << " for " << _duration << " s";
+  gzmsg << std::endl;
+
+  this->dataPtr->timer = std::thread([this, _duration]()
+      {
+        std::unique_lock<std::mutex> waitLock(this->dataPtr->waitMutex);
+        auto stopped = [this]() {return this->dataPtr->stopRequested;};
+        if (_duration > 0)
+        {
+          this->dataPtr->waitCondition.wait_for(waitLock,
+              std::chrono::duration<double>(_duration), stopped);
+        }
+        else
+          this->dataPtr->waitCondition.wait(waitLock, stopped);
+        waitLock.unlock();
+
+        this->Finish();
+      });
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool TraceCapture::Stop()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->controlMutex);
+  if (!this->dataPtr->timer.joinable())
+    return false;
+
+  const bool wasCapturing = capturing;
+  {
+    std::lock_guard<std::mutex> waitLock(this->dataPtr->waitMutex);
+    this->dataPtr->stopRequested = true;
+  }
+  this->dataPtr->waitCondition.notify_all();
+  this->dataPtr->timer.join();
+  return wasCapturing;
+}
+
+//////////////////////////////////////////////////
+bool TraceCapture::Capturing()
+{
+  return capturing.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+std::string TraceCapture::Filename() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->controlMutex);
+  return this->dataPtr->filename;
+}
+
+//////////////////////////////////////////////////
+std::string TraceCapture::DefaultFilename()
+{
+  std::string timeStr = common::Time::GetWallTimeAsISOString();
+#ifdef _WIN32
+  std::replace(timeStr.begin(), timeStr.end(), ':', '_');
+#endif
+
+  boost::filesystem::path path(SystemPaths::Instance()->GetLogPath());
+  path = path / "traces" / (timeStr + ".json");
+  return path.string();
+}
+
+//////////////////////////////////////////////////
+void TraceCapture::Begin(const char *_name)
+{
+#if IGN_PROFILER_ENABLE
+  ignition::common::Profiler::Instance()->BeginSample(_name);
+#endif
+
+  ThreadState &state = threadState;
+  if (state.depth < kMaxDepth)
+  {
+    OpenZone &zone = state.zones[state.depth];
+    zone.generation = 0;
+    if (capturing.load(std::memory_order_relaxed))
+    {
+      zone.generation = generation.load();
+      zone.start = Now();
+      strncpy(zone.name, _name ? _name : "", kMaxNameLength);
+      zone.name[kMaxNameLength] = '\0';
+    }
+  }
+  ++state.depth;
+}
+
+//////////////////////////////////////////////////
+void TraceCapture::End()
+{
+#if IGN_PROFILER_ENABLE
+  ignition::common::Profiler::Instance()->EndSample();
+#endif
+
+  ThreadState &state = threadState;
+  if (state.depth == 0)
+    return;
+
+  --state.depth;
+  if (state.depth >= kMaxDepth)
+    return;
+
+  // Only the zones that began during this capture are recorded
+  const OpenZone &zone = state.zones[state.depth];
+  if (zone.generation == 0 || !capturing.load(std::memory_order_relaxed) ||
+      zone.generation != generation.load())
+  {
+    return;
+  }
+
+  if (!state.buffer)
+  {
+    state.buffer = std::make_shared<ThreadBuffer>();
+    TraceCapturePrivate *data = TraceCapture::Instance()->dataPtr.get();
+    std::lock_guard<std::mutex> lock(data->registryMutex);
+    state.buffer->id = data->buffers.size() + 1;
+    state.buffer->name = state.name;
+    data->buffers.push_back(state.buffer);
+  }
+
+  ThreadBuffer &buffer = *state.buffer;
+  if (buffer.generation.load(std::memory_order_relaxed) != zone.generation)
+  {
+    buffer.count.store(0, std::memory_order_relaxed);
+    buffer.dropped.store(0, std::memory_order_relaxed);
+    buffer.generation.store(zone.generation, std::memory_order_release);
+  }
+
+  const size_t count = buffer.count.load(std::memory_order_relaxed);
+  if (count >= kMaxEventsPerThread)
+  {
+    buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  std::unique_ptr<TraceEvent[]> &chunk = buffer.chunks[count / kChunkEvents];
+  if (!chunk)
+    chunk.reset(new TraceEvent[kChunkEvents]);
+
+  TraceEvent &event = chunk[count % kChunkEvents];
+  event.start = zone.start;
+  event.duration = Now() - zone.start;
+  memcpy(event.name, zone.name, sizeof(event.name));
+
+  buffer.count.store(count + 1, std::memory_order_release);
+}
+
+//////////////////////////////////////////////////
+void TraceCapture::SetThreadName(const char *_name)
+{
+#if IGN_PROFILER_ENABLE
+  ignition::common::Profiler::Instance()->SetThreadName(_name);
+#endif
+
+  ThreadState &state = threadState;
+  state.name = _name ? _name : "";
+  if (state.buffer)
+  {
+    TraceCapturePrivate *data = TraceCapture::Instance()->dataPtr.get();
+    std::lock_guard<std::mutex> lock(data->registryMutex);
+    state.buffer->name = state.name;
+  }
+}
+
+//////////////////////////////////////////////////
+void TraceCapture::Finish()
+{
+  capturing = false;
+  const uint64_t capture = generation.load();
+
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->registryMutex);
+    buffers = this->dataPtr->buffers;
+  }
+
+  const boost::filesystem::path path(this->dataPtr->filename);
+  boost::system::error_code error;
+  if (path.has_parent_path())
+    boost::filesystem::create_directories(path.parent_path(), error);
+
+  std::ofstream out(this->dataPtr->filename.c_str());
+  if (!out)
+  {
+    gzerr << "Unable to write the trace to [" << this->dataPtr->filename
+      << "]" << std::endl;
+    return;
+  }
+
+#ifndef _WIN32
+  const int pid = static_cast<int>(getpid());
+#else
+  const int pid = 1;
+#endif
+
+  // Times are in microseconds since the start of the capture
+  const double start = this->dataPtr->startTime * 1e-3;
+  out.setf(std::ios::fixed);
+  out.precision(3);
+
+  size_t zones = 0;
+  size_t dropped = 0;
+  bool first = true;
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (auto const &buffer : buffers)
+  {
+    if (buffer->generation.load(std::memory_order_acquire) != capture)
+      continue;
+
+    const size_t count = buffer->count.load(std::memory_order_acquire);
+    zones += count;
+    dropped += buffer->dropped.load(std::memory_order_relaxed);
+
+    std::string name;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->registryMutex);
+      name = buffer->name;
+    }
+    if (!name.empty())
+    {
+      out << (first ? "\n" : ",\n")
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"tid\":" << buffer->id << ",\"args\":{\"name\":";
+      WriteJsonString(out, name);
+      out << "}}";
+      first = false;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      const TraceEvent &event =
+        buffer->chunks[i / kChunkEvents][i % kChunkEvents];
+      out << (first ? "\n" : ",\n") << "{\"name\":";
+      WriteJsonString(out, event.name);
+      out << ",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << buffer->id
+        << ",\"ts\":" << event.start * 1e-3 - start
+        << ",\"dur\":" << event.duration * 1e-3 << "}";
+      first = false;
+    }
+  }
+  out << "\n]}\n";
+  out.close();
+
+  gzmsg << "Wrote a trace of " << zones << " zones to ["
+    << this->dataPtr->filename << "]" << std::endl;
+  if (dropped > 0)
+  {
+    gzwarn << dropped << " zones were dropped, more than "
+      << kMaxEventsPerThread << " zones were recorded by a thread"
+      << std::endl;
+  }
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_TRACECAPTURE_HH_
+#define GAZEBO_COMMON_TRACECAPTURE_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <ignition/common/Profiler.hh>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, TraceCapture)
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class TraceCapturePrivate;
+
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class TraceCapture TraceCapture.hh common/common.hh
+    /// \brief Records the IGN_PROFILE zones for a window of time, and writes
+    /// them to a trace file in the Chrome trace event format, which the
+    /// Perfetto UI and chrome://tracing open.
+    ///
+    /// Unlike the ignition profiler, which needs IGN_PROFILER_ENABLE and a
+    /// browser connected to Remotery, captures are always available. The
+    /// profiler macros are routed here by including this header instead of
+    /// ignition/common/Profiler.hh, and still reach the ignition profiler
+    /// when it is enabled. Outside of a capture, a zone costs a check of a
+    /// flag. During a capture, each thread records its zones into its own
+    /// buffer without locking, up to kMaxEventsPerThread zones.
+    class GZ_COMMON_VISIBLE TraceCapture : public SingletonT<TraceCapture>
+    {
+      /// \brief Zones nested deeper on a thread are not recorded.
+      public: static const unsigned int kMaxDepth = 64;
+
+      /// \brief Longer zone names are truncated.
+      public: static const unsigned int kMaxNameLength = 39;
+
+      /// \brief Zones recorded by a thread past this count are dropped.
+      public: static const size_t kMaxEventsPerThread = 1 << 20;
+
+      /// \brief Duration of a capture when none is given, in seconds.
+      public: static const double kDefaultDuration;
+
+      /// \brief Start a capture.
+      /// \param[in] _filename Trace file to write, DefaultFilename() if
+      /// empty.
+      /// \param[in] _duration Duration of the capture in seconds. The
+      /// capture runs until Stop is called if zero or negative.
+      /// \return False if a capture is already running.
+      public: bool Start(const std::string &_filename,
+                  const double _duration = kDefaultDuration);
+
+      /// \brief Stop the capture before the end of its duration, and write
+      /// the trace file. Returns once it is written.
+      /// \return False if no capture was running.
+      public: bool Stop();
+
+      /// \brief Get whether a capture is running.
+      /// \return True if the zones are recorded.
+      public: static bool Capturing();
+
+      /// \brief Get the trace file written by the last capture started.
+      /// \return File name, empty if no capture was started.
+      public: std::string Filename() const;
+
+      /// \brief Get the file written when no file name is given.
+      /// \return A file under the traces directory of the log path, named
+      /// after the current time.
+      public: static std::string DefaultFilename();
+
+      /// \brief Begin a zone on this thread, see IGN_PROFILE_BEGIN.
+      /// \param[in] _name Name of the zone, copied.
+      public: static void Begin(const char *_name);
+
+      /// \brief End the innermost zone of this thread, see IGN_PROFILE_END.
+      public: static void End();
+
+      /// \brief Name this thread in the trace, see IGN_PROFILE_THREAD_NAME.
+      /// \param[in] _name Name of the thread.
+      public: static void SetThreadName(const char *_name);
+
+      /// \brief End the capture and write the trace file.
+      private: void Finish();
+
+      /// \brief Constructor.
+      private: TraceCapture();
+
+      /// \brief Destructor, stops the capture.
+      private: virtual ~TraceCapture();
+
+      /// \brief This is a singleton.
+      private: friend class SingletonT<TraceCapture>;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<TraceCapturePrivate> dataPtr;
+    };
+
+    /// \class TraceZone TraceCapture.hh common/common.hh
+    /// \brief A zone that lasts as long as this object, see IGN_PROFILE.
+    class GZ_COMMON_VISIBLE TraceZone
+    {
+      /// \brief Constructor, begins the zone.
+      /// \param[in] _name Name of the zone.
+      public: explicit TraceZone(const char *_name)
+              {
+                TraceCapture::Begin(_name);
+              }
+
+      /// \brief Destructor, ends the zone.
+      public: ~TraceZone()
+              {
+                TraceCapture::End();
+              }
+
+      /// \brief Not copyable.
+      private: TraceZone(const TraceZone &) = delete;
+
+      /// \brief Not copyable.
+      private: TraceZone &operator=(const TraceZone &) = delete;
+    };
+    /// \}
+  }
+}
+
+// Route the profiler macros through TraceCapture.
+#undef IGN_PROFILE_THREAD_NAME
+#undef IGN_PROFILE_BEGIN
+#undef IGN_PROFILE_END
+#undef IGN_PROFILE_L
+#undef IGN_PROFILE
+
+#define GZ_TRACE_CONCAT_IMPL(_a, _b) _a##_b
+#define GZ_TRACE_CONCAT(_a, _b) GZ_TRACE_CONCAT_IMPL(_a, _b)
+
+#define IGN_PROFILE_THREAD_NAME(name) \
+  gazebo::common::TraceCapture::SetThreadName(name)
+#define IGN_PROFILE_BEGIN(name) gazebo::common::TraceCapture::Begin(name)
+#define IGN_PROFILE_END() gazebo::common::TraceCapture::End()
+#define IGN_PROFILE_L(name, line) \
+  gazebo::common::TraceZone GZ_TRACE_CONCAT(gzTraceZone, line)(name)
+#define IGN_PROFILE(name) IGN_PROFILE_L(name, __LINE__)
+
+#endif
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/TraceCapture.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TraceCaptureTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Read a trace file.
+/// \param[in] _filename The trace file.
+/// \return Content of the file.
+static std::string ReadTrace(const std::string &_filename)
+{
+  std::ifstream in(_filename.c_str());
+  std::stringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get a trace file in a temporary directory.
+/// \param[in] _name Name of the file.
+/// \return Path of the file.
+static std::string TraceFile(const std::string &_name)
+{
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gazebo_trace_%%%%%%%%") / _name;
+  return path.string();
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceCaptureTest, Capture)
+{
+  common::TraceCapture *capture = common::TraceCapture::Instance();
+  EXPECT_FALSE(common::TraceCapture::Capturing());
+  EXPECT_FALSE(capture->Stop());
+
+  // Not recorded outside of a capture
+  {
+    IGN_PROFILE("idleZone");
+  }
+
+  const std::string filename = TraceFile("capture.json");
+  EXPECT_TRUE(capture->Start(filename, 0));
+  EXPECT_TRUE(common::TraceCapture::Capturing());
+  EXPECT_EQ(filename, capture->Filename());
+  EXPECT_FALSE(capture->Start(filename, 0));
+
+  IGN_PROFILE_THREAD_NAME("main \"thread\"");
+  {
+    IGN_PROFILE("outerZone");
+    IGN_PROFILE_BEGIN("innerZone");
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    IGN_PROFILE_END();
+  }
+  std::thread([]()
+  {
+    IGN_PROFILE_THREAD_NAME("worker");
+    IGN_PROFILE("workerZone");
+  }).join();
+
+  // Began before the capture ends, ended after it
+  IGN_PROFILE_BEGIN("unfinishedZone");
+  EXPECT_TRUE(capture->Stop());
+  IGN_PROFILE_END();
+  EXPECT_FALSE(common::TraceCapture::Capturing());
+
+  const std::string trace = ReadTrace(filename);
+  EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, trace.find("\"outerZone\""));
+  EXPECT_NE(std::string::npos, trace.find("\"innerZone\""));
+  EXPECT_NE(std::string::npos, trace.find("\"workerZone\""));
+  EXPECT_NE(std::string::npos, trace.find("\"main \\\"thread\\\"\""));
+  EXPECT_NE(std::string::npos, trace.find("\"worker\""));
+  EXPECT_EQ(std::string::npos, trace.find("idleZone"));
+  EXPECT_EQ(std::string::npos, trace.find("unfinishedZone"));
+
+  // The inner zone is written before the outer zone, since it ends first
+  EXPECT_LT(trace.find("innerZone"), trace.find("outerZone"));
+
+  boost::filesystem::remove_all(
+      boost::filesystem::path(filename).parent_path());
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceCaptureTest, Duration)
+{
+  common::TraceCapture *capture = common::TraceCapture::Instance();
+  const std::string filename = TraceFile("duration.json");
+  ASSERT_TRUE(capture->Start(filename, 0.05));
+  {
+    IGN_PROFILE("timedZone");
+  }
+
+  for (int i = 0; i < 500 && common::TraceCapture::Capturing(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(common::TraceCapture::Capturing());
+
+  // The zones of the previous capture are not written again
+  ASSERT_TRUE(capture->Start(filename, 0));
+  {
+    IGN_PROFILE("secondZone");
+  }
+  EXPECT_TRUE(capture->Stop());
+
+  const std::string trace = ReadTrace(filename);
+  EXPECT_NE(std::string::npos, trace.find("\"secondZone\""));
+  EXPECT_EQ(std::string::npos, trace.find("timedZone"));
+
+  boost::filesystem::remove_all(
+      boost::filesystem::path(filename).parent_path());
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceCaptureTest, LongNames)
+{
+  common::TraceCapture *capture = common::TraceCapture::Instance();
+  const std::string filename = TraceFile("names.json");
+  const std::string name(100, 'z');
+
+  ASSERT_TRUE(capture->Start(filename, 0));
+  {
+    IGN_PROFILE(name.c_str());
+  }
+  EXPECT_TRUE(capture->Stop());
+
+  const std::string trace = ReadTrace(filename);
+  const std::string truncated =
+    "\"" + name.substr(0, common::TraceCapture::kMaxNameLength) + "\"";
+  EXPECT_NE(std::string::npos, trace.find(truncated));
+
+  boost::filesystem::remove_all(
+      boost::filesystem::path(filename).parent_path());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
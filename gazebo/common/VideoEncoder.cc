@@ -14,7 +14,11 @@
  * limitations under the License.
  *
 */
+#include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <thread>
+#include <vector>
 #include <stdio.h>
 #include <gazebo/gazebo_config.h>
 
@@ -49,6 +53,7 @@ extern "C"
 
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/ThreadRoles.hh"
 #include "gazebo/common/VideoEncoder.hh"
 
 using namespace gazebo;
@@ -115,8 +120,101 @@ class gazebo::common::VideoEncoderPrivate
 
   /// \brief Mutex for thread safety.
   public: std::mutex mutex;
+
+  /// \brief A frame waiting to be encoded.
+  public: class Frame
+  {
+    /// \brief RGB pixels.
+    public: std::vector<unsigned char> data;
+
+    /// \brief Width in pixels.
+    public: unsigned int width = 0;
+
+    /// \brief Height in pixels.
+    public: unsigned int height = 0;
+  };
+
+#ifdef HAVE_FFMPEG
+  /// \brief Encode a frame and write its packets.
+  /// \param[in] _frame RGB pixels.
+  /// \param[in] _width Width in pixels.
+  /// \param[in] _height Height in pixels.
+  /// \return True on success.
+  public: bool Encode(const unsigned char *_frame,
+              const unsigned int _width, const unsigned int _height);
+
+  /// \brief Body of the encoding thread. Encodes the queued frames until
+  /// stopped and the queue is empty.
+  public: void Run();
+
+  /// \brief Allocate, configure and open the codec context.
+  /// \param[in] _encoder Encoder to open.
+  /// \param[in] _width Width in pixels of the output video.
+  /// \param[in] _height Height in pixels of the output video.
+  /// \return False if the encoder could not be opened.
+  public: bool OpenCodec(const AVCodec *_encoder,
+              const unsigned int _width, const unsigned int _height);
+#endif
+
+  /// \brief Largest number of queued frames set by SetQueueSize.
+  public: unsigned int queueSize = 4;
+
+  /// \brief Largest number of queued frames of the current video, 0 if
+  /// frames are encoded by AddFrame.
+  public: unsigned int queueCapacity = 0;
+
+  /// \brief Frames waiting for the encoding thread.
+  public: std::deque<Frame> queue;
+
+  /// \brief Buffers of encoded frames, reused by the next frames.
+  public: std::vector<std::vector<unsigned char>> spareBuffers;
+
+  /// \brief Frames dropped because the queue was full.
+  public: uint64_t droppedFrames = 0;
+
+  /// \brief True to stop the encoding thread once the queue is empty.
+  public: bool stopEncoding = false;
+
+  /// \brief Protects the queue, the spare buffers and the dropped frames.
+  public: mutable std::mutex queueMutex;
+
+  /// \brief Wakes the encoding thread.
+  public: std::condition_variable queueCondition;
+
+  /// \brief Encoding thread.
+  public: std::thread encodeThread;
+
+  /// \brief True to try the hardware encoders first.
+  public: bool hardwareEncoding = false;
+
+  /// \brief Name of the libav encoder of the current video.
+  public: std::string encoderName;
 };
 
+#ifdef HAVE_FFMPEG
+/////////////////////////////////////////////////
+/// \brief Get the pixel format to encode with.
+/// \param[in] _encoder Encoder.
+/// \return YUV420P or NV12, or AV_PIX_FMT_NONE if the encoder supports
+/// neither.
+static AVPixelFormat EncoderPixelFormat(const AVCodec *_encoder)
+{
+  if (!_encoder->pix_fmts)
+    return AV_PIX_FMT_YUV420P;
+
+  AVPixelFormat result = AV_PIX_FMT_NONE;
+  for (const AVPixelFormat *fmt = _encoder->pix_fmts;
+       *fmt != AV_PIX_FMT_NONE; ++fmt)
+  {
+    if (*fmt == AV_PIX_FMT_YUV420P)
+      return *fmt;
+    if (*fmt == AV_PIX_FMT_NV12)
+      result = *fmt;
+  }
+  return result;
+}
+#endif
+
 /////////////////////////////////////////////////
 VideoEncoder::VideoEncoder()
 : dataPtr(new VideoEncoderPrivate)
@@ -143,6 +241,43 @@ unsigned int VideoEncoder::BitRate() const
   return this->dataPtr->bitRate;
 }
 
+/////////////////////////////////////////////////
+void VideoEncoder::SetQueueSize(const unsigned int _size)
+{
+  this->dataPtr->queueSize = _size;
+}
+
+/////////////////////////////////////////////////
+unsigned int VideoEncoder::QueueSize() const
+{
+  return this->dataPtr->queueSize;
+}
+
+/////////////////////////////////////////////////
+uint64_t VideoEncoder::DroppedFrameCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+  return this->dataPtr->droppedFrames;
+}
+
+/////////////////////////////////////////////////
+void VideoEncoder::SetHardwareEncoding(const bool _enable)
+{
+  this->dataPtr->hardwareEncoding = _enable;
+}
+
+/////////////////////////////////////////////////
+bool VideoEncoder::HardwareEncoding() const
+{
+  return this->dataPtr->hardwareEncoding;
+}
+
+/////////////////////////////////////////////////
+std::string VideoEncoder::EncoderName() const
+{
+  return this->dataPtr->encoderName;
+}
+
 /////////////////////////////////////////////////
 #ifdef HAVE_FFMPEG
 bool VideoEncoder::Start(const std::string &_format,
@@ -204,6 +339,10 @@ bool VideoEncoder::Start(const std::string &_format,
   this->dataPtr->fps = _fps;
   this->dataPtr->frameCount = 0;
   this->dataPtr->filename = _filename;
+  {
+    std::lock_guard<std::mutex> queueLock(this->dataPtr->queueMutex);
+    this->dataPtr->droppedFrames = 0;
+  }
 
   // Create a default filenamae if the provided filename is empty.
   if (this->dataPtr->filename.empty())
@@ -330,85 +469,40 @@ bool VideoEncoder::Start(const std::string &_format,
   }
   this->dataPtr->videoStream->id = this->dataPtr->formatCtx->nb_streams-1;
 
-  // Allocate a new video context
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-  this->dataPtr->codecCtx = this->dataPtr->videoStream->codec;
-#else
-  this->dataPtr->codecCtx = avcodec_alloc_context3(encoder);
-#endif
-
-  if (!this->dataPtr->codecCtx)
+  // Hardware encoders of the codec are tried before the software encoder.
+  // Those that take frames in system memory are used, the others need a
+  // hardware frames context.
+  std::vector<const AVCodec *> encoders;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 24, 1)
+  if (this->dataPtr->hardwareEncoding)
   {
-    gzerr << "Could not allocate an encoding context."
-          << "Video encoding is not started\n";
-    this->Reset();
-    return false;
+    const std::string codecName =
+      avcodec_get_name(this->dataPtr->formatCtx->oformat->video_codec);
+    for (auto const &suffix :
+        {"_nvenc", "_qsv", "_amf", "_videotoolbox", "_v4l2m2m"})
+    {
+      const AVCodec *hardware =
+        avcodec_find_encoder_by_name((codecName + suffix).c_str());
+      if (hardware && EncoderPixelFormat(hardware) != AV_PIX_FMT_NONE)
+        encoders.push_back(hardware);
+    }
   }
-
-  // some formats want stream headers to be separate
-  if (this->dataPtr->formatCtx->oformat->flags & AVFMT_GLOBALHEADER)
-  {
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-    this->dataPtr->codecCtx->flags |= CODEC_FLAG_GLOBAL_HEADER;
-#else
-    this->dataPtr->codecCtx->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
 #endif
-  }
-
-  // Frames per second
-  this->dataPtr->codecCtx->time_base.den = this->dataPtr->fps;
-  this->dataPtr->codecCtx->time_base.num = 1;
-
-  // The video stream must have the same time base as the context
-  this->dataPtr->videoStream->time_base.den = this->dataPtr->fps;
-  this->dataPtr->videoStream->time_base.num = 1;
-
-  // Bitrate
-  this->dataPtr->codecCtx->bit_rate = this->dataPtr->bitRate;
+  encoders.push_back(encoder);
 
-  // The resolution must be divisible by two
-  this->dataPtr->codecCtx->width = _width % 2 == 0 ? _width : _width + 1;
-  this->dataPtr->codecCtx->height = _height % 2 == 0 ? _height : _height + 1;
-
-  // Emit one intra-frame every 10 frames
-  this->dataPtr->codecCtx->gop_size = 10;
-  this->dataPtr->codecCtx->max_b_frames = 1;
-  this->dataPtr->codecCtx->pix_fmt = AV_PIX_FMT_YUV420P;
-  this->dataPtr->codecCtx->thread_count = 5;
-
-  // Set the codec id
-  this->dataPtr->codecCtx->codec_id =
-    this->dataPtr->formatCtx->oformat->video_codec;
-
-  if (this->dataPtr->codecCtx->codec_id == AV_CODEC_ID_MPEG1VIDEO)
+  this->dataPtr->encoderName.clear();
+  for (auto const &candidate : encoders)
   {
-    // Needed to avoid using macroblocks in which some coeffs overflow.
-    // This does not happen with normal video, it just happens here as
-    // the motion of the chroma plane does not match the luma plane.
-    this->dataPtr->codecCtx->mb_decision = 2;
-  }
-
-  if (this->dataPtr->codecCtx->codec_id == AV_CODEC_ID_H264)
-  {
-    av_opt_set(this->dataPtr->codecCtx->priv_data, "preset", "slow", 0);
-
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-    av_opt_set(this->dataPtr->videoStream->codec->priv_data,
-        "preset", "slow", 0);
-#else
-    av_opt_set(this->dataPtr->videoStream->priv_data, "preset", "slow", 0);
-#endif
+    if (this->dataPtr->OpenCodec(candidate, _width, _height))
+    {
+      this->dataPtr->encoderName = candidate->name;
+      break;
+    }
   }
 
-  // Open the video context
-  int ret = avcodec_open2(this->dataPtr->codecCtx, encoder, 0);
-  if (ret < 0)
+  if (this->dataPtr->encoderName.empty())
   {
-    char errBuff[AV_ERROR_MAX_STRING_SIZE];
-    av_strerror(ret, errBuff, AV_ERROR_MAX_STRING_SIZE);
-
-    gzerr << "Could not open video codec: " << errBuff
-          << "Video encoding is not started\n";
+    gzerr << "Could not open a video codec. Video encoding is not started\n";
     this->Reset();
     return false;
   }
@@ -500,9 +594,112 @@ bool VideoEncoder::Start(const std::string &_format,
     return false;
   }
 
+  // Frames are encoded on a thread of their own, so AddFrame only copies
+  // them.
+  this->dataPtr->queueCapacity = this->dataPtr->queueSize;
+  if (this->dataPtr->queueCapacity > 0)
+  {
+    this->dataPtr->stopEncoding = false;
+    this->dataPtr->encodeThread =
+      std::thread(&VideoEncoderPrivate::Run, this->dataPtr.get());
+  }
+
   this->dataPtr->encoding = true;
   return true;
 }
+
+/////////////////////////////////////////////////
+bool VideoEncoderPrivate::OpenCodec(const AVCodec *_encoder,
+    const unsigned int _width, const unsigned int _height)
+{
+  // Allocate a new video context
+#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
+  this->codecCtx = this->videoStream->codec;
+#else
+  this->codecCtx = avcodec_alloc_context3(_encoder);
+#endif
+
+  if (!this->codecCtx)
+  {
+    gzerr << "Could not allocate an encoding context."
+          << "Video encoding is not started\n";
+    return false;
+  }
+
+  // some formats want stream headers to be separate
+  if (this->formatCtx->oformat->flags & AVFMT_GLOBALHEADER)
+  {
+#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
+    this->codecCtx->flags |= CODEC_FLAG_GLOBAL_HEADER;
+#else
+    this->codecCtx->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+#endif
+  }
+
+  // Frames per second
+  this->codecCtx->time_base.den = this->fps;
+  this->codecCtx->time_base.num = 1;
+
+  // The video stream must have the same time base as the context
+  this->videoStream->time_base.den = this->fps;
+  this->videoStream->time_base.num = 1;
+
+  // Bitrate
+  this->codecCtx->bit_rate = this->bitRate;
+
+  // The resolution must be divisible by two
+  this->codecCtx->width = _width % 2 == 0 ? _width : _width + 1;
+  this->codecCtx->height = _height % 2 == 0 ? _height : _height + 1;
+
+  // Emit one intra-frame every 10 frames
+  this->codecCtx->gop_size = 10;
+  this->codecCtx->max_b_frames = 1;
+  const AVPixelFormat pixFmt = EncoderPixelFormat(_encoder);
+  this->codecCtx->pix_fmt =
+    pixFmt == AV_PIX_FMT_NONE ? AV_PIX_FMT_YUV420P : pixFmt;
+  this->codecCtx->thread_count = 5;
+
+  // Set the codec id
+  this->codecCtx->codec_id = this->formatCtx->oformat->video_codec;
+
+  if (this->codecCtx->codec_id == AV_CODEC_ID_MPEG1VIDEO)
+  {
+    // Needed to avoid using macroblocks in which some coeffs overflow.
+    // This does not happen with normal video, it just happens here as
+    // the motion of the chroma plane does not match the luma plane.
+    this->codecCtx->mb_decision = 2;
+  }
+
+  if (this->codecCtx->codec_id == AV_CODEC_ID_H264)
+  {
+    av_opt_set(this->codecCtx->priv_data, "preset", "slow", 0);
+
+#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
+    av_opt_set(this->videoStream->codec->priv_data,
+        "preset", "slow", 0);
+#else
+    av_opt_set(this->videoStream->priv_data, "preset", "slow", 0);
+#endif
+  }
+
+  // Open the video context
+  int ret = avcodec_open2(this->codecCtx, _encoder, 0);
+  if (ret < 0)
+  {
+    char errBuff[AV_ERROR_MAX_STRING_SIZE];
+    av_strerror(ret, errBuff, AV_ERROR_MAX_STRING_SIZE);
+
+    gzwarn << "Could not open video codec[" << _encoder->name << "]: "
+           << errBuff << "\n";
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 24, 1)
+    avcodec_free_context(&this->codecCtx);
+#endif
+    this->codecCtx = nullptr;
+    return false;
+  }
+
+  return true;
+}
 // #else for HAVE_FFMPEG version check
 #else
 bool VideoEncoder::Start(const std::string &/*_format*/,
@@ -536,76 +733,57 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
 
 #ifdef HAVE_FFMPEG
 /////////////////////////////////////////////////
-// This function supports ffmpeg2
-bool VideoEncoder::AddFrame(const unsigned char *_frame,
-    const unsigned int _width,
-    const unsigned int _height,
-    const std::chrono::steady_clock::time_point &_timestamp)
+bool VideoEncoderPrivate::Encode(const unsigned char *_frame,
+    const unsigned int _width, const unsigned int _height)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  if (!this->dataPtr->encoding)
-  {
-    gzerr << "Start encoding before adding a frame\n";
-    return false;
-  }
-
-  auto dt = _timestamp - this->dataPtr->timePrev;
-
-  // Skip frames that arrive faster than the video's fps
-  if (dt < std::chrono::duration<double>(1.0/this->dataPtr->fps))
-    return false;
-
-  this->dataPtr->timePrev = _timestamp;
-
   // Cause the sws to be recreated on image resize
-  if (this->dataPtr->swsCtx &&
-      (this->dataPtr->inWidth != _width || this->dataPtr->inHeight != _height))
+  if (this->swsCtx &&
+      (this->inWidth != _width || this->inHeight != _height))
   {
-    sws_freeContext(this->dataPtr->swsCtx);
-    this->dataPtr->swsCtx = nullptr;
+    sws_freeContext(this->swsCtx);
+    this->swsCtx = nullptr;
 
-    if (this->dataPtr->avInFrame)
+    if (this->avInFrame)
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-      av_free(this->dataPtr->avInFrame);
+      av_free(this->avInFrame);
 #else
-      av_frame_free(&this->dataPtr->avInFrame);
+      av_frame_free(&this->avInFrame);
 #endif
-    this->dataPtr->avInFrame = nullptr;
+    this->avInFrame = nullptr;
   }
 
-  if (!this->dataPtr->swsCtx)
+  if (!this->swsCtx)
   {
-    this->dataPtr->inWidth = _width;
-    this->dataPtr->inHeight = _height;
+    this->inWidth = _width;
+    this->inHeight = _height;
 
-    if (!this->dataPtr->avInFrame)
+    if (!this->avInFrame)
     {
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-      this->dataPtr->avInFrame = new AVPicture;
-      avpicture_alloc(this->dataPtr->avInFrame,
-          AV_PIX_FMT_RGB24, this->dataPtr->inWidth,
-          this->dataPtr->inHeight);
+      this->avInFrame = new AVPicture;
+      avpicture_alloc(this->avInFrame,
+          AV_PIX_FMT_RGB24, this->inWidth,
+          this->inHeight);
 #else
-      this->dataPtr->avInFrame = av_frame_alloc();
+      this->avInFrame = av_frame_alloc();
 
-      av_image_alloc(this->dataPtr->avInFrame->data,
-          this->dataPtr->avInFrame->linesize,
-          this->dataPtr->inWidth, this->dataPtr->inHeight,
+      av_image_alloc(this->avInFrame->data,
+          this->avInFrame->linesize,
+          this->inWidth, this->inHeight,
           AV_PIX_FMT_RGB24, 1);
 #endif
     }
 
-    this->dataPtr->swsCtx = sws_getContext(
-        this->dataPtr->inWidth,
-        this->dataPtr->inHeight,
+    this->swsCtx = sws_getContext(
+        this->inWidth,
+        this->inHeight,
         AV_PIX_FMT_RGB24,
-        this->dataPtr->codecCtx->width,
-        this->dataPtr->codecCtx->height,
-        this->dataPtr->codecCtx->pix_fmt,
+        this->codecCtx->width,
+        this->codecCtx->height,
+        this->codecCtx->pix_fmt,
         SWS_BICUBIC, nullptr, nullptr, nullptr);
 
-    if (this->dataPtr->swsCtx == nullptr)
+    if (this->swsCtx == nullptr)
     {
       gzerr << "Error while calling sws_getContext\n";
       return false;
@@ -613,17 +791,17 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
   }
 
   // encode
-  memcpy(this->dataPtr->avInFrame->data[0], _frame,
-         this->dataPtr->inWidth * this->dataPtr->inHeight * 3);
+  memcpy(this->avInFrame->data[0], _frame,
+         this->inWidth * this->inHeight * 3);
 
-  sws_scale(this->dataPtr->swsCtx,
-      this->dataPtr->avInFrame->data,
-      this->dataPtr->avInFrame->linesize,
-      0, this->dataPtr->inHeight,
-      this->dataPtr->avOutFrame->data,
-      this->dataPtr->avOutFrame->linesize);
+  sws_scale(this->swsCtx,
+      this->avInFrame->data,
+      this->avInFrame->linesize,
+      0, this->inHeight,
+      this->avOutFrame->data,
+      this->avOutFrame->linesize);
 
-  this->dataPtr->avOutFrame->pts = this->dataPtr->frameCount++;
+  this->avOutFrame->pts = this->frameCount++;
 
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 40, 101)
   int gotOutput = 0;
@@ -632,31 +810,31 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
   avPacket.data = nullptr;
   avPacket.size = 0;
 
-  int ret = avcodec_encode_video2(this->dataPtr->codecCtx, &avPacket,
-      this->dataPtr->avOutFrame, &gotOutput);
+  int ret = avcodec_encode_video2(this->codecCtx, &avPacket,
+      this->avOutFrame, &gotOutput);
 
   if (ret >= 0 && gotOutput == 1)
   {
-    avPacket.stream_index = this->dataPtr->videoStream->index;
+    avPacket.stream_index = this->videoStream->index;
 
     // Scale timestamp appropriately.
     if (avPacket.pts != static_cast<int64_t>(AV_NOPTS_VALUE))
     {
       avPacket.pts = av_rescale_q(avPacket.pts,
-          this->dataPtr->codecCtx->time_base,
-          this->dataPtr->videoStream->time_base);
+          this->codecCtx->time_base,
+          this->videoStream->time_base);
     }
 
     if (avPacket.dts != static_cast<int64_t>(AV_NOPTS_VALUE))
     {
       avPacket.dts = av_rescale_q(
           avPacket.dts,
-          this->dataPtr->codecCtx->time_base,
-          this->dataPtr->videoStream->time_base);
+          this->codecCtx->time_base,
+          this->videoStream->time_base);
     }
 
     // Write frame to disk
-    ret = av_interleaved_write_frame(this->dataPtr->formatCtx, &avPacket);
+    ret = av_interleaved_write_frame(this->formatCtx, &avPacket);
 
     if (ret < 0)
     {
@@ -676,38 +854,38 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
   avPacket->data = nullptr;
   avPacket->size = 0;
 
-  int ret = avcodec_send_frame(this->dataPtr->codecCtx,
-                               this->dataPtr->avOutFrame);
+  int ret = avcodec_send_frame(this->codecCtx,
+                               this->avOutFrame);
 
   // This loop will retrieve and write available packets
   while (ret >= 0)
   {
-    ret = avcodec_receive_packet(this->dataPtr->codecCtx, avPacket);
+    ret = avcodec_receive_packet(this->codecCtx, avPacket);
 
     // Potential performance improvement: Queue the packets and write in
     // a separate thread.
     if (ret >= 0)
     {
-      avPacket->stream_index = this->dataPtr->videoStream->index;
+      avPacket->stream_index = this->videoStream->index;
 
       // Scale timestamp appropriately.
       if (avPacket->pts != static_cast<int64_t>(AV_NOPTS_VALUE))
       {
         avPacket->pts = av_rescale_q(avPacket->pts,
-            this->dataPtr->codecCtx->time_base,
-            this->dataPtr->videoStream->time_base);
+            this->codecCtx->time_base,
+            this->videoStream->time_base);
       }
 
       if (avPacket->dts != static_cast<int64_t>(AV_NOPTS_VALUE))
       {
         avPacket->dts = av_rescale_q(
             avPacket->dts,
-            this->dataPtr->codecCtx->time_base,
-            this->dataPtr->videoStream->time_base);
+            this->codecCtx->time_base,
+            this->videoStream->time_base);
       }
 
       // Write frame to disk
-      if (av_interleaved_write_frame(this->dataPtr->formatCtx, avPacket) < 0)
+      if (av_interleaved_write_frame(this->formatCtx, avPacket) < 0)
         gzerr << "Error writing frame" << std::endl;
     }
   }
@@ -716,6 +894,93 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
 #endif
   return true;
 }
+
+/////////////////////////////////////////////////
+void VideoEncoderPrivate::Run()
+{
+  common::ThreadRoles::Instance()->Apply("video_encoder");
+
+  std::unique_lock<std::mutex> lock(this->queueMutex);
+  while (true)
+  {
+    this->queueCondition.wait(lock, [this]
+        {
+          return this->stopEncoding || !this->queue.empty();
+        });
+
+    // Stop only once the queued frames are in the video.
+    if (this->queue.empty())
+      break;
+
+    Frame frame = std::move(this->queue.front());
+    this->queue.pop_front();
+
+    lock.unlock();
+    this->Encode(frame.data.data(), frame.width, frame.height);
+    lock.lock();
+
+    this->spareBuffers.push_back(std::move(frame.data));
+  }
+}
+
+/////////////////////////////////////////////////
+// This function supports ffmpeg2
+bool VideoEncoder::AddFrame(const unsigned char *_frame,
+    const unsigned int _width,
+    const unsigned int _height,
+    const std::chrono::steady_clock::time_point &_timestamp)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (!this->dataPtr->encoding)
+  {
+    gzerr << "Start encoding before adding a frame\n";
+    return false;
+  }
+
+  auto dt = _timestamp - this->dataPtr->timePrev;
+
+  // Skip frames that arrive faster than the video's fps
+  if (dt < std::chrono::duration<double>(1.0/this->dataPtr->fps))
+    return false;
+
+  this->dataPtr->timePrev = _timestamp;
+
+  // Without an encoding thread the frame is encoded right away.
+  if (this->dataPtr->queueCapacity == 0)
+    return this->dataPtr->Encode(_frame, _width, _height);
+
+  // The frame is dropped rather than waiting for the encoder, so the
+  // caller keeps its rate.
+  VideoEncoderPrivate::Frame frame;
+  {
+    std::lock_guard<std::mutex> queueLock(this->dataPtr->queueMutex);
+    if (this->dataPtr->queue.size() >= this->dataPtr->queueCapacity)
+    {
+      ++this->dataPtr->droppedFrames;
+      return false;
+    }
+
+    if (!this->dataPtr->spareBuffers.empty())
+    {
+      frame.data = std::move(this->dataPtr->spareBuffers.back());
+      this->dataPtr->spareBuffers.pop_back();
+    }
+  }
+
+  // Only this thread adds frames, so the queue has room for this one.
+  frame.data.assign(_frame, _frame + _width * _height * 3);
+  frame.width = _width;
+  frame.height = _height;
+
+  {
+    std::lock_guard<std::mutex> queueLock(this->dataPtr->queueMutex);
+    this->dataPtr->queue.push_back(std::move(frame));
+  }
+  this->dataPtr->queueCondition.notify_one();
+
+  return true;
+}
 // #else for HAVE_FFMPEG check
 #else
 bool VideoEncoder::AddFrame(const unsigned char */*_frame*/,
@@ -734,6 +999,20 @@ bool VideoEncoder::AddFrame(const unsigned char */*_frame*/,
 bool VideoEncoder::Stop()
 {
 #ifdef HAVE_FFMPEG
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Encode the queued frames before writing the trailer.
+  if (this->dataPtr->encodeThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> queueLock(this->dataPtr->queueMutex);
+      this->dataPtr->stopEncoding = true;
+    }
+    this->dataPtr->queueCondition.notify_all();
+    this->dataPtr->encodeThread.join();
+  }
+  this->dataPtr->queueCapacity = 0;
+
   if (this->dataPtr->encoding && this->dataPtr->formatCtx)
     av_write_trailer(this->dataPtr->formatCtx);
 
@@ -822,6 +1101,12 @@ void VideoEncoder::Reset()
   this->dataPtr->inWidth = 0;
   this->dataPtr->inHeight = 0;
   this->dataPtr->timePrev = {};
+  this->dataPtr->encoderName.clear();
+  {
+    std::lock_guard<std::mutex> queueLock(this->dataPtr->queueMutex);
+    this->dataPtr->droppedFrames = 0;
+    this->dataPtr->spareBuffers.clear();
+  }
   this->dataPtr->bitRate = VIDEO_ENCODER_BITRATE_DEFAULT;
   this->dataPtr->fps = VIDEO_ENCODER_FPS_DEFAULT;
   this->dataPtr->format = VIDEO_ENCODER_FORMAT_DEFAULT;
@@ -18,6 +18,7 @@
 #define GAZEBO_COMMON_VIDEOENCODER_HH_
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <gazebo/util/system.hh>
@@ -43,6 +44,11 @@ namespace gazebo
     /// \class VideoEncoder VideoEncoder.hh common/common.hh
     /// \brief The VideoEncoder class supports encoding a series of images
     /// to a video format, and then writing the video to disk.
+    ///
+    /// Frames are encoded on a thread of their own, named after the
+    /// video_encoder role of common::ThreadRoles. AddFrame copies the frame
+    /// into a bounded queue and returns, and drops the frame if the queue is
+    /// full.
     class GZ_COMMON_VISIBLE VideoEncoder
     {
       /// \brief Constructor
@@ -89,7 +95,8 @@ namespace gazebo
       /// \param[in] _frame Image buffer to be encoded
       /// \param[in] _width Input frame width
       /// \param[in] _height Input frame height
-      /// \return True on success
+      /// \return True on success, false if the frame was skipped to keep
+      /// the video's fps or dropped because the queue was full.
       public: bool AddFrame(const unsigned char *_frame,
                             const unsigned int _width,
                             const unsigned int _height);
@@ -99,7 +106,8 @@ namespace gazebo
       /// \param[in] _width Input frame width
       /// \param[in] _height Input frame height
       /// \param[in] _timestamp Timestamp of the image frame
-      /// \return True on success.
+      /// \return True on success, false if the frame was skipped to keep
+      /// the video's fps or dropped because the queue was full.
       public: bool AddFrame(const unsigned char *_frame,
                   const unsigned int _width,
                   const unsigned int _height,
@@ -118,6 +126,36 @@ namespace gazebo
       /// \return Bit rate
       public: unsigned int BitRate() const;
 
+      /// \brief Set the number of frames that may wait for the encoding
+      /// thread. Takes effect at the next Start.
+      /// \param[in] _size Number of frames, 4 by default. With 0, frames are
+      /// encoded by AddFrame on the calling thread.
+      public: void SetQueueSize(const unsigned int _size);
+
+      /// \brief Get the number of frames that may wait for the encoding
+      /// thread.
+      /// \return Number of frames.
+      public: unsigned int QueueSize() const;
+
+      /// \brief Get the number of frames dropped because the queue was
+      /// full, since the last Start.
+      /// \return Number of frames.
+      public: uint64_t DroppedFrameCount() const;
+
+      /// \brief Set whether to try the hardware encoders of the format's
+      /// codec, such as h264_nvenc or h264_qsv, before its software
+      /// encoder. Takes effect at the next Start.
+      /// \param[in] _enable True to try the hardware encoders.
+      public: void SetHardwareEncoding(const bool _enable);
+
+      /// \brief Get whether the hardware encoders are tried.
+      /// \return True if the hardware encoders are tried.
+      public: bool HardwareEncoding() const;
+
+      /// \brief Get the name of the libav encoder of the current video.
+      /// \return Encoder name, empty if not started.
+      public: std::string EncoderName() const;
+
       /// \brief Reset to default video properties and clean up allocated
       /// memory. This will also delete any temporary files.
       public: void Reset();
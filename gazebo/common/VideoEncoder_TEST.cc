@@ -15,6 +15,9 @@
 */
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <vector>
+
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/VideoEncoder.hh"
 #include "test/util.hh"
@@ -75,3 +78,56 @@ TEST_F(VideoEncoderTest, Exists)
   EXPECT_FALSE(common::exists(common::cwd() + "/TMP_RECORDING.mp4"));
 #endif
 }
+
+/////////////////////////////////////////////////
+TEST_F(VideoEncoderTest, Queue)
+{
+  VideoEncoder video;
+  EXPECT_EQ(video.QueueSize(), 4u);
+  EXPECT_FALSE(video.HardwareEncoding());
+  EXPECT_EQ(video.DroppedFrameCount(), 0u);
+  EXPECT_TRUE(video.EncoderName().empty());
+
+#ifdef HAVE_FFMPEG
+  const unsigned int width = 640;
+  const unsigned int height = 480;
+  std::vector<unsigned char> frame(width * height * 3, 128);
+
+  // Frames added faster than they are encoded are dropped, not waited for.
+  video.SetQueueSize(1);
+  ASSERT_TRUE(video.Start("mp4", "", width, height, 1000));
+  EXPECT_FALSE(video.EncoderName().empty());
+
+  auto stamp = std::chrono::steady_clock::now();
+  unsigned int added = 0;
+  for (int i = 0; i < 50; ++i)
+  {
+    stamp += std::chrono::milliseconds(2);
+    if (video.AddFrame(frame.data(), width, height, stamp))
+      ++added;
+  }
+  EXPECT_GT(added, 0u);
+  EXPECT_EQ(added + video.DroppedFrameCount(), 50u);
+
+  // Stop encodes the queued frames.
+  EXPECT_TRUE(video.Stop());
+  EXPECT_FALSE(video.IsEncoding());
+
+  // Without a queue, frames are encoded by AddFrame and never dropped.
+  video.SetQueueSize(0);
+  ASSERT_TRUE(video.Start("mp4", "", width, height, 1000));
+  for (int i = 0; i < 10; ++i)
+  {
+    stamp += std::chrono::milliseconds(2);
+    EXPECT_TRUE(video.AddFrame(frame.data(), width, height, stamp));
+  }
+  EXPECT_EQ(video.DroppedFrameCount(), 0u);
+  video.Reset();
+
+  // Without a hardware encoder, the software encoder is used.
+  video.SetHardwareEncoding(true);
+  EXPECT_TRUE(video.Start("mp4", "", width, height));
+  EXPECT_TRUE(video.IsEncoding());
+  video.Reset();
+#endif
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright 2016 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cstring>
+#include <mutex>
+
+#include <gazebo/gazebo_config.h>
+
+#include "gazebo/common/ffmpeg_inc.h"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/VideoStreamDecoder.hh"
+
+// The send/receive API matches the one of VideoStreamEncoder.
+#if defined(HAVE_FFMPEG) && \
+    LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 64, 101)
+#define GZ_VIDEO_STREAM 1
+#endif
+
+using namespace gazebo;
+using namespace common;
+
+// Private data class
+class gazebo::common::VideoStreamDecoderPrivate
+{
+#ifdef GZ_VIDEO_STREAM
+  /// \brief Free the decoder.
+  public: void Close()
+  {
+    if (this->codecCtx)
+      avcodec_free_context(&this->codecCtx);
+    if (this->frame)
+      av_frame_free(&this->frame);
+    if (this->packet)
+      av_packet_free(&this->packet);
+    if (this->swsCtx)
+    {
+      sws_freeContext(this->swsCtx);
+      this->swsCtx = nullptr;
+    }
+  }
+
+  /// \brief Decoder context.
+  public: AVCodecContext *codecCtx = nullptr;
+
+  /// \brief Decoded frame.
+  public: AVFrame *frame = nullptr;
+
+  /// \brief Packet to decode.
+  public: AVPacket *packet = nullptr;
+
+  /// \brief Converts decoded frames to RGB.
+  public: SwsContext *swsCtx = nullptr;
+
+  /// \brief Copy of the packet to decode, padded as libavcodec expects.
+  public: std::vector<uint8_t> buffer;
+#endif
+
+  /// \brief Format given to Start.
+  public: std::string format;
+
+  /// \brief Protects the decoder.
+  public: mutable std::mutex mutex;
+};
+
+/////////////////////////////////////////////////
+VideoStreamDecoder::VideoStreamDecoder()
+  : dataPtr(new VideoStreamDecoderPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+VideoStreamDecoder::~VideoStreamDecoder()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+bool VideoStreamDecoder::Start(const std::string &_format)
+{
+#ifdef GZ_VIDEO_STREAM
+  this->Stop();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  AVCodecID codecId;
+  if (_format == "h264")
+    codecId = AV_CODEC_ID_H264;
+  else if (_format == "h265")
+    codecId = AV_CODEC_ID_HEVC;
+  else if (_format == "jpeg")
+    codecId = AV_CODEC_ID_MJPEG;
+  else
+  {
+    gzerr << "Unknown video stream format [" << _format
+          << "], use h264, h265 or jpeg\n";
+    return false;
+  }
+
+  const AVCodec *codec = avcodec_find_decoder(codecId);
+  if (!codec)
+  {
+    gzerr << "Unable to find a " << _format << " decoder\n";
+    return false;
+  }
+
+  this->dataPtr->codecCtx = avcodec_alloc_context3(codec);
+  // Frame threads would delay the output by one frame per thread.
+  this->dataPtr->codecCtx->thread_type = FF_THREAD_SLICE;
+  this->dataPtr->codecCtx->flags |= AV_CODEC_FLAG_LOW_DELAY;
+  if (avcodec_open2(this->dataPtr->codecCtx, codec, nullptr) < 0)
+  {
+    gzerr << "Unable to open the " << _format << " decoder\n";
+    this->dataPtr->Close();
+    return false;
+  }
+
+  this->dataPtr->frame = AVFrameAlloc();
+  this->dataPtr->packet = av_packet_alloc();
+  this->dataPtr->format = _format;
+  return true;
+#else
+  gzwarn << "Video streaming needs FFMPEG with libavcodec 57.64.101 or "
+         << "newer, unable to decode [" << _format << "] video\n";
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+void VideoStreamDecoder::Stop()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+#ifdef GZ_VIDEO_STREAM
+  this->dataPtr->Close();
+#endif
+}
+
+/////////////////////////////////////////////////
+bool VideoStreamDecoder::IsDecoding() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+#ifdef GZ_VIDEO_STREAM
+  return this->dataPtr->codecCtx != nullptr;
+#else
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool VideoStreamDecoder::Decode(const std::string &_packet,
+    std::vector<unsigned char> &_frame,
+    unsigned int &_width, unsigned int &_height)
+{
+#ifdef GZ_VIDEO_STREAM
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (!this->dataPtr->codecCtx)
+  {
+    gzerr << "Start the video stream decoder before decoding a frame\n";
+    return false;
+  }
+
+  if (_packet.empty())
+    return false;
+
+  this->dataPtr->buffer.assign(
+      _packet.size() + AV_INPUT_BUFFER_PADDING_SIZE, 0);
+  std::memcpy(this->dataPtr->buffer.data(), _packet.data(), _packet.size());
+
+  AVPacket *packet = this->dataPtr->packet;
+  packet->data = this->dataPtr->buffer.data();
+  packet->size = static_cast<int>(_packet.size());
+
+  // Frames that depend on a frame that was not received are rejected,
+  // which is expected until the first key frame arrives.
+  if (avcodec_send_packet(this->dataPtr->codecCtx, packet) < 0)
+    return false;
+
+  bool decoded = false;
+  AVFrame *frame = this->dataPtr->frame;
+  while (avcodec_receive_frame(this->dataPtr->codecCtx, frame) == 0)
+  {
+    this->dataPtr->swsCtx = sws_getCachedContext(this->dataPtr->swsCtx,
+        frame->width, frame->height,
+        static_cast<AVPixelFormat>(frame->format),
+        frame->width, frame->height, AV_PIX_FMT_RGB24,
+        SWS_BICUBIC, nullptr, nullptr, nullptr);
+    if (!this->dataPtr->swsCtx)
+    {
+      AVFrameUnref(frame);
+      continue;
+    }
+
+    _width = frame->width;
+    _height = frame->height;
+    _frame.resize(_width * _height * 3);
+    uint8_t *dstData[1] = {_frame.data()};
+    const int dstStride[1] = {static_cast<int>(_width * 3)};
+    sws_scale(this->dataPtr->swsCtx, frame->data, frame->linesize, 0,
+        frame->height, dstData, dstStride);
+    AVFrameUnref(frame);
+    decoded = true;
+  }
+
+  return decoded;
+#else
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+std::string VideoStreamDecoder::Format() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->format;
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_VIDEOSTREAMDECODER_HH_
+#define GAZEBO_COMMON_VIDEOSTREAMDECODER_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class VideoStreamDecoderPrivate;
+
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class VideoStreamDecoder VideoStreamDecoder.hh common/common.hh
+    /// \brief Decompresses the frames of a VideoStreamEncoder, for example
+    /// the frames of a compressed camera topic, back to RGB.
+    class GZ_COMMON_VISIBLE VideoStreamDecoder
+    {
+      /// \brief Constructor
+      public: VideoStreamDecoder();
+
+      /// \brief Destructor
+      public: virtual ~VideoStreamDecoder();
+
+      /// \brief Start the decoder.
+      /// \param[in] _format "h264", "h265" or "jpeg".
+      /// \return True on success.
+      public: bool Start(const std::string &_format);
+
+      /// \brief Stop the decoder.
+      public: void Stop();
+
+      /// \brief True if the decoder has been started.
+      /// \return True if Start succeeded and Stop was not called.
+      public: bool IsDecoding() const;
+
+      /// \brief Decode a frame. Video frames must be given in order. Frames
+      /// received before the first key frame are dropped.
+      /// \param[in] _packet The compressed frame.
+      /// \param[out] _frame The RGB frame, 3 bytes per pixel.
+      /// \param[out] _width Width of the frame.
+      /// \param[out] _height Height of the frame.
+      /// \return True if a frame was decoded.
+      public: bool Decode(const std::string &_packet,
+                  std::vector<unsigned char> &_frame,
+                  unsigned int &_width, unsigned int &_height);
+
+      /// \brief Get the format given to Start.
+      /// \return "h264", "h265" or "jpeg".
+      public: std::string Format() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<VideoStreamDecoderPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
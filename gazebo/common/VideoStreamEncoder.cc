@@ -0,0 +1,464 @@
+/*
+ * Copyright 2016 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include <gazebo/gazebo_config.h>
+
+#include "gazebo/common/ffmpeg_inc.h"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/VideoStreamEncoder.hh"
+
+// The send/receive API is needed to encode one frame at a time.
+#if defined(HAVE_FFMPEG) && \
+    LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 64, 101)
+#define GZ_VIDEO_STREAM 1
+extern "C" {
+#include <libavutil/hwcontext.h>
+}
+#endif
+
+using namespace gazebo;
+using namespace common;
+
+// Private data class
+class gazebo::common::VideoStreamEncoderPrivate
+{
+#ifdef GZ_VIDEO_STREAM
+  /// \brief Open an encoder.
+  /// \param[in] _codec Encoder to open.
+  /// \param[in] _fps Frame rate of the stream.
+  /// \return True on success.
+  public: bool Open(const AVCodec *_codec, const unsigned int _fps);
+
+  /// \brief Free the encoder.
+  public: void Close();
+
+  /// \brief Encoder context.
+  public: AVCodecContext *codecCtx = nullptr;
+
+  /// \brief Frame in the pixel format of the encoder.
+  public: AVFrame *frame = nullptr;
+
+  /// \brief Hardware frame, used by VAAPI encoders.
+  public: AVFrame *hwFrame = nullptr;
+
+  /// \brief Hardware device, used by VAAPI encoders.
+  public: AVBufferRef *hwDevice = nullptr;
+
+  /// \brief Encoded packet.
+  public: AVPacket *packet = nullptr;
+
+  /// \brief Converts RGB frames to the pixel format of the encoder.
+  public: SwsContext *swsCtx = nullptr;
+
+  /// \brief Presentation time stamp of the next frame.
+  public: int64_t pts = 0;
+#endif
+
+  /// \brief Format given to Start.
+  public: std::string format;
+
+  /// \brief Name of the encoder in use.
+  public: std::string encoderName;
+
+  /// \brief Width of the stream.
+  public: unsigned int width = 0;
+
+  /// \brief Height of the stream.
+  public: unsigned int height = 0;
+
+  /// \brief Bit rate of the stream.
+  public: unsigned int bitRate = 0;
+
+  /// \brief Number of frames between two key frames.
+  public: unsigned int gop = 30;
+
+  /// \brief True to make the next frame a key frame.
+  public: bool keyFrameRequested = false;
+
+  /// \brief Protects the encoder.
+  public: mutable std::mutex mutex;
+};
+
+#ifdef GZ_VIDEO_STREAM
+/////////////////////////////////////////////////
+bool VideoStreamEncoderPrivate::Open(const AVCodec *_codec,
+    const unsigned int _fps)
+{
+  const std::string name = _codec->name;
+  const bool vaapi = name.find("_vaapi") != std::string::npos;
+
+  this->codecCtx = avcodec_alloc_context3(_codec);
+  if (!this->codecCtx)
+    return false;
+
+  this->codecCtx->width = this->width;
+  this->codecCtx->height = this->height;
+  this->codecCtx->time_base = {1, static_cast<int>(_fps)};
+  this->codecCtx->framerate = {static_cast<int>(_fps), 1};
+  this->codecCtx->bit_rate = this->bitRate;
+  this->codecCtx->gop_size = this->format == "jpeg" ? 0 : this->gop;
+  // B-frames would hold frames back
+  this->codecCtx->max_b_frames = 0;
+  this->codecCtx->pix_fmt = this->format == "jpeg" ?
+      AV_PIX_FMT_YUVJ420P : AV_PIX_FMT_YUV420P;
+  // AV_CODEC_FLAG_GLOBAL_HEADER is not set, so that the parameter sets are
+  // repeated with every key frame, and subscribers can join at any time.
+
+  AVPixelFormat swFormat = this->codecCtx->pix_fmt;
+  if (vaapi)
+  {
+    if (av_hwdevice_ctx_create(&this->hwDevice, AV_HWDEVICE_TYPE_VAAPI,
+          nullptr, nullptr, 0) < 0)
+    {
+      this->Close();
+      return false;
+    }
+
+    AVBufferRef *framesRef = av_hwframe_ctx_alloc(this->hwDevice);
+    if (!framesRef)
+    {
+      this->Close();
+      return false;
+    }
+    auto framesCtx = reinterpret_cast<AVHWFramesContext *>(framesRef->data);
+    framesCtx->format = AV_PIX_FMT_VAAPI;
+    framesCtx->sw_format = AV_PIX_FMT_NV12;
+    framesCtx->width = this->width;
+    framesCtx->height = this->height;
+    framesCtx->initial_pool_size = 4;
+    if (av_hwframe_ctx_init(framesRef) < 0)
+    {
+      av_buffer_unref(&framesRef);
+      this->Close();
+      return false;
+    }
+    this->codecCtx->hw_frames_ctx = av_buffer_ref(framesRef);
+    av_buffer_unref(&framesRef);
+
+    this->codecCtx->pix_fmt = AV_PIX_FMT_VAAPI;
+    swFormat = AV_PIX_FMT_NV12;
+  }
+
+  // Low latency settings. Options that an encoder does not have are
+  // ignored.
+  if (name == "libx264" || name == "libx265")
+  {
+    av_opt_set(this->codecCtx->priv_data, "preset", "veryfast", 0);
+    av_opt_set(this->codecCtx->priv_data, "tune", "zerolatency", 0);
+  }
+  else if (name.find("_nvenc") != std::string::npos)
+  {
+    av_opt_set(this->codecCtx->priv_data, "zerolatency", "1", 0);
+  }
+  av_opt_set(this->codecCtx->priv_data, "forced-idr", "1", 0);
+
+  if (avcodec_open2(this->codecCtx, _codec, nullptr) < 0)
+  {
+    this->Close();
+    return false;
+  }
+
+  this->frame = AVFrameAlloc();
+  this->frame->format = swFormat;
+  this->frame->width = this->width;
+  this->frame->height = this->height;
+  if (av_frame_get_buffer(this->frame, 0) < 0)
+  {
+    this->Close();
+    return false;
+  }
+
+  if (vaapi)
+    this->hwFrame = AVFrameAlloc();
+
+  this->packet = av_packet_alloc();
+  this->pts = 0;
+  this->encoderName = name;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void VideoStreamEncoderPrivate::Close()
+{
+  if (this->codecCtx)
+    avcodec_free_context(&this->codecCtx);
+  if (this->frame)
+    av_frame_free(&this->frame);
+  if (this->hwFrame)
+    av_frame_free(&this->hwFrame);
+  if (this->hwDevice)
+    av_buffer_unref(&this->hwDevice);
+  if (this->packet)
+    av_packet_free(&this->packet);
+  if (this->swsCtx)
+  {
+    sws_freeContext(this->swsCtx);
+    this->swsCtx = nullptr;
+  }
+  this->encoderName.clear();
+}
+#endif
+
+/////////////////////////////////////////////////
+VideoStreamEncoder::VideoStreamEncoder()
+  : dataPtr(new VideoStreamEncoderPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+VideoStreamEncoder::~VideoStreamEncoder()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+bool VideoStreamEncoder::Start(const std::string &_format,
+    const unsigned int _width, const unsigned int _height,
+    const unsigned int _fps, const unsigned int _bitRate,
+    const unsigned int _gop)
+{
+#ifdef GZ_VIDEO_STREAM
+  this->Stop();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Hardware encoders first, then the software encoders.
+  std::vector<std::string> names;
+  AVCodecID codecId;
+  if (_format == "h264")
+  {
+    names = {"h264_nvenc", "h264_vaapi", "libx264"};
+    codecId = AV_CODEC_ID_H264;
+  }
+  else if (_format == "h265")
+  {
+    names = {"hevc_nvenc", "hevc_vaapi", "libx265"};
+    codecId = AV_CODEC_ID_HEVC;
+  }
+  else if (_format == "jpeg")
+  {
+    names = {"mjpeg"};
+    codecId = AV_CODEC_ID_MJPEG;
+  }
+  else
+  {
+    gzerr << "Unknown video stream format [" << _format
+          << "], use h264, h265 or jpeg\n";
+    return false;
+  }
+
+  if (_width == 0 || _height == 0 || _fps == 0)
+  {
+    gzerr << "Invalid video stream size [" << _width << "x" << _height
+          << "] or frame rate [" << _fps << "]\n";
+    return false;
+  }
+
+  this->dataPtr->format = _format;
+  // Most encoders need an even size
+  this->dataPtr->width = _width - _width % 2;
+  this->dataPtr->height = _height - _height % 2;
+  this->dataPtr->gop = std::max(_gop, 1u);
+
+  // Calculate a good bitrate if the _bitRate argument is zero
+  const unsigned int pixels = this->dataPtr->width * this->dataPtr->height;
+  if (_bitRate != 0)
+    this->dataPtr->bitRate = _bitRate;
+  // 240p
+  else if (pixels <= 424*240)
+    this->dataPtr->bitRate = 100000;
+  // 360p
+  else if (pixels <= 640*360)
+    this->dataPtr->bitRate = 230000;
+  // 432p
+  else if (pixels <= 768*432)
+    this->dataPtr->bitRate = 330000;
+  // 480p (SD or NTSC widescreen)
+  else if (pixels <= 848*480)
+    this->dataPtr->bitRate = 410000;
+  // 576p (PAL widescreen)
+  else if (pixels <= 1024*576)
+    this->dataPtr->bitRate = 590000;
+  // 720p (HD)
+  else if (pixels <= 1280*720)
+    this->dataPtr->bitRate = 920000;
+  // >720P(Full HD)
+  else
+    this->dataPtr->bitRate = 2070000;
+
+  std::vector<const AVCodec *> codecs;
+  for (const auto &name : names)
+  {
+    const AVCodec *codec = avcodec_find_encoder_by_name(name.c_str());
+    if (codec)
+      codecs.push_back(codec);
+  }
+  const AVCodec *defaultCodec = avcodec_find_encoder(codecId);
+  if (defaultCodec)
+    codecs.push_back(defaultCodec);
+
+  for (const auto codec : codecs)
+  {
+    if (this->dataPtr->Open(codec, _fps))
+    {
+      gzmsg << "Streaming " << _format << " video with encoder ["
+            << this->dataPtr->encoderName << "]\n";
+      this->dataPtr->keyFrameRequested = false;
+      return true;
+    }
+  }
+
+  gzerr << "Unable to open a " << _format << " encoder\n";
+  return false;
+#else
+  gzwarn << "Video streaming needs FFMPEG with libavcodec 57.64.101 or "
+         << "newer, unable to stream [" << _format << "] video of size ["
+         << _width << "x" << _height << "], fps [" << _fps
+         << "], bit rate [" << _bitRate << "] and gop [" << _gop << "]\n";
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+void VideoStreamEncoder::Stop()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+#ifdef GZ_VIDEO_STREAM
+  this->dataPtr->Close();
+#endif
+}
+
+/////////////////////////////////////////////////
+bool VideoStreamEncoder::IsEncoding() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return !this->dataPtr->encoderName.empty();
+}
+
+/////////////////////////////////////////////////
+bool VideoStreamEncoder::Encode(const unsigned char *_frame,
+    const unsigned int _width, const unsigned int _height,
+    std::string &_packet, bool &_keyFrame)
+{
+  _packet.clear();
+  _keyFrame = false;
+
+#ifdef GZ_VIDEO_STREAM
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (!this->dataPtr->codecCtx)
+  {
+    gzerr << "Start the video stream encoder before encoding a frame\n";
+    return false;
+  }
+
+  if (!_frame || _width == 0 || _height == 0)
+    return false;
+
+  AVFrame *frame = this->dataPtr->frame;
+  this->dataPtr->swsCtx = sws_getCachedContext(this->dataPtr->swsCtx,
+      _width, _height, AV_PIX_FMT_RGB24,
+      frame->width, frame->height, static_cast<AVPixelFormat>(frame->format),
+      SWS_BICUBIC, nullptr, nullptr, nullptr);
+  if (!this->dataPtr->swsCtx || av_frame_make_writable(frame) < 0)
+  {
+    gzerr << "Unable to convert a frame for the video stream encoder\n";
+    return false;
+  }
+
+  const uint8_t *srcData[1] = {_frame};
+  const int srcStride[1] = {static_cast<int>(_width * 3)};
+  sws_scale(this->dataPtr->swsCtx, srcData, srcStride, 0, _height,
+      frame->data, frame->linesize);
+
+  AVFrame *input = frame;
+  if (this->dataPtr->hwFrame)
+  {
+    input = this->dataPtr->hwFrame;
+    av_frame_unref(input);
+    if (av_hwframe_get_buffer(this->dataPtr->codecCtx->hw_frames_ctx,
+          input, 0) < 0 || av_hwframe_transfer_data(input, frame, 0) < 0)
+    {
+      gzerr << "Unable to upload a frame to the video stream encoder\n";
+      return false;
+    }
+  }
+
+  input->pts = this->dataPtr->pts++;
+  input->pict_type = this->dataPtr->keyFrameRequested ?
+      AV_PICTURE_TYPE_I : AV_PICTURE_TYPE_NONE;
+  this->dataPtr->keyFrameRequested = false;
+
+  if (avcodec_send_frame(this->dataPtr->codecCtx, input) < 0)
+  {
+    gzerr << "Unable to encode a frame of the video stream\n";
+    return false;
+  }
+
+  AVPacket *packet = this->dataPtr->packet;
+  while (avcodec_receive_packet(this->dataPtr->codecCtx, packet) == 0)
+  {
+    _packet.append(reinterpret_cast<const char *>(packet->data),
+        packet->size);
+    if (packet->flags & AV_PKT_FLAG_KEY)
+      _keyFrame = true;
+    av_packet_unref(packet);
+  }
+
+  return !_packet.empty();
+#else
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+void VideoStreamEncoder::RequestKeyFrame()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->keyFrameRequested = true;
+}
+
+/////////////////////////////////////////////////
+std::string VideoStreamEncoder::Format() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->format;
+}
+
+/////////////////////////////////////////////////
+std::string VideoStreamEncoder::EncoderName() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->encoderName;
+}
+
+/////////////////////////////////////////////////
+unsigned int VideoStreamEncoder::BitRate() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->bitRate;
+}
+
+/////////////////////////////////////////////////
+unsigned int VideoStreamEncoder::Gop() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->gop;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_VIDEOSTREAMENCODER_HH_
+#define GAZEBO_COMMON_VIDEOSTREAMENCODER_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class VideoStreamEncoderPrivate;
+
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class VideoStreamEncoder VideoStreamEncoder.hh common/common.hh
+    /// \brief Compresses RGB frames one at a time, for streaming. Unlike
+    /// VideoEncoder, nothing is written to disk: each call to Encode returns
+    /// the compressed frame, which can be sent to a VideoStreamDecoder.
+    ///
+    /// Video formats use a hardware encoder when one is available (NVENC,
+    /// then VAAPI), and fall back to the libavcodec software encoders.
+    /// Frames are encoded without delay: there are no B-frames, and every
+    /// frame produces one packet.
+    class GZ_COMMON_VISIBLE VideoStreamEncoder
+    {
+      /// \brief Constructor
+      public: VideoStreamEncoder();
+
+      /// \brief Destructor
+      public: virtual ~VideoStreamEncoder();
+
+      /// \brief Start the encoder.
+      /// \param[in] _format "h264", "h265", or "jpeg" to compress each
+      /// frame on its own.
+      /// \param[in] _width Width in pixels of the frames.
+      /// \param[in] _height Height in pixels of the frames.
+      /// \param[in] _fps Frame rate of the stream.
+      /// \param[in] _bitRate Bit rate of the stream. Zero computes a bit
+      /// rate from the resolution.
+      /// \param[in] _gop Number of frames between two key frames. Ignored
+      /// by "jpeg", where every frame is a key frame.
+      /// \return True on success.
+      public: bool Start(const std::string &_format,
+                  const unsigned int _width, const unsigned int _height,
+                  const unsigned int _fps = 30,
+                  const unsigned int _bitRate = 0,
+                  const unsigned int _gop = 30);
+
+      /// \brief Stop the encoder.
+      public: void Stop();
+
+      /// \brief True if the encoder has been started.
+      /// \return True if Start succeeded and Stop was not called.
+      public: bool IsEncoding() const;
+
+      /// \brief Compress a frame.
+      /// \param[in] _frame RGB frame, 3 bytes per pixel.
+      /// \param[in] _width Width of the frame, it is scaled if it differs
+      /// from the width given to Start.
+      /// \param[in] _height Height of the frame.
+      /// \param[out] _packet The compressed frame.
+      /// \param[out] _keyFrame True if the frame can be decoded on its own.
+      /// \return True if a packet was produced.
+      public: bool Encode(const unsigned char *_frame,
+                  const unsigned int _width, const unsigned int _height,
+                  std::string &_packet, bool &_keyFrame);
+
+      /// \brief Make the next frame a key frame, for example when a new
+      /// subscriber joins the stream.
+      public: void RequestKeyFrame();
+
+      /// \brief Get the format given to Start.
+      /// \return "h264", "h265" or "jpeg".
+      public: std::string Format() const;
+
+      /// \brief Get the name of the libavcodec encoder in use, for example
+      /// "h264_nvenc" or "libx264".
+      /// \return Encoder name, empty if not encoding.
+      public: std::string EncoderName() const;
+
+      /// \brief Get the bit rate.
+      /// \return Bit rate of the stream.
+      public: unsigned int BitRate() const;
+
+      /// \brief Get the number of frames between two key frames.
+      /// \return Group of pictures size.
+      public: unsigned int Gop() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<VideoStreamEncoderPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
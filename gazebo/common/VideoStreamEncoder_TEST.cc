@@ -0,0 +1,184 @@
+/*
+ * Copyright 2016 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/VideoStreamDecoder.hh"
+#include "gazebo/common/VideoStreamEncoder.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+using namespace common;
+
+class VideoStreamEncoderTest : public gazebo::testing::AutoLogFixture { };
+
+/// \brief Fill an RGB frame with a gradient that moves with _offset.
+/// \param[in] _width Width of the frame.
+/// \param[in] _height Height of the frame.
+/// \param[in] _offset Shift of the gradient.
+/// \return The frame.
+static std::vector<unsigned char> Gradient(const unsigned int _width,
+    const unsigned int _height, const unsigned int _offset)
+{
+  std::vector<unsigned char> frame(_width * _height * 3);
+  for (unsigned int y = 0; y < _height; ++y)
+  {
+    for (unsigned int x = 0; x < _width; ++x)
+    {
+      unsigned char *pixel = &frame[(y * _width + x) * 3];
+      pixel[0] = static_cast<unsigned char>((x + _offset) * 255 / _width);
+      pixel[1] = static_cast<unsigned char>(y * 255 / _height);
+      pixel[2] = 128;
+    }
+  }
+  return frame;
+}
+
+/// \brief Mean absolute difference between two frames.
+/// \param[in] _a First frame.
+/// \param[in] _b Second frame.
+/// \return Mean difference per channel.
+static double Difference(const std::vector<unsigned char> &_a,
+    const std::vector<unsigned char> &_b)
+{
+  double sum = 0;
+  for (size_t i = 0; i < _a.size() && i < _b.size(); ++i)
+    sum += std::abs(static_cast<int>(_a[i]) - static_cast<int>(_b[i]));
+  return sum / std::max<size_t>(_a.size(), 1);
+}
+
+/////////////////////////////////////////////////
+TEST_F(VideoStreamEncoderTest, StartStop)
+{
+  VideoStreamEncoder encoder;
+  EXPECT_FALSE(encoder.IsEncoding());
+  EXPECT_TRUE(encoder.EncoderName().empty());
+
+  EXPECT_FALSE(encoder.Start("bogus", 64, 48));
+  EXPECT_FALSE(encoder.Start("jpeg", 0, 48));
+  EXPECT_FALSE(encoder.IsEncoding());
+
+  std::string packet;
+  bool keyFrame = true;
+  std::vector<unsigned char> frame = Gradient(64, 48, 0);
+  EXPECT_FALSE(encoder.Encode(frame.data(), 64, 48, packet, keyFrame));
+  EXPECT_TRUE(packet.empty());
+  EXPECT_FALSE(keyFrame);
+
+  ASSERT_TRUE(encoder.Start("jpeg", 64, 48));
+  EXPECT_TRUE(encoder.IsEncoding());
+  EXPECT_EQ(encoder.Format(), "jpeg");
+  EXPECT_FALSE(encoder.EncoderName().empty());
+  EXPECT_EQ(encoder.BitRate(), 100000u);
+
+  encoder.Stop();
+  EXPECT_FALSE(encoder.IsEncoding());
+}
+
+/////////////////////////////////////////////////
+TEST_F(VideoStreamEncoderTest, Jpeg)
+{
+  const unsigned int width = 64;
+  const unsigned int height = 48;
+
+  VideoStreamEncoder encoder;
+  ASSERT_TRUE(encoder.Start("jpeg", width, height));
+  VideoStreamDecoder decoder;
+  ASSERT_TRUE(decoder.Start("jpeg"));
+  EXPECT_TRUE(decoder.IsDecoding());
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    std::vector<unsigned char> frame = Gradient(width, height, i);
+    std::string packet;
+    bool keyFrame = false;
+    ASSERT_TRUE(encoder.Encode(frame.data(), width, height, packet,
+          keyFrame));
+    EXPECT_TRUE(keyFrame);
+    EXPECT_LT(packet.size(), frame.size());
+
+    std::vector<unsigned char> decoded;
+    unsigned int decodedWidth = 0;
+    unsigned int decodedHeight = 0;
+    ASSERT_TRUE(decoder.Decode(packet, decoded, decodedWidth,
+          decodedHeight));
+    EXPECT_EQ(decodedWidth, width);
+    EXPECT_EQ(decodedHeight, height);
+    EXPECT_LT(Difference(frame, decoded), 10.0);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(VideoStreamEncoderTest, H264)
+{
+  const unsigned int width = 320;
+  const unsigned int height = 240;
+
+  VideoStreamEncoder encoder;
+  if (!encoder.Start("h264", width, height, 30, 0, 10))
+  {
+    gzwarn << "No h264 encoder, skipping test\n";
+    return;
+  }
+  EXPECT_EQ(encoder.Gop(), 10u);
+
+  VideoStreamDecoder decoder;
+  ASSERT_TRUE(decoder.Start("h264"));
+
+  unsigned int keyFrames = 0;
+  unsigned int decodedFrames = 0;
+  std::vector<unsigned char> frame;
+  std::vector<unsigned char> decoded;
+  for (unsigned int i = 0; i < 25; ++i)
+  {
+    // A new subscriber
+    if (i == 15)
+      encoder.RequestKeyFrame();
+
+    frame = Gradient(width, height, i);
+    std::string packet;
+    bool keyFrame = false;
+    ASSERT_TRUE(encoder.Encode(frame.data(), width, height, packet,
+          keyFrame));
+    if (i == 0 || i == 15)
+      EXPECT_TRUE(keyFrame);
+    if (keyFrame)
+      ++keyFrames;
+
+    unsigned int decodedWidth = 0;
+    unsigned int decodedHeight = 0;
+    if (decoder.Decode(packet, decoded, decodedWidth, decodedHeight))
+    {
+      ++decodedFrames;
+      EXPECT_EQ(decodedWidth, width);
+      EXPECT_EQ(decodedHeight, height);
+    }
+  }
+
+  // Key frames at 0, 10, 15 and 20 at most, the gop may restart at 15
+  EXPECT_GE(keyFrames, 3u);
+  EXPECT_LE(keyFrames, 4u);
+  // Every frame is decoded as soon as it arrives
+  EXPECT_EQ(decodedFrames, 25u);
+  EXPECT_LT(Difference(frame, decoded), 20.0);
+}
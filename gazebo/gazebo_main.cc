@@ -50,7 +50,7 @@ void help()
   << "  -r [ --record ]               Record state data.\n"
   << "  --record_encoding arg (=zlib) Compression encoding format for log "
   << "data \n"
-  << "                                (zlib|bz2|txt).\n"
+  << "                                (zlib|bz2|txt|bin).\n"
   << "  --record_path arg             Absolute path in which to store "
   << "state data.\n"
   << "  --record_period arg (=-1)     Recording period (seconds).\n"
@@ -58,6 +58,9 @@ void help()
   << "regular expression).\n"
   << "  --record_resources           Recording with model meshes and "
   << "materials.\n"
+  << "  --record_overflow arg (=block) Action when recording falls behind "
+  << "simulation\n"
+  << "                                (block|drop).\n"
   << "  --seed arg                    Start with a given random number seed.\n"
   << "  --iters arg                   Number of iterations to simulate.\n"
   << "  --minimal_comms               Reduce the TCP/IP traffic output by "
@@ -18,6 +18,7 @@
 
 #include "gazebo/transport/TransportIface.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/PluginStats.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/ModelDatabase.hh"
 #include "gazebo/gazebo_config.h"
@@ -70,6 +71,8 @@ bool gazebo_shared::setup(const std::string &_prefix, int _argc, char **_argv,
   for (std::vector<gazebo::SystemPluginPtr>::iterator iter =
        _plugins.begin(); iter != _plugins.end(); ++iter)
   {
+    gazebo::common::PluginScope scope((*iter)->GetFilename(),
+        (*iter)->GetHandle());
     (*iter)->Load(_argc, _argv);
   }
 
@@ -89,6 +92,8 @@ bool gazebo_shared::setup(const std::string &_prefix, int _argc, char **_argv,
   for (std::vector<gazebo::SystemPluginPtr>::iterator iter = _plugins.begin();
        iter != _plugins.end(); ++iter)
   {
+    gazebo::common::PluginScope scope((*iter)->GetFilename(),
+        (*iter)->GetHandle());
     (*iter)->Init();
   }
 
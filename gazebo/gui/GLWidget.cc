@@ -14,17 +14,18 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <functional>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <math.h>
 
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Matrix4.hh>
 #include <ignition/math/Pose3.hh>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/rendering/Conversions.hh"
 #include "gazebo/rendering/FPSViewController.hh"
 #include "gazebo/rendering/Heightmap.hh"
@@ -65,9 +66,13 @@ GLWidget::GLWidget(QWidget *_parent)
   this->dataPtr->copyEntityName = "";
   this->dataPtr->modelEditorEnabled = false;
 
+  // The timer paces the frames, which are only rendered when something
+  // changed.
   this->dataPtr->updateTimer = new QTimer(this);
   connect(this->dataPtr->updateTimer, SIGNAL(timeout()),
-  this, SLOT(update()));
+  this, SLOT(OnRenderTimer()));
+  this->dataPtr->unfocusedRenderRate =
+    getINIProperty<double>("rendering.unfocused_fps", 5.0);
 
   this->dataPtr->windowId = -1;
 
@@ -218,6 +223,28 @@ GLWidget::~GLWidget()
 /////////////////////////////////////////////////
 bool GLWidget::eventFilter(QObject * /*_obj*/, QEvent *_event)
 {
+  // Input and window events may change what the frame shows.
+  switch (_event->type())
+  {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    case QEvent::MouseMove:
+    case QEvent::Wheel:
+    case QEvent::KeyPress:
+    case QEvent::KeyRelease:
+    case QEvent::Resize:
+    case QEvent::Show:
+    case QEvent::Enter:
+    case QEvent::Leave:
+    case QEvent::FocusIn:
+    case QEvent::FocusOut:
+      this->dataPtr->renderRequested = true;
+      break;
+    default:
+      break;
+  }
+
   if (_event->type() == QEvent::Enter)
   {
     this->setFocus(Qt::OtherFocusReason);
@@ -281,34 +308,82 @@ void GLWidget::moveEvent(QMoveEvent *_e)
 /////////////////////////////////////////////////
 void GLWidget::paintEvent(QPaintEvent *_e)
 {
+  // Exposed windows are redrawn right away.
+  {
+    IGN_PROFILE("gui::GLWidget::paintEvent pre-render");
+    event::Events::preRender();
+  }
+
   rendering::UserCameraPtr cam = gui::get_active_camera();
   if (cam && cam->Initialized())
-  {
-    {
-      IGN_PROFILE("gui::GLWidget::paintEvent pre-render");
-      event::Events::preRender();
-    }
+    this->RenderFrame();
 
-    // Tell all the cameras to render
-    {
-      IGN_PROFILE("gui::GLWidget::paintEvent render");
-      event::Events::render();
-    }
+  _e->accept();
+}
 
-    {
-      IGN_PROFILE("gui::GLWidget::paintEvent post-render");
-      event::Events::postRender();
-    }
+/////////////////////////////////////////////////
+void GLWidget::OnRenderTimer()
+{
+  const common::Time now = common::Time::GetWallTime();
+  const double sinceLast = (now - this->dataPtr->lastRenderTime).Double();
+
+  // Inactive windows are paced down. Messages wait in the scene queues.
+  if (this->dataPtr->unfocusedRenderRate > 0 && this->window() &&
+      !this->window()->isActiveWindow() &&
+      sinceLast < 1.0 / this->dataPtr->unfocusedRenderRate)
+  {
+    return;
   }
-  else
+
+  // Messages are processed on every tick, so the queues stay short and
+  // camera animations progress.
   {
-    {
-      IGN_PROFILE("gui::GLWidget::paintEvent pre-render");
-      event::Events::preRender();
-    }
+    IGN_PROFILE("gui::GLWidget::OnRenderTimer pre-render");
+    event::Events::preRender();
   }
 
-  _e->accept();
+  rendering::UserCameraPtr cam = gui::get_active_camera();
+  if (!cam || !cam->Initialized())
+    return;
+
+  // Render when the scene, the camera or the input changed, and once per
+  // second in case a change wasn't reported.
+  const bool changed = this->dataPtr->renderRequested ||
+    (this->dataPtr->scene && this->dataPtr->scene->ChangeCount() !=
+     this->dataPtr->renderedChangeCount) ||
+    cam->IsAnimating() ||
+    cam->WorldPose() != this->dataPtr->renderedCameraPose ||
+    sinceLast >= 1.0;
+
+  if (changed)
+    this->RenderFrame();
+}
+
+/////////////////////////////////////////////////
+void GLWidget::RenderFrame()
+{
+  rendering::UserCameraPtr cam = gui::get_active_camera();
+
+  // Read the state before rendering, changes made while rendering show in
+  // the next frame.
+  this->dataPtr->renderRequested = false;
+  if (this->dataPtr->scene)
+    this->dataPtr->renderedChangeCount = this->dataPtr->scene->ChangeCount();
+  if (cam)
+    this->dataPtr->renderedCameraPose = cam->WorldPose();
+  this->dataPtr->lastRenderTime = common::Time::GetWallTime();
+  ++this->dataPtr->renderedFrames;
+
+  // Tell all the cameras to render
+  {
+    IGN_PROFILE("gui::GLWidget::RenderFrame render");
+    event::Events::render();
+  }
+
+  {
+    IGN_PROFILE("gui::GLWidget::RenderFrame post-render");
+    event::Events::postRender();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -921,6 +996,12 @@ void GLWidget::ViewScene(rendering::ScenePtr _scene)
   // client side heightmap configuration
   _scene->SetHeightmapLOD(gazebo::gui::getINIProperty<int>("heightmap.lod", 0));
 
+  // client side light budget, for worlds with many lights
+  _scene->SetMaxShadowLights(
+      gazebo::gui::getINIProperty<int>("rendering.max_shadow_lights", 0));
+  _scene->SetLightsPerObject(
+      gazebo::gui::getINIProperty<int>("rendering.lights_per_object", 0));
+
   // Update at the camera's update rate
   this->dataPtr->updateTimer->start(
       static_cast<int>(
@@ -936,6 +1017,18 @@ void GLWidget::SetRenderRate(double _renderRate)
         std::round(1000.0 / _renderRate))));
 }
 
+/////////////////////////////////////////////////
+void GLWidget::SetUnfocusedRenderRate(const double _renderRate)
+{
+  this->dataPtr->unfocusedRenderRate = std::max(_renderRate, 0.0);
+}
+
+/////////////////////////////////////////////////
+uint64_t GLWidget::RenderedFrameCount() const
+{
+  return this->dataPtr->renderedFrames;
+}
+
 /////////////////////////////////////////////////
 rendering::ScenePtr GLWidget::Scene() const
 {
@@ -78,6 +78,18 @@ namespace gazebo
       /// \param[in] _renderRate Updated render rate
       public: void SetRenderRate(double _renderRate);
 
+      /// \brief Set the largest render rate while the window isn't active.
+      /// The default comes from rendering.unfocused_fps in gui.ini, 5 if
+      /// unset.
+      /// \param[in] _renderRate Frames per second, 0 to not slow down.
+      public: void SetUnfocusedRenderRate(const double _renderRate);
+
+      /// \brief Get the number of frames rendered. Frames are only rendered
+      /// when the scene, the camera or the input changed, and at least
+      /// once per second.
+      /// \return Number of frames.
+      public: uint64_t RenderedFrameCount() const;
+
       signals: void clicked();
 
       /// \brief QT signal to notify when we received a selection msg.
@@ -210,6 +222,13 @@ namespace gazebo
       /// \brief QT Callback that turns on perspective projection
       private slots: void OnPerspective();
 
+      /// \brief Process the scene messages, and render a frame if
+      /// anything changed. Called by the update timer.
+      private slots: void OnRenderTimer();
+
+      /// \brief Render a frame of the active camera.
+      private: void RenderFrame();
+
       /// \brief Set this->mouseEvent's Buttons property to the value of
       /// _event->buttons(). Note that this is different from the
       /// SetMouseEventButtons, plural, function.
@@ -115,6 +115,25 @@ namespace gazebo
       /// \brief Timer used to update the render window.
       public: QTimer *updateTimer = nullptr;
 
+      /// \brief True if input or a window event asks for a new frame.
+      public: bool renderRequested = true;
+
+      /// \brief Scene change count at the last frame.
+      public: uint64_t renderedChangeCount = 0;
+
+      /// \brief Camera pose at the last frame.
+      public: ignition::math::Pose3d renderedCameraPose;
+
+      /// \brief Wall time of the last frame.
+      public: common::Time lastRenderTime;
+
+      /// \brief Largest render rate while the window isn't active, 0 for
+      /// no limit.
+      public: double unfocusedRenderRate = 5.0;
+
+      /// \brief Number of frames rendered.
+      public: uint64_t renderedFrames = 0;
+
       /// \brief Time when the last wheel event was processed
       public: common::Time lastWheelEventTime;
     };
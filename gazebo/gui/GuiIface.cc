@@ -25,9 +25,9 @@
 #include <boost/program_options.hpp>
 #include <boost/property_tree/ini_parser.hpp>
 
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/SemanticVersion.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/gui/qt.h"
 #include "gazebo/gazebo_client.hh"
 
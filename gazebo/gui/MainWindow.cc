@@ -20,6 +20,7 @@
 #include <ignition/math/Pose3.hh>
 #include <sdf/sdf.hh>
 #include <boost/algorithm/string.hpp>
+#include <boost/make_shared.hpp>
 
 #include "gazebo/gazebo_config.h"
 #include "gazebo/gazebo_client.hh"
@@ -342,6 +343,8 @@ void MainWindow::Init()
 
   this->dataPtr->newEntitySub = this->dataPtr->node->Subscribe("~/model/info",
       &MainWindow::OnModel, this, true);
+  this->dataPtr->newEntityVSub = this->dataPtr->node->Subscribe(
+      "~/model/info_v", &MainWindow::OnModelV, this, true);
 
   // \todo Treating both light topics the same way, this should be improved
   this->dataPtr->lightModifySub = this->dataPtr->node->Subscribe(
@@ -377,6 +380,7 @@ void MainWindow::closeEvent(QCloseEvent * /*_event*/)
   this->dataPtr->responseSub.reset();
   this->dataPtr->guiSub.reset();
   this->dataPtr->newEntitySub.reset();
+  this->dataPtr->newEntityVSub.reset();
   this->dataPtr->worldModSub.reset();
   this->dataPtr->lightModifySub.reset();
   this->dataPtr->lightFactorySub.reset();
@@ -2132,6 +2136,13 @@ void MainWindow::OnModel(ConstModelPtr &_msg)
   gui::Events::modelUpdate(*_msg);
 }
 
+/////////////////////////////////////////////////
+void MainWindow::OnModelV(ConstModel_VPtr &_msg)
+{
+  for (int i = 0; i < _msg->models_size(); ++i)
+    this->OnModel(boost::make_shared<const msgs::Model>(_msg->models(i)));
+}
+
 /////////////////////////////////////////////////
 void MainWindow::OnLight(ConstLightPtr &_msg)
 {
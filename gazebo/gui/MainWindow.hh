@@ -281,6 +281,10 @@ namespace gazebo
 
       private: void OnModel(ConstModelPtr &_msg);
 
+      /// \brief Model batch message callback.
+      /// \param[in] _msg The models.
+      private: void OnModelV(ConstModel_VPtr &_msg);
+
       /// \brief Light message callback.
       /// \param[in] _msg Pointer to the light message.
       private: void OnLight(ConstLightPtr &_msg);
@@ -83,6 +83,9 @@ namespace gazebo
       /// \brief Subscribe to model info messages.
       public: transport::SubscriberPtr newEntitySub;
 
+      /// \brief Subscribe to model batch info messages.
+      public: transport::SubscriberPtr newEntityVSub;
+
       /// \brief Subscribe to world modify messages.
       public: transport::SubscriberPtr worldModSub;
 
@@ -87,6 +87,9 @@ ModelListWidget::ModelListWidget(QWidget *_parent)
   connect(this->dataPtr->modelTreeWidget, SIGNAL(itemClicked(QTreeWidgetItem *,
       int)),
           this, SLOT(OnModelSelection(QTreeWidgetItem *, int)));
+  connect(this->dataPtr->modelTreeWidget,
+      SIGNAL(itemExpanded(QTreeWidgetItem *)),
+      this, SLOT(OnItemExpanded(QTreeWidgetItem *)));
   connect(this->dataPtr->modelTreeWidget,
       SIGNAL(customContextMenuRequested(const QPoint &)),
       this, SLOT(OnCustomContextMenu(const QPoint &)));
@@ -273,6 +276,7 @@ void ModelListWidget::OnSetSelectedEntity(const std::string &_name,
         this->dataPtr->requestPub->Publish(*this->dataPtr->requestMsg);
       }
       this->dataPtr->modelTreeWidget->setCurrentItem(mItem);
+      this->PopulateModelItem(mItem);
       mItem->setExpanded(!mItem->isExpanded());
     }
     else if (lItem)
@@ -371,8 +375,6 @@ void ModelListWidget::OnLightUpdate(const msgs::Light &_msg)
 void ModelListWidget::ProcessModelMsgs()
 {
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
-  QFont subheaderFont;
-  subheaderFont.setBold(true);
 
   for (auto iter = this->dataPtr->modelMsgs.begin();
        iter != this->dataPtr->modelMsgs.end(); ++iter)
@@ -392,99 +394,16 @@ void ModelListWidget::ProcessModelMsgs()
             QStringList(QString("%1").arg(QString::fromStdString(name))));
 
         topItem->setData(0, Qt::UserRole, QVariant((*iter).name().c_str()));
-        this->dataPtr->modelTreeWidget->addTopLevelItem(topItem);
-
-        if ((*iter).link_size() > 0)
-        {
-          // Create subheader for links
-          QTreeWidgetItem *linkHeaderItem = new QTreeWidgetItem(topItem,
-          QStringList(QString("%1").arg(QString::fromStdString("LINKS"))));
-          linkHeaderItem->setFont(0, subheaderFont);
-          linkHeaderItem->setFlags(Qt::NoItemFlags);
-          this->dataPtr->modelTreeWidget->addTopLevelItem(linkHeaderItem);
-        }
-
-        for (int i = 0; i < (*iter).link_size(); ++i)
-        {
-          std::string linkName = (*iter).link(i).name();
-
-          // get unscoped name by stripping parent
-          int index = linkName.find(name) + name.length() + 2;
-          std::string linkNameShort = linkName.substr(index,
-                                                      linkName.size() - index);
-
-          QTreeWidgetItem *linkItem = new QTreeWidgetItem(topItem,
-              QStringList(QString("%1").arg(
-                  QString::fromStdString(linkNameShort))));
-
-          linkItem->setData(0, Qt::UserRole, QVariant(linkName.c_str()));
-          linkItem->setData(1, Qt::UserRole, QVariant((*iter).name().c_str()));
-          linkItem->setData(2, Qt::UserRole, QVariant((*iter).id()));
-          linkItem->setData(3, Qt::UserRole, QVariant("Link"));
-          this->dataPtr->modelTreeWidget->addTopLevelItem(linkItem);
-        }
-
-        if ((*iter).joint_size() > 0)
-        {
-          // Create subheader for joints
-          QTreeWidgetItem *jointHeaderItem = new QTreeWidgetItem(topItem,
-          QStringList(QString("%1").arg(QString::fromStdString("JOINTS"))));
-          jointHeaderItem->setFont(0, subheaderFont);
-          jointHeaderItem->setFlags(Qt::NoItemFlags);
-          this->dataPtr->modelTreeWidget->addTopLevelItem(jointHeaderItem);
-        }
+        this->dataPtr->listItems[name] = topItem;
 
-        for (int i = 0; i < (*iter).joint_size(); ++i)
+        // The items of the links, joints and plugins are only created when
+        // the model is expanded or one of them is looked up, which keeps
+        // large worlds quick to list.
+        if ((*iter).link_size() > 0 || (*iter).joint_size() > 0 ||
+            (*iter).plugin_size() > 0)
         {
-          std::string jointName = (*iter).joint(i).name();
-
-          // get unscoped name by stripping parent
-          int index = jointName.find(name) + name.length() + 2;
-          std::string jointNameShort = jointName.substr(
-              index, jointName.size() - index);
-
-          QTreeWidgetItem *jointItem = new QTreeWidgetItem(topItem,
-              QStringList(QString("%1").arg(
-                  QString::fromStdString(jointNameShort))));
-
-          jointItem->setData(0, Qt::UserRole, QVariant(jointName.c_str()));
-          jointItem->setData(3, Qt::UserRole, QVariant("Joint"));
-          this->dataPtr->modelTreeWidget->addTopLevelItem(jointItem);
-        }
-
-        if ((*iter).plugin_size() > 0)
-        {
-          // Create subheader for plugins
-          QTreeWidgetItem *pluginHeaderItem = new QTreeWidgetItem(topItem,
-          QStringList(QString("%1").arg("PLUGINS")));
-          pluginHeaderItem->setFont(0, subheaderFont);
-          pluginHeaderItem->setFlags(Qt::NoItemFlags);
-          this->dataPtr->modelTreeWidget->addTopLevelItem(pluginHeaderItem);
-        }
-
-        for (int i = 0; i < (*iter).plugin_size(); ++i)
-        {
-          std::string pluginName = (*iter).plugin(i).name();
-
-          QTreeWidgetItem *pluginItem = new QTreeWidgetItem(topItem,
-              QStringList(QString("%1").arg(
-                  QString::fromStdString(pluginName))));
-
-          common::URI pluginUri;
-          pluginUri.SetScheme("data");
-
-          pluginUri.Path().PushBack("world");
-          pluginUri.Path().PushBack(gui::get_world());
-          pluginUri.Path().PushBack("model");
-          pluginUri.Path().PushBack((*iter).name());
-          pluginUri.Path().PushBack("plugin");
-          pluginUri.Path().PushBack(pluginName);
-
-          pluginItem->setData(0, Qt::UserRole,
-              QVariant(pluginUri.Str().c_str()));
-          pluginItem->setData(3, Qt::UserRole, QVariant("Plugin"));
-
-          this->dataPtr->modelTreeWidget->addTopLevelItem(pluginItem);
+          topItem->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+          this->dataPtr->unpopulatedItems[topItem] = *iter;
         }
       }
     }
@@ -493,7 +412,11 @@ void ModelListWidget::ProcessModelMsgs()
       if ((*iter).has_deleted() && (*iter).deleted())
       {
         int i = this->dataPtr->modelsItem->indexOfChild(listItem);
-        this->dataPtr->modelsItem->takeChild(i);
+        if (i >= 0)
+        {
+          this->UnindexItem(listItem);
+          delete this->dataPtr->modelsItem->takeChild(i);
+        }
       }
       else
       {
@@ -505,6 +428,143 @@ void ModelListWidget::ProcessModelMsgs()
   this->dataPtr->modelMsgs.clear();
 }
 
+/////////////////////////////////////////////////
+void ModelListWidget::PopulateModelItem(QTreeWidgetItem *_item)
+{
+  auto unpopulated = this->dataPtr->unpopulatedItems.find(_item);
+  if (unpopulated == this->dataPtr->unpopulatedItems.end())
+    return;
+
+  const msgs::Model msg = unpopulated->second;
+  this->dataPtr->unpopulatedItems.erase(unpopulated);
+
+  const std::string &name = msg.name();
+  QFont subheaderFont;
+  subheaderFont.setBold(true);
+
+  QList<QTreeWidgetItem *> children;
+
+  if (msg.link_size() > 0)
+  {
+    // Create subheader for links
+    QTreeWidgetItem *linkHeaderItem = new QTreeWidgetItem(
+        QStringList(QString("%1").arg(QString::fromStdString("LINKS"))));
+    linkHeaderItem->setFont(0, subheaderFont);
+    linkHeaderItem->setFlags(Qt::NoItemFlags);
+    children.push_back(linkHeaderItem);
+  }
+
+  for (int i = 0; i < msg.link_size(); ++i)
+  {
+    std::string linkName = msg.link(i).name();
+
+    // get unscoped name by stripping parent
+    int index = linkName.find(name) + name.length() + 2;
+    std::string linkNameShort = linkName.substr(index,
+                                                linkName.size() - index);
+
+    QTreeWidgetItem *linkItem = new QTreeWidgetItem(
+        QStringList(QString("%1").arg(
+            QString::fromStdString(linkNameShort))));
+
+    linkItem->setData(0, Qt::UserRole, QVariant(linkName.c_str()));
+    linkItem->setData(1, Qt::UserRole, QVariant(name.c_str()));
+    linkItem->setData(2, Qt::UserRole, QVariant(msg.id()));
+    linkItem->setData(3, Qt::UserRole, QVariant("Link"));
+    this->dataPtr->listItems[linkName] = linkItem;
+    children.push_back(linkItem);
+  }
+
+  if (msg.joint_size() > 0)
+  {
+    // Create subheader for joints
+    QTreeWidgetItem *jointHeaderItem = new QTreeWidgetItem(
+        QStringList(QString("%1").arg(QString::fromStdString("JOINTS"))));
+    jointHeaderItem->setFont(0, subheaderFont);
+    jointHeaderItem->setFlags(Qt::NoItemFlags);
+    children.push_back(jointHeaderItem);
+  }
+
+  for (int i = 0; i < msg.joint_size(); ++i)
+  {
+    std::string jointName = msg.joint(i).name();
+
+    // get unscoped name by stripping parent
+    int index = jointName.find(name) + name.length() + 2;
+    std::string jointNameShort = jointName.substr(
+        index, jointName.size() - index);
+
+    QTreeWidgetItem *jointItem = new QTreeWidgetItem(
+        QStringList(QString("%1").arg(
+            QString::fromStdString(jointNameShort))));
+
+    jointItem->setData(0, Qt::UserRole, QVariant(jointName.c_str()));
+    jointItem->setData(3, Qt::UserRole, QVariant("Joint"));
+    this->dataPtr->listItems[jointName] = jointItem;
+    children.push_back(jointItem);
+  }
+
+  if (msg.plugin_size() > 0)
+  {
+    // Create subheader for plugins
+    QTreeWidgetItem *pluginHeaderItem = new QTreeWidgetItem(
+        QStringList(QString("%1").arg("PLUGINS")));
+    pluginHeaderItem->setFont(0, subheaderFont);
+    pluginHeaderItem->setFlags(Qt::NoItemFlags);
+    children.push_back(pluginHeaderItem);
+  }
+
+  for (int i = 0; i < msg.plugin_size(); ++i)
+  {
+    std::string pluginName = msg.plugin(i).name();
+
+    QTreeWidgetItem *pluginItem = new QTreeWidgetItem(
+        QStringList(QString("%1").arg(
+            QString::fromStdString(pluginName))));
+
+    common::URI pluginUri;
+    pluginUri.SetScheme("data");
+
+    pluginUri.Path().PushBack("world");
+    pluginUri.Path().PushBack(gui::get_world());
+    pluginUri.Path().PushBack("model");
+    pluginUri.Path().PushBack(name);
+    pluginUri.Path().PushBack("plugin");
+    pluginUri.Path().PushBack(pluginName);
+
+    pluginItem->setData(0, Qt::UserRole,
+        QVariant(pluginUri.Str().c_str()));
+    pluginItem->setData(3, Qt::UserRole, QVariant("Plugin"));
+    this->dataPtr->listItems[pluginUri.Str()] = pluginItem;
+    children.push_back(pluginItem);
+  }
+
+  // Insert all the children at once
+  _item->addChildren(children);
+  _item->setChildIndicatorPolicy(
+      QTreeWidgetItem::DontShowIndicatorWhenChildless);
+}
+
+/////////////////////////////////////////////////
+void ModelListWidget::OnItemExpanded(QTreeWidgetItem *_item)
+{
+  this->PopulateModelItem(_item);
+}
+
+/////////////////////////////////////////////////
+void ModelListWidget::UnindexItem(QTreeWidgetItem *_item)
+{
+  for (int i = 0; i < _item->childCount(); ++i)
+    this->UnindexItem(_item->child(i));
+
+  this->dataPtr->unpopulatedItems.erase(_item);
+
+  auto indexed = this->dataPtr->listItems.find(
+      _item->data(0, Qt::UserRole).toString().toStdString());
+  if (indexed != this->dataPtr->listItems.end() && indexed->second == _item)
+    this->dataPtr->listItems.erase(indexed);
+}
+
 /////////////////////////////////////////////////
 void ModelListWidget::OnResponse(ConstResponsePtr &_msg)
 {
@@ -613,7 +673,12 @@ void ModelListWidget::RemoveEntity(const std::string &_name)
     QTreeWidgetItem *listItem = this->ListItem(_name, items[i]);
     if (listItem)
     {
-      items[i]->takeChild(items[i]->indexOfChild(listItem));
+      int index = items[i]->indexOfChild(listItem);
+      if (index >= 0)
+      {
+        this->UnindexItem(listItem);
+        delete items[i]->takeChild(index);
+      }
       this->dataPtr->propTreeBrowser->clear();
       this->dataPtr->selectedEntityName.clear();
       this->dataPtr->sdfElement.reset();
@@ -627,33 +692,37 @@ void ModelListWidget::RemoveEntity(const std::string &_name)
 QTreeWidgetItem *ModelListWidget::ListItem(const std::string &_name,
                                               QTreeWidgetItem *_parent)
 {
-  QTreeWidgetItem *listItem = nullptr;
+  auto indexed = this->dataPtr->listItems.find(_name);
 
-  // Find an existing element with the name from the message
-  for (int i = 0; i < _parent->childCount() && !listItem; ++i)
+  // The entity may belong to a model whose children are not created yet,
+  // try each of its scopes from the innermost one.
+  if (indexed == this->dataPtr->listItems.end())
   {
-    QTreeWidgetItem *item = _parent->child(i);
-    std::string listData = item->data(0, Qt::UserRole).toString().toStdString();
-
-    if (listData == _name)
+    size_t scope = _name.rfind("::");
+    while (scope != std::string::npos && scope > 0)
     {
-      listItem = item;
-      break;
-    }
-
-    for (int j = 0; j < item->childCount(); j++)
-    {
-      QTreeWidgetItem *childItem = item->child(j);
-      listData = childItem->data(0, Qt::UserRole).toString().toStdString();
-      if (listData == _name)
+      auto model = this->dataPtr->listItems.find(_name.substr(0, scope));
+      if (model != this->dataPtr->listItems.end() &&
+          this->dataPtr->unpopulatedItems.count(model->second) > 0)
       {
-        listItem = childItem;
+        this->PopulateModelItem(model->second);
+        indexed = this->dataPtr->listItems.find(_name);
         break;
       }
+      scope = _name.rfind("::", scope - 1);
     }
   }
 
-  return listItem;
+  if (indexed == this->dataPtr->listItems.end())
+    return nullptr;
+
+  // Only return children and grandchildren of the parent
+  QTreeWidgetItem *listItem = indexed->second;
+  QTreeWidgetItem *parent = listItem->parent();
+  if (parent == _parent || (parent && parent->parent() == _parent))
+    return listItem;
+
+  return nullptr;
 }
 
 /////////////////////////////////////////////////
@@ -2904,6 +2973,8 @@ void ModelListWidget::InitTransport(const std::string &_name)
 void ModelListWidget::ResetTree()
 {
   this->dataPtr->modelTreeWidget->clear();
+  this->dataPtr->listItems.clear();
+  this->dataPtr->unpopulatedItems.clear();
 
   // Create the top level of items in the tree widget
   {
@@ -3399,7 +3470,7 @@ void ModelListWidget::ProcessLightMsgs()
           QStringList(QString("%1").arg(QString::fromStdString(name))));
 
       item->setData(0, Qt::UserRole, QVariant((*iter).name().c_str()));
-      this->dataPtr->modelTreeWidget->addTopLevelItem(item);
+      this->dataPtr->listItems[name] = item;
     }
     else
     {
@@ -49,6 +49,10 @@ namespace gazebo
       private slots: void OnPropertyChanged(QtProperty *_item);
       private slots: void OnCustomContextMenu(const QPoint &_pt);
       private slots: void OnCurrentPropertyChanged(QtBrowserItem *_item);
+
+      /// \brief Create the children of a model item when it is expanded.
+      /// \param[in] _item Expanded item.
+      private slots: void OnItemExpanded(QTreeWidgetItem *_item);
       private: void OnSetSelectedEntity(const std::string &_name,
                                         const std::string &_mode);
       private: void OnResponse(ConstResponsePtr &_msg);
@@ -112,9 +116,24 @@ namespace gazebo
 
       private: void RemoveEntity(const std::string &_name);
 
+      /// \brief Get the item of an entity, among the children and
+      /// grandchildren of a parent item. Creates the children of the model
+      /// of the entity if needed.
+      /// \param[in] _name Scoped name of the entity.
+      /// \param[in] _parent Parent item.
+      /// \return The item, nullptr if not found.
       private: QTreeWidgetItem *ListItem(const std::string &_name,
                                          QTreeWidgetItem *_parent);
 
+      /// \brief Create the link, joint and plugin items of a model item, if
+      /// they were not created yet.
+      /// \param[in] _item Model item.
+      private: void PopulateModelItem(QTreeWidgetItem *_item);
+
+      /// \brief Remove an item and its children from the name index.
+      /// \param[in] _item Item to remove.
+      private: void UnindexItem(QTreeWidgetItem *_item);
+
       private: void FillPropertyTree(const msgs::Model &_msg,
                                      QtProperty *_parent);
 
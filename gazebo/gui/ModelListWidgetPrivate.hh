@@ -19,6 +19,7 @@
 
 #include <string>
 #include <list>
+#include <unordered_map>
 #include <vector>
 #include <deque>
 #include <sdf/sdf.hh>
@@ -81,6 +82,15 @@ namespace gazebo
       /// \brief Spherical coordinates tree item.
       public: QTreeWidgetItem *sphericalCoordItem;
 
+      /// \brief Items of the models, lights, links, joints and plugins,
+      /// indexed by the name stored in their user data.
+      public: std::unordered_map<std::string, QTreeWidgetItem *> listItems;
+
+      /// \brief Model items whose children are not created yet, with the
+      /// message to create them from.
+      public: std::unordered_map<QTreeWidgetItem *, msgs::Model>
+              unpopulatedItems;
+
       public: QtVariantPropertyManager *variantManager;
       public: QtVariantEditorFactory *variantFactory;
       public: std::mutex *propMutex, *receiveMutex;
@@ -371,6 +371,18 @@ void ModelListWidget_TEST::ModelsTree()
   QVERIFY(sphereItem != nullptr);
   QVERIFY(cylinderItem != nullptr);
 
+  // verify the link items are only created when the model is expanded
+  QCOMPARE(boxItem->childCount(), 0);
+  QCOMPARE(boxItem->childIndicatorPolicy(),
+      QTreeWidgetItem::ShowIndicator);
+  boxItem->setExpanded(true);
+  QCoreApplication::processEvents();
+  // links header and the link
+  QCOMPARE(boxItem->childCount(), 2);
+  QCOMPARE(boxItem->child(1)->text(0), tr("link"));
+  QCOMPARE(boxItem->child(1)->data(0, Qt::UserRole).toString(),
+      tr("box::link"));
+
   node.reset();
   delete requestMsg;
   delete modelListWidget;
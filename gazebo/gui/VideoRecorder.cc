@@ -130,6 +130,13 @@ void VideoRecorder::OnRecordStop()
 
   cam->StopVideo();
 
+  const uint64_t dropped = cam->DroppedVideoFrameCount();
+  if (dropped > 0)
+  {
+    gzwarn << "The video encoder fell behind and dropped " << dropped
+      << " frames\n";
+  }
+
   // Inform listeners that we have stopped recording
   emit RecordingStopped();
   emit RecordingChanged(false);
@@ -243,6 +250,9 @@ void VideoRecorder::OnRecordStart(const QString &_format)
       return;
   }
 
+  cam->SetVideoHardwareEncoding(
+      getINIProperty<int>("recording.hardware_encoding", 0) != 0);
+
   if (cam->StartVideo(this->dataPtr->format, filename))
   {
     // Tell listeners that we started recording
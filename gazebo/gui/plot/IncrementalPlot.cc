@@ -15,6 +15,8 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 
 #include <ignition/math/Helpers.hh>
@@ -342,12 +344,23 @@ void IncrementalPlot::Update()
   if (this->dataPtr->curves.empty())
     return;
 
+  // Reduce the new points of each curve to about two per pixel column of
+  // the visible x range, high rate signals would draw many points on top
+  // of each other otherwise.
+  const QwtScaleMap canvasXMap = this->canvasMap(QwtPlot::xBottom);
+  const double canvasWidth = std::max(1, this->canvas()->width());
+  const double resolution =
+      std::fabs(canvasXMap.s2() - canvasXMap.s1()) / canvasWidth;
+
   ignition::math::Vector2d lastPoint;
   for (auto &curve : this->dataPtr->curves)
   {
     if (!curve.second->Active())
       continue;
 
+    curve.second->SetResolution(resolution);
+    curve.second->Flush();
+
     unsigned int pointCount = curve.second->Size();
     if (pointCount == 0u)
       continue;
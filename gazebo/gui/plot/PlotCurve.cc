@@ -14,7 +14,10 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
 #include <map>
+#include <mutex>
 #include <ignition/math/Color.hh>
 
 #include "gazebo/common/Assert.hh"
@@ -24,11 +27,6 @@
 #include "gazebo/gui/plot/IncrementalPlot.hh"
 #include "gazebo/gui/plot/PlotCurve.hh"
 
-// member variables in qwt_series_data were renamed in 6.2.0
-#if QWT_VERSION < 0x060200
-#define QWT_VERSION_LT_620
-#endif
-
 using namespace gazebo;
 using namespace gui;
 
@@ -50,136 +48,227 @@ namespace gazebo
           Colors[ColorGroupCount][ColorCount];
     };
 
-    /// \brief A class that manages curve data
-    class CurveData: public QwtArraySeriesData<QPointF>
+    /// \brief Curve data in a fixed capacity ring buffer. Once full, each
+    /// new point overwrites the oldest one. With a resolution, the points
+    /// within a resolution wide x interval are reduced to their minimum and
+    /// maximum, which keeps the envelope of a high rate signal.
+    class CurveData: public QwtSeriesData<QPointF>
     {
       public: CurveData()
-              {}
-
-      private: inline const QRectF& BoundingRect() const
-               {
-#ifdef QWT_VERSION_LT_620
-                 return this->d_boundingRect;
-#else
-                 return this->cachedBoundingRect;
-#endif
-               }
-
-      private: inline QRectF& BoundingRect()
-               {
-#ifdef QWT_VERSION_LT_620
-                 return this->d_boundingRect;
-#else
-                 return this->cachedBoundingRect;
-#endif
-               }
+              {
+                this->ring.resize(this->capacity);
+              }
 
-      private: inline const QVector<QPointF>& SamplesRef() const
-               {
-#ifdef QWT_VERSION_LT_620
-                 return this->d_samples;
-#else
-                 return this->m_samples;
-#endif
-               }
+      /// \brief Number of samples.
+      /// \return Number of samples.
+      public: virtual size_t size() const
+              {
+                return this->count;
+              }
 
-      private: inline QVector<QPointF>& SamplesRef()
-               {
-#ifdef QWT_VERSION_LT_620
-                 return this->d_samples;
-#else
-                 return this->m_samples;
-#endif
-               }
+      /// \brief Get a sample.
+      /// \param[in] _i Index of the sample, from the oldest.
+      /// \return The sample.
+      public: virtual QPointF sample(size_t _i) const
+              {
+                return this->ring[this->Slot(_i)];
+              }
 
       /// \brief Bounding rectangle accessor. This create the object
       /// if it does not already exist or is too small.
       /// \return Bounding box of the sample.
       public: virtual QRectF boundingRect() const
               {
-                if (this->BoundingRect().width() < 0.0)
-                {
-#ifdef QWT_VERSION_LT_620
-                  this->d_boundingRect = qwtBoundingRect(*this);
-#else
-                  this->cachedBoundingRect = qwtBoundingRect(*this);
-#endif
-                }
+                if (this->bounds.width() < 0.0)
+                  this->bounds = qwtBoundingRect(*this);
 
                 // set a minimum bounding box height
                 // this prevents plot's auto scale to zoom in on near-zero
                 // floating point noise.
                 double minHeight = 1e-3;
-                double absHeight = std::fabs(this->BoundingRect().height());
+                double absHeight = std::fabs(this->bounds.height());
                 if (absHeight < minHeight)
                 {
                   double halfMinHeight = minHeight * 0.5;
-                  double mid = this->BoundingRect().top() +
-                      (absHeight * 0.5);
-#ifdef QWT_VERSION_LT_620
-                  this->d_boundingRect.setTop(mid - halfMinHeight);
-                  this->d_boundingRect.setBottom(mid + halfMinHeight);
-#else
-                  this->cachedBoundingRect.setTop(mid - halfMinHeight);
-                  this->cachedBoundingRect.setBottom(mid + halfMinHeight);
-#endif
+                  double mid = this->bounds.top() + (absHeight * 0.5);
+                  this->bounds.setTop(mid - halfMinHeight);
+                  this->bounds.setBottom(mid + halfMinHeight);
                 }
 
-                return this->BoundingRect();
+                return this->bounds;
               }
 
       /// \brief Add a point to the sample.
       /// \param[in] _point Point to add.
       public: inline void Add(const QPointF &_point)
               {
-                this->SamplesRef() += _point;
-
-                if (this->SamplesRef().size() > maxSampleSize)
+                // Merge the point into the envelope of its interval
+                if (this->resolution > 0.0 && this->count > 0)
                 {
-                  // remove sample window
-                  // update bounding rect?
-                  this->SamplesRef().remove(0, windowSize);
+                  const double bucket =
+                      std::floor(_point.x() / this->resolution);
+                  if (bucket == this->bucket && this->bucketCount == 2)
+                  {
+                    this->MergeIntoBucket(_point);
+                    return;
+                  }
+                  if (bucket != this->bucket)
+                    this->bucketCount = 0;
+                  this->bucket = bucket;
                 }
+                else if (this->resolution > 0.0)
+                {
+                  this->bucket = std::floor(_point.x() / this->resolution);
+                  this->bucketCount = 0;
+                }
+                else
+                  this->bucketCount = 0;
 
-                if (this->SamplesRef().size() == 1)
+                if (this->count == this->capacity)
                 {
-                  // init bounding rect
-                  this->BoundingRect().setTopLeft(_point);
-                  this->BoundingRect().setBottomRight(_point);
-                  return;
+                  // Overwrite the oldest point
+                  this->start = (this->start + 1) % this->capacity;
+                  --this->count;
+                  this->bounds = QRectF(0.0, 0.0, -1.0, -1.0);
                 }
 
-                // expand bounding rect
-                if (_point.x() < this->BoundingRect().left())
-                  this->BoundingRect().setLeft(_point.x());
-                else if (_point.x() > this->BoundingRect().right())
-                  this->BoundingRect().setRight(_point.x());
-                if (_point.y() < this->BoundingRect().top())
-                  this->BoundingRect().setTop(_point.y());
-                else if (_point.y() > this->BoundingRect().bottom())
-                  this->BoundingRect().setBottom(_point.y());
+                this->ring[this->Slot(this->count)] = _point;
+                ++this->count;
+                ++this->bucketCount;
+                this->Expand(_point);
               }
 
       /// \brief Clear the sample data.
       public: void Clear()
               {
-                this->SamplesRef().clear();
-                this->SamplesRef().squeeze();
-                this->BoundingRect() = QRectF(0.0, 0.0, -1.0, -1.0);
+                this->start = 0;
+                this->count = 0;
+                this->bucketCount = 0;
+                this->bounds = QRectF(0.0, 0.0, -1.0, -1.0);
+              }
+
+      /// \brief Set the maximum number of samples. Drops the oldest ones
+      /// if there are more.
+      /// \param[in] _capacity Maximum number of samples.
+      public: void SetCapacity(const size_t _capacity)
+              {
+                const size_t capacity = std::max<size_t>(_capacity, 2u);
+                const size_t kept = std::min(this->count, capacity);
+                std::vector<QPointF> ring(capacity);
+                for (size_t i = 0; i < kept; ++i)
+                  ring[i] = this->sample(this->count - kept + i);
+
+                this->ring.swap(ring);
+                this->capacity = capacity;
+                this->start = 0;
+                this->count = kept;
+                this->bucketCount = 0;
+                this->bounds = QRectF(0.0, 0.0, -1.0, -1.0);
+              }
+
+      /// \brief Get the maximum number of samples.
+      /// \return Maximum number of samples.
+      public: size_t Capacity() const
+              {
+                return this->capacity;
+              }
+
+      /// \brief Set the width of the x intervals reduced to their minimum
+      /// and maximum.
+      /// \param[in] _resolution Interval width, 0 to keep every point.
+      public: void SetResolution(const double _resolution)
+              {
+                this->resolution = std::max(_resolution, 0.0);
               }
 
-      /// \brief Get the sample data.
-      /// \return A vector of same points.
-      public: QVector<QPointF> Samples() const
+      /// \brief Get the width of the x intervals.
+      /// \return Interval width.
+      public: double Resolution() const
               {
-                return this->SamplesRef();
+                return this->resolution;
               }
 
-      /// \brief maxium sample size of this curve.
-      private: int maxSampleSize = 11000;
+      /// \brief Index in the ring of a sample.
+      /// \param[in] _i Index of the sample, from the oldest.
+      /// \return Index in the ring.
+      private: size_t Slot(const size_t _i) const
+               {
+                 return (this->start + _i) % this->capacity;
+               }
+
+      /// \brief Expand the bounding rectangle with a point.
+      /// \param[in] _point New point.
+      private: void Expand(const QPointF &_point)
+               {
+                 if (this->count == 1)
+                 {
+                   // init bounding rect
+                   this->bounds.setTopLeft(_point);
+                   this->bounds.setBottomRight(_point);
+                   return;
+                 }
+
+                 // a dropped point invalidated the rect, it is recomputed
+                 // when needed
+                 if (this->bounds.width() < 0.0)
+                   return;
+
+                 if (_point.x() < this->bounds.left())
+                   this->bounds.setLeft(_point.x());
+                 else if (_point.x() > this->bounds.right())
+                   this->bounds.setRight(_point.x());
+                 if (_point.y() < this->bounds.top())
+                   this->bounds.setTop(_point.y());
+                 else if (_point.y() > this->bounds.bottom())
+                   this->bounds.setBottom(_point.y());
+               }
+
+      /// \brief Merge a point into the last two samples, which hold the
+      /// minimum and maximum of the current interval.
+      /// \param[in] _point New point.
+      private: void MergeIntoBucket(const QPointF &_point)
+               {
+                 QPointF &first = this->ring[this->Slot(this->count - 2)];
+                 QPointF &second = this->ring[this->Slot(this->count - 1)];
+                 QPointF low = first.y() <= second.y() ? first : second;
+                 QPointF high = first.y() <= second.y() ? second : first;
+
+                 if (_point.y() < low.y())
+                   low = _point;
+                 else if (_point.y() > high.y())
+                   high = _point;
+                 else
+                   return;
+
+                 // keep the samples in x order
+                 first = low.x() <= high.x() ? low : high;
+                 second = low.x() <= high.x() ? high : low;
+                 this->Expand(_point);
+               }
+
+      /// \brief Samples, from start, wrapping around.
+      private: std::vector<QPointF> ring;
+
+      /// \brief Maximum number of samples of this curve.
+      private: size_t capacity = 11000;
 
-      /// \brief Size of samples to remove when maxSampleSize is reached.
-      private: int windowSize = 1000;
+      /// \brief Index in the ring of the oldest sample.
+      private: size_t start = 0;
+
+      /// \brief Number of samples.
+      private: size_t count = 0;
+
+      /// \brief Bounding rectangle, invalid when its width is negative.
+      private: mutable QRectF bounds = QRectF(0.0, 0.0, -1.0, -1.0);
+
+      /// \brief Width of the x intervals, 0 to keep every point.
+      private: double resolution = 0.0;
+
+      /// \brief Index of the x interval of the last sample.
+      private: double bucket = 0.0;
+
+      /// \brief Number of samples of the last interval, at most 2.
+      private: unsigned int bucketCount = 0;
     };
 
 
@@ -202,9 +291,48 @@ namespace gazebo
       /// \brief Qwt Curve object.
       public: QwtPlotCurve *curve = nullptr;
 
-      /// \brief Curve data in the form of QwtArraySeriesData
+      /// \brief Curve data, owned by the Qwt curve.
       public: CurveData *curveData;
 
+      /// \brief Move the pending points to the curve data. Called from the
+      /// GUI thread, which is the only one that reads the curve data.
+      public: void Flush()
+              {
+                std::vector<QPointF> points;
+                {
+                  std::lock_guard<std::mutex> lock(this->pendingMutex);
+                  points.swap(this->pending);
+                }
+                for (const auto &pt : points)
+                  this->curveData->Add(pt);
+              }
+
+      /// \brief Queue points to add to the curve data.
+      /// \param[in] _points Points to add.
+      public: void Queue(const std::vector<QPointF> &_points)
+              {
+                std::lock_guard<std::mutex> lock(this->pendingMutex);
+                this->pending.insert(this->pending.end(), _points.begin(),
+                    _points.end());
+
+                // Older points would be overwritten anyway, so keep the
+                // queue bounded if the GUI thread falls behind.
+                const size_t capacity = this->curveData->Capacity();
+                if (this->pending.size() > 2 * capacity)
+                {
+                  this->pending.erase(this->pending.begin(),
+                      this->pending.end() - capacity);
+                }
+              }
+
+      /// \brief Points added since the last flush. They are received on
+      /// transport threads, while the plot reads the curve data on the
+      /// GUI thread.
+      public: std::vector<QPointF> pending;
+
+      /// \brief Mutex to protect the pending points.
+      public: std::mutex pendingMutex;
+
       /// \brief Global id incremented on every new curve
       public: static unsigned int globalCurveId;
 
@@ -309,7 +437,7 @@ void PlotCurve::AddPoint(const ignition::math::Vector2d &_pt)
     return;
 
   // Add a point
-  this->dataPtr->curveData->Add(QPointF(_pt.X(), _pt.Y()));
+  this->dataPtr->Queue({QPointF(_pt.X(), _pt.Y())});
 }
 
 /////////////////////////////////////////////////
@@ -319,18 +447,54 @@ void PlotCurve::AddPoints(const std::vector<ignition::math::Vector2d> &_pts)
     return;
 
   // Add all the points
+  std::vector<QPointF> points;
+  points.reserve(_pts.size());
   for (const auto &pt : _pts)
-  {
-    this->dataPtr->curveData->Add(QPointF(pt.X(), pt.Y()));
-  }
+    points.push_back(QPointF(pt.X(), pt.Y()));
+  this->dataPtr->Queue(points);
 }
 
 /////////////////////////////////////////////////
 void PlotCurve::Clear()
 {
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->pendingMutex);
+    this->dataPtr->pending.clear();
+  }
   this->dataPtr->curveData->Clear();
 }
 
+/////////////////////////////////////////////////
+void PlotCurve::SetCapacity(const unsigned int _capacity)
+{
+  this->dataPtr->Flush();
+  this->dataPtr->curveData->SetCapacity(_capacity);
+}
+
+/////////////////////////////////////////////////
+unsigned int PlotCurve::Capacity() const
+{
+  return static_cast<unsigned int>(this->dataPtr->curveData->Capacity());
+}
+
+/////////////////////////////////////////////////
+void PlotCurve::SetResolution(const double _resolution)
+{
+  this->dataPtr->curveData->SetResolution(_resolution);
+}
+
+/////////////////////////////////////////////////
+double PlotCurve::Resolution() const
+{
+  return this->dataPtr->curveData->Resolution();
+}
+
+/////////////////////////////////////////////////
+void PlotCurve::Flush()
+{
+  this->dataPtr->Flush();
+}
+
 /////////////////////////////////////////////////
 void PlotCurve::Detach()
 {
@@ -395,12 +559,14 @@ void PlotCurve::SetAge(const unsigned int _age)
 /////////////////////////////////////////////////
 unsigned int PlotCurve::Size() const
 {
-  return static_cast<unsigned int>(this->dataPtr->curveData->samples().size());
+  this->dataPtr->Flush();
+  return static_cast<unsigned int>(this->dataPtr->curveData->size());
 }
 
 /////////////////////////////////////////////////
 ignition::math::Vector2d PlotCurve::Min()
 {
+  this->dataPtr->Flush();
   return ignition::math::Vector2d(this->dataPtr->curve->minXValue(),
       this->dataPtr->curve->minYValue());
 }
@@ -408,6 +574,7 @@ ignition::math::Vector2d PlotCurve::Min()
 /////////////////////////////////////////////////
 ignition::math::Vector2d PlotCurve::Max()
 {
+  this->dataPtr->Flush();
   return ignition::math::Vector2d(this->dataPtr->curve->maxXValue(),
       this->dataPtr->curve->maxYValue());
 }
@@ -415,14 +582,14 @@ ignition::math::Vector2d PlotCurve::Max()
 /////////////////////////////////////////////////
 ignition::math::Vector2d PlotCurve::Point(const unsigned int _index) const
 {
-  if (_index >= static_cast<unsigned int>(
-      this->dataPtr->curveData->samples().size()))
+  this->dataPtr->Flush();
+  if (_index >= static_cast<unsigned int>(this->dataPtr->curveData->size()))
   {
     return ignition::math::Vector2d(ignition::math::NAN_D,
         ignition::math::NAN_D);
   }
 
-  const QPointF &pt = this->dataPtr->curveData->samples()[_index];
+  const QPointF pt = this->dataPtr->curveData->sample(_index);
   return ignition::math::Vector2d(pt.x(), pt.y());
 }
 
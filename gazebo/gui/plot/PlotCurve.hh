@@ -47,7 +47,8 @@ namespace gazebo
       /// \brief Destructor.
       public: ~PlotCurve();
 
-      /// \brief Add a point to the curve
+      /// \brief Add a point to the curve. Safe to call from any thread,
+      /// the point is added to the curve data on the next flush.
       /// \param[in] _pt Point to add.
       public: void AddPoint(const ignition::math::Vector2d &_pt);
 
@@ -58,6 +59,31 @@ namespace gazebo
       /// \brief Clear all data from the curve.
       public: void Clear();
 
+      /// \brief Set the maximum number of points of the curve. Once full,
+      /// each new point replaces the oldest one.
+      /// \param[in] _capacity Maximum number of points, 11000 by default.
+      public: void SetCapacity(const unsigned int _capacity);
+
+      /// \brief Get the maximum number of points of the curve.
+      /// \return Maximum number of points.
+      public: unsigned int Capacity() const;
+
+      /// \brief Set the x resolution of the curve. The new points within
+      /// a resolution wide x interval are reduced to their minimum and
+      /// maximum, so a high rate signal keeps its envelope with at most two
+      /// points per interval.
+      /// \param[in] _resolution Width of the x intervals, 0 to keep every
+      /// point.
+      public: void SetResolution(const double _resolution);
+
+      /// \brief Get the x resolution of the curve.
+      /// \return Width of the x intervals, 0 if every point is kept.
+      public: double Resolution() const;
+
+      /// \brief Add the points received since the last flush to the curve
+      /// data. Called from the GUI thread before drawing the curve.
+      public: void Flush();
+
       /// \brief Attach the curve to a plot.
       /// \param[in] _plot Plot to attach to.
       public: void Attach(IncrementalPlot *_plot);
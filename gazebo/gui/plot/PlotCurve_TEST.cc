@@ -133,5 +133,85 @@ void PlotCurve_TEST::AddPoint()
   delete plotCurve;
 }
 
+/////////////////////////////////////////////////
+void PlotCurve_TEST::Capacity()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  this->Load("worlds/empty.world");
+
+  gazebo::gui::PlotCurve *plotCurve = new gazebo::gui::PlotCurve("curve01");
+  QVERIFY(plotCurve != nullptr);
+  QCOMPARE(plotCurve->Capacity(), 11000u);
+
+  plotCurve->SetCapacity(100u);
+  QCOMPARE(plotCurve->Capacity(), 100u);
+
+  // add more points than the curve holds
+  for (unsigned int i = 0; i < 250u; ++i)
+    plotCurve->AddPoint(ignition::math::Vector2d(i, i * 2.0));
+
+  // verify only the newest points are kept, oldest first
+  QCOMPARE(plotCurve->Size(), 100u);
+  QCOMPARE(plotCurve->Point(0), ignition::math::Vector2d(150, 300));
+  QCOMPARE(plotCurve->Point(99), ignition::math::Vector2d(249, 498));
+  QCOMPARE(plotCurve->Min(), ignition::math::Vector2d(150, 300));
+  QCOMPARE(plotCurve->Max(), ignition::math::Vector2d(249, 498));
+
+  // shrinking keeps the newest points
+  plotCurve->SetCapacity(10u);
+  QCOMPARE(plotCurve->Size(), 10u);
+  QCOMPARE(plotCurve->Point(0), ignition::math::Vector2d(240, 480));
+
+  plotCurve->Clear();
+  QCOMPARE(plotCurve->Size(), 0u);
+
+  delete plotCurve;
+}
+
+/////////////////////////////////////////////////
+void PlotCurve_TEST::Resolution()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  this->Load("worlds/empty.world");
+
+  gazebo::gui::PlotCurve *plotCurve = new gazebo::gui::PlotCurve("curve01");
+  QVERIFY(plotCurve != nullptr);
+  QCOMPARE(plotCurve->Resolution(), 0.0);
+
+  plotCurve->SetResolution(1.0);
+  QCOMPARE(plotCurve->Resolution(), 1.0);
+
+  // 10 points in each of 3 intervals
+  std::vector<ignition::math::Vector2d> points;
+  for (unsigned int i = 0; i < 30u; ++i)
+  {
+    double y = (i % 10 == 3) ? 5.0 : ((i % 10 == 7) ? -5.0 : 0.0);
+    points.push_back(ignition::math::Vector2d(i * 0.1 + 0.01, y));
+  }
+  plotCurve->AddPoints(points);
+
+  // verify each interval is reduced to its max and min, in x order
+  QCOMPARE(plotCurve->Size(), 6u);
+  for (unsigned int i = 0; i < 3u; ++i)
+  {
+    QCOMPARE(plotCurve->Point(i * 2), points[i * 10 + 3]);
+    QCOMPARE(plotCurve->Point(i * 2 + 1), points[i * 10 + 7]);
+  }
+  QCOMPARE(plotCurve->Min().Y(), -5.0);
+  QCOMPARE(plotCurve->Max().Y(), 5.0);
+
+  // verify every point is kept without a resolution
+  plotCurve->Clear();
+  plotCurve->SetResolution(0.0);
+  plotCurve->AddPoints(points);
+  QCOMPARE(plotCurve->Size(), 30u);
+
+  delete plotCurve;
+}
+
 // Generate a main function for the test
 QTEST_MAIN(PlotCurve_TEST)
@@ -32,5 +32,11 @@ class PlotCurve_TEST : public QTestFixture
 
   /// \brief Test adding points to the curve
   private slots: void AddPoint();
+
+  /// \brief Test that a full curve drops its oldest points
+  private slots: void Capacity();
+
+  /// \brief Test reducing points to their envelope with a resolution
+  private slots: void Resolution();
 };
 #endif
@@ -17,7 +17,9 @@
 
 #include <google/protobuf/descriptor.h>
 #include <algorithm>
+#include <cmath>
 #include <array>
+#include <ignition/math/Helpers.hh>
 #include <ignition/math/MassMatrix3.hh>
 #include <ignition/math/Rand.hh>
 
@@ -161,6 +163,103 @@ namespace gazebo
       Set(_p->mutable_orientation(), _v.Rot());
     }
 
+    /////////////////////////////////////////////
+    uint64_t CompressQuaternion(const ignition::math::Quaterniond &_q)
+    {
+      ignition::math::Quaterniond q = _q;
+      q.Normalize();
+      std::array<double, 4> c = {{q.W(), q.X(), q.Y(), q.Z()}};
+
+      unsigned int largest = 0;
+      for (unsigned int i = 1; i < 4; ++i)
+      {
+        if (std::abs(c[i]) > std::abs(c[largest]))
+          largest = i;
+      }
+
+      // q and -q are the same rotation, so the dropped component is made
+      // positive and the others lie in [-1/sqrt(2), 1/sqrt(2)].
+      const double sign = c[largest] < 0 ? -1.0 : 1.0;
+      const double range = 1.0 / std::sqrt(2.0);
+      const uint64_t steps = (1u << 20) - 1u;
+
+      uint64_t packed = static_cast<uint64_t>(largest) << 60;
+      unsigned int shift = 40;
+      for (unsigned int i = 0; i < 4; ++i)
+      {
+        if (i == largest)
+          continue;
+        double v = ignition::math::clamp(sign * c[i] / range, -1.0, 1.0);
+        packed |= static_cast<uint64_t>(
+            std::lround((v + 1.0) * 0.5 * steps)) << shift;
+        shift -= 20;
+      }
+      return packed;
+    }
+
+    /////////////////////////////////////////////
+    ignition::math::Quaterniond DecompressQuaternion(const uint64_t _q)
+    {
+      const double range = 1.0 / std::sqrt(2.0);
+      const uint64_t steps = (1u << 20) - 1u;
+      const unsigned int largest = (_q >> 60) & 3u;
+
+      std::array<double, 4> c;
+      double sum = 0;
+      unsigned int shift = 40;
+      for (unsigned int i = 0; i < 4; ++i)
+      {
+        if (i == largest)
+          continue;
+        double v = static_cast<double>((_q >> shift) & steps) / steps;
+        c[i] = (v * 2.0 - 1.0) * range;
+        sum += c[i] * c[i];
+        shift -= 20;
+      }
+      c[largest] = std::sqrt(std::max(0.0, 1.0 - sum));
+
+      ignition::math::Quaterniond q(c[0], c[1], c[2], c[3]);
+      q.Normalize();
+      return q;
+    }
+
+    /////////////////////////////////////////////
+    void Set(msgs::PosesDelta::Pose *_p, const ignition::math::Pose3d &_v,
+             const double _resolution)
+    {
+      _p->set_x(std::llround(_v.Pos().X() / _resolution));
+      _p->set_y(std::llround(_v.Pos().Y() / _resolution));
+      _p->set_z(std::llround(_v.Pos().Z() / _resolution));
+      _p->set_orientation(CompressQuaternion(_v.Rot()));
+    }
+
+    /////////////////////////////////////////////
+    ignition::math::Pose3d ConvertIgn(const msgs::PosesDelta::Pose &_p,
+                                      const double _resolution)
+    {
+      return ignition::math::Pose3d(
+          ignition::math::Vector3d(_p.x() * _resolution,
+            _p.y() * _resolution, _p.z() * _resolution),
+          DecompressQuaternion(_p.orientation()));
+    }
+
+    /////////////////////////////////////////////
+    msgs::PosesStamped Convert(const msgs::PosesDelta &_msg)
+    {
+      msgs::PosesStamped result;
+      result.mutable_time()->CopyFrom(_msg.time());
+      for (int i = 0; i < _msg.pose_size(); ++i)
+      {
+        const msgs::PosesDelta::Pose &p = _msg.pose(i);
+        msgs::Pose *poseMsg = result.add_pose();
+        poseMsg->set_id(p.id());
+        if (p.has_name())
+          poseMsg->set_name(p.name());
+        Set(poseMsg, ConvertIgn(p, _msg.position_resolution()));
+      }
+      return result;
+    }
+
     /////////////////////////////////////////////
     void Set(msgs::Color *_c, const ignition::math::Color &_v)
     {
@@ -3442,5 +3541,20 @@ namespace gazebo
 
       return result;
     }
+
+    /////////////////////////////////////////////////
+    bool AddToBatch(msgs::SensorBatch &_batch,
+        const google::protobuf::Message &_sample, const common::Time &_stamp)
+    {
+      const std::string type = _sample.GetTypeName();
+      if (_batch.sample_size() == 0)
+        _batch.set_type(type);
+      else if (_batch.type() != type)
+        return false;
+
+      msgs::Set(_batch.add_stamp(), _stamp);
+      _sample.SerializeToString(_batch.add_sample());
+      return true;
+    }
   }
 }
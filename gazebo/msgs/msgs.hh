@@ -18,6 +18,7 @@
 #define GAZEBO_MSGS_MSGS_HH_
 
 #include <string>
+#include <vector>
 
 #include <sdf/sdf.hh>
 
@@ -302,6 +303,43 @@ namespace gazebo
     GAZEBO_VISIBLE
     void Set(msgs::Pose *_p, const ignition::math::Pose3d &_v);
 
+    /// \brief Pack a unit quaternion in 64 bits. The largest component is
+    /// dropped and the other three are stored with 20 bits each, which
+    /// keeps the orientation error below 1e-5 rad.
+    /// \param[in] _q The quaternion, normalized before packing.
+    /// \return The packed quaternion.
+    GAZEBO_VISIBLE
+    uint64_t CompressQuaternion(const ignition::math::Quaterniond &_q);
+
+    /// \brief Unpack a quaternion packed by CompressQuaternion.
+    /// \param[in] _q The packed quaternion.
+    /// \return The unit quaternion.
+    GAZEBO_VISIBLE
+    ignition::math::Quaterniond DecompressQuaternion(const uint64_t _q);
+
+    /// \brief Set a msgs::PosesDelta::Pose from an ignition::math::Pose3d
+    /// \param[out] _p A msgs::PosesDelta::Pose pointer
+    /// \param[in] _v An ignition::math::Pose3d reference
+    /// \param[in] _resolution Size of a position step, in meters.
+    GAZEBO_VISIBLE
+    void Set(msgs::PosesDelta::Pose *_p, const ignition::math::Pose3d &_v,
+             const double _resolution);
+
+    /// \brief Convert a msgs::PosesDelta::Pose to an ignition::math::Pose
+    /// \param[in] _p The pose to convert
+    /// \param[in] _resolution Size of a position step, in meters.
+    /// \return An ignition::math::Pose object
+    GAZEBO_VISIBLE
+    ignition::math::Pose3d ConvertIgn(const msgs::PosesDelta::Pose &_p,
+                                      const double _resolution);
+
+    /// \brief Convert a msgs::PosesDelta to a msgs::PosesStamped holding
+    /// the same entities.
+    /// \param[in] _msg The message to convert
+    /// \return A msgs::PosesStamped object
+    GAZEBO_VISIBLE
+    msgs::PosesStamped Convert(const msgs::PosesDelta &_msg);
+
     /// \brief Set a msgs::Color from an ignition::math::Color
     /// \param[out] _p A msgs::Color pointer
     /// \param[in] _v An ignition::math::Color reference
@@ -777,6 +815,35 @@ namespace gazebo
     /// \return The resulting message
     GAZEBO_VISIBLE
     msgs::Material ConvertIgnMsg(const ignition::msgs::Material &_msg);
+    /// \brief Append a sample to a sensor batch. The first sample sets
+    /// the type of the batch.
+    /// \param[in,out] _batch The batch.
+    /// \param[in] _sample The sample.
+    /// \param[in] _stamp Time of the sample.
+    /// \return False if the sample type differs from the batch type.
+    GAZEBO_VISIBLE
+    bool AddToBatch(msgs::SensorBatch &_batch,
+        const google::protobuf::Message &_sample, const common::Time &_stamp);
+
+    /// \brief Unpack the samples of a sensor batch.
+    /// \param[in] _batch The batch.
+    /// \return The samples, in the order they were measured. Empty if the
+    /// batch holds samples of another type.
+    template<typename M>
+    std::vector<M> UnpackBatch(const msgs::SensorBatch &_batch)
+    {
+      std::vector<M> result;
+      if (_batch.type() != M().GetTypeName())
+        return result;
+
+      result.resize(_batch.sample_size());
+      for (int i = 0; i < _batch.sample_size(); ++i)
+      {
+        if (!result[i].ParseFromString(_batch.sample(i)))
+          return std::vector<M>();
+      }
+      return result;
+    }
     /// \}
   }
 }
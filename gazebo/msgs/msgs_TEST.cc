@@ -16,6 +16,8 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
 #include <ignition/msgs.hh>
 #include <ignition/msgs/MessageTypes.hh>
 #include "gazebo/msgs/msgs.hh"
@@ -3997,3 +3999,101 @@ TEST_F(MsgsTest, ConvertIgnMsgMaterial)
   EXPECT_DOUBLE_EQ(ignMsg.ambient().a(), ignMsg2.ambient().a());
   EXPECT_EQ(ignMsg.lighting(), ignMsg2.lighting());
 }
+
+/////////////////////////////////////////////////
+/// \brief Dot product of two quaternions.
+static double QuatDot(const ignition::math::Quaterniond &_a,
+    const ignition::math::Quaterniond &_b)
+{
+  return _a.W() * _b.W() + _a.X() * _b.X() + _a.Y() * _b.Y() +
+      _a.Z() * _b.Z();
+}
+
+/////////////////////////////////////////////////
+TEST_F(MsgsTest, CompressQuaternion)
+{
+  const std::vector<ignition::math::Quaterniond> rotations = {
+      ignition::math::Quaterniond::Identity,
+      ignition::math::Quaterniond(0, 0, 1, 0),
+      ignition::math::Quaterniond(-1, 0, 0, 0),
+      ignition::math::Quaterniond(0.1, -0.2, 0.3),
+      ignition::math::Quaterniond(-2.5, 1.2, 3.1),
+      ignition::math::Quaterniond(IGN_PI, 0, 0)};
+
+  for (const auto &q : rotations)
+  {
+    ignition::math::Quaterniond q2 =
+        msgs::DecompressQuaternion(msgs::CompressQuaternion(q));
+    // q and -q are the same rotation
+    EXPECT_NEAR(1.0, std::abs(QuatDot(q, q2)), 1e-10) << q;
+    EXPECT_NEAR(1.0, q2.Length(), 1e-12);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MsgsTest, ConvertPosesDelta)
+{
+  const double resolution = 1e-4;
+  const ignition::math::Pose3d pose(1.23456, -7.5, 1000.0, 0.1, 0.2, 0.3);
+
+  msgs::PosesDelta msg;
+  msgs::Set(msg.mutable_time(), common::Time(2, 500));
+  msg.set_keyframe(true);
+  msg.set_position_resolution(resolution);
+  msgs::PosesDelta::Pose *p = msg.add_pose();
+  p->set_id(3);
+  p->set_name("model::link");
+  msgs::Set(p, pose, resolution);
+  EXPECT_EQ(12346, p->x());
+  EXPECT_EQ(-75000, p->y());
+
+  msgs::PosesStamped stamped = msgs::Convert(msg);
+  EXPECT_EQ(2, stamped.time().sec());
+  EXPECT_EQ(500, stamped.time().nsec());
+  ASSERT_EQ(1, stamped.pose_size());
+  EXPECT_EQ(3u, stamped.pose(0).id());
+  EXPECT_EQ("model::link", stamped.pose(0).name());
+
+  ignition::math::Pose3d pose2 = msgs::ConvertIgn(stamped.pose(0));
+  EXPECT_NEAR(0.0, (pose.Pos() - pose2.Pos()).Length(), resolution);
+  EXPECT_NEAR(1.0, std::abs(QuatDot(pose.Rot(), pose2.Rot())), 1e-10);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MsgsTest, SensorBatch)
+{
+  msgs::SensorBatch batch;
+  for (int i = 0; i < 3; ++i)
+  {
+    msgs::SonarStamped sample;
+    msgs::Set(sample.mutable_time(), common::Time(i, 10));
+    sample.mutable_sonar()->set_frame("sonar");
+    msgs::Set(sample.mutable_sonar()->mutable_world_pose(),
+        ignition::math::Pose3d::Zero);
+    sample.mutable_sonar()->set_range_min(0);
+    sample.mutable_sonar()->set_range_max(5);
+    sample.mutable_sonar()->set_radius(1);
+    sample.mutable_sonar()->set_range(0.5 * i);
+    sample.mutable_sonar()->set_geometry("cone");
+    EXPECT_TRUE(msgs::AddToBatch(batch, sample, common::Time(i, 10)));
+  }
+  EXPECT_EQ("gazebo.msgs.SonarStamped", batch.type());
+  ASSERT_EQ(3, batch.stamp_size());
+  EXPECT_EQ(2, batch.stamp(2).sec());
+
+  // Samples of another type are refused
+  msgs::Contacts contacts;
+  msgs::Set(contacts.mutable_time(), common::Time(3, 0));
+  EXPECT_FALSE(msgs::AddToBatch(batch, contacts, common::Time(3, 0)));
+  EXPECT_EQ(3, batch.sample_size());
+
+  std::vector<msgs::SonarStamped> samples =
+    msgs::UnpackBatch<msgs::SonarStamped>(batch);
+  ASSERT_EQ(3u, samples.size());
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ(i, samples[i].time().sec());
+    EXPECT_DOUBLE_EQ(0.5 * i, samples[i].sonar().range());
+  }
+  EXPECT_TRUE(msgs::UnpackBatch<msgs::Contacts>(batch).empty());
+}
@@ -56,17 +56,112 @@ class gazebo::physics::ActorPrivate
   public: std::map<std::string, ignition::math::Matrix4d>
       rotationAligner;
 
-  /// \brief Last animated frame
-  public: std::map<std::string, ignition::math::Matrix4d> lastFrame;
+  /// \brief Skeleton nodes driven by an animation, indexed by the handles
+  /// of the skin skeleton nodes.
+  public: class Binding
+  {
+    /// \brief Animation of each node, nullptr if the node is not animated.
+    public: std::vector<const common::NodeAnimation *> nodes;
+
+    /// \brief True for the nodes that take the transform of the root.
+    public: std::vector<bool> root;
+
+    /// \brief BVH translation aligner of each node.
+    public: std::vector<ignition::math::Matrix4d> translationAligners;
+
+    /// \brief BVH rotation aligner of each node.
+    public: std::vector<ignition::math::Matrix4d> rotationAligners;
+  };
+
+  /// \brief Get the binding of an animation, creating it on first use.
+  /// \param[in] _type Animation type.
+  /// \param[in] _skel Skin skeleton.
+  /// \param[in] _anim Animation.
+  /// \param[in] _skelMap Animation node of each skin node.
+  /// \return The binding.
+  public: const Binding &BindingFor(const std::string &_type,
+      common::Skeleton *_skel, const common::SkeletonAnimation *_anim,
+      const std::map<std::string, std::string> &_skelMap);
+
+  /// \brief What ApplyFrame has to do.
+  public: enum PendingUpdate
+  {
+    /// \brief Nothing.
+    NONE,
+
+    /// \brief Set the world pose of the actor to pendingPose.
+    WORLD_POSE,
+
+    /// \brief Set the skeleton pose to frame.
+    SKELETON
+  };
+
+  /// \brief Update computed by Actor::EvaluateFrame.
+  public: PendingUpdate pending = NONE;
+
+  /// \brief Actor pose for a WORLD_POSE update.
+  public: ignition::math::Pose3d pendingPose;
+
+  /// \brief Simulation time of the pending update.
+  public: double pendingTime = 0;
 
-  /// \brief Last map associating skeleton nodes from skin and animation
-  public: std::map<std::string, std::string> lastSkelMap;
+  /// \brief Bindings, by animation type.
+  public: std::map<std::string, Binding> bindings;
+
+  /// \brief Last animated frame: transform of each skeleton node relative
+  /// to its parent. Empty until the first frame is animated.
+  public: std::vector<ignition::math::Matrix4d> frame;
+
+  /// \brief Link of each skeleton node.
+  public: std::vector<LinkPtr> boneLinks;
 };
 
 using namespace gazebo;
 using namespace physics;
 using namespace common;
 
+//////////////////////////////////////////////////
+const ActorPrivate::Binding &ActorPrivate::BindingFor(
+    const std::string &_type, Skeleton *_skel,
+    const SkeletonAnimation *_anim,
+    const std::map<std::string, std::string> &_skelMap)
+{
+  auto iter = this->bindings.find(_type);
+  if (iter != this->bindings.end())
+    return iter->second;
+
+  auto animName = [&_skelMap](const std::string &_node)
+  {
+    auto nameIter = _skelMap.find(_node);
+    return nameIter == _skelMap.end() ? std::string() : nameIter->second;
+  };
+  const std::string rootName = animName(_skel->GetRootNode()->GetName());
+
+  Binding &binding = this->bindings[_type];
+  const unsigned int count = _skel->GetNumNodes();
+  binding.nodes.resize(count, nullptr);
+  binding.root.resize(count, false);
+  binding.translationAligners.resize(count);
+  binding.rotationAligners.resize(count);
+
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    const std::string name = animName(_skel->GetNodeByHandle(i)->GetName());
+    binding.nodes[i] = _anim->NodeAnimationByName(name);
+    binding.root[i] = name == rootName;
+
+    auto translation = this->translationAligner.find(name);
+    if (translation != this->translationAligner.end())
+      binding.translationAligners[i] = translation->second;
+
+    auto rotation = this->rotationAligner.find(name);
+    if (rotation != this->rotationAligner.end())
+      binding.rotationAligners[i] = rotation->second;
+  }
+
+  return binding;
+}
+
 //////////////////////////////////////////////////
 Actor::Actor(BasePtr _parent)
   : Model(_parent), dataPtr(new ActorPrivate)
@@ -680,20 +775,36 @@ bool Actor::IsActive() const
 ///////////////////////////////////////////////////
 void Actor::Update()
 {
+  if (!this->EvaluateFrame())
+    return;
+
+  msgs::PoseAnimation msg;
+  if (this->ApplyFrame(msg) &&
+      this->bonePosePub && this->bonePosePub->HasConnections())
+  {
+    this->bonePosePub->Publish(msg);
+  }
+}
+
+//////////////////////////////////////////////////
+bool Actor::EvaluateFrame()
+{
+  this->dataPtr->pending = ActorPrivate::NONE;
+
   common::Time currentTime = this->world->SimTime();
+  this->dataPtr->pendingTime = currentTime.Double();
   if (!this->active)
   {
-    this->SetPose(this->dataPtr->lastFrame, this->dataPtr->lastSkelMap,
-                  currentTime.Double());
-    return;
+    this->dataPtr->pending = ActorPrivate::SKELETON;
+    return true;
   }
 
   if (this->skelAnimation.empty() && this->trajectories.empty())
-    return;
+    return false;
 
   // do not refresh animation faster than 30 Hz sim time
   if ((currentTime - this->prevFrameTime).Double() < (1.0 / 30.0))
-    return;
+    return false;
 
   // Get trajectory
   TrajectoryInfo *tinfo = nullptr;
@@ -705,9 +816,8 @@ void Actor::Update()
     // waiting for delayed start
     if (this->scriptTime < 0)
     {
-      this->SetPose(this->dataPtr->lastFrame, this->dataPtr->lastSkelMap,
-                    currentTime.Double());
-      return;
+      this->dataPtr->pending = ActorPrivate::SKELETON;
+      return true;
     }
 
     if (this->scriptTime >= this->scriptLength)
@@ -715,7 +825,7 @@ void Actor::Update()
       if (!this->loop)
       {
         this->active = false;
-        return;
+        return false;
       }
       else
       {
@@ -739,7 +849,7 @@ void Actor::Update()
     {
       gzerr << "Trajectory not found at time [" << this->scriptTime << "]"
           << std::endl;
-      return;
+      return false;
     }
     this->scriptTime = this->scriptTime - tinfo->startTime;
   }
@@ -753,13 +863,13 @@ void Actor::Update()
 
   // Update global trajectory (not skeleton animation)
   ignition::math::Pose3d modelPose;
-  if (!this->customTrajectoryInfo &&
-      this->trajectories.find(tinfo->id) != this->trajectories.end())
+  auto trajectory = this->trajectories.find(tinfo->id);
+  if (!this->customTrajectoryInfo && trajectory != this->trajectories.end())
   {
     // Get the pose keyframe calculated for this script time
     common::PoseKeyFrame posFrame(0.0);
-    this->trajectories[tinfo->id]->SetTime(this->scriptTime);
-    this->trajectories[tinfo->id]->GetInterpolatedKeyFrame(posFrame);
+    trajectory->second->SetTime(this->scriptTime);
+    trajectory->second->GetInterpolatedKeyFrame(posFrame);
 
     modelPose.Pos() = posFrame.Translation();
     modelPose.Rot() = posFrame.Rotation();
@@ -774,7 +884,7 @@ void Actor::Update()
     else
     {
       auto frame0 = dynamic_cast<common::PoseKeyFrame *>
-        (this->trajectories[tinfo->id]->GetKeyFrame(0));
+        (trajectory->second->GetKeyFrame(0));
       ignition::math::Vector3d vector3Ign = frame0->Translation();
       this->pathLength = modelPose.Pos().Distance(vector3Ign);
     }
@@ -786,39 +896,32 @@ void Actor::Update()
   // If there's no skeleton animation, we just update the global pose
   if (!skelAnim)
   {
-    this->SetWorldPose(modelPose);
-    return;
+    this->dataPtr->pendingPose = modelPose;
+    this->dataPtr->pending = ActorPrivate::WORLD_POSE;
+    return true;
   }
 
-  auto skelMap = this->skelNodesMap[tinfo->type];
+  const auto &skelMap = this->skelNodesMap[tinfo->type];
+  const ActorPrivate::Binding &binding = this->dataPtr->BindingFor(
+      tinfo->type, this->skeleton, skelAnim, skelMap);
 
-  std::map<std::string, ignition::math::Matrix4d> frame;
-  if (!this->customTrajectoryInfo)
-  {
-    if (this->interpolateX[tinfo->type] &&
-          this->trajectories.find(tinfo->id) != this->trajectories.end())
-    {
-      frame = skelAnim->PoseAtX(this->pathLength,
-                skelMap[this->skeleton->GetRootNode()->GetName()]);
-    }
-    else
-    {
-      frame = skelAnim->PoseAt(this->scriptTime);
-    }
-  }
-  else
+  SkeletonNode *rootNode = this->skeleton->GetRootNode();
+  const unsigned int rootHandle = rootNode->GetHandle();
+
+  double animTime = this->scriptTime;
+  if (!this->customTrajectoryInfo && this->interpolateX[tinfo->type] &&
+      trajectory != this->trajectories.end())
   {
-    frame = skelAnim->PoseAt(this->scriptTime);
+    auto rootIter = skelMap.find(rootNode->GetName());
+    animTime = skelAnim->TimeAtX(this->pathLength,
+        rootIter == skelMap.end() ? std::string() : rootIter->second);
   }
 
   this->lastTraj = tinfo->id;
 
   ignition::math::Matrix4d rootTrans = ignition::math::Matrix4d::Identity;
-  auto iter = frame.find(skelMap[this->skeleton->GetRootNode()->GetName()]);
-  if (iter != frame.end())
-  {
-    rootTrans = frame[skelMap[this->skeleton->GetRootNode()->GetName()]];
-  }
+  if (binding.nodes[rootHandle])
+    rootTrans = binding.nodes[rootHandle]->FrameAt(animTime, true);
 
   ignition::math::Vector3d rootPos = rootTrans.Translation();
   ignition::math::Quaterniond rootRot = rootTrans.Rotation();
@@ -859,21 +962,77 @@ void Actor::Update()
   // workaround for rotation bug
   rootM.SetTranslation(rootM.Translation() * this->skinScale);
 
-  frame[skelMap[this->skeleton->GetRootNode()->GetName()]] = rootM;
+  // Transform of each bone relative to its parent. Bones that are not
+  // animated keep the transform of the skin.
+  std::vector<ignition::math::Matrix4d> &frame = this->dataPtr->frame;
+  frame.resize(this->skeleton->GetNumNodes());
+  for (unsigned int i = 0; i < frame.size(); ++i)
+  {
+    SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
+    if (!binding.root[i] && !binding.nodes[i])
+    {
+      frame[i] = bone->Transform();
+      continue;
+    }
+
+    ignition::math::Matrix4d transform = binding.root[i] ? rootM :
+        binding.nodes[i]->FrameAt(animTime, true);
 
-  this->dataPtr->lastFrame = frame;
-  this->dataPtr->lastSkelMap = skelMap;
+    if (this->dataPtr->bvhFile)
+    {
+      if (bone != rootNode)
+      {
+        ignition::math::Vector3d bvhOffset = transform.Translation();
+        ignition::math::Vector3d daeOffset = bone->Transform().Translation();
+        // scale bvh offset to dae link length
+        transform.SetTranslation(daeOffset.Length() * bvhOffset.Normalize());
+      }
+
+      transform = binding.translationAligners[i] * transform *
+          binding.rotationAligners[i];
+    }
+    frame[i] = transform;
+  }
 
-  this->SetPose(frame, skelMap, currentTime.Double());
+  this->dataPtr->pending = ActorPrivate::SKELETON;
+  return true;
 }
 
 //////////////////////////////////////////////////
-void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
-    std::map<std::string, std::string> _skelMap, const double _time)
+bool Actor::ApplyFrame(msgs::PoseAnimation &_msg)
 {
-  msgs::PoseAnimation msg;
-  msg.set_model_name(this->visualName);
-  msg.set_model_id(this->visualId);
+  const ActorPrivate::PendingUpdate pending = this->dataPtr->pending;
+  this->dataPtr->pending = ActorPrivate::NONE;
+
+  if (pending == ActorPrivate::WORLD_POSE)
+  {
+    this->SetWorldPose(this->dataPtr->pendingPose);
+    return false;
+  }
+
+  if (pending != ActorPrivate::SKELETON || !this->skeleton)
+    return false;
+
+  // Until the first frame is animated, the skeleton keeps the pose of the
+  // skin.
+  std::vector<ignition::math::Matrix4d> &frame = this->dataPtr->frame;
+  if (frame.empty())
+  {
+    for (unsigned int i = 0; i < this->skeleton->GetNumNodes(); ++i)
+      frame.push_back(this->skeleton->GetNodeByHandle(i)->Transform());
+  }
+
+  this->SetPose(frame, this->dataPtr->pendingTime, _msg);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Actor::SetPose(const std::vector<ignition::math::Matrix4d> &_frame,
+    const double _time, msgs::PoseAnimation &_msg)
+{
+  _msg.Clear();
+  _msg.set_model_name(this->visualName);
+  _msg.set_model_id(this->visualId);
 
   ignition::math::Matrix4d modelTrans(ignition::math::Matrix4d::Identity);
   ignition::math::Pose3d mainLinkPose;
@@ -884,41 +1043,25 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
     mainLinkPose.Rot() = this->worldPose.Rot();
   }
 
+  // Look the links up once, they are the same for every frame.
+  std::vector<LinkPtr> &boneLinks = this->dataPtr->boneLinks;
+  if (boneLinks.size() != this->skeleton->GetNumNodes())
+  {
+    boneLinks.clear();
+    for (unsigned int i = 0; i < this->skeleton->GetNumNodes(); ++i)
+    {
+      boneLinks.push_back(this->GetChildLink(
+            this->skeleton->GetNodeByHandle(i)->GetName()));
+    }
+  }
+
   for (unsigned int i = 0; i < this->skeleton->GetNumNodes(); ++i)
   {
     SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
     SkeletonNode *parentBone = bone->GetParent();
-    ignition::math::Matrix4d transform(ignition::math::Matrix4d::Identity);
-
-    if (_frame.find(_skelMap[bone->GetName()]) != _frame.end())
-    {
-      if (this->dataPtr->bvhFile)
-      {
-        std::string tempStr(_skelMap[bone->GetName()]);
-        transform = _frame[tempStr];
+    ignition::math::Matrix4d transform = _frame[i];
 
-        if (bone->GetName() != this->skeleton->GetRootNode()->GetName())
-        {
-          ignition::math::Vector3d bvhOffset = transform.Translation();
-          ignition::math::Vector3d daeOffset = bone->Transform().Translation();
-          // scale bvh offset to dae link length
-          transform.SetTranslation(daeOffset.Length() * bvhOffset.Normalize());
-        }
-
-        transform = this->dataPtr->translationAligner[tempStr] * transform *
-            this->dataPtr->rotationAligner[tempStr];
-      }
-      else
-      {
-        transform = _frame[_skelMap[bone->GetName()]];
-      }
-    }
-    else
-    {
-      transform = bone->Transform();
-    }
-
-    LinkPtr currentLink = this->GetChildLink(bone->GetName());
+    LinkPtr currentLink = boneLinks[i];
     ignition::math::Pose3d bonePose = transform.Pose();
     if (!bonePose.IsFinite())
     {
@@ -927,7 +1070,7 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
       bonePose.Correct();
     }
 
-    msgs::Pose *bone_pose = msg.add_pose();
+    msgs::Pose *bone_pose = _msg.add_pose();
     bone_pose->set_name(bone->GetName());
 
     if (!parentBone)
@@ -943,13 +1086,13 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
     {
       bone_pose->mutable_position()->CopyFrom(msgs::Convert(bonePose.Pos()));
       bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(bonePose.Rot()));
-      LinkPtr parentLink = this->GetChildLink(parentBone->GetName());
+      LinkPtr parentLink = boneLinks[parentBone->GetHandle()];
       auto parentPose = parentLink->WorldPose();
       ignition::math::Matrix4d parentTrans(parentPose);
       transform = parentTrans * transform;
     }
 
-    msgs::Pose *link_pose = msg.add_pose();
+    msgs::Pose *link_pose = _msg.add_pose();
     link_pose->set_name(currentLink->GetScopedName());
     link_pose->set_id(currentLink->GetId());
     ignition::math::Pose3d linkPose = transform.Pose() - mainLinkPose;
@@ -958,10 +1101,10 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
     currentLink->SetWorldPose(transform.Pose(), true, false);
   }
 
-  msgs::Time *stamp = msg.add_time();
+  msgs::Time *stamp = _msg.add_time();
   stamp->CopyFrom(msgs::Convert(_time));
 
-  msgs::Pose *model_pose = msg.add_pose();
+  msgs::Pose *model_pose = _msg.add_pose();
   model_pose->set_name(this->GetScopedName());
   model_pose->set_id(this->GetId());
   if (!this->customTrajectoryInfo)
@@ -978,8 +1121,6 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
         msgs::Convert(this->worldPose.Rot()));
   }
 
-  if (this->bonePosePub && this->bonePosePub->HasConnections())
-    this->bonePosePub->Publish(msg);
   if (!this->customTrajectoryInfo)
     this->SetWorldPose(mainLinkPose, true, false);
 }
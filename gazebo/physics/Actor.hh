@@ -40,6 +40,11 @@ namespace gazebo
     class Skeleton;
   }
 
+  namespace msgs
+  {
+    class PoseAnimation;
+  }
+
   namespace physics
   {
     class ActorPrivate;
@@ -114,9 +119,25 @@ namespace gazebo
       /// \return True if animation is being played.
       public: virtual bool IsActive() const;
 
-      /// \brief Update the actor
+      /// \brief Update the actor: EvaluateFrame followed by ApplyFrame, and
+      /// publication of the skeleton pose.
       public: void Update();
 
+      /// \brief First half of the update: evaluate the trajectory and the
+      /// skeleton animation at the current simulation time. Only the state
+      /// of this actor is modified, so the world evaluates the actors of a
+      /// crowd in parallel.
+      /// \return True if ApplyFrame must be called.
+      /// \sa PhysicsEngine::SetParam("parallel_actor_update_threshold")
+      public: bool EvaluateFrame();
+
+      /// \brief Second half of the update: move the actor and its links to
+      /// the frame computed by EvaluateFrame.
+      /// \param[out] _msg Skeleton pose of the actor visual.
+      /// \return True if _msg was filled, false if only the actor pose was
+      /// updated.
+      public: bool ApplyFrame(msgs::PoseAnimation &_msg);
+
       /// \brief Finalize the actor
       public: virtual void Fini();
 
@@ -282,13 +303,12 @@ namespace gazebo
 
       /// \brief Set the actor's pose. This sets the pose for each bone in the
       /// skeleton and also the actor's pose in the world.
-      /// \param[in] _frame Each frame name and transform.
-      /// \param[in] _skelMap Map of bone relationships.
+      /// \param[in] _frame Transform of each skeleton node relative to its
+      /// parent, indexed by node handle.
       /// \param[in] _time Time over which to animate the set pose.
-      private: void SetPose(
-                   std::map<std::string, ignition::math::Matrix4d> _frame,
-                   std::map<std::string, std::string> _skelMap,
-                   const double _time);
+      /// \param[out] _msg Skeleton pose of the actor visual.
+      private: void SetPose(const std::vector<ignition::math::Matrix4d> &_frame,
+                   const double _time, msgs::PoseAnimation &_msg);
 
       /// \brief Pointer to the actor's mesh.
       protected: const common::Mesh *mesh = nullptr;
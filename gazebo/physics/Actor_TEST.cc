@@ -15,6 +15,8 @@
  *
 */
 
+#include <atomic>
+
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/physics/Actor.hh"
 
@@ -24,6 +26,19 @@ using namespace gazebo;
 
 class ActorTest : public ServerFixture { };
 
+/// \brief Number of skeleton pose batches received.
+static std::atomic<unsigned int> g_batchCount(0);
+
+/// \brief Number of actors in the last skeleton pose batch.
+static std::atomic<int> g_batchSize(0);
+
+/////////////////////////////////////////////////
+void OnSkeletonPoseBatch(ConstPoseAnimation_VPtr &_msg)
+{
+  g_batchSize = _msg->pose_animation_size();
+  ++g_batchCount;
+}
+
 //////////////////////////////////////////////////
 TEST_F(ActorTest, Load)
 {
@@ -102,6 +117,44 @@ TEST_F(ActorTest, TrajectoryFromSDF)
   EXPECT_LT(fabs(actor->ScriptTime() - world->SimTime().Double()), 1.0 / 30);
 }
 
+//////////////////////////////////////////////////
+TEST_F(ActorTest, CrowdUpdate)
+{
+  // Load a world with an actor
+  this->Load("worlds/actor.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  auto actor = boost::dynamic_pointer_cast<physics::Actor>(
+      world->ModelByName("actor"));
+  ASSERT_TRUE(actor != nullptr);
+
+  // Update the actor as a crowd of one
+  auto physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  EXPECT_EQ(0u, physics->ParallelActorUpdateThreshold());
+  EXPECT_FALSE(physics->SetParam("parallel_actor_update_threshold", -1));
+  EXPECT_TRUE(physics->SetParam("parallel_actor_update_threshold", 1));
+  EXPECT_EQ(1u, physics->ParallelActorUpdateThreshold());
+
+  transport::SubscriberPtr sub = this->node->Subscribe(
+      "~/skeleton_pose/batch", &OnSkeletonPoseBatch);
+
+  // The actor follows its trajectory as in the serial update
+  world->Step(4000);
+
+  ignition::math::Vector3d target(1.0, 0.0, 1.0);
+  EXPECT_LT((target - actor->WorldPose().Pos()).Length(), 0.1);
+  EXPECT_LT(fabs(actor->ScriptTime() - world->SimTime().Double()), 1.0 / 30);
+
+  // The skeleton poses are batched
+  int sleep = 0;
+  while (g_batchCount == 0u && sleep++ < 100)
+    common::Time::MSleep(10);
+  EXPECT_GT(g_batchCount, 0u);
+  EXPECT_EQ(1, g_batchSize);
+}
+
 //////////////////////////////////////////////////
 TEST_F(ActorTest, ActorCollision)
 {
@@ -99,13 +99,16 @@ void Base::Fini()
     temp->RemoveChild(this->id);
   }
 
-  // Also destroy all children.
-  while (!this->children.empty())
+  // Also destroy all children. They are moved out first, so that removing
+  // each does not search the vector again.
+  Base_V oldChildren;
+  oldChildren.swap(this->children);
+  this->childrenByName.clear();
+  for (auto &child : oldChildren)
   {
-    auto child = this->children.front();
-    this->RemoveChild(child);
+    child->SetParent(nullptr);
+    child->Fini();
   }
-  this->children.clear();
 
   this->sdf.reset();
 
@@ -136,7 +139,31 @@ void Base::SetName(const std::string &_name)
   GZ_ASSERT(this->sdf != NULL, "Base sdf member is NULL");
   GZ_ASSERT(this->sdf->GetAttribute("name"), "Base sdf missing name attribute");
   this->sdf->GetAttribute("name")->Set(_name);
+
+  // Move the entry of the name index of the parent
+  if (this->parent && this->name != _name)
+  {
+    auto iter = this->parent->childrenByName.find(this->name);
+    if (iter != this->parent->childrenByName.end())
+    {
+      Base_V &named = iter->second;
+      for (auto childIter = named.begin(); childIter != named.end();
+           ++childIter)
+      {
+        if (childIter->get() == this)
+        {
+          BasePtr self = *childIter;
+          named.erase(childIter);
+          if (named.empty())
+            this->parent->childrenByName.erase(iter);
+          this->parent->childrenByName[_name].push_back(self);
+          break;
+        }
+      }
+    }
+  }
   this->name = _name;
+
   this->ComputeScopedName();
 }
 
@@ -189,10 +216,11 @@ void Base::AddChild(BasePtr _child)
     gzthrow("Cannot add a null _child to an entity");
 
   // Add this _child to our list
-  if (std::find(this->children.begin(), this->children.end(), _child)
-      == this->children.end())
+  Base_V &named = this->childrenByName[_child->GetName()];
+  if (std::find(named.begin(), named.end(), _child) == named.end())
   {
     this->children.push_back(_child);
+    named.push_back(_child);
   }
 }
 
@@ -243,6 +271,10 @@ BasePtr Base::GetChild(unsigned int _i) const
 //////////////////////////////////////////////////
 BasePtr Base::GetChild(const std::string &_name)
 {
+  auto iter = this->childrenByName.find(_name);
+  if (iter != this->childrenByName.end() && !iter->second.empty())
+    return iter->second.front();
+
   std::string fullName = this->GetScopedName() + "::" + _name;
   return this->GetByName(fullName);
 }
@@ -264,6 +296,20 @@ void Base::RemoveChild(physics::BasePtr _child)
   _child->Fini();
 
   // Remove from vector if still there
+  this->UnindexChild(_child);
+  this->children.erase(std::remove(this->children.begin(),
+                                   this->children.end(), _child),
+                                   this->children.end());
+}
+
+//////////////////////////////////////////////////
+void Base::DetachChild(physics::BasePtr _child)
+{
+  if (!_child)
+    return;
+
+  _child->SetParent(nullptr);
+  this->UnindexChild(_child);
   this->children.erase(std::remove(this->children.begin(),
                                    this->children.end(), _child),
                                    this->children.end());
@@ -273,6 +319,40 @@ void Base::RemoveChild(physics::BasePtr _child)
 void Base::RemoveChildren()
 {
   this->children.clear();
+  this->childrenByName.clear();
+}
+
+//////////////////////////////////////////////////
+void Base::UnindexChild(const BasePtr &_child)
+{
+  auto iter = this->childrenByName.find(_child->GetName());
+  if (iter != this->childrenByName.end())
+  {
+    Base_V &named = iter->second;
+    auto childIter = std::find(named.begin(), named.end(), _child);
+    if (childIter != named.end())
+    {
+      named.erase(childIter);
+      if (named.empty())
+        this->childrenByName.erase(iter);
+      return;
+    }
+  }
+
+  // The name was changed without SetName
+  for (iter = this->childrenByName.begin();
+       iter != this->childrenByName.end(); ++iter)
+  {
+    Base_V &named = iter->second;
+    auto childIter = std::find(named.begin(), named.end(), _child);
+    if (childIter != named.end())
+    {
+      named.erase(childIter);
+      if (named.empty())
+        this->childrenByName.erase(iter);
+      return;
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -315,6 +395,35 @@ BasePtr Base::GetByIdRecursive(unsigned int _id)
 
 //////////////////////////////////////////////////
 BasePtr Base::GetByName(const std::string &_name)
+{
+  if (this->GetScopedName() == _name || this->GetName() == _name)
+    return shared_from_this();
+
+  // The scoped names of the descendants extend the one of this entity, or
+  // are relative to the root. Follow them through the name indices.
+  size_t start = std::string::npos;
+  if (!this->parent)
+    start = 0;
+  else if (_name.size() > this->scopedName.size() + 2 &&
+      _name.compare(0, this->scopedName.size(), this->scopedName) == 0 &&
+      _name.compare(this->scopedName.size(), 2, "::") == 0)
+  {
+    start = this->scopedName.size() + 2;
+  }
+
+  if (start != std::string::npos)
+  {
+    BasePtr result = this->ScopedDescendant(_name, start);
+    if (result)
+      return result;
+  }
+
+  // Local names of nested entities, and names that hold a "::"
+  return this->SearchByName(_name);
+}
+
+//////////////////////////////////////////////////
+BasePtr Base::SearchByName(const std::string &_name)
 {
   if (this->GetScopedName() == _name || this->GetName() == _name)
     return shared_from_this();
@@ -324,11 +433,35 @@ BasePtr Base::GetByName(const std::string &_name)
 
   for (iter = this->children.begin();
       iter != this->children.end() && result == NULL; ++iter)
-    result = (*iter)->GetByName(_name);
+    result = (*iter)->SearchByName(_name);
 
   return result;
 }
 
+//////////////////////////////////////////////////
+BasePtr Base::ScopedDescendant(const std::string &_name,
+    const size_t _start) const
+{
+  const size_t end = _name.find("::", _start);
+  auto iter = this->childrenByName.find(_name.substr(_start,
+      end == std::string::npos ? std::string::npos : end - _start));
+  if (iter == this->childrenByName.end())
+    return BasePtr();
+
+  // Siblings of different types may share a name
+  for (auto const &child : iter->second)
+  {
+    if (end == std::string::npos)
+      return child;
+
+    BasePtr result = child->ScopedDescendant(_name, end + 2);
+    if (result)
+      return result;
+  }
+
+  return BasePtr();
+}
+
 //////////////////////////////////////////////////
 std::string Base::GetScopedName(bool _prependWorldName) const
 {
@@ -21,6 +21,7 @@
 #include <boost/enable_shared_from_this.hpp>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <sdf/sdf.hh>
@@ -234,7 +235,9 @@ namespace gazebo
       public: BasePtr GetByIdRecursive(unsigned int _id);
 
 
-      /// \brief Get by name.
+      /// \brief Get by name. A scoped name is resolved in a few hash
+      /// lookups, one per level. Other names, such as the local name of a
+      /// nested entity, are searched in the subtree, depth first.
       /// \param[in] _name Get a child (or self) object by name
       /// \return A pointer to the object, NULL if not found
       public: BasePtr GetByName(const std::string &_name);
@@ -244,7 +247,8 @@ namespace gazebo
       /// \return A pointer to the object, NULL if the index is invalid.
       public: BasePtr GetChild(unsigned int _i) const;
 
-      /// \brief Get a child by name.
+      /// \brief Get a child by name. Direct children are found through a
+      /// hash index, other names by a search of the subtree.
       /// \param[in] _name Name of the child.
       /// \return A pointer to the object, NULL if not found
       public: BasePtr GetChild(const std::string &_name);
@@ -257,6 +261,11 @@ namespace gazebo
       /// \param[in] _child Pointer to the child.
       public: void RemoveChild(physics::BasePtr _child);
 
+      /// \brief Remove a child without finalizing it, so that it can be
+      /// added back later with AddChild.
+      /// \param[in] _child Pointer to the child.
+      public: void DetachChild(physics::BasePtr _child);
+
       /// \brief Add a type specifier.
       /// \param[in] _type New type to append to this objects type
       /// definition.
@@ -360,6 +369,22 @@ namespace gazebo
       /// \sa Base::GetScopedName
       protected: void ComputeScopedName();
 
+      /// \brief Search the subtree for an entity by name, depth first.
+      /// \param[in] _name Scoped or local name.
+      /// \return A pointer to the object, NULL if not found
+      private: BasePtr SearchByName(const std::string &_name);
+
+      /// \brief Follow a scoped name through the name indices.
+      /// \param[in] _name Scoped name.
+      /// \param[in] _start Position in _name of the name of a child.
+      /// \return A pointer to the descendant, NULL if not found
+      private: BasePtr ScopedDescendant(const std::string &_name,
+                   const size_t _start) const;
+
+      /// \brief Remove a child from the name index.
+      /// \param[in] _child Child to remove.
+      private: void UnindexChild(const BasePtr &_child);
+
       /// \brief The SDF values for this object.
       protected: sdf::ElementPtr sdf;
 
@@ -396,6 +421,10 @@ namespace gazebo
       /// \brief Local copy of the scoped name.
       private: std::string scopedName;
 
+      /// \brief Children by name, in the order of the children vector.
+      /// Siblings of different types may share a name.
+      private: std::unordered_map<std::string, Base_V> childrenByName;
+
       protected: friend class Entity;
     };
     /// \}
@@ -40,6 +40,7 @@ void BoxShape::Init()
 void BoxShape::SetSize(const ignition::math::Vector3d &_size)
 {
   this->sdf->GetElement("size")->Set(_size);
+  this->InvalidateBoundingBox();
 }
 
 //////////////////////////////////////////////////
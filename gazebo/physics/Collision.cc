@@ -305,7 +305,7 @@ void Collision::FillMsg(msgs::Collision &_msg)
     _msg.add_visual()->CopyFrom(*this->visualMsg);
     // TODO remove the need to create the special collision visual msg and
     // let the gui handle this.
-    _msg.add_visual()->CopyFrom(this->CreateCollisionVisual());
+    _msg.add_visual()->CopyFrom(this->CreateCollisionVisual(_msg.geometry()));
   }
 }
 
@@ -342,7 +342,8 @@ void Collision::ProcessMsg(const msgs::Collision &_msg)
 }
 
 /////////////////////////////////////////////////
-msgs::Visual Collision::CreateCollisionVisual()
+msgs::Visual Collision::CreateCollisionVisual(
+    const msgs::Geometry &_shapeGeom)
 {
   msgs::Visual msg;
   msg.set_name(this->GetScopedName()+"__COLLISION_VISUAL__");
@@ -359,8 +360,17 @@ msgs::Visual Collision::CreateCollisionVisual()
       "file://media/materials/scripts/gazebo.material");
   msg.mutable_material()->mutable_script()->set_name(
       "Gazebo/OrangeTransparent");
-  msgs::Geometry *geom = msg.mutable_geometry();
-  geom->CopyFrom(msgs::GeometryFromSDF(this->sdf->GetElement("geometry")));
+
+  // Shapes write every change of their geometry to the SDF, so the SDF only
+  // needs converting again when the shape's own message changes.
+  std::string key = _shapeGeom.SerializeAsString();
+  if (key != this->collisionVisualKey || key.empty())
+  {
+    this->collisionVisualGeom =
+        msgs::GeometryFromSDF(this->sdf->GetElement("geometry"));
+    this->collisionVisualKey = key;
+  }
+  msg.mutable_geometry()->CopyFrom(this->collisionVisualGeom);
 
   return msg;
 }
@@ -404,12 +414,22 @@ const ignition::math::Pose3d &Collision::WorldPose() const
   return this->worldPose;
 }
 
+/////////////////////////////////////////////////
+ignition::math::AxisAlignedBox Collision::CachedBoundingBox() const
+{
+  return this->BoundingBoxCache([this]()
+  {
+    return this->BoundingBox();
+  });
+}
+
 /////////////////////////////////////////////////
 void Collision::SetWorldPoseDirty()
 {
   // Tell the collision object that the next call to ::GetWorldPose should
   // compute a new worldPose value.
   this->worldPoseDirty = true;
+  this->InvalidateBoundingBox();
 }
 
 std::optional<sdf::SemanticPose> Collision::SDFSemanticPose() const
@@ -101,6 +101,12 @@ namespace gazebo
       public: virtual ignition::math::AxisAlignedBox BoundingBox() const
           override = 0;
 
+      /// \brief Get the bounding box for this collision from the cache,
+      /// which is refreshed when the collision moves or changes shape.
+      /// \return The bounding box.
+      /// \sa Entity::InvalidateBoundingBox
+      public: ignition::math::AxisAlignedBox CachedBoundingBox() const;
+
       /// \brief Get the shape type.
       /// \return The shape type.
       /// \sa EntityType
@@ -206,8 +212,11 @@ namespace gazebo
                   const override;
 
       /// \brief Helper function used to create a collision visual message.
+      /// \param[in] _shapeGeom Geometry message of the current shape, used
+      /// to tell whether the cached visual geometry is still valid.
       /// \return Visual message for a collision.
-      private: msgs::Visual CreateCollisionVisual();
+      private: msgs::Visual CreateCollisionVisual(
+                   const msgs::Geometry &_shapeGeom);
 
       /// \brief The link this collision belongs to
       protected: LinkPtr link;
@@ -238,6 +247,14 @@ namespace gazebo
 
       /// \brief SDF Collision DOM object
       private: const sdf::Collision *collisionSDFDom = nullptr;
+
+      /// \brief Serialized shape geometry the collision visual geometry was
+      /// last generated for.
+      private: std::string collisionVisualKey;
+
+      /// \brief Collision visual geometry generated from SDF, reused while
+      /// the shape is unchanged.
+      private: msgs::Geometry collisionVisualGeom;
     };
     /// \}
   }
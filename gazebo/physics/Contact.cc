@@ -52,13 +52,10 @@ Contact &Contact::operator =(const Contact &_contact)
   this->collision2 = _contact.collision2;
 
   this->count = _contact.count;
-  for (int i = 0; i < MAX_CONTACT_JOINTS; i++)
-  {
-    this->wrench[i] = _contact.wrench[i];
-    this->positions[i] = _contact.positions[i];
-    this->normals[i] = _contact.normals[i];
-    this->depths[i] = _contact.depths[i];
-  }
+  this->wrench = _contact.wrench;
+  this->positions = _contact.positions;
+  this->normals = _contact.normals;
+  this->depths = _contact.depths;
 
   this->time = _contact.time;
 
@@ -68,7 +65,7 @@ Contact &Contact::operator =(const Contact &_contact)
 //////////////////////////////////////////////////
 Contact &Contact::operator =(const msgs::Contact &_contact)
 {
-  this->count = 0;
+  this->Reset();
 
   this->world = physics::get_world(_contact.world());
 
@@ -87,11 +84,8 @@ Contact &Contact::operator =(const msgs::Contact &_contact)
 
   for (int j = 0; j < _contact.position_size(); ++j)
   {
-    this->positions[j] = msgs::ConvertIgn(_contact.position(j));
-
-    this->normals[j] = msgs::ConvertIgn(_contact.normal(j));
-
-    this->depths[j] = _contact.depth(j);
+    this->AddPoint(msgs::ConvertIgn(_contact.position(j)),
+        msgs::ConvertIgn(_contact.normal(j)), _contact.depth(j));
 
     this->wrench[j].body1Force =
       msgs::ConvertIgn(_contact.wrench(j).body_1_wrench().force());
@@ -104,8 +98,6 @@ Contact &Contact::operator =(const msgs::Contact &_contact)
 
     this->wrench[j].body2Torque =
       msgs::ConvertIgn(_contact.wrench(j).body_2_wrench().torque());
-
-    this->count++;
   }
 
   this->time = msgs::Convert(_contact.time());
@@ -117,6 +109,21 @@ Contact &Contact::operator =(const msgs::Contact &_contact)
 void Contact::Reset()
 {
   this->count = 0;
+  this->wrench.clear();
+  this->positions.clear();
+  this->normals.clear();
+  this->depths.clear();
+}
+
+//////////////////////////////////////////////////
+int Contact::AddPoint(const ignition::math::Vector3d &_position,
+    const ignition::math::Vector3d &_normal, const double _depth)
+{
+  this->wrench.emplace_back();
+  this->positions.push_back(_position);
+  this->normals.push_back(_normal);
+  this->depths.push_back(_depth);
+  return this->count++;
 }
 
 //////////////////////////////////////////////////
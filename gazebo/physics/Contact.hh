@@ -27,7 +27,6 @@
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/util/system.hh"
 
-// For the sake of efficiency, use fixed size arrays for collision
 // MAX_COLLIDE_RETURNS limits contact detection, needs to be large
 //                      for proper contact dynamics.
 // MAX_CONTACT_JOINTS truncates <max_contacts> specified in SDF
@@ -44,7 +43,13 @@ namespace gazebo
 
     /// \class Contact Contact.hh physics/physics.hh
     /// \brief A contact between two collisions. Each contact can consist of
-    /// a number of contact points
+    /// a number of contact points.
+    ///
+    /// The point data is stored as one array per quantity, sized to the
+    /// number of points, so a contact with a single point does not pay for
+    /// MAX_CONTACT_JOINTS of them. Use AddPoint to add a point, which keeps
+    /// the arrays and count in sync. Elements below count can be read and
+    /// written with operator[] as before.
     class GZ_PHYSICS_VISIBLE Contact
     {
       /// \brief Constructor.
@@ -75,9 +80,19 @@ namespace gazebo
       /// \return A string that contains the values of the contact.
       public: std::string DebugString() const;
 
-      /// \brief Reset to default values.
+      /// \brief Reset to default values. Removes all contact points, but
+      /// keeps the memory of the arrays for reuse.
       public: void Reset();
 
+      /// \brief Add a contact point with a zero wrench.
+      /// \param[in] _position Position of the point.
+      /// \param[in] _normal Normal at the point.
+      /// \param[in] _depth Penetration depth at the point.
+      /// \return Index of the new point.
+      public: int AddPoint(const ignition::math::Vector3d &_position,
+                  const ignition::math::Vector3d &_normal,
+                  const double _depth);
+
       /// \brief Pointer to the first collision object
       public: Collision *collision1;
 
@@ -88,16 +103,16 @@ namespace gazebo
       /// All forces and torques are in the world frame.
       /// All forces and torques are relative to the center of mass of the
       /// respective links that the collision elments are attached to.
-      public: JointWrench wrench[MAX_CONTACT_JOINTS];
+      public: std::vector<JointWrench> wrench;
 
       /// \brief Array of force positions.
-      public: ignition::math::Vector3d positions[MAX_CONTACT_JOINTS];
+      public: std::vector<ignition::math::Vector3d> positions;
 
       /// \brief Array of force normals.
-      public: ignition::math::Vector3d normals[MAX_CONTACT_JOINTS];
+      public: std::vector<ignition::math::Vector3d> normals;
 
       /// \brief Array of contact depths
-      public: double depths[MAX_CONTACT_JOINTS];
+      public: std::vector<double> depths;
 
       /// \brief Length of all the arrays.
       public: int count;
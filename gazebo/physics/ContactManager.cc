@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/transport/Node.hh"
@@ -133,6 +135,15 @@ bool ContactManager::SubscribersConnected(Collision *_collision1,
       return true;
     }
   }
+
+  for (const auto &query : this->queries)
+  {
+    if (query->collisions.find(_collision1) != query->collisions.end() ||
+        query->collisions.find(_collision2) != query->collisions.end())
+    {
+      return true;
+    }
+  }
   return false;
 }
 
@@ -206,9 +217,22 @@ Contact *ContactManager::NewContact(Collision *_collision1,
   this->GetCustomPublishers(_collision1, _collision2,
                             getOnlyConnected, publishers);
 
+  std::vector<ContactQuery *> matchingQueries;
+  {
+    boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+    for (const auto &query : this->queries)
+    {
+      if (query->collisions.find(_collision1) != query->collisions.end() ||
+          query->collisions.find(_collision2) != query->collisions.end())
+      {
+        matchingQueries.push_back(query.get());
+      }
+    }
+  }
+
   if (this->NeverDropContacts() ||
       this->contactPub->HasConnections() ||
-      !publishers.empty())
+      !publishers.empty() || !matchingQueries.empty())
   {
     // Get or create a contact feedback object.
     if (this->contactIndex < this->contacts.size())
@@ -217,18 +241,21 @@ Contact *ContactManager::NewContact(Collision *_collision1,
     {
       result = new Contact();
       this->contacts.push_back(result);
+      this->contactMemory.Add(sizeof(Contact), 1);
       this->contactIndex = this->contacts.size();
     }
     for (unsigned int i = 0; i < publishers.size(); ++i)
     {
       publishers[i]->contacts.push_back(result);
     }
+    for (auto query : matchingQueries)
+      query->contacts.push_back(result);
   }
 
   if (!result)
     return result;
 
-  result->count = 0;
+  result->Reset();
   result->collision1 = _collision1;
   result->collision2 = _collision2;
   result->time = _time;
@@ -262,6 +289,10 @@ const std::vector<Contact*> &ContactManager::GetContacts() const
 void ContactManager::ResetCount()
 {
   this->contactIndex = 0;
+
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  for (const auto &query : this->queries)
+    query->contacts.clear();
 }
 
 /////////////////////////////////////////////////
@@ -272,12 +303,16 @@ void ContactManager::Clear()
     delete this->contacts[i];
 
   this->contacts.clear();
+  this->contactMemory.Clear();
 
   boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
   for (iter = this->customContactPublishers.begin();
       iter != this->customContactPublishers.end(); ++iter)
     iter->second->contacts.clear();
 
+  for (const auto &query : this->queries)
+    query->contacts.clear();
+
   // Reset the contact count to zero.
   this->contactIndex = 0;
 }
@@ -285,9 +320,6 @@ void ContactManager::Clear()
 /////////////////////////////////////////////////
 void ContactManager::PublishContacts()
 {
-//  if (this->contacts.size() == 0)
-//    return;
-
   if (!this->contactPub)
   {
     gzerr << "ContactManager has not been initialized. "
@@ -295,21 +327,37 @@ void ContactManager::PublishContacts()
     return;
   }
 
+  const common::Time simTime = this->world->SimTime();
+
+  this->contactsMsg.Clear();
+  this->contactMsgIndex.clear();
+
   // publish to default topic, ~/physics/contacts
-  if (!transport::getMinimalComms())
+  bool publishDefault = !transport::getMinimalComms() &&
+    this->contactPub->HasConnections();
+
+  if (publishDefault && this->publishRate > 0.0)
   {
-    msgs::Contacts msg;
+    // Simulation time moves backwards after a world reset
+    if (simTime < this->lastPublishTime)
+      this->lastPublishTime = simTime;
+    else if (this->lastPublishTime != common::Time::Zero &&
+        (simTime - this->lastPublishTime).Double() < 1.0 / this->publishRate)
+      publishDefault = false;
+  }
+
+  if (publishDefault)
+  {
+    // contactsMsg is empty, so it ends up holding the contacts in order
     for (unsigned int i = 0; i < this->contactIndex; ++i)
     {
-      if (this->contacts[i]->count == 0)
-        continue;
-
-      msgs::Contact *contactMsg = msg.add_contact();
-      this->contacts[i]->FillMsg(*contactMsg);
+      if (this->contacts[i]->count > 0)
+        this->ContactMsgIndex(this->contacts[i]);
     }
 
-    msgs::Set(msg.mutable_time(), this->world->SimTime());
-    this->contactPub->Publish(msg);
+    msgs::Set(this->contactsMsg.mutable_time(), simTime);
+    this->contactPub->Publish(this->contactsMsg);
+    this->lastPublishTime = simTime;
   }
 
   // publish to other custom topics
@@ -319,20 +367,56 @@ void ContactManager::PublishContacts()
       iter != this->customContactPublishers.end(); ++iter)
   {
     ContactPublisher *contactPublisher = iter->second;
-    msgs::Contacts msg2;
-    for (unsigned int j = 0;
-        j < contactPublisher->contacts.size(); ++j)
+    if (contactPublisher->publisher->HasConnections())
     {
-      if (contactPublisher->contacts[j]->count == 0)
-        continue;
+      msgs::Contacts &msg = contactPublisher->msg;
+      msg.Clear();
+      for (unsigned int j = 0;
+          j < contactPublisher->contacts.size(); ++j)
+      {
+        if (contactPublisher->contacts[j]->count == 0)
+          continue;
 
-      msgs::Contact *contactMsg = msg2.add_contact();
-      contactPublisher->contacts[j]->FillMsg(*contactMsg);
+        msg.add_contact()->CopyFrom(this->contactsMsg.contact(
+              this->ContactMsgIndex(contactPublisher->contacts[j])));
+      }
+      msgs::Set(msg.mutable_time(), simTime);
+      contactPublisher->publisher->Publish(msg);
     }
-    msgs::Set(msg2.mutable_time(), this->world->SimTime());
-    contactPublisher->publisher->Publish(msg2);
     contactPublisher->contacts.clear();
   }
+
+  // hand the contacts to in-process readers
+  for (const auto &query : this->queries)
+  {
+    if (query->onContacts)
+      query->onContacts(query->contacts);
+  }
+}
+
+/////////////////////////////////////////////////
+int ContactManager::ContactMsgIndex(Contact *_contact)
+{
+  auto iter = this->contactMsgIndex.find(_contact);
+  if (iter != this->contactMsgIndex.end())
+    return iter->second;
+
+  const int index = this->contactsMsg.contact_size();
+  _contact->FillMsg(*this->contactsMsg.add_contact());
+  this->contactMsgIndex[_contact] = index;
+  return index;
+}
+
+/////////////////////////////////////////////////
+void ContactManager::SetPublishRate(const double _hz)
+{
+  this->publishRate = std::max(_hz, 0.0);
+}
+
+/////////////////////////////////////////////////
+double ContactManager::PublishRate() const
+{
+  return this->publishRate;
 }
 
 /////////////////////////////////////////////////
@@ -445,6 +529,31 @@ void ContactManager::RemoveFilter(const std::string &_name)
   }
 }
 
+/////////////////////////////////////////////////
+ContactQueryPtr ContactManager::CreateQuery(
+    const std::vector<CollisionPtr> &_collisions)
+{
+  ContactQueryPtr query(new ContactQuery);
+  for (const auto &collision : _collisions)
+  {
+    if (collision)
+      query->collisions.insert(collision.get());
+  }
+
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  this->queries.push_back(query);
+  return query;
+}
+
+/////////////////////////////////////////////////
+void ContactManager::RemoveQuery(const ContactQueryPtr &_query)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  this->queries.erase(
+      std::remove(this->queries.begin(), this->queries.end(), _query),
+      this->queries.end());
+}
+
 /////////////////////////////////////////////////
 unsigned int ContactManager::GetFilterCount()
 {
@@ -18,15 +18,20 @@
 #ifndef GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 #define GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 
-#include <vector>
-#include <string>
+#include <functional>
 #include <map>
+#include <memory>
+#include <string>
+#include <vector>
 #include <ignition/transport/Node.hh>
 
 #include <boost/unordered/unordered_set.hpp>
 #include <boost/unordered/unordered_map.hpp>
 #include <boost/thread/recursive_mutex.hpp>
 
+#include "gazebo/common/MemoryStats.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -56,6 +61,10 @@ namespace gazebo
       /// \brief A list of contacts associated to the collisions.
       public: std::vector<Contact *> contacts;
 
+      /// \brief Outgoing contacts message, reused from one publication to
+      /// the next.
+      public: msgs::Contacts msg;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
@@ -63,6 +72,32 @@ namespace gazebo
       public: ignition::transport::Node::Publisher publisherIgn;
     };
 
+    /// \brief Contacts of a set of collisions, gathered by the contact
+    /// manager for in-process readers, such as plugins that run on the
+    /// physics thread. Unlike a filter, a query builds and publishes no
+    /// message. Created by ContactManager::CreateQuery.
+    class GZ_PHYSICS_VISIBLE ContactQuery
+    {
+      /// \brief Collisions whose contacts are gathered.
+      public: boost::unordered_set<Collision *> collisions;
+
+      /// \brief Contacts of the last collision detection that involve at
+      /// least one of the collisions. The contacts are owned by the
+      /// contact manager, and are valid until the next collision detection.
+      public: std::vector<Contact *> contacts;
+
+      /// \brief Optional callback, called on the physics thread by
+      /// ContactManager::PublishContacts once the contacts of a step are
+      /// complete, including their wrenches. It lets readers on other
+      /// threads copy the contacts of every step without any message being
+      /// published. It must not create or remove queries or filters.
+      public: std::function<void(const std::vector<Contact *> &)> onContacts;
+    };
+
+    /// \def ContactQueryPtr
+    /// \brief Shared pointer to a ContactQuery.
+    typedef std::shared_ptr<ContactQuery> ContactQueryPtr;
+
     /// \addtogroup gazebo_physics
     /// \{
 
@@ -160,8 +195,25 @@ namespace gazebo
       public: void Clear();
 
       /// \brief Publish all contacts in a msgs::Contacts message.
+      ///
+      /// Topics without subscribers are skipped, and the default topic,
+      /// ~/physics/contacts, is throttled to PublishRate(). The
+      /// msgs::Contact of each contact is built at most once per call and
+      /// shared by every topic that publishes it.
       public: void PublishContacts();
 
+      /// \brief Set the maximum rate of the default contact topic,
+      /// ~/physics/contacts, in simulation time. Filtered topics created
+      /// by CreateFilter are published every step.
+      /// \param[in] _hz Rate in Hz, zero (the default) to publish every
+      /// step.
+      public: void SetPublishRate(const double _hz);
+
+      /// \brief Get the maximum rate of the default contact topic.
+      /// \return Rate in Hz, zero if the topic is published every step.
+      /// \sa SetPublishRate
+      public: double PublishRate() const;
+
       /// \brief Set the contact count to zero.
       public: void ResetCount();
 
@@ -204,6 +256,22 @@ namespace gazebo
       /// return True if the filter exists.
       public: bool HasFilter(const std::string &_name);
 
+      /// \brief Create a query that gathers the contacts of a set of
+      /// collisions in process, for readers on the physics thread. While the
+      /// query exists, NewContact creates the contacts of its collisions
+      /// even if no one subscribes to the contact topics, so the reader
+      /// doesn't need SetNeverDropContacts.
+      /// \param[in] _collisions Collisions whose contacts are gathered.
+      /// \return The query. Its contacts are refreshed by every collision
+      /// detection.
+      /// \sa RemoveQuery
+      public: ContactQueryPtr CreateQuery(
+                  const std::vector<CollisionPtr> &_collisions);
+
+      /// \brief Remove a query created by CreateQuery.
+      /// \param[in] _query The query.
+      public: void RemoveQuery(const ContactQueryPtr &_query);
+
       /// \brief Helper function which gets the custom publishers which publish
       ///   contacts of either \e _collision1 or \e _collision2.
       /// \param[in] _collision1 the first collision object
@@ -215,10 +283,19 @@ namespace gazebo
                        Collision *_collision2, const bool _getOnlyConnected,
                        std::vector<ContactPublisher*> &_publishers);
 
+      /// \brief Get the index of a contact's message in contactsMsg,
+      /// building the message on first use in a PublishContacts call.
+      /// \param[in] _contact Contact to convert.
+      /// \return Index into contactsMsg.
+      private: int ContactMsgIndex(Contact *_contact);
+
       private: std::vector<Contact*> contacts;
 
       private: unsigned int contactIndex;
 
+      /// \brief Memory held by the contact pool.
+      private: common::MemoryCharge contactMemory{"ContactManager/contacts"};
+
       /// \brief Node for communication.
       private: transport::NodePtr node;
 
@@ -236,6 +313,24 @@ namespace gazebo
       /// \brief Mutex to protect the list of custom publishers.
       private: boost::recursive_mutex *customMutex;
 
+      /// \brief Queries created by CreateQuery, protected by customMutex.
+      private: std::vector<ContactQueryPtr> queries;
+
+      /// \brief Maximum rate of the default contact topic, zero to
+      /// publish every step.
+      private: double publishRate = 0.0;
+
+      /// \brief Simulation time the default contact topic was last
+      /// published.
+      private: common::Time lastPublishTime;
+
+      /// \brief Messages of the contacts converted in the current
+      /// PublishContacts call. Reused between calls to keep allocations.
+      private: msgs::Contacts contactsMsg;
+
+      /// \brief Index into contactsMsg of each converted contact.
+      private: boost::unordered_map<const Contact *, int> contactMsgIndex;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
@@ -15,6 +15,8 @@
  *
 */
 
+#include <atomic>
+
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -194,6 +196,113 @@ TEST_F(ContactManagerTest, NeverDropContacts)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, Query)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  physics::CollisionPtr collision =
+    box->GetLink("link")->GetCollision("collision");
+  ASSERT_TRUE(collision != nullptr);
+
+  physics::ContactQueryPtr query = manager->CreateQuery({collision});
+  ASSERT_TRUE(query != nullptr);
+  EXPECT_TRUE(query->contacts.empty());
+
+  // Contacts of queried collisions are created without subscribers
+  world->Step(1);
+  ASSERT_FALSE(query->contacts.empty());
+  EXPECT_FALSE(manager->NeverDropContacts());
+  EXPECT_EQ(query->contacts.size(), manager->GetContactCount());
+  for (const auto contact : query->contacts)
+  {
+    EXPECT_TRUE(contact->collision1 == collision.get() ||
+        contact->collision2 == collision.get());
+    EXPECT_GT(contact->count, 0);
+  }
+
+  // Each collision detection refreshes the contacts
+  world->Step(1);
+  EXPECT_EQ(query->contacts.size(), manager->GetContactCount());
+
+  // Without the query no contact is created
+  manager->RemoveQuery(query);
+  world->Step(1);
+  EXPECT_EQ(0u, manager->GetContactCount());
+}
+
+/////////////////////////////////////////////////
+std::atomic<int> g_contactMsgCount(0);
+
+/////////////////////////////////////////////////
+void OnContacts(ConstContactsPtr &/*_msg*/)
+{
+  ++g_contactMsgCount;
+}
+
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, PublishRate)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+  EXPECT_DOUBLE_EQ(manager->PublishRate(), 0.0);
+
+  // Negative rates are rejected
+  EXPECT_FALSE(physics->SetParam("contact_publish_rate", -1.0));
+  EXPECT_TRUE(physics->SetParam("contact_publish_rate", std::string("100")));
+  EXPECT_DOUBLE_EQ(
+      boost::any_cast<double>(physics->GetParam("contact_publish_rate")),
+      100.0);
+  EXPECT_DOUBLE_EQ(manager->PublishRate(), 100.0);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub =
+    node->Subscribe("~/physics/contacts", &OnContacts);
+
+  // 100 Hz with a 1 ms step publishes every 10th step
+  const double dt = physics->GetMaxStepSize();
+  ASSERT_DOUBLE_EQ(dt, 0.001);
+  g_contactMsgCount = 0;
+  world->Step(100);
+
+  for (int i = 0; i < 50 && g_contactMsgCount < 10; ++i)
+    common::Time::MSleep(10);
+  common::Time::MSleep(50);
+
+  EXPECT_GE(g_contactMsgCount, 9);
+  EXPECT_LE(g_contactMsgCount, 11);
+
+  // Publish every step again
+  manager->SetPublishRate(0.0);
+  g_contactMsgCount = 0;
+  world->Step(20);
+
+  for (int i = 0; i < 50 && g_contactMsgCount < 20; ++i)
+    common::Time::MSleep(10);
+  EXPECT_EQ(g_contactMsgCount, 20);
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gazebo/physics/Contact.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ContactTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(ContactTest, AddPoint)
+{
+  physics::Contact contact;
+  EXPECT_EQ(contact.count, 0);
+  EXPECT_TRUE(contact.positions.empty());
+
+  EXPECT_EQ(contact.AddPoint(ignition::math::Vector3d(1, 2, 3),
+        ignition::math::Vector3d::UnitZ, 0.1), 0);
+  EXPECT_EQ(contact.AddPoint(ignition::math::Vector3d(4, 5, 6),
+        -ignition::math::Vector3d::UnitZ, 0.2), 1);
+
+  EXPECT_EQ(contact.count, 2);
+  ASSERT_EQ(contact.positions.size(), 2u);
+  ASSERT_EQ(contact.normals.size(), 2u);
+  ASSERT_EQ(contact.depths.size(), 2u);
+  ASSERT_EQ(contact.wrench.size(), 2u);
+
+  EXPECT_EQ(contact.positions[1], ignition::math::Vector3d(4, 5, 6));
+  EXPECT_EQ(contact.normals[1], -ignition::math::Vector3d::UnitZ);
+  EXPECT_DOUBLE_EQ(contact.depths[0], 0.1);
+  EXPECT_EQ(contact.wrench[0].body1Force, ignition::math::Vector3d::Zero);
+
+  // Copies only carry the points in use
+  contact.wrench[1].body2Torque.Set(0, 0, 1);
+  physics::Contact copy(contact);
+  EXPECT_EQ(copy.count, 2);
+  ASSERT_EQ(copy.wrench.size(), 2u);
+  EXPECT_EQ(copy.wrench[1].body2Torque, ignition::math::Vector3d::UnitZ);
+
+  // Reset removes the points but keeps the memory
+  contact.Reset();
+  EXPECT_EQ(contact.count, 0);
+  EXPECT_TRUE(contact.positions.empty());
+  EXPECT_GE(contact.positions.capacity(), 2u);
+
+  EXPECT_EQ(contact.AddPoint(ignition::math::Vector3d::Zero,
+        ignition::math::Vector3d::UnitX, 0.0), 0);
+  EXPECT_EQ(contact.count, 1);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
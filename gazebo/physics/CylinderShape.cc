@@ -64,6 +64,7 @@ void CylinderShape::SetSize(double _radius, double _length)
 {
   this->sdf->GetElement("radius")->Set(_radius);
   this->sdf->GetElement("length")->Set(_length);
+  this->InvalidateBoundingBox();
 }
 
 //////////////////////////////////////////////////
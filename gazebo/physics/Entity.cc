@@ -185,6 +185,34 @@ ignition::math::AxisAlignedBox Entity::BoundingBox() const
       ignition::math::Vector3d::Zero, ignition::math::Vector3d::One);
 }
 
+//////////////////////////////////////////////////
+void Entity::InvalidateBoundingBox()
+{
+  for (Entity *entity = this; entity; entity = entity->parentEntity.get())
+    ++entity->boundingBoxVersion;
+}
+
+//////////////////////////////////////////////////
+ignition::math::AxisAlignedBox Entity::BoundingBoxCache(
+    const std::function<ignition::math::AxisAlignedBox()> &_compute) const
+{
+  const uint64_t version = this->boundingBoxVersion;
+  {
+    std::lock_guard<std::mutex> lock(this->boundingBoxMutex);
+    if (this->cachedBoundingBoxVersion == version)
+      return this->cachedBoundingBox;
+  }
+
+  // Compute without the lock, a pose update during the computation
+  // changes the version and the next call computes the box again.
+  const ignition::math::AxisAlignedBox box = _compute();
+
+  std::lock_guard<std::mutex> lock(this->boundingBoxMutex);
+  this->cachedBoundingBox = box;
+  this->cachedBoundingBoxVersion = version;
+  return box;
+}
+
 //////////////////////////////////////////////////
 void Entity::SetCanonicalLink(bool _value)
 {
@@ -305,6 +333,7 @@ void Entity::SetWorldPoseModel(
   // initialization: (no children?) set own worldPose
   this->worldPose = _pose;
   this->worldPose.Correct();
+  this->InvalidateBoundingBox();
 
   // (OnPoseChange uses GetWorldPose)
   if (_notify)
@@ -425,6 +454,7 @@ void Entity::SetWorldPoseDefault(const ignition::math::Pose3d &_pose,
 {
   this->worldPose = _pose;
   this->worldPose.Correct();
+  this->InvalidateBoundingBox();
 
   if (_notify)
     this->UpdatePhysicsPose(true);
@@ -488,6 +518,12 @@ void Entity::SetWorldPose(const ignition::math::Pose3d &_pose,
     std::lock_guard<std::mutex> lock(this->GetWorld()->WorldPoseMutex());
     (*this.*setWorldPoseFunc)(_pose, _notify, _publish);
   }
+
+  // Let state captures know that the model moved.
+  ModelPtr model = this->GetParentModel();
+  if (model)
+    model->UpdateStateVersion();
+
   if (_publish)
     this->PublishPose();
 }
@@ -529,6 +565,7 @@ void Entity::UpdatePhysicsPose(bool _updateChildren)
         coll->worldPose.Rot() = this->worldPose.Rot() *
           coll->initialRelativePose.Rot();
         coll->OnPoseChange();
+        coll->InvalidateBoundingBox();
       }
       else
       {
@@ -676,6 +713,12 @@ const ignition::math::Pose3d &Entity::DirtyPose() const
   return this->dirtyPose;
 }
 
+//////////////////////////////////////////////////
+void Entity::_PropagateDirtyPose()
+{
+  (*this.*setWorldPoseFunc)(this->dirtyPose, false, false);
+}
+
 //////////////////////////////////////////////////
 ignition::math::AxisAlignedBox Entity::CollisionBoundingBox() const
 {
@@ -688,7 +731,8 @@ ignition::math::AxisAlignedBox Entity::CollisionBoundingBoxHelper(
     BasePtr _base) const
 {
   if (_base->HasType(COLLISION))
-    return boost::dynamic_pointer_cast<Collision>(_base)->BoundingBox();
+    return boost::dynamic_pointer_cast<Collision>(
+        _base)->CachedBoundingBox();
 
   ignition::math::AxisAlignedBox box;
 
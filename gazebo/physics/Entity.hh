@@ -17,6 +17,10 @@
 #ifndef GAZEBO_PHYSICS_ENTITY_HH_
 #define GAZEBO_PHYSICS_ENTITY_HH_
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <ignition/math/AxisAlignedBox.hh>
@@ -97,6 +101,11 @@ namespace gazebo
       /// \return The bounding box.
       public: virtual ignition::math::AxisAlignedBox BoundingBox() const;
 
+      /// \brief Mark the cached bounding boxes of this entity, and of the
+      /// entities it belongs to, out of date. The pose setters call this,
+      /// as do the shapes when their geometry changes.
+      public: void InvalidateBoundingBox();
+
       /// \brief Get the absolute pose of the entity.
       /// \return The absolute pose of the entity.
       public: inline virtual const ignition::math::Pose3d &WorldPose() const
@@ -227,6 +236,14 @@ namespace gazebo
       /// \return The dirty pose of the entity.
       public: const ignition::math::Pose3d &DirtyPose() const;
 
+      /// \internal
+      /// \brief Copy Entity#dirtyPose into the world pose, without
+      /// notifying the physics engine or publishing the pose. This is
+      /// SetWorldPose(DirtyPose(), false, false) except that it does not
+      /// lock World::WorldPoseMutex, which the caller must hold.
+      /// Only World should call this function.
+      public: void _PropagateDirtyPose();
+
       /// \brief This function is called when the entity's
       /// (or one of its parents) pose of the parent has changed.
       protected: virtual void OnPoseChange() = 0;
@@ -278,6 +295,15 @@ namespace gazebo
       /// \param[in] _info Update information.
       private: void UpdateAnimation(const common::UpdateInfo &_info);
 
+      /// \brief Get a bounding box from the cache of the entity.
+      /// \param[in] _compute Function computing the box, called when the
+      /// cache is out of date.
+      /// \return The bounding box.
+      /// \sa InvalidateBoundingBox
+      protected: ignition::math::AxisAlignedBox BoundingBoxCache(
+                     const std::function<ignition::math::AxisAlignedBox()>
+                     &_compute) const;
+
       /// \brief A helper that prevents numerous dynamic_casts.
       protected: EntityPtr parentEntity;
 
@@ -317,6 +343,18 @@ namespace gazebo
       /// \brief Scale of the entity
       protected: ignition::math::Vector3d scale;
 
+      /// \brief Incremented each time the bounding box changes.
+      private: std::atomic<uint64_t> boundingBoxVersion{1};
+
+      /// \brief Version of the cached bounding box, 0 when empty.
+      private: mutable uint64_t cachedBoundingBoxVersion = 0;
+
+      /// \brief Cached bounding box.
+      private: mutable ignition::math::AxisAlignedBox cachedBoundingBox;
+
+      /// \brief Protects the cached bounding box.
+      private: mutable std::mutex boundingBoxMutex;
+
       /// \brief True if the object is static.
       private: bool isStatic;
 
@@ -0,0 +1,1071 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Matrix3.hh>
+#include <ignition/math/Rand.hh>
+
+#include "gazebo/physics/GranularMedia.hh"
+
+namespace
+{
+  /// \brief Number of grains processed together by a thread.
+  const size_t kGrainBlock = 1024;
+
+  /// \brief Fraction of the contact period used as the longest substep.
+  const double kSubstepFraction = 0.1;
+
+  /// \brief Bucket of the cells outside of the dense grid.
+  const uint32_t kNoBucket = std::numeric_limits<uint32_t>::max();
+
+}
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Static half space bounding the grains.
+    struct GranularPlane
+    {
+      /// \brief Unit normal, pointing towards the grains.
+      public: ignition::math::Vector3d normal;
+
+      /// \brief Distance from the origin along the normal.
+      public: double offset = 0;
+    };
+
+    /// \internal
+    /// \brief Rigid body coupled to the grains.
+    struct GranularBody
+    {
+      /// \brief Shapes of bodies.
+      public: enum Shape {SPHERE, BOX, CYLINDER};
+
+      /// \brief Shape of the body.
+      public: Shape shape = SPHERE;
+
+      /// \brief Radius of a sphere or a cylinder.
+      public: double radius = 0;
+
+      /// \brief Half size of a box, or half length of a cylinder along z.
+      public: ignition::math::Vector3d halfSize;
+
+      /// \brief World pose of the center.
+      public: ignition::math::Pose3d pose;
+
+      /// \brief World linear velocity of the center.
+      public: ignition::math::Vector3d linearVel;
+
+      /// \brief World angular velocity.
+      public: ignition::math::Vector3d angularVel;
+
+      /// \brief Force summed over the substeps of the current step.
+      public: ignition::math::Vector3d forceSum;
+
+      /// \brief Torque summed over the substeps of the current step.
+      public: ignition::math::Vector3d torqueSum;
+
+      /// \brief Force averaged over the last step.
+      public: ignition::math::Vector3d force;
+
+      /// \brief Torque averaged over the last step.
+      public: ignition::math::Vector3d torque;
+    };
+
+    /// \internal
+    /// \brief Private data for the GranularMedia class
+    class GranularMediaPrivate
+    {
+      /// \brief Get the damping of a contact.
+      /// \param[in] _mass Effective mass of the contact.
+      /// \return Damping coefficient in N.s/m.
+      public: double Damping(const double _mass) const;
+
+      /// \brief Get the force of a contact on a grain.
+      /// \param[in] _normal Unit normal, pointing towards the grain.
+      /// \param[in] _depth Overlap of the grain and the other object.
+      /// \param[in] _vel Velocity of the grain relative to the other
+      /// object.
+      /// \param[in] _mass Effective mass of the contact.
+      /// \return Force on the grain, zero if the objects separate.
+      public: ignition::math::Vector3d ContactForce(
+                  const ignition::math::Vector3d &_normal,
+                  const double _depth, const ignition::math::Vector3d &_vel,
+                  const double _mass) const;
+
+      /// \brief Sort the grains into the buckets of the spatial hash.
+      public: void BuildHash();
+
+      /// \brief Get the cell of a location.
+      /// \param[in] _x Location along x.
+      /// \param[in] _y Location along y.
+      /// \param[in] _z Location along z.
+      /// \param[out] _cell Cell coordinates.
+      public: void Cell(const double _x, const double _y, const double _z,
+                  int64_t _cell[3]) const;
+
+      /// \brief Get the bucket of a cell.
+      /// \param[in] _x Cell coordinate along x.
+      /// \param[in] _y Cell coordinate along y.
+      /// \param[in] _z Cell coordinate along z.
+      /// \return Bucket, kNoBucket if the cell is outside of the dense grid
+      /// and holds no grain.
+      public: uint32_t Bucket(const int64_t _x, const int64_t _y,
+                  const int64_t _z) const;
+
+      /// \brief Compute the forces of the other grains and of the planes
+      /// on a range of grains.
+      /// \param[in] _begin First grain.
+      /// \param[in] _end One past the last grain.
+      /// \return Number of contacts.
+      public: uint64_t GrainForces(const size_t _begin, const size_t _end);
+
+      /// \brief Add the contact forces between the grains and a body.
+      /// \param[in] _body The body.
+      /// \return Number of contacts.
+      public: uint64_t BodyForces(GranularBody &_body);
+
+      /// \brief Find the contact between a grain and a body.
+      /// \param[in] _body The body.
+      /// \param[in] _pos Center of the grain.
+      /// \param[in] _radius Radius of the grain.
+      /// \param[out] _normal Unit normal, pointing towards the grain.
+      /// \param[out] _depth Overlap of the grain and the body.
+      /// \return True if they overlap.
+      public: static bool BodyContact(const GranularBody &_body,
+                  const ignition::math::Vector3d &_pos, const double _radius,
+                  ignition::math::Vector3d &_normal, double &_depth);
+
+      /// \brief Advance a range of grains by a substep.
+      /// \param[in] _begin First grain.
+      /// \param[in] _end One past the last grain.
+      /// \param[in] _dt Substep in seconds.
+      public: void Integrate(const size_t _begin, const size_t _end,
+                  const double _dt);
+
+      /// \brief Density of the grains.
+      public: double density = 2600;
+
+      /// \brief Normal stiffness of the contacts.
+      public: double stiffness = 1e4;
+
+      /// \brief Coefficient of restitution.
+      public: double restitution = 0.3;
+
+      /// \brief Damping ratio matching the restitution.
+      public: double dampingRatio = 0;
+
+      /// \brief Coulomb friction coefficient.
+      public: double friction = 0.5;
+
+      /// \brief Gravity.
+      public: ignition::math::Vector3d gravity{0, 0, -9.8};
+
+      /// \brief Grain coordinates, one array per axis so that the loops
+      /// over the grains vectorize.
+      public: std::vector<double> px, py, pz;
+
+      /// \brief Grain velocities.
+      public: std::vector<double> vx, vy, vz;
+
+      /// \brief Forces on the grains in the current substep.
+      public: std::vector<double> fx, fy, fz;
+
+      /// \brief Grain radii.
+      public: std::vector<double> radius;
+
+      /// \brief Inverse of the grain masses.
+      public: std::vector<double> invMass;
+
+      /// \brief Radius of the largest grain.
+      public: double maxRadius = 0;
+
+      /// \brief Mass of the lightest grain.
+      public: double minMass = std::numeric_limits<double>::max();
+
+      /// \brief Inverse of the size of the cells of the spatial hash.
+      public: double invCellSize = 1;
+
+      /// \brief True if the buckets are the cells of a dense grid around
+      /// the grains, false if the cells are hashed into the buckets.
+      public: bool dense = false;
+
+      /// \brief First cell of the dense grid.
+      public: int64_t gridMin[3] = {0, 0, 0};
+
+      /// \brief Number of cells of the dense grid along each axis.
+      public: int64_t gridSize[3] = {0, 0, 0};
+
+      /// \brief Number of buckets minus one, a power of two minus one,
+      /// when hashing.
+      public: uint32_t bucketMask = 0;
+
+      /// \brief Bucket of each grain.
+      public: std::vector<uint32_t> grainBucket;
+
+      /// \brief Index in sortedGrains of the first grain of each bucket.
+      /// The last element is the number of grains.
+      public: std::vector<uint32_t> bucketStart;
+
+      /// \brief Grains sorted by bucket.
+      public: std::vector<uint32_t> sortedGrains;
+
+      /// \brief Last body query that visited each bucket, so that buckets
+      /// shared by several cells are visited once.
+      public: std::vector<uint32_t> bucketVisit;
+
+      /// \brief Number of body queries.
+      public: uint32_t visitCount = 0;
+
+      /// \brief Static half spaces.
+      public: std::vector<GranularPlane> planes;
+
+      /// \brief Rigid bodies.
+      public: std::vector<GranularBody> bodies;
+
+      /// \brief Number of contacts in the last substep.
+      public: uint64_t contactCount = 0;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+double GranularMediaPrivate::Damping(const double _mass) const
+{
+  return 2.0 * this->dampingRatio * std::sqrt(this->stiffness * _mass);
+}
+
+/////////////////////////////////////////////////
+ignition::math::Vector3d GranularMediaPrivate::ContactForce(
+    const ignition::math::Vector3d &_normal, const double _depth,
+    const ignition::math::Vector3d &_vel, const double _mass) const
+{
+  const double damping = this->Damping(_mass);
+  const double normalVel = _vel.Dot(_normal);
+
+  // Spring and dashpot, which never pull the objects together.
+  const double normalForce = this->stiffness * _depth - damping * normalVel;
+  if (normalForce <= 0)
+    return ignition::math::Vector3d::Zero;
+
+  ignition::math::Vector3d force = normalForce * _normal;
+
+  // Viscous friction up to the Coulomb limit.
+  const ignition::math::Vector3d tangentVel = _vel - normalVel * _normal;
+  const double tangentSpeed = tangentVel.Length();
+  if (tangentSpeed > 1e-12)
+  {
+    const double friction =
+        std::min(this->friction * normalForce, damping * tangentSpeed);
+    force -= tangentVel * (friction / tangentSpeed);
+  }
+  return force;
+}
+
+/////////////////////////////////////////////////
+void GranularMediaPrivate::Cell(const double _x, const double _y,
+    const double _z, int64_t _cell[3]) const
+{
+  _cell[0] = static_cast<int64_t>(std::floor(_x * this->invCellSize));
+  _cell[1] = static_cast<int64_t>(std::floor(_y * this->invCellSize));
+  _cell[2] = static_cast<int64_t>(std::floor(_z * this->invCellSize));
+}
+
+/////////////////////////////////////////////////
+uint32_t GranularMediaPrivate::Bucket(const int64_t _x, const int64_t _y,
+    const int64_t _z) const
+{
+  if (this->dense)
+  {
+    const int64_t x = _x - this->gridMin[0];
+    const int64_t y = _y - this->gridMin[1];
+    const int64_t z = _z - this->gridMin[2];
+    if (x < 0 || y < 0 || z < 0 || x >= this->gridSize[0] ||
+        y >= this->gridSize[1] || z >= this->gridSize[2])
+    {
+      return kNoBucket;
+    }
+    return static_cast<uint32_t>(
+        x + this->gridSize[0] * (y + this->gridSize[1] * z));
+  }
+
+  return static_cast<uint32_t>((_x * 73856093) ^ (_y * 19349663) ^
+      (_z * 83492791)) & this->bucketMask;
+}
+
+/////////////////////////////////////////////////
+void GranularMediaPrivate::BuildHash()
+{
+  const size_t count = this->px.size();
+  this->invCellSize = 1.0 / (2.0 * this->maxRadius);
+
+  // Packed grains fill most of their bounding box. A dense grid over it
+  // keeps neighboring cells next to each other in memory, which is much
+  // faster than hashing. Grains spread far apart are hashed instead.
+  int64_t minCell[3];
+  int64_t maxCell[3];
+  this->Cell(this->px[0], this->py[0], this->pz[0], minCell);
+  std::copy(minCell, minCell + 3, maxCell);
+  for (size_t i = 1; i < count; ++i)
+  {
+    int64_t cell[3];
+    this->Cell(this->px[i], this->py[i], this->pz[i], cell);
+    for (int a = 0; a < 3; ++a)
+    {
+      minCell[a] = std::min(minCell[a], cell[a]);
+      maxCell[a] = std::max(maxCell[a], cell[a]);
+    }
+  }
+
+  double cells = 1;
+  for (int a = 0; a < 3; ++a)
+  {
+    this->gridMin[a] = minCell[a];
+    this->gridSize[a] = maxCell[a] - minCell[a] + 1;
+    cells *= static_cast<double>(this->gridSize[a]);
+  }
+
+  uint32_t buckets;
+  this->dense = cells <= 4.0 * count + 64;
+  if (this->dense)
+  {
+    buckets = static_cast<uint32_t>(cells);
+  }
+  else
+  {
+    buckets = 64;
+    while (buckets < 2 * count)
+      buckets *= 2;
+    this->bucketMask = buckets - 1;
+  }
+
+  // Counting sort of the grains by bucket.
+  this->grainBucket.resize(count);
+  this->bucketStart.assign(buckets + 1, 0);
+  for (size_t i = 0; i < count; ++i)
+  {
+    int64_t cell[3];
+    this->Cell(this->px[i], this->py[i], this->pz[i], cell);
+    const uint32_t bucket = this->Bucket(cell[0], cell[1], cell[2]);
+    this->grainBucket[i] = bucket;
+    ++this->bucketStart[bucket + 1];
+  }
+
+  for (uint32_t b = 0; b < buckets; ++b)
+    this->bucketStart[b + 1] += this->bucketStart[b];
+
+  this->sortedGrains.resize(count);
+  std::vector<uint32_t> next(this->bucketStart.begin(),
+      this->bucketStart.end() - 1);
+  for (size_t i = 0; i < count; ++i)
+    this->sortedGrains[next[this->grainBucket[i]]++] =
+        static_cast<uint32_t>(i);
+
+  if (this->bucketVisit.size() != buckets)
+  {
+    this->bucketVisit.assign(buckets, 0);
+    this->visitCount = 0;
+  }
+}
+
+/////////////////////////////////////////////////
+uint64_t GranularMediaPrivate::GrainForces(const size_t _begin,
+    const size_t _end)
+{
+  uint64_t contacts = 0;
+  for (size_t i = _begin; i < _end; ++i)
+  {
+    const ignition::math::Vector3d pos(this->px[i], this->py[i], this->pz[i]);
+    const ignition::math::Vector3d vel(this->vx[i], this->vy[i], this->vz[i]);
+    const double r = this->radius[i];
+    const double invMassI = this->invMass[i];
+    ignition::math::Vector3d force;
+
+    // The other grains in the 27 cells around the grain. Hashed cells that
+    // share a bucket are visited once.
+    int64_t cell[3];
+    this->Cell(pos.X(), pos.Y(), pos.Z(), cell);
+    uint32_t visited[27];
+    int visitedCount = 0;
+    for (int64_t dz = -1; dz <= 1; ++dz)
+    {
+      for (int64_t dy = -1; dy <= 1; ++dy)
+      {
+        for (int64_t dx = -1; dx <= 1; ++dx)
+        {
+          const uint32_t bucket =
+              this->Bucket(cell[0] + dx, cell[1] + dy, cell[2] + dz);
+          if (bucket == kNoBucket)
+            continue;
+
+          if (!this->dense)
+          {
+            if (std::find(visited, visited + visitedCount, bucket) !=
+                visited + visitedCount)
+            {
+              continue;
+            }
+            visited[visitedCount++] = bucket;
+          }
+
+          for (uint32_t s = this->bucketStart[bucket];
+               s < this->bucketStart[bucket + 1]; ++s)
+          {
+            const uint32_t j = this->sortedGrains[s];
+            if (j == i)
+              continue;
+
+            const double ddx = pos.X() - this->px[j];
+            const double ddy = pos.Y() - this->py[j];
+            const double ddz = pos.Z() - this->pz[j];
+            const double reach = r + this->radius[j];
+            const double dist2 = ddx * ddx + ddy * ddy + ddz * ddz;
+            if (dist2 >= reach * reach)
+              continue;
+
+            // Each grain of a pair computes its own, opposite, force, so
+            // that the grains can be processed in parallel.
+            const double dist = std::sqrt(dist2);
+            ignition::math::Vector3d normal;
+            if (dist > 1e-12)
+              normal.Set(ddx / dist, ddy / dist, ddz / dist);
+            else
+              normal.Set(0, 0, i < j ? -1 : 1);
+
+            const ignition::math::Vector3d relVel = vel -
+                ignition::math::Vector3d(this->vx[j], this->vy[j],
+                    this->vz[j]);
+            force += this->ContactForce(normal, reach - dist, relVel,
+                1.0 / (invMassI + this->invMass[j]));
+            ++contacts;
+          }
+        }
+      }
+    }
+
+    for (auto const &plane : this->planes)
+    {
+      const double depth = r - (plane.normal.Dot(pos) - plane.offset);
+      if (depth > 0)
+      {
+        force += this->ContactForce(plane.normal, depth, vel,
+            1.0 / invMassI);
+        ++contacts;
+      }
+    }
+
+    this->fx[i] = force.X();
+    this->fy[i] = force.Y();
+    this->fz[i] = force.Z();
+  }
+  return contacts;
+}
+
+/////////////////////////////////////////////////
+bool GranularMediaPrivate::BodyContact(const GranularBody &_body,
+    const ignition::math::Vector3d &_pos, const double _radius,
+    ignition::math::Vector3d &_normal, double &_depth)
+{
+  const ignition::math::Vector3d offset = _pos - _body.pose.Pos();
+  if (_body.shape == GranularBody::SPHERE)
+  {
+    const double dist = offset.Length();
+    _depth = _body.radius + _radius - dist;
+    if (_depth <= 0)
+      return false;
+    _normal = dist > 1e-12 ? offset / dist : ignition::math::Vector3d::UnitZ;
+    return true;
+  }
+
+  const ignition::math::Vector3d local =
+      _body.pose.Rot().RotateVectorReverse(offset);
+  const ignition::math::Vector3d &half = _body.halfSize;
+  ignition::math::Vector3d closest;
+  ignition::math::Vector3d localNormal;
+
+  if (_body.shape == GranularBody::BOX)
+  {
+    closest.Set(
+        ignition::math::clamp(local.X(), -half.X(), half.X()),
+        ignition::math::clamp(local.Y(), -half.Y(), half.Y()),
+        ignition::math::clamp(local.Z(), -half.Z(), half.Z()));
+
+    if (closest == local)
+    {
+      // Center inside the box, push out through the closest face.
+      int axis = 0;
+      double gap = half.X() - std::abs(local.X());
+      for (int a = 1; a < 3; ++a)
+      {
+        if (half[a] - std::abs(local[a]) < gap)
+        {
+          gap = half[a] - std::abs(local[a]);
+          axis = a;
+        }
+      }
+      localNormal[axis] = local[axis] < 0 ? -1 : 1;
+      _depth = _radius + gap;
+      _normal = _body.pose.Rot().RotateVector(localNormal);
+      return true;
+    }
+  }
+  else
+  {
+    // Cylinder along z.
+    const double radial = std::hypot(local.X(), local.Y());
+    const ignition::math::Vector3d dir = radial > 1e-12 ?
+        ignition::math::Vector3d(local.X() / radial, local.Y() / radial, 0) :
+        ignition::math::Vector3d::UnitX;
+
+    if (radial <= _body.radius && std::abs(local.Z()) <= half.Z())
+    {
+      // Center inside the cylinder, push out through the closest surface.
+      const double radialGap = _body.radius - radial;
+      const double axialGap = half.Z() - std::abs(local.Z());
+      if (radialGap < axialGap)
+      {
+        localNormal = dir;
+        _depth = _radius + radialGap;
+      }
+      else
+      {
+        localNormal.Z(local.Z() < 0 ? -1 : 1);
+        _depth = _radius + axialGap;
+      }
+      _normal = _body.pose.Rot().RotateVector(localNormal);
+      return true;
+    }
+
+    closest = dir * std::min(radial, _body.radius);
+    closest.Z(ignition::math::clamp(local.Z(), -half.Z(), half.Z()));
+  }
+
+  const ignition::math::Vector3d gap = local - closest;
+  const double dist = gap.Length();
+  _depth = _radius - dist;
+  if (_depth <= 0 || dist <= 1e-12)
+    return false;
+
+  _normal = _body.pose.Rot().RotateVector(gap / dist);
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint64_t GranularMediaPrivate::BodyForces(GranularBody &_body)
+{
+  // World bounding box of the body.
+  ignition::math::Vector3d extent;
+  if (_body.shape == GranularBody::SPHERE)
+  {
+    extent.Set(_body.radius, _body.radius, _body.radius);
+  }
+  else
+  {
+    ignition::math::Vector3d half = _body.halfSize;
+    if (_body.shape == GranularBody::CYLINDER)
+      half.Set(_body.radius, _body.radius, half.Z());
+
+    const ignition::math::Matrix3d rot(_body.pose.Rot());
+    for (int a = 0; a < 3; ++a)
+    {
+      extent[a] = std::abs(rot(a, 0)) * half.X() +
+          std::abs(rot(a, 1)) * half.Y() + std::abs(rot(a, 2)) * half.Z();
+    }
+  }
+  extent += ignition::math::Vector3d(this->maxRadius, this->maxRadius,
+      this->maxRadius);
+
+  const ignition::math::Vector3d center = _body.pose.Pos();
+  const ignition::math::Vector3d low = center - extent;
+  const ignition::math::Vector3d high = center + extent;
+  int64_t minCell[3];
+  int64_t maxCell[3];
+  this->Cell(low.X(), low.Y(), low.Z(), minCell);
+  this->Cell(high.X(), high.Y(), high.Z(), maxCell);
+  double cellCount = 1;
+  for (int a = 0; a < 3; ++a)
+  {
+    // Cells of the dense grid only, the others hold no grain.
+    if (this->dense)
+    {
+      minCell[a] = std::max(minCell[a], this->gridMin[a]);
+      maxCell[a] = std::min(maxCell[a],
+          this->gridMin[a] + this->gridSize[a] - 1);
+      if (maxCell[a] < minCell[a])
+        return 0;
+    }
+    cellCount *= static_cast<double>(maxCell[a] - minCell[a] + 1);
+  }
+
+  uint64_t contacts = 0;
+  auto contact = [&](const uint32_t _i)
+  {
+    const ignition::math::Vector3d pos(
+        this->px[_i], this->py[_i], this->pz[_i]);
+    ignition::math::Vector3d normal;
+    double depth;
+    if (!BodyContact(_body, pos, this->radius[_i], normal, depth))
+      return;
+
+    const ignition::math::Vector3d point = pos - normal * this->radius[_i];
+    const ignition::math::Vector3d arm = point - center;
+    const ignition::math::Vector3d bodyVel =
+        _body.linearVel + _body.angularVel.Cross(arm);
+    const ignition::math::Vector3d relVel = ignition::math::Vector3d(
+        this->vx[_i], this->vy[_i], this->vz[_i]) - bodyVel;
+
+    // The body is much heavier than a grain.
+    const ignition::math::Vector3d force = this->ContactForce(normal, depth,
+        relVel, 1.0 / this->invMass[_i]);
+
+    this->fx[_i] += force.X();
+    this->fy[_i] += force.Y();
+    this->fz[_i] += force.Z();
+    _body.forceSum -= force;
+    _body.torqueSum -= arm.Cross(force);
+    ++contacts;
+  };
+
+  // Large bodies, such as a bin holding all the grains, check every grain
+  // rather than every cell they overlap.
+  if (cellCount > static_cast<double>(this->px.size()))
+  {
+    for (size_t i = 0; i < this->px.size(); ++i)
+      contact(static_cast<uint32_t>(i));
+    return contacts;
+  }
+
+  const uint32_t visit = ++this->visitCount;
+  for (int64_t z = minCell[2]; z <= maxCell[2]; ++z)
+  {
+    for (int64_t y = minCell[1]; y <= maxCell[1]; ++y)
+    {
+      for (int64_t x = minCell[0]; x <= maxCell[0]; ++x)
+      {
+        const uint32_t bucket = this->Bucket(x, y, z);
+        if (this->bucketVisit[bucket] == visit)
+          continue;
+        this->bucketVisit[bucket] = visit;
+
+        for (uint32_t s = this->bucketStart[bucket];
+             s < this->bucketStart[bucket + 1]; ++s)
+        {
+          contact(this->sortedGrains[s]);
+        }
+      }
+    }
+  }
+  return contacts;
+}
+
+/////////////////////////////////////////////////
+void GranularMediaPrivate::Integrate(const size_t _begin, const size_t _end,
+    const double _dt)
+{
+  const double gx = this->gravity.X();
+  const double gy = this->gravity.Y();
+  const double gz = this->gravity.Z();
+
+  // Semi-implicit Euler over plain arrays.
+  double *posX = this->px.data();
+  double *posY = this->py.data();
+  double *posZ = this->pz.data();
+  double *velX = this->vx.data();
+  double *velY = this->vy.data();
+  double *velZ = this->vz.data();
+  const double *forceX = this->fx.data();
+  const double *forceY = this->fy.data();
+  const double *forceZ = this->fz.data();
+  const double *inv = this->invMass.data();
+  for (size_t i = _begin; i < _end; ++i)
+  {
+    velX[i] += _dt * (forceX[i] * inv[i] + gx);
+    velY[i] += _dt * (forceY[i] * inv[i] + gy);
+    velZ[i] += _dt * (forceZ[i] * inv[i] + gz);
+    posX[i] += _dt * velX[i];
+    posY[i] += _dt * velY[i];
+    posZ[i] += _dt * velZ[i];
+  }
+}
+
+/////////////////////////////////////////////////
+GranularMedia::GranularMedia()
+  : dataPtr(new GranularMediaPrivate)
+{
+  this->SetRestitution(this->dataPtr->restitution);
+}
+
+/////////////////////////////////////////////////
+GranularMedia::~GranularMedia()
+{
+}
+
+/////////////////////////////////////////////////
+void GranularMedia::SetDensity(const double _density)
+{
+  if (_density > 0)
+    this->dataPtr->density = _density;
+}
+
+/////////////////////////////////////////////////
+double GranularMedia::Density() const
+{
+  return this->dataPtr->density;
+}
+
+/////////////////////////////////////////////////
+void GranularMedia::SetStiffness(const double _stiffness)
+{
+  if (_stiffness > 0)
+    this->dataPtr->stiffness = _stiffness;
+}
+
+/////////////////////////////////////////////////
+double GranularMedia::Stiffness() const
+{
+  return this->dataPtr->stiffness;
+}
+
+/////////////////////////////////////////////////
+void GranularMedia::SetRestitution(const double _restitution)
+{
+  this->dataPtr->restitution = ignition::math::clamp(_restitution, 0.0, 1.0);
+
+  // Damping ratio of a linear spring and dashpot with this restitution.
+  const double e = std::max(this->dataPtr->restitution, 1e-3);
+  const double logE = std::log(e);
+  this->dataPtr->dampingRatio = -logE / std::sqrt(M_PI * M_PI + logE * logE);
+}
+
+/////////////////////////////////////////////////
+double GranularMedia::Restitution() const
+{
+  return this->dataPtr->restitution;
+}
+
+/////////////////////////////////////////////////
+void GranularMedia::SetFriction(const double _friction)
+{
+  this->dataPtr->friction = std::max(_friction, 0.0);
+}
+
+/////////////////////////////////////////////////
+double GranularMedia::Friction() const
+{
+  return this->dataPtr->friction;
+}
+
+/////////////////////////////////////////////////
+void GranularMedia::SetGravity(const ignition::math::Vector3d &_gravity)
+{
+  this->dataPtr->gravity = _gravity;
+}
+
+/////////////////////////////////////////////////
+ignition::math::Vector3d GranularMedia::Gravity() const
+{
+  return this->dataPtr->gravity;
+}
+
+/////////////////////////////////////////////////
+size_t GranularMedia::AddGrain(const ignition::math::Vector3d &_pos,
+    const double _radius, const ignition::math::Vector3d &_vel)
+{
+  const double radius = std::max(_radius, 1e-6);
+  const double mass =
+      this->dataPtr->density * 4.0 / 3.0 * M_PI * radius * radius * radius;
+
+  this->dataPtr->px.push_back(_pos.X());
+  this->dataPtr->py.push_back(_pos.Y());
+  this->dataPtr->pz.push_back(_pos.Z());
+  this->dataPtr->vx.push_back(_vel.X());
+  this->dataPtr->vy.push_back(_vel.Y());
+  this->dataPtr->vz.push_back(_vel.Z());
+  this->dataPtr->fx.push_back(0);
+  this->dataPtr->fy.push_back(0);
+  this->dataPtr->fz.push_back(0);
+  this->dataPtr->radius.push_back(radius);
+  this->dataPtr->invMass.push_back(1.0 / mass);
+
+  this->dataPtr->maxRadius = std::max(this->dataPtr->maxRadius, radius);
+  this->dataPtr->minMass = std::min(this->dataPtr->minMass, mass);
+  return this->dataPtr->px.size() - 1;
+}
+
+/////////////////////////////////////////////////
+size_t GranularMedia::FillBox(const ignition::math::Vector3d &_min,
+    const ignition::math::Vector3d &_max, const double _radius,
+    const double _jitter)
+{
+  if (_radius <= 0)
+    return 0;
+
+  // Lattice spaced so that jittered neighbors never overlap.
+  const double jitter = ignition::math::clamp(_jitter, 0.0, 1.0) * _radius;
+  const double spacing = 2.0 * _radius + 2.0 * jitter;
+  const ignition::math::Vector3d size = _max - _min;
+  size_t counts[3];
+  for (int a = 0; a < 3; ++a)
+  {
+    counts[a] = size[a] >= 2.0 * _radius ?
+        static_cast<size_t>((size[a] - 2.0 * _radius) / spacing) + 1 : 0;
+  }
+
+  size_t added = 0;
+  for (size_t z = 0; z < counts[2]; ++z)
+  {
+    for (size_t y = 0; y < counts[1]; ++y)
+    {
+      for (size_t x = 0; x < counts[0]; ++x)
+      {
+        ignition::math::Vector3d pos = _min + ignition::math::Vector3d(
+            _radius + x * spacing, _radius + y * spacing,
+            _radius + z * spacing);
+        if (jitter > 0)
+        {
+          pos += ignition::math::Vector3d(
+              ignition::math::Rand::DblUniform(-jitter, jitter),
+              ignition::math::Rand::DblUniform(-jitter, jitter),
+              ignition::math::Rand::DblUniform(-jitter, jitter));
+        }
+        this->AddGrain(pos, _radius);
+        ++added;
+      }
+    }
+  }
+  return added;
+}
+
+/////////////////////////////////////////////////
+void GranularMedia::ClearGrains()
+{
+  for (auto *array : {&this->dataPtr->px, &this->dataPtr->py,
+       &this->dataPtr->pz, &this->dataPtr->vx, &this->dataPtr->vy,
+       &this->dataPtr->vz, &this->dataPtr->fx, &this->dataPtr->fy,
+       &this->dataPtr->fz, &this->dataPtr->radius, &this->dataPtr->invMass})
+  {
+    array->clear();
+  }
+  this->dataPtr->maxRadius = 0;
+  this->dataPtr->minMass = std::numeric_limits<double>::max();
+}
+
+/////////////////////////////////////////////////
+size_t GranularMedia::GrainCount() const
+{
+  return this->dataPtr->px.size();
+}
+
+/////////////////////////////////////////////////
+ignition::math::Vector3d GranularMedia::GrainPosition(
+    const size_t _index) const
+{
+  if (_index >= this->dataPtr->px.size())
+    return ignition::math::Vector3d::Zero;
+
+  return ignition::math::Vector3d(this->dataPtr->px[_index],
+      this->dataPtr->py[_index], this->dataPtr->pz[_index]);
+}
+
+/////////////////////////////////////////////////
+ignition::math::Vector3d GranularMedia::GrainVelocity(
+    const size_t _index) const
+{
+  if (_index >= this->dataPtr->vx.size())
+    return ignition::math::Vector3d::Zero;
+
+  return ignition::math::Vector3d(this->dataPtr->vx[_index],
+      this->dataPtr->vy[_index], this->dataPtr->vz[_index]);
+}
+
+/////////////////////////////////////////////////
+void GranularMedia::GrainPositions(
+    std::vector<ignition::math::Vector3d> &_positions) const
+{
+  _positions.resize(this->dataPtr->px.size());
+  for (size_t i = 0; i < _positions.size(); ++i)
+  {
+    _positions[i].Set(this->dataPtr->px[i], this->dataPtr->py[i],
+        this->dataPtr->pz[i]);
+  }
+}
+
+/////////////////////////////////////////////////
+void GranularMedia::AddPlane(const ignition::math::Vector3d &_normal,
+    const double _offset)
+{
+  if (_normal.Length() <= 1e-12)
+    return;
+
+  GranularPlane plane;
+  plane.normal = _normal.Normalized();
+  plane.offset = _offset;
+  this->dataPtr->planes.push_back(plane);
+}
+
+/////////////////////////////////////////////////
+size_t GranularMedia::AddSphereBody(const double _radius)
+{
+  GranularBody body;
+  body.shape = GranularBody::SPHERE;
+  body.radius = std::max(_radius, 0.0);
+  this->dataPtr->bodies.push_back(body);
+  return this->dataPtr->bodies.size() - 1;
+}
+
+/////////////////////////////////////////////////
+size_t GranularMedia::AddBoxBody(const ignition::math::Vector3d &_size)
+{
+  GranularBody body;
+  body.shape = GranularBody::BOX;
+  body.halfSize = _size.Abs() * 0.5;
+  this->dataPtr->bodies.push_back(body);
+  return this->dataPtr->bodies.size() - 1;
+}
+
+/////////////////////////////////////////////////
+size_t GranularMedia::AddCylinderBody(const double _radius,
+    const double _length)
+{
+  GranularBody body;
+  body.shape = GranularBody::CYLINDER;
+  body.radius = std::max(_radius, 0.0);
+  body.halfSize.Set(0, 0, std::abs(_length) * 0.5);
+  this->dataPtr->bodies.push_back(body);
+  return this->dataPtr->bodies.size() - 1;
+}
+
+/////////////////////////////////////////////////
+size_t GranularMedia::BodyCount() const
+{
+  return this->dataPtr->bodies.size();
+}
+
+/////////////////////////////////////////////////
+void GranularMedia::SetBodyState(const size_t _index,
+    const ignition::math::Pose3d &_pose,
+    const ignition::math::Vector3d &_linearVel,
+    const ignition::math::Vector3d &_angularVel)
+{
+  if (_index >= this->dataPtr->bodies.size())
+    return;
+
+  GranularBody &body = this->dataPtr->bodies[_index];
+  body.pose = _pose;
+  body.linearVel = _linearVel;
+  body.angularVel = _angularVel;
+}
+
+/////////////////////////////////////////////////
+ignition::math::Vector3d GranularMedia::BodyForce(const size_t _index) const
+{
+  if (_index >= this->dataPtr->bodies.size())
+    return ignition::math::Vector3d::Zero;
+  return this->dataPtr->bodies[_index].force;
+}
+
+/////////////////////////////////////////////////
+ignition::math::Vector3d GranularMedia::BodyTorque(const size_t _index) const
+{
+  if (_index >= this->dataPtr->bodies.size())
+    return ignition::math::Vector3d::Zero;
+  return this->dataPtr->bodies[_index].torque;
+}
+
+/////////////////////////////////////////////////
+double GranularMedia::CriticalTimeStep() const
+{
+  if (this->dataPtr->px.empty())
+    return 0;
+
+  // Period of a contact between the two lightest grains.
+  const double period = 2.0 * M_PI *
+      std::sqrt(0.5 * this->dataPtr->minMass / this->dataPtr->stiffness);
+  return kSubstepFraction * period;
+}
+
+/////////////////////////////////////////////////
+unsigned int GranularMedia::Step(const double _dt)
+{
+  for (auto &body : this->dataPtr->bodies)
+  {
+    body.forceSum = ignition::math::Vector3d::Zero;
+    body.torqueSum = ignition::math::Vector3d::Zero;
+    body.force = ignition::math::Vector3d::Zero;
+    body.torque = ignition::math::Vector3d::Zero;
+  }
+  this->dataPtr->contactCount = 0;
+
+  const size_t count = this->dataPtr->px.size();
+  if (count == 0 || _dt <= 0)
+    return 0;
+
+  const double critical = this->CriticalTimeStep();
+  const unsigned int substeps =
+      std::max(1u, static_cast<unsigned int>(std::ceil(_dt / critical)));
+  const double dt = _dt / substeps;
+
+  for (unsigned int s = 0; s < substeps; ++s)
+  {
+    this->dataPtr->BuildHash();
+
+    std::atomic<uint64_t> contacts(0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, count, kGrainBlock),
+        [&](const tbb::blocked_range<size_t> &_r)
+        {
+          contacts += this->dataPtr->GrainForces(_r.begin(), _r.end());
+        });
+
+    // Bodies are few, and their contacts touch few grains.
+    uint64_t bodyContacts = 0;
+    for (auto &body : this->dataPtr->bodies)
+      bodyContacts += this->dataPtr->BodyForces(body);
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, count, kGrainBlock),
+        [&](const tbb::blocked_range<size_t> &_r)
+        {
+          this->dataPtr->Integrate(_r.begin(), _r.end(), dt);
+        });
+
+    this->dataPtr->contactCount = contacts + bodyContacts;
+  }
+
+  for (auto &body : this->dataPtr->bodies)
+  {
+    body.force = body.forceSum / substeps;
+    body.torque = body.torqueSum / substeps;
+  }
+  return substeps;
+}
+
+/////////////////////////////////////////////////
+uint64_t GranularMedia::ContactCount() const
+{
+  return this->dataPtr->contactCount;
+}
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_GRANULARMEDIA_HH_
+#define GAZEBO_PHYSICS_GRANULARMEDIA_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class GranularMediaPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class GranularMedia GranularMedia.hh physics/physics.hh
+    /// \brief Discrete element solver for granular media such as sand,
+    /// regolith or rubble, simulated as many spherical grains outside of
+    /// the physics engine.
+    ///
+    /// Grains touching each other or a body push back with a linear spring
+    /// and a dashpot along the contact normal, and rub with a regularized
+    /// Coulomb friction. Grains don't rotate. Neighboring grains are found
+    /// in cells as large as the largest grain, sorted every substep into a
+    /// dense grid around packed grains, or a spatial hash when they are
+    /// spread apart. The contacts and the integration of the grains run
+    /// in parallel over the grains, on arrays of coordinates that the
+    /// compiler vectorizes.
+    ///
+    /// Rigid bodies couple to the grains through contact forces. Their
+    /// pose and velocity are set before each step, and the forces and
+    /// torques the grains apply to them are read after the step, to be
+    /// applied to the matching links. Static half spaces bound the grains,
+    /// such as the ground.
+    ///
+    /// Step splits the time step into substeps short enough for the
+    /// stiffness of the contacts, see CriticalTimeStep.
+    class GZ_PHYSICS_VISIBLE GranularMedia
+    {
+      /// \brief Constructor.
+      public: GranularMedia();
+
+      /// \brief Destructor.
+      public: ~GranularMedia();
+
+      /// \brief Set the density of the grains.
+      /// \param[in] _density Density in kg/m^3, 2600 by default. Applies
+      /// to the grains added afterwards.
+      public: void SetDensity(const double _density);
+
+      /// \brief Get the density of the grains.
+      /// \return Density in kg/m^3.
+      public: double Density() const;
+
+      /// \brief Set the normal stiffness of the contacts.
+      /// \param[in] _stiffness Stiffness in N/m, 1e4 by default.
+      public: void SetStiffness(const double _stiffness);
+
+      /// \brief Get the normal stiffness of the contacts.
+      /// \return Stiffness in N/m.
+      public: double Stiffness() const;
+
+      /// \brief Set the coefficient of restitution of the contacts, which
+      /// sets the damping of the dashpot.
+      /// \param[in] _restitution Restitution between 0 and 1, 0.3 by
+      /// default.
+      public: void SetRestitution(const double _restitution);
+
+      /// \brief Get the coefficient of restitution of the contacts.
+      /// \return Restitution.
+      public: double Restitution() const;
+
+      /// \brief Set the friction coefficient of the contacts.
+      /// \param[in] _friction Coulomb friction coefficient, 0.5 by default.
+      public: void SetFriction(const double _friction);
+
+      /// \brief Get the friction coefficient of the contacts.
+      /// \return Coulomb friction coefficient.
+      public: double Friction() const;
+
+      /// \brief Set the gravity applied to the grains.
+      /// \param[in] _gravity Gravity in m/s^2, (0, 0, -9.8) by default.
+      public: void SetGravity(const ignition::math::Vector3d &_gravity);
+
+      /// \brief Get the gravity applied to the grains.
+      /// \return Gravity in m/s^2.
+      public: ignition::math::Vector3d Gravity() const;
+
+      /// \brief Add a grain.
+      /// \param[in] _pos Location of the center of the grain.
+      /// \param[in] _radius Radius of the grain.
+      /// \param[in] _vel Initial velocity of the grain.
+      /// \return Index of the grain.
+      public: size_t AddGrain(const ignition::math::Vector3d &_pos,
+                  const double _radius,
+                  const ignition::math::Vector3d &_vel =
+                  ignition::math::Vector3d::Zero);
+
+      /// \brief Fill a box with grains on a cubic lattice.
+      /// \param[in] _min Minimum corner of the box.
+      /// \param[in] _max Maximum corner of the box.
+      /// \param[in] _radius Radius of the grains.
+      /// \param[in] _jitter Random offset of the grains as a fraction of
+      /// their radius, from 0 to 1, which keeps them from stacking in
+      /// perfect columns.
+      /// \return Number of grains added.
+      public: size_t FillBox(const ignition::math::Vector3d &_min,
+                  const ignition::math::Vector3d &_max,
+                  const double _radius, const double _jitter = 0.1);
+
+      /// \brief Remove all the grains.
+      public: void ClearGrains();
+
+      /// \brief Get the number of grains.
+      /// \return Number of grains.
+      public: size_t GrainCount() const;
+
+      /// \brief Get the location of a grain.
+      /// \param[in] _index Index of the grain.
+      /// \return Location of the center of the grain, zero if the index is
+      /// out of range.
+      public: ignition::math::Vector3d GrainPosition(const size_t _index)
+                  const;
+
+      /// \brief Get the velocity of a grain.
+      /// \param[in] _index Index of the grain.
+      /// \return Velocity of the grain, zero if the index is out of range.
+      public: ignition::math::Vector3d GrainVelocity(const size_t _index)
+                  const;
+
+      /// \brief Get the locations of all the grains.
+      /// \param[out] _positions Location of each grain, resized to the
+      /// number of grains.
+      public: void GrainPositions(
+                  std::vector<ignition::math::Vector3d> &_positions) const;
+
+      /// \brief Add a static half space that bounds the grains, such as
+      /// the ground.
+      /// \param[in] _normal Normal of the boundary, pointing towards the
+      /// grains.
+      /// \param[in] _offset Distance of the boundary from the origin along
+      /// the normal.
+      public: void AddPlane(const ignition::math::Vector3d &_normal,
+                  const double _offset);
+
+      /// \brief Add a spherical rigid body.
+      /// \param[in] _radius Radius of the sphere.
+      /// \return Index of the body.
+      public: size_t AddSphereBody(const double _radius);
+
+      /// \brief Add a box shaped rigid body.
+      /// \param[in] _size Size of the box along its axes.
+      /// \return Index of the body.
+      public: size_t AddBoxBody(const ignition::math::Vector3d &_size);
+
+      /// \brief Add a cylindrical rigid body, such as a wheel.
+      /// \param[in] _radius Radius of the cylinder.
+      /// \param[in] _length Length of the cylinder along its z axis.
+      /// \return Index of the body.
+      public: size_t AddCylinderBody(const double _radius,
+                  const double _length);
+
+      /// \brief Get the number of rigid bodies.
+      /// \return Number of bodies.
+      public: size_t BodyCount() const;
+
+      /// \brief Set the pose and velocity of a rigid body for the next
+      /// step. The body keeps moving at that velocity during the step.
+      /// \param[in] _index Index of the body.
+      /// \param[in] _pose World pose of the center of the body.
+      /// \param[in] _linearVel World linear velocity of the center.
+      /// \param[in] _angularVel World angular velocity.
+      public: void SetBodyState(const size_t _index,
+                  const ignition::math::Pose3d &_pose,
+                  const ignition::math::Vector3d &_linearVel,
+                  const ignition::math::Vector3d &_angularVel);
+
+      /// \brief Get the force of the grains on a rigid body, averaged over
+      /// the last step.
+      /// \param[in] _index Index of the body.
+      /// \return World force on the body.
+      public: ignition::math::Vector3d BodyForce(const size_t _index) const;
+
+      /// \brief Get the torque of the grains on a rigid body about its
+      /// center, averaged over the last step.
+      /// \param[in] _index Index of the body.
+      /// \return World torque on the body.
+      public: ignition::math::Vector3d BodyTorque(const size_t _index) const;
+
+      /// \brief Get the longest stable substep for the stiffness of the
+      /// contacts and the lightest grain.
+      /// \return Time step in seconds, 0 if there are no grains.
+      public: double CriticalTimeStep() const;
+
+      /// \brief Advance the grains.
+      /// \param[in] _dt Time step in seconds.
+      /// \return Number of substeps taken.
+      public: unsigned int Step(const double _dt);
+
+      /// \brief Get the number of grain to grain and grain to body contacts
+      /// in the last substep.
+      /// \return Number of contacts.
+      public: uint64_t ContactCount() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<GranularMediaPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "gazebo/physics/GranularMedia.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class GranularMediaTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Step the grains for a duration.
+/// \param[in] _media The grains.
+/// \param[in] _duration Duration in seconds.
+static void StepFor(physics::GranularMedia &_media, const double _duration)
+{
+  const double dt = 0.001;
+  for (double t = 0; t < _duration; t += dt)
+    _media.Step(dt);
+}
+
+/////////////////////////////////////////////////
+TEST_F(GranularMediaTest, Parameters)
+{
+  physics::GranularMedia media;
+  EXPECT_DOUBLE_EQ(media.Density(), 2600);
+  EXPECT_DOUBLE_EQ(media.Restitution(), 0.3);
+  EXPECT_DOUBLE_EQ(media.CriticalTimeStep(), 0);
+  EXPECT_EQ(media.Step(0.001), 0u);
+
+  media.SetRestitution(2);
+  EXPECT_DOUBLE_EQ(media.Restitution(), 1);
+  media.SetStiffness(-1);
+  EXPECT_DOUBLE_EQ(media.Stiffness(), 1e4);
+
+  // Stiffer contacts need shorter substeps.
+  media.AddGrain(ignition::math::Vector3d::Zero, 0.01);
+  const double critical = media.CriticalTimeStep();
+  EXPECT_GT(critical, 0);
+  media.SetStiffness(4e4);
+  EXPECT_NEAR(media.CriticalTimeStep(), critical / 2, 1e-12);
+  EXPECT_EQ(media.Step(critical * 10), 20u);
+
+  EXPECT_EQ(media.FillBox(ignition::math::Vector3d(0, 0, 0),
+        ignition::math::Vector3d(0.1, 0.1, 0.1), 0.01, 0), 125u);
+  EXPECT_EQ(media.GrainCount(), 126u);
+  media.ClearGrains();
+  EXPECT_EQ(media.GrainCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(GranularMediaTest, Collision)
+{
+  physics::GranularMedia media;
+  media.SetGravity(ignition::math::Vector3d::Zero);
+  media.SetStiffness(1000);
+  media.SetRestitution(0.5);
+  media.SetFriction(0);
+
+  // Head on, on either side of the origin to cross cells of negative
+  // coordinates.
+  media.AddGrain(ignition::math::Vector3d(-0.1, 0, 0), 0.05,
+      ignition::math::Vector3d(1, 0, 0));
+  media.AddGrain(ignition::math::Vector3d(0.1, 0, 0), 0.05,
+      ignition::math::Vector3d(-1, 0, 0));
+  StepFor(media, 0.5);
+
+  const ignition::math::Vector3d vel0 = media.GrainVelocity(0);
+  const ignition::math::Vector3d vel1 = media.GrainVelocity(1);
+  EXPECT_NEAR(vel0.X(), -0.5, 0.05);
+  EXPECT_NEAR(vel1.X(), 0.5, 0.05);
+  EXPECT_NEAR((vel0 + vel1).Length(), 0, 1e-9);
+  EXPECT_EQ(media.ContactCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(GranularMediaTest, Contacts)
+{
+  physics::GranularMedia media;
+  media.SetGravity(ignition::math::Vector3d::Zero);
+
+  // A row of overlapping grains across the origin, and one apart.
+  const int count = 20;
+  for (int i = 0; i < count; ++i)
+    media.AddGrain(ignition::math::Vector3d(-0.19 + 0.019 * i, 0, 0), 0.01);
+  media.AddGrain(ignition::math::Vector3d(0, 1, 0), 0.01);
+
+  media.Step(1e-7);
+  EXPECT_EQ(media.ContactCount(), 2u * (count - 1));
+
+  // Grains pushed apart along the row only.
+  EXPECT_LT(media.GrainVelocity(0).X(), 0);
+  EXPECT_GT(media.GrainVelocity(count - 1).X(), 0);
+  EXPECT_EQ(media.GrainVelocity(count), ignition::math::Vector3d::Zero);
+}
+
+/////////////////////////////////////////////////
+TEST_F(GranularMediaTest, Settle)
+{
+  physics::GranularMedia media;
+  media.SetStiffness(1e5);
+  media.AddPlane(ignition::math::Vector3d::UnitZ, 0);
+
+  // A layer of grains dropped on the ground comes to rest on it.
+  const size_t count = media.FillBox(ignition::math::Vector3d(-0.3, -0.3, 0.2),
+      ignition::math::Vector3d(0.3, 0.3, 0.32), 0.05);
+  EXPECT_EQ(count, 25u);
+
+  StepFor(media, 1);
+
+  std::vector<ignition::math::Vector3d> positions;
+  media.GrainPositions(positions);
+  ASSERT_EQ(positions.size(), count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    EXPECT_NEAR(positions[i].Z(), 0.05, 0.001);
+    EXPECT_LT(media.GrainVelocity(i).Length(), 1e-3);
+  }
+  EXPECT_EQ(media.ContactCount(), count);
+}
+
+/////////////////////////////////////////////////
+TEST_F(GranularMediaTest, Bodies)
+{
+  physics::GranularMedia media;
+  media.SetStiffness(1e5);
+
+  // A static box holds the weight of the grains.
+  const size_t floor = media.AddBoxBody(ignition::math::Vector3d(4, 4, 0.1));
+  media.SetBodyState(floor, ignition::math::Pose3d(0, 0, -0.05, 0, 0, 0),
+      ignition::math::Vector3d::Zero, ignition::math::Vector3d::Zero);
+  const size_t count = media.FillBox(ignition::math::Vector3d(-0.2, -0.2, 0),
+      ignition::math::Vector3d(0.2, 0.2, 0.3), 0.05);
+
+  StepFor(media, 2);
+
+  const double mass = 2600 * 4.0 / 3.0 * M_PI * std::pow(0.05, 3);
+  const double weight = count * mass * 9.8;
+  EXPECT_NEAR(media.BodyForce(floor).Z(), -weight, weight * 0.05);
+  EXPECT_NEAR(media.BodyForce(floor).X(), 0, weight * 0.05);
+
+  // A sphere sinks into the grains and is pushed up, the torque about its
+  // center is only from friction.
+  const size_t ball = media.AddSphereBody(0.1);
+  media.SetBodyState(ball, ignition::math::Pose3d(0, 0, 0.15, 0, 0, 0),
+      ignition::math::Vector3d::Zero, ignition::math::Vector3d::Zero);
+  media.Step(0.001);
+  EXPECT_GT(media.BodyForce(ball).Z(), 0);
+  EXPECT_LT(media.BodyTorque(ball).Length(),
+      media.BodyForce(ball).Length() * 0.1);
+
+  // A wheel spinning in the grains is braked by friction.
+  const size_t wheel = media.AddCylinderBody(0.1, 0.1);
+  media.SetBodyState(ball, ignition::math::Pose3d(0, 0, 5, 0, 0, 0),
+      ignition::math::Vector3d::Zero, ignition::math::Vector3d::Zero);
+  media.SetBodyState(wheel,
+      ignition::math::Pose3d(0, 0, 0.15, M_PI / 2, 0, 0),
+      ignition::math::Vector3d::Zero, ignition::math::Vector3d(0, 5, 0));
+  media.Step(0.001);
+  EXPECT_EQ(media.BodyForce(ball), ignition::math::Vector3d::Zero);
+  EXPECT_GT(media.BodyForce(wheel).Z(), 0);
+  EXPECT_LT(media.BodyTorque(wheel).Y(), 0);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
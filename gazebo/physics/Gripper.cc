@@ -14,21 +14,18 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <functional>
 #include <map>
-#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Pose3.hh>
 
-#include "gazebo/msgs/msgs.hh"
-
 #include "gazebo/common/Events.hh"
 
-#include "gazebo/transport/Node.hh"
-#include "gazebo/transport/Subscriber.hh"
-
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Joint.hh"
@@ -42,13 +39,23 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \internal
+/// \brief An object that touched the gripper during an update window.
+class GripperContactCount
+{
+  /// \brief Scoped name of the collision of the object.
+  public: std::string name;
+
+  /// \brief Number of contacts with the gripper.
+  public: int count = 0;
+};
+
 /// \internal
 /// \brief Private data class for Gripper
 class gazebo::physics::GripperPrivate
 {
-  /// \brief Callback used when the gripper contacts an object.
-  /// \param[in] _msg Message that contains contact information.
-  public: void OnContacts(ConstContactsPtr &_msg);
+  /// \brief Count the contacts of the last collision detection.
+  public: void GatherContacts();
 
   /// \brief Update the gripper.
   public: void OnUpdate();
@@ -69,8 +76,12 @@ class gazebo::physics::GripperPrivate
   public: physics::WorldPtr world;
 
   /// \brief A fixed joint to connect the gripper to a grasped object.
+  /// Created once and attached again for each grasp.
   public: physics::JointPtr fixedJoint;
 
+  /// \brief True once the fixed joint was loaded.
+  public: bool fixedJointLoaded = false;
+
   /// \brief The base link for the gripper.
   public: physics::LinkPtr palmLink;
 
@@ -80,11 +91,20 @@ class gazebo::physics::GripperPrivate
   /// \brief The collisions for the links in the gripper.
   public: std::map<std::string, physics::CollisionPtr> collisions;
 
-  /// \brief The current contacts.
-  public: std::vector<msgs::Contact> contacts;
+  /// \brief Contacts of the gripper collisions, gathered by the contact
+  /// manager on every collision detection.
+  public: ContactQueryPtr contactQuery;
 
-  /// \brief Mutex used to protect reading/writing the contact message.
-  public: std::mutex mutexContacts;
+  /// \brief Number of contacts with dynamic objects since the last
+  /// update.
+  public: unsigned int contactCount = 0;
+
+  /// \brief Objects touched since the last update, in the order they first
+  /// touched.
+  public: std::vector<GripperContactCount> touched;
+
+  /// \brief Index of each touched object in touched.
+  public: std::unordered_map<const Collision *, size_t> touchedIndex;
 
   /// \brief True if the gripper has an object.
   public: bool attached;
@@ -124,12 +144,6 @@ class gazebo::physics::GripperPrivate
 
   /// \brief Name of the gripper.
   public: std::string name;
-
-  /// \brief Node for communication.
-  public: transport::NodePtr node;
-
-  /// \brief Subscription to contact messages from the physics engine.
-  public: transport::SubscriberPtr contactSub;
 };
 
 /////////////////////////////////////////////////
@@ -145,18 +159,17 @@ Gripper::Gripper(ModelPtr _model) : dataPtr(new GripperPrivate)
   this->dataPtr->attached = false;
 
   this->dataPtr->updateRate = common::Time(0, common::Time::SecToNano(0.75));
-
-  this->dataPtr->node = transport::NodePtr(new transport::Node());
 }
 
 /////////////////////////////////////////////////
 Gripper::~Gripper()
 {
-  if (this->dataPtr->world && this->dataPtr->world->Running())
+  if (this->dataPtr->world && this->dataPtr->world->Physics() &&
+      this->dataPtr->contactQuery)
   {
     physics::ContactManager *mgr =
         this->dataPtr->world->Physics()->GetContactManager();
-    mgr->RemoveFilter(this->Name());
+    mgr->RemoveQuery(this->dataPtr->contactQuery);
   }
 
   this->dataPtr->model.reset();
@@ -167,8 +180,6 @@ Gripper::~Gripper()
 /////////////////////////////////////////////////
 void Gripper::Load(sdf::ElementPtr _sdf)
 {
-  this->dataPtr->node->Init(this->dataPtr->world->Name());
-
   this->dataPtr->name = _sdf->Get<std::string>("name");
   this->dataPtr->fixedJoint =
       this->dataPtr->world->Physics()->CreateJoint("fixed",
@@ -212,19 +223,17 @@ void Gripper::Load(sdf::ElementPtr _sdf)
     gripperLinkElem = gripperLinkElem->GetNextElement("gripper_link");
   }
 
-  if (!this->dataPtr->collisions.empty())
+  if (!this->dataPtr->collisions.empty() && !this->dataPtr->contactQuery)
   {
-    // request the contact manager to publish messages to a custom topic for
-    // this sensor
+    // Read the contacts of the gripper collisions in process, instead of
+    // building and parsing contact messages.
+    std::vector<physics::CollisionPtr> collisions;
+    for (auto const &collision : this->dataPtr->collisions)
+      collisions.push_back(collision.second);
+
     physics::ContactManager *mgr =
         this->dataPtr->world->Physics()->GetContactManager();
-    std::string topic = mgr->CreateFilter(this->Name(),
-        this->dataPtr->collisions);
-    if (!this->dataPtr->contactSub)
-    {
-      this->dataPtr->contactSub = this->dataPtr->node->Subscribe(topic,
-          &GripperPrivate::OnContacts, this->dataPtr.get());
-    }
+    this->dataPtr->contactQuery = mgr->CreateQuery(collisions);
   }
   this->dataPtr->connections.push_back(event::Events::ConnectWorldUpdateEnd(
           std::bind(&GripperPrivate::OnUpdate, this->dataPtr.get())));
@@ -254,13 +263,15 @@ bool Gripper::IsAttached() const
 /////////////////////////////////////////////////
 void GripperPrivate::OnUpdate()
 {
+  this->GatherContacts();
+
   if (common::Time::GetWallTime() - this->prevUpdateTime < this->updateRate)
   {
     return;
   }
 
   // @todo: should package the decision into a function
-  if (this->contacts.size() >= this->minContactCount)
+  if (this->contactCount >= this->minContactCount)
   {
     this->posCount++;
     this->zeroCount = 0;
@@ -280,10 +291,9 @@ void GripperPrivate::OnUpdate()
     this->HandleDetach();
   }
 
-  {
-    std::lock_guard<std::mutex> lock(this->mutexContacts);
-    this->contacts.clear();
-  }
+  this->contactCount = 0;
+  this->touched.clear();
+  this->touchedIndex.clear();
 
   this->prevUpdateTime = common::Time::GetWallTime();
 }
@@ -297,69 +307,61 @@ void GripperPrivate::HandleAttach()
     return;
   }
 
-  std::map<std::string, physics::CollisionPtr> cc;
-  std::map<std::string, int> contactCounts;
-  std::map<std::string, int>::iterator iter;
+  // Objects are checked by name, the first one that stays still relative
+  // to the palm is attached.
+  std::vector<GripperContactCount> objects = this->touched;
+  std::sort(objects.begin(), objects.end(),
+      [](const GripperContactCount &_a, const GripperContactCount &_b)
+      {
+        return _a.name < _b.name;
+      });
 
-  // This function is only called from the OnUpdate function so
-  // the call to contacts.clear() is not going to happen in
-  // parallel with the reads in the following code, no mutex
-  // needed.
-  for (unsigned int i = 0; i < this->contacts.size(); ++i)
+  for (auto const &object : objects)
   {
-    std::string name1 = this->contacts[i].collision1();
-    std::string name2 = this->contacts[i].collision2();
+    if (object.count < 2 || this->attached)
+      continue;
 
-    if (this->collisions.find(name1) == this->collisions.end())
-    {
-      cc[name1] = boost::dynamic_pointer_cast<Collision>(
-          this->world->EntityByName(name1));
-      contactCounts[name1] += 1;
-    }
+    // Look the object up by name, it may have been removed since it touched
+    // the gripper.
+    CollisionPtr collision = boost::dynamic_pointer_cast<Collision>(
+        this->world->EntityByName(object.name));
+    if (!collision)
+      continue;
 
-    if (this->collisions.find(name2) == this->collisions.end())
-    {
-      cc[name2] = boost::dynamic_pointer_cast<Collision>(
-          this->world->EntityByName(name2));
-      contactCounts[name2] += 1;
-    }
-  }
-
-  iter = contactCounts.begin();
-  while (iter != contactCounts.end())
-  {
-    if (iter->second < 2)
-    {
-      contactCounts.erase(iter++);
-    }
-    else
-    {
-      if (!this->attached && cc[iter->first])
-      {
-        ignition::math::Pose3d diff =
-          cc[iter->first]->GetLink()->WorldPose() - this->palmLink->WorldPose();
+    LinkPtr link = collision->GetLink();
+    ignition::math::Pose3d diff =
+      link->WorldPose() - this->palmLink->WorldPose();
 
-        double dd = (diff - this->prevDiff).Pos().SquaredLength();
+    double dd = (diff - this->prevDiff).Pos().SquaredLength();
 
-        this->prevDiff = diff;
+    this->prevDiff = diff;
 
-        this->diffs[this->diffIndex] = dd;
-        double var = ignition::math::variance<double>(this->diffs);
-        double max = ignition::math::max<double>(this->diffs);
+    this->diffs[this->diffIndex] = dd;
+    double var = ignition::math::variance<double>(this->diffs);
+    double max = ignition::math::max<double>(this->diffs);
 
-        if (var < 1e-5 && max < 1e-5)
-        {
-          this->attached = true;
-
-          this->fixedJoint->Load(this->palmLink,
-              cc[iter->first]->GetLink(), ignition::math::Pose3d());
-          this->fixedJoint->Init();
-        }
+    if (var < 1e-5 && max < 1e-5)
+    {
+      this->attached = true;
 
-        this->diffIndex = (this->diffIndex+1) % 10;
+      // Grasping the same object again only attaches the pooled joint
+      if (!this->fixedJointLoaded ||
+          this->fixedJoint->GetChild() != link ||
+          this->fixedJoint->GetParent() != this->palmLink)
+      {
+        this->fixedJoint->Load(this->palmLink, link,
+            ignition::math::Pose3d());
+        this->fixedJointLoaded = true;
       }
-      ++iter;
+      else
+      {
+        this->palmLink->AddChildJoint(this->fixedJoint);
+        link->AddParentJoint(this->fixedJoint);
+      }
+      this->fixedJoint->Init();
     }
+
+    this->diffIndex = (this->diffIndex+1) % 10;
   }
 }
 
@@ -371,20 +373,37 @@ void GripperPrivate::HandleDetach()
 }
 
 /////////////////////////////////////////////////
-void GripperPrivate::OnContacts(ConstContactsPtr &_msg)
+void GripperPrivate::GatherContacts()
 {
-  for (int i = 0; i < _msg->contact_size(); ++i)
+  if (!this->contactQuery)
+    return;
+
+  // Runs on the physics thread after the update, while the contacts of the
+  // query are valid.
+  for (auto const *contact : this->contactQuery->contacts)
   {
-    CollisionPtr collision1 = boost::dynamic_pointer_cast<Collision>(
-        this->world->EntityByName(_msg->contact(i).collision1()));
-    CollisionPtr collision2 = boost::dynamic_pointer_cast<Collision>(
-        this->world->EntityByName(_msg->contact(i).collision2()));
+    if (!contact->collision1 || contact->collision1->IsStatic() ||
+        !contact->collision2 || contact->collision2->IsStatic())
+    {
+      continue;
+    }
+    ++this->contactCount;
 
-    if ((collision1 && !collision1->IsStatic()) &&
-        (collision2 && !collision2->IsStatic()))
+    for (Collision *collision : {contact->collision1, contact->collision2})
     {
-      std::lock_guard<std::mutex> lock(this->mutexContacts);
-      this->contacts.push_back(_msg->contact(i));
+      // Skip the gripper collisions
+      if (this->contactQuery->collisions.count(collision) > 0)
+        continue;
+
+      auto iter = this->touchedIndex.find(collision);
+      if (iter == this->touchedIndex.end())
+      {
+        iter = this->touchedIndex.emplace(collision,
+            this->touched.size()).first;
+        this->touched.push_back(GripperContactCount());
+        this->touched.back().name = collision->GetScopedName();
+      }
+      ++this->touched[iter->second].count;
     }
   }
 }
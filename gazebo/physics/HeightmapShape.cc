@@ -16,7 +16,10 @@
 */
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <string>
+#include <utility>
+#include <vector>
 #include <ignition/math/Helpers.hh>
 #include <gazebo/gazebo_config.h>
 
@@ -24,8 +27,13 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Image.hh"
 #include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Events.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
+#include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/HeightmapShape.hh"
+#include "gazebo/physics/HeightmapTiles.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/transport/transport.hh"
 
@@ -48,6 +56,8 @@ HeightmapShape::HeightmapShape(CollisionPtr _parent)
 //////////////////////////////////////////////////
 HeightmapShape::~HeightmapShape()
 {
+  this->updateConnection.reset();
+  this->tiles.reset();
   this->requestSub.reset();
   this->responsePub.reset();
   if (this->node)
@@ -194,6 +204,24 @@ void HeightmapShape::Load(sdf::ElementPtr _sdf)
     }
   }
 
+  if (this->sdf->HasElement("collision_decimation"))
+  {
+    this->SetCollisionDecimation(
+        this->sdf->Get<unsigned int>("collision_decimation"));
+  }
+
+  if (this->sdf->HasElement("tiles"))
+  {
+    sdf::ElementPtr tilesElem = this->sdf->GetElement("tiles");
+    unsigned int size = 257u;
+    unsigned int budget = this->tileBudget;
+    if (tilesElem->HasElement("size"))
+      size = tilesElem->Get<unsigned int>("size");
+    if (tilesElem->HasElement("budget"))
+      budget = tilesElem->Get<unsigned int>("budget");
+    this->SetTiling(size, budget);
+  }
+
   // Check if the geometry of the terrain data matches Ogre constrains
   if (this->heightmapData->GetWidth() != this->heightmapData->GetHeight() ||
       !ignition::math::isPowerOfTwo(this->heightmapData->GetWidth() - 1))
@@ -209,19 +237,56 @@ int HeightmapShape::GetSubSampling() const
   return this->subSampling;
 }
 
+//////////////////////////////////////////////////
+void HeightmapShape::SetCollisionDecimation(const unsigned int _step)
+{
+  if (_step == 0u || _step & (_step - 1u))
+  {
+    gzerr << "Heightmap collision decimation must be a power of 2, "
+          << "collisions use every height instead." << std::endl;
+    this->collisionDecimation = 1u;
+    return;
+  }
+  this->collisionDecimation = _step;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapShape::CollisionDecimation() const
+{
+  return this->collisionDecimation;
+}
+
 //////////////////////////////////////////////////
 void HeightmapShape::FillHeightfield(std::vector<float>& _heights)
 {
-  this->heightmapData->FillHeightMap(this->subSampling, this->vertSize,
-      this->Size(), this->scale, this->flipY, _heights);
+  if (this->vertSize == this->sampledVertSize ||
+      this->sampledVertSize == 0u)
+  {
+    this->heightmapData->FillHeightMap(this->subSampling, this->vertSize,
+        this->Size(), this->scale, this->flipY, _heights);
+    return;
+  }
+
+  // Fill one full resolution row at a time and keep every step-th sample
+  const unsigned int step = (this->sampledVertSize - 1u) /
+      (this->vertSize - 1u);
+  _heights.resize(static_cast<size_t>(this->vertSize) * this->vertSize);
+  std::vector<float> row;
+  for (unsigned int y = 0; y < this->vertSize; ++y)
+  {
+    this->heightmapData->FillHeightMapRegion(this->subSampling,
+        this->sampledVertSize, this->Size(), this->scale, this->flipY,
+        0u, y * step, this->sampledVertSize, 1u, row);
+    for (unsigned int x = 0; x < this->vertSize; ++x)
+      _heights[static_cast<size_t>(y) * this->vertSize + x] = row[x * step];
+  }
 }
 
 //////////////////////////////////////////////////
 void HeightmapShape::FillHeightfield(std::vector<double>& _heights)
 {
   std::vector<float> fHeights;
-  this->heightmapData->FillHeightMap(this->subSampling, this->vertSize,
-      this->Size(), this->scale, this->flipY, fHeights);
+  this->FillHeightfield(fHeights);
   _heights = std::vector<double>(fHeights.begin(), fHeights.end());
 }
 
@@ -240,6 +305,7 @@ void HeightmapShape::Init()
   // sampling size along image width and height
   this->vertSize = (this->heightmapData->GetWidth() * this->subSampling)
       - this->subSampling + 1;
+  this->sampledVertSize = this->vertSize;
   this->scale.X() = terrainSize.X() / this->vertSize;
   this->scale.Y() = terrainSize.Y() / this->vertSize;
 
@@ -258,8 +324,136 @@ void HeightmapShape::Init()
   else
     this->scale.Z() = fabs(terrainSize.Z()) / heightmapSizeZ;
 
-  // Construct the heightmap lookup table
-  this->FillHeightfield(this->heights);
+  this->updateConnection.reset();
+  this->tiles.reset();
+  if (this->tileSize > 0u && !this->tilingSupported)
+  {
+    gzwarn << "Heightmap tiles are not supported by the physics engine, "
+           << "loading the whole heightmap [" << this->GetURI() << "]\n";
+  }
+
+  if (this->tileSize > 0u && this->tilingSupported)
+  {
+    // Tiles are filled on demand, the whole table is never built.
+    this->heights.clear();
+    if (this->collisionDecimation > 1u)
+    {
+      gzwarn << "Heightmap collision decimation is not supported with "
+             << "tiles, ignoring it [" << this->GetURI() << "]\n";
+    }
+#ifdef HAVE_GDAL
+    // Keep the blocks of a paged DEM under all resident tiles in memory
+    if (demData && demData->Paged())
+    {
+      const unsigned int span = this->tileSize /
+        static_cast<unsigned int>(this->subSampling) /
+        common::Dem::BlockSize() + 2;
+      demData->SetBlockBudget(std::max(demData->BlockBudget(),
+            this->tileBudget * span * span));
+    }
+#endif
+    this->tiles.reset(new HeightmapTiles(this->heightmapData,
+        this->subSampling, this->vertSize, this->Size(), this->scale,
+        this->flipY, this->tileSize, this->tileBudget));
+    this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&HeightmapShape::UpdateTiles, this));
+    this->UpdateTiles();
+  }
+  else
+  {
+    // Decimate the collision table. The full resolution table has
+    // (width - 1) * subSampling intervals per side, a power of two.
+    unsigned int step = std::min(this->collisionDecimation,
+        this->sampledVertSize - 1u);
+    this->vertSize = (this->sampledVertSize - 1u) / step + 1u;
+
+    // Construct the heightmap lookup table
+    this->FillHeightfield(this->heights);
+    this->heights.shrink_to_fit();
+  }
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::SetTiling(const unsigned int _tileSize,
+    const unsigned int _budget)
+{
+  this->tileSize = _tileSize;
+  this->tileBudget = std::max(1u, _budget);
+}
+
+//////////////////////////////////////////////////
+bool HeightmapShape::Tiled() const
+{
+  return this->tiles != nullptr;
+}
+
+//////////////////////////////////////////////////
+const HeightmapTiles *HeightmapShape::Tiles() const
+{
+  return this->tiles.get();
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::UpdateTiles()
+{
+  if (!this->tiles || !this->world || this->vertSize < 2u)
+    return;
+
+  const ignition::math::Pose3d pose = this->collisionParent->WorldPose();
+  const ignition::math::Vector3d size = this->Size();
+  const double spacingX = size.X() / (this->vertSize - 1);
+  const double spacingY = std::abs(size.Y()) / (this->vertSize - 1);
+  const int tileSize = static_cast<int>(this->tiles->TileSize());
+  const int last = static_cast<int>(this->tiles->TilesPerSide()) - 1;
+
+  std::vector<unsigned int> active;
+  std::function<void(const ModelPtr &)> addModel =
+      [&](const ModelPtr &_model)
+      {
+        if (_model->IsStatic())
+          return;
+
+        for (const auto &link : _model->GetLinks())
+        {
+          ignition::math::AxisAlignedBox box = link->BoundingBox();
+          bool valid = box.Min().X() <= box.Max().X();
+          ignition::math::Vector3d center = valid ? box.Center() :
+              link->WorldPose().Pos();
+          double radius = valid ? box.Size().Length() * 0.5 : 0.0;
+
+          // Heightmap frame, with rows along -y unless the rows are
+          // flipped.
+          ignition::math::Vector3d local =
+              pose.Rot().RotateVectorReverse(center - pose.Pos());
+          double col = (local.X() + size.X() * 0.5) / spacingX;
+          double row = this->flipY ? (local.Y() + size.Y() * 0.5) / spacingY :
+              (size.Y() * 0.5 - local.Y()) / spacingY;
+          double reach = std::max(radius / spacingX, radius / spacingY);
+
+          // One ring of tiles around the link is filled ahead of time.
+          int x0 = static_cast<int>(std::floor((col - reach) / tileSize)) - 1;
+          int x1 = static_cast<int>(std::floor((col + reach) / tileSize)) + 1;
+          int y0 = static_cast<int>(std::floor((row - reach) / tileSize)) - 1;
+          int y1 = static_cast<int>(std::floor((row + reach) / tileSize)) + 1;
+          x0 = std::max(x0, 0);
+          y0 = std::max(y0, 0);
+          x1 = std::min(x1, last);
+          y1 = std::min(y1, last);
+          for (int y = y0; y <= y1; ++y)
+          {
+            for (int x = x0; x <= x1; ++x)
+              active.push_back(y * (last + 1) + x);
+          }
+        }
+
+        for (const auto &nested : _model->NestedModels())
+          addModel(nested);
+      };
+
+  for (const auto &model : this->world->Models())
+    addModel(model);
+
+  this->tiles->SetActiveTiles(active);
 }
 
 //////////////////////////////////////////////////
@@ -269,6 +463,7 @@ void HeightmapShape::SetScale(const ignition::math::Vector3d &_scale)
     return;
 
   this->scale = _scale;
+  this->InvalidateBoundingBox();
 }
 
 //////////////////////////////////////////////////
@@ -311,8 +506,8 @@ void HeightmapShape::FillHeights(msgs::Geometry &_msg) const
   {
     for (unsigned int x = 0; x < this->vertSize; ++x)
     {
-      int index = (this->vertSize - y - 1) * this->vertSize + x;
-      _msg.mutable_heightmap()->add_heights(this->heights[index]);
+      _msg.mutable_heightmap()->add_heights(
+          this->GetHeight(x, this->vertSize - y - 1));
     }
   }
 }
@@ -332,6 +527,9 @@ ignition::math::Vector2i HeightmapShape::VertexCount() const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 {
+  if (this->tiles)
+    return this->tiles->Height(_x, _y);
+
   int index =  _y * this->vertSize + _x;
   if (_x < 0 || _y < 0 || index >= static_cast<int>(this->heights.size()))
     return 0.0;
@@ -342,6 +540,12 @@ HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 /////////////////////////////////////////////////
 void HeightmapShape::SetHeight(int _x, int _y, HeightmapShape::HeightType _h)
 {
+  if (this->tiles)
+  {
+    gzerr << "SetHeight is not supported on a tiled heightmap" << std::endl;
+    return;
+  }
+
   int index =  _y * this->vertSize + _x;
   if (_x < 0 || _y < 0 || index >= static_cast<int>(this->heights.size()))
   {
@@ -351,11 +555,15 @@ void HeightmapShape::SetHeight(int _x, int _y, HeightmapShape::HeightType _h)
   }
 
   this->heights[index] = _h;
+  this->InvalidateBoundingBox();
 }
 
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 {
+  if (this->tiles)
+    return this->TiledHeightBounds().second;
+
   HeightType max = -std::numeric_limits<HeightType>::max();
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
@@ -369,6 +577,9 @@ HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMinHeight() const
 {
+  if (this->tiles)
+    return this->TiledHeightBounds().first;
+
   HeightType min = std::numeric_limits<HeightType>::max();
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
@@ -379,6 +590,40 @@ HeightmapShape::HeightType HeightmapShape::GetMinHeight() const
   return min;
 }
 
+/////////////////////////////////////////////////
+std::pair<HeightmapShape::HeightType, HeightmapShape::HeightType>
+    HeightmapShape::TiledHeightBounds() const
+{
+  // The bounds follow from the elevation range of the terrain data, so the
+  // tiles do not have to be scanned. See HeightmapData::FillHeightMap.
+  double low = 0.0;
+  double high = this->heightmapData->GetMaxElevation() * this->scale.Z();
+#ifdef HAVE_GDAL
+  auto demData = dynamic_cast<common::Dem *>(this->heightmapData);
+  if (demData)
+  {
+    low = demData->GetMinElevation();
+    high = low + (demData->GetMaxElevation() - low) * this->scale.Z();
+    if (this->Size().Z() < 0)
+    {
+      double flipped = -high;
+      high = -low;
+      low = flipped;
+    }
+  }
+  else
+#endif
+  if (this->Size().Z() < 0)
+  {
+    double flipped = 1.0 - high;
+    high = 1.0 - low;
+    low = flipped;
+  }
+
+  return std::make_pair(static_cast<HeightType>(low),
+      static_cast<HeightType>(high));
+}
+
 //////////////////////////////////////////////////
 common::Image HeightmapShape::GetImage() const
 {
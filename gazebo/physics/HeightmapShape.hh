@@ -17,7 +17,9 @@
 #ifndef GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 #define GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <ignition/transport/Node.hh>
 
@@ -26,6 +28,7 @@
 #include "gazebo/common/ImageHeightmap.hh"
 #include "gazebo/common/HeightmapData.hh"
 #include "gazebo/common/Dem.hh"
+#include "gazebo/common/Event.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/Shape.hh"
@@ -35,6 +38,8 @@ namespace gazebo
 {
   namespace physics
   {
+    class HeightmapTiles;
+
     /// \addtogroup gazebo_physics
     /// \{
 
@@ -54,7 +59,10 @@ namespace gazebo
       /// \brief Destructor.
       public: virtual ~HeightmapShape();
 
-      /// \brief Load the heightmap.
+      /// \brief Load the heightmap. A <tiles> element in the heightmap
+      /// enables SetTiling, with the optional <size> and <budget> children
+      /// as the tile size and budget. A <collision_decimation> element sets
+      /// SetCollisionDecimation.
       /// \param[in] _sdf SDF value to load from.
       public: virtual void Load(sdf::ElementPtr _sdf);
 
@@ -120,10 +128,51 @@ namespace gazebo
       /// \return The minimum height.
       public: HeightType GetMinHeight() const;
 
+      /// \brief Page the height lookup table in square tiles instead of
+      /// holding all of it, for terrains too large to fit in memory. Only
+      /// the tiles under and around the links of non static models are
+      /// kept resident, and they are filled on a background thread. Must
+      /// be called before Init. Physics engines that read the heights
+      /// through GetHeight support tiling, the others load the whole table.
+      /// The tiles of a large DEM are filled from the blocks paged by
+      /// common::Dem, so the raster is never read whole.
+      /// \param[in] _tileSize Number of height samples per row of a tile,
+      /// 0 to disable tiling.
+      /// \param[in] _budget Largest number of resident tiles, more are kept
+      /// if the links need them.
+      /// \sa HeightmapTiles
+      public: void SetTiling(const unsigned int _tileSize,
+                  const unsigned int _budget);
+
+      /// \brief Get whether the height lookup table is paged in tiles.
+      /// \return True if Init set up tiles.
+      public: bool Tiled() const;
+
+      /// \brief Get the tiles of the height lookup table.
+      /// \return The tiles, or nullptr if the table is not tiled.
+      public: const HeightmapTiles *Tiles() const;
+
+      /// \brief Make the tiles near the links of non static models active.
+      /// Called at the start of every world update when the table is tiled.
+      public: void UpdateTiles();
+
       /// \brief Get the amount of subsampling.
       /// \return Amount of subsampling.
       public: int GetSubSampling() const;
 
+      /// \brief Keep only every _step-th row and column of the height
+      /// lookup table used for collisions, independently of the visual
+      /// resolution. The decimated table is filled row by row, so the full
+      /// resolution table is never built. Must be called before Init and
+      /// is ignored when the table is tiled.
+      /// \param[in] _step Power of two, 1 to keep every height.
+      public: void SetCollisionDecimation(const unsigned int _step);
+
+      /// \brief Get the collision decimation step.
+      /// \return Number of full resolution samples per collision sample.
+      /// \sa SetCollisionDecimation
+      public: unsigned int CollisionDecimation() const;
+
       /// \brief Return an image representation of the heightmap.
       /// \return Image where white pixels represents the highest locations,
       /// and black pixels the lowest.
@@ -137,6 +186,10 @@ namespace gazebo
       /// \return 0 when the operation succeeds to load a file or -1 when fails.
       private: int LoadTerrainFile(const std::string &_filename);
 
+      /// \brief Get the height range of a tiled heightmap.
+      /// \return The smallest and largest heights.
+      private: std::pair<HeightType, HeightType> TiledHeightBounds() const;
+
       /// \brief Handle request messages.
       /// \param[in] _msg The request message.
       private: void OnRequest(ConstRequestPtr &_msg);
@@ -167,6 +220,30 @@ namespace gazebo
       /// \brief The amount of subsampling. Default is 2.
       protected: int subSampling;
 
+      /// \brief True if the physics engine reads all heights through
+      /// GetHeight, so that the table can be tiled.
+      protected: bool tilingSupported = false;
+
+      /// \brief Number of height samples per row of a tile, 0 to hold the
+      /// whole table.
+      private: unsigned int tileSize = 0u;
+
+      /// \brief Largest number of resident tiles.
+      private: unsigned int tileBudget = 64u;
+
+      /// \brief Number of full resolution samples per collision sample.
+      private: unsigned int collisionDecimation = 1u;
+
+      /// \brief Size of the full resolution table, which vertSize is
+      /// decimated from.
+      private: unsigned int sampledVertSize = 0u;
+
+      /// \brief Tiles of the height table, nullptr if it is not tiled.
+      private: std::unique_ptr<HeightmapTiles> tiles;
+
+      /// \brief Connection to the world update, to update the tiles.
+      private: event::ConnectionPtr updateConnection;
+
       /// \brief Transportation node.
       private: transport::NodePtr node;
 
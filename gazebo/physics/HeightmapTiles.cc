@@ -0,0 +1,402 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/HeightmapTiles.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \brief Heights of one tile, row by row.
+    typedef std::shared_ptr<const std::vector<float>> TilePtr;
+
+    /// \internal
+    /// \brief Private data for the HeightmapTiles class
+    class HeightmapTilesPrivate
+    {
+      /// \brief Fill the heights of a tile from the terrain data.
+      /// \param[in] _tile Tile index.
+      /// \return The heights.
+      public: TilePtr Fill(const unsigned int _tile) const;
+
+      /// \brief Fill a tile unless it is resident or being filled, and
+      /// store it.
+      /// \param[in] _tile Tile index.
+      /// \param[in] _lock Lock on the mutex, released while filling.
+      /// \return The heights of the tile.
+      public: TilePtr Load(const unsigned int _tile,
+                  std::unique_lock<std::mutex> &_lock);
+
+      /// \brief Release the least recently used inactive tiles until the
+      /// budget is met. The mutex must be locked.
+      /// \param[in] _keep Tile that must not be released.
+      public: void Evict(const unsigned int _keep =
+                  std::numeric_limits<unsigned int>::max());
+
+      /// \brief Fill the queued tiles until stopped.
+      public: void Run();
+
+      /// \brief Terrain data.
+      public: common::HeightmapData *data;
+
+      /// \brief Subsampling of the table.
+      public: int subSampling;
+
+      /// \brief Number of points per row of the table.
+      public: unsigned int vertSize;
+
+      /// \brief Real dimmensions of the terrain.
+      public: ignition::math::Vector3d size;
+
+      /// \brief Scale of the heights.
+      public: ignition::math::Vector3d scale;
+
+      /// \brief True to invert the rows of the table.
+      public: bool flipY;
+
+      /// \brief Number of points per row of a tile.
+      public: unsigned int tileSize;
+
+      /// \brief Largest number of resident tiles.
+      public: unsigned int budget;
+
+      /// \brief Number of tiles per row.
+      public: unsigned int tilesPerSide;
+
+      /// \brief Resident tiles, nullptr for the others. Read and written
+      /// with std::atomic_load and std::atomic_store, so that heights are
+      /// read without locking the mutex.
+      public: std::vector<TilePtr> tiles;
+
+      /// \brief Protects the members below.
+      public: std::mutex mutex;
+
+      /// \brief Signaled when a tile is queued or the thread must stop.
+      public: std::condition_variable queueCondition;
+
+      /// \brief Signaled when a tile has been filled.
+      public: std::condition_variable doneCondition;
+
+      /// \brief Tiles waiting for the background thread.
+      public: std::deque<unsigned int> queue;
+
+      /// \brief Per tile flags: 1 if queued, 2 if being filled, 4 if
+      /// active.
+      public: std::vector<unsigned char> flags;
+
+      /// \brief Active tiles.
+      public: std::vector<unsigned int> activeTiles;
+
+      /// \brief Last use of each tile, in calls to SetActiveTiles.
+      public: std::vector<uint64_t> lastUse;
+
+      /// \brief Number of calls to SetActiveTiles.
+      public: uint64_t clock = 0u;
+
+      /// \brief Number of resident tiles.
+      public: unsigned int residentCount = 0u;
+
+      /// \brief Number of tiles being filled.
+      public: unsigned int fillingCount = 0u;
+
+      /// \brief True once the budget was found too small for the active
+      /// tiles.
+      public: bool budgetWarned = false;
+
+      /// \brief True to stop the background thread.
+      public: bool stop = false;
+
+      /// \brief Background thread.
+      public: std::thread thread;
+    };
+  }
+}
+
+/// \brief Tile flag for tiles in the queue.
+static const unsigned char kQueued = 1u;
+
+/// \brief Tile flag for tiles being filled.
+static const unsigned char kFilling = 2u;
+
+/// \brief Tile flag for active tiles.
+static const unsigned char kActive = 4u;
+
+//////////////////////////////////////////////////
+TilePtr HeightmapTilesPrivate::Fill(const unsigned int _tile) const
+{
+  unsigned int x = (_tile % this->tilesPerSide) * this->tileSize;
+  unsigned int y = (_tile / this->tilesPerSide) * this->tileSize;
+
+  std::shared_ptr<std::vector<float>> heights(new std::vector<float>);
+  this->data->FillHeightMapRegion(this->subSampling, this->vertSize,
+      this->size, this->scale, this->flipY, x, y, this->tileSize,
+      this->tileSize, *heights);
+  return heights;
+}
+
+//////////////////////////////////////////////////
+TilePtr HeightmapTilesPrivate::Load(const unsigned int _tile,
+    std::unique_lock<std::mutex> &_lock)
+{
+  // Another thread may already be filling the tile.
+  while (this->flags[_tile] & kFilling)
+    this->doneCondition.wait(_lock);
+
+  TilePtr heights = std::atomic_load(&this->tiles[_tile]);
+  if (heights)
+    return heights;
+
+  this->flags[_tile] |= kFilling;
+  ++this->fillingCount;
+  _lock.unlock();
+
+  heights = this->Fill(_tile);
+
+  _lock.lock();
+  std::atomic_store(&this->tiles[_tile], heights);
+  ++this->residentCount;
+  this->lastUse[_tile] = this->clock;
+  this->flags[_tile] &= ~kFilling;
+  --this->fillingCount;
+  this->Evict(_tile);
+  this->doneCondition.notify_all();
+  return heights;
+}
+
+//////////////////////////////////////////////////
+void HeightmapTilesPrivate::Evict(const unsigned int _keep)
+{
+  while (this->residentCount > this->budget)
+  {
+    unsigned int oldest = std::numeric_limits<unsigned int>::max();
+    for (unsigned int i = 0; i < this->tiles.size(); ++i)
+    {
+      if (i != _keep && (this->flags[i] & (kActive | kFilling)) == 0u &&
+          std::atomic_load(&this->tiles[i]) &&
+          (oldest == std::numeric_limits<unsigned int>::max() ||
+           this->lastUse[i] < this->lastUse[oldest]))
+      {
+        oldest = i;
+      }
+    }
+
+    if (oldest == std::numeric_limits<unsigned int>::max())
+    {
+      if (!this->budgetWarned)
+      {
+        gzwarn << "Heightmap tile budget [" << this->budget << "] is too "
+               << "small for the tiles in use, keeping them resident.\n";
+        this->budgetWarned = true;
+      }
+      return;
+    }
+
+    // Readers that hold the tile keep it alive until they are done.
+    std::atomic_store(&this->tiles[oldest], TilePtr());
+    --this->residentCount;
+  }
+}
+
+//////////////////////////////////////////////////
+void HeightmapTilesPrivate::Run()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->queueCondition.wait(lock, [this]
+        {
+          return this->stop || !this->queue.empty();
+        });
+    if (this->stop)
+      return;
+
+    unsigned int tile = this->queue.front();
+    this->queue.pop_front();
+    this->flags[tile] &= ~kQueued;
+
+    // Skip tiles that are no longer needed.
+    if (this->flags[tile] & kActive)
+      this->Load(tile, lock);
+    else
+      this->doneCondition.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////
+HeightmapTiles::HeightmapTiles(common::HeightmapData *_data,
+    const int _subSampling, const unsigned int _vertSize,
+    const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, const bool _flipY,
+    const unsigned int _tileSize, const unsigned int _budget)
+  : dataPtr(new HeightmapTilesPrivate)
+{
+  this->dataPtr->data = _data;
+  this->dataPtr->subSampling = _subSampling;
+  this->dataPtr->vertSize = _vertSize;
+  this->dataPtr->size = _size;
+  this->dataPtr->scale = _scale;
+  this->dataPtr->flipY = _flipY;
+  this->dataPtr->tileSize = std::max(1u, _tileSize);
+  this->dataPtr->budget = std::max(1u, _budget);
+  this->dataPtr->tilesPerSide = (_vertSize + this->dataPtr->tileSize - 1u) /
+      this->dataPtr->tileSize;
+
+  unsigned int count =
+      this->dataPtr->tilesPerSide * this->dataPtr->tilesPerSide;
+  this->dataPtr->tiles.resize(count);
+  this->dataPtr->flags.resize(count, 0u);
+  this->dataPtr->lastUse.resize(count, 0u);
+
+  this->dataPtr->thread =
+      std::thread(&HeightmapTilesPrivate::Run, this->dataPtr.get());
+}
+
+//////////////////////////////////////////////////
+HeightmapTiles::~HeightmapTiles()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->queueCondition.notify_all();
+  this->dataPtr->thread.join();
+}
+
+//////////////////////////////////////////////////
+float HeightmapTiles::Height(const int _x, const int _y) const
+{
+  if (_x < 0 || _y < 0 ||
+      _x >= static_cast<int>(this->dataPtr->vertSize) ||
+      _y >= static_cast<int>(this->dataPtr->vertSize))
+  {
+    return 0.0f;
+  }
+
+  unsigned int tile = this->TileIndex(_x, _y);
+  TilePtr heights = std::atomic_load(&this->dataPtr->tiles[tile]);
+  if (!heights)
+  {
+    // The tile was not requested in time, fill it here.
+    std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+    heights = this->dataPtr->Load(tile, lock);
+  }
+
+  unsigned int x0 = (tile % this->dataPtr->tilesPerSide) *
+      this->dataPtr->tileSize;
+  unsigned int y0 = (tile / this->dataPtr->tilesPerSide) *
+      this->dataPtr->tileSize;
+  unsigned int width =
+      std::min(this->dataPtr->tileSize, this->dataPtr->vertSize - x0);
+
+  size_t index = static_cast<size_t>(_y - y0) * width + (_x - x0);
+  if (index >= heights->size())
+    return 0.0f;
+  return (*heights)[index];
+}
+
+//////////////////////////////////////////////////
+void HeightmapTiles::SetActiveTiles(const std::vector<unsigned int> &_tiles)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  ++this->dataPtr->clock;
+
+  for (unsigned int tile : this->dataPtr->activeTiles)
+    this->dataPtr->flags[tile] &= ~kActive;
+  this->dataPtr->activeTiles.clear();
+
+  bool queued = false;
+  for (unsigned int tile : _tiles)
+  {
+    if (tile >= this->dataPtr->tiles.size() ||
+        (this->dataPtr->flags[tile] & kActive))
+    {
+      continue;
+    }
+
+    this->dataPtr->flags[tile] |= kActive;
+    this->dataPtr->activeTiles.push_back(tile);
+    this->dataPtr->lastUse[tile] = this->dataPtr->clock;
+
+    if ((this->dataPtr->flags[tile] & (kQueued | kFilling)) == 0u &&
+        !std::atomic_load(&this->dataPtr->tiles[tile]))
+    {
+      this->dataPtr->flags[tile] |= kQueued;
+      this->dataPtr->queue.push_back(tile);
+      queued = true;
+    }
+  }
+
+  this->dataPtr->Evict();
+  if (queued)
+    this->dataPtr->queueCondition.notify_one();
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTiles::TileIndex(const unsigned int _x,
+    const unsigned int _y) const
+{
+  unsigned int last = this->dataPtr->tilesPerSide - 1u;
+  return std::min(_y / this->dataPtr->tileSize, last) *
+      this->dataPtr->tilesPerSide +
+      std::min(_x / this->dataPtr->tileSize, last);
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTiles::TilesPerSide() const
+{
+  return this->dataPtr->tilesPerSide;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTiles::TileSize() const
+{
+  return this->dataPtr->tileSize;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTiles::Budget() const
+{
+  return this->dataPtr->budget;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTiles::ResidentTileCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->residentCount;
+}
+
+//////////////////////////////////////////////////
+void HeightmapTiles::WaitForActiveTiles() const
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->doneCondition.wait(lock, [this]
+      {
+        return this->dataPtr->queue.empty() &&
+            this->dataPtr->fillingCount == 0u;
+      });
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_HEIGHTMAPTILES_HH_
+#define GAZEBO_PHYSICS_HEIGHTMAPTILES_HH_
+
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/HeightmapData.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    class HeightmapTilesPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class HeightmapTiles HeightmapTiles.hh physics/physics.hh
+    /// \brief Height lookup table of a heightmap split in square tiles, of
+    /// which only a bounded number is kept in memory.
+    ///
+    /// The table has the layout of HeightmapData::FillHeightMap. Tiles that
+    /// are made active with SetActiveTiles are filled on a background
+    /// thread. A height read from a tile that is not resident fills the
+    /// tile on the calling thread. Whenever more tiles than the budget are
+    /// resident, the least recently used ones that are not active are
+    /// released.
+    class GZ_PHYSICS_VISIBLE HeightmapTiles
+    {
+      /// \brief Constructor.
+      /// \param[in] _data Terrain data to fill the tiles from. It must
+      /// outlive this object.
+      /// \param[in] _subSampling Subsampling of the table, see
+      /// HeightmapData::FillHeightMap.
+      /// \param[in] _vertSize Number of points per row of the table.
+      /// \param[in] _size Real dimmensions of the terrain.
+      /// \param[in] _scale Scale of the heights.
+      /// \param[in] _flipY True to invert the rows of the table.
+      /// \param[in] _tileSize Number of points per row of a tile.
+      /// \param[in] _budget Largest number of resident tiles, at least 1.
+      public: HeightmapTiles(common::HeightmapData *_data,
+                  const int _subSampling, const unsigned int _vertSize,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale, const bool _flipY,
+                  const unsigned int _tileSize, const unsigned int _budget);
+
+      /// \brief Destructor. Stops the background thread.
+      public: ~HeightmapTiles();
+
+      /// \brief Get a height of the table. Thread safe.
+      /// \param[in] _x Column.
+      /// \param[in] _y Row.
+      /// \return The height, or 0 outside of the table.
+      public: float Height(const int _x, const int _y) const;
+
+      /// \brief Set the tiles that are needed soon. Tiles that are not
+      /// resident are queued for the background thread, and the other
+      /// tiles may be released.
+      /// \param[in] _tiles Tile indices, see TileIndex.
+      public: void SetActiveTiles(const std::vector<unsigned int> &_tiles);
+
+      /// \brief Get the index of the tile holding a point of the table.
+      /// \param[in] _x Column.
+      /// \param[in] _y Row.
+      /// \return Tile index, row by row.
+      public: unsigned int TileIndex(const unsigned int _x,
+                  const unsigned int _y) const;
+
+      /// \brief Get the number of tiles along a side of the table.
+      /// \return Number of tiles per row.
+      public: unsigned int TilesPerSide() const;
+
+      /// \brief Get the number of points per row of a tile.
+      /// \return Tile size.
+      public: unsigned int TileSize() const;
+
+      /// \brief Get the largest number of resident tiles.
+      /// \return Tile budget.
+      public: unsigned int Budget() const;
+
+      /// \brief Get the number of tiles in memory.
+      /// \return Number of resident tiles.
+      public: unsigned int ResidentTileCount() const;
+
+      /// \brief Wait until the background thread has filled the active
+      /// tiles.
+      public: void WaitForActiveTiles() const;
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<HeightmapTilesPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_config.h"
+
+#include "gazebo/common/ImageHeightmap.hh"
+#include "gazebo/physics/HeightmapTiles.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class HeightmapTiles : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Load the bowl heightmap and its whole height table.
+  public: void SetUp() override
+  {
+    gazebo::testing::AutoLogFixture::SetUp();
+    ASSERT_EQ(0, this->img.Load(std::string(PROJECT_SOURCE_PATH) +
+        "/media/materials/textures/heightmap_bowl.png"));
+    this->vertSize = this->img.GetWidth() * 2 - 1;
+    this->img.FillHeightMap(2, this->vertSize, this->size, this->scale,
+        false, this->heights);
+    ASSERT_EQ(this->vertSize * this->vertSize, this->heights.size());
+  }
+
+  /// \brief Terrain data.
+  public: common::ImageHeightmap img;
+
+  /// \brief Number of points per row of the height table.
+  public: unsigned int vertSize = 0;
+
+  /// \brief Terrain size.
+  public: ignition::math::Vector3d size{129, 129, 10};
+
+  /// \brief Height scale.
+  public: ignition::math::Vector3d scale{1, 1, 10};
+
+  /// \brief Whole height table.
+  public: std::vector<float> heights;
+};
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapTiles, Heights)
+{
+  physics::HeightmapTiles tiles(&this->img, 2, this->vertSize, this->size,
+      this->scale, false, 64, 4);
+  EXPECT_EQ(64u, tiles.TileSize());
+  EXPECT_EQ(4u, tiles.Budget());
+  EXPECT_EQ(5u, tiles.TilesPerSide());
+  EXPECT_EQ(0u, tiles.ResidentTileCount());
+  EXPECT_EQ(6u, tiles.TileIndex(64, 70));
+  EXPECT_EQ(24u, tiles.TileIndex(this->vertSize - 1, this->vertSize - 1));
+
+  // Reading every height pages all tiles through the budget.
+  for (unsigned int y = 0; y < this->vertSize; y += 7)
+  {
+    for (unsigned int x = 0; x < this->vertSize; x += 3)
+    {
+      ASSERT_FLOAT_EQ(this->heights[y * this->vertSize + x],
+          tiles.Height(x, y));
+    }
+    EXPECT_LE(tiles.ResidentTileCount(), 4u);
+  }
+
+  EXPECT_FLOAT_EQ(0.0f, tiles.Height(-1, 0));
+  EXPECT_FLOAT_EQ(0.0f, tiles.Height(0, this->vertSize));
+}
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapTiles, ActiveTiles)
+{
+  physics::HeightmapTiles tiles(&this->img, 2, this->vertSize, this->size,
+      this->scale, false, 64, 3);
+
+  tiles.SetActiveTiles({0, 1, 5});
+  tiles.WaitForActiveTiles();
+  EXPECT_EQ(3u, tiles.ResidentTileCount());
+
+  // New active tiles release the oldest inactive ones.
+  tiles.SetActiveTiles({12, 13});
+  tiles.WaitForActiveTiles();
+  EXPECT_EQ(3u, tiles.ResidentTileCount());
+  EXPECT_FLOAT_EQ(this->heights[130 * this->vertSize + 200],
+      tiles.Height(200, 130));
+
+  // Active tiles stay resident beyond the budget.
+  tiles.SetActiveTiles({20, 21, 22, 23});
+  tiles.WaitForActiveTiles();
+  EXPECT_EQ(4u, tiles.ResidentTileCount());
+
+  // Concurrent readers see the same heights.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.push_back(std::thread([&, t]()
+        {
+          for (unsigned int y = t; y < this->vertSize; y += 16)
+          {
+            for (unsigned int x = 0; x < this->vertSize; x += 16)
+            {
+              EXPECT_FLOAT_EQ(this->heights[y * this->vertSize + x],
+                  tiles.Height(x, y));
+            }
+          }
+        }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  // Tiles filled by the readers are released on the next update.
+  tiles.SetActiveTiles({20, 21, 22, 23});
+  EXPECT_EQ(4u, tiles.ResidentTileCount());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -63,6 +63,7 @@ Joint::Joint(BasePtr _parent)
   this->springReferencePosition[0] = 0;
   this->springReferencePosition[1] = 0;
   this->provideFeedback = false;
+  this->feedbackSubscribers = 0;
   this->stopStiffness[0] = 1e8;
   this->stopDissipation[0] = 1.0;
   this->stopStiffness[1] = 1e8;
@@ -128,7 +129,11 @@ void Joint::Load(sdf::ElementPtr _sdf)
     sdf::ElementPtr physicsElem = _sdf->GetElement("physics");
     if (physicsElem->HasElement("provide_feedback"))
     {
-      this->SetProvideFeedback(physicsElem->Get<bool>("provide_feedback"));
+      // Feedback requested in SDF is computed every step
+      const bool provide = physicsElem->Get<bool>("provide_feedback");
+      if (provide)
+        this->AddFeedbackSubscriber();
+      this->SetProvideFeedback(provide);
     }
   }
 
@@ -719,6 +724,18 @@ bool Joint::SetPosition(const unsigned int /*_index*/, const double _position,
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Joint::KinematicSetPosition() const
+{
+  return false;
+}
+
+//////////////////////////////////////////////////
+void Joint::OnKinematicSetPosition(const unsigned int /*_index*/,
+    const double /*_position*/)
+{
+}
+
 //////////////////////////////////////////////////
 bool Joint::SetPositionMaximal(
     const unsigned int _index, double _position,
@@ -1187,6 +1204,25 @@ void Joint::SetProvideFeedback(bool _enable)
   this->provideFeedback = _enable;
 }
 
+//////////////////////////////////////////////////
+void Joint::AddFeedbackSubscriber()
+{
+  ++this->feedbackSubscribers;
+}
+
+//////////////////////////////////////////////////
+void Joint::RemoveFeedbackSubscriber()
+{
+  if (this->feedbackSubscribers > 0)
+    --this->feedbackSubscribers;
+}
+
+//////////////////////////////////////////////////
+unsigned int Joint::FeedbackSubscriberCount() const
+{
+  return this->feedbackSubscribers;
+}
+
 //////////////////////////////////////////////////
 void Joint::SetStopStiffness(unsigned int _index, double _stiffness)
 {
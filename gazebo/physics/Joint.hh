@@ -364,6 +364,21 @@ namespace gazebo
                   const unsigned int _index, const double _position,
                   const bool _preserveWorldVelocity = false);
 
+      /// \brief Get whether SetPosition only moves the connected links
+      /// kinematically, as SetPositionMaximal does. The positions of such
+      /// joints can be set together in one pass over the kinematic tree,
+      /// see JointController::SetJointPositions.
+      /// \return True if the joint position can be set by moving links.
+      public: virtual bool KinematicSetPosition() const;
+
+      /// \brief Update engine state after the links of this joint were
+      /// moved to a new position by a kinematic pass. Called instead of
+      /// SetPosition, once the link poses are set.
+      /// \param[in] _index Index of the joint axis.
+      /// \param[in] _position Position the joint was set to.
+      public: virtual void OnKinematicSetPosition(const unsigned int _index,
+                  const double _position);
+
       /// \brief Helper function for maximal coordinate solver SetPosition.
       /// The child links of this joint are updated based on position change.
       /// And all the links connected to the child link of this joint
@@ -504,6 +519,21 @@ namespace gazebo
       /// \param[in] _enable True to enable joint feedback.
       public: virtual void SetProvideFeedback(bool _enable);
 
+      /// \brief Register a reader that needs joint feedback every step.
+      /// Physics engines that compute feedback on demand keep it enabled
+      /// while at least one subscriber exists, independent of how often
+      /// GetForceTorque is called. Feedback must still be enabled with
+      /// SetProvideFeedback.
+      /// \sa RemoveFeedbackSubscriber
+      public: void AddFeedbackSubscriber();
+
+      /// \brief Unregister a reader added with AddFeedbackSubscriber.
+      public: void RemoveFeedbackSubscriber();
+
+      /// \brief Get the number of feedback subscribers.
+      /// \return Number of readers that need feedback every step.
+      public: unsigned int FeedbackSubscriberCount() const;
+
       /// \brief Cache Joint Force Torque Values if necessary for physics engine
       public: virtual void CacheForceTorque();
 
@@ -632,6 +662,10 @@ namespace gazebo
       /// \brief Register items in the introspection service.
       protected: virtual void RegisterIntrospectionItems() override;
 
+      /// \brief JointController computes child link poses with
+      /// ChildLinkPose when it sets several joint positions in one pass.
+      friend class JointController;
+
       /// \brief Register position items in the introspection service.
       /// \param[in] _index Axis index.
       private: void RegisterIntrospectionPosition(const unsigned int _index);
@@ -709,6 +743,9 @@ namespace gazebo
       /// \brief Provide Feedback data for contact forces
       protected: bool provideFeedback;
 
+      /// \brief Number of readers that need feedback every step.
+      protected: unsigned int feedbackSubscribers;
+
       /// \brief Names of all the sensors attached to the link.
       private: std::vector<std::string> sensors;
 
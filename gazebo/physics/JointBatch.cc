@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/JointBatch.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+JointBatch::JointBatch(const Joint_V &_joints)
+  : joints(_joints)
+{
+  for (auto const &joint : this->joints)
+  {
+    for (unsigned int i = 0; i < joint->DOF(); ++i)
+    {
+      this->axisJoints.push_back(joint.get());
+      this->axisIndices.push_back(i);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+JointBatch::~JointBatch()
+{
+}
+
+/////////////////////////////////////////////////
+const Joint_V &JointBatch::Joints() const
+{
+  return this->joints;
+}
+
+/////////////////////////////////////////////////
+unsigned int JointBatch::AxisCount() const
+{
+  return this->axisJoints.size();
+}
+
+/////////////////////////////////////////////////
+void JointBatch::Positions(std::vector<double> &_positions) const
+{
+  _positions.resize(this->axisJoints.size());
+  for (size_t i = 0; i < this->axisJoints.size(); ++i)
+    _positions[i] = this->axisJoints[i]->Position(this->axisIndices[i]);
+}
+
+/////////////////////////////////////////////////
+void JointBatch::Velocities(std::vector<double> &_velocities) const
+{
+  _velocities.resize(this->axisJoints.size());
+  for (size_t i = 0; i < this->axisJoints.size(); ++i)
+    _velocities[i] = this->axisJoints[i]->GetVelocity(this->axisIndices[i]);
+}
+
+/////////////////////////////////////////////////
+void JointBatch::Forces(std::vector<double> &_forces) const
+{
+  _forces.resize(this->axisJoints.size());
+  for (size_t i = 0; i < this->axisJoints.size(); ++i)
+    _forces[i] = this->axisJoints[i]->GetForce(this->axisIndices[i]);
+}
+
+/////////////////////////////////////////////////
+bool JointBatch::SetForces(const std::vector<double> &_forces)
+{
+  if (_forces.size() != this->axisJoints.size())
+  {
+    gzerr << "Joint batch has " << this->axisJoints.size()
+          << " axes, got " << _forces.size() << " forces\n";
+    return false;
+  }
+
+  for (size_t i = 0; i < this->axisJoints.size(); ++i)
+    this->axisJoints[i]->SetForce(this->axisIndices[i], _forces[i]);
+  return true;
+}
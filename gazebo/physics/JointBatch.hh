@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_JOINTBATCH_HH_
+#define GAZEBO_PHYSICS_JOINTBATCH_HH_
+
+#include <vector>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class JointBatch JointBatch.hh physics/physics.hh
+    /// \brief Fixed set of joints whose state is read and written in bulk.
+    ///
+    /// Every joint contributes all of its axes, in order, so the arrays
+    /// hold one value per axis in the order the joints were given. The set
+    /// is resolved once, which removes the name lookups and the per joint
+    /// calls a controller would otherwise make every step. Physics engines
+    /// may return a derived batch from PhysicsEngine::CreateJointBatch that
+    /// reads the state straight from the engine.
+    /// \sa Model::CreateJointBatch
+    class GZ_PHYSICS_VISIBLE JointBatch
+    {
+      /// \brief Constructor.
+      /// \param[in] _joints Joints of the batch.
+      public: explicit JointBatch(const Joint_V &_joints);
+
+      /// \brief Destructor.
+      public: virtual ~JointBatch();
+
+      /// \brief Get the joints of the batch.
+      /// \return The joints, in order.
+      public: const Joint_V &Joints() const;
+
+      /// \brief Get the number of values in the arrays of the batch.
+      /// \return The total number of axes of the joints.
+      public: unsigned int AxisCount() const;
+
+      /// \brief Read the positions of all the axes.
+      /// \param[out] _positions Positions, resized to AxisCount.
+      /// \sa Joint::Position
+      public: virtual void Positions(std::vector<double> &_positions) const;
+
+      /// \brief Read the velocities of all the axes.
+      /// \param[out] _velocities Velocities, resized to AxisCount.
+      /// \sa Joint::GetVelocity
+      public: virtual void Velocities(std::vector<double> &_velocities) const;
+
+      /// \brief Read the forces applied to all the axes.
+      /// \param[out] _forces Forces, resized to AxisCount.
+      /// \sa Joint::GetForce
+      public: virtual void Forces(std::vector<double> &_forces) const;
+
+      /// \brief Apply forces to all the axes, with the same limits and
+      /// accumulation as Joint::SetForce.
+      /// \param[in] _forces One force per axis.
+      /// \return False if the size of _forces is not AxisCount.
+      public: virtual bool SetForces(const std::vector<double> &_forces);
+
+      /// \brief Joints of the batch.
+      protected: Joint_V joints;
+
+      /// \brief Joint of each axis.
+      protected: std::vector<Joint *> axisJoints;
+
+      /// \brief Index of each axis in its joint.
+      protected: std::vector<unsigned int> axisIndices;
+    };
+    /// \}
+  }
+}
+#endif
@@ -15,8 +15,16 @@
  *
 */
 
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include <boost/algorithm/string.hpp>
+#include <ignition/math/Helpers.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Subscriber.hh"
 #include "gazebo/physics/Model.hh"
@@ -31,6 +39,55 @@
 using namespace gazebo;
 using namespace physics;
 
+/////////////////////////////////////////////////
+void JointControllerPrivate::Compile()
+{
+  this->forceTargets.clear();
+  this->positionTargets.clear();
+  this->velocityTargets.clear();
+
+  for (auto const &force : this->forces)
+  {
+    auto joint = this->joints.find(force.first);
+    if (joint != this->joints.end() && joint->second)
+      this->forceTargets.push_back({joint->second.get(), &force.second});
+  }
+
+  for (auto const &position : this->positions)
+  {
+    auto joint = this->joints.find(position.first);
+    if (joint != this->joints.end() && joint->second)
+    {
+      this->positionTargets.push_back({joint->second.get(),
+          &this->posPids[position.first], &position.second});
+    }
+  }
+
+  for (auto const &velocity : this->velocities)
+  {
+    auto joint = this->joints.find(velocity.first);
+    if (joint != this->joints.end() && joint->second)
+    {
+      this->velocityTargets.push_back({joint->second.get(),
+          &this->velPids[velocity.first], &velocity.second});
+    }
+  }
+
+  this->targetsDirty = false;
+}
+
+/////////////////////////////////////////////////
+void JointControllerPrivate::SetCommand(
+    std::map<std::string, double> &_commands, const std::string &_name,
+    const double _value)
+{
+  auto result = _commands.emplace(_name, _value);
+  if (result.second)
+    this->targetsDirty = true;
+  else
+    result.first->second = _value;
+}
+
 /////////////////////////////////////////////////
 JointController::JointController(ModelPtr _model)
   : dataPtr(new JointControllerPrivate)
@@ -74,6 +131,7 @@ void JointController::AddJoint(JointPtr _joint)
       1, 0.1, 0.01, 1, -1, 1000, -1000);
   this->dataPtr->velPids[_joint->GetScopedName()].Init(
       1, 0.1, 0.01, 1, -1, 1000, -1000);
+  this->dataPtr->targetsDirty = true;
 }
 
 /////////////////////////////////////////////////
@@ -84,6 +142,7 @@ void JointController::RemoveJoint(Joint *_joint)
     this->dataPtr->joints.erase(_joint->GetScopedName());
     this->dataPtr->posPids.erase(_joint->GetScopedName());
     this->dataPtr->velPids.erase(_joint->GetScopedName());
+    this->dataPtr->targetsDirty = true;
   }
 }
 
@@ -94,6 +153,7 @@ void JointController::Reset()
   this->dataPtr->positions.clear();
   this->dataPtr->velocities.clear();
   this->dataPtr->forces.clear();
+  this->dataPtr->targetsDirty = true;
 
   std::map<std::string, common::PID>::iterator iter;
 
@@ -124,47 +184,29 @@ void JointController::Update()
   // TODO: fix this when World::ResetTime is improved
   if (stepTime > 0)
   {
+    if (this->dataPtr->targetsDirty)
+      this->dataPtr->Compile();
+
     IGN_PROFILE_BEGIN("forces");
-    if (!this->dataPtr->forces.empty())
-    {
-      std::map<std::string, double>::iterator iter;
-      for (iter = this->dataPtr->forces.begin();
-          iter != this->dataPtr->forces.end(); ++iter)
-      {
-        this->dataPtr->joints[iter->first]->SetForce(0, iter->second);
-      }
-    }
+    for (auto const &target : this->dataPtr->forceTargets)
+      target.joint->SetForce(0, *target.force);
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("positions");
-    if (!this->dataPtr->positions.empty())
+    for (auto const &target : this->dataPtr->positionTargets)
     {
-      std::map<std::string, double>::iterator iter;
-
-      for (iter = this->dataPtr->positions.begin();
-           iter != this->dataPtr->positions.end(); ++iter)
-      {
-        double cmd = this->dataPtr->posPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->Position(0) -
-            iter->second, stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
-      }
+      double cmd = target.pid->Update(
+          target.joint->Position(0) - *target.target, stepTime);
+      target.joint->SetForce(0, cmd);
     }
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("velocities");
-    if (!this->dataPtr->velocities.empty())
+    for (auto const &target : this->dataPtr->velocityTargets)
     {
-      std::map<std::string, double>::iterator iter;
-
-      for (iter = this->dataPtr->velocities.begin();
-           iter != this->dataPtr->velocities.end(); ++iter)
-      {
-        double cmd = this->dataPtr->velPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->GetVelocity(0) - iter->second,
-            stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
-      }
+      double cmd = target.pid->Update(
+          target.joint->GetVelocity(0) - *target.target, stepTime);
+      target.joint->SetForce(0, cmd);
     }
     IGN_PROFILE_END();
   }
@@ -250,6 +292,8 @@ void JointController::OnJointCommand(const ignition::msgs::JointCmd &_msg)
   {
     if (_msg.reset())
     {
+      this->dataPtr->targetsDirty = true;
+
       if (this->dataPtr->forces.find(_msg.name()) !=
           this->dataPtr->forces.end())
       {
@@ -272,7 +316,10 @@ void JointController::OnJointCommand(const ignition::msgs::JointCmd &_msg)
     }
 
     if (_msg.has_force_optional())
-      this->dataPtr->forces[_msg.name()] = _msg.force_optional().data();
+    {
+      this->dataPtr->SetCommand(this->dataPtr->forces, _msg.name(),
+          _msg.force_optional().data());
+    }
 
     if (_msg.has_position())
     {
@@ -397,8 +444,10 @@ void JointController::SetJointPosition(const std::string & _name,
 void JointController::SetJointPositions(
     const std::map<std::string, double> & _jointPositions)
 {
-  // go through all joints in this model and update each one
-  //   for each joint update, recursively update all children
+  IGN_PROFILE("JointController::SetJointPositions");
+
+  // go through all joints in this model and collect the ones to update
+  std::vector<std::pair<JointPtr, double>> positions;
   std::map<std::string, JointPtr>::iterator iter;
   std::map<std::string, double>::const_iterator jiter;
 
@@ -416,8 +465,159 @@ void JointController::SetJointPositions(
         continue;
     }
 
-    this->SetJointPosition(iter->second, jiter->second);
+    positions.push_back(std::make_pair(iter->second, jiter->second));
+  }
+
+  // Several joints share subtrees, so set them all in one pass
+  if (positions.size() > 1u && this->SetJointPositionsKinematic(positions))
+    return;
+
+  // for each joint update, recursively update all children
+  for (const auto &position : positions)
+    this->SetJointPosition(position.first, position.second);
+}
+
+//////////////////////////////////////////////////
+bool JointController::SetJointPositionsKinematic(
+    const std::vector<std::pair<JointPtr, double>> &_positions)
+{
+  ModelPtr model = this->dataPtr->model;
+  if (!model || model->IsStatic() || !model->GetWorld())
+    return false;
+
+  // Target position of each joint, truncated by the joint limits
+  std::unordered_map<Joint *, double> targets;
+  for (const auto &position : _positions)
+  {
+    const JointPtr &joint = position.first;
+    if (!joint->KinematicSetPosition() || !joint->GetChild() ||
+        !(joint->HasType(Base::HINGE_JOINT) ||
+          joint->HasType(Base::UNIVERSAL_JOINT) ||
+          joint->HasType(Base::SLIDER_JOINT)))
+    {
+      return false;
+    }
+
+    const double lower = joint->LowerLimit(0);
+    const double upper = joint->UpperLimit(0);
+    targets[joint.get()] = lower < upper ?
+      ignition::math::clamp(position.second, lower, upper) :
+      ignition::math::clamp(position.second, upper, lower);
+  }
+
+  /// \brief Pose change of one link.
+  struct LinkUpdate
+  {
+    /// \brief Link to move.
+    LinkPtr link;
+
+    /// \brief World pose before the update.
+    ignition::math::Pose3d oldPose;
+
+    /// \brief World pose after the update.
+    ignition::math::Pose3d newPose;
+
+    /// \brief True if a joint between the link and the root was set.
+    bool moved;
+  };
+
+  // Links in topological order. A joint on the stack connects the link at
+  // the stored index, or the world for kNoParent, to its child link.
+  const size_t kNoParent = std::numeric_limits<size_t>::max();
+  std::vector<LinkUpdate> updates;
+  std::unordered_set<Link *> visited;
+  std::vector<std::pair<JointPtr, size_t>> stack;
+
+  for (const auto &link : model->GetLinks())
+  {
+    if (link->GetParentJoints().empty())
+    {
+      updates.push_back({link, link->WorldPose(), link->WorldPose(), false});
+      visited.insert(link.get());
+      for (const auto &joint : link->GetChildJoints())
+        stack.push_back(std::make_pair(joint, updates.size() - 1u));
+    }
+  }
+  for (const auto &joint : model->GetJoints())
+  {
+    if (!joint->GetParent())
+      stack.push_back(std::make_pair(joint, kNoParent));
+  }
+
+  size_t targetCount = 0u;
+  while (!stack.empty())
+  {
+    JointPtr joint = stack.back().first;
+    const size_t parentIndex = stack.back().second;
+    stack.pop_back();
+
+    LinkPtr child = joint->GetChild();
+    if (!child)
+      continue;
+
+    // A link reached twice is inside a loop, which can not be set
+    // kinematically
+    if (!visited.insert(child.get()).second)
+      return false;
+
+    LinkUpdate update;
+    update.link = child;
+    update.oldPose = child->WorldPose();
+    update.moved = parentIndex != kNoParent && updates[parentIndex].moved;
+
+    // Move the child about the joint in the current configuration, then
+    // with its parent link
+    ignition::math::Pose3d pose = update.oldPose;
+    auto target = targets.find(joint.get());
+    if (target != targets.end())
+    {
+      pose = joint->ChildLinkPose(0, target->second);
+      update.moved = true;
+      ++targetCount;
+    }
+
+    if (parentIndex == kNoParent)
+    {
+      update.newPose = pose;
+    }
+    else
+    {
+      update.newPose = (pose - updates[parentIndex].oldPose) +
+        updates[parentIndex].newPose;
+    }
+
+    updates.push_back(update);
+    for (const auto &childJoint : child->GetChildJoints())
+      stack.push_back(std::make_pair(childJoint, updates.size() - 1u));
+  }
+
+  // Every joint must have been reached from a root link
+  if (targetCount != targets.size())
+    return false;
+
+  {
+    // block any other physics pose updates
+    boost::recursive_mutex::scoped_lock lock(
+      *model->GetWorld()->Physics()->GetPhysicsUpdateMutex());
+
+    for (const auto &update : updates)
+    {
+      if (!update.moved)
+        continue;
+
+      update.link->SetWorldPose(update.newPose, true, false);
+      update.link->SetWorldTwist(ignition::math::Vector3d::Zero,
+          ignition::math::Vector3d::Zero);
+    }
   }
+
+  for (const auto &position : _positions)
+    position.first->OnKinematicSetPosition(0, position.second);
+
+  // Publish the model once instead of once per moved link
+  model->GetWorld()->PublishModelPose(model);
+
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -491,7 +691,7 @@ bool JointController::SetPositionTarget(const std::string &_jointName,
   if (this->dataPtr->posPids.find(_jointName) !=
       this->dataPtr->posPids.end())
   {
-    this->dataPtr->positions[_jointName] = _target;
+    this->dataPtr->SetCommand(this->dataPtr->positions, _jointName, _target);
     result = true;
   }
 
@@ -520,7 +720,8 @@ bool JointController::SetVelocityTarget(const std::string &_jointName,
   if (this->dataPtr->velPids.find(_jointName) !=
       this->dataPtr->velPids.end())
   {
-    this->dataPtr->velocities[_jointName] = _target;
+    this->dataPtr->SetCommand(this->dataPtr->velocities, _jointName,
+        _target);
     result = true;
   }
 
@@ -536,7 +737,7 @@ bool JointController::SetForce(const std::string &_jointName,
   if (this->dataPtr->joints.find(_jointName) !=
       this->dataPtr->joints.end())
   {
-    this->dataPtr->forces[_jointName] = _force;
+    this->dataPtr->SetCommand(this->dataPtr->forces, _jointName, _force);
     result = true;
   }
 
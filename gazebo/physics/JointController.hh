@@ -19,6 +19,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 #include <ignition/msgs.hh>
 
@@ -70,6 +71,10 @@ namespace gazebo
         const std::string &_name, double _position, int _index = 0);
 
       /// \brief Set the positions of a set of Joint's.
+      /// When every joint supports Joint::KinematicSetPosition and the
+      /// model's joints form a tree, all positions are applied in one
+      /// pass over the tree and each link pose is written once. Otherwise
+      /// the joints are set one at a time.
       /// \sa JointController::SetJointPosition(JointPtr, double)
       public: void SetJointPositions(
                   const std::map<std::string, double> &_jointPositions);
@@ -155,6 +160,18 @@ namespace gazebo
       /// \param[in] _msg The received message.
       private: void OnJointCommand(const ignition::msgs::JointCmd &_msg);
 
+      /// \brief Set the positions of several joints in one forward
+      /// kinematics pass. Links are visited in topological order, starting
+      /// from the links without a parent joint, so each link pose is
+      /// computed from the already updated pose of its parent link and
+      /// set once.
+      /// \param[in] _positions Joints to set, with their positions.
+      /// \return False, without moving any link, if a joint does not
+      /// support Joint::KinematicSetPosition or the links connected to the
+      /// model contain a loop.
+      private: bool SetJointPositionsKinematic(
+          const std::vector<std::pair<JointPtr, double>> &_positions);
+
       /// \brief Set the positions of a Joint by name
       ///        The position is specified in native units, which means,
       ///        if you are using metric system, it's meters for SliderJoint
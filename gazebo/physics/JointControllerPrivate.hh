@@ -19,6 +19,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <ignition/transport.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -30,8 +31,45 @@ namespace gazebo
 {
   namespace physics
   {
+    /// \brief A force command, resolved for JointController::Update.
+    class JointForceTarget
+    {
+      /// \brief Joint to apply the force to.
+      public: Joint *joint;
+
+      /// \brief Force to apply, the value in JointControllerPrivate::forces.
+      public: const double *force;
+    };
+
+    /// \brief A position or velocity command, resolved for
+    /// JointController::Update.
+    class JointPIDTarget
+    {
+      /// \brief Joint to control.
+      public: Joint *joint;
+
+      /// \brief PID controller of the joint.
+      public: common::PID *pid;
+
+      /// \brief Target of the joint, the value in
+      /// JointControllerPrivate::positions or velocities.
+      public: const double *target;
+    };
+
     class JointControllerPrivate
     {
+      /// \brief Resolve the commands into the target lists, so that
+      /// JointController::Update does no name lookup.
+      public: void Compile();
+
+      /// \brief Set a command, and mark the targets to be resolved again
+      /// if the command is new.
+      /// \param[in] _commands Forces, positions or velocities.
+      /// \param[in] _name Scoped name of the joint.
+      /// \param[in] _value Value of the command.
+      public: void SetCommand(std::map<std::string, double> &_commands,
+                  const std::string &_name, const double _value);
+
       /// \brief Model to control.
       public: ModelPtr model;
 
@@ -68,6 +106,20 @@ namespace gazebo
 
       /// \brief Last time the controller was updated.
       public: common::Time prevUpdateTime;
+
+      /// \brief Force commands, in the order of the forces map.
+      public: std::vector<JointForceTarget> forceTargets;
+
+      /// \brief Position commands, in the order of the positions map.
+      public: std::vector<JointPIDTarget> positionTargets;
+
+      /// \brief Velocity commands, in the order of the velocities map.
+      public: std::vector<JointPIDTarget> velocityTargets;
+
+      /// \brief True if a joint, PID or command was added or removed since
+      /// the targets were resolved. The targets point into the maps above,
+      /// whose values do not move until they are erased.
+      public: bool targetsDirty = true;
     };
   }
 }
@@ -16,6 +16,7 @@
 */
 
 #include <boost/algorithm/string.hpp>
+#include <atomic>
 #include <functional>
 #include <mutex>
 #include <sstream>
@@ -61,6 +62,10 @@ class gazebo::physics::LinkPrivate
   /// \brief This flag is used to trigger the enabled
   public: bool enabled = false;
 
+  /// \brief True while the model of the link is asleep. Read by physics
+  /// engine threads when they report moved links.
+  public: std::atomic<bool> sleeping{false};
+
   /// \brief Names of all the sensors attached to the link.
   public: std::vector<std::string> sensors;
 
@@ -103,12 +108,16 @@ class gazebo::physics::LinkPrivate
   /// \brief Wind velocity.
   public: ignition::math::Vector3d windLinearVel;
 
-  /// \brief Update connection to calculate wind velocity.
-  public: event::ConnectionPtr updateConnection;
+  /// \brief Features of the link that need work at every world update, a
+  /// combination of the UpdateFeature values.
+  public: unsigned int updateFeatures = 0;
 
   /// \brief All the attached batteries.
   public: std::vector<common::BatteryPtr> batteries;
 
+  /// \brief True if the collisions are swept along the velocity.
+  public: bool continuousCollision = false;
+
 #ifdef HAVE_OPENAL
       /// \brief All the audio sources
       public: std::vector<util::OpenALSourcePtr> audioSources;
@@ -123,11 +132,34 @@ class gazebo::physics::LinkPrivate
 
   /// \brief SDF Link DOM object
   public: const sdf::Link *linkSDFDom = nullptr;
+
+  /// \brief True if the visual SDF changed since the visual msgs were
+  /// last generated from it.
+  public: bool visualMsgsDirty = true;
+
+  /// \brief Sensor msgs generated from SDF, reused by FillMsg.
+  public: std::vector<msgs::Sensor> sensorMsgs;
+
+  /// \brief True if sensorMsgs must be generated again.
+  public: bool sensorMsgsDirty = true;
 };
 
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Features of a link that need work at every world update.
+enum UpdateFeature : unsigned int
+{
+  /// \brief Audio sources or an audio sink follow the link.
+  AUDIO_UPDATE = 0x1,
+
+  /// \brief The wind velocity of the link is computed.
+  WIND_UPDATE = 0x2,
+
+  /// \brief Batteries drain with time.
+  BATTERY_UPDATE = 0x4
+};
+
 //////////////////////////////////////////////////
 Link::Link(EntityPtr _parent)
     : Entity(_parent), dataPtr(new LinkPrivate)
@@ -278,6 +310,9 @@ void Link::Load(sdf::ElementPtr _sdf)
     this->dataPtr->audioSink = util::OpenAL::Instance()->CreateSink(
         _sdf->GetElement("audio_sink"));
   }
+
+  this->SetUpdateFeature(AUDIO_UPDATE, this->dataPtr->audioSink ||
+      !this->dataPtr->audioSources.empty());
 #endif
 
   if (this->sdf->HasElement("battery"))
@@ -301,10 +336,10 @@ void Link::Load(sdf::ElementPtr _sdf)
   this->sdf->GetElement("enable_wind")->GetValue()->SetUpdateFunc(
       std::bind(&Link::WindMode, this));
 
-  this->connections.push_back(event::Events::ConnectWorldUpdateBegin(
-      std::bind(
-      static_cast<void(Link::*)(const common::UpdateInfo &)>(&Link::Update),
-      this, std::placeholders::_1)));
+  // Continuous collision is not part of the SDFormat spec, so the value is
+  // copied as a string.
+  if (this->sdf->HasElement("enable_ccd"))
+    this->dataPtr->continuousCollision = this->sdf->Get<bool>("enable_ccd");
 
   this->SetStatic(this->IsStatic());
 }
@@ -327,6 +362,7 @@ void Link::Init()
       CollisionPtr collision = boost::static_pointer_cast<Collision>(*iter);
       this->dataPtr->collisions.push_back(collision);
       collision->Init();
+      this->InvalidateBoundingBox();
     }
     if ((*iter)->HasType(Base::LIGHT))
     {
@@ -350,7 +386,14 @@ void Link::Init()
 //////////////////////////////////////////////////
 void Link::Fini()
 {
-  this->dataPtr->updateConnection.reset();
+  if ((this->dataPtr->updateFeatures & WIND_UPDATE) && this->world)
+    this->world->Wind().RemoveEntity(this);
+  this->dataPtr->updateFeatures = 0;
+
+  // The model no longer updates this link
+  ModelPtr model = this->GetModel();
+  if (model)
+    model->SetLinkUpdating(this, false);
 
   this->dataPtr->attachedModels.clear();
   this->dataPtr->parentJoints.clear();
@@ -448,6 +491,9 @@ void Link::UpdateParameters(sdf::ElementPtr _sdf)
 {
   Entity::UpdateParameters(_sdf);
 
+  this->dataPtr->visualMsgsDirty = true;
+  this->dataPtr->sensorMsgsDirty = true;
+
   if (this->sdf->HasElement("inertial"))
   {
     sdf::ElementPtr inertialElem = this->sdf->GetElement("inertial");
@@ -590,24 +636,47 @@ void Link::SetLaserRetro(float _retro)
 }
 
 //////////////////////////////////////////////////
-void Link::Update(const common::UpdateInfo & /*_info*/)
+void Link::Update(const common::UpdateInfo &_info)
 {
   IGN_PROFILE("Link::Update");
-#ifdef HAVE_OPENAL
-  IGN_PROFILE_BEGIN("audio");
-  if (this->dataPtr->audioSink)
+  if (this->dataPtr->updateFeatures & WIND_UPDATE)
+    this->UpdateWind(_info);
+
+  if (this->IsSleeping())
   {
-    this->dataPtr->audioSink->SetPose(this->WorldPose());
-    this->dataPtr->audioSink->SetVelocity(this->WorldLinearVel());
+    bool wrenches;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->wrenchMsgMutex);
+      wrenches = !this->dataPtr->wrenchMsgs.empty();
+    }
+
+    // A wrench message wakes the model. Otherwise only the batteries,
+    // which drain with time, are updated.
+    if (wrenches)
+    {
+      this->Wake();
+    }
+    else
+    {
+      for (auto &battery : this->dataPtr->batteries)
+        battery->Update();
+      return;
+    }
   }
 
-  // Update all the audio sources
-  for (std::vector<util::OpenALSourcePtr>::iterator iter =
-      this->dataPtr->audioSources.begin(); iter !=
-      this->dataPtr->audioSources.end(); ++iter)
+#ifdef HAVE_OPENAL
+  IGN_PROFILE_BEGIN("audio");
+  // The audio thread applies the poses, so OpenAL is not called here.
+  if (this->dataPtr->audioSink || !this->dataPtr->audioSources.empty())
   {
-    (*iter)->SetPose(this->WorldPose());
-    (*iter)->SetVelocity(this->WorldLinearVel());
+    util::OpenAL *openAL = util::OpenAL::Instance();
+    const ignition::math::Pose3d pose = this->WorldPose();
+    const ignition::math::Vector3d vel = this->WorldLinearVel();
+    if (this->dataPtr->audioSink)
+      openAL->QueueSinkUpdate(this->dataPtr->audioSink, pose, vel);
+
+    for (auto const &source : this->dataPtr->audioSources)
+      openAL->QueueSourceUpdate(source, pose, vel);
   }
   IGN_PROFILE_END();
 #endif
@@ -645,6 +714,25 @@ void Link::Update(const common::UpdateInfo & /*_info*/)
   IGN_PROFILE_END();
 }
 
+//////////////////////////////////////////////////
+bool Link::IsSleeping() const
+{
+  return this->dataPtr->sleeping;
+}
+
+//////////////////////////////////////////////////
+void Link::SetSleeping(const bool _sleeping)
+{
+  this->dataPtr->sleeping = _sleeping;
+}
+
+//////////////////////////////////////////////////
+void Link::Wake()
+{
+  if (this->IsSleeping())
+    this->GetParentModel()->Wake();
+}
+
 //////////////////////////////////////////////////
 void Link::UpdateWind(const common::UpdateInfo & /*_info*/)
 {
@@ -834,20 +922,20 @@ ModelPtr Link::GetModel() const
 //////////////////////////////////////////////////
 ignition::math::AxisAlignedBox Link::BoundingBox() const
 {
-  ignition::math::AxisAlignedBox box;
+  return this->BoundingBoxCache([this]()
+  {
+    ignition::math::AxisAlignedBox box;
 
-  box.Min().Set(ignition::math::MAX_D, ignition::math::MAX_D,
-      ignition::math::MAX_D);
-  box.Max().Set(-ignition::math::MAX_D, -ignition::math::MAX_D,
-     -ignition::math::MAX_D);
+    box.Min().Set(ignition::math::MAX_D, ignition::math::MAX_D,
+        ignition::math::MAX_D);
+    box.Max().Set(-ignition::math::MAX_D, -ignition::math::MAX_D,
+       -ignition::math::MAX_D);
 
-  for (Collision_V::const_iterator iter = this->dataPtr->collisions.begin();
-       iter != this->dataPtr->collisions.end(); ++iter)
-  {
-    box += (*iter)->BoundingBox();
-  }
+    for (const auto &collision : this->dataPtr->collisions)
+      box += collision->CachedBoundingBox();
 
-  return box;
+    return box;
+  });
 }
 
 //////////////////////////////////////////////////
@@ -855,9 +943,10 @@ void Link::SetWindMode(const bool _mode)
 {
   this->sdf->GetElement("enable_wind")->Set(_mode);
 
-  if (!this->WindMode() && this->dataPtr->updateConnection)
+  const bool enabled = this->dataPtr->updateFeatures & WIND_UPDATE;
+  if (!this->WindMode() && enabled)
     this->SetWindEnabled(false);
-  else if (this->WindMode() && !this->dataPtr->updateConnection)
+  else if (this->WindMode() && !enabled)
     this->SetWindEnabled(true);
 }
 
@@ -866,12 +955,13 @@ void Link::SetWindEnabled(const bool _enable)
 {
   if (_enable)
   {
-    this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
-        std::bind(&Link::UpdateWind, this, std::placeholders::_1));
+    this->world->Wind().AddEntity(this);
+    this->SetUpdateFeature(WIND_UPDATE, true);
   }
   else
   {
-    this->dataPtr->updateConnection.reset();
+    this->world->Wind().RemoveEntity(this);
+    this->SetUpdateFeature(WIND_UPDATE, false);
     // Make sure wind velocity is null
     this->dataPtr->windLinearVel.Set(0, 0, 0);
   }
@@ -889,6 +979,18 @@ bool Link::WindMode() const
   return this->sdf->Get<bool>("enable_wind");
 }
 
+//////////////////////////////////////////////////
+void Link::SetContinuousCollision(const bool _enable)
+{
+  this->dataPtr->continuousCollision = _enable;
+}
+
+//////////////////////////////////////////////////
+bool Link::ContinuousCollision() const
+{
+  return this->dataPtr->continuousCollision;
+}
+
 //////////////////////////////////////////////////
 bool Link::SetSelected(bool _s)
 {
@@ -1012,23 +1114,33 @@ void Link::FillMsg(msgs::Link &_msg)
     }
   }
 
-  // Add in the sensor data.
-  if (this->sdf->HasElement("sensor"))
+  // Add in the sensor data. The SDF conversion is only redone when the
+  // link's SDF is updated.
+  if (this->dataPtr->sensorMsgsDirty)
   {
-    sdf::ElementPtr sensorElem = this->sdf->GetElement("sensor");
-    while (sensorElem)
+    this->dataPtr->sensorMsgs.clear();
+    if (this->sdf->HasElement("sensor"))
     {
-      msgs::Sensor *msg = _msg.add_sensor();
-      msg->CopyFrom(msgs::SensorFromSDF(sensorElem));
-      msg->set_parent(this->GetScopedName());
-      msg->set_parent_id(this->GetId());
-      sensorElem = sensorElem->GetNextElement("sensor");
+      sdf::ElementPtr sensorElem = this->sdf->GetElement("sensor");
+      while (sensorElem)
+      {
+        this->dataPtr->sensorMsgs.push_back(msgs::SensorFromSDF(sensorElem));
+        sensorElem = sensorElem->GetNextElement("sensor");
+      }
     }
+    this->dataPtr->sensorMsgsDirty = false;
+  }
+  for (const auto &sensorMsg : this->dataPtr->sensorMsgs)
+  {
+    msgs::Sensor *msg = _msg.add_sensor();
+    msg->CopyFrom(sensorMsg);
+    msg->set_parent(this->GetScopedName());
+    msg->set_parent_id(this->GetId());
   }
 
   if (this->visuals.empty())
     this->ParseVisuals();
-  else
+  else if (this->dataPtr->visualMsgsDirty)
     this->UpdateVisualMsg();
 
   for (Visuals_M::iterator iter = this->visuals.begin();
@@ -1421,7 +1533,7 @@ void Link::OnCollision(ConstContactsPtr &_msg)
     {
       if ((*iter)->HasCollisionName(collisionName1) ||
           (*iter)->HasCollisionName(collisionName2))
-        (*iter)->Play();
+        util::OpenAL::Instance()->QueuePlay(*iter);
     }
 #endif
   }
@@ -1458,6 +1570,7 @@ void Link::RemoveCollision(const std::string &_name)
     if ((*iter)->GetName() == _name || (*iter)->GetScopedName() == _name)
     {
       this->dataPtr->collisions.erase(iter);
+      this->InvalidateBoundingBox();
       break;
     }
   }
@@ -1477,6 +1590,7 @@ void Link::SetScale(const ignition::math::Vector3d &_scale)
 
   // update the visual sdf to ensure cloning and saving has the correct values.
   this->UpdateVisualGeomSDF(_scale);
+  this->dataPtr->visualMsgsDirty = true;
 
   this->scale = _scale;
 }
@@ -1594,6 +1708,8 @@ void Link::UpdateVisualMsg()
       visualElem = visualElem->GetNextElement("visual");
     }
   }
+
+  this->dataPtr->visualMsgsDirty = false;
 }
 
 /////////////////////////////////////////////////
@@ -1822,8 +1938,18 @@ void Link::OnWrenchMsg(ConstWrenchPtr &_msg)
     return;
   }
 
-  std::lock_guard<std::mutex> lock(this->dataPtr->wrenchMsgMutex);
-  this->dataPtr->wrenchMsgs.push_back(*_msg);
+  bool first;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->wrenchMsgMutex);
+    this->dataPtr->wrenchMsgs.push_back(*_msg);
+    first = this->dataPtr->wrenchMsgs.size() == 1;
+  }
+
+  // The first pending message asks the model for a single update, which
+  // applies all the messages received until then.
+  ModelPtr model = this->GetModel();
+  if (first && model)
+    model->QueueLinkUpdate(this);
 }
 
 //////////////////////////////////////////////////
@@ -1856,6 +1982,42 @@ void Link::LoadBattery(sdf::ElementPtr _sdf)
   common::BatteryPtr battery(new common::Battery());
   battery->Load(_sdf);
   this->dataPtr->batteries.push_back(battery);
+  this->SetUpdateFeature(BATTERY_UPDATE, true);
+}
+
+//////////////////////////////////////////////////
+void Link::SetUpdateFeature(const unsigned int _feature, const bool _enabled)
+{
+  const unsigned int features = _enabled ?
+      this->dataPtr->updateFeatures | _feature :
+      this->dataPtr->updateFeatures & ~_feature;
+  if (features == this->dataPtr->updateFeatures)
+    return;
+  this->dataPtr->updateFeatures = features;
+
+  ModelPtr model = this->GetModel();
+  if (!model)
+    return;
+
+  model->SetLinkUpdating(this, features != 0);
+
+  // Pending wrenches still need an update
+  if (features == 0)
+  {
+    bool wrenches;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->wrenchMsgMutex);
+      wrenches = !this->dataPtr->wrenchMsgs.empty();
+    }
+    if (wrenches)
+      model->QueueLinkUpdate(this);
+  }
+}
+
+//////////////////////////////////////////////////
+bool Link::HasUpdateWork() const
+{
+  return this->dataPtr->updateFeatures != 0;
 }
 
 /////////////////////////////////////////////////
@@ -79,9 +79,16 @@ namespace gazebo
       /// \param[in] _sdf SDF values to load from.
       public: virtual void UpdateParameters(sdf::ElementPtr _sdf) override;
 
-      /// \brief Update the collision.
+      /// \brief Update the wind, audio, wrenches and batteries of the link.
+      /// The model calls it only while the link has such work.
       /// \param[in] _info Update information.
+      /// \sa Model::UpdateLinks
       public: void Update(const common::UpdateInfo &_info);
+
+      /// \brief Tell whether the link has audio, wind or battery work at
+      /// every world update. Pending wrench messages are not counted.
+      /// \return True if the link needs an update at every step.
+      public: bool HasUpdateWork() const;
       using Base::Update;
 
       /// \brief Set the scale of the link.
@@ -96,6 +103,22 @@ namespace gazebo
       /// \return True if the link is enabled.
       public: virtual bool GetEnabled() const = 0;
 
+      /// \brief Get whether the model of this link is asleep. A sleeping
+      /// link is disabled in the physics engine, and its pose is neither
+      /// propagated nor published until the model wakes up.
+      /// \return True if the link is asleep. Thread safe.
+      /// \sa Model::Sleep
+      public: bool IsSleeping() const;
+
+      /// \brief Mark the link as asleep or awake. This is called by the
+      /// model for each of its links; use Model::Sleep and Model::Wake
+      /// to change the state of a whole model.
+      /// \param[in] _sleeping True if the link is asleep.
+      public: void SetSleeping(const bool _sleeping);
+
+      /// \brief Wake up the top level model of this link if it is asleep.
+      public: void Wake();
+
       /// \brief Set whether this entity has been selected by the user
       /// through the gui
       /// \param[in] _set True to set the link as selected.
@@ -117,6 +140,17 @@ namespace gazebo
       /// \return True if wind is enabled.
       public: virtual bool WindMode() const;
 
+      /// \brief Set whether the collisions of this body are swept along
+      /// its velocity, so that it does not tunnel through thin objects
+      /// when it moves farther than its own size in one step.
+      /// Physics engines without continuous collision detection ignore it.
+      /// \param[in] _enable True to enable continuous collision.
+      public: virtual void SetContinuousCollision(const bool _enable);
+
+      /// \brief Get whether continuous collision is enabled.
+      /// \return True if continuous collision is enabled.
+      public: bool ContinuousCollision() const;
+
       /// \brief Set whether this body will collide with others in the
       /// model.
       /// \sa GetSelfCollide
@@ -672,6 +706,13 @@ namespace gazebo
       /// \param[in] _sdf SDF parameter.
       private: void LoadBattery(const sdf::ElementPtr _sdf);
 
+      /// \brief Turn a feature needing an update at every step on or off,
+      /// and add or remove the link from the links updated by its model.
+      /// \param[in] _feature Feature flag.
+      /// \param[in] _enabled True if the feature is active.
+      private: void SetUpdateFeature(const unsigned int _feature,
+                   const bool _enabled);
+
       /// \brief Register items in the introspection service.
       protected: virtual void RegisterIntrospectionItems() override;
 
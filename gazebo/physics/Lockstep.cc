@@ -0,0 +1,369 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Events.hh"
+#include "gazebo/common/UpdateInfo.hh"
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/Lockstep.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief An action or an observation of a Lockstep.
+class LockstepChannel
+{
+  /// \brief ActionType or ObservationType.
+  public: int type;
+
+  /// \brief Joint, for joint channels.
+  public: JointPtr joint;
+
+  /// \brief Link, for link channels.
+  public: LinkPtr link;
+
+  /// \brief Joint axis.
+  public: unsigned int axis = 0;
+
+  /// \brief Offset in the buffer.
+  public: unsigned int offset = 0;
+
+  /// \brief Function of custom observations.
+  public: Lockstep::ObservationFunc func;
+};
+
+/// \brief Private data for the Lockstep class
+class gazebo::physics::LockstepPrivate
+{
+  /// \brief Apply the actions, before each physics update.
+  /// \param[in] _info Update information.
+  public: void OnBeforePhysicsUpdate(const common::UpdateInfo &_info);
+
+  /// \brief Read the observations, at the end of the last iteration.
+  public: void OnWorldUpdateEnd();
+
+  /// \brief World to step.
+  public: WorldPtr world;
+
+  /// \brief Actions, in buffer order.
+  public: std::vector<LockstepChannel> actions;
+
+  /// \brief Observations, in buffer order.
+  public: std::vector<LockstepChannel> observations;
+
+  /// \brief Number of action values.
+  public: unsigned int actionSize = 0;
+
+  /// \brief Number of observation values.
+  public: unsigned int observationSize = 0;
+
+  /// \brief Serializes calls to Step.
+  public: std::mutex stepMutex;
+
+  /// \brief Actions of the current step.
+  public: const double *actionValues = nullptr;
+
+  /// \brief Observations of the current step.
+  public: double *observationValues = nullptr;
+
+  /// \brief Iteration at the end of the current step.
+  public: uint64_t lastIteration = 0;
+
+  /// \brief True while a step is running. Publishes the buffers to the
+  /// world thread.
+  public: std::atomic<bool> active{false};
+
+  /// \brief True once the observations of the current step are read.
+  public: std::atomic<bool> observed{false};
+
+  /// \brief Event connections.
+  public: std::vector<event::ConnectionPtr> connections;
+};
+
+//////////////////////////////////////////////////
+void LockstepPrivate::OnBeforePhysicsUpdate(const common::UpdateInfo &_info)
+{
+  if (!this->active || _info.worldName != this->world->Name())
+    return;
+
+  for (auto const &action : this->actions)
+  {
+    const double *v = this->actionValues + action.offset;
+    switch (action.type)
+    {
+      case Lockstep::JOINT_FORCE:
+        action.joint->SetForce(action.axis, *v);
+        break;
+      case Lockstep::JOINT_VELOCITY:
+        action.joint->SetVelocity(action.axis, *v);
+        break;
+      case Lockstep::LINK_FORCE:
+        action.link->AddForce(ignition::math::Vector3d(v[0], v[1], v[2]));
+        break;
+      case Lockstep::LINK_TORQUE:
+        action.link->AddTorque(ignition::math::Vector3d(v[0], v[1], v[2]));
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void LockstepPrivate::OnWorldUpdateEnd()
+{
+  if (!this->active || this->observed ||
+      this->world->Iterations() != this->lastIteration)
+  {
+    return;
+  }
+
+  for (auto const &observation : this->observations)
+  {
+    double *v = this->observationValues + observation.offset;
+    switch (observation.type)
+    {
+      case Lockstep::JOINT_POSITION:
+        *v = observation.joint->Position(observation.axis);
+        break;
+      case Lockstep::JOINT_VELOCITY_OBSERVATION:
+        *v = observation.joint->GetVelocity(observation.axis);
+        break;
+      case Lockstep::JOINT_FORCE_OBSERVATION:
+        *v = observation.joint->GetForce(observation.axis);
+        break;
+      case Lockstep::LINK_POSE:
+        {
+          const ignition::math::Pose3d pose = observation.link->WorldPose();
+          v[0] = pose.Pos().X();
+          v[1] = pose.Pos().Y();
+          v[2] = pose.Pos().Z();
+          v[3] = pose.Rot().W();
+          v[4] = pose.Rot().X();
+          v[5] = pose.Rot().Y();
+          v[6] = pose.Rot().Z();
+          break;
+        }
+      case Lockstep::LINK_VELOCITY:
+        {
+          const ignition::math::Vector3d linear =
+            observation.link->WorldLinearVel();
+          const ignition::math::Vector3d angular =
+            observation.link->WorldAngularVel();
+          v[0] = linear.X();
+          v[1] = linear.Y();
+          v[2] = linear.Z();
+          v[3] = angular.X();
+          v[4] = angular.Y();
+          v[5] = angular.Z();
+          break;
+        }
+      default:
+        observation.func(v);
+        break;
+    }
+  }
+
+  this->observed = true;
+}
+
+//////////////////////////////////////////////////
+Lockstep::Lockstep(WorldPtr _world)
+  : dataPtr(new LockstepPrivate)
+{
+  this->dataPtr->world = _world;
+  if (!this->dataPtr->world)
+  {
+    gzerr << "Lockstep requires a world" << std::endl;
+    return;
+  }
+
+  this->dataPtr->connections.push_back(
+      event::Events::ConnectBeforePhysicsUpdate(
+        std::bind(&LockstepPrivate::OnBeforePhysicsUpdate,
+          this->dataPtr.get(), std::placeholders::_1)));
+  this->dataPtr->connections.push_back(
+      event::Events::ConnectWorldUpdateEnd(
+        std::bind(&LockstepPrivate::OnWorldUpdateEnd, this->dataPtr.get())));
+}
+
+//////////////////////////////////////////////////
+Lockstep::~Lockstep()
+{
+  this->dataPtr->connections.clear();
+}
+
+//////////////////////////////////////////////////
+int Lockstep::AddJointAction(JointPtr _joint, const ActionType _type,
+    const unsigned int _axis)
+{
+  if (!_joint || _axis >= _joint->DOF() ||
+      (_type != JOINT_FORCE && _type != JOINT_VELOCITY))
+  {
+    gzerr << "Invalid lockstep joint action" << std::endl;
+    return -1;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->stepMutex);
+  LockstepChannel action;
+  action.type = _type;
+  action.joint = _joint;
+  action.axis = _axis;
+  action.offset = this->dataPtr->actionSize++;
+  this->dataPtr->actions.push_back(action);
+  return action.offset;
+}
+
+//////////////////////////////////////////////////
+int Lockstep::AddLinkAction(LinkPtr _link, const ActionType _type)
+{
+  if (!_link || (_type != LINK_FORCE && _type != LINK_TORQUE))
+  {
+    gzerr << "Invalid lockstep link action" << std::endl;
+    return -1;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->stepMutex);
+  LockstepChannel action;
+  action.type = _type;
+  action.link = _link;
+  action.offset = this->dataPtr->actionSize;
+  this->dataPtr->actionSize += 3;
+  this->dataPtr->actions.push_back(action);
+  return action.offset;
+}
+
+//////////////////////////////////////////////////
+int Lockstep::AddJointObservation(JointPtr _joint,
+    const ObservationType _type, const unsigned int _axis)
+{
+  if (!_joint || _axis >= _joint->DOF() || (_type != JOINT_POSITION &&
+        _type != JOINT_VELOCITY_OBSERVATION &&
+        _type != JOINT_FORCE_OBSERVATION))
+  {
+    gzerr << "Invalid lockstep joint observation" << std::endl;
+    return -1;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->stepMutex);
+  LockstepChannel observation;
+  observation.type = _type;
+  observation.joint = _joint;
+  observation.axis = _axis;
+  observation.offset = this->dataPtr->observationSize++;
+  this->dataPtr->observations.push_back(observation);
+  return observation.offset;
+}
+
+//////////////////////////////////////////////////
+int Lockstep::AddLinkObservation(LinkPtr _link, const ObservationType _type)
+{
+  if (!_link || (_type != LINK_POSE && _type != LINK_VELOCITY))
+  {
+    gzerr << "Invalid lockstep link observation" << std::endl;
+    return -1;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->stepMutex);
+  LockstepChannel observation;
+  observation.type = _type;
+  observation.link = _link;
+  observation.offset = this->dataPtr->observationSize;
+  this->dataPtr->observationSize += _type == LINK_POSE ? 7 : 6;
+  this->dataPtr->observations.push_back(observation);
+  return observation.offset;
+}
+
+//////////////////////////////////////////////////
+int Lockstep::AddObservation(const unsigned int _size,
+    const ObservationFunc &_func)
+{
+  if (!_func)
+  {
+    gzerr << "Invalid lockstep observation function" << std::endl;
+    return -1;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->stepMutex);
+  LockstepChannel observation;
+  observation.type = -1;
+  observation.func = _func;
+  observation.offset = this->dataPtr->observationSize;
+  this->dataPtr->observationSize += _size;
+  this->dataPtr->observations.push_back(observation);
+  return observation.offset;
+}
+
+//////////////////////////////////////////////////
+unsigned int Lockstep::ActionSize() const
+{
+  return this->dataPtr->actionSize;
+}
+
+//////////////////////////////////////////////////
+unsigned int Lockstep::ObservationSize() const
+{
+  return this->dataPtr->observationSize;
+}
+
+//////////////////////////////////////////////////
+bool Lockstep::Step(const double *_actions, const unsigned int _steps,
+    double *_observations)
+{
+  if (!this->dataPtr->world || _steps == 0)
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->stepMutex);
+
+  if (!this->dataPtr->world->IsPaused())
+    this->dataPtr->world->SetPaused(true);
+
+  this->dataPtr->actionValues = _actions;
+  this->dataPtr->observationValues = _observations;
+  this->dataPtr->lastIteration =
+    this->dataPtr->world->Iterations() + _steps;
+  this->dataPtr->observed = false;
+  this->dataPtr->active = true;
+
+  this->dataPtr->world->Step(_steps);
+
+  this->dataPtr->active = false;
+  this->dataPtr->actionValues = nullptr;
+  this->dataPtr->observationValues = nullptr;
+
+  return this->dataPtr->observed;
+}
+
+//////////////////////////////////////////////////
+bool Lockstep::Step(const std::vector<double> &_actions,
+    const unsigned int _steps, std::vector<double> &_observations)
+{
+  if (_actions.size() != this->dataPtr->actionSize)
+  {
+    gzerr << "Expected " << this->dataPtr->actionSize << " actions, got "
+      << _actions.size() << std::endl;
+    return false;
+  }
+
+  _observations.resize(this->dataPtr->observationSize);
+  return this->Step(_actions.data(), _steps, _observations.data());
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_LOCKSTEP_HH_
+#define GAZEBO_PHYSICS_LOCKSTEP_HH_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class LockstepPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class Lockstep Lockstep.hh physics/physics.hh
+    /// \brief Drive a paused world in lockstep from an external controller,
+    /// such as a learning loop, without messages on the hot path.
+    ///
+    /// The controller declares once which joint and link values it writes
+    /// (actions) and reads (observations). Each call to Step then takes a
+    /// flat buffer of actions, applies them at every iteration before the
+    /// physics update, steps the world and fills a flat buffer of
+    /// observations captured at the end of the last iteration.
+    ///
+    /// Example:
+    ///
+    ///   physics::Lockstep lockstep(world);
+    ///   lockstep.AddJointAction(joint, physics::Lockstep::JOINT_FORCE);
+    ///   lockstep.AddLinkObservation(link, physics::Lockstep::LINK_POSE);
+    ///   std::vector<double> actions(lockstep.ActionSize());
+    ///   std::vector<double> observations;
+    ///   lockstep.Step(actions, 10, observations);
+    class GZ_PHYSICS_VISIBLE Lockstep
+    {
+      /// \brief Values written by an action.
+      public: enum ActionType
+      {
+        /// \brief Joint effort of an axis, one value.
+        JOINT_FORCE,
+
+        /// \brief Joint velocity of an axis, one value.
+        JOINT_VELOCITY,
+
+        /// \brief Force on the link center of mass in the world frame,
+        /// three values.
+        LINK_FORCE,
+
+        /// \brief Torque on the link in the world frame, three values.
+        LINK_TORQUE
+      };
+
+      /// \brief Values read by an observation.
+      public: enum ObservationType
+      {
+        /// \brief Joint position of an axis, one value.
+        JOINT_POSITION,
+
+        /// \brief Joint velocity of an axis, one value.
+        JOINT_VELOCITY_OBSERVATION,
+
+        /// \brief Joint effort of an axis, one value.
+        JOINT_FORCE_OBSERVATION,
+
+        /// \brief World pose of the link: position and orientation
+        /// quaternion (w, x, y, z), seven values.
+        LINK_POSE,
+
+        /// \brief World linear and angular velocity of the link, six
+        /// values.
+        LINK_VELOCITY
+      };
+
+      /// \brief Fill observation values, see AddObservation.
+      /// \param[out] _values Values to fill.
+      public: typedef std::function<void (double *_values)> ObservationFunc;
+
+      /// \brief Constructor.
+      /// \param[in] _world World to step.
+      public: explicit Lockstep(WorldPtr _world);
+
+      /// \brief Destructor.
+      public: ~Lockstep();
+
+      /// \brief Add a joint action.
+      /// \param[in] _joint Joint to drive.
+      /// \param[in] _type JOINT_FORCE or JOINT_VELOCITY.
+      /// \param[in] _axis Joint axis.
+      /// \return Offset of the action in the action buffer, or -1 if the
+      /// joint, the type or the axis is invalid.
+      public: int AddJointAction(JointPtr _joint, const ActionType _type,
+                  const unsigned int _axis = 0);
+
+      /// \brief Add a link action.
+      /// \param[in] _link Link to drive.
+      /// \param[in] _type LINK_FORCE or LINK_TORQUE.
+      /// \return Offset of the action in the action buffer, or -1 if the
+      /// link or the type is invalid.
+      public: int AddLinkAction(LinkPtr _link, const ActionType _type);
+
+      /// \brief Add a joint observation.
+      /// \param[in] _joint Joint to read.
+      /// \param[in] _type JOINT_POSITION, JOINT_VELOCITY_OBSERVATION or
+      /// JOINT_FORCE_OBSERVATION.
+      /// \param[in] _axis Joint axis.
+      /// \return Offset of the observation in the observation buffer, or
+      /// -1 if the joint, the type or the axis is invalid.
+      public: int AddJointObservation(JointPtr _joint,
+                  const ObservationType _type, const unsigned int _axis = 0);
+
+      /// \brief Add a link observation.
+      /// \param[in] _link Link to read.
+      /// \param[in] _type LINK_POSE or LINK_VELOCITY.
+      /// \return Offset of the observation in the observation buffer, or
+      /// -1 if the link or the type is invalid.
+      public: int AddLinkObservation(LinkPtr _link,
+                  const ObservationType _type);
+
+      /// \brief Add an observation read by a function, for example of
+      /// sensor data. The function is called in the world thread at the
+      /// end of the last iteration of a step.
+      /// \param[in] _size Number of values.
+      /// \param[in] _func Function filling the values.
+      /// \return Offset of the observation in the observation buffer, or
+      /// -1 if the function is empty.
+      public: int AddObservation(const unsigned int _size,
+                  const ObservationFunc &_func);
+
+      /// \brief Get the number of action values.
+      /// \return Size of the action buffer.
+      public: unsigned int ActionSize() const;
+
+      /// \brief Get the number of observation values.
+      /// \return Size of the observation buffer.
+      public: unsigned int ObservationSize() const;
+
+      /// \brief Apply actions, step the world and read observations. The
+      /// world is paused if it is not.
+      /// \param[in] _actions ActionSize() action values, applied at each
+      /// iteration.
+      /// \param[in] _steps Number of iterations.
+      /// \param[out] _observations ObservationSize() values, filled at the
+      /// end of the last iteration.
+      /// \return False if _steps is zero or the world stopped.
+      public: bool Step(const double *_actions, const unsigned int _steps,
+                  double *_observations);
+
+      /// \brief Apply actions, step the world and read observations.
+      /// \param[in] _actions Action values.
+      /// \param[in] _steps Number of iterations.
+      /// \param[out] _observations Observation values, resized to
+      /// ObservationSize().
+      /// \return False if the number of actions is not ActionSize(), if
+      /// _steps is zero or if the world stopped.
+      /// \sa Step(const double *, const unsigned int, double *)
+      public: bool Step(const std::vector<double> &_actions,
+                  const unsigned int _steps,
+                  std::vector<double> &_observations);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LockstepPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/Lockstep.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class LockstepTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(LockstepTest, Step)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  SpawnSphere("sphere", ignition::math::Vector3d(0, 0, 2),
+      ignition::math::Vector3d::Zero);
+  physics::ModelPtr model = world->ModelByName("sphere");
+  ASSERT_TRUE(model != nullptr);
+  physics::LinkPtr link = model->GetLink();
+  ASSERT_TRUE(link != nullptr);
+
+  physics::Lockstep lockstep(world);
+
+  // Invalid channels are rejected
+  EXPECT_EQ(-1, lockstep.AddLinkAction(nullptr,
+        physics::Lockstep::LINK_FORCE));
+  EXPECT_EQ(-1, lockstep.AddLinkAction(link,
+        physics::Lockstep::JOINT_FORCE));
+  EXPECT_EQ(-1, lockstep.AddLinkObservation(link,
+        physics::Lockstep::JOINT_POSITION));
+  EXPECT_EQ(-1, lockstep.AddObservation(1, nullptr));
+
+  EXPECT_EQ(0, lockstep.AddLinkAction(link, physics::Lockstep::LINK_FORCE));
+  EXPECT_EQ(0, lockstep.AddLinkObservation(link,
+        physics::Lockstep::LINK_POSE));
+  EXPECT_EQ(7, lockstep.AddLinkObservation(link,
+        physics::Lockstep::LINK_VELOCITY));
+  EXPECT_EQ(13, lockstep.AddObservation(1,
+        [&world](double *_values) {*_values = world->Iterations();}));
+  EXPECT_EQ(3u, lockstep.ActionSize());
+  EXPECT_EQ(14u, lockstep.ObservationSize());
+
+  // A force against gravity holds the sphere in place
+  const ignition::math::Vector3d weight = world->Gravity() *
+    link->GetInertial()->Mass();
+  std::vector<double> actions = {-weight.X(), -weight.Y(), -weight.Z()};
+  std::vector<double> observations;
+  const uint32_t iterations = world->Iterations();
+  EXPECT_TRUE(lockstep.Step(actions, 10, observations));
+  ASSERT_EQ(14u, observations.size());
+  EXPECT_EQ(iterations + 10, world->Iterations());
+  EXPECT_DOUBLE_EQ(iterations + 10, observations[13]);
+  EXPECT_NEAR(2.0, observations[2], 1e-6);
+  EXPECT_NEAR(0.0, observations[9], 1e-6);
+
+  // Without the force, it falls
+  actions = {0, 0, 0};
+  EXPECT_TRUE(lockstep.Step(actions, 100, observations));
+  EXPECT_LT(observations[2], 2.0);
+  EXPECT_LT(observations[9], -0.5);
+
+  // Observations come from the last iteration
+  const ignition::math::Pose3d pose = link->WorldPose();
+  EXPECT_DOUBLE_EQ(pose.Pos().Z(), observations[2]);
+  EXPECT_DOUBLE_EQ(pose.Rot().W(), observations[3]);
+  EXPECT_DOUBLE_EQ(link->WorldLinearVel().Z(), observations[9]);
+
+  // Wrong action sizes and empty steps are rejected
+  EXPECT_FALSE(lockstep.Step(std::vector<double>(2), 1, observations));
+  EXPECT_FALSE(lockstep.Step(actions, 0, observations));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
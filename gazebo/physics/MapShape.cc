@@ -129,6 +129,7 @@ void MapShape::SetScale(const ignition::math::Vector3d &_scale)
   this->scale = _scale;
 
   this->sdf->GetElement("scale")->Set(_scale);
+  this->InvalidateBoundingBox();
 
   /// TODO MapShape::SetScale not yet implemented.
 }
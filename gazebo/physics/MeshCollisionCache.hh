@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_MESHCOLLISIONCACHE_HH_
+#define GAZEBO_PHYSICS_MESHCOLLISIONCACHE_HH_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class MeshCollisionCache MeshCollisionCache.hh physics/physics.hh
+    /// \brief Shares engine specific triangle mesh data between identical
+    /// mesh collisions.
+    ///
+    /// Entries are keyed by MeshShape::CollisionGeometryKey. The cache only
+    /// holds weak references: the data is destroyed when the last collision
+    /// that uses it releases its shared pointer, for example when its model
+    /// is removed.
+    /// \tparam T Type of the engine data.
+    template<typename T>
+    class MeshCollisionCache
+    {
+      /// \brief Get the data for a key, creating it if no collision uses it.
+      /// \param[in] _key Collision geometry key. An empty key never matches,
+      /// so the data is always created.
+      /// \param[in] _create Function that creates the data.
+      /// \return Shared pointer to the data, or nullptr if _create failed.
+      public: std::shared_ptr<T> Get(const std::string &_key,
+                  const std::function<std::shared_ptr<T>()> &_create)
+      {
+        if (_key.empty())
+          return _create();
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        // Drop the entries of data that has been released.
+        for (auto iter = this->entries.begin(); iter != this->entries.end();)
+        {
+          if (iter->second.expired())
+            iter = this->entries.erase(iter);
+          else
+            ++iter;
+        }
+
+        auto iter = this->entries.find(_key);
+        if (iter != this->entries.end())
+        {
+          std::shared_ptr<T> data = iter->second.lock();
+          if (data)
+            return data;
+        }
+
+        std::shared_ptr<T> data = _create();
+        if (data)
+          this->entries[_key] = data;
+        return data;
+      }
+
+      /// \brief Get the number of data entries in use.
+      /// \return Number of entries that are used by at least one collision.
+      public: size_t Size() const
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        size_t count = 0;
+        for (const auto &entry : this->entries)
+        {
+          if (!entry.second.expired())
+            ++count;
+        }
+        return count;
+      }
+
+      /// \brief Cached data, indexed by key.
+      private: std::map<std::string, std::weak_ptr<T>> entries;
+
+      /// \brief Protects the entries.
+      private: mutable std::mutex mutex;
+    };
+    /// \}
+  }
+}
+#endif
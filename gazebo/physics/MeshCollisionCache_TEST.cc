@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "gazebo/physics/MeshCollisionCache.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshCollisionCache_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(MeshCollisionCache_TEST, Share)
+{
+  physics::MeshCollisionCache<int> cache;
+  int created = 0;
+  auto create = [&created]()
+  {
+    return std::make_shared<int>(++created);
+  };
+
+  // Identical keys share the data.
+  std::shared_ptr<int> a = cache.Get("box.dae\n1 1 1", create);
+  std::shared_ptr<int> b = cache.Get("box.dae\n1 1 1", create);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(created, 1);
+  EXPECT_EQ(cache.Size(), 1u);
+
+  // Another scale is another entry.
+  std::shared_ptr<int> c = cache.Get("box.dae\n2 2 2", create);
+  EXPECT_NE(a, c);
+  EXPECT_EQ(created, 2);
+  EXPECT_EQ(cache.Size(), 2u);
+
+  // Empty keys are never shared.
+  std::shared_ptr<int> d = cache.Get("", create);
+  std::shared_ptr<int> e = cache.Get("", create);
+  EXPECT_NE(d, e);
+  EXPECT_EQ(created, 4);
+  EXPECT_EQ(cache.Size(), 2u);
+
+  // The data is released with its last user.
+  std::weak_ptr<int> weak = a;
+  a.reset();
+  EXPECT_FALSE(weak.expired());
+  b.reset();
+  EXPECT_TRUE(weak.expired());
+  EXPECT_EQ(cache.Size(), 1u);
+
+  // A released key is created again.
+  a = cache.Get("box.dae\n1 1 1", create);
+  EXPECT_EQ(*a, 5);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,9 +14,15 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
 #include <boost/thread/recursive_mutex.hpp>
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/ConvexDecomposition.hh"
+#include "gazebo/common/MeshCache.hh"
 #include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/Exception.hh"
@@ -24,11 +30,15 @@
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/MeshCollisionCache.hh"
 #include "gazebo/physics/MeshShape.hh"
 
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Convex decompositions shared between identical mesh shapes.
+static MeshCollisionCache<common::Mesh> g_convexHullCache;
+
 //////////////////////////////////////////////////
 MeshShape::MeshShape(CollisionPtr _parent)
   : Shape(_parent)
@@ -43,6 +53,25 @@ MeshShape::~MeshShape()
 {
 }
 
+//////////////////////////////////////////////////
+void MeshShape::Load(sdf::ElementPtr _sdf)
+{
+  Shape::Load(_sdf);
+
+  if (this->sdf->HasElement("convex_decomposition"))
+  {
+    this->convexDecomposition = true;
+
+    sdf::ElementPtr decompositionElem =
+        this->sdf->GetElement("convex_decomposition");
+    if (decompositionElem->HasElement("max_convex_hulls"))
+    {
+      this->SetMaxConvexHulls(
+          decompositionElem->Get<unsigned int>("max_convex_hulls"));
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 void MeshShape::Init()
 {
@@ -98,12 +127,104 @@ void MeshShape::Init()
       }
     }
   }
+
+  this->convexHulls.reset();
+  if (!this->convexDecomposition || !this->mesh)
+    return;
+
+  common::ConvexDecomposition decomposition;
+  decomposition.SetMaxHulls(this->maxConvexHulls);
+
+  // The hulls depend on the geometry but not on the scale, which the
+  // physics engines apply.
+  std::string variant = decomposition.ParameterKey();
+  if (this->submesh)
+  {
+    sdf::ElementPtr submeshElem = this->sdf->GetElement("submesh");
+    variant += "\n" + this->submesh->GetName() + "\n" +
+        std::to_string(submeshElem->HasElement("center") &&
+        submeshElem->Get<bool>("center"));
+  }
+
+  const std::string meshName = this->mesh->GetName();
+  this->convexHulls = g_convexHullCache.Get(meshName + "\n" + variant,
+      [&]()
+      {
+        std::shared_ptr<common::MeshCache> cache =
+            common::MeshManager::Instance()->Cache();
+        std::string filename = common::find_file(meshName);
+
+        std::shared_ptr<common::Mesh> hulls;
+        if (cache)
+          hulls.reset(cache->Load(filename, variant));
+
+        if (!hulls)
+        {
+          if (this->submesh)
+            hulls.reset(decomposition.Decompose(this->submesh));
+          else
+            hulls.reset(decomposition.Decompose(this->mesh));
+
+          if (hulls && cache)
+            cache->Save(hulls.get(), filename, variant);
+        }
+        return hulls;
+      });
+
+  if (!this->convexHulls)
+  {
+    gzwarn << "Unable to decompose mesh [" << meshName << "] into convex "
+           << "hulls, colliding with its triangles instead.\n";
+  }
+}
+
+//////////////////////////////////////////////////
+void MeshShape::SetConvexDecompositionEnabled(const bool _enabled)
+{
+  this->convexDecomposition = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool MeshShape::ConvexDecompositionEnabled() const
+{
+  return this->convexDecomposition;
+}
+
+//////////////////////////////////////////////////
+void MeshShape::SetMaxConvexHulls(const unsigned int _count)
+{
+  this->maxConvexHulls = std::max(1u, _count);
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshShape::MaxConvexHulls() const
+{
+  return this->maxConvexHulls;
+}
+
+//////////////////////////////////////////////////
+const common::Mesh *MeshShape::ConvexHulls() const
+{
+  return this->convexHulls.get();
+}
+
+//////////////////////////////////////////////////
+const common::Mesh *MeshShape::MeshData() const
+{
+  return this->mesh;
+}
+
+//////////////////////////////////////////////////
+const common::SubMesh *MeshShape::SubMeshData() const
+{
+  return this->submesh;
 }
 
 //////////////////////////////////////////////////
 void MeshShape::SetScale(const ignition::math::Vector3d &_scale)
 {
   this->sdf->GetElement("scale")->Set(_scale);
+  this->InvalidateBoundingBox();
 }
 
 //////////////////////////////////////////////////
@@ -112,6 +233,33 @@ ignition::math::Vector3d MeshShape::Size() const
   return this->sdf->Get<ignition::math::Vector3d>("scale");
 }
 
+//////////////////////////////////////////////////
+std::string MeshShape::CollisionGeometryKey() const
+{
+  if (!this->mesh)
+    return std::string();
+
+  std::ostringstream stream;
+  stream << std::setprecision(17) << this->mesh->GetName();
+
+  if (this->submesh)
+  {
+    sdf::ElementPtr submeshElem = this->sdf->GetElement("submesh");
+    stream << '\n' << this->submesh->GetName() << '\n'
+           << (submeshElem->HasElement("center") &&
+               submeshElem->Get<bool>("center"));
+  }
+
+  ignition::math::Vector3d scale =
+      this->sdf->Get<ignition::math::Vector3d>("scale");
+  stream << '\n' << scale.X() << ' ' << scale.Y() << ' ' << scale.Z();
+
+  // Shapes that collide with convex hulls build different engine data.
+  if (this->convexHulls)
+    stream << "\nconvex " << this->maxConvexHulls;
+  return stream.str();
+}
+
 //////////////////////////////////////////////////
 std::string MeshShape::GetMeshURI() const
 {
@@ -131,6 +279,7 @@ void MeshShape::SetMesh(const std::string &_uri,
   }
 
   this->Init();
+  this->InvalidateBoundingBox();
 }
 
 //////////////////////////////////////////////////
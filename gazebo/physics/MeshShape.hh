@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_MESHSHAPE_HH_
 #define GAZEBO_PHYSICS_MESHSHAPE_HH_
 
+#include <memory>
 #include <string>
 
 #include "gazebo/common/CommonTypes.hh"
@@ -45,6 +46,12 @@ namespace gazebo
       /// \brief Update the tri mesh.
       public: virtual void Update() {}
 
+      /// \brief Load the mesh shape. A <convex_decomposition> element in
+      /// the mesh enables SetConvexDecompositionEnabled, and its optional
+      /// <max_convex_hulls> child sets SetMaxConvexHulls.
+      /// \param[in] _sdf SDF mesh element.
+      public: virtual void Load(sdf::ElementPtr _sdf);
+
       /// \copydoc Shape::Init()
       public: virtual void Init();
 
@@ -78,11 +85,65 @@ namespace gazebo
       /// \param[in] _msg Message that contains triangle mesh info.
       public: virtual void ProcessMsg(const msgs::Geometry &_msg);
 
+      /// \brief Get a key that identifies the collision geometry built by
+      /// Init. Shapes with the same key use the same mesh, submesh, center
+      /// flag and scale, so the physics engines can share their triangle
+      /// mesh data.
+      /// \return The key, or an empty string if no mesh is loaded.
+      /// \sa MeshCollisionCache
+      public: std::string CollisionGeometryKey() const;
+
+      /// \brief Enable collision against a convex decomposition of the
+      /// mesh instead of its triangles. Convex collisions are much cheaper
+      /// than triangle mesh collisions, at the cost of filling the concave
+      /// parts that are smaller than the decomposition can resolve. The
+      /// decomposition is computed by Init, and is stored in the binary
+      /// mesh cache when one is set, see MeshManager::SetCachePath.
+      /// \param[in] _enabled True to collide with convex hulls.
+      public: void SetConvexDecompositionEnabled(const bool _enabled);
+
+      /// \brief Get whether collisions use a convex decomposition.
+      /// \return True if convex decomposition is enabled.
+      public: bool ConvexDecompositionEnabled() const;
+
+      /// \brief Set the largest number of convex hulls of the
+      /// decomposition. The default is 16.
+      /// \param[in] _count Number of hulls, at least 1.
+      public: void SetMaxConvexHulls(const unsigned int _count);
+
+      /// \brief Get the largest number of convex hulls of the
+      /// decomposition.
+      /// \return Number of hulls.
+      public: unsigned int MaxConvexHulls() const;
+
+      /// \brief Get the convex decomposition built by Init, unscaled.
+      /// \return A mesh with one submesh per convex hull, or nullptr if
+      /// convex decomposition is disabled or failed.
+      public: const common::Mesh *ConvexHulls() const;
+
+      /// \brief Get the mesh data loaded by Init.
+      /// \return The mesh, or nullptr if no mesh is loaded.
+      public: const common::Mesh *MeshData() const;
+
+      /// \brief Get the submesh used instead of the whole mesh.
+      /// \return The submesh, or nullptr if the whole mesh is used.
+      public: const common::SubMesh *SubMeshData() const;
+
       /// \brief Pointer to the mesh data.
       protected: const common::Mesh *mesh;
 
       /// \brief The submesh to use from within the parent mesh.
       protected: common::SubMesh *submesh;
+
+      /// \brief Convex hulls of the mesh or submesh, shared between shapes
+      /// that decompose the same geometry.
+      protected: std::shared_ptr<common::Mesh> convexHulls;
+
+      /// \brief True to collide with the convex hulls.
+      protected: bool convexDecomposition = false;
+
+      /// \brief Largest number of convex hulls.
+      protected: unsigned int maxConvexHulls = 16u;
     };
     /// \}
   }
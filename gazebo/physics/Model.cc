@@ -25,11 +25,14 @@
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/SemanticVersion.hh>
 #include <ignition/msgs/plugin_v.pb.h>
+#include <algorithm>
+#include <list>
 #include <sstream>
 
 #include "gazebo/common/KeyFrame.hh"
 #include "gazebo/common/Animation.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/PluginStats.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
@@ -56,9 +59,12 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Last state version given to a model.
+static std::atomic<uint64_t> g_stateVersion(0);
+
 //////////////////////////////////////////////////
 Model::Model(BasePtr _parent)
-  : Entity(_parent)
+  : Entity(_parent), stateVersion(++g_stateVersion)
 {
   this->AddType(MODEL);
 }
@@ -151,6 +157,15 @@ void Model::Load(sdf::ElementPtr _sdf)
   if (this->sdf->HasElement("allow_auto_disable"))
     this->SetAutoDisable(this->sdf->Get<bool>("allow_auto_disable"));
 
+  // The world prefetches the resources of the models it loads itself.
+  // Models inserted later do it here, nested models are covered by their
+  // parent.
+  if (this->world->IsLoaded() &&
+      !boost::dynamic_pointer_cast<Model>(this->GetParent()))
+  {
+    this->world->PrefetchResources(this->sdf);
+  }
+
   this->LoadLinks();
 
   this->LoadModels();
@@ -227,6 +242,7 @@ void Model::LoadLinks()
       link->Load(linkElem);
       linkElem = linkElem->GetNextElement("link");
       this->links.push_back(link);
+      this->InvalidateBoundingBox();
     }
   }
 }
@@ -350,7 +366,7 @@ void Model::Init()
 void Model::Update()
 {
   IGN_PROFILE("Model::Update");
-  if (this->IsStatic())
+  if (this->IsStatic() || this->sleeping)
     return;
 
   IGN_PROFILE_BEGIN("lockMutex");
@@ -516,9 +532,18 @@ void Model::Fini()
   }
   this->canonicalLink.reset();
   this->links.clear();
+  {
+    std::lock_guard<std::mutex> lock(this->linkUpdateMutex);
+    this->updatingLinks.clear();
+    this->queuedLinks.clear();
+    this->hasLinkUpdates = false;
+  }
+  this->linksToUpdate.clear();
 
   this->plugins.clear();
 
+  this->SetStepDivisor(1);
+
   Entity::Fini();
 }
 
@@ -527,6 +552,8 @@ void Model::UpdateParameters(sdf::ElementPtr _sdf)
 {
   Entity::UpdateParameters(_sdf);
 
+  this->pluginMsgsDirty = true;
+
   if (_sdf->HasElement("link"))
   {
     sdf::ElementPtr linkElem = _sdf->GetElement("link");
@@ -708,6 +735,8 @@ const sdf::ElementPtr Model::UnscaledSDF()
 //////////////////////////////////////////////////
 void Model::Reset()
 {
+  this->Wake();
+
   Entity::Reset();
 
   this->ResetPhysicsStates();
@@ -723,6 +752,7 @@ void Model::Reset()
   for (std::vector<ModelPluginPtr>::iterator iter = this->plugins.begin();
        iter != this->plugins.end(); ++iter)
   {
+    common::PluginScope scope((*iter)->GetFilename(), (*iter)->GetHandle());
     (*iter)->Reset();
   }
 }
@@ -848,22 +878,21 @@ ignition::math::Vector3d Model::WorldAngularAccel() const
 //////////////////////////////////////////////////
 ignition::math::AxisAlignedBox Model::BoundingBox() const
 {
-  ignition::math::AxisAlignedBox box;
+  return this->BoundingBoxCache([this]()
+  {
+    ignition::math::AxisAlignedBox box;
 
-  box.Min().Set(FLT_MAX, FLT_MAX, FLT_MAX);
-  box.Max().Set(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    box.Min().Set(FLT_MAX, FLT_MAX, FLT_MAX);
+    box.Max().Set(-FLT_MAX, -FLT_MAX, -FLT_MAX);
 
-  for (const auto &iter : this->links)
-  {
-    if (iter)
+    for (const auto &iter : this->links)
     {
-      ignition::math::AxisAlignedBox linkBox;
-      linkBox = iter->BoundingBox();
-      box += linkBox;
+      if (iter)
+        box += iter->BoundingBox();
     }
-  }
 
-  return box;
+    return box;
+  });
 }
 
 //////////////////////////////////////////////////
@@ -896,6 +925,26 @@ JointPtr Model::GetJoint(const std::string &_name)
   return result;
 }
 
+//////////////////////////////////////////////////
+JointBatchPtr Model::CreateJointBatch(
+    const std::vector<std::string> &_jointNames)
+{
+  Joint_V batchJoints;
+  for (auto const &name : _jointNames)
+  {
+    JointPtr joint = this->GetJoint(name);
+    if (!joint)
+    {
+      gzerr << "Model [" << this->GetName() << "] has no joint named ["
+            << name << "], unable to create the joint batch.\n";
+      return JointBatchPtr();
+    }
+    batchJoints.push_back(joint);
+  }
+
+  return this->world->Physics()->CreateJointBatch(batchJoints);
+}
+
 //////////////////////////////////////////////////
 const Model_V &Model::NestedModels() const
 {
@@ -1151,6 +1200,9 @@ void Model::LoadPlugin(sdf::ElementPtr _sdf)
 
     ModelPtr myself = boost::static_pointer_cast<Model>(shared_from_this());
 
+    // The callbacks connected by the plugin are charged to it
+    common::PluginScope scope(filename, pluginName);
+
     try
     {
       plugin->Load(myself, _sdf);
@@ -1260,17 +1312,22 @@ void Model::FillMsg(msgs::Model &_msg)
     model->FillMsg(*_msg.add_model());
   }
 
-  if (this->sdf->HasElement("plugin"))
+  if (this->pluginMsgsDirty)
   {
-    sdf::ElementPtr pluginElem = this->sdf->GetElement("plugin");
-    while (pluginElem)
+    this->pluginMsgs.clear();
+    if (this->sdf->HasElement("plugin"))
     {
-      auto pluginMsg = _msg.add_plugin();
-      pluginMsg->CopyFrom(msgs::PluginFromSDF(pluginElem));
-
-      pluginElem = pluginElem->GetNextElement("plugin");
+      sdf::ElementPtr pluginElem = this->sdf->GetElement("plugin");
+      while (pluginElem)
+      {
+        this->pluginMsgs.push_back(msgs::PluginFromSDF(pluginElem));
+        pluginElem = pluginElem->GetNextElement("plugin");
+      }
     }
+    this->pluginMsgsDirty = false;
   }
+  for (const auto &pluginMsg : this->pluginMsgs)
+    _msg.add_plugin()->CopyFrom(pluginMsg);
 }
 
 //////////////////////////////////////////////////
@@ -1416,6 +1473,8 @@ void Model::SetScale(const ignition::math::Vector3d &_scale,
   if (this->scale != _scale)
   {
     this->scale = _scale;
+    this->UpdateStateVersion();
+    this->InvalidateBoundingBox();
 
     Base_V::iterator iter;
     for (iter = this->children.begin(); iter != this->children.end(); ++iter)
@@ -1503,6 +1562,194 @@ bool Model::GetAutoDisable() const
   return this->sdf->Get<bool>("allow_auto_disable");
 }
 
+/////////////////////////////////////////////////
+bool Model::CanSleep() const
+{
+  if (this->IsStatic() || this->HasType(Base::ACTOR) ||
+      !this->jointAnimations.empty() || !this->GetAutoDisable())
+  {
+    return false;
+  }
+
+  // Only top level models sleep, nested models sleep with their parent.
+  if (this->GetParent() && this->GetParent()->HasType(Base::MODEL))
+    return false;
+
+  std::list<const Model *> models = {this};
+  while (!models.empty())
+  {
+    const Model *model = models.front();
+    models.pop_front();
+    for (auto const &link : model->links)
+    {
+      for (auto const &joints : {link->GetParentJoints(),
+                                 link->GetChildJoints()})
+      {
+        for (auto const &joint : joints)
+        {
+          for (auto const &other : {joint->GetParent(), joint->GetChild()})
+          {
+            if (other && other->GetParentModel().get() != this)
+              return false;
+          }
+        }
+      }
+    }
+    for (auto const &nested : model->models)
+      models.push_back(nested.get());
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void Model::SetLinksSleeping(const bool _sleeping)
+{
+  for (auto const &link : this->links)
+  {
+    if (_sleeping)
+    {
+      // Some engines enable a link when its velocity is set, so clear the
+      // velocities before disabling it.
+      link->SetLinearVel(ignition::math::Vector3d::Zero);
+      link->SetAngularVel(ignition::math::Vector3d::Zero);
+      link->SetEnabled(false);
+      link->SetSleeping(true);
+    }
+    else
+    {
+      link->SetSleeping(false);
+      link->SetEnabled(true);
+    }
+  }
+
+  for (auto const &model : this->models)
+    model->SetLinksSleeping(_sleeping);
+}
+
+/////////////////////////////////////////////////
+void Model::Sleep()
+{
+  if (this->sleeping)
+    return;
+
+  this->SetLinksSleeping(true);
+  this->sleepPose = this->WorldPose();
+  this->sleeping = true;
+}
+
+/////////////////////////////////////////////////
+void Model::Wake()
+{
+  this->restTime = 0;
+  if (!this->sleeping)
+    return;
+
+  this->sleeping = false;
+  this->SetLinksSleeping(false);
+}
+
+/////////////////////////////////////////////////
+bool Model::IsSleeping() const
+{
+  return this->sleeping;
+}
+
+/////////////////////////////////////////////////
+void Model::SetStepDivisor(const unsigned int _divisor)
+{
+  const unsigned int divisor = std::max(_divisor, 1u);
+  if (divisor == this->stepDivisor)
+    return;
+
+  PhysicsEnginePtr physics = this->world ? this->world->Physics() : nullptr;
+  if (physics)
+  {
+    if (this->stepDivisor == 1)
+      physics->AddSubsteppedModels(1);
+    else if (divisor == 1)
+      physics->AddSubsteppedModels(-1);
+  }
+  this->stepDivisor = divisor;
+}
+
+/////////////////////////////////////////////////
+unsigned int Model::StepDivisor() const
+{
+  return this->stepDivisor;
+}
+
+/////////////////////////////////////////////////
+bool Model::UpdateSleep(const double _dt, const double _linear,
+    const double _angular, const double _sleepTime)
+{
+  if (this->sleeping)
+    return false;
+
+  std::list<const Model *> models = {this};
+  while (!models.empty())
+  {
+    const Model *model = models.front();
+    models.pop_front();
+    for (auto const &link : model->links)
+    {
+      if (link->WorldLinearVel().Length() > _linear ||
+          link->WorldAngularVel().Length() > _angular)
+      {
+        this->restTime = 0;
+        return false;
+      }
+    }
+    for (auto const &nested : model->models)
+      models.push_back(nested.get());
+  }
+
+  this->restTime += _dt;
+  if (this->restTime < _sleepTime)
+    return false;
+
+  this->Sleep();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool Model::SleepDisturbed(const double _linear, const double _angular)
+{
+  if (!this->sleeping)
+    return false;
+
+  if (this->WorldPose() != this->sleepPose)
+    return true;
+
+  std::list<const Model *> models = {this};
+  while (!models.empty())
+  {
+    const Model *model = models.front();
+    models.pop_front();
+    for (auto const &link : model->links)
+    {
+      if (link->WorldForce() != ignition::math::Vector3d::Zero ||
+          link->WorldTorque() != ignition::math::Vector3d::Zero ||
+          link->WorldLinearVel().Length() > _linear ||
+          link->WorldAngularVel().Length() > _angular)
+      {
+        return true;
+      }
+    }
+    for (auto const &nested : model->models)
+      models.push_back(nested.get());
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+unsigned int Model::LinkCountRecursive() const
+{
+  unsigned int count = this->links.size();
+  for (auto const &model : this->models)
+    count += model->LinkCountRecursive();
+  return count;
+}
+
 /////////////////////////////////////////////////
 void Model::SetSelfCollide(bool _self_collide)
 {
@@ -1523,7 +1770,10 @@ void Model::RemoveLink(const std::string &_name)
   {
     if ((*iter)->GetName() == _name || (*iter)->GetScopedName() == _name)
     {
+      this->SetLinkUpdating(iter->get(), false);
       this->links.erase(iter);
+      this->UpdateStateVersion();
+      this->InvalidateBoundingBox();
       break;
     }
   }
@@ -1764,10 +2014,36 @@ LinkPtr Model::CreateLink(const std::string &_name)
 
   link->SetName(_name);
   this->links.push_back(link);
+  this->UpdateStateVersion();
+  this->InvalidateBoundingBox();
 
   return link;
 }
 
+//////////////////////////////////////////////////
+uint64_t Model::StateVersion() const
+{
+  return this->stateVersion;
+}
+
+//////////////////////////////////////////////////
+void Model::UpdateStateVersion()
+{
+  const uint64_t version = ++g_stateVersion;
+
+  Model *model = this;
+  while (model)
+  {
+    model->stateVersion = version;
+
+    BasePtr parentBase = model->GetParent();
+    if (parentBase && parentBase->HasType(MODEL))
+      model = static_cast<Model *>(parentBase.get());
+    else
+      model = nullptr;
+  }
+}
+
 //////////////////////////////////////////////////
 void Model::PluginInfo(const common::URI &_pluginUri,
     ignition::msgs::Plugin_V &_plugins, bool &_success)
@@ -1869,3 +2145,74 @@ std::optional<sdf::SemanticPose> Model::SDFSemanticPose() const
   }
   return std::nullopt;
 }
+
+/////////////////////////////////////////////////
+void Model::UpdateLinks(const common::UpdateInfo &_info)
+{
+  if (this->hasLinkUpdates)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->linkUpdateMutex);
+      this->linksToUpdate = this->updatingLinks;
+      for (auto link : this->queuedLinks)
+      {
+        if (std::find(this->updatingLinks.begin(), this->updatingLinks.end(),
+              link) == this->updatingLinks.end())
+        {
+          this->linksToUpdate.push_back(link);
+        }
+      }
+      this->queuedLinks.clear();
+      this->hasLinkUpdates = !this->updatingLinks.empty();
+    }
+
+    // Updated without the lock, so a wrench message received meanwhile
+    // queues the link again
+    for (auto link : this->linksToUpdate)
+      link->Update(_info);
+  }
+
+  for (auto &model : this->models)
+    model->UpdateLinks(_info);
+}
+
+/////////////////////////////////////////////////
+void Model::SetLinkUpdating(Link *_link, const bool _updating)
+{
+  std::lock_guard<std::mutex> lock(this->linkUpdateMutex);
+  auto iter = std::find(this->updatingLinks.begin(),
+      this->updatingLinks.end(), _link);
+  if (_updating)
+  {
+    if (iter == this->updatingLinks.end())
+      this->updatingLinks.push_back(_link);
+  }
+  else
+  {
+    if (iter != this->updatingLinks.end())
+      this->updatingLinks.erase(iter);
+    this->queuedLinks.erase(std::remove(this->queuedLinks.begin(),
+          this->queuedLinks.end(), _link), this->queuedLinks.end());
+  }
+  this->hasLinkUpdates =
+    !this->updatingLinks.empty() || !this->queuedLinks.empty();
+}
+
+/////////////////////////////////////////////////
+void Model::QueueLinkUpdate(Link *_link)
+{
+  std::lock_guard<std::mutex> lock(this->linkUpdateMutex);
+  if (std::find(this->queuedLinks.begin(), this->queuedLinks.end(), _link) ==
+      this->queuedLinks.end())
+  {
+    this->queuedLinks.push_back(_link);
+  }
+  this->hasLinkUpdates = true;
+}
+
+/////////////////////////////////////////////////
+size_t Model::UpdatingLinkCount() const
+{
+  std::lock_guard<std::mutex> lock(this->linkUpdateMutex);
+  return this->updatingLinks.size();
+}
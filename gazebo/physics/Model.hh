@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_MODEL_HH_
 #define GAZEBO_PHYSICS_MODEL_HH_
 
+#include <atomic>
 #include <string>
 #include <map>
 #include <mutex>
@@ -201,6 +202,16 @@ namespace gazebo
       /// \return Pointer to the joint
       public: JointPtr GetJoint(const std::string &name);
 
+      /// \brief Create a batch to read the positions and velocities and
+      /// apply the forces of a set of joints in bulk, in the order given.
+      /// The joints are looked up once, so the batch can be kept and used
+      /// every step.
+      /// \param[in] _jointNames Names of the joints, scoped or not.
+      /// \return The batch, or nullptr if a joint does not exist.
+      /// \sa JointBatch
+      public: JointBatchPtr CreateJointBatch(
+                  const std::vector<std::string> &_jointNames);
+
       /// \cond
       /// This is an internal function
       /// \brief Get a link by id.
@@ -344,6 +355,104 @@ namespace gazebo
       /// \return True if auto disable is allowed for this model.
       public: bool GetAutoDisable() const;
 
+      /// \brief Get whether the model can be put to sleep by the world: it
+      /// must be a dynamic top level model that allows auto disable, that
+      /// plays no joint animation and whose joints only connect its own
+      /// links, or a link to the world.
+      /// \return True if the model can sleep.
+      public: bool CanSleep() const;
+
+      /// \brief Put the model to sleep: the velocities of all its links,
+      /// also those of nested models, are cleared and the links are
+      /// disabled in the physics engine. A sleeping model skips Update, and
+      /// the poses of its links are neither propagated nor published.
+      public: void Sleep();
+
+      /// \brief Wake the model up if it is asleep.
+      public: void Wake();
+
+      /// \brief Get whether the model is asleep.
+      /// \return True if the model is asleep.
+      public: bool IsSleeping() const;
+
+      /// \brief Track how long the model has been at rest, and put it to
+      /// sleep once it has rested long enough. Called by the world after
+      /// each physics step.
+      /// \param[in] _dt Time step.
+      /// \param[in] _linear Largest linear velocity of a link at rest.
+      /// \param[in] _angular Largest angular velocity of a link at rest.
+      /// \param[in] _sleepTime Rest time before sleeping.
+      /// \return True if the model fell asleep.
+      public: bool UpdateSleep(const double _dt, const double _linear,
+                  const double _angular, const double _sleepTime);
+
+      /// \brief Check whether a sleeping model was disturbed: moved, given a
+      /// velocity above the rest thresholds, or pushed by a force or torque
+      /// on one of its links.
+      /// \param[in] _linear Largest linear velocity of a link at rest.
+      /// \param[in] _angular Largest angular velocity of a link at rest.
+      /// \return True if the model should wake up.
+      public: bool SleepDisturbed(const double _linear,
+                  const double _angular);
+
+      /// \brief Set the step divisor of the model. The physics engine
+      /// integrates the links of a model with a divisor above one with that
+      /// many substeps per world step, together with the bodies they are
+      /// coupled to by joints or contacts, while the rest of the world takes
+      /// a single step. Nested models use the largest divisor of their own
+      /// and of the models they are nested in. Supported by ODE, for the
+      /// islands of the model, and by DART, for the skeleton of a top level
+      /// model.
+      /// \param[in] _divisor Number of substeps, 1 for none.
+      public: void SetStepDivisor(const unsigned int _divisor);
+
+      /// \brief Get the step divisor of the model.
+      /// \return Number of substeps per world step.
+      /// \sa SetStepDivisor
+      public: unsigned int StepDivisor() const;
+
+      /// \brief Get the number of links of the model, including those of
+      /// nested models.
+      /// \return Link count.
+      public: unsigned int LinkCountRecursive() const;
+
+      /// \brief Get the state version of the model. The version changes
+      /// whenever the model, one of its links or one of its nested models is
+      /// moved by a pose setter, scaled, or gains or loses a link. Motion
+      /// integrated by the physics engine does not change it. Versions are
+      /// unique across all models.
+      /// \return State version.
+      public: uint64_t StateVersion() const;
+
+      /// \brief Give the model, and the models it is nested in, a new state
+      /// version.
+      /// \sa StateVersion
+      public: void UpdateStateVersion();
+
+      /// \brief Update the links of the model and of its nested models that
+      /// have audio, wind or battery work, or pending wrench messages. The
+      /// other links are skipped. The world calls it at the start of each
+      /// update, before the world update begin event.
+      /// \param[in] _info Update information.
+      public: void UpdateLinks(const common::UpdateInfo &_info);
+
+      /// \brief Add or remove a link from the links updated at every step.
+      /// Removing a link also drops its queued update.
+      /// \param[in] _link Link of this model.
+      /// \param[in] _updating True to update the link at every step.
+      /// \sa Link::HasUpdateWork
+      public: void SetLinkUpdating(Link *_link, const bool _updating);
+
+      /// \brief Update a link once, at the next call to UpdateLinks. Safe to
+      /// call from any thread.
+      /// \param[in] _link Link of this model.
+      public: void QueueLinkUpdate(Link *_link);
+
+      /// \brief Get the number of links of this model, nested models
+      /// excluded, updated at every step.
+      /// \return Number of links.
+      public: size_t UpdatingLinkCount() const;
+
       /// \brief Load all plugins
       ///
       /// Load all plugins specified in the SDF for the model.
@@ -567,6 +676,48 @@ namespace gazebo
 
       /// \brief SDF Model DOM object
       private: const sdf::Model *modelSDFDom = nullptr;
+
+      /// \brief Mark the links of the model and its nested models as asleep
+      /// or awake, and enable or disable them in the physics engine.
+      /// \param[in] _sleeping True to put the links to sleep.
+      private: void SetLinksSleeping(const bool _sleeping);
+
+      /// \brief True while the model is asleep.
+      private: bool sleeping = false;
+
+      /// \brief Simulation time the model has been at rest.
+      private: double restTime = 0;
+
+      /// \brief World pose of the model when it fell asleep.
+      private: ignition::math::Pose3d sleepPose;
+
+      /// \brief Number of physics substeps per world step.
+      private: unsigned int stepDivisor = 1;
+
+      /// \brief State version of the model.
+      private: std::atomic<uint64_t> stateVersion;
+
+      /// \brief Links updated at every step.
+      private: std::vector<Link *> updatingLinks;
+
+      /// \brief Links updated once at the next step.
+      private: std::vector<Link *> queuedLinks;
+
+      /// \brief Links being updated by UpdateLinks, kept to reuse its
+      /// memory.
+      private: std::vector<Link *> linksToUpdate;
+
+      /// \brief Protects updatingLinks and queuedLinks.
+      private: mutable std::mutex linkUpdateMutex;
+
+      /// \brief True if updatingLinks or queuedLinks is not empty.
+      private: std::atomic<bool> hasLinkUpdates{false};
+
+      /// \brief Plugin msgs generated from SDF, reused by FillMsg.
+      private: std::vector<msgs::Plugin> pluginMsgs;
+
+      /// \brief True if pluginMsgs must be generated again.
+      private: bool pluginMsgsDirty = true;
     };
     /// \}
   }
@@ -0,0 +1,445 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/ModelBoxIndex.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Largest number of cells a box may cover, larger boxes are
+/// returned by every query.
+static const int64_t kMaxBoxCells = 4096;
+
+/// \brief Grid cell coordinates are packed in 21 bits each.
+static const int64_t kCellBias = 1 << 20;
+
+/// \brief An indexed model.
+struct IndexEntry
+{
+  /// \brief The model.
+  ModelPtr model;
+
+  /// \brief Bounding box when last refreshed.
+  ignition::math::AxisAlignedBox box;
+
+  /// \brief First covered cell, valid if not oversized.
+  int64_t min[3];
+
+  /// \brief Last covered cell, valid if not oversized.
+  int64_t max[3];
+
+  /// \brief True if the box is not stored in the grid.
+  bool oversized = false;
+};
+
+/// \brief Private data for the ModelBoxIndex class
+class gazebo::physics::ModelBoxIndexPrivate
+{
+  /// \brief Compute the cells covered by a box.
+  /// \param[in] _box The box.
+  /// \param[out] _min First cell.
+  /// \param[out] _max Last cell.
+  /// \return False if the box is not finite or covers too many cells.
+  public: bool Cells(const ignition::math::AxisAlignedBox &_box,
+              int64_t _min[3], int64_t _max[3]) const;
+
+  /// \brief Get the key of a cell.
+  /// \param[in] _x X coordinate of the cell.
+  /// \param[in] _y Y coordinate of the cell.
+  /// \param[in] _z Z coordinate of the cell.
+  /// \return Key into cells.
+  public: static uint64_t Key(const int64_t _x, const int64_t _y,
+              const int64_t _z);
+
+  /// \brief Store a model and its nested models, replacing the entries
+  /// they already have.
+  /// \param[in] _model Model to store.
+  public: void Insert(const ModelPtr &_model);
+
+  /// \brief Remove the entry of a model from the grid.
+  /// \param[in] _entry Entry to remove.
+  public: void Unlink(const IndexEntry &_entry);
+
+  /// \brief Rebuild the index from scratch.
+  /// \param[in] _models Top level models of the world.
+  public: void Rebuild(const Model_V &_models);
+
+  /// \brief Entries by model id.
+  public: std::unordered_map<uint32_t, IndexEntry> entries;
+
+  /// \brief Ids of the models touching each cell.
+  public: std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+
+  /// \brief Ids of the models not stored in the grid.
+  public: std::vector<uint32_t> oversized;
+
+  /// \brief Last change of each cell that ever held a model, see
+  /// ModelBoxIndex::LastChange.
+  public: std::unordered_map<uint64_t, uint64_t> cellChanges;
+
+  /// \brief Last change of the oversized models.
+  public: uint64_t oversizedChange = 0;
+
+  /// \brief Last rebuild, which may have emptied any cell.
+  public: uint64_t rebuildChange = 0;
+
+  /// \brief Last change anywhere in the index.
+  public: uint64_t lastChange = 0;
+
+  /// \brief Counter of the updates that changed the index.
+  public: uint64_t change = 0;
+
+  /// \brief Edge length of a cell.
+  public: double cellSize = 10.0;
+
+  /// \brief True to rebuild on the next update.
+  public: bool rebuild = true;
+
+  /// \brief Entity change count of the world at the last update.
+  public: uint64_t entityChanges = 0;
+
+  /// \brief Number of models refreshed by the last update.
+  public: unsigned int refreshCount = 0;
+
+  /// \brief Protects the entries, cells and settings.
+  public: mutable std::mutex mutex;
+
+  /// \brief Top level models that moved since the last update.
+  public: std::vector<ModelPtr> dirty;
+
+  /// \brief Protects dirty, which is filled from several threads.
+  public: std::mutex dirtyMutex;
+};
+
+//////////////////////////////////////////////////
+bool ModelBoxIndexPrivate::Cells(const ignition::math::AxisAlignedBox &_box,
+    int64_t _min[3], int64_t _max[3]) const
+{
+  const ignition::math::Vector3d &boxMin = _box.Min();
+  const ignition::math::Vector3d &boxMax = _box.Max();
+  int64_t count = 1;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (!std::isfinite(boxMin[i]) || !std::isfinite(boxMax[i]) ||
+        boxMin[i] > boxMax[i])
+    {
+      return false;
+    }
+
+    const double low = std::floor(boxMin[i] / this->cellSize);
+    const double high = std::floor(boxMax[i] / this->cellSize);
+    if (low < -kCellBias || high >= kCellBias)
+      return false;
+
+    _min[i] = static_cast<int64_t>(low);
+    _max[i] = static_cast<int64_t>(high);
+    count *= _max[i] - _min[i] + 1;
+    if (count > kMaxBoxCells)
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+uint64_t ModelBoxIndexPrivate::Key(const int64_t _x, const int64_t _y,
+    const int64_t _z)
+{
+  return (static_cast<uint64_t>(_x + kCellBias) << 42) |
+    (static_cast<uint64_t>(_y + kCellBias) << 21) |
+    static_cast<uint64_t>(_z + kCellBias);
+}
+
+//////////////////////////////////////////////////
+void ModelBoxIndexPrivate::Unlink(const IndexEntry &_entry)
+{
+  const uint32_t id = _entry.model->GetId();
+  if (_entry.oversized)
+  {
+    this->oversized.erase(std::remove(this->oversized.begin(),
+          this->oversized.end(), id), this->oversized.end());
+    this->oversizedChange = this->change;
+    return;
+  }
+
+  for (int64_t x = _entry.min[0]; x <= _entry.max[0]; ++x)
+  {
+    for (int64_t y = _entry.min[1]; y <= _entry.max[1]; ++y)
+    {
+      for (int64_t z = _entry.min[2]; z <= _entry.max[2]; ++z)
+      {
+        const uint64_t key = Key(x, y, z);
+        this->cellChanges[key] = this->change;
+        auto cell = this->cells.find(key);
+        if (cell == this->cells.end())
+          continue;
+        cell->second.erase(std::remove(cell->second.begin(),
+              cell->second.end(), id), cell->second.end());
+        if (cell->second.empty())
+          this->cells.erase(cell);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void ModelBoxIndexPrivate::Insert(const ModelPtr &_model)
+{
+  const uint32_t id = _model->GetId();
+  const ignition::math::AxisAlignedBox box = _model->BoundingBox();
+  auto existing = this->entries.find(id);
+  if (existing != this->entries.end())
+  {
+    // Resting models keep reporting tiny moves, do not let them invalidate
+    // the results cached for their region.
+    if (existing->second.box == box)
+    {
+      for (auto const &nested : _model->NestedModels())
+        this->Insert(nested);
+      return;
+    }
+    this->Unlink(existing->second);
+  }
+
+  IndexEntry &entry = this->entries[id];
+  entry.model = _model;
+  entry.box = box;
+  entry.oversized = !this->Cells(entry.box, entry.min, entry.max);
+  ++this->refreshCount;
+
+  this->lastChange = this->change;
+
+  if (entry.oversized)
+  {
+    this->oversized.push_back(id);
+    this->oversizedChange = this->change;
+  }
+  else
+  {
+    for (int64_t x = entry.min[0]; x <= entry.max[0]; ++x)
+    {
+      for (int64_t y = entry.min[1]; y <= entry.max[1]; ++y)
+      {
+        for (int64_t z = entry.min[2]; z <= entry.max[2]; ++z)
+        {
+          const uint64_t key = Key(x, y, z);
+          this->cells[key].push_back(id);
+          this->cellChanges[key] = this->change;
+        }
+      }
+    }
+  }
+
+  // Nested models move with their parent
+  for (auto const &nested : _model->NestedModels())
+    this->Insert(nested);
+}
+
+//////////////////////////////////////////////////
+void ModelBoxIndexPrivate::Rebuild(const Model_V &_models)
+{
+  this->entries.clear();
+  this->cells.clear();
+  this->oversized.clear();
+  this->cellChanges.clear();
+  this->rebuildChange = this->change;
+  this->oversizedChange = this->change;
+  this->lastChange = this->change;
+  for (auto const &model : _models)
+    this->Insert(model);
+}
+
+//////////////////////////////////////////////////
+ModelBoxIndex::ModelBoxIndex()
+  : dataPtr(new ModelBoxIndexPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+ModelBoxIndex::~ModelBoxIndex()
+{
+}
+
+//////////////////////////////////////////////////
+void ModelBoxIndex::SetCellSize(const double _size)
+{
+  if (_size <= 0)
+  {
+    gzerr << "Cell size must be positive, got [" << _size << "]\n";
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->cellSize = _size;
+  this->dataPtr->rebuild = true;
+}
+
+//////////////////////////////////////////////////
+double ModelBoxIndex::CellSize() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->cellSize;
+}
+
+//////////////////////////////////////////////////
+Model_V ModelBoxIndex::Query(const ignition::math::AxisAlignedBox &_box) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  std::vector<uint32_t> ids(this->dataPtr->oversized);
+  int64_t min[3];
+  int64_t max[3];
+  if (this->dataPtr->Cells(_box, min, max))
+  {
+    for (int64_t x = min[0]; x <= max[0]; ++x)
+    {
+      for (int64_t y = min[1]; y <= max[1]; ++y)
+      {
+        for (int64_t z = min[2]; z <= max[2]; ++z)
+        {
+          auto cell = this->dataPtr->cells.find(
+              ModelBoxIndexPrivate::Key(x, y, z));
+          if (cell != this->dataPtr->cells.end())
+            ids.insert(ids.end(), cell->second.begin(), cell->second.end());
+        }
+      }
+    }
+  }
+  else
+  {
+    // Scanning the entries is cheaper than visiting that many cells
+    ids.clear();
+    for (auto const &entry : this->dataPtr->entries)
+      ids.push_back(entry.first);
+  }
+
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+  Model_V models;
+  for (const uint32_t id : ids)
+  {
+    const IndexEntry &entry = this->dataPtr->entries.at(id);
+    if (entry.oversized || entry.box.Intersects(_box))
+      models.push_back(entry.model);
+  }
+  return models;
+}
+
+//////////////////////////////////////////////////
+uint64_t ModelBoxIndex::LastChange(
+    const ignition::math::AxisAlignedBox &_box) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  int64_t min[3];
+  int64_t max[3];
+  if (!this->dataPtr->Cells(_box, min, max))
+    return this->dataPtr->lastChange;
+
+  uint64_t last = std::max(this->dataPtr->rebuildChange,
+      this->dataPtr->oversizedChange);
+  for (int64_t x = min[0]; x <= max[0]; ++x)
+  {
+    for (int64_t y = min[1]; y <= max[1]; ++y)
+    {
+      for (int64_t z = min[2]; z <= max[2]; ++z)
+      {
+        auto cell = this->dataPtr->cellChanges.find(
+            ModelBoxIndexPrivate::Key(x, y, z));
+        if (cell != this->dataPtr->cellChanges.end())
+          last = std::max(last, cell->second);
+      }
+    }
+  }
+  return last;
+}
+
+//////////////////////////////////////////////////
+unsigned int ModelBoxIndex::ModelCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->entries.size();
+}
+
+//////////////////////////////////////////////////
+unsigned int ModelBoxIndex::RefreshCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->refreshCount;
+}
+
+//////////////////////////////////////////////////
+void ModelBoxIndex::MarkDirty(const ModelPtr &_model)
+{
+  if (!_model)
+    return;
+
+  // Refresh from the top level model, whose box contains the nested ones
+  BasePtr root = _model;
+  while (root->GetParent() && root->GetParent()->HasType(Base::MODEL))
+    root = root->GetParent();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->dirtyMutex);
+  this->dataPtr->dirty.push_back(boost::static_pointer_cast<Model>(root));
+}
+
+//////////////////////////////////////////////////
+void ModelBoxIndex::Update(const World &_world, const uint64_t _entityChanges)
+{
+  std::vector<ModelPtr> dirty;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->dirtyMutex);
+    dirty.swap(this->dataPtr->dirty);
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->refreshCount = 0;
+
+  const bool rebuild = this->dataPtr->rebuild ||
+    this->dataPtr->entityChanges != _entityChanges;
+  if (!rebuild && dirty.empty())
+    return;
+  ++this->dataPtr->change;
+
+  if (rebuild)
+  {
+    this->dataPtr->Rebuild(_world.Models());
+    this->dataPtr->entityChanges = _entityChanges;
+    this->dataPtr->rebuild = false;
+    return;
+  }
+
+  std::unordered_set<uint32_t> refreshed;
+  for (auto const &model : dirty)
+  {
+    // Models removed since they were marked are not indexed anymore
+    if (refreshed.insert(model->GetId()).second &&
+        this->dataPtr->entries.count(model->GetId()))
+    {
+      this->dataPtr->Insert(model);
+    }
+  }
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_MODELBOXINDEX_HH_
+#define GAZEBO_PHYSICS_MODELBOXINDEX_HH_
+
+#include <cstdint>
+#include <memory>
+
+#include <ignition/math/AxisAlignedBox.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class ModelBoxIndexPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class ModelBoxIndex ModelBoxIndex.hh physics/physics.hh
+    /// \brief Spatial index of the bounding boxes of the models of a world,
+    /// nested models included, updated at the end of every World::Update.
+    ///
+    /// Boxes are stored in a uniform grid of cubic cells. Only the models
+    /// that moved during the step, see World::PublishModelPose, are
+    /// refreshed, so the cost of an update grows with the number of moving
+    /// models rather than with the size of the world. The whole index is
+    /// rebuilt when models are inserted or removed. Boxes too large for the
+    /// grid, such as ground planes, are returned by every query.
+    /// \sa World::SetBoxIndexEnabled
+    class GZ_PHYSICS_VISIBLE ModelBoxIndex
+    {
+      /// \brief Constructor.
+      public: ModelBoxIndex();
+
+      /// \brief Destructor.
+      public: ~ModelBoxIndex();
+
+      /// \brief Set the edge length of the grid cells. The index is
+      /// rebuilt on the next update.
+      /// \param[in] _size Edge length in meters, must be positive.
+      public: void SetCellSize(const double _size);
+
+      /// \brief Get the edge length of the grid cells.
+      /// \return Edge length in meters. The default is 10.
+      public: double CellSize() const;
+
+      /// \brief Get the models whose bounding box, as last indexed,
+      /// intersects a box. May be called from any thread.
+      /// \param[in] _box Box in the world frame.
+      /// \return Candidate models, sorted by id. A model may be returned
+      /// even if only its grid cells touch _box, callers still test the
+      /// exact shape they are interested in.
+      public: Model_V Query(const ignition::math::AxisAlignedBox &_box) const;
+
+      /// \brief Get the last update that changed the boxes in a region:
+      /// a model moved within it, entered it or left it. Results that
+      /// depend only on the models in a region, such as an occlusion test,
+      /// stay valid while this value is unchanged. May be called from any
+      /// thread.
+      /// \param[in] _box Region in the world frame.
+      /// \return Update counter of the last change, zero if none.
+      public: uint64_t LastChange(
+                  const ignition::math::AxisAlignedBox &_box) const;
+
+      /// \brief Get the number of indexed models.
+      /// \return Number of models, nested models included.
+      public: unsigned int ModelCount() const;
+
+      /// \brief Get the number of models refreshed by the last update.
+      /// \return Number of refreshed boxes.
+      public: unsigned int RefreshCount() const;
+
+      /// \brief Mark a model as moved, its box and those of its nested and
+      /// parent models are refreshed on the next update. Thread safe.
+      /// \param[in] _model Model that moved.
+      public: void MarkDirty(const ModelPtr &_model);
+
+      /// \brief Refresh the boxes of the models that moved, or rebuild the
+      /// index if the models of the world changed. Only World calls this.
+      /// \param[in] _world World to index.
+      /// \param[in] _entityChanges Count of model insertions and removals
+      /// of the world.
+      private: void Update(const World &_world,
+                   const uint64_t _entityChanges);
+
+      /// \brief Only World may update the index.
+      friend class World;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ModelBoxIndexPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/ModelBoxIndex.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ModelBoxIndexTest : public ServerFixture
+{
+};
+
+/// \brief Is a model in a list?
+/// \param[in] _models The list.
+/// \param[in] _name Name of the model.
+/// \return True if found.
+static bool Contains(const physics::Model_V &_models, const std::string &_name)
+{
+  return std::find_if(_models.begin(), _models.end(),
+      [&_name](const physics::ModelPtr &_model)
+      {
+        return _model->GetName() == _name;
+      }) != _models.end();
+}
+
+/////////////////////////////////////////////////
+TEST_F(ModelBoxIndexTest, Query)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Disabled by default
+  EXPECT_FALSE(world->BoxIndexEnabled());
+  EXPECT_TRUE(world->BoxIndex() == nullptr);
+
+  SpawnBox("near", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5), ignition::math::Vector3d::Zero,
+      true);
+  SpawnBox("far", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(100, 0, 0.5), ignition::math::Vector3d::Zero,
+      true);
+
+  world->SetBoxIndexEnabled(true);
+  physics::ModelBoxIndexPtr index = world->BoxIndex();
+  ASSERT_TRUE(index != nullptr);
+  EXPECT_DOUBLE_EQ(10.0, index->CellSize());
+
+  // Built on the next step
+  EXPECT_EQ(0u, index->ModelCount());
+  world->Step(1);
+  EXPECT_GE(index->ModelCount(), 3u);
+
+  physics::Model_V models = index->Query(ignition::math::AxisAlignedBox(
+        ignition::math::Vector3d(-2, -2, -2),
+        ignition::math::Vector3d(2, 2, 2)));
+  EXPECT_TRUE(Contains(models, "near"));
+  EXPECT_FALSE(Contains(models, "far"));
+
+  models = index->Query(ignition::math::AxisAlignedBox(
+        ignition::math::Vector3d(98, -2, -2),
+        ignition::math::Vector3d(102, 2, 2)));
+  EXPECT_FALSE(Contains(models, "near"));
+  EXPECT_TRUE(Contains(models, "far"));
+
+  // Models sorted by id
+  for (size_t i = 1; i < models.size(); ++i)
+    EXPECT_LT(models[i-1]->GetId(), models[i]->GetId());
+
+  // Nothing moved, nothing is refreshed
+  world->Step(1);
+  EXPECT_EQ(0u, index->RefreshCount());
+
+  // Only the moved model is refreshed
+  physics::ModelPtr nearModel = world->ModelByName("near");
+  ASSERT_TRUE(nearModel != nullptr);
+  nearModel->SetWorldPose(ignition::math::Pose3d(100, 5, 0.5, 0, 0, 0));
+  world->Step(1);
+  EXPECT_EQ(1u, index->RefreshCount());
+
+  models = index->Query(ignition::math::AxisAlignedBox(
+        ignition::math::Vector3d(-2, -2, -2),
+        ignition::math::Vector3d(2, 2, 2)));
+  EXPECT_FALSE(Contains(models, "near"));
+
+  models = index->Query(ignition::math::AxisAlignedBox(
+        ignition::math::Vector3d(98, -2, -2),
+        ignition::math::Vector3d(102, 6, 2)));
+  EXPECT_TRUE(Contains(models, "near"));
+  EXPECT_TRUE(Contains(models, "far"));
+
+  // A query larger than the grid scans every model
+  models = index->Query(ignition::math::AxisAlignedBox(
+        ignition::math::Vector3d(-1e6, -1e6, -1e6),
+        ignition::math::Vector3d(1e6, 1e6, 1e6)));
+  EXPECT_TRUE(Contains(models, "near"));
+  EXPECT_TRUE(Contains(models, "far"));
+
+  // Removing a model rebuilds the index
+  const unsigned int count = index->ModelCount();
+  world->RemoveModel("far");
+  world->Step(1);
+  EXPECT_EQ(count - 1, index->ModelCount());
+
+  world->SetBoxIndexEnabled(false);
+  EXPECT_TRUE(world->BoxIndex() == nullptr);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
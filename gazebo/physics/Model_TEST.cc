@@ -20,6 +20,9 @@
 #include "gazebo/test/ServerFixture.hh"
 #include "test/util.hh"
 #include "gazebo/common/URI.hh"
+#include "gazebo/physics/BoxShape.hh"
+#include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/Link.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/Model.hh"
 
@@ -242,6 +245,105 @@ TEST_F(ModelTest, BoundingBox)
       model->BoundingBox());
 }
 
+//////////////////////////////////////////////////
+TEST_F(ModelTest, BoundingBoxCache)
+{
+  this->Load("worlds/another_box.world", true);
+
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  auto model = world->ModelByName("box");
+  ASSERT_TRUE(model != nullptr);
+  auto link = model->GetLink("link");
+  ASSERT_TRUE(link != nullptr);
+  auto collision = link->GetCollision("collision");
+  ASSERT_TRUE(collision != nullptr);
+
+  const ignition::math::AxisAlignedBox box(-10.5, -20.5, -30.5, -9.5, -19.5,
+      -29.5);
+  EXPECT_EQ(box, model->BoundingBox());
+  EXPECT_EQ(box, model->BoundingBox());
+  EXPECT_EQ(box, link->BoundingBox());
+  EXPECT_EQ(box, collision->CachedBoundingBox());
+
+  // Moving the model refreshes the boxes
+  model->SetWorldPose(ignition::math::Pose3d(1, 2, 3, 0, 0, 0));
+  const ignition::math::AxisAlignedBox moved(0.5, 1.5, 2.5, 1.5, 2.5, 3.5);
+  EXPECT_EQ(moved, model->BoundingBox());
+  EXPECT_EQ(moved, link->BoundingBox());
+  EXPECT_EQ(moved, collision->CachedBoundingBox());
+
+  // So does resizing the shape
+  auto shape =
+    boost::dynamic_pointer_cast<physics::BoxShape>(collision->GetShape());
+  ASSERT_TRUE(shape != nullptr);
+  shape->SetSize(ignition::math::Vector3d(2, 2, 2));
+  EXPECT_EQ(ignition::math::AxisAlignedBox(0, 1, 2, 2, 3, 4),
+      model->BoundingBox());
+
+  // Motion integrated by the physics engine refreshes the boxes too
+  this->SpawnBox("falling", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 5), ignition::math::Vector3d::Zero);
+  auto falling = world->ModelByName("falling");
+  ASSERT_TRUE(falling != nullptr);
+  EXPECT_NEAR(5.0, falling->BoundingBox().Center().Z(), 1e-6);
+
+  world->Step(200);
+  const double z = falling->GetLink()->WorldPose().Pos().Z();
+  EXPECT_LT(z, 4.0);
+  EXPECT_NEAR(z, falling->BoundingBox().Center().Z(), 1e-6);
+}
+
+//////////////////////////////////////////////////
+TEST_F(ModelTest, UpdatingLinks)
+{
+  this->Load("worlds/empty.world", true);
+
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5), ignition::math::Vector3d::Zero);
+  auto model = world->ModelByName("box");
+  ASSERT_TRUE(model != nullptr);
+  auto link = model->GetLink();
+  ASSERT_TRUE(link != nullptr);
+
+  // A plain link has nothing to update
+  EXPECT_FALSE(link->HasUpdateWork());
+  EXPECT_EQ(0u, model->UpdatingLinkCount());
+
+  // Wind adds the link to the updated links, and removes it when disabled
+  link->SetWindMode(true);
+  EXPECT_TRUE(link->HasUpdateWork());
+  EXPECT_EQ(1u, model->UpdatingLinkCount());
+  world->Step(1);
+
+  link->SetWindMode(false);
+  EXPECT_FALSE(link->HasUpdateWork());
+  EXPECT_EQ(0u, model->UpdatingLinkCount());
+
+  // A wrench message is applied once, without updating the link afterwards
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  auto pub = node->Advertise<msgs::Wrench>("~/box/link/wrench");
+  msgs::Wrench msg;
+  msgs::Set(msg.mutable_force(), ignition::math::Vector3d(0, 0, 1000));
+  msgs::Set(msg.mutable_torque(), ignition::math::Vector3d::Zero);
+  pub->WaitForConnection();
+  pub->Publish(msg);
+
+  // 1000 N during one step of 1 ms throw the 1 kg box upwards
+  for (int i = 0; i < 100 && link->WorldLinearVel().Z() < 0.5; ++i)
+  {
+    common::Time::MSleep(10);
+    world->Step(1);
+  }
+  EXPECT_GT(link->WorldLinearVel().Z(), 0.5);
+  EXPECT_EQ(0u, model->UpdatingLinkCount());
+}
+
 //////////////////////////////////////////////////
 TEST_F(ModelTest, StripScopedName)
 {
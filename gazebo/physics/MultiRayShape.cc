@@ -27,6 +27,7 @@ MultiRayShape::MultiRayShape(CollisionPtr _parent)
 {
   this->AddType(MULTIRAY_SHAPE);
   this->SetName("multiray");
+  this->newLaserScans.SetName("newLaserScans");
 }
 
 //////////////////////////////////////////////////
@@ -15,11 +15,19 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
 #include <boost/lexical_cast.hpp>
 
 #include <sdf/sdf.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/common/Assert.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
@@ -27,16 +35,66 @@
 #include "gazebo/transport/TransportIface.hh"
 #include "gazebo/transport/Node.hh"
 
+#include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/ContactManager.hh"
+#include "gazebo/physics/JointBatch.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PresetManager.hh"
+#include "gazebo/physics/RayShape.hh"
 
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Get the value of a parameter that is not part of the SDFormat
+/// spec. Such a value coming from a world file is encoded as a string.
+/// \param[in] _value Value of type T, or a string to convert to T.
+/// \return The value.
+/// \throws std::bad_any_cast, boost::bad_any_cast or
+/// boost::bad_lexical_cast if _value is neither.
+template<typename T>
+static T CastParam(const boost::any &_value)
+{
+  try
+  {
+    return PhysicsEngine::any_cast<T>(_value);
+  }
+  catch(std::bad_any_cast &)
+  {
+    return boost::lexical_cast<T>(
+        PhysicsEngine::any_cast<std::string>(_value));
+  }
+  catch(boost::bad_any_cast &)
+  {
+    return boost::lexical_cast<T>(
+        PhysicsEngine::any_cast<std::string>(_value));
+  }
+}
+
+/// \brief Add the collisions of a model and its nested models whose
+/// bounding box overlaps a box.
+/// \param[in] _model Model to search.
+/// \param[in] _bounds Box in world frame.
+/// \param[out] _collisions Overlapping collisions.
+static void OverlappingCollisions(const ModelPtr &_model,
+    const ignition::math::AxisAlignedBox &_bounds,
+    std::vector<CollisionPtr> &_collisions)
+{
+  for (const auto &link : _model->GetLinks())
+  {
+    for (const auto &collision : link->GetCollisions())
+    {
+      if (collision->BoundingBox().Intersects(_bounds))
+        _collisions.push_back(collision);
+    }
+  }
+
+  for (const auto &model : _model->NestedModels())
+    OverlappingCollisions(model, _bounds, _collisions);
+}
+
 //////////////////////////////////////////////////
 PhysicsEngine::PhysicsEngine(WorldPtr _world)
   : world(_world)
@@ -47,6 +105,16 @@ PhysicsEngine::PhysicsEngine(WorldPtr _world)
   this->targetRealTimeFactor = 0;
   this->realTimeUpdateRate = 0;
   this->maxStepSize = 0;
+  this->parallelModelUpdateThreshold = 0;
+  this->parallelPoseUpdateThreshold = 0;
+  this->parallelActorUpdateThreshold = 0;
+  this->sleepTime = 0;
+  this->sleepLinearVelocity = 0.01;
+  this->sleepAngularVelocity = 0.01;
+  this->adaptiveMinStepSize = 0;
+  this->adaptiveMaxStepSize = 0;
+  this->adaptiveMaxContactDepth = 0.01;
+  this->substeppedModelCount = 0;
 
   this->node = transport::NodePtr(new transport::Node());
   this->node->Init(this->world->Name());
@@ -82,6 +150,8 @@ void PhysicsEngine::Load(sdf::ElementPtr _sdf)
 //////////////////////////////////////////////////
 void PhysicsEngine::Fini()
 {
+  this->queryRay.reset();
+
   // Clean up transport
   {
     this->physicsSub.reset();
@@ -136,6 +206,12 @@ CollisionPtr PhysicsEngine::CreateCollision(const std::string &_shapeType,
   return result;
 }
 
+//////////////////////////////////////////////////
+JointBatchPtr PhysicsEngine::CreateJointBatch(const Joint_V &_joints)
+{
+  return JointBatchPtr(new JointBatch(_joints));
+}
+
 //////////////////////////////////////////////////
 double PhysicsEngine::GetUpdatePeriod()
 {
@@ -211,6 +287,10 @@ void PhysicsEngine::OnRequest(ConstRequestPtr &/*_msg*/)
 void PhysicsEngine::OnPhysicsMsg(ConstPhysicsPtr &_msg)
 {
   this->world->PresetMgr()->CurrentProfile(_msg->profile_name());
+
+  // The rest of the message may change parameters directly, so the next
+  // profile switch must set all of them again.
+  this->world->PresetMgr()->InvalidateAppliedParams();
 }
 
 //////////////////////////////////////////////////
@@ -243,6 +323,90 @@ bool PhysicsEngine::SetParam(const std::string &_key,
       this->world->SetMagneticField(
           any_cast<ignition::math::Vector3d>(copy));
     }
+    else if (_key == "parallel_model_update_threshold" ||
+             _key == "parallel_pose_update_threshold" ||
+             _key == "parallel_actor_update_threshold")
+    {
+      const int threshold = CastParam<int>(_value);
+
+      if (threshold < 0)
+      {
+        gzerr << _key << " must be positive, or zero to disable it."
+              << std::endl;
+        return false;
+      }
+
+      if (_key == "parallel_model_update_threshold")
+      {
+        // Model::Update is only thread-safe with ODE
+        if (threshold > 0 && this->GetType() != "ode")
+        {
+          gzwarn << "Parallel model update is only thread-safe with the ODE "
+                 << "physics engine, models stay updated serially by ["
+                 << this->GetType() << "]" << std::endl;
+          this->parallelModelUpdateThreshold = 0;
+          return false;
+        }
+        this->parallelModelUpdateThreshold =
+            static_cast<unsigned int>(threshold);
+      }
+      else if (_key == "parallel_pose_update_threshold")
+        this->parallelPoseUpdateThreshold =
+            static_cast<unsigned int>(threshold);
+      else
+        this->parallelActorUpdateThreshold =
+            static_cast<unsigned int>(threshold);
+    }
+    else if (_key == "contact_publish_rate")
+    {
+      const double rate = CastParam<double>(_value);
+
+      if (rate < 0)
+      {
+        gzerr << _key << " must be positive, or zero to publish every step."
+              << std::endl;
+        return false;
+      }
+
+      this->contactManager->SetPublishRate(rate);
+    }
+    else if (_key == "sleep_time" || _key == "sleep_linear_velocity" ||
+             _key == "sleep_angular_velocity")
+    {
+      const double value = CastParam<double>(_value);
+
+      if (value < 0)
+      {
+        gzerr << _key << " must be positive." << std::endl;
+        return false;
+      }
+
+      if (_key == "sleep_time")
+        this->sleepTime = value;
+      else if (_key == "sleep_linear_velocity")
+        this->sleepLinearVelocity = value;
+      else
+        this->sleepAngularVelocity = value;
+    }
+    else if (_key == "adaptive_min_step_size" ||
+             _key == "adaptive_max_step_size" ||
+             _key == "adaptive_max_contact_depth")
+    {
+      const double value = CastParam<double>(_value);
+
+      if (value < 0)
+      {
+        gzerr << _key << " must be positive." << std::endl;
+        return false;
+      }
+
+      if (_key == "adaptive_min_step_size")
+        this->adaptiveMinStepSize = value;
+      else if (_key == "adaptive_max_step_size")
+        this->adaptiveMaxStepSize = value;
+      else
+        this->adaptiveMaxContactDepth = value;
+    }
     else
     {
       gzwarn << "SetParam failed for [" << _key << "] in physics engine "
@@ -295,6 +459,26 @@ bool PhysicsEngine::GetParam(const std::string &_key,
     _value = this->world->Gravity();
   else if (_key == "magnetic_field")
     _value = this->world->MagneticField();
+  else if (_key == "parallel_model_update_threshold")
+    _value = static_cast<int>(this->parallelModelUpdateThreshold);
+  else if (_key == "parallel_pose_update_threshold")
+    _value = static_cast<int>(this->parallelPoseUpdateThreshold);
+  else if (_key == "parallel_actor_update_threshold")
+    _value = static_cast<int>(this->parallelActorUpdateThreshold);
+  else if (_key == "contact_publish_rate")
+    _value = this->contactManager->PublishRate();
+  else if (_key == "sleep_time")
+    _value = this->sleepTime;
+  else if (_key == "sleep_linear_velocity")
+    _value = this->sleepLinearVelocity;
+  else if (_key == "sleep_angular_velocity")
+    _value = this->sleepAngularVelocity;
+  else if (_key == "adaptive_min_step_size")
+    _value = this->adaptiveMinStepSize;
+  else if (_key == "adaptive_max_step_size")
+    _value = this->adaptiveMaxStepSize;
+  else if (_key == "adaptive_max_contact_depth")
+    _value = this->adaptiveMaxContactDepth;
   else
   {
     gzwarn << "GetParam failed for [" << _key << "] in physics engine "
@@ -305,6 +489,125 @@ bool PhysicsEngine::GetParam(const std::string &_key,
   return true;
 }
 
+//////////////////////////////////////////////////
+void PhysicsEngine::Raycast(const std::vector<QueryRay> &_rays,
+    std::vector<QueryHit> &_hits)
+{
+  IGN_PROFILE("PhysicsEngine::Raycast");
+  _hits.assign(_rays.size(), QueryHit());
+  if (_rays.empty())
+    return;
+
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  if (!this->queryRay)
+  {
+    this->queryRay = boost::dynamic_pointer_cast<RayShape>(
+        this->CreateShape("ray", CollisionPtr()));
+    if (!this->queryRay)
+    {
+      gzerr << "Physics engine [" << this->GetType()
+            << "] does not support raycasts\n";
+      return;
+    }
+  }
+
+  for (size_t i = 0; i < _rays.size(); ++i)
+  {
+    const double length = _rays[i].start.Distance(_rays[i].end);
+    if (length <= 0.0)
+      continue;
+
+    this->queryRay->SetPoints(_rays[i].start, _rays[i].end);
+
+    double distance;
+    std::string name;
+    this->queryRay->GetIntersection(distance, name);
+    if (name.empty() || distance > length)
+      continue;
+
+    QueryHit &hit = _hits[i];
+    hit.collision = boost::dynamic_pointer_cast<Collision>(
+        this->world->EntityByName(name));
+    if (!hit.collision)
+      continue;
+    hit.distance = distance;
+    hit.point = _rays[i].start +
+      (_rays[i].end - _rays[i].start) * (distance / length);
+  }
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::Overlap(const QueryShape &_shape,
+    const ignition::math::Pose3d &_pose,
+    std::vector<CollisionPtr> &_collisions)
+{
+  IGN_PROFILE("PhysicsEngine::Overlap");
+  _collisions.clear();
+
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  const ignition::math::AxisAlignedBox bounds = _shape.Bounds(_pose);
+  for (const auto &model : this->world->Models())
+    OverlappingCollisions(model, bounds, _collisions);
+}
+
+//////////////////////////////////////////////////
+bool PhysicsEngine::Sweep(const QueryShape &_shape,
+    const ignition::math::Pose3d &_start,
+    const ignition::math::Vector3d &_end, QueryHit &_hit)
+{
+  IGN_PROFILE("PhysicsEngine::Sweep");
+  _hit = QueryHit();
+
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  const ignition::math::Vector3d path = _end - _start.Pos();
+  const double length = path.Length();
+  const double step = _shape.InnerRadius();
+
+  // Advance by at most the inner radius, so no collision thicker than the
+  // step is skipped
+  unsigned int steps = 1u;
+  if (step > 0.0)
+    steps = std::max(1u, static_cast<unsigned int>(std::ceil(length / step)));
+
+  std::vector<CollisionPtr> collisions;
+  ignition::math::Pose3d pose = _start;
+  for (unsigned int i = 0; i <= steps; ++i)
+  {
+    const double fraction = static_cast<double>(i) / steps;
+    pose.Pos() = _start.Pos() + path * fraction;
+    this->Overlap(_shape, pose, collisions);
+    if (collisions.empty())
+      continue;
+
+    // Report the collision closest to the shape
+    double best = std::numeric_limits<double>::infinity();
+    for (const auto &collision : collisions)
+    {
+      const double distance =
+        collision->WorldPose().Pos().Distance(pose.Pos());
+      if (distance < best)
+      {
+        best = distance;
+        _hit.collision = collision;
+      }
+    }
+    _hit.distance = length * fraction;
+    _hit.point = pose.Pos();
+    return true;
+  }
+
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool PhysicsEngine::FillSolverStatistics(msgs::SolverStatistics &/*_msg*/)
+{
+  return false;
+}
+
 //////////////////////////////////////////////////
 ContactManager *PhysicsEngine::GetContactManager() const
 {
@@ -317,6 +620,75 @@ sdf::ElementPtr PhysicsEngine::GetSDF() const
   return this->sdf;
 }
 
+//////////////////////////////////////////////////
+unsigned int PhysicsEngine::ParallelModelUpdateThreshold() const
+{
+  return this->parallelModelUpdateThreshold;
+}
+
+//////////////////////////////////////////////////
+unsigned int PhysicsEngine::ParallelPoseUpdateThreshold() const
+{
+  return this->parallelPoseUpdateThreshold;
+}
+
+//////////////////////////////////////////////////
+unsigned int PhysicsEngine::ParallelActorUpdateThreshold() const
+{
+  return this->parallelActorUpdateThreshold;
+}
+
+//////////////////////////////////////////////////
+double PhysicsEngine::SleepTime() const
+{
+  return this->sleepTime;
+}
+
+//////////////////////////////////////////////////
+double PhysicsEngine::SleepLinearVelocity() const
+{
+  return this->sleepLinearVelocity;
+}
+
+//////////////////////////////////////////////////
+double PhysicsEngine::SleepAngularVelocity() const
+{
+  return this->sleepAngularVelocity;
+}
+
+//////////////////////////////////////////////////
+double PhysicsEngine::AdaptiveMinStepSize() const
+{
+  return this->adaptiveMinStepSize;
+}
+
+//////////////////////////////////////////////////
+double PhysicsEngine::AdaptiveMaxStepSize() const
+{
+  return this->adaptiveMaxStepSize;
+}
+
+//////////////////////////////////////////////////
+double PhysicsEngine::AdaptiveMaxContactDepth() const
+{
+  return this->adaptiveMaxContactDepth;
+}
+
+//////////////////////////////////////////////////
+unsigned int PhysicsEngine::SubsteppedModelCount() const
+{
+  return this->substeppedModelCount;
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::AddSubsteppedModels(const int _count)
+{
+  GZ_ASSERT(_count >= 0 ||
+      this->substeppedModelCount >= static_cast<unsigned int>(-_count),
+      "More substepped models removed than added");
+  this->substeppedModelCount += _count;
+}
+
 //////////////////////////////////////////////////
 WorldPtr PhysicsEngine::World() const
 {
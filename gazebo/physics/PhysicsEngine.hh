@@ -20,12 +20,14 @@
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/any.hpp>
 #include <string>
+#include <vector>
 #include <ignition/transport/Node.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
 
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/SceneQuery.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -163,6 +165,13 @@ namespace gazebo
       public: virtual JointPtr CreateJoint(const std::string &_type,
                                            ModelPtr _parent = ModelPtr()) = 0;
 
+      /// \brief Create a batch to read and write the state of a set of
+      /// joints in bulk. The default batch calls the joints one by one,
+      /// engines may override it to read the state from their own arrays.
+      /// \param[in] _joints Joints of the batch, all initialized.
+      /// \return The new batch.
+      public: virtual JointBatchPtr CreateJointBatch(const Joint_V &_joints);
+
 
       /// \brief Set the gravity vector.
       /// \param[in] _gravity New gravity vector.
@@ -215,6 +224,43 @@ namespace gazebo
       ///          (defined but not used in ode).
       ///       -# "max_step_size" (double) - maximum physics step size when
       ///          physics update step must return.
+      ///       -# "parallel_model_update_threshold" (int) - minimum number of
+      ///          models in the world before Model::Update is dispatched
+      ///          in parallel. Zero (the default) keeps the serial update.
+      ///          Only accepted by ODE, other engines keep it at zero.
+      ///          See World for the threading contract.
+      ///       -# "parallel_pose_update_threshold" (int) - minimum number of
+      ///          links moved by the physics engine in a step before their
+      ///          poses are propagated in parallel. Zero (the default) keeps
+      ///          the serial propagation.
+      ///       -# "parallel_actor_update_threshold" (int) - minimum number of
+      ///          actors in the world before they are updated as a crowd:
+      ///          their animations are evaluated in parallel and their
+      ///          skeleton poses are published in one message on
+      ///          ~/skeleton_pose/batch. Zero (the default) keeps the
+      ///          serial update.
+      ///       -# "contact_publish_rate" (double) - maximum rate in Hz of
+      ///          simulation time at which ~/physics/contacts is published.
+      ///          Zero (the default) publishes every step.
+      ///       -# "sleep_time" (double) - simulation time in seconds that a
+      ///          model allowed to auto disable must stay at rest before it
+      ///          is put to sleep. Zero (the default) disables sleeping.
+      ///       -# "sleep_linear_velocity" (double) - largest linear velocity
+      ///          of a link at rest, 0.01 m/s by default.
+      ///       -# "sleep_angular_velocity" (double) - largest angular
+      ///          velocity of a link at rest, 0.01 rad/s by default.
+      ///       -# "adaptive_min_step_size" (double) - smallest step size in
+      ///          seconds of adaptive stepping, where the world chooses the
+      ///          step size between bounds and max_step_size follows it.
+      ///          Zero (the default) keeps fixed steps.
+      ///       -# "adaptive_max_step_size" (double) - largest step size of
+      ///          adaptive stepping, rounded down to the smallest times a
+      ///          power of two. Zero (the default) uses the
+      ///          max_step_size set before adaptive stepping started.
+      ///       -# "adaptive_max_contact_depth" (double) - contact depth in
+      ///          meters above which adaptive stepping drops to the
+      ///          smallest step size, 0.01 m by default. Zero disables the
+      ///          check.
       ///
       /// \param[in] _value The value to set to
       /// \return true if SetParam is successful, false if operation fails.
@@ -242,6 +288,48 @@ namespace gazebo
       /// \return Pointer to the world.
       public: WorldPtr World() const;
 
+      /// \brief Cast a batch of rays against the collisions of the world.
+      /// The whole batch runs under the physics update mutex, so it can be
+      /// called from another thread or from the World update begin and end
+      /// events, where the mutex is already held by the caller.
+      /// \param[in] _rays Rays to cast.
+      /// \param[out] _hits Closest hit of each ray, in the order of _rays.
+      /// A ray that hits nothing has a null collision.
+      public: virtual void Raycast(const std::vector<QueryRay> &_rays,
+                                   std::vector<QueryHit> &_hits);
+
+      /// \brief Find the collisions that overlap a shape. Engines without a
+      /// narrow phase for queries report every collision whose bounding box
+      /// overlaps the bounds of the shape. Safe to call like Raycast.
+      /// \param[in] _shape Query shape.
+      /// \param[in] _pose Pose of the shape in world frame.
+      /// \param[out] _collisions Overlapping collisions.
+      public: virtual void Overlap(const QueryShape &_shape,
+                  const ignition::math::Pose3d &_pose,
+                  std::vector<CollisionPtr> &_collisions);
+
+      /// \brief Move a shape in a straight line and find the first
+      /// collision it touches. The default implementation advances the
+      /// shape by its inner radius between Overlap tests, so engines with
+      /// an exact overlap test give exact results up to that resolution.
+      /// Safe to call like Raycast.
+      /// \param[in] _shape Query shape.
+      /// \param[in] _start Pose of the shape at the start of the sweep.
+      /// \param[in] _end Position of the shape at the end of the sweep.
+      /// \param[out] _hit First collision touched, with the distance the
+      /// shape traveled before touching it.
+      /// \return True if the shape touched a collision.
+      public: virtual bool Sweep(const QueryShape &_shape,
+                  const ignition::math::Pose3d &_start,
+                  const ignition::math::Vector3d &_end, QueryHit &_hit);
+
+      /// \brief Fill a message with the convergence of the constraint
+      /// solver over the steps since the previous call, and start over.
+      /// \param[out] _msg Message to fill.
+      /// \return False if the engine does not report solver statistics.
+      public: virtual bool FillSolverStatistics(
+                  msgs::SolverStatistics &_msg);
+
       /// \brief Get a pointer to the contact manger.
       /// \return Pointer to the contact manager.
       public: ContactManager *GetContactManager() const;
@@ -255,6 +343,70 @@ namespace gazebo
       /// \return Pointer to the physics SDF element.
       public: sdf::ElementPtr GetSDF() const;
 
+      /// \brief Get the minimum number of models required before the
+      /// world updates its models in parallel.
+      /// \return Model count threshold, zero if parallel model update is
+      /// disabled.
+      /// \sa SetParam("parallel_model_update_threshold")
+      public: unsigned int ParallelModelUpdateThreshold() const;
+
+      /// \brief Get the minimum number of moved links required before the
+      /// world propagates their poses in parallel.
+      /// \return Link count threshold, zero if parallel pose propagation is
+      /// disabled.
+      /// \sa SetParam("parallel_pose_update_threshold")
+      public: unsigned int ParallelPoseUpdateThreshold() const;
+
+      /// \brief Get the minimum number of actors from which the world
+      /// updates them as a crowd.
+      /// \return Actor count threshold, zero if the crowd update is
+      /// disabled.
+      /// \sa SetParam("parallel_actor_update_threshold")
+      public: unsigned int ParallelActorUpdateThreshold() const;
+
+      /// \brief Get the time a model must stay at rest before it sleeps.
+      /// \return Rest time in seconds, zero if sleeping is disabled.
+      /// \sa SetParam("sleep_time")
+      public: double SleepTime() const;
+
+      /// \brief Get the largest linear velocity of a link at rest.
+      /// \return Velocity in m/s.
+      /// \sa SetParam("sleep_linear_velocity")
+      public: double SleepLinearVelocity() const;
+
+      /// \brief Get the largest angular velocity of a link at rest.
+      /// \return Velocity in rad/s.
+      /// \sa SetParam("sleep_angular_velocity")
+      public: double SleepAngularVelocity() const;
+
+      /// \brief Get the smallest step size of adaptive stepping.
+      /// \return Step size in seconds, zero if adaptive stepping is
+      /// disabled.
+      /// \sa SetParam("adaptive_min_step_size")
+      public: double AdaptiveMinStepSize() const;
+
+      /// \brief Get the largest step size of adaptive stepping.
+      /// \return Step size in seconds, zero to use the max step size.
+      /// \sa SetParam("adaptive_max_step_size")
+      public: double AdaptiveMaxStepSize() const;
+
+      /// \brief Get the contact depth above which adaptive stepping drops
+      /// to the smallest step size.
+      /// \return Depth in meters, zero if unchecked.
+      /// \sa SetParam("adaptive_max_contact_depth")
+      public: double AdaptiveMaxContactDepth() const;
+
+      /// \brief Get the number of models with a step divisor above one.
+      /// Engines that substep skip the extra work while it is zero.
+      /// \return Model count.
+      /// \sa Model::SetStepDivisor
+      public: unsigned int SubsteppedModelCount() const;
+
+      /// \brief Change the number of models with a step divisor above one.
+      /// Called by Model::SetStepDivisor.
+      /// \param[in] _count Number of models to add, negative to remove.
+      public: void AddSubsteppedModels(const int _count);
+
       /// \brief Helper function for performing any_cast operations in
       /// SetParam. This is useful because the PresetManager stores the
       /// output of sdf::Element::GetAny as boost::any values in its
@@ -322,6 +474,45 @@ namespace gazebo
       /// \brief Real time update rate.
       protected: double maxStepSize;
 
+      /// \brief Minimum model count for parallel model update, zero to
+      /// disable it.
+      protected: unsigned int parallelModelUpdateThreshold;
+
+      /// \brief Minimum moved link count for parallel pose propagation, zero
+      /// to disable it.
+      protected: unsigned int parallelPoseUpdateThreshold;
+
+      /// \brief Minimum actor count for the crowd update, zero to disable
+      /// it.
+      protected: unsigned int parallelActorUpdateThreshold;
+
+      /// \brief Rest time before a model sleeps, zero to disable sleeping.
+      protected: double sleepTime;
+
+      /// \brief Largest linear velocity of a link at rest.
+      protected: double sleepLinearVelocity;
+
+      /// \brief Largest angular velocity of a link at rest.
+      protected: double sleepAngularVelocity;
+
+      /// \brief Smallest step size of adaptive stepping, zero to disable
+      /// it.
+      protected: double adaptiveMinStepSize;
+
+      /// \brief Largest step size of adaptive stepping, zero to use the
+      /// max step size.
+      protected: double adaptiveMaxStepSize;
+
+      /// \brief Contact depth above which adaptive stepping uses the
+      /// smallest step size, zero to disable the check.
+      protected: double adaptiveMaxContactDepth;
+
+      /// \brief Number of models with a step divisor above one.
+      protected: unsigned int substeppedModelCount;
+
+      /// \brief Ray used by the default Raycast, created on first use.
+      protected: RayShapePtr queryRay;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
@@ -16,6 +16,7 @@
 */
 
 #include <any>
+#include <vector>
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/test/helper_physics_generator.hh"
 #include "gazebo/msgs/msgs.hh"
@@ -117,6 +118,14 @@ void PhysicsEngineTest::PhysicsEngineParam(const std::string &_physicsEngine)
 
     // Try SetParam with wrong type
     EXPECT_NO_THROW(physics->SetParam("iters", std::string("wrong")));
+
+    // Parallel model update is only thread-safe with ODE
+    EXPECT_EQ(_physicsEngine == "ode",
+        physics->SetParam("parallel_model_update_threshold", 4));
+    EXPECT_EQ(_physicsEngine == "ode" ? 4u : 0u,
+        physics->ParallelModelUpdateThreshold());
+    EXPECT_TRUE(physics->SetParam("parallel_model_update_threshold", 0));
+    EXPECT_EQ(0u, physics->ParallelModelUpdateThreshold());
   }
 
   {
@@ -242,6 +251,60 @@ TEST_P(PhysicsEngineTest, PhysicsEngineGetParamBool)
   PhysicsEngineGetParamBool(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(PhysicsEngineTest, SceneQueries)
+{
+  Load("worlds/empty.world", true, GetParam());
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != NULL);
+
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5), ignition::math::Vector3d::Zero,
+      true);
+  physics::ModelPtr model = world->ModelByName("box");
+  ASSERT_TRUE(model != NULL);
+  physics::CollisionPtr box = model->GetLink()->GetCollisions()[0];
+  world->Step(1);
+
+  // One ray hits the side of the box, the other passes over it
+  std::vector<physics::QueryRay> rays(2);
+  rays[0].start.Set(3, 0, 0.5);
+  rays[0].end.Set(-3, 0, 0.5);
+  rays[1].start.Set(3, 0, 2);
+  rays[1].end.Set(-3, 0, 2);
+  std::vector<physics::QueryHit> hits;
+  physics->Raycast(rays, hits);
+  ASSERT_EQ(hits.size(), 2u);
+  EXPECT_EQ(hits[0].collision, box);
+  EXPECT_NEAR(hits[0].distance, 2.5, 1e-3);
+  EXPECT_NEAR(hits[0].point.X(), 0.5, 1e-3);
+  EXPECT_TRUE(hits[1].collision == NULL);
+
+  std::vector<physics::CollisionPtr> collisions;
+  physics->Overlap(physics::QueryShape::Sphere(0.2),
+      ignition::math::Pose3d(0.6, 0, 0.5, 0, 0, 0), collisions);
+  ASSERT_EQ(collisions.size(), 1u);
+  EXPECT_EQ(collisions[0], box);
+
+  physics->Overlap(physics::QueryShape::Box(ignition::math::Vector3d::One),
+      ignition::math::Pose3d(0, 0, 3, 0, 0, 0), collisions);
+  EXPECT_TRUE(collisions.empty());
+
+  // The sweep reaches the box within one step of the sphere radius
+  physics::QueryHit hit;
+  EXPECT_TRUE(physics->Sweep(physics::QueryShape::Sphere(0.2),
+      ignition::math::Pose3d(0, 3, 0.5, 0, 0, 0),
+      ignition::math::Vector3d(0, -3, 0.5), hit));
+  EXPECT_EQ(hit.collision, box);
+  EXPECT_NEAR(hit.distance, 2.3, 0.25);
+
+  EXPECT_FALSE(physics->Sweep(physics::QueryShape::Sphere(0.2),
+      ignition::math::Pose3d(0, 3, 2, 0, 0, 0),
+      ignition::math::Vector3d(0, -3, 2), hit));
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, PhysicsEngineTest,
                         PHYSICS_ENGINE_VALUES,);  // NOLINT
 
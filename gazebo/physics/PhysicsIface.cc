@@ -15,6 +15,8 @@
  *
 */
 
+#include <algorithm>
+#include <thread>
 #include <boost/thread/mutex.hpp>
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
@@ -123,6 +125,17 @@ void physics::run_worlds(unsigned int _steps)
     world->Run(_steps);
 }
 
+/////////////////////////////////////////////////
+void physics::spread_worlds(const unsigned int _firstCpu)
+{
+  const unsigned int cpuCount =
+    std::max(std::thread::hardware_concurrency(), 1u);
+
+  unsigned int cpu = _firstCpu;
+  for (auto &world : g_worlds)
+    world->SetCpuAffinity(static_cast<int>(cpu++ % cpuCount));
+}
+
 /////////////////////////////////////////////////
 void physics::pause_worlds(bool _pause)
 {
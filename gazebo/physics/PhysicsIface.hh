@@ -121,6 +121,14 @@ namespace gazebo
     GZ_PHYSICS_VISIBLE
     void run_worlds(unsigned int _iterations = 0);
 
+    /// \brief Spread the update threads of the worlds over the CPUs, one
+    /// world per CPU in turn, so many worlds in one process do not compete
+    /// for the same cores. Must be called before run_worlds.
+    /// \param[in] _firstCpu Index of the CPU of the first world.
+    /// \sa World::SetCpuAffinity
+    GZ_PHYSICS_VISIBLE
+    void spread_worlds(const unsigned int _firstCpu = 0);
+
     /// \brief stop multiple worlds stored in static variable
     /// gazebo::g_worlds
     GZ_PHYSICS_VISIBLE
@@ -72,6 +72,13 @@ namespace gazebo
     class LinkState;
     class JointState;
     class TrajectoryInfo;
+    class WorldSnapshot;
+    class ModelBoxIndex;
+    class TriggerVolumes;
+    class WorldStreaming;
+    class JointBatch;
+    class WindField;
+    class GranularMedia;
 
     /// \def BasePtr
     /// \brief Boost shared pointer to a Base object
@@ -137,6 +144,34 @@ namespace gazebo
     /// \brief Shared pointer to a UserCmdManager object
     typedef std::shared_ptr<UserCmdManager> UserCmdManagerPtr;
 
+    /// \def  WorldSnapshotPtr
+    /// \brief Shared pointer to an immutable WorldSnapshot object
+    typedef std::shared_ptr<const WorldSnapshot> WorldSnapshotPtr;
+
+    /// \def  ModelBoxIndexPtr
+    /// \brief Shared pointer to a ModelBoxIndex object
+    typedef std::shared_ptr<ModelBoxIndex> ModelBoxIndexPtr;
+
+    /// \def  TriggerVolumesPtr
+    /// \brief Shared pointer to a TriggerVolumes object
+    typedef std::shared_ptr<TriggerVolumes> TriggerVolumesPtr;
+
+    /// \def  WorldStreamingPtr
+    /// \brief Shared pointer to a WorldStreaming object
+    typedef std::shared_ptr<WorldStreaming> WorldStreamingPtr;
+
+    /// \def  JointBatchPtr
+    /// \brief Shared pointer to a JointBatch object
+    typedef std::shared_ptr<JointBatch> JointBatchPtr;
+
+    /// \def  WindFieldPtr
+    /// \brief Shared pointer to a WindField object
+    typedef std::shared_ptr<WindField> WindFieldPtr;
+
+    /// \def  GranularMediaPtr
+    /// \brief Shared pointer to a GranularMedia object
+    typedef std::shared_ptr<GranularMedia> GranularMediaPtr;
+
     /// \def ShapePtr
     /// \brief Boost shared pointer to a Shape object
     typedef boost::shared_ptr<Shape> ShapePtr;
@@ -55,6 +55,7 @@ void PlaneShape::SetNormal(const ignition::math::Vector3d &_norm)
 {
   this->sdf->GetElement("normal")->Set(_norm);
   this->CreatePlane();
+  this->InvalidateBoundingBox();
 }
 
 //////////////////////////////////////////////////
@@ -67,6 +68,7 @@ ignition::math::Vector3d PlaneShape::Normal() const
 void PlaneShape::SetSize(const ignition::math::Vector2d &_size)
 {
   this->sdf->GetElement("size")->Set(_size);
+  this->InvalidateBoundingBox();
 }
 
 //////////////////////////////////////////////////
@@ -88,6 +88,7 @@ void PolylineShape::SetHeight(const double &_height)
     polylineElem->GetElement("height")->Set(_height);
     polylineElem = polylineElem->GetNextElement("polyline");
   }
+  this->InvalidateBoundingBox();
 }
 
 //////////////////////////////////////////////////
@@ -106,6 +107,7 @@ void PolylineShape::SetScale(const ignition::math::Vector3d &_scale)
     return;
 
   this->scale = _scale;
+  this->InvalidateBoundingBox();
 }
 
 ////////////////////////////////////////////////////
@@ -125,6 +127,7 @@ void PolylineShape::SetVertices(
     }
     polylineElem = polylineElem->GetNextElement("polyline");
   }
+  this->InvalidateBoundingBox();
 }
 
 ////////////////////////////////////////////////////
@@ -132,6 +135,7 @@ void PolylineShape::SetVertices(const msgs::Geometry &_msg)
 {
   sdf::ElementPtr geomSDF = msgs::GeometryToSDF(_msg);
   this->sdf = geomSDF->GetElement("polyline");
+  this->InvalidateBoundingBox();
 }
 
 //////////////////////////////////////////////////
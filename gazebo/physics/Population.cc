@@ -17,7 +17,6 @@
 
 #include <string>
 #include <vector>
-#include <boost/lexical_cast.hpp>
 #include <boost/shared_ptr.hpp>
 #include <ignition/math/Kmeans.hh>
 #include <ignition/math/Rand.hh>
@@ -101,37 +100,26 @@ bool Population::PopulateOne(const sdf::ElementPtr _population)
     return false;
   }
 
-  // Create an sdf containing the model description.
-  sdf::SDF sdf;
-  sdf.SetFromString("<sdf version ='" + std::string(SDF_PROTOCOL_VERSION) +
-    "'>" + params.modelSdf + "</sdf>");
+  // Clone the parsed model description for each instance, instead of
+  // printing and parsing it again for each clone.
+  sdf::ElementPtr modelElem = _population->GetElement("model");
+  std::vector<sdf::ElementPtr> clones;
+  clones.reserve(objects.size());
 
   for (size_t i = 0; i < objects.size(); ++i)
   {
-    ignition::math::Vector3d p(objects[i].X(), objects[i].Y(), objects[i].Z());
-
     // Create a unique model for each clone.
-    std::string cloneSdf = sdf.ToString();
-    std::string delim = "model name='";
-    size_t first = cloneSdf.find(delim) + delim.size();
-    size_t last = cloneSdf.find("'", first);
-    std::string newName = params.modelName + std::string("_clone_") +
-      boost::lexical_cast<std::string>(i);
-    cloneSdf.replace(first, last - first, newName);
-
-    // Insert the <pose> element.
-    std::string endDelim = "'>";
-    first = cloneSdf.find(delim) + delim.size();
-    last = cloneSdf.find(endDelim, first);
-    std::string pose = "\n    <pose>" +
-      boost::lexical_cast<std::string>(p.X()) + " " +
-      boost::lexical_cast<std::string>(p.Y()) + " " +
-      boost::lexical_cast<std::string>(p.Z()) + " 0 0 0</pose>";
-    cloneSdf.insert(last + endDelim.size(), pose);
-
-    this->dataPtr->world->InsertModelString(cloneSdf);
+    sdf::ElementPtr clone = modelElem->Clone();
+    clone->GetAttribute("name")->Set(params.modelName +
+        std::string("_clone_") + std::to_string(i));
+    clone->GetElement("pose")->Set(ignition::math::Pose3d(objects[i],
+        ignition::math::Quaterniond::Identity));
+    clones.push_back(clone);
   }
 
+  // Insert all the clones at once.
+  this->dataPtr->world->InsertModels(clones);
+
   return true;
 }
 
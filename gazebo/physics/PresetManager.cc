@@ -15,6 +15,11 @@
  *
 */
 
+#include <any>
+#include <typeinfo>
+
+#include <ignition/math/Vector3.hh>
+
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/physics/PresetManagerPrivate.hh"
@@ -37,6 +42,59 @@ template<typename T> bool CastAnyValue(const boost::any &_value, T &_return)
   return true;
 }
 
+//////////////////////////////////////////////////
+/// \brief Get the type of the value held by a boost::any, looking into a
+/// std::any it may hold, like PhysicsEngine::any_cast.
+/// \param[in] _value Value.
+/// \return Type of the value.
+static const std::type_info &AnyValueType(const boost::any &_value)
+{
+  const std::any *value = boost::any_cast<std::any>(&_value);
+  if (value)
+    return value->type();
+  return _value.type();
+}
+
+//////////////////////////////////////////////////
+template<typename T> bool AnyValueEqual(const boost::any &_value1,
+    const boost::any &_value2)
+{
+  T value1;
+  T value2;
+  return CastAnyValue(_value1, value1) && CastAnyValue(_value2, value2) &&
+      value1 == value2;
+}
+
+//////////////////////////////////////////////////
+/// \brief Compare two parameter values.
+/// \param[in] _value1 First value.
+/// \param[in] _value2 Second value.
+/// \return True if both values have the same type and are equal. Values of
+/// types parameters don't use are never equal.
+static bool AnyEqual(const boost::any &_value1, const boost::any &_value2)
+{
+  const std::type_info &type = AnyValueType(_value1);
+  if (type != AnyValueType(_value2))
+    return false;
+
+  if (type == typeid(double))
+    return AnyValueEqual<double>(_value1, _value2);
+  if (type == typeid(float))
+    return AnyValueEqual<float>(_value1, _value2);
+  if (type == typeid(int))
+    return AnyValueEqual<int>(_value1, _value2);
+  if (type == typeid(unsigned int))
+    return AnyValueEqual<unsigned int>(_value1, _value2);
+  if (type == typeid(bool))
+    return AnyValueEqual<bool>(_value1, _value2);
+  if (type == typeid(std::string))
+    return AnyValueEqual<std::string>(_value1, _value2);
+  if (type == typeid(ignition::math::Vector3d))
+    return AnyValueEqual<ignition::math::Vector3d>(_value1, _value2);
+
+  return false;
+}
+
 //////////////////////////////////////////////////
 Preset::Preset()
     : dataPtr(new PresetPrivate)
@@ -89,6 +147,39 @@ bool Preset::SetAllPhysicsParameters(PhysicsEnginePtr _physicsEngine) const
   return result;
 }
 
+//////////////////////////////////////////////////
+bool Preset::SetChangedPhysicsParameters(PhysicsEnginePtr _physicsEngine,
+    std::map<std::string, boost::any> &_applied) const
+{
+  if (!_physicsEngine)
+    return this->SetAllPhysicsParameters(_physicsEngine);
+
+  bool result = true;
+  for (auto const &param : this->dataPtr->parameterMap)
+  {
+    // disable params we know can't be set
+    if (param.first == "type")
+      continue;
+
+    // Skip the values which were applied already. A value the engine
+    // rejected is remembered too, so that it isn't retried on every switch.
+    auto applied = _applied.find(param.first);
+    if (applied != _applied.end() && AnyEqual(applied->second, param.second))
+      continue;
+
+    if (!_physicsEngine->SetParam(param.first, param.second))
+    {
+      gzwarn << "Couldn't set parameter [" << param.first
+        << "] in physics engine" << std::endl;
+      result = false;
+    }
+
+    _applied[param.first] = param.second;
+  }
+
+  return result;
+}
+
 //////////////////////////////////////////////////
 bool Preset::SetAllParamsFromSDF(const sdf::ElementPtr _elem)
 {
@@ -278,13 +369,65 @@ bool PresetManager::CurrentProfile(const std::string &_name)
 
     // For now, ignore the return value of this function, since not all
     // parameters are supported
-    this->CurrentPreset()->SetAllPhysicsParameters(
-        this->dataPtr->physicsEngine);
+    this->ApplyChangedParams(*this->CurrentPreset());
   }
 
   return true;
 }
 
+//////////////////////////////////////////////////
+bool PresetManager::QueueProfile(const std::string &_name)
+{
+  if (_name.empty() || !this->HasProfile(_name))
+  {
+    gzwarn << "Profile [" << _name << "] not found." << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->queuedPresetMutex);
+  this->dataPtr->queuedPreset = _name;
+  this->dataPtr->hasQueuedPreset = true;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void PresetManager::ApplyQueuedProfile()
+{
+  if (!this->dataPtr->hasQueuedPreset)
+    return;
+
+  std::string name;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->queuedPresetMutex);
+    name.swap(this->dataPtr->queuedPreset);
+    this->dataPtr->hasQueuedPreset = false;
+  }
+
+  this->CurrentProfile(name);
+}
+
+//////////////////////////////////////////////////
+void PresetManager::InvalidateAppliedParams()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->currentProfileMutex);
+  this->dataPtr->appliedParams.clear();
+}
+
+//////////////////////////////////////////////////
+bool PresetManager::ApplyChangedParams(const Preset &_preset)
+{
+  PhysicsEnginePtr physicsEngine = this->dataPtr->physicsEngine;
+  if (!physicsEngine)
+    return _preset.SetAllPhysicsParameters(physicsEngine);
+
+  // Keep the physics step from running with a partially applied profile
+  boost::recursive_mutex::scoped_lock lock(
+      *physicsEngine->GetPhysicsUpdateMutex());
+
+  return _preset.SetChangedPhysicsParameters(physicsEngine,
+      this->dataPtr->appliedParams);
+}
+
 //////////////////////////////////////////////////
 std::string PresetManager::CurrentProfile() const
 {
@@ -364,7 +507,13 @@ bool PresetManager::SetCurrentProfileParam(const std::string &_key,
     return false;
   try
   {
-    return this->dataPtr->physicsEngine->SetParam(_key, _value);
+    if (!this->dataPtr->physicsEngine->SetParam(_key, _value))
+    {
+      this->dataPtr->appliedParams.erase(_key);
+      return false;
+    }
+    this->dataPtr->appliedParams[_key] = _value;
+    return true;
   }
   catch(const boost::bad_any_cast &e)
   {
@@ -485,8 +634,7 @@ bool PresetManager::ProfileSDF(const std::string &_name,
   if (_name == this->CurrentProfile())
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->currentProfileMutex);
-    this->CurrentPreset()->SetAllPhysicsParameters(
-        this->dataPtr->physicsEngine);
+    this->ApplyChangedParams(*this->CurrentPreset());
   }
 
   iter->second.SetAllParamsFromSDF(_sdf);
@@ -19,6 +19,7 @@
 #define _GAZEBO_PHYSICS_PRESETMANAGER_HH_
 
 #include <boost/any.hpp>
+#include <map>
 #include <string>
 #include <vector>
 #include <sdf/sdf.hh>
@@ -75,6 +76,17 @@ namespace gazebo
       public: bool SetAllPhysicsParameters(PhysicsEnginePtr _physicsEngine)
           const;
 
+      /// \brief Set the parameters of this preset in the physics engine,
+      /// except the ones whose value was applied already.
+      /// \param[in] _physicsEngine The physics engine in which to affect the
+      /// change.
+      /// \param[in,out] _applied Values last applied to the engine, keyed by
+      /// parameter name. The values this call applies, including the ones
+      /// the engine failed to set, are stored in it.
+      /// \return True if setting all the changed parameters was successful.
+      public: bool SetChangedPhysicsParameters(PhysicsEnginePtr _physicsEngine,
+          std::map<std::string, boost::any> &_applied) const;
+
       /// \brief Set all parameters of this preset based on the key/value pairs
       /// in the given SDF element.
       /// \param[in] _elem The physics SDF element from which to read values.
@@ -115,11 +127,31 @@ namespace gazebo
       /// \brief Destructor
       public: ~PresetManager();
 
-      /// \brief Set the current profile.
+      /// \brief Set the current profile. Only the parameters whose value
+      /// differs from the one last applied to the physics engine are set,
+      /// while the physics update mutex is locked, so that a physics step
+      /// never runs with a partially applied profile.
       /// \param[in] _name The name of the new current profile.
       /// \return True if the profile switch was successful.
       public: bool CurrentProfile(const std::string &_name);
 
+      /// \brief Request a switch of the current profile, which the world
+      /// performs before its next step. A later request replaces a pending
+      /// one. This is the cheapest way to switch profiles while the
+      /// simulation runs.
+      /// \param[in] _name The name of the new current profile.
+      /// \return False if the profile doesn't exist.
+      public: bool QueueProfile(const std::string &_name);
+
+      /// \brief Switch to the profile requested by QueueProfile, if any.
+      /// Called by the world between steps.
+      public: void ApplyQueuedProfile();
+
+      /// \brief Forget the parameter values applied to the physics engine,
+      /// so that the next profile switch sets all the parameters. Call it
+      /// after changing parameters of the engine directly.
+      public: void InvalidateAppliedParams();
+
       /// \brief Get the name of the current profile.
       /// \return The name of the current profile.
       public: std::string CurrentProfile() const;
@@ -217,6 +249,13 @@ namespace gazebo
       private: void GeneratePresetFromSDF(const sdf::ElementPtr _elem,
           Preset &_preset) const;
 
+      /// \brief Set the parameters of a preset on the physics engine,
+      /// skipping the ones already applied with the same value. The
+      /// current profile mutex must be locked.
+      /// \param[in] _preset The preset profile to apply.
+      /// \return True if all the parameters were set.
+      private: bool ApplyChangedParams(const Preset &_preset);
+
       /// \brief Get a pointer to the current profile preset.
       /// \return Pointer to the current profile preset object.
       private: Preset *CurrentPreset() const;
@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_PHYSICS_PRESETMANAGER_PRIVATE_HH_
 #define _GAZEBO_PHYSICS_PRESETMANAGER_PRIVATE_HH_
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <mutex>
@@ -64,6 +65,20 @@ namespace gazebo
 
       /// \brief Mutex to protect setting the current preset profile.
       public: std::mutex currentProfileMutex;
+
+      /// \brief Values last applied to the physics engine, keyed by
+      /// parameter name, including the ones the engine failed to set.
+      /// Protected by currentProfileMutex.
+      public: std::map<std::string, boost::any> appliedParams;
+
+      /// \brief Name of the profile to switch to before the next step.
+      public: std::string queuedPreset;
+
+      /// \brief True if queuedPreset holds a profile to switch to.
+      public: std::atomic<bool> hasQueuedPreset{false};
+
+      /// \brief Mutex to protect queuedPreset.
+      public: std::mutex queuedPresetMutex;
     };
   }
 }
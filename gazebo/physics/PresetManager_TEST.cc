@@ -15,6 +15,9 @@
  *
 */
 
+#include <map>
+#include <string>
+
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/test/helper_physics_generator.hh"
 #include "gazebo/physics/PresetManager.hh"
@@ -332,6 +335,91 @@ TEST_F(PresetManagerTest, SDF)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(PresetManagerTest, ChangedParams)
+{
+  Load("test/worlds/presets.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != NULL);
+
+  physics::Preset preset("preset");
+  EXPECT_TRUE(preset.SetParam("iters", 20));
+  EXPECT_TRUE(preset.SetParam("type", std::string("ode")));
+
+  // The first time, all the parameters are applied, except the type
+  std::map<std::string, boost::any> applied;
+  EXPECT_TRUE(preset.SetChangedPhysicsParameters(physics, applied));
+  EXPECT_EQ(1u, applied.size());
+  EXPECT_EQ(20, boost::any_cast<int>(physics->GetParam("iters")));
+
+  // A value applied already is skipped
+  EXPECT_TRUE(physics->SetParam("iters", 30));
+  EXPECT_TRUE(preset.SetChangedPhysicsParameters(physics, applied));
+  EXPECT_EQ(30, boost::any_cast<int>(physics->GetParam("iters")));
+
+  // A changed value is applied
+  EXPECT_TRUE(preset.SetParam("iters", 40));
+  EXPECT_TRUE(preset.SetChangedPhysicsParameters(physics, applied));
+  EXPECT_EQ(40, boost::any_cast<int>(physics->GetParam("iters")));
+
+  // Switching profiles only sets what differs, unless the applied values
+  // were invalidated
+  physics::PresetManagerPtr presetManager = world->PresetMgr();
+  EXPECT_TRUE(presetManager->CurrentProfile("preset_2"));
+  EXPECT_EQ(100, boost::any_cast<int>(physics->GetParam("iters")));
+  EXPECT_DOUBLE_EQ(0.02, physics->GetMaxStepSize());
+
+  EXPECT_TRUE(presetManager->CurrentProfile("preset_1"));
+  EXPECT_EQ(50, boost::any_cast<int>(physics->GetParam("iters")));
+  EXPECT_DOUBLE_EQ(0.01, physics->GetMaxStepSize());
+
+  // A parameter changed on the engine directly stays, if both profiles
+  // have the same value
+  EXPECT_TRUE(physics->SetParam("iters", 10));
+  EXPECT_TRUE(presetManager->SetProfileParam("preset_2", "iters", 50));
+  EXPECT_TRUE(presetManager->CurrentProfile("preset_2"));
+  EXPECT_EQ(10, boost::any_cast<int>(physics->GetParam("iters")));
+  EXPECT_DOUBLE_EQ(0.02, physics->GetMaxStepSize());
+
+  presetManager->InvalidateAppliedParams();
+  EXPECT_TRUE(presetManager->CurrentProfile("preset_1"));
+  EXPECT_EQ(50, boost::any_cast<int>(physics->GetParam("iters")));
+  EXPECT_DOUBLE_EQ(0.01, physics->GetMaxStepSize());
+}
+
+/////////////////////////////////////////////////
+TEST_F(PresetManagerTest, QueueProfile)
+{
+  Load("test/worlds/presets.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  physics::PresetManagerPtr presetManager = world->PresetMgr();
+  EXPECT_EQ("preset_1", presetManager->CurrentProfile());
+
+  EXPECT_FALSE(presetManager->QueueProfile(""));
+  EXPECT_FALSE(presetManager->QueueProfile("preset_does_not_exist"));
+
+  // The switch happens before the next step, and the latest request wins
+  EXPECT_TRUE(presetManager->QueueProfile("unused"));
+  EXPECT_TRUE(presetManager->QueueProfile("preset_2"));
+  EXPECT_EQ("preset_1", presetManager->CurrentProfile());
+  EXPECT_DOUBLE_EQ(0.01, world->Physics()->GetMaxStepSize());
+
+  world->Step(1);
+  EXPECT_EQ("preset_2", presetManager->CurrentProfile());
+  EXPECT_DOUBLE_EQ(0.02, world->Physics()->GetMaxStepSize());
+
+  // Nothing is queued anymore
+  EXPECT_TRUE(presetManager->CurrentProfile("preset_1"));
+  world->Step(1);
+  EXPECT_EQ("preset_1", presetManager->CurrentProfile());
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
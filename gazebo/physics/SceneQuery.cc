@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <ignition/math/Matrix3.hh>
+
+#include "gazebo/physics/SceneQuery.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+QueryShape QueryShape::Sphere(const double _radius)
+{
+  QueryShape shape;
+  shape.type = SPHERE;
+  shape.radius = _radius;
+  shape.size.Set(2.0 * _radius, 2.0 * _radius, 2.0 * _radius);
+  return shape;
+}
+
+//////////////////////////////////////////////////
+QueryShape QueryShape::Box(const ignition::math::Vector3d &_size)
+{
+  QueryShape shape;
+  shape.type = BOX;
+  shape.size = _size;
+  shape.radius = 0.5 * _size.Length();
+  return shape;
+}
+
+//////////////////////////////////////////////////
+ignition::math::AxisAlignedBox QueryShape::Bounds(
+    const ignition::math::Pose3d &_pose) const
+{
+  ignition::math::Vector3d extent;
+  if (this->type == SPHERE)
+  {
+    extent.Set(this->radius, this->radius, this->radius);
+  }
+  else
+  {
+    // Half extents of the rotated box along the world axes
+    const ignition::math::Matrix3d rot(_pose.Rot());
+    const ignition::math::Vector3d half = this->size * 0.5;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      extent[i] = std::abs(rot(i, 0)) * half.X() +
+                  std::abs(rot(i, 1)) * half.Y() +
+                  std::abs(rot(i, 2)) * half.Z();
+    }
+  }
+  return ignition::math::AxisAlignedBox(_pose.Pos() - extent,
+      _pose.Pos() + extent);
+}
+
+//////////////////////////////////////////////////
+double QueryShape::InnerRadius() const
+{
+  if (this->type == SPHERE)
+    return this->radius;
+  return 0.5 * std::min(this->size.X(), std::min(this->size.Y(),
+        this->size.Z()));
+}
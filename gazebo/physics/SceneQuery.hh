@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_SCENEQUERY_HH_
+#define GAZEBO_PHYSICS_SCENEQUERY_HH_
+
+#include <limits>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class QueryRay SceneQuery.hh physics/physics.hh
+    /// \brief A ray cast by PhysicsEngine::Raycast.
+    class GZ_PHYSICS_VISIBLE QueryRay
+    {
+      /// \brief Start of the ray in world frame.
+      public: ignition::math::Vector3d start;
+
+      /// \brief End of the ray in world frame.
+      public: ignition::math::Vector3d end;
+    };
+
+    /// \class QueryHit SceneQuery.hh physics/physics.hh
+    /// \brief Result of a raycast or sweep query.
+    class GZ_PHYSICS_VISIBLE QueryHit
+    {
+      /// \brief Collision that was hit, nullptr if nothing was hit.
+      public: CollisionPtr collision;
+
+      /// \brief Distance from the start of the ray or sweep to the hit.
+      public: double distance = std::numeric_limits<double>::infinity();
+
+      /// \brief Hit point in world frame.
+      public: ignition::math::Vector3d point;
+
+      /// \brief Surface normal at the hit point in world frame, zero if
+      /// the physics engine does not report normals.
+      public: ignition::math::Vector3d normal;
+    };
+
+    /// \class QueryShape SceneQuery.hh physics/physics.hh
+    /// \brief Shape of an overlap or sweep query.
+    class GZ_PHYSICS_VISIBLE QueryShape
+    {
+      /// \brief Shape types.
+      public: enum Type
+      {
+        /// \brief A sphere of radius.
+        SPHERE,
+
+        /// \brief A box of size, centered on the query pose.
+        BOX
+      };
+
+      /// \brief Create a sphere query shape.
+      /// \param[in] _radius Sphere radius.
+      /// \return The shape.
+      public: static QueryShape Sphere(const double _radius);
+
+      /// \brief Create a box query shape.
+      /// \param[in] _size Box size.
+      /// \return The shape.
+      public: static QueryShape Box(const ignition::math::Vector3d &_size);
+
+      /// \brief Get the world axis aligned bounds of the shape.
+      /// \param[in] _pose Pose of the shape in world frame.
+      /// \return Bounds of the shape at _pose.
+      public: ignition::math::AxisAlignedBox Bounds(
+                  const ignition::math::Pose3d &_pose) const;
+
+      /// \brief Get the radius of the largest sphere inside the shape.
+      /// Sweeps advance by at most this distance between overlap tests.
+      /// \return Inner radius.
+      public: double InnerRadius() const;
+
+      /// \brief Shape type.
+      public: Type type = SPHERE;
+
+      /// \brief Sphere radius.
+      public: double radius = 0.0;
+
+      /// \brief Box size.
+      public: ignition::math::Vector3d size;
+    };
+    /// \}
+  }
+}
+#endif
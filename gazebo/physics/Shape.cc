@@ -62,3 +62,9 @@ double Shape::ComputeVolume() const
   return size.X() * size.Y() * size.Z();
 }
 
+//////////////////////////////////////////////////
+void Shape::InvalidateBoundingBox()
+{
+  if (this->collisionParent)
+    this->collisionParent->InvalidateBoundingBox();
+}
@@ -69,6 +69,10 @@ namespace gazebo
       /// \return The shape volume in kg/m^3.
       public: virtual double ComputeVolume() const;
 
+      /// \brief Tell the collision parent that its bounding box changed.
+      /// Shapes call this when their geometry changes.
+      protected: void InvalidateBoundingBox();
+
       /// \brief This shape's collision parent.
       protected: CollisionPtr collisionParent;
 
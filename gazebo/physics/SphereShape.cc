@@ -41,6 +41,7 @@ void SphereShape::Init()
 void SphereShape::SetRadius(double _radius)
 {
   this->sdf->GetElement("radius")->Set(_radius);
+  this->InvalidateBoundingBox();
 }
 
 //////////////////////////////////////////////////
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "gazebo/physics/StepSizeController.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Private data for the StepSizeController class
+class gazebo::physics::StepSizeControllerPrivate
+{
+  /// \brief Minimum step size.
+  public: double minStepSize = 0.001;
+
+  /// \brief Largest exponent: the maximum step size is
+  /// minStepSize * 2^maxLevel.
+  public: unsigned int maxLevel = 0;
+
+  /// \brief Current exponent.
+  public: unsigned int level = 0;
+
+  /// \brief Calm steps before the step size doubles.
+  public: unsigned int growSteps = 10;
+
+  /// \brief Calm steps since the last change of the step size.
+  public: unsigned int calmSteps = 0;
+};
+
+/////////////////////////////////////////////////
+StepSizeController::StepSizeController()
+  : dataPtr(new StepSizeControllerPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+StepSizeController::~StepSizeController()
+{
+}
+
+/////////////////////////////////////////////////
+bool StepSizeController::SetBounds(const double _minStepSize,
+    const double _maxStepSize)
+{
+  if (!(_minStepSize > 0) || _maxStepSize < _minStepSize)
+    return false;
+
+  // A small tolerance, so that e.g. 0.004 / 0.001 gives 2 levels
+  const double ratio = _maxStepSize / _minStepSize;
+  this->dataPtr->minStepSize = _minStepSize;
+  this->dataPtr->maxLevel = static_cast<unsigned int>(
+      std::min(std::floor(std::log2(ratio) + 1e-9), 31.0));
+  this->Reset();
+  return true;
+}
+
+/////////////////////////////////////////////////
+double StepSizeController::MinStepSize() const
+{
+  return this->dataPtr->minStepSize;
+}
+
+/////////////////////////////////////////////////
+double StepSizeController::MaxStepSize() const
+{
+  return this->dataPtr->minStepSize * (1u << this->dataPtr->maxLevel);
+}
+
+/////////////////////////////////////////////////
+void StepSizeController::SetGrowSteps(const unsigned int _steps)
+{
+  this->dataPtr->growSteps = std::max(_steps, 1u);
+}
+
+/////////////////////////////////////////////////
+unsigned int StepSizeController::GrowSteps() const
+{
+  return this->dataPtr->growSteps;
+}
+
+/////////////////////////////////////////////////
+double StepSizeController::StepSize() const
+{
+  return this->dataPtr->minStepSize * (1u << this->dataPtr->level);
+}
+
+/////////////////////////////////////////////////
+double StepSizeController::Update(const double _simTime,
+    const bool _eventful, const double _limit)
+{
+  StepSizeControllerPrivate &data = *this->dataPtr;
+
+  // Largest level allowed by the limit
+  unsigned int maxLevel = data.maxLevel;
+  if (_limit > 0)
+  {
+    const double ratio = _limit / data.minStepSize;
+    if (ratio < 2)
+    {
+      maxLevel = 0;
+    }
+    else
+    {
+      maxLevel = std::min(maxLevel,
+          static_cast<unsigned int>(std::floor(std::log2(ratio) + 1e-9)));
+    }
+  }
+
+  if (_eventful)
+  {
+    data.level = 0;
+    data.calmSteps = 0;
+  }
+  else if (data.level > maxLevel)
+  {
+    // Smaller steps divide the larger ones, so they stay on the grid
+    data.level = maxLevel;
+    data.calmSteps = 0;
+  }
+  else if (data.level < maxLevel && ++data.calmSteps >= data.growSteps)
+  {
+    // Grow only at a multiple of the larger step, counted in minimum
+    // steps from the origin of the simulation time
+    const uint64_t ticks = static_cast<uint64_t>(
+        std::llround(std::max(_simTime, 0.0) / data.minStepSize));
+    const uint64_t larger = uint64_t(1) << (data.level + 1);
+    if (ticks % larger == 0)
+    {
+      ++data.level;
+      data.calmSteps = 0;
+    }
+  }
+
+  return this->StepSize();
+}
+
+/////////////////////////////////////////////////
+void StepSizeController::Reset()
+{
+  this->dataPtr->level = 0;
+  this->dataPtr->calmSteps = 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_STEPSIZECONTROLLER_HH_
+#define GAZEBO_PHYSICS_STEPSIZECONTROLLER_HH_
+
+#include <memory>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class StepSizeControllerPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class StepSizeController StepSizeController.hh physics/physics.hh
+    /// \brief Choose the size of the next physics step between bounds.
+    ///
+    /// Step sizes are the minimum step size times a power of two, and a
+    /// step only grows when the simulation time is a multiple of the larger
+    /// size. Every step therefore ends on the grid of the minimum step
+    /// size, like with fixed steps of that size, so that sensors and
+    /// plugins updating at multiples of it are scheduled at the right
+    /// time.
+    ///
+    /// The step drops to the minimum size as soon as a step is reported as
+    /// eventful, e.g. because of an impact, and doubles after a number of
+    /// calm steps.
+    class GZ_PHYSICS_VISIBLE StepSizeController
+    {
+      /// \brief Constructor.
+      public: StepSizeController();
+
+      /// \brief Destructor.
+      public: ~StepSizeController();
+
+      /// \brief Set the bounds of the step size, and restart at the
+      /// minimum step size.
+      /// \param[in] _minStepSize Minimum step size in seconds.
+      /// \param[in] _maxStepSize Maximum step size in seconds, rounded down
+      /// to the minimum step size times a power of two.
+      /// \return False if the minimum step size is not positive or is
+      /// larger than the maximum.
+      public: bool SetBounds(const double _minStepSize,
+                  const double _maxStepSize);
+
+      /// \brief Get the minimum step size.
+      /// \return Step size in seconds.
+      public: double MinStepSize() const;
+
+      /// \brief Get the maximum step size, after rounding.
+      /// \return Step size in seconds.
+      public: double MaxStepSize() const;
+
+      /// \brief Set the number of calm steps before the step size doubles.
+      /// \param[in] _steps Number of steps, at least one. The default is
+      /// 10.
+      public: void SetGrowSteps(const unsigned int _steps);
+
+      /// \brief Get the number of calm steps before the step size doubles.
+      /// \return Number of steps.
+      public: unsigned int GrowSteps() const;
+
+      /// \brief Get the current step size.
+      /// \return Step size in seconds.
+      public: double StepSize() const;
+
+      /// \brief Choose the size of the next step.
+      /// \param[in] _simTime Simulation time at the start of the next step,
+      /// in seconds.
+      /// \param[in] _eventful True if the previous step had an event which
+      /// requires the minimum step size, such as an impact.
+      /// \param[in] _limit Largest acceptable step size in seconds, zero or
+      /// negative for no limit. The step is the largest size of the grid
+      /// which doesn't exceed it, or the minimum size.
+      /// \return Size of the next step in seconds.
+      public: double Update(const double _simTime, const bool _eventful,
+                  const double _limit = 0);
+
+      /// \brief Restart at the minimum step size.
+      public: void Reset();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<StepSizeControllerPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
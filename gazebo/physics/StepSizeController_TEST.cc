@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "gazebo/physics/StepSizeController.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class StepSizeControllerTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Check that a time is on the grid of a step size.
+/// \param[in] _time Time in seconds.
+/// \param[in] _step Step size in seconds.
+/// \return True if the time is a multiple of the step size.
+static bool OnGrid(const double _time, const double _step)
+{
+  const double ticks = _time / _step;
+  return std::abs(ticks - std::round(ticks)) < 1e-6;
+}
+
+/////////////////////////////////////////////////
+TEST_F(StepSizeControllerTest, Bounds)
+{
+  physics::StepSizeController controller;
+  EXPECT_FALSE(controller.SetBounds(0, 0.004));
+  EXPECT_FALSE(controller.SetBounds(-0.001, 0.004));
+  EXPECT_FALSE(controller.SetBounds(0.004, 0.001));
+
+  // The maximum is rounded down to a power of two of the minimum
+  EXPECT_TRUE(controller.SetBounds(0.001, 0.005));
+  EXPECT_DOUBLE_EQ(0.001, controller.MinStepSize());
+  EXPECT_DOUBLE_EQ(0.004, controller.MaxStepSize());
+  EXPECT_DOUBLE_EQ(0.001, controller.StepSize());
+
+  EXPECT_TRUE(controller.SetBounds(0.001, 0.001));
+  EXPECT_DOUBLE_EQ(0.001, controller.MaxStepSize());
+  EXPECT_DOUBLE_EQ(0.001, controller.Update(0, false));
+
+  controller.SetGrowSteps(0);
+  EXPECT_EQ(1u, controller.GrowSteps());
+}
+
+/////////////////////////////////////////////////
+TEST_F(StepSizeControllerTest, GrowShrink)
+{
+  physics::StepSizeController controller;
+  ASSERT_TRUE(controller.SetBounds(0.001, 0.004));
+  controller.SetGrowSteps(3);
+
+  // Calm steps grow to the maximum, always on the grid of the new size
+  double simTime = 0;
+  double step = controller.StepSize();
+  for (int i = 0; i < 50; ++i)
+  {
+    simTime += step;
+    const double next = controller.Update(simTime, false);
+    if (next > step)
+      EXPECT_TRUE(OnGrid(simTime, next));
+    EXPECT_TRUE(OnGrid(simTime, 0.001));
+    step = next;
+  }
+  EXPECT_DOUBLE_EQ(0.004, step);
+
+  // An event drops to the minimum at once
+  simTime += step;
+  EXPECT_DOUBLE_EQ(0.001, controller.Update(simTime, true));
+
+  // Growing again waits for the calm steps
+  step = 0.001;
+  simTime += step;
+  EXPECT_DOUBLE_EQ(0.001, controller.Update(simTime, false));
+  simTime += step;
+  EXPECT_DOUBLE_EQ(0.001, controller.Update(simTime, false));
+
+  // A limit caps the step size to a size of the grid
+  for (int i = 0; i < 50; ++i)
+  {
+    simTime += step;
+    step = controller.Update(simTime, false, 0.0025);
+  }
+  EXPECT_DOUBLE_EQ(0.002, step);
+  EXPECT_DOUBLE_EQ(0.001, controller.Update(simTime + step, false, 0.0001));
+
+  controller.Reset();
+  EXPECT_DOUBLE_EQ(0.001, controller.StepSize());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
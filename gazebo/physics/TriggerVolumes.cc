@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/ModelBoxIndex.hh"
+#include "gazebo/physics/TriggerVolumes.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief A trigger volume.
+struct TriggerVolume
+{
+  /// \brief Volume in the world frame.
+  ignition::math::AxisAlignedBox box;
+
+  /// \brief Called on enter and exit.
+  TriggerVolumes::Callback callback;
+
+  /// \brief Models inside, sorted by id.
+  Model_V models;
+
+  /// \brief Index change the volume was last evaluated at.
+  uint64_t lastChange = 0;
+
+  /// \brief True to evaluate at the next update regardless of changes.
+  bool evaluate = true;
+};
+
+/// \brief Private data for the TriggerVolumes class
+class gazebo::physics::TriggerVolumesPrivate
+{
+  /// \brief Volumes by id.
+  public: std::map<unsigned int, TriggerVolume> volumes;
+
+  /// \brief Id of the next volume.
+  public: unsigned int nextId = 0;
+
+  /// \brief Index used by the last update, a new index restarts its
+  /// change counter.
+  public: const ModelBoxIndex *index = nullptr;
+
+  /// \brief Number of volumes evaluated by the last update.
+  public: unsigned int evaluatedCount = 0;
+
+  /// \brief Protects the members above.
+  public: mutable std::mutex mutex;
+};
+
+/// \brief Compare models by id.
+/// \param[in] _a First model.
+/// \param[in] _b Second model.
+/// \return True if _a has the lower id.
+static bool LessId(const ModelPtr &_a, const ModelPtr &_b)
+{
+  return _a->GetId() < _b->GetId();
+}
+
+//////////////////////////////////////////////////
+TriggerVolumes::TriggerVolumes()
+  : dataPtr(new TriggerVolumesPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+TriggerVolumes::~TriggerVolumes()
+{
+}
+
+//////////////////////////////////////////////////
+unsigned int TriggerVolumes::Add(const ignition::math::AxisAlignedBox &_box,
+    const Callback &_callback)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const unsigned int id = this->dataPtr->nextId++;
+  TriggerVolume &volume = this->dataPtr->volumes[id];
+  volume.box = _box;
+  volume.callback = _callback;
+  return id;
+}
+
+//////////////////////////////////////////////////
+void TriggerVolumes::Remove(const unsigned int _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->volumes.erase(_id);
+}
+
+//////////////////////////////////////////////////
+void TriggerVolumes::SetBox(const unsigned int _id,
+    const ignition::math::AxisAlignedBox &_box)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto volume = this->dataPtr->volumes.find(_id);
+  if (volume == this->dataPtr->volumes.end() || volume->second.box == _box)
+    return;
+
+  volume->second.box = _box;
+  volume->second.evaluate = true;
+}
+
+//////////////////////////////////////////////////
+Model_V TriggerVolumes::Models(const unsigned int _id) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto volume = this->dataPtr->volumes.find(_id);
+  if (volume == this->dataPtr->volumes.end())
+    return Model_V();
+  return volume->second.models;
+}
+
+//////////////////////////////////////////////////
+unsigned int TriggerVolumes::Count() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->volumes.size();
+}
+
+//////////////////////////////////////////////////
+unsigned int TriggerVolumes::EvaluatedCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->evaluatedCount;
+}
+
+//////////////////////////////////////////////////
+void TriggerVolumes::Update(const ModelBoxIndexPtr &_index)
+{
+  if (!_index)
+    return;
+
+  // Transitions are reported after the lock is released, so callbacks may
+  // add or remove volumes.
+  std::vector<std::pair<unsigned int, std::pair<ModelPtr, bool>>> events;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    const bool newIndex = this->dataPtr->index != _index.get();
+    this->dataPtr->index = _index.get();
+    this->dataPtr->evaluatedCount = 0;
+
+    for (auto &iter : this->dataPtr->volumes)
+    {
+      TriggerVolume &volume = iter.second;
+      const uint64_t change = _index->LastChange(volume.box);
+      if (!newIndex && !volume.evaluate && change == volume.lastChange)
+        continue;
+      volume.lastChange = change;
+      volume.evaluate = false;
+      ++this->dataPtr->evaluatedCount;
+
+      // Both lists are sorted by id
+      Model_V models = _index->Query(volume.box);
+      Model_V entered;
+      Model_V left;
+      std::set_difference(models.begin(), models.end(),
+          volume.models.begin(), volume.models.end(),
+          std::back_inserter(entered), LessId);
+      std::set_difference(volume.models.begin(), volume.models.end(),
+          models.begin(), models.end(), std::back_inserter(left), LessId);
+
+      for (auto const &model : left)
+        events.push_back({iter.first, {model, false}});
+      for (auto const &model : entered)
+        events.push_back({iter.first, {model, true}});
+
+      volume.models.swap(models);
+    }
+  }
+
+  for (auto const &event : events)
+  {
+    Callback callback;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      auto volume = this->dataPtr->volumes.find(event.first);
+      if (volume == this->dataPtr->volumes.end())
+        continue;
+      callback = volume->second.callback;
+    }
+    if (callback)
+      callback(event.second.first, event.second.second);
+  }
+}
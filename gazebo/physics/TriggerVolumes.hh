@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_TRIGGERVOLUMES_HH_
+#define GAZEBO_PHYSICS_TRIGGERVOLUMES_HH_
+
+#include <functional>
+#include <memory>
+
+#include <ignition/math/AxisAlignedBox.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class TriggerVolumesPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class TriggerVolumes TriggerVolumes.hh physics/physics.hh
+    /// \brief Axis aligned trigger volumes that report models entering and
+    /// leaving them, built on the world's ModelBoxIndex.
+    ///
+    /// A model is inside a volume while its bounding box intersects it.
+    /// Volumes are evaluated at the end of World::Update, right after the
+    /// index is refreshed, and only if the index reports a change in their
+    /// region, so a quiet volume costs a lookup of its grid cells per step
+    /// instead of a pose test per tracked entity. Nested models are
+    /// reported as well as top level models.
+    /// \sa World::TriggerVolumes
+    class GZ_PHYSICS_VISIBLE TriggerVolumes
+    {
+      /// \brief Called when a model enters or leaves a volume.
+      /// \param[in] _model The model. Models removed from the world are
+      /// reported as leaving.
+      /// \param[in] _inside True if the model entered the volume, false if
+      /// it left.
+      public: using Callback =
+                  std::function<void(const ModelPtr &_model,
+                      const bool _inside)>;
+
+      /// \brief Constructor.
+      public: TriggerVolumes();
+
+      /// \brief Destructor.
+      public: ~TriggerVolumes();
+
+      /// \brief Add a volume. Models already inside it are reported as
+      /// entering at the next update. Thread safe.
+      /// \param[in] _box Volume in the world frame.
+      /// \param[in] _callback Called from the world update thread.
+      /// \return Id of the volume.
+      public: unsigned int Add(const ignition::math::AxisAlignedBox &_box,
+                  const Callback &_callback);
+
+      /// \brief Remove a volume. Its callback is not called anymore, not
+      /// even for the models still inside. Thread safe.
+      /// \param[in] _id Id returned by Add.
+      public: void Remove(const unsigned int _id);
+
+      /// \brief Move or resize a volume. Thread safe.
+      /// \param[in] _id Id returned by Add.
+      /// \param[in] _box New volume in the world frame.
+      public: void SetBox(const unsigned int _id,
+                  const ignition::math::AxisAlignedBox &_box);
+
+      /// \brief Get the models inside a volume, as of the last update.
+      /// Thread safe.
+      /// \param[in] _id Id returned by Add.
+      /// \return Models sorted by id.
+      public: Model_V Models(const unsigned int _id) const;
+
+      /// \brief Get the number of volumes.
+      /// \return Number of volumes.
+      public: unsigned int Count() const;
+
+      /// \brief Get the number of volumes evaluated by the last update.
+      /// \return Number of volumes whose region changed.
+      public: unsigned int EvaluatedCount() const;
+
+      /// \brief Evaluate the volumes whose region changed and call the
+      /// callbacks. Only World calls this.
+      /// \param[in] _index The world's index, already refreshed.
+      private: void Update(const ModelBoxIndexPtr &_index);
+
+      /// \brief Only World may update the volumes.
+      friend class World;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<TriggerVolumesPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/TriggerVolumes.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class TriggerVolumesTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(TriggerVolumesTest, EnterExit)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5), ignition::math::Vector3d::Zero,
+      true);
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+
+  physics::TriggerVolumesPtr triggers = world->TriggerVolumes();
+  ASSERT_TRUE(triggers != nullptr);
+  EXPECT_TRUE(world->BoxIndexEnabled());
+  EXPECT_EQ(triggers, world->TriggerVolumes());
+
+  std::vector<std::string> entered;
+  std::vector<std::string> left;
+  auto callback = [&](const physics::ModelPtr &_model, const bool _inside)
+  {
+    if (_model->GetName() == "ground_plane")
+      return;
+    if (_inside)
+      entered.push_back(_model->GetName());
+    else
+      left.push_back(_model->GetName());
+  };
+
+  const ignition::math::AxisAlignedBox volumeBox(
+      ignition::math::Vector3d(20, -1, 0), ignition::math::Vector3d(22, 1, 2));
+  const unsigned int id = triggers->Add(volumeBox, callback);
+  EXPECT_EQ(1u, triggers->Count());
+
+  // Empty at first
+  world->Step(1);
+  EXPECT_TRUE(entered.empty());
+  EXPECT_TRUE(left.empty());
+
+  // Nothing changes in the region, the volume is not evaluated
+  world->Step(1);
+  EXPECT_EQ(0u, triggers->EvaluatedCount());
+
+  // Enter
+  box->SetWorldPose(ignition::math::Pose3d(21, 0, 0.5, 0, 0, 0));
+  world->Step(1);
+  ASSERT_EQ(1u, entered.size());
+  EXPECT_EQ("box", entered[0]);
+  EXPECT_TRUE(left.empty());
+  physics::Model_V models = triggers->Models(id);
+  EXPECT_TRUE(std::find(models.begin(), models.end(), box) != models.end());
+
+  // Moving inside is not reported again
+  box->SetWorldPose(ignition::math::Pose3d(21.2, 0, 0.5, 0, 0, 0));
+  world->Step(1);
+  EXPECT_EQ(1u, entered.size());
+  EXPECT_TRUE(left.empty());
+
+  // Exit
+  box->SetWorldPose(ignition::math::Pose3d(0, 0, 0.5, 0, 0, 0));
+  world->Step(1);
+  EXPECT_EQ(1u, entered.size());
+  ASSERT_EQ(1u, left.size());
+  EXPECT_EQ("box", left[0]);
+
+  // Moving the volume over the model reports it
+  triggers->SetBox(id, ignition::math::AxisAlignedBox(
+      ignition::math::Vector3d(-1, -1, 0), ignition::math::Vector3d(1, 1, 2)));
+  world->Step(1);
+  EXPECT_EQ(2u, entered.size());
+
+  // Removed volumes are silent
+  triggers->Remove(id);
+  EXPECT_EQ(0u, triggers->Count());
+  box->SetWorldPose(ignition::math::Pose3d(50, 0, 0.5, 0, 0, 0));
+  world->Step(1);
+  EXPECT_EQ(1u, left.size());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,11 +14,16 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
+#include <cstdlib>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/transport/transport.hh"
 
+#include "gazebo/physics/Model.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/WorldState.hh"
 
@@ -28,6 +33,115 @@
 using namespace gazebo;
 using namespace physics;
 
+/////////////////////////////////////////////////
+/// \brief Estimate the memory used by a model state.
+/// \param[in] _state Model state.
+/// \return Number of bytes.
+static size_t modelStateSize(const ModelState &_state)
+{
+  size_t size = sizeof(ModelState) + _state.GetName().capacity();
+
+  for (const auto &link : _state.GetLinkStates())
+  {
+    size += sizeof(LinkState) + link.first.capacity() +
+        link.second.GetCollisionStateCount() * sizeof(CollisionState);
+  }
+
+  for (const auto &joint : _state.GetJointStates())
+  {
+    size += sizeof(JointState) + joint.first.capacity() +
+        joint.second.GetAngleCount() * sizeof(double);
+  }
+
+  for (const auto &nested : _state.NestedModelStates())
+    size += modelStateSize(nested.second);
+
+  return size;
+}
+
+/////////////////////////////////////////////////
+/// \brief Estimate the memory used by a world state.
+/// \param[in] _state World state.
+/// \return Number of bytes.
+static size_t worldStateSize(const WorldState &_state)
+{
+  size_t size = sizeof(WorldState);
+
+  for (const auto &model : _state.GetModelStates())
+    size += modelStateSize(model.second);
+
+  for (const auto &light : _state.LightStates())
+    size += sizeof(LightState) + light.first.capacity();
+
+  for (const auto &insertion : _state.Insertions())
+    size += insertion.capacity();
+
+  for (const auto &deletion : _state.Deletions())
+    size += deletion.capacity();
+
+  return size;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the top level models and the lights affected by a command.
+/// \param[in] _msg Command message.
+/// \return Names of the entities, without duplicates.
+static std::vector<std::string> affectedEntities(const msgs::UserCmd &_msg)
+{
+  std::vector<std::string> names;
+  auto addName = [&names](const std::string &_name)
+  {
+    // Nested models and links are restored with their top level model
+    const std::string topName = _name.substr(0, _name.find("::"));
+    if (!topName.empty() &&
+        std::find(names.begin(), names.end(), topName) == names.end())
+    {
+      names.push_back(topName);
+    }
+  };
+
+  for (int i = 0; i < _msg.model_size(); ++i)
+    addName(_msg.model(i).name());
+
+  for (int i = 0; i < _msg.light_size(); ++i)
+    addName(_msg.light(i).name());
+
+  if (_msg.has_entity_name())
+    addName(_msg.entity_name());
+
+  return names;
+}
+
+/////////////////////////////////////////////////
+/// \brief Reset the physics states of the entities recorded by a command.
+/// \param[in] _cmd Private data of the command.
+static void resetPhysicsStates(const UserCmdPrivate &_cmd)
+{
+  if (_cmd.wholeWorld)
+  {
+    _cmd.world->ResetPhysicsStates();
+    return;
+  }
+
+  for (const auto &name : _cmd.entities)
+  {
+    ModelPtr model = _cmd.world->ModelByName(name);
+    if (model)
+      model->ResetPhysicsStates();
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Estimate the memory used by a list of commands.
+/// \param[in] _cmds Commands.
+/// \return Number of bytes.
+static size_t commandsSize(const std::vector<UserCmdPtr> &_cmds)
+{
+  size_t size = 0;
+  for (const auto &cmd : _cmds)
+    size += cmd->MemorySize();
+  return size;
+}
 
 /////////////////////////////////////////////////
 UserCmd::UserCmd(const unsigned int _id,
@@ -45,6 +159,26 @@ UserCmd::UserCmd(const unsigned int _id,
   this->dataPtr->startState = WorldState(this->dataPtr->world);
 }
 
+/////////////////////////////////////////////////
+UserCmd::UserCmd(const unsigned int _id,
+                 physics::WorldPtr _world,
+                 const std::string &_description,
+                 const msgs::UserCmd::Type &_type,
+                 const std::vector<std::string> &_entities)
+  : dataPtr(new UserCmdPrivate())
+{
+  this->dataPtr->id = _id;
+  this->dataPtr->world = _world;
+  this->dataPtr->description = _description;
+  this->dataPtr->type = _type;
+  this->dataPtr->wholeWorld = false;
+  this->dataPtr->entities = _entities;
+
+  // Record the current state of the affected entities only
+  this->dataPtr->startState.LoadEntities(this->dataPtr->world,
+      this->dataPtr->entities);
+}
+
 /////////////////////////////////////////////////
 UserCmd::~UserCmd()
 {
@@ -60,10 +194,18 @@ UserCmd::~UserCmd()
 void UserCmd::Undo()
 {
   // Record / override the state for redo
-  this->dataPtr->endState = WorldState(this->dataPtr->world);
+  if (this->dataPtr->wholeWorld)
+  {
+    this->dataPtr->endState = WorldState(this->dataPtr->world);
+  }
+  else
+  {
+    this->dataPtr->endState.LoadEntities(this->dataPtr->world,
+        this->dataPtr->entities);
+  }
 
-  // Reset physics states for the whole world
-  this->dataPtr->world->ResetPhysicsStates();
+  // Reset physics states of the recorded entities
+  resetPhysicsStates(*this->dataPtr);
 
   // Set state to the moment the command was executed
   this->dataPtr->world->SetState(this->dataPtr->startState);
@@ -72,8 +214,8 @@ void UserCmd::Undo()
 /////////////////////////////////////////////////
 void UserCmd::Redo()
 {
-  // Reset physics states for the whole world
-  this->dataPtr->world->ResetPhysicsStates();
+  // Reset physics states of the recorded entities
+  resetPhysicsStates(*this->dataPtr);
 
   // Set state to the moment undo was triggered
   this->dataPtr->world->SetState(this->dataPtr->endState);
@@ -97,6 +239,32 @@ msgs::UserCmd::Type UserCmd::Type() const
   return this->dataPtr->type;
 }
 
+/////////////////////////////////////////////////
+bool UserCmd::WholeWorld() const
+{
+  return this->dataPtr->wholeWorld;
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::string> &UserCmd::Entities() const
+{
+  return this->dataPtr->entities;
+}
+
+/////////////////////////////////////////////////
+size_t UserCmd::MemorySize() const
+{
+  size_t size = sizeof(UserCmdPrivate) +
+      this->dataPtr->description.capacity() +
+      worldStateSize(this->dataPtr->startState) +
+      worldStateSize(this->dataPtr->endState);
+
+  for (const auto &name : this->dataPtr->entities)
+    size += sizeof(std::string) + name.capacity();
+
+  return size;
+}
+
 /////////////////////////////////////////////////
 UserCmdManager::UserCmdManager(const WorldPtr _world)
   : dataPtr(new UserCmdManagerPrivate())
@@ -125,6 +293,21 @@ UserCmdManager::UserCmdManager(const WorldPtr _world)
       this->dataPtr->node->Advertise<msgs::Light>("~/light/modify");
 
   this->dataPtr->idCounter = 0;
+
+  // The history can be bounded from the environment
+  const char *historyLimit = common::getEnv("GAZEBO_UNDO_HISTORY_LIMIT");
+  if (historyLimit)
+  {
+    this->dataPtr->historyLimit =
+        static_cast<unsigned int>(std::strtoul(historyLimit, nullptr, 10));
+  }
+
+  const char *memoryBudget = common::getEnv("GAZEBO_UNDO_MEMORY_BUDGET");
+  if (memoryBudget)
+  {
+    this->dataPtr->memoryBudget =
+        static_cast<size_t>(std::strtoull(memoryBudget, nullptr, 10));
+  }
 }
 
 /////////////////////////////////////////////////
@@ -147,8 +330,11 @@ UserCmdManager::~UserCmdManager()
     this->dataPtr->node.reset();
   }
 
-  this->dataPtr->undoCmds.clear();
-  this->dataPtr->redoCmds.clear();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->undoCmds.clear();
+    this->dataPtr->redoCmds.clear();
+  }
 
   delete this->dataPtr;
   this->dataPtr = NULL;
@@ -160,9 +346,20 @@ void UserCmdManager::OnUserCmdMsg(ConstUserCmdPtr &_msg)
   // Generate unique id
   unsigned int id = this->dataPtr->idCounter++;
 
-  // Create command
-  UserCmdPtr cmd(new UserCmd(id, this->dataPtr->world, _msg->description(),
-      _msg->type()));
+  // Create command. World control, such as a reset, affects all the
+  // entities, while the other commands only record the entities they
+  // change.
+  UserCmdPtr cmd;
+  if (_msg->type() == msgs::UserCmd::WORLD_CONTROL)
+  {
+    cmd.reset(new UserCmd(id, this->dataPtr->world, _msg->description(),
+        _msg->type()));
+  }
+  else
+  {
+    cmd.reset(new UserCmd(id, this->dataPtr->world, _msg->description(),
+        _msg->type(), affectedEntities(*_msg)));
+  }
 
   // Forward message after we've saved the current state
   switch (_msg->type())
@@ -220,12 +417,17 @@ void UserCmdManager::OnUserCmdMsg(ConstUserCmdPtr &_msg)
     }
   }
 
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
   // Add it to undo list
   this->dataPtr->undoCmds.push_back(cmd);
 
   // Clear redo list
   this->dataPtr->redoCmds.clear();
 
+  // Drop the oldest commands beyond the limits
+  this->TrimHistory();
+
   // Publish stats
   this->PublishCurrentStats();
 }
@@ -233,6 +435,8 @@ void UserCmdManager::OnUserCmdMsg(ConstUserCmdPtr &_msg)
 /////////////////////////////////////////////////
 void UserCmdManager::OnUndoRedoMsg(ConstUndoRedoPtr &_msg)
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
   // Undo
   if (_msg->undo())
   {
@@ -328,9 +532,92 @@ void UserCmdManager::OnUndoRedoMsg(ConstUndoRedoPtr &_msg)
     }
   }
 
+  // Recording the states for redo may exceed the memory budget
+  this->TrimHistory();
+
   this->PublishCurrentStats();
 }
 
+/////////////////////////////////////////////////
+void UserCmdManager::SetHistoryLimit(const unsigned int _limit)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->historyLimit = _limit;
+  this->TrimHistory();
+}
+
+/////////////////////////////////////////////////
+unsigned int UserCmdManager::HistoryLimit() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->historyLimit;
+}
+
+/////////////////////////////////////////////////
+void UserCmdManager::SetMemoryBudget(const size_t _bytes)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->memoryBudget = _bytes;
+  this->TrimHistory();
+}
+
+/////////////////////////////////////////////////
+size_t UserCmdManager::MemoryBudget() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->memoryBudget;
+}
+
+/////////////////////////////////////////////////
+size_t UserCmdManager::MemoryUsage() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return commandsSize(this->dataPtr->undoCmds) +
+      commandsSize(this->dataPtr->redoCmds);
+}
+
+/////////////////////////////////////////////////
+unsigned int UserCmdManager::UndoCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->undoCmds.size();
+}
+
+/////////////////////////////////////////////////
+unsigned int UserCmdManager::RedoCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->redoCmds.size();
+}
+
+/////////////////////////////////////////////////
+void UserCmdManager::TrimHistory()
+{
+  auto &undoCmds = this->dataPtr->undoCmds;
+  auto &redoCmds = this->dataPtr->redoCmds;
+
+  // The oldest command is the first one to undo, then the last one to redo
+  auto dropOldest = [&undoCmds, &redoCmds]()
+  {
+    std::vector<UserCmdPtr> &cmds = undoCmds.empty() ? redoCmds : undoCmds;
+    const size_t size = cmds.front()->MemorySize();
+    cmds.erase(cmds.begin());
+    return size;
+  };
+
+  const unsigned int limit = this->dataPtr->historyLimit;
+  while (limit > 0 && undoCmds.size() + redoCmds.size() > limit)
+    dropOldest();
+
+  const size_t budget = this->dataPtr->memoryBudget;
+  if (budget == 0)
+    return;
+
+  size_t usage = commandsSize(undoCmds) + commandsSize(redoCmds);
+  while (usage > budget && undoCmds.size() + redoCmds.size() > 1)
+    usage -= std::min(usage, dropOldest());
+}
+
 /////////////////////////////////////////////////
 void UserCmdManager::PublishCurrentStats()
 {
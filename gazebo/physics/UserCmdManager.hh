@@ -17,7 +17,9 @@
 #ifndef GAZEBO_PHYSICS_USERCMDMANAGER_HH_
 #define GAZEBO_PHYSICS_USERCMDMANAGER_HH_
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 #include "gazebo/transport/TransportTypes.hh"
 
@@ -45,6 +47,22 @@ namespace gazebo
                       const std::string &_description,
                       const msgs::UserCmd::Type &_type);
 
+      /// \brief Constructor for a command which only affects some
+      /// entities. Only their states are recorded, together with the time
+      /// of the world, and only they are restored by Undo and Redo.
+      /// \param[in] _id Unique ID for this command
+      /// \param[in] _world Pointer to the world
+      /// \param[in] _description Description for the command, such as
+      /// "Rotate box", "Delete sphere", etc.
+      /// \param[in] _type Type of command, such as MOVING, DELETING, etc.
+      /// \param[in] _entities Names of the top level models and lights
+      /// affected by the command.
+      public: UserCmd(const unsigned int _id,
+                      physics::WorldPtr _world,
+                      const std::string &_description,
+                      const msgs::UserCmd::Type &_type,
+                      const std::vector<std::string> &_entities);
+
       /// \brief Destructor
       public: virtual ~UserCmd();
 
@@ -66,6 +84,20 @@ namespace gazebo
       /// \return Command type
       public: msgs::UserCmd::Type Type() const;
 
+      /// \brief Get whether the command records the whole world, rather
+      /// than only some entities.
+      /// \return True if the states of all the entities are recorded.
+      public: bool WholeWorld() const;
+
+      /// \brief Get the entities affected by the command.
+      /// \return Names of the models and lights, empty for a command
+      /// recording the whole world.
+      public: const std::vector<std::string> &Entities() const;
+
+      /// \brief Get an estimate of the memory used by the recorded states.
+      /// \return Number of bytes.
+      public: size_t MemorySize() const;
+
       /// \internal
       /// \brief Pointer to private data.
       protected: UserCmdPrivate *dataPtr;
@@ -83,6 +115,37 @@ namespace gazebo
       /// \brief Destructor.
       public: virtual ~UserCmdManager();
 
+      /// \brief Set the maximum number of commands kept in the undo and
+      /// redo history. The oldest commands are dropped first.
+      /// \param[in] _limit Maximum number of commands, 0 for no limit.
+      public: void SetHistoryLimit(const unsigned int _limit);
+
+      /// \brief Get the maximum number of commands kept in the history.
+      /// \return Maximum number of commands, 0 for no limit.
+      public: unsigned int HistoryLimit() const;
+
+      /// \brief Set the memory which the recorded states of the history may
+      /// use. The oldest commands are dropped until the history fits, but
+      /// the most recent command is always kept.
+      /// \param[in] _bytes Memory budget in bytes, 0 for no budget.
+      public: void SetMemoryBudget(const size_t _bytes);
+
+      /// \brief Get the memory budget of the history.
+      /// \return Memory budget in bytes, 0 for no budget.
+      public: size_t MemoryBudget() const;
+
+      /// \brief Get an estimate of the memory used by the history.
+      /// \return Number of bytes.
+      public: size_t MemoryUsage() const;
+
+      /// \brief Get the number of commands which can be undone.
+      /// \return Number of commands.
+      public: unsigned int UndoCount() const;
+
+      /// \brief Get the number of commands which can be redone.
+      /// \return Number of commands.
+      public: unsigned int RedoCount() const;
+
       /// \brief Callback when a UserCmd message is received, notifying that
       /// a new command has been executed by a user.
       /// \param[in] _msg Incoming message
@@ -96,6 +159,10 @@ namespace gazebo
       /// \brief Publish a message about current user command statistics.
       private: void PublishCurrentStats();
 
+      /// \brief Drop the oldest commands until the history fits its limit
+      /// and memory budget. The mutex must be locked.
+      private: void TrimHistory();
+
       /// \internal
       /// \brief Pointer to private data.
       private: UserCmdManagerPrivate *dataPtr;
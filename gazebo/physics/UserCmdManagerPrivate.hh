@@ -17,6 +17,8 @@
 #ifndef _GAZEBO_USER_CMD_MANAGER_PRIVATE_HH_
 #define _GAZEBO_USER_CMD_MANAGER_PRIVATE_HH_
 
+#include <cstddef>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <sdf/sdf.hh>
@@ -38,13 +40,21 @@ namespace gazebo
       /// \brief Pointer to the world.
       public: WorldPtr world;
 
-      /// \brief Whole world state the moment the user command was executed.
+      /// \brief World state the moment the user command was executed. It
+      /// only holds the affected entities, unless wholeWorld is true.
       public: WorldState startState;
 
-      /// \brief Whole world state for the most recent time the user has
-      /// triggered undo for this command.
+      /// \brief World state for the most recent time the user has
+      /// triggered undo for this command. It only holds the affected
+      /// entities, unless wholeWorld is true.
       public: WorldState endState;
 
+      /// \brief True if the states of all the entities are recorded.
+      public: bool wholeWorld = true;
+
+      /// \brief Names of the models and lights affected by the command.
+      public: std::vector<std::string> entities;
+
       /// \brief Unique ID identifying this command in the server.
       public: unsigned int id;
 
@@ -93,6 +103,16 @@ namespace gazebo
 
       /// \brief List of commands which can be redone.
       public: std::vector<UserCmdPtr> redoCmds;
+
+      /// \brief Maximum number of commands in both lists, 0 for no limit.
+      public: unsigned int historyLimit = 100;
+
+      /// \brief Memory budget of the recorded states in bytes, 0 for no
+      /// budget.
+      public: size_t memoryBudget = 0;
+
+      /// \brief Protects the command lists and the limits.
+      public: mutable std::mutex mutex;
     };
   }
 }
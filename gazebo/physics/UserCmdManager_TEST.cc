@@ -15,6 +15,9 @@
  *
 */
 
+#include <string>
+#include <vector>
+
 #include <sdf/sdf.hh>
 
 #include "gazebo/test/ServerFixture.hh"
@@ -61,6 +64,116 @@ TEST_F(UserCmdManagerTest, CreateCmd)
   manager = NULL;
 }
 
+/////////////////////////////////////////////////
+TEST_F(UserCmdManagerTest, EntityCmd)
+{
+  this->Load("worlds/shapes.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr box = world->ModelByName("box");
+  physics::ModelPtr sphere = world->ModelByName("sphere");
+  ASSERT_TRUE(box != NULL);
+  ASSERT_TRUE(sphere != NULL);
+  const ignition::math::Pose3d boxPose = box->WorldPose();
+  const ignition::math::Pose3d spherePose = sphere->WorldPose();
+
+  // A command moving the box only records the box
+  std::vector<std::string> entities = {"box"};
+  physics::UserCmd cmd(0, world, "Move box", msgs::UserCmd::MOVING,
+      entities);
+  EXPECT_FALSE(cmd.WholeWorld());
+  EXPECT_EQ(entities, cmd.Entities());
+
+  physics::UserCmd worldCmd(1, world, "Reset", msgs::UserCmd::WORLD_CONTROL);
+  EXPECT_TRUE(worldCmd.WholeWorld());
+  EXPECT_TRUE(worldCmd.Entities().empty());
+  EXPECT_LT(cmd.MemorySize(), worldCmd.MemorySize());
+
+  const ignition::math::Pose3d newBoxPose(1, 2, 3, 0, 0, 0);
+  const ignition::math::Pose3d newSpherePose(-1, -2, 3, 0, 0, 0);
+  box->SetWorldPose(newBoxPose);
+  sphere->SetWorldPose(newSpherePose);
+
+  // Undo only restores the box
+  cmd.Undo();
+  EXPECT_EQ(boxPose, box->WorldPose());
+  EXPECT_EQ(newSpherePose, sphere->WorldPose());
+
+  cmd.Redo();
+  EXPECT_EQ(newBoxPose, box->WorldPose());
+  EXPECT_EQ(newSpherePose, sphere->WorldPose());
+
+  // Undo of the world command restores everything
+  worldCmd.Undo();
+  EXPECT_EQ(boxPose, box->WorldPose());
+  EXPECT_EQ(spherePose, sphere->WorldPose());
+}
+
+/////////////////////////////////////////////////
+TEST_F(UserCmdManagerTest, HistoryLimits)
+{
+  this->Load("worlds/shapes.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::UserCmdManager manager(world);
+  manager.SetHistoryLimit(0);
+  EXPECT_EQ(0u, manager.HistoryLimit());
+  EXPECT_EQ(0u, manager.MemoryBudget());
+  EXPECT_EQ(0u, manager.MemoryUsage());
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::PublisherPtr pub =
+      node->Advertise<msgs::UserCmd>("~/user_cmd");
+
+  auto publish = [&pub](const std::string &_model)
+  {
+    msgs::UserCmd msg;
+    msg.set_description("Move " + _model);
+    msg.set_type(msgs::UserCmd::MOVING);
+    msgs::Model *modelMsg = msg.add_model();
+    modelMsg->set_name(_model);
+    msgs::Set(modelMsg->mutable_pose(),
+        ignition::math::Pose3d(0, 0, 5, 0, 0, 0));
+    pub->Publish(msg);
+  };
+
+  // Wait for each command to be recorded
+  unsigned int expected = 0;
+  for (const auto &model : {"box", "sphere", "cylinder"})
+  {
+    publish(model);
+    ++expected;
+    for (int i = 0; i < 100 && manager.UndoCount() < expected; ++i)
+      common::Time::MSleep(10);
+    EXPECT_EQ(expected, manager.UndoCount());
+  }
+  EXPECT_GT(manager.MemoryUsage(), 0u);
+
+  // Lowering the limit drops the oldest commands
+  manager.SetHistoryLimit(2);
+  EXPECT_EQ(2u, manager.HistoryLimit());
+  EXPECT_EQ(2u, manager.UndoCount());
+  EXPECT_EQ(0u, manager.RedoCount());
+
+  // A tiny budget keeps the most recent command only
+  manager.SetMemoryBudget(1);
+  EXPECT_EQ(1u, manager.MemoryBudget());
+  EXPECT_EQ(1u, manager.UndoCount());
+
+  // Without a budget the history grows again
+  manager.SetMemoryBudget(0);
+  publish("box");
+  for (int i = 0; i < 100 && manager.UndoCount() < 2; ++i)
+    common::Time::MSleep(10);
+  EXPECT_EQ(2u, manager.UndoCount());
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
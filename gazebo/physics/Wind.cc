@@ -16,6 +16,9 @@
 */
 
 #include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <boost/lexical_cast.hpp>
 #include <sdf/sdf.hh>
 
@@ -27,6 +30,7 @@
 #include "gazebo/physics/Entity.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/Wind.hh"
+#include "gazebo/physics/WindField.hh"
 #include "gazebo/physics/World.hh"
 
 namespace gazebo
@@ -57,6 +61,33 @@ namespace gazebo
       public: std::function< ignition::math::Vector3d (
                   const Wind *, const Entity *)> linearVelFunc;
 
+      /// \brief True while linearVelFunc is Wind::LinearVelDefault.
+      public: bool defaultFunc = false;
+
+      /// \brief Spatially varying wind, null for a uniform wind.
+      public: WindFieldPtr field;
+
+      /// \brief Protects the field, the entities and the batch.
+      public: std::mutex mutex;
+
+      /// \brief Entities registered with AddEntity.
+      public: std::vector<const Entity *> entities;
+
+      /// \brief Index of each registered entity in entities.
+      public: std::unordered_map<const Entity *, size_t> entityIndex;
+
+      /// \brief Locations of the entities for the batch.
+      public: std::vector<ignition::math::Vector3d> positions;
+
+      /// \brief Wind velocity at each entity, sampled in one batch.
+      public: std::vector<ignition::math::Vector3d> velocities;
+
+      /// \brief World iteration at which velocities were sampled.
+      public: uint32_t batchIteration = 0;
+
+      /// \brief False when velocities must be sampled again.
+      public: bool batchValid = false;
+
       // Transport is declared last.
       /// \brief Node for communication.
       public: transport::NodePtr node;
@@ -95,6 +126,7 @@ Wind::Wind(World &_world, sdf::ElementPtr _sdf)
 
   this->SetLinearVelFunc(std::bind(&Wind::LinearVelDefault, this,
         std::placeholders::_1, std::placeholders::_2));
+  this->dataPtr->defaultFunc = true;
 }
 
 //////////////////////////////////////////////////
@@ -109,17 +141,121 @@ Wind::~Wind()
 
 //////////////////////////////////////////////////
 ignition::math::Vector3d Wind::LinearVelDefault(
-    const Wind *_wind, const Entity */*_entity*/)
+    const Wind *_wind, const Entity *_entity)
 {
+  WindFieldPtr field = _wind->Field();
+  if (field && _entity)
+  {
+    return field->Velocity(_entity->WorldPose().Pos(),
+        this->dataPtr->world.SimTime().Double());
+  }
   return _wind->LinearVel();
 }
 
 //////////////////////////////////////////////////
 ignition::math::Vector3d Wind::WorldLinearVel(const Entity *_entity) const
 {
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->entityIndex.find(_entity);
+    if (this->dataPtr->field && this->dataPtr->defaultFunc &&
+        iter != this->dataPtr->entityIndex.end())
+    {
+      // All the entities are sampled at once, when the first of them is
+      // queried in an iteration.
+      const uint32_t iteration = this->dataPtr->world.Iterations();
+      if (!this->dataPtr->batchValid ||
+          this->dataPtr->batchIteration != iteration)
+      {
+        auto &positions = this->dataPtr->positions;
+        positions.resize(this->dataPtr->entities.size());
+        for (size_t i = 0; i < positions.size(); ++i)
+          positions[i] = this->dataPtr->entities[i]->WorldPose().Pos();
+
+        this->dataPtr->field->Velocities(positions,
+            this->dataPtr->world.SimTime().Double(),
+            this->dataPtr->velocities);
+        this->dataPtr->batchIteration = iteration;
+        this->dataPtr->batchValid = true;
+      }
+      return this->dataPtr->velocities[iter->second];
+    }
+  }
+
   return this->dataPtr->linearVelFunc(this, _entity);
 }
 
+//////////////////////////////////////////////////
+void Wind::WorldLinearVels(const std::vector<const Entity *> &_entities,
+    std::vector<ignition::math::Vector3d> &_velocities) const
+{
+  WindFieldPtr field;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->defaultFunc)
+      field = this->dataPtr->field;
+  }
+
+  if (field)
+  {
+    std::vector<ignition::math::Vector3d> positions(_entities.size());
+    for (size_t i = 0; i < _entities.size(); ++i)
+      positions[i] = _entities[i]->WorldPose().Pos();
+    field->Velocities(positions, this->dataPtr->world.SimTime().Double(),
+        _velocities);
+    return;
+  }
+
+  _velocities.resize(_entities.size());
+  for (size_t i = 0; i < _entities.size(); ++i)
+    _velocities[i] = this->dataPtr->linearVelFunc(this, _entities[i]);
+}
+
+//////////////////////////////////////////////////
+void Wind::SetField(const WindFieldPtr &_field)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->field = _field;
+  this->dataPtr->batchValid = false;
+}
+
+//////////////////////////////////////////////////
+WindFieldPtr Wind::Field() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->field;
+}
+
+//////////////////////////////////////////////////
+void Wind::AddEntity(const Entity *_entity)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!_entity || this->dataPtr->entityIndex.count(_entity))
+    return;
+
+  this->dataPtr->entityIndex[_entity] = this->dataPtr->entities.size();
+  this->dataPtr->entities.push_back(_entity);
+  this->dataPtr->batchValid = false;
+}
+
+//////////////////////////////////////////////////
+void Wind::RemoveEntity(const Entity *_entity)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->entityIndex.find(_entity);
+  if (iter == this->dataPtr->entityIndex.end())
+    return;
+
+  // Move the last entity in the slot of the removed one
+  const size_t index = iter->second;
+  const Entity *last = this->dataPtr->entities.back();
+  this->dataPtr->entities[index] = last;
+  this->dataPtr->entityIndex[last] = index;
+  this->dataPtr->entities.pop_back();
+  this->dataPtr->entityIndex.erase(_entity);
+  this->dataPtr->batchValid = false;
+}
+
 //////////////////////////////////////////////////
 ignition::math::Vector3d Wind::RelativeLinearVel(const Entity *_entity) const
 {
@@ -239,4 +375,8 @@ void Wind::SetLinearVelFunc(std::function< ignition::math::Vector3d (
     const Wind *, const Entity *_entity) > _linearVelFunc)
 {
   this->dataPtr->linearVelFunc = _linearVelFunc;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->defaultFunc = false;
+  this->dataPtr->batchValid = false;
 }
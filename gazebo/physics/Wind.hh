@@ -20,6 +20,7 @@
 #include <string>
 #include <functional>
 #include <memory>
+#include <vector>
 #include <boost/any.hpp>
 
 #include "gazebo/msgs/msgs.hh"
@@ -114,7 +115,43 @@ namespace gazebo
       public: void SetLinearVelFunc(std::function< ignition::math::Vector3d (
           const Wind *_wind, const Entity *_entity) > _linearVelFunc);
 
-      /// \brief Get the global wind velocity, ignoring the entity.
+      /// \brief Set a spatially varying wind field. While set, the default
+      /// wind velocity at an entity is sampled from the field at the entity
+      /// location and simulation time, instead of the global velocity. A
+      /// function set with SetLinearVelFunc takes precedence.
+      /// \param[in] _field The field, null to go back to the global
+      /// velocity.
+      public: void SetField(const WindFieldPtr &_field);
+
+      /// \brief Get the wind field.
+      /// \return The field set with SetField, may be null.
+      public: WindFieldPtr Field() const;
+
+      /// \brief Register an entity whose wind velocity is read every step,
+      /// such as a link with wind enabled. With a wind field, the
+      /// velocities of all registered entities are sampled in one batch the
+      /// first time one of them is queried in a world iteration.
+      /// \param[in] _entity The entity.
+      /// \sa WorldLinearVel
+      public: void AddEntity(const Entity *_entity);
+
+      /// \brief Unregister an entity added with AddEntity.
+      /// \param[in] _entity The entity.
+      public: void RemoveEntity(const Entity *_entity);
+
+      /// \brief Get the wind velocity at the locations of many entities.
+      /// With a wind field and the default velocity function, the field is
+      /// sampled in one batch.
+      /// \param[in] _entities Entities at which locations the wind is
+      /// applied.
+      /// \param[out] _velocities Linear velocity of the wind at each
+      /// entity, in the world frame.
+      public: void WorldLinearVels(
+          const std::vector<const Entity *> &_entities,
+          std::vector<ignition::math::Vector3d> &_velocities) const;
+
+      /// \brief Get the global wind velocity, or the velocity of the wind
+      /// field at the entity location if a field is set.
       /// \param[in] _wind Reference to the wind.
       /// \param[in] _entity Pointer to an entity at which location the wind
       /// velocity is to be calculated.
@@ -0,0 +1,529 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/WindField.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the WindField class
+    class WindFieldPrivate
+    {
+      /// \brief Release the mapped file and the owned samples.
+      public: void Unload();
+
+      /// \brief Check the grid and precompute the lookup constants.
+      /// \param[in] _nx Number of samples along x.
+      /// \param[in] _ny Number of samples along y.
+      /// \param[in] _nz Number of samples along z.
+      /// \param[in] _nt Number of frames.
+      /// \param[in] _origin Location of the first sample.
+      /// \param[in] _spacing Distance between samples.
+      /// \param[in] _timeStep Time between frames.
+      /// \return True if the grid is valid.
+      public: bool SetGrid(const uint32_t _nx, const uint32_t _ny,
+                  const uint32_t _nz, const uint32_t _nt,
+                  const ignition::math::Vector3d &_origin,
+                  const ignition::math::Vector3d &_spacing,
+                  const double _timeStep);
+
+      /// \brief Get the frames around a time.
+      /// \param[in] _time Time.
+      /// \param[out] _frame0 Samples of the frame before the time.
+      /// \param[out] _frame1 Samples of the frame after the time.
+      /// \param[out] _weight Weight of the second frame.
+      public: void Frames(const double _time, const float *&_frame0,
+                  const float *&_frame1, float &_weight) const;
+
+      /// \brief Interpolate the velocities of a run of locations.
+      /// \param[in] _positions Locations.
+      /// \param[in] _count Number of locations.
+      /// \param[in] _time Time.
+      /// \param[out] _velocities Velocity of each location.
+      public: void Evaluate(const ignition::math::Vector3d *_positions,
+                  const size_t _count, const double _time,
+                  ignition::math::Vector3d *_velocities) const;
+
+      /// \brief Number of samples along each axis.
+      public: uint32_t size[3] = {0, 0, 0};
+
+      /// \brief Number of frames.
+      public: uint32_t frameCount = 0;
+
+      /// \brief Location of the first sample.
+      public: double origin[3] = {0, 0, 0};
+
+      /// \brief Distance between samples.
+      public: double spacing[3] = {1, 1, 1};
+
+      /// \brief Inverse of the distance between samples.
+      public: double invSpacing[3] = {1, 1, 1};
+
+      /// \brief Largest grid coordinate along each axis.
+      public: float maxCoord[3] = {0, 0, 0};
+
+      /// \brief Largest index of the first sample of a cell along each axis.
+      public: uint32_t maxCell[3] = {0, 0, 0};
+
+      /// \brief Offset in samples to the next sample along each axis, 0
+      /// along the axes with a single sample.
+      public: uint32_t stride[3] = {0, 0, 0};
+
+      /// \brief Number of samples in a frame.
+      public: size_t frameSize = 0;
+
+      /// \brief Time between frames.
+      public: double timeStep = 0;
+
+      /// \brief True if the frames repeat.
+      public: bool loop = false;
+
+      /// \brief Velocity triplets of all the frames.
+      public: const float *samples = nullptr;
+
+      /// \brief Samples set with SetData, or read without memory mapping.
+      public: std::vector<float> ownedSamples;
+
+      /// \brief Mapped file, null if the samples are not mapped.
+      public: void *mapped = nullptr;
+
+      /// \brief Size of the mapped file.
+      public: size_t mappedSize = 0;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Magic string at the start of a wind field file.
+static const char kMagic[8] = {'G', 'Z', 'W', 'I', 'N', 'D', '0', '1'};
+
+/// \brief Size of the header of a wind field file.
+static const size_t kHeaderSize = 80;
+
+/// \brief Number of locations whose cells are looked up together.
+static const size_t kBlockSize = 64;
+
+//////////////////////////////////////////////////
+/// \brief Trilinear interpolation in a cell of a frame.
+/// \param[in] _frame Samples of the frame.
+/// \param[in] _cell Index of the first sample of the cell.
+/// \param[in] _stride Offset to the next sample along each axis.
+/// \param[in] _fx Location in the cell along x, in [0, 1].
+/// \param[in] _fy Location in the cell along y, in [0, 1].
+/// \param[in] _fz Location in the cell along z, in [0, 1].
+/// \param[out] _out Interpolated velocity.
+static inline void Trilinear(const float *_frame, const uint32_t _cell,
+    const uint32_t *_stride, const float _fx, const float _fy,
+    const float _fz, float *_out)
+{
+  const float *c000 = _frame + 3 * static_cast<size_t>(_cell);
+  const float *c100 = c000 + 3 * _stride[0];
+  const float *c010 = c000 + 3 * _stride[1];
+  const float *c110 = c010 + 3 * _stride[0];
+  const float *c001 = c000 + 3 * _stride[2];
+  const float *c101 = c001 + 3 * _stride[0];
+  const float *c011 = c001 + 3 * _stride[1];
+  const float *c111 = c011 + 3 * _stride[0];
+
+  for (int c = 0; c < 3; ++c)
+  {
+    const float x00 = c000[c] + _fx * (c100[c] - c000[c]);
+    const float x10 = c010[c] + _fx * (c110[c] - c010[c]);
+    const float x01 = c001[c] + _fx * (c101[c] - c001[c]);
+    const float x11 = c011[c] + _fx * (c111[c] - c011[c]);
+    const float y0 = x00 + _fy * (x10 - x00);
+    const float y1 = x01 + _fy * (x11 - x01);
+    _out[c] = y0 + _fz * (y1 - y0);
+  }
+}
+
+//////////////////////////////////////////////////
+void WindFieldPrivate::Unload()
+{
+#ifndef _WIN32
+  if (this->mapped)
+    munmap(this->mapped, this->mappedSize);
+#endif
+  this->mapped = nullptr;
+  this->mappedSize = 0;
+  this->samples = nullptr;
+  this->ownedSamples.clear();
+  this->ownedSamples.shrink_to_fit();
+  this->frameCount = 0;
+}
+
+//////////////////////////////////////////////////
+bool WindFieldPrivate::SetGrid(const uint32_t _nx, const uint32_t _ny,
+    const uint32_t _nz, const uint32_t _nt,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_spacing, const double _timeStep)
+{
+  if (_nx == 0 || _ny == 0 || _nz == 0 || _nt == 0)
+  {
+    gzerr << "Wind field has no samples\n";
+    return false;
+  }
+
+  if (!(_spacing.X() > 0 && _spacing.Y() > 0 && _spacing.Z() > 0))
+  {
+    gzerr << "Wind field spacing [" << _spacing << "] must be positive\n";
+    return false;
+  }
+
+  if (_nt > 1 && !(_timeStep > 0))
+  {
+    gzerr << "Wind field time step [" << _timeStep
+          << "] must be positive\n";
+    return false;
+  }
+
+  const uint32_t sizes[3] = {_nx, _ny, _nz};
+  const uint32_t strides[3] = {1, _nx, _nx * _ny};
+  for (int i = 0; i < 3; ++i)
+  {
+    this->size[i] = sizes[i];
+    this->origin[i] = _origin[i];
+    this->spacing[i] = _spacing[i];
+    this->invSpacing[i] = 1.0 / _spacing[i];
+    this->maxCoord[i] = static_cast<float>(sizes[i] - 1);
+    this->maxCell[i] = sizes[i] > 1 ? sizes[i] - 2 : 0;
+    this->stride[i] = sizes[i] > 1 ? strides[i] : 0;
+  }
+  this->frameSize = static_cast<size_t>(_nx) * _ny * _nz;
+  this->frameCount = _nt;
+  this->timeStep = _timeStep;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void WindFieldPrivate::Frames(const double _time, const float *&_frame0,
+    const float *&_frame1, float &_weight) const
+{
+  uint32_t t0 = 0;
+  uint32_t t1 = 0;
+  _weight = 0;
+
+  if (this->frameCount > 1)
+  {
+    double t = _time / this->timeStep;
+    if (this->loop)
+    {
+      t = std::fmod(t, static_cast<double>(this->frameCount));
+      if (t < 0)
+        t += this->frameCount;
+      t0 = std::min(static_cast<uint32_t>(t), this->frameCount - 1);
+      t1 = (t0 + 1) % this->frameCount;
+    }
+    else
+    {
+      t = std::min(std::max(t, 0.0), this->frameCount - 1.0);
+      t0 = std::min(static_cast<uint32_t>(t), this->frameCount - 2);
+      t1 = t0 + 1;
+    }
+    _weight = static_cast<float>(t - t0);
+  }
+
+  _frame0 = this->samples + 3 * this->frameSize * t0;
+  _frame1 = this->samples + 3 * this->frameSize * t1;
+}
+
+//////////////////////////////////////////////////
+void WindFieldPrivate::Evaluate(const ignition::math::Vector3d *_positions,
+    const size_t _count, const double _time,
+    ignition::math::Vector3d *_velocities) const
+{
+  if (!this->samples)
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _velocities[i] = ignition::math::Vector3d::Zero;
+    return;
+  }
+
+  const float *frame0;
+  const float *frame1;
+  float weight;
+  this->Frames(_time, frame0, frame1, weight);
+
+  // Cell and location in the cell of each position of a block, as
+  // structures of arrays so that the loops below vectorize.
+  uint32_t cells[kBlockSize];
+  float fractions[3][kBlockSize];
+
+  for (size_t begin = 0; begin < _count; begin += kBlockSize)
+  {
+    const size_t n = std::min(kBlockSize, _count - begin);
+    const ignition::math::Vector3d *positions = _positions + begin;
+
+    for (size_t i = 0; i < n; ++i)
+      cells[i] = 0;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const double o = this->origin[axis];
+      const double inv = this->invSpacing[axis];
+      const float maxCoord = this->maxCoord[axis];
+      const uint32_t maxCell = this->maxCell[axis];
+      const uint32_t stride = std::max(this->stride[axis], 1u);
+      float *f = fractions[axis];
+
+      // Branch free: clamp to the grid, then split into cell and fraction
+      for (size_t i = 0; i < n; ++i)
+      {
+        const float g = std::min(std::max(
+              static_cast<float>((positions[i][axis] - o) * inv), 0.0f),
+            maxCoord);
+        const uint32_t c = std::min(static_cast<uint32_t>(g), maxCell);
+        f[i] = g - static_cast<float>(c);
+        cells[i] += c * stride;
+      }
+    }
+
+    // Blend the corners of the cells in the two frames
+    for (size_t i = 0; i < n; ++i)
+    {
+      float v0[3];
+      float v1[3];
+      Trilinear(frame0, cells[i], this->stride,
+          fractions[0][i], fractions[1][i], fractions[2][i], v0);
+      Trilinear(frame1, cells[i], this->stride,
+          fractions[0][i], fractions[1][i], fractions[2][i], v1);
+      _velocities[begin + i].Set(
+          v0[0] + weight * (v1[0] - v0[0]),
+          v0[1] + weight * (v1[1] - v0[1]),
+          v0[2] + weight * (v1[2] - v0[2]));
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+WindField::WindField()
+  : dataPtr(new WindFieldPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+WindField::~WindField()
+{
+  this->dataPtr->Unload();
+}
+
+//////////////////////////////////////////////////
+bool WindField::Load(const std::string &_filename)
+{
+  this->dataPtr->Unload();
+
+  const unsigned char *bytes = nullptr;
+  size_t fileSize = 0;
+
+#ifndef _WIN32
+  int fd = open(_filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    gzerr << "Unable to open wind field [" << _filename << "]\n";
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(kHeaderSize))
+  {
+    gzerr << "Wind field [" << _filename << "] is too small\n";
+    close(fd);
+    return false;
+  }
+  fileSize = static_cast<size_t>(st.st_size);
+
+  void *mapped = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED)
+  {
+    gzerr << "Unable to map wind field [" << _filename << "]\n";
+    return false;
+  }
+  this->dataPtr->mapped = mapped;
+  this->dataPtr->mappedSize = fileSize;
+  bytes = static_cast<const unsigned char *>(mapped);
+#else
+  std::ifstream file(_filename, std::ios::binary | std::ios::ate);
+  if (!file)
+  {
+    gzerr << "Unable to open wind field [" << _filename << "]\n";
+    return false;
+  }
+  fileSize = static_cast<size_t>(file.tellg());
+  if (fileSize < kHeaderSize)
+  {
+    gzerr << "Wind field [" << _filename << "] is too small\n";
+    return false;
+  }
+  this->dataPtr->ownedSamples.resize(
+      (fileSize + sizeof(float) - 1) / sizeof(float));
+  file.seekg(0);
+  file.read(reinterpret_cast<char *>(this->dataPtr->ownedSamples.data()),
+      fileSize);
+  bytes = reinterpret_cast<const unsigned char *>(
+      this->dataPtr->ownedSamples.data());
+#endif
+
+  if (std::memcmp(bytes, kMagic, sizeof(kMagic)) != 0)
+  {
+    gzerr << "[" << _filename << "] is not a wind field\n";
+    this->dataPtr->Unload();
+    return false;
+  }
+
+  uint32_t counts[4];
+  double values[7];
+  std::memcpy(counts, bytes + 8, sizeof(counts));
+  std::memcpy(values, bytes + 24, sizeof(values));
+
+  if (!this->dataPtr->SetGrid(counts[0], counts[1], counts[2], counts[3],
+        ignition::math::Vector3d(values[0], values[1], values[2]),
+        ignition::math::Vector3d(values[3], values[4], values[5]),
+        values[6]))
+  {
+    gzerr << "Invalid wind field [" << _filename << "]\n";
+    this->dataPtr->Unload();
+    return false;
+  }
+
+  const size_t expected = kHeaderSize +
+    3 * sizeof(float) * this->dataPtr->frameSize * counts[3];
+  if (fileSize < expected)
+  {
+    gzerr << "Wind field [" << _filename << "] holds " << fileSize
+          << " bytes, expected " << expected << "\n";
+    this->dataPtr->Unload();
+    return false;
+  }
+
+  this->dataPtr->samples =
+    reinterpret_cast<const float *>(bytes + kHeaderSize);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool WindField::SetData(const unsigned int _nx, const unsigned int _ny,
+    const unsigned int _nz, const unsigned int _nt,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_spacing, const double _timeStep,
+    const std::vector<float> &_velocities)
+{
+  this->dataPtr->Unload();
+
+  if (!this->dataPtr->SetGrid(_nx, _ny, _nz, _nt, _origin, _spacing,
+        _timeStep))
+  {
+    this->dataPtr->Unload();
+    return false;
+  }
+
+  if (_velocities.size() != 3 * this->dataPtr->frameSize * _nt)
+  {
+    gzerr << "Wind field has " << _velocities.size() << " values, expected "
+          << 3 * this->dataPtr->frameSize * _nt << "\n";
+    this->dataPtr->Unload();
+    return false;
+  }
+
+  this->dataPtr->ownedSamples = _velocities;
+  this->dataPtr->samples = this->dataPtr->ownedSamples.data();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool WindField::Valid() const
+{
+  return this->dataPtr->samples != nullptr;
+}
+
+//////////////////////////////////////////////////
+unsigned int WindField::FrameCount() const
+{
+  return this->Valid() ? this->dataPtr->frameCount : 0u;
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d WindField::Min() const
+{
+  return ignition::math::Vector3d(this->dataPtr->origin[0],
+      this->dataPtr->origin[1], this->dataPtr->origin[2]);
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d WindField::Max() const
+{
+  ignition::math::Vector3d result;
+  for (int i = 0; i < 3; ++i)
+  {
+    result[i] = this->dataPtr->origin[i] + this->dataPtr->spacing[i] *
+      (this->dataPtr->size[i] > 0 ? this->dataPtr->size[i] - 1 : 0);
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+void WindField::SetLoop(const bool _loop)
+{
+  this->dataPtr->loop = _loop;
+}
+
+//////////////////////////////////////////////////
+bool WindField::Loop() const
+{
+  return this->dataPtr->loop;
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d WindField::Velocity(
+    const ignition::math::Vector3d &_pos, const double _time) const
+{
+  ignition::math::Vector3d result;
+  this->dataPtr->Evaluate(&_pos, 1, _time, &result);
+  return result;
+}
+
+//////////////////////////////////////////////////
+void WindField::Velocities(
+    const std::vector<ignition::math::Vector3d> &_positions,
+    const double _time,
+    std::vector<ignition::math::Vector3d> &_velocities) const
+{
+  _velocities.resize(_positions.size());
+  if (!_positions.empty())
+  {
+    this->dataPtr->Evaluate(_positions.data(), _positions.size(), _time,
+        _velocities.data());
+  }
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WINDFIELD_HH_
+#define GAZEBO_PHYSICS_WINDFIELD_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class WindFieldPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class WindField WindField.hh physics/physics.hh
+    /// \brief Wind velocities sampled on a regular grid, for instance
+    /// exported from a CFD solver.
+    ///
+    /// The grid has nx * ny * nz samples in space and nt frames in time.
+    /// The velocity at a location is trilinearly interpolated between the
+    /// samples of the enclosing cell, and linearly between the two frames
+    /// around the time. Locations outside of the grid get the velocity of
+    /// the closest point of the grid.
+    ///
+    /// A wind field file starts with an 80 byte little endian header:
+    ///   \li char[8] magic "GZWIND01"
+    ///   \li uint32 nx, ny, nz, nt
+    ///   \li float64 origin x, y, z: location of the first sample
+    ///   \li float64 spacing x, y, z: distance between samples
+    ///   \li float64 time step between frames
+    ///
+    /// followed by nx * ny * nz * nt float32 triplets (vx, vy, vz), with x
+    /// varying fastest, then y, z and t. The file is memory mapped, so
+    /// large fields are paged in on demand and shared between processes.
+    /// \sa Wind::SetField
+    class GZ_PHYSICS_VISIBLE WindField
+    {
+      /// \brief Constructor.
+      public: WindField();
+
+      /// \brief Destructor.
+      public: ~WindField();
+
+      /// \brief Load a wind field file.
+      /// \param[in] _filename Path to the file.
+      /// \return True if the file is a valid wind field.
+      public: bool Load(const std::string &_filename);
+
+      /// \brief Set the samples of the field from memory.
+      /// \param[in] _nx Number of samples along x.
+      /// \param[in] _ny Number of samples along y.
+      /// \param[in] _nz Number of samples along z.
+      /// \param[in] _nt Number of frames.
+      /// \param[in] _origin Location of the first sample.
+      /// \param[in] _spacing Distance between samples along each axis.
+      /// \param[in] _timeStep Time between frames.
+      /// \param[in] _velocities nx * ny * nz * nt velocity triplets, in the
+      /// order of the file.
+      /// \return True if the sizes and the spacing are valid.
+      public: bool SetData(const unsigned int _nx, const unsigned int _ny,
+                  const unsigned int _nz, const unsigned int _nt,
+                  const ignition::math::Vector3d &_origin,
+                  const ignition::math::Vector3d &_spacing,
+                  const double _timeStep,
+                  const std::vector<float> &_velocities);
+
+      /// \brief Check whether the field holds samples.
+      /// \return True if a file or data was loaded.
+      public: bool Valid() const;
+
+      /// \brief Get the number of frames.
+      /// \return Number of frames, 0 if the field is not valid.
+      public: unsigned int FrameCount() const;
+
+      /// \brief Get the location of the first sample.
+      /// \return Minimum corner of the grid.
+      public: ignition::math::Vector3d Min() const;
+
+      /// \brief Get the location of the last sample.
+      /// \return Maximum corner of the grid.
+      public: ignition::math::Vector3d Max() const;
+
+      /// \brief Set whether the frames repeat once the last one is reached.
+      /// When false, the last frame is held.
+      /// \param[in] _loop True to loop the frames.
+      public: void SetLoop(const bool _loop);
+
+      /// \brief Get whether the frames repeat.
+      /// \return True if the frames loop.
+      public: bool Loop() const;
+
+      /// \brief Get the wind velocity at a location.
+      /// \param[in] _pos Location in the world frame.
+      /// \param[in] _time Time, usually the simulation time.
+      /// \return Interpolated velocity, zero if the field is not valid.
+      public: ignition::math::Vector3d Velocity(
+                  const ignition::math::Vector3d &_pos,
+                  const double _time) const;
+
+      /// \brief Get the wind velocities at many locations at once. This is
+      /// much cheaper than calling Velocity for each location, since the
+      /// frame lookup is shared and the cell lookups run in tight loops.
+      /// \param[in] _positions Locations in the world frame.
+      /// \param[in] _time Time, usually the simulation time.
+      /// \param[out] _velocities Velocity at each location, resized to the
+      /// number of locations.
+      public: void Velocities(
+                  const std::vector<ignition::math::Vector3d> &_positions,
+                  const double _time,
+                  std::vector<ignition::math::Vector3d> &_velocities) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<WindFieldPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
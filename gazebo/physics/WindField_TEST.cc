@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+#include <boost/filesystem.hpp>
+
+#include "gazebo/physics/WindField.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class WindFieldTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Velocity of a field that is linear in space and time.
+/// \param[in] _pos Location.
+/// \param[in] _time Time.
+/// \return Velocity.
+static ignition::math::Vector3d Linear(const ignition::math::Vector3d &_pos,
+    const double _time)
+{
+  return ignition::math::Vector3d(1 + _pos.X() + 2 * _pos.Y(),
+      -_pos.Z() + 3 * _time, 0.5 * _pos.X() - _pos.Y());
+}
+
+/////////////////////////////////////////////////
+/// \brief Sample the linear field on a grid.
+/// \param[in] _nx Number of samples along x.
+/// \param[in] _ny Number of samples along y.
+/// \param[in] _nz Number of samples along z.
+/// \param[in] _nt Number of frames.
+/// \param[in] _origin Location of the first sample.
+/// \param[in] _spacing Distance between samples.
+/// \param[in] _timeStep Time between frames.
+/// \return Velocity triplets.
+static std::vector<float> Sample(const unsigned int _nx,
+    const unsigned int _ny, const unsigned int _nz, const unsigned int _nt,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_spacing, const double _timeStep)
+{
+  std::vector<float> result;
+  for (unsigned int t = 0; t < _nt; ++t)
+  {
+    for (unsigned int z = 0; z < _nz; ++z)
+    {
+      for (unsigned int y = 0; y < _ny; ++y)
+      {
+        for (unsigned int x = 0; x < _nx; ++x)
+        {
+          const ignition::math::Vector3d v = Linear(_origin +
+              ignition::math::Vector3d(x, y, z) * _spacing, t * _timeStep);
+          result.push_back(v.X());
+          result.push_back(v.Y());
+          result.push_back(v.Z());
+        }
+      }
+    }
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+TEST_F(WindFieldTest, Invalid)
+{
+  physics::WindField field;
+  EXPECT_FALSE(field.Valid());
+  EXPECT_EQ(0u, field.FrameCount());
+  EXPECT_EQ(ignition::math::Vector3d::Zero,
+      field.Velocity(ignition::math::Vector3d(1, 2, 3), 0));
+
+  const ignition::math::Vector3d one(1, 1, 1);
+  EXPECT_FALSE(field.SetData(0, 1, 1, 1, one, one, 1, {}));
+  EXPECT_FALSE(field.SetData(1, 1, 1, 1, one, -one, 1, {0, 0, 0}));
+  EXPECT_FALSE(field.SetData(1, 1, 1, 2, one, one, 0, {0, 0, 0, 0, 0, 0}));
+  EXPECT_FALSE(field.SetData(2, 1, 1, 1, one, one, 1, {0, 0, 0}));
+  EXPECT_FALSE(field.Valid());
+
+  EXPECT_FALSE(field.Load("/does/not/exist.gzwind"));
+  EXPECT_FALSE(field.Valid());
+}
+
+/////////////////////////////////////////////////
+TEST_F(WindFieldTest, Interpolation)
+{
+  const ignition::math::Vector3d origin(-2, -1, 0);
+  const ignition::math::Vector3d spacing(0.5, 1, 2);
+  physics::WindField field;
+  ASSERT_TRUE(field.SetData(9, 4, 3, 5, origin, spacing, 0.25,
+        Sample(9, 4, 3, 5, origin, spacing, 0.25)));
+  EXPECT_TRUE(field.Valid());
+  EXPECT_EQ(5u, field.FrameCount());
+  EXPECT_EQ(origin, field.Min());
+  EXPECT_EQ(ignition::math::Vector3d(2, 2, 4), field.Max());
+
+  // The interpolation is exact for a linear field
+  std::vector<ignition::math::Vector3d> positions;
+  for (double x = -2; x <= 2; x += 0.37)
+  {
+    for (double y = -1; y <= 2; y += 0.41)
+    {
+      for (double z = 0; z <= 4; z += 0.73)
+        positions.push_back(ignition::math::Vector3d(x, y, z));
+    }
+  }
+  ASSERT_GT(positions.size(), 64u);
+
+  for (const double time : {0.0, 0.1, 0.6, 1.0})
+  {
+    std::vector<ignition::math::Vector3d> velocities;
+    field.Velocities(positions, time, velocities);
+    ASSERT_EQ(positions.size(), velocities.size());
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+      const ignition::math::Vector3d expected = Linear(positions[i], time);
+      EXPECT_NEAR(expected.X(), velocities[i].X(), 1e-4);
+      EXPECT_NEAR(expected.Y(), velocities[i].Y(), 1e-4);
+      EXPECT_NEAR(expected.Z(), velocities[i].Z(), 1e-4);
+
+      // The batch matches the single lookup
+      EXPECT_EQ(velocities[i], field.Velocity(positions[i], time));
+    }
+  }
+
+  // Outside of the grid and after the last frame, the edges are held
+  EXPECT_EQ(field.Velocity(ignition::math::Vector3d(2, 2, 4), 1.0),
+      field.Velocity(ignition::math::Vector3d(10, 5, 100), 7.0));
+  EXPECT_EQ(field.Velocity(origin, 0),
+      field.Velocity(ignition::math::Vector3d(-10, -5, -3), -1.0));
+
+  // When looping, the last frame blends back into the first one
+  field.SetLoop(true);
+  EXPECT_TRUE(field.Loop());
+  EXPECT_TRUE(field.Velocity(origin, 0.1).Equal(
+      field.Velocity(origin, 1.35), 1e-4));
+  const ignition::math::Vector3d mid = field.Velocity(origin, 1.125);
+  EXPECT_NEAR((Linear(origin, 1.0).Y() + Linear(origin, 0).Y()) / 2,
+      mid.Y(), 1e-4);
+}
+
+/////////////////////////////////////////////////
+TEST_F(WindFieldTest, SingleSample)
+{
+  // Axes with a single sample are constant, a single frame is static
+  physics::WindField field;
+  ASSERT_TRUE(field.SetData(2, 1, 1, 1, ignition::math::Vector3d::Zero,
+        ignition::math::Vector3d::One, 0, {0, 0, 0, 2, 4, 6}));
+  EXPECT_EQ(ignition::math::Vector3d(1, 2, 3),
+      field.Velocity(ignition::math::Vector3d(0.5, 7, -3), 12.0));
+}
+
+/////////////////////////////////////////////////
+TEST_F(WindFieldTest, Load)
+{
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_wind_field_%%%%-%%%%.gzwind");
+
+  const uint32_t counts[4] = {3, 3, 2, 2};
+  const double values[7] = {0, 0, 10, 1, 1, 1, 2};
+  const std::vector<float> samples = Sample(3, 3, 2, 2,
+      ignition::math::Vector3d(0, 0, 10), ignition::math::Vector3d::One, 2);
+  {
+    std::ofstream out(path.string(), std::ios::binary);
+    out.write("GZWIND01", 8);
+    out.write(reinterpret_cast<const char *>(counts), sizeof(counts));
+    out.write(reinterpret_cast<const char *>(values), sizeof(values));
+    out.write(reinterpret_cast<const char *>(samples.data()),
+        samples.size() * sizeof(float));
+  }
+
+  {
+    physics::WindField field;
+    ASSERT_TRUE(field.Load(path.string()));
+    EXPECT_EQ(2u, field.FrameCount());
+    EXPECT_EQ(ignition::math::Vector3d(2, 2, 11), field.Max());
+
+    const ignition::math::Vector3d pos(0.5, 1.25, 10.5);
+    const ignition::math::Vector3d v = field.Velocity(pos, 1.0);
+    EXPECT_NEAR(Linear(pos, 1.0).X(), v.X(), 1e-4);
+    EXPECT_NEAR(Linear(pos, 1.0).Y(), v.Y(), 1e-4);
+    EXPECT_NEAR(Linear(pos, 1.0).Z(), v.Z(), 1e-4);
+  }
+
+  // A truncated file is rejected
+  boost::filesystem::resize_file(path, 80 + 12);
+  {
+    physics::WindField field;
+    EXPECT_FALSE(field.Load(path.string()));
+    EXPECT_FALSE(field.Valid());
+  }
+
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
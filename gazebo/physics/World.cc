@@ -16,19 +16,31 @@
 */
 
 #include <time.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
 
 #include <sdf/sdf.hh>
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <deque>
+#include <functional>
 #include <list>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
 #include <ignition/math/Rand.hh>
 #include <ignition/math/SemanticVersion.hh>
 
@@ -37,9 +49,9 @@
 #include <ignition/msgs/plugin_v.pb.h>
 #include <ignition/msgs/stringmsg.pb.h>
 
-#include "ignition/common/Profiler.hh"
 #include "ignition/common/URI.hh"
 #include "gazebo/common/FuelModelDatabase.hh"
+#include "gazebo/common/TraceCapture.hh"
 
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/TransportIface.hh"
@@ -53,8 +65,12 @@
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MemoryStats.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/PluginStats.hh"
 #include "gazebo/common/SdfFrameSemantics.hh"
+#include "gazebo/common/ThreadRoles.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/URI.hh"
 
@@ -64,6 +80,7 @@
 #include "gazebo/util/Diagnostics.hh"
 #include "gazebo/util/IntrospectionManager.hh"
 #include "gazebo/util/LogRecord.hh"
+#include "gazebo/util/TimingStats.hh"
 
 #include "gazebo/physics/Road.hh"
 #include "gazebo/physics/RayShape.hh"
@@ -81,6 +98,10 @@
 #include "gazebo/physics/Wind.hh"
 #include "gazebo/physics/WorldPrivate.hh"
 #include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
+#include "gazebo/physics/ModelBoxIndex.hh"
+#include "gazebo/physics/TriggerVolumes.hh"
+#include "gazebo/physics/WorldStreaming.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
 
 #include "gazebo/physics/Collision.hh"
@@ -108,6 +129,217 @@ class ModelUpdate_TBB
   private: Model_V *models;
 };
 
+/// \brief Collect the mesh files used by the geometry in an SDF subtree.
+/// Only existing elements are visited, so the SDF is left unchanged.
+/// \param[in] _elem Root of the subtree.
+/// \param[out] _uris Full URIs of the meshes, in the form used by MeshShape.
+static void CollectMeshUris(sdf::ElementPtr _elem,
+    std::vector<std::string> &_uris)
+{
+  if (_elem->GetName() == "mesh")
+  {
+    sdf::ElementPtr uriElem = _elem->FindElement("uri");
+    if (uriElem)
+    {
+      _uris.push_back(common::asFullPath(uriElem->Get<std::string>(),
+          _elem->FilePath()));
+    }
+    return;
+  }
+
+  // Plugin parameters are free form and never describe geometry.
+  if (_elem->GetName() == "plugin")
+    return;
+
+  for (sdf::ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    CollectMeshUris(child, _uris);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Wait for the deadline of the next step, in real time mode. The
+/// thread sleeps on the monotonic clock until shortly before the deadline,
+/// then busy-waits, since waking up from a sleep takes tens of
+/// microseconds even on a PREEMPT_RT kernel. A step that is already late
+/// counts as an overrun, and a step late by more than a period moves the
+/// deadlines, instead of running a burst of steps to catch up.
+/// \param[in] _data World data.
+/// \param[in] _period Update period in seconds.
+static void WaitForDeadline(WorldPrivate &_data, const double _period)
+{
+  const auto period = std::chrono::nanoseconds(
+      static_cast<int64_t>(_period * 1e9));
+  const auto now = std::chrono::steady_clock::now();
+
+  if (_data.deadline == std::chrono::steady_clock::time_point())
+  {
+    _data.deadline = now;
+  }
+  else if (now > _data.deadline)
+  {
+    const auto lateness = now - _data.deadline;
+    ++_data.overruns;
+    _data.maxOverrun = std::max(_data.maxOverrun, common::Time(
+        std::chrono::duration<double>(lateness).count()));
+    if (lateness > period)
+      _data.deadline = now;
+  }
+  else
+  {
+    const auto wake = _data.deadline - _data.spinTime;
+    if (wake > now)
+    {
+#ifdef __linux__
+      // std::chrono::steady_clock is CLOCK_MONOTONIC
+      const int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          wake.time_since_epoch()).count();
+      timespec ts;
+      ts.tv_sec = ns / 1000000000;
+      ts.tv_nsec = ns % 1000000000;
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+          EINTR)
+      {
+      }
+#else
+      std::this_thread::sleep_until(wake);
+#endif
+    }
+
+    while (std::chrono::steady_clock::now() < _data.deadline)
+    {
+    }
+  }
+
+  _data.deadline += period;
+}
+
+/////////////////////////////////////////////////
+/// \brief Queue a response for the response worker, which serializes its
+/// data and publishes it. Without a worker, the response is sent right
+/// away.
+/// \param[in] _data World data.
+/// \param[in] _response Response, without its serialized data.
+/// \param[in] _serialize Function that serializes the data.
+static void QueueResponse(WorldPrivate &_data, const msgs::Response &_response,
+    const std::function<void(std::string &)> &_serialize)
+{
+  std::unique_lock<std::mutex> lock(_data.responseMutex);
+  if (!_data.responseThread)
+  {
+    lock.unlock();
+    msgs::Response response(_response);
+    _serialize(*response.mutable_serialized_data());
+    _data.responsePub->Publish(response);
+    return;
+  }
+
+  _data.responseJobs.emplace_back(_response, _serialize);
+  _data.responseCondition.notify_one();
+}
+
+/////////////////////////////////////////////////
+/// \brief Queue a message response for the response worker.
+/// \param[in] _data World data.
+/// \param[in] _response Response, without its serialized data.
+/// \param[in] _msg Message filled by the world thread, not modified after.
+static void QueueResponse(WorldPrivate &_data, const msgs::Response &_response,
+    const std::shared_ptr<google::protobuf::Message> &_msg)
+{
+  QueueResponse(_data, _response, [_msg](std::string &_serialized)
+      {
+        _msg->SerializeToString(&_serialized);
+      });
+}
+
+/////////////////////////////////////////////////
+/// \brief Serialize and publish the queued responses, until the world
+/// stops.
+/// \param[in] _data World data.
+static void RunResponseWorker(WorldPrivate *_data)
+{
+  std::unique_lock<std::mutex> lock(_data->responseMutex);
+  while (true)
+  {
+    _data->responseCondition.wait(lock, [_data]()
+        {
+          return !_data->responseJobs.empty() || _data->responseStop;
+        });
+
+    if (_data->responseJobs.empty())
+      break;
+
+    auto job = std::move(_data->responseJobs.front());
+    _data->responseJobs.pop_front();
+    lock.unlock();
+
+    job.second(*job.first.mutable_serialized_data());
+    _data->responsePub->Publish(job.first);
+
+    lock.lock();
+  }
+}
+
+
+/// \brief Magic number at the start of state snapshots, "GZS1".
+static const uint32_t kStateSnapshotMagic = 0x31535a47;
+
+/// \brief Values stored per link in state snapshots: position,
+/// orientation quaternion (w, x, y, z), linear and angular velocity.
+static const size_t kStateSnapshotLinkValues = 13;
+
+/// \brief Header of the state snapshots of World::StateSnapshot.
+struct StateSnapshotHeader
+{
+  /// \brief kStateSnapshotMagic.
+  uint32_t magic;
+
+  /// \brief Number of links.
+  uint32_t linkCount;
+
+  /// \brief Number of joint positions.
+  uint32_t positionCount;
+
+  /// \brief Unused, zero.
+  uint32_t reserved;
+
+  /// \brief Hash of the ids of the links and joints, so that a snapshot
+  /// is only restored into the entities it was taken from.
+  uint64_t layout;
+
+  /// \brief World iterations.
+  uint64_t iterations;
+
+  /// \brief Simulation time in seconds.
+  double simTime;
+};
+
+/// \brief Collect the links and joints of a model and its nested models,
+/// in the order used by state snapshots.
+/// \param[in] _model The model.
+/// \param[out] _links Links of the model.
+/// \param[out] _joints Joints of the model.
+/// \param[in,out] _layout FNV-1a hash of the ids of the entities.
+static void CollectSnapshotEntities(const ModelPtr &_model, Link_V &_links,
+    Joint_V &_joints, uint64_t &_layout)
+{
+  for (auto const &link : _model->GetLinks())
+  {
+    _links.push_back(link);
+    _layout = (_layout ^ link->GetId()) * 1099511628211ull;
+  }
+
+  for (auto const &joint : _model->GetJoints())
+  {
+    _joints.push_back(joint);
+    _layout = (_layout ^ joint->GetId()) * 1099511628211ull;
+  }
+
+  for (auto const &nested : _model->NestedModels())
+    CollectSnapshotEntities(nested, _links, _joints, _layout);
+}
+
 //////////////////////////////////////////////////
 World::World(const std::string &_name)
   : dataPtr(new WorldPrivate)
@@ -132,6 +364,7 @@ World::World(const std::string &_name)
   this->dataPtr->logThread = nullptr;
   this->dataPtr->stop = false;
   this->dataPtr->sensorsInitialized = false;
+  this->dataPtr->snapshotsEnabled = false;
 
   this->dataPtr->currentStateBuffer = 0;
   this->dataPtr->stateToggle = 0;
@@ -151,6 +384,28 @@ World::World(const std::string &_name)
   this->dataPtr->sleepOffset = common::Time(0);
 
   this->dataPtr->prevStatTime = common::Time::GetWallTime();
+  this->dataPtr->prevTimingTime = common::Time::GetWallTime();
+  this->dataPtr->prevMemoryTime = this->dataPtr->prevTimingTime;
+  this->dataPtr->prevSolverTime = this->dataPtr->prevTimingTime;
+  this->dataPtr->prevPluginStatsTime = this->dataPtr->prevTimingTime;
+
+  util::TimingStats *timing = util::TimingStats::Instance();
+  auto &stages = this->dataPtr->timingStages;
+  stages.worldUpdateBegin = timing->Stage("World::Update/worldUpdateBegin");
+  stages.worldUpdateBeginModelLocal =
+    timing->Stage("World::Update/worldUpdateBeginModelLocal");
+  stages.modelUpdate = timing->Stage("World::Update/Model::Update");
+  stages.updateCollision = timing->Stage("World::Update/UpdateCollision");
+  stages.beforePhysicsUpdate =
+    timing->Stage("World::Update/beforePhysicsUpdate");
+  stages.updatePhysics = timing->Stage("World::Update/UpdatePhysics");
+  stages.dirtyPoses = timing->Stage("World::Update/dirtyPoses");
+  stages.logRecord = timing->Stage("World::Update/LogRecordNotify");
+  stages.publishContacts = timing->Stage("World::Update/PublishContacts");
+  stages.boxIndex = timing->Stage("World::Update/UpdateBoxIndex");
+  stages.snapshot = timing->Stage("World::Update/CaptureSnapshot");
+  stages.worldUpdateEnd = timing->Stage("World::Update/worldUpdateEnd");
+  stages.update = timing->Stage("World::Update");
   this->dataPtr->prevProcessMsgsTime = common::Time::GetWallTime();
   this->dataPtr->logLastStatePlayedSimTime = common::Time(0);
   this->dataPtr->logLastStatePlayedRealTime = common::Time(0);
@@ -203,6 +458,10 @@ void World::Load(sdf::ElementPtr _sdf)
     }
   }
 
+  const char *poolSize = common::getEnv("GAZEBO_MODEL_POOL_SIZE");
+  if (poolSize && atoi(poolSize) > 0)
+    this->dataPtr->modelPoolSize = atoi(poolSize);
+
   if (this->dataPtr->sdf->Get<std::string>("name").empty())
     gzwarn << "create_world(world_name =["
            << this->dataPtr->name << "]) overwrites sdf world name\n!";
@@ -259,6 +518,16 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->posePub = this->dataPtr->node->Advertise<msgs::PosesStamped>(
     "~/pose/info", 10, 60);
 
+  // compact pose pub, rate limited in World::PublishPoseDelta since every
+  // message must reach the subscribers
+  this->dataPtr->poseDeltaPub =
+    this->dataPtr->node->Advertise<msgs::PosesDelta>("~/pose/delta/info", 10);
+
+  // skeleton poses of the actors updated as a crowd, one message per step
+  this->dataPtr->skeletonPoseBatchPub =
+    this->dataPtr->node->Advertise<msgs::PoseAnimation_V>(
+        "~/skeleton_pose/batch", 10);
+
   this->dataPtr->guiPub = this->dataPtr->node->Advertise<msgs::GUI>("~/gui", 5);
   if (this->dataPtr->sdf->HasElement("gui"))
   {
@@ -293,8 +562,22 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->statPub =
     this->dataPtr->node->Advertise<msgs::WorldStatistics>(
         "~/world_stats", 100, 5);
+  this->dataPtr->timingPub =
+    this->dataPtr->node->Advertise<msgs::TimingStatistics>(
+        "~/timing_stats", 10, 1);
+  this->dataPtr->memoryPub =
+    this->dataPtr->node->Advertise<msgs::MemoryStatistics>(
+        "~/memory_stats", 10, 1);
+  this->dataPtr->solverPub =
+    this->dataPtr->node->Advertise<msgs::SolverStatistics>(
+        "~/solver_stats", 10, 1);
+  this->dataPtr->pluginStatsPub =
+    this->dataPtr->node->Advertise<msgs::PluginStatistics>(
+        "~/plugin_stats", 10, 1);
   this->dataPtr->modelPub = this->dataPtr->node->Advertise<msgs::Model>(
       "~/model/info");
+  this->dataPtr->modelVPub = this->dataPtr->node->Advertise<msgs::Model_V>(
+      "~/model/info_v");
   this->dataPtr->lightPub = this->dataPtr->node->Advertise<msgs::Light>(
       "~/light/modify");
   this->dataPtr->lightFactoryPub = this->dataPtr->node->Advertise<msgs::Light>(
@@ -413,6 +696,30 @@ void World::Load(sdf::ElementPtr _sdf)
   // information. The joints must be created last, otherwise they get
   // initialized improperly.
   {
+    // Models in streaming regions are taken out of the world, so neither
+    // the prefetch nor LoadEntities touches them until an active model
+    // approaches their region
+    if (this->dataPtr->sdf->HasElement("ignition:streaming"))
+    {
+      this->dataPtr->streaming = std::make_shared<WorldStreaming>();
+      this->dataPtr->streaming->Load(
+          this->dataPtr->sdf->GetElement("ignition:streaming"));
+
+      sdf::ElementPtr modelElem = this->dataPtr->sdf->HasElement("model") ?
+        this->dataPtr->sdf->GetElement("model") : sdf::ElementPtr();
+      while (modelElem)
+      {
+        sdf::ElementPtr nextElem = modelElem->GetNextElement("model");
+        if (this->dataPtr->streaming->Take(modelElem))
+          this->dataPtr->sdf->RemoveChild(modelElem);
+        modelElem = nextElem;
+      }
+    }
+
+    // Resolve and parse the resources of every model in parallel, so the
+    // serial load below finds them in the caches.
+    this->PrefetchResources(this->dataPtr->sdf);
+
     // Create all the entities
     this->LoadEntities(this->dataPtr->sdf, this->dataPtr->rootElement);
 
@@ -420,13 +727,11 @@ void World::Load(sdf::ElementPtr _sdf)
       this->ModelByIndex(i)->LoadJoints();
   }
 
-  // TODO: Performance test to see if TBB model updating is necessary
-  // Choose threaded or unthreaded model updating depending on the number of
-  // models in the scene
-  // if (this->ModelCount() < 20)
-  this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
-  // else
-  // this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  // Choose threaded or unthreaded model updating. The TBB version falls
+  // back to the single loop while the number of models in the scene is
+  // below the physics engine's parallel_model_update_threshold, which only
+  // ODE lets be set.
+  this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
 
   event::Events::worldCreated(this->Name());
 
@@ -512,7 +817,6 @@ void World::Init(UpdateScenePosesFunc _func)
   this->dataPtr->updateInfo.worldName = this->Name();
 
   this->dataPtr->iterations = 0;
-  this->dataPtr->logPrevIteration = 0;
 
   util::DiagnosticManager::Instance()->Init(this->Name());
 
@@ -570,6 +874,78 @@ void World::RunBlocking(const unsigned int _iterations)
   this->RunLoop();
 }
 
+//////////////////////////////////////////////////
+void World::SetCpuAffinity(const int _cpu)
+{
+#ifndef __linux__
+  if (_cpu >= 0)
+    gzwarn << "CPU affinity is only supported on Linux" << std::endl;
+#endif
+  this->dataPtr->cpuAffinity = std::max(_cpu, -1);
+}
+
+//////////////////////////////////////////////////
+int World::CpuAffinity() const
+{
+  return this->dataPtr->cpuAffinity;
+}
+
+//////////////////////////////////////////////////
+void World::SetRealTimeMode(const bool _enable)
+{
+  this->dataPtr->realTimeMode = _enable;
+
+  // The first step of the mode starts right away
+  this->dataPtr->deadline = std::chrono::steady_clock::time_point();
+}
+
+//////////////////////////////////////////////////
+bool World::RealTimeMode() const
+{
+  return this->dataPtr->realTimeMode;
+}
+
+//////////////////////////////////////////////////
+void World::SetRealTimePriority(const int _priority)
+{
+#ifndef __linux__
+  if (_priority > 0)
+    gzwarn << "Real time priority is only supported on Linux" << std::endl;
+#endif
+  this->dataPtr->realTimePriority = ignition::math::clamp(_priority, 0, 99);
+}
+
+//////////////////////////////////////////////////
+int World::RealTimePriority() const
+{
+  return this->dataPtr->realTimePriority;
+}
+
+//////////////////////////////////////////////////
+void World::SetSpinTime(const double _spin)
+{
+  this->dataPtr->spinTime = std::chrono::nanoseconds(
+      static_cast<int64_t>(std::max(_spin, 0.0) * 1e9));
+}
+
+//////////////////////////////////////////////////
+double World::SpinTime() const
+{
+  return this->dataPtr->spinTime.count() * 1e-9;
+}
+
+//////////////////////////////////////////////////
+uint64_t World::Overruns() const
+{
+  return this->dataPtr->overruns;
+}
+
+//////////////////////////////////////////////////
+common::Time World::MaxOverrun() const
+{
+  return this->dataPtr->maxOverrun;
+}
+
 //////////////////////////////////////////////////
 void World::RemoveModel(ModelPtr _model)
 {
@@ -603,6 +979,35 @@ void World::Stop()
 //////////////////////////////////////////////////
 void World::RunLoop()
 {
+  // The settings of the world itself override the ones of the role.
+  common::ThreadRoles::Instance()->Apply("world");
+
+#ifdef __linux__
+  if (this->dataPtr->cpuAffinity >= 0)
+  {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(this->dataPtr->cpuAffinity, &cpus);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0)
+    {
+      gzwarn << "Unable to pin world [" << this->Name() << "] to CPU ["
+        << this->dataPtr->cpuAffinity << "]" << std::endl;
+    }
+  }
+
+  if (this->dataPtr->realTimePriority > 0)
+  {
+    sched_param param;
+    param.sched_priority = this->dataPtr->realTimePriority;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0)
+    {
+      gzwarn << "Unable to run world [" << this->Name() << "] with "
+        << "SCHED_FIFO priority [" << this->dataPtr->realTimePriority
+        << "], check the rtprio limit" << std::endl;
+    }
+  }
+#endif
+
   this->dataPtr->physicsEngine->InitForThread();
 
   this->dataPtr->startTime = common::Time::GetWallTime();
@@ -621,6 +1026,13 @@ void World::RunLoop()
   this->dataPtr->logThread =
     new std::thread(std::bind(&World::LogWorker, this));
 
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->responseMutex);
+    this->dataPtr->responseStop = false;
+    this->dataPtr->responseThread =
+      new std::thread(RunResponseWorker, this->dataPtr);
+  }
+
   if (!util::LogPlay::Instance()->IsOpen())
   {
     for (this->dataPtr->iterations = 0; !this->dataPtr->stop &&
@@ -654,11 +1066,35 @@ void World::RunLoop()
     delete this->dataPtr->logThread;
     this->dataPtr->logThread = nullptr;
   }
+
+  // Send the queued responses before the worker exits
+  std::thread *responseThread = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->responseMutex);
+    this->dataPtr->responseStop = true;
+    this->dataPtr->responseCondition.notify_all();
+    std::swap(responseThread, this->dataPtr->responseThread);
+  }
+  if (responseThread)
+  {
+    responseThread->join();
+    delete responseThread;
+  }
 }
 
 //////////////////////////////////////////////////
 void World::LogStep()
 {
+  // Rendering sensors in lockstep finish the frames of the state played
+  // last before the scene moves on, so no frame is skipped when the log
+  // plays faster than real time
+  if (this->dataPtr->waitForSensors &&
+      (!this->IsPaused() || this->dataPtr->stepInc != 0))
+  {
+    IGN_PROFILE("waitForSensors");
+    this->dataPtr->waitForSensors(this->dataPtr->simTime.Double(), 0.0);
+  }
+
   {
     std::lock_guard<std::recursive_mutex> lk(this->dataPtr->worldUpdateMutex);
 
@@ -683,6 +1119,17 @@ void World::LogStep()
 
         this->dataPtr->logPlayState.Load(this->dataPtr->logPlayStateSDF);
 
+        // The segment played by this server is complete
+        if (this->dataPtr->logPlayEndTime != common::Time::Zero &&
+            this->dataPtr->logPlayState.GetSimTime() >
+            this->dataPtr->logPlayEndTime)
+        {
+          this->dataPtr->stop = true;
+          this->dataPtr->stepInc = 0;
+          this->dataPtr->stepCondition.notify_all();
+          return;
+        }
+
         // If it's the first step, we're going back in time or
         // rt factor is close to zero, don't sleep.
         if ((this->dataPtr->logPlayRealTimeFactor > 1e-5) &&
@@ -720,8 +1167,8 @@ void World::LogStep()
         this->Update();
       }
 
-      if (this->dataPtr->stepInc > 0)
-        this->dataPtr->stepInc--;
+      if (this->dataPtr->stepInc > 0 && --this->dataPtr->stepInc == 0)
+        this->dataPtr->stepCondition.notify_all();
     }
   }
 
@@ -730,6 +1177,18 @@ void World::LogStep()
   this->ProcessMessages();
 }
 
+//////////////////////////////////////////////////
+void World::SetLogPlayEndTime(const common::Time &_time)
+{
+  this->dataPtr->logPlayEndTime = _time;
+}
+
+//////////////////////////////////////////////////
+common::Time World::LogPlayEndTime() const
+{
+  return this->dataPtr->logPlayEndTime;
+}
+
 //////////////////////////////////////////////////
 void World::_SetSensorsInitialized(const bool _init)
 {
@@ -742,6 +1201,77 @@ bool World::SensorsInitialized() const
   return this->dataPtr->sensorsInitialized;
 }
 
+//////////////////////////////////////////////////
+void World::SetSnapshotsEnabled(const bool _enable)
+{
+  this->dataPtr->snapshotsEnabled = _enable;
+  if (!_enable)
+  {
+    std::atomic_store(&this->dataPtr->latestSnapshot,
+        std::shared_ptr<const WorldSnapshot>());
+  }
+}
+
+//////////////////////////////////////////////////
+bool World::SnapshotsEnabled() const
+{
+  return this->dataPtr->snapshotsEnabled;
+}
+
+//////////////////////////////////////////////////
+WorldSnapshotPtr World::Snapshot() const
+{
+  return std::atomic_load(&this->dataPtr->latestSnapshot);
+}
+
+//////////////////////////////////////////////////
+void World::SetBoxIndexEnabled(const bool _enable)
+{
+  if (_enable == this->BoxIndexEnabled())
+    return;
+
+  // A new index is built from scratch on the next update
+  std::atomic_store(&this->dataPtr->boxIndex,
+      _enable ? std::make_shared<ModelBoxIndex>() : ModelBoxIndexPtr());
+}
+
+//////////////////////////////////////////////////
+bool World::BoxIndexEnabled() const
+{
+  return this->BoxIndex() != nullptr;
+}
+
+//////////////////////////////////////////////////
+ModelBoxIndexPtr World::BoxIndex() const
+{
+  return std::atomic_load(&this->dataPtr->boxIndex);
+}
+
+//////////////////////////////////////////////////
+WorldStreamingPtr World::Streaming() const
+{
+  return this->dataPtr->streaming;
+}
+
+//////////////////////////////////////////////////
+TriggerVolumesPtr World::TriggerVolumes()
+{
+  TriggerVolumesPtr triggers =
+    std::atomic_load(&this->dataPtr->triggerVolumes);
+  if (triggers)
+    return triggers;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->triggerVolumesMutex);
+  triggers = std::atomic_load(&this->dataPtr->triggerVolumes);
+  if (!triggers)
+  {
+    this->SetBoxIndexEnabled(true);
+    triggers = std::make_shared<physics::TriggerVolumes>();
+    std::atomic_store(&this->dataPtr->triggerVolumes, triggers);
+  }
+  return triggers;
+}
+
 /////////////////////////////////////////////////
 void World::SetSensorWaitFunc(std::function<void(double, double)> _func)
 {
@@ -786,34 +1316,47 @@ void World::Step()
         this->dataPtr->physicsEngine->GetMaxStepSize());
   IGN_PROFILE_END();
 
-  IGN_PROFILE_BEGIN("sleepOffset");
   double updatePeriod = this->dataPtr->physicsEngine->GetUpdatePeriod();
-  // sleep here to get the correct update rate
-  common::Time tmpTime = common::Time::GetWallTime();
-  common::Time sleepTime = this->dataPtr->prevStepWallTime +
-    common::Time(updatePeriod) - tmpTime - this->dataPtr->sleepOffset;
-
-  common::Time actualSleep;
-  if (sleepTime > 0)
+  bool stepDue = true;
+  if (this->dataPtr->realTimeMode && updatePeriod > 0)
   {
-    common::Time::Sleep(sleepTime);
-    actualSleep = common::Time::GetWallTime() - tmpTime;
+    IGN_PROFILE_BEGIN("waitForDeadline");
+    WaitForDeadline(*this->dataPtr, updatePeriod);
+    IGN_PROFILE_END();
+    DIAG_TIMER_LAP("World::Step", "waitForDeadline");
   }
   else
-    sleepTime = 0;
+  {
+    IGN_PROFILE_BEGIN("sleepOffset");
+    // sleep here to get the correct update rate
+    common::Time tmpTime = common::Time::GetWallTime();
+    common::Time sleepTime = this->dataPtr->prevStepWallTime +
+      common::Time(updatePeriod) - tmpTime - this->dataPtr->sleepOffset;
+
+    common::Time actualSleep;
+    if (sleepTime > 0)
+    {
+      common::Time::Sleep(sleepTime);
+      actualSleep = common::Time::GetWallTime() - tmpTime;
+    }
+    else
+      sleepTime = 0;
 
-  // exponentially avg out
-  this->dataPtr->sleepOffset = (actualSleep - sleepTime) * 0.01 +
-                      this->dataPtr->sleepOffset * 0.99;
+    // exponentially avg out
+    this->dataPtr->sleepOffset = (actualSleep - sleepTime) * 0.01 +
+                        this->dataPtr->sleepOffset * 0.99;
 
-  IGN_PROFILE_END();
-  DIAG_TIMER_LAP("World::Step", "sleepOffset");
+    IGN_PROFILE_END();
+    DIAG_TIMER_LAP("World::Step", "sleepOffset");
+
+    // throttling update rate, with sleepOffset as tolerance
+    // the tolerance is needed as the sleep time is not exact
+    stepDue = common::Time::GetWallTime() - this->dataPtr->prevStepWallTime +
+        this->dataPtr->sleepOffset >= common::Time(updatePeriod);
+  }
 
   IGN_PROFILE_BEGIN("worldUpdateMutex");
-  // throttling update rate, with sleepOffset as tolerance
-  // the tolerance is needed as the sleep time is not exact
-  if (common::Time::GetWallTime() - this->dataPtr->prevStepWallTime +
-      this->dataPtr->sleepOffset >= common::Time(updatePeriod))
+  if (stepDue)
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
 
@@ -826,15 +1369,24 @@ void World::Step()
     if (!this->IsPaused() || this->dataPtr->stepInc > 0
         || this->dataPtr->needsReset)
     {
+      stepTime = this->AdaptStepSize();
+
       // query timestep to allow dynamic time step size updates
       this->dataPtr->simTime += stepTime;
       this->dataPtr->iterations++;
+
+      // Send the messages of this step together.
+      this->dataPtr->node->BeginPublishBatch();
       this->Update();
+      this->dataPtr->node->EndPublishBatch();
 
       DIAG_TIMER_LAP("World::Step", "update");
 
-      if (this->IsPaused() && this->dataPtr->stepInc > 0)
-        this->dataPtr->stepInc--;
+      if (this->IsPaused() && this->dataPtr->stepInc > 0 &&
+          --this->dataPtr->stepInc == 0)
+      {
+        this->dataPtr->stepCondition.notify_all();
+      }
     }
     else
     {
@@ -854,6 +1406,9 @@ void World::Step()
   this->ProcessMessages();
   IGN_PROFILE_END();
 
+  if (this->dataPtr->streaming)
+    this->dataPtr->streaming->Update(*this);
+
   DIAG_TIMER_STOP("World::Step");
 
   IGN_PROFILE_BEGIN("ClearModels");
@@ -871,19 +1426,16 @@ void World::Step(const unsigned int _steps)
     this->SetPaused(true);
   }
 
-  {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
-    this->dataPtr->stepInc = _steps;
-  }
+  std::unique_lock<std::recursive_mutex> lock(
+      this->dataPtr->worldUpdateMutex);
+  this->dataPtr->stepInc = _steps;
 
-  // block on completion
-  bool wait = true;
-  while (wait)
+  // block on completion. The timeout catches a stop of the world, which
+  // is not notified.
+  while (this->dataPtr->stepInc != 0 && !this->dataPtr->stop)
   {
-    common::Time::NSleep(1);
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
-    if (this->dataPtr->stepInc == 0 || this->dataPtr->stop)
-      wait = false;
+    this->dataPtr->stepCondition.wait_for(lock,
+        std::chrono::milliseconds(10));
   }
 }
 
@@ -908,41 +1460,50 @@ void World::Update()
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "needsReset");
 
+  // Switch the physics profile between steps
+  if (this->dataPtr->presetManager)
+    this->dataPtr->presetManager->ApplyQueuedProfile();
+
+  const auto &stages = this->dataPtr->timingStages;
+  util::StageTimer updateTimer;
+  util::StageTimer stageTimer;
+
   IGN_PROFILE_BEGIN("worldUpdateBegin");
   this->dataPtr->updateInfo.simTime = this->SimTime();
   this->dataPtr->updateInfo.realTime = this->RealTime();
+
+  // Only the links with audio, wind, battery or wrench work are updated
+  for (auto &model : this->dataPtr->models)
+    model->UpdateLinks(this->dataPtr->updateInfo);
+
   event::Events::worldUpdateBegin(this->dataPtr->updateInfo);
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Events::worldUpdateBegin");
+  stageTimer.Lap(stages.worldUpdateBegin);
+
+  IGN_PROFILE_BEGIN("worldUpdateBeginModelLocal");
+  // Model-local callbacks run in parallel, once the global ones are done.
+  event::Events::worldUpdateBeginModelLocal.SignalParallel(
+      this->dataPtr->updateInfo);
+  IGN_PROFILE_END();
+  DIAG_TIMER_LAP("World::Update", "Events::worldUpdateBeginModelLocal");
+  stageTimer.Lap(stages.worldUpdateBeginModelLocal);
 
   IGN_PROFILE_BEGIN("Update");
   // Update all the models
   (*this.*dataPtr->modelUpdateFunc)();
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Model::Update");
+  stageTimer.Lap(stages.modelUpdate);
 
   IGN_PROFILE_BEGIN("UpdateCollision");
   // This must be called before PhysicsEngine::UpdatePhysics for ODE.
   this->dataPtr->physicsEngine->UpdateCollision();
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdateCollision");
+  stageTimer.Lap(stages.updateCollision);
 
   IGN_PROFILE_BEGIN("beforePhysicsUpdate");
-  // Wait for logging to finish, if it's running.
-  if (util::LogRecord::Instance()->Running())
-  {
-    std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
-
-    // It's possible the logWorker thread never processed the previous
-    // state. This checks to make sure that we don't continute until the log
-    // worker catchs up.
-    if (this->dataPtr->iterations - this->dataPtr->logPrevIteration > 1)
-    {
-      this->dataPtr->logCondition.notify_one();
-      this->dataPtr->logContinueCondition.wait(lock);
-    }
-  }
-
   // Give clients a possibility to react to collisions before the physics
   // gets updated.
   this->dataPtr->updateInfo.realTime = this->RealTime();
@@ -950,16 +1511,22 @@ void World::Update()
 
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Events::beforePhysicsUpdate");
+  stageTimer.Lap(stages.beforePhysicsUpdate);
 
   // Update the physics engine
   if (this->dataPtr->enablePhysicsEngine && this->dataPtr->physicsEngine)
   {
+    IGN_PROFILE_BEGIN("WakeSleepingModels");
+    this->WakeSleepingModels();
+    IGN_PROFILE_END();
+
     IGN_PROFILE_BEGIN("UpdatePhysics");
     // This must be called directly after PhysicsEngine::UpdateCollision.
     this->dataPtr->physicsEngine->UpdatePhysics();
 
     IGN_PROFILE_END();
     DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdatePhysics");
+    stageTimer.Lap(stages.updatePhysics);
 
     // do this after physics update as
     //   ode --> MoveCallback sets the dirtyPoses
@@ -970,24 +1537,27 @@ void World::Update()
       boost::recursive_mutex::scoped_lock plock(
           *this->Physics()->GetPhysicsUpdateMutex());
 
-      for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
-      {
-        dirtyEntity->SetWorldPose(dirtyEntity->DirtyPose(), false);
-      }
-
-      this->dataPtr->dirtyPoses.clear();
+      this->UpdateDirtyPoses();
       IGN_PROFILE_END();
     }
 
     DIAG_TIMER_LAP("World::Update", "SetWorldPose(dirtyPoses)");
+    stageTimer.Lap(stages.dirtyPoses);
+
+    IGN_PROFILE_BEGIN("SleepRestingModels");
+    this->SleepRestingModels();
+    IGN_PROFILE_END();
   }
 
+  stageTimer.Restart();
+
   IGN_PROFILE_BEGIN("LogRecordNotify");
   // Only update state information if logging data.
   if (util::LogRecord::Instance()->Running())
-    this->dataPtr->logCondition.notify_one();
+    this->CaptureLogState();
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "LogRecordNotify");
+  stageTimer.Lap(stages.logRecord);
 
   IGN_PROFILE_BEGIN("PublishContacts");
   // Output the contact information
@@ -995,13 +1565,52 @@ void World::Update()
 
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "ContactManager::PublishContacts");
+  stageTimer.Lap(stages.publishContacts);
 
-  event::Events::worldUpdateEnd();
+  ModelBoxIndexPtr boxIndex = this->BoxIndex();
+  if (boxIndex)
+  {
+    IGN_PROFILE_BEGIN("UpdateBoxIndex");
+    boxIndex->Update(*this, this->dataPtr->logEntityChanges);
 
-  gazebo::util::IntrospectionManager::Instance()->Update();
+    TriggerVolumesPtr triggers =
+      std::atomic_load(&this->dataPtr->triggerVolumes);
+    if (triggers)
+      triggers->Update(boxIndex);
+    IGN_PROFILE_END();
+    DIAG_TIMER_LAP("World::Update", "UpdateBoxIndex");
+    stageTimer.Lap(stages.boxIndex);
+  }
 
-  DIAG_TIMER_STOP("World::Update");
-}
+  if (this->dataPtr->snapshotsEnabled)
+  {
+    IGN_PROFILE_BEGIN("CaptureSnapshot");
+    std::shared_ptr<WorldSnapshot> &back =
+      this->dataPtr->snapshots[this->dataPtr->snapshotBackIndex];
+
+    // Readers only get new references through latestSnapshot, so a back
+    // buffer nobody else holds can be refilled safely.
+    if (!back || back.use_count() > 1)
+      back = std::make_shared<WorldSnapshot>();
+
+    back->Capture(*this);
+    std::atomic_store(&this->dataPtr->latestSnapshot,
+        std::shared_ptr<const WorldSnapshot>(back));
+    this->dataPtr->snapshotBackIndex ^= 1u;
+    IGN_PROFILE_END();
+    DIAG_TIMER_LAP("World::Update", "CaptureSnapshot");
+    stageTimer.Lap(stages.snapshot);
+  }
+
+  stageTimer.Restart();
+  event::Events::worldUpdateEnd();
+
+  gazebo::util::IntrospectionManager::Instance()->Update();
+  stageTimer.Lap(stages.worldUpdateEnd);
+  updateTimer.Lap(stages.update);
+
+  DIAG_TIMER_STOP("World::Update");
+}
 
 //////////////////////////////////////////////////
 void World::Fini()
@@ -1012,10 +1621,18 @@ void World::Fini()
   // wait until World::Step has completed before proceeding
   std::lock_guard<std::mutex> lock(this->dataPtr->stepMutex);
 
+  this->dataPtr->streaming.reset();
+
 #ifdef HAVE_OPENAL
   util::OpenAL::Instance()->Fini();
 #endif
 
+  if (this->dataPtr->pluginStatsEnabled)
+  {
+    common::PluginStats::Disable();
+    this->dataPtr->pluginStatsEnabled = false;
+  }
+
   // Clean transport
   {
     // Clear subscribers first
@@ -1039,10 +1656,17 @@ void World::Fini()
 
     this->dataPtr->poseLocalPub.reset();
     this->dataPtr->posePub.reset();
+    this->dataPtr->poseDeltaPub.reset();
+    this->dataPtr->skeletonPoseBatchPub.reset();
     this->dataPtr->guiPub.reset();
     this->dataPtr->responsePub.reset();
     this->dataPtr->statPub.reset();
+    this->dataPtr->timingPub.reset();
+    this->dataPtr->memoryPub.reset();
+    this->dataPtr->solverPub.reset();
+    this->dataPtr->pluginStatsPub.reset();
     this->dataPtr->modelPub.reset();
+    this->dataPtr->modelVPub.reset();
     this->dataPtr->lightPub.reset();
     this->dataPtr->lightFactoryPub.reset();
 
@@ -1069,6 +1693,8 @@ void World::Fini()
       model->Fini();
   }
   this->dataPtr->models.clear();
+  this->TrimModelPool(0);
+  this->dataPtr->modelPoolKeys.clear();
 
   for (auto &road : this->dataPtr->roads)
   {
@@ -1092,6 +1718,8 @@ void World::Fini()
   this->dataPtr->prevStates[0].SetWorld(WorldPtr());
   this->dataPtr->prevStates[1].SetWorld(WorldPtr());
   this->dataPtr->prevUnfilteredState.SetWorld(WorldPtr());
+  this->dataPtr->logCaptureState.SetWorld(WorldPtr());
+  this->dataPtr->logUnfilteredCaptureState.SetWorld(WorldPtr());
   this->dataPtr->logPlayState.SetWorld(WorldPtr());
   this->dataPtr->states[0].clear();
   this->dataPtr->states[1].clear();
@@ -1295,9 +1923,66 @@ ModelPtr World::LoadModel(sdf::ElementPtr _sdf , BasePtr _parent)
 
   this->PublishModelPose(model);
   this->dataPtr->models.push_back(model);
+  ++this->dataPtr->logEntityChanges;
   return model;
 }
 
+//////////////////////////////////////////////////
+Model_V World::LoadModels(const std::vector<sdf::ElementPtr> &_sdfs,
+    BasePtr _parent)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->loadModelMutex);
+  Model_V result;
+  result.reserve(_sdfs.size());
+
+  // Names are checked against a set, instead of scanning all the models
+  // for each new one
+  std::set<std::string> names;
+  for (auto const &m : this->dataPtr->models)
+    names.insert(m->GetName());
+
+  msgs::Model_V msg;
+  for (auto const &elem : _sdfs)
+  {
+    if (elem->GetName() != "model")
+    {
+      gzerr << "SDF is missing the <model> tag:\n";
+      continue;
+    }
+
+    std::string modelName = elem->Get<std::string>("name");
+    if (!names.insert(modelName).second)
+    {
+      gzwarn << "Model with name [" << modelName << "] already exists. "
+        << "Not inserting model.\n";
+      continue;
+    }
+
+    elem->SetParent(this->dataPtr->sdf);
+    elem->GetParent()->InsertElement(elem);
+
+    ModelPtr model = this->dataPtr->physicsEngine->CreateModel(_parent);
+    model->SetWorld(shared_from_this());
+    model->Load(elem);
+
+    event::Events::addEntity(model->GetScopedName());
+    model->FillMsg(*msg.add_models());
+
+    this->PublishModelPose(model);
+    this->dataPtr->models.push_back(model);
+    ++this->dataPtr->logEntityChanges;
+    result.push_back(model);
+  }
+
+  if (!result.empty())
+  {
+    this->dataPtr->modelVPub->Publish(msg);
+    this->EnableAllModels();
+  }
+
+  return result;
+}
+
 //////////////////////////////////////////////////
 LightPtr World::LoadLight(const sdf::ElementPtr &_sdf, const BasePtr &_parent)
 {
@@ -1320,6 +2005,7 @@ LightPtr World::LoadLight(const sdf::ElementPtr &_sdf, const BasePtr &_parent)
   light->SetWorld(shared_from_this());
   light->Load(_sdf);
   this->dataPtr->lights.push_back(light);
+  ++this->dataPtr->logEntityChanges;
 
   // msg should contain scoped name (consistent with other entities)
   msg->set_name(light->GetScopedName());
@@ -1350,6 +2036,7 @@ ActorPtr World::LoadActor(sdf::ElementPtr _sdf , BasePtr _parent)
   this->EnableAllModels();
   this->PublishModelPose(actor);
   this->dataPtr->models.push_back(actor);
+  ++this->dataPtr->logEntityChanges;
 
   return actor;
 }
@@ -1363,6 +2050,57 @@ RoadPtr World::LoadRoad(sdf::ElementPtr _sdf , BasePtr _parent)
   return road;
 }
 
+//////////////////////////////////////////////////
+void World::PrefetchResources(sdf::ElementPtr _sdf)
+{
+  IGN_PROFILE("World::PrefetchResources");
+
+  std::vector<std::string> uris;
+  CollectMeshUris(_sdf, uris);
+  std::sort(uris.begin(), uris.end());
+  uris.erase(std::unique(uris.begin(), uris.end()), uris.end());
+  if (uris.empty())
+    return;
+
+  // Download the missing models in one batch, so find_file below finds
+  // them installed instead of downloading them one at a time.
+  common::prefetch_uris(uris);
+
+  // SystemPaths and the model databases are not thread safe, so the URIs
+  // are resolved here. The loaders only see existing absolute paths.
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  std::vector<std::string> filenames;
+  for (const auto &uri : uris)
+  {
+    if (meshManager->HasMesh(uri))
+      continue;
+
+    std::string filename = common::find_file(uri);
+    if (!filename.empty() && filename != "__default__" &&
+        meshManager->IsValidFilename(filename) &&
+        !meshManager->HasMesh(filename))
+    {
+      filenames.push_back(filename);
+    }
+  }
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, filenames.size(), 1),
+      [&filenames, meshManager](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          try
+          {
+            meshManager->Load(filenames[i]);
+          }
+          catch(common::Exception &)
+          {
+            // The error is reported again when the shape is loaded.
+          }
+        }
+      });
+}
+
 //////////////////////////////////////////////////
 void World::LoadEntities(sdf::ElementPtr _sdf, BasePtr _parent)
 {
@@ -1460,6 +2198,7 @@ void World::ResetTime()
   this->dataPtr->startTime = common::Time::GetWallTime();
   this->dataPtr->realTimeOffset = common::Time(0);
   this->dataPtr->iterations = 0;
+  this->dataPtr->stepSizeController.Reset();
 
   if (this->IsPaused())
     this->dataPtr->pauseStartTime = this->dataPtr->startTime;
@@ -1489,8 +2228,13 @@ void World::Reset()
 
     this->ResetTime();
     this->ResetEntities(Base::BASE);
+
+    // The last snapshot describes the state before the reset.
+    std::atomic_store(&this->dataPtr->latestSnapshot,
+        std::shared_ptr<const WorldSnapshot>());
     for (auto &plugin : this->dataPtr->plugins)
     {
+      common::PluginScope scope(plugin->GetFilename(), plugin->GetHandle());
       plugin->Reset();
     }
     this->dataPtr->physicsEngine->Reset();
@@ -1763,19 +2507,315 @@ void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
 
 
 //////////////////////////////////////////////////
-// void World::ModelUpdateTBB()
-// {
-//   tbb::parallel_for (tbb::blocked_range<size_t>(0,
-//   this->dataPtr->models.size(), 10),
-//       ModelUpdate_TBB(&this->dataPtr->models));
-// }
+bool World::UpdateCrowd()
+{
+  unsigned int threshold =
+    this->dataPtr->physicsEngine->ParallelActorUpdateThreshold();
+  if (threshold == 0)
+    return false;
+
+  Actor_V &actors = this->dataPtr->crowdActors;
+  actors.clear();
+  for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
+  {
+    BasePtr child = this->dataPtr->rootElement->GetChild(i);
+    if (child->HasType(Base::ACTOR))
+      actors.push_back(boost::static_pointer_cast<Actor>(child));
+  }
+  if (actors.size() < threshold)
+    return false;
+
+  IGN_PROFILE("World::UpdateCrowd");
+
+  // Evaluating the animations only touches the state of each actor.
+  std::vector<char> apply(actors.size(), 0);
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, actors.size()),
+      [&actors, &apply](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+          apply[i] = actors[i]->EvaluateFrame();
+      });
+
+  // Moving the links goes through the world, so it stays serial.
+  msgs::PoseAnimation_V &msg = this->dataPtr->skeletonPoseBatchMsg;
+  int count = 0;
+  for (size_t i = 0; i < actors.size(); ++i)
+  {
+    if (!apply[i])
+      continue;
+
+    msgs::PoseAnimation *poseMsg = count < msg.pose_animation_size() ?
+        msg.mutable_pose_animation(count) : msg.add_pose_animation();
+    if (actors[i]->ApplyFrame(*poseMsg))
+      ++count;
+  }
+
+  while (msg.pose_animation_size() > count)
+    msg.mutable_pose_animation()->RemoveLast();
+
+  if (count > 0 && this->dataPtr->skeletonPoseBatchPub &&
+      this->dataPtr->skeletonPoseBatchPub->HasConnections())
+  {
+    this->dataPtr->skeletonPoseBatchPub->Publish(msg);
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void World::ModelUpdateTBB()
+{
+  // Actors updated as a crowd are skipped below.
+  const bool crowd = this->UpdateCrowd();
+
+  unsigned int threshold =
+    this->dataPtr->physicsEngine->ParallelModelUpdateThreshold();
+  if (threshold == 0 || this->dataPtr->models.size() < threshold)
+  {
+    this->ModelUpdateSingleLoop(crowd);
+    return;
+  }
+
+  IGN_PROFILE("World::ModelUpdateTBB");
+
+  // Lights, actors and static models are updated serially. Actors move
+  // their links kinematically and publish skeleton poses, and static
+  // models return from Model::Update straight away.
+  //
+  // Unlike ModelUpdateSingleLoop, which updates the children in world
+  // order, the update order here is: first all the serial children, in
+  // world order, then the dynamic models, in parallel and in no set
+  // order. Code that relies on an actor or light updating after a given
+  // model must not depend on the world order once the model count
+  // reaches the parallel threshold.
+  this->dataPtr->parallelUpdateModels.clear();
+  for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
+  {
+    BasePtr child = this->dataPtr->rootElement->GetChild(i);
+    if (child->HasType(Base::MODEL) && !child->HasType(Base::ACTOR))
+    {
+      ModelPtr model = boost::static_pointer_cast<Model>(child);
+      if (!model->IsStatic() && !model->IsSleeping())
+        this->dataPtr->parallelUpdateModels.push_back(model);
+    }
+    else if (!crowd || !child->HasType(Base::ACTOR))
+      child->Update();
+  }
+
+  // Grain size of one: the cost of a model update varies a lot with the
+  // number of joints and connected plugins.
+  common::ThreadRoles::Instance()->Execute("world", [this]()
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0,
+        this->dataPtr->parallelUpdateModels.size(), 1),
+        ModelUpdate_TBB(&this->dataPtr->parallelUpdateModels));
+  });
+}
+
+//////////////////////////////////////////////////
+void World::WakeSleepingModels()
+{
+  Model_V sleeping;
+  for (auto const &model : this->dataPtr->models)
+  {
+    if (model->IsSleeping())
+      sleeping.push_back(model);
+  }
+  if (sleeping.empty())
+    return;
+
+  const PhysicsEnginePtr &physics = this->dataPtr->physicsEngine;
+  const bool sleepEnabled = physics->SleepTime() > 0;
+  const double linear = physics->SleepLinearVelocity();
+  const double angular = physics->SleepAngularVelocity();
+
+  std::vector<ignition::math::AxisAlignedBox> awakeBoxes;
+  for (auto const &model : this->dataPtr->models)
+  {
+    if (!model->IsSleeping() && !model->IsStatic())
+      awakeBoxes.push_back(model->CollisionBoundingBox());
+  }
+
+  for (auto const &model : sleeping)
+  {
+    bool wake = !sleepEnabled || model->SleepDisturbed(linear, angular);
+
+    // Wake on contact: inflate the box a little so that a body resting on
+    // top of a sleeping one wakes it before they interpenetrate.
+    if (!wake && !awakeBoxes.empty())
+    {
+      ignition::math::AxisAlignedBox box = model->CollisionBoundingBox();
+      const ignition::math::Vector3d margin(0.01, 0.01, 0.01);
+      box = ignition::math::AxisAlignedBox(box.Min() - margin,
+          box.Max() + margin);
+      for (auto const &other : awakeBoxes)
+      {
+        if (box.Intersects(other))
+        {
+          wake = true;
+          break;
+        }
+      }
+    }
+
+    if (wake)
+      model->Wake();
+  }
+}
+
+//////////////////////////////////////////////////
+void World::SleepRestingModels()
+{
+  const PhysicsEnginePtr &physics = this->dataPtr->physicsEngine;
+  const double sleepTime = physics->SleepTime();
+  if (sleepTime <= 0)
+    return;
+
+  const double dt = physics->GetMaxStepSize();
+  for (auto const &model : this->dataPtr->models)
+  {
+    if (!model->IsSleeping() && model->CanSleep())
+    {
+      model->UpdateSleep(dt, physics->SleepLinearVelocity(),
+          physics->SleepAngularVelocity(), sleepTime);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+double World::AdaptStepSize()
+{
+  const PhysicsEnginePtr &physics = this->dataPtr->physicsEngine;
+  const double minStepSize = physics->AdaptiveMinStepSize();
+  double stepSize = physics->GetMaxStepSize();
+  ContactManager *contactManager = physics->GetContactManager();
+
+  if (minStepSize <= 0)
+  {
+    if (!this->dataPtr->adaptiveStepping)
+      return stepSize;
+
+    // Back to fixed steps
+    this->dataPtr->adaptiveStepping = false;
+    if (this->dataPtr->adaptiveNeverDropContacts)
+    {
+      contactManager->SetNeverDropContacts(false);
+      this->dataPtr->adaptiveNeverDropContacts = false;
+    }
+    if (stepSize == this->dataPtr->adaptiveStepSize)
+    {
+      physics->SetMaxStepSize(this->dataPtr->fixedStepSize);
+      stepSize = this->dataPtr->fixedStepSize;
+    }
+    return stepSize;
+  }
+
+  if (!this->dataPtr->adaptiveStepping)
+  {
+    this->dataPtr->adaptiveStepping = true;
+    this->dataPtr->fixedStepSize = stepSize;
+    this->dataPtr->adaptiveStepBounds = std::make_pair(0.0, 0.0);
+    this->dataPtr->adaptiveContactCount = 0;
+
+    // Contacts tell when impacts happen
+    if (!contactManager->NeverDropContacts())
+    {
+      contactManager->SetNeverDropContacts(true);
+      this->dataPtr->adaptiveNeverDropContacts = true;
+    }
+  }
+  else if (stepSize != this->dataPtr->adaptiveStepSize)
+  {
+    // The max step size was set by someone else, e.g. a preset
+    this->dataPtr->fixedStepSize = stepSize;
+  }
+
+  double maxStepSize = physics->AdaptiveMaxStepSize();
+  if (maxStepSize <= 0)
+    maxStepSize = this->dataPtr->fixedStepSize;
+  maxStepSize = std::max(maxStepSize, minStepSize);
+
+  StepSizeController &controller = this->dataPtr->stepSizeController;
+  const auto bounds = std::make_pair(minStepSize, maxStepSize);
+  if (bounds != this->dataPtr->adaptiveStepBounds)
+  {
+    controller.SetBounds(minStepSize, maxStepSize);
+    this->dataPtr->adaptiveStepBounds = bounds;
+  }
+
+  // New contacts are impacts, and deep contacts large constraint errors
+  const unsigned int contactCount = contactManager->GetContactCount();
+  bool eventful = contactCount > this->dataPtr->adaptiveContactCount;
+  this->dataPtr->adaptiveContactCount = contactCount;
+
+  const double maxDepth = physics->AdaptiveMaxContactDepth();
+  for (unsigned int i = 0; !eventful && maxDepth > 0 && i < contactCount;
+       ++i)
+  {
+    const Contact *contact = contactManager->GetContact(i);
+    for (int j = 0; contact && j < contact->count; ++j)
+    {
+      if (contact->depths[j] > maxDepth)
+      {
+        eventful = true;
+        break;
+      }
+    }
+  }
+
+  double limit = 0;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->stepSizeCriteriaMutex);
+    for (auto const &criterion : this->dataPtr->stepSizeCriteria)
+    {
+      const double criterionLimit = criterion.second(this->dataPtr->simTime);
+      if (criterionLimit > 0 && (limit <= 0 || criterionLimit < limit))
+        limit = criterionLimit;
+    }
+  }
+
+  stepSize = controller.Update(this->dataPtr->simTime.Double(), eventful,
+      limit);
+  if (stepSize != physics->GetMaxStepSize())
+    physics->SetMaxStepSize(stepSize);
+  this->dataPtr->adaptiveStepSize = stepSize;
+
+  return stepSize;
+}
+
+//////////////////////////////////////////////////
+void World::SetStepSizeCriterion(const std::string &_name,
+    const StepSizeCriterion &_criterion)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->stepSizeCriteriaMutex);
+  if (_criterion)
+    this->dataPtr->stepSizeCriteria[_name] = _criterion;
+  else
+    this->dataPtr->stepSizeCriteria.erase(_name);
+}
+
+//////////////////////////////////////////////////
+unsigned int World::SleepingLinkCount() const
+{
+  unsigned int count = 0;
+  for (auto const &model : this->dataPtr->models)
+  {
+    if (model->IsSleeping())
+      count += model->LinkCountRecursive();
+  }
+  return count;
+}
 
 //////////////////////////////////////////////////
-void World::ModelUpdateSingleLoop()
+void World::ModelUpdateSingleLoop(const bool _skipActors)
 {
   // Update all the models
   for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
-    this->dataPtr->rootElement->GetChild(i)->Update();
+  {
+    BasePtr child = this->dataPtr->rootElement->GetChild(i);
+    if (!_skipActors || !child->HasType(Base::ACTOR))
+      child->Update();
+  }
 }
 
 
@@ -1822,6 +2862,8 @@ void World::LoadPlugin(const std::string &_filename,
             << "Plugin filename[" << _filename << "] name[" << _name << "]\n";
       return;
     }
+    // The callbacks connected by the plugin are charged to it
+    common::PluginScope scope(_filename, _name);
     plugin->Load(shared_from_this(), _sdf);
     this->dataPtr->plugins.push_back(plugin);
 
@@ -1884,7 +2926,7 @@ void World::ProcessRequestMsgs()
 
     if (requestMsg.request() == "entity_list")
     {
-      msgs::Model_V modelVMsg;
+      auto modelVMsg = std::make_shared<msgs::Model_V>();
 
       for (unsigned int i = 0;
           i < this->dataPtr->rootElement->GetChildCount(); ++i)
@@ -1892,15 +2934,15 @@ void World::ProcessRequestMsgs()
         BasePtr entity = this->dataPtr->rootElement->GetChild(i);
         if (entity->HasType(Base::MODEL))
         {
-          msgs::Model *modelMsg = modelVMsg.add_models();
+          msgs::Model *modelMsg = modelVMsg->add_models();
           ModelPtr model = boost::dynamic_pointer_cast<Model>(entity);
           model->FillMsg(*modelMsg);
         }
       }
 
-      response.set_type(modelVMsg.GetTypeName());
-      std::string *serializedData = response.mutable_serialized_data();
-      modelVMsg.SerializeToString(serializedData);
+      response.set_type(modelVMsg->GetTypeName());
+      QueueResponse(*this->dataPtr, response, modelVMsg);
+      send = false;
     }
     else if (requestMsg.request() == "entity_delete")
     {
@@ -1909,8 +2951,7 @@ void World::ProcessRequestMsgs()
     }
     else if (requestMsg.request() == "entity_info")
     {
-      BasePtr entity(
-        this->dataPtr->rootElement->GetByName(requestMsg.data()));
+      BasePtr entity(this->BaseByName(requestMsg.data()));
       if (entity)
       {
         if (entity->HasType(Base::MODEL))
@@ -1991,28 +3032,36 @@ void World::ProcessRequestMsgs()
         }
       }
 
-      msgs::GzString msg;
-      std::ostringstream stream;
-      stream << "<?xml version='1.0'?>\n"
-             << "<sdf version='" << SDF_VERSION << "'>\n"
-             << newSdf->ToString("")
-             << "</sdf>";
-
-      msg.set_data(stream.str());
-
-      std::string *serializedData = response.mutable_serialized_data();
-      msg.SerializeToString(serializedData);
-      response.set_type(msg.GetTypeName());
+      // Printing a large world takes long, so the worker prints a copy
+      // of the current state.
+      sdf::ElementPtr sdfCopy = newSdf->Clone();
+      response.set_type(msgs::GzString().GetTypeName());
+      QueueResponse(*this->dataPtr, response,
+          [sdfCopy](std::string &_data)
+          {
+            msgs::GzString msg;
+            std::ostringstream stream;
+            stream << "<?xml version='1.0'?>\n"
+                   << "<sdf version='" << SDF_VERSION << "'>\n"
+                   << sdfCopy->ToString("")
+                   << "</sdf>";
+            msg.set_data(stream.str());
+            msg.SerializeToString(&_data);
+          });
+      send = false;
     }
     else if (requestMsg.request() == "scene_info")
     {
-      this->dataPtr->sceneMsg.clear_model();
-      this->dataPtr->sceneMsg.clear_light();
-      this->BuildSceneMsg(this->dataPtr->sceneMsg, this->dataPtr->rootElement);
-
-      std::string *serializedData = response.mutable_serialized_data();
-      this->dataPtr->sceneMsg.SerializeToString(serializedData);
-      response.set_type(this->dataPtr->sceneMsg.GetTypeName());
+      // The scene is filled from the state of this step, and serialized
+      // and sent by the response worker.
+      auto scene = std::make_shared<msgs::Scene>(this->dataPtr->sceneMsg);
+      scene->clear_model();
+      scene->clear_light();
+      this->BuildSceneMsg(*scene, this->dataPtr->rootElement);
+
+      response.set_type(scene->GetTypeName());
+      QueueResponse(*this->dataPtr, response, scene);
+      send = false;
 
       for (auto road : this->dataPtr->roads)
       {
@@ -2029,6 +3078,29 @@ void World::ProcessRequestMsgs()
       sphereCoordMsg.SerializeToString(serializedData);
       response.set_type(sphereCoordMsg.GetTypeName());
     }
+    else if (requestMsg.request() == "trace_start")
+    {
+      // data is the trace file, dbl_data the duration of the capture
+      common::TraceCapture *trace = common::TraceCapture::Instance();
+      double duration = common::TraceCapture::kDefaultDuration;
+      if (requestMsg.has_dbl_data())
+        duration = requestMsg.dbl_data();
+
+      if (trace->Start(requestMsg.data(), duration))
+      {
+        msgs::GzString filenameMsg;
+        filenameMsg.set_data(trace->Filename());
+        filenameMsg.SerializeToString(response.mutable_serialized_data());
+        response.set_type(filenameMsg.GetTypeName());
+      }
+      else
+        response.set_response("failure");
+    }
+    else if (requestMsg.request() == "trace_stop")
+    {
+      if (!common::TraceCapture::Instance()->Stop())
+        response.set_response("failure");
+    }
     else
       send = false;
 
@@ -2168,9 +3240,11 @@ void World::ProcessLightFactoryMsgs()
 void World::ProcessFactoryMsgs()
 {
   IGN_PROFILE("World::ProcessFactoryMsgs");
-  std::list<sdf::ElementPtr> modelsToLoad, lightsToLoad;
+  std::list<std::pair<sdf::ElementPtr, ModelPoolEntry>> modelsToLoad;
+  std::list<sdf::ElementPtr> lightsToLoad;
 
   std::list<msgs::Factory> factoryMsgsCopy;
+  std::list<std::vector<sdf::ElementPtr>> factoryModelsCopy;
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
 
@@ -2178,10 +3252,25 @@ void World::ProcessFactoryMsgs()
       this->dataPtr->factoryMsgs.end(),
       std::back_inserter(factoryMsgsCopy));
     this->dataPtr->factoryMsgs.clear();
+    factoryModelsCopy.swap(this->dataPtr->factoryModels);
   }
 
   for (auto const &factoryMsg : factoryMsgsCopy)
   {
+    // Only models spawned from an SDF string or file can be pooled, and
+    // a pooled model is reused for the same string or file.
+    std::string poolKey;
+    if (this->dataPtr->modelPoolSize > 0 && !factoryMsg.has_edit_name())
+    {
+      if (factoryMsg.has_sdf() && !factoryMsg.sdf().empty())
+        poolKey = "sdf:" + factoryMsg.sdf();
+      else if (factoryMsg.has_sdf_filename() &&
+          !factoryMsg.sdf_filename().empty())
+        poolKey = "file:" + factoryMsg.sdf_filename();
+    }
+
+    if (!poolKey.empty() && this->ReusePooledModel(poolKey, factoryMsg))
+      continue;
 
     this->dataPtr->factorySDF->Clear();
 
@@ -2197,28 +3286,63 @@ void World::ProcessFactoryMsgs()
     else if (factoryMsg.has_sdf_filename() &&
             !factoryMsg.sdf_filename().empty())
     {
-      std::string filename;
-      // If http(s), look at Fuel
-      auto uri = ignition::common::URI(factoryMsg.sdf_filename());
-      if (uri.Valid() && (uri.Scheme() == "https" || uri.Scheme() == "http"))
+      // Spawning the same model file many times only parses it once, as
+      // long as the file is not modified in between.
+      auto parsed =
+          this->dataPtr->parsedSDFFiles.find(factoryMsg.sdf_filename());
+      if (parsed != this->dataPtr->parsedSDFFiles.end())
       {
-        filename = common::FuelModelDatabase::Instance()->ModelFile(
-            factoryMsg.sdf_filename());
-      }
-      // Otherwise, look at database
-      else
-      {
-        filename = common::ModelDatabase::Instance()->GetModelFile(
-            factoryMsg.sdf_filename());
+        boost::system::error_code ec;
+        std::time_t modified =
+            boost::filesystem::last_write_time(parsed->second.filename, ec);
+        if (!ec && modified == parsed->second.modified)
+        {
+          this->dataPtr->factorySDF->Root(parsed->second.root->Clone());
+        }
+        else
+        {
+          this->dataPtr->parsedSDFFiles.erase(parsed);
+          parsed = this->dataPtr->parsedSDFFiles.end();
+        }
       }
 
-      if (!sdf::readFile(filename, this->dataPtr->factorySDF))
+      if (parsed == this->dataPtr->parsedSDFFiles.end())
       {
-        gzerr << "Unable to read sdf file [" << filename << "]\n";
-        continue;
-      }
+        std::string filename;
+        // If http(s), look at Fuel
+        auto uri = ignition::common::URI(factoryMsg.sdf_filename());
+        if (uri.Valid() &&
+            (uri.Scheme() == "https" || uri.Scheme() == "http"))
+        {
+          filename = common::FuelModelDatabase::Instance()->ModelFile(
+              factoryMsg.sdf_filename());
+        }
+        // Otherwise, look at database
+        else
+        {
+          filename = common::ModelDatabase::Instance()->GetModelFile(
+              factoryMsg.sdf_filename());
+        }
+
+        if (!sdf::readFile(filename, this->dataPtr->factorySDF))
+        {
+          gzerr << "Unable to read sdf file [" << filename << "]\n";
+          continue;
+        }
+
+        common::convertToFullPaths(this->dataPtr->factorySDF->Root());
 
-      common::convertToFullPaths(this->dataPtr->factorySDF->Root());
+        boost::system::error_code ec;
+        std::time_t modified = boost::filesystem::last_write_time(filename, ec);
+        if (!ec)
+        {
+          ParsedSDFFile &entry =
+              this->dataPtr->parsedSDFFiles[factoryMsg.sdf_filename()];
+          entry.filename = filename;
+          entry.modified = modified;
+          entry.root = this->dataPtr->factorySDF->Root()->Clone();
+        }
+      }
     }
     else if (factoryMsg.has_clone_model_name())
     {
@@ -2248,8 +3372,7 @@ void World::ProcessFactoryMsgs()
 
     if (factoryMsg.has_edit_name())
     {
-      BasePtr base(
-        this->dataPtr->rootElement->GetByName(factoryMsg.edit_name()));
+      BasePtr base(this->BaseByName(factoryMsg.edit_name()));
       if (base)
       {
         sdf::ElementPtr elem;
@@ -2303,6 +3426,14 @@ void World::ProcessFactoryMsgs()
 
       elem->SetParent(this->dataPtr->sdf);
       elem->GetParent()->InsertElement(elem);
+
+      ModelPoolEntry poolEntry;
+      if (isModel && !poolKey.empty())
+      {
+        poolEntry.key = poolKey;
+        poolEntry.pose = elem->Get<ignition::math::Pose3d>("pose");
+      }
+
       if (factoryMsg.has_pose())
       {
         elem->GetElement("pose")->Set(msgs::ConvertIgn(factoryMsg.pose()));
@@ -2338,9 +3469,12 @@ void World::ProcessFactoryMsgs()
 
           entityName = this->UniqueModelName(entityName);
           elem->GetAttribute("name")->Set(entityName);
+
+          // A renamed model does not match its SDF anymore
+          poolEntry.key.clear();
         }
 
-        modelsToLoad.push_back(elem);
+        modelsToLoad.push_back(std::make_pair(elem, poolEntry));
       }
       else if (isLight)
       {
@@ -2350,15 +3484,19 @@ void World::ProcessFactoryMsgs()
   }
 
   // Load models
-  for (auto const &elem : modelsToLoad)
+  for (auto const &toLoad : modelsToLoad)
   {
     try
     {
       std::lock_guard<std::mutex> lock(this->dataPtr->factoryDeleteMutex);
 
-      ModelPtr model = this->LoadModel(elem, this->dataPtr->rootElement);
+      ModelPtr model = this->LoadModel(toLoad.first,
+          this->dataPtr->rootElement);
       if (model != nullptr)
       {
+        if (!toLoad.second.key.empty())
+          this->dataPtr->modelPoolKeys[model->GetName()] = toLoad.second;
+
         model->Init();
         model->LoadPlugins(this->dataPtr->modelPluginLoadingTimeout);
       }
@@ -2369,24 +3507,44 @@ void World::ProcessFactoryMsgs()
     }
   }
 
-  // Load lights
-  for (auto const &elem : lightsToLoad)
+  // Load model batches
+  for (auto const &batch : factoryModelsCopy)
   {
     try
     {
       std::lock_guard<std::mutex> lock(this->dataPtr->factoryDeleteMutex);
 
-      LightPtr light = this->LoadLight(elem, this->dataPtr->rootElement);
-      light->Init();
+      for (auto const &model :
+          this->LoadModels(batch, this->dataPtr->rootElement))
+      {
+        model->Init();
+        model->LoadPlugins(this->dataPtr->modelPluginLoadingTimeout);
+      }
     }
     catch(...)
     {
-      gzerr << "Loading light from factory message failed\n";
+      gzerr << "Loading model batch failed\n";
     }
   }
-}
 
-//////////////////////////////////////////////////
+  // Load lights
+  for (auto const &elem : lightsToLoad)
+  {
+    try
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->factoryDeleteMutex);
+
+      LightPtr light = this->LoadLight(elem, this->dataPtr->rootElement);
+      light->Init();
+    }
+    catch(...)
+    {
+      gzerr << "Loading light from factory message failed\n";
+    }
+  }
+}
+
+//////////////////////////////////////////////////
 ModelPtr World::ModelBelowPoint(const ignition::math::Vector3d &_pt) const
 {
   ModelPtr model;
@@ -2573,6 +3731,259 @@ void World::InsertModelString(const std::string &_sdfString)
   this->dataPtr->factoryMsgs.push_back(msg);
 }
 
+//////////////////////////////////////////////////
+std::string World::StateSnapshot() const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+
+  Link_V links;
+  Joint_V joints;
+  StateSnapshotHeader header = StateSnapshotHeader();
+  header.layout = 14695981039346656037ull;
+  for (auto const &model : this->dataPtr->models)
+    CollectSnapshotEntities(model, links, joints, header.layout);
+
+  std::vector<double> values;
+  values.reserve(links.size() * kStateSnapshotLinkValues + joints.size());
+  for (auto const &link : links)
+  {
+    const ignition::math::Pose3d pose = link->WorldPose();
+    const ignition::math::Vector3d linearVel = link->WorldLinearVel();
+    const ignition::math::Vector3d angularVel = link->WorldAngularVel();
+    values.insert(values.end(), {
+        pose.Pos().X(), pose.Pos().Y(), pose.Pos().Z(),
+        pose.Rot().W(), pose.Rot().X(), pose.Rot().Y(), pose.Rot().Z(),
+        linearVel.X(), linearVel.Y(), linearVel.Z(),
+        angularVel.X(), angularVel.Y(), angularVel.Z()});
+  }
+
+  for (auto const &joint : joints)
+  {
+    for (unsigned int i = 0; i < joint->DOF(); ++i)
+      values.push_back(joint->Position(i));
+  }
+
+  header.magic = kStateSnapshotMagic;
+  header.linkCount = links.size();
+  header.positionCount = values.size() - links.size() *
+    kStateSnapshotLinkValues;
+  header.iterations = this->dataPtr->iterations;
+  header.simTime = this->dataPtr->simTime.Double();
+
+  std::string snapshot(sizeof(header) + values.size() * sizeof(double), '\0');
+  std::memcpy(&snapshot[0], &header, sizeof(header));
+  if (!values.empty())
+  {
+    std::memcpy(&snapshot[sizeof(header)], values.data(),
+        values.size() * sizeof(double));
+  }
+  return snapshot;
+}
+
+//////////////////////////////////////////////////
+bool World::RestoreStateSnapshot(const std::string &_snapshot)
+{
+  StateSnapshotHeader header;
+  if (_snapshot.size() < sizeof(header))
+  {
+    gzerr << "Invalid state snapshot" << std::endl;
+    return false;
+  }
+  std::memcpy(&header, _snapshot.data(), sizeof(header));
+
+  const size_t valueCount = header.linkCount * kStateSnapshotLinkValues +
+    header.positionCount;
+  if (header.magic != kStateSnapshotMagic ||
+      _snapshot.size() != sizeof(header) + valueCount * sizeof(double))
+  {
+    gzerr << "Invalid state snapshot" << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  boost::recursive_mutex::scoped_lock plock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+
+  Link_V links;
+  Joint_V joints;
+  uint64_t layout = 14695981039346656037ull;
+  for (auto const &model : this->dataPtr->models)
+    CollectSnapshotEntities(model, links, joints, layout);
+
+  if (layout != header.layout || links.size() != header.linkCount)
+  {
+    gzerr << "State snapshot was taken from different models" << std::endl;
+    return false;
+  }
+
+  std::vector<double> values(valueCount);
+  if (valueCount > 0)
+  {
+    std::memcpy(values.data(), _snapshot.data() + sizeof(header),
+        valueCount * sizeof(double));
+  }
+
+  // Write the links straight into the physics engine
+  const double *v = values.data();
+  for (auto const &link : links)
+  {
+    link->SetWorldPose(ignition::math::Pose3d(
+          v[0], v[1], v[2], v[3], v[4], v[5], v[6]), true, false);
+    link->SetLinearVel(ignition::math::Vector3d(v[7], v[8], v[9]));
+    link->SetAngularVel(ignition::math::Vector3d(v[10], v[11], v[12]));
+    link->SetForce(ignition::math::Vector3d::Zero);
+    link->SetTorque(ignition::math::Vector3d::Zero);
+    v += kStateSnapshotLinkValues;
+  }
+
+  // Link poses define the joint positions of maximal coordinate engines.
+  // The other engines need the joint positions themselves.
+  const std::string type = this->dataPtr->physicsEngine->GetType();
+  const bool setPositions = type != "ode" && type != "bullet";
+  for (auto const &joint : joints)
+  {
+    for (unsigned int i = 0; i < joint->DOF(); ++i, ++v)
+    {
+      if (setPositions)
+        joint->SetPosition(i, *v);
+    }
+  }
+
+  this->dataPtr->iterations = header.iterations;
+  this->SetSimTime(common::Time(header.simTime));
+
+  for (auto const &model : this->dataPtr->models)
+    this->PublishModelPose(model);
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void World::SetModelPoolSize(const unsigned int _size)
+{
+  boost::recursive_mutex::scoped_lock plock(
+      *this->Physics()->GetPhysicsUpdateMutex());
+  std::lock_guard<std::mutex> flock(this->dataPtr->factoryDeleteMutex);
+
+  this->dataPtr->modelPoolSize = _size;
+  this->TrimModelPool(_size);
+}
+
+//////////////////////////////////////////////////
+unsigned int World::ModelPoolSize() const
+{
+  return this->dataPtr->modelPoolSize;
+}
+
+//////////////////////////////////////////////////
+bool World::PoolModel(const ModelPtr &_model, const sdf::ElementPtr &_sdf)
+{
+  auto keyIter = this->dataPtr->modelPoolKeys.find(_model->GetName());
+  if (keyIter == this->dataPtr->modelPoolKeys.end())
+    return false;
+
+  ModelPoolEntry entry = keyIter->second;
+  this->dataPtr->modelPoolKeys.erase(keyIter);
+
+  if (!_sdf ||
+      this->dataPtr->modelPool.size() >= this->dataPtr->modelPoolSize ||
+      this->dataPtr->modelPool.find(entry.key) !=
+      this->dataPtr->modelPool.end())
+  {
+    return false;
+  }
+
+  // Models that run code or produce data of their own are not kept
+  if (_model->GetPluginCount() > 0 || _model->GetSensorCount() > 0 ||
+      !_model->NestedModels().empty())
+  {
+    return false;
+  }
+
+  // Deactivate the model, so it neither moves nor collides
+  _model->SetEnabled(false);
+  for (auto const &link : _model->GetLinks())
+    link->SetCollideMode("none");
+
+  this->dataPtr->rootElement->DetachChild(_model);
+
+  entry.model = _model;
+  entry.sdf = _sdf;
+  this->dataPtr->modelPool[entry.key] = entry;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool World::ReusePooledModel(const std::string &_key,
+    const msgs::Factory &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->factoryDeleteMutex);
+
+  auto iter = this->dataPtr->modelPool.find(_key);
+  if (iter == this->dataPtr->modelPool.end())
+    return false;
+
+  // The name might have been taken since the model was deleted
+  ModelPoolEntry entry = iter->second;
+  if (this->ModelByName(entry.model->GetName()))
+    return false;
+  this->dataPtr->modelPool.erase(iter);
+
+  ModelPtr model = entry.model;
+  entry.model.reset();
+  entry.sdf->SetParent(this->dataPtr->sdf);
+  this->dataPtr->sdf->InsertElement(entry.sdf);
+  model->SetParent(this->dataPtr->rootElement);
+  this->dataPtr->rootElement->AddChild(model);
+
+  // Reset the pose, joints and velocities, as if the model was new
+  const ignition::math::Pose3d pose =
+    _msg.has_pose() ? msgs::ConvertIgn(_msg.pose()) : entry.pose;
+  entry.sdf->GetElement("pose")->Set(pose);
+  model->SetInitialRelativePose(pose);
+  model->Reset();
+  model->Reset(Base::LINK);
+
+  for (auto const &link : model->GetLinks())
+    link->SetCollideMode(link->IsStatic() ? "fixed" : "all");
+  model->SetEnabled(true);
+
+  entry.sdf.reset();
+  this->dataPtr->modelPoolKeys[model->GetName()] = entry;
+
+  event::Events::addEntity(model->GetScopedName());
+
+  msgs::Model msg;
+  model->FillMsg(msg);
+  this->dataPtr->modelPub->Publish(msg);
+
+  this->PublishModelPose(model);
+  this->dataPtr->models.push_back(model);
+  ++this->dataPtr->logEntityChanges;
+  this->EnableAllModels();
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void World::TrimModelPool(const unsigned int _size)
+{
+  auto iter = this->dataPtr->modelPool.begin();
+  while (this->dataPtr->modelPool.size() > _size &&
+      iter != this->dataPtr->modelPool.end())
+  {
+    iter->second.model->Fini();
+    iter = this->dataPtr->modelPool.erase(iter);
+  }
+}
+
+//////////////////////////////////////////////////
+void World::InsertModels(const std::vector<sdf::ElementPtr> &_models)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  this->dataPtr->factoryModels.push_back(_models);
+}
+
 //////////////////////////////////////////////////
 std::string World::StripWorldName(const std::string &_name) const
 {
@@ -2778,6 +4189,131 @@ bool World::OnLog(std::ostringstream &_stream)
   return true;
 }
 
+//////////////////////////////////////////////////
+void World::PublishPoseDelta()
+{
+  this->dataPtr->poseDeltaModels.insert(
+      this->dataPtr->publishModelPoses.begin(),
+      this->dataPtr->publishModelPoses.end());
+  this->dataPtr->poseDeltaLights.insert(
+      this->dataPtr->publishLightPoses.begin(),
+      this->dataPtr->publishLightPoses.end());
+
+  common::Time now = common::Time::GetWallTime();
+  if (this->dataPtr->poseDeltaCount > 0 &&
+      (now - this->dataPtr->poseDeltaPrevTime).Double() < 1.0 / 60.0)
+  {
+    return;
+  }
+  this->dataPtr->poseDeltaPrevTime = now;
+
+  const bool keyframe = this->dataPtr->poseDeltaCount == 0;
+  this->dataPtr->poseDeltaCount = (this->dataPtr->poseDeltaCount + 1) %
+      this->dataPtr->poseDeltaKeyframePeriod;
+
+  msgs::PosesDelta msg;
+  msgs::Set(msg.mutable_time(), this->SimTime());
+  msg.set_keyframe(keyframe);
+  msg.set_position_resolution(this->dataPtr->poseDeltaResolution);
+
+  if (keyframe)
+    this->dataPtr->poseDeltaSent.clear();
+
+  auto addPose = [&](const BasePtr &_entity,
+      const ignition::math::Pose3d &_pose)
+  {
+    auto &sent = this->dataPtr->poseDeltaSent;
+    auto iter = sent.find(_entity->GetId());
+    if (!keyframe && iter != sent.end())
+    {
+      const ignition::math::Quaterniond &a = iter->second.Rot();
+      const ignition::math::Quaterniond &b = _pose.Rot();
+      double dot = std::abs(a.W() * b.W() + a.X() * b.X() + a.Y() * b.Y() +
+          a.Z() * b.Z());
+      double angle = 2.0 * std::acos(std::min(1.0, dot));
+      if (iter->second.Pos().Distance(_pose.Pos()) <=
+            this->dataPtr->poseDeltaLinear &&
+          angle <= this->dataPtr->poseDeltaAngular)
+      {
+        return;
+      }
+    }
+    sent[_entity->GetId()] = _pose;
+
+    msgs::PosesDelta::Pose *poseMsg = msg.add_pose();
+    poseMsg->set_id(_entity->GetId());
+    if (keyframe)
+      poseMsg->set_name(_entity->GetScopedName());
+    msgs::Set(poseMsg, _pose, this->dataPtr->poseDeltaResolution);
+  };
+
+  std::list<ModelPtr> modelList;
+  if (keyframe)
+  {
+    modelList.insert(modelList.end(), this->dataPtr->models.begin(),
+        this->dataPtr->models.end());
+  }
+  else
+  {
+    modelList.insert(modelList.end(), this->dataPtr->poseDeltaModels.begin(),
+        this->dataPtr->poseDeltaModels.end());
+  }
+
+  while (!modelList.empty())
+  {
+    ModelPtr m = modelList.front();
+    modelList.pop_front();
+
+    addPose(m, m->RelativePose());
+    for (auto const &link : m->GetLinks())
+      addPose(link, link->RelativePose());
+
+    for (auto const &n : m->NestedModels())
+      modelList.push_back(n);
+  }
+
+  if (keyframe)
+  {
+    for (auto const &light : this->dataPtr->lights)
+      addPose(light, light->RelativePose());
+  }
+  else
+  {
+    for (auto const &light : this->dataPtr->poseDeltaLights)
+      addPose(light, light->RelativePose());
+  }
+
+  this->dataPtr->poseDeltaModels.clear();
+  this->dataPtr->poseDeltaLights.clear();
+
+  if (keyframe || msg.pose_size() > 0)
+    this->dataPtr->poseDeltaPub->Publish(msg);
+}
+
+//////////////////////////////////////////////////
+bool World::SetPoseDeltaParams(const double _linear, const double _angular,
+    const double _resolution, const unsigned int _keyframePeriod)
+{
+  if (_linear < 0 || _angular < 0 || _resolution <= 0 ||
+      _keyframePeriod == 0)
+  {
+    gzerr << "Invalid compact pose stream parameters: thresholds must not "
+          << "be negative, and the resolution and keyframe period must be "
+          << "positive.\n";
+    return false;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  this->dataPtr->poseDeltaLinear = _linear;
+  this->dataPtr->poseDeltaAngular = _angular;
+  this->dataPtr->poseDeltaResolution = _resolution;
+  this->dataPtr->poseDeltaKeyframePeriod = _keyframePeriod;
+
+  // The next message is a keyframe in the new encoding
+  this->dataPtr->poseDeltaCount = 0;
+  return true;
+}
+
 //////////////////////////////////////////////////
 void World::ProcessMessages()
 {
@@ -2791,7 +4327,8 @@ void World::ProcessMessages()
         (this->dataPtr->poseLocalPub &&
          this->dataPtr->poseLocalPub->HasConnections()))
     {
-      msgs::PosesStamped msg;
+      msgs::PosesStamped &msg = this->dataPtr->posesMsg;
+      msg.Clear();
 
       // Time stamp this PosesStamped message
       msgs::Set(msg.mutable_time(), this->SimTime());
@@ -2862,6 +4399,17 @@ void World::ProcessMessages()
       }
     }
 
+    if (this->dataPtr->poseDeltaPub &&
+        this->dataPtr->poseDeltaPub->HasConnections())
+    {
+      this->PublishPoseDelta();
+    }
+    else
+    {
+      // Start with a keyframe once a subscriber connects
+      this->dataPtr->poseDeltaCount = 0;
+    }
+
     this->dataPtr->publishModelPoses.clear();
     this->dataPtr->publishLightPoses.clear();
   }
@@ -2962,6 +4510,12 @@ void World::PublishWorldStats()
 
   this->dataPtr->worldStatsMsg.set_iterations(this->dataPtr->iterations);
   this->dataPtr->worldStatsMsg.set_paused(this->IsPaused());
+  if (this->dataPtr->realTimeMode)
+  {
+    this->dataPtr->worldStatsMsg.set_overruns(this->dataPtr->overruns);
+    msgs::Set(this->dataPtr->worldStatsMsg.mutable_max_overrun(),
+        this->dataPtr->maxOverrun);
+  }
 
   if (util::LogPlay::Instance()->IsOpen())
   {
@@ -2978,6 +4532,93 @@ void World::PublishWorldStats()
   if (this->dataPtr->statPub && this->dataPtr->statPub->HasConnections())
     this->dataPtr->statPub->Publish(this->dataPtr->worldStatsMsg);
   this->dataPtr->prevStatTime = common::Time::GetWallTime();
+
+  // Timing statistics cover one second of wall clock time each.
+  if (this->dataPtr->timingPub && this->dataPtr->timingPub->HasConnections() &&
+      this->dataPtr->prevStatTime - this->dataPtr->prevTimingTime >=
+      common::Time(1, 0))
+  {
+    util::TimingStats::Instance()->FillMsg(this->dataPtr->timingMsg);
+    msgs::Set(this->dataPtr->timingMsg.mutable_sim_time(), this->SimTime());
+    this->dataPtr->timingPub->Publish(this->dataPtr->timingMsg);
+    this->dataPtr->prevTimingTime = this->dataPtr->prevStatTime;
+  }
+
+  // So are memory statistics
+  if (this->dataPtr->memoryPub && this->dataPtr->memoryPub->HasConnections() &&
+      this->dataPtr->prevStatTime - this->dataPtr->prevMemoryTime >=
+      common::Time(1, 0))
+  {
+    msgs::MemoryStatistics &msg = this->dataPtr->memoryMsg;
+    msg.clear_tag();
+    msgs::Set(msg.mutable_sim_time(), this->SimTime());
+    msg.set_resident_bytes(common::MemoryStats::ResidentBytes());
+
+    const std::vector<std::string> names =
+        common::MemoryStats::Instance()->TagNames();
+    for (unsigned int i = 0; i < names.size(); ++i)
+    {
+      msgs::MemoryStatistics::Tag *tag = msg.add_tag();
+      tag->set_name(names[i]);
+      tag->set_bytes(common::MemoryStats::Bytes(i));
+      tag->set_peak_bytes(common::MemoryStats::PeakBytes(i));
+      tag->set_objects(common::MemoryStats::Objects(i));
+    }
+    this->dataPtr->memoryPub->Publish(msg);
+    this->dataPtr->prevMemoryTime = this->dataPtr->prevStatTime;
+  }
+
+  // And solver statistics, from engines that report them
+  if (this->dataPtr->solverPub && this->dataPtr->solverPub->HasConnections() &&
+      this->dataPtr->physicsEngine &&
+      this->dataPtr->prevStatTime - this->dataPtr->prevSolverTime >=
+      common::Time(1, 0))
+  {
+    msgs::SolverStatistics &msg = this->dataPtr->solverMsg;
+    if (this->dataPtr->physicsEngine->FillSolverStatistics(msg))
+    {
+      msgs::Set(msg.mutable_sim_time(), this->SimTime());
+      this->dataPtr->solverPub->Publish(msg);
+    }
+    this->dataPtr->prevSolverTime = this->dataPtr->prevStatTime;
+  }
+
+  // Plugin callbacks are only timed while someone listens
+  const bool pluginStats = this->dataPtr->pluginStatsPub &&
+    this->dataPtr->pluginStatsPub->HasConnections();
+  if (pluginStats != this->dataPtr->pluginStatsEnabled)
+  {
+    if (pluginStats)
+      common::PluginStats::Enable();
+    else
+      common::PluginStats::Disable();
+    this->dataPtr->pluginStatsEnabled = pluginStats;
+  }
+
+  if (pluginStats && this->dataPtr->prevStatTime -
+      this->dataPtr->prevPluginStatsTime >= common::Time(1, 0))
+  {
+    msgs::PluginStatistics &msg = this->dataPtr->pluginStatsMsg;
+    msg.clear_callback();
+    msgs::Set(msg.mutable_sim_time(), this->SimTime());
+
+    double interval = 0;
+    for (auto const &sample :
+        common::PluginStats::Instance()->Collect(interval))
+    {
+      msgs::PluginStatistics::Callback *callback = msg.add_callback();
+      callback->set_filename(sample.filename);
+      callback->set_name(sample.name);
+      callback->set_event(sample.event);
+      callback->set_count(sample.calls);
+      callback->set_total(sample.ns * 1e-9);
+      callback->set_interval_count(sample.intervalCalls);
+      callback->set_interval_total(sample.intervalNs * 1e-9);
+    }
+    msg.set_interval(interval);
+    this->dataPtr->pluginStatsPub->Publish(msg);
+    this->dataPtr->prevPluginStatsTime = this->dataPtr->prevStatTime;
+  }
 }
 
 //////////////////////////////////////////////////
@@ -2993,6 +4634,10 @@ void World::PublishModelPose(physics::ModelPtr _model)
 
   // Only add if the model name is not in the list
   this->dataPtr->publishModelPoses.insert(_model);
+
+  ModelBoxIndexPtr boxIndex = this->BoxIndex();
+  if (boxIndex)
+    boxIndex->MarkDirty(_model);
 }
 
 //////////////////////////////////////////////////
@@ -3013,61 +4658,132 @@ void World::PublishLightPose(const physics::LightPtr _light)
   this->dataPtr->publishLightPoses.insert(_light);
 }
 
+//////////////////////////////////////////////////
+void World::CaptureLogState()
+{
+  util::LogRecord *logRecord = util::LogRecord::Instance();
+
+  // Capture a state whenever models or lights were inserted or deleted,
+  // otherwise throttle state capture based on log recording frequency.
+  uint64_t entityChanges = this->dataPtr->logEntityChanges;
+  bool insertDelete = entityChanges != this->dataPtr->logCapturedEntityChanges;
+  if (!insertDelete && this->dataPtr->simTime -
+      this->dataPtr->logLastStateTime < logRecord->Period())
+  {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
+    if (this->dataPtr->logSnapshots.size() >= logRecord->StateBufferSize())
+    {
+      if (logRecord->OverflowPolicy() == "drop")
+      {
+        // Retry on the next iteration, the snapshot that is eventually
+        // captured still reports the insertions and deletions.
+        logRecord->NotifyStateCapture(true);
+        return;
+      }
+
+      // Apply back pressure, wait until the log worker frees a slot.
+      this->dataPtr->logCondition.notify_one();
+      this->dataPtr->logContinueCondition.wait(lock, [this, logRecord]
+          {
+            return this->dataPtr->stop ||
+                this->dataPtr->logSnapshots.size() <
+                logRecord->StateBufferSize();
+          });
+    }
+  }
+
+  // The snapshot is taken on the world thread, after the physics update, so
+  // that it is consistent and the log worker never reads the live world.
+  WorldPrivate::LogSnapshot snapshot;
+  {
+    WorldPtr self = shared_from_this();
+    std::string filterStr = logRecord->Filter();
+    std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
+    this->dataPtr->logCaptureState.LoadWithFilter(self, filterStr);
+    snapshot.state = this->dataPtr->logCaptureState;
+    snapshot.state.SetWorld(self);
+
+    // Insertions and deletions are detected on the unfiltered state.
+    snapshot.insertDelete = insertDelete;
+    snapshot.filtered = insertDelete && !filterStr.empty();
+    if (snapshot.filtered)
+    {
+      this->dataPtr->logUnfilteredCaptureState.Load(self);
+      snapshot.unfilteredState = this->dataPtr->logUnfilteredCaptureState;
+      snapshot.unfilteredState.SetWorld(self);
+    }
+  }
+
+  this->dataPtr->logCapturedEntityChanges = entityChanges;
+  this->dataPtr->logLastStateTime = this->dataPtr->simTime;
+  logRecord->NotifyStateCapture(false);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->logMutex);
+  this->dataPtr->logSnapshots.push_back(std::move(snapshot));
+  this->dataPtr->logCondition.notify_one();
+}
+
 //////////////////////////////////////////////////
 void World::LogWorker()
 {
+  common::ThreadRoles::Instance()->Apply("log_worker");
+
   std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
 
   WorldPtr self = shared_from_this();
-  this->dataPtr->logPrevIteration = this->dataPtr->iterations;
 
   GZ_ASSERT(self, "Self pointer to World is invalid");
 
   // Init the prevUnfilteredState
-  this->dataPtr->prevUnfilteredState.Load(self);
+  {
+    std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
+    this->dataPtr->prevUnfilteredState.Load(self);
+  }
 
   while (!this->dataPtr->stop)
   {
-    // get unfiltered world state
-    WorldState unfilteredState;
+    while (!this->dataPtr->logSnapshots.empty())
     {
-      std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-      unfilteredState.Load(self);
-    }
+      WorldPrivate::LogSnapshot snapshot =
+          std::move(this->dataPtr->logSnapshots.front());
+      this->dataPtr->logSnapshots.pop_front();
 
-    // compute world state diff and find out about insertions and deletions
-    std::vector<std::string> insertions;
-    std::vector<std::string> deletions;
-    bool insertDelete = false;
+      // Let a world blocked on a full buffer continue while this snapshot
+      // is processed.
+      this->dataPtr->logContinueCondition.notify_all();
+      lock.unlock();
 
-    {
-      WorldState unfilteredDiffState = unfilteredState -
-          this->dataPtr->prevUnfilteredState;
-      if (!unfilteredDiffState.IsZero())
+      const WorldState &unfilteredState = snapshot.filtered ?
+          snapshot.unfilteredState : snapshot.state;
+
+      // compute world state diff and find out about insertions and deletions
+      std::vector<std::string> insertions;
+      std::vector<std::string> deletions;
+      bool insertDelete = false;
+
+      if (snapshot.insertDelete)
       {
-        insertions = unfilteredDiffState.Insertions();
-        deletions = unfilteredDiffState.Deletions();
-        insertDelete = !insertions.empty() || !deletions.empty();
+        WorldState unfilteredDiffState = unfilteredState -
+            this->dataPtr->prevUnfilteredState;
+        if (!unfilteredDiffState.IsZero())
+        {
+          insertions = unfilteredDiffState.Insertions();
+          deletions = unfilteredDiffState.Deletions();
+          insertDelete = !insertions.empty() || !deletions.empty();
+        }
+        this->dataPtr->prevUnfilteredState = unfilteredState;
       }
-    }
-    this->dataPtr->prevUnfilteredState = unfilteredState;
 
-    // Throttle state capture based on log recording frequency.
-    auto simTime = this->SimTime();
-    if ((simTime - this->dataPtr->logLastStateTime >=
-        util::LogRecord::Instance()->Period()) || insertDelete)
-    {
       int currState = (this->dataPtr->stateToggle + 1) % 2;
+      this->dataPtr->prevStates[currState] = std::move(snapshot.state);
 
-      std::string filterStr = util::LogRecord::Instance()->Filter();
       // compute diff for filtered states
-      {
-        std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-        this->dataPtr->prevStates[currState].LoadWithFilter(self, filterStr);
-      }
       WorldState diffState = this->dataPtr->prevStates[currState] -
           this->dataPtr->prevStates[this->dataPtr->stateToggle];
-      this->dataPtr->logPrevIteration = this->dataPtr->iterations;
 
       if (!diffState.IsZero() || insertDelete)
       {
@@ -3091,15 +4807,15 @@ void World::LogWorker()
         }
       }
 
-      this->dataPtr->logLastStateTime = simTime;
+      lock.lock();
     }
 
-    this->dataPtr->logContinueCondition.notify_all();
-
     // Wait until there is work to be done.
     this->dataPtr->logCondition.wait(lock);
   }
 
+  this->dataPtr->logSnapshots.clear();
+
   // Make sure nothing is blocked by this thread.
   this->dataPtr->logContinueCondition.notify_all();
 }
@@ -3119,21 +4835,18 @@ void World::RemoveModel(const std::string &_name)
   std::lock_guard<std::mutex> flock(this->dataPtr->factoryDeleteMutex);
 
   // Remove all the dirty poses from the delete entity.
+  for (auto &buffer : this->dataPtr->dirtyPoses)
   {
-    for (auto entity = this->dataPtr->dirtyPoses.begin();
-             entity != this->dataPtr->dirtyPoses.end(); ++entity)
-    {
-      if ((*entity)->GetName() == _name ||
-         ((*entity)->GetParent() && (*entity)->GetParent()->GetName() == _name))
-      {
-        this->dataPtr->dirtyPoses.erase(entity++);
-      }
-      else
-        ++entity;
-    }
+    buffer.erase(std::remove_if(buffer.begin(), buffer.end(),
+        [&_name](Entity *_entity)
+        {
+          return _entity->GetName() == _name ||
+              (_entity->GetParent() && _entity->GetParent()->GetName() == _name);
+        }), buffer.end());
   }
 
   // Remove from SDF
+  sdf::ElementPtr modelElem;
   if (this->dataPtr->sdf->HasElement("model"))
   {
     sdf::ElementPtr childElem = this->dataPtr->sdf->GetElement("model");
@@ -3142,6 +4855,7 @@ void World::RemoveModel(const std::string &_name)
     if (childElem)
     {
       this->dataPtr->sdf->RemoveChild(childElem);
+      modelElem = childElem;
     }
   }
 
@@ -3167,8 +4881,11 @@ void World::RemoveModel(const std::string &_name)
     {
       if ((*model)->GetName() == _name || (*model)->GetScopedName() == _name)
       {
+        ModelPtr removed = *model;
         this->dataPtr->models.erase(model);
-        this->dataPtr->rootElement->RemoveChild(_name);
+        if (!this->PoolModel(removed, modelElem))
+          this->dataPtr->rootElement->RemoveChild(_name);
+        ++this->dataPtr->logEntityChanges;
         break;
       }
     }
@@ -3190,6 +4907,7 @@ void World::RemoveModel(const std::string &_name)
           (*light)->GetParent()->RemoveChild(*light);
         }
         this->dataPtr->lights.erase(light);
+        ++this->dataPtr->logEntityChanges;
         break;
       }
     }
@@ -3314,7 +5032,78 @@ void World::SetAtmosphereEnabled(const bool _enable)
 void World::_AddDirty(Entity *_entity)
 {
   GZ_ASSERT(_entity != nullptr, "_entity is nullptr");
-  this->dataPtr->dirtyPoses.push_back(_entity);
+  // The pose of a sleeping link does not change.
+  if (_entity->HasType(Base::LINK) &&
+      static_cast<Link *>(_entity)->IsSleeping())
+  {
+    return;
+  }
+
+  // Each thread appends to its own buffer, so physics engines may call
+  // this concurrently (e.g. ODE island threads) without locking.
+  this->dataPtr->dirtyPoses.local().push_back(_entity);
+}
+
+/////////////////////////////////////////////////
+void World::UpdateDirtyPoses()
+{
+  size_t count = 0;
+  for (auto const &buffer : this->dataPtr->dirtyPoses)
+    count += buffer.size();
+
+  if (count == 0)
+    return;
+
+  unsigned int threshold =
+    this->dataPtr->physicsEngine->ParallelPoseUpdateThreshold();
+  bool parallel = threshold > 0 && count >= threshold;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->setWorldPoseMutex);
+
+    // Setting the pose of a canonical link also sets the pose of its parent
+    // models, which may be shared with other canonical links of nested
+    // models. Only the remaining links can be updated concurrently.
+    for (auto &buffer : this->dataPtr->dirtyPoses)
+    {
+      if (parallel)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, buffer.size(), 64),
+            [&buffer](const tbb::blocked_range<size_t> &_r)
+            {
+              for (size_t i = _r.begin(); i != _r.end(); ++i)
+              {
+                if (!buffer[i]->IsCanonicalLink())
+                  buffer[i]->_PropagateDirtyPose();
+              }
+            });
+      }
+
+      for (auto &dirtyEntity : buffer)
+      {
+        if (!parallel || dirtyEntity->IsCanonicalLink())
+          dirtyEntity->_PropagateDirtyPose();
+      }
+    }
+  }
+
+  // Publish the parent models outside of the world pose lock. Links of the
+  // same model are usually stored next to each other, so skipping repeated
+  // models avoids most of the redundant insertions.
+  for (auto &buffer : this->dataPtr->dirtyPoses)
+  {
+    Model *lastModel = nullptr;
+    for (auto &dirtyEntity : buffer)
+    {
+      ModelPtr model = dirtyEntity->GetParentModel();
+      if (model.get() != lastModel)
+      {
+        this->PublishModelPose(model);
+        lastModel = model.get();
+      }
+    }
+    buffer.clear();
+  }
 }
 
 /////////////////////////////////////////////////
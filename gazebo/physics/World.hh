@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_WORLD_HH_
 #define GAZEBO_PHYSICS_WORLD_HH_
 
+#include <functional>
 #include <vector>
 #include <list>
 #include <set>
@@ -195,6 +196,11 @@ namespace gazebo
       /// \return A list of all the Models in the world.
       public: Model_V Models() const;
 
+      /// \brief Get the number of links that sleep, see
+      /// PhysicsEngine::SleepTime.
+      /// \return The number of sleeping links.
+      public: unsigned int SleepingLinkCount() const;
+
       /// \brief Get the number of lights.
       /// \return The number of lights in the World.
       public: unsigned int LightCount() const;
@@ -250,7 +256,9 @@ namespace gazebo
 
       /// \brief Get an element by name.
       /// Searches the list of entities, and return a pointer to the model
-      /// with a matching _name.
+      /// with a matching _name. Scoped names are resolved through the name
+      /// index of each level of the entity tree, in constant time for a
+      /// given depth, see Base::GetByName.
       /// \param[in] _name The name of the Model to find.
       /// \return A pointer to the entity, or NULL if no entity was found.
       public: BasePtr BaseByName(const std::string &_name) const;
@@ -298,6 +306,23 @@ namespace gazebo
       /// \param _state The state to set the World to.
       public: void SetState(const WorldState &_state);
 
+      /// \brief Capture the dynamic state of all models in a compact
+      /// binary blob: the world pose and velocities of every link, the
+      /// joint positions, the simulation time and the iterations.
+      /// \return The snapshot, for RestoreStateSnapshot.
+      /// \sa RestoreStateSnapshot
+      public: std::string StateSnapshot() const;
+
+      /// \brief Restore a snapshot taken by StateSnapshot. The state is
+      /// written into the physics engine in one pass, without resetting
+      /// plugins and without sending a message per entity. This is much
+      /// cheaper than Reset, for example between episodes of a learning
+      /// loop.
+      /// \param[in] _snapshot The snapshot.
+      /// \return False if the snapshot is invalid, or was taken from a
+      /// different set of models, links or joints.
+      public: bool RestoreStateSnapshot(const std::string &_snapshot);
+
       /// \brief Insert a model from an SDF file.
       /// Spawns a model into the world based on an SDF file.
       /// \param[in] _sdfFilename The name of the SDF file (including path).
@@ -313,6 +338,32 @@ namespace gazebo
       /// \param[in] _sdf A reference to an SDF object.
       public: void InsertModelSDF(const sdf::SDF &_sdf);
 
+      /// \brief Insert many models at once.
+      /// The models are loaded together on the next world update, and
+      /// announced with a single msgs::Model_V on ~/model/info_v instead of
+      /// one msgs::Model each on ~/model/info. This is meant for large
+      /// batches of similar models, which can be cloned from one parsed
+      /// element instead of being parsed from a string each.
+      /// \param[in] _models <model> elements. The world takes them over,
+      /// so they must not be shared with other models.
+      public: void InsertModels(const std::vector<sdf::ElementPtr> &_models);
+
+      /// \brief Set the number of deleted models kept for reuse.
+      /// A model spawned from a factory message and then deleted is
+      /// deactivated and kept. A later factory message with the same SDF
+      /// string or file reuses it after a pose and state reset, instead of
+      /// parsing and loading the model again. Only models without plugins,
+      /// sensors and nested models are kept. The pool is disabled by
+      /// default; the GAZEBO_MODEL_POOL_SIZE environment variable sets the
+      /// initial size.
+      /// \param[in] _size Maximum number of pooled models, 0 to disable.
+      public: void SetModelPoolSize(const unsigned int _size);
+
+      /// \brief Get the number of deleted models kept for reuse.
+      /// \return Maximum number of pooled models.
+      /// \sa SetModelPoolSize
+      public: unsigned int ModelPoolSize() const;
+
       /// \brief Return a version of the name with "<world_name>::" removed
       /// \param[in] _name Usually the name of an entity.
       /// \return The stripped world name.
@@ -348,6 +399,21 @@ namespace gazebo
       /// \return Reference to the mutex.
       public: std::mutex &WorldPoseMutex() const;
 
+      /// \brief Set how the compact pose stream is encoded. The world
+      /// publishes msgs::PosesDelta on ~/pose/delta/info, at most 60 times
+      /// per second and only while it has subscribers. A message holds the
+      /// entities whose relative pose changed beyond the thresholds since
+      /// they were last sent, and every _keyframePeriod-th message is a
+      /// keyframe holding all entities.
+      /// \param[in] _linear Smallest position change to send, in meters.
+      /// \param[in] _angular Smallest rotation change to send, in radians.
+      /// \param[in] _resolution Size of a position step, in meters.
+      /// \param[in] _keyframePeriod Number of messages between keyframes.
+      /// \return False if a value is out of range.
+      public: bool SetPoseDeltaParams(const double _linear,
+                  const double _angular, const double _resolution,
+                  const unsigned int _keyframePeriod);
+
       /// \brief check if physics engine is enabled/disabled.
       /// \param True if the physics engine is enabled.
       public: bool PhysicsEnabled() const;
@@ -379,6 +445,14 @@ namespace gazebo
       /// \return True if World::Load has completed.
       public: bool IsLoaded() const;
 
+      /// \brief Resolve and parse the mesh files used by an SDF subtree on
+      /// a thread pool. The meshes are stored in common::MeshManager, so
+      /// loading the entities afterwards only creates the physics objects.
+      /// Called by World::Load for the whole world, and by Model::Load for
+      /// models inserted later.
+      /// \param[in] _sdf Root of the subtree, such as a world or a model.
+      public: void PrefetchResources(sdf::ElementPtr _sdf);
+
       /// \brief Remove all entities from the world. Implementation of
       /// World::Clear
       public: void ClearModels();
@@ -415,6 +489,68 @@ namespace gazebo
       /// A value of zero disables run stop.
       public: void RunBlocking(const unsigned int _iterations = 0);
 
+      /// \brief Pin the thread that runs the update loop to a CPU. This
+      /// lets several worlds in one process step on separate cores. Must be
+      /// called before Run or RunBlocking. Only supported on Linux.
+      /// \param[in] _cpu Index of the CPU, or -1 to let the OS schedule
+      /// the thread.
+      /// \sa CpuAffinity()
+      public: void SetCpuAffinity(const int _cpu);
+
+      /// \brief Get the CPU the update loop is pinned to.
+      /// \return Index of the CPU, or -1 if the thread is not pinned.
+      /// \sa SetCpuAffinity(const int _cpu)
+      public: int CpuAffinity() const;
+
+      /// \brief Step on absolute deadlines of the monotonic clock instead
+      /// of the relative sleeps, which drift and oscillate under load. The
+      /// loop sleeps until shortly before each deadline, then busy-waits
+      /// for the rest, see SetSpinTime. A step that starts after its
+      /// deadline counts as an overrun, see Overruns.
+      /// \param[in] _enable True to step on deadlines.
+      /// \sa RealTimeMode()
+      public: void SetRealTimeMode(const bool _enable);
+
+      /// \brief Get whether the world steps on deadlines.
+      /// \return True if the world steps on deadlines.
+      /// \sa SetRealTimeMode(const bool _enable)
+      public: bool RealTimeMode() const;
+
+      /// \brief Run the update loop with the SCHED_FIFO policy. This needs
+      /// the CAP_SYS_NICE capability or an rtprio limit. Must be called
+      /// before Run or RunBlocking. Only supported on Linux.
+      /// \param[in] _priority Priority from 1 to 99, or 0 for the default
+      /// policy.
+      /// \sa RealTimePriority()
+      public: void SetRealTimePriority(const int _priority);
+
+      /// \brief Get the SCHED_FIFO priority of the update loop.
+      /// \return Priority, or 0 for the default policy.
+      /// \sa SetRealTimePriority(const int _priority)
+      public: int RealTimePriority() const;
+
+      /// \brief Set the time the loop busy-waits before each deadline, in
+      /// real time mode. The default of 50 microseconds covers the wake up
+      /// latency of a PREEMPT_RT kernel.
+      /// \param[in] _spin Busy-wait time in seconds.
+      /// \sa SpinTime()
+      public: void SetSpinTime(const double _spin);
+
+      /// \brief Get the time the loop busy-waits before each deadline.
+      /// \return Busy-wait time in seconds.
+      /// \sa SetSpinTime(const double _spin)
+      public: double SpinTime() const;
+
+      /// \brief Get the number of steps that started after their deadline,
+      /// in real time mode.
+      /// \return Number of overruns.
+      public: uint64_t Overruns() const;
+
+      /// \brief Get the latest start of a step after its deadline, in real
+      /// time mode.
+      /// \return Worst lateness.
+      public: common::Time MaxOverrun() const;
+
       /// \brief Remove a model. This function will block until
       /// the physics engine is not locked. The duration of the block
       /// is less than the time to complete a simulation iteration.
@@ -436,6 +572,8 @@ namespace gazebo
       /// is added to a list that will be processed by the World.
       /// Only a physics engine implementation should call this function.
       /// If you are unsure whether you should use this function, do not.
+      /// This function is lock-free and may be called concurrently from
+      /// several physics engine threads.
       /// \param[in] _entity Entity that has moved.
       public: void _AddDirty(Entity *_entity);
 
@@ -449,6 +587,53 @@ namespace gazebo
       /// \param[in] _init True if sensors have been initialized.
       public: void _SetSensorsInitialized(const bool _init);
 
+      /// \brief Enable or disable capturing a WorldSnapshot at the end of
+      /// every World::Update. Disabled by default. Sensors that read link
+      /// state enable it when they load.
+      /// \param[in] _enable True to capture snapshots.
+      public: void SetSnapshotsEnabled(const bool _enable);
+
+      /// \brief Get whether snapshots are captured.
+      /// \return True if a snapshot is captured every step.
+      public: bool SnapshotsEnabled() const;
+
+      /// \brief Get the snapshot of the last completed step. Snapshots are
+      /// kept in a double buffer, so capturing the next step does not wait
+      /// for readers of this one. The returned snapshot never changes.
+      /// May be called from any thread.
+      /// \return Latest snapshot, or nullptr if snapshots are disabled or
+      /// no step has completed since they were enabled.
+      public: WorldSnapshotPtr Snapshot() const;
+
+      /// \brief Enable or disable the spatial index of model bounding
+      /// boxes, refreshed at the end of every World::Update. Disabled by
+      /// default. Sensors that search the models around them enable it
+      /// when they load.
+      /// \param[in] _enable True to maintain the index.
+      public: void SetBoxIndexEnabled(const bool _enable);
+
+      /// \brief Get whether the model bounding box index is maintained.
+      /// \return True if enabled.
+      public: bool BoxIndexEnabled() const;
+
+      /// \brief Get the model bounding box index. May be called from any
+      /// thread.
+      /// \return The index, or nullptr if disabled.
+      public: ModelBoxIndexPtr BoxIndex() const;
+
+      /// \brief Get the trigger volumes of the world, which report models
+      /// entering and leaving boxes. They are created, and the model
+      /// bounding box index enabled, on the first call. Disabling the index
+      /// pauses them. May be called from any thread.
+      /// \return The trigger volumes.
+      public: TriggerVolumesPtr TriggerVolumes();
+
+      /// \brief Get the streaming regions, which load the models around
+      /// the active models and unload the others. Enabled by an
+      /// <ignition:streaming> element in the world.
+      /// \return The streaming regions, or nullptr if not enabled.
+      public: WorldStreamingPtr Streaming() const;
+
       /// \brief Return the URI of the world.
       /// \return URI of this world.
       public: common::URI URI() const;
@@ -464,6 +649,36 @@ namespace gazebo
       /// \param[in] _func function to be called
       public: void SetSensorWaitFunc(std::function<void(double, double)> _func);
 
+      /// \brief Set the simulation time at which log playback stops. The
+      /// world stops before playing the first state past it, so a server
+      /// can re-simulate the sensors of one segment of a log. Set it
+      /// before the world runs.
+      /// \param[in] _time End time, zero to play the whole log.
+      public: void SetLogPlayEndTime(const common::Time &_time);
+
+      /// \brief Get the simulation time at which log playback stops.
+      /// \return End time, zero if the whole log is played.
+      public: common::Time LogPlayEndTime() const;
+
+      /// \brief Function limiting the size of the next step of adaptive
+      /// stepping. It receives the simulation time at the start of the step
+      /// and returns the largest acceptable step size in seconds, or zero
+      /// for no limit. Returning the time left until an update lets it
+      /// happen at the end of a step.
+      public: typedef std::function<double (const common::Time &)>
+          StepSizeCriterion;
+
+      /// \brief Set a criterion of adaptive stepping, see
+      /// PhysicsEngine::SetParam("adaptive_min_step_size"). The step size
+      /// is the largest one which satisfies all the criteria, and drops to
+      /// the minimum size on new contacts or deep contacts. Called in the
+      /// world thread before each step.
+      /// \param[in] _name Name of the criterion, e.g. of the plugin.
+      /// \param[in] _criterion Criterion, empty to remove the one of that
+      /// name.
+      public: void SetStepSizeCriterion(const std::string &_name,
+                  const StepSizeCriterion &_criterion);
+
       /// \brief Set Visual shininess value by scoped name
       /// \param[in] _scopedName Scoped name of visual.
       /// \param[in] _shininess Shininess value.
@@ -503,6 +718,32 @@ namespace gazebo
       public: LightPtr LoadLight(const sdf::ElementPtr &_sdf,
           const BasePtr &_parent);
 
+      /// \brief Load a batch of models in one pass, and publish them in one
+      /// message.
+      /// \param[in] _sdfs SDF elements containing the Model descriptions.
+      /// \param[in] _parent Parent of the models.
+      /// \return Pointers to the newly created Models.
+      private: Model_V LoadModels(const std::vector<sdf::ElementPtr> &_sdfs,
+                                  BasePtr _parent);
+
+      /// \brief Move a deleted model to the model pool.
+      /// \param[in] _model The model, already removed from the model list.
+      /// \param[in] _sdf The model's element, removed from the world SDF.
+      /// \return True if the model was pooled, false if it must be deleted.
+      private: bool PoolModel(const ModelPtr &_model,
+                              const sdf::ElementPtr &_sdf);
+
+      /// \brief Insert a model from the pool for a factory message.
+      /// \param[in] _key Factory key of the message.
+      /// \param[in] _msg The factory message.
+      /// \return True if a pooled model was reused.
+      private: bool ReusePooledModel(const std::string &_key,
+                                     const msgs::Factory &_msg);
+
+      /// \brief Delete the pooled models above the pool size.
+      /// \param[in] _size Number of pooled models to keep.
+      private: void TrimModelPool(const unsigned int _size);
+
       /// \brief Load an actor.
       /// \param[in] _sdf SDF element containing the Actor description.
       /// \param[in] _parent Parent of the Actor.
@@ -564,11 +805,63 @@ namespace gazebo
       /// \param[in] _msg The model message.
       private: void OnModelMsg(ConstModelPtr &_msg);
 
-      /// \brief TBB version of model updating.
+      /// \brief TBB version of model updating. Used once the number of
+      /// models reaches PhysicsEngine::ParallelModelUpdateThreshold, which
+      /// is only set with ODE, otherwise this calls ModelUpdateSingleLoop.
+      ///
+      /// Each non-static model is updated on a TBB worker thread, so
+      /// Model::Update, Joint::Update, the JointController and all
+      /// callbacks connected through Joint::ConnectJointUpdate may run
+      /// concurrently with the update of other models. From these it is
+      /// safe to:
+      ///   - read and write state of the model's own links and joints,
+      ///     e.g. Joint::SetForce, Joint::Position, Link::AddForce,
+      ///     Link::WorldPose;
+      ///   - call Entity::SetWorldPose and Joint::SetPosition, which are
+      ///     serialized on the world's set-world-pose mutex;
+      ///   - publish on transport publishers.
+      /// It is not safe to insert or remove entities, to modify links or
+      /// joints of a different model (including joints connecting two
+      /// top level models), or to change physics engine parameters.
+      /// Lights, actors and static models are always updated serially,
+      /// except for the actors updated by UpdateCrowd. They are all
+      /// updated before the dynamic models, so the world order of
+      /// ModelUpdateSingleLoop is not kept.
       private: void ModelUpdateTBB();
 
       /// \brief Single loop version of model updating.
-      private: void ModelUpdateSingleLoop();
+      /// \param[in] _skipActors True to skip the actors, when they were
+      /// updated by UpdateCrowd.
+      private: void ModelUpdateSingleLoop(const bool _skipActors);
+
+      /// \brief Update the actors as a crowd once their number reaches
+      /// PhysicsEngine::ParallelActorUpdateThreshold. Actor::EvaluateFrame
+      /// runs in parallel, then Actor::ApplyFrame runs serially, and the
+      /// skeleton poses are published in a single message on
+      /// ~/skeleton_pose/batch instead of ~/skeleton_pose/info.
+      /// \return True if the actors were updated.
+      private: bool UpdateCrowd();
+
+      /// \brief Propagate the poses set by the physics engine through
+      /// _AddDirty into Entity::worldPose, and queue the parent models for
+      /// pose publication. The links are updated concurrently once their
+      /// number reaches PhysicsEngine::ParallelPoseUpdateThreshold.
+      /// Must be called with the physics update mutex locked.
+      private: void UpdateDirtyPoses();
+
+      /// \brief Wake the sleeping models that were disturbed, or whose
+      /// bounding box touches the bounding box of an awake dynamic model.
+      /// Called before the physics update.
+      private: void WakeSleepingModels();
+
+      /// \brief Put the models that rested longer than
+      /// PhysicsEngine::SleepTime to sleep. Called after the physics update.
+      private: void SleepRestingModels();
+
+      /// \brief Choose the size of the next step. With adaptive stepping,
+      /// the max step size of the physics engine is set to it.
+      /// \return Step size in seconds.
+      private: double AdaptStepSize();
 
       /// \brief Helper function to load a plugin from SDF.
       /// \param[in] _sdf SDF plugin description.
@@ -614,12 +907,23 @@ namespace gazebo
       /// and textures.
       private: void LogModelResources();
 
+      /// \brief Publish the compact pose stream. Must be called with the
+      /// receive mutex locked, before the pose publication lists are
+      /// cleared.
+      private: void PublishPoseDelta();
+
       /// \brief Process all incoming messages.
       private: void ProcessMessages();
 
       /// \brief Publish the world stats message.
       private: void PublishWorldStats();
 
+      /// \brief Capture the current state for the log worker thread.
+      /// Called from the world thread after the physics update. The state
+      /// is throttled by the log record period, and a full snapshot buffer
+      /// is handled according to the log record overflow policy.
+      private: void CaptureLogState();
+
       /// \brief Thread function for logging state data.
       private: void LogWorker();
 
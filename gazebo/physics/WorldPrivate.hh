@@ -18,17 +18,26 @@
 #define GAZEBO_PHYSICS_WORLDPRIVATE_HH_
 
 #include <atomic>
+#include <chrono>
+#include <ctime>
 #include <deque>
+#include <functional>
 #include <vector>
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <sdf/sdf.hh>
 #include <string>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
+#include <utility>
 #include <condition_variable>
 
+#include <tbb/enumerable_thread_specific.h>
+
+#include <ignition/math/Pose3.hh>
 #include <ignition/transport.hh>
 
 #include "gazebo/common/Event.hh"
@@ -40,12 +49,45 @@
 #include "gazebo/transport/TransportTypes.hh"
 
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/StepSizeController.hh"
+#include "gazebo/physics/World.hh"
 #include "gazebo/physics/WorldState.hh"
 
 namespace gazebo
 {
   namespace physics
   {
+    /// \brief How a model spawned from a factory message can be reused.
+    class ModelPoolEntry
+    {
+      /// \brief The factory SDF string or file the model was spawned from.
+      public: std::string key;
+
+      /// \brief Pose of the model in its SDF, used when a factory message
+      /// does not set one.
+      public: ignition::math::Pose3d pose;
+
+      /// \brief The deactivated model, while it is in the pool.
+      public: ModelPtr model;
+
+      /// \brief The model's element, while it is out of the world SDF.
+      public: sdf::ElementPtr sdf;
+    };
+
+    /// \brief A model file parsed for a factory message, reused while the
+    /// file is unmodified.
+    class ParsedSDFFile
+    {
+      /// \brief Resolved path of the file.
+      public: std::string filename;
+
+      /// \brief Modification time of the file when it was parsed.
+      public: std::time_t modified = 0;
+
+      /// \brief Parsed root element with full paths, cloned for each use.
+      public: sdf::ElementPtr root;
+    };
+
     /// \brief Private data class for World.
     class WorldPrivate
     {
@@ -71,6 +113,27 @@ namespace gazebo
       /// \brief thread in which the world is updated.
       public: std::thread *thread;
 
+      /// \brief CPU the update thread is pinned to, -1 if not pinned.
+      public: int cpuAffinity = -1;
+
+      /// \brief True to step on absolute deadlines.
+      public: bool realTimeMode = false;
+
+      /// \brief SCHED_FIFO priority of the update thread, 0 if not set.
+      public: int realTimePriority = 0;
+
+      /// \brief Time to busy-wait before each deadline.
+      public: std::chrono::nanoseconds spinTime{50000};
+
+      /// \brief Deadline of the next step, in real time mode.
+      public: std::chrono::steady_clock::time_point deadline;
+
+      /// \brief Number of steps that started after their deadline.
+      public: uint64_t overruns = 0;
+
+      /// \brief Worst lateness of a step.
+      public: common::Time maxOverrun;
+
       /// \brief True to stop the world from running.
       public: bool stop;
 
@@ -101,12 +164,27 @@ namespace gazebo
       /// \brief Publisher for world statistics messages.
       public: transport::PublisherPtr statPub;
 
+      /// \brief Publisher for timing statistics messages.
+      public: transport::PublisherPtr timingPub;
+
+      /// \brief Publisher for memory statistics messages.
+      public: transport::PublisherPtr memoryPub;
+
+      /// \brief Publisher for solver statistics messages.
+      public: transport::PublisherPtr solverPub;
+
+      /// \brief Publisher for plugin statistics messages.
+      public: transport::PublisherPtr pluginStatsPub;
+
       /// \brief Publisher for request response messages.
       public: transport::PublisherPtr responsePub;
 
       /// \brief Publisher for model messages.
       public: transport::PublisherPtr modelPub;
 
+      /// \brief Publisher for the messages of model batches.
+      public: transport::PublisherPtr modelVPub;
+
       /// \brief Publisher for gui messages.
       public: transport::PublisherPtr guiPub;
 
@@ -122,6 +200,40 @@ namespace gazebo
       /// \brief Publisher for local pose messages.
       public: transport::PublisherPtr poseLocalPub;
 
+      /// \brief Publisher for the skeleton poses of a crowd of actors.
+      public: transport::PublisherPtr skeletonPoseBatchPub;
+
+      /// \brief Publisher for compact pose messages.
+      public: transport::PublisherPtr poseDeltaPub;
+
+      /// \brief Models that moved since the last compact pose message.
+      public: std::set<ModelPtr> poseDeltaModels;
+
+      /// \brief Lights that moved since the last compact pose message.
+      public: std::set<LightPtr> poseDeltaLights;
+
+      /// \brief Last relative pose sent on the compact stream, by id.
+      public: std::unordered_map<uint32_t, ignition::math::Pose3d>
+              poseDeltaSent;
+
+      /// \brief Smallest position change sent on the compact stream.
+      public: double poseDeltaLinear = 1e-4;
+
+      /// \brief Smallest rotation change sent on the compact stream.
+      public: double poseDeltaAngular = 1e-3;
+
+      /// \brief Size of a position step of the compact stream.
+      public: double poseDeltaResolution = 1e-4;
+
+      /// \brief Number of compact pose messages between keyframes.
+      public: unsigned int poseDeltaKeyframePeriod = 60;
+
+      /// \brief Compact pose messages sent since the last keyframe.
+      public: unsigned int poseDeltaCount = 0;
+
+      /// \brief Wall time of the last compact pose message.
+      public: common::Time poseDeltaPrevTime;
+
       /// \brief Subscriber to world control messages.
       public: transport::SubscriberPtr controlSub;
 
@@ -152,15 +264,77 @@ namespace gazebo
       /// \brief Outgoing world statistics message.
       public: msgs::WorldStatistics worldStatsMsg;
 
+      /// \brief Outgoing timing statistics message.
+      public: msgs::TimingStatistics timingMsg;
+
+      /// \brief Outgoing memory statistics message.
+      public: msgs::MemoryStatistics memoryMsg;
+
+      /// \brief Outgoing solver statistics message.
+      public: msgs::SolverStatistics solverMsg;
+
+      /// \brief Outgoing plugin statistics message.
+      public: msgs::PluginStatistics pluginStatsMsg;
+
       /// \brief Outgoing scene message.
       public: msgs::Scene sceneMsg;
 
+      /// \brief Outgoing pose message. It is cleared and refilled every
+      /// step, so that its pose sub-messages are reused.
+      public: msgs::PosesStamped posesMsg;
+
       /// \brief Function pointer to the model update function.
       public: void (World::*modelUpdateFunc)();
 
+      /// \brief Models updated concurrently by World::ModelUpdateTBB.
+      /// Kept as a member to avoid an allocation every step.
+      public: Model_V parallelUpdateModels;
+
+      /// \brief Actors updated as a crowd by World::UpdateCrowd. Kept as a
+      /// member to avoid an allocation every step.
+      public: Actor_V crowdActors;
+
+      /// \brief Outgoing skeleton poses of the crowd. It is cleared and
+      /// refilled every step, so that its sub-messages are reused.
+      public: msgs::PoseAnimation_V skeletonPoseBatchMsg;
+
       /// \brief Last time a world statistics message was sent.
       public: common::Time prevStatTime;
 
+      /// \brief Last time a timing statistics message was sent.
+      public: common::Time prevTimingTime;
+
+      /// \brief Last time a memory statistics message was sent.
+      public: common::Time prevMemoryTime;
+
+      /// \brief Last time a solver statistics message was sent.
+      public: common::Time prevSolverTime;
+
+      /// \brief Last time a plugin statistics message was sent.
+      public: common::Time prevPluginStatsTime;
+
+      /// \brief True while this world has common::PluginStats enabled,
+      /// because ~/plugin_stats has subscribers.
+      public: bool pluginStatsEnabled = false;
+
+      /// \brief util::TimingStats ids of the stages of World::Update.
+      public: struct
+      {
+        unsigned int worldUpdateBegin;
+        unsigned int worldUpdateBeginModelLocal;
+        unsigned int modelUpdate;
+        unsigned int updateCollision;
+        unsigned int beforePhysicsUpdate;
+        unsigned int updatePhysics;
+        unsigned int dirtyPoses;
+        unsigned int logRecord;
+        unsigned int publishContacts;
+        unsigned int boxIndex;
+        unsigned int snapshot;
+        unsigned int worldUpdateEnd;
+        unsigned int update;
+      } timingStages;
+
       /// \brief Time at which pause started.
       public: common::Time pauseStartTime;
 
@@ -193,6 +367,10 @@ namespace gazebo
       /// World::SetPaused to assign world::pause
       public: std::recursive_mutex worldUpdateMutex;
 
+      /// \brief Notified with worldUpdateMutex held when stepInc reaches
+      /// zero, wakes World::Step(steps).
+      public: std::condition_variable_any stepCondition;
+
       /// \brief The world's current SDF description.
       public: sdf::ElementPtr sdf;
 
@@ -211,6 +389,18 @@ namespace gazebo
       /// \brief Factory message buffer.
       public: std::list<msgs::Factory> factoryMsgs;
 
+      /// \brief Batches of models to insert, from World::InsertModels.
+      public: std::list<std::vector<sdf::ElementPtr>> factoryModels;
+
+      /// \brief Maximum number of deleted models kept for reuse.
+      public: std::atomic<unsigned int> modelPoolSize{0};
+
+      /// \brief Deleted models kept for reuse, by factory key.
+      public: std::unordered_map<std::string, ModelPoolEntry> modelPool;
+
+      /// \brief Live models that can return to the pool, by name.
+      public: std::unordered_map<std::string, ModelPoolEntry> modelPoolKeys;
+
       /// \brief Model message buffer.
       public: std::list<msgs::Model> modelMsgs;
 
@@ -291,6 +481,10 @@ namespace gazebo
       /// objects are inserted via the factory.
       public: sdf::SDFPtr factorySDF;
 
+      /// \brief Model files parsed for factory messages, by the URI of the
+      /// factory message.
+      public: std::map<std::string, ParsedSDFFile> parsedSDFFiles;
+
       /// \brief The list of models that need to publish their pose.
       public: std::set<ModelPtr> publishModelPoses;
 
@@ -312,12 +506,45 @@ namespace gazebo
       /// \brief Condition used for log worker.
       public: std::condition_variable logCondition;
 
-      /// \brief Condition used to guarantee the log worker thread doesn't
-      /// skip an interation.
+      /// \brief Condition used to wake up the world thread when the log
+      /// worker frees a slot in logSnapshots.
       public: std::condition_variable logContinueCondition;
 
-      /// \brief Last iteration recorded by the log worker thread.
-      public: uint64_t logPrevIteration;
+      /// \brief A state captured by the world thread for the log worker.
+      public: struct LogSnapshot
+      {
+        /// \brief World state, filtered by the log record filter.
+        WorldState state;
+
+        /// \brief Unfiltered world state, only loaded when filtered is
+        /// true.
+        WorldState unfilteredState;
+
+        /// \brief True if models or lights were inserted or deleted since
+        /// the previous snapshot.
+        bool insertDelete = false;
+
+        /// \brief True if state was filtered and unfilteredState is valid.
+        bool filtered = false;
+      };
+
+      /// \brief Last filtered state captured for the log worker. Capturing
+      /// into the same state lets unchanged static models be reused.
+      public: WorldState logCaptureState;
+
+      /// \brief Last unfiltered state captured for the log worker.
+      public: WorldState logUnfilteredCaptureState;
+
+      /// \brief States captured by World::Update that are waiting to be
+      /// processed by the log worker. Protected by logMutex.
+      public: std::deque<LogSnapshot> logSnapshots;
+
+      /// \brief Incremented every time a model or light is inserted or
+      /// deleted.
+      public: std::atomic<uint64_t> logEntityChanges{0};
+
+      /// \brief Value of logEntityChanges when the last snapshot was taken.
+      public: uint64_t logCapturedEntityChanges = 0;
 
       /// \brief Real time value set from a log file.
       public: common::Time logRealTime;
@@ -334,6 +561,25 @@ namespace gazebo
       /// \brief Worker thread for logging.
       public: std::thread *logThread;
 
+      /// \brief Worker thread that serializes and sends the responses
+      /// to the requests that build large messages.
+      public: std::thread *responseThread = nullptr;
+
+      /// \brief Protects responseThread, responseJobs and responseStop.
+      public: std::mutex responseMutex;
+
+      /// \brief Notified when a response is queued, or the worker must
+      /// stop.
+      public: std::condition_variable responseCondition;
+
+      /// \brief Responses waiting for the worker, with the function that
+      /// serializes their data.
+      public: std::deque<std::pair<msgs::Response,
+              std::function<void(std::string &)>>> responseJobs;
+
+      /// \brief True to stop the response worker once the queue is empty.
+      public: bool responseStop = false;
+
       /// \brief A cached list of models. This is here for performance.
       public: Model_V models;
 
@@ -347,7 +593,9 @@ namespace gazebo
       /// \brief when physics engine makes an update and changes a link pose,
       /// this flag is set to trigger Entity::SetWorldPose on the
       /// physics::Link in World::Update.
-      public: std::list<Entity*> dirtyPoses;
+      /// There is one buffer per thread calling World::_AddDirty. The
+      /// buffers keep their capacity between steps.
+      public: tbb::enumerable_thread_specific<std::vector<Entity*>> dirtyPoses;
 
       /// \brief Class to manage preset simulation parameter profiles.
       public: PresetManagerPtr presetManager;
@@ -359,6 +607,36 @@ namespace gazebo
       /// by the SensorManager.
       public: std::atomic_bool sensorsInitialized;
 
+      /// \brief True to capture a WorldSnapshot every step.
+      public: std::atomic_bool snapshotsEnabled;
+
+      /// \brief Double buffer of snapshots. The one that is not latest is
+      /// refilled, unless a reader still holds it.
+      public: std::shared_ptr<WorldSnapshot> snapshots[2];
+
+      /// \brief Index into snapshots of the next buffer to fill.
+      public: unsigned int snapshotBackIndex = 0;
+
+      /// \brief Snapshot returned by World::Snapshot. Accessed with
+      /// std::atomic_load and std::atomic_store.
+      public: std::shared_ptr<const WorldSnapshot> latestSnapshot;
+
+      /// \brief Index of the model bounding boxes, null when disabled.
+      /// Accessed with std::atomic_load and std::atomic_store.
+      public: ModelBoxIndexPtr boxIndex;
+
+      /// \brief Trigger volumes, created by the first call to
+      /// World::TriggerVolumes. Accessed with std::atomic_load and
+      /// std::atomic_store.
+      public: TriggerVolumesPtr triggerVolumes;
+
+      /// \brief Serializes the creation of triggerVolumes.
+      public: std::mutex triggerVolumesMutex;
+
+      /// \brief Streaming regions, null unless the world has an
+      /// <ignition:streaming> element.
+      public: WorldStreamingPtr streaming;
+
       /// \brief Simulation time of the last log state captured.
       public: gazebo::common::Time logLastStateTime;
 
@@ -371,6 +649,10 @@ namespace gazebo
       /// \brief Log play real time factor
       public: double logPlayRealTimeFactor;
 
+      /// \brief Simulation time at which log playback stops, zero to play
+      /// the whole log.
+      public: common::Time logPlayEndTime;
+
       /// \brief URI of this world.
       public: common::URI uri;
 
@@ -404,6 +686,35 @@ namespace gazebo
 
       /// \brief Shininess values from scene SDF
       public: std::map<std::string, double> materialShininessMap;
+
+      /// \brief Chooses the step sizes of adaptive stepping.
+      public: StepSizeController stepSizeController;
+
+      /// \brief True while stepping adaptively.
+      public: bool adaptiveStepping = false;
+
+      /// \brief Max step size to restore when adaptive stepping stops.
+      public: double fixedStepSize = 0;
+
+      /// \brief Step size last chosen by adaptive stepping.
+      public: double adaptiveStepSize = 0;
+
+      /// \brief Step size bounds given to the step size controller.
+      public: std::pair<double, double> adaptiveStepBounds{0, 0};
+
+      /// \brief Number of contacts of the previous step.
+      public: unsigned int adaptiveContactCount = 0;
+
+      /// \brief True if adaptive stepping made the contact manager keep
+      /// all the contacts.
+      public: bool adaptiveNeverDropContacts = false;
+
+      /// \brief Criteria of adaptive stepping, by name.
+      public: std::map<std::string, World::StepSizeCriterion>
+          stepSizeCriteria;
+
+      /// \brief Protects stepSizeCriteria.
+      public: std::mutex stepSizeCriteriaMutex;
     };
   }
 }
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <functional>
+#include <unordered_map>
+
+#include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Private data for the WorldSnapshot class
+class gazebo::physics::WorldSnapshotPrivate
+{
+  /// \brief Simulation time of the step.
+  public: common::Time simTime;
+
+  /// \brief World iteration of the step.
+  public: uint64_t iterations = 0;
+
+  /// \brief Link states, by link id.
+  public: std::unordered_map<uint32_t, LinkSnapshot> links;
+
+  /// \brief Collision world poses, by collision id.
+  public: std::unordered_map<uint32_t, ignition::math::Pose3d> collisions;
+};
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d LinkSnapshot::WorldLinearVel(
+    const ignition::math::Vector3d &_offset) const
+{
+  return this->linearVel +
+    this->angularVel.Cross(this->pose.Rot().RotateVector(_offset));
+}
+
+//////////////////////////////////////////////////
+WorldSnapshot::WorldSnapshot()
+  : dataPtr(new WorldSnapshotPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+WorldSnapshot::~WorldSnapshot()
+{
+}
+
+//////////////////////////////////////////////////
+common::Time WorldSnapshot::SimTime() const
+{
+  return this->dataPtr->simTime;
+}
+
+//////////////////////////////////////////////////
+uint64_t WorldSnapshot::Iterations() const
+{
+  return this->dataPtr->iterations;
+}
+
+//////////////////////////////////////////////////
+const LinkSnapshot *WorldSnapshot::Link(const uint32_t _id) const
+{
+  auto iter = this->dataPtr->links.find(_id);
+  return iter == this->dataPtr->links.end() ? nullptr : &iter->second;
+}
+
+//////////////////////////////////////////////////
+bool WorldSnapshot::CollisionPose(const uint32_t _id,
+    ignition::math::Pose3d &_pose) const
+{
+  auto iter = this->dataPtr->collisions.find(_id);
+  if (iter == this->dataPtr->collisions.end())
+    return false;
+
+  _pose = iter->second;
+  return true;
+}
+
+//////////////////////////////////////////////////
+unsigned int WorldSnapshot::LinkCount() const
+{
+  return this->dataPtr->links.size();
+}
+
+//////////////////////////////////////////////////
+void WorldSnapshot::Capture(const World &_world)
+{
+  // clear() keeps the buckets, so a reused snapshot does not allocate
+  // unless models were added.
+  this->dataPtr->links.clear();
+  this->dataPtr->collisions.clear();
+  this->dataPtr->simTime = _world.SimTime();
+  this->dataPtr->iterations = _world.Iterations();
+
+  std::function<void(const Model_V &)> captureModels =
+    [&](const Model_V &_models)
+  {
+    for (const auto &model : _models)
+    {
+      for (const auto &link : model->GetLinks())
+      {
+        LinkSnapshot &state = this->dataPtr->links[link->GetId()];
+        state.pose = link->WorldPose();
+        state.linearVel = link->WorldLinearVel(
+            ignition::math::Vector3d::Zero);
+        state.angularVel = link->WorldAngularVel();
+
+        for (unsigned int i = 0; i < link->GetChildCount(); ++i)
+        {
+          BasePtr child = link->GetChild(i);
+          if (child->HasType(Base::COLLISION))
+          {
+            this->dataPtr->collisions[child->GetId()] =
+              boost::static_pointer_cast<Collision>(child)->WorldPose();
+          }
+        }
+      }
+      captureModels(model->NestedModels());
+    }
+  };
+  captureModels(_world.Models());
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDSNAPSHOT_HH_
+#define GAZEBO_PHYSICS_WORLDSNAPSHOT_HH_
+
+#include <cstdint>
+#include <memory>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class WorldSnapshotPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class LinkSnapshot WorldSnapshot.hh physics/physics.hh
+    /// \brief State of a link at the end of a world step.
+    class GZ_PHYSICS_VISIBLE LinkSnapshot
+    {
+      /// \brief Get the linear velocity of a point on the link.
+      /// \param[in] _offset Offset of the point from the link origin,
+      /// expressed in the link frame.
+      /// \return Linear velocity of the point in the world frame.
+      public: ignition::math::Vector3d WorldLinearVel(
+                  const ignition::math::Vector3d &_offset) const;
+
+      /// \brief Pose of the link origin in the world frame.
+      public: ignition::math::Pose3d pose;
+
+      /// \brief Linear velocity of the link origin in the world frame.
+      public: ignition::math::Vector3d linearVel;
+
+      /// \brief Angular velocity of the link in the world frame.
+      public: ignition::math::Vector3d angularVel;
+    };
+
+    /// \class WorldSnapshot WorldSnapshot.hh physics/physics.hh
+    /// \brief Immutable copy of the link and collision state of a world,
+    /// captured at the end of World::Update.
+    ///
+    /// A snapshot is never modified once it is returned by
+    /// World::Snapshot, so it can be read without locks while physics
+    /// computes the next step. All values come from the same step, unlike
+    /// reads of the live entities, which can straddle an update.
+    /// \sa World::SetSnapshotsEnabled
+    class GZ_PHYSICS_VISIBLE WorldSnapshot
+    {
+      /// \brief Constructor.
+      public: WorldSnapshot();
+
+      /// \brief Destructor.
+      public: ~WorldSnapshot();
+
+      /// \brief Get the simulation time of the step.
+      /// \return Simulation time.
+      public: common::Time SimTime() const;
+
+      /// \brief Get the world iteration of the step.
+      /// \return Iteration count.
+      public: uint64_t Iterations() const;
+
+      /// \brief Get the state of a link.
+      /// \param[in] _id Id of the link, see Base::GetId.
+      /// \return State of the link, or nullptr if the link was not in the
+      /// world.
+      public: const LinkSnapshot *Link(const uint32_t _id) const;
+
+      /// \brief Get the world pose of a collision.
+      /// \param[in] _id Id of the collision, see Base::GetId.
+      /// \param[out] _pose World pose of the collision.
+      /// \return False if the collision was not in the world.
+      public: bool CollisionPose(const uint32_t _id,
+                  ignition::math::Pose3d &_pose) const;
+
+      /// \brief Get the number of links in the snapshot.
+      /// \return Number of links.
+      public: unsigned int LinkCount() const;
+
+      /// \brief Copy the state of a world. Only World calls this, on a
+      /// snapshot no reader holds.
+      /// \param[in] _world World to copy.
+      private: void Capture(const World &_world);
+
+      /// \brief Only World may capture a snapshot.
+      friend class World;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<WorldSnapshotPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
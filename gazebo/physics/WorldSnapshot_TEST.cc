@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <limits>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class WorldSnapshotTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(WorldSnapshotTest, Capture)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  SpawnSphere("sphere", ignition::math::Vector3d(0, 0, 2),
+      ignition::math::Vector3d::Zero);
+  physics::ModelPtr model = world->ModelByName("sphere");
+  ASSERT_TRUE(model != nullptr);
+  physics::LinkPtr link = model->GetLink();
+  ASSERT_TRUE(link != nullptr);
+
+  // Disabled by default
+  EXPECT_FALSE(world->SnapshotsEnabled());
+  world->Step(1);
+  EXPECT_TRUE(world->Snapshot() == nullptr);
+
+  world->SetSnapshotsEnabled(true);
+  EXPECT_TRUE(world->SnapshotsEnabled());
+  world->Step(10);
+
+  physics::WorldSnapshotPtr first = world->Snapshot();
+  ASSERT_TRUE(first != nullptr);
+  EXPECT_EQ(first->SimTime(), world->SimTime());
+  EXPECT_EQ(first->Iterations(), world->Iterations());
+  EXPECT_GE(first->LinkCount(), 2u);
+
+  const physics::LinkSnapshot *state = first->Link(link->GetId());
+  ASSERT_TRUE(state != nullptr);
+  EXPECT_EQ(state->pose, link->WorldPose());
+  EXPECT_EQ(state->linearVel,
+      link->WorldLinearVel(ignition::math::Vector3d::Zero));
+  EXPECT_EQ(state->angularVel, link->WorldAngularVel());
+  EXPECT_LT(state->linearVel.Z(), 0.0);
+
+  ignition::math::Vector3d offset(0.1, 0.2, 0.3);
+  EXPECT_NEAR((state->WorldLinearVel(offset) -
+        link->WorldLinearVel(offset)).Length(), 0.0, 1e-10);
+
+  physics::CollisionPtr collision = link->GetCollisions().front();
+  ignition::math::Pose3d collisionPose;
+  EXPECT_TRUE(first->CollisionPose(collision->GetId(), collisionPose));
+  EXPECT_EQ(collisionPose, collision->WorldPose());
+
+  EXPECT_TRUE(first->Link(std::numeric_limits<uint32_t>::max()) == nullptr);
+
+  // A snapshot held by a reader is never modified
+  const ignition::math::Pose3d firstPose = state->pose;
+  const common::Time firstTime = first->SimTime();
+  world->Step(20);
+
+  physics::WorldSnapshotPtr second = world->Snapshot();
+  ASSERT_TRUE(second != nullptr);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(first->SimTime(), firstTime);
+  EXPECT_EQ(first->Link(link->GetId())->pose, firstPose);
+  EXPECT_GT(second->SimTime(), firstTime);
+  EXPECT_LT(second->Link(link->GetId())->pose.Pos().Z(), firstPose.Pos().Z());
+
+  // Reset and disable clear the latest snapshot
+  world->Reset();
+  EXPECT_TRUE(world->Snapshot() == nullptr);
+  world->Step(1);
+  EXPECT_TRUE(world->Snapshot() != nullptr);
+
+  world->SetSnapshotsEnabled(false);
+  EXPECT_TRUE(world->Snapshot() == nullptr);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -33,6 +33,26 @@ using namespace physics;
 // move to class when merging forward
 static std::string worldStateFilter;
 
+/////////////////////////////////////////////////
+/// \brief Get whether the state of a model can only change through the
+/// setters that update its state version: the model and all its nested
+/// models must be static, and it must not be an actor.
+/// \param[in] _model Model to check.
+/// \return True if the state of the model is tracked by its version.
+static bool versionTracked(const ModelPtr &_model)
+{
+  if (!_model->IsStatic() || _model->HasType(Base::ACTOR))
+    return false;
+
+  for (const auto &nested : _model->NestedModels())
+  {
+    if (!versionTracked(nested))
+      return false;
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 WorldState::WorldState()
   : State()
@@ -52,8 +72,11 @@ WorldState::WorldState(const WorldPtr _world)
   for (Model_V::const_iterator iter = models.begin();
        iter != models.end(); ++iter)
   {
+    const uint64_t version = (*iter)->StateVersion();
     this->modelStates.insert(std::make_pair((*iter)->GetName(),
           ModelState(*iter, this->realTime, this->simTime, this->iterations)));
+    if (versionTracked(*iter))
+      this->staticVersions[(*iter)->GetName()] = version;
   }
 
   // Add states for all the lights
@@ -131,8 +154,36 @@ void WorldState::Load(const WorldPtr _world)
 
     if (add)
     {
-      this->modelStates[(*iter)->GetName()].Load(*iter, this->realTime,
-          this->simTime, this->iterations);
+      const std::string &modelName = (*iter)->GetName();
+
+      // Read the version before the state, a concurrent change then causes
+      // a new capture next time.
+      const uint64_t version = (*iter)->StateVersion();
+      const bool tracked = versionTracked(*iter);
+
+      auto versionIter = this->staticVersions.find(modelName);
+      auto stateIter = this->modelStates.find(modelName);
+      if (tracked && versionIter != this->staticVersions.end() &&
+          versionIter->second == version &&
+          stateIter != this->modelStates.end())
+      {
+        // The model has not changed since the last capture, only refresh
+        // the time stamps.
+        stateIter->second.SetWallTime(this->wallTime);
+        stateIter->second.SetRealTime(this->realTime);
+        stateIter->second.SetSimTime(this->simTime);
+        stateIter->second.SetIterations(this->iterations);
+      }
+      else
+      {
+        this->modelStates[modelName].Load(*iter, this->realTime,
+            this->simTime, this->iterations);
+      }
+
+      if (tracked)
+        this->staticVersions[modelName] = version;
+      else if (versionIter != this->staticVersions.end())
+        this->staticVersions.erase(versionIter);
     }
   }
 
@@ -142,7 +193,10 @@ void WorldState::Load(const WorldPtr _world)
        iter != this->modelStates.end();)
   {
     if (iter->second.GetRealTime() != this->realTime)
+    {
+      this->staticVersions.erase(iter->first);
       this->modelStates.erase(iter++);
+    }
     else
       ++iter;
   }
@@ -157,6 +211,41 @@ void WorldState::Load(const WorldPtr _world)
   }
 }
 
+/////////////////////////////////////////////////
+void WorldState::LoadEntities(const WorldPtr _world,
+    const std::vector<std::string> &_names)
+{
+  this->world = _world;
+  this->name = _world->Name();
+  this->wallTime = common::Time::GetWallTime();
+  this->simTime = _world->SimTime();
+  this->realTime = _world->RealTime();
+  this->iterations = _world->Iterations();
+  this->insertions.clear();
+  this->deletions.clear();
+  this->modelStates.clear();
+  this->staticVersions.clear();
+  this->lightStates.clear();
+
+  for (const auto &entityName : _names)
+  {
+    ModelPtr model = _world->ModelByName(entityName);
+    if (model)
+    {
+      this->modelStates[entityName].Load(model, this->realTime,
+          this->simTime, this->iterations);
+      continue;
+    }
+
+    LightPtr light = _world->LightByName(entityName);
+    if (light)
+    {
+      this->lightStates[entityName].Load(light, this->realTime,
+          this->simTime, this->iterations);
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 void WorldState::Load(const sdf::ElementPtr _elem)
 {
@@ -172,6 +261,7 @@ void WorldState::Load(const sdf::ElementPtr _elem)
 
   // Add the model states
   this->modelStates.clear();
+  this->staticVersions.clear();
   if (_elem->HasElement("model"))
   {
     sdf::ElementPtr childElem = _elem->GetElement("model");
@@ -441,6 +531,7 @@ WorldState &WorldState::operator=(const WorldState &_state)
   // Clear the states
   this->modelStates.clear();
   this->lightStates.clear();
+  this->staticVersions = _state.staticVersions;
 
   this->insertions.clear();
   this->deletions.clear();
@@ -488,6 +579,17 @@ WorldState WorldState::operator-(const WorldState &_state) const
   {
     if (this->HasModelState(iter->second.GetName()))
     {
+      // Both states were captured from the same version of a static
+      // model, so they are equal.
+      auto version = this->staticVersions.find(iter->first);
+      auto otherVersion = _state.staticVersions.find(iter->first);
+      if (version != this->staticVersions.end() &&
+          otherVersion != _state.staticVersions.end() &&
+          version->second == otherVersion->second)
+      {
+        continue;
+      }
+
       ModelState state = this->GetModelState(iter->second.GetName()) -
         iter->second;
 
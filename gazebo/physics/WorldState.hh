@@ -21,6 +21,7 @@
 #ifndef GAZEBO_PHYSICS_WORLDSTATE_HH_
 #define GAZEBO_PHYSICS_WORLDSTATE_HH_
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -78,6 +79,16 @@ namespace gazebo
       public: void LoadWithFilter(const WorldPtr _world,
           const std::string &_filter);
 
+      /// \brief Load the state of only some entities of a world.
+      ///
+      /// Generate a WorldState holding the time of the world and the states
+      /// of the named models and lights. Names which don't match
+      /// any model or light are skipped.
+      /// \param[in] _world Pointer to a world
+      /// \param[in] _names Names of the models and lights.
+      public: void LoadEntities(const WorldPtr _world,
+          const std::vector<std::string> &_names);
+
       /// \brief Load state from SDF element.
       ///
       /// Set a WorldState from an SDF element containing WorldState info.
@@ -276,6 +287,11 @@ namespace gazebo
 
       /// \brief Pointer to the world.
       private: WorldPtr world;
+
+      /// \brief State versions of the static top level models, at the time
+      /// their states were captured. A model state whose version has not
+      /// changed is reused by the next capture, and skipped by the diff.
+      private: std::map<std::string, uint64_t> staticVersions;
     };
     /// \}
   }
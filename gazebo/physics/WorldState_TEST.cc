@@ -261,6 +261,58 @@ TEST_F(WorldStateTest, OperatorsNoInsertionsDeletions)
   EXPECT_TRUE((worldState0 - worldState1).IsZero());
 }
 
+//////////////////////////////////////////////////
+TEST_F(WorldStateTest, StaticModelVersion)
+{
+  // Load a world
+  this->Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+
+  physics::ModelPtr ground = world->ModelByName("ground_plane");
+  ASSERT_TRUE(ground != nullptr);
+  ASSERT_TRUE(ground->IsStatic());
+
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  EXPECT_NE(ground->StateVersion(), box->StateVersion());
+
+  // Capturing an unchanged world gives the same state
+  physics::WorldState worldState0(world);
+  physics::WorldState worldState1 = worldState0;
+  world->Step(1);
+  worldState1.Load(world);
+  EXPECT_TRUE((worldState1 - worldState0).IsZero());
+  EXPECT_EQ(worldState1.GetSimTime(),
+      worldState1.GetModelState("ground_plane").GetSimTime());
+
+  std::ostringstream stream0, stream1;
+  stream0 << worldState0.GetModelState("ground_plane");
+  stream1 << worldState1.GetModelState("ground_plane");
+  EXPECT_EQ(stream0.str(), stream1.str());
+
+  // Moving a static model changes its version, and the next capture
+  const uint64_t version = ground->StateVersion();
+  const ignition::math::Pose3d pose(1, 2, 3, 0, 0, 0);
+  ground->SetWorldPose(pose);
+  EXPECT_NE(version, ground->StateVersion());
+
+  physics::WorldState worldState2 = worldState1;
+  worldState2.Load(world);
+  EXPECT_EQ(pose, worldState2.GetModelState("ground_plane").Pose());
+
+  physics::WorldState diffState = worldState2 - worldState1;
+  EXPECT_FALSE(diffState.IsZero());
+  EXPECT_TRUE(diffState.HasModelState("ground_plane"));
+
+  // So does scaling it
+  ground->SetScale(ignition::math::Vector3d(2, 2, 2));
+  physics::WorldState worldState3 = worldState2;
+  worldState3.Load(world);
+  EXPECT_EQ(ignition::math::Vector3d(2, 2, 2),
+      worldState3.GetModelState("ground_plane").Scale());
+  EXPECT_FALSE((worldState3 - worldState2).IsZero());
+}
+
 //////////////////////////////////////////////////
 TEST_F(WorldStateTest, InsertionOfMeshModel)
 {
@@ -0,0 +1,458 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/TraceCapture.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/Node.hh"
+#include "gazebo/transport/Publisher.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/ModelState.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldStreaming.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Fraction of the radius an active model must move past it before
+/// a region unloads, so a model at the edge does not toggle it every step.
+static const double kUnloadMargin = 0.1;
+
+/// \brief A model owned by a streaming region.
+struct StreamedModel
+{
+  /// \brief Model name.
+  std::string name;
+
+  /// \brief The model element of the world file. Never modified, so the
+  /// background thread can copy it without a lock.
+  sdf::ElementPtr sdf;
+
+  /// \brief Pose the model loads at, updated when it unloads.
+  ignition::math::Pose3d pose;
+
+  /// \brief State cached when the model unloaded, nullptr before.
+  std::shared_ptr<ModelState> state;
+};
+
+/// \brief Load state of a region.
+enum class RegionState
+{
+  /// \brief The models are not in the world.
+  UNLOADED,
+
+  /// \brief Copies of the models are being prepared or inserted.
+  LOADING,
+
+  /// \brief The models are in the world.
+  LOADED,
+
+  /// \brief The models are being deleted.
+  UNLOADING
+};
+
+/// \brief A streaming region.
+struct StreamingRegion
+{
+  /// \brief Region name.
+  std::string name;
+
+  /// \brief Region in the world frame.
+  ignition::math::AxisAlignedBox box;
+
+  /// \brief Models of the region.
+  std::vector<StreamedModel> models;
+
+  /// \brief Load state.
+  RegionState state = RegionState::UNLOADED;
+
+  /// \brief True once the copies are handed to the world, or the deletes
+  /// requested, while LOADING or UNLOADING.
+  bool committed = false;
+};
+
+/// \brief Private data for the WorldStreaming class
+class gazebo::physics::WorldStreamingPrivate
+{
+  /// \brief Regions, in the order they were added.
+  public: std::vector<StreamingRegion> regions;
+
+  /// \brief Names of the active models.
+  public: std::set<std::string> active;
+
+  /// \brief Load radius.
+  public: double radius = 50.0;
+
+  /// \brief Positions of the active models, posted by Update.
+  public: std::vector<ignition::math::Vector3d> positions;
+
+  /// \brief True if positions has not been read by the thread yet.
+  public: bool positionsPosted = false;
+
+  /// \brief Model copies ready to insert, by region index.
+  public: std::vector<std::pair<size_t, std::vector<sdf::ElementPtr>>>
+          readyLoads;
+
+  /// \brief Regions ready to unload, by index.
+  public: std::vector<size_t> readyUnloads;
+
+  /// \brief Node of the delete requests.
+  public: transport::NodePtr node;
+
+  /// \brief Publishes the entity_delete requests.
+  public: transport::PublisherPtr requestPub;
+
+  /// \brief True to stop the thread.
+  public: bool stop = false;
+
+  /// \brief Protects the members above.
+  public: mutable std::mutex mutex;
+
+  /// \brief Wakes the thread when positions are posted.
+  public: std::condition_variable condition;
+
+  /// \brief Decides the loads and unloads and copies the model elements.
+  public: std::thread thread;
+};
+
+/// \brief Get the distance from a point to a box.
+/// \param[in] _box The box.
+/// \param[in] _p The point.
+/// \return Distance, 0 inside the box.
+static double BoxDistance(const ignition::math::AxisAlignedBox &_box,
+    const ignition::math::Vector3d &_p)
+{
+  const ignition::math::Vector3d closest(
+      ignition::math::clamp(_p.X(), _box.Min().X(), _box.Max().X()),
+      ignition::math::clamp(_p.Y(), _box.Min().Y(), _box.Max().Y()),
+      ignition::math::clamp(_p.Z(), _box.Min().Z(), _box.Max().Z()));
+  return closest.Distance(_p);
+}
+
+//////////////////////////////////////////////////
+WorldStreaming::WorldStreaming()
+  : dataPtr(new WorldStreamingPrivate)
+{
+  this->dataPtr->thread = std::thread(&WorldStreaming::Run, this);
+}
+
+//////////////////////////////////////////////////
+WorldStreaming::~WorldStreaming()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->condition.notify_all();
+  if (this->dataPtr->thread.joinable())
+    this->dataPtr->thread.join();
+}
+
+//////////////////////////////////////////////////
+void WorldStreaming::Load(sdf::ElementPtr _sdf)
+{
+  if (!_sdf)
+    return;
+
+  if (_sdf->HasElement("radius"))
+    this->SetRadius(_sdf->Get<double>("radius"));
+
+  sdf::ElementPtr elem = _sdf->HasElement("active_model") ?
+    _sdf->GetElement("active_model") : sdf::ElementPtr();
+  while (elem)
+  {
+    this->SetActive(elem->Get<std::string>(), true);
+    elem = elem->GetNextElement("active_model");
+  }
+
+  elem = _sdf->HasElement("region") ? _sdf->GetElement("region") :
+    sdf::ElementPtr();
+  while (elem)
+  {
+    const std::string name = elem->Get<std::string>("name");
+    const ignition::math::AxisAlignedBox box(
+        elem->Get<ignition::math::Vector3d>("min"),
+        elem->Get<ignition::math::Vector3d>("max"));
+    if (!this->AddRegion(name, box))
+      gzerr << "Streaming region [" << name << "] already exists\n";
+    elem = elem->GetNextElement("region");
+  }
+}
+
+//////////////////////////////////////////////////
+bool WorldStreaming::AddRegion(const std::string &_name,
+    const ignition::math::AxisAlignedBox &_box)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto const &region : this->dataPtr->regions)
+  {
+    if (region.name == _name)
+      return false;
+  }
+
+  StreamingRegion region;
+  region.name = _name;
+  region.box = _box;
+  this->dataPtr->regions.push_back(std::move(region));
+  return true;
+}
+
+//////////////////////////////////////////////////
+void WorldStreaming::SetActive(const std::string &_name, const bool _active)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (_active)
+    this->dataPtr->active.insert(_name);
+  else
+    this->dataPtr->active.erase(_name);
+}
+
+//////////////////////////////////////////////////
+bool WorldStreaming::Active(const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->active.count(_name) > 0;
+}
+
+//////////////////////////////////////////////////
+void WorldStreaming::SetRadius(const double _radius)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->radius = std::max(0.0, _radius);
+}
+
+//////////////////////////////////////////////////
+double WorldStreaming::Radius() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->radius;
+}
+
+//////////////////////////////////////////////////
+unsigned int WorldStreaming::RegionCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return static_cast<unsigned int>(this->dataPtr->regions.size());
+}
+
+//////////////////////////////////////////////////
+bool WorldStreaming::RegionLoaded(const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto const &region : this->dataPtr->regions)
+  {
+    if (region.name == _name)
+      return region.state == RegionState::LOADED;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+unsigned int WorldStreaming::ModelCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  size_t count = 0;
+  for (auto const &region : this->dataPtr->regions)
+    count += region.models.size();
+  return static_cast<unsigned int>(count);
+}
+
+//////////////////////////////////////////////////
+bool WorldStreaming::Take(const sdf::ElementPtr &_sdf)
+{
+  if (!_sdf || _sdf->GetName() != "model")
+    return false;
+
+  StreamedModel model;
+  model.name = _sdf->Get<std::string>("name");
+  model.sdf = _sdf;
+  if (_sdf->HasElement("pose"))
+    model.pose = _sdf->Get<ignition::math::Pose3d>("pose");
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->active.count(model.name) > 0)
+    return false;
+
+  for (auto &region : this->dataPtr->regions)
+  {
+    if (region.box.Contains(model.pose.Pos()))
+    {
+      region.models.push_back(std::move(model));
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+void WorldStreaming::Update(World &_world)
+{
+  IGN_PROFILE("WorldStreaming::Update");
+
+  if (!this->dataPtr->node)
+  {
+    this->dataPtr->node = transport::NodePtr(new transport::Node());
+    this->dataPtr->node->Init(_world.Name());
+    this->dataPtr->requestPub =
+      this->dataPtr->node->Advertise<msgs::Request>("~/request");
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Regions whose copies were inserted by the last ProcessMessages get
+  // their cached states back, and regions whose models are all deleted
+  // may load again.
+  for (auto &region : this->dataPtr->regions)
+  {
+    if (!region.committed)
+      continue;
+
+    if (region.state == RegionState::LOADING)
+    {
+      for (auto const &streamed : region.models)
+      {
+        ModelPtr model = _world.ModelByName(streamed.name);
+        if (model && streamed.state)
+          model->SetState(*streamed.state);
+      }
+      region.state = RegionState::LOADED;
+      region.committed = false;
+    }
+    else if (region.state == RegionState::UNLOADING &&
+        std::none_of(region.models.begin(), region.models.end(),
+          [&_world](const StreamedModel &_m)
+          {
+            return _world.ModelByName(_m.name) != nullptr;
+          }))
+    {
+      region.state = RegionState::UNLOADED;
+      region.committed = false;
+    }
+  }
+
+  for (auto &load : this->dataPtr->readyLoads)
+  {
+    _world.InsertModels(load.second);
+    this->dataPtr->regions[load.first].committed = true;
+  }
+  this->dataPtr->readyLoads.clear();
+
+  for (auto const index : this->dataPtr->readyUnloads)
+  {
+    StreamingRegion &region = this->dataPtr->regions[index];
+    for (auto &streamed : region.models)
+    {
+      ModelPtr model = _world.ModelByName(streamed.name);
+      if (!model)
+        continue;
+
+      streamed.pose = model->WorldPose();
+      streamed.state = std::make_shared<ModelState>(model);
+      msgs::Request *request =
+        msgs::CreateRequest("entity_delete", streamed.name);
+      this->dataPtr->requestPub->Publish(*request);
+      delete request;
+    }
+    region.committed = true;
+  }
+  this->dataPtr->readyUnloads.clear();
+
+  this->dataPtr->positions.clear();
+  for (auto const &name : this->dataPtr->active)
+  {
+    ModelPtr model = _world.ModelByName(name);
+    if (model)
+      this->dataPtr->positions.push_back(model->WorldPose().Pos());
+  }
+  this->dataPtr->positionsPosted = true;
+  this->dataPtr->condition.notify_one();
+}
+
+//////////////////////////////////////////////////
+void WorldStreaming::Run()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  while (true)
+  {
+    this->dataPtr->condition.wait(lock, [this]
+        {
+          return this->dataPtr->stop || this->dataPtr->positionsPosted;
+        });
+    if (this->dataPtr->stop)
+      break;
+    this->dataPtr->positionsPosted = false;
+
+    const double radius = this->dataPtr->radius;
+    std::vector<std::pair<size_t, std::vector<StreamedModel>>> toCopy;
+    for (size_t i = 0; i < this->dataPtr->regions.size(); ++i)
+    {
+      StreamingRegion &region = this->dataPtr->regions[i];
+      double distance = std::numeric_limits<double>::infinity();
+      for (auto const &pos : this->dataPtr->positions)
+        distance = std::min(distance, BoxDistance(region.box, pos));
+
+      if (region.state == RegionState::UNLOADED && distance <= radius)
+      {
+        region.state = RegionState::LOADING;
+        toCopy.emplace_back(i, region.models);
+      }
+      else if (region.state == RegionState::LOADED &&
+          distance > radius * (1.0 + kUnloadMargin))
+      {
+        region.state = RegionState::UNLOADING;
+        this->dataPtr->readyUnloads.push_back(i);
+      }
+    }
+
+    if (toCopy.empty())
+      continue;
+
+    // Copying the elements is the costly part of a load, and the originals
+    // are never modified, so it happens without the lock
+    lock.unlock();
+    std::vector<std::pair<size_t, std::vector<sdf::ElementPtr>>> copies;
+    for (auto const &region : toCopy)
+    {
+      IGN_PROFILE("WorldStreaming::Copy");
+      std::vector<sdf::ElementPtr> batch;
+      batch.reserve(region.second.size());
+      for (auto const &streamed : region.second)
+      {
+        sdf::ElementPtr copy = streamed.sdf->Clone();
+        copy->GetElement("pose")->Set(streamed.pose);
+        batch.push_back(copy);
+      }
+      copies.emplace_back(region.first, std::move(batch));
+    }
+    lock.lock();
+
+    for (auto &copy : copies)
+      this->dataPtr->readyLoads.push_back(std::move(copy));
+  }
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDSTREAMING_HH_
+#define GAZEBO_PHYSICS_WORLDSTREAMING_HH_
+
+#include <memory>
+#include <string>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <sdf/sdf.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class WorldStreamingPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class WorldStreaming WorldStreaming.hh physics/physics.hh
+    /// \brief Loads and unloads the models of streaming regions as active
+    /// models approach and leave them.
+    ///
+    /// Streaming is enabled by an <ignition:streaming> element of the
+    /// world:
+    /// \code
+    /// <ignition:streaming>
+    ///   <radius>50</radius>
+    ///   <active_model>robot</active_model>
+    ///   <region name="building_a">
+    ///     <min>0 0 -1</min>
+    ///     <max>80 40 30</max>
+    ///   </region>
+    /// </ignition:streaming>
+    /// \endcode
+    /// Top level models whose SDF pose lies in a region are taken out of
+    /// the world before World::LoadEntities. A region is loaded while an
+    /// active model is within the radius of its box, and unloaded once all
+    /// active models are farther than the radius plus a margin. The state
+    /// of unloaded models is cached and restored when the region loads
+    /// again.
+    ///
+    /// Decisions and SDF copies are made on a background thread. The
+    /// models are inserted through World::InsertModels and removed with
+    /// entity_delete requests, so both happen between steps and reach the
+    /// scene like any other spawn or delete.
+    /// \sa World::Streaming
+    class GZ_PHYSICS_VISIBLE WorldStreaming
+    {
+      /// \brief Constructor.
+      public: WorldStreaming();
+
+      /// \brief Destructor. Stops the background thread.
+      public: ~WorldStreaming();
+
+      /// \brief Load the regions, radius and active models.
+      /// \param[in] _sdf The <ignition:streaming> element.
+      public: void Load(sdf::ElementPtr _sdf);
+
+      /// \brief Add a region. Only models taken after the call stream with
+      /// it. Thread safe.
+      /// \param[in] _name Unique name of the region.
+      /// \param[in] _box Region in the world frame.
+      /// \return False if a region with the name exists.
+      public: bool AddRegion(const std::string &_name,
+                  const ignition::math::AxisAlignedBox &_box);
+
+      /// \brief Mark a model as active or not. Thread safe.
+      /// \param[in] _name Name of the top level model.
+      /// \param[in] _active True if regions stream around the model.
+      public: void SetActive(const std::string &_name, const bool _active);
+
+      /// \brief Get whether a model is active.
+      /// \param[in] _name Name of the top level model.
+      /// \return True if active.
+      public: bool Active(const std::string &_name) const;
+
+      /// \brief Set the distance from an active model at which regions
+      /// load. Thread safe.
+      /// \param[in] _radius Distance in meters.
+      public: void SetRadius(const double _radius);
+
+      /// \brief Get the load radius.
+      /// \return Distance in meters.
+      public: double Radius() const;
+
+      /// \brief Get the number of regions.
+      /// \return Number of regions.
+      public: unsigned int RegionCount() const;
+
+      /// \brief Get whether the models of a region are loaded.
+      /// \param[in] _name Name of the region.
+      /// \return True if the region is loaded.
+      public: bool RegionLoaded(const std::string &_name) const;
+
+      /// \brief Get the number of models owned by the streaming regions,
+      /// loaded or not.
+      /// \return Number of models.
+      public: unsigned int ModelCount() const;
+
+      /// \brief Keep a top level model out of the world if it lies in a
+      /// region. Only World calls this, before loading its entities.
+      /// \param[in] _sdf The <model> element.
+      /// \return True if the model streams with a region.
+      private: bool Take(const sdf::ElementPtr &_sdf);
+
+      /// \brief Commit the loads and unloads decided since the last call,
+      /// and hand the active model positions to the background thread.
+      /// Only World calls this, between steps.
+      /// \param[in] _world The world.
+      private: void Update(World &_world);
+
+      /// \brief Body of the background thread.
+      private: void Run();
+
+      /// \brief Only World takes models and updates the regions.
+      friend class World;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<WorldStreamingPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -15,14 +15,37 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldStreaming.hh"
 #include "gazebo/test/ServerFixture.hh"
 #include "test/util.hh"
 
 using namespace gazebo;
 
-class WorldTest : public ServerFixture {};
+class WorldTest : public ServerFixture
+{
+  /// \brief Store a compact pose message.
+  /// \param[in] _msg The message.
+  public: void OnPoseDelta(ConstPosesDeltaPtr &_msg)
+  {
+    std::lock_guard<std::mutex> lock(this->poseDeltaMutex);
+    this->poseDeltaMsgs.push_back(*_msg);
+  }
+
+  /// \brief Compact pose messages received.
+  public: std::vector<msgs::PosesDelta> poseDeltaMsgs;
+
+  /// \brief Protects poseDeltaMsgs.
+  public: std::mutex poseDeltaMutex;
+};
 
 //////////////////////////////////////////////////
 /// \brief Test the factory message's allow_renaming flag and unique model name
@@ -216,6 +239,426 @@ TEST_F(WorldTest, Stop)
   EXPECT_TRUE(world->Running());
 }
 
+//////////////////////////////////////////////////
+/// \brief spread_worlds must give each world its own CPU in turn.
+TEST_F(WorldTest, CpuAffinity)
+{
+  this->Load("worlds/blank.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // Not pinned by default
+  EXPECT_EQ(-1, world->CpuAffinity());
+
+  world->SetCpuAffinity(-5);
+  EXPECT_EQ(-1, world->CpuAffinity());
+
+  physics::spread_worlds();
+  EXPECT_EQ(0, world->CpuAffinity());
+
+  const int cpuCount =
+    static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+  physics::spread_worlds(cpuCount + 1);
+  EXPECT_EQ(1 % cpuCount, world->CpuAffinity());
+
+  world->SetCpuAffinity(-1);
+  EXPECT_EQ(-1, world->CpuAffinity());
+}
+
+//////////////////////////////////////////////////
+/// \brief Responses built by the response worker must hold the state of
+/// the world.
+TEST_F(WorldTest, AsyncResponses)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  boost::shared_ptr<msgs::Response> response =
+    transport::request("default", "scene_info", "", common::Time(5, 0));
+  ASSERT_NE(nullptr, response);
+  EXPECT_EQ("success", response->response());
+
+  msgs::Scene scene;
+  ASSERT_EQ(scene.GetTypeName(), response->type());
+  ASSERT_TRUE(scene.ParseFromString(response->serialized_data()));
+  EXPECT_EQ("default", scene.name());
+  ASSERT_EQ(1, scene.model_size());
+  EXPECT_EQ("ground_plane", scene.model(0).name());
+
+  response = transport::request("default", "entity_list", "",
+      common::Time(5, 0));
+  ASSERT_NE(nullptr, response);
+  msgs::Model_V models;
+  ASSERT_TRUE(models.ParseFromString(response->serialized_data()));
+  EXPECT_EQ(1, models.models_size());
+
+  response = transport::request("default", "world_sdf", "",
+      common::Time(5, 0));
+  ASSERT_NE(nullptr, response);
+  msgs::GzString sdfString;
+  ASSERT_TRUE(sdfString.ParseFromString(response->serialized_data()));
+  EXPECT_NE(std::string::npos, sdfString.data().find("ground_plane"));
+}
+
+//////////////////////////////////////////////////
+/// \brief The name index of the children must follow renames and removals.
+TEST_F(WorldTest, ChildNameIndex)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto model = world->ModelByName("ground_plane");
+  ASSERT_NE(nullptr, model);
+
+  auto link = model->GetChild("link");
+  ASSERT_NE(nullptr, link);
+  EXPECT_EQ(link, model->GetChild("link")->GetChild("collision")->GetParent());
+
+  // Nested names still resolve through the subtree
+  EXPECT_NE(nullptr, model->GetChild("link::collision"));
+
+  link->SetName("renamed");
+  EXPECT_EQ(nullptr, model->GetChild("link"));
+  EXPECT_EQ(link, model->GetChild("renamed"));
+
+  link->SetName("link");
+  EXPECT_EQ(link, model->GetChild("link"));
+  EXPECT_EQ(nullptr, model->GetChild("renamed"));
+
+  model->DetachChild(link);
+  EXPECT_EQ(nullptr, model->GetChild("link"));
+  model->AddChild(link);
+  link->SetParent(model);
+  EXPECT_EQ(link, model->GetChild("link"));
+}
+
+//////////////////////////////////////////////////
+/// \brief Deadline stepping must keep the update rate and count the steps
+/// that start late.
+TEST_F(WorldTest, RealTimeMode)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // Off by default
+  EXPECT_FALSE(world->RealTimeMode());
+  EXPECT_EQ(0, world->RealTimePriority());
+  EXPECT_DOUBLE_EQ(50e-6, world->SpinTime());
+  EXPECT_EQ(0u, world->Overruns());
+
+  world->SetRealTimePriority(120);
+  EXPECT_EQ(99, world->RealTimePriority());
+  world->SetRealTimePriority(-1);
+  EXPECT_EQ(0, world->RealTimePriority());
+
+  world->SetSpinTime(-1.0);
+  EXPECT_DOUBLE_EQ(0.0, world->SpinTime());
+  world->SetSpinTime(1e-4);
+  EXPECT_DOUBLE_EQ(1e-4, world->SpinTime());
+
+  world->Physics()->SetRealTimeUpdateRate(1000.0);
+  world->SetRealTimeMode(true);
+  EXPECT_TRUE(world->RealTimeMode());
+
+  const uint64_t iterations = world->Iterations();
+  const common::Time start = common::Time::GetWallTime();
+  world->SetPaused(false);
+  common::Time::MSleep(500);
+  world->SetPaused(true);
+  const double elapsed = (common::Time::GetWallTime() - start).Double();
+  const double steps = static_cast<double>(world->Iterations() - iterations);
+
+  // The rate holds whether or not steps were late
+  EXPECT_NEAR(elapsed * 1000.0, steps, elapsed * 1000.0 * 0.2);
+  EXPECT_GE(world->MaxOverrun(), common::Time::Zero);
+  if (world->Overruns() == 0u)
+    EXPECT_EQ(common::Time::Zero, world->MaxOverrun());
+}
+
+//////////////////////////////////////////////////
+/// \brief Models and poses updated in parallel must behave like the serial
+/// update.
+TEST_F(WorldTest, ParallelModelUpdate)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto physics = world->Physics();
+  ASSERT_NE(nullptr, physics);
+
+  // Disabled by default
+  EXPECT_EQ(0u, physics->ParallelModelUpdateThreshold());
+
+  EXPECT_FALSE(physics->SetParam("parallel_model_update_threshold", -1));
+  EXPECT_TRUE(physics->SetParam("parallel_model_update_threshold", 4));
+  EXPECT_EQ(4u, physics->ParallelModelUpdateThreshold());
+  EXPECT_EQ(4, boost::any_cast<int>(
+      physics->GetParam("parallel_model_update_threshold")));
+
+  // Values from a world file are strings
+  EXPECT_TRUE(physics->SetParam("parallel_model_update_threshold",
+      std::string("2")));
+  EXPECT_EQ(2u, physics->ParallelModelUpdateThreshold());
+
+  // Also propagate the link poses computed by ODE in parallel
+  EXPECT_EQ(0u, physics->ParallelPoseUpdateThreshold());
+  EXPECT_TRUE(physics->SetParam("parallel_pose_update_threshold", 1));
+  EXPECT_EQ(1u, physics->ParallelPoseUpdateThreshold());
+
+  const unsigned int boxCount = 8;
+  for (unsigned int i = 0; i < boxCount; ++i)
+  {
+    this->SpawnBox("box_" + std::to_string(i), ignition::math::Vector3d::One,
+        ignition::math::Vector3d(i * 2.0, 0, 2.0),
+        ignition::math::Vector3d::Zero);
+  }
+
+  world->Step(500);
+
+  // All boxes should have fallen onto the ground plane
+  for (unsigned int i = 0; i < boxCount; ++i)
+  {
+    auto model = world->ModelByName("box_" + std::to_string(i));
+    ASSERT_NE(nullptr, model);
+    EXPECT_NEAR(0.5, model->WorldPose().Pos().Z(), 1e-2);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, Sleep)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_NE(nullptr, physics);
+  EXPECT_DOUBLE_EQ(0.0, physics->SleepTime());
+  EXPECT_FALSE(physics->SetParam("sleep_time", -1.0));
+  EXPECT_TRUE(physics->SetParam("sleep_time", 0.1));
+  EXPECT_DOUBLE_EQ(0.1, physics->SleepTime());
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5), ignition::math::Vector3d::Zero);
+  physics::ModelPtr model = world->ModelByName("box");
+  ASSERT_NE(nullptr, model);
+  physics::LinkPtr link = model->GetLink();
+  ASSERT_NE(nullptr, link);
+
+  // The box rests on the ground plane and falls asleep
+  world->Step(1000);
+  EXPECT_TRUE(model->IsSleeping());
+  EXPECT_TRUE(link->IsSleeping());
+  EXPECT_EQ(1u, world->SleepingLinkCount());
+  ignition::math::Pose3d pose = model->WorldPose();
+
+  // A force wakes it
+  link->AddForce(ignition::math::Vector3d(100, 0, 0));
+  world->Step(1);
+  EXPECT_FALSE(model->IsSleeping());
+  EXPECT_EQ(0u, world->SleepingLinkCount());
+
+  // So does moving it
+  world->Step(1000);
+  EXPECT_TRUE(model->IsSleeping());
+  model->SetWorldPose(pose + ignition::math::Pose3d(0, 2, 0, 0, 0, 0));
+  world->Step(1);
+  EXPECT_FALSE(model->IsSleeping());
+
+  // Disabling sleep wakes all models
+  world->Step(1000);
+  EXPECT_TRUE(model->IsSleeping());
+  EXPECT_TRUE(physics->SetParam("sleep_time", 0.0));
+  world->Step(1);
+  EXPECT_FALSE(model->IsSleeping());
+  EXPECT_EQ(0u, world->SleepingLinkCount());
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, AdaptiveStep)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_NE(nullptr, physics);
+  const double fixedStepSize = physics->GetMaxStepSize();
+  EXPECT_DOUBLE_EQ(0.0, physics->AdaptiveMinStepSize());
+  EXPECT_FALSE(physics->SetParam("adaptive_min_step_size", -1.0));
+  EXPECT_TRUE(physics->SetParam("adaptive_min_step_size", fixedStepSize));
+  EXPECT_TRUE(physics->SetParam("adaptive_max_step_size",
+      std::to_string(4 * fixedStepSize)));
+  EXPECT_DOUBLE_EQ(4 * fixedStepSize, physics->AdaptiveMaxStepSize());
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5), ignition::math::Vector3d::Zero);
+  physics::ModelPtr model = world->ModelByName("box");
+  ASSERT_NE(nullptr, model);
+
+  // Steps stay on the grid of the smallest step size
+  auto onGrid = [&]()
+  {
+    const double ticks = world->SimTime().Double() / fixedStepSize;
+    return std::abs(ticks - std::round(ticks)) < 1e-6;
+  };
+
+  // Resting on the ground, the steps grow to the largest size
+  for (int i = 0; i < 200; ++i)
+  {
+    world->Step(1);
+    EXPECT_TRUE(onGrid());
+  }
+  EXPECT_DOUBLE_EQ(4 * fixedStepSize, physics->GetMaxStepSize());
+
+  // Falling takes large steps, an impact drops to the smallest size
+  model->SetWorldPose(ignition::math::Pose3d(0, 0, 2, 0, 0, 0));
+  bool impact = false;
+  for (int i = 0; i < 1000 && !impact; ++i)
+  {
+    world->Step(1);
+    EXPECT_TRUE(onGrid());
+    impact = ignition::math::equal(physics->GetMaxStepSize(),
+        fixedStepSize);
+  }
+  EXPECT_TRUE(impact);
+
+  // A criterion limits the step size
+  world->SetStepSizeCriterion("test", [&](const common::Time &)
+      {
+        return 2.5 * fixedStepSize;
+      });
+  world->Step(200);
+  EXPECT_DOUBLE_EQ(2 * fixedStepSize, physics->GetMaxStepSize());
+  world->SetStepSizeCriterion("test", nullptr);
+  world->Step(200);
+  EXPECT_DOUBLE_EQ(4 * fixedStepSize, physics->GetMaxStepSize());
+
+  // Back to fixed steps
+  EXPECT_TRUE(physics->SetParam("adaptive_min_step_size", 0.0));
+  world->Step(1);
+  EXPECT_DOUBLE_EQ(fixedStepSize, physics->GetMaxStepSize());
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, PoseDeltaStream)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  EXPECT_FALSE(world->SetPoseDeltaParams(-1, 0, 1e-4, 10));
+  EXPECT_FALSE(world->SetPoseDeltaParams(0, 0, 0, 10));
+  EXPECT_FALSE(world->SetPoseDeltaParams(0, 0, 1e-4, 0));
+  EXPECT_TRUE(world->SetPoseDeltaParams(1e-4, 1e-3, 1e-4, 1000));
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 5), ignition::math::Vector3d::Zero);
+  physics::ModelPtr model = world->ModelByName("box");
+  ASSERT_NE(nullptr, model);
+
+  transport::SubscriberPtr sub = this->node->Subscribe("~/pose/delta/info",
+      &WorldTest::OnPoseDelta, this);
+
+  // The box falls, while the ground plane does not move
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    world->Step(20);
+    common::Time::MSleep(20);
+  }
+
+  std::lock_guard<std::mutex> lock(this->poseDeltaMutex);
+  const std::vector<msgs::PosesDelta> &received = this->poseDeltaMsgs;
+  ASSERT_GT(received.size(), 2u);
+  EXPECT_TRUE(received[0].keyframe());
+
+  unsigned int keyframeIds = received[0].pose_size();
+  EXPECT_GE(keyframeIds, 4u);
+  for (size_t i = 1; i < received.size(); ++i)
+  {
+    EXPECT_FALSE(received[i].keyframe());
+    EXPECT_LT(static_cast<unsigned int>(received[i].pose_size()),
+        keyframeIds);
+    for (int j = 0; j < received[i].pose_size(); ++j)
+    {
+      EXPECT_FALSE(received[i].pose(j).has_name());
+      EXPECT_TRUE(received[i].pose(j).id() == model->GetId() ||
+                  received[i].pose(j).id() == model->GetLink()->GetId());
+    }
+  }
+
+  // The decoded pose matches the last pose of the box
+  msgs::PosesStamped decoded = msgs::Convert(received.back());
+  ASSERT_GT(decoded.pose_size(), 0);
+  EXPECT_NEAR(model->RelativePose().Pos().Z(),
+      msgs::ConvertIgn(decoded.pose(0)).Pos().Z(), 0.1);
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, Streaming)
+{
+  this->Load("test/worlds/world_streaming.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  physics::WorldStreamingPtr streaming = world->Streaming();
+  ASSERT_NE(nullptr, streaming);
+  EXPECT_EQ(1u, streaming->RegionCount());
+  EXPECT_EQ(2u, streaming->ModelCount());
+  EXPECT_DOUBLE_EQ(10.0, streaming->Radius());
+  EXPECT_TRUE(streaming->Active("robot"));
+
+  physics::ModelPtr robot = world->ModelByName("robot");
+  ASSERT_NE(nullptr, robot);
+
+  // Step until the region reaches the expected state
+  auto stepUntil = [&](const bool _loaded)
+  {
+    for (int i = 0; i < 200 && streaming->RegionLoaded("far") != _loaded;
+        ++i)
+    {
+      world->Step(1);
+      common::Time::MSleep(10);
+    }
+    return streaming->RegionLoaded("far") == _loaded;
+  };
+
+  // The region is far from the robot
+  world->Step(10);
+  EXPECT_FALSE(streaming->RegionLoaded("far"));
+  EXPECT_EQ(nullptr, world->ModelByName("far_box_1"));
+  EXPECT_EQ(nullptr, world->ModelByName("far_box_2"));
+
+  // Approaching the region loads both boxes
+  robot->SetWorldPose(ignition::math::Pose3d(88, 0, 0.5, 0, 0, 0));
+  ASSERT_TRUE(stepUntil(true));
+  physics::ModelPtr box = world->ModelByName("far_box_1");
+  ASSERT_NE(nullptr, box);
+  EXPECT_NE(nullptr, world->ModelByName("far_box_2"));
+  box->SetWorldPose(ignition::math::Pose3d(97, 2, 0.5, 0, 0, 0));
+
+  // Leaving unloads them, keeping the pose of the moved box
+  robot->SetWorldPose(ignition::math::Pose3d::Zero);
+  ASSERT_TRUE(stepUntil(false));
+  for (int i = 0; i < 200 && world->ModelByName("far_box_1"); ++i)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  EXPECT_EQ(nullptr, world->ModelByName("far_box_1"));
+  EXPECT_EQ(nullptr, world->ModelByName("far_box_2"));
+
+  robot->SetWorldPose(ignition::math::Pose3d(88, 0, 0.5, 0, 0, 0));
+  ASSERT_TRUE(stepUntil(true));
+  box = world->ModelByName("far_box_1");
+  ASSERT_NE(nullptr, box);
+  EXPECT_EQ(ignition::math::Vector3d(97, 2, 0.5), box->WorldPose().Pos());
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -164,9 +164,7 @@ void BulletLink::Init()
   this->rigidLink->setFriction(0.5*(hackMu1 + hackMu2));  // Hack
 
   // Setup motion clamping to prevent objects from moving too fast.
-  // this->rigidLink->setCcdMotionThreshold(1);
-  // auto size = this->BoundingBox().Size();
-  // this->rigidLink->setCcdSweptSphereRadius(size.GetMax()*0.8);
+  this->SetContinuousCollision(this->ContinuousCollision());
 
   if (this->inertial->Mass() <= 0.0)
     this->rigidLink->setCollisionFlags(btCollisionObject::CF_KINEMATIC_OBJECT);
@@ -290,6 +288,28 @@ bool BulletLink::GetGravityMode() const
   return result;
 }
 
+//////////////////////////////////////////////////
+void BulletLink::SetContinuousCollision(const bool _enable)
+{
+  Link::SetContinuousCollision(_enable);
+
+  if (!this->rigidLink)
+    return;
+
+  if (!_enable)
+  {
+    this->rigidLink->setCcdMotionThreshold(0);
+    this->rigidLink->setCcdSweptSphereRadius(0);
+    return;
+  }
+
+  // Sweep a sphere that fits inside the link once it moves farther than
+  // the radius of that sphere in one step.
+  double radius = 0.5 * this->BoundingBox().Size().Min();
+  this->rigidLink->setCcdMotionThreshold(radius);
+  this->rigidLink->setCcdSweptSphereRadius(radius);
+}
+
 //////////////////////////////////////////////////
 void BulletLink::SetSelfCollide(bool _collide)
 {
@@ -340,23 +360,33 @@ void BulletLink::OnPoseChange()
 //////////////////////////////////////////////////
 bool BulletLink::GetEnabled() const
 {
-  // This function and its counterpart BulletLink::SetEnabled
-  // don't do anything yet.
-  return true;
+  if (!this->rigidLink)
+    return true;
+
+  return this->rigidLink->isActive();
 }
 
 //////////////////////////////////////////////////
-void BulletLink::SetEnabled(bool /*_enable*/) const
+void BulletLink::SetEnabled(bool _enable) const
 {
-  /*
   if (!this->rigidLink)
     return;
 
   if (_enable)
+  {
+    // Restore the activation state chosen in BulletLink::Init.
+    if (this->GetModel()->GetAutoDisable() &&
+        this->GetModel()->GetJointCount() == 0 &&
+        this->GetSensorCount() == 0)
+    {
+      this->rigidLink->forceActivationState(ACTIVE_TAG);
+    }
+    else
+      this->rigidLink->forceActivationState(DISABLE_DEACTIVATION);
     this->rigidLink->activate(true);
+  }
   else
-    this->rigidLink->setActivationState(WANTS_DEACTIVATION);
-    */
+    this->rigidLink->forceActivationState(ISLAND_SLEEPING);
 }
 
 //////////////////////////////////////////////////
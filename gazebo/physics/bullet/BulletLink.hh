@@ -102,6 +102,9 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void SetSelfCollide(bool _collide);
 
+      // Documentation inherited.
+      public: virtual void SetContinuousCollision(const bool _enable);
+
       /// \brief Get the bullet rigid body.
       /// \return Pointer to bullet rigid body object.
       public: btRigidBody *GetBulletLink() const;
@@ -15,16 +15,53 @@
  *
 */
 
+#include <vector>
+
 #include "gazebo/common/Mesh.hh"
 
+#include "gazebo/physics/MeshCollisionCache.hh"
 #include "gazebo/physics/bullet/BulletTypes.hh"
 #include "gazebo/physics/bullet/BulletCollision.hh"
 #include "gazebo/physics/bullet/BulletPhysics.hh"
 #include "gazebo/physics/bullet/BulletMesh.hh"
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \brief Bullet triangle mesh and the GImpact shape built on it, or
+    /// the compound of the convex hulls of a decomposition, which can be
+    /// used by several collisions.
+    class BulletMeshData
+    {
+      /// \brief Destructor.
+      public: ~BulletMeshData()
+      {
+        delete this->shape;
+        delete this->triMesh;
+        for (auto *hull : this->hulls)
+          delete hull;
+      }
+
+      /// \brief Triangle data, nullptr for convex hulls.
+      public: btTriangleMesh *triMesh = nullptr;
+
+      /// \brief Convex hulls, children of the compound shape.
+      public: std::vector<btConvexHullShape *> hulls;
+
+      /// \brief Collision shape, a GImpact shape with its bounding volume
+      /// hierarchy or a compound of convex hulls.
+      public: btCollisionShape *shape = nullptr;
+    };
+  }
+}
+
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Shapes shared between identical mesh collisions.
+static MeshCollisionCache<BulletMeshData> g_meshDataCache;
+
 //////////////////////////////////////////////////
 BulletMesh::BulletMesh()
 {
@@ -38,51 +75,115 @@ BulletMesh::~BulletMesh()
 //////////////////////////////////////////////////
 void BulletMesh::Init(const common::SubMesh *_subMesh,
                       BulletCollisionPtr _collision,
-                      const ignition::math::Vector3d &_scale)
+                      const ignition::math::Vector3d &_scale,
+                      const std::string &_cacheKey)
 {
-  float *vertices = nullptr;
-  int *indices = nullptr;
+  std::shared_ptr<BulletMeshData> meshData = g_meshDataCache.Get(_cacheKey,
+      [&]()
+      {
+        float *vertices = nullptr;
+        int *indices = nullptr;
 
-  unsigned int numVertices = _subMesh->GetVertexCount();
-  unsigned int numIndices = _subMesh->GetIndexCount();
+        unsigned int numVertices = _subMesh->GetVertexCount();
+        unsigned int numIndices = _subMesh->GetIndexCount();
 
-  // Get all the vertex and index data
-  _subMesh->FillArrays(&vertices, &indices);
+        // Get all the vertex and index data
+        _subMesh->FillArrays(&vertices, &indices);
 
-  this->CreateMesh(vertices, indices, numVertices,
-                   numIndices, _collision, _scale);
+        std::shared_ptr<BulletMeshData> result = this->CreateMesh(vertices,
+            indices, numVertices, numIndices, _scale);
 
-  delete [] vertices;
-  delete [] indices;
+        delete [] vertices;
+        delete [] indices;
+        return result;
+      });
+
+  this->data.push_back(meshData);
+  _collision->SetCollisionShape(meshData->shape);
 }
 
 //////////////////////////////////////////////////
 void BulletMesh::Init(const common::Mesh *_mesh,
                       BulletCollisionPtr _collision,
-                      const ignition::math::Vector3d &_scale)
+                      const ignition::math::Vector3d &_scale,
+                      const std::string &_cacheKey)
 {
-  float *vertices = nullptr;
-  int *indices = nullptr;
+  std::shared_ptr<BulletMeshData> meshData = g_meshDataCache.Get(_cacheKey,
+      [&]()
+      {
+        float *vertices = nullptr;
+        int *indices = nullptr;
+
+        unsigned int numVertices = _mesh->GetVertexCount();
+        unsigned int numIndices = _mesh->GetIndexCount();
 
-  unsigned int numVertices = _mesh->GetVertexCount();
-  unsigned int numIndices = _mesh->GetIndexCount();
+        // Get all the vertex and index data
+        _mesh->FillArrays(&vertices, &indices);
 
-  // Get all the vertex and index data
-  _mesh->FillArrays(&vertices, &indices);
+        std::shared_ptr<BulletMeshData> result = this->CreateMesh(vertices,
+            indices, numVertices, numIndices, _scale);
 
-  this->CreateMesh(vertices, indices, numVertices,
-                   numIndices, _collision, _scale);
+        delete [] vertices;
+        delete [] indices;
+        return result;
+      });
 
-  delete [] vertices;
-  delete [] indices;
+  this->data.push_back(meshData);
+  _collision->SetCollisionShape(meshData->shape);
+}
+
+//////////////////////////////////////////////////
+bool BulletMesh::InitConvex(const common::Mesh *_hulls,
+    BulletCollisionPtr _collision, const ignition::math::Vector3d &_scale,
+    const std::string &_cacheKey)
+{
+  if (!_hulls || _hulls->GetSubMeshCount() == 0u)
+    return false;
+
+  std::shared_ptr<BulletMeshData> meshData = g_meshDataCache.Get(_cacheKey,
+      [&]()
+      {
+        std::shared_ptr<BulletMeshData> result(new BulletMeshData);
+        btCompoundShape *compound = new btCompoundShape();
+        result->shape = compound;
+
+        btTransform identity;
+        identity.setIdentity();
+        for (unsigned int i = 0; i < _hulls->GetSubMeshCount(); ++i)
+        {
+          const common::SubMesh *subMesh = _hulls->GetSubMesh(i);
+          btConvexHullShape *hull = new btConvexHullShape();
+          for (unsigned int j = 0; j < subMesh->GetVertexCount(); ++j)
+          {
+            ignition::math::Vector3d v = subMesh->Vertex(j) * _scale;
+            hull->addPoint(btVector3(v.X(), v.Y(), v.Z()), false);
+          }
+          hull->recalcLocalAabb();
+          result->hulls.push_back(hull);
+          compound->addChildShape(identity, hull);
+        }
+        return result;
+      });
+
+  this->data.push_back(meshData);
+  _collision->SetCollisionShape(meshData->shape);
+  return true;
+}
+
+//////////////////////////////////////////////////
+size_t BulletMesh::SharedDataCount()
+{
+  return g_meshDataCache.Size();
 }
 
 /////////////////////////////////////////////////
-void BulletMesh::CreateMesh(float *_vertices, int *_indices,
-    unsigned int _numVertices, unsigned int _numIndices,
-    BulletCollisionPtr _collision, const ignition::math::Vector3d &_scale)
+std::shared_ptr<BulletMeshData> BulletMesh::CreateMesh(float *_vertices,
+    int *_indices, unsigned int _numVertices, unsigned int _numIndices,
+    const ignition::math::Vector3d &_scale)
 {
-  btTriangleMesh *mTriMesh = new btTriangleMesh();
+  std::shared_ptr<BulletMeshData> result(new BulletMeshData);
+  result->triMesh = new btTriangleMesh();
+  btTriangleMesh *mTriMesh = result->triMesh;
 
   // Scale the vertex data
   for (unsigned int j = 0;  j < _numVertices; ++j)
@@ -110,9 +211,9 @@ void BulletMesh::CreateMesh(float *_vertices, int *_indices,
     mTriMesh->addTriangle(bv0, bv1, bv2);
   }
 
-  btGImpactMeshShape *gimpactMeshShape =
-    new btGImpactMeshShape(mTriMesh);
-  gimpactMeshShape->updateBound();
+  btGImpactMeshShape *shape = new btGImpactMeshShape(mTriMesh);
+  shape->updateBound();
+  result->shape = shape;
 
-  _collision->SetCollisionShape(gimpactMeshShape);
+  return result;
 }
@@ -18,6 +18,10 @@
 #ifndef GAZEBO_PHYSICS_BULLET_BULLETMESH_HH_
 #define GAZEBO_PHYSICS_BULLET_BULLETMESH_HH_
 
+#include <list>
+#include <memory>
+#include <string>
+
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/bullet/BulletTypes.hh"
@@ -31,6 +35,8 @@ namespace gazebo
     /// \addtogroup gazebo_physics_bullet Bullet Physics
     /// \{
 
+    class BulletMeshData;
+
     /// \brief Triangle mesh collision helper class
     class GZ_PHYSICS_VISIBLE BulletMesh
     {
@@ -44,29 +50,59 @@ namespace gazebo
       /// \param[in] _subMesh Pointer to the submesh.
       /// \param[in] _collision Pointer to the collision object.
       /// \param[in] _scale Scaling factor.
+      /// \param[in] _cacheKey Collision geometry key, see
+      /// MeshShape::CollisionGeometryKey. Meshes with the same non empty key
+      /// share one Bullet shape. An empty key disables sharing.
       public: void Init(const common::SubMesh *_subMesh,
                       BulletCollisionPtr _collision,
-                      const ignition::math::Vector3d &_scale);
+                      const ignition::math::Vector3d &_scale,
+                      const std::string &_cacheKey = "");
 
       /// \brief Create a mesh collision shape using a mesh.
       /// \param[in] _mesh Pointer to the mesh.
       /// \param[in] _collision Pointer to the collision object.
       /// \param[in] _scale Scaling factor.
+      /// \param[in] _cacheKey Collision geometry key, see
+      /// MeshShape::CollisionGeometryKey. Meshes with the same non empty key
+      /// share one Bullet shape. An empty key disables sharing.
       public: void Init(const common::Mesh *_mesh,
                       BulletCollisionPtr _collision,
-                      const ignition::math::Vector3d &_scale);
+                      const ignition::math::Vector3d &_scale,
+                      const std::string &_cacheKey = "");
+
+      /// \brief Create a compound collision shape of convex hulls.
+      /// \param[in] _hulls Mesh with one submesh per convex hull, see
+      /// MeshShape::ConvexHulls.
+      /// \param[in] _collision Pointer to the collision object.
+      /// \param[in] _scale Scaling factor.
+      /// \param[in] _cacheKey Collision geometry key, see
+      /// MeshShape::CollisionGeometryKey. An empty key disables sharing.
+      /// \return False if there are no hulls.
+      public: bool InitConvex(const common::Mesh *_hulls,
+                      BulletCollisionPtr _collision,
+                      const ignition::math::Vector3d &_scale,
+                      const std::string &_cacheKey = "");
+
+      /// \brief Get the number of Bullet shapes shared between meshes.
+      /// \return Number of shared shapes in use.
+      public: static size_t SharedDataCount();
 
       /// \brief Helper function to create the collision shape.
       /// \param[in] _vertices Array of vertices.
       /// \param[in] _indices Array of indices.
       /// \param[in] _numVertices Number of vertices.
       /// \param[in] _numIndices Number of indices.
-      /// \param[in] _collision Pointer to the collision object.
       /// \param[in] _scale Scaling factor.
-      private: void CreateMesh(float *_vertices, int *_indices,
+      /// \return The triangle mesh and its shape.
+      private: static std::shared_ptr<BulletMeshData> CreateMesh(
+                   float *_vertices, int *_indices,
                    unsigned int _numVertices, unsigned int _numIndices,
-                   BulletCollisionPtr _collision,
                    const ignition::math::Vector3d &_scale);
+
+      /// \brief Shapes created by Init, possibly shared with other meshes.
+      /// The shapes of earlier calls are kept, because the compound shape
+      /// of the link may still refer to them.
+      private: std::list<std::shared_ptr<BulletMeshData>> data;
     };
     /// \}
   }
@@ -60,14 +60,23 @@ void BulletMeshShape::Init()
   BulletCollisionPtr bParent =
     boost::static_pointer_cast<BulletCollision>(this->collisionParent);
 
+  if (this->bulletMesh->InitConvex(this->ConvexHulls(), bParent,
+        this->sdf->Get<ignition::math::Vector3d>("scale"),
+        this->CollisionGeometryKey()))
+  {
+    return;
+  }
+
   if (this->submesh)
   {
     this->bulletMesh->Init(this->submesh, bParent,
-        this->sdf->Get<ignition::math::Vector3d>("scale"));
+        this->sdf->Get<ignition::math::Vector3d>("scale"),
+        this->CollisionGeometryKey());
   }
   else
   {
     this->bulletMesh->Init(this->mesh, bParent,
-        this->sdf->Get<ignition::math::Vector3d>("scale"));
+        this->sdf->Get<ignition::math::Vector3d>("scale"),
+        this->CollisionGeometryKey());
   }
 }
@@ -18,9 +18,14 @@
 #include <algorithm>
 #include <string>
 
-#include <ignition/common/Profiler.hh>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/task_arena.h>
+
 #include <ignition/math/Rand.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/bullet/BulletTypes.hh"
 #include "gazebo/physics/bullet/BulletLink.hh"
 #include "gazebo/physics/bullet/BulletCollision.hh"
@@ -213,20 +218,19 @@ void UpdateContacts(btDynamicsWorld *_world, btScalar _timeStep)
         localTorque2 = body2Pose.Rot().RotateVectorReverse(
             BulletTypes::ConvertVector3Ign(torqueB));
 
-        contactFeedback->positions[j] = BulletTypes::ConvertVector3Ign(ptB);
-        contactFeedback->normals[j] = BulletTypes::ConvertVector3Ign(normalOnB);
-        contactFeedback->depths[j] = -pt.getDistance();
+        const int index = contactFeedback->AddPoint(
+            BulletTypes::ConvertVector3Ign(ptB),
+            BulletTypes::ConvertVector3Ign(normalOnB), -pt.getDistance());
         if (!link1->IsStatic())
         {
-          contactFeedback->wrench[j].body1Force = localForce1;
-          contactFeedback->wrench[j].body1Torque = localTorque1;
+          contactFeedback->wrench[index].body1Force = localForce1;
+          contactFeedback->wrench[index].body1Torque = localTorque1;
         }
         if (!link2->IsStatic())
         {
-          contactFeedback->wrench[j].body2Force = localForce2;
-          contactFeedback->wrench[j].body2Torque = localTorque2;
+          contactFeedback->wrench[index].body2Force = localForce2;
+          contactFeedback->wrench[index].body2Torque = localTorque2;
         }
-        contactFeedback->count++;
       }
     }
   }
@@ -258,6 +262,85 @@ bool ContactProcessed(btManifoldPoint &/*_cp*/, void * /*_body0*/,
   return true;
 }
 
+#ifdef LIBBULLET_VERSION_GT_287
+//////////////////////////////////////////////////
+/// \brief Bullet task scheduler that runs the parallel loops of the
+/// multithreaded world in a TBB arena.
+class TbbTaskScheduler : public btITaskScheduler
+{
+  /// \brief Constructor
+  public: TbbTaskScheduler() : btITaskScheduler("GazeboTBB")
+  {
+    this->arena.initialize(this->threads);
+  }
+
+  // Documentation inherited
+  public: virtual int getMaxNumThreads() const
+  {
+    return BT_MAX_THREAD_COUNT;
+  }
+
+  // Documentation inherited
+  public: virtual int getNumThreads() const
+  {
+    return this->threads;
+  }
+
+  // Documentation inherited
+  public: virtual void setNumThreads(int _threads)
+  {
+    _threads = std::max(1, std::min(_threads, int(BT_MAX_THREAD_COUNT)));
+    if (_threads == this->threads)
+      return;
+
+    this->threads = _threads;
+    this->arena.terminate();
+    this->arena.initialize(this->threads);
+  }
+
+  // Documentation inherited
+  public: virtual void parallelFor(int _begin, int _end, int _grainSize,
+      const btIParallelForBody &_body)
+  {
+    this->arena.execute([&]()
+    {
+      tbb::parallel_for(tbb::blocked_range<int>(_begin, _end, _grainSize),
+          [&](const tbb::blocked_range<int> &_r)
+          {
+            _body.forLoop(_r.begin(), _r.end());
+          });
+    });
+  }
+
+  // Documentation inherited
+  public: virtual btScalar parallelSum(int _begin, int _end, int _grainSize,
+      const btIParallelSumBody &_body)
+  {
+    btScalar sum = 0;
+    this->arena.execute([&]()
+    {
+      sum = tbb::parallel_reduce(
+          tbb::blocked_range<int>(_begin, _end, _grainSize), btScalar(0),
+          [&](const tbb::blocked_range<int> &_r, btScalar _partial)
+          {
+            return _partial + _body.sumLoop(_r.begin(), _r.end());
+          },
+          [](btScalar _a, btScalar _b)
+          {
+            return _a + _b;
+          });
+    });
+    return sum;
+  }
+
+  /// \brief Number of threads of the arena.
+  private: int threads = 1;
+
+  /// \brief Arena that bounds the number of threads of the loops.
+  private: tbb::task_arena arena;
+};
+#endif
+
 //////////////////////////////////////////////////
 BulletPhysics::BulletPhysics(WorldPtr _world)
     : PhysicsEngine(_world)
@@ -302,14 +385,57 @@ BulletPhysics::BulletPhysics(WorldPtr _world)
   gContactAddedCallback = ContactCallback;
   gContactProcessedCallback = ContactProcessed;
 
-  this->dynamicsWorld->setInternalTickCallback(
-      InternalTickCallback, static_cast<void *>(this));
+  this->ConfigureDynamicsWorld();
 
   // Set random seed for physics engine based on gazebo's random seed.
   // Note: this was moved from physics::PhysicsEngine constructor.
   this->SetSeed(ignition::math::Rand::Seed());
+}
+
+//////////////////////////////////////////////////
+void BulletPhysics::ConfigureDynamicsWorld()
+{
+  this->dynamicsWorld->setInternalTickCallback(
+      InternalTickCallback, static_cast<void *>(this));
 
-  btGImpactCollisionAlgorithm::registerAlgorithm(dispatcher);
+  btGImpactCollisionAlgorithm::registerAlgorithm(this->dispatcher);
+}
+
+//////////////////////////////////////////////////
+bool BulletPhysics::CreateDynamicsWorldMt(const unsigned int _threads)
+{
+#ifdef LIBBULLET_VERSION_GT_287
+  // The scheduler is global to Bullet, so the last engine to load picks the
+  // number of threads. If Bullet was built without BT_THREADSAFE its loops
+  // ignore the scheduler and run serially.
+  static TbbTaskScheduler scheduler;
+  scheduler.setNumThreads(_threads);
+  btSetTaskScheduler(&scheduler);
+
+  // The broadphase keeps its pair cache, and with it the collision filter.
+  delete this->dynamicsWorld;
+  delete this->solver;
+  delete this->dispatcher;
+
+  this->dispatcher = new btCollisionDispatcherMt(this->collisionConfig);
+
+  // Islands are solved in parallel, each by a solver of the pool, and the
+  // large islands by a solver that parallelizes its own iterations.
+  btConstraintSolverPoolMt *pool = new btConstraintSolverPoolMt(_threads);
+  this->solverPool = pool;
+  this->solver = new btSequentialImpulseConstraintSolverMt;
+
+  this->dynamicsWorld = new btDiscreteDynamicsWorldMt(this->dispatcher,
+      this->broadPhase, pool, this->solver, this->collisionConfig);
+
+  this->ConfigureDynamicsWorld();
+  this->threadCount = scheduler.getNumThreads();
+  return true;
+#else
+  gzwarn << "This version of Bullet has no multithreaded dynamics world, "
+         << _threads << " threads requested, using 1.\n";
+  return false;
+#endif
 }
 
 //////////////////////////////////////////////////
@@ -325,6 +451,15 @@ void BulletPhysics::Load(sdf::ElementPtr _sdf)
 
   sdf::ElementPtr bulletElem = this->sdf->GetElement("bullet");
 
+  // The multithreaded world replaces the default one before any body is
+  // added, so every setting below applies to it.
+  if (bulletElem->HasElement("threads"))
+  {
+    int threads = bulletElem->Get<int>("threads");
+    if (threads > 1)
+      this->CreateDynamicsWorldMt(threads);
+  }
+
   auto g = this->world->Gravity();
   // ODEPhysics checks this, so we will too.
   if (g == ignition::math::Vector3d::Zero)
@@ -538,6 +673,10 @@ void BulletPhysics::Fini()
     delete this->dynamicsWorld;
   this->dynamicsWorld = nullptr;
 
+  if (this->solverPool)
+    delete this->solverPool;
+  this->solverPool = nullptr;
+
   if (this->solver)
     delete this->solver;
   this->solver = nullptr;
@@ -721,6 +860,8 @@ bool BulletPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = this->sdf->GetElement("max_contacts")->Get<int>();
   else if (_key == "min_step_size")
     _value = bulletElem->GetElement("solver")->Get<double>("min_step_size");
+  else if (_key == "threads")
+    _value = static_cast<int>(this->threadCount);
   else
   {
     return PhysicsEngine::GetParam(_key, _value);
@@ -172,12 +172,29 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSORPGSIters(unsigned int iters);
 
+      /// \brief Replace the dynamics world by the multithreaded one of
+      /// Bullet, which steps its islands in parallel with a pool of
+      /// constraint solvers. All engines share one task scheduler, backed by
+      /// TBB. This must be called before any body is added.
+      /// \param[in] _threads Number of threads, more than 1.
+      /// \return False if Bullet has no multithreaded world.
+      private: bool CreateDynamicsWorldMt(const unsigned int _threads);
+
+      /// \brief Set the callbacks of the dynamics world.
+      private: void ConfigureDynamicsWorld();
+
       private: btBroadphaseInterface *broadPhase;
       private: btDefaultCollisionConfiguration *collisionConfig;
       private: btCollisionDispatcher *dispatcher;
       private: btSequentialImpulseConstraintSolver *solver;
       private: btDiscreteDynamicsWorld *dynamicsWorld;
 
+      /// \brief Island solvers of the multithreaded world, null otherwise.
+      private: btConstraintSolver *solverPool = nullptr;
+
+      /// \brief Number of threads stepping the dynamics world.
+      private: unsigned int threadCount = 1;
+
       private: common::Time lastUpdateTime;
 
       /// \brief The type of the solver.
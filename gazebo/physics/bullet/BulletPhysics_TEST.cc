@@ -267,6 +267,25 @@ TEST_F(BulletPhysics_TEST, PhysicsMsgParam)
   PhysicsMsgParam();
 }
 
+/////////////////////////////////////////////////
+/// Test that the dynamics world is single threaded by default
+TEST_F(BulletPhysics_TEST, Threads)
+{
+  Load("worlds/empty.world", true, "bullet");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  EXPECT_EQ(1, boost::any_cast<int>(physics->GetParam("threads")));
+
+  BulletPhysicsPtr bulletPhysics
+      = boost::static_pointer_cast<BulletPhysics>(physics);
+  ASSERT_TRUE(bulletPhysics != nullptr);
+  EXPECT_TRUE(bulletPhysics->GetDynamicsWorld() != nullptr);
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gazebo/physics/dart/DARTJoint.hh"
+#include "gazebo/physics/dart/DARTModel.hh"
+#include "gazebo/physics/dart/DARTJointBatch.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+DARTJointBatch::DARTJointBatch(const Joint_V &_joints)
+  : JointBatch(_joints)
+{
+}
+
+/////////////////////////////////////////////////
+DARTJointBatch::~DARTJointBatch()
+{
+}
+
+/////////////////////////////////////////////////
+bool DARTJointBatch::Resolve() const
+{
+  if (this->skeleton)
+    return true;
+  if (this->generic || this->joints.empty())
+    return false;
+
+  dart::dynamics::SkeletonPtr jointSkeleton;
+  std::vector<std::size_t> indices;
+  indices.reserve(this->axisJoints.size());
+  for (size_t i = 0; i < this->axisJoints.size(); ++i)
+  {
+    DARTJoint *joint = dynamic_cast<DARTJoint *>(this->axisJoints[i]);
+    if (!joint)
+    {
+      this->generic = true;
+      return false;
+    }
+
+    dart::dynamics::Joint *dtJoint = joint->GetDARTJoint();
+    if (!dtJoint)
+    {
+      // Not initialized yet, try again on the next read
+      return false;
+    }
+
+    DARTModelPtr model = joint->GetDARTModel();
+    if (!model || model->IsStatic() || !dtJoint->getSkeleton() ||
+        joint->DOF() != dtJoint->getNumDofs() ||
+        (jointSkeleton && jointSkeleton != dtJoint->getSkeleton()))
+    {
+      this->generic = true;
+      return false;
+    }
+
+    jointSkeleton = dtJoint->getSkeleton();
+    indices.push_back(dtJoint->getIndexInSkeleton(this->axisIndices[i]));
+  }
+
+  this->skeleton = jointSkeleton;
+  this->dofIndices.swap(indices);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void DARTJointBatch::Positions(std::vector<double> &_positions) const
+{
+  if (!this->Resolve())
+  {
+    JointBatch::Positions(_positions);
+    return;
+  }
+
+  const Eigen::VectorXd values = this->skeleton->getPositions(
+      this->dofIndices);
+  _positions.assign(values.data(), values.data() + values.size());
+}
+
+/////////////////////////////////////////////////
+void DARTJointBatch::Velocities(std::vector<double> &_velocities) const
+{
+  if (!this->Resolve())
+  {
+    JointBatch::Velocities(_velocities);
+    return;
+  }
+
+  const Eigen::VectorXd values = this->skeleton->getVelocities(
+      this->dofIndices);
+  _velocities.assign(values.data(), values.data() + values.size());
+}
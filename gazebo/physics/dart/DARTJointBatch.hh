@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_DART_DARTJOINTBATCH_HH_
+#define GAZEBO_PHYSICS_DART_DARTJOINTBATCH_HH_
+
+#include <vector>
+
+#include "gazebo/physics/JointBatch.hh"
+#include "gazebo/physics/dart/dart_inc.h"
+#include "gazebo/physics/dart/DARTTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics_dart
+    /// \{
+
+    /// \class DARTJointBatch DARTJointBatch.hh physics/physics.hh
+    /// \brief Joint batch that reads the positions and velocities from the
+    /// generalized coordinates of the DART skeleton with a single indexed
+    /// gather. The degrees of freedom are resolved the first time all the
+    /// joints are initialized. Joints of several models, or of a static
+    /// model, are read through the generic batch.
+    class GZ_PHYSICS_VISIBLE DARTJointBatch : public JointBatch
+    {
+      /// \brief Constructor.
+      /// \param[in] _joints Joints of the batch.
+      public: explicit DARTJointBatch(const Joint_V &_joints);
+
+      /// \brief Destructor.
+      public: virtual ~DARTJointBatch();
+
+      // Documentation inherited
+      public: virtual void Positions(std::vector<double> &_positions) const;
+
+      // Documentation inherited
+      public: virtual void Velocities(std::vector<double> &_velocities) const;
+
+      /// \brief Resolve the skeleton degrees of freedom of the axes.
+      /// \return True if all the axes belong to the same skeleton.
+      private: bool Resolve() const;
+
+      /// \brief Skeleton of all the joints, once resolved.
+      private: mutable dart::dynamics::SkeletonPtr skeleton;
+
+      /// \brief Index in the skeleton of the degree of freedom of each
+      /// axis.
+      private: mutable std::vector<std::size_t> dofIndices;
+
+      /// \brief True if the axes can't be read from a single skeleton.
+      private: mutable bool generic = false;
+    };
+    /// \}
+  }
+}
+#endif
@@ -972,7 +972,7 @@ void DARTLink::updateDirtyPoseFromDARTTransformation()
 
   // Set the new pose to the world
   // (Below method can be changed in gazebo code)
-  this->world->dataPtr->dirtyPoses.push_back(this);
+  this->world->_AddDirty(this);
 }
 
 //////////////////////////////////////////////////
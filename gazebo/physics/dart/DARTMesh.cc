@@ -15,9 +15,13 @@
  *
 */
 
+#include <sstream>
+
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/Console.hh"
 #include "gazebo/common/Mesh.hh"
 
+#include "gazebo/physics/World.hh"
 #include "gazebo/physics/dart/DARTCollision.hh"
 #include "gazebo/physics/dart/DARTPhysics.hh"
 #include "gazebo/physics/dart/DARTMesh.hh"
@@ -44,20 +48,24 @@ void DARTMesh::Init(const common::SubMesh *_subMesh,
                     DARTCollisionPtr _collision,
                     const ignition::math::Vector3d &_scale)
 {
-  float *vertices = nullptr;
-  int *indices = nullptr;
+  this->CreateShapeNode(_subMesh, _collision, _scale, [&]()
+  {
+    float *vertices = nullptr;
+    int *indices = nullptr;
 
-  unsigned int numVertices = _subMesh->GetVertexCount();
-  unsigned int numIndices = _subMesh->GetIndexCount();
+    unsigned int numVertices = _subMesh->GetVertexCount();
+    unsigned int numIndices = _subMesh->GetIndexCount();
 
-  // Get all the vertex and index data
-  _subMesh->FillArrays(&vertices, &indices);
+    // Get all the vertex and index data
+    _subMesh->FillArrays(&vertices, &indices);
 
-  this->CreateMesh(vertices, indices, numVertices, numIndices,
-                   _collision, _scale);
+    dart::dynamics::ShapePtr shape = this->CreateMesh(vertices, indices,
+        numVertices, numIndices, _scale);
 
-  delete [] vertices;
-  delete [] indices;
+    delete [] vertices;
+    delete [] indices;
+    return shape;
+  });
 }
 
 //////////////////////////////////////////////////
@@ -65,28 +73,82 @@ void DARTMesh::Init(const common::Mesh *_mesh,
                     DARTCollisionPtr _collision,
                     const ignition::math::Vector3d &_scale)
 {
-  float *vertices = nullptr;
-  int *indices = nullptr;
+  this->CreateShapeNode(_mesh, _collision, _scale, [&]()
+  {
+    float *vertices = nullptr;
+    int *indices = nullptr;
 
-  unsigned int numVertices = _mesh->GetVertexCount();
-  unsigned int numIndices = _mesh->GetIndexCount();
+    unsigned int numVertices = _mesh->GetVertexCount();
+    unsigned int numIndices = _mesh->GetIndexCount();
 
-  // Get all the vertex and index data
-  _mesh->FillArrays(&vertices, &indices);
+    // Get all the vertex and index data
+    _mesh->FillArrays(&vertices, &indices);
 
-  this->CreateMesh(vertices, indices, numVertices, numIndices,
-                   _collision, _scale);
-  delete [] vertices;
-  delete [] indices;
+    dart::dynamics::ShapePtr shape = this->CreateMesh(vertices, indices,
+        numVertices, numIndices, _scale);
+
+    delete [] vertices;
+    delete [] indices;
+    return shape;
+  });
 }
 
 /////////////////////////////////////////////////
-void DARTMesh::CreateMesh(float *_vertices, int *_indices,
-    unsigned int _numVertices, unsigned int _numIndices,
-    DARTCollisionPtr _collision, const ignition::math::Vector3d &_scale)
+void DARTMesh::CreateShapeNode(const void *_mesh,
+    DARTCollisionPtr _collision, const ignition::math::Vector3d &_scale,
+    const std::function<dart::dynamics::ShapePtr()> &_create)
 {
   GZ_ASSERT(_collision, "DART collision is null");
+  GZ_ASSERT(_collision->DARTBodyNode(),
+            "DART _collision->DARTBodyNode() is null");
+
+  dart::dynamics::ShapePtr dtMeshShape;
+  DARTPhysicsPtr physics;
+  if (_collision->GetWorld())
+  {
+    physics = boost::dynamic_pointer_cast<DARTPhysics>(
+        _collision->GetWorld()->Physics());
+  }
 
+  if (physics)
+  {
+    // DART's own collision detector has no mesh support, so a mesh only
+    // takes part in collisions with the bullet or fcl detectors
+    if (physics->CollisionDetectorInUse() == "dart")
+    {
+      static bool warned = false;
+      if (!warned)
+      {
+        gzwarn << "The DART collision detector does not support meshes, "
+               << "mesh collisions are ignored. Use the bullet or fcl "
+               << "<collision_detector> for mesh collisions.\n";
+        warned = true;
+      }
+    }
+
+    std::ostringstream key;
+    key << _mesh << " " << _scale;
+    dtMeshShape = physics->SharedShape(key.str(), _create);
+  }
+  else
+  {
+    dtMeshShape = _create();
+  }
+
+  dart::dynamics::ShapeNode *node =
+    _collision->DARTBodyNode()->createShapeNodeWith<
+      dart::dynamics::VisualAspect,
+      dart::dynamics::CollisionAspect,
+      dart::dynamics::DynamicsAspect>(dtMeshShape);
+
+  this->dataPtr->dtMeshShape.set(node);
+}
+
+/////////////////////////////////////////////////
+dart::dynamics::ShapePtr DARTMesh::CreateMesh(float *_vertices,
+    int *_indices, unsigned int _numVertices, unsigned int _numIndices,
+    const ignition::math::Vector3d &_scale)
+{
   // Create new aiScene (aiMesh)
   aiScene *assimpScene = new aiScene;
   aiMesh *assimpMesh = new aiMesh;
@@ -122,18 +184,8 @@ void DARTMesh::CreateMesh(float *_vertices, int *_indices,
     itAIFace->mIndices[2] = _indices[i*3 + 2];
   }
 
-  dart::dynamics::ShapePtr dtMeshShape(new dart::dynamics::MeshShape(
+  return dart::dynamics::ShapePtr(new dart::dynamics::MeshShape(
       DARTTypes::ConvVec3(_scale), assimpScene));
-  GZ_ASSERT(_collision->DARTBodyNode(),
-            "DART _collision->DARTBodyNode() is null");
-
-  dart::dynamics::ShapeNode *node =
-    _collision->DARTBodyNode()->createShapeNodeWith<
-      dart::dynamics::VisualAspect,
-      dart::dynamics::CollisionAspect,
-      dart::dynamics::DynamicsAspect>(dtMeshShape);
-
-  this->dataPtr->dtMeshShape.set(node);
 }
 
 /////////////////////////////////////////////////
@@ -18,6 +18,9 @@
 #ifndef GAZEBO_PHYSICS_DART_DARTMESH_HH_
 #define GAZEBO_PHYSICS_DART_DARTMESH_HH_
 
+#include <functional>
+#include <string>
+
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/dart/DARTTypes.hh"
@@ -67,11 +70,25 @@ namespace gazebo
       /// \param[in] _indices Array of indices.
       /// \param[in] _numVertices Number of vertices.
       /// \param[in] _numIndices Number of indices.
+      /// \param[in] _scale Scaling factor.
+      /// \return The DART mesh shape.
+      private: dart::dynamics::ShapePtr CreateMesh(float *_vertices,
+                   int *_indices, unsigned int _numVertices,
+                   unsigned int _numIndices,
+                   const ignition::math::Vector3d &_scale);
+
+      /// \brief Create the shape node of the collision. The shape is shared
+      /// with the other collisions that use the same mesh and scale, see
+      /// DARTPhysics::SharedShape.
+      /// \param[in] _mesh Address of the mesh or submesh. Meshes loaded
+      /// through the MeshManager keep their address until shutdown.
       /// \param[in] _collision Pointer to the collision object.
-      private: void CreateMesh(float *_vertices, int *_indices,
-                   unsigned int _numVertices, unsigned int _numIndices,
+      /// \param[in] _scale Scaling factor.
+      /// \param[in] _create Creates the shape if it is not shared yet.
+      private: void CreateShapeNode(const void *_mesh,
                    DARTCollisionPtr _collision,
-                   const ignition::math::Vector3d &_scale);
+                   const ignition::math::Vector3d &_scale,
+                   const std::function<dart::dynamics::ShapePtr()> &_create);
 
       /// \internal
       /// \brief Pointer to private data
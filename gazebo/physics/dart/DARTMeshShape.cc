@@ -61,8 +61,15 @@ void DARTMeshShape::Init()
 {
   MeshShape::Init();
 
-
-  if (this->submesh)
+  // DART collides with mesh shapes through its collision detector, so the
+  // convex hulls replace the triangles with far fewer of them.
+  if (this->ConvexHulls())
+  {
+    this->dataPtr->dartMesh->Init(this->ConvexHulls(),
+        boost::dynamic_pointer_cast<DARTCollision>(this->collisionParent),
+        this->sdf->Get<ignition::math::Vector3d>("scale"));
+  }
+  else if (this->submesh)
   {
     this->dataPtr->dartMesh->Init(this->submesh,
         boost::dynamic_pointer_cast<DARTCollision>(this->collisionParent),
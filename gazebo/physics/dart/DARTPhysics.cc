@@ -25,11 +25,20 @@
 #include <dart/collision/dart/dart.hpp>
 #include <dart/collision/fcl/fcl.hpp>
 
-#include <ignition/common/Profiler.hh>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/TraceCapture.hh"
 
 #include "gazebo/transport/Publisher.hh"
 
@@ -50,6 +59,7 @@
 #include "gazebo/physics/dart/DARTBallJoint.hh"
 #include "gazebo/physics/dart/DARTUniversalJoint.hh"
 #include "gazebo/physics/dart/DARTFixedJoint.hh"
+#include "gazebo/physics/dart/DARTJointBatch.hh"
 
 #include "gazebo/physics/dart/DARTRayShape.hh"
 #include "gazebo/physics/dart/DARTBoxShape.hh"
@@ -97,6 +107,18 @@ void DARTPhysics::Load(sdf::ElementPtr _sdf)
   if (g == ignition::math::Vector3d::Zero)
     gzwarn << "Gravity vector is (0, 0, 0). Objects will float.\n";
   this->dataPtr->dtWorld->setGravity(Eigen::Vector3d(g.X(), g.Y(), g.Z()));
+
+  // The collision detector has to be chosen before any shape is created,
+  // since collision shapes are created for the detector in use
+  if (this->sdf->HasElement("dart"))
+  {
+    sdf::ElementPtr dartElem = this->sdf->GetElement("dart");
+    if (dartElem->HasElement("collision_detector"))
+    {
+      this->SetParam("collision_detector",
+          dartElem->Get<std::string>("collision_detector"));
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -108,6 +130,40 @@ std::string DARTPhysics::CollisionDetectorInUse() const
   return cd->getType();
 }
 
+//////////////////////////////////////////////////
+dart::dynamics::ShapePtr DARTPhysics::SharedShape(const std::string &_key,
+    const std::function<dart::dynamics::ShapePtr()> &_create)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->sharedShapesMutex);
+
+  // Shapes are cached per collision detector, each builds its own
+  // collision object from the shape
+  const std::string key = this->CollisionDetectorInUse() + ":" + _key;
+  auto iter = this->dataPtr->sharedShapes.find(key);
+  if (iter != this->dataPtr->sharedShapes.end())
+  {
+    dart::dynamics::ShapePtr shape = iter->second.lock();
+    if (shape)
+      return shape;
+  }
+
+  dart::dynamics::ShapePtr shape = _create();
+  if (shape)
+    this->dataPtr->sharedShapes[key] = shape;
+
+  // Forget shapes that are no longer used by any collision
+  for (auto it = this->dataPtr->sharedShapes.begin();
+       it != this->dataPtr->sharedShapes.end();)
+  {
+    if (it->second.expired())
+      it = this->dataPtr->sharedShapes.erase(it);
+    else
+      ++it;
+  }
+
+  return shape;
+}
+
 //////////////////////////////////////////////////
 void DARTPhysics::Init()
 {
@@ -351,7 +407,7 @@ static void RetrieveDARTCollisions(
     dart::dynamics::BodyNode *dtBodyNode1 = dartLink1->DARTBodyNode();
     dart::dynamics::BodyNode *dtBodyNode2 = dartLink2->DARTBodyNode();
 
-    contactFeedback->count = 0;
+    contactFeedback->Reset();
 
     std::deque<const dart::collision::Contact*>::const_iterator contIt;
     int contNum = 0;
@@ -387,12 +443,9 @@ static void RetrieveDARTCollisions(
       localTorque2 = body2Pose.Rot().RotateVectorReverse(
           DARTTypes::ConvVec3Ign(torqueB));
 
-      contactFeedback->positions[contNum] =
-        DARTTypes::ConvVec3Ign(dtContact->point);
-      contactFeedback->normals[contNum] =
-        DARTTypes::ConvVec3Ign(dtContact->normal);
-      contactFeedback->depths[contNum] =
-        dtContact->penetrationDepth;
+      contactFeedback->AddPoint(DARTTypes::ConvVec3Ign(dtContact->point),
+          DARTTypes::ConvVec3Ign(dtContact->normal),
+          dtContact->penetrationDepth);
 
       if (!dartLink1->IsStatic())
       {
@@ -405,8 +458,6 @@ static void RetrieveDARTCollisions(
         contactFeedback->wrench[contNum].body2Force = localForce2;
         contactFeedback->wrench[contNum].body2Torque = localTorque2;
       }
-
-      ++contactFeedback->count;
     }
   }
 }
@@ -448,8 +499,13 @@ void DARTPhysics::UpdatePhysics()
   // common::Time currTime =  this->world->GetRealTime();
 
   this->dataPtr->dtWorld->setTimeStep(this->maxStepSize);
-  this->dataPtr->dtWorld->step(
-        this->dataPtr->resetAllForcesAfterSimulationStep);
+  if (this->substeppedModelCount > 0)
+    this->StepSubstepped();
+  else if (!this->StepParallel())
+  {
+    this->dataPtr->dtWorld->step(
+          this->dataPtr->resetAllForcesAfterSimulationStep);
+  }
 
   // Update all the transformation of DART's links to gazebo's links
   // TODO: How to visit all the links in the world?
@@ -479,6 +535,156 @@ void DARTPhysics::UpdatePhysics()
   IGN_PROFILE_END();
 }
 
+//////////////////////////////////////////////////
+bool DARTPhysics::StepParallel()
+{
+  if (this->dataPtr->parallelSkeletonThreshold <= 0)
+    return false;
+
+  dart::simulation::WorldPtr dtWorld = this->dataPtr->dtWorld;
+  std::vector<dart::dynamics::Skeleton *> &skeletons =
+      this->dataPtr->mobileSkeletons;
+  skeletons.clear();
+  for (std::size_t i = 0; i < dtWorld->getNumSkeletons(); ++i)
+  {
+    dart::dynamics::Skeleton *skeleton = dtWorld->getSkeleton(i).get();
+    if (skeleton->isMobile())
+      skeletons.push_back(skeleton);
+  }
+
+  if (skeletons.size() <
+      static_cast<std::size_t>(this->dataPtr->parallelSkeletonThreshold))
+  {
+    return false;
+  }
+
+  IGN_PROFILE("DARTPhysics::StepParallel");
+  const double dt = dtWorld->getTimeStep();
+  const bool resetForces = this->dataPtr->resetAllForcesAfterSimulationStep;
+
+  // Each skeleton only reads the world gravity and writes its own state, so
+  // the skeletons may be integrated in any order.
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, skeletons.size()),
+      [&](const tbb::blocked_range<std::size_t> &_r)
+      {
+        for (std::size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          skeletons[i]->computeForwardDynamics();
+          skeletons[i]->integrateVelocities(dt);
+        }
+      });
+
+  // Collision detection and the constraint impulses of the skeletons that
+  // touch each other.
+  IGN_PROFILE_BEGIN("solve");
+  dtWorld->getConstraintSolver()->solve();
+  IGN_PROFILE_END();
+
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, skeletons.size()),
+      [&](const tbb::blocked_range<std::size_t> &_r)
+      {
+        for (std::size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          dart::dynamics::Skeleton *skeleton = skeletons[i];
+          if (skeleton->isImpulseApplied())
+          {
+            skeleton->computeImpulseForwardDynamics();
+            skeleton->setImpulseApplied(false);
+          }
+
+          skeleton->integratePositions(dt);
+
+          if (resetForces)
+          {
+            skeleton->clearInternalForces();
+            skeleton->clearExternalForces();
+            skeleton->resetCommands();
+          }
+        }
+      });
+
+  dtWorld->setTime(dtWorld->getTime() + dt);
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the largest step divisor of a model and its nested models.
+/// \param[in] _model The model.
+/// \return Step divisor.
+static unsigned int ModelStepDivisor(const ModelPtr &_model)
+{
+  unsigned int divisor = _model->StepDivisor();
+  for (auto const &nested : _model->NestedModels())
+    divisor = std::max(divisor, ModelStepDivisor(nested));
+  return divisor;
+}
+
+//////////////////////////////////////////////////
+void DARTPhysics::StepSubstepped()
+{
+  IGN_PROFILE("DARTPhysics::StepSubstepped");
+
+  dart::simulation::WorldPtr dtWorld = this->dataPtr->dtWorld;
+  const double dt = dtWorld->getTimeStep();
+  const double time = dtWorld->getTime();
+  const bool resetForces = this->dataPtr->resetAllForcesAfterSimulationStep;
+
+  auto &skeletons = this->dataPtr->substepSkeletons;
+  skeletons.clear();
+  std::vector<unsigned int> divisors;
+  for (auto const &model : this->world->Models())
+  {
+    DARTModelPtr dartModel = boost::dynamic_pointer_cast<DARTModel>(model);
+    if (!dartModel)
+      continue;
+
+    dart::dynamics::SkeletonPtr skeleton = dartModel->DARTSkeleton();
+    if (!skeleton || !skeleton->isMobile())
+      continue;
+
+    const unsigned int divisor = ModelStepDivisor(model);
+    skeletons.emplace_back(skeleton.get(), divisor);
+    if (divisor > 1)
+      divisors.push_back(divisor);
+  }
+  std::sort(divisors.begin(), divisors.end(), std::greater<unsigned int>());
+  divisors.erase(std::unique(divisors.begin(), divisors.end()),
+      divisors.end());
+
+  for (const unsigned int divisor : divisors)
+  {
+    for (auto const &skeleton : skeletons)
+      skeleton.first->setMobile(skeleton.second == divisor);
+
+    // Keep the forces for all substeps, and clear them afterwards.
+    dtWorld->setTimeStep(dt / divisor);
+    for (unsigned int i = 0; i < divisor; ++i)
+      dtWorld->step(false);
+
+    if (resetForces)
+    {
+      for (auto const &skeleton : skeletons)
+      {
+        if (skeleton.second == divisor)
+        {
+          skeleton.first->clearInternalForces();
+          skeleton.first->clearExternalForces();
+          skeleton.first->resetCommands();
+        }
+      }
+    }
+  }
+
+  for (auto const &skeleton : skeletons)
+    skeleton.first->setMobile(skeleton.second == 1);
+  dtWorld->setTimeStep(dt);
+  dtWorld->step(resetForces);
+
+  for (auto const &skeleton : skeletons)
+    skeleton.first->setMobile(true);
+  dtWorld->setTime(time + dt);
+}
+
 //////////////////////////////////////////////////
 std::string DARTPhysics::GetType() const
 {
@@ -587,6 +793,12 @@ JointPtr DARTPhysics::CreateJoint(const std::string &_type, ModelPtr _parent)
   return joint;
 }
 
+//////////////////////////////////////////////////
+JointBatchPtr DARTPhysics::CreateJointBatch(const Joint_V &_joints)
+{
+  return JointBatchPtr(new DARTJointBatch(_joints));
+}
+
 //////////////////////////////////////////////////
 std::string DARTPhysics::GetSolverType() const
 {
@@ -685,6 +897,12 @@ boost::any DARTPhysics::GetParam(const std::string &_key) const
 //////////////////////////////////////////////////
 bool DARTPhysics::GetParam(const std::string &_key, boost::any &_value) const
 {
+  if (_key == "parallel_skeleton_threshold")
+  {
+    _value = this->dataPtr->parallelSkeletonThreshold;
+    return true;
+  }
+
   if (!this->sdf->HasElement("dart"))
   {
     return PhysicsEngine::GetParam(_key, _value);
@@ -698,6 +916,10 @@ bool DARTPhysics::GetParam(const std::string &_key, boost::any &_value) const
   {
     _value = this->GetSolverType();
   }
+  else if (_key == "collision_detector")
+  {
+    _value = this->CollisionDetectorInUse();
+  }
   else if (_key == "max_contacts")
   {
     _value = dartElem->GetElement("max_contacts")->Get<int>();
@@ -741,6 +963,17 @@ bool DARTPhysics::SetParam(const std::string &_key, const boost::any &_value)
       this->dataPtr->resetAllForcesAfterSimulationStep =
           any_cast<bool>(_value);
     }
+    else if (_key == "parallel_skeleton_threshold")
+    {
+      int value = any_cast<int>(_value);
+      if (value < 0)
+      {
+        gzerr << "parallel_skeleton_threshold must be positive, or zero "
+              << "to disable the parallel step\n";
+        return false;
+      }
+      this->dataPtr->parallelSkeletonThreshold = value;
+    }
     else if (_key == "collision_detector")
     {
       // set collision detector
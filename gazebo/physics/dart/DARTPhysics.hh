@@ -18,6 +18,7 @@
 #ifndef _GAZEBO_DARTPHYSICS_HH_
 #define _GAZEBO_DARTPHYSICS_HH_
 
+#include <functional>
 #include <string>
 
 #include <boost/thread/thread.hpp>
@@ -122,6 +123,9 @@ namespace gazebo
       public: virtual JointPtr CreateJoint(const std::string &_type,
                                            ModelPtr _parent);
 
+      // Documentation inherited
+      public: virtual JointBatchPtr CreateJointBatch(const Joint_V &_joints);
+
       // Documentation inherited
       public: virtual ShapePtr CreateShape(const std::string &_shapeType,
                                            CollisionPtr _collision);
@@ -159,6 +163,18 @@ namespace gazebo
       /// detector has been loaded yet, the empty string is returned.
       public: std::string CollisionDetectorInUse() const;
 
+      /// \brief Get a collision shape shared by all collisions with the
+      /// same geometry. Collision detectors build one collision object per
+      /// shape, so sharing the shape keeps mesh geometry from being built
+      /// once per collision. Shapes are kept per collision detector, and
+      /// only while a collision uses them.
+      /// \param[in] _key Identifies the geometry, including its scale.
+      /// \param[in] _create Creates the shape if no collision uses one with
+      /// this key.
+      /// \return The shared shape.
+      public: dart::dynamics::ShapePtr SharedShape(const std::string &_key,
+                  const std::function<dart::dynamics::ShapePtr()> &_create);
+
       // Documentation inherited
       protected: virtual void OnRequest(ConstRequestPtr &_msg);
 
@@ -171,6 +187,23 @@ namespace gazebo
       private: DARTLinkPtr FindDARTLink(
           const dart::dynamics::BodyNode *_dtBodyNode);
 
+      /// \brief Step the DART world like dart::simulation::World::step, but
+      /// run the forward dynamics and the integration of the skeletons in
+      /// parallel. Contacts and joint constraints are still solved by the
+      /// constraint solver of the world, serially and in its own order, so
+      /// the result is the same as the one of a serial step.
+      /// \return False if there are fewer mobile skeletons than the
+      /// parallel threshold and nothing was stepped.
+      private: bool StepParallel();
+
+      /// \brief Step the DART world when some models have a step divisor.
+      /// For each divisor, from the largest, the skeletons of the other
+      /// models are made immobile and the world is stepped that many
+      /// times with a fraction of the step size. The remaining skeletons
+      /// then take a single step. While a group of skeletons is stepped,
+      /// the other skeletons act on it like static objects.
+      private: void StepSubstepped();
+
       /// \internal
       /// \brief Pointer to private data.
       private: DARTPhysicsPrivate *dataPtr = nullptr;
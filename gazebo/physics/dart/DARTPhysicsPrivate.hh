@@ -18,6 +18,13 @@
 #ifndef _GAZEBO_DARTPHYSICS_PRIVATE_HH_
 #define _GAZEBO_DARTPHYSICS_PRIVATE_HH_
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "gazebo/physics/dart/dart_inc.h"
 
 namespace gazebo
@@ -50,6 +57,27 @@ namespace gazebo
       /// and torques (both internal and external) after completing a simulation
       /// step. Default value is true.
       public: bool resetAllForcesAfterSimulationStep;
+
+      /// \brief Number of mobile skeletons at which a step integrates the
+      /// skeletons in parallel, 0 to always step serially.
+      public: int parallelSkeletonThreshold = 0;
+
+      /// \brief Mobile skeletons of the current parallel step, kept to
+      /// reuse the allocation.
+      public: std::vector<dart::dynamics::Skeleton *> mobileSkeletons;
+
+      /// \brief Mobile skeletons of the current substepped step, with the
+      /// step divisor of their model.
+      public: std::vector<std::pair<dart::dynamics::Skeleton *,
+               unsigned int>> substepSkeletons;
+
+      /// \brief Collision shapes shared between collisions, by collision
+      /// detector and geometry, see DARTPhysics::SharedShape.
+      public: std::map<std::string, std::weak_ptr<dart::dynamics::Shape>>
+               sharedShapes;
+
+      /// \brief Protects sharedShapes.
+      public: std::mutex sharedShapesMutex;
     };
   }
 }
@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <fcl/BVH_model.h>
+#include <fcl/collision.h>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/ode/ODEFCLCollider.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \brief FCL mesh with oriented bounding boxes.
+    typedef fcl::BVHModel<fcl::OBB> ODEFCLModel;
+
+    /// \brief Triangles of a registered trimesh geom.
+    class ODEFCLMesh
+    {
+      /// \brief Object that registered the geom.
+      public: const void *owner = nullptr;
+
+      /// \brief Vertices, x y z per vertex.
+      public: const float *vertices = nullptr;
+
+      /// \brief Number of vertices.
+      public: int vertexCount = 0;
+
+      /// \brief Vertex indices, three per triangle.
+      public: const int *indices = nullptr;
+
+      /// \brief Number of indices.
+      public: int indexCount = 0;
+
+      /// \brief Key of the shared tree.
+      public: const void *shareKey = nullptr;
+
+      /// \brief Shared tree, kept alive by the geoms that use it.
+      public: std::shared_ptr<const ODEFCLModel> tree;
+
+      /// \brief Copy of the tree that holds the pose of the geom.
+      public: std::unique_ptr<ODEFCLModel> model;
+
+      /// \brief True if the tree could not be built.
+      public: bool failed = false;
+    };
+
+    /// \brief Registered geoms and shared trees.
+    class ODEFCLRegistry
+    {
+      /// \brief Protects the maps.
+      public: std::mutex mutex;
+
+      /// \brief Registered geoms.
+      public: std::unordered_map<dGeomID, ODEFCLMesh> meshes;
+
+      /// \brief Shared trees by key.
+      public: std::map<const void *, std::weak_ptr<const ODEFCLModel>> trees;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief All the registered geoms.
+static ODEFCLRegistry g_fclRegistry;
+
+/////////////////////////////////////////////////
+/// \brief Build the tree of a mesh.
+/// \param[in] _mesh The mesh.
+/// \return The tree, nullptr if the mesh has no valid triangles.
+static std::shared_ptr<const ODEFCLModel> BuildTree(const ODEFCLMesh &_mesh)
+{
+  std::vector<fcl::Vec3f> points(_mesh.vertexCount);
+  for (int i = 0; i < _mesh.vertexCount; ++i)
+  {
+    points[i] = fcl::Vec3f(_mesh.vertices[i*3+0], _mesh.vertices[i*3+1],
+        _mesh.vertices[i*3+2]);
+  }
+
+  std::vector<fcl::Triangle> triangles;
+  triangles.reserve(_mesh.indexCount / 3);
+  for (int i = 0; i + 2 < _mesh.indexCount; i += 3)
+  {
+    const int *index = _mesh.indices + i;
+    if (index[0] < 0 || index[1] < 0 || index[2] < 0 ||
+        index[0] >= _mesh.vertexCount || index[1] >= _mesh.vertexCount ||
+        index[2] >= _mesh.vertexCount)
+    {
+      continue;
+    }
+    triangles.push_back(fcl::Triangle(index[0], index[1], index[2]));
+  }
+
+  if (triangles.empty())
+    return nullptr;
+
+  std::shared_ptr<ODEFCLModel> tree(new ODEFCLModel);
+  if (tree->beginModel(triangles.size(), points.size()) != fcl::BVH_OK ||
+      tree->addSubModel(points, triangles) != fcl::BVH_OK ||
+      tree->endModel() != fcl::BVH_OK)
+  {
+    return nullptr;
+  }
+  tree->computeLocalAABB();
+  return tree;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the model of a registered geom, building it if needed.
+/// Must be called with the registry locked.
+/// \param[in] _geom The geom.
+/// \return The model, nullptr if the geom is not registered or its tree
+/// can't be built.
+static ODEFCLModel *GeomModel(dGeomID _geom)
+{
+  auto iter = g_fclRegistry.meshes.find(_geom);
+  if (iter == g_fclRegistry.meshes.end())
+    return nullptr;
+
+  ODEFCLMesh &mesh = iter->second;
+  if (!mesh.model && !mesh.failed)
+  {
+    if (mesh.shareKey)
+      mesh.tree = g_fclRegistry.trees[mesh.shareKey].lock();
+    if (!mesh.tree)
+    {
+      mesh.tree = BuildTree(mesh);
+      if (mesh.shareKey)
+        g_fclRegistry.trees[mesh.shareKey] = mesh.tree;
+    }
+
+    if (mesh.tree)
+    {
+      mesh.model.reset(new ODEFCLModel(*mesh.tree));
+    }
+    else
+    {
+      gzwarn << "Unable to build the FCL tree of a triangle mesh, "
+             << "using the ODE collider for it.\n";
+      mesh.failed = true;
+    }
+  }
+
+  if (!mesh.model)
+    return nullptr;
+
+  // Pose of the geom, offset included
+  const dReal *pos = dGeomGetPosition(_geom);
+  const dReal *rot = dGeomGetRotation(_geom);
+  const fcl::Vec3f rows[3] = {
+      fcl::Vec3f(rot[0], rot[1], rot[2]),
+      fcl::Vec3f(rot[4], rot[5], rot[6]),
+      fcl::Vec3f(rot[8], rot[9], rot[10])};
+  mesh.model->setTransform(rows, fcl::Vec3f(pos[0], pos[1], pos[2]));
+  mesh.model->computeAABB();
+  return mesh.model.get();
+}
+
+/////////////////////////////////////////////////
+void ODEFCLCollider::AddMesh(const void *_owner, dGeomID _geom,
+    const float *_vertices, const int _vertexCount, const int *_indices,
+    const int _indexCount, const void *_shareKey)
+{
+  if (!_geom || !_vertices || !_indices)
+    return;
+
+  std::lock_guard<std::mutex> lock(g_fclRegistry.mutex);
+  ODEFCLMesh &mesh = g_fclRegistry.meshes[_geom];
+  mesh = ODEFCLMesh();
+  mesh.owner = _owner;
+  mesh.vertices = _vertices;
+  mesh.vertexCount = _vertexCount;
+  mesh.indices = _indices;
+  mesh.indexCount = _indexCount;
+  mesh.shareKey = _shareKey;
+}
+
+/////////////////////////////////////////////////
+void ODEFCLCollider::RemoveMesh(const void *_owner, dGeomID _geom)
+{
+  std::lock_guard<std::mutex> lock(g_fclRegistry.mutex);
+  auto iter = g_fclRegistry.meshes.find(_geom);
+  if (iter == g_fclRegistry.meshes.end() || iter->second.owner != _owner)
+    return;
+
+  const void *key = iter->second.shareKey;
+  g_fclRegistry.meshes.erase(iter);
+
+  auto tree = g_fclRegistry.trees.find(key);
+  if (tree != g_fclRegistry.trees.end() && tree->second.expired())
+    g_fclRegistry.trees.erase(tree);
+}
+
+/////////////////////////////////////////////////
+int ODEFCLCollider::Collide(dGeomID _geom1, dGeomID _geom2,
+    const int _maxContacts, dContactGeom *_contacts)
+{
+  if (_maxContacts <= 0)
+    return 0;
+
+  std::lock_guard<std::mutex> lock(g_fclRegistry.mutex);
+  ODEFCLModel *model1 = GeomModel(_geom1);
+  ODEFCLModel *model2 = GeomModel(_geom2);
+  if (!model1 || !model2)
+    return -1;
+
+  std::vector<fcl::Contact> contacts;
+  int count = fcl::collide(model1, model2, _maxContacts, false, true,
+      contacts);
+  count = std::min(count, static_cast<int>(contacts.size()));
+
+  for (int i = 0; i < count; ++i)
+  {
+    const fcl::Contact &contact = contacts[i];
+    dContactGeom &result = _contacts[i];
+
+    // FCL normals point from the first object to the second one, ODE
+    // normals push the first geom out of the second one.
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      result.pos[j] = contact.pos[j];
+      result.normal[j] = -contact.normal[j];
+    }
+    result.pos[3] = 0;
+    result.normal[3] = 0;
+    result.depth = contact.penetration_depth;
+    result.g1 = _geom1;
+    result.g2 = _geom2;
+    result.side1 = contact.b1;
+    result.side2 = contact.b2;
+  }
+
+  return count;
+}
+
+/////////////////////////////////////////////////
+size_t ODEFCLCollider::TreeCount()
+{
+  std::lock_guard<std::mutex> lock(g_fclRegistry.mutex);
+  size_t count = 0;
+  for (auto const &tree : g_fclRegistry.trees)
+  {
+    if (!tree.second.expired())
+      ++count;
+  }
+
+  // Meshes without a key own their tree
+  for (auto const &mesh : g_fclRegistry.meshes)
+  {
+    if (!mesh.second.shareKey && mesh.second.tree)
+      ++count;
+  }
+  return count;
+}
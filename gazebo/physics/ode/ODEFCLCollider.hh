@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_ODE_ODEFCLCOLLIDER_HH_
+#define GAZEBO_PHYSICS_ODE_ODEFCLCOLLIDER_HH_
+
+#include <cstddef>
+
+#include "gazebo/physics/ode/ode_inc.h"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics_ode
+    /// \{
+
+    /// \class ODEFCLCollider ODEFCLCollider.hh physics/physics.hh
+    /// \brief Triangle mesh against triangle mesh narrow phase based on
+    /// FCL, used instead of OPCODE when the mesh_collider parameter of
+    /// ODEPhysics is "fcl".
+    ///
+    /// ODEMesh registers the vertices of every trimesh geom. The OBB tree
+    /// of a mesh is built the first time it collides, once per shared
+    /// trimesh data, see MeshShape::CollisionGeometryKey. Each geom then
+    /// keeps its own copy of the tree, since FCL stores the pose in the
+    /// collision object, and only its pose is updated before each query.
+    /// The registry is shared by all the worlds. It is locked during the
+    /// queries, so the FCL pairs of the parallel narrow phase run one at a
+    /// time.
+    class GZ_PHYSICS_VISIBLE ODEFCLCollider
+    {
+      /// \brief Register the triangles of a trimesh geom. A geom that is
+      /// already registered is replaced.
+      /// \param[in] _owner Object that registers the geom, needed to
+      /// remove it.
+      /// \param[in] _geom The trimesh geom.
+      /// \param[in] _vertices Vertices, x y z per vertex, in the frame of
+      /// the geom. Must stay valid until the geom is removed.
+      /// \param[in] _vertexCount Number of vertices.
+      /// \param[in] _indices Vertex indices, three per triangle. Must stay
+      /// valid until the geom is removed.
+      /// \param[in] _indexCount Number of indices.
+      /// \param[in] _shareKey Geoms with the same non null key have the
+      /// same triangles and share one tree.
+      public: static void AddMesh(const void *_owner, dGeomID _geom,
+                  const float *_vertices, const int _vertexCount,
+                  const int *_indices, const int _indexCount,
+                  const void *_shareKey);
+
+      /// \brief Remove a trimesh geom, if it was registered by _owner.
+      /// \param[in] _owner Object that registered the geom.
+      /// \param[in] _geom The trimesh geom.
+      public: static void RemoveMesh(const void *_owner, dGeomID _geom);
+
+      /// \brief Collide two registered trimesh geoms.
+      /// \param[in] _geom1 First geom.
+      /// \param[in] _geom2 Second geom.
+      /// \param[in] _maxContacts Size of _contacts.
+      /// \param[out] _contacts Contacts, with the ODE conventions: the
+      /// normal points from _geom2 to _geom1 and the sides are the triangle
+      /// indices.
+      /// \return Number of contacts, or -1 if a geom is not registered or
+      /// its tree can't be built, in which case dCollide should be used.
+      public: static int Collide(dGeomID _geom1, dGeomID _geom2,
+                  const int _maxContacts, dContactGeom *_contacts);
+
+      /// \brief Get the number of trees built and still in use.
+      /// \return Number of trees, shared trees count once.
+      public: static size_t TreeCount();
+    };
+    /// \}
+  }
+}
+#endif
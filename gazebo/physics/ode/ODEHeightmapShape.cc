@@ -26,6 +26,10 @@ ODEHeightmapShape::ODEHeightmapShape(CollisionPtr _parent)
     : HeightmapShape(_parent)
 {
   this->flipY = false;
+
+  // ODE reads the heights through GetHeightCallback when the heightmap is
+  // tiled.
+  this->tilingSupported = true;
 }
 
 //////////////////////////////////////////////////
@@ -110,19 +114,44 @@ void ODEHeightmapShape::Init()
 
 
   // Step 3: Setup a callback method for ODE
-  setOdeHeightfieldDetails(
-      this->odeData,
-      this->heights.data(),
-      // in meters
-      this->Size().X(),
-      // in meters
-      this->Size().Y(),
-      // number of vertices
-      this->vertSize,
-      // vertical (z-axis) offset
-      this->Pos().Z(),
-      // vertical thickness for closing the height map mesh
-      1.0);
+  if (this->Tiled())
+  {
+    dGeomHeightfieldDataBuildCallback(
+        this->odeData,
+        this,
+        &ODEHeightmapShape::GetHeightCallback,
+        // in meters
+        this->Size().X(),
+        // in meters
+        this->Size().Y(),
+        // number of vertices
+        this->vertSize,
+        this->vertSize,
+        // vertical (z-axis) scaling
+        1.0,
+        // vertical (z-axis) offset
+        this->Pos().Z(),
+        // vertical thickness for closing the height map mesh
+        1.0,
+        // wrap mode
+        0);
+  }
+  else
+  {
+    setOdeHeightfieldDetails(
+        this->odeData,
+        this->heights.data(),
+        // in meters
+        this->Size().X(),
+        // in meters
+        this->Size().Y(),
+        // number of vertices
+        this->vertSize,
+        // vertical (z-axis) offset
+        this->Pos().Z(),
+        // vertical thickness for closing the height map mesh
+        1.0);
+  }
 
   // Step 4: Restrict the bounds of the AABB to improve efficiency
   dGeomHeightfieldDataSetBounds(this->odeData, this->GetMinHeight(),
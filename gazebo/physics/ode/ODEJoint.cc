@@ -68,6 +68,7 @@ void ODEJoint::Fini()
 {
   this->applyDamping.reset();
 
+  this->AttachFeedback(false);
   if (this->feedback)
     delete this->feedback;
   this->feedback = nullptr;
@@ -277,11 +278,67 @@ double ODEJoint::GetCFM()
 //////////////////////////////////////////////////
 dJointFeedback *ODEJoint::GetFeedback()
 {
-  if (this->jointId)
-    return dJointGetFeedback(this->jointId);
-  else
+  if (!this->jointId)
+  {
     gzerr << "ODE Joint ID is invalid\n";
-  return nullptr;
+    return nullptr;
+  }
+
+  return this->ReadFeedback();
+}
+
+//////////////////////////////////////////////////
+void ODEJoint::SetFeedbackIdleTime(const common::Time &_time)
+{
+  this->feedbackIdleTime = _time;
+}
+
+//////////////////////////////////////////////////
+common::Time ODEJoint::FeedbackIdleTime() const
+{
+  return this->feedbackIdleTime;
+}
+
+//////////////////////////////////////////////////
+bool ODEJoint::FeedbackActive() const
+{
+  return this->feedbackAttached;
+}
+
+//////////////////////////////////////////////////
+void ODEJoint::AttachFeedback(const bool _attach)
+{
+  if (!this->jointId)
+  {
+    if (_attach)
+      gzerr << "ODE Joint ID is invalid\n";
+    return;
+  }
+
+  if (_attach)
+  {
+    // Allocated on first use. While detached, the structure keeps the last
+    // values ODE computed.
+    if (this->feedback == nullptr)
+      this->feedback = new dJointFeedback();
+    dJointSetFeedback(this->jointId, this->feedback);
+  }
+  else if (this->feedbackAttached)
+  {
+    dJointSetFeedback(this->jointId, nullptr);
+  }
+  this->feedbackAttached = _attach;
+}
+
+//////////////////////////////////////////////////
+dJointFeedback *ODEJoint::ReadFeedback() const
+{
+  // Readers may run on other threads, so they only record the read. Update
+  // attaches suspended feedback again on the physics thread.
+  if (this->GetWorld())
+    this->feedbackReadTime = this->GetWorld()->SimTime().Double();
+
+  return this->provideFeedback ? this->feedback : nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -336,7 +393,12 @@ ignition::math::Vector3d ODEJoint::LinkForce(
     return result;
   }
 
-  dJointFeedback *jointFeedback = dJointGetFeedback(this->jointId);
+  dJointFeedback *jointFeedback = this->ReadFeedback();
+  if (!jointFeedback)
+  {
+    gzerr << "Joint feedback uninitialized" << std::endl;
+    return result;
+  }
 
   if (_index == 0)
     result.Set(jointFeedback->f1[0], jointFeedback->f1[1],
@@ -360,7 +422,7 @@ ignition::math::Vector3d ODEJoint::LinkTorque(
     return result;
   }
 
-  dJointFeedback *jointFeedback = dJointGetFeedback(this->jointId);
+  dJointFeedback *jointFeedback = this->ReadFeedback();
   if (!jointFeedback)
   {
     gzerr << "Joint feedback uninitialized" << std::endl;
@@ -633,9 +695,43 @@ void ODEJoint::Reset()
 
   this->forceAppliedTime = common::Time::Zero;
 
+  // Do not report forces from before the reset
+  if (this->feedback)
+    *this->feedback = dJointFeedback();
+
   Joint::Reset();
 }
 
+//////////////////////////////////////////////////
+void ODEJoint::Update()
+{
+  Joint::Update();
+
+  if (!this->provideFeedback)
+    return;
+
+  // Joints without subscribers keep feedback only while it is read
+  bool active = this->feedbackSubscribers > 0 ||
+      this->feedbackIdleTime <= common::Time::Zero;
+  if (!active && this->GetWorld())
+  {
+    double now = this->GetWorld()->SimTime().Double();
+
+    // Simulation time went back, e.g. after a world reset
+    double readTime = this->feedbackReadTime;
+    if (now < readTime)
+    {
+      this->feedbackReadTime = now;
+      readTime = now;
+    }
+
+    active = now - readTime <= this->feedbackIdleTime.Double();
+  }
+
+  if (active != this->feedbackAttached)
+    this->AttachFeedback(active);
+}
+
 //////////////////////////////////////////////////
 void ODEJoint::CacheForceTorque()
 {
@@ -1093,30 +1189,12 @@ void ODEJoint::SetProvideFeedback(bool _enable)
 {
   Joint::SetProvideFeedback(_enable);
 
+  // Enabling feedback counts as a read, so the feedback is computed for at
+  // least the idle time even if nobody subscribes. Update suspends it
+  // afterwards while it is not read.
   if (this->provideFeedback)
-  {
-    if (this->feedback == nullptr)
-    {
-      this->feedback = new dJointFeedback;
-      this->feedback->f1[0] = 0;
-      this->feedback->f1[1] = 0;
-      this->feedback->f1[2] = 0;
-      this->feedback->t1[0] = 0;
-      this->feedback->t1[1] = 0;
-      this->feedback->t1[2] = 0;
-      this->feedback->f2[0] = 0;
-      this->feedback->f2[1] = 0;
-      this->feedback->f2[2] = 0;
-      this->feedback->t2[0] = 0;
-      this->feedback->t2[1] = 0;
-      this->feedback->t2[2] = 0;
-    }
-
-    if (this->jointId)
-      dJointSetFeedback(this->jointId, this->feedback);
-    else
-      gzerr << "ODE Joint ID is invalid\n";
-  }
+    this->ReadFeedback();
+  this->AttachFeedback(this->provideFeedback);
 }
 
 //////////////////////////////////////////////////
@@ -1215,7 +1293,20 @@ bool ODEJoint::SetPosition(const unsigned int _index, const double _position,
 {
   const bool result = Joint::SetPositionMaximal(_index, _position,
                                                 _preserveWorldVelocity);
+  this->OnKinematicSetPosition(_index, _position);
+  return result;
+}
 
+//////////////////////////////////////////////////
+bool ODEJoint::KinematicSetPosition() const
+{
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ODEJoint::OnKinematicSetPosition(const unsigned int /*_index*/,
+    const double _position)
+{
   // The following code fixes issue 2430 without breaking ABI
   // We only need to worry about this for angles outside the range [-pi, pi]
   if (std::abs(_position) >= M_PI)
@@ -1226,6 +1317,4 @@ bool ODEJoint::SetPosition(const unsigned int _index, const double _position,
       hinge->SetCumulativeAngle(_position);
     }
   }
-
-  return result;
 }
@@ -18,6 +18,7 @@
 #define _ODEJOINT_HH_
 
 #include <boost/any.hpp>
+#include <atomic>
 #include <string>
 
 #include "gazebo/physics/ode/ODEPhysics.hh"
@@ -61,6 +62,9 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void Reset() override;
 
+      // Documentation inherited.
+      public: void Update() override;
+
       // Documentation inherited.
       public: virtual LinkPtr GetJointLink(unsigned int _index) const override;
 
@@ -98,6 +102,13 @@ namespace gazebo
                               const bool _preserveWorldVelocity = false)
             override;
 
+      // Documentation inherited.
+      public: bool KinematicSetPosition() const override;
+
+      // Documentation inherited.
+      public: void OnKinematicSetPosition(const unsigned int _index,
+                                          const double _position) override;
+
       // Documentation inherited.
       public: virtual void SetStiffness(unsigned int _index,
                                         const double _stiffness) override;
@@ -128,10 +139,34 @@ namespace gazebo
       /// \return The Constraint Force Mixing value
       public: double GetCFM();
 
-      /// \brief Get the feedback data structure for this joint, if set
+      /// \brief Get the feedback data structure for this joint, if set.
+      /// Calling this counts as a read of the joint feedback. If feedback
+      /// was suspended because nobody read it, the returned values are the
+      /// last ones ODE computed, and feedback is enabled again on the next
+      /// step.
       /// \return Pointer to the joint feedback.
       public: dJointFeedback *GetFeedback();
 
+      /// \brief Set how long joint feedback is computed after the last
+      /// read when the joint has no feedback subscribers. After this much
+      /// simulation time without a call to GetForceTorque, GetFeedback,
+      /// LinkForce or LinkTorque, ODE stops computing the feedback of this
+      /// joint until it is read again. Reads in between return the last
+      /// computed values.
+      /// \param[in] _time Idle time, zero (the default) to compute feedback
+      /// every step while it is enabled.
+      /// \sa Joint::AddFeedbackSubscriber
+      public: void SetFeedbackIdleTime(const common::Time &_time);
+
+      /// \brief Get the feedback idle time.
+      /// \return Simulation time after the last read at which feedback is
+      /// suspended.
+      public: common::Time FeedbackIdleTime() const;
+
+      /// \brief Get whether ODE currently computes feedback for this joint.
+      /// \return True if the feedback is attached to the ODE joint.
+      public: bool FeedbackActive() const;
+
       /// \brief Get flag indicating whether implicit spring damper is enabled.
       /// \return True if implicit spring damper is used.
       public: bool UsesImplicitSpringDamper();
@@ -277,9 +312,29 @@ namespace gazebo
       /// \brief Joint angle(s) when ODE joint has angle 0.
       protected: double angleOffset[MAX_JOINT_AXIS];
 
+      /// \brief Attach or detach the feedback from the ODE joint. The
+      /// feedback structure is allocated on first attach.
+      /// \param[in] _attach True to have ODE compute the feedback.
+      private: void AttachFeedback(const bool _attach);
+
+      /// \brief Record a read of the joint feedback.
+      /// \return The feedback, or null if feedback is disabled.
+      private: dJointFeedback *ReadFeedback() const;
+
       /// \brief Feedback data for this joint
       private: dJointFeedback *feedback;
 
+      /// \brief True while the feedback is attached to the ODE joint.
+      private: bool feedbackAttached = false;
+
+      /// \brief Simulation time of the last feedback read, in seconds.
+      /// Written by readers on any thread.
+      private: mutable std::atomic<double> feedbackReadTime{0.0};
+
+      /// \brief Time after the last read at which feedback is suspended.
+      /// Zero disables suspension.
+      private: common::Time feedbackIdleTime;
+
       /// \brief CFM for joint's limit constraint
       private: double stopCFM;
 
@@ -122,6 +122,79 @@ TEST_F(ODEJoint_TEST, ImplicitDamping)
         << "]\n";
 }
 
+////////////////////////////////////////////////////////////////////////
+// Test that feedback without subscribers can be computed only while read
+////////////////////////////////////////////////////////////////////////
+TEST_F(ODEJoint_TEST, DemandDrivenFeedback)
+{
+  Load("worlds/implicit_damping_test.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  world->Physics()->SetGravity(ignition::math::Vector3d(0, 0, -10));
+
+  physics::ModelPtr model = world->ModelByName("model_1");
+  ASSERT_TRUE(model != nullptr);
+  physics::ODEJointPtr joint =
+    boost::dynamic_pointer_cast<physics::ODEJoint>(model->GetJoint("joint_1"));
+  ASSERT_TRUE(joint != nullptr);
+  EXPECT_EQ(joint->FeedbackSubscriberCount(), 0u);
+  EXPECT_FALSE(joint->FeedbackActive());
+
+  const double dt = world->Physics()->GetMaxStepSize();
+  ASSERT_GT(dt, 0);
+  const common::Time idle(0.1);
+  const unsigned int idleSteps = static_cast<unsigned int>(0.2 / dt);
+
+  // Suspension is off by default, feedback stays enabled without reads
+  EXPECT_EQ(joint->FeedbackIdleTime(), common::Time::Zero);
+  joint->SetProvideFeedback(true);
+  world->Step(idleSteps);
+  EXPECT_TRUE(joint->FeedbackActive());
+  joint->SetProvideFeedback(false);
+  EXPECT_FALSE(joint->FeedbackActive());
+
+  joint->SetFeedbackIdleTime(idle);
+  EXPECT_EQ(joint->FeedbackIdleTime(), idle);
+
+  // Enabling feedback computes it until the idle time passes
+  joint->SetProvideFeedback(true);
+  EXPECT_TRUE(joint->FeedbackActive());
+  world->Step(1);
+  EXPECT_TRUE(joint->FeedbackActive());
+  world->Step(idleSteps);
+  EXPECT_FALSE(joint->FeedbackActive());
+
+  // A read of suspended feedback returns the last computed wrench, and
+  // enables feedback again on the next step. Polling keeps it enabled.
+  EXPECT_GT(joint->GetForceTorque(0u).body2Force.Length(), 0.0);
+  EXPECT_GT(joint->LinkForce(0u).Length(), 0.0);
+  EXPECT_FALSE(joint->FeedbackActive());
+  world->Step(1);
+  EXPECT_TRUE(joint->FeedbackActive());
+  for (unsigned int i = 0; i < idleSteps; ++i)
+  {
+    world->Step(1);
+    joint->GetForceTorque(0u);
+  }
+  EXPECT_TRUE(joint->FeedbackActive());
+  EXPECT_GT(joint->GetForceTorque(0u).body2Force.Length(), 0.0);
+
+  // A subscriber keeps feedback enabled without reads
+  joint->AddFeedbackSubscriber();
+  world->Step(idleSteps);
+  EXPECT_TRUE(joint->FeedbackActive());
+  joint->RemoveFeedbackSubscriber();
+  world->Step(idleSteps);
+  EXPECT_FALSE(joint->FeedbackActive());
+
+  // Disabling feedback detaches it right away
+  joint->GetForceTorque(0u);
+  world->Step(1);
+  EXPECT_TRUE(joint->FeedbackActive());
+  joint->SetProvideFeedback(false);
+  EXPECT_FALSE(joint->FeedbackActive());
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -123,6 +123,8 @@ void ODELink::Init()
   {
     dBodySetMovedCallback(this->linkId, MoveCallback);
     dBodySetDisabledCallback(this->linkId, DisabledCallback);
+    this->odePhysics->SetContinuousCollision(this,
+        this->ContinuousCollision());
   }
   else if (!this->IsStatic() && this->initialized)
   {
@@ -177,6 +179,9 @@ void ODELink::MoveCallback(dBodyID _id)
 //////////////////////////////////////////////////
 void ODELink::Fini()
 {
+  if (this->odePhysics)
+    this->odePhysics->SetContinuousCollision(this, false);
+
   if (this->linkId)
     dBodyDestroy(this->linkId);
   this->linkId = nullptr;
@@ -186,6 +191,15 @@ void ODELink::Fini()
   Link::Fini();
 }
 
+//////////////////////////////////////////////////
+void ODELink::SetContinuousCollision(const bool _enable)
+{
+  Link::SetContinuousCollision(_enable);
+
+  if (this->linkId && this->odePhysics)
+    this->odePhysics->SetContinuousCollision(this, _enable);
+}
+
 //////////////////////////////////////////////////
 void ODELink::SetGravityMode(bool _mode)
 {
@@ -158,6 +158,9 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetAutoDisable(bool _disable);
 
+      // Documentation inherited
+      public: virtual void SetContinuousCollision(const bool _enable);
+
       /// \brief Return the ID of this link
       /// \return ODE link id
       public: dBodyID GetODEId() const;
@@ -14,31 +14,175 @@
  * limitations under the License.
  *
 */
+#include <vector>
+
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/ConvexDecomposition.hh"
+#include "gazebo/gazebo_config.h"
 
+#include "gazebo/physics/MeshCollisionCache.hh"
 #include "gazebo/physics/ode/ODECollision.hh"
+#ifdef HAVE_FCL
+#include "gazebo/physics/ode/ODEFCLCollider.hh"
+#endif
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODEMesh.hh"
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \brief Triangle mesh data that can be used by several ODE geoms.
+    /// The geoms keep their own transforms, so only the vertices, the
+    /// indices and the ODE trimesh data with its BVH are shared. Convex
+    /// meshes fill the convex arrays instead, which dConvex references
+    /// without copying.
+    class ODEMeshData
+    {
+      /// \brief Destructor.
+      public: ~ODEMeshData()
+      {
+        if (this->odeData)
+          dGeomTriMeshDataDestroy(this->odeData);
+        delete [] this->vertices;
+        delete [] this->indices;
+      }
+
+      /// \brief Convex hull planes, a b c d per face with a x + b y + c z
+      /// = d on the face.
+      public: std::vector<dReal> planes;
+
+      /// \brief Convex hull points, x y z per point.
+      public: std::vector<dReal> points;
+
+      /// \brief Convex hull polygons, the number of points of each face
+      /// followed by their indices.
+      public: std::vector<unsigned int> polygons;
+
+      /// \brief Array of vertex values.
+      public: float *vertices = nullptr;
+
+      /// \brief Array of index values.
+      public: int *indices = nullptr;
+
+      /// \brief Number of vertices.
+      public: unsigned int vertexCount = 0;
+
+      /// \brief Number of indices.
+      public: unsigned int indexCount = 0;
+
+      /// \brief ODE trimesh data.
+      public: dTriMeshDataID odeData = nullptr;
+    };
+  }
+}
+
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Trimesh data shared between identical mesh collisions.
+static MeshCollisionCache<ODEMeshData> g_meshDataCache;
+
+/// \brief Scale the vertices of a mesh and build its ODE trimesh data.
+/// \param[in] _source Mesh or submesh to read the vertices from.
+/// \param[in] _scale Scaling factor.
+/// \return The new trimesh data.
+template<typename T>
+static std::shared_ptr<ODEMeshData> BuildMeshData(const T *_source,
+    const ignition::math::Vector3d &_scale)
+{
+  unsigned int numVertices = _source->GetVertexCount();
+  unsigned int numIndices = _source->GetIndexCount();
+
+  std::shared_ptr<ODEMeshData> data(new ODEMeshData);
+
+  // Get all the vertex and index data
+  _source->FillArrays(&data->vertices, &data->indices);
+  data->vertexCount = numVertices;
+  data->indexCount = numIndices;
+
+  // Scale the vertex data
+  for (unsigned int j = 0;  j < numVertices; j++)
+  {
+    data->vertices[j*3+0] = data->vertices[j*3+0] * _scale.X();
+    data->vertices[j*3+1] = data->vertices[j*3+1] * _scale.Y();
+    data->vertices[j*3+2] = data->vertices[j*3+2] * _scale.Z();
+  }
+
+  /// This will hold the vertex data of the triangle mesh
+  data->odeData = dGeomTriMeshDataCreate();
+
+  // Build the ODE triangle mesh
+  dGeomTriMeshDataBuildSingle(data->odeData,
+      data->vertices, 3*sizeof(data->vertices[0]), numVertices,
+      data->indices, numIndices, 3*sizeof(data->indices[0]));
+
+  return data;
+}
+
+/// \brief Build the ODE convex data of a set of hulls. ODE collisions hold
+/// a single geom, so the hulls are merged into their common hull.
+/// \param[in] _hulls Mesh with one submesh per convex hull.
+/// \param[in] _scale Scaling factor.
+/// \return The new convex data, or nullptr if the hulls are flat.
+static std::shared_ptr<ODEMeshData> BuildConvexData(
+    const common::Mesh *_hulls, const ignition::math::Vector3d &_scale)
+{
+  std::vector<ignition::math::Vector3d> points;
+  for (unsigned int i = 0; i < _hulls->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *subMesh = _hulls->GetSubMesh(i);
+    for (unsigned int j = 0; j < subMesh->GetVertexCount(); ++j)
+      points.push_back(subMesh->Vertex(j) * _scale);
+  }
+
+  std::unique_ptr<common::SubMesh> hull(
+      common::ConvexDecomposition::ConvexHull(points));
+  if (!hull)
+    return nullptr;
+
+  std::shared_ptr<ODEMeshData> data(new ODEMeshData);
+  for (unsigned int i = 0; i < hull->GetVertexCount(); ++i)
+  {
+    const ignition::math::Vector3d &v = hull->Vertex(i);
+    data->points.push_back(v.X());
+    data->points.push_back(v.Y());
+    data->points.push_back(v.Z());
+  }
+
+  for (unsigned int i = 0; i + 2 < hull->GetIndexCount(); i += 3)
+  {
+    const ignition::math::Vector3d &a = hull->Vertex(hull->GetIndex(i));
+    const ignition::math::Vector3d &b = hull->Vertex(hull->GetIndex(i+1));
+    const ignition::math::Vector3d &c = hull->Vertex(hull->GetIndex(i+2));
+    ignition::math::Vector3d normal = (b - a).Cross(c - a).Normalize();
+    data->planes.push_back(normal.X());
+    data->planes.push_back(normal.Y());
+    data->planes.push_back(normal.Z());
+    data->planes.push_back(normal.Dot(a));
+
+    data->polygons.push_back(3u);
+    data->polygons.push_back(hull->GetIndex(i));
+    data->polygons.push_back(hull->GetIndex(i+1));
+    data->polygons.push_back(hull->GetIndex(i+2));
+  }
+
+  return data;
+}
+
 //////////////////////////////////////////////////
 ODEMesh::ODEMesh()
 {
-  this->odeData = nullptr;
-  this->vertices = nullptr;
-  this->indices = nullptr;
 }
 
 //////////////////////////////////////////////////
 ODEMesh::~ODEMesh()
 {
-  delete [] this->vertices;
-  delete [] this->indices;
-  dGeomTriMeshDataDestroy(this->odeData);
+#ifdef HAVE_FCL
+  ODEFCLCollider::RemoveMesh(this, this->fclGeom);
+#endif
 }
 
 //////////////////////////////////////////////////
@@ -49,6 +193,10 @@ void ODEMesh::Update()
   // tell the tri-tri collider the current transform of the trimesh --
   // this is fairly important for good results.
 
+  // Convex geoms have no previous transform.
+  if (dGeomGetClass(this->collisionId) != dTriMeshClass)
+    return;
+
   // Fill in the (4x4) matrix.
   dReal *matrix = this->transform + (this->transformIndex * 16);
   const dReal *Pos = dGeomGetPosition(this->collisionId);
@@ -81,76 +229,130 @@ void ODEMesh::Update()
 
 //////////////////////////////////////////////////
 void ODEMesh::Init(const common::SubMesh *_subMesh, ODECollisionPtr _collision,
-    const ignition::math::Vector3d &_scale)
+    const ignition::math::Vector3d &_scale, const std::string &_cacheKey)
 {
   if (!_subMesh)
     return;
 
-  unsigned int numVertices = _subMesh->GetVertexCount();
-  unsigned int numIndices = _subMesh->GetIndexCount();
-
-  this->vertices = nullptr;
-  this->indices = nullptr;
-
-  // Get all the vertex and index data
-  _subMesh->FillArrays(&this->vertices, &this->indices);
+  std::shared_ptr<ODEMeshData> meshData = g_meshDataCache.Get(_cacheKey,
+      [&]()
+      {
+        return BuildMeshData(_subMesh, _scale);
+      });
 
   this->collisionId = _collision->GetCollisionId();
 
-  this->CreateMesh(numVertices, numIndices, _collision, _scale);
+  this->CreateMesh(meshData, _collision);
 }
 
 //////////////////////////////////////////////////
 void ODEMesh::Init(const common::Mesh *_mesh, ODECollisionPtr _collision,
-    const ignition::math::Vector3d &_scale)
+    const ignition::math::Vector3d &_scale, const std::string &_cacheKey)
 {
   if (!_mesh)
     return;
 
-  unsigned int numVertices = _mesh->GetVertexCount();
-  unsigned int numIndices = _mesh->GetIndexCount();
-
-  this->vertices = nullptr;
-  this->indices = nullptr;
-
-  // Get all the vertex and index data
-  _mesh->FillArrays(&this->vertices, &this->indices);
+  std::shared_ptr<ODEMeshData> meshData = g_meshDataCache.Get(_cacheKey,
+      [&]()
+      {
+        return BuildMeshData(_mesh, _scale);
+      });
 
   this->collisionId = _collision->GetCollisionId();
-  this->CreateMesh(numVertices, numIndices, _collision, _scale);
+  this->CreateMesh(meshData, _collision);
 }
 
 //////////////////////////////////////////////////
-void ODEMesh::CreateMesh(unsigned int _numVertices, unsigned int _numIndices,
-    ODECollisionPtr _collision, const ignition::math::Vector3d &_scale)
+bool ODEMesh::InitConvex(const common::Mesh *_hulls,
+    ODECollisionPtr _collision, const ignition::math::Vector3d &_scale,
+    const std::string &_cacheKey)
 {
-  /// This will hold the vertex data of the triangle mesh
-  if (this->odeData == nullptr)
-    this->odeData = dGeomTriMeshDataCreate();
+  if (!_hulls)
+    return false;
 
-  // Scale the vertex data
-  for (unsigned int j = 0;  j < _numVertices; j++)
+  if (_hulls->GetSubMeshCount() > 1u)
   {
-    this->vertices[j*3+0] = this->vertices[j*3+0] * _scale.X();
-    this->vertices[j*3+1] = this->vertices[j*3+1] * _scale.Y();
-    this->vertices[j*3+2] = this->vertices[j*3+2] * _scale.Z();
+    gzwarn << "ODE collisions hold a single convex geom, mesh ["
+           << _hulls->GetName() << "] collides with the convex hull of its "
+           << _hulls->GetSubMeshCount() << " hulls.\n";
   }
 
-  // Build the ODE triangle mesh
-  dGeomTriMeshDataBuildSingle(this->odeData,
-      this->vertices, 3*sizeof(this->vertices[0]), _numVertices,
-      this->indices, _numIndices, 3*sizeof(this->indices[0]));
+  std::shared_ptr<ODEMeshData> meshData = g_meshDataCache.Get(_cacheKey,
+      [&]()
+      {
+        return BuildConvexData(_hulls, _scale);
+      });
+  if (!meshData)
+    return false;
 
+  this->collisionId = _collision->GetCollisionId();
+  this->CreateMesh(meshData, _collision);
+  return true;
+}
+
+//////////////////////////////////////////////////
+size_t ODEMesh::SharedDataCount()
+{
+  return g_meshDataCache.Size();
+}
+
+//////////////////////////////////////////////////
+void ODEMesh::CreateMesh(std::shared_ptr<ODEMeshData> _data,
+    ODECollisionPtr _collision)
+{
   if (_collision->GetCollisionId() == nullptr)
   {
     _collision->SetSpaceId(dSimpleSpaceCreate(_collision->GetSpaceId()));
-    _collision->SetCollision(dCreateTriMesh(_collision->GetSpaceId(),
-          this->odeData, 0, 0, 0), true);
+    if (_data->odeData)
+    {
+      _collision->SetCollision(dCreateTriMesh(_collision->GetSpaceId(),
+            _data->odeData, 0, 0, 0), true);
+    }
+    else
+    {
+      _collision->SetCollision(dCreateConvex(_collision->GetSpaceId(),
+            _data->planes.data(), _data->planes.size() / 4,
+            _data->points.data(), _data->points.size() / 3,
+            _data->polygons.data()), true);
+    }
+  }
+  else if (_data->odeData &&
+      dGeomGetClass(_collision->GetCollisionId()) == dTriMeshClass)
+  {
+    dGeomTriMeshSetData(_collision->GetCollisionId(), _data->odeData);
+  }
+  else if (!_data->odeData &&
+      dGeomGetClass(_collision->GetCollisionId()) == dConvexClass)
+  {
+    dGeomSetConvex(_collision->GetCollisionId(),
+        _data->planes.data(), _data->planes.size() / 4,
+        _data->points.data(), _data->points.size() / 3,
+        _data->polygons.data());
   }
   else
   {
-    dGeomTriMeshSetData(_collision->GetCollisionId(), this->odeData);
+    gzerr << "Unable to switch the collision [" << _collision->GetScopedName()
+          << "] between triangle mesh and convex geometry.\n";
+    return;
+  }
+
+#ifdef HAVE_FCL
+  if (this->fclGeom != _collision->GetCollisionId())
+    ODEFCLCollider::RemoveMesh(this, this->fclGeom);
+  this->fclGeom = _collision->GetCollisionId();
+  if (_data->odeData)
+  {
+    ODEFCLCollider::AddMesh(this, this->fclGeom, _data->vertices,
+        _data->vertexCount, _data->indices, _data->indexCount, _data.get());
   }
+  else
+  {
+    ODEFCLCollider::RemoveMesh(this, this->fclGeom);
+  }
+#endif
+
+  // Release the previous data only once the geom no longer uses it.
+  this->data = _data;
 
   memset(this->transform, 0, 32*sizeof(dReal));
   this->transformIndex = 0;
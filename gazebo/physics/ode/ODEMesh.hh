@@ -18,6 +18,9 @@
 #ifndef GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 #define GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 
+#include <memory>
+#include <string>
+
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/ode/ODETypes.hh"
@@ -29,6 +32,8 @@ namespace gazebo
 {
   namespace physics
   {
+    class ODEMeshData;
+
     /// \addtogroup gazebo_physics_ode
     /// \{
 
@@ -45,28 +50,56 @@ namespace gazebo
       /// \param[in] _subMesh Pointer to the submesh.
       /// \param[in] _collision Pointer to the collision object.
       /// \param[in] _scale Scaling factor.
+      /// \param[in] _cacheKey Collision geometry key, see
+      /// MeshShape::CollisionGeometryKey. Meshes with the same non empty key
+      /// share one ODE trimesh data. An empty key disables sharing.
       public: void Init(const common::SubMesh *_subMesh,
                       ODECollisionPtr _collision,
-                      const ignition::math::Vector3d &_scale);
+                      const ignition::math::Vector3d &_scale,
+                      const std::string &_cacheKey = "");
 
       /// \brief Create a mesh collision shape using a mesh.
       /// \param[in] _mesh Pointer to the mesh.
       /// \param[in] _collision Pointer to the collision object.
       /// \param[in] _scale Scaling factor.
+      /// \param[in] _cacheKey Collision geometry key, see
+      /// MeshShape::CollisionGeometryKey. Meshes with the same non empty key
+      /// share one ODE trimesh data. An empty key disables sharing.
       public: void Init(const common::Mesh *_mesh,
                       ODECollisionPtr _collision,
-                      const ignition::math::Vector3d &_scale);
+                      const ignition::math::Vector3d &_scale,
+                      const std::string &_cacheKey = "");
+
+      /// \brief Create a convex collision shape from a convex
+      /// decomposition. ODE collisions hold a single geom, so a
+      /// decomposition with several hulls collides with their common
+      /// hull. ODE has no convex and triangle mesh collider, so the shape
+      /// does not touch triangle mesh collisions.
+      /// \param[in] _hulls Mesh with one submesh per convex hull, see
+      /// MeshShape::ConvexHulls.
+      /// \param[in] _collision Pointer to the collision object.
+      /// \param[in] _scale Scaling factor.
+      /// \param[in] _cacheKey Collision geometry key, see
+      /// MeshShape::CollisionGeometryKey. An empty key disables sharing.
+      /// \return False if the hulls are empty or flat.
+      public: bool InitConvex(const common::Mesh *_hulls,
+                      ODECollisionPtr _collision,
+                      const ignition::math::Vector3d &_scale,
+                      const std::string &_cacheKey = "");
 
       /// \brief Update the collision mesh.
       public: virtual void Update();
 
+      /// \brief Get the number of ODE trimesh data objects shared between
+      /// meshes.
+      /// \return Number of shared trimesh data objects in use.
+      public: static size_t SharedDataCount();
+
       /// \brief Helper function to create the collision shape.
-      /// \param[in] _numVertices Number of vertices.
-      /// \param[in] _numIndices Number of indices.
+      /// \param[in] _data Trimesh data for the collision.
       /// \param[in] _collision Pointer to the collision object.
-      private: void CreateMesh(unsigned int _numVertices,
-                   unsigned int _numIndices, ODECollisionPtr _collision,
-                   const ignition::math::Vector3d &_scale);
+      private: void CreateMesh(std::shared_ptr<ODEMeshData> _data,
+                   ODECollisionPtr _collision);
 
       /// \brief Transform matrix.
       private: dReal transform[16*2];
@@ -74,17 +107,15 @@ namespace gazebo
       /// \brief Transform matrix index.
       private: int transformIndex;
 
-      /// \brief Array of vertex values.
-      private: float *vertices;
-
-      /// \brief Array of index values.
-      private: int *indices;
-
-      /// \brief ODE trimesh data.
-      private: dTriMeshDataID odeData;
+      /// \brief Vertices, indices and ODE trimesh data, possibly shared
+      /// with other meshes.
+      private: std::shared_ptr<ODEMeshData> data;
 
       /// \brief The collision id that this mesh is attached to.
-      private: dGeomID collisionId;
+      private: dGeomID collisionId = nullptr;
+
+      /// \brief Geom registered with the FCL collider, see ODEFCLCollider.
+      private: dGeomID fclGeom = nullptr;
     };
     /// \}
   }
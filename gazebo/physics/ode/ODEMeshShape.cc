@@ -57,16 +57,26 @@ void ODEMeshShape::Init()
   if (!this->mesh)
     return;
 
+  if (this->odeMesh->InitConvex(this->ConvexHulls(),
+        boost::static_pointer_cast<ODECollision>(this->collisionParent),
+        this->sdf->Get<ignition::math::Vector3d>("scale"),
+        this->CollisionGeometryKey()))
+  {
+    return;
+  }
+
   if (this->submesh)
   {
     this->odeMesh->Init(this->submesh,
         boost::static_pointer_cast<ODECollision>(this->collisionParent),
-        this->sdf->Get<ignition::math::Vector3d>("scale"));
+        this->sdf->Get<ignition::math::Vector3d>("scale"),
+        this->CollisionGeometryKey());
   }
   else
   {
     this->odeMesh->Init(this->mesh,
         boost::static_pointer_cast<ODECollision>(this->collisionParent),
-        this->sdf->Get<ignition::math::Vector3d>("scale"));
+        this->sdf->Get<ignition::math::Vector3d>("scale"),
+        this->CollisionGeometryKey());
   }
 }
@@ -14,6 +14,9 @@
  * limitations under the License.
  *
  */
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Exception.hh"
 
@@ -88,22 +91,84 @@ void ODEMultiRayShape::UpdateRays()
   if (ode == nullptr)
     gzthrow("Invalid physics engine. Must use ODE.");
 
+  int threshold = 0;
+  boost::any value;
+  if (ode->GetParam("parallel_ray_threshold", value))
+    threshold = boost::any_cast<int>(value);
+
   // Do we need to lock the physics engine here? YES!
   // especially when spawning models with sensors
   {
     boost::recursive_mutex::scoped_lock lock(*ode->GetPhysicsUpdateMutex());
 
-    // Do collision detection
+    // Broadphase, fills this->candidates
+    this->candidates.clear();
     dSpaceCollide2((dGeomID) (this->superSpaceId),
         (dGeomID) (ode->GetSpaceId()),
         this, &UpdateCallback);
+
+    // Narrow phase. The broadphase has already computed the poses of all
+    // the geoms involved, so dCollide only reads them.
+    if (threshold > 0 &&
+        this->candidates.size() >= static_cast<unsigned int>(threshold))
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, this->candidates.size()),
+          [this](const tbb::blocked_range<size_t> &_r)
+      {
+        // Ray-trimesh colliders keep their caches in thread local storage.
+        dAllocateODEDataForThread(dAllocateMaskAll);
+
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          // Heightfields keep temporary buffers in the geom, and geom
+          // transforms swap the pose of the geom they wrap.
+          int hitClass = dGeomGetClass(this->candidates[i].hitId);
+          if (hitClass != dHeightfieldClass && hitClass != dGeomTransformClass)
+            this->Intersect(this->candidates[i]);
+        }
+      });
+
+      for (auto &candidate : this->candidates)
+      {
+        int hitClass = dGeomGetClass(candidate.hitId);
+        if (hitClass == dHeightfieldClass || hitClass == dGeomTransformClass)
+          this->Intersect(candidate);
+      }
+    }
+    else
+    {
+      for (auto &candidate : this->candidates)
+        this->Intersect(candidate);
+    }
+  }
+
+  // Keep the closest hit of each ray. Candidates are visited in broadphase
+  // order, so ties resolve as in a serial update.
+  for (const auto &candidate : this->candidates)
+  {
+    if (candidate.depth >= 0 &&
+        candidate.depth < candidate.shape->GetLength())
+    {
+      candidate.shape->SetLength(candidate.depth);
+      candidate.shape->SetRetro(candidate.hitCollision->GetLaserRetro());
+      candidate.shape->SetCollisionName(
+          candidate.hitCollision->GetScopedName());
+    }
   }
 }
 
 //////////////////////////////////////////////////
-void ODEMultiRayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
+void ODEMultiRayShape::Intersect(RayCandidate &_candidate)
 {
   dContactGeom contact;
+  int n = dCollide(_candidate.rayId, _candidate.hitId, 1, &contact,
+      sizeof(contact));
+  _candidate.depth = n > 0 ? contact.depth : -1.0;
+}
+
+//////////////////////////////////////////////////
+void ODEMultiRayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
+{
   ODEMultiRayShape *self = nullptr;
 
   self = static_cast<ODEMultiRayShape*>(_data);
@@ -173,33 +238,23 @@ void ODEMultiRayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
       dGeomRaySetClosestHit(_o2, 1);
     }
 
-    if (!self->defaultUpdate || (rayCollision && hitCollision))
+    // Rays of a standalone multiray shape are not updated here, only
+    // the rays of a collision are.
+    if (self->defaultUpdate && rayCollision && hitCollision)
     {
-      int n = dCollide(_o1, _o2, 1, &contact, sizeof(contact));
+      RayShape *shape =
+        boost::static_pointer_cast<RayShape>(rayCollision->GetShape()).get();
 
-      if (n > 0 && self->defaultUpdate)
+      if (shape)
       {
-        RayShape *shape = self->defaultUpdate ?
-          boost::static_pointer_cast<RayShape>(rayCollision->GetShape()).get() :
-          static_cast<RayShape*>(dGeomGetData(rayId));
-
-        if (shape && hitCollision && contact.depth < shape->GetLength())
-        {
-          // gzerr << "ODEMultiRayShape UpdateCallback dSpaceCollide2 "
-          //      << " depth[" << contact.depth << "]"
-          //      << " position[" << contact.pos[0]
-          //        << ", " << contact.pos[1]
-          //        << ", " << contact.pos[2]
-          //        << ", " << "]"
-          //      << " ray[" << rayCollision->GetScopedName() << "]"
-          //      << " pose[" << rayCollision->GetWorldPose() << "]"
-          //      << " hit[" << hitCollision->GetScopedName() << "]"
-          //      << " pose[" << hitCollision->GetWorldPose() << "]"
-          //      << "\n";
-          shape->SetLength(contact.depth);
-          shape->SetRetro(hitCollision->GetLaserRetro());
-          shape->SetCollisionName(hitCollision->GetScopedName());
-        }
+        // The narrow phase runs later in UpdateRays.
+        RayCandidate candidate;
+        candidate.rayId = rayId;
+        candidate.hitId = rayId == _o1 ? _o2 : _o1;
+        candidate.shape = shape;
+        candidate.hitCollision = hitCollision;
+        candidate.depth = -1.0;
+        self->candidates.push_back(candidate);
       }
     }
   }
@@ -17,7 +17,11 @@
 #ifndef GAZEBO_PHYSICS_ODE_ODEMULTIRAYSHAPE_HH_
 #define GAZEBO_PHYSICS_ODE_ODEMULTIRAYSHAPE_HH_
 
+#include <vector>
+
 #include "gazebo/physics/MultiRayShape.hh"
+#include "gazebo/physics/ode/ODETypes.hh"
+#include "gazebo/physics/ode/ode_inc.h"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -41,7 +45,13 @@ namespace gazebo
       /// \brief Destructor.
       public: virtual ~ODEMultiRayShape();
 
-      // Documentation inherited.
+      /// \brief Intersect all rays with the world.
+      ///
+      /// The broadphase runs once for all rays and records every ray and
+      /// geom pair whose bounding boxes overlap. The narrow phase then runs
+      /// over the recorded pairs, on TBB workers when there are at least
+      /// "parallel_ray_threshold" (ODE param) of them, and the ray lengths
+      /// are updated in a final serial pass in broadphase order.
       public: virtual void UpdateRays();
 
       /// \brief Ray-intersection callback.
@@ -66,6 +76,33 @@ namespace gazebo
       /// \brief Helper to get the correct ray shape in the UpdateCallback
       /// function.
       private: bool defaultUpdate = true;
+
+      /// \brief A ray and a geom whose bounding boxes overlap.
+      private: struct RayCandidate
+      {
+        /// \brief Ray geom.
+        dGeomID rayId;
+
+        /// \brief Geom the ray may hit.
+        dGeomID hitId;
+
+        /// \brief Ray shape to update.
+        RayShape *shape;
+
+        /// \brief Collision that owns hitId.
+        ODECollision *hitCollision;
+
+        /// \brief Distance to the hit, negative if the ray misses.
+        double depth;
+      };
+
+      /// \brief Candidates found by the broadphase in UpdateRays. Reused
+      /// between updates to keep allocations.
+      private: std::vector<RayCandidate> candidates;
+
+      /// \brief Run the narrow phase for a single candidate.
+      /// \param[in,out] _candidate Candidate, its depth is set.
+      private: void Intersect(RayCandidate &_candidate);
     };
     /// \}
   }
@@ -21,6 +21,7 @@
 #include <sdf/sdf.hh>
 
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <string>
 #include <utility>
@@ -28,10 +29,11 @@
 
 #include <ignition/math/Rand.hh>
 #include <ignition/math/Vector3.hh>
-#include <ignition/common/Profiler.hh>
 
 #include <sdf/Param.hh>
 
+#include "gazebo/common/TraceCapture.hh"
+#include "gazebo/gazebo_config.h"
 #include "gazebo/util/Diagnostics.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
@@ -52,6 +54,9 @@
 #include "gazebo/physics/ContactManager.hh"
 
 #include "gazebo/physics/ode/ODECollision.hh"
+#ifdef HAVE_FCL
+#include "gazebo/physics/ode/ODEFCLCollider.hh"
+#endif
 #include "gazebo/physics/ode/ODELink.hh"
 #include "gazebo/physics/ode/ODEScrewJoint.hh"
 #include "gazebo/physics/ode/ODEHingeJoint.hh"
@@ -103,32 +108,144 @@ class ContactUpdate_TBB
 };
 */
 
-class Colliders_TBB
+/// \brief Check if the narrow phase of a collision may run on a TBB
+/// worker. Heightfields keep temporary buffers in the geom, and geom
+/// transforms swap the pose of the geom they wrap, so both must be collided
+/// on the physics thread.
+/// \param[in] _collision Collision to check.
+/// \return True if dCollide can be called concurrently for _collision.
+static bool ParallelCollideSafe(const ODECollision *_collision)
 {
-  public: Colliders_TBB(
-              std::vector<std::pair<ODECollision*, ODECollision*> > *_colliders,
-              ODEPhysics *_engine,
-              dContactGeom* _contactCollisions) :
-    colliders(_colliders),
-              engine(_engine), contactCollisions(_contactCollisions)
+  int geomClass = dGeomGetClass(_collision->GetCollisionId());
+  return geomClass != dHeightfieldClass && geomClass != dGeomTransformClass;
+}
+
+/// \brief Check the name of a triangle mesh collider.
+/// \param[in] _collider "ode" for the ODE trimesh collider, or "fcl" for
+/// ODEFCLCollider when gazebo is built with FCL.
+/// \return True if the collider is available.
+static bool ValidMeshCollider(const std::string &_collider)
+{
+#ifdef HAVE_FCL
+  if (_collider == "fcl")
+    return true;
+#endif
+  return _collider == "ode";
+}
+
+/// \brief Find the unused contact of the previous step closest to a new
+/// contact of the same pair.
+/// \param[in] _previous Contacts of the pair in the previous step.
+/// \param[in] _contact The new contact.
+/// \param[in] _distance Largest distance between the two contact points.
+/// \return The matching contact, nullptr if there is none.
+static ODEPersistentContact *FindPersistentContact(
+    std::vector<ODEPersistentContact> &_previous,
+    const ODEPersistentContact &_contact, const double _distance)
+{
+  // Contacts whose normals differ by more than about 25 degrees are on
+  // different features.
+  const double minNormalDot = 0.9;
+
+  ODEPersistentContact *match = nullptr;
+  double best = _distance * _distance;
+  for (auto &previous : _previous)
   {
-    // dAllocateODEDataForThread(dAllocateMaskAll);
+    if (previous.used || previous.normal.Dot(_contact.normal) < minNormalDot)
+      continue;
+
+    double distance = (previous.pos - _contact.pos).SquaredLength();
+    if (distance <= best)
+    {
+      best = distance;
+      match = &previous;
+    }
   }
+  return match;
+}
 
-  public: void operator() (const tbb::blocked_range<size_t> &_r) const
+/// \brief Get the collision of a geom.
+/// \param[in] _geom The geom, possibly wrapped in a geom transform.
+/// \return The collision, nullptr if the geom has none.
+static ODECollision *GeomCollision(dGeomID _geom)
+{
+  if (dGeomGetClass(_geom) == dGeomTransformClass)
+    _geom = dGeomTransformGetGeom(_geom);
+  return static_cast<ODECollision*>(dGeomGetData(_geom));
+}
+
+/// \brief State of a scene query against the ODE collision space.
+struct ODESceneQuery
+{
+  /// \brief Collisions that overlap the query geom.
+  std::vector<ODECollision *> collisions;
+
+  /// \brief Closest contact of a ray query.
+  dContactGeom contact;
+
+  /// \brief Collision of the closest contact, nullptr if none.
+  ODECollision *hit = nullptr;
+};
+
+/// \brief dSpaceCollide2 callback of scene queries. _o1 is the query
+/// geom, a ray or a shape that belongs to no space.
+/// \param[in] _data The ODESceneQuery.
+/// \param[in] _o1 Query geom.
+/// \param[in] _o2 Geom or space of the world.
+static void SceneQueryCallback(void *_data, dGeomID _o1, dGeomID _o2)
+{
+  if (dGeomIsSpace(_o2))
   {
-    for (size_t i = _r.begin(); i != _r.end(); i++)
+    dSpaceCollide2(_o1, _o2, _data, &SceneQueryCallback);
+    return;
+  }
+
+  // Sensor rays are not part of the scene
+  ODECollision *collision = GeomCollision(_o2);
+  if (!collision || dGeomGetClass(_o2) == dRayClass ||
+      dGeomGetCategoryBits(_o2) == GZ_SENSOR_COLLIDE)
+  {
+    return;
+  }
+
+  dContactGeom contact;
+  if (dCollide(_o1, _o2, 1, &contact, sizeof(contact)) < 1)
+    return;
+
+  ODESceneQuery *query = static_cast<ODESceneQuery *>(_data);
+  if (dGeomGetClass(_o1) == dRayClass)
+  {
+    // The depth of a ray contact is the distance from the ray start
+    if (!query->hit || contact.depth < query->contact.depth)
     {
-      ODECollision *collision1 = (*this->colliders)[i].first;
-      ODECollision *collision2 = (*this->colliders)[i].second;
-      this->engine->Collide(collision1, collision2, contactCollisions);
+      query->hit = collision;
+      query->contact = contact;
     }
   }
+  else if (std::find(query->collisions.begin(), query->collisions.end(),
+        collision) == query->collisions.end())
+  {
+    query->collisions.push_back(collision);
+  }
+}
 
-  private: std::vector< std::pair<ODECollision*, ODECollision*> > *colliders;
-  private: ODEPhysics *engine;
-  private: dContactGeom* contactCollisions;
-};
+/// \brief Convert the axis order of a sweep and prune space.
+/// \param[in] _order Axis order, a permutation of "xyz".
+/// \param[out] _axes The matching dSAP_AXES constant.
+/// \return True if _order is valid.
+static bool SapAxes(const std::string &_order, int &_axes)
+{
+  static const std::map<std::string, int> axes = {
+      {"xyz", dSAP_AXES_XYZ}, {"xzy", dSAP_AXES_XZY},
+      {"yxz", dSAP_AXES_YXZ}, {"yzx", dSAP_AXES_YZX},
+      {"zxy", dSAP_AXES_ZXY}, {"zyx", dSAP_AXES_ZYX}};
+
+  auto iter = axes.find(_order);
+  if (iter == axes.end())
+    return false;
+  _axes = iter->second;
+  return true;
+}
 
 //////////////////////////////////////////////////
 extern "C" void dMessageQuiet(int, const char *, va_list)
@@ -141,6 +258,8 @@ ODEPhysics::ODEPhysics(WorldPtr _world)
 {
   this->dataPtr->physicsStepFunc = nullptr;
   this->dataPtr->maxContacts = 0;
+  this->dataPtr->parallelCollisionThreshold = 0;
+  this->dataPtr->parallelRayThreshold = 0;
 
   // Collision detection init
   dInitODE2(0);
@@ -149,8 +268,8 @@ ODEPhysics::ODEPhysics(WorldPtr _world)
 
   this->dataPtr->worldId = dWorldCreate();
 
-  this->dataPtr->spaceId = dHashSpaceCreate(0);
-  dHashSpaceSetLevels(this->dataPtr->spaceId, -2, 8);
+  this->dataPtr->spaceId = this->CreateSpace(this->dataPtr->spaceType,
+      nullptr);
 
   this->dataPtr->contactGroup = dJointGroupCreate(0);
 
@@ -235,6 +354,88 @@ void ODEPhysics::Load(sdf::ElementPtr _sdf)
     this->GetSORPGSIters());
   dWorldSetQuickStepW(this->dataPtr->worldId, this->GetSORPGSW());
 
+  // Broadphase. Not part of the SDFormat spec, so the values are copied
+  // as strings.
+  if (odeElem->HasElement("space"))
+  {
+    sdf::ElementPtr spaceElem = odeElem->GetElement("space");
+    if (spaceElem->HasElement("type"))
+      this->dataPtr->spaceType = spaceElem->Get<std::string>("type");
+    if (spaceElem->HasElement("model_type"))
+    {
+      this->dataPtr->modelSpaceType =
+          spaceElem->Get<std::string>("model_type");
+    }
+    if (spaceElem->HasElement("hash_min_level"))
+      this->dataPtr->hashMinLevel = spaceElem->Get<int>("hash_min_level");
+    if (spaceElem->HasElement("hash_max_level"))
+      this->dataPtr->hashMaxLevel = spaceElem->Get<int>("hash_max_level");
+    if (spaceElem->HasElement("quadtree_center"))
+    {
+      this->dataPtr->quadTreeCenter =
+          spaceElem->Get<ignition::math::Vector3d>("quadtree_center");
+    }
+    if (spaceElem->HasElement("quadtree_extents"))
+    {
+      this->dataPtr->quadTreeExtents =
+          spaceElem->Get<ignition::math::Vector3d>("quadtree_extents");
+    }
+    if (spaceElem->HasElement("quadtree_depth"))
+      this->dataPtr->quadTreeDepth = spaceElem->Get<int>("quadtree_depth");
+    if (spaceElem->HasElement("sap_axis_order"))
+    {
+      this->dataPtr->sapAxisOrder =
+          spaceElem->Get<std::string>("sap_axis_order");
+    }
+
+    if (this->dataPtr->modelSpaceType != "simple" &&
+        this->dataPtr->modelSpaceType != "hash")
+    {
+      gzerr << "Invalid model space type [" << this->dataPtr->modelSpaceType
+            << "], using simple spaces.\n";
+      this->dataPtr->modelSpaceType = "simple";
+    }
+
+    if (!this->RebuildSpace())
+    {
+      gzerr << "Using a hash space.\n";
+      this->dataPtr->spaceType = "hash";
+      this->RebuildSpace();
+    }
+  }
+
+  // Triangle mesh narrow phase, not part of the SDFormat spec either.
+  if (odeElem->HasElement("mesh_collider"))
+  {
+    std::string collider = odeElem->Get<std::string>("mesh_collider");
+    if (!this->SetParam("mesh_collider", collider))
+      gzerr << "Using the ode mesh collider.\n";
+  }
+
+  // Tolerance on the constraint residual, below which quickstep stops
+  // iterating early. Not part of the SDFormat spec either.
+  if (solverElem->HasElement("sor_lcp_tolerance"))
+  {
+    this->SetParam("sor_lcp_tolerance",
+        solverElem->Get<double>("sor_lcp_tolerance"));
+  }
+
+  // Contact persistence, not part of the SDFormat spec either.
+  if (odeElem->HasElement("contact_persistence"))
+  {
+    sdf::ElementPtr persistElem = odeElem->GetElement("contact_persistence");
+    if (persistElem->HasElement("enabled"))
+    {
+      this->dataPtr->contactPersistence =
+          persistElem->Get<bool>("enabled");
+    }
+    if (persistElem->HasElement("distance"))
+    {
+      this->SetParam("contact_persistence_distance",
+          persistElem->Get<double>("distance"));
+    }
+  }
+
   // Set the physics update function
   this->SetStepType(this->dataPtr->stepType);
   if (this->dataPtr->physicsStepFunc == nullptr)
@@ -370,6 +571,25 @@ void ODEPhysics::UpdateCollision()
   IGN_PROFILE_BEGIN("dSpaceCollide");
 
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  // Keep the impulses of the contact joints before they are destroyed
+  this->dataPtr->previousManifolds.clear();
+  if (this->dataPtr->contactPersistence)
+  {
+    for (auto &manifold : this->dataPtr->manifolds)
+    {
+      for (auto &contact : manifold.second)
+      {
+        dJointGetLambda(contact.joint, contact.lambda, contact.lambdaErp);
+        contact.joint = nullptr;
+      }
+    }
+    this->dataPtr->previousManifolds.swap(this->dataPtr->manifolds);
+  }
+  this->dataPtr->manifolds.clear();
+  this->dataPtr->warmStartedContacts = 0;
+  this->dataPtr->speculativeContacts = 0;
+
   dJointGroupEmpty(this->dataPtr->contactGroup);
 
   unsigned int i = 0;
@@ -385,6 +605,26 @@ void ODEPhysics::UpdateCollision()
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "dSpaceCollide");
   IGN_PROFILE_END();
 
+  if (!this->dataPtr->continuousLinks.empty())
+  {
+    IGN_PROFILE_BEGIN("speculativeContacts");
+    this->CreateSpeculativeContacts();
+    DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "speculativeContacts");
+    IGN_PROFILE_END();
+  }
+
+  if (this->dataPtr->parallelCollisionThreshold > 0 &&
+      this->dataPtr->collidersCount + this->dataPtr->trimeshCollidersCount >=
+      static_cast<unsigned int>(this->dataPtr->parallelCollisionThreshold))
+  {
+    IGN_PROFILE_BEGIN("collideParallel");
+    this->CollideParallel();
+    DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "collideParallel");
+    IGN_PROFILE_END();
+    DIAG_TIMER_STOP("ODEPhysics::UpdateCollision");
+    return;
+  }
+
   IGN_PROFILE_BEGIN("collideShapes");
   // Generate non-trimesh collisions.
   for (i = 0; i < this->dataPtr->collidersCount; ++i)
@@ -411,6 +651,71 @@ void ODEPhysics::UpdateCollision()
   DIAG_TIMER_STOP("ODEPhysics::UpdateCollision");
 }
 
+//////////////////////////////////////////////////
+void ODEPhysics::CollideParallel()
+{
+  const unsigned int collidersCount = this->dataPtr->collidersCount;
+  const unsigned int pairCount =
+    collidersCount + this->dataPtr->trimeshCollidersCount;
+
+  // Normal colliders first, then trimesh colliders, which is the order
+  // used by the serial narrow phase.
+  auto pair = [this, collidersCount](const unsigned int _i)
+      -> const std::pair<ODECollision*, ODECollision*> &
+  {
+    return _i < collidersCount ? this->dataPtr->colliders[_i] :
+      this->dataPtr->trimeshColliders[_i - collidersCount];
+  };
+
+  for (auto &buffer : this->dataPtr->collideBuffers)
+    buffer.contacts.clear();
+  this->dataPtr->pairContacts.assign(pairCount, ODEPairContacts());
+
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, pairCount),
+      [&](const tbb::blocked_range<unsigned int> &_r)
+  {
+    // Trimesh colliders keep their caches in thread local storage.
+    dAllocateODEDataForThread(dAllocateMaskAll);
+
+    ODECollideBuffer &buffer = this->dataPtr->collideBuffers.local();
+    for (unsigned int i = _r.begin(); i != _r.end(); ++i)
+    {
+      const auto &colliders = pair(i);
+      if (!ParallelCollideSafe(colliders.first) ||
+          !ParallelCollideSafe(colliders.second))
+      {
+        continue;
+      }
+
+      ODEPairContacts &result = this->dataPtr->pairContacts[i];
+      result.buffer = &buffer;
+      result.offset = buffer.contacts.size();
+      result.count = this->GenerateContacts(colliders.first,
+          colliders.second, buffer.scratch);
+      buffer.contacts.insert(buffer.contacts.end(), buffer.scratch,
+          buffer.scratch + result.count);
+    }
+  });
+
+  // Create the contact joints in pair order, so the result does not depend
+  // on how the pairs were scheduled.
+  for (unsigned int i = 0; i < pairCount; ++i)
+  {
+    const auto &colliders = pair(i);
+    const ODEPairContacts &result = this->dataPtr->pairContacts[i];
+    if (!result.buffer)
+    {
+      this->Collide(colliders.first, colliders.second,
+          this->dataPtr->contactCollisions);
+    }
+    else if (result.count > 0)
+    {
+      this->CreateContactJoints(colliders.first, colliders.second,
+          &result.buffer->contacts[result.offset], result.count);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 void ODEPhysics::UpdatePhysics()
 {
@@ -422,8 +727,15 @@ void ODEPhysics::UpdatePhysics()
     boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
 
     // Update the dynamical model
-    (*(this->dataPtr->physicsStepFunc))
-      (this->dataPtr->worldId, this->maxStepSize);
+    if (this->substeppedModelCount > 0)
+      this->StepSubstepped(this->maxStepSize);
+    else
+    {
+      this->dataPtr->substeppedBodies = 0;
+      (*(this->dataPtr->physicsStepFunc))
+        (this->dataPtr->worldId, this->maxStepSize);
+      this->AccumulateSolverStatistics();
+    }
 
     ignition::math::Vector3d f1, f2, t1, t2;
 
@@ -461,9 +773,226 @@ void ODEPhysics::UpdatePhysics()
   DIAG_TIMER_STOP("ODEPhysics::UpdatePhysics");
 }
 
+//////////////////////////////////////////////////
+void ODEPhysics::AddSubstepBodies(const ModelPtr &_model,
+    const unsigned int _divisor)
+{
+  const unsigned int divisor = std::max(_divisor, _model->StepDivisor());
+  for (auto const &link : _model->GetLinks())
+  {
+    ODELinkPtr odeLink = boost::static_pointer_cast<ODELink>(link);
+    if (!odeLink->GetODEId())
+      continue;
+
+    ODESubstepBody body;
+    body.body = odeLink->GetODEId();
+    body.divisor = divisor;
+    this->dataPtr->substepBodies.push_back(body);
+  }
+
+  for (auto const &nested : _model->NestedModels())
+    this->AddSubstepBodies(nested, divisor);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::StepSubstepped(const dReal _dt)
+{
+  IGN_PROFILE("ODEPhysics::StepSubstepped");
+
+  std::vector<ODESubstepBody> &bodies = this->dataPtr->substepBodies;
+  bodies.clear();
+  for (auto const &model : this->world->Models())
+    this->AddSubstepBodies(model, 1);
+
+  std::vector<unsigned int> divisors;
+  for (auto &body : bodies)
+  {
+    body.enabled = dBodyIsEnabled(body.body);
+    dCopyVector3(body.force, dBodyGetForce(body.body));
+    dCopyVector3(body.torque, dBodyGetTorque(body.body));
+    if (body.divisor > 1)
+      divisors.push_back(body.divisor);
+  }
+  std::sort(divisors.begin(), divisors.end(), std::greater<unsigned int>());
+  divisors.erase(std::unique(divisors.begin(), divisors.end()),
+      divisors.end());
+
+  // Only change the enabled state of a body when needed, since enabling a
+  // body restarts its auto disable countdown.
+  auto setEnabled = [](dBodyID _body, const bool _enable)
+  {
+    if (_enable && !dBodyIsEnabled(_body))
+      dBodyEnable(_body);
+    else if (!_enable && dBodyIsEnabled(_body))
+      dBodyDisable(_body);
+  };
+
+  unsigned int substepped = 0;
+  for (const unsigned int divisor : divisors)
+  {
+    bool stepping = false;
+    for (auto &body : bodies)
+    {
+      const bool enable =
+          !body.stepped && body.divisor == divisor && body.enabled;
+      setEnabled(body.body, enable);
+      stepping = stepping || enable;
+    }
+    if (!stepping)
+      continue;
+
+    for (unsigned int i = 0; i < divisor; ++i)
+    {
+      // ODE clears the accumulated forces after each step, apply them
+      // again to every substep.
+      if (i > 0)
+      {
+        for (auto const &body : bodies)
+        {
+          if (!body.stepped && dBodyIsEnabled(body.body))
+          {
+            dBodySetForce(body.body,
+                body.force[0], body.force[1], body.force[2]);
+            dBodySetTorque(body.body,
+                body.torque[0], body.torque[1], body.torque[2]);
+          }
+        }
+      }
+      (*(this->dataPtr->physicsStepFunc))
+        (this->dataPtr->worldId, _dt / divisor);
+      this->AccumulateSolverStatistics();
+    }
+
+    // The bodies of the substepped models, and those ODE enabled because
+    // they share an island with one of them, are done. Keep the enabled
+    // state ODE left them in.
+    for (auto &body : bodies)
+    {
+      if (!body.stepped &&
+          (body.divisor == divisor || dBodyIsEnabled(body.body)))
+      {
+        body.stepped = true;
+        body.enabled = dBodyIsEnabled(body.body);
+        ++substepped;
+      }
+    }
+  }
+  this->dataPtr->substeppedBodies = substepped;
+
+  // One step for the rest of the world
+  for (auto const &body : bodies)
+    setEnabled(body.body, !body.stepped && body.enabled);
+  (*(this->dataPtr->physicsStepFunc))(this->dataPtr->worldId, _dt);
+  this->AccumulateSolverStatistics();
+
+  for (auto const &body : bodies)
+  {
+    if (body.stepped && body.enabled)
+      setEnabled(body.body, true);
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::SubsteppedBodyCount() const
+{
+  return this->dataPtr->substeppedBodies;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::AccumulateSolverStatistics()
+{
+  ODESolverStatistics &stats = this->dataPtr->solverStats;
+  ++stats.steps;
+  stats.lastIslands.clear();
+
+  const int limit =
+      dWorldGetQuickStepPreconIterations(this->dataPtr->worldId) +
+      dWorldGetQuickStepNumIterations(this->dataPtr->worldId) +
+      dWorldGetQuickStepExtraFrictionIterations(this->dataPtr->worldId);
+
+  const int count = dWorldGetIslandCount(this->dataPtr->worldId);
+  for (int i = 0; i < count; ++i)
+  {
+    dIslandStatistics island;
+    if (!dWorldGetIslandStatistics(this->dataPtr->worldId, i, &island) ||
+        island.rows == 0)
+    {
+      continue;
+    }
+
+    ++stats.islandSolves;
+    stats.iterations += island.iterations;
+    stats.maxIterations = std::max(stats.maxIterations, island.iterations);
+    if (island.iterations >= limit)
+      ++stats.saturatedSolves;
+    stats.residual += island.residual;
+    stats.maxResidual = std::max(stats.maxResidual,
+        static_cast<double>(island.residual));
+    stats.maxIslandBodies = std::max(stats.maxIslandBodies, island.bodies);
+    stats.maxIslandRows = std::max(stats.maxIslandRows, island.rows);
+    stats.lastIslands.push_back(island);
+  }
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::FillSolverStatistics(msgs::SolverStatistics &_msg)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  ODESolverStatistics &stats = this->dataPtr->solverStats;
+
+  _msg.Clear();
+  _msg.set_engine(this->GetType());
+  _msg.set_steps(stats.steps);
+  _msg.set_island_solves(stats.islandSolves);
+  _msg.set_iteration_limit(
+      dWorldGetQuickStepPreconIterations(this->dataPtr->worldId) +
+      dWorldGetQuickStepNumIterations(this->dataPtr->worldId) +
+      dWorldGetQuickStepExtraFrictionIterations(this->dataPtr->worldId));
+  _msg.set_tolerance(dWorldGetQuickStepTolerance(this->dataPtr->worldId));
+  _msg.set_max_iterations(stats.maxIterations);
+  _msg.set_saturated_solves(stats.saturatedSolves);
+  _msg.set_max_residual(stats.maxResidual);
+  _msg.set_max_island_bodies(stats.maxIslandBodies);
+  _msg.set_max_island_rows(stats.maxIslandRows);
+  if (stats.islandSolves > 0)
+  {
+    _msg.set_mean_iterations(
+        static_cast<double>(stats.iterations) / stats.islandSolves);
+    _msg.set_mean_residual(stats.residual / stats.islandSolves);
+  }
+
+  // The largest islands are the ones worth tuning for
+  std::vector<dIslandStatistics> &islands = stats.lastIslands;
+  const size_t kMaxIslands = 32;
+  const size_t count = std::min(islands.size(), kMaxIslands);
+  std::partial_sort(islands.begin(), islands.begin() + count, islands.end(),
+      [](const dIslandStatistics &_a, const dIslandStatistics &_b)
+      {
+        return _a.rows > _b.rows;
+      });
+  for (size_t i = 0; i < count; ++i)
+  {
+    msgs::SolverStatistics::Island *island = _msg.add_island();
+    island->set_bodies(islands[i].bodies);
+    island->set_joints(islands[i].joints);
+    island->set_contacts(islands[i].contacts);
+    island->set_rows(islands[i].rows);
+    island->set_iterations(islands[i].iterations);
+    island->set_residual(islands[i].residual);
+  }
+
+  stats = ODESolverStatistics();
+  return true;
+}
+
 //////////////////////////////////////////////////
 void ODEPhysics::Fini()
 {
+  if (this->dataPtr->sweepRay)
+    dGeomDestroy(this->dataPtr->sweepRay);
+  this->dataPtr->sweepRay = nullptr;
+  this->dataPtr->continuousLinks.clear();
+
   dCloseODE();
 
   if (this->dataPtr->contactGroup)
@@ -499,6 +1028,12 @@ void ODEPhysics::Reset()
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
   // Very important to clear out the contact group
   dJointGroupEmpty(this->dataPtr->contactGroup);
+
+  // The contacts of the previous state must not warm start the next step
+  this->dataPtr->manifolds.clear();
+  this->dataPtr->previousManifolds.clear();
+  this->dataPtr->warmStartedContacts = 0;
+  this->dataPtr->speculativeContacts = 0;
 }
 
 //////////////////////////////////////////////////
@@ -512,7 +1047,8 @@ LinkPtr ODEPhysics::CreateLink(ModelPtr _parent)
 
   if (iter == this->dataPtr->spaces.end())
     this->dataPtr->spaces[_parent->GetName()] =
-      dSimpleSpaceCreate(this->dataPtr->spaceId);
+      this->CreateSpace(this->dataPtr->modelSpaceType,
+          this->dataPtr->spaceId);
 
   ODELinkPtr link(new ODELink(_parent));
 
@@ -911,6 +1447,75 @@ JointPtr ODEPhysics::CreateJoint(const std::string &_type, ModelPtr _parent)
   return joint;
 }
 
+//////////////////////////////////////////////////
+dSpaceID ODEPhysics::CreateSpace(const std::string &_type,
+    dSpaceID _parent) const
+{
+  if (_type == "simple")
+    return dSimpleSpaceCreate(_parent);
+
+  if (_type == "hash")
+  {
+    dSpaceID space = dHashSpaceCreate(_parent);
+    dHashSpaceSetLevels(space, this->dataPtr->hashMinLevel,
+        this->dataPtr->hashMaxLevel);
+    return space;
+  }
+
+  if (_type == "quadtree")
+  {
+    const ignition::math::Vector3d &c = this->dataPtr->quadTreeCenter;
+    const ignition::math::Vector3d &e = this->dataPtr->quadTreeExtents;
+    dVector3 center = {static_cast<dReal>(c.X()), static_cast<dReal>(c.Y()),
+        static_cast<dReal>(c.Z()), 0};
+    dVector3 extents = {static_cast<dReal>(e.X()),
+        static_cast<dReal>(e.Y()), static_cast<dReal>(e.Z()), 0};
+    return dQuadTreeSpaceCreate(_parent, center, extents,
+        this->dataPtr->quadTreeDepth);
+  }
+
+  if (_type == "sap")
+  {
+    int axes;
+    if (!SapAxes(this->dataPtr->sapAxisOrder, axes))
+    {
+      gzerr << "Invalid sweep and prune axis order ["
+            << this->dataPtr->sapAxisOrder << "]\n";
+      return nullptr;
+    }
+    return dSweepAndPruneSpaceCreate(_parent, axes);
+  }
+
+  gzerr << "Invalid space type [" << _type << "]. Valid types are hash, "
+        << "sap, quadtree and simple.\n";
+  return nullptr;
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::RebuildSpace()
+{
+  dSpaceID space = this->CreateSpace(this->dataPtr->spaceType, nullptr);
+  if (!space)
+    return false;
+
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  dSpaceID oldSpace = this->dataPtr->spaceId;
+  if (oldSpace)
+  {
+    while (dSpaceGetNumGeoms(oldSpace) > 0)
+    {
+      dGeomID geom = dSpaceGetGeom(oldSpace, 0);
+      dSpaceRemove(oldSpace, geom);
+      dSpaceAdd(space, geom);
+    }
+    dSpaceDestroy(oldSpace);
+  }
+
+  this->dataPtr->spaceId = space;
+  return true;
+}
+
 //////////////////////////////////////////////////
 dSpaceID ODEPhysics::GetSpaceId() const
 {
@@ -970,21 +1575,9 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
   }
   else
   {
-    ODECollision *collision1 = nullptr;
-    ODECollision *collision2 = nullptr;
-
     // Get pointers to the underlying collisions
-    if (dGeomGetClass(_o1) == dGeomTransformClass)
-      collision1 =
-        static_cast<ODECollision*>(dGeomGetData(dGeomTransformGetGeom(_o1)));
-    else
-      collision1 = static_cast<ODECollision*>(dGeomGetData(_o1));
-
-    if (dGeomGetClass(_o2) == dGeomTransformClass)
-      collision2 =
-        static_cast<ODECollision*>(dGeomGetData(dGeomTransformGetGeom(_o2)));
-    else
-      collision2 = static_cast<ODECollision*>(dGeomGetData(_o2));
+    ODECollision *collision1 = GeomCollision(_o1);
+    ODECollision *collision2 = GeomCollision(_o2);
 
     // Exit if both bodies are not enabled
     if (dGeomGetCategoryBits(_o1) != GZ_SENSOR_COLLIDE &&
@@ -1017,11 +1610,25 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
 //////////////////////////////////////////////////
 void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
                          dContactGeom *_contactCollisions)
+{
+  unsigned int numc = this->GenerateContacts(_collision1, _collision2,
+      _contactCollisions);
+
+  if (numc > 0)
+  {
+    this->CreateContactJoints(_collision1, _collision2, _contactCollisions,
+        numc);
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::GenerateContacts(ODECollision *_collision1,
+    ODECollision *_collision2, dContactGeom *_contactCollisions)
 {
   // Filter collisions based on collide bitmask.
   if ((_collision1->GetSurface()->collideBitmask &
         _collision2->GetSurface()->collideBitmask) == 0)
-    return;
+    return 0;
 
   // Filter collisions based on contact bitmask if collide_without_contact is
   // on.The bitmask is set mainly for speed improvements otherwise a collision
@@ -1033,7 +1640,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     if ((_collision1->GetSurface()->collideWithoutContactBitmask &
          _collision2->GetSurface()->collideWithoutContactBitmask) == 0)
     {
-      return;
+      return 0;
     }
   }
 
@@ -1050,9 +1657,8 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   }*/
 
   unsigned int numc = 0;
-  dContact contact;
 
-  // maxCollide must less than the size of this->dataPtr->indices
+  // maxCollide must be less than MAX_CONTACT_JOINTS
   // Check the header
   unsigned int maxCollide = MAX_CONTACT_JOINTS;
 
@@ -1068,34 +1674,60 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     maxCollide = _collision2->GetMaxContacts();
 
   // Generate the contacts
-  numc = dCollide(_collision1->GetCollisionId(), _collision2->GetCollisionId(),
-      MAX_COLLIDE_RETURNS, _contactCollisions, sizeof(_contactCollisions[0]));
-
-  // Return if no contacts.
-  if (numc == 0)
-    return;
+  int fclCount = -1;
+#ifdef HAVE_FCL
+  if (this->dataPtr->meshCollider == "fcl" &&
+      dGeomGetClass(_collision1->GetCollisionId()) == dTriMeshClass &&
+      dGeomGetClass(_collision2->GetCollisionId()) == dTriMeshClass)
+  {
+    fclCount = ODEFCLCollider::Collide(_collision1->GetCollisionId(),
+        _collision2->GetCollisionId(), MAX_COLLIDE_RETURNS,
+        _contactCollisions);
+  }
+#endif
 
-  // Store the indices of the contacts.
-  for (int i = 0; i < MAX_CONTACT_JOINTS; i++)
-    this->dataPtr->indices[i] = i;
+  if (fclCount >= 0)
+  {
+    numc = fclCount;
+  }
+  else
+  {
+    numc = dCollide(_collision1->GetCollisionId(),
+        _collision2->GetCollisionId(), MAX_COLLIDE_RETURNS,
+        _contactCollisions, sizeof(_contactCollisions[0]));
+  }
 
-  // Choose only the best contacts if too many were generated.
+  // Choose only the best contacts if too many were generated. The deepest
+  // of the extra contacts replaces the last kept one.
   if (maxCollide > 0 && numc > maxCollide)
   {
+    unsigned int deepest = maxCollide - 1;
     double max = _contactCollisions[maxCollide-1].depth;
     for (unsigned int i = maxCollide; i < numc; ++i)
     {
       if (_contactCollisions[i].depth > max)
       {
         max = _contactCollisions[i].depth;
-        this->dataPtr->indices[maxCollide-1] = i;
+        deepest = i;
       }
     }
+    _contactCollisions[maxCollide-1] = _contactCollisions[deepest];
 
     // Make sure numc has the valid number of contacts.
     numc = maxCollide;
   }
 
+  return numc;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::CreateContactJoints(ODECollision *_collision1,
+    ODECollision *_collision2, dContactGeom *_contactCollisions,
+    const unsigned int _count, const bool _speculative)
+{
+  const unsigned int numc = _count;
+  dContact contact;
+
   // Set the contact surface parameter flags.
   contact.surface.mode = dContactBounce |
                          dContactMu2 |
@@ -1105,6 +1737,8 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
                          dContactApprox3 |
                          dContactSlip1 |
                          dContactSlip2;
+  if (_speculative)
+    contact.surface.mode |= dContactSpeculative;
 
   ODESurfaceParamsPtr surf1 = _collision1->GetODESurface();
   ODESurfaceParamsPtr surf2 = _collision2->GetODESurface();
@@ -1209,7 +1843,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
       {
         // Copy the contact normal
         dReal *contactNormal =
-          _contactCollisions[this->dataPtr->indices[c]].normal;
+          _contactCollisions[c].normal;
         contactNormalCopy.Set(
           contactNormal[0], contactNormal[1], contactNormal[2]);
 
@@ -1239,7 +1873,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
 
         // Construct displacement vector from wheel center to contact point
         dReal *contactPosition =
-          _contactCollisions[this->dataPtr->indices[c]].pos;
+          _contactCollisions[c].pos;
         contactPositionCopy.Set(contactPosition[0] - wheelPosition[0],
                                 contactPosition[1] - wheelPosition[1],
                                 contactPosition[2] - wheelPosition[2]);
@@ -1356,9 +1990,14 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   dBodyID b2 = dGeomGetBody(_collision2->GetCollisionId());
 
   // Add a new contact to the manager. This will return nullptr if no one is
-  // listening for contact information.
-  Contact *contactFeedback = this->contactManager->NewContact(_collision1,
-      _collision2, this->world->SimTime());
+  // listening for contact information. Speculative contacts are not
+  // touching yet, so they are not reported.
+  Contact *contactFeedback = nullptr;
+  if (!_speculative)
+  {
+    contactFeedback = this->contactManager->NewContact(_collision1,
+        _collision2, this->world->SimTime());
+  }
 
   ODEJointFeedback *jointFeedback = nullptr;
 
@@ -1378,42 +2017,110 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     this->dataPtr->jointFeedbackIndex++;
     jointFeedback->count = 0;
     jointFeedback->contact = contactFeedback;
+
+    // Size the feedback array before handing out pointers into it.
+    if (jointFeedback->feedbacks.size() < numc)
+      jointFeedback->feedbacks.resize(numc);
+  }
+
+  // Let the contact modifiers of the two collisions adjust the contacts
+  const ODEContactModifier *modifier1 = nullptr;
+  const ODEContactModifier *modifier2 = nullptr;
+  if (!this->dataPtr->contactModifiers.empty())
+  {
+    auto iter = this->dataPtr->contactModifiers.find(_collision1);
+    if (iter != this->dataPtr->contactModifiers.end())
+      modifier1 = &iter->second;
+    iter = this->dataPtr->contactModifiers.find(_collision2);
+    if (iter != this->dataPtr->contactModifiers.end())
+      modifier2 = &iter->second;
+  }
+
+  std::vector<dContact> &modified = this->dataPtr->modifiedContacts;
+  const bool modify = modifier1 || modifier2;
+  if (modify)
+  {
+    modified.assign(numc, contact);
+    for (unsigned int j = 0; j < numc; ++j)
+      modified[j].geom = _contactCollisions[j];
+
+    if (modifier1)
+      (*modifier1)(_collision1, _collision2, modified.data(), numc);
+    if (modifier2)
+      (*modifier2)(_collision2, _collision1, modified.data(), numc);
+  }
+
+  // Contacts of the pair in the previous step, to warm start from, and in
+  // this step. A pair collided in the other order has its friction
+  // directions flipped, so it is not matched.
+  std::vector<ODEPersistentContact> *previousContacts = nullptr;
+  std::vector<ODEPersistentContact> *currentContacts = nullptr;
+  if (this->dataPtr->contactPersistence)
+  {
+    const auto key = std::make_pair(_collision1, _collision2);
+    auto iter = this->dataPtr->previousManifolds.find(key);
+    if (iter != this->dataPtr->previousManifolds.end())
+      previousContacts = &iter->second;
+    currentContacts = &this->dataPtr->manifolds[key];
   }
 
   // Create a joint for each contact
   for (unsigned int j = 0; j < numc; ++j)
   {
-    contact.geom = _contactCollisions[this->dataPtr->indices[j]];
+    dContact *jointContact = &contact;
+    if (modify)
+      jointContact = &modified[j];
+    else
+      contact.geom = _contactCollisions[j];
 
     // Create the contact joint. This introduces the contact constraint to
     // ODE
     dJointID contactJoint = dJointCreateContact(this->dataPtr->worldId,
-      this->dataPtr->contactGroup, &contact);
+      this->dataPtr->contactGroup, jointContact);
+
+    if (currentContacts)
+    {
+      ODEPersistentContact current;
+      current.joint = contactJoint;
+      current.pos.Set(jointContact->geom.pos[0], jointContact->geom.pos[1],
+          jointContact->geom.pos[2]);
+      current.normal.Set(jointContact->geom.normal[0],
+          jointContact->geom.normal[1], jointContact->geom.normal[2]);
+
+      if (previousContacts)
+      {
+        ODEPersistentContact *match = FindPersistentContact(
+            *previousContacts, current,
+            this->dataPtr->contactPersistenceDistance);
+        if (match)
+        {
+          dJointSetLambda(contactJoint, match->lambda, match->lambdaErp);
+          match->used = true;
+          ++this->dataPtr->warmStartedContacts;
+        }
+      }
+      currentContacts->push_back(current);
+    }
 
     // Store contact information.
     if (contactFeedback && jointFeedback)
     {
-      // Store the contact depth
-      contactFeedback->depths[j] =
-        _contactCollisions[this->dataPtr->indices[j]].depth;
-
-      // Store the contact position
-      contactFeedback->positions[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].pos[0],
-          _contactCollisions[this->dataPtr->indices[j]].pos[1],
-          _contactCollisions[this->dataPtr->indices[j]].pos[2]);
-
-      // Store the contact normal
-      contactFeedback->normals[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].normal[0],
-          _contactCollisions[this->dataPtr->indices[j]].normal[1],
-          _contactCollisions[this->dataPtr->indices[j]].normal[2]);
+      // Store the contact position, normal and depth
+      contactFeedback->AddPoint(
+          ignition::math::Vector3d(
+            _contactCollisions[j].pos[0],
+            _contactCollisions[j].pos[1],
+            _contactCollisions[j].pos[2]),
+          ignition::math::Vector3d(
+            _contactCollisions[j].normal[0],
+            _contactCollisions[j].normal[1],
+            _contactCollisions[j].normal[2]),
+          _contactCollisions[j].depth);
 
       // Set the joint feedback.
       dJointSetFeedback(contactJoint, &(jointFeedback->feedbacks[j]));
 
-      // Increase the counters
-      contactFeedback->count++;
+      // Increase the counter
       jointFeedback->count++;
     }
 
@@ -1424,6 +2131,180 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   }
 }
 
+/////////////////////////////////////////////////
+unsigned int ODEPhysics::WarmStartedContactCount() const
+{
+  return this->dataPtr->warmStartedContacts;
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::SetContinuousCollision(ODELink *_link, const bool _enable)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  auto &links = this->dataPtr->continuousLinks;
+  auto iter = std::find(links.begin(), links.end(), _link);
+  if (_enable && iter == links.end())
+    links.push_back(_link);
+  else if (!_enable && iter != links.end())
+    links.erase(iter);
+}
+
+/////////////////////////////////////////////////
+unsigned int ODEPhysics::SpeculativeContactCount() const
+{
+  return this->dataPtr->speculativeContacts;
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::CreateSpeculativeContacts()
+{
+  if (!this->dataPtr->sweepRay)
+  {
+    this->dataPtr->sweepRay = dCreateRay(nullptr, 1.0);
+    dGeomRaySetClosestHit(this->dataPtr->sweepRay, 1);
+  }
+  dGeomID ray = this->dataPtr->sweepRay;
+
+  for (ODELink *link : this->dataPtr->continuousLinks)
+  {
+    dBodyID body = link->GetODEId();
+    if (!body || !dBodyIsEnabled(body) || link->GetKinematic())
+      continue;
+
+    const dReal *vel = dBodyGetLinearVel(body);
+    ignition::math::Vector3d dir(vel[0], vel[1], vel[2]);
+    const double travel = dir.Length() * this->maxStepSize;
+    if (travel <= 0)
+      continue;
+    dir.Normalize();
+
+    for (auto const &child : link->GetCollisions())
+    {
+      ODECollision *collision = static_cast<ODECollision*>(child.get());
+      dGeomID geom = collision->GetCollisionId();
+      if (!geom || !collision->IsPlaceable() ||
+          collision->GetSurface()->collideWithoutContact)
+      {
+        continue;
+      }
+
+      dReal aabb[6];
+      dGeomGetAABB(geom, aabb);
+      const ignition::math::Vector3d center((aabb[0] + aabb[1]) * 0.5,
+          (aabb[2] + aabb[3]) * 0.5, (aabb[4] + aabb[5]) * 0.5);
+      const ignition::math::Vector3d half((aabb[1] - aabb[0]) * 0.5,
+          (aabb[3] - aabb[2]) * 0.5, (aabb[5] - aabb[4]) * 0.5);
+
+      // The regular contacts catch a collision that moves less than its
+      // own half size before it passes the middle of a thin object.
+      if (travel < half.Min())
+        continue;
+
+      // Distance from the center to the front of the box along the motion
+      const double extent = std::abs(dir.X()) * half.X() +
+        std::abs(dir.Y()) * half.Y() + std::abs(dir.Z()) * half.Z();
+
+      dGeomRaySet(ray, center.X(), center.Y(), center.Z(),
+          dir.X(), dir.Y(), dir.Z());
+      dGeomRaySetLength(ray, extent + travel);
+      dGeomSetCategoryBits(ray, dGeomGetCategoryBits(geom));
+      dGeomSetCollideBits(ray, dGeomGetCollideBits(geom));
+
+      this->dataPtr->sweptCollision = collision;
+      this->dataPtr->sweepHits.clear();
+      dSpaceCollide2(ray, (dGeomID)this->dataPtr->spaceId,
+          this, &SweepCallback);
+
+      for (auto &hit : this->dataPtr->sweepHits)
+      {
+        // Overlapping collisions get regular contacts
+        const double gap = hit.second.depth - extent;
+        if (gap <= 0 || gap >= travel)
+          continue;
+
+        // The normal pushes the swept collision back
+        dContactGeom &contactGeom = hit.second;
+        ignition::math::Vector3d normal(contactGeom.normal[0],
+            contactGeom.normal[1], contactGeom.normal[2]);
+        if (normal.Dot(dir) > 0)
+          normal = -normal;
+        contactGeom.normal[0] = normal.X();
+        contactGeom.normal[1] = normal.Y();
+        contactGeom.normal[2] = normal.Z();
+        contactGeom.depth = -gap;
+        contactGeom.g1 = geom;
+        contactGeom.g2 = hit.first->GetCollisionId();
+
+        this->CreateContactJoints(collision, hit.first, &contactGeom, 1,
+            true);
+        ++this->dataPtr->speculativeContacts;
+      }
+    }
+  }
+  this->dataPtr->sweptCollision = nullptr;
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::SweepCallback(void *_data, dGeomID _o1, dGeomID _o2)
+{
+  ODEPhysics *self = static_cast<ODEPhysics*>(_data);
+
+  if (dGeomIsSpace(_o2))
+  {
+    dSpaceCollide2(_o1, _o2, self, &SweepCallback);
+    return;
+  }
+
+  ODECollision *swept = self->dataPtr->sweptCollision;
+  ODECollision *collision = GeomCollision(_o2);
+  if (!collision || collision == swept ||
+      dGeomGetCategoryBits(_o2) == GZ_SENSOR_COLLIDE ||
+      collision->GetSurface()->collideWithoutContact ||
+      (swept->GetSurface()->collideBitmask &
+       collision->GetSurface()->collideBitmask) == 0)
+  {
+    return;
+  }
+
+  // Skip the collisions of the same link and of the links jointed to it
+  dBodyID b1 = dGeomGetBody(swept->GetCollisionId());
+  dBodyID b2 = dGeomGetBody(_o2);
+  if (b1 == b2 ||
+      (b1 && b2 && dAreConnectedExcluding(b1, b2, dJointTypeContact)))
+  {
+    return;
+  }
+
+  dContactGeom contactGeom;
+  if (dCollide(_o1, _o2, 1, &contactGeom, sizeof(contactGeom)) < 1)
+    return;
+
+  auto &hits = self->dataPtr->sweepHits;
+  for (auto &hit : hits)
+  {
+    if (hit.first == collision)
+    {
+      if (contactGeom.depth < hit.second.depth)
+        hit.second = contactGeom;
+      return;
+    }
+  }
+  hits.push_back(std::make_pair(collision, contactGeom));
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::SetContactModifier(ODECollision *_collision,
+    const ODEContactModifier &_modifier)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  if (_modifier)
+    this->dataPtr->contactModifiers[_collision] = _modifier;
+  else
+    this->dataPtr->contactModifiers.erase(_collision);
+}
+
 /////////////////////////////////////////////////
 void ODEPhysics::AddTrimeshCollider(ODECollision *_collision1,
                                     ODECollision *_collision2)
@@ -1452,6 +2333,85 @@ void ODEPhysics::AddCollider(ODECollision *_collision1,
   this->dataPtr->collidersCount++;
 }
 
+/////////////////////////////////////////////////
+void ODEPhysics::Raycast(const std::vector<QueryRay> &_rays,
+    std::vector<QueryHit> &_hits)
+{
+  IGN_PROFILE("ODEPhysics::Raycast");
+  _hits.assign(_rays.size(), QueryHit());
+  if (_rays.empty())
+    return;
+
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  dGeomID ray = dCreateRay(0, 1.0);
+  for (size_t i = 0; i < _rays.size(); ++i)
+  {
+    ignition::math::Vector3d dir = _rays[i].end - _rays[i].start;
+    const double length = dir.Length();
+    if (length <= 0.0)
+      continue;
+    dir /= length;
+
+    dGeomRaySet(ray, _rays[i].start.X(), _rays[i].start.Y(),
+        _rays[i].start.Z(), dir.X(), dir.Y(), dir.Z());
+    dGeomRaySetLength(ray, length);
+
+    ODESceneQuery query;
+    dSpaceCollide2(ray, (dGeomID)(this->dataPtr->spaceId), &query,
+        &SceneQueryCallback);
+    if (!query.hit)
+      continue;
+
+    QueryHit &hit = _hits[i];
+    hit.collision = boost::static_pointer_cast<Collision>(
+        query.hit->shared_from_this());
+    hit.distance = query.contact.depth;
+    hit.point.Set(query.contact.pos[0], query.contact.pos[1],
+        query.contact.pos[2]);
+    hit.normal.Set(query.contact.normal[0], query.contact.normal[1],
+        query.contact.normal[2]);
+  }
+  dGeomDestroy(ray);
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::Overlap(const QueryShape &_shape,
+    const ignition::math::Pose3d &_pose,
+    std::vector<CollisionPtr> &_collisions)
+{
+  IGN_PROFILE("ODEPhysics::Overlap");
+  _collisions.clear();
+
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  dGeomID geom;
+  if (_shape.type == QueryShape::SPHERE)
+    geom = dCreateSphere(0, _shape.radius);
+  else
+    geom = dCreateBox(0, _shape.size.X(), _shape.size.Y(), _shape.size.Z());
+
+  dGeomSetPosition(geom, _pose.Pos().X(), _pose.Pos().Y(), _pose.Pos().Z());
+  dQuaternion q;
+  q[0] = _pose.Rot().W();
+  q[1] = _pose.Rot().X();
+  q[2] = _pose.Rot().Y();
+  q[3] = _pose.Rot().Z();
+  dGeomSetQuaternion(geom, q);
+
+  ODESceneQuery query;
+  dSpaceCollide2(geom, (dGeomID)(this->dataPtr->spaceId), &query,
+      &SceneQueryCallback);
+  dGeomDestroy(geom);
+
+  _collisions.reserve(query.collisions.size());
+  for (auto collision : query.collisions)
+  {
+    _collisions.push_back(boost::static_pointer_cast<Collision>(
+          collision->shared_from_this()));
+  }
+}
+
 /////////////////////////////////////////////////
 void ODEPhysics::DebugPrint() const
 {
@@ -1624,6 +2584,11 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
       dWorldSetQuickStepExperimentalRowReordering(this->dataPtr->worldId,
         any_cast<bool>(_value));
     }
+    else if (_key == "deterministic_threads")
+    {
+      dWorldSetQuickStepDeterministicThreads(this->dataPtr->worldId,
+        any_cast<bool>(_value));
+    }
     else if (_key == "warm_start_factor")
     {
       dWorldSetQuickStepWarmStartFactor(this->dataPtr->worldId,
@@ -1648,6 +2613,173 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
       }
       dWorldSetIslandThreads(this->dataPtr->worldId, value);
     }
+    else if (_key == "parallel_collision_threshold")
+    {
+      int value;
+      try
+      {
+        value = any_cast<int>(_value);
+      }
+      catch(const boost::bad_any_cast &e)
+      {
+        gzerr << "boost any_cast error:" << e.what() << "\n";
+        return false;
+      }
+      if (value < 0)
+      {
+        gzerr << "parallel_collision_threshold must be positive, or zero "
+              << "to disable the parallel narrow phase\n";
+        return false;
+      }
+      this->dataPtr->parallelCollisionThreshold = value;
+    }
+    else if (_key == "parallel_ray_threshold")
+    {
+      int value;
+      try
+      {
+        value = any_cast<int>(_value);
+      }
+      catch(const boost::bad_any_cast &e)
+      {
+        gzerr << "boost any_cast error:" << e.what() << "\n";
+        return false;
+      }
+      if (value < 0)
+      {
+        gzerr << "parallel_ray_threshold must be positive, or zero "
+              << "to disable the parallel ray narrow phase\n";
+        return false;
+      }
+      this->dataPtr->parallelRayThreshold = value;
+    }
+    else if (_key == "space_type")
+    {
+      std::string type = any_cast<std::string>(_value);
+      std::string oldType = this->dataPtr->spaceType;
+      this->dataPtr->spaceType = type;
+      if (!this->RebuildSpace())
+      {
+        this->dataPtr->spaceType = oldType;
+        return false;
+      }
+    }
+    else if (_key == "model_space_type")
+    {
+      std::string type = any_cast<std::string>(_value);
+      if (type != "simple" && type != "hash")
+      {
+        gzerr << "model_space_type must be simple or hash\n";
+        return false;
+      }
+      // Only models created afterwards use the new type.
+      this->dataPtr->modelSpaceType = type;
+    }
+    else if (_key == "space_hash_min_level" ||
+             _key == "space_hash_max_level")
+    {
+      int value = any_cast<int>(_value);
+      int minLevel = this->dataPtr->hashMinLevel;
+      int maxLevel = this->dataPtr->hashMaxLevel;
+      if (_key == "space_hash_min_level")
+        minLevel = value;
+      else
+        maxLevel = value;
+
+      if (minLevel > maxLevel)
+      {
+        gzerr << "space_hash_min_level must not exceed "
+              << "space_hash_max_level\n";
+        return false;
+      }
+      this->dataPtr->hashMinLevel = minLevel;
+      this->dataPtr->hashMaxLevel = maxLevel;
+
+      if (this->dataPtr->spaceType == "hash")
+        dHashSpaceSetLevels(this->dataPtr->spaceId, minLevel, maxLevel);
+    }
+    else if (_key == "space_quadtree_center" ||
+             _key == "space_quadtree_extents")
+    {
+      ignition::math::Vector3d value =
+          any_cast<ignition::math::Vector3d>(_value);
+      if (_key == "space_quadtree_center")
+        this->dataPtr->quadTreeCenter = value;
+      else
+      {
+        if (value.Min() <= 0)
+        {
+          gzerr << "space_quadtree_extents must be positive\n";
+          return false;
+        }
+        this->dataPtr->quadTreeExtents = value;
+      }
+
+      if (this->dataPtr->spaceType == "quadtree")
+        return this->RebuildSpace();
+    }
+    else if (_key == "space_quadtree_depth")
+    {
+      int value = any_cast<int>(_value);
+      if (value < 1)
+      {
+        gzerr << "space_quadtree_depth must be at least 1\n";
+        return false;
+      }
+      this->dataPtr->quadTreeDepth = value;
+
+      if (this->dataPtr->spaceType == "quadtree")
+        return this->RebuildSpace();
+    }
+    else if (_key == "contact_persistence")
+    {
+      this->dataPtr->contactPersistence = any_cast<bool>(_value);
+      if (!this->dataPtr->contactPersistence)
+      {
+        this->dataPtr->manifolds.clear();
+        this->dataPtr->previousManifolds.clear();
+      }
+    }
+    else if (_key == "contact_persistence_distance")
+    {
+      double value = any_cast<double>(_value);
+      if (value <= 0)
+      {
+        gzerr << "contact_persistence_distance must be positive\n";
+        return false;
+      }
+      this->dataPtr->contactPersistenceDistance = value;
+    }
+    else if (_key == "mesh_collider")
+    {
+      std::string collider = any_cast<std::string>(_value);
+      if (!ValidMeshCollider(collider))
+      {
+        gzerr << "Invalid mesh collider [" << collider << "], must be ode"
+#ifdef HAVE_FCL
+              << " or fcl"
+#else
+              << ", gazebo was built without FCL"
+#endif
+              << ".\n";
+        return false;
+      }
+      this->dataPtr->meshCollider = collider;
+    }
+    else if (_key == "space_sap_axis_order")
+    {
+      std::string order = any_cast<std::string>(_value);
+      int axes;
+      if (!SapAxes(order, axes))
+      {
+        gzerr << "space_sap_axis_order must be a permutation of xyz\n";
+        return false;
+      }
+      this->dataPtr->sapAxisOrder = order;
+
+      if (this->dataPtr->spaceType == "sap")
+        return this->RebuildSpace();
+    }
     else if (_key == "ode_quiet")
     {
       bool odeQuiet;
@@ -1765,6 +2897,10 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = dWorldGetQuickStepExperimentalRowReordering
         (this->dataPtr->worldId);
   }
+  else if (_key == "deterministic_threads")
+  {
+    _value = dWorldGetQuickStepDeterministicThreads(this->dataPtr->worldId);
+  }
   else if (_key == "warm_start_factor")
     _value = dWorldGetQuickStepWarmStartFactor(this->dataPtr->worldId);
   else if (_key == "extra_friction_iterations")
@@ -1773,6 +2909,32 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = this->GetFrictionModel();
   else if (_key == "island_threads")
     _value = dWorldGetIslandThreads(this->dataPtr->worldId);
+  else if (_key == "parallel_collision_threshold")
+    _value = this->dataPtr->parallelCollisionThreshold;
+  else if (_key == "parallel_ray_threshold")
+    _value = this->dataPtr->parallelRayThreshold;
+  else if (_key == "space_type")
+    _value = this->dataPtr->spaceType;
+  else if (_key == "model_space_type")
+    _value = this->dataPtr->modelSpaceType;
+  else if (_key == "space_hash_min_level")
+    _value = this->dataPtr->hashMinLevel;
+  else if (_key == "space_hash_max_level")
+    _value = this->dataPtr->hashMaxLevel;
+  else if (_key == "space_quadtree_center")
+    _value = this->dataPtr->quadTreeCenter;
+  else if (_key == "space_quadtree_extents")
+    _value = this->dataPtr->quadTreeExtents;
+  else if (_key == "space_quadtree_depth")
+    _value = this->dataPtr->quadTreeDepth;
+  else if (_key == "space_sap_axis_order")
+    _value = this->dataPtr->sapAxisOrder;
+  else if (_key == "mesh_collider")
+    _value = this->dataPtr->meshCollider;
+  else if (_key == "contact_persistence")
+    _value = this->dataPtr->contactPersistence;
+  else if (_key == "contact_persistence_distance")
+    _value = this->dataPtr->contactPersistenceDistance;
   else if (_key == "ode_quiet")
     _value = dGetMessageHandler() != 0;
   else if (_key == "world_step_solver")
@@ -19,6 +19,7 @@
 
 #include <tbb/spin_mutex.h>
 #include <tbb/concurrent_vector.h>
+#include <functional>
 #include <string>
 #include <utility>
 
@@ -39,6 +40,15 @@ namespace gazebo
     class ODEJointFeedback;
     class ODEPhysicsPrivate;
 
+    /// \brief Function that adjusts the ODE contacts of a collision pair
+    /// before their contact joints are created. The arguments are the
+    /// collision the function was set for, the other collision of the pair,
+    /// the contacts and their number.
+    /// \sa ODEPhysics::SetContactModifier
+    typedef std::function<void (ODECollision *_collision,
+        ODECollision *_other, dContact *_contacts, unsigned int _count)>
+        ODEContactModifier;
+
     /// \ingroup gazebo_physics
     /// \addtogroup gazebo_physics_ode ODE Physics
     /// \brief Open Dynamics Engine physics wrapper
@@ -210,6 +220,29 @@ namespace gazebo
       // Documentation inherited
       public: virtual void DebugPrint() const;
 
+      /// \brief Cast the rays against the ODE collision space, reusing one
+      /// ray geom for the batch. Hits report the surface normal.
+      /// \param[in] _rays Rays to cast.
+      /// \param[out] _hits Closest hit of each ray.
+      public: void Raycast(const std::vector<QueryRay> &_rays,
+                           std::vector<QueryHit> &_hits) override;
+
+      /// \brief Find overlapping collisions with ODE's broadphase and exact
+      /// geom tests.
+      /// \param[in] _shape Query shape.
+      /// \param[in] _pose Pose of the shape in world frame.
+      /// \param[out] _collisions Overlapping collisions.
+      public: void Overlap(const QueryShape &_shape,
+                           const ignition::math::Pose3d &_pose,
+                           std::vector<CollisionPtr> &_collisions) override;
+
+      /// \brief Report the convergence of each island solved by quickstep.
+      /// The world step solver reports the number of steps only.
+      /// \param[out] _msg Message to fill.
+      /// \return True.
+      public: bool FillSolverStatistics(msgs::SolverStatistics &_msg)
+                  override;
+
       // Documentation inherited
       public: virtual void SetSeed(uint32_t _seed);
 
@@ -280,6 +313,44 @@ namespace gazebo
       public: virtual void SetStepType(const std::string &_type);
 
 
+      /// \brief Set a function that adjusts the contacts of a collision,
+      /// for example their friction direction or surface motion, before
+      /// the contact joints are created. Only the pairs that involve the
+      /// collision reach the function, which runs on the physics thread
+      /// during UpdateCollision. The function must be removed before the
+      /// collision is deleted.
+      /// \param[in] _collision The collision.
+      /// \param[in] _modifier The function, or an empty function to remove
+      /// the current one.
+      public: void SetContactModifier(ODECollision *_collision,
+                  const ODEContactModifier &_modifier);
+
+      /// \brief Get the number of contact joints of the last step that
+      /// started from the impulses of a contact of the previous step, see
+      /// the contact_persistence parameter.
+      /// \return Number of warm started contact joints.
+      public: unsigned int WarmStartedContactCount() const;
+
+      /// \brief Set whether the collisions of a link are swept along its
+      /// velocity. Each step, a link that moves farther than its own size
+      /// gets speculative contacts with the objects ahead of it, which
+      /// stop it at the surface instead of letting it tunnel through.
+      /// \param[in] _link The link.
+      /// \param[in] _enable True to sweep the collisions of the link.
+      /// \sa Link::SetContinuousCollision
+      public: void SetContinuousCollision(ODELink *_link, const bool _enable);
+
+      /// \brief Get the number of speculative contact joints of the last
+      /// step.
+      /// \return Number of speculative contact joints.
+      public: unsigned int SpeculativeContactCount() const;
+
+      /// \brief Get the number of bodies integrated with substeps in the
+      /// last step.
+      /// \return Number of substepped bodies.
+      /// \sa Model::SetStepDivisor
+      public: unsigned int SubsteppedBodyCount() const;
+
       /// \brief Collide two collision objects.
       /// \param[in] _collision1 First collision object.
       /// \param[in] _collision2 Second collision object.
@@ -287,6 +358,73 @@ namespace gazebo
       public: void Collide(ODECollision *_collision1, ODECollision *_collision2,
                            dContactGeom *_contactCollisions);
 
+      /// \brief Generate the contact points between two collision objects,
+      /// without creating contact joints. This only reads shared state, so
+      /// several threads can call it at once if each one has its own
+      /// _contactCollisions array.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[out] _contactCollisions Array of MAX_COLLIDE_RETURNS
+      /// contacts. On return the first entries hold the contacts to use.
+      /// \return Number of contacts to use.
+      private: unsigned int GenerateContacts(ODECollision *_collision1,
+                   ODECollision *_collision2,
+                   dContactGeom *_contactCollisions);
+
+      /// \brief Create the contact joints between two collision objects.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[in,out] _contactCollisions Contacts from GenerateContacts.
+      /// \param[in] _count Number of contacts.
+      /// \param[in] _speculative True if the contacts are gaps the
+      /// collisions may close in one step, with negative depths.
+      private: void CreateContactJoints(ODECollision *_collision1,
+                   ODECollision *_collision2,
+                   dContactGeom *_contactCollisions, unsigned int _count,
+                   const bool _speculative = false);
+
+      /// \brief Create the speculative contacts of the links swept along
+      /// their velocity.
+      /// \sa SetContinuousCollision
+      private: void CreateSpeculativeContacts();
+
+      /// \brief Create a collision space.
+      /// \param[in] _type Space type: "hash", "sap", "quadtree" or "simple".
+      /// \param[in] _parent Space to insert the new space into, or nullptr.
+      /// \return The new space, or nullptr if _type is unknown.
+      private: dSpaceID CreateSpace(const std::string &_type,
+                   dSpaceID _parent) const;
+
+      /// \brief Replace the top-level space with one built from the current
+      /// space settings, and move all its geoms and subspaces to it.
+      /// \return True if the space was created.
+      private: bool RebuildSpace();
+
+      /// \brief Step the world when some models have a step divisor. For
+      /// each divisor, from the largest, the bodies of the other models
+      /// are disabled and the world is stepped that many times with a
+      /// fraction of the step size. ODE enables the disabled bodies that
+      /// are connected to a stepped body, so whole islands are substepped.
+      /// The remaining bodies then take a single step.
+      /// \param[in] _dt Step size.
+      private: void StepSubstepped(const dReal _dt);
+
+      /// \brief Add the convergence of the islands of the last ODE step
+      /// to the solver statistics.
+      private: void AccumulateSolverStatistics();
+
+      /// \brief Add the bodies of a model and of its nested models to
+      /// the bodies of StepSubstepped.
+      /// \param[in] _model The model.
+      /// \param[in] _divisor Step divisor of the parent model.
+      private: void AddSubstepBodies(const ModelPtr &_model,
+                   const unsigned int _divisor);
+
+      /// \brief Collide all pairs found by dSpaceCollide. The contact
+      /// points are generated on TBB workers, and the contact joints are
+      /// then created on this thread in the order the pairs were found.
+      private: void CollideParallel();
+
       /// \brief process joint feedbacks.
       /// \param[in] _feedback ODE Joint Contact feedback information.
       public: void ProcessJointFeedback(ODEJointFeedback *_feedback);
@@ -302,6 +440,13 @@ namespace gazebo
       private: static void CollisionCallback(void *_data, dGeomID _o1,
                                              dGeomID _o2);
 
+      /// \brief Callback of the ray that sweeps a collision.
+      /// \param[in] _data Pointer to the physics engine.
+      /// \param[in] _o1 The ray.
+      /// \param[in] _o2 Geom or space to check for hits.
+      private: static void SweepCallback(void *_data, dGeomID _o1,
+                                         dGeomID _o2);
+
 
       /// \brief Create a triangle mesh object collider.
       /// \param[in] _collision1 The first collision object.
@@ -18,12 +18,18 @@
 #ifndef _ODEPHYSICS_PRIVATE_HH_
 #define _ODEPHYSICS_PRIVATE_HH_
 
+#include <tbb/enumerable_thread_specific.h>
+
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
+#include <ignition/math/Vector3.hh>
+
 #include "gazebo/physics/Contact.hh"
+#include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 
 namespace gazebo
@@ -41,8 +47,120 @@ namespace gazebo
       /// \brief Number of elements in feedbacks array.
       public: int count;
 
-      /// \brief Contact joint feedback information.
-      public: dJointFeedback feedbacks[MAX_CONTACT_JOINTS];
+      /// \brief Contact joint feedback information. Only grows, so the
+      /// pointers passed to dJointSetFeedback stay valid for a step.
+      public: std::vector<dJointFeedback> feedbacks;
+    };
+
+    /// \brief Per thread storage of the parallel narrow phase.
+    class ODECollideBuffer
+    {
+      /// \brief Array passed to dCollide.
+      public: dContactGeom scratch[MAX_COLLIDE_RETURNS];
+
+      /// \brief Contacts kept for the pairs processed by this thread.
+      public: std::vector<dContactGeom> contacts;
+    };
+
+    /// \brief Contacts generated for one collision pair by the parallel
+    /// narrow phase.
+    class ODEPairContacts
+    {
+      /// \brief Buffer that holds the contacts, nullptr if the pair must
+      /// be collided on the physics thread.
+      public: ODECollideBuffer *buffer = nullptr;
+
+      /// \brief Index of the first contact in buffer->contacts.
+      public: size_t offset = 0;
+
+      /// \brief Number of contacts.
+      public: unsigned int count = 0;
+    };
+
+    /// \brief Contact joint of a step, whose impulses warm start the
+    /// matching contact joint of the next step.
+    class ODEPersistentContact
+    {
+      /// \brief The contact joint, only valid during the step it was
+      /// created in.
+      public: dJointID joint = nullptr;
+
+      /// \brief Contact position in the world frame.
+      public: ignition::math::Vector3d pos;
+
+      /// \brief Contact normal in the world frame.
+      public: ignition::math::Vector3d normal;
+
+      /// \brief Row impulses solved for the joint.
+      public: dReal lambda[6] = {0, 0, 0, 0, 0, 0};
+
+      /// \brief Row impulses of the error reduction pass.
+      public: dReal lambdaErp[6] = {0, 0, 0, 0, 0, 0};
+
+      /// \brief True once a contact of the next step was matched to it.
+      public: bool used = false;
+    };
+
+    /// \brief Body of a world step with substepped models.
+    class ODESubstepBody
+    {
+      /// \brief The body.
+      public: dBodyID body = nullptr;
+
+      /// \brief Step divisor of the model of the body.
+      public: unsigned int divisor = 1;
+
+      /// \brief True if the body was enabled before the step.
+      public: bool enabled = true;
+
+      /// \brief True once the body was integrated with substeps.
+      public: bool stepped = false;
+
+      /// \brief Force accumulated on the body before the step, which ODE
+      /// clears after each substep.
+      public: dVector3 force = {0, 0, 0, 0};
+
+      /// \brief Torque accumulated on the body before the step.
+      public: dVector3 torque = {0, 0, 0, 0};
+    };
+
+    /// \brief Contacts of a collision pair, in the order the pair was
+    /// collided.
+    typedef std::map<std::pair<const ODECollision *, const ODECollision *>,
+        std::vector<ODEPersistentContact>> ODEContactManifolds;
+
+    /// \brief Convergence of the quickstep solver accumulated over steps.
+    class ODESolverStatistics
+    {
+      /// \brief Number of ODE steps, substeps included.
+      public: uint64_t steps = 0;
+
+      /// \brief Number of islands with constraints solved.
+      public: uint64_t islandSolves = 0;
+
+      /// \brief Sum of the iterations of the island solves.
+      public: uint64_t iterations = 0;
+
+      /// \brief Most iterations of an island solve.
+      public: int maxIterations = 0;
+
+      /// \brief Number of island solves that did every iteration.
+      public: uint64_t saturatedSolves = 0;
+
+      /// \brief Sum of the final residuals of the island solves.
+      public: double residual = 0;
+
+      /// \brief Largest final residual of an island solve.
+      public: double maxResidual = 0;
+
+      /// \brief Most bodies in an island.
+      public: int maxIslandBodies = 0;
+
+      /// \brief Most constraint rows in an island.
+      public: int maxIslandRows = 0;
+
+      /// \brief Islands with constraints of the last step.
+      public: std::vector<dIslandStatistics> lastIslands;
     };
 
     class ODEPhysicsPrivate
@@ -53,6 +171,39 @@ namespace gazebo
       /// \brief Top-level space for all sub-spaces/collisions
       public: dSpaceID spaceId;
 
+      /// \brief Type of the top-level space: "hash", "sap", "quadtree" or
+      /// "simple".
+      public: std::string spaceType = "hash";
+
+      /// \brief Type of the space created for each model: "simple" or
+      /// "hash".
+      public: std::string modelSpaceType = "simple";
+
+      /// \brief Smallest cell size of hash spaces, as a power of two.
+      public: int hashMinLevel = -2;
+
+      /// \brief Largest cell size of hash spaces, as a power of two.
+      public: int hashMaxLevel = 8;
+
+      /// \brief Center of the quadtree space.
+      public: ignition::math::Vector3d quadTreeCenter =
+                ignition::math::Vector3d::Zero;
+
+      /// \brief Half extents of the quadtree space.
+      public: ignition::math::Vector3d quadTreeExtents =
+                ignition::math::Vector3d(500, 500, 100);
+
+      /// \brief Depth of the quadtree space.
+      public: int quadTreeDepth = 6;
+
+      /// \brief Axis order of the sweep and prune space, e.g. "xyz". The
+      /// first axis should be the one along which the world is widest.
+      public: std::string sapAxisOrder = "xyz";
+
+      /// \brief Narrow phase of triangle mesh pairs: "ode", or "fcl" for
+      /// ODEFCLCollider.
+      public: std::string meshCollider = "ode";
+
       /// \brief Collision attributes
       public: dJointGroupID contactGroup;
 
@@ -78,9 +229,6 @@ namespace gazebo
       /// \brief Array of contact collisions.
       public: dContactGeom contactCollisions[MAX_COLLIDE_RETURNS];
 
-      /// \brief Indices used during creation of contact joints.
-      public: int indices[MAX_CONTACT_JOINTS];
-
       /// \brief Current index into the contactFeedbacks buffer
       public: unsigned int jointFeedbackIndex;
 
@@ -92,6 +240,74 @@ namespace gazebo
 
       /// \brief Maximum number of contact points per collision pair.
       public: unsigned int maxContacts;
+
+      /// \brief Minimum number of collision pairs for the narrow phase to
+      /// run on TBB workers. Zero disables the parallel narrow phase.
+      public: int parallelCollisionThreshold;
+
+      /// \brief Minimum number of ray and geom pairs for the narrow phase
+      /// of ODEMultiRayShape to run on TBB workers. Zero disables it.
+      public: int parallelRayThreshold;
+
+      /// \brief Per thread contact buffers of the parallel narrow phase.
+      public: tbb::enumerable_thread_specific<ODECollideBuffer>
+               collideBuffers;
+
+      /// \brief Result of the parallel narrow phase, one entry per pair.
+      public: std::vector<ODEPairContacts> pairContacts;
+
+      /// \brief Contact modifiers, indexed by collision.
+      public: std::unordered_map<const ODECollision *, ODEContactModifier>
+               contactModifiers;
+
+      /// \brief Contacts passed to the contact modifiers, reused between
+      /// collision pairs.
+      public: std::vector<dContact> modifiedContacts;
+
+      /// \brief True to warm start the contact joints with the impulses
+      /// of the matching contacts of the previous step.
+      public: bool contactPersistence = false;
+
+      /// \brief Largest distance between two contact points of a pair
+      /// in consecutive steps for them to match.
+      public: double contactPersistenceDistance = 0.01;
+
+      /// \brief Contacts of the previous step, with their impulses.
+      public: ODEContactManifolds previousManifolds;
+
+      /// \brief Contacts created during the current step.
+      public: ODEContactManifolds manifolds;
+
+      /// \brief Number of contact joints of the last step that were warm
+      /// started.
+      public: unsigned int warmStartedContacts = 0;
+
+      /// \brief Links whose collisions are swept along their velocity, in
+      /// the order they were enabled.
+      public: std::vector<ODELink *> continuousLinks;
+
+      /// \brief Ray that sweeps the collisions.
+      public: dGeomID sweepRay = nullptr;
+
+      /// \brief Collision being swept.
+      public: ODECollision *sweptCollision = nullptr;
+
+      /// \brief Nearest hit of the swept collision on each other collision.
+      public: std::vector<std::pair<ODECollision *, dContactGeom>> sweepHits;
+
+      /// \brief Number of speculative contact joints of the last step.
+      public: unsigned int speculativeContacts = 0;
+
+      /// \brief Bodies of the current step with substepped models, kept
+      /// to reuse the allocation.
+      public: std::vector<ODESubstepBody> substepBodies;
+
+      /// \brief Number of bodies integrated with substeps in the last
+      /// step.
+      public: unsigned int substeppedBodies = 0;
+
+      /// \brief Solver statistics since the last FillSolverStatistics.
+      public: ODESolverStatistics solverStats;
     };
   }
 }
@@ -17,8 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include "gazebo/gazebo_config.h"
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -320,6 +322,104 @@ TEST_F(ODEPhysics_TEST, PhysicsParam)
     }
   }
 
+  // Test deterministic_threads
+  {
+    bool deterministic = true;
+    EXPECT_NO_THROW(deterministic = boost::any_cast<bool>(
+      odePhysics->GetParam("deterministic_threads")));
+    EXPECT_FALSE(deterministic);
+
+    EXPECT_TRUE(odePhysics->SetParam("deterministic_threads", true));
+    EXPECT_NO_THROW(deterministic = boost::any_cast<bool>(
+      odePhysics->GetParam("deterministic_threads")));
+    EXPECT_TRUE(deterministic);
+    EXPECT_TRUE(odePhysics->SetParam("deterministic_threads", false));
+  }
+
+  // Test parallel_collision_threshold
+  {
+    // parallel narrow phase should be off by default
+    int threshold = 1;
+    EXPECT_NO_THROW(threshold = boost::any_cast<int>(
+      odePhysics->GetParam("parallel_collision_threshold")));
+    EXPECT_EQ(threshold, 0);
+
+    EXPECT_FALSE(odePhysics->SetParam("parallel_collision_threshold", -1));
+    EXPECT_TRUE(odePhysics->SetParam("parallel_collision_threshold", 8));
+    EXPECT_NO_THROW(threshold = boost::any_cast<int>(
+      odePhysics->GetParam("parallel_collision_threshold")));
+    EXPECT_EQ(threshold, 8);
+    EXPECT_TRUE(odePhysics->SetParam("parallel_collision_threshold", 0));
+  }
+
+  // Test parallel_ray_threshold
+  {
+    // parallel ray narrow phase should be off by default
+    int threshold = 1;
+    EXPECT_NO_THROW(threshold = boost::any_cast<int>(
+      odePhysics->GetParam("parallel_ray_threshold")));
+    EXPECT_EQ(threshold, 0);
+
+    EXPECT_FALSE(odePhysics->SetParam("parallel_ray_threshold", -1));
+    EXPECT_TRUE(odePhysics->SetParam("parallel_ray_threshold", 64));
+    EXPECT_NO_THROW(threshold = boost::any_cast<int>(
+      odePhysics->GetParam("parallel_ray_threshold")));
+    EXPECT_EQ(threshold, 64);
+    EXPECT_TRUE(odePhysics->SetParam("parallel_ray_threshold", 0));
+  }
+
+  // Test broadphase space selection
+  {
+    std::string space;
+    EXPECT_NO_THROW(space = boost::any_cast<std::string>(
+      odePhysics->GetParam("space_type")));
+    EXPECT_EQ(space, "hash");
+    EXPECT_NO_THROW(space = boost::any_cast<std::string>(
+      odePhysics->GetParam("model_space_type")));
+    EXPECT_EQ(space, "simple");
+
+    EXPECT_FALSE(odePhysics->SetParam("space_type", std::string("octree")));
+    EXPECT_FALSE(odePhysics->SetParam("space_sap_axis_order",
+        std::string("xxy")));
+    EXPECT_FALSE(odePhysics->SetParam("space_hash_min_level", 9));
+    EXPECT_FALSE(odePhysics->SetParam("space_quadtree_depth", 0));
+
+    for (const std::string &spaceType : {"sap", "quadtree", "simple", "hash"})
+    {
+      EXPECT_TRUE(odePhysics->SetParam("space_type", spaceType));
+      EXPECT_NO_THROW(space = boost::any_cast<std::string>(
+        odePhysics->GetParam("space_type")));
+      EXPECT_EQ(space, spaceType);
+      EXPECT_TRUE(odePhysics->GetSpaceId() != nullptr);
+    }
+
+    EXPECT_TRUE(odePhysics->SetParam("space_sap_axis_order",
+        std::string("yxz")));
+    EXPECT_TRUE(odePhysics->SetParam("space_quadtree_depth", 4));
+    int depth = 0;
+    EXPECT_NO_THROW(depth = boost::any_cast<int>(
+      odePhysics->GetParam("space_quadtree_depth")));
+    EXPECT_EQ(depth, 4);
+  }
+
+  // Test triangle mesh collider selection
+  {
+    std::string collider;
+    EXPECT_NO_THROW(collider = boost::any_cast<std::string>(
+      odePhysics->GetParam("mesh_collider")));
+    EXPECT_EQ(collider, "ode");
+    EXPECT_FALSE(odePhysics->SetParam("mesh_collider", std::string("gjk")));
+#ifdef HAVE_FCL
+    EXPECT_TRUE(odePhysics->SetParam("mesh_collider", std::string("fcl")));
+    EXPECT_NO_THROW(collider = boost::any_cast<std::string>(
+      odePhysics->GetParam("mesh_collider")));
+    EXPECT_EQ(collider, "fcl");
+#else
+    EXPECT_FALSE(odePhysics->SetParam("mesh_collider", std::string("fcl")));
+#endif
+    EXPECT_TRUE(odePhysics->SetParam("mesh_collider", std::string("ode")));
+  }
+
   // Test ode_quiet
   // convenient for disabling LCP internal error messages from world solver
   {
@@ -490,6 +590,351 @@ TEST_F(ODEPhysics_TEST, PhysicsMsgParam)
   PhysicsMsgParam();
 }
 
+/////////////////////////////////////////////////
+/// Check that the parallel narrow phase gives the same result as the serial
+/// one.
+TEST_F(ODEPhysics_TEST, ParallelCollision)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  // A pile of boxes and spheres that touch each other and the ground.
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      std::string suffix = std::to_string(i) + "_" + std::to_string(j);
+      SpawnBox("box_" + suffix, ignition::math::Vector3d(0.5, 0.5, 0.5),
+          ignition::math::Vector3d(i * 0.45, j * 0.45, 0.25),
+          ignition::math::Vector3d(0, 0, 0.1 * (i + j)));
+      SpawnSphere("sphere_" + suffix,
+          ignition::math::Vector3d(i * 0.45 + 0.1, j * 0.45, 0.75),
+          ignition::math::Vector3d::Zero);
+    }
+  }
+
+  auto run = [&](const int _threshold)
+  {
+    world->Reset();
+    EXPECT_TRUE(physics->SetParam("parallel_collision_threshold",
+        _threshold));
+    world->Step(200);
+
+    std::vector<ignition::math::Pose3d> poses;
+    for (const auto &model : world->Models())
+      poses.push_back(model->WorldPose());
+    return poses;
+  };
+
+  auto serial = run(0);
+  auto parallel = run(1);
+  ASSERT_EQ(serial.size(), parallel.size());
+  for (size_t i = 0; i < serial.size(); ++i)
+    EXPECT_EQ(serial[i], parallel[i]) << world->ModelByIndex(i)->GetName();
+}
+
+/////////////////////////////////////////////////
+/// Check that contact modifiers only see the pairs of their collision and
+/// change the contact joints.
+TEST_F(ODEPhysics_TEST, ContactModifier)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr physics =
+    boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(physics != nullptr);
+
+  SpawnBox("box", ignition::math::Vector3d(0.5, 0.5, 0.5),
+      ignition::math::Vector3d(0, 0, 0.25), ignition::math::Vector3d::Zero);
+  SpawnBox("other_box", ignition::math::Vector3d(0.5, 0.5, 0.5),
+      ignition::math::Vector3d(0, 5, 0.25), ignition::math::Vector3d::Zero);
+  ModelPtr model = world->ModelByName("box");
+  ASSERT_TRUE(model != nullptr);
+  LinkPtr link = model->GetLink();
+  ASSERT_TRUE(link != nullptr);
+  ODECollision *collision =
+    boost::static_pointer_cast<ODECollision>(link->GetCollisions()[0]).get();
+
+  // Remove the friction of the box
+  unsigned int calls = 0;
+  physics->SetContactModifier(collision,
+      [&](ODECollision *_collision, ODECollision *_other,
+          dContact *_contacts, unsigned int _count)
+      {
+        EXPECT_EQ(collision, _collision);
+        EXPECT_EQ("ground_plane", _other->GetModel()->GetName());
+        EXPECT_GT(_count, 0u);
+        for (unsigned int i = 0; i < _count; ++i)
+        {
+          _contacts[i].surface.mu = 0;
+          _contacts[i].surface.mu2 = 0;
+        }
+        ++calls;
+      });
+
+  world->Step(10);
+  EXPECT_GT(calls, 0u);
+
+  // The box slides without friction
+  link->SetLinearVel(ignition::math::Vector3d(1, 0, 0));
+  world->Step(100);
+  EXPECT_NEAR(1.0, link->WorldLinearVel().X(), 1e-3);
+
+  // Once the modifier is removed friction stops the box
+  physics->SetContactModifier(collision, nullptr);
+  const unsigned int callsBefore = calls;
+  world->Step(500);
+  EXPECT_NEAR(0.0, link->WorldLinearVel().X(), 1e-3);
+  EXPECT_EQ(callsBefore, calls);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ODEPhysics_TEST, ContactPersistence)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr physics =
+    boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(physics != nullptr);
+
+  bool persistence = true;
+  EXPECT_NO_THROW(persistence = boost::any_cast<bool>(
+    physics->GetParam("contact_persistence")));
+  EXPECT_FALSE(persistence);
+  EXPECT_FALSE(physics->SetParam("contact_persistence_distance", 0.0));
+
+  // A stack of boxes resting on the ground
+  for (int i = 0; i < 3; ++i)
+  {
+    SpawnBox("box_" + std::to_string(i),
+        ignition::math::Vector3d(0.5, 0.5, 0.5),
+        ignition::math::Vector3d(0, 0, 0.25 + i * 0.5),
+        ignition::math::Vector3d::Zero);
+  }
+  world->Step(200);
+  EXPECT_EQ(0u, physics->WarmStartedContactCount());
+
+  EXPECT_TRUE(physics->SetParam("contact_persistence", true));
+  EXPECT_TRUE(physics->SetParam("contact_persistence_distance", 0.02));
+  world->Step(1);
+  EXPECT_EQ(0u, physics->WarmStartedContactCount());
+
+  // The contacts of resting boxes match the ones of the previous step
+  world->Step(1);
+  EXPECT_GT(physics->WarmStartedContactCount(), 0u);
+
+  // The stack stays put with half the iterations
+  physics->SetParam("iters", 25);
+  world->Step(1000);
+  for (int i = 0; i < 3; ++i)
+  {
+    ModelPtr model = world->ModelByName("box_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+    EXPECT_NEAR(0.25 + i * 0.5, model->WorldPose().Pos().Z(), 1e-2);
+    EXPECT_NEAR(0.0, model->WorldPose().Pos().X(), 1e-2);
+  }
+  EXPECT_GT(physics->WarmStartedContactCount(), 0u);
+
+  // Resetting the world drops the contacts of the previous state
+  world->Reset();
+  world->Step(1);
+  EXPECT_EQ(0u, physics->WarmStartedContactCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ODEPhysics_TEST, ContinuousCollision)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr physics =
+    boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(physics != nullptr);
+
+  // Two thin static walls and a small fast sphere in front of each one
+  for (int i = 0; i < 2; ++i)
+  {
+    const std::string suffix = std::to_string(i);
+    SpawnBox("wall_" + suffix, ignition::math::Vector3d(0.01, 1, 1),
+        ignition::math::Vector3d(1, i * 2.0, 1), ignition::math::Vector3d::Zero,
+        true);
+    SpawnSphere("ball_" + suffix, ignition::math::Vector3d(0.01, i * 2.0, 1),
+        ignition::math::Vector3d::Zero, ignition::math::Vector3d::Zero, 0.02);
+  }
+
+  std::vector<LinkPtr> links;
+  for (int i = 0; i < 2; ++i)
+  {
+    ModelPtr model = world->ModelByName("ball_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+    LinkPtr link = model->GetLink();
+    ASSERT_TRUE(link != nullptr);
+    link->SetGravityMode(false);
+    links.push_back(link);
+  }
+
+  EXPECT_FALSE(links[1]->ContinuousCollision());
+  links[1]->SetContinuousCollision(true);
+  EXPECT_TRUE(links[1]->ContinuousCollision());
+
+  // 40 mm per step, more than the diameter of the spheres and the
+  // thickness of the walls. The centers of the spheres never land inside
+  // the walls.
+  const ignition::math::Vector3d vel(40, 0, 0);
+  for (auto const &link : links)
+    link->SetLinearVel(vel);
+
+  world->Step(100);
+
+  // The sphere without continuous collision tunnels through its wall
+  EXPECT_GT(links[0]->WorldPose().Pos().X(), 1.0);
+  EXPECT_LT(links[1]->WorldPose().Pos().X(), 1.0);
+  EXPECT_EQ(0u, physics->SpeculativeContactCount());
+
+  // Speculative contacts hold the sphere while it approaches the wall
+  links[1]->SetWorldPose(ignition::math::Pose3d(0.01, 2, 1, 0, 0, 0));
+  links[1]->SetLinearVel(vel);
+  bool speculative = false;
+  for (int i = 0; i < 100 && !speculative; ++i)
+  {
+    world->Step(1);
+    speculative = physics->SpeculativeContactCount() > 0;
+  }
+  EXPECT_TRUE(speculative);
+
+  links[1]->SetContinuousCollision(false);
+  world->Step(1);
+  EXPECT_EQ(0u, physics->SpeculativeContactCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ODEPhysics_TEST, StepDivisor)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr physics =
+    boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(physics != nullptr);
+
+  // Two falling spheres, and a box resting on a box
+  for (int i = 0; i < 2; ++i)
+  {
+    SpawnSphere("sphere_" + std::to_string(i),
+        ignition::math::Vector3d(0, i * 2.0, 5),
+        ignition::math::Vector3d::Zero);
+  }
+  SpawnBox("bottom", ignition::math::Vector3d(0.5, 0.5, 0.5),
+      ignition::math::Vector3d(0, 4, 0.25), ignition::math::Vector3d::Zero);
+  SpawnBox("top", ignition::math::Vector3d(0.5, 0.5, 0.5),
+      ignition::math::Vector3d(0, 4, 0.75), ignition::math::Vector3d::Zero);
+
+  ModelPtr sphere0 = world->ModelByName("sphere_0");
+  ModelPtr sphere1 = world->ModelByName("sphere_1");
+  ModelPtr top = world->ModelByName("top");
+  ASSERT_TRUE(sphere0 != nullptr);
+  ASSERT_TRUE(sphere1 != nullptr);
+  ASSERT_TRUE(top != nullptr);
+
+  EXPECT_EQ(1u, sphere1->StepDivisor());
+  EXPECT_EQ(0u, physics->SubsteppedModelCount());
+  sphere1->SetStepDivisor(4);
+  EXPECT_EQ(4u, sphere1->StepDivisor());
+  EXPECT_EQ(1u, physics->SubsteppedModelCount());
+
+  // Only the substepped sphere is integrated with substeps, and both
+  // spheres fall the same distance.
+  world->Step(100);
+  EXPECT_EQ(1u, physics->SubsteppedBodyCount());
+  EXPECT_NEAR(sphere0->WorldPose().Pos().Z(), sphere1->WorldPose().Pos().Z(),
+      1e-2);
+  EXPECT_LT(sphere1->WorldPose().Pos().Z(), 5.0);
+  EXPECT_NEAR(world->SimTime().Double(), 100 * physics->GetMaxStepSize(),
+      1e-9);
+
+  // The box under the substepped box shares its island
+  top->SetStepDivisor(2);
+  EXPECT_EQ(2u, physics->SubsteppedModelCount());
+  world->Step(100);
+  EXPECT_EQ(3u, physics->SubsteppedBodyCount());
+  EXPECT_NEAR(0.75, top->WorldPose().Pos().Z(), 1e-2);
+
+  sphere1->SetStepDivisor(1);
+  top->SetStepDivisor(0);
+  EXPECT_EQ(1u, top->StepDivisor());
+  EXPECT_EQ(0u, physics->SubsteppedModelCount());
+  world->Step(1);
+  EXPECT_EQ(0u, physics->SubsteppedBodyCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ODEPhysics_TEST, SolverStatistics)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr physics =
+    boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(physics != nullptr);
+
+  // Two boxes apart resting on the ground are islands of their own
+  SpawnBox("box_0", ignition::math::Vector3d(0.5, 0.5, 0.5),
+      ignition::math::Vector3d(0, 0, 0.25), ignition::math::Vector3d::Zero);
+  SpawnBox("box_1", ignition::math::Vector3d(0.5, 0.5, 0.5),
+      ignition::math::Vector3d(2, 0, 0.25), ignition::math::Vector3d::Zero);
+
+  msgs::SolverStatistics msg;
+  EXPECT_TRUE(physics->FillSolverStatistics(msg));
+  world->Step(100);
+  EXPECT_TRUE(physics->FillSolverStatistics(msg));
+  EXPECT_EQ("ode", msg.engine());
+  EXPECT_EQ(100u, msg.steps());
+  EXPECT_EQ(200u, msg.island_solves());
+  EXPECT_EQ(1, msg.max_island_bodies());
+  ASSERT_EQ(2, msg.island_size());
+  for (int i = 0; i < msg.island_size(); ++i)
+  {
+    EXPECT_EQ(1, msg.island(i).bodies());
+    EXPECT_GT(msg.island(i).contacts(), 0);
+    EXPECT_GT(msg.island(i).rows(), 0);
+    EXPECT_LE(msg.island(i).iterations(), msg.iteration_limit());
+  }
+
+  // Without a tolerance, every solve does every iteration
+  EXPECT_EQ(msg.island_solves(), msg.saturated_solves());
+  EXPECT_EQ(msg.iteration_limit(), msg.max_iterations());
+
+  // With one, the solves of the resting boxes stop early
+  EXPECT_TRUE(physics->SetParam("sor_lcp_tolerance", 1e-3));
+  world->Step(100);
+  EXPECT_TRUE(physics->FillSolverStatistics(msg));
+  EXPECT_DOUBLE_EQ(1e-3, msg.tolerance());
+  EXPECT_LT(msg.saturated_solves(), msg.island_solves());
+  EXPECT_LT(msg.mean_iterations(), msg.iteration_limit());
+  for (int i = 0; i < 2; ++i)
+  {
+    ModelPtr model = world->ModelByName("box_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+    EXPECT_NEAR(0.25, model->WorldPose().Pos().Z(), 1e-2);
+  }
+
+  // Nothing was stepped since the last call
+  EXPECT_TRUE(physics->FillSolverStatistics(msg));
+  EXPECT_EQ(0u, msg.steps());
+  EXPECT_EQ(0, msg.island_size());
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/simbody/SimbodyHingeJoint.hh"
+#include "gazebo/physics/simbody/SimbodyPhysics.hh"
+#include "gazebo/physics/simbody/SimbodySliderJoint.hh"
+#include "gazebo/physics/simbody/SimbodyJointBatch.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+SimbodyJointBatch::SimbodyJointBatch(const Joint_V &_joints,
+    SimbodyPhysics *_physics)
+  : JointBatch(_joints), physics(_physics)
+{
+  this->mobilizers.resize(this->axisJoints.size(), nullptr);
+  for (size_t i = 0; i < this->axisJoints.size(); ++i)
+  {
+    Joint *joint = this->axisJoints[i];
+
+    // Static models report their stored position
+    LinkPtr child = joint->GetChild();
+    if (child && child->GetModel() && child->GetModel()->IsStatic())
+      continue;
+
+    // Only the joints whose axes map one to one to the mobilizer
+    // coordinates are read straight from the state
+    if (dynamic_cast<SimbodyHingeJoint *>(joint) ||
+        dynamic_cast<SimbodySliderJoint *>(joint))
+    {
+      this->mobilizers[i] = dynamic_cast<SimbodyJoint *>(joint);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+SimbodyJointBatch::~SimbodyJointBatch()
+{
+}
+
+/////////////////////////////////////////////////
+void SimbodyJointBatch::Positions(std::vector<double> &_positions) const
+{
+  if (!this->physics->simbodyPhysicsInitialized)
+  {
+    JointBatch::Positions(_positions);
+    return;
+  }
+
+  const SimTK::State &state = this->physics->integ->getState();
+  _positions.resize(this->axisJoints.size());
+  for (size_t i = 0; i < this->axisJoints.size(); ++i)
+  {
+    SimbodyJoint *joint = this->mobilizers[i];
+    if (joint && joint->physicsInitialized && !joint->mobod.isEmptyHandle())
+    {
+      _positions[i] = joint->mobod.getOneQ(state,
+          SimTK::MobilizerQIndex(this->axisIndices[i]));
+    }
+    else
+    {
+      _positions[i] = this->axisJoints[i]->Position(this->axisIndices[i]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void SimbodyJointBatch::Velocities(std::vector<double> &_velocities) const
+{
+  if (!this->physics->simbodyPhysicsInitialized)
+  {
+    JointBatch::Velocities(_velocities);
+    return;
+  }
+
+  const SimTK::State &state = this->physics->integ->getState();
+  _velocities.resize(this->axisJoints.size());
+  for (size_t i = 0; i < this->axisJoints.size(); ++i)
+  {
+    SimbodyJoint *joint = this->mobilizers[i];
+    if (joint && joint->physicsInitialized && !joint->mobod.isEmptyHandle())
+    {
+      _velocities[i] = joint->mobod.getOneU(state,
+          SimTK::MobilizerUIndex(this->axisIndices[i]));
+    }
+    else
+    {
+      _velocities[i] =
+          this->axisJoints[i]->GetVelocity(this->axisIndices[i]);
+    }
+  }
+}
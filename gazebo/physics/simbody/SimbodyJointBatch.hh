@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_SIMBODY_SIMBODYJOINTBATCH_HH_
+#define GAZEBO_PHYSICS_SIMBODY_SIMBODYJOINTBATCH_HH_
+
+#include <vector>
+
+#include "gazebo/physics/JointBatch.hh"
+#include "gazebo/physics/simbody/SimbodyTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    class SimbodyJoint;
+
+    /// \addtogroup gazebo_physics_simbody
+    /// \{
+
+    /// \class SimbodyJointBatch SimbodyJointBatch.hh physics/physics.hh
+    /// \brief Joint batch that reads the positions and velocities of hinge
+    /// and slider joints from the Simbody state, which is fetched once per
+    /// call. The other joints are read through the generic batch.
+    class GZ_PHYSICS_VISIBLE SimbodyJointBatch : public JointBatch
+    {
+      /// \brief Constructor.
+      /// \param[in] _joints Joints of the batch.
+      /// \param[in] _physics Simbody physics engine of the joints.
+      public: SimbodyJointBatch(const Joint_V &_joints,
+                  SimbodyPhysics *_physics);
+
+      /// \brief Destructor.
+      public: virtual ~SimbodyJointBatch();
+
+      // Documentation inherited
+      public: virtual void Positions(std::vector<double> &_positions) const;
+
+      // Documentation inherited
+      public: virtual void Velocities(std::vector<double> &_velocities) const;
+
+      /// \brief Physics engine of the joints.
+      private: SimbodyPhysics *physics;
+
+      /// \brief Simbody joint of each axis read from the state, nullptr
+      /// for the axes read through the generic batch.
+      private: std::vector<SimbodyJoint *> mobilizers;
+    };
+    /// \}
+  }
+}
+#endif
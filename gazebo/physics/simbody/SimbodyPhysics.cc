@@ -17,12 +17,12 @@
 
 #include <string>
 
-#include <ignition/common/Profiler.hh>
-
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/simbody/SimbodyTypes.hh"
 #include "gazebo/physics/simbody/SimbodyModel.hh"
 #include "gazebo/physics/simbody/SimbodyLink.hh"
 #include "gazebo/physics/simbody/SimbodyJoint.hh"
+#include "gazebo/physics/simbody/SimbodyJointBatch.hh"
 #include "gazebo/physics/simbody/SimbodyCollision.hh"
 
 #include "gazebo/physics/simbody/SimbodyPlaneShape.hh"
@@ -150,6 +150,13 @@ void SimbodyPhysics::Load(sdf::ElementPtr _sdf)
   this->contact.setTransitionVelocity(
     simbodyElem->Get<double>("max_transient_velocity"));
 
+  // Not part of sdformat yet, so only read when present.
+  if (simbodyElem->HasElement("parallel_force_threads"))
+  {
+    this->SetParallelForceThreads(
+        simbodyElem->Get<int>("parallel_force_threads"));
+  }
+
   sdf::ElementPtr simbodyContactElem = simbodyElem->GetElement("contact");
 
   // system wide contact properties, assigned in AddCollisionsToLink()
@@ -403,6 +410,50 @@ void SimbodyPhysics::InitModel(const physics::ModelPtr _model)
   this->simbodyPhysicsInitialized = true;
 }
 
+//////////////////////////////////////////////////
+bool SimbodyPhysics::SetParallelForceThreads(const int _threads)
+{
+  if (_threads < 1)
+  {
+    gzerr << "parallel_force_threads must be at least 1\n";
+    return false;
+  }
+
+#ifdef LIBSIMBODY_VERSION_GT_35
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  this->forces.setNumberOfThreads(_threads);
+  this->parallelForceThreads = _threads;
+
+  // The thread count is part of the topology of the force subsystem, so a
+  // built system needs a new state. The bodies are the same, so the
+  // generalized coordinates carry over.
+  if (this->integ &&
+      this->integ->getState().getSystemStage() != SimTK::Stage::Empty)
+  {
+    SimTK::State previous = this->integ->getState();
+    this->system.realizeTopology();
+    SimTK::State state = this->system.getDefaultState();
+    state.setTime(previous.getTime());
+    state.updQ() = previous.getQ();
+    state.updU() = previous.getU();
+    this->integ->initialize(state);
+
+    // restore potentially user run-time modified gravity
+    this->SetGravity(this->world->Gravity());
+  }
+  return true;
+#else
+  if (_threads > 1)
+  {
+    gzwarn << "This version of Simbody cannot evaluate forces in parallel, "
+           << "using 1 thread.\n";
+    return false;
+  }
+  return true;
+#endif
+}
+
 //////////////////////////////////////////////////
 void SimbodyPhysics::InitForThread()
 {
@@ -522,20 +573,17 @@ void SimbodyPhysics::UpdateCollision()
               const SimTK::ContactDetail &detail = patch.getContactDetail(i);
               // get contact information from simbody and
               // add them to contactFeedback.
-              // Store the contact depth
-              contactFeedback->depths[count] = detail.getDeformation();
-
-              // Store the contact position
-              contactFeedback->positions[count].Set(
-                detail.getContactPoint()[0],
-                detail.getContactPoint()[1],
-                detail.getContactPoint()[2]);
-
-              // Store the contact normal
-              contactFeedback->normals[count].Set(
-                detail.getContactNormal()[0],
-                detail.getContactNormal()[1],
-                detail.getContactNormal()[2]);
+              // Store the contact position, normal and depth
+              const int index = contactFeedback->AddPoint(
+                  ignition::math::Vector3d(
+                    detail.getContactPoint()[0],
+                    detail.getContactPoint()[1],
+                    detail.getContactPoint()[2]),
+                  ignition::math::Vector3d(
+                    detail.getContactNormal()[0],
+                    detail.getContactNormal()[1],
+                    detail.getContactNormal()[2]),
+                  detail.getDeformation());
 
               // Store the contact forces
               const SimTK::Vec3 f2 = detail.getForceOnSurface2();
@@ -594,18 +642,17 @@ void SimbodyPhysics::UpdateCollision()
               // gzerr << "t1cg: " << t1cg << "\n";
 
               // copy.
-              contactFeedback->wrench[count].body1Force.Set(
+              contactFeedback->wrench[index].body1Force.Set(
                 f1cg[0], f1cg[1], f1cg[2]);
-              contactFeedback->wrench[count].body2Force.Set(
+              contactFeedback->wrench[index].body2Force.Set(
                 f2cg[0], f2cg[1], f2cg[2]);
-              contactFeedback->wrench[count].body1Torque.Set(
+              contactFeedback->wrench[index].body1Torque.Set(
                 t1cg[0], t1cg[1], t1cg[2]);
-              contactFeedback->wrench[count].body2Torque.Set(
+              contactFeedback->wrench[index].body2Torque.Set(
                 t2cg[0], t2cg[1], t2cg[2]);
 
-              // Increase the counters
+              // Increase the counter
               ++count;
-              contactFeedback->count = count;
             }
           }
         }
@@ -697,7 +744,7 @@ void SimbodyPhysics::UpdatePhysics()
       auto pose = SimbodyPhysics::Transform2PoseIgn(
         simbodyLink->masterMobod.getBodyTransform(s));
       simbodyLink->SetDirtyPose(pose);
-      this->world->dataPtr->dirtyPoses.push_back(
+      this->world->_AddDirty(
         boost::static_pointer_cast<Entity>(*lx).get());
     }
 
@@ -808,6 +855,12 @@ JointPtr SimbodyPhysics::CreateJoint(const std::string &_type,
   return joint;
 }
 
+//////////////////////////////////////////////////
+JointBatchPtr SimbodyPhysics::CreateJointBatch(const Joint_V &_joints)
+{
+  return JointBatchPtr(new SimbodyJointBatch(_joints, this));
+}
+
 //////////////////////////////////////////////////
 void SimbodyPhysics::SetGravity(const ignition::math::Vector3d &_gravity)
 {
@@ -1652,6 +1705,10 @@ bool SimbodyPhysics::GetParam(const std::string &_key, boost::any &_value) const
   {
     _value = this->contact.getTransitionVelocity();
   }
+  else if (_key == "parallel_force_threads")
+  {
+    _value = this->parallelForceThreads;
+  }
   else
   {
     return PhysicsEngine::GetParam(_key, _value);
@@ -1672,6 +1729,10 @@ bool SimbodyPhysics::SetParam(const std::string &_key, const boost::any &_value)
     {
       this->contact.setTransitionVelocity(any_cast<double>(_value));
     }
+    else if (_key == "parallel_force_threads")
+    {
+      return this->SetParallelForceThreads(any_cast<int>(_value));
+    }
     else if (_key == "stiffness")
     {
       this->contactMaterialStiffness = any_cast<double>(_value);
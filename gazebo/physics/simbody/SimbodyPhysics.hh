@@ -86,6 +86,9 @@ namespace gazebo
       public: virtual JointPtr CreateJoint(const std::string &_type,
                                            ModelPtr _parent);
 
+      // Documentation inherited
+      public: virtual JointBatchPtr CreateJointBatch(const Joint_V &_joints);
+
       // Documentation inherited
       public: virtual ShapePtr CreateShape(const std::string &_shapeType,
                                            CollisionPtr _collision);
@@ -203,6 +206,17 @@ namespace gazebo
         const SimTK::MultibodyGraphMaker &_mbgraph,
         const physics::ModelPtr _model);
 
+      /// \brief Set the number of threads that evaluate the force elements
+      /// of the GeneralForceSubsystem. Simbody runs the elements that allow
+      /// it, such as custom forces added by plugins, in parallel and sums
+      /// their forces; the compliant contact subsystem is realized serially
+      /// by Simbody. A system that is already built is realized again,
+      /// keeping its time, positions, velocities and gravity.
+      /// \param[in] _threads Number of threads, 1 for serial evaluation.
+      /// \return False if _threads is not positive, or if Simbody cannot
+      /// evaluate forces in parallel.
+      private: bool SetParallelForceThreads(const int _threads);
+
       /// \brief helper function for building SimbodySystem
       private: void AddCollisionsToLink(const physics::SimbodyLink *_link,
         SimTK::MobilizedBody &_mobod, SimTK::ContactCliqueId _modelClique);
@@ -282,6 +296,9 @@ namespace gazebo
       ///   SimTK::RungeKutta2Integrator(system)
       ///   SimTK::SemiExplicitEuler2Integrator(system)
       private: std::string integratorType;
+
+      /// \brief Number of threads evaluating the force elements.
+      private: int parallelForceThreads = 1;
     };
   /// \}
   }
@@ -15,11 +15,11 @@
  *
 */
 
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Color.hh>
 #include <ignition/math/Matrix4.hh>
 
 #include "gazebo/common/MeshManager.hh"
+#include "gazebo/common/TraceCapture.hh"
 
 #include "gazebo/rendering/Material.hh"
 #include "gazebo/rendering/MovableText.hh"
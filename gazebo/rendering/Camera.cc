@@ -15,13 +15,31 @@
  *
 */
 
+#if defined(HAVE_OPENGL) && !defined(_WIN32)
+
+// Pixel buffer objects are core in OpenGL 2.1, but their prototypes are
+// only declared on request.
+#define GL_GLEXT_PROTOTYPES
+#if defined(__APPLE__)
+#include <OpenGL/gl.h>
+#include <OpenGL/glext.h>
+#else
+#include <GL/gl.h>
+#include <GL/glext.h>
+#endif /* __APPLE__ */
+
+#define GAZEBO_CAMERA_PIXEL_BUFFERS
+
+#endif /* HAVE_OPENGL && !_WIN32 */
+
 #include <sstream>
+#include <unordered_set>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Matrix4.hh>
@@ -37,12 +55,14 @@
   #include "gazebo/common/win_dirent.h"
 #endif
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/rendering/skyx/include/SkyX.h"
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/PixelConversions.hh"
 #include "gazebo/common/VideoEncoder.hh"
 
 #include "gazebo/rendering/ogre_gazebo.h"
@@ -54,6 +74,7 @@
 #include "gazebo/rendering/Distortion.hh"
 #include "gazebo/rendering/CameraPrivate.hh"
 #include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/CameraAtlas.hh"
 #include "gazebo/rendering/RenderEvents.hh"
 
 using namespace gazebo;
@@ -78,6 +99,8 @@ Camera::Camera(const std::string &_name, ScenePtr _scene,
   this->scene = _scene;
 
   this->newData = false;
+  this->newImageFrame.SetName("newImageFrame");
+  this->dataPtr->newImageFrameHandle.SetName("newImageFrameHandle");
 
   this->textureWidth = this->textureHeight = 0;
 
@@ -171,6 +194,28 @@ void Camera::Load()
       gzerr << "Error making directory\n";
   }
 
+  if (this->sdf->HasElement("async_readback"))
+    this->dataPtr->asyncReadback = this->sdf->Get<bool>("async_readback");
+
+  if (this->sdf->HasElement("atlas"))
+    this->dataPtr->atlasEnabled = this->sdf->Get<bool>("atlas");
+
+  if (this->sdf->HasElement("shadows"))
+  {
+    const std::string shadows = this->sdf->Get<std::string>("shadows");
+    if (shadows == "off")
+      this->dataPtr->shadowQuality = SHADOW_OFF;
+    else if (shadows == "static")
+      this->dataPtr->shadowQuality = SHADOW_STATIC;
+    else if (shadows == "full")
+      this->dataPtr->shadowQuality = SHADOW_FULL;
+    else
+    {
+      gzerr << "Unknown shadow quality [" << shadows << "], expected off, "
+            << "static or full" << std::endl;
+    }
+  }
+
   if (this->sdf->HasElement("horizontal_fov"))
   {
     sdf::ElementPtr elem = this->sdf->GetElement("horizontal_fov");
@@ -390,10 +435,14 @@ void Camera::Fini()
   if (this->saveFrameBuffer)
     delete [] this->saveFrameBuffer;
   this->saveFrameBuffer = NULL;
+  this->dataPtr->frameBufferMemory.Clear();
+
+  this->ReleasePixelBuffers();
 
   if (this->bayerFrameBuffer)
     delete [] this->bayerFrameBuffer;
   this->bayerFrameBuffer = NULL;
+  this->dataPtr->bayerBufferMemory.Clear();
 
   this->initialized = false;
 
@@ -408,7 +457,13 @@ void Camera::Fini()
   if (this->viewport && this->scene)
     RTShaderSystem::DetachViewport(this->viewport, this->scene);
 
-  if (this->renderTarget)
+  if (this->dataPtr->atlas)
+  {
+    this->dataPtr->atlas->ReleaseTile(this->dataPtr->atlasTile);
+    this->dataPtr->atlas.reset();
+    this->dataPtr->atlasTile = -1;
+  }
+  else if (this->renderTarget)
     this->renderTarget->removeAllViewports();
   this->renderTarget = NULL;
 
@@ -418,6 +473,7 @@ void Camera::Fini()
 
   if (this->camera)
   {
+    this->scene->SetStaticShadowsOnly(this->camera, false);
     this->scene->OgreSceneManager()->destroyCamera(this->scopedUniqueName);
     this->camera = NULL;
   }
@@ -597,6 +653,56 @@ void Camera::Render(const bool _force)
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Counts the objects a camera queues for rendering, that is the
+/// objects that passed culling.
+class VisibleObjectCounter : public Ogre::RenderQueue::RenderableListener
+{
+  /// \brief Constructor.
+  /// \param[in] _manager Scene manager that renders.
+  /// \param[in] _camera Camera whose objects are counted.
+  public: VisibleObjectCounter(Ogre::SceneManager *_manager,
+              Ogre::Camera *_camera)
+    : manager(_manager), camera(_camera)
+  {
+    this->manager->getRenderQueue()->setRenderableListener(this);
+  }
+
+  /// \brief Destructor.
+  public: virtual ~VisibleObjectCounter()
+  {
+    this->manager->getRenderQueue()->setRenderableListener(nullptr);
+  }
+
+  // Documentation inherited
+  public: virtual bool renderableQueued(Ogre::Renderable *_rend,
+              Ogre::uint8 /*_groupID*/, Ogre::ushort /*_priority*/,
+              Ogre::Technique ** /*_ppTech*/, Ogre::RenderQueue * /*_queue*/)
+  {
+    // Skip the shadow textures and the other cameras of the target
+    Ogre::Viewport *viewport = this->manager->getCurrentViewport();
+    if (!viewport || viewport->getCamera() != this->camera)
+      return true;
+
+    // Sub entities of one entity are one object
+    Ogre::SubEntity *subEntity = dynamic_cast<Ogre::SubEntity *>(_rend);
+    if (subEntity)
+      this->objects.insert(subEntity->getParent());
+    else
+      this->objects.insert(_rend);
+    return true;
+  }
+
+  /// \brief Scene manager that renders.
+  public: Ogre::SceneManager *manager;
+
+  /// \brief Camera whose objects are counted.
+  public: Ogre::Camera *camera;
+
+  /// \brief Visible objects.
+  public: std::unordered_set<const void *> objects;
+};
+
 //////////////////////////////////////////////////
 void Camera::RenderImpl()
 {
@@ -608,7 +714,27 @@ void Camera::RenderImpl()
     }
     {
       IGN_PROFILE("rendering::Camera::RenderImpl update");
-      this->renderTarget->update();
+      // Cameras in an atlas are rendered in one batch when the first of
+      // them reads its image.
+      if (this->dataPtr->atlas)
+      {
+        this->dataPtr->atlas->RequestRender(this->dataPtr->atlasTile);
+      }
+      else if (this->dataPtr->renderStats)
+      {
+        common::Time start = common::Time::GetWallTime();
+        {
+          VisibleObjectCounter counter(this->scene->OgreSceneManager(),
+              this->camera);
+          this->renderTarget->update();
+          this->dataPtr->visibleObjects = counter.objects.size();
+        }
+        this->dataPtr->renderDuration = common::Time::GetWallTime() - start;
+      }
+      else
+      {
+        this->renderTarget->update();
+      }
     }
     {
       IGN_PROFILE("rendering::Camera::RenderImpl post-render");
@@ -633,9 +759,22 @@ void Camera::ReadPixelBuffer()
 
     // Allocate buffer
     if (!this->saveFrameBuffer)
+    {
       this->saveFrameBuffer = new unsigned char[size];
+      memset(this->saveFrameBuffer, 128, size);
+      this->dataPtr->frameBufferMemory.Set(size, 1);
+    }
 
-    memset(this->saveFrameBuffer, 128, size);
+    if (this->dataPtr->atlas)
+    {
+      this->dataPtr->atlas->ReadTile(this->dataPtr->atlasTile,
+          this->saveFrameBuffer);
+      this->dataPtr->readbackReady = true;
+      return;
+    }
+
+    if (this->dataPtr->asyncReadback && this->ReadPixelBufferAsync())
+      return;
 
     Ogre::PixelBox box(width, height, 1,
         static_cast<Ogre::PixelFormat>(this->imageFormat),
@@ -663,7 +802,7 @@ void Camera::ReadPixelBuffer()
       // Setup the viewport to use the texture
       Ogre::Viewport *vp = rtt->addViewport(this->camera);
       vp->setClearEveryFrame(true);
-      vp->setShadowsEnabled(true);
+      vp->setShadowsEnabled(this->dataPtr->shadowQuality != SHADOW_OFF);
       vp->setOverlaysEnabled(false);
     }
 
@@ -684,7 +823,166 @@ void Camera::ReadPixelBuffer()
     // pixels from buffer into memory.
     this->viewport->getTarget()->copyContentsToMemory(box);
 #endif
+    this->dataPtr->readbackReady = true;
+  }
+}
+
+//////////////////////////////////////////////////
+bool Camera::ReadPixelBufferAsync()
+{
+#ifdef GAZEBO_CAMERA_PIXEL_BUFFERS
+  // The texture is only up to date if it is the render target.
+  if (!this->renderTexture ||
+      this->renderTexture->getBuffer()->getRenderTarget() != this->renderTarget)
+  {
+    return false;
+  }
+
+  GLenum format;
+  GLenum type;
+  switch (this->imageFormat)
+  {
+    case Ogre::PF_L8:
+      format = GL_LUMINANCE;
+      type = GL_UNSIGNED_BYTE;
+      break;
+    case Ogre::PF_L16:
+      format = GL_LUMINANCE;
+      type = GL_UNSIGNED_SHORT;
+      break;
+    case Ogre::PF_BYTE_RGB:
+      format = GL_RGB;
+      type = GL_UNSIGNED_BYTE;
+      break;
+    case Ogre::PF_BYTE_BGR:
+      format = GL_BGR;
+      type = GL_UNSIGNED_BYTE;
+      break;
+    case Ogre::PF_FLOAT32_R:
+      format = GL_RED;
+      type = GL_FLOAT;
+      break;
+    case Ogre::PF_SHORT_RGB:
+      format = GL_RGB;
+      type = GL_UNSIGNED_SHORT;
+      break;
+    default:
+      return false;
   }
+
+  // This fails if OpenGL is not the rendering backend.
+  GLuint texId = 0;
+  this->renderTexture->getCustomAttribute("GLID", &texId);
+  if (texId == 0)
+    return false;
+
+  size_t size = Ogre::PixelUtil::getMemorySize(this->ImageWidth(),
+      this->ImageHeight(), 1,
+      static_cast<Ogre::PixelFormat>(this->imageFormat));
+
+  // Create the ring again when the image size changes. A pending frame of
+  // the old size is dropped.
+  if (size != this->dataPtr->pixelBufferSize)
+  {
+    this->ReleasePixelBuffers();
+
+    glGenBuffers(2, this->dataPtr->pixelBuffers);
+    for (auto pbo : this->dataPtr->pixelBuffers)
+    {
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+      glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    this->dataPtr->pixelBufferSize = size;
+
+    if (this->saveFrameBuffer)
+      delete [] this->saveFrameBuffer;
+    this->saveFrameBuffer = new unsigned char[size];
+    memset(this->saveFrameBuffer, 128, size);
+    this->dataPtr->frameBufferMemory.Set(size, 1);
+  }
+
+  GLint packAlignment;
+  glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+  // Queue the copy of the current frame. glGetTexImage returns immediately
+  // because a pack buffer is bound.
+  unsigned int &index = this->dataPtr->pixelBufferIndex;
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, this->dataPtr->pixelBuffers[index]);
+  glBindTexture(GL_TEXTURE_2D, texId);
+  glGetTexImage(GL_TEXTURE_2D, 0, format, type, nullptr);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  // The previous frame had a whole frame to complete, so mapping its
+  // buffer rarely waits.
+  index = 1u - index;
+  if (this->dataPtr->pixelBufferPending)
+  {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, this->dataPtr->pixelBuffers[index]);
+    const void *data = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    if (data)
+    {
+      memcpy(this->saveFrameBuffer, data, size);
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+      this->dataPtr->readbackReady = true;
+    }
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+
+  this->dataPtr->pixelBufferPending = true;
+  return true;
+#else
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////
+void Camera::ReleasePixelBuffers()
+{
+#ifdef GAZEBO_CAMERA_PIXEL_BUFFERS
+  if (this->dataPtr->pixelBuffers[0] != 0u)
+    glDeleteBuffers(2, this->dataPtr->pixelBuffers);
+#endif
+  this->dataPtr->pixelBuffers[0] = 0u;
+  this->dataPtr->pixelBuffers[1] = 0u;
+  this->dataPtr->pixelBufferSize = 0u;
+  this->dataPtr->pixelBufferIndex = 0u;
+  this->dataPtr->pixelBufferPending = false;
+  this->dataPtr->readbackReady = false;
+}
+
+//////////////////////////////////////////////////
+void Camera::SetAsyncReadback(const bool _enable)
+{
+  if (!_enable)
+    this->ReleasePixelBuffers();
+  this->dataPtr->asyncReadback = _enable;
+}
+
+//////////////////////////////////////////////////
+bool Camera::AsyncReadback() const
+{
+  return this->dataPtr->asyncReadback;
+}
+
+//////////////////////////////////////////////////
+void Camera::SetAtlasEnabled(const bool _enable)
+{
+  this->dataPtr->atlasEnabled = _enable;
+}
+
+//////////////////////////////////////////////////
+bool Camera::AtlasEnabled() const
+{
+  return this->dataPtr->atlasEnabled;
+}
+
+//////////////////////////////////////////////////
+CameraAtlasPtr Camera::Atlas() const
+{
+  return this->dataPtr->atlas;
 }
 
 //////////////////////////////////////////////////
@@ -704,8 +1002,8 @@ void Camera::PostRender()
   if (this->newData)
     this->lastRenderWallTime = common::Time::GetWallTime();
 
-  if (this->newData && (this->captureData || this->captureDataOnce ||
-      this->dataPtr->videoEncoder.IsEncoding()))
+  if (this->dataPtr->readbackReady && (this->captureData ||
+      this->captureDataOnce || this->dataPtr->videoEncoder.IsEncoding()))
   {
     unsigned int width = this->ImageWidth();
     unsigned int height = this->ImageHeight();
@@ -734,7 +1032,10 @@ void Camera::PostRender()
          (this->ImageFormat() == "BAYER_GRBG8"))
     {
       if (!this->bayerFrameBuffer)
+      {
         this->bayerFrameBuffer = new unsigned char[width * height];
+        this->dataPtr->bayerBufferMemory.Set(width * height, 1);
+      }
 
       this->ConvertRGBToBAYER(this->bayerFrameBuffer,
           this->saveFrameBuffer, this->ImageFormat(),
@@ -745,8 +1046,19 @@ void Camera::PostRender()
 
     this->newImageFrame(buffer, width, height, this->ImageDepth(),
                     this->ImageFormat());
+
+    if (this->dataPtr->newImageFrameHandle.ConnectionCount() > 0u)
+    {
+      const size_t size = buffer == this->bayerFrameBuffer ?
+          width * height : Ogre::PixelUtil::getMemorySize(width, height, 1,
+          static_cast<Ogre::PixelFormat>(this->imageFormat));
+      this->dataPtr->newImageFrameHandle(this->dataPtr->framePool.Fill(
+          buffer, size, width, height, this->ImageDepth(),
+          this->ImageFormat()));
+    }
   }
 
+  this->dataPtr->readbackReady = false;
   this->newData = false;
 }
 
@@ -993,12 +1305,16 @@ std::string Camera::ImageFormat() const
 //////////////////////////////////////////////////
 unsigned int Camera::TextureWidth() const
 {
+  if (this->dataPtr->atlas)
+    return this->ImageWidth();
   return this->renderTexture->getBuffer(0, 0)->getWidth();
 }
 
 //////////////////////////////////////////////////
 unsigned int Camera::TextureHeight() const
 {
+  if (this->dataPtr->atlas)
+    return this->ImageHeight();
   return this->renderTexture->getBuffer(0, 0)->getHeight();
 }
 
@@ -1074,6 +1390,18 @@ bool Camera::CaptureData() const
   return this->captureData;
 }
 
+//////////////////////////////////////////////////
+unsigned int Camera::FrameListenerCount() const
+{
+  unsigned int count = this->newImageFrame.ConnectionCount() +
+    this->dataPtr->newImageFrameHandle.ConnectionCount();
+  if (this->captureData || this->captureDataOnce)
+    ++count;
+  if (this->dataPtr->videoEncoder.IsEncoding())
+    ++count;
+  return count;
+}
+
 //////////////////////////////////////////////////
 void Camera::SetSaveFramePathname(const std::string &_pathname)
 {
@@ -1308,9 +1636,24 @@ bool Camera::SaveFrame(const unsigned char *_image,
   imgData->format = (Ogre::PixelFormat)Camera::OgrePixelFormat(_format);
   size = Camera::ImageByteSize(_width, _height, _format);
 
+  const unsigned char *data = _image;
+#if OGRE_ENDIAN == OGRE_ENDIAN_LITTLE
+  // FreeImage stores 3 byte pixels as BGR on little endian machines, and
+  // the codec would otherwise convert the frame pixel by pixel.
+  std::vector<unsigned char> bgr;
+  if (imgData->format == Ogre::PF_BYTE_RGB)
+  {
+    bgr.resize(size);
+    common::ConvertRGBToBGR(_image, bgr.data(),
+        static_cast<size_t>(_width) * _height);
+    imgData->format = Ogre::PF_BYTE_BGR;
+    data = bgr.data();
+  }
+#endif
+
   // Wrap buffer in a chunk
   Ogre::MemoryDataStreamPtr stream(
-      new Ogre::MemoryDataStream(const_cast<unsigned char*>(_image),
+      new Ogre::MemoryDataStream(const_cast<unsigned char*>(data),
         size, false));
 
   // Get codec
@@ -1382,105 +1725,10 @@ void Camera::ConvertRGBToBAYER(unsigned char *_dst,
     const unsigned char *_src, const std::string &_format, const int _width,
     const int _height)
 {
-  if (_src)
+  if (_src && _width > 0 && _height > 0)
   {
-    // do last minute conversion if Bayer pattern is requested, go from R8G8B8
-    if (_format == "BAYER_RGGB8")
-    {
-      for (int i = 0; i < _width; i++)
-      {
-        for (int j = 0; j < _height; j++)
-        {
-          //
-          // RG
-          // GB
-          //
-          // determine position
-          if (j%2)  // even column
-            if (i%2)  // even row, red
-              _dst[i+j*_width] = _src[i*3+j*_width*3+2];
-            else  // odd row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-          else  // odd column
-            if (i%2)  // even row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-            else  // odd row, blue
-              _dst[i+j*_width] = _src[i*3+j*_width*3+0];
-        }
-      }
-    }
-    else if (_format == "BAYER_BGGR8")
-    {
-      for (int i = 0; i < _width; i++)
-      {
-        for (int j = 0; j < _height; j++)
-        {
-          //
-          // BG
-          // GR
-          //
-          // determine position
-          if (j%2)  // even column
-            if (i%2)  // even row, blue
-              _dst[i+j*_width] = _src[i*3+j*_width*3+0];
-            else  // odd row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-          else  // odd column
-            if (i%2)  // even row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-            else  // odd row, red
-              _dst[i+j*_width] = _src[i*3+j*_width*3+2];
-        }
-      }
-    }
-    else if (_format == "BAYER_GBRG8")
-    {
-      for (int i = 0; i < _width; i++)
-      {
-        for (int j = 0; j < _height; j++)
-        {
-          //
-          // GB
-          // RG
-          //
-          // determine position
-          if (j%2)  // even column
-            if (i%2)  // even row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-            else  // odd row, blue
-              _dst[i+j*_width] = _src[i*3+j*_width*3+2];
-          else  // odd column
-            if (i%2)  // even row, red
-              _dst[i+j*_width] = _src[i*3+j*_width*3+0];
-            else  // odd row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-        }
-      }
-    }
-    else if (_format == "BAYER_GRBG8")
-    {
-      for (int i = 0; i < _width; i++)
-      {
-        for (int j = 0; j < _height; j++)
-        {
-          //
-          // GR
-          // BG
-          //
-          // determine position
-          if (j%2)  // even column
-            if (i%2)  // even row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-            else  // odd row, red
-              _dst[i+j*_width] = _src[i*3+j*_width*3+0];
-          else  // odd column
-            if (i%2)  // even row, blue
-              _dst[i+j*_width] = _src[i*3+j*_width*3+2];
-            else  // odd row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-        }
-      }
-    }
+    common::ConvertRGBToBayer(_src, _dst, static_cast<unsigned int>(_width),
+        static_cast<unsigned int>(_height), _format);
   }
 }
 
@@ -1525,6 +1773,18 @@ bool Camera::ResetVideo()
   return true;
 }
 
+//////////////////////////////////////////////////
+void Camera::SetVideoHardwareEncoding(const bool _enable)
+{
+  this->dataPtr->videoEncoder.SetHardwareEncoding(_enable);
+}
+
+//////////////////////////////////////////////////
+uint64_t Camera::DroppedVideoFrameCount() const
+{
+  return this->dataPtr->videoEncoder.DroppedFrameCount();
+}
+
 //////////////////////////////////////////////////
 void Camera::CreateRenderTexture(const std::string &_textureName)
 {
@@ -1544,6 +1804,25 @@ void Camera::CreateRenderTexture(const std::string &_textureName)
   fsaa = 0;
 #endif
 
+  // Render into a tile of a texture shared with compatible cameras.
+  // Distortion and SkyX need a render target of their own.
+  if (this->dataPtr->atlasEnabled && !this->dataPtr->distortion &&
+      !this->scene->GetSkyX())
+  {
+    CameraAtlasPtr atlas = this->scene->AtlasForCamera(this->ImageWidth(),
+        this->ImageHeight(), this->imageFormat, fsaa, this->NearClip(),
+        this->FarClip());
+    int tile = atlas ? atlas->AcquireTile() : -1;
+    if (tile >= 0)
+    {
+      this->dataPtr->atlas = atlas;
+      this->dataPtr->atlasTile = tile;
+      this->SetRenderTarget(atlas->RenderTarget());
+      this->initialized = true;
+      return;
+    }
+  }
+
   // Create the render texture
   this->renderTexture = (Ogre::TextureManager::getSingleton().createManual(
       _textureName,
@@ -1577,6 +1856,7 @@ void Camera::CreateCamera()
   this->cameraNode = this->sceneNode->createChildSceneNode(
       this->scopedUniqueName + "_cameraNode");
   this->cameraNode->attachObject(this->camera);
+  this->camera->setLodBias(this->dataPtr->lodBias);
 
   if (this->sdf->HasElement("projection_type"))
     this->SetProjectionType(this->sdf->Get<std::string>("projection_type"));
@@ -1627,9 +1907,16 @@ void Camera::SetRenderTarget(Ogre::RenderTarget *_target)
   if (this->renderTarget)
   {
     // Setup the viewport to use the texture
-    this->viewport = this->renderTarget->addViewport(this->camera);
+    if (this->dataPtr->atlas &&
+        this->renderTarget == this->dataPtr->atlas->RenderTarget())
+    {
+      this->viewport = this->dataPtr->atlas->AddViewport(this->camera,
+          this->dataPtr->atlasTile);
+    }
+    else
+      this->viewport = this->renderTarget->addViewport(this->camera);
     this->viewport->setClearEveryFrame(true);
-    this->viewport->setShadowsEnabled(true);
+    this->SetShadowQuality(this->dataPtr->shadowQuality);
     this->viewport->setOverlaysEnabled(false);
 
     if (this->camera->getProjectionType() == Ogre::PT_ORTHOGRAPHIC)
@@ -2119,6 +2406,43 @@ unsigned int Camera::TriangleCount() const
 #endif
 }
 
+//////////////////////////////////////////////////
+unsigned int Camera::BatchCount() const
+{
+  if (!this->renderTarget)
+    return 0;
+
+#if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR >= 11
+  return this->renderTarget->getStatistics().batchCount;
+#else
+  return this->renderTarget->getBatchCount();
+#endif
+}
+
+//////////////////////////////////////////////////
+void Camera::SetRenderStatsEnabled(const bool _enable)
+{
+  this->dataPtr->renderStats = _enable;
+}
+
+//////////////////////////////////////////////////
+bool Camera::RenderStatsEnabled() const
+{
+  return this->dataPtr->renderStats;
+}
+
+//////////////////////////////////////////////////
+unsigned int Camera::VisibleObjectCount() const
+{
+  return this->dataPtr->visibleObjects;
+}
+
+//////////////////////////////////////////////////
+common::Time Camera::RenderDuration() const
+{
+  return this->dataPtr->renderDuration;
+}
+
 //////////////////////////////////////////////////
 bool Camera::SetProjectionType(const std::string &_type)
 {
@@ -2211,6 +2535,19 @@ event::ConnectionPtr Camera::ConnectNewImageFrame(
   return this->newImageFrame.Connect(_subscriber);
 }
 
+//////////////////////////////////////////////////
+event::ConnectionPtr Camera::ConnectNewImageFrameHandle(
+    std::function<void (FramePtr)> _subscriber)
+{
+  return this->dataPtr->newImageFrameHandle.Connect(_subscriber);
+}
+
+//////////////////////////////////////////////////
+FramePtr Camera::LatestFrame() const
+{
+  return this->dataPtr->framePool.Latest();
+}
+
 //////////////////////////////////////////////////
 VisualPtr Camera::TrackedVisual() const
 {
@@ -2277,6 +2614,42 @@ void Camera::SetTrackMaxDistance(const double _dist)
   this->dataPtr->trackMaxDistance = _dist;
 }
 
+/////////////////////////////////////////////////
+void Camera::SetLodBias(const double _bias)
+{
+  if (_bias <= 0)
+  {
+    gzerr << "LOD bias must be positive, got [" << _bias << "]\n";
+    return;
+  }
+
+  this->dataPtr->lodBias = _bias;
+  if (this->camera)
+    this->camera->setLodBias(_bias);
+}
+
+/////////////////////////////////////////////////
+double Camera::LodBias() const
+{
+  return this->dataPtr->lodBias;
+}
+
+/////////////////////////////////////////////////
+void Camera::SetShadowQuality(const ShadowQualityLevel _quality)
+{
+  this->dataPtr->shadowQuality = _quality;
+  if (this->viewport)
+    this->viewport->setShadowsEnabled(_quality != SHADOW_OFF);
+  if (this->camera && this->scene)
+    this->scene->SetStaticShadowsOnly(this->camera, _quality == SHADOW_STATIC);
+}
+
+/////////////////////////////////////////////////
+Camera::ShadowQualityLevel Camera::ShadowQuality() const
+{
+  return this->dataPtr->shadowQuality;
+}
+
 /////////////////////////////////////////////////
 bool Camera::TrackInheritYaw() const
 {
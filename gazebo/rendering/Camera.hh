@@ -17,6 +17,7 @@
 #ifndef GAZEBO_RENDERING_CAMERA_HH_
 #define GAZEBO_RENDERING_CAMERA_HH_
 
+#include <cstdint>
 #include <memory>
 #include <functional>
 
@@ -84,6 +85,18 @@ namespace gazebo
     class GZ_RENDERING_VISIBLE Camera :
       public boost::enable_shared_from_this<Camera>
     {
+      /// \brief How much of the shadows a camera renders.
+      public: enum ShadowQualityLevel
+      {
+        /// \brief No shadows.
+        SHADOW_OFF,
+        /// \brief Shadows of the static visuals only. Their shadow maps
+        /// are cached while the camera and the lights do not move.
+        SHADOW_STATIC,
+        /// \brief Shadows of all the visuals, rendered every frame.
+        SHADOW_FULL
+      };
+
       /// \brief Constructor
       /// \param[in] _namePrefix Unique prefix name for the camera.
       /// \param[in] _scene Scene that will contain the camera
@@ -417,6 +430,12 @@ namespace gazebo
       /// \return True if the camera is set to capture data.
       public: bool CaptureData() const;
 
+      /// \brief Get the number of consumers of the frames of this camera:
+      /// the connections to its frame events, plus one when frames are
+      /// saved to disk and one when a video is recorded.
+      /// \return Zero if a rendered frame would not be used.
+      public: virtual unsigned int FrameListenerCount() const;
+
       /// \brief Set the save frame pathname
       /// \param[in] _pathname Directory in which to store saved image frames
       public: void SetSaveFramePathname(const std::string &_pathname);
@@ -458,6 +477,33 @@ namespace gazebo
       /// \return The current triangle count
       public: virtual unsigned int TriangleCount() const;
 
+      /// \brief Get the number of draw calls of the last frame.
+      /// \return The current batch count.
+      public: unsigned int BatchCount() const;
+
+      /// \brief Collect the statistics of each rendered frame, see
+      /// VisibleObjectCount() and RenderDuration(). Collecting them adds a
+      /// little work to every frame.
+      /// \param[in] _enable True to collect the statistics. Disabled by
+      /// default.
+      public: void SetRenderStatsEnabled(const bool _enable);
+
+      /// \brief Get whether the frame statistics are collected.
+      /// \return True if collected.
+      public: bool RenderStatsEnabled() const;
+
+      /// \brief Get the number of objects that passed culling in the last
+      /// frame. Merged static geometry counts as one object per batch.
+      /// Cameras rendered in an atlas report no objects.
+      /// \return Number of visible objects.
+      /// \sa SetRenderStatsEnabled(const bool _enable)
+      public: unsigned int VisibleObjectCount() const;
+
+      /// \brief Get the wall clock time spent rendering the last frame.
+      /// \return Render duration.
+      /// \sa SetRenderStatsEnabled(const bool _enable)
+      public: common::Time RenderDuration() const;
+
       /// \brief Set the aspect ratio
       /// \param[in] _ratio The aspect ratio (width / height) in pixels
       public: void SetAspectRatio(float _ratio);
@@ -508,6 +554,42 @@ namespace gazebo
       /// \brief Capture data once and save to disk
       public: void SetCaptureDataOnce();
 
+      /// \brief Enable asynchronous readback of rendered frames. The frame
+      /// is copied into a pixel buffer object on the GPU and read back on
+      /// the next PostRender, so the render thread does not wait for the
+      /// GPU. Camera data and the newImageFrame event are delayed by one
+      /// frame. Falls back to a synchronous readback when OpenGL pixel
+      /// buffer objects are not available. Can also be enabled with the
+      /// <async_readback> camera SDF element.
+      /// \param[in] _enable True to enable asynchronous readback.
+      /// \sa AsyncReadback()
+      public: void SetAsyncReadback(const bool _enable);
+
+      /// \brief Get whether asynchronous readback is enabled.
+      /// \return True if asynchronous readback is enabled.
+      /// \sa SetAsyncReadback(const bool _enable)
+      public: bool AsyncReadback() const;
+
+      /// \brief Render into a tile of a texture shared with other cameras
+      /// of the same image size, format, anti-aliasing and clip distances.
+      /// All the cameras of an atlas are rendered in one pass and read back
+      /// once. Must be called before CreateRenderTexture. Cameras with
+      /// distortion or in a scene with SkyX get their own texture, and
+      /// RenderTexture() returns NULL for cameras in an atlas. Can also be
+      /// enabled with the <atlas> camera SDF element.
+      /// \param[in] _enable True to render into an atlas.
+      /// \sa AtlasEnabled()
+      public: void SetAtlasEnabled(const bool _enable);
+
+      /// \brief Get whether the camera may render into an atlas.
+      /// \return True if rendering into an atlas is enabled.
+      /// \sa SetAtlasEnabled(const bool _enable)
+      public: bool AtlasEnabled() const;
+
+      /// \brief Get the atlas the camera renders into.
+      /// \return The atlas, or NULL if the camera has its own texture.
+      public: CameraAtlasPtr Atlas() const;
+
       /// \brief Turn on video recording.
       /// \param[in] _format String that represents the video type.
       /// Supported types include: "avi", "ogv", mp4", "v4l2". If using
@@ -545,6 +627,18 @@ namespace gazebo
       /// always return true.
       public: bool ResetVideo();
 
+      /// \brief Set whether video recording tries the hardware encoders
+      /// first. Takes effect at the next StartVideo.
+      /// \param[in] _enable True to try the hardware encoders.
+      /// \sa common::VideoEncoder::SetHardwareEncoding
+      public: void SetVideoHardwareEncoding(const bool _enable);
+
+      /// \brief Get the number of video frames dropped because the encoder
+      /// fell behind, since the last StartVideo.
+      /// \return Number of frames.
+      /// \sa common::VideoEncoder::DroppedFrameCount
+      public: uint64_t DroppedVideoFrameCount() const;
+
       /// \brief Set the render target
       /// \param[in] _textureName Name of the new render texture
       public: void CreateRenderTexture(const std::string &_textureName);
@@ -623,6 +717,22 @@ namespace gazebo
           std::function<void (const unsigned char *, unsigned int, unsigned int,
           unsigned int, const std::string &)> _subscriber);
 
+      /// \brief Connect to the new image signal with shared ownership of
+      /// the frame. The frame comes from a small pool owned by the camera
+      /// and is not overwritten while the subscriber holds it, so it can be
+      /// kept or published without a copy.
+      /// \param[in] _subscriber Callback that is called when a new image is
+      /// generated
+      /// \return A pointer to the connection. This must be kept in scope.
+      public: event::ConnectionPtr ConnectNewImageFrameHandle(
+          std::function<void (FramePtr)> _subscriber);
+
+      /// \brief Get the last frame handed to the frame handle subscribers.
+      /// \return The latest frame, or nullptr if no frame handle subscriber
+      /// received a frame yet.
+      /// \sa ConnectNewImageFrameHandle
+      public: FramePtr LatestFrame() const;
+
       /// \brief Save a frame using an image buffer
       /// \param[in] _image The raw image buffer
       /// \param[in] _width Width of the image
@@ -770,6 +880,33 @@ namespace gazebo
       /// \sa TrackMaxDistance()
       public: void SetTrackMaxDistance(const double _dist);
 
+      /// \brief Set the level of detail bias of the camera. Distances to
+      /// the mesh levels of detail are divided by the bias, so a bias lower
+      /// than one switches to coarser levels closer to the camera. Sensor
+      /// cameras can use a lower bias than the user camera.
+      /// \param[in] _bias Positive bias.
+      /// \sa RenderEngine::SetMeshLod(const bool _enable)
+      public: void SetLodBias(const double _bias);
+
+      /// \brief Get the level of detail bias of the camera.
+      /// \return The bias. The default is 1.
+      /// \sa SetLodBias(const double _bias)
+      public: double LodBias() const;
+
+      /// \brief Set how much of the shadows the camera renders. The scene
+      /// renders the shadow maps again for every camera, so sensor
+      /// cameras that do not need moving shadows can use SHADOW_STATIC or
+      /// SHADOW_OFF. Can also be set with the <shadows> camera SDF
+      /// element, one of "off", "static" or "full".
+      /// \param[in] _quality Shadow quality level.
+      /// \sa Scene::SetShadowsEnabled(const bool _value)
+      public: void SetShadowQuality(const ShadowQualityLevel _quality);
+
+      /// \brief Get how much of the shadows the camera renders.
+      /// \return Shadow quality level. The default is SHADOW_FULL.
+      /// \sa SetShadowQuality(const ShadowQualityLevel _quality)
+      public: ShadowQualityLevel ShadowQuality() const;
+
       /// \brief Get whether this camera inherits the yaw rotation of the
       /// tracked model.
       /// \return True if the camera inherits the yaw rotation of the tracked
@@ -790,6 +927,16 @@ namespace gazebo
       /// \brief Read image data from pixel buffer
       protected: void ReadPixelBuffer();
 
+      /// \brief Start an asynchronous readback of the current frame and
+      /// copy the previous frame into the save frame buffer.
+      /// \return False if asynchronous readback is not available, in which
+      /// case the frame must be read synchronously.
+      private: bool ReadPixelBufferAsync();
+
+      /// \brief Release the pixel buffer objects used for asynchronous
+      /// readback.
+      private: void ReleasePixelBuffers();
+
       /// \brief Implementation of the Camera::TrackVisual call
       /// \param[in] _visualName Name of the visual to track
       /// \return True if able to track the visual
@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstring>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/TraceCapture.hh"
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/CameraAtlas.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Largest atlas texture width and height.
+static const unsigned int kMaxAtlasSize = 4096u;
+
+/// \brief Largest number of tiles along each side of the atlas.
+static const unsigned int kMaxTilesPerSide = 8u;
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \brief Private data for the CameraAtlas class
+    class CameraAtlasPrivate
+    {
+      /// \brief Width of a tile in pixels.
+      public: unsigned int width = 0u;
+
+      /// \brief Height of a tile in pixels.
+      public: unsigned int height = 0u;
+
+      /// \brief Ogre pixel format of the tiles.
+      public: int format = 0;
+
+      /// \brief Anti-aliasing level.
+      public: unsigned int fsaa = 0u;
+
+      /// \brief Near clip distance.
+      public: double nearClip = 0.0;
+
+      /// \brief Far clip distance.
+      public: double farClip = 0.0;
+
+      /// \brief Number of tile columns.
+      public: unsigned int columns = 0u;
+
+      /// \brief Number of tile rows.
+      public: unsigned int rows = 0u;
+
+      /// \brief The atlas texture.
+      public: Ogre::TexturePtr texture;
+
+      /// \brief Viewport of each tile, nullptr for free tiles.
+      public: std::vector<Ogre::Viewport *> viewports;
+
+      /// \brief True for tiles that are used by a camera.
+      public: std::vector<bool> used;
+
+      /// \brief True if a tile requested a render since the last readback.
+      public: bool renderPending = false;
+
+      /// \brief Pixels of the whole atlas from the last readback.
+      public: std::vector<unsigned char> data;
+    };
+  }
+}
+
+/// \brief Largest power of two number of tiles of a given size that fit
+/// along one side of the atlas. Powers of two keep the relative viewport
+/// coordinates exact, so tiles never lose a pixel to rounding.
+/// \param[in] _size Tile size in pixels.
+/// \return Number of tiles.
+static unsigned int TilesPerSide(const unsigned int _size)
+{
+  unsigned int count = 0u;
+  if (_size == 0u)
+    return count;
+
+  for (unsigned int n = 1u; n <= kMaxTilesPerSide && n * _size <= kMaxAtlasSize;
+       n *= 2u)
+  {
+    count = n;
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+CameraAtlas::CameraAtlas(const std::string &_name,
+    const unsigned int _width, const unsigned int _height,
+    const int _format, const unsigned int _fsaa,
+    const double _near, const double _far)
+  : dataPtr(new CameraAtlasPrivate)
+{
+  this->dataPtr->width = _width;
+  this->dataPtr->height = _height;
+  this->dataPtr->format = _format;
+  this->dataPtr->fsaa = _fsaa;
+  this->dataPtr->nearClip = _near;
+  this->dataPtr->farClip = _far;
+  this->dataPtr->columns = TilesPerSide(_width);
+  this->dataPtr->rows = TilesPerSide(_height);
+
+  if (this->TileCount() == 0u)
+  {
+    gzwarn << "Camera image of size[" << _width << "x" << _height
+           << "] is too large for a camera atlas\n";
+    return;
+  }
+
+  this->dataPtr->texture = Ogre::TextureManager::getSingleton().createManual(
+      _name,
+      "General",
+      Ogre::TEX_TYPE_2D,
+      _width * this->dataPtr->columns,
+      _height * this->dataPtr->rows,
+      0,
+      static_cast<Ogre::PixelFormat>(_format),
+      Ogre::TU_RENDERTARGET,
+      0,
+      false,
+      _fsaa);
+
+  // Tiles are only rendered on request.
+  this->RenderTarget()->setAutoUpdated(false);
+
+  this->dataPtr->viewports.resize(this->TileCount(), nullptr);
+  this->dataPtr->used.resize(this->TileCount(), false);
+}
+
+//////////////////////////////////////////////////
+CameraAtlas::~CameraAtlas()
+{
+  if (!this->dataPtr->texture.isNull())
+  {
+    this->RenderTarget()->removeAllViewports();
+    Ogre::TextureManager::getSingleton().remove(
+        this->dataPtr->texture->getName());
+  }
+}
+
+//////////////////////////////////////////////////
+bool CameraAtlas::Compatible(const unsigned int _width,
+    const unsigned int _height, const int _format, const unsigned int _fsaa,
+    const double _near, const double _far) const
+{
+  return _width == this->dataPtr->width &&
+      _height == this->dataPtr->height &&
+      _format == this->dataPtr->format &&
+      _fsaa == this->dataPtr->fsaa &&
+      ignition::math::equal(_near, this->dataPtr->nearClip) &&
+      ignition::math::equal(_far, this->dataPtr->farClip);
+}
+
+//////////////////////////////////////////////////
+unsigned int CameraAtlas::TileCount() const
+{
+  return this->dataPtr->columns * this->dataPtr->rows;
+}
+
+//////////////////////////////////////////////////
+unsigned int CameraAtlas::UsedTileCount() const
+{
+  unsigned int count = 0u;
+  for (bool used : this->dataPtr->used)
+  {
+    if (used)
+      ++count;
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+int CameraAtlas::AcquireTile()
+{
+  for (unsigned int i = 0u; i < this->dataPtr->used.size(); ++i)
+  {
+    if (!this->dataPtr->used[i])
+    {
+      this->dataPtr->used[i] = true;
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+//////////////////////////////////////////////////
+void CameraAtlas::ReleaseTile(const int _tile)
+{
+  if (_tile < 0 || static_cast<unsigned int>(_tile) >= this->TileCount())
+    return;
+
+  if (this->dataPtr->viewports[_tile])
+  {
+    this->RenderTarget()->removeViewport(_tile);
+    this->dataPtr->viewports[_tile] = nullptr;
+  }
+  this->dataPtr->used[_tile] = false;
+}
+
+//////////////////////////////////////////////////
+Ogre::Viewport *CameraAtlas::AddViewport(Ogre::Camera *_camera,
+    const int _tile)
+{
+  if (_tile < 0 || static_cast<unsigned int>(_tile) >= this->TileCount() ||
+      !this->dataPtr->used[_tile] || this->dataPtr->viewports[_tile])
+  {
+    gzerr << "Invalid camera atlas tile[" << _tile << "]\n";
+    return nullptr;
+  }
+
+  float tileWidth = 1.0f / this->dataPtr->columns;
+  float tileHeight = 1.0f / this->dataPtr->rows;
+  unsigned int column = _tile % this->dataPtr->columns;
+  unsigned int row = _tile / this->dataPtr->columns;
+
+  // The tile index doubles as the unique z order of the viewport.
+  Ogre::Viewport *viewport = this->RenderTarget()->addViewport(_camera, _tile,
+      column * tileWidth, row * tileHeight, tileWidth, tileHeight);
+  viewport->setAutoUpdated(false);
+
+  this->dataPtr->viewports[_tile] = viewport;
+  return viewport;
+}
+
+//////////////////////////////////////////////////
+Ogre::RenderTarget *CameraAtlas::RenderTarget() const
+{
+  if (this->dataPtr->texture.isNull())
+    return nullptr;
+  return this->dataPtr->texture->getBuffer()->getRenderTarget();
+}
+
+//////////////////////////////////////////////////
+void CameraAtlas::RequestRender(const int _tile)
+{
+  if (_tile < 0 || static_cast<unsigned int>(_tile) >= this->TileCount() ||
+      !this->dataPtr->viewports[_tile])
+  {
+    return;
+  }
+
+  this->dataPtr->viewports[_tile]->setAutoUpdated(true);
+  this->dataPtr->renderPending = true;
+}
+
+//////////////////////////////////////////////////
+void CameraAtlas::ReadTile(const int _tile, unsigned char *_data)
+{
+  if (_tile < 0 || static_cast<unsigned int>(_tile) >= this->TileCount())
+    return;
+
+  Ogre::PixelFormat format =
+      static_cast<Ogre::PixelFormat>(this->dataPtr->format);
+  unsigned int atlasWidth = this->dataPtr->width * this->dataPtr->columns;
+  unsigned int atlasHeight = this->dataPtr->height * this->dataPtr->rows;
+
+  if (this->dataPtr->renderPending)
+  {
+    IGN_PROFILE("rendering::CameraAtlas::ReadTile render");
+
+    // Render every requested tile in one pass over the target.
+    this->RenderTarget()->update();
+    for (auto viewport : this->dataPtr->viewports)
+    {
+      if (viewport)
+        viewport->setAutoUpdated(false);
+    }
+
+    this->dataPtr->data.resize(Ogre::PixelUtil::getMemorySize(
+        atlasWidth, atlasHeight, 1, format));
+    Ogre::PixelBox box(atlasWidth, atlasHeight, 1, format,
+        this->dataPtr->data.data());
+    this->dataPtr->texture->getBuffer()->blitToMemory(box);
+
+    this->dataPtr->renderPending = false;
+  }
+
+  if (this->dataPtr->data.empty())
+    return;
+
+  size_t pixelSize = Ogre::PixelUtil::getNumElemBytes(format);
+  size_t rowSize = this->dataPtr->width * pixelSize;
+  size_t atlasRowSize = atlasWidth * pixelSize;
+  unsigned int column = _tile % this->dataPtr->columns;
+  unsigned int row = _tile / this->dataPtr->columns;
+
+  const unsigned char *src = this->dataPtr->data.data() +
+      row * this->dataPtr->height * atlasRowSize + column * rowSize;
+  for (unsigned int y = 0u; y < this->dataPtr->height; ++y)
+  {
+    std::memcpy(_data + y * rowSize, src, rowSize);
+    src += atlasRowSize;
+  }
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_CAMERAATLAS_HH_
+#define GAZEBO_RENDERING_CAMERAATLAS_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace Ogre
+{
+  class Camera;
+  class RenderTarget;
+  class Viewport;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    class CameraAtlasPrivate;
+
+    /// \addtogroup gazebo_rendering Rendering
+    /// \{
+
+    /// \class CameraAtlas CameraAtlas.hh rendering/rendering.hh
+    /// \brief A render texture shared by cameras with the same image size,
+    /// format, anti-aliasing and clip distances.
+    ///
+    /// Every camera in the atlas renders into its own tile, which is a
+    /// viewport of the shared texture. Cameras only request a render. The
+    /// first camera that reads its image afterwards updates the texture
+    /// once for all requested tiles and reads the whole texture back once.
+    /// The other cameras copy their tile out of that readback. This removes
+    /// the per camera render target switch, flush and readback that
+    /// dominate the cost of many small cameras.
+    class GZ_RENDERING_VISIBLE CameraAtlas
+    {
+      /// \brief Constructor
+      /// \param[in] _name Name of the atlas texture.
+      /// \param[in] _width Width of a tile in pixels.
+      /// \param[in] _height Height of a tile in pixels.
+      /// \param[in] _format Ogre pixel format of the tiles.
+      /// \param[in] _fsaa Anti-aliasing level of the atlas texture.
+      /// \param[in] _near Near clip distance of the cameras.
+      /// \param[in] _far Far clip distance of the cameras.
+      public: CameraAtlas(const std::string &_name,
+                          const unsigned int _width,
+                          const unsigned int _height,
+                          const int _format,
+                          const unsigned int _fsaa,
+                          const double _near,
+                          const double _far);
+
+      /// \brief Destructor
+      public: ~CameraAtlas();
+
+      /// \brief Check if a camera with the given properties can render
+      /// into this atlas.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _format Ogre pixel format.
+      /// \param[in] _fsaa Anti-aliasing level.
+      /// \param[in] _near Near clip distance.
+      /// \param[in] _far Far clip distance.
+      /// \return True if the properties match those of the atlas.
+      public: bool Compatible(const unsigned int _width,
+                              const unsigned int _height,
+                              const int _format,
+                              const unsigned int _fsaa,
+                              const double _near,
+                              const double _far) const;
+
+      /// \brief Get the number of tiles in the atlas.
+      /// \return Number of tiles, 0 if a tile is larger than the largest
+      /// supported texture.
+      public: unsigned int TileCount() const;
+
+      /// \brief Get the number of tiles used by cameras.
+      /// \return Number of used tiles.
+      public: unsigned int UsedTileCount() const;
+
+      /// \brief Reserve a free tile.
+      /// \return Index of the tile, or -1 if the atlas is full.
+      public: int AcquireTile();
+
+      /// \brief Remove the viewport of a tile and free the tile.
+      /// \param[in] _tile Index of the tile.
+      public: void ReleaseTile(const int _tile);
+
+      /// \brief Create the viewport that renders a camera into a tile.
+      /// \param[in] _camera Ogre camera to render.
+      /// \param[in] _tile Tile returned by AcquireTile.
+      /// \return The viewport, or nullptr if the tile is invalid.
+      public: Ogre::Viewport *AddViewport(Ogre::Camera *_camera,
+                                          const int _tile);
+
+      /// \brief Get the render target of the atlas texture.
+      /// \return The render target.
+      public: Ogre::RenderTarget *RenderTarget() const;
+
+      /// \brief Mark a tile to be rendered in the next batched pass.
+      /// \param[in] _tile Index of the tile.
+      public: void RequestRender(const int _tile);
+
+      /// \brief Copy the image of a tile. Renders all requested tiles and
+      /// reads the atlas back first if a render was requested since the
+      /// last readback.
+      /// \param[in] _tile Index of the tile.
+      /// \param[out] _data Buffer of at least the tile image size.
+      public: void ReadTile(const int _tile, unsigned char *_data);
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<CameraAtlasPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/CameraAtlas.hh"
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/rendering/Scene.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class CameraAtlas_TEST : public RenderingFixture
+{
+  /// \brief Create a camera with a 64x48 image.
+  /// \param[in] _scene Scene to create the camera in.
+  /// \param[in] _name Name of the camera.
+  /// \param[in] _atlas True to render into an atlas.
+  /// \return The camera.
+  public: rendering::CameraPtr CreateCamera(rendering::ScenePtr _scene,
+              const std::string &_name, const bool _atlas)
+  {
+    rendering::CameraPtr camera = _scene->CreateCamera(_name, false);
+    std::stringstream ss;
+    ss << "<sdf version='" << SDF_VERSION << "'>"
+       << "  <camera>"
+       << "    <horizontal_fov>1.0</horizontal_fov>"
+       << "    <image>"
+       << "      <width>64</width>"
+       << "      <height>48</height>"
+       << "      <format>R8G8B8</format>"
+       << "    </image>"
+       << "    <clip>"
+       << "      <near>0.1</near><far>100</far>"
+       << "    </clip>"
+       << "  </camera>"
+       << "</sdf>";
+    sdf::ElementPtr cameraSDF(new sdf::Element);
+    sdf::initFile("camera.sdf", cameraSDF);
+    sdf::readString(ss.str(), cameraSDF);
+    camera->Load(cameraSDF);
+    camera->Init();
+    camera->SetAtlasEnabled(_atlas);
+    camera->CreateRenderTexture(_name + "_RttTex");
+    camera->SetCaptureData(true);
+    return camera;
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(CameraAtlas_TEST, Tiles)
+{
+  Load("worlds/empty.world");
+
+  rendering::CameraAtlas atlas("test_atlas", 640, 480,
+      static_cast<int>(Ogre::PF_BYTE_RGB), 0, 0.1, 100);
+
+  // 4096 / 640 and 4096 / 480 rounded down to a power of two
+  EXPECT_EQ(atlas.TileCount(), 32u);
+  EXPECT_EQ(atlas.UsedTileCount(), 0u);
+  EXPECT_TRUE(atlas.Compatible(640, 480,
+      static_cast<int>(Ogre::PF_BYTE_RGB), 0, 0.1, 100));
+  EXPECT_FALSE(atlas.Compatible(320, 240,
+      static_cast<int>(Ogre::PF_BYTE_RGB), 0, 0.1, 100));
+  EXPECT_FALSE(atlas.Compatible(640, 480,
+      static_cast<int>(Ogre::PF_BYTE_RGB), 0, 0.1, 50));
+
+  EXPECT_EQ(atlas.AcquireTile(), 0);
+  EXPECT_EQ(atlas.AcquireTile(), 1);
+  EXPECT_EQ(atlas.UsedTileCount(), 2u);
+  atlas.ReleaseTile(0);
+  EXPECT_EQ(atlas.UsedTileCount(), 1u);
+  EXPECT_EQ(atlas.AcquireTile(), 0);
+
+  rendering::CameraAtlas large("test_atlas_large", 8192, 480,
+      static_cast<int>(Ogre::PF_BYTE_RGB), 0, 0.1, 100);
+  EXPECT_EQ(large.TileCount(), 0u);
+  EXPECT_EQ(large.AcquireTile(), -1);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CameraAtlas_TEST, SharedTexture)
+{
+  Load("worlds/shapes.world");
+
+  rendering::ScenePtr scene = rendering::get_scene("default");
+  if (!scene)
+    scene = rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::CameraPtr camera = this->CreateCamera(scene, "cam", false);
+  rendering::CameraPtr camera1 = this->CreateCamera(scene, "cam1", true);
+  rendering::CameraPtr camera2 = this->CreateCamera(scene, "cam2", true);
+
+  EXPECT_TRUE(camera->Atlas() == nullptr);
+  ASSERT_TRUE(camera1->Atlas() != nullptr);
+  EXPECT_EQ(camera1->Atlas(), camera2->Atlas());
+  EXPECT_EQ(camera1->Atlas()->UsedTileCount(), 2u);
+  EXPECT_TRUE(camera1->RenderTexture() == nullptr);
+  EXPECT_EQ(camera1->TextureWidth(), 64u);
+  EXPECT_EQ(camera1->ViewportWidth(), 64u);
+  EXPECT_EQ(camera1->ViewportHeight(), 48u);
+
+  ignition::math::Pose3d pose(-5, 0, 1, 0, 0, 0);
+  camera->SetWorldPose(pose);
+  camera1->SetWorldPose(pose);
+  camera2->SetWorldPose(ignition::math::Pose3d(5, 5, 1, 0, 0, 3.14));
+
+  for (int i = 0; i < 10; ++i)
+  {
+    camera->Render(true);
+    camera1->Render(true);
+    camera2->Render(true);
+    camera->PostRender();
+    camera1->PostRender();
+    camera2->PostRender();
+  }
+
+  // A camera in an atlas sees the same image as one with its own texture.
+  unsigned int size = 64 * 48 * 3;
+  const unsigned char *data = camera->ImageData();
+  const unsigned char *data1 = camera1->ImageData();
+  const unsigned char *data2 = camera2->ImageData();
+  ASSERT_TRUE(data != nullptr);
+  ASSERT_TRUE(data1 != nullptr);
+  ASSERT_TRUE(data2 != nullptr);
+
+  unsigned int diffMax = 0;
+  unsigned int diffSum = 0;
+  double diffAvg = 0.0;
+  this->ImageCompare(const_cast<unsigned char *>(data),
+      const_cast<unsigned char *>(data1), 64, 48, 3,
+      diffMax, diffSum, diffAvg);
+  EXPECT_LE(diffSum, 10u);
+
+  // Tiles do not bleed into each other.
+  EXPECT_NE(std::memcmp(data1, data2, size), 0);
+
+  camera2->Fini();
+  EXPECT_EQ(camera1->Atlas()->UsedTileCount(), 1u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -23,9 +23,15 @@
 #include <list>
 #include <ignition/math/Pose3.hh>
 
+#include "gazebo/common/Event.hh"
+#include "gazebo/common/MemoryStats.hh"
 #include "gazebo/common/PID.hh"
+#include "gazebo/common/Time.hh"
 #include "gazebo/common/VideoEncoder.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/FramePool.hh"
+#include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/util/system.hh"
 
 namespace Ogre
@@ -109,6 +115,18 @@ namespace gazebo
       /// \brief Maximum distance between the camera and tracked model.
       public: double trackMaxDistance;
 
+      /// \brief Level of detail bias.
+      public: double lodBias = 1.0;
+
+      /// \brief True to collect the statistics of each frame.
+      public: bool renderStats = false;
+
+      /// \brief Objects that passed culling in the last frame.
+      public: unsigned int visibleObjects = 0;
+
+      /// \brief Time spent rendering the last frame.
+      public: common::Time renderDuration;
+
       /// \brief Video encoder.
       public: common::VideoEncoder videoEncoder;
 
@@ -123,6 +141,52 @@ namespace gazebo
 
       /// \brief Camera Intrinsic Matrix
       public: ignition::math::Matrix3d cameraIntrinsicMatrix;
+
+      /// \brief True to read frames back asynchronously.
+      public: bool asyncReadback = false;
+
+      /// \brief Ring of OpenGL pixel buffer objects for asynchronous
+      /// readback.
+      public: unsigned int pixelBuffers[2] = {0u, 0u};
+
+      /// \brief Size in bytes of each pixel buffer object.
+      public: size_t pixelBufferSize = 0u;
+
+      /// \brief Pixel buffer object the next frame is read into.
+      public: unsigned int pixelBufferIndex = 0u;
+
+      /// \brief True if the other pixel buffer object holds a frame that
+      /// has not been copied to the save frame buffer yet.
+      public: bool pixelBufferPending = false;
+
+      /// \brief True if ReadPixelBuffer copied a frame into the save frame
+      /// buffer that PostRender has not handed out yet.
+      public: bool readbackReady = false;
+
+      /// \brief True to render into a camera atlas when possible.
+      public: bool atlasEnabled = false;
+
+      /// \brief Atlas the camera renders into, if any.
+      public: CameraAtlasPtr atlas;
+
+      /// \brief Tile of the atlas used by the camera.
+      public: int atlasTile = -1;
+
+      /// \brief How much of the shadows the camera renders.
+      public: Camera::ShadowQualityLevel shadowQuality = Camera::SHADOW_FULL;
+
+      /// \brief Memory held by the save frame buffer.
+      public: common::MemoryCharge frameBufferMemory{"Camera/images"};
+
+      /// \brief Memory held by the Bayer frame buffer.
+      public: common::MemoryCharge bayerBufferMemory{"Camera/images"};
+
+      /// \brief Frames handed to the frame handle subscribers.
+      public: FramePool framePool;
+
+      /// \brief Event triggered with a pooled frame when a new image is
+      /// generated.
+      public: event::EventT<void(FramePtr)> newImageFrameHandle;
     };
   }
 }
@@ -17,8 +17,7 @@
 
 #include <boost/bind/bind.hpp>
 
-#include <ignition/common/Profiler.hh>
-
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/RenderEngine.hh"
 #include "gazebo/rendering/DynamicLines.hh"
@@ -281,6 +281,136 @@ TEST_F(Camera_TEST, Create)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(Camera_TEST, ShadowQuality)
+{
+  Load("worlds/shapes.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene("default");
+  if (!scene)
+    scene = gazebo::rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::CameraPtr camera = scene->CreateCamera("test_camera_shadows",
+      false);
+  ASSERT_TRUE(camera != nullptr);
+
+  std::stringstream ss;
+  ss << "<sdf version='" << SDF_VERSION << "'>"
+     << "  <camera>"
+     << "    <horizontal_fov>1.0</horizontal_fov>"
+     << "    <image>"
+     << "      <width>320</width>"
+     << "      <height>240</height>"
+     << "    </image>"
+     << "    <clip>"
+     << "      <near>0.1</near><far>100</far>"
+     << "    </clip>"
+     << "  </camera>"
+     << "</sdf>";
+  sdf::ElementPtr cameraSDF(new sdf::Element);
+  sdf::initFile("camera.sdf", cameraSDF);
+  sdf::readString(ss.str(), cameraSDF);
+  camera->Load(cameraSDF);
+  camera->Init();
+  camera->CreateRenderTexture("test_camera_shadows_RttTex");
+  camera->SetWorldPose(ignition::math::Pose3d(-5, 0, 0.5, 0, 0, 0));
+
+  // Full shadows by default, nothing is cached
+  EXPECT_EQ(rendering::Camera::SHADOW_FULL, camera->ShadowQuality());
+  scene->SetShadowsEnabled(true);
+  camera->Render(true);
+  camera->Render(true);
+  EXPECT_EQ(0u, scene->CachedShadowCount());
+
+  // The static shadow maps are reused while the camera does not move
+  camera->SetShadowQuality(rendering::Camera::SHADOW_STATIC);
+  EXPECT_EQ(rendering::Camera::SHADOW_STATIC, camera->ShadowQuality());
+  camera->Render(true);
+  uint64_t cached = scene->CachedShadowCount();
+  camera->Render(true);
+  if (scene->ShadowsEnabled())
+    EXPECT_GT(scene->CachedShadowCount(), cached);
+
+  // Moving the camera renders them again
+  cached = scene->CachedShadowCount();
+  camera->SetWorldPose(ignition::math::Pose3d(-6, 1, 1.5, 0, 0.2, 0.3));
+  camera->Render(true);
+  EXPECT_EQ(cached, scene->CachedShadowCount());
+
+  // So does discarding the cache
+  scene->InvalidateStaticShadows();
+  camera->Render(true);
+  EXPECT_EQ(cached, scene->CachedShadowCount());
+
+  // No shadow maps without shadows
+  camera->SetShadowQuality(rendering::Camera::SHADOW_OFF);
+  EXPECT_EQ(rendering::Camera::SHADOW_OFF, camera->ShadowQuality());
+  camera->Render(true);
+  camera->Render(true);
+  EXPECT_EQ(cached, scene->CachedShadowCount());
+
+  scene->RemoveCamera(camera->Name());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Camera_TEST, RenderStats)
+{
+  Load("worlds/shapes.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene("default");
+  if (!scene)
+    scene = gazebo::rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::CameraPtr camera = scene->CreateCamera("test_camera_stats",
+      false);
+  ASSERT_TRUE(camera != nullptr);
+
+  std::stringstream ss;
+  ss << "<sdf version='" << SDF_VERSION << "'>"
+     << "  <camera>"
+     << "    <horizontal_fov>1.0</horizontal_fov>"
+     << "    <image>"
+     << "      <width>320</width>"
+     << "      <height>240</height>"
+     << "    </image>"
+     << "    <clip>"
+     << "      <near>0.1</near><far>100</far>"
+     << "    </clip>"
+     << "  </camera>"
+     << "</sdf>";
+  sdf::ElementPtr cameraSDF(new sdf::Element);
+  sdf::initFile("camera.sdf", cameraSDF);
+  sdf::readString(ss.str(), cameraSDF);
+  camera->Load(cameraSDF);
+  camera->Init();
+  camera->CreateRenderTexture("test_camera_stats_RttTex");
+  camera->SetWorldPose(ignition::math::Pose3d(-5, 0, 0.5, 0, 0, 0));
+
+  // Statistics are off by default
+  EXPECT_FALSE(camera->RenderStatsEnabled());
+  camera->Render(true);
+  EXPECT_EQ(0u, camera->VisibleObjectCount());
+
+  // The camera sees the shapes and the ground plane
+  camera->SetRenderStatsEnabled(true);
+  EXPECT_TRUE(camera->RenderStatsEnabled());
+  camera->Render(true);
+  EXPECT_GE(camera->VisibleObjectCount(), 4u);
+  EXPECT_GT(camera->BatchCount(), 0u);
+  EXPECT_GT(camera->TriangleCount(), 0u);
+  EXPECT_GT(camera->RenderDuration(), common::Time::Zero);
+
+  // Looking away from the shapes, fewer objects pass culling
+  unsigned int facing = camera->VisibleObjectCount();
+  camera->SetWorldPose(ignition::math::Pose3d(-5, 0, 0.5, 0, -1.5, 0));
+  camera->Render(true);
+  EXPECT_LT(camera->VisibleObjectCount(), facing);
+
+  scene->RemoveCamera(camera->Name());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -17,11 +17,11 @@
 /* Desc: Contact Visualization Class
  * Author: Nate Koenig
  */
-#include <boost/bind/bind.hpp>
+#include <unordered_set>
 
-#include <ignition/common/Profiler.hh>
+#include <boost/bind/bind.hpp>
 
-#include "gazebo/common/MeshManager.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Subscriber.hh"
 #include "gazebo/msgs/msgs.hh"
@@ -29,6 +29,7 @@
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/Conversions.hh"
 #include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/UserCamera.hh"
 #include "gazebo/rendering/DynamicLines.hh"
 #include "gazebo/rendering/ContactVisualPrivate.hh"
 #include "gazebo/rendering/ContactVisual.hh"
@@ -36,6 +37,25 @@
 using namespace gazebo;
 using namespace rendering;
 
+/// \brief Contact messages per second received while enabled.
+static const double kContactRate = 10.0;
+
+/// \brief Size of the screen cells in which a single contact is drawn, in
+/// pixels.
+static const int kContactCellSize = 4;
+
+/////////////////////////////////////////////////
+/// \brief Subscription quality of service of the contact visual.
+/// \return Reduced rate, newest message only.
+static transport::SubscriptionQoS ContactQoS()
+{
+  transport::SubscriptionQoS qos;
+  qos.maxRate = kContactRate;
+  qos.keepLatest = true;
+  qos.queueDepth = 1;
+  return qos;
+}
+
 /////////////////////////////////////////////////
 ContactVisual::ContactVisual(const std::string &_name, VisualPtr _vis,
                              const std::string &_topicName)
@@ -53,10 +73,7 @@ ContactVisual::ContactVisual(const std::string &_name, VisualPtr _vis,
 
   dPtr->topicName = _topicName;
   dPtr->contactsSub = dPtr->node->Subscribe(dPtr->topicName,
-      &ContactVisual::OnContact, this);
-
-  common::MeshManager::Instance()->CreateSphere("contact_sphere", 0.02, 10, 10);
-  this->InsertMesh("contact_sphere");
+      &ContactVisual::OnContact, this, ContactQoS());
 
   dPtr->connections.push_back(
       event::Events::ConnectPreRender(
@@ -80,6 +97,10 @@ void ContactVisual::Update()
   if (!dPtr->contactsMsg || !dPtr->receivedMsg)
     return;
 
+  // New data changes the frame of views that render on change.
+  if (dPtr->scene)
+    dPtr->scene->MarkChanged();
+
   // The following values are used to calculate normal scaling factor based
   // on force value.
   double magScale = 100;
@@ -88,13 +109,47 @@ void ContactVisual::Update()
   double vRange = vMax - vMin;
   double offset = vRange - vMin;
 
-  unsigned int c = 0;
+  if (!dPtr->contactPoints)
+    this->CreateLines();
+
+  dPtr->contactPoints->Clear();
+  dPtr->normals->Clear();
+  dPtr->depths->Clear();
+
+  // Contacts that fall in an occupied screen cell are skipped, as are
+  // contacts behind or outside the user camera.
+  UserCameraPtr camera;
+  if (this->GetScene()->UserCameraCount() > 0u)
+    camera = this->GetScene()->GetUserCamera(0);
+  std::unordered_set<uint64_t> occupiedCells;
+
   for (int i = 0; i < dPtr->contactsMsg->contact_size(); i++)
   {
     for (int j = 0; j < dPtr->contactsMsg->contact(i).position_size(); j++)
     {
       auto pos = msgs::ConvertIgn(
           dPtr->contactsMsg->contact(i).position(j));
+
+      if (camera)
+      {
+        if ((pos - camera->WorldPosition()).Dot(camera->Direction()) <= 0)
+          continue;
+
+        const ignition::math::Vector2i pixel = camera->Project(pos);
+        if (pixel.X() < 0 || pixel.Y() < 0 ||
+            pixel.X() >= static_cast<int>(camera->ViewportWidth()) ||
+            pixel.Y() >= static_cast<int>(camera->ViewportHeight()))
+        {
+          continue;
+        }
+
+        const uint64_t cell =
+            (static_cast<uint64_t>(pixel.X() / kContactCellSize) << 32) |
+            static_cast<uint64_t>(pixel.Y() / kContactCellSize);
+        if (!occupiedCells.insert(cell).second)
+          continue;
+      }
+
       auto normal = msgs::ConvertIgn(
           dPtr->contactsMsg->contact(i).normal(j));
       double depth = dPtr->contactsMsg->contact(i).depth(j);
@@ -107,26 +162,19 @@ void ContactVisual::Update()
       double normalScale = (2.0 * vRange) / (1 + exp
           (-force.SquaredLength() / magScale)) - offset;
 
-      // Create a new contact visualization point if necessary
-      if (c >= dPtr->points.size())
-        this->CreateNewPoint();
+      dPtr->contactPoints->AddPoint(pos, ignition::math::Color::Blue);
 
-      dPtr->points[c]->contactPointVis->SetVisible(true);
-      dPtr->points[c]->contactPointVis->SetPosition(pos);
+      dPtr->normals->AddPoint(pos);
+      dPtr->normals->AddPoint(pos + normal * normalScale);
 
-      dPtr->points[c]->normal->SetPoint(1, (normal*normalScale));
-      dPtr->points[c]->depth->SetPoint(1, (normal*-depth*10));
-
-      GZ_OGRE_SET_MATERIAL_BY_NAME(dPtr->points[c]->normal, "Gazebo/LightOn");
-      GZ_OGRE_SET_MATERIAL_BY_NAME(dPtr->points[c]->depth, "Gazebo/LightOff");
-      dPtr->points[c]->depth->Update();
-      dPtr->points[c]->normal->Update();
-      c++;
+      dPtr->depths->AddPoint(pos);
+      dPtr->depths->AddPoint(pos + normal * -depth * 10);
     }
   }
 
-  for ( ; c < dPtr->points.size(); c++)
-    dPtr->points[c]->contactPointVis->SetVisible(false);
+  dPtr->contactPoints->Update();
+  dPtr->normals->Update();
+  dPtr->depths->Update();
 
   dPtr->receivedMsg = false;
 }
@@ -162,47 +210,37 @@ void ContactVisual::SetEnabled(bool _enabled)
     dPtr->contactsMsg.reset();
     dPtr->receivedMsg = false;
 
-    for (unsigned int c = 0 ; c < dPtr->points.size(); c++)
-      dPtr->points[c]->contactPointVis->SetVisible(false);
+    if (dPtr->contactPoints)
+    {
+      dPtr->contactPoints->Clear();
+      dPtr->normals->Clear();
+      dPtr->depths->Clear();
+      dPtr->contactPoints->Update();
+      dPtr->normals->Update();
+      dPtr->depths->Update();
+    }
   }
   else if (!dPtr->contactsSub)
   {
     dPtr->contactsSub = dPtr->node->Subscribe(dPtr->topicName,
-        &ContactVisual::OnContact, this);
+        &ContactVisual::OnContact, this, ContactQoS());
   }
 }
 
 /////////////////////////////////////////////////
-void ContactVisual::CreateNewPoint()
+void ContactVisual::CreateLines()
 {
   ContactVisualPrivate *dPtr =
       reinterpret_cast<ContactVisualPrivate *>(this->dataPtr);
 
-  std::string objName = this->Name() +
-    "_contactpoint_" + std::to_string(dPtr->points.size());
-
-  ContactVisualPrivate::ContactPoint *cp =
-      new ContactVisualPrivate::ContactPoint();
-
-  cp->contactPointVis.reset(
-      new Visual(objName + "_node", shared_from_this(), false));
-  cp->contactPointVis->Load();
-
-  /// \todo We can improve this by using instanced geometry.
-  cp->contactPointVis->AttachMesh("contact_sphere");
-  cp->contactPointVis->SetMaterial("Gazebo/BlueLaser");
-
-  cp->normal = cp->contactPointVis->CreateDynamicLine(RENDERING_LINE_LIST);
-  cp->depth = cp->contactPointVis->CreateDynamicLine(RENDERING_LINE_LIST);
-
-  cp->normal->AddPoint(ignition::math::Vector3d(0, 0, 0));
-  cp->normal->AddPoint(ignition::math::Vector3d(0, 0, 0.1));
+  dPtr->contactPoints = this->CreateDynamicLine(RENDERING_POINT_LIST);
+  GZ_OGRE_SET_MATERIAL_BY_NAME(dPtr->contactPoints, "Gazebo/ContactPoint");
 
-  cp->depth->AddPoint(ignition::math::Vector3d(0, 0, 0));
-  cp->depth->AddPoint(ignition::math::Vector3d(0, 0, -1));
+  dPtr->normals = this->CreateDynamicLine(RENDERING_LINE_LIST);
+  GZ_OGRE_SET_MATERIAL_BY_NAME(dPtr->normals, "Gazebo/LightOn");
 
-  cp->contactPointVis->SetVisibilityFlags(GZ_VISIBILITY_GUI);
-  cp->contactPointVis->SetVisible(false);
+  dPtr->depths = this->CreateDynamicLine(RENDERING_LINE_LIST);
+  GZ_OGRE_SET_MATERIAL_BY_NAME(dPtr->depths, "Gazebo/LightOff");
 
-  dPtr->points.push_back(cp);
+  this->SetVisibilityFlags(GZ_VISIBILITY_GUI);
 }
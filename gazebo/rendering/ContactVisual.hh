@@ -34,8 +34,10 @@ namespace gazebo
     /// \class ContactVisual ContactVisual.hh rendering/rendering.hh
     /// \brief Contact visualization
     ///
-    /// This class visualizes contact points by drawing arrows in the 3D
-    /// environment.
+    /// This class visualizes contact points by drawing points, normals and
+    /// depths in the 3D environment, with one draw call for each. Contacts
+    /// that fall in the same few pixels of the user camera are drawn once,
+    /// and contacts are received at a reduced rate while enabled.
     class GZ_RENDERING_VISIBLE ContactVisual : public Visual
     {
       /// \brief Constructor
@@ -60,8 +62,8 @@ namespace gazebo
       /// \param[in] _msg The Contact message
       private: void OnContact(ConstContactsPtr &_msg);
 
-      /// \brief Create a new contact visualization point.
-      private: void CreateNewPoint();
+      /// \brief Create the render objects of the contacts.
+      private: void CreateLines();
     };
     /// \}
   }
@@ -47,17 +47,14 @@ namespace gazebo
       /// \brief All the event connections.
       public: std::vector<event::ConnectionPtr> connections;
 
-      /// \brief A contact point visualization.
-      public: class ContactPoint
-               {
-                 /// \brief The contact point visual
-                 public: VisualPtr contactPointVis;
-                 /// \brief Normal and depth for the contact point.
-                 public: DynamicLines *normal, *depth;
-               };
+      /// \brief Renders the contact positions as point sprites.
+      public: DynamicLines *contactPoints = nullptr;
 
-      /// \brief All the contact points.
-      public: std::vector<ContactVisualPrivate::ContactPoint *> points;
+      /// \brief Renders the contact normals as a line list.
+      public: DynamicLines *normals = nullptr;
+
+      /// \brief Renders the contact depths as a line list.
+      public: DynamicLines *depths = nullptr;
 
       /// \brief Mutex to protect the contact message.
       public: boost::mutex mutex;
@@ -21,6 +21,8 @@
   #include "gazebo/common/win_dirent.h"
 #endif
 
+#include <algorithm>
+
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Console.hh"
 
@@ -185,6 +187,14 @@ void DepthCamera::Load(sdf::ElementPtr _sdf)
   this->dataPtr->outputReflectance =  found != std::string::npos;
   found = outputs.find("normals");
   this->dataPtr->outputNormals =  found != std::string::npos;
+
+  // Gazebo specific opt-in
+  sdf::ElementPtr depthElem = _sdf->GetElement("depth_camera");
+  if (depthElem->HasElement("point_cloud_decimation"))
+  {
+    this->SetPointCloudDecimation(
+        depthElem->Get<unsigned int>("point_cloud_decimation"));
+  }
 }
 
 //////////////////////////////////////////////////
@@ -267,7 +277,7 @@ void DepthCamera::CreateDepthTexture(const std::string &_textureName)
         _textureName + "_pcd",
         "General",
         Ogre::TEX_TYPE_2D,
-        this->ImageWidth(), this->ImageHeight(), 0,
+        this->PointCloudWidth(), this->PointCloudHeight(), 0,
         Ogre::PF_FLOAT32_RGBA,
         Ogre::TU_RENDERTARGET).getPointer();
 
@@ -422,7 +432,10 @@ void DepthCamera::PostRender()
 
       // Blit the depth buffer if needed
       if (!this->dataPtr->depthBuffer)
+      {
         this->dataPtr->depthBuffer = new float[size];
+        this->dataPtr->bufferMemory.Add(size * sizeof(float), 1);
+      }
 
       Ogre::PixelBox dstBox(width, height,
           1, Ogre::PF_FLOAT32_R, this->dataPtr->depthBuffer);
@@ -433,6 +446,13 @@ void DepthCamera::PostRender()
 
       this->dataPtr->newDepthFrame(
           this->dataPtr->depthBuffer, width, height, 1, "FLOAT32");
+
+      if (this->dataPtr->newDepthFrameHandle.ConnectionCount() > 0u)
+      {
+        this->dataPtr->newDepthFrameHandle(
+            this->dataPtr->depthFramePool.Fill(this->dataPtr->depthBuffer,
+            width * height * sizeof(float), width, height, 1, "FLOAT32"));
+      }
     }
     else
     {
@@ -441,14 +461,22 @@ void DepthCamera::PostRender()
       // Get access to the buffer and make an image and write it to file
       pcdPixelBuffer = this->dataPtr->pcdTexture->getBuffer();
 
+      // The point cloud is smaller than the image when decimated.
+      unsigned int pcdWidth = this->PointCloudWidth();
+      unsigned int pcdHeight = this->PointCloudHeight();
+
       // Blit the depth buffer if needed
       if (!this->dataPtr->pcdBuffer)
-        this->dataPtr->pcdBuffer = new float[width * height * 4];
+      {
+        this->dataPtr->pcdBuffer = new float[pcdWidth * pcdHeight * 4];
+        this->dataPtr->bufferMemory.Add(
+            pcdWidth * pcdHeight * 4 * sizeof(float), 1);
+      }
 
-      memset(this->dataPtr->pcdBuffer, 0, width * height * 4);
+      memset(this->dataPtr->pcdBuffer, 0, pcdWidth * pcdHeight * 4);
 
-      Ogre::Box pcd_src_box(0, 0, width, height);
-      Ogre::PixelBox pcd_dst_box(width, height,
+      Ogre::Box pcd_src_box(0, 0, pcdWidth, pcdHeight);
+      Ogre::PixelBox pcd_dst_box(pcdWidth, pcdHeight,
           1, Ogre::PF_FLOAT32_RGBA, this->dataPtr->pcdBuffer);
 
       pcdPixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
@@ -456,7 +484,7 @@ void DepthCamera::PostRender()
       pcdPixelBuffer->unlock();
 
       this->dataPtr->newRGBPointCloud(
-          this->dataPtr->pcdBuffer, width, height, 1, "RGBPOINTS");
+          this->dataPtr->pcdBuffer, pcdWidth, pcdHeight, 1, "RGBPOINTS");
     }
 
     if (this->dataPtr->outputReflectance)
@@ -467,7 +495,10 @@ void DepthCamera::PostRender()
 
      // Blit the depth buffer if needed
      if (!this->dataPtr->reflectanceBuffer)
+     {
        this->dataPtr->reflectanceBuffer = new float[width * height * 1];
+       this->dataPtr->bufferMemory.Add(width * height * sizeof(float), 1);
+     }
 
      memset(this->dataPtr->reflectanceBuffer, 0, width * height * 1);
 
@@ -492,7 +523,10 @@ void DepthCamera::PostRender()
 
       // Blit the depth buffer if needed
       if (!this->dataPtr->normalsBuffer)
+      {
         this->dataPtr->normalsBuffer = new float[width * height * 4];
+        this->dataPtr->bufferMemory.Add(width * height * 4 * sizeof(float), 1);
+      }
 
       memset(this->dataPtr->normalsBuffer, 0, width * height * 4);
 
@@ -559,6 +593,9 @@ void DepthCamera::UpdateRenderTarget(Ogre::RenderTarget *_target,
   renderSys->setLightingEnabled(false);
   renderSys->_setFog(Ogre::FOG_NONE);
 
+  if (_material == this->dataPtr->depthMaterial)
+    this->dataPtr->rangeNoise.SetShaderParams(pass);
+
   // These two lines don't seem to do anything useful
   renderSys->_setProjectionMatrix(
       this->OgreCamera()->getProjectionMatrixRS());
@@ -688,6 +725,19 @@ event::ConnectionPtr DepthCamera::ConnectNewDepthFrame(
   return this->dataPtr->newDepthFrame.Connect(_subscriber);
 }
 
+//////////////////////////////////////////////////
+event::ConnectionPtr DepthCamera::ConnectNewDepthFrameHandle(
+    std::function<void (FramePtr)> _subscriber)
+{
+  return this->dataPtr->newDepthFrameHandle.Connect(_subscriber);
+}
+
+//////////////////////////////////////////////////
+FramePtr DepthCamera::LatestDepthFrame() const
+{
+  return this->dataPtr->depthFramePool.Latest();
+}
+
 //////////////////////////////////////////////////
 event::ConnectionPtr DepthCamera::ConnectNewRGBPointCloud(
     std::function<void (const float *, unsigned int, unsigned int, unsigned int,
@@ -696,6 +746,50 @@ event::ConnectionPtr DepthCamera::ConnectNewRGBPointCloud(
   return this->dataPtr->newRGBPointCloud.Connect(_subscriber);
 }
 
+//////////////////////////////////////////////////
+bool DepthCamera::OutputPoints() const
+{
+  return this->dataPtr->outputPoints;
+}
+
+//////////////////////////////////////////////////
+void DepthCamera::SetPointCloudDecimation(const unsigned int _decimation)
+{
+  if (this->dataPtr->pcdTexture)
+  {
+    gzwarn << "Point cloud decimation must be set before the depth texture "
+           << "is created\n";
+    return;
+  }
+  this->dataPtr->pcdDecimation = std::max(1u, _decimation);
+}
+
+//////////////////////////////////////////////////
+unsigned int DepthCamera::PointCloudDecimation() const
+{
+  return this->dataPtr->pcdDecimation;
+}
+
+//////////////////////////////////////////////////
+void DepthCamera::SetRangeNoise(const RangeNoise &_noise)
+{
+  this->dataPtr->rangeNoise = _noise;
+}
+
+//////////////////////////////////////////////////
+unsigned int DepthCamera::PointCloudWidth() const
+{
+  unsigned int decimation = this->dataPtr->pcdDecimation;
+  return (this->ImageWidth() + decimation - 1) / decimation;
+}
+
+//////////////////////////////////////////////////
+unsigned int DepthCamera::PointCloudHeight() const
+{
+  unsigned int decimation = this->dataPtr->pcdDecimation;
+  return (this->ImageHeight() + decimation - 1) / decimation;
+}
+
 //////////////////////////////////////////////////
 event::ConnectionPtr DepthCamera::ConnectNewReflectanceFrame(
     std::function<void (const float*, unsigned int, unsigned int, unsigned int,
@@ -712,6 +806,17 @@ event::ConnectionPtr DepthCamera::ConnectNewNormalsPointCloud(
   return this->dataPtr->newNormalsPointCloud.Connect(_subscriber);
 }
 
+//////////////////////////////////////////////////
+unsigned int DepthCamera::FrameListenerCount() const
+{
+  return Camera::FrameListenerCount() +
+    this->dataPtr->newDepthFrame.ConnectionCount() +
+    this->dataPtr->newDepthFrameHandle.ConnectionCount() +
+    this->dataPtr->newRGBPointCloud.ConnectionCount() +
+    this->dataPtr->newReflectanceFrame.ConnectionCount() +
+    this->dataPtr->newNormalsPointCloud.ConnectionCount();
+}
+
 /////////////////////////////////////////////////
 ReflectanceMaterialSwitcher::ReflectanceMaterialSwitcher(
   ScenePtr _scene, Ogre::Viewport* _viewport)
@@ -26,6 +26,7 @@
 #include "gazebo/common/CommonTypes.hh"
 
 #include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/RangeNoise.hh"
 #include "gazebo/util/system.hh"
 
 namespace Ogre
@@ -103,6 +104,20 @@ namespace gazebo
           std::function<void (const float *, unsigned int, unsigned int,
           unsigned int, const std::string &)>  _subscriber);
 
+      /// \brief Connect to the new depth image signal with shared
+      /// ownership of the frame. The frame holds one float per pixel and is
+      /// not overwritten while the subscriber holds it.
+      /// \param[in] _subscriber Subscriber callback function
+      /// \return Pointer to the new Connection. This must be kept in scope
+      /// \sa ConnectNewDepthFrame
+      public: event::ConnectionPtr ConnectNewDepthFrameHandle(
+          std::function<void (FramePtr)> _subscriber);
+
+      /// \brief Get the last depth frame handed to the depth frame handle
+      /// subscribers.
+      /// \return The latest depth frame, or nullptr if there is none yet.
+      public: FramePtr LatestDepthFrame() const;
+
       /// \brief Connect a to the new rgb point cloud signal
       /// Point coordinates and color are stored in a vector4f.
       /// The first three channels are for the XYZ coordinates.
@@ -137,6 +152,39 @@ namespace gazebo
           std::function<void (const float *, unsigned int, unsigned int,
           unsigned int, const std::string &)>  _subscriber);
 
+      // Documentation inherited.
+      public: virtual unsigned int FrameListenerCount() const override;
+
+      /// \brief Get whether the camera generates point clouds.
+      /// \return True if the camera generates point clouds.
+      public: bool OutputPoints() const;
+
+      /// \brief Render the point cloud at a lower resolution than the image.
+      /// Every square of _decimation x _decimation pixels becomes one point,
+      /// computed on the GPU, so the readback shrinks by the same factor.
+      /// Must be called before CreateDepthTexture.
+      /// \param[in] _decimation Decimation factor, 1 keeps every pixel.
+      /// \sa PointCloudDecimation()
+      public: void SetPointCloudDecimation(const unsigned int _decimation);
+
+      /// \brief Set the noise that the depth shader adds to the depth
+      /// image.
+      /// \param[in] _noise Noise parameters.
+      public: void SetRangeNoise(const RangeNoise &_noise);
+
+      /// \brief Get the point cloud decimation factor.
+      /// \return The decimation factor.
+      /// \sa SetPointCloudDecimation(const unsigned int _decimation)
+      public: unsigned int PointCloudDecimation() const;
+
+      /// \brief Get the width of the point cloud.
+      /// \return Number of points in a row.
+      public: unsigned int PointCloudWidth() const;
+
+      /// \brief Get the height of the point cloud.
+      /// \return Number of rows of points.
+      public: unsigned int PointCloudHeight() const;
+
       /// \brief Implementation of the render call
       private: virtual void RenderImpl();
 
@@ -21,8 +21,11 @@
 #include <string>
 
 #include "gazebo/common/Event.hh"
+#include "gazebo/common/MemoryStats.hh"
 
 #include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/FramePool.hh"
+#include "gazebo/rendering/RangeNoise.hh"
 
 namespace Ogre
 {
@@ -57,9 +60,16 @@ namespace gazebo
       /// \brief The depth buffer
       public: float *depthBuffer = nullptr;
 
+      /// \brief Memory held by the depth, point cloud, reflectance and
+      /// normals buffers.
+      public: common::MemoryCharge bufferMemory{"Camera/images"};
+
       /// \brief The depth material
       public: Ogre::Material *depthMaterial = nullptr;
 
+      /// \brief Noise added to the depth image by the depth shader.
+      public: RangeNoise rangeNoise;
+
       /// \brief True to generate point clouds
       public: bool outputPoints;
 
@@ -72,6 +82,10 @@ namespace gazebo
       /// \brief Point cloud data buffer
       public: float *pcdBuffer = nullptr;
 
+      /// \brief Number of image pixels along each side of the square that
+      /// becomes one point of the point cloud.
+      public: unsigned int pcdDecimation = 1u;
+
       /// \brief reflectance data buffer
       public: float *reflectanceBuffer = nullptr;
 
@@ -125,6 +139,12 @@ namespace gazebo
       public: event::EventT<void(const float *, unsigned int, unsigned int,
                    unsigned int, const std::string &)> newDepthFrame;
 
+      /// \brief Event used to signal pooled depth frames
+      public: event::EventT<void(FramePtr)> newDepthFrameHandle;
+
+      /// \brief Depth frames handed to the depth frame handle subscribers.
+      public: FramePool depthFramePool;
+
       /// \brief Event used to signal reflectance data
       public: event::EventT<void(const float *, unsigned int, unsigned int,
                   unsigned int, const std::string &)> newReflectanceFrame;
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+
 #include <sdf/sdf.hh>
 
 #include <ignition/math/Helpers.hh>
@@ -25,6 +27,9 @@
 using namespace gazebo;
 using namespace rendering;
 
+/// \brief Largest side of the distortion map, in texels.
+static const unsigned int kDistortionMapSize = 128;
+
 namespace gazebo
 {
   namespace rendering
@@ -74,13 +79,15 @@ namespace gazebo
       /// \brief Ogre Material that contains the distortion shader
       public: Ogre::MaterialPtr distortionMaterial;
 
-      /// \brief Ogre Texture that contains the distortion map
+      /// \brief Ogre Texture that contains the distortion map, only created
+      /// when the image is cropped.
       public: Ogre::TexturePtr distortionTexture;
 
       /// \brief Connection for the pre render event.
       public: event::ConnectionPtr preRenderConnection;
 
-      /// \brief Mapping of distorted to undistorted normalized pixels
+      /// \brief Coarse mapping of distorted to undistorted normalized
+      /// pixels. The shader refines it, so it is much smaller than the image.
       public: std::vector<ignition::math::Vector2d> distortionMap;
 
       /// \brief Width of distortion texture map
@@ -89,26 +96,44 @@ namespace gazebo
       /// \brief Height of distortion texture map
       public: unsigned int distortionTexHeight;
 
-      // \brief Set scale parameter in shader before rendering frame
+      /// \brief Ratio of the distortion texture width to the focal length.
+      /// Always 1 in legacy mode.
+      public: double normalization = 1.0;
+
+      // \brief Set distortion parameters in shader before rendering frame
       public:
       virtual void notifyMaterialRender(Ogre::uint32 _passId,
                                         Ogre::MaterialPtr& _material)
       {
+        Ogre::Pass *pass = _material->getTechnique(0)->getPass(_passId);
+
         // If more compositors are added to the camera in addition to the
         // distortion compositor, an Ogre bug will cause the material for the
         // last camera initialized to be used for all cameras. This workaround
-        // doesn't correct the material used, but it applies the correct texture
-        // to this active material.
-        _material->getTechnique(0)->getPass(_passId)->getTextureUnitState(1)->
-          setTexture(distortionTexture);
-
-        // @todo Explore more efficent implementations as it is run every frame
+        // doesn't correct the material used, but it applies the correct
+        // parameters to this active material.
+        const bool useMap = !distortionTexture.isNull();
+        if (useMap && pass->getNumTextureUnitStates() > 1)
+          pass->getTextureUnitState(1)->setTexture(distortionTexture);
+
+        // The distortion is evaluated in the shader, so the coefficients
+        // can change without rebuilding anything.
         Ogre::GpuProgramParametersSharedPtr params =
-            _material->getTechnique(0)->getPass(_passId)
-                     ->getFragmentProgramParameters();
+            pass->getFragmentProgramParameters();
         params->setNamedConstant("scale",
             Ogre::Vector3(1.0/distortionScale.X(),
             1.0/distortionScale.Y(), 1.0));
+        params->setNamedConstant("radial",
+            Ogre::Vector3(this->k1, this->k2, this->k3));
+        params->setNamedConstant("tangential",
+            Ogre::Vector2(this->p1, this->p2));
+        params->setNamedConstant("center",
+            Ogre::Vector2(this->lensCenter.X(), this->lensCenter.Y()));
+        params->setNamedConstant("normalization",
+            static_cast<Ogre::Real>(this->normalization));
+        params->setNamedConstant("useDistortionMap",
+            static_cast<Ogre::Real>(
+            useMap && pass->getNumTextureUnitStates() > 1 ? 1.0 : 0.0));
       }
     };
   }
@@ -186,13 +211,46 @@ void Distortion::SetCamera(CameraPtr _camera)
     return;
   }
 
-  // seems to work best with a square distortion map texture
-  unsigned int texSide = _camera->ImageHeight() > _camera->ImageWidth() ?
-      _camera->ImageHeight() : _camera->ImageWidth();
   // calculate focal length from largest fov
   const double fov = _camera->ImageHeight() > _camera->ImageWidth() ?
       _camera->VFOV().Radian() : _camera->HFOV().Radian();
-  const double focalLength = texSide/(2*tan(fov/2));
+
+  // The shader distorts in units of focal length, the ratio of the image
+  // side to the focal length only depends on the field of view.
+  this->dataPtr->normalization =
+      this->dataPtr->legacyMode ? 1.0 : 2.0 * tan(fov / 2.0);
+
+  // set up the distortion instance
+  this->dataPtr->distortionMaterial =
+      Ogre::MaterialManager::getSingleton().getByName(
+          "Gazebo/CameraDistortionMap");
+  this->dataPtr->distortionMaterial =
+      this->dataPtr->distortionMaterial->clone(
+          "Gazebo/" + _camera->Name() + "_CameraDistortionMap");
+
+  this->dataPtr->distortionMap.clear();
+  this->dataPtr->distortionTexture.setNull();
+  this->dataPtr->distortionTexWidth = 0;
+  this->dataPtr->distortionTexHeight = 0;
+
+  // Black borders are cropped, and the shader samples the image far from
+  // the center, where the inverse of a strong barrel distortion is hard to
+  // find from scratch. A small map gives the shader a first guess there.
+  if (this->dataPtr->distortionCrop)
+    this->BuildDistortionMap(_camera, fov);
+
+  this->CalculateAndApplyDistortionScale();
+
+  this->RefreshCompositor(_camera);
+}
+
+//////////////////////////////////////////////////
+void Distortion::BuildDistortionMap(CameraPtr _camera, const double _fov)
+{
+  // seems to work best with a square distortion map texture
+  const unsigned int texSide = std::min(kDistortionMapSize,
+      std::max(_camera->ImageHeight(), _camera->ImageWidth()));
+  const double focalLength = texSide/(2*tan(_fov/2));
   this->dataPtr->distortionTexWidth = texSide;
   this->dataPtr->distortionTexHeight = texSide;
   unsigned int imageSize =
@@ -310,14 +368,6 @@ void Distortion::SetCamera(CameraPtr _camera)
     }
   }
 
-  // set up the distortion instance
-  this->dataPtr->distortionMaterial =
-      Ogre::MaterialManager::getSingleton().getByName(
-          "Gazebo/CameraDistortionMap");
-  this->dataPtr->distortionMaterial =
-      this->dataPtr->distortionMaterial->clone(
-          "Gazebo/" + _camera->Name() + "_CameraDistortionMap");
-
   // create the distortion map texture for the distortion instance
   std::string texName = _camera->Name() + "_distortionTex";
   this->dataPtr->distortionTexture =
@@ -441,13 +491,9 @@ void Distortion::SetCamera(CameraPtr _camera)
   }
   pixelBuffer->unlock();
 
-  this->CalculateAndApplyDistortionScale();
-
   // set up the distortion map texture to be used in the pixel shader.
   this->dataPtr->distortionMaterial->getTechnique(0)->getPass(0)->
       createTextureUnitState(texName, 1);
-
-  this->RefreshCompositor(_camera);
 }
 
 //////////////////////////////////////////////////
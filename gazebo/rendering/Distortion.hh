@@ -37,6 +37,10 @@ namespace gazebo
 
     /// \class Distortion Distortion.hh rendering/rendering.hh
     /// \brief Camera distortion based on the Brown-Conrady model.
+    ///
+    /// The distortion is evaluated in a fragment shader, which inverts the
+    /// model with a few Newton iterations per pixel, so the cost of setting
+    /// up a camera does not grow with its resolution.
     class GZ_RENDERING_VISIBLE Distortion
     {
       /// \brief Constructor
@@ -135,6 +139,13 @@ namespace gazebo
       protected: ignition::math::Vector2d
         DistortionMapValueClamped(const int x, const int y) const;
 
+      /// \brief Build the small inverse distortion map that gives the shader
+      /// a first guess of the undistorted coordinates when the image is
+      /// cropped.
+      /// \param[in] _camera Camera to be distorted.
+      /// \param[in] _fov Largest field of view of the camera, in radians.
+      protected: void BuildDistortionMap(CameraPtr _camera, const double _fov);
+
       /// \brief calculate the correct scale factor to "zoom" the render,
       /// cutting off black borders caused by distortion (only if the crop
       /// flag has been set).
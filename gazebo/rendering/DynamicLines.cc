@@ -16,10 +16,12 @@
 */
 #include <math.h>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <sstream>
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Color.hh>
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 
 #include "gazebo/common/Console.hh"
@@ -35,8 +37,25 @@ enum {POSITION_BINDING, TEXCOORD_BINDING};
 /// \brief Private implementation
 class gazebo::rendering::DynamicLinesPrivate
 {
+  /// \brief Mark a range of points as changed.
+  /// \param[in] _begin Index of the first changed point.
+  /// \param[in] _end Index past the last changed point.
+  public: void Changed(const size_t _begin, const size_t _end)
+  {
+    this->changedBegin = std::min(this->changedBegin, _begin);
+    this->changedEnd = std::max(this->changedEnd, _end);
+  }
+
   /// \brief list of colors at each point
   public: std::vector<ignition::math::Color> colors;
+
+  /// \brief Index of the first point changed since the buffers were
+  /// filled.
+  public: size_t changedBegin = 0;
+
+  /// \brief Index past the last point changed since the buffers were
+  /// filled.
+  public: size_t changedEnd = 0;
 };
 
 /////////////////////////////////////////////////
@@ -72,6 +91,7 @@ void DynamicLines::AddPoint(const ignition::math::Vector3d &_pt,
 {
   this->points.push_back(_pt);
   this->dataPtr->colors.push_back(_color);
+  this->dataPtr->Changed(this->points.size() - 1, this->points.size());
   this->dirty = true;
 }
 
@@ -95,6 +115,7 @@ void DynamicLines::SetPoint(const unsigned int _index,
 
   this->points[_index] = _value;
 
+  this->dataPtr->Changed(_index, _index + 1);
   this->dirty = true;
 }
 
@@ -103,6 +124,7 @@ void DynamicLines::SetColor(const unsigned int _index,
                             const ignition::math::Color &_color)
 {
   this->dataPtr->colors[_index] = _color;
+  this->dataPtr->Changed(_index, _index + 1);
   this->dirty = true;
 }
 
@@ -133,6 +155,8 @@ unsigned int DynamicLines::GetPointCount() const
 void DynamicLines::Clear()
 {
   this->points.clear();
+  this->dataPtr->colors.clear();
+  this->dataPtr->Changed(0, 0);
   this->dirty = true;
 }
 
@@ -140,7 +164,7 @@ void DynamicLines::Clear()
 void DynamicLines::Update()
 {
   IGN_PROFILE("rendering::DynamicLines::Update");
-  if (this->dirty && this->points.size() > 1)
+  if (this->dirty)
     this->FillHardwareBuffers();
 }
 
@@ -157,46 +181,71 @@ void DynamicLines::CreateVertexDeclaration()
 /////////////////////////////////////////////////
 void DynamicLines::FillHardwareBuffers()
 {
-  int size = this->points.size();
-  this->PrepareHardwareBuffers(size, 0);
+  const size_t size = this->points.size();
+  const bool reallocated = this->PrepareHardwareBuffers(size, 0);
+
+  this->mBox.setNull();
+  for (auto const &point : this->points)
+    this->mBox.merge(Conversions::Convert(point));
 
+  // Without points the render operation draws nothing
   if (!size)
   {
     this->mBox.setExtents(Ogre::Vector3::ZERO, Ogre::Vector3::ZERO);
+    if (this->getParentSceneNode())
+      this->getParentSceneNode()->needUpdate();
     this->dirty = false;
+    return;
   }
 
-  Ogre::HardwareVertexBufferSharedPtr vbuf =
-    this->mRenderOp.vertexData->vertexBufferBinding->getBuffer(0);
+  // Only the changed points are written, unless the buffers are new
+  const size_t begin =
+      reallocated ? 0 : std::min(this->dataPtr->changedBegin, size);
+  const size_t end = reallocated ? size : std::min(this->dataPtr->changedEnd,
+      size);
 
-  Ogre::Real *prPos =
-    static_cast<Ogre::Real*>(vbuf->lock(Ogre::HardwareBuffer::HBL_NORMAL));
+  if (begin < end)
   {
-    for (int i = 0; i < size; i++)
+    // A full write lets the driver hand out a fresh buffer, a partial one
+    // leaves the rest of the buffer untouched.
+    const Ogre::HardwareBuffer::LockOptions options =
+        (begin == 0 && end == size) ? Ogre::HardwareBuffer::HBL_DISCARD :
+        Ogre::HardwareBuffer::HBL_NO_OVERWRITE;
+
+    Ogre::HardwareVertexBufferSharedPtr vbuf =
+      this->mRenderOp.vertexData->vertexBufferBinding->getBuffer(0);
+
+    Ogre::Real *prPos = static_cast<Ogre::Real*>(vbuf->lock(
+          begin * vbuf->getVertexSize(), (end - begin) * vbuf->getVertexSize(),
+          options));
+    for (size_t i = begin; i < end; ++i)
     {
       *prPos++ = this->points[i].X();
       *prPos++ = this->points[i].Y();
       *prPos++ = this->points[i].Z();
-
-      this->mBox.merge(Conversions::Convert(this->points[i]));
     }
+    vbuf->unlock();
+
+    // Update the colors
+    Ogre::HardwareVertexBufferSharedPtr cbuf =
+      this->mRenderOp.vertexData->vertexBufferBinding->getBuffer(1);
+
+    Ogre::RGBA *colorArrayBuffer = static_cast<Ogre::RGBA*>(cbuf->lock(
+          begin * cbuf->getVertexSize(), (end - begin) * cbuf->getVertexSize(),
+          options));
+    Ogre::RenderSystem *renderSystemForVertex =
+          Ogre::Root::getSingleton().getRenderSystem();
+    for (size_t i = begin; i < end; ++i)
+    {
+      Ogre::ColourValue color = Conversions::Convert(this->dataPtr->colors[i]);
+      renderSystemForVertex->convertColourValue(color,
+          &colorArrayBuffer[i - begin]);
+    }
+    cbuf->unlock();
   }
-  vbuf->unlock();
 
-  // Update the colors
-  Ogre::HardwareVertexBufferSharedPtr cbuf =
-    this->mRenderOp.vertexData->vertexBufferBinding->getBuffer(1);
-
-  Ogre::RGBA *colorArrayBuffer =
-        static_cast<Ogre::RGBA*>(cbuf->lock(Ogre::HardwareBuffer::HBL_DISCARD));
-  Ogre::RenderSystem *renderSystemForVertex =
-        Ogre::Root::getSingleton().getRenderSystem();
-  for (int i = 0; i < size; ++i)
-  {
-    Ogre::ColourValue color = Conversions::Convert(this->dataPtr->colors[i]);
-    renderSystemForVertex->convertColourValue(color, &colorArrayBuffer[i]);
-  }
-  cbuf->unlock();
+  this->dataPtr->changedBegin = std::numeric_limits<size_t>::max();
+  this->dataPtr->changedEnd = 0;
 
   // need to update after mBox change, otherwise the lines goes in and out
   // of scope based on old mBox
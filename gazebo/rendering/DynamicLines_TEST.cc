@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/Visual.hh"
+#include "gazebo/rendering/DynamicLines.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class DynamicLines_TEST : public RenderingFixture
+{
+};
+
+/// \brief Exposes the buffer capacity of DynamicLines.
+class TestLines : public rendering::DynamicLines
+{
+  /// \brief Constructor.
+  public: TestLines()
+    : rendering::DynamicLines(rendering::RENDERING_LINE_LIST)
+  {
+  }
+
+  /// \brief Get the capacity of the vertex buffer.
+  /// \return Capacity in vertices.
+  public: size_t Capacity() const
+  {
+    return this->vertexBufferCapacity;
+  }
+};
+
+//////////////////////////////////////////////////
+TEST_F(DynamicLines_TEST, BufferCapacity)
+{
+  this->Load("worlds/empty.world");
+
+  auto scene = gazebo::rendering::get_scene("default");
+
+  if (!scene)
+    scene = gazebo::rendering::create_scene("default", false);
+
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::VisualPtr vis(new rendering::Visual("lines_vis",
+      scene->WorldVisual()));
+  vis->Load();
+
+  TestLines lines;
+  vis->GetSceneNode()->attachObject(&lines);
+
+  // capacity grows to the next power of two
+  for (unsigned int i = 0; i < 100; ++i)
+    lines.AddPoint(ignition::math::Vector3d(i, 0, 0));
+  lines.Update();
+  EXPECT_EQ(lines.Capacity(), 128u);
+  EXPECT_EQ(lines.GetPointCount(), 100u);
+
+  // changing points keeps the buffer
+  for (unsigned int i = 0; i < 10; ++i)
+  {
+    lines.SetPoint(i, ignition::math::Vector3d(i, 1, 0));
+    lines.Update();
+  }
+  EXPECT_EQ(lines.Capacity(), 128u);
+  EXPECT_EQ(lines.Point(5), ignition::math::Vector3d(5, 1, 0));
+
+  // a few updates with fewer points don't shrink the buffer
+  for (unsigned int i = 0; i < 10; ++i)
+  {
+    lines.Clear();
+    lines.AddPoint(ignition::math::Vector3d::Zero);
+    lines.AddPoint(ignition::math::Vector3d::UnitX);
+    lines.Update();
+  }
+  EXPECT_EQ(lines.Capacity(), 128u);
+
+  // a long time with fewer points does
+  for (unsigned int i = 0; i < 1000; ++i)
+  {
+    lines.SetPoint(1, ignition::math::Vector3d(1, i, 0));
+    lines.Update();
+  }
+  EXPECT_LT(lines.Capacity(), 128u);
+  EXPECT_GE(lines.Capacity(), 2u);
+
+  vis->GetSceneNode()->detachObject(&lines);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
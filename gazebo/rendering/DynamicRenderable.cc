@@ -15,12 +15,55 @@
  *
 */
 
+#include <algorithm>
+#include <limits>
+
 #include "gazebo/common/Console.hh"
 #include "gazebo/rendering/DynamicRenderable.hh"
 
 using namespace gazebo;
 using namespace rendering;
 
+/// \brief Number of consecutive updates a buffer must be used below a
+/// quarter of its capacity before it shrinks.
+static const unsigned int kShrinkUpdateCount = 300;
+
+//////////////////////////////////////////////////
+/// \brief Get the capacity a hardware buffer needs for a number of
+/// elements.
+/// \param[in] _count Number of elements.
+/// \param[in] _capacity Current capacity of the buffer.
+/// \param[in,out] _lowUsageCount Consecutive calls with a low usage.
+/// \return The new capacity, a power of two.
+static size_t BufferCapacity(const size_t _count, const size_t _capacity,
+    unsigned int &_lowUsageCount)
+{
+  // Grow to the next power of two
+  if (_count > _capacity || _capacity == 0)
+  {
+    _lowUsageCount = 0;
+    size_t capacity = std::max<size_t>(_capacity, 1);
+    while (capacity < _count)
+      capacity <<= 1;
+    return capacity;
+  }
+
+  if (_count >= _capacity >> 2)
+  {
+    _lowUsageCount = 0;
+    return _capacity;
+  }
+
+  if (++_lowUsageCount < kShrinkUpdateCount)
+    return _capacity;
+
+  // Shrink, leaving room for the count to double again
+  _lowUsageCount = 0;
+  size_t capacity = _capacity;
+  while (_count < capacity >> 2)
+    capacity >>= 1;
+  return capacity;
+}
 
 //////////////////////////////////////////////////
 DynamicRenderable::DynamicRenderable()
@@ -127,34 +170,15 @@ RenderOpType DynamicRenderable::GetOperationType() const
 }
 
 //////////////////////////////////////////////////
-void DynamicRenderable::PrepareHardwareBuffers(size_t vertexCount,
+bool DynamicRenderable::PrepareHardwareBuffers(size_t vertexCount,
                                                size_t indexCount)
 {
   // Prepare vertex buffer
-  size_t newVertCapacity = this->vertexBufferCapacity;
-
-  if ((vertexCount > this->vertexBufferCapacity) ||
-      (!this->vertexBufferCapacity))
-  {
-    // vertexCount exceeds current capacity!
-    // It is necessary to reallocate the buffer.
+  const size_t newVertCapacity = BufferCapacity(vertexCount,
+      this->vertexBufferCapacity, this->vertexLowUsageCount);
 
-    // Check if this is the first call
-    if (!newVertCapacity)
-      newVertCapacity = 1;
-
-    // Make capacity the next power of two
-    while (newVertCapacity < vertexCount)
-      newVertCapacity <<= 1;
-  }
-  else if (vertexCount < this->vertexBufferCapacity>>1)
-  {
-    // Make capacity the previous power of two
-    while (vertexCount < newVertCapacity>>1)
-      newVertCapacity >>= 1;
-  }
-
-  if (newVertCapacity != this->vertexBufferCapacity)
+  const bool reallocated = newVertCapacity != this->vertexBufferCapacity;
+  if (reallocated)
   {
     this->vertexBufferCapacity = newVertCapacity;
 
@@ -171,8 +195,6 @@ void DynamicRenderable::PrepareHardwareBuffers(size_t vertexCount,
         this->vertexBufferCapacity,
         Ogre::HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY);
 
-    // TODO: Custom HBU_?
-
     // Bind buffer
     this->mRenderOp.vertexData->vertexBufferBinding->setBinding(0, vbuf);
 
@@ -187,28 +209,9 @@ void DynamicRenderable::PrepareHardwareBuffers(size_t vertexCount,
     OgreAssert(indexCount <= std::numeric_limits<uint16_t>::max(),
         "indexCount exceeds 16 bit");
 
-    size_t newIndexCapacity = this->indexBufferCapacity;
-
     // Prepare index buffer
-    if ((indexCount > newIndexCapacity) || (!newIndexCapacity))
-    {
-      // indexCount exceeds current capacity!
-      // It is necessary to reallocate the buffer.
-
-      // Check if this is the first call
-      if (!newIndexCapacity)
-        newIndexCapacity = 1;
-
-      // Make capacity the next power of two
-      while (newIndexCapacity < indexCount)
-        newIndexCapacity <<= 1;
-    }
-    else if (indexCount < newIndexCapacity>>1)
-    {
-      // Make capacity the previous power of two
-      while (indexCount < newIndexCapacity>>1)
-        newIndexCapacity >>= 1;
-    }
+    const size_t newIndexCapacity = BufferCapacity(indexCount,
+        this->indexBufferCapacity, this->indexLowUsageCount);
 
     if (newIndexCapacity != this->indexBufferCapacity)
     {
@@ -220,12 +223,13 @@ void DynamicRenderable::PrepareHardwareBuffers(size_t vertexCount,
           Ogre::HardwareIndexBuffer::IT_16BIT,
           this->indexBufferCapacity,
           Ogre::HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY);
-      // TODO: Custom HBU_?
     }
 
     // Update index count in the render operation
     this->mRenderOp.indexData->indexCount = indexCount;
   }
+
+  return reallocated;
 }
 
 //////////////////////////////////////////////////
@@ -84,13 +84,18 @@ namespace gazebo
        ///    fillHardwareBuffers().  It guarantees that the hardware buffers
        ///    are large enough to hold at least the requested number of
        ///    vertices and indices (if using indices).  The buffers are
-       ///    possibly reallocated to achieve this.
+       ///    possibly reallocated to achieve this. They grow to the next
+       ///    power of two, and only shrink once they have been used below a
+       ///    quarter of their capacity for a few hundred calls, so a steady
+       ///    number of points keeps the same buffers.
        /// \par The vertex and index count in the render operation are set to
        ///      the values of vertexCount and indexCount respectively.
        /// \param[in] _vertexCount The number of vertices the buffer must hold.
        /// \param[in] _indexCount The number of indices the buffer must hold.
        ///        This parameter is ignored if not using indices.
-      protected: void PrepareHardwareBuffers(size_t _vertexCount,
+       /// \return True if the vertex buffers were reallocated, in which case
+       ///         their whole content must be written.
+      protected: bool PrepareHardwareBuffers(size_t _vertexCount,
                                              size_t _indexCount);
 
        /// \brief Fills the hardware vertex and index buffers with data.
@@ -106,6 +111,14 @@ namespace gazebo
 
       /// \brief Maximum capacity of the currently allocated index buffer.
       protected: size_t indexBufferCapacity;
+
+      /// \brief Consecutive calls to PrepareHardwareBuffers that used
+      /// less than a quarter of the vertex buffer.
+      protected: unsigned int vertexLowUsageCount = 0;
+
+      /// \brief Consecutive calls to PrepareHardwareBuffers that used
+      /// less than a quarter of the index buffer.
+      protected: unsigned int indexLowUsageCount = 0;
     };
     /// \}
   }
@@ -14,9 +14,9 @@
  * limitations under the License.
  *
 */
-#include <ignition/common/Profiler.hh>
 
 #include "gazebo/common/MouseEvent.hh"
+#include "gazebo/common/TraceCapture.hh"
 
 #include "gazebo/rendering/UserCamera.hh"
 #include "gazebo/rendering/FPSViewController.hh"
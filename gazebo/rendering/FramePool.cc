@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "gazebo/common/TraceCapture.hh"
+#include "gazebo/rendering/FramePool.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Private data for the FramePool class
+    class FramePoolPrivate
+    {
+      /// \brief Frames kept by the pool. A frame is free when the pool
+      /// holds the only reference to it.
+      public: std::vector<std::shared_ptr<Frame>> frames;
+
+      /// \brief Most recently filled frame. Its extra reference keeps it
+      /// from being refilled until a newer frame exists.
+      public: std::shared_ptr<Frame> latest;
+
+      /// \brief Largest number of frames kept by the pool.
+      public: unsigned int limit = 0u;
+
+      /// \brief Protects frames and latest.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+Frame::Frame()
+{
+}
+
+//////////////////////////////////////////////////
+const unsigned char *Frame::Data() const
+{
+  return this->data.data();
+}
+
+//////////////////////////////////////////////////
+size_t Frame::Size() const
+{
+  return this->size;
+}
+
+//////////////////////////////////////////////////
+unsigned int Frame::Width() const
+{
+  return this->width;
+}
+
+//////////////////////////////////////////////////
+unsigned int Frame::Height() const
+{
+  return this->height;
+}
+
+//////////////////////////////////////////////////
+unsigned int Frame::Depth() const
+{
+  return this->depth;
+}
+
+//////////////////////////////////////////////////
+const std::string &Frame::Format() const
+{
+  return this->format;
+}
+
+//////////////////////////////////////////////////
+const common::Time &Frame::Stamp() const
+{
+  return this->stamp;
+}
+
+//////////////////////////////////////////////////
+FramePool::FramePool(const unsigned int _size, const unsigned int _limit)
+  : dataPtr(new FramePoolPrivate)
+{
+  this->dataPtr->limit = std::max(_size, _limit);
+  for (unsigned int i = 0; i < _size; ++i)
+    this->dataPtr->frames.push_back(std::make_shared<Frame>());
+}
+
+//////////////////////////////////////////////////
+FramePool::~FramePool()
+{
+}
+
+//////////////////////////////////////////////////
+FramePtr FramePool::Fill(const void *_data, const size_t _size,
+    const unsigned int _width, const unsigned int _height,
+    const unsigned int _depth, const std::string &_format)
+{
+  IGN_PROFILE("rendering::FramePool::Fill");
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  std::shared_ptr<Frame> frame;
+  for (auto &f : this->dataPtr->frames)
+  {
+    if (f.use_count() == 1)
+    {
+      frame = f;
+      break;
+    }
+  }
+
+  if (!frame)
+  {
+    frame = std::make_shared<Frame>();
+    if (this->dataPtr->frames.size() < this->dataPtr->limit)
+      this->dataPtr->frames.push_back(frame);
+  }
+
+  if (frame->data.size() < _size)
+    frame->data.resize(_size);
+  if (_data && _size > 0u)
+    std::memcpy(frame->data.data(), _data, _size);
+  frame->size = _size;
+  frame->width = _width;
+  frame->height = _height;
+  frame->depth = _depth;
+  frame->format = _format;
+  frame->stamp = common::Time::GetWallTime();
+
+  this->dataPtr->latest = frame;
+  return frame;
+}
+
+//////////////////////////////////////////////////
+FramePtr FramePool::Latest() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->latest;
+}
+
+//////////////////////////////////////////////////
+unsigned int FramePool::FrameCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return static_cast<unsigned int>(this->dataPtr->frames.size());
+}
+
+//////////////////////////////////////////////////
+unsigned int FramePool::InUseCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  unsigned int count = 0u;
+  for (const auto &f : this->dataPtr->frames)
+  {
+    const long owners = f == this->dataPtr->latest ? 2 : 1;
+    if (f.use_count() > owners)
+      ++count;
+  }
+  return count;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_FRAMEPOOL_HH_
+#define GAZEBO_RENDERING_FRAMEPOOL_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    class FramePoolPrivate;
+
+    /// \addtogroup gazebo_rendering Rendering
+    /// \{
+
+    /// \class Frame FramePool.hh rendering/rendering.hh
+    /// \brief One image produced by a rendering sensor.
+    ///
+    /// Frames are handed to subscribers as a FramePtr. The frame is not
+    /// written to while any subscriber holds it, so it can be kept, queued
+    /// or published from another thread without a copy.
+    class GZ_RENDERING_VISIBLE Frame
+    {
+      /// \brief Constructor
+      public: Frame();
+
+      /// \brief Get the frame data.
+      /// \return Pointer to the first byte of the frame.
+      public: const unsigned char *Data() const;
+
+      /// \brief Get the frame data as an array of T, for example float for
+      /// depth and laser frames.
+      /// \return Pointer to the first element of the frame.
+      public: template<typename T> const T *DataAs() const
+              {
+                return reinterpret_cast<const T *>(this->data.data());
+              }
+
+      /// \brief Get the size of the frame data.
+      /// \return Size in bytes.
+      public: size_t Size() const;
+
+      /// \brief Get the frame width.
+      /// \return Width in pixels.
+      public: unsigned int Width() const;
+
+      /// \brief Get the frame height.
+      /// \return Height in pixels.
+      public: unsigned int Height() const;
+
+      /// \brief Get the number of channels per pixel.
+      /// \return Frame depth.
+      public: unsigned int Depth() const;
+
+      /// \brief Get the frame format, e.g. "R8G8B8" or "FLOAT32".
+      /// \return Format string.
+      public: const std::string &Format() const;
+
+      /// \brief Get the wall time at which the frame was filled.
+      /// \return Wall time of the frame.
+      public: const common::Time &Stamp() const;
+
+      /// \brief Frame data. Only resized when the frame is filled with a
+      /// larger image, so a pooled frame does not reallocate per update.
+      private: std::vector<unsigned char> data;
+
+      /// \brief Number of valid bytes in data.
+      private: size_t size = 0u;
+
+      /// \brief Frame width.
+      private: unsigned int width = 0u;
+
+      /// \brief Frame height.
+      private: unsigned int height = 0u;
+
+      /// \brief Frame depth.
+      private: unsigned int depth = 0u;
+
+      /// \brief Frame format.
+      private: std::string format;
+
+      /// \brief Wall time of the frame.
+      private: common::Time stamp;
+
+      /// \brief The pool fills the frames.
+      friend class FramePool;
+    };
+
+    /// \class FramePool FramePool.hh rendering/rendering.hh
+    /// \brief A small set of reusable frames handed out with shared
+    /// ownership.
+    ///
+    /// A rendering sensor fills one frame per update with Fill and passes
+    /// the returned FramePtr to its frame handle subscribers. Fill only
+    /// reuses a frame that no subscriber holds, so rendering continues into
+    /// another frame while subscribers keep older ones. When every frame is
+    /// held the pool grows up to its limit. Past the limit a frame that is
+    /// not kept by the pool is returned, so a subscriber that never
+    /// releases its frames can not make the pool grow without bound.
+    class GZ_RENDERING_VISIBLE FramePool
+    {
+      /// \brief Constructor
+      /// \param[in] _size Number of frames allocated up front.
+      /// \param[in] _limit Largest number of frames kept by the pool.
+      public: explicit FramePool(const unsigned int _size = 3u,
+                                 const unsigned int _limit = 8u);
+
+      /// \brief Destructor
+      public: ~FramePool();
+
+      /// \brief Copy an image into a frame that no subscriber holds.
+      /// \param[in] _data Image data.
+      /// \param[in] _size Size of the image data in bytes.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _depth Number of channels per pixel.
+      /// \param[in] _format Image format.
+      /// \return The filled frame.
+      public: FramePtr Fill(const void *_data, const size_t _size,
+                            const unsigned int _width,
+                            const unsigned int _height,
+                            const unsigned int _depth,
+                            const std::string &_format);
+
+      /// \brief Get the most recently filled frame.
+      /// \return The latest frame, or nullptr before the first Fill.
+      public: FramePtr Latest() const;
+
+      /// \brief Get the number of frames kept by the pool.
+      /// \return Number of frames.
+      public: unsigned int FrameCount() const;
+
+      /// \brief Get the number of frames kept by the pool that are held
+      /// outside of the pool.
+      /// \return Number of frames in use.
+      public: unsigned int InUseCount() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<FramePoolPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "test/util.hh"
+
+#include "gazebo/rendering/FramePool.hh"
+
+using namespace gazebo;
+class FramePool_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(FramePool_TEST, Fill)
+{
+  rendering::FramePool pool(2u, 3u);
+  EXPECT_EQ(pool.FrameCount(), 2u);
+  EXPECT_EQ(pool.InUseCount(), 0u);
+  EXPECT_EQ(pool.Latest(), nullptr);
+
+  std::vector<float> depth = {1.0f, 2.0f, 3.0f, 4.0f};
+  rendering::FramePtr frame = pool.Fill(depth.data(),
+      depth.size() * sizeof(float), 2u, 2u, 1u, "FLOAT32");
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(frame->Width(), 2u);
+  EXPECT_EQ(frame->Height(), 2u);
+  EXPECT_EQ(frame->Depth(), 1u);
+  EXPECT_EQ(frame->Format(), "FLOAT32");
+  EXPECT_EQ(frame->Size(), depth.size() * sizeof(float));
+  EXPECT_FLOAT_EQ(frame->DataAs<float>()[3], 4.0f);
+  EXPECT_EQ(pool.Latest(), frame);
+  EXPECT_EQ(pool.InUseCount(), 1u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(FramePool_TEST, HeldFramesAreNotOverwritten)
+{
+  rendering::FramePool pool(2u, 3u);
+
+  unsigned char image[3] = {1u, 2u, 3u};
+  rendering::FramePtr first = pool.Fill(image, 3u, 3u, 1u, 1u, "L8");
+
+  // The held frame and the latest frame are both skipped.
+  std::vector<rendering::FramePtr> held;
+  for (unsigned char i = 10u; i < 15u; ++i)
+  {
+    image[0] = i;
+    held.push_back(pool.Fill(image, 3u, 3u, 1u, 1u, "L8"));
+    EXPECT_NE(held.back(), first);
+  }
+  EXPECT_EQ(first->Data()[0], 1u);
+  for (unsigned char i = 0u; i < 5u; ++i)
+    EXPECT_EQ(held[i]->Data()[0], 10u + i);
+
+  // The pool stops growing at its limit while every frame is held.
+  EXPECT_EQ(pool.FrameCount(), 3u);
+
+  // Released frames are reused without growing the pool.
+  first.reset();
+  held.clear();
+  EXPECT_EQ(pool.InUseCount(), 0u);
+  const rendering::Frame *latest = pool.Latest().get();
+  for (int i = 0; i < 10; ++i)
+  {
+    rendering::FramePtr frame = pool.Fill(image, 3u, 3u, 1u, 1u, "L8");
+    EXPECT_NE(frame.get(), latest);
+    latest = frame.get();
+  }
+  EXPECT_EQ(pool.FrameCount(), 3u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
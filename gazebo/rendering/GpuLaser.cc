@@ -15,9 +15,10 @@
  *
 */
 
+#include <algorithm>
 #include <sstream>
+#include <vector>
 
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Color.hh>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Pose3.hh>
@@ -29,6 +30,7 @@
   #include "gazebo/common/win_dirent.h"
 #endif
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 
 #include "gazebo/common/Assert.hh"
@@ -56,7 +58,6 @@ GpuLaser::GpuLaser(const std::string &_namePrefix, ScenePtr _scene,
 : Camera(_namePrefix, _scene, _autoRender),
   dataPtr(new GpuLaserPrivate)
 {
-  this->dataPtr->laserBuffer = NULL;
   this->dataPtr->laserScan = NULL;
   this->dataPtr->matFirstPass = NULL;
   this->dataPtr->matSecondPass = NULL;
@@ -115,6 +116,15 @@ void GpuLaser::Fini()
         this->dataPtr->secondPassTexture->getName());
     this->dataPtr->secondPassTexture = nullptr;
   }
+  if (this->dataPtr->layeredTexture)
+  {
+    Ogre::TextureManager::getSingleton().remove(
+        this->dataPtr->layeredTexture->getName());
+    this->dataPtr->layeredTexture = nullptr;
+    this->dataPtr->layeredTarget = nullptr;
+  }
+  this->dataPtr->rayPixels.clear();
+  this->dataPtr->layeredBuffer.clear();
 
   if (this->dataPtr->orthoCam)
   {
@@ -126,8 +136,6 @@ void GpuLaser::Fini()
   this->dataPtr->texIdx.clear();
   this->dataPtr->texCount = 0;
 
-  delete [] this->dataPtr->laserBuffer;
-  this->dataPtr->laserBuffer = nullptr;
   delete [] this->dataPtr->laserScan;
   this->dataPtr->laserScan = nullptr;
 
@@ -139,8 +147,6 @@ void GpuLaser::CreateLaserTexture(const std::string &_textureName)
 {
   this->camera->yaw(Ogre::Radian(this->horzHalfAngle));
 
-  this->CreateOrthoCam();
-
   this->dataPtr->textureCount = this->cameraCount;
 
   if (this->dataPtr->textureCount == 2)
@@ -158,6 +164,14 @@ void GpuLaser::CreateLaserTexture(const std::string &_textureName)
     this->dataPtr->cameraYaws[3] = -this->hfov;
   }
 
+  if (this->dataPtr->singlePass)
+  {
+    this->CreateLayeredTexture(_textureName);
+    return;
+  }
+
+  this->CreateOrthoCam();
+
   for (unsigned int i = 0; i < this->dataPtr->textureCount; ++i)
   {
     std::stringstream texName;
@@ -228,6 +242,52 @@ void GpuLaser::CreateLaserTexture(const std::string &_textureName)
 //////////////////////////////////////////////////
 void GpuLaser::PostRender()
 {
+  if (this->dataPtr->singlePass)
+  {
+    this->dataPtr->layeredTarget->swapBuffers();
+
+    if (this->newData && this->captureData)
+    {
+      unsigned int width = this->dataPtr->layeredTexture->getWidth();
+      unsigned int height = this->dataPtr->layeredTexture->getHeight();
+      this->dataPtr->layeredBuffer.resize(width * height * 3);
+
+      Ogre::PixelBox dstBox(width, height, 1, Ogre::PF_FLOAT32_RGB,
+          this->dataPtr->layeredBuffer.data());
+      this->dataPtr->layeredTexture->getBuffer()->blitToMemory(dstBox);
+
+      unsigned int len = this->dataPtr->w2nd * this->dataPtr->h2nd * 3;
+      if (!this->dataPtr->laserScan)
+        this->dataPtr->laserScan = new float[len];
+
+      // Same values as the second pass shader: rays outside the first pass
+      // textures get 1 in every channel.
+      const float *src = this->dataPtr->layeredBuffer.data();
+      float *dst = this->dataPtr->laserScan;
+      for (int pixel : this->dataPtr->rayPixels)
+      {
+        if (pixel < 0)
+        {
+          dst[0] = dst[1] = dst[2] = 1.0f;
+        }
+        else
+        {
+          dst[0] = src[pixel * 3];
+          dst[1] = src[pixel * 3 + 1];
+          dst[2] = src[pixel * 3 + 2];
+        }
+        dst += 3;
+      }
+
+      this->dataPtr->newLaserFrame(this->dataPtr->laserScan,
+          this->dataPtr->w2nd, this->dataPtr->h2nd, 3, "BLABLA");
+      this->NotifyLaserFrameHandles();
+    }
+
+    this->newData = false;
+    return;
+  }
+
   for (unsigned int i = 0; i < this->dataPtr->textureCount; ++i)
   {
     this->dataPtr->firstPassTargets[i]->swapBuffers();
@@ -236,40 +296,21 @@ void GpuLaser::PostRender()
 
   if (this->newData && this->captureData)
   {
-    Ogre::HardwarePixelBufferSharedPtr pixelBuffer;
-
-    unsigned int width = this->dataPtr->secondPassViewport->getActualWidth();
-    unsigned int height = this->dataPtr->secondPassViewport->getActualHeight();
-
-    // Get access to the buffer and make an image and write it to file
-    pixelBuffer = this->dataPtr->secondPassTexture->getBuffer();
-
-    size_t size = Ogre::PixelUtil::getMemorySize(
-                    width, height, 1, Ogre::PF_FLOAT32_RGB);
-
-    // Blit the depth buffer if needed
-    if (!this->dataPtr->laserBuffer)
-      this->dataPtr->laserBuffer = new float[size];
-
-    memset(this->dataPtr->laserBuffer, 255, size);
-
-    Ogre::PixelBox dstBox(width, height,
-        1, Ogre::PF_FLOAT32_RGB, this->dataPtr->laserBuffer);
-
-    pixelBuffer->blitToMemory(dstBox);
-
     if (!this->dataPtr->laserScan)
     {
       int len = this->dataPtr->w2nd * this->dataPtr->h2nd * 3;
       this->dataPtr->laserScan = new float[len];
     }
 
-    memcpy(this->dataPtr->laserScan, this->dataPtr->laserBuffer,
-           this->dataPtr->w2nd * this->dataPtr->h2nd * 3 *
-           sizeof(this->dataPtr->laserScan[0]));
+    // The second pass texture has one pixel per ray, read it back straight
+    // into the buffer handed to the laser frame listeners.
+    Ogre::PixelBox dstBox(this->dataPtr->w2nd, this->dataPtr->h2nd,
+        1, Ogre::PF_FLOAT32_RGB, this->dataPtr->laserScan);
+    this->dataPtr->secondPassTexture->getBuffer()->blitToMemory(dstBox);
 
     this->dataPtr->newLaserFrame(this->dataPtr->laserScan, this->dataPtr->w2nd,
         this->dataPtr->h2nd, 3, "BLABLA");
+    this->NotifyLaserFrameHandles();
   }
 
   this->newData = false;
@@ -297,7 +338,11 @@ void GpuLaser::UpdateRenderTarget(Ogre::RenderTarget *_target,
 
   Ogre::AutoParamDataSource autoParamDataSource;
 
-  vp = _target->getViewport(0);
+  // The layered target of the single pass mode has one viewport per camera.
+  if (this->dataPtr->singlePass && _target == this->dataPtr->layeredTarget)
+    vp = this->dataPtr->currentViewport;
+  else
+    vp = _target->getViewport(0);
 
   // Need this line to render the ground plane. No idea why it's necessary.
   renderSys->_setViewport(vp);
@@ -317,6 +362,10 @@ void GpuLaser::UpdateRenderTarget(Ogre::RenderTarget *_target,
   pass->_updateAutoParams(&autoParamDataSource, 1);
 #endif
 
+  // Fresh noise offsets for each first pass camera
+  if (_material == this->dataPtr->matFirstPass)
+    this->dataPtr->rangeNoise.SetShaderParams(pass);
+
   if (_updateTex)
   {
     pass->getFragmentProgramParameters()->setNamedConstant("tex1",
@@ -382,7 +431,7 @@ void GpuLaser::notifyRenderSingleObject(Ogre::Renderable *_rend,
 
   Ogre::AutoParamDataSource autoParamDataSource;
 
-  Ogre::Viewport *vp = this->dataPtr->currentTarget->getViewport(0);
+  Ogre::Viewport *vp = this->dataPtr->currentViewport;
 
   renderSys->_setViewport(vp);
   autoParamDataSource.setCurrentRenderable(_rend);
@@ -423,6 +472,37 @@ void GpuLaser::RenderImpl()
   sceneMgr->_suppressRenderStateChanges(true);
   sceneMgr->addRenderObjectListener(this);
 
+  if (this->dataPtr->singlePass)
+  {
+    // All first pass cameras render into their own viewport of the layered
+    // target, within a single update of the target.
+    Ogre::RenderTarget *target = this->dataPtr->layeredTarget;
+    target->_beginUpdate();
+    for (unsigned int i = 0; i < this->dataPtr->textureCount; ++i)
+    {
+      if (this->dataPtr->textureCount > 1)
+        this->sceneNode->roll(Ogre::Radian(this->dataPtr->cameraYaws[i]));
+
+      this->dataPtr->currentMat = this->dataPtr->matFirstPass;
+      this->dataPtr->currentTarget = target;
+      this->dataPtr->currentViewport = this->dataPtr->firstPassViewports[i];
+
+      this->UpdateRenderTarget(target, this->dataPtr->matFirstPass,
+          this->camera);
+      target->_updateViewport(this->dataPtr->firstPassViewports[i], false);
+    }
+    target->_endUpdate();
+
+    if (this->dataPtr->textureCount > 1)
+      this->sceneNode->roll(Ogre::Radian(this->dataPtr->cameraYaws[3]));
+
+    sceneMgr->removeRenderObjectListener(this);
+    sceneMgr->_suppressRenderStateChanges(false);
+
+    this->dataPtr->lastRenderDuration = firstPassTimer.GetElapsed().Double();
+    return;
+  }
+
   for (unsigned int i = 0; i < this->dataPtr->textureCount; ++i)
   {
     if (this->dataPtr->textureCount > 1)
@@ -434,6 +514,7 @@ void GpuLaser::RenderImpl()
 
     this->dataPtr->currentMat = this->dataPtr->matFirstPass;
     this->dataPtr->currentTarget = this->dataPtr->firstPassTargets[i];
+    this->dataPtr->currentViewport = this->dataPtr->firstPassViewports[i];
 
     this->UpdateRenderTarget(this->dataPtr->firstPassTargets[i],
                   this->dataPtr->matFirstPass, this->camera);
@@ -472,7 +553,7 @@ GpuLaser::DataIter GpuLaser::LaserDataBegin() const
   const unsigned int rangeOffset = 0;
   // intensity data in G channel
   const unsigned int intenOffset = 1;
-  return DataIter(index, this->dataPtr->laserBuffer, skip, rangeOffset,
+  return DataIter(index, this->dataPtr->laserScan, skip, rangeOffset,
       intenOffset, this->dataPtr->w2nd);
 }
 
@@ -487,7 +568,7 @@ GpuLaser::DataIter GpuLaser::LaserDataEnd() const
   const unsigned int rangeOffset = 0;
   // intensity data in G channel
   const unsigned int intenOffset = 1;
-  return DataIter(index, this->dataPtr->laserBuffer, skip, rangeOffset,
+  return DataIter(index, this->dataPtr->laserScan, skip, rangeOffset,
       intenOffset, this->dataPtr->w2nd);
 }
 
@@ -553,14 +634,7 @@ void GpuLaser::Set1stPassTarget(Ogre::RenderTarget *_target,
     // Setup the viewport to use the texture
     this->dataPtr->firstPassViewports[_index] =
       this->dataPtr->firstPassTargets[_index]->addViewport(this->camera);
-    this->dataPtr->firstPassViewports[_index]->setClearEveryFrame(true);
-    this->dataPtr->firstPassViewports[_index]->setOverlaysEnabled(false);
-    this->dataPtr->firstPassViewports[_index]->setShadowsEnabled(false);
-    this->dataPtr->firstPassViewports[_index]->setSkiesEnabled(false);
-    this->dataPtr->firstPassViewports[_index]->setBackgroundColour(
-        Ogre::ColourValue(this->farClip, 0.0, 1.0));
-    this->dataPtr->firstPassViewports[_index]->setVisibilityMask(
-        GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE));
+    this->SetupFirstPassViewport(this->dataPtr->firstPassViewports[_index]);
   }
 
   if (_index == 0)
@@ -570,6 +644,81 @@ void GpuLaser::Set1stPassTarget(Ogre::RenderTarget *_target,
   }
 }
 
+//////////////////////////////////////////////////
+void GpuLaser::SetupFirstPassViewport(Ogre::Viewport *_viewport)
+{
+  _viewport->setClearEveryFrame(true);
+  _viewport->setOverlaysEnabled(false);
+  _viewport->setShadowsEnabled(false);
+  _viewport->setSkiesEnabled(false);
+  _viewport->setBackgroundColour(
+      Ogre::ColourValue(this->farClip, 0.0, 1.0));
+  _viewport->setVisibilityMask(
+      GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE));
+}
+
+//////////////////////////////////////////////////
+void GpuLaser::CreateLayeredTexture(const std::string &_textureName)
+{
+  unsigned int count = this->dataPtr->textureCount;
+
+  this->dataPtr->layeredTexture =
+    Ogre::TextureManager::getSingleton().createManual(
+    _textureName + "first_pass_layered", "General", Ogre::TEX_TYPE_2D,
+    this->ImageWidth() * count, this->ImageHeight(), 0,
+    Ogre::PF_FLOAT32_RGB, Ogre::TU_RENDERTARGET).getPointer();
+
+  this->dataPtr->layeredTarget =
+    this->dataPtr->layeredTexture->getBuffer()->getRenderTarget();
+  this->dataPtr->layeredTarget->setAutoUpdated(false);
+
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    Ogre::Viewport *viewport = this->dataPtr->layeredTarget->addViewport(
+        this->camera, i, static_cast<float>(i) / count, 0.0f,
+        1.0f / count, 1.0f);
+    viewport->setAutoUpdated(false);
+    this->SetupFirstPassViewport(viewport);
+    this->dataPtr->firstPassViewports[i] = viewport;
+  }
+
+  this->camera->setAspectRatio(this->RayCountRatio());
+  this->camera->setFOVy(Ogre::Radian(this->LimitFOV(this->CosVertFOV())));
+
+  this->dataPtr->matFirstPass = (Ogre::Material*)(
+  Ogre::MaterialManager::getSingleton().getByName("Gazebo/LaserScan1st").get());
+
+  this->dataPtr->matFirstPass->load();
+  this->dataPtr->matFirstPass->setCullingMode(Ogre::CULL_NONE);
+
+  // Nearest pixel of the layered texture for every ray, the same sample the
+  // second pass takes with filtering disabled.
+  std::vector<unsigned int> textures;
+  std::vector<ignition::math::Vector2d> texCoords;
+  this->RayTexCoords(textures, texCoords);
+
+  unsigned int layeredWidth = this->dataPtr->layeredTexture->getWidth();
+  this->dataPtr->rayPixels.resize(textures.size());
+  for (unsigned int k = 0; k < textures.size(); ++k)
+  {
+    const ignition::math::Vector2d &uv = texCoords[k];
+    if (uv.X() < 0.0 || uv.X() > 1.0 || uv.Y() < 0.0 || uv.Y() > 1.0)
+    {
+      this->dataPtr->rayPixels[k] = -1;
+      continue;
+    }
+
+    Ogre::Viewport *viewport = this->dataPtr->firstPassViewports[textures[k]];
+    int width = viewport->getActualWidth();
+    int height = viewport->getActualHeight();
+    int x = std::min(static_cast<int>(uv.X() * width), width - 1);
+    int y = std::min(static_cast<int>(uv.Y() * height), height - 1);
+
+    this->dataPtr->rayPixels[k] = (viewport->getActualTop() + y) *
+        layeredWidth + viewport->getActualLeft() + x;
+  }
+}
+
 //////////////////////////////////////////////////
 void GpuLaser::Set2ndPassTarget(Ogre::RenderTarget *_target)
 {
@@ -605,34 +754,11 @@ void GpuLaser::SetRangeCount(const unsigned int _w, const unsigned int _h)
 }
 
 /////////////////////////////////////////////////
-void GpuLaser::CreateMesh()
+void GpuLaser::RayTexCoords(std::vector<unsigned int> &_textures,
+    std::vector<ignition::math::Vector2d> &_texCoords) const
 {
-  std::string meshName = this->Name() + "_undistortion_mesh";
-
-  common::Mesh *mesh = new common::Mesh();
-  mesh->SetName(meshName);
-
-  common::SubMesh *submesh = new common::SubMesh();
-
-  double dx, dy;
-  submesh->SetPrimitiveType(common::SubMesh::POINTS);
-
-  if (this->dataPtr->h2nd == 1)
-  {
-    dy = 0;
-  }
-  else
-  {
-    dy = 0.1;
-  }
-
-  dx = 0.1;
-
-  // startX ranges from 0 to -(w2nd/10) at dx=0.1 increments
-  // startY ranges from h2nd/10 to 0 at dy=0.1 decrements
-  // see GpuLaser::Set2ndPassTarget() on how the ortho cam is set up
-  double startX = dx;
-  double startY = this->dataPtr->h2nd/10.0;
+  _textures.clear();
+  _texCoords.clear();
 
   // half of actual camera vertical FOV without padding
   double phi = this->VertFOV() / 2;
@@ -644,9 +770,6 @@ void GpuLaser::CreateMesh()
     phi = 0;
   }
 
-  // index of ray
-  unsigned int ptsOnLine = 0;
-
   // total laser hfov
   double thfov = this->dataPtr->textureCount * this->CosHorzFOV();
   double hstep = thfov / (this->dataPtr->w2nd - 1);
@@ -681,20 +804,6 @@ void GpuLaser::CreateMesh()
         delta -= hstep;
       }
 
-      startX -= dx;
-      if (ptsOnLine == this->dataPtr->w2nd)
-      {
-        ptsOnLine = 0;
-        startX = 0;
-        startY -= dy;
-      }
-      ptsOnLine++;
-
-      // the texture/1000.0 value is used in the laser_2nd_pass.frag shader
-      // as a trick to determine which camera texture to use when stitching
-      // together the final depth image.
-      submesh->AddVertex(texture/1000.0, startX, startY);
-
       // first compute angle from the start of current camera's horizontal
       // min angle, then set delta to be angle from center of current camera.
       delta = delta - (texture * this->CosHorzFOV());
@@ -706,9 +815,66 @@ void GpuLaser::CreateMesh()
       double v = 0.5 - (tan(gamma) * cos(theta)) /
           (2.0 * tan(phiCamera) * cos(delta));
 
-      submesh->AddTexCoord(u, v);
-      submesh->AddIndex(this->dataPtr->w2nd * j + i);
+      _textures.push_back(texture);
+      _texCoords.push_back(ignition::math::Vector2d(u, v));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void GpuLaser::CreateMesh()
+{
+  std::string meshName = this->Name() + "_undistortion_mesh";
+
+  common::Mesh *mesh = new common::Mesh();
+  mesh->SetName(meshName);
+
+  common::SubMesh *submesh = new common::SubMesh();
+
+  double dx, dy;
+  submesh->SetPrimitiveType(common::SubMesh::POINTS);
+
+  if (this->dataPtr->h2nd == 1)
+  {
+    dy = 0;
+  }
+  else
+  {
+    dy = 0.1;
+  }
+
+  dx = 0.1;
+
+  // startX ranges from 0 to -(w2nd/10) at dx=0.1 increments
+  // startY ranges from h2nd/10 to 0 at dy=0.1 decrements
+  // see GpuLaser::Set2ndPassTarget() on how the ortho cam is set up
+  double startX = dx;
+  double startY = this->dataPtr->h2nd/10.0;
+
+  // index of ray
+  unsigned int ptsOnLine = 0;
+
+  std::vector<unsigned int> textures;
+  std::vector<ignition::math::Vector2d> texCoords;
+  this->RayTexCoords(textures, texCoords);
+
+  for (unsigned int k = 0; k < textures.size(); ++k)
+  {
+    startX -= dx;
+    if (ptsOnLine == this->dataPtr->w2nd)
+    {
+      ptsOnLine = 0;
+      startX = 0;
+      startY -= dy;
     }
+    ptsOnLine++;
+
+    // the texture/1000.0 value is used in the laser_2nd_pass.frag shader
+    // as a trick to determine which camera texture to use when stitching
+    // together the final depth image.
+    submesh->AddVertex(textures[k]/1000.0, startX, startY);
+    submesh->AddTexCoord(texCoords[k].X(), texCoords[k].Y());
+    submesh->AddIndex(k);
   }
 
   mesh->AddSubMesh(submesh);
@@ -888,6 +1054,24 @@ void GpuLaser::SetRayCountRatio(const double _rayCountRatio)
   this->rayCountRatio = _rayCountRatio;
 }
 
+//////////////////////////////////////////////////
+void GpuLaser::SetRangeNoise(const RangeNoise &_noise)
+{
+  this->dataPtr->rangeNoise = _noise;
+}
+
+//////////////////////////////////////////////////
+void GpuLaser::SetSinglePass(const bool _enable)
+{
+  this->dataPtr->singlePass = _enable;
+}
+
+//////////////////////////////////////////////////
+bool GpuLaser::SinglePass() const
+{
+  return this->dataPtr->singlePass;
+}
+
 //////////////////////////////////////////////////
 event::ConnectionPtr GpuLaser::ConnectNewLaserFrame(
     std::function<void (const float *_frame, unsigned int _width,
@@ -896,3 +1080,37 @@ event::ConnectionPtr GpuLaser::ConnectNewLaserFrame(
 {
   return this->dataPtr->newLaserFrame.Connect(_subscriber);
 }
+
+//////////////////////////////////////////////////
+event::ConnectionPtr GpuLaser::ConnectNewLaserFrameHandle(
+    std::function<void (FramePtr)> _subscriber)
+{
+  return this->dataPtr->newLaserFrameHandle.Connect(_subscriber);
+}
+
+//////////////////////////////////////////////////
+FramePtr GpuLaser::LatestLaserFrame() const
+{
+  return this->dataPtr->laserFramePool.Latest();
+}
+
+//////////////////////////////////////////////////
+void GpuLaser::NotifyLaserFrameHandles()
+{
+  if (this->dataPtr->newLaserFrameHandle.ConnectionCount() == 0u)
+    return;
+
+  const unsigned int w = this->dataPtr->w2nd;
+  const unsigned int h = this->dataPtr->h2nd;
+  this->dataPtr->newLaserFrameHandle(this->dataPtr->laserFramePool.Fill(
+      this->dataPtr->laserScan, w * h * 3 * sizeof(float), w, h, 3,
+      "BLABLA"));
+}
+
+//////////////////////////////////////////////////
+unsigned int GpuLaser::FrameListenerCount() const
+{
+  return Camera::FrameListenerCount() +
+    this->dataPtr->newLaserFrame.ConnectionCount() +
+    this->dataPtr->newLaserFrameHandle.ConnectionCount();
+}
@@ -19,12 +19,16 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+
+#include <ignition/math/Vector2.hh>
 
 #include <sdf/sdf.hh>
 
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/Camera.hh"
 #include "gazebo/rendering/GpuLaserDataIterator.hh"
+#include "gazebo/rendering/RangeNoise.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/util/system.hh"
 
@@ -105,6 +109,24 @@ namespace gazebo
                   unsigned int _height, unsigned int _depth,
                   const std::string &_format)> _subscriber);
 
+      /// \brief Connect to the laser frame signal with shared ownership of
+      /// the frame. The frame holds three floats per ray, laid out like the
+      /// data of ConnectNewLaserFrame, and is not overwritten while the
+      /// subscriber holds it.
+      /// \param[in] _subscriber Callback that is called when a new frame is
+      /// generated
+      /// \return A pointer to the connection. This must be kept in scope.
+      public: event::ConnectionPtr ConnectNewLaserFrameHandle(
+                  std::function<void (FramePtr)> _subscriber);
+
+      /// \brief Get the last frame handed to the laser frame handle
+      /// subscribers.
+      /// \return The latest laser frame, or nullptr if there is none yet.
+      public: FramePtr LatestLaserFrame() const;
+
+      // Documentation inherited.
+      public: virtual unsigned int FrameListenerCount() const override;
+
       /// \brief Set the number of samples in the width and height for the
       /// first pass texture.
       /// \param[in] _w Number of samples in the horizontal sweep
@@ -112,6 +134,11 @@ namespace gazebo
       public: void SetRangeCount(const unsigned int _w,
           const unsigned int _h = 1);
 
+      /// \brief Set the noise that the first pass shader adds to the
+      /// ranges.
+      /// \param[in] _noise Noise parameters.
+      public: void SetRangeNoise(const RangeNoise &_noise);
+
       /// \internal
       /// \brief Implementation of Ogre::RenderObjectListener
       public: virtual void notifyRenderSingleObject(Ogre::Renderable *_rend,
@@ -207,6 +234,21 @@ namespace gazebo
       /// \param[in] _rayCountRatio ray count ratio (equivalent to aspect ratio)
       public: void SetRayCountRatio(const double _rayCountRatio);
 
+      /// \brief Render all first pass cameras into the viewports of a single
+      /// layered texture and resample the ranges with a lookup table built
+      /// once, instead of running the orthographic second pass. This saves
+      /// the second render, a target switch per camera and the canvas mesh.
+      /// Must be called before CreateLaserTexture. The laser data keeps the
+      /// GpuLaserDataIterator layout.
+      /// \param[in] _enable True to enable the single render pass.
+      /// \sa SinglePass()
+      public: void SetSinglePass(const bool _enable);
+
+      /// \brief Get whether the single render pass is enabled.
+      /// \return True if the single render pass is enabled.
+      /// \sa SetSinglePass(const bool _enable)
+      public: bool SinglePass() const;
+
       // Documentation inherited.
       private: virtual void RenderImpl();
 
@@ -223,12 +265,32 @@ namespace gazebo
       /// \brief Create an ortho camera.
       private: void CreateOrthoCam();
 
+      /// \brief Copy the laser scan into a pooled frame and hand it to the
+      /// laser frame handle subscribers, if there are any.
+      private: void NotifyLaserFrameHandles();
+
       /// \brief Create a mesh.
       private: void CreateMesh();
 
       /// \brief Create a canvas.
       private: void CreateCanvas();
 
+      /// \brief Compute where each ray samples the first pass textures.
+      /// \param[out] _textures Index of the first pass texture of each ray.
+      /// \param[out] _texCoords Texture coordinates of each ray. A ray with
+      /// coordinates outside [0, 1] has no range.
+      private: void RayTexCoords(std::vector<unsigned int> &_textures,
+          std::vector<ignition::math::Vector2d> &_texCoords) const;
+
+      /// \brief Create the layered first pass texture and the ray lookup
+      /// table used by the single render pass.
+      /// \param[in] _textureName Name of the texture.
+      private: void CreateLayeredTexture(const std::string &_textureName);
+
+      /// \brief Configure a first pass viewport.
+      /// \param[in] _viewport Viewport to configure.
+      private: void SetupFirstPassViewport(Ogre::Viewport *_viewport);
+
       /// \brief Builds scaled Orthogonal Matrix from parameters.
       /// \param[in] _left Left clip.
       /// \param[in] _right Right clip.
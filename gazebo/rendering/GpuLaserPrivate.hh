@@ -21,6 +21,8 @@
 #include <string>
 #include <vector>
 
+#include "gazebo/rendering/FramePool.hh"
+#include "gazebo/rendering/RangeNoise.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 
 #include "gazebo/common/Event.hh"
@@ -59,10 +61,15 @@ namespace gazebo
                    unsigned int _height, unsigned int _depth,
                    const std::string &_format)> newLaserFrame;
 
-      /// \brief Raw buffer of laser data.
-      public: float *laserBuffer;
+      /// \brief Event triggered with a pooled frame when new laser range
+      /// data are available.
+      public: event::EventT<void(FramePtr)> newLaserFrameHandle;
 
-      /// \brief Outgoing laser data, used by newLaserFrame event.
+      /// \brief Frames handed to the laser frame handle subscribers.
+      public: FramePool laserFramePool;
+
+      /// \brief Laser data, one range, retro and padding float per ray.
+      /// Used by the newLaserFrame event and the data iterators.
       public: float *laserScan;
 
       /// \brief Pointer to Ogre material for the first rendering pass.
@@ -98,6 +105,12 @@ namespace gazebo
       /// \brief Temporary pointer to the current render target.
       public: Ogre::RenderTarget *currentTarget;
 
+      /// \brief Temporary pointer to the current first pass viewport.
+      public: Ogre::Viewport *currentViewport = nullptr;
+
+      /// \brief Noise added to the ranges by the first pass shader.
+      public: RangeNoise rangeNoise;
+
       /// \brief Temporary pointer to the current material.
       public: Ogre::Material *currentMat;
 
@@ -133,6 +146,24 @@ namespace gazebo
 
       /// Number of second pass texture units created.
       public: static int texCount;
+
+      /// \brief True to render the first pass into one layered texture and
+      /// skip the second pass.
+      public: bool singlePass = false;
+
+      /// \brief Texture holding one viewport per first pass camera, used
+      /// by the single render pass.
+      public: Ogre::Texture *layeredTexture = nullptr;
+
+      /// \brief Render target of the layered texture.
+      public: Ogre::RenderTarget *layeredTarget = nullptr;
+
+      /// \brief Index of the layered texture pixel sampled by each ray, -1
+      /// for rays without a range.
+      public: std::vector<int> rayPixels;
+
+      /// \brief Pixels of the layered texture.
+      public: std::vector<float> layeredBuffer;
     };
   }
 }
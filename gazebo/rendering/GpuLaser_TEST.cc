@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
 #include "gazebo/rendering/RenderingIface.hh"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/rendering/GpuLaser.hh"
@@ -24,6 +27,52 @@
 using namespace gazebo;
 class GpuLaser_TEST : public RenderingFixture
 {
+  /// \brief Create a horizontal laser with 64 rays over 1 radian, set up
+  /// the way GpuRaySensor does it for a single camera.
+  /// \param[in] _scene Scene to create the laser in.
+  /// \param[in] _name Name of the laser.
+  /// \param[in] _singlePass True to render in a single pass.
+  /// \return The laser.
+  public: rendering::GpuLaserPtr CreateLaser(rendering::ScenePtr _scene,
+              const std::string &_name, const bool _singlePass)
+  {
+    const double hfov = 1.0;
+    const unsigned int width = 2048u;
+
+    rendering::GpuLaserPtr laserCam = _scene->CreateGpuLaser(_name, false);
+    laserCam->SetCaptureData(true);
+    laserCam->SetIsHorizontal(true);
+    laserCam->SetNearClip(0.1);
+    laserCam->SetFarClip(10.0);
+    laserCam->SetHorzHalfAngle(0.0);
+    laserCam->SetCameraCount(1u);
+    laserCam->SetHorzFOV(hfov);
+    laserCam->SetCosHorzFOV(hfov);
+    laserCam->SetVertFOV(0.0);
+    laserCam->SetVertHalfAngle(0.0);
+    laserCam->SetCosVertFOV(0.0);
+    laserCam->SetRayCountRatio(width);
+
+    sdf::ElementPtr cameraElem(new sdf::Element);
+    sdf::initFile("camera.sdf", cameraElem);
+    cameraElem->GetElement("horizontal_fov")->Set(hfov);
+    sdf::ElementPtr ptr = cameraElem->GetElement("image");
+    ptr->GetElement("width")->Set(width);
+    ptr->GetElement("height")->Set(1u);
+    ptr->GetElement("format")->Set("FLOAT32");
+    ptr = cameraElem->GetElement("clip");
+    ptr->GetElement("near")->Set(0.1);
+    ptr->GetElement("far")->Set(10.0);
+
+    laserCam->Load(cameraElem);
+    laserCam->Init();
+    laserCam->SetRangeCount(64u, 1u);
+    laserCam->SetClipDist(0.1, 10.0);
+    laserCam->SetSinglePass(_singlePass);
+    laserCam->CreateLaserTexture(_name + "_RttTex_Laser");
+    laserCam->SetWorldPose(ignition::math::Pose3d(-3, 0, 0.5, 0, 0, 0));
+    return laserCam;
+  }
 };
 
 /////////////////////////////////////////////////
@@ -81,7 +130,59 @@ TEST_F(GpuLaser_TEST, BasicGpuLaserAPITest)
 
     laserCam->SetCameraCount(4u);
     EXPECT_EQ(laserCam->CameraCount(), 4u);
+
+    EXPECT_FALSE(laserCam->SinglePass());
+    laserCam->SetSinglePass(true);
+    EXPECT_TRUE(laserCam->SinglePass());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(GpuLaser_TEST, SinglePass)
+{
+  Load("worlds/shapes.world");
+
+  rendering::ScenePtr scene = rendering::get_scene("default");
+  if (!scene)
+    scene = rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::GpuLaserPtr laserCam = this->CreateLaser(scene, "laser", false);
+  rendering::GpuLaserPtr singlePassCam =
+      this->CreateLaser(scene, "laser_single_pass", true);
+  ASSERT_TRUE(laserCam != nullptr);
+  ASSERT_TRUE(singlePassCam != nullptr);
+  EXPECT_TRUE(singlePassCam->SinglePass());
+
+  for (int i = 0; i < 10; ++i)
+  {
+    laserCam->Render(true);
+    singlePassCam->Render(true);
+    laserCam->PostRender();
+    singlePassCam->PostRender();
+  }
+
+  std::vector<double> ranges;
+  for (auto it = laserCam->LaserDataBegin(); it != laserCam->LaserDataEnd();
+       ++it)
+  {
+    ranges.push_back(it->range);
+  }
+
+  std::vector<double> singlePassRanges;
+  for (auto it = singlePassCam->LaserDataBegin();
+       it != singlePassCam->LaserDataEnd(); ++it)
+  {
+    singlePassRanges.push_back(it->range);
   }
+
+  ASSERT_EQ(ranges.size(), 64u);
+  ASSERT_EQ(singlePassRanges.size(), ranges.size());
+
+  // The middle ray hits the unit box at the origin.
+  EXPECT_NEAR(singlePassRanges[32], 2.5, 0.05);
+  for (unsigned int i = 0; i < ranges.size(); ++i)
+    EXPECT_NEAR(singlePassRanges[i], ranges[i], 1e-3);
 }
 
 /////////////////////////////////////////////////
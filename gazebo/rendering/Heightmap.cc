@@ -15,6 +15,8 @@
  *
 */
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 
 #include <string.h>
@@ -87,6 +89,7 @@ Heightmap::Heightmap(ScenePtr _scene)
 Heightmap::~Heightmap()
 {
   this->dataPtr->scene.reset();
+  this->dataPtr->clipmapTerrain.reset();
 
   if (this->dataPtr->terrainPaging)
   {
@@ -94,7 +97,7 @@ Heightmap::~Heightmap()
     this->dataPtr->pageManager->destroyWorld(this->dataPtr->world);
     OGRE_DELETE this->dataPtr->pageManager;
   }
-  else
+  else if (this->dataPtr->terrainGroup)
   {
     this->dataPtr->terrainGroup->removeAllTerrains();
 
@@ -194,6 +197,32 @@ common::Image Heightmap::Image() const
   double height = 0.0;
   unsigned char *imageData = nullptr;
 
+  if (this->dataPtr->clipmapTerrain)
+  {
+    // The GPU terrain keeps the heights as they were loaded
+    const unsigned int size = this->dataPtr->dataSize;
+    auto range = std::minmax_element(this->dataPtr->heights.begin(),
+        this->dataPtr->heights.end());
+    double minHeight = *range.first;
+    double maxHeight = std::max(*range.second - minHeight, 1e-6);
+
+    imageData = new unsigned char[size * size];
+    for (unsigned int y = 0; y < size; ++y)
+    {
+      for (unsigned int x = 0; x < size; ++x)
+      {
+        height = (this->dataPtr->heights[y * size + x] - minHeight) /
+            maxHeight;
+        imageData[(size - y - 1)*size+x] =
+          static_cast<unsigned char>(height * 255.0);
+      }
+    }
+
+    result.SetFromData(imageData, size, size, common::Image::L_INT8);
+    delete [] imageData;
+    return result;
+  }
+
   /// \todo Support multiple terrain objects
   Ogre::Terrain *terrain = this->dataPtr->terrainGroup->getTerrain(0, 0);
 
@@ -529,6 +558,68 @@ void Heightmap::Load()
     return;
   }
 
+  {
+    UserCameraPtr userCam = this->dataPtr->scene->GetUserCamera(0);
+
+    // Move the camera above the terrain only if the user did not modify the
+    // camera position in the world file
+    if (userCam && !userCam->IsCameraSetInWorldFile())
+    {
+      double h = *std::max_element(
+        &this->dataPtr->heights[0],
+        &this->dataPtr->heights[0] + this->dataPtr->heights.size());
+
+      ignition::math::Vector3d camPos(5, -5, h + 200);
+      ignition::math::Vector3d lookAt(0, 0, h);
+      auto mat = ignition::math::Matrix4d::LookAt(camPos, lookAt);
+
+      userCam->SetWorldPose(mat.Pose());
+    }
+  }
+
+  if (this->dataPtr->clipmap)
+  {
+    gzmsg << "Loading heightmap on the GPU" << std::endl;
+    common::Time time = common::Time::GetWallTime();
+
+    if (!this->dataPtr->materialName.empty())
+    {
+      gzwarn << "Heightmap material [" << this->dataPtr->materialName
+             << "] is not supported by the GPU clipmap and will be ignored"
+             << std::endl;
+    }
+
+    this->dataPtr->clipmapTerrain.reset(new HeightmapClipmap(
+        this->dataPtr->scene->OgreSceneManager(),
+        this->dataPtr->scene->Name() + "::heightmap_clipmap"));
+    this->dataPtr->clipmapTerrain->SetLayers(this->dataPtr->diffuseTextures,
+        this->dataPtr->worldSizes, this->dataPtr->blendHeight,
+        this->dataPtr->blendFade);
+
+    ignition::math::Vector3d corner(
+        this->dataPtr->terrainOrigin.X() - 0.5 * this->dataPtr->terrainSize.X(),
+        this->dataPtr->terrainOrigin.Y() - 0.5 * this->dataPtr->terrainSize.X(),
+        this->dataPtr->terrainOrigin.Z() + minElevation);
+
+    if (this->dataPtr->clipmapTerrain->Load(&this->dataPtr->heights,
+          this->dataPtr->dataSize, corner, this->dataPtr->terrainSize.X()))
+    {
+      this->dataPtr->clipmapTerrain->SetCastShadows(
+          this->dataPtr->castShadows);
+
+      gzmsg << "Heightmap loaded. Process took: "
+            <<  (common::Time::GetWallTime() - time).Double()
+            << " seconds" << std::endl;
+      return;
+    }
+
+    gzerr << "Unable to load the heightmap on the GPU, "
+          << "using the Ogre terrain instead" << std::endl;
+    this->dataPtr->clipmapTerrain.reset();
+    this->dataPtr->clipmap = false;
+  }
+
+
   boost::filesystem::path imgPath;
   boost::filesystem::path terrainName;
   boost::filesystem::path terrainDirPath;
@@ -617,26 +708,6 @@ void Heightmap::Load()
   this->dataPtr->terrainGroup->setOrigin(Conversions::Convert(origin));
   this->ConfigureTerrainDefaults();
 
-  if (!this->dataPtr->heights.empty())
-  {
-    UserCameraPtr userCam = this->dataPtr->scene->GetUserCamera(0);
-
-    // Move the camera above the terrain only if the user did not modify the
-    // camera position in the world file
-    if (userCam && !userCam->IsCameraSetInWorldFile())
-    {
-      double h = *std::max_element(
-        &this->dataPtr->heights[0],
-        &this->dataPtr->heights[0] + this->dataPtr->heights.size());
-
-      ignition::math::Vector3d camPos(5, -5, h + 200);
-      ignition::math::Vector3d lookAt(0, 0, h);
-      auto mat = ignition::math::Matrix4d::LookAt(camPos, lookAt);
-
-      userCam->SetWorldPose(mat.Pose());
-    }
-  }
-
   this->dataPtr->terrainHashChanged = this->PrepareTerrain(terrainDirPath);
 
   if (this->dataPtr->useTerrainPaging)
@@ -844,6 +915,15 @@ void Heightmap::ConfigureTerrainDefaults()
 /////////////////////////////////////////////////
 void Heightmap::SetWireframe(const bool _show)
 {
+  if (this->dataPtr->clipmapTerrain)
+  {
+    this->dataPtr->clipmapTerrain->SetWireframe(_show);
+    return;
+  }
+
+  if (!this->dataPtr->terrainGroup)
+    return;
+
   Ogre::TerrainGroup::TerrainIterator ti =
     this->dataPtr->terrainGroup->getTerrainIterator();
   while (ti.hasMoreElements())
@@ -982,10 +1062,7 @@ bool Heightmap::InitBlendMaps(Ogre::Terrain *_terrain)
 double Heightmap::Height(const double _x, const double _y, const double _z)
     const
 {
-  GZ_ASSERT(this->dataPtr->terrainGroup, "TerrainGroup pointer is NULL");
-
-  Ogre::TerrainGroup::RayResult result =
-      this->dataPtr->terrainGroup->rayIntersects(
+  Ogre::TerrainGroup::RayResult result = this->RayIntersects(
       Ogre::Ray(Ogre::Vector3(_x, _y, _z), Ogre::Vector3(0, 0, -1)));
 
   if (result.hit)
@@ -1007,7 +1084,25 @@ Ogre::TerrainGroup::RayResult Heightmap::MouseHit(CameraPtr _camera,
       _camera->OgreViewport()->getActualHeight());
 
   // The terrain uses a special ray intersection test.
-  return this->dataPtr->terrainGroup->rayIntersects(mouseRay);
+  return this->RayIntersects(mouseRay);
+}
+
+/////////////////////////////////////////////////
+Ogre::TerrainGroup::RayResult Heightmap::RayIntersects(
+    const Ogre::Ray &_ray) const
+{
+  if (this->dataPtr->clipmapTerrain)
+  {
+    ignition::math::Vector3d point;
+    bool hit = this->dataPtr->clipmapTerrain->RayIntersects(
+        Conversions::ConvertIgn(_ray.getOrigin()),
+        Conversions::ConvertIgn(_ray.getDirection()), point);
+    return Ogre::TerrainGroup::RayResult(hit, nullptr,
+        Conversions::Convert(point));
+  }
+
+  GZ_ASSERT(this->dataPtr->terrainGroup, "TerrainGroup pointer is NULL");
+  return this->dataPtr->terrainGroup->rayIntersects(_ray);
 }
 
 /////////////////////////////////////////////////
@@ -1076,23 +1171,59 @@ bool Heightmap::Lower(CameraPtr _camera,
   return terrainResult.hit;
 }
 
+/////////////////////////////////////////////////
+/// \brief Convert a world position to the terrain space of the GPU terrain,
+/// as Ogre::Terrain::getTerrainPosition does.
+/// \param[in] _origin Center of the terrain.
+/// \param[in] _size Size of one side of the terrain.
+/// \param[in] _pos World position.
+/// \return Position in terrain space, from 0 to 1 over the terrain.
+static Ogre::Vector3 ClipmapTerrainPosition(
+    const ignition::math::Vector3d &_origin, const double _size,
+    const Ogre::Vector3 &_pos)
+{
+  return Ogre::Vector3((_pos.x - _origin.X()) / _size + 0.5,
+      (_pos.y - _origin.Y()) / _size + 0.5, 0);
+}
+
 /////////////////////////////////////////////////
 double Heightmap::AvgHeight(const ignition::math::Vector3d &_pos,
     const double _radius) const
 {
-  GZ_ASSERT(this->dataPtr->terrainGroup, "TerrainGroup pointer is NULL");
-  Ogre::Terrain *terrain = this->dataPtr->terrainGroup->getTerrain(0, 0);
+  int size = 0;
+  Ogre::Vector3 pos;
+  std::function<float(int, int)> heightAt;
 
-  if (!terrain)
+  if (this->dataPtr->clipmapTerrain)
   {
-    gzerr << "Invalid heightmap position [" << _pos << "]\n";
-    return 0.0;
+    size = static_cast<int>(this->dataPtr->dataSize);
+    pos = ClipmapTerrainPosition(this->dataPtr->terrainOrigin,
+        this->dataPtr->terrainSize.X(), Conversions::Convert(_pos));
+    heightAt = [this, size](int _x, int _y)
+    {
+      _x = std::min(_x, size - 1);
+      _y = std::min(_y, size - 1);
+      return this->dataPtr->heights[_y * size + _x];
+    };
   }
+  else
+  {
+    GZ_ASSERT(this->dataPtr->terrainGroup, "TerrainGroup pointer is NULL");
+    Ogre::Terrain *terrain = this->dataPtr->terrainGroup->getTerrain(0, 0);
 
-  int size = static_cast<int>(terrain->getSize());
+    if (!terrain)
+    {
+      gzerr << "Invalid heightmap position [" << _pos << "]\n";
+      return 0.0;
+    }
 
-  Ogre::Vector3 pos;
-  terrain->getTerrainPosition(Conversions::Convert(_pos), &pos);
+    size = static_cast<int>(terrain->getSize());
+    terrain->getTerrainPosition(Conversions::Convert(_pos), &pos);
+    heightAt = [terrain](int _x, int _y)
+    {
+      return terrain->getHeightAtPoint(_x, _y);
+    };
+  }
 
   int startx = (pos.x - _radius) * size;
   int starty = (pos.y - _radius) * size;
@@ -1111,7 +1242,7 @@ double Heightmap::AvgHeight(const ignition::math::Vector3d &_pos,
   {
     for (int x = startx; x <= endx; ++x)
     {
-      sum += terrain->getHeightAtPoint(x, y);
+      sum += heightAt(x, y);
       count++;
     }
   }
@@ -1123,19 +1254,51 @@ double Heightmap::AvgHeight(const ignition::math::Vector3d &_pos,
 void Heightmap::ModifyTerrain(Ogre::Vector3 _pos, const double _outsideRadius,
     const double _insideRadius, const double _weight, const std::string &_op)
 {
-  GZ_ASSERT(this->dataPtr->terrainGroup, "TerrainGroup pointer is NULL");
-  Ogre::Terrain *terrain = this->dataPtr->terrainGroup->getTerrain(0, 0);
+  int size = 0;
+  Ogre::Vector3 pos;
+  std::function<float(int, int)> heightAt;
+  std::function<void(int, int, float)> setHeightAt;
+  Ogre::Terrain *terrain = nullptr;
 
-  if (!terrain)
+  if (this->dataPtr->clipmapTerrain)
   {
-    gzerr << "Invalid heightmap position [" << _pos << "]\n";
-    return;
+    size = static_cast<int>(this->dataPtr->dataSize);
+    pos = ClipmapTerrainPosition(this->dataPtr->terrainOrigin,
+        this->dataPtr->terrainSize.X(), _pos);
+    heightAt = [this, size](int _x, int _y)
+    {
+      _x = std::min(_x, size - 1);
+      _y = std::min(_y, size - 1);
+      return this->dataPtr->heights[_y * size + _x];
+    };
+    setHeightAt = [this, size](int _x, int _y, float _height)
+    {
+      if (_x < size && _y < size)
+        this->dataPtr->heights[_y * size + _x] = _height;
+    };
   }
+  else
+  {
+    GZ_ASSERT(this->dataPtr->terrainGroup, "TerrainGroup pointer is NULL");
+    terrain = this->dataPtr->terrainGroup->getTerrain(0, 0);
 
-  int size = static_cast<int>(terrain->getSize());
+    if (!terrain)
+    {
+      gzerr << "Invalid heightmap position [" << _pos << "]\n";
+      return;
+    }
 
-  Ogre::Vector3 pos;
-  terrain->getTerrainPosition(_pos, &pos);
+    size = static_cast<int>(terrain->getSize());
+    terrain->getTerrainPosition(_pos, &pos);
+    heightAt = [terrain](int _x, int _y)
+    {
+      return terrain->getHeightAtPoint(_x, _y);
+    };
+    setHeightAt = [terrain](int _x, int _y, float _height)
+    {
+      terrain->setHeightAtPoint(_x, _y, _height);
+    };
+  }
 
   int startx = (pos.x - _outsideRadius) * size;
   int starty = (pos.y - _outsideRadius) * size;
@@ -1151,7 +1314,11 @@ void Heightmap::ModifyTerrain(Ogre::Vector3 _pos, const double _outsideRadius,
   double avgHeight = 0;
 
   if (_op == "flatten" || _op == "smooth")
-    avgHeight = this->AvgHeight(Conversions::ConvertIgn(pos), _outsideRadius);
+  {
+    // The Ogre terrain averages around the terrain space position
+    avgHeight = this->AvgHeight(Conversions::ConvertIgn(
+        terrain ? pos : _pos), _outsideRadius);
+  }
 
   for (int y = starty; y <= endy; ++y)
   {
@@ -1170,7 +1337,7 @@ void Heightmap::ModifyTerrain(Ogre::Vector3 _pos, const double _outsideRadius,
       }
 
       float addedHeight = weight * _weight;
-      float newHeight = terrain->getHeightAtPoint(x, y);
+      float newHeight = heightAt(x, y);
 
       if (_op == "raise")
         newHeight += addedHeight;
@@ -1193,11 +1360,23 @@ void Heightmap::ModifyTerrain(Ogre::Vector3 _pos, const double _outsideRadius,
       else
         gzerr << "Unknown terrain operation[" << _op << "]\n";
 
-      terrain->setHeightAtPoint(x, y, newHeight);
+      setHeightAt(x, y, newHeight);
     }
   }
-  terrain->dirty();
-  terrain->update();
+
+  if (terrain)
+  {
+    terrain->dirty();
+    terrain->update();
+  }
+  else
+  {
+    this->dataPtr->clipmapTerrain->UpdateHeights(startx, starty, endx, endy);
+  }
+
+  // The terrain casts static shadows
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->InvalidateStaticShadows();
 }
 
 /////////////////////////////////////////////////
@@ -1282,6 +1461,26 @@ void Heightmap::SetCastShadows(const bool _value)
     this->dataPtr->terrainGlobals->setCastsDynamicShadows(
         this->dataPtr->castShadows);
   }
+  if (this->dataPtr->clipmapTerrain)
+    this->dataPtr->clipmapTerrain->SetCastShadows(this->dataPtr->castShadows);
+}
+
+/////////////////////////////////////////////////
+void Heightmap::SetClipmapEnabled(const bool _enabled)
+{
+  if (this->dataPtr->terrainGroup || this->dataPtr->clipmapTerrain)
+  {
+    gzwarn << "The heightmap is already loaded, the GPU clipmap can only be "
+           << "changed before loading" << std::endl;
+    return;
+  }
+  this->dataPtr->clipmap = _enabled;
+}
+
+/////////////////////////////////////////////////
+bool Heightmap::ClipmapEnabled() const
+{
+  return this->dataPtr->clipmap;
 }
 
 /////////////////////////////////////////////////
@@ -1294,7 +1493,7 @@ double Heightmap::SkirtLength() const
 void Heightmap::SetMaterial(const std::string &_materialName)
 {
   this->dataPtr->materialName = _materialName;
-  if (!this->dataPtr->materialName.empty() && this->dataPtr->terrainGlobals)
+  if (!this->dataPtr->materialName.empty() && this->dataPtr->terrainGroup)
     this->CreateMaterial();
 }
 
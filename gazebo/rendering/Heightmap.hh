@@ -219,6 +219,26 @@ namespace gazebo
       /// \return True if the heightmap terrain casts shadows
       public: bool CastShadows() const;
 
+      /// \brief Render the terrain with a GPU clipmap instead of the Ogre
+      /// terrain. The heights are displaced in the vertex shader, so the
+      /// terrain loads without building or caching any geometry, and its
+      /// memory does not grow with the LOD. Custom materials and shadow
+      /// receiving are not supported, and depth cameras and GPU lasers see
+      /// the terrain as flat. Must be called before Load.
+      /// \param[in] _enabled True to use the GPU clipmap.
+      /// \sa HeightmapClipmap
+      public: void SetClipmapEnabled(const bool _enabled);
+
+      /// \brief Get whether the terrain is rendered with a GPU clipmap.
+      /// \return True if the GPU clipmap is used.
+      public: bool ClipmapEnabled() const;
+
+      /// \brief Intersect a ray with the terrain.
+      /// \param[in] _ray The ray, in world coordinates.
+      /// \return The result of the intersection test.
+      public: Ogre::TerrainGroup::RayResult RayIntersects(
+                  const Ogre::Ray &_ray) const;
+
       /// \brief Create terrain material generator. There are two types:
       /// custom material generator that support user material scripts,
       /// and a default material generator that uses our own glsl shader
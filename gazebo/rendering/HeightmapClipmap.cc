@@ -0,0 +1,890 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/Conversions.hh"
+#include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/rendering/HeightmapClipmap.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Maximum number of quads per side of the node grid.
+static const unsigned int kGridSize = 32u;
+
+/// \brief LOD range of the finest level, in leaf node sizes. Each coarser
+/// level doubles the range. Must stay above 2 * sqrt(2) / (1 - kMorphStart)
+/// so that neighbouring nodes differ by one level at most.
+static const double kRangeRatio = 6.0;
+
+/// \brief Fraction of a LOD range after which the vertices start to morph
+/// to the next level.
+static const double kMorphStart = 0.5;
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    class HeightmapClipmapPrivate;
+
+    /// \brief A quadtree node selected for rendering, drawn with the shared
+    /// grid.
+    class ClipmapNode : public Ogre::Renderable
+    {
+      /// \brief Constructor.
+      /// \param[in] _terrain Terrain that owns the node.
+      public: explicit ClipmapNode(HeightmapClipmapPrivate *_terrain)
+              : terrain(_terrain) {}
+
+      // Documentation inherited
+      public: virtual const Ogre::MaterialPtr &getMaterial() const;
+
+      // Documentation inherited
+      public: virtual void getRenderOperation(Ogre::RenderOperation &_op);
+
+      // Documentation inherited
+      public: virtual void getWorldTransforms(Ogre::Matrix4 *_xform) const;
+
+      // Documentation inherited
+      public: virtual Ogre::Real getSquaredViewDepth(
+                  const Ogre::Camera *_camera) const;
+
+      // Documentation inherited
+      public: virtual const Ogre::LightList &getLights() const;
+
+      /// \brief Terrain that owns the node.
+      public: HeightmapClipmapPrivate *terrain;
+
+      /// \brief Center of the node bounds.
+      public: Ogre::Vector3 center;
+    };
+
+    /// \brief Scene object of the terrain. Selects the quadtree nodes to
+    /// render for each camera.
+    class ClipmapTerrainObject : public Ogre::MovableObject
+    {
+      /// \brief Constructor.
+      /// \param[in] _name Name of the object.
+      /// \param[in] _terrain Terrain that owns the object.
+      public: ClipmapTerrainObject(const std::string &_name,
+                  HeightmapClipmapPrivate *_terrain)
+              : Ogre::MovableObject(_name), terrain(_terrain) {}
+
+      // Documentation inherited
+      public: virtual const Ogre::String &getMovableType() const;
+
+      // Documentation inherited
+      public: virtual const Ogre::AxisAlignedBox &getBoundingBox() const;
+
+      // Documentation inherited
+      public: virtual Ogre::Real getBoundingRadius() const;
+
+      // Documentation inherited
+      public: virtual void _notifyCurrentCamera(Ogre::Camera *_camera);
+
+      // Documentation inherited
+      public: virtual void _updateRenderQueue(Ogre::RenderQueue *_queue);
+
+      // Documentation inherited
+      public: virtual void visitRenderables(
+                  Ogre::Renderable::Visitor *_visitor,
+                  bool _debugRenderables = false);
+
+      /// \brief Terrain that owns the object.
+      public: HeightmapClipmapPrivate *terrain;
+    };
+
+    /// \internal
+    /// \brief Private data of HeightmapClipmap.
+    class HeightmapClipmapPrivate
+    {
+      /// \brief Get a height sample, clamped to the terrain.
+      /// \param[in] _x Column of the sample.
+      /// \param[in] _y Row of the sample.
+      /// \return The height, without the height offset.
+      public: float Sample(int _x, int _y) const
+      {
+        const int last = static_cast<int>(this->dataSize) - 1;
+        _x = ignition::math::clamp(_x, 0, last);
+        _y = ignition::math::clamp(_y, 0, last);
+        return (*this->heights)[_y * this->dataSize + _x];
+      }
+
+      /// \brief Get the bounds of a node.
+      /// \param[in] _level Level of the node, 0 for the leaves.
+      /// \param[in] _x Column of the node in its level.
+      /// \param[in] _y Row of the node in its level.
+      /// \return The bounds.
+      public: Ogre::AxisAlignedBox NodeBox(const unsigned int _level,
+                  const unsigned int _x, const unsigned int _y) const
+      {
+        const unsigned int count = this->leafCount >> _level;
+        const std::pair<float, float> &bound =
+            this->bounds[_level][_y * count + _x];
+        const double size = this->NodeSize(_level);
+        const double x = this->origin.x + _x * size;
+        const double y = this->origin.y + _y * size;
+        return Ogre::AxisAlignedBox(x, y, this->origin.z + bound.first,
+            x + size, y + size, this->origin.z + bound.second);
+      }
+
+      /// \brief Get the size of the nodes of a level.
+      /// \param[in] _level The level.
+      /// \return Size of one side of the nodes.
+      public: double NodeSize(const unsigned int _level) const
+      {
+        return this->gridSize * this->spacing * (1u << _level);
+      }
+
+      /// \brief Update the height bounds of the nodes over a region.
+      /// \param[in] _x0 First column of the region.
+      /// \param[in] _y0 First row of the region.
+      /// \param[in] _x1 Last column of the region.
+      /// \param[in] _y1 Last row of the region.
+      public: void UpdateBounds(const unsigned int _x0,
+                  const unsigned int _y0, const unsigned int _x1,
+                  const unsigned int _y1);
+
+      /// \brief Select the nodes to render for a camera.
+      /// \param[in] _camera Camera that renders the terrain. Its LOD camera
+      /// is the viewer.
+      public: void Select(Ogre::Camera *_camera);
+
+      /// \brief Select a node or its children.
+      /// \param[in] _camera Camera that renders the terrain.
+      /// \param[in] _eye Position of the viewer.
+      /// \param[in] _level Level of the node.
+      /// \param[in] _x Column of the node in its level.
+      /// \param[in] _y Row of the node in its level.
+      public: void SelectNode(const Ogre::Camera *_camera,
+                  const Ogre::Vector3 &_eye, const unsigned int _level,
+                  const unsigned int _x, const unsigned int _y);
+
+      /// \brief Find the closest intersection of a ray with a node.
+      /// \param[in] _ray The ray.
+      /// \param[in] _level Level of the node.
+      /// \param[in] _x Column of the node in its level.
+      /// \param[in] _y Row of the node in its level.
+      /// \param[in,out] _best Distance to the closest intersection so far.
+      public: void IntersectNode(const Ogre::Ray &_ray,
+                  const unsigned int _level, const unsigned int _x,
+                  const unsigned int _y, Ogre::Real &_best) const;
+
+      /// \brief Set the terrain parameters of a pass.
+      /// \param[in] _pass The pass.
+      public: void SetPassParams(Ogre::Pass *_pass) const;
+
+      /// \brief Scene manager that renders the terrain.
+      public: Ogre::SceneManager *manager = nullptr;
+
+      /// \brief Name of the terrain.
+      public: std::string name;
+
+      /// \brief Heights of the terrain.
+      public: const std::vector<float> *heights = nullptr;
+
+      /// \brief Number of heights per side.
+      public: unsigned int dataSize = 0u;
+
+      /// \brief Minimum corner of the terrain, and height offset.
+      public: Ogre::Vector3 origin = Ogre::Vector3::ZERO;
+
+      /// \brief Size of one side of the terrain.
+      public: double size = 0.0;
+
+      /// \brief Distance between two height samples.
+      public: double spacing = 0.0;
+
+      /// \brief Number of quads per side of the node grid.
+      public: unsigned int gridSize = kGridSize;
+
+      /// \brief Number of leaf nodes per side.
+      public: unsigned int leafCount = 0u;
+
+      /// \brief Number of levels of the quadtree.
+      public: unsigned int levelCount = 0u;
+
+      /// \brief LOD range of each level.
+      public: std::vector<double> ranges;
+
+      /// \brief Distances over which the vertices of each level morph.
+      public: std::vector<std::pair<double, double>> morphs;
+
+      /// \brief Minimum and maximum height of each node, by level then row.
+      public: std::vector<std::vector<std::pair<float, float>>> bounds;
+
+      /// \brief Bounds of the whole terrain.
+      public: Ogre::AxisAlignedBox box;
+
+      /// \brief Geometry of the node grid.
+      public: Ogre::RenderOperation renderOp;
+
+      /// \brief Heights on the GPU.
+      public: Ogre::TexturePtr heightTexture;
+
+      /// \brief Material of the terrain.
+      public: Ogre::MaterialPtr material;
+
+      /// \brief Shadow caster material of the terrain.
+      public: Ogre::MaterialPtr casterMaterial;
+
+      /// \brief Scene object of the terrain.
+      public: std::unique_ptr<ClipmapTerrainObject> object;
+
+      /// \brief Scene node of the terrain.
+      public: Ogre::SceneNode *node = nullptr;
+
+      /// \brief Pool of nodes, the first selectedCount ones are rendered.
+      public: std::vector<std::unique_ptr<ClipmapNode>> nodes;
+
+      /// \brief Number of nodes selected for the current camera.
+      public: unsigned int selectedCount = 0u;
+
+      /// \brief Diffuse textures of the layers.
+      public: std::vector<std::string> textures;
+
+      /// \brief World size of the layer textures.
+      public: std::vector<double> worldSizes;
+
+      /// \brief Heights at which the layers start.
+      public: std::vector<double> blendHeights;
+
+      /// \brief Heights over which the layers fade in.
+      public: std::vector<double> blendFades;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+const Ogre::MaterialPtr &ClipmapNode::getMaterial() const
+{
+  return this->terrain->material;
+}
+
+/////////////////////////////////////////////////
+void ClipmapNode::getRenderOperation(Ogre::RenderOperation &_op)
+{
+  _op = this->terrain->renderOp;
+}
+
+/////////////////////////////////////////////////
+void ClipmapNode::getWorldTransforms(Ogre::Matrix4 *_xform) const
+{
+  *_xform = this->terrain->object->_getParentNodeFullTransform();
+}
+
+/////////////////////////////////////////////////
+Ogre::Real ClipmapNode::getSquaredViewDepth(const Ogre::Camera *_camera) const
+{
+  return (this->center - _camera->getDerivedPosition()).squaredLength();
+}
+
+/////////////////////////////////////////////////
+const Ogre::LightList &ClipmapNode::getLights() const
+{
+  return this->terrain->object->queryLights();
+}
+
+/////////////////////////////////////////////////
+const Ogre::String &ClipmapTerrainObject::getMovableType() const
+{
+  static const Ogre::String type = "GazeboClipmapTerrain";
+  return type;
+}
+
+/////////////////////////////////////////////////
+const Ogre::AxisAlignedBox &ClipmapTerrainObject::getBoundingBox() const
+{
+  return this->terrain->box;
+}
+
+/////////////////////////////////////////////////
+Ogre::Real ClipmapTerrainObject::getBoundingRadius() const
+{
+  return this->terrain->box.getHalfSize().length();
+}
+
+/////////////////////////////////////////////////
+void ClipmapTerrainObject::_notifyCurrentCamera(Ogre::Camera *_camera)
+{
+  Ogre::MovableObject::_notifyCurrentCamera(_camera);
+  this->terrain->Select(_camera);
+}
+
+/////////////////////////////////////////////////
+void ClipmapTerrainObject::_updateRenderQueue(Ogre::RenderQueue *_queue)
+{
+  for (unsigned int i = 0; i < this->terrain->selectedCount; ++i)
+  {
+    _queue->addRenderable(this->terrain->nodes[i].get(), this->mRenderQueueID,
+        OGRE_RENDERABLE_DEFAULT_PRIORITY);
+  }
+}
+
+/////////////////////////////////////////////////
+void ClipmapTerrainObject::visitRenderables(
+    Ogre::Renderable::Visitor *_visitor, bool /*_debugRenderables*/)
+{
+  for (auto &node : this->terrain->nodes)
+    _visitor->visit(node.get(), 0, false);
+}
+
+/////////////////////////////////////////////////
+void HeightmapClipmapPrivate::UpdateBounds(const unsigned int _x0,
+    const unsigned int _y0, const unsigned int _x1, const unsigned int _y1)
+{
+  // A sample on the edge of a leaf belongs to both leaves
+  unsigned int lx0 = _x0 > 0 ? (_x0 - 1) / this->gridSize : 0;
+  unsigned int ly0 = _y0 > 0 ? (_y0 - 1) / this->gridSize : 0;
+  unsigned int lx1 = std::min(_x1 / this->gridSize, this->leafCount - 1);
+  unsigned int ly1 = std::min(_y1 / this->gridSize, this->leafCount - 1);
+
+  for (unsigned int ly = ly0; ly <= ly1; ++ly)
+  {
+    for (unsigned int lx = lx0; lx <= lx1; ++lx)
+    {
+      float minHeight = std::numeric_limits<float>::max();
+      float maxHeight = std::numeric_limits<float>::lowest();
+      for (unsigned int y = 0; y <= this->gridSize; ++y)
+      {
+        const float *row = &(*this->heights)[
+            (ly * this->gridSize + y) * this->dataSize + lx * this->gridSize];
+        for (unsigned int x = 0; x <= this->gridSize; ++x)
+        {
+          minHeight = std::min(minHeight, row[x]);
+          maxHeight = std::max(maxHeight, row[x]);
+        }
+      }
+      this->bounds[0][ly * this->leafCount + lx] =
+          std::make_pair(minHeight, maxHeight);
+    }
+  }
+
+  for (unsigned int level = 1; level < this->levelCount; ++level)
+  {
+    lx0 /= 2;
+    ly0 /= 2;
+    lx1 /= 2;
+    ly1 /= 2;
+    const unsigned int count = this->leafCount >> level;
+    const auto &children = this->bounds[level - 1];
+    for (unsigned int y = ly0; y <= ly1; ++y)
+    {
+      for (unsigned int x = lx0; x <= lx1; ++x)
+      {
+        std::pair<float, float> bound = children[2 * y * 2 * count + 2 * x];
+        for (unsigned int i = 1; i < 4; ++i)
+        {
+          const std::pair<float, float> &child =
+              children[(2 * y + i / 2) * 2 * count + 2 * x + i % 2];
+          bound.first = std::min(bound.first, child.first);
+          bound.second = std::max(bound.second, child.second);
+        }
+        this->bounds[level][y * count + x] = bound;
+      }
+    }
+  }
+
+  const auto &root = this->bounds[this->levelCount - 1][0];
+  this->box.setExtents(this->origin.x, this->origin.y,
+      this->origin.z + root.first, this->origin.x + this->size,
+      this->origin.y + this->size, this->origin.z + root.second);
+}
+
+/////////////////////////////////////////////////
+void HeightmapClipmapPrivate::Select(Ogre::Camera *_camera)
+{
+  this->selectedCount = 0u;
+  if (this->levelCount == 0u)
+    return;
+
+  // Shadow cameras have the viewer as their LOD camera, so that the shadows
+  // are cast by the same nodes as the rendered terrain
+  const Ogre::Camera *viewer = _camera->getLodCamera();
+  this->SelectNode(_camera, viewer->getDerivedPosition(),
+      this->levelCount - 1, 0, 0);
+}
+
+/////////////////////////////////////////////////
+void HeightmapClipmapPrivate::SelectNode(const Ogre::Camera *_camera,
+    const Ogre::Vector3 &_eye, const unsigned int _level,
+    const unsigned int _x, const unsigned int _y)
+{
+  const Ogre::AxisAlignedBox nodeBox = this->NodeBox(_level, _x, _y);
+  if (!_camera->isVisible(nodeBox))
+    return;
+
+  if (_level > 0 && Ogre::Math::intersects(
+        Ogre::Sphere(_eye, this->ranges[_level - 1]), nodeBox))
+  {
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      this->SelectNode(_camera, _eye, _level - 1, 2 * _x + i % 2,
+          2 * _y + i / 2);
+    }
+    return;
+  }
+
+  if (this->selectedCount == this->nodes.size())
+    this->nodes.emplace_back(new ClipmapNode(this));
+
+  ClipmapNode *node = this->nodes[this->selectedCount++].get();
+  const double nodeSize = this->NodeSize(_level);
+  node->setCustomParameter(0, Ogre::Vector4(
+        this->origin.x + _x * nodeSize, this->origin.y + _y * nodeSize,
+        nodeSize, _level));
+  node->setCustomParameter(1, Ogre::Vector4(
+        this->morphs[_level].first, this->morphs[_level].second, 0, 0));
+  node->setCustomParameter(2, Ogre::Vector4(_eye.x, _eye.y, _eye.z, 1));
+  node->center = nodeBox.getCenter();
+}
+
+/////////////////////////////////////////////////
+void HeightmapClipmapPrivate::IntersectNode(const Ogre::Ray &_ray,
+    const unsigned int _level, const unsigned int _x, const unsigned int _y,
+    Ogre::Real &_best) const
+{
+  std::pair<bool, Ogre::Real> hit =
+      Ogre::Math::intersects(_ray, this->NodeBox(_level, _x, _y));
+  if (!hit.first || hit.second >= _best)
+    return;
+
+  if (_level > 0)
+  {
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      this->IntersectNode(_ray, _level - 1, 2 * _x + i % 2,
+          2 * _y + i / 2, _best);
+    }
+    return;
+  }
+
+  // Same triangles as the node grid
+  for (unsigned int j = 0; j < this->gridSize; ++j)
+  {
+    for (unsigned int i = 0; i < this->gridSize; ++i)
+    {
+      const int x = _x * this->gridSize + i;
+      const int y = _y * this->gridSize + j;
+      const double px = this->origin.x + x * this->spacing;
+      const double py = this->origin.y + y * this->spacing;
+      const Ogre::Vector3 v00(px, py, this->origin.z + this->Sample(x, y));
+      const Ogre::Vector3 v10(px + this->spacing, py,
+          this->origin.z + this->Sample(x + 1, y));
+      const Ogre::Vector3 v11(px + this->spacing, py + this->spacing,
+          this->origin.z + this->Sample(x + 1, y + 1));
+      const Ogre::Vector3 v01(px, py + this->spacing,
+          this->origin.z + this->Sample(x, y + 1));
+
+      for (const auto &tri : {Ogre::Math::intersects(_ray, v00, v10, v11),
+                              Ogre::Math::intersects(_ray, v00, v11, v01)})
+      {
+        if (tri.first && tri.second >= 0 && tri.second < _best)
+          _best = tri.second;
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void HeightmapClipmapPrivate::SetPassParams(Ogre::Pass *_pass) const
+{
+  const Ogre::Vector4 terrainParams(this->origin.x, this->origin.y,
+      this->size, this->gridSize);
+  const Ogre::Vector4 heightParams(this->origin.z, this->dataSize, 0, 0);
+
+  Ogre::GpuProgramParametersSharedPtr params[] = {
+      _pass->getVertexProgramParameters(),
+      _pass->getFragmentProgramParameters()};
+  for (auto &p : params)
+  {
+    p->setIgnoreMissingParams(true);
+    p->setNamedConstant("terrainParams", terrainParams);
+    p->setNamedConstant("heightParams", heightParams);
+  }
+}
+
+/////////////////////////////////////////////////
+HeightmapClipmap::HeightmapClipmap(Ogre::SceneManager *_manager,
+    const std::string &_name)
+  : dataPtr(new HeightmapClipmapPrivate)
+{
+  this->dataPtr->manager = _manager;
+  this->dataPtr->name = _name;
+}
+
+/////////////////////////////////////////////////
+HeightmapClipmap::~HeightmapClipmap()
+{
+  if (this->dataPtr->node)
+  {
+    this->dataPtr->node->detachAllObjects();
+    this->dataPtr->manager->destroySceneNode(this->dataPtr->node);
+    this->dataPtr->node = nullptr;
+  }
+  this->dataPtr->object.reset();
+  this->dataPtr->nodes.clear();
+
+  OGRE_DELETE this->dataPtr->renderOp.vertexData;
+  OGRE_DELETE this->dataPtr->renderOp.indexData;
+
+  if (!this->dataPtr->material.isNull())
+  {
+    Ogre::MaterialManager::getSingleton().remove(
+        this->dataPtr->material->getName());
+  }
+  if (!this->dataPtr->casterMaterial.isNull())
+  {
+    Ogre::MaterialManager::getSingleton().remove(
+        this->dataPtr->casterMaterial->getName());
+  }
+  if (!this->dataPtr->heightTexture.isNull())
+  {
+    Ogre::TextureManager::getSingleton().remove(
+        this->dataPtr->heightTexture->getName());
+  }
+}
+
+/////////////////////////////////////////////////
+void HeightmapClipmap::SetLayers(const std::vector<std::string> &_textures,
+    const std::vector<double> &_worldSizes,
+    const std::vector<double> &_blendHeights,
+    const std::vector<double> &_blendFades)
+{
+  this->dataPtr->textures = _textures;
+  this->dataPtr->worldSizes = _worldSizes;
+  this->dataPtr->blendHeights = _blendHeights;
+  this->dataPtr->blendFades = _blendFades;
+}
+
+/////////////////////////////////////////////////
+bool HeightmapClipmap::Load(const std::vector<float> *_heights,
+    const unsigned int _dataSize, const ignition::math::Vector3d &_min,
+    const double _size)
+{
+  if (this->dataPtr->levelCount > 0u)
+    return true;
+
+  if (!_heights || _dataSize < 3u ||
+      !ignition::math::isPowerOfTwo(_dataSize - 1) ||
+      _heights->size() < static_cast<size_t>(_dataSize) * _dataSize)
+  {
+    gzerr << "Invalid heights for the GPU terrain" << std::endl;
+    return false;
+  }
+
+  Ogre::MaterialPtr baseMaterial =
+      Ogre::MaterialManager::getSingleton().getByName(
+      "Gazebo/ClipmapTerrain");
+  Ogre::MaterialPtr baseCaster =
+      Ogre::MaterialManager::getSingleton().getByName(
+      "Gazebo/ClipmapTerrainCaster");
+  if (baseMaterial.isNull() || baseCaster.isNull())
+  {
+    gzerr << "Unable to find the GPU terrain materials" << std::endl;
+    return false;
+  }
+
+  this->dataPtr->heights = _heights;
+  this->dataPtr->dataSize = _dataSize;
+  this->dataPtr->origin = Conversions::Convert(_min);
+  this->dataPtr->size = _size;
+  this->dataPtr->spacing = _size / (_dataSize - 1);
+  this->dataPtr->gridSize = std::min(kGridSize, _dataSize - 1);
+  this->dataPtr->leafCount = (_dataSize - 1) / this->dataPtr->gridSize;
+
+  this->dataPtr->levelCount = 1u;
+  while ((1u << (this->dataPtr->levelCount - 1)) < this->dataPtr->leafCount)
+    ++this->dataPtr->levelCount;
+
+  // LOD ranges, the coarsest level is never subdivided
+  const double leafSize = this->dataPtr->NodeSize(0);
+  double previous = 0.0;
+  for (unsigned int level = 0; level < this->dataPtr->levelCount; ++level)
+  {
+    const double range = kRangeRatio * leafSize * (1u << level);
+    this->dataPtr->ranges.push_back(range);
+    if (level + 1 < this->dataPtr->levelCount)
+    {
+      this->dataPtr->morphs.push_back(std::make_pair(
+          previous + kMorphStart * (range - previous), range));
+    }
+    else
+    {
+      this->dataPtr->morphs.push_back(std::make_pair(
+          std::numeric_limits<float>::max() * 0.5,
+          std::numeric_limits<float>::max()));
+    }
+    previous = range;
+  }
+
+  this->dataPtr->bounds.resize(this->dataPtr->levelCount);
+  for (unsigned int level = 0; level < this->dataPtr->levelCount; ++level)
+  {
+    const unsigned int count = this->dataPtr->leafCount >> level;
+    this->dataPtr->bounds[level].resize(count * count);
+  }
+  this->dataPtr->UpdateBounds(0, 0, _dataSize - 1, _dataSize - 1);
+
+  // Grid shared by all the nodes
+  const unsigned int m = this->dataPtr->gridSize;
+  Ogre::VertexData *vertexData = OGRE_NEW Ogre::VertexData();
+  vertexData->vertexStart = 0;
+  vertexData->vertexCount = (m + 1) * (m + 1);
+  vertexData->vertexDeclaration->addElement(0, 0, Ogre::VET_FLOAT2,
+      Ogre::VES_POSITION);
+
+  std::vector<float> vertices;
+  vertices.reserve(vertexData->vertexCount * 2);
+  for (unsigned int j = 0; j <= m; ++j)
+  {
+    for (unsigned int i = 0; i <= m; ++i)
+    {
+      vertices.push_back(i);
+      vertices.push_back(j);
+    }
+  }
+
+  Ogre::HardwareVertexBufferSharedPtr vbuf =
+      Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
+      vertexData->vertexDeclaration->getVertexSize(0),
+      vertexData->vertexCount, Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+  vbuf->writeData(0, vbuf->getSizeInBytes(), &vertices[0], true);
+  vertexData->vertexBufferBinding->setBinding(0, vbuf);
+
+  std::vector<uint16_t> indices;
+  indices.reserve(m * m * 6);
+  for (unsigned int j = 0; j < m; ++j)
+  {
+    for (unsigned int i = 0; i < m; ++i)
+    {
+      const uint16_t v00 = j * (m + 1) + i;
+      const uint16_t v10 = v00 + 1;
+      const uint16_t v01 = v00 + m + 1;
+      const uint16_t v11 = v01 + 1;
+      indices.insert(indices.end(), {v00, v10, v11, v00, v11, v01});
+    }
+  }
+
+  Ogre::IndexData *indexData = OGRE_NEW Ogre::IndexData();
+  indexData->indexStart = 0;
+  indexData->indexCount = indices.size();
+  indexData->indexBuffer =
+      Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
+      Ogre::HardwareIndexBuffer::IT_16BIT, indexData->indexCount,
+      Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+  indexData->indexBuffer->writeData(0,
+      indexData->indexBuffer->getSizeInBytes(), &indices[0], true);
+
+  this->dataPtr->renderOp.operationType =
+      Ogre::RenderOperation::OT_TRIANGLE_LIST;
+  this->dataPtr->renderOp.useIndexes = true;
+  this->dataPtr->renderOp.vertexData = vertexData;
+  this->dataPtr->renderOp.indexData = indexData;
+
+  // Heights, uploaded once
+  this->dataPtr->heightTexture =
+      Ogre::TextureManager::getSingleton().createManual(
+      this->dataPtr->name + "_heights",
+      Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+      Ogre::TEX_TYPE_2D, _dataSize, _dataSize, 0, Ogre::PF_FLOAT32_R,
+      Ogre::TU_DEFAULT);
+  this->UpdateHeights(0, 0, _dataSize - 1, _dataSize - 1);
+
+  // Materials
+  this->dataPtr->material = baseMaterial->clone(
+      this->dataPtr->name + "_material");
+  this->dataPtr->casterMaterial = baseCaster->clone(
+      this->dataPtr->name + "_caster");
+
+  const std::string &heightName = this->dataPtr->heightTexture->getName();
+  Ogre::Pass *pass = this->dataPtr->material->getTechnique(0)->getPass(0);
+  pass->getTextureUnitState(0)->setTextureName(heightName);
+  pass->getTextureUnitState(1)->setTextureName(heightName);
+
+  const unsigned int layerCount = std::min<size_t>(3u,
+      std::min(this->dataPtr->textures.size(),
+      this->dataPtr->worldSizes.size()));
+  Ogre::Vector4 layerSizes(1, 1, 1, 1);
+  Ogre::Vector4 blendHeights(0, 0, 0, 0);
+  Ogre::Vector4 blendFades(1, 1, 1, 1);
+  for (unsigned int i = 0; i < layerCount; ++i)
+  {
+    pass->getTextureUnitState(2 + i)->setTextureName(
+        this->dataPtr->textures[i]);
+    layerSizes[i] = std::max(this->dataPtr->worldSizes[i], 1e-6);
+
+    // The blend of layer i + 1 is at index i, as for the Ogre terrain
+    if (i > 0 && i - 1 < this->dataPtr->blendHeights.size() &&
+        i - 1 < this->dataPtr->blendFades.size())
+    {
+      blendHeights[i] = this->dataPtr->blendHeights[i - 1];
+      blendFades[i] = this->dataPtr->blendFades[i - 1];
+    }
+  }
+
+  this->dataPtr->SetPassParams(pass);
+  Ogre::GpuProgramParametersSharedPtr fpParams =
+      pass->getFragmentProgramParameters();
+  fpParams->setNamedConstant("layerSizes", layerSizes);
+  fpParams->setNamedConstant("blendHeights", blendHeights);
+  fpParams->setNamedConstant("blendFades", blendFades);
+  fpParams->setNamedConstant("layerCount",
+      static_cast<Ogre::Real>(std::max(layerCount, 1u)));
+
+  Ogre::Pass *casterPass =
+      this->dataPtr->casterMaterial->getTechnique(0)->getPass(0);
+  casterPass->getTextureUnitState(0)->setTextureName(heightName);
+  this->dataPtr->SetPassParams(casterPass);
+
+  this->dataPtr->material->load();
+  this->dataPtr->casterMaterial->load();
+
+  // Scene object
+  this->dataPtr->object.reset(new ClipmapTerrainObject(
+      this->dataPtr->name, this->dataPtr.get()));
+  this->dataPtr->object->setQueryFlags(0);
+  this->dataPtr->object->setVisibilityFlags(
+      (GZ_VISIBILITY_ALL & ~GZ_VISIBILITY_SELECTABLE) |
+      GZ_VISIBILITY_STATIC);
+  this->dataPtr->node =
+      this->dataPtr->manager->getRootSceneNode()->createChildSceneNode(
+      this->dataPtr->name + "_node");
+  this->dataPtr->node->attachObject(this->dataPtr->object.get());
+  this->SetCastShadows(false);
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+double HeightmapClipmap::Height(const double _x, const double _y) const
+{
+  if (this->dataPtr->levelCount == 0u)
+    return 0.0;
+
+  const double u = (_x - this->dataPtr->origin.x) / this->dataPtr->spacing;
+  const double v = (_y - this->dataPtr->origin.y) / this->dataPtr->spacing;
+  const double last = this->dataPtr->dataSize - 1;
+  if (u < 0 || v < 0 || u > last || v > last)
+    return this->dataPtr->origin.z;
+
+  const int x = std::min(static_cast<int>(u), static_cast<int>(last) - 1);
+  const int y = std::min(static_cast<int>(v), static_cast<int>(last) - 1);
+  const double fx = u - x;
+  const double fy = v - y;
+
+  // Interpolate on the same triangles as the node grid
+  const double h00 = this->dataPtr->Sample(x, y);
+  const double h11 = this->dataPtr->Sample(x + 1, y + 1);
+  double height;
+  if (fx > fy)
+  {
+    const double h10 = this->dataPtr->Sample(x + 1, y);
+    height = h00 + fx * (h10 - h00) + fy * (h11 - h10);
+  }
+  else
+  {
+    const double h01 = this->dataPtr->Sample(x, y + 1);
+    height = h00 + fy * (h01 - h00) + fx * (h11 - h01);
+  }
+  return this->dataPtr->origin.z + height;
+}
+
+/////////////////////////////////////////////////
+bool HeightmapClipmap::RayIntersects(const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_direction,
+    ignition::math::Vector3d &_point) const
+{
+  if (this->dataPtr->levelCount == 0u)
+    return false;
+
+  const Ogre::Ray ray(Conversions::Convert(_origin),
+      Conversions::Convert(_direction.Normalized()));
+  Ogre::Real best = std::numeric_limits<Ogre::Real>::max();
+  this->dataPtr->IntersectNode(ray, this->dataPtr->levelCount - 1, 0, 0,
+      best);
+  if (best == std::numeric_limits<Ogre::Real>::max())
+    return false;
+
+  _point = Conversions::ConvertIgn(ray.getPoint(best));
+  return true;
+}
+
+/////////////////////////////////////////////////
+void HeightmapClipmap::UpdateHeights(unsigned int _x0, unsigned int _y0,
+    unsigned int _x1, unsigned int _y1)
+{
+  if (this->dataPtr->heightTexture.isNull())
+    return;
+
+  const unsigned int last = this->dataPtr->dataSize - 1;
+  _x1 = std::min(_x1, last);
+  _y1 = std::min(_y1, last);
+  if (_x0 > _x1 || _y0 > _y1)
+    return;
+
+  Ogre::PixelBox heights(this->dataPtr->dataSize, this->dataPtr->dataSize,
+      1, Ogre::PF_FLOAT32_R,
+      const_cast<float *>(&(*this->dataPtr->heights)[0]));
+  Ogre::Image::Box region(_x0, _y0, _x1 + 1, _y1 + 1);
+  this->dataPtr->heightTexture->getBuffer()->blitFromMemory(
+      heights.getSubVolume(region), region);
+
+  this->dataPtr->UpdateBounds(_x0, _y0, _x1, _y1);
+}
+
+/////////////////////////////////////////////////
+void HeightmapClipmap::SetWireframe(const bool _show)
+{
+  if (this->dataPtr->material.isNull())
+    return;
+
+  this->dataPtr->material->getTechnique(0)->getPass(0)->setPolygonMode(
+      _show ? Ogre::PM_WIREFRAME : Ogre::PM_SOLID);
+}
+
+/////////////////////////////////////////////////
+void HeightmapClipmap::SetCastShadows(const bool _value)
+{
+  if (!this->dataPtr->object)
+    return;
+
+  this->dataPtr->object->setCastShadows(_value);
+
+  // The default caster pass would render the flat grid
+  this->dataPtr->material->getTechnique(0)->setShadowCasterMaterial(
+      _value ? this->dataPtr->casterMaterial : Ogre::MaterialPtr());
+}
+
+/////////////////////////////////////////////////
+unsigned int HeightmapClipmap::LevelCount() const
+{
+  return this->dataPtr->levelCount;
+}
+
+/////////////////////////////////////////////////
+unsigned int HeightmapClipmap::SelectedNodeCount() const
+{
+  return this->dataPtr->selectedCount;
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_HEIGHTMAPCLIPMAP_HH_
+#define GAZEBO_RENDERING_HEIGHTMAPCLIPMAP_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace Ogre
+{
+  class SceneManager;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    class HeightmapClipmapPrivate;
+
+    /// \addtogroup gazebo_rendering
+    /// \{
+
+    /// \class HeightmapClipmap HeightmapClipmap.hh rendering/rendering.hh
+    /// \brief Heightmap terrain displaced on the GPU.
+    ///
+    /// The heights are uploaded once to a floating point texture. The
+    /// terrain is a quadtree whose nodes are all drawn with the same small
+    /// grid, scaled to the size of the node and displaced in the vertex
+    /// shader. The nodes are selected per camera so that the grid spacing
+    /// doubles with each LOD range away from the viewer, and the vertices
+    /// morph smoothly between levels. Unlike the Ogre terrain, nothing is
+    /// generated or cached on the CPU besides per node height bounds, so
+    /// the load time and the geometry memory do not depend on the size of
+    /// the terrain.
+    /// \sa Heightmap::SetClipmapEnabled
+    class GZ_RENDERING_VISIBLE HeightmapClipmap
+    {
+      /// \brief Constructor.
+      /// \param[in] _manager Scene manager that renders the terrain.
+      /// \param[in] _name Unique name of the terrain.
+      public: HeightmapClipmap(Ogre::SceneManager *_manager,
+                  const std::string &_name);
+
+      /// \brief Destructor.
+      public: ~HeightmapClipmap();
+
+      /// \brief Set the diffuse layers of the terrain. At most three layers
+      /// are rendered. Must be called before Load.
+      /// \param[in] _textures Diffuse texture of each layer.
+      /// \param[in] _worldSizes World size of each texture.
+      /// \param[in] _blendHeights Height at which each layer after the
+      /// first one starts.
+      /// \param[in] _blendFades Height over which each layer after the
+      /// first one fades in.
+      public: void SetLayers(const std::vector<std::string> &_textures,
+                  const std::vector<double> &_worldSizes,
+                  const std::vector<double> &_blendHeights,
+                  const std::vector<double> &_blendFades);
+
+      /// \brief Create the terrain.
+      /// \param[in] _heights Heights of the terrain, row by row from the
+      /// minimum y. Must stay valid as long as the terrain.
+      /// \param[in] _dataSize Number of heights per side, 2^n+1.
+      /// \param[in] _min Minimum corner of the terrain, the z value is added
+      /// to all the heights.
+      /// \param[in] _size Size of one side of the terrain.
+      /// \return True if the terrain was created.
+      public: bool Load(const std::vector<float> *_heights,
+                  const unsigned int _dataSize,
+                  const ignition::math::Vector3d &_min, const double _size);
+
+      /// \brief Get the height of the terrain at a location, interpolated
+      /// between the samples.
+      /// \param[in] _x X location.
+      /// \param[in] _y Y location.
+      /// \return Height of the terrain, or the height offset outside of it.
+      public: double Height(const double _x, const double _y) const;
+
+      /// \brief Intersect a ray with the terrain.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _direction Direction of the ray.
+      /// \param[out] _point First intersection with the terrain.
+      /// \return True if the ray hits the terrain.
+      public: bool RayIntersects(const ignition::math::Vector3d &_origin,
+                  const ignition::math::Vector3d &_direction,
+                  ignition::math::Vector3d &_point) const;
+
+      /// \brief Upload a modified region of the heights to the GPU.
+      /// \param[in] _x0 First column of the region.
+      /// \param[in] _y0 First row of the region.
+      /// \param[in] _x1 Last column of the region.
+      /// \param[in] _y1 Last row of the region.
+      public: void UpdateHeights(unsigned int _x0, unsigned int _y0,
+                  unsigned int _x1, unsigned int _y1);
+
+      /// \brief Show the terrain as a wireframe.
+      /// \param[in] _show True to show the wireframe.
+      public: void SetWireframe(const bool _show);
+
+      /// \brief Set whether the terrain casts shadows.
+      /// \param[in] _value True to cast shadows.
+      public: void SetCastShadows(const bool _value);
+
+      /// \brief Get the number of LOD levels of the quadtree.
+      /// \return Number of levels, 0 if the terrain is not loaded.
+      public: unsigned int LevelCount() const;
+
+      /// \brief Get the number of nodes selected for the last camera that
+      /// rendered the terrain.
+      /// \return Number of nodes.
+      public: unsigned int SelectedNodeCount() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<HeightmapClipmapPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -17,12 +17,14 @@
 #ifndef _GAZEBO_RENDERING_HEIGHTMAPPRIVATE_HH_
 #define _GAZEBO_RENDERING_HEIGHTMAPPRIVATE_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <boost/filesystem.hpp>
 
 #include <ignition/math/Vector3.hh>
 
+#include "gazebo/rendering/HeightmapClipmap.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 
 #if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR >= 11
@@ -400,7 +402,7 @@ namespace gazebo
       public: Ogre::TerrainGlobalOptions *terrainGlobals = nullptr;
 
       /// \brief Group of terrains.
-      public: Ogre::TerrainGroup *terrainGroup;
+      public: Ogre::TerrainGroup *terrainGroup = nullptr;
 
       /// \brief True if the terrain was imported.
       public: bool terrainsImported;
@@ -483,6 +485,14 @@ namespace gazebo
       /// for paging and also when heighmap is too large for LOD to work.
       public: unsigned int numTerrainSubdivisions = 16u;
 
+      /// \brief True to render the terrain with the GPU clipmap instead
+      /// of the Ogre terrain.
+      public: bool clipmap = false;
+
+      /// \brief GPU terrain, used instead of the terrain group when the
+      /// clipmap is enabled.
+      public: std::unique_ptr<HeightmapClipmap> clipmapTerrain;
+
       /// \brief Event connections
       public: std::vector<event::ConnectionPtr> connections;
     };
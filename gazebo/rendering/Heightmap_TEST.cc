@@ -114,6 +114,67 @@ TEST_F(Heightmap_TEST, LOD)
   EXPECT_EQ(heightmap->LOD(), 0u);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test loading a terrain with the GPU clipmap
+TEST_F(Heightmap_TEST, Clipmap)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene("default");
+  ASSERT_TRUE(scene != nullptr);
+
+  gazebo::rendering::Heightmap *heightmap =
+      new gazebo::rendering::Heightmap(scene);
+
+  // test basic API
+  EXPECT_FALSE(heightmap->ClipmapEnabled());
+  heightmap->SetClipmapEnabled(true);
+  EXPECT_TRUE(heightmap->ClipmapEnabled());
+
+  msgs::Visual msg;
+  msg.set_name("heightmap_visual");
+  msg.set_parent_name("heightmap_visual_parent");
+  auto geomMsg = msg.mutable_geometry();
+  msgs::Set(geomMsg->mutable_heightmap()->mutable_size(),
+      ignition::math::Vector3d(129, 129, 10));
+  geomMsg->mutable_heightmap()->set_filename(
+      "file://media/materials/textures/heightmap_bowl.png");
+
+  auto visMsg = new ConstVisualPtr(&msg);
+  heightmap->LoadFromMsg(*visMsg);
+
+  // No Ogre terrain is created
+  EXPECT_TRUE(heightmap->OgreTerrain() == nullptr);
+  EXPECT_TRUE(heightmap->ClipmapEnabled());
+
+  // Cannot be changed once loaded
+  heightmap->SetClipmapEnabled(false);
+  EXPECT_TRUE(heightmap->ClipmapEnabled());
+
+  unsigned int vertSize = (129 * 2) - 1;
+  common::Image img = heightmap->Image();
+  EXPECT_EQ(img.GetWidth(), vertSize);
+  EXPECT_EQ(img.GetHeight(), vertSize);
+
+  // The bowl is lower in the middle than near the edges
+  double center = heightmap->Height(0, 0, 100);
+  double edge = heightmap->Height(60, 60, 100);
+  EXPECT_GE(center, 0.0);
+  EXPECT_LE(edge, 10.0 + 1e-3);
+  EXPECT_LT(center, edge);
+
+  // Rays hit the terrain at the same height
+  Ogre::TerrainGroup::RayResult result = heightmap->RayIntersects(
+      Ogre::Ray(Ogre::Vector3(0, 0, 100), Ogre::Vector3(0, 0, -1)));
+  EXPECT_TRUE(result.hit);
+  EXPECT_NEAR(result.position.z, center, 1e-3);
+
+  // Outside of the terrain
+  EXPECT_DOUBLE_EQ(heightmap->Height(500, 500, 100), 0.0);
+
+  delete heightmap;
+}
+
 #ifdef HAVE_GDAL
 /////////////////////////////////////////////////
 /// \brief Test Loading a terrain from a DEM file
@@ -15,14 +15,18 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+
 #include <boost/bind/bind.hpp>
-#include <ignition/common/Profiler.hh>
 
 #include "gazebo/common/MeshManager.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/transport/transport.hh"
 
 #include "gazebo/rendering/Conversions.hh"
 #include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/UserCamera.hh"
 #include "gazebo/rendering/DynamicLines.hh"
 #include "gazebo/rendering/LaserVisualPrivate.hh"
 #include "gazebo/rendering/LaserVisual.hh"
@@ -30,6 +34,40 @@
 using namespace gazebo;
 using namespace rendering;
 
+/// \brief Scans per second received while the visual is shown.
+static const double kScanRate = 10.0;
+
+/// \brief Smallest distance on the screen between two drawn rays, in
+/// pixels.
+static const double kMinRaySpacing = 2.0;
+
+/////////////////////////////////////////////////
+/// \brief Get how many rays to advance between two drawn rays.
+/// \param[in] _step Angle between two rays, in radians.
+/// \param[in] _pixelsPerRadian Screen distance between the ends of rays
+/// one radian apart.
+/// \return One to draw every ray, more to skip rays.
+static unsigned int RayStride(const double _step,
+    const double _pixelsPerRadian)
+{
+  const double spacing = std::fabs(_step) * _pixelsPerRadian;
+  if (spacing <= 0 || spacing >= kMinRaySpacing)
+    return 1u;
+  return static_cast<unsigned int>(std::ceil(kMinRaySpacing / spacing));
+}
+
+/////////////////////////////////////////////////
+/// \brief Subscription quality of service of the laser visual.
+/// \return Reduced rate, newest scan only.
+static transport::SubscriptionQoS ScanQoS()
+{
+  transport::SubscriptionQoS qos;
+  qos.maxRate = kScanRate;
+  qos.keepLatest = true;
+  qos.queueDepth = 1;
+  return qos;
+}
+
 /////////////////////////////////////////////////
 LaserVisual::LaserVisual(const std::string &_name, VisualPtr _vis,
                          const std::string &_topicName)
@@ -45,8 +83,9 @@ LaserVisual::LaserVisual(const std::string &_name, VisualPtr _vis,
   dPtr->node = transport::NodePtr(new transport::Node());
   dPtr->node->Init(dPtr->scene->Name());
 
+  dPtr->topicName = _topicName;
   dPtr->laserScanSub = dPtr->node->Subscribe(_topicName,
-      &LaserVisual::OnScan, this);
+      &LaserVisual::OnScan, this, ScanQoS());
 
   dPtr->connection = event::Events::ConnectPreRender(
         boost::bind(&LaserVisual::Update, this));
@@ -58,22 +97,17 @@ LaserVisual::~LaserVisual()
   LaserVisualPrivate *dPtr =
       reinterpret_cast<LaserVisualPrivate *>(this->dataPtr);
 
-  for (auto ray : dPtr->rayStrips)
-    this->DeleteDynamicLine(ray);
-
-  for (auto ray : dPtr->noHitRayStrips)
-    this->DeleteDynamicLine(ray);
-
-  for (auto ray : dPtr->deadzoneRayFans)
-    this->DeleteDynamicLine(ray);
-
-  for (auto ray : dPtr->rayLines)
-    this->DeleteDynamicLine(ray);
+  for (auto ray : {dPtr->rayStrip, dPtr->noHitRayStrip, dPtr->deadzoneRays,
+      dPtr->rayLines})
+  {
+    if (ray)
+      this->DeleteDynamicLine(ray);
+  }
 
-  dPtr->rayStrips.clear();
-  dPtr->noHitRayStrips.clear();
-  dPtr->deadzoneRayFans.clear();
-  dPtr->rayLines.clear();
+  dPtr->rayStrip = nullptr;
+  dPtr->noHitRayStrip = nullptr;
+  dPtr->deadzoneRays = nullptr;
+  dPtr->rayLines = nullptr;
 }
 
 /////////////////////////////////////////////////
@@ -107,61 +141,91 @@ void LaserVisual::Update()
   if (!dPtr->laserMsg || !dPtr->receivedMsg)
     return;
 
+  // New data changes the frame of views that render on change.
+  if (dPtr->scene)
+    dPtr->scene->MarkChanged();
+
   dPtr->receivedMsg = false;
 
-  double verticalAngle = dPtr->laserMsg->scan().vertical_angle_min();
+  // Create the render objects on the first scan
+  if (!dPtr->rayLines)
+  {
+    // The ray strip fills in-between the ray lines in areas that have
+    // intersected an object.
+    dPtr->rayStrip =
+        this->CreateDynamicLine(rendering::RENDERING_TRIANGLE_STRIP);
+    GZ_OGRE_SET_MATERIAL_BY_NAME(dPtr->rayStrip, "Gazebo/BlueLaser");
+
+    // The no hit ray strip fills in-between the ray lines in areas that
+    // have not intersected an object.
+    dPtr->noHitRayStrip =
+        this->CreateDynamicLine(rendering::RENDERING_TRIANGLE_STRIP);
+    GZ_OGRE_SET_MATERIAL_BY_NAME(dPtr->noHitRayStrip,
+        "Gazebo/LightBlueLaser");
+
+    // Deadzone rays display areas that are between the sensor's origin
+    // and start of the rays.
+    dPtr->deadzoneRays =
+        this->CreateDynamicLine(rendering::RENDERING_TRIANGLE_LIST);
+    GZ_OGRE_SET_MATERIAL_BY_NAME(dPtr->deadzoneRays,
+        "Gazebo/BlackTransparent");
+
+    // Individual ray lines
+    dPtr->rayLines = this->CreateDynamicLine(rendering::RENDERING_LINE_LIST);
+    GZ_OGRE_SET_MATERIAL_BY_NAME(dPtr->rayLines, "Gazebo/BlueLaser");
+
+    this->SetVisibilityFlags(GZ_VISIBILITY_GUI);
+  }
+
+  const msgs::LaserScan &scan = dPtr->laserMsg->scan();
+
   ignition::math::Pose3d offset =
-    msgs::ConvertIgn(dPtr->laserMsg->scan().world_pose()) - this->WorldPose();
+    msgs::ConvertIgn(scan.world_pose()) - this->WorldPose();
 
-  unsigned int vertCount = dPtr->laserMsg->scan().has_vertical_count() ?
-      dPtr->laserMsg->scan().vertical_count() : 1u;
+  unsigned int vertCount = scan.has_vertical_count() ?
+      scan.vertical_count() : 1u;
+  unsigned int count = scan.count();
 
-  double minRange = dPtr->laserMsg->scan().range_min();
+  double minRange = scan.range_min();
 
-  // Process each ray fan
-  for (unsigned int j = 0; j < vertCount; ++j)
+  // Skip rays that would be drawn closer than kMinRaySpacing pixels at
+  // their maximum range.
+  unsigned int stride = 1u;
+  unsigned int vertStride = 1u;
+  if (this->GetScene()->UserCameraCount() > 0u)
   {
-    // Create a new render objects, if there are not enough already allocated.
-    if (j+1 > dPtr->rayStrips.size())
-    {
-      // Ray strips fill in-between the ray lines in areas that have
-      // intersected an object.
-      dPtr->rayStrips.push_back(
-          this->CreateDynamicLine(rendering::RENDERING_TRIANGLE_STRIP));
-      GZ_OGRE_SET_MATERIAL_BY_NAME(dPtr->rayStrips[j], "Gazebo/BlueLaser");
-
-      // No hit ray strips fill in-between the ray lines in areas that have
-      // not intersected an object.
-      dPtr->noHitRayStrips.push_back(
-          this->CreateDynamicLine(rendering::RENDERING_TRIANGLE_STRIP));
-      GZ_OGRE_SET_MATERIAL_BY_NAME(dPtr->noHitRayStrips[j],
-          "Gazebo/LightBlueLaser");
-
-      // Deadzone ray fans display areas that are between the sensor's origin
-      // and start of the rays.
-      dPtr->deadzoneRayFans.push_back(
-          this->CreateDynamicLine(rendering::RENDERING_TRIANGLE_FAN));
-      GZ_OGRE_SET_MATERIAL_BY_NAME(dPtr->deadzoneRayFans[j],
-          "Gazebo/BlackTransparent");
-      dPtr->deadzoneRayFans[j]->AddPoint(ignition::math::Vector3d(0, 0, 0));
-
-      // Individual ray lines
-      dPtr->rayLines.push_back(
-          this->CreateDynamicLine(rendering::RENDERING_LINE_LIST));
-      GZ_OGRE_SET_MATERIAL_BY_NAME(dPtr->rayLines[j], "Gazebo/BlueLaser");
-
-      this->SetVisibilityFlags(GZ_VISIBILITY_GUI);
-    }
-    dPtr->deadzoneRayFans[j]->SetPoint(0, offset.Pos());
+    UserCameraPtr camera = this->GetScene()->GetUserCamera(0);
+    const double distance = std::max(0.1,
+        camera->WorldPosition().Distance(this->WorldPose().Pos()));
+    const double reach = std::isfinite(scan.range_max()) ?
+        std::min(scan.range_max(), distance) : distance;
+    const double pixelsPerMeter = camera->ViewportWidth() /
+        (2.0 * distance * std::tan(camera->HFOV().Radian() * 0.5));
+
+    stride = RayStride(scan.angle_step(), reach * pixelsPerMeter);
+    vertStride = RayStride(scan.vertical_angle_step(),
+        reach * pixelsPerMeter);
+  }
 
-    double angle = dPtr->laserMsg->scan().angle_min();
-    unsigned int count = dPtr->laserMsg->scan().count();
+  dPtr->rayStrip->Clear();
+  dPtr->noHitRayStrip->Clear();
+  dPtr->deadzoneRays->Clear();
+  dPtr->rayLines->Clear();
+
+  // Process each ray fan
+  for (unsigned int j = 0; j < vertCount; j += vertStride)
+  {
+    double verticalAngle = scan.vertical_angle_min() +
+        j * scan.vertical_angle_step();
 
     // Process each ray in the current scan.
-    for (unsigned int i = 0; i < count; ++i)
+    ignition::math::Vector3d prevStartPt;
+    for (unsigned int i = 0; i < count; i += stride)
     {
+      double angle = scan.angle_min() + i * scan.angle_step();
+
       // Calculate the range of the ray
-      double r = dPtr->laserMsg->scan().ranges(j*count + i);
+      double r = scan.ranges(j*count + i);
       if (r < minRange)
       {
         // Less than min range, don't display a ray
@@ -185,44 +249,71 @@ void LaserVisual::Update()
       // Compute the end point of the ray
       ignition::math::Vector3d pt = (axis * hitRange) + offset.Pos();
 
-      double noHitRange = inf ? dPtr->laserMsg->scan().range_max() : hitRange;
+      double noHitRange = inf ? scan.range_max() : hitRange;
 
       // Compute the end point of the no-hit ray
       ignition::math::Vector3d noHitPt = (axis * noHitRange) + offset.Pos();
 
-      // Draw the lines and strips that represent each simulated ray
-      if (i >= dPtr->rayLines[j]->GetPointCount()/2)
+      // Join the strips of two fans with degenerate triangles. Each ray
+      // adds two points, so the winding of the next fan is kept.
+      if (i == 0 && dPtr->rayStrip->GetPointCount() > 0)
       {
-        dPtr->rayLines[j]->AddPoint(startPt);
-        dPtr->rayLines[j]->AddPoint(inf ? noHitPt : pt);
-
-        dPtr->rayStrips[j]->AddPoint(startPt);
-        dPtr->rayStrips[j]->AddPoint(inf ? startPt : pt);
+        dPtr->rayStrip->AddPoint(
+            dPtr->rayStrip->Point(dPtr->rayStrip->GetPointCount() - 1));
+        dPtr->rayStrip->AddPoint(startPt);
 
-        dPtr->noHitRayStrips[j]->AddPoint(startPt);
-        dPtr->noHitRayStrips[j]->AddPoint(inf ? noHitPt : pt);
+        dPtr->noHitRayStrip->AddPoint(dPtr->noHitRayStrip->Point(
+            dPtr->noHitRayStrip->GetPointCount() - 1));
+        dPtr->noHitRayStrip->AddPoint(startPt);
       }
-      else
-      {
-        dPtr->rayLines[j]->SetPoint(i*2, startPt);
-        dPtr->rayLines[j]->SetPoint(i*2+1, inf ? noHitPt : pt);
 
-        dPtr->rayStrips[j]->SetPoint(i*2, startPt);
-        dPtr->rayStrips[j]->SetPoint(i*2+1, inf ? startPt : pt);
+      // Draw the lines and strips that represent each simulated ray
+      dPtr->rayLines->AddPoint(startPt);
+      dPtr->rayLines->AddPoint(inf ? noHitPt : pt);
 
-        dPtr->noHitRayStrips[j]->SetPoint(i*2, startPt);
-        dPtr->noHitRayStrips[j]->SetPoint(i*2+1, inf ? noHitPt : pt);
-      }
+      dPtr->rayStrip->AddPoint(startPt);
+      dPtr->rayStrip->AddPoint(inf ? startPt : pt);
 
-      // Draw the triangle fan that indicates the dead zone.
-      if (i+1 >= dPtr->deadzoneRayFans[j]->GetPointCount())
-        dPtr->deadzoneRayFans[j]->AddPoint(startPt);
-      else
-        dPtr->deadzoneRayFans[j]->SetPoint(i+1, startPt);
+      dPtr->noHitRayStrip->AddPoint(startPt);
+      dPtr->noHitRayStrip->AddPoint(inf ? noHitPt : pt);
 
-      angle += dPtr->laserMsg->scan().angle_step();
+      // Draw the triangles that indicate the dead zone.
+      if (i > 0)
+      {
+        dPtr->deadzoneRays->AddPoint(offset.Pos());
+        dPtr->deadzoneRays->AddPoint(prevStartPt);
+        dPtr->deadzoneRays->AddPoint(startPt);
+      }
+      prevStartPt = startPt;
     }
-    verticalAngle += dPtr->laserMsg->scan().vertical_angle_step();
+  }
+
+  dPtr->rayStrip->Update();
+  dPtr->noHitRayStrip->Update();
+  dPtr->deadzoneRays->Update();
+  dPtr->rayLines->Update();
+}
+
+/////////////////////////////////////////////////
+void LaserVisual::SetVisible(bool _visible, bool _cascade)
+{
+  Visual::SetVisible(_visible, _cascade);
+
+  LaserVisualPrivate *dPtr =
+      reinterpret_cast<LaserVisualPrivate *>(this->dataPtr);
+
+  // Only receive scans while they are shown
+  boost::mutex::scoped_lock lock(dPtr->mutex);
+  if (!_visible)
+  {
+    dPtr->laserScanSub.reset();
+    dPtr->laserMsg.reset();
+    dPtr->receivedMsg = false;
+  }
+  else if (!dPtr->laserScanSub && dPtr->node)
+  {
+    dPtr->laserScanSub = dPtr->node->Subscribe(dPtr->topicName,
+        &LaserVisual::OnScan, this, ScanQoS());
   }
 }
 
@@ -34,7 +34,10 @@ namespace gazebo
     /// \{
 
     /// \class LaserVisual LaserVisual.hh rendering/rendering.hh
-    /// \brief Visualization for laser data.
+    /// \brief Visualization for laser data. All the rays of the sensor are
+    /// drawn with one line list and three triangle batches. Rays closer
+    /// than two pixels on the screen of the user camera are skipped, and
+    /// scans are received at a reduced rate while the visual is shown.
     class GZ_RENDERING_VISIBLE LaserVisual : public Visual
     {
       /// \brief Constructor.
@@ -51,6 +54,10 @@ namespace gazebo
       public: virtual void SetEmissive(const ignition::math::Color &_color,
           const bool _cascade = true) override;
 
+      // Documentation inherited
+      public: virtual void SetVisible(bool _visible, bool _cascade = true)
+          override;
+
       /// \brief Callback when laser data is received.
       private: void OnScan(ConstLaserScanStampedPtr &_msg);
 
@@ -17,7 +17,7 @@
 #ifndef GAZEBO_RENDERING_LASERVISUAL_PRIVATE_HH_
 #define GAZEBO_RENDERING_LASERVISUAL_PRIVATE_HH_
 
-#include <vector>
+#include <string>
 
 #include "gazebo/msgs/MessageTypes.hh"
 #include "gazebo/transport/TransportTypes.hh"
@@ -38,18 +38,22 @@ namespace gazebo
       /// \brief Subscription to the laser data.
       public: transport::SubscriberPtr laserScanSub;
 
-      /// \brief Renders the laser data as a triangle strip.
-      public: std::vector<DynamicLines *> rayStrips;
+      /// \brief Name of the topic that has laser data.
+      public: std::string topicName;
+
+      /// \brief Renders the laser data of all the vertical layers as one
+      /// triangle strip.
+      public: DynamicLines *rayStrip = nullptr;
 
       /// \brief Renders laser data for rays that do not hit obstacles.
-      public: std::vector<DynamicLines *> noHitRayStrips;
+      public: DynamicLines *noHitRayStrip = nullptr;
 
       /// \brief Renders a deadzone that is between the sensor's origin
-      /// and start of the rays.
-      public: std::vector<DynamicLines *> deadzoneRayFans;
+      /// and start of the rays, as a triangle list.
+      public: DynamicLines *deadzoneRays = nullptr;
 
       /// \brief Renders the laser data as a line list.
-      public: std::vector<DynamicLines *> rayLines;
+      public: DynamicLines *rayLines = nullptr;
 
       /// \brief Mutex to protect the contact message.
       public: boost::mutex mutex;
@@ -17,9 +17,8 @@
 
 #include <mutex>
 
-#include <ignition/common/Profiler.hh>
-
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/TraceCapture.hh"
 
 #include "gazebo/transport/Node.hh"
 
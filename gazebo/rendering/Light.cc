@@ -15,8 +15,7 @@
  *
 */
 
-#include <ignition/common/Profiler.hh>
-
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 
 #include "gazebo/msgs/msgs.hh"
@@ -160,6 +159,9 @@ void Light::UpdateFromMsg(ConstLightPtr &_msg)
 {
   this->UpdateSDFFromMsg(*_msg);
 
+  if (_msg->has_shadow_priority())
+    this->SetShadowPriority(_msg->shadow_priority());
+
   this->Update();
 
   if (_msg->has_pose())
@@ -177,6 +179,9 @@ void Light::LoadFromMsg(const msgs::Light &_msg)
 
   this->UpdateSDFFromMsg(_msg);
 
+  if (_msg.has_shadow_priority())
+    this->SetShadowPriority(_msg.shadow_priority());
+
   this->Load();
 
   if (_msg.has_pose())
@@ -575,6 +580,8 @@ void Light::SetRange(const double _range)
 //////////////////////////////////////////////////
 void Light::SetCastShadows(const bool _cast)
 {
+  const bool changed = this->dataPtr->castShadows != _cast;
+  this->dataPtr->castShadows = _cast;
 
   if (this->dataPtr->light->getType() == Ogre::Light::LT_DIRECTIONAL)
   {
@@ -585,37 +592,78 @@ void Light::SetCastShadows(const bool _cast)
   else if (this->dataPtr->light->getType() == Ogre::Light::LT_SPOTLIGHT)
   {
     // use different shadow camera for spot light
-    this->dataPtr->light->setCastShadows(_cast);
+    this->dataPtr->light->setCastShadows(
+        _cast && this->dataPtr->shadowActive);
     if (_cast && this->dataPtr->shadowCameraSetup.isNull())
     {
       this->dataPtr->shadowCameraSetup =
           Ogre::ShadowCameraSetupPtr(new Ogre::DefaultShadowCameraSetup());
       this->dataPtr->light->setCustomShadowCameraSetup(
           this->dataPtr->shadowCameraSetup);
-      RTShaderSystem::Instance()->UpdateShadows();
     }
   }
   else if (this->dataPtr->light->getType() == Ogre::Light::LT_POINT)
   {
     // use different shadow camera for point light
-    this->dataPtr->light->setCastShadows(_cast);
+    this->dataPtr->light->setCastShadows(
+        _cast && this->dataPtr->shadowActive);
     if (_cast && this->dataPtr->shadowCameraSetup.isNull())
     {
       this->dataPtr->shadowCameraSetup =
           Ogre::ShadowCameraSetupPtr(new PointLightShadowCameraSetup());
       this->dataPtr->light->setCustomShadowCameraSetup(
           this->dataPtr->shadowCameraSetup);
-      RTShaderSystem::Instance()->UpdateShadows();
     }
   }
   else
   {
+    this->dataPtr->castShadows = false;
     this->dataPtr->light->setCastShadows(false);
   }
+
+  // The number of shadow textures depends on the lights casting shadows.
+  if (changed)
+    RTShaderSystem::Instance()->UpdateShadows();
 }
 
 //////////////////////////////////////////////////
 bool Light::CastShadows() const
+{
+  if (this->dataPtr->light)
+    return this->dataPtr->castShadows;
+
+  return false;
+}
+
+//////////////////////////////////////////////////
+void Light::SetShadowPriority(const double _priority)
+{
+  this->dataPtr->shadowPriority = _priority;
+}
+
+//////////////////////////////////////////////////
+double Light::ShadowPriority() const
+{
+  return this->dataPtr->shadowPriority;
+}
+
+//////////////////////////////////////////////////
+void Light::SetShadowActive(const bool _active)
+{
+  if (this->dataPtr->shadowActive == _active)
+    return;
+
+  this->dataPtr->shadowActive = _active;
+  if (this->dataPtr->light &&
+      this->dataPtr->light->getType() != Ogre::Light::LT_DIRECTIONAL)
+  {
+    this->dataPtr->light->setCastShadows(
+        this->dataPtr->castShadows && _active);
+  }
+}
+
+//////////////////////////////////////////////////
+bool Light::ShadowActive() const
 {
   if (this->dataPtr->light)
     return this->dataPtr->light->getCastShadows();
@@ -689,7 +737,8 @@ void Light::FillMsg(msgs::Light &_msg) const
   msgs::Set(_msg.mutable_specular(), this->SpecularColor());
   msgs::Set(_msg.mutable_direction(), this->Direction());
 
-  _msg.set_cast_shadows(this->dataPtr->light->getCastShadows());
+  _msg.set_cast_shadows(this->CastShadows());
+  _msg.set_shadow_priority(this->ShadowPriority());
 
   sdf::ElementPtr elem = this->dataPtr->sdf->GetElement("attenuation");
   _msg.set_attenuation_constant(elem->Get<double>("constant"));
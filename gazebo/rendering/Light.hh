@@ -193,6 +193,28 @@ namespace gazebo
       /// \return True if cast shadows.
       public: bool CastShadows() const;
 
+      /// \brief Set the priority of the light's shadow. When a scene caps
+      /// the number of shadowed lights, lights of higher priority keep
+      /// their shadow first, then the lights closest to the camera.
+      /// \param[in] _priority Shadow priority, 0 by default.
+      /// \sa Scene::SetMaxShadowLights
+      public: void SetShadowPriority(const double _priority);
+
+      /// \brief Get the priority of the light's shadow.
+      /// \return Shadow priority.
+      public: double ShadowPriority() const;
+
+      /// \brief Set whether a light that casts shadows currently renders
+      /// its shadow. Used by the scene to cap the number of shadowed
+      /// lights, CastShadows is unchanged.
+      /// \param[in] _active False to stop rendering the shadow.
+      public: void SetShadowActive(const bool _active);
+
+      /// \brief Get whether the light currently renders a shadow.
+      /// \return True if the light casts shadows and its shadow was not
+      /// culled by the scene.
+      public: bool ShadowActive() const;
+
       /// \brief Fill the contents of a light message.
       /// \param[out] _msg Message to fill.
       public: void FillMsg(msgs::Light &_msg) const;
@@ -66,6 +66,15 @@ namespace gazebo
 
       /// \brief Custom shadow camera setup for non-directional lights
       public: Ogre::ShadowCameraSetupPtr shadowCameraSetup;
+
+      /// \brief True if the light was asked to cast shadows.
+      public: bool castShadows = false;
+
+      /// \brief False if the scene culled the light's shadow.
+      public: bool shadowActive = true;
+
+      /// \brief Priority of the light's shadow.
+      public: double shadowPriority = 0.0;
     };
   }
 }
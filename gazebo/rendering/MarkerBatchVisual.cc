@@ -0,0 +1,537 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/TraceCapture.hh"
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/Conversions.hh"
+#include "gazebo/rendering/RenderEngine.hh"
+#include "gazebo/rendering/RenderEvents.hh"
+#include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/VisualPrivate.hh"
+#include "gazebo/rendering/MarkerBatchVisual.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Number of segments around the cylinder and sphere shapes.
+static const unsigned int kSegments = 16;
+
+/// \brief Number of rings from pole to pole of the sphere shape.
+static const unsigned int kRings = 8;
+
+/// \brief Triangles of a unit marker shape, centered at the origin.
+struct MarkerShape
+{
+  /// \brief Vertex positions.
+  std::vector<Ogre::Vector3> positions;
+
+  /// \brief Vertex normals.
+  std::vector<Ogre::Vector3> normals;
+
+  /// \brief Indices of the triangle vertices.
+  std::vector<uint32_t> indices;
+};
+
+/// \brief Private data for the marker batch visual class.
+class gazebo::rendering::MarkerBatchVisualPrivate : public VisualPrivate
+{
+  /// \brief A marker of the batch.
+  public: class Marker
+  {
+    /// \brief Pose of the marker.
+    public: ignition::math::Pose3d pose;
+
+    /// \brief Scale of the marker.
+    public: ignition::math::Vector3d scale = ignition::math::Vector3d::One;
+
+    /// \brief Points of a POINTS marker.
+    public: std::vector<ignition::math::Vector3d> points;
+
+    /// \brief Lifetime of the marker, zero if it doesn't expire.
+    public: common::Time lifetime;
+  };
+
+  /// \brief Type of the markers.
+  public: ignition::msgs::Marker::Type type = ignition::msgs::Marker::BOX;
+
+  /// \brief Material of the markers.
+  public: ignition::msgs::Material materialMsg;
+
+  /// \brief Markers of the batch, by id.
+  public: std::map<uint64_t, Marker> markers;
+
+  /// \brief Shape of each marker, empty for points.
+  public: MarkerShape shape;
+
+  /// \brief Holds the geometry of all the markers.
+  public: Ogre::ManualObject *manualObject = nullptr;
+
+  /// \brief Material of the geometry.
+  public: Ogre::MaterialPtr material;
+
+  /// \brief True when a marker changed since the last update.
+  public: bool dirty = false;
+};
+
+/////////////////////////////////////////////////
+/// \brief Create the shape of a unit box.
+/// \param[out] _shape The box.
+static void BoxShape(MarkerShape &_shape)
+{
+  const Ogre::Vector3 axes[3] =
+      {Ogre::Vector3::UNIT_X, Ogre::Vector3::UNIT_Y, Ogre::Vector3::UNIT_Z};
+
+  for (unsigned int a = 0; a < 3; ++a)
+  {
+    for (const float sign : {1.0f, -1.0f})
+    {
+      // u x v is the outward normal, so the corners are counter clockwise
+      const Ogre::Vector3 n = axes[a] * sign;
+      const Ogre::Vector3 u = axes[(a + 1) % 3];
+      const Ogre::Vector3 v = axes[(a + 2) % 3] * sign;
+
+      const uint32_t base = _shape.positions.size();
+      _shape.positions.push_back((n - u - v) * 0.5f);
+      _shape.positions.push_back((n + u - v) * 0.5f);
+      _shape.positions.push_back((n + u + v) * 0.5f);
+      _shape.positions.push_back((n - u + v) * 0.5f);
+      _shape.normals.insert(_shape.normals.end(), 4, n);
+      _shape.indices.insert(_shape.indices.end(),
+          {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Create the shape of a unit cylinder, along Z.
+/// \param[out] _shape The cylinder.
+static void CylinderShape(MarkerShape &_shape)
+{
+  // Side, a bottom and a top vertex per segment
+  for (unsigned int i = 0; i <= kSegments; ++i)
+  {
+    const float angle = Ogre::Math::TWO_PI * i / kSegments;
+    const Ogre::Vector3 n(Ogre::Math::Cos(angle), Ogre::Math::Sin(angle), 0);
+    _shape.positions.push_back(n * 0.5f - Ogre::Vector3(0, 0, 0.5f));
+    _shape.positions.push_back(n * 0.5f + Ogre::Vector3(0, 0, 0.5f));
+    _shape.normals.insert(_shape.normals.end(), 2, n);
+  }
+  for (uint32_t i = 0; i < kSegments; ++i)
+  {
+    const uint32_t b = 2 * i;
+    _shape.indices.insert(_shape.indices.end(),
+        {b, b + 2, b + 3, b, b + 3, b + 1});
+  }
+
+  // Caps
+  for (const float sign : {1.0f, -1.0f})
+  {
+    const Ogre::Vector3 n(0, 0, sign);
+    const uint32_t center = _shape.positions.size();
+    _shape.positions.push_back(n * 0.5f);
+    _shape.normals.push_back(n);
+    for (unsigned int i = 0; i <= kSegments; ++i)
+    {
+      const float angle = Ogre::Math::TWO_PI * i / kSegments;
+      _shape.positions.push_back(Ogre::Vector3(
+          0.5f * Ogre::Math::Cos(angle), 0.5f * Ogre::Math::Sin(angle),
+          0.5f * sign));
+      _shape.normals.push_back(n);
+    }
+    for (uint32_t i = 0; i < kSegments; ++i)
+    {
+      if (sign > 0)
+        _shape.indices.insert(_shape.indices.end(),
+            {center, center + 1 + i, center + 2 + i});
+      else
+        _shape.indices.insert(_shape.indices.end(),
+            {center, center + 2 + i, center + 1 + i});
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Create the shape of a unit sphere.
+/// \param[out] _shape The sphere.
+static void SphereShape(MarkerShape &_shape)
+{
+  for (unsigned int r = 0; r <= kRings; ++r)
+  {
+    const float polar = Ogre::Math::PI * r / kRings;
+    for (unsigned int s = 0; s <= kSegments; ++s)
+    {
+      const float azimuth = Ogre::Math::TWO_PI * s / kSegments;
+      const Ogre::Vector3 n(
+          Ogre::Math::Sin(polar) * Ogre::Math::Cos(azimuth),
+          Ogre::Math::Sin(polar) * Ogre::Math::Sin(azimuth),
+          Ogre::Math::Cos(polar));
+      _shape.positions.push_back(n * 0.5f);
+      _shape.normals.push_back(n);
+    }
+  }
+  for (uint32_t r = 0; r < kRings; ++r)
+  {
+    for (uint32_t s = 0; s < kSegments; ++s)
+    {
+      const uint32_t a = r * (kSegments + 1) + s;
+      const uint32_t b = a + kSegments + 1;
+      _shape.indices.insert(_shape.indices.end(),
+          {a, b, b + 1, a, b + 1, a + 1});
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+MarkerBatchVisual::MarkerBatchVisual(const std::string &_name, VisualPtr _vis)
+: Visual(*new MarkerBatchVisualPrivate, _name, _vis, false)
+{
+  this->dPtr = reinterpret_cast<MarkerBatchVisualPrivate *>(this->dataPtr);
+}
+
+/////////////////////////////////////////////////
+MarkerBatchVisual::~MarkerBatchVisual()
+{
+  this->Fini();
+  this->dPtr = nullptr;
+}
+
+/////////////////////////////////////////////////
+bool MarkerBatchVisual::Batchable(const ignition::msgs::Marker::Type _type)
+{
+  return _type == ignition::msgs::Marker::BOX ||
+         _type == ignition::msgs::Marker::CYLINDER ||
+         _type == ignition::msgs::Marker::SPHERE ||
+         _type == ignition::msgs::Marker::POINTS;
+}
+
+/////////////////////////////////////////////////
+void MarkerBatchVisual::Load(const ignition::msgs::Marker::Type _type,
+    const ignition::msgs::Material &_material, const int32_t _layer)
+{
+  Visual::Load();
+
+  this->dPtr->type = _type;
+  this->dPtr->materialMsg = _material;
+
+  switch (_type)
+  {
+    case ignition::msgs::Marker::BOX:
+      BoxShape(this->dPtr->shape);
+      break;
+    case ignition::msgs::Marker::CYLINDER:
+      CylinderShape(this->dPtr->shape);
+      break;
+    case ignition::msgs::Marker::SPHERE:
+      SphereShape(this->dPtr->shape);
+      break;
+    case ignition::msgs::Marker::POINTS:
+      break;
+    default:
+      gzerr << "Unable to batch markers of type[" << _type << "]\n";
+      break;
+  }
+
+  // The material is unique to the batch, so colors can be set on it.
+  const std::string materialName = this->Name() + "_MATERIAL_";
+  if (_material.has_script())
+  {
+    for (int i = 0; i < _material.script().uri_size(); ++i)
+      RenderEngine::Instance()->AddResourcePath(_material.script().uri(i));
+  }
+
+  Ogre::MaterialPtr scriptMaterial;
+  if (_material.has_script() && !_material.script().name().empty())
+  {
+    scriptMaterial = Ogre::MaterialManager::getSingleton().getByName(
+        _material.script().name());
+    if (scriptMaterial.isNull())
+    {
+      gzwarn << "Unable to get Material[" << _material.script().name()
+             << "] for marker batch[" << this->Name()
+             << "]. Markers will appear white.\n";
+    }
+  }
+
+  if (!scriptMaterial.isNull())
+  {
+    this->dPtr->material = scriptMaterial->clone(materialName);
+  }
+  else
+  {
+    this->dPtr->material = Ogre::MaterialManager::getSingleton().create(
+        materialName,
+        Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    this->dPtr->material->setLightingEnabled(_material.lighting());
+  }
+
+  if (_material.has_ambient())
+  {
+    this->dPtr->material->setAmbient(Conversions::Convert(
+        ignition::msgs::Convert(_material.ambient())));
+  }
+  if (_material.has_diffuse())
+  {
+    const ignition::math::Color diffuse =
+        ignition::msgs::Convert(_material.diffuse());
+    this->dPtr->material->setDiffuse(Conversions::Convert(diffuse));
+    if (diffuse.A() < 1.0f)
+    {
+      this->dPtr->material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
+      this->dPtr->material->setDepthWriteEnabled(false);
+    }
+  }
+  if (_material.has_specular())
+  {
+    this->dPtr->material->setSpecular(Conversions::Convert(
+        ignition::msgs::Convert(_material.specular())));
+  }
+  if (_material.has_emissive())
+  {
+    this->dPtr->material->setSelfIllumination(Conversions::Convert(
+        ignition::msgs::Convert(_material.emissive())));
+  }
+
+  this->dPtr->manualObject =
+      this->GetScene()->OgreSceneManager()->createManualObject(
+      this->Name() + "__BATCH__");
+  this->dPtr->manualObject->setDynamic(true);
+  this->dPtr->manualObject->setCastShadows(false);
+  this->GetSceneNode()->attachObject(this->dPtr->manualObject);
+
+  rendering::Events::newLayer(_layer);
+  this->SetLayer(_layer);
+  this->SetVisibilityFlags(GZ_VISIBILITY_GUI);
+}
+
+/////////////////////////////////////////////////
+void MarkerBatchVisual::AddModify(const uint64_t _id,
+    const ignition::msgs::Marker &_msg)
+{
+  MarkerBatchVisualPrivate::Marker &marker = this->dPtr->markers[_id];
+
+  if (_msg.has_pose())
+    marker.pose = ignition::msgs::Convert(_msg.pose());
+
+  if (_msg.has_scale())
+    marker.scale = ignition::msgs::Convert(_msg.scale());
+
+  // As with MarkerVisual, the presence of points replaces the existing ones
+  if (_msg.point_size() > 0)
+  {
+    marker.points.resize(_msg.point_size());
+    for (int i = 0; i < _msg.point_size(); ++i)
+      marker.points[i] = ignition::msgs::Convert(_msg.point(i));
+  }
+
+  if (_msg.has_lifetime() &&
+      (_msg.lifetime().sec() > 0 ||
+      (_msg.lifetime().sec() == 0 && _msg.lifetime().nsec() > 0)))
+  {
+    marker.lifetime = this->GetScene()->SimTime() +
+      gazebo::common::Time(_msg.lifetime().sec(), _msg.lifetime().nsec());
+  }
+
+  this->dPtr->dirty = true;
+}
+
+/////////////////////////////////////////////////
+bool MarkerBatchVisual::Remove(const uint64_t _id)
+{
+  if (this->dPtr->markers.erase(_id) == 0)
+    return false;
+
+  this->dPtr->dirty = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::vector<uint64_t> MarkerBatchVisual::RemoveExpired(
+    const common::Time &_simTime, const bool _reset)
+{
+  std::vector<uint64_t> removed;
+  for (auto it = this->dPtr->markers.begin();
+       it != this->dPtr->markers.end();)
+  {
+    if (it->second.lifetime != common::Time::Zero &&
+        (it->second.lifetime <= _simTime || _reset))
+    {
+      removed.push_back(it->first);
+      it = this->dPtr->markers.erase(it);
+    }
+    else
+      ++it;
+  }
+
+  if (!removed.empty())
+    this->dPtr->dirty = true;
+  return removed;
+}
+
+/////////////////////////////////////////////////
+size_t MarkerBatchVisual::MarkerCount() const
+{
+  return this->dPtr->markers.size();
+}
+
+/////////////////////////////////////////////////
+std::vector<uint64_t> MarkerBatchVisual::Ids() const
+{
+  std::vector<uint64_t> ids;
+  ids.reserve(this->dPtr->markers.size());
+  for (auto const &marker : this->dPtr->markers)
+    ids.push_back(marker.first);
+  return ids;
+}
+
+/////////////////////////////////////////////////
+void MarkerBatchVisual::Update()
+{
+  if (!this->dPtr->dirty || !this->dPtr->manualObject)
+    return;
+
+  IGN_PROFILE("rendering::MarkerBatchVisual::Update");
+
+  Ogre::ManualObject *manualObject = this->dPtr->manualObject;
+  const MarkerShape &shape = this->dPtr->shape;
+  const bool points = this->dPtr->type == ignition::msgs::Marker::POINTS;
+
+  size_t vertexCount = 0;
+  for (auto const &marker : this->dPtr->markers)
+  {
+    vertexCount += points ? marker.second.points.size() :
+        shape.positions.size();
+  }
+
+  // A first section without vertices would be discarded, wait for some.
+  if (vertexCount == 0 && manualObject->getNumSections() == 0)
+  {
+    this->dPtr->dirty = false;
+    return;
+  }
+
+  manualObject->estimateVertexCount(vertexCount);
+  if (!points)
+  {
+    manualObject->estimateIndexCount(
+        this->dPtr->markers.size() * shape.indices.size());
+  }
+
+  // Once created, the section and its buffers are reused, and only
+  // reallocated when they grow.
+  if (manualObject->getNumSections() == 0)
+  {
+    manualObject->begin(this->dPtr->material->getName(), points ?
+        Ogre::RenderOperation::OT_POINT_LIST :
+        Ogre::RenderOperation::OT_TRIANGLE_LIST);
+  }
+  else
+  {
+    manualObject->beginUpdate(0);
+  }
+
+  uint32_t base = 0;
+  for (auto const &marker : this->dPtr->markers)
+  {
+    const Ogre::Vector3 position =
+        Conversions::Convert(marker.second.pose.Pos());
+    const Ogre::Quaternion rotation =
+        Conversions::Convert(marker.second.pose.Rot());
+    const Ogre::Vector3 scale = Conversions::Convert(marker.second.scale);
+
+    if (points)
+    {
+      for (auto const &point : marker.second.points)
+      {
+        manualObject->position(
+            position + rotation * (scale * Conversions::Convert(point)));
+      }
+      continue;
+    }
+
+    // Normals are transformed by the inverse transpose, so a non uniform
+    // scale keeps them perpendicular to the faces.
+    const Ogre::Vector3 normalScale(
+        Ogre::Math::RealEqual(scale.x, 0) ? 0 : 1 / scale.x,
+        Ogre::Math::RealEqual(scale.y, 0) ? 0 : 1 / scale.y,
+        Ogre::Math::RealEqual(scale.z, 0) ? 0 : 1 / scale.z);
+
+    for (size_t i = 0; i < shape.positions.size(); ++i)
+    {
+      manualObject->position(
+          position + rotation * (scale * shape.positions[i]));
+      manualObject->normal(
+          (rotation * (normalScale * shape.normals[i])).normalisedCopy());
+    }
+    for (auto const index : shape.indices)
+      manualObject->index(base + index);
+    base += shape.positions.size();
+  }
+
+  manualObject->end();
+  this->dPtr->dirty = false;
+}
+
+/////////////////////////////////////////////////
+void MarkerBatchVisual::Fini()
+{
+  if (this->dPtr->manualObject)
+  {
+    this->GetSceneNode()->detachObject(this->dPtr->manualObject);
+    this->GetScene()->OgreSceneManager()->destroyManualObject(
+        this->dPtr->manualObject);
+    this->dPtr->manualObject = nullptr;
+  }
+
+  if (!this->dPtr->material.isNull())
+  {
+    Ogre::MaterialManager::getSingleton().remove(
+        this->dPtr->material->getName());
+    this->dPtr->material.setNull();
+  }
+
+  this->dPtr->markers.clear();
+  Visual::Fini();
+}
+
+/////////////////////////////////////////////////
+bool MarkerBatchVisual::FillMsg(const uint64_t _id,
+    ignition::msgs::Marker &_msg) const
+{
+  auto it = this->dPtr->markers.find(_id);
+  if (it == this->dPtr->markers.end())
+    return false;
+
+  _msg.set_type(this->dPtr->type);
+  _msg.mutable_lifetime()->set_sec(it->second.lifetime.sec);
+  _msg.mutable_lifetime()->set_nsec(it->second.lifetime.nsec);
+  ignition::msgs::Set(_msg.mutable_pose(), it->second.pose);
+  ignition::msgs::Set(_msg.mutable_scale(), it->second.scale);
+  for (auto const &point : it->second.points)
+    ignition::msgs::Set(_msg.add_point(), point);
+  *_msg.mutable_material() = this->dPtr->materialMsg;
+  _msg.set_layer(this->dataPtr->layer);
+
+  return true;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_MARKERBATCHVISUAL_HH_
+#define GAZEBO_RENDERING_MARKERBATCHVISUAL_HH_
+
+#include <string>
+#include <vector>
+
+#include <ignition/msgs.hh>
+
+#include "gazebo/rendering/Visual.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declare private data class
+    class MarkerBatchVisualPrivate;
+
+    /// \cond
+    /// \brief Renders many markers of the same type, material and layer as
+    /// a single object. The geometry of all the markers is written into one
+    /// dynamic vertex buffer, which is rewritten in place once per frame
+    /// when a marker changes. Boxes, cylinders, spheres and points can be
+    /// batched. The MarkerManager class should instantiate instances of
+    /// this class.
+    /// \sa MarkerManager
+    class GZ_RENDERING_VISIBLE MarkerBatchVisual : public Visual
+    {
+      /// \brief Constructor.
+      /// \param[in] _name Name of the visual.
+      /// \param[in] _vis Pointer to the parent Visual.
+      public: MarkerBatchVisual(const std::string &_name, VisualPtr _vis);
+
+      /// \brief Destructor.
+      public: virtual ~MarkerBatchVisual();
+
+      /// \brief Load the batch.
+      /// \param[in] _type Type of the markers, BOX, CYLINDER, SPHERE or
+      /// POINTS.
+      /// \param[in] _material Material of the markers.
+      /// \param[in] _layer Layer of the markers.
+      public: void Load(const ignition::msgs::Marker::Type _type,
+                  const ignition::msgs::Material &_material,
+                  const int32_t _layer);
+      using Visual::Load;
+
+      /// \brief Check whether a marker type can be batched.
+      /// \param[in] _type Type of marker.
+      /// \return True for boxes, cylinders, spheres and points.
+      public: static bool Batchable(const ignition::msgs::Marker::Type _type);
+
+      /// \brief Add or modify a marker of the batch. The pose, scale,
+      /// points and lifetime of the message replace those of the marker.
+      /// Its type, material and layer are ignored.
+      /// \param[in] _id Id of the marker.
+      /// \param[in] _msg The message that defines what to add or modify.
+      public: void AddModify(const uint64_t _id,
+                  const ignition::msgs::Marker &_msg);
+
+      /// \brief Remove a marker from the batch.
+      /// \param[in] _id Id of the marker.
+      /// \return True if the marker was in the batch.
+      public: bool Remove(const uint64_t _id);
+
+      /// \brief Remove the markers whose lifetime has expired.
+      /// \param[in] _simTime Current simulation time.
+      /// \param[in] _reset True if the world was reset, which expires all
+      /// the markers with a lifetime.
+      /// \return Ids of the removed markers.
+      public: std::vector<uint64_t> RemoveExpired(
+                  const common::Time &_simTime, const bool _reset);
+
+      /// \brief Get the number of markers in the batch.
+      /// \return Number of markers.
+      public: size_t MarkerCount() const;
+
+      /// \brief Get the ids of the markers in the batch.
+      /// \return Ids of the markers, in increasing order.
+      public: std::vector<uint64_t> Ids() const;
+
+      /// \brief Rewrite the vertex buffer if a marker changed since the
+      /// last update.
+      public: void Update();
+
+      // Documentation inherited
+      public: virtual void Fini();
+
+      /// \brief Populate a marker message with one marker of the batch.
+      /// \param[in] _id Id of the marker.
+      /// \param[out] _msg The message to populate.
+      /// \return False if the marker is not in the batch.
+      public: bool FillMsg(const uint64_t _id,
+                  ignition::msgs::Marker &_msg) const;
+
+      /// \brief Private data pointer
+      private: MarkerBatchVisualPrivate *dPtr;
+    };
+    /// \endcond
+  }
+}
+#endif
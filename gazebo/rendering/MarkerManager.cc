@@ -15,6 +15,7 @@
  *
 */
 
+#include <algorithm>
 #include <functional>
 #include <list>
 #include <map>
@@ -27,10 +28,12 @@
 #include <ignition/transport/Node.hh>
 
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/Time.hh"
 #include "gazebo/transport/TransportIface.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/rendering/RenderingIface.hh"
 #include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/MarkerBatchVisual.hh"
 #include "gazebo/rendering/MarkerVisual.hh"
 #include "gazebo/rendering/MarkerManager.hh"
 
@@ -44,19 +47,72 @@ class gazebo::rendering::MarkerManagerPrivate
   /// \brief Shared pointer to MarkerVisual
   typedef std::shared_ptr<MarkerVisual> MarkerVisualPtr;
 
+  /// \def MarkerBatchVisualPtr
+  /// \brief Shared pointer to MarkerBatchVisual
+  typedef std::shared_ptr<MarkerBatchVisual> MarkerBatchVisualPtr;
+
   /// \def Marker_M
   /// \brief Map of markers. The key is a marker namespace, the
   /// value is the map of markers in the namespace and their ids.
   typedef std::map<std::string, std::map<uint64_t, MarkerVisualPtr>> Marker_M;
 
+  /// \def Batch_M
+  /// \brief Map of marker batches. The key is a marker namespace, the
+  /// value is the map of batches in the namespace and their keys.
+  typedef std::map<std::string, std::map<std::string, MarkerBatchVisualPtr>>
+      Batch_M;
+
+  /// \def BatchIds_M
+  /// \brief Map of batched markers. The key is a marker namespace, the
+  /// value is the map of the ids in the namespace to the key of their
+  /// batch.
+  typedef std::map<std::string, std::map<uint64_t, std::string>> BatchIds_M;
+
+  /// \brief Markers received in one request.
+  public: class MarkerRequest
+  {
+    /// \brief The markers, processed in order.
+    public: ignition::msgs::Marker_V markers;
+
+    /// \brief True if the markers were received on /marker_array, and
+    /// may be batched.
+    public: bool batch = false;
+  };
+
   /// \def MarkerMsgs_L
-  /// \brief List of marker messages.
-  typedef std::list<ignition::msgs::Marker> MarkerMsgs_L;
+  /// \brief List of marker requests.
+  typedef std::list<MarkerRequest> MarkerMsgs_L;
 
   /// \brief Process a marker message.
   /// \param[in] _msg The message data.
+  /// \param[in] _batch True to batch the marker, if it can be batched.
   /// \return True if the marker was processed successfully.
-  public: bool ProcessMarkerMsg(const ignition::msgs::Marker &_msg);
+  public: bool ProcessMarkerMsg(const ignition::msgs::Marker &_msg,
+              const bool _batch);
+
+  /// \brief Add or modify a batched marker, moving it to another batch
+  /// if its type, material or layer changes.
+  /// \param[in] _ns Namespace of the marker.
+  /// \param[in] _id Id of the marker.
+  /// \param[in] _msg The message data.
+  public: void AddModifyBatched(const std::string &_ns, const uint64_t _id,
+              const ignition::msgs::Marker &_msg);
+
+  /// \brief Remove a batched marker. Its batch is removed once empty.
+  /// \param[in] _ns Namespace of the marker.
+  /// \param[in] _id Id of the marker.
+  /// \return True if the marker was batched.
+  public: bool RemoveBatched(const std::string &_ns, const uint64_t _id);
+
+  /// \brief Remove all the batches of a namespace.
+  /// \param[in] _ns Namespace of the batches.
+  public: void RemoveBatches(const std::string &_ns);
+
+  /// \brief Check whether a batched marker exists.
+  /// \param[in] _ns Namespace of the marker.
+  /// \param[in] _id Id of the marker.
+  /// \return True if the marker is batched.
+  public: bool Batched(const std::string &_ns, const uint64_t _id) const;
 
   /// \brief Update the markers. This function is called on
   /// the PreRender event.
@@ -66,6 +122,13 @@ class gazebo::rendering::MarkerManagerPrivate
   /// \param[in] _req The marker message.
   public: void OnMarkerMsg(const ignition::msgs::Marker &_req);
 
+  /// \brief Service callback that receives many markers at once.
+  /// \param[in] _req The marker messages.
+  /// \param[out] _rep Service reply.
+  /// \return True on success.
+  public: bool OnMarkerArrayMsg(const ignition::msgs::Marker_V &_req,
+              ignition::msgs::Boolean &_rep);
+
   /// \brief Service callback that returns a list of markers.
   /// \param[out] _rep Service reply
   /// \return True on success.
@@ -84,6 +147,12 @@ class gazebo::rendering::MarkerManagerPrivate
   /// \brief Map of markers
   public: Marker_M markers;
 
+  /// \brief Map of marker batches
+  public: Batch_M batches;
+
+  /// \brief Batch of each batched marker
+  public: BatchIds_M batchIds;
+
   /// \brief List of marker message to process.
   public: MarkerMsgs_L markerMsgs;
 
@@ -104,8 +173,33 @@ class gazebo::rendering::MarkerManagerPrivate
 
   /// \brief Subscribe to world_stats topic
   public: transport::SubscriberPtr statsSub;
+
+  /// \brief Publishes the number of markers processed per second.
+  public: ignition::transport::Node::Publisher throughputPub;
+
+  /// \brief Markers processed since the throughput was last published.
+  public: uint64_t processedCount = 0;
+
+  /// \brief Wall time the throughput was last published.
+  public: common::Time throughputTime;
 };
 
+/// \brief Wall time between two publications of the marker throughput.
+static const common::Time kThroughputPeriod(1, 0);
+
+/////////////////////////////////////////////////
+/// \brief Get the key of the batch of a marker.
+/// \param[in] _type Type of the marker.
+/// \param[in] _material Material of the marker.
+/// \param[in] _layer Layer of the marker.
+/// \return Markers with the same key share a batch.
+static std::string BatchKey(const ignition::msgs::Marker::Type _type,
+    const ignition::msgs::Material &_material, const int32_t _layer)
+{
+  return std::to_string(_type) + "_" + std::to_string(_layer) + "_" +
+      _material.SerializeAsString();
+}
+
 /////////////////////////////////////////////////
 MarkerManager::MarkerManager()
 : dataPtr(new MarkerManagerPrivate)
@@ -144,6 +238,17 @@ bool MarkerManager::Init(Scene *_scene)
     gzerr << "Unable to advertise to the /marker service.\n";
   }
 
+  // Advertise to the marker array service
+  if (!this->dataPtr->node.Advertise("/marker_array",
+        &MarkerManagerPrivate::OnMarkerArrayMsg, this->dataPtr.get()))
+  {
+    gzerr << "Unable to advertise to the /marker_array service.\n";
+  }
+
+  this->dataPtr->throughputPub =
+      this->dataPtr->node.Advertise<ignition::msgs::Double>("/marker/stats");
+  this->dataPtr->throughputTime = common::Time::GetWallTime();
+
   this->dataPtr->gznode = transport::NodePtr(new transport::Node());
   this->dataPtr->gznode->Init();
 
@@ -162,13 +267,17 @@ void MarkerManagerPrivate::OnPreRender()
 {
   std::lock_guard<std::mutex> lock(this->mutex);
 
+  if (!this->markerMsgs.empty())
+    this->scene->MarkChanged();
+
   // Process the marker messages.
-  for (auto markerIter = this->markerMsgs.begin();
-       markerIter != this->markerMsgs.end();)
+  for (auto const &request : this->markerMsgs)
   {
-    this->ProcessMarkerMsg(*markerIter);
-    this->markerMsgs.erase(markerIter++);
+    for (auto const &markerMsg : request.markers.marker())
+      this->ProcessMarkerMsg(markerMsg, request.batch);
+    this->processedCount += request.markers.marker_size();
   }
+  this->markerMsgs.clear();
 
   // Erase any markers that have a lifetime.
   for (auto mit = this->markers.begin();
@@ -197,11 +306,156 @@ void MarkerManagerPrivate::OnPreRender()
     else
       ++mit;
   }
+
+  // Erase the batched markers that have expired, and rewrite the batches
+  // that changed.
+  for (auto nsIter = this->batches.begin(); nsIter != this->batches.end();)
+  {
+    for (auto it = nsIter->second.begin(); it != nsIter->second.end();)
+    {
+      for (auto const id : it->second->RemoveExpired(this->simTime,
+            this->simTime < this->lastSimTime))
+      {
+        this->batchIds[nsIter->first].erase(id);
+      }
+
+      if (it->second->MarkerCount() == 0)
+      {
+        it->second->Fini();
+        this->scene->RemoveVisual(it->second);
+        it = nsIter->second.erase(it);
+      }
+      else
+      {
+        it->second->Update();
+        ++it;
+      }
+    }
+
+    if (nsIter->second.empty())
+    {
+      this->batchIds.erase(nsIter->first);
+      nsIter = this->batches.erase(nsIter);
+    }
+    else
+      ++nsIter;
+  }
   this->lastSimTime = this->simTime;
+
+  // Publish the number of markers processed per second.
+  const common::Time wallTime = common::Time::GetWallTime();
+  const common::Time elapsed = wallTime - this->throughputTime;
+  if (elapsed >= kThroughputPeriod)
+  {
+    ignition::msgs::Double msg;
+    msg.set_data(this->processedCount / elapsed.Double());
+    this->throughputPub.Publish(msg);
+    this->processedCount = 0;
+    this->throughputTime = wallTime;
+  }
 }
 
 //////////////////////////////////////////////////
-bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
+bool MarkerManagerPrivate::Batched(const std::string &_ns,
+    const uint64_t _id) const
+{
+  auto nsIter = this->batchIds.find(_ns);
+  return nsIter != this->batchIds.end() &&
+      nsIter->second.find(_id) != nsIter->second.end();
+}
+
+//////////////////////////////////////////////////
+void MarkerManagerPrivate::AddModifyBatched(const std::string &_ns,
+    const uint64_t _id, const ignition::msgs::Marker &_msg)
+{
+  // Type and material default to those of the marker's current batch
+  MarkerBatchVisualPtr current;
+  ignition::msgs::Marker merged;
+  auto idIter = this->batchIds[_ns].find(_id);
+  if (idIter != this->batchIds[_ns].end())
+  {
+    current = this->batches[_ns][idIter->second];
+    current->FillMsg(_id, merged);
+    if (_msg.point_size() > 0)
+      merged.clear_point();
+
+    // Lifetimes are filled as sim times, turn them back into durations
+    const common::Time end(merged.lifetime().sec(), merged.lifetime().nsec());
+    if (end != common::Time::Zero)
+    {
+      const common::Time remaining =
+          std::max(end - this->scene->SimTime(), common::Time(0, 1));
+      merged.mutable_lifetime()->set_sec(remaining.sec);
+      merged.mutable_lifetime()->set_nsec(remaining.nsec);
+    }
+  }
+  merged.MergeFrom(_msg);
+  merged.set_layer(_msg.layer());
+
+  const std::string key =
+      BatchKey(merged.type(), merged.material(), merged.layer());
+  if (idIter != this->batchIds[_ns].end() && idIter->second == key)
+  {
+    current->AddModify(_id, _msg);
+    return;
+  }
+
+  // The marker is new, or moves to another batch
+  if (current)
+    this->RemoveBatched(_ns, _id);
+
+  MarkerBatchVisualPtr &batch = this->batches[_ns][key];
+  if (!batch)
+  {
+    // Create the name for the batch
+    std::string name = "__GZ_MARKER_BATCH_" + _ns + "_" +
+      std::to_string(std::hash<std::string>()(key));
+
+    batch.reset(new MarkerBatchVisual(name, this->scene->WorldVisual()));
+    batch->Load(merged.type(), merged.material(), merged.layer());
+  }
+
+  batch->AddModify(_id, merged);
+  this->batchIds[_ns][_id] = key;
+}
+
+//////////////////////////////////////////////////
+bool MarkerManagerPrivate::RemoveBatched(const std::string &_ns,
+    const uint64_t _id)
+{
+  auto nsIter = this->batchIds.find(_ns);
+  if (nsIter == this->batchIds.end())
+    return false;
+
+  auto idIter = nsIter->second.find(_id);
+  if (idIter == nsIter->second.end())
+    return false;
+
+  // Empty batches are removed on the next PreRender
+  this->batches[_ns][idIter->second]->Remove(_id);
+  nsIter->second.erase(idIter);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void MarkerManagerPrivate::RemoveBatches(const std::string &_ns)
+{
+  auto nsIter = this->batches.find(_ns);
+  if (nsIter == this->batches.end())
+    return;
+
+  for (auto const &batch : nsIter->second)
+  {
+    batch.second->Fini();
+    this->scene->RemoveVisual(batch.second);
+  }
+  this->batches.erase(nsIter);
+  this->batchIds.erase(_ns);
+}
+
+//////////////////////////////////////////////////
+bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg,
+    const bool _batch)
 {
   // Get the namespace, if it exists. Otherwise, use the global namespace
   std::string ns;
@@ -223,11 +477,12 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
     id = ignition::math::Rand::IntUniform(0, ignition::math::MAX_I32);
 
     // Make sure it's unique if namespace is given
-    if (nsIter != this->markers.end())
+    while ((nsIter != this->markers.end() &&
+            nsIter->second.find(id) != nsIter->second.end()) ||
+           this->Batched(ns, id))
     {
-      while (nsIter->second.find(id) != nsIter->second.end())
-        id = ignition::math::Rand::IntUniform(ignition::math::MIN_UI32,
-                                              ignition::math::MAX_UI32);
+      id = ignition::math::Rand::IntUniform(ignition::math::MIN_UI32,
+                                            ignition::math::MAX_UI32);
     }
   }
 
@@ -236,11 +491,29 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
   if (nsIter != this->markers.end())
     markerIter = nsIter->second.find(id);
 
+  const bool exists =
+      nsIter != this->markers.end() && markerIter != nsIter->second.end();
+
   // Add/modify a marker
   if (_msg.action() == ignition::msgs::Marker::ADD_MODIFY)
   {
+    // Markers of a batchable type without a parent are batched when they
+    // come from /marker_array, unless they already have their own visual.
+    const bool batched = this->Batched(ns, id);
+    if (_batch && !exists && _msg.parent().empty() &&
+        (MarkerBatchVisual::Batchable(_msg.type()) ||
+         (batched && _msg.type() == ignition::msgs::Marker::NONE)))
+    {
+      this->AddModifyBatched(ns, id, _msg);
+      return true;
+    }
+
+    // Otherwise the marker leaves its batch for a visual of its own
+    if (batched)
+      this->RemoveBatched(ns, id);
+
     // Modify an existing marker, identified by namespace and id
-    if (nsIter != this->markers.end() && markerIter != nsIter->second.end())
+    if (exists)
     {
       markerIter->second->Load(_msg);
     }
@@ -266,7 +539,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
   else if (_msg.action() == ignition::msgs::Marker::DELETE_MARKER)
   {
     // Remove the marker if it can be found.
-    if (nsIter != this->markers.end() && markerIter != nsIter->second.end())
+    if (exists)
     {
       markerIter->second->Fini();
       this->scene->RemoveVisual(markerIter->second);
@@ -276,7 +549,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
       if (this->markers[ns].empty())
         this->markers.erase(nsIter);
     }
-    else
+    else if (!this->RemoveBatched(ns, id))
     {
       gzwarn << "Unable to delete marker with id[" << id << "] "
         << "in namespace[" << ns << "]" << std::endl;
@@ -287,22 +560,29 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
   else if (_msg.action() == ignition::msgs::Marker::DELETE_ALL)
   {
     // If given namespace doesn't exist
-    if (!ns.empty() && nsIter == this->markers.end())
+    if (!ns.empty() && nsIter == this->markers.end() &&
+        this->batches.find(ns) == this->batches.end())
     {
       gzwarn << "Unable to delete all markers in namespace[" << ns <<
           "], namespace can't be found." << std::endl;
       return false;
     }
     // Remove all markers in the specified namespace
-    else if (nsIter != this->markers.end())
+    else if (nsIter != this->markers.end() ||
+             this->batches.find(ns) != this->batches.end())
     {
-      for (auto it = nsIter->second.begin(); it != nsIter->second.end(); ++it)
+      if (nsIter != this->markers.end())
       {
-        it->second->Fini();
-        this->scene->RemoveVisual(it->second);
+        for (auto it = nsIter->second.begin(); it != nsIter->second.end();
+             ++it)
+        {
+          it->second->Fini();
+          this->scene->RemoveVisual(it->second);
+        }
+        nsIter->second.clear();
+        this->markers.erase(nsIter);
       }
-      nsIter->second.clear();
-      this->markers.erase(nsIter);
+      this->RemoveBatches(ns);
     }
     // Remove all markers in all namespaces.
     else
@@ -317,6 +597,9 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
         }
       }
       this->markers.clear();
+
+      while (!this->batches.empty())
+        this->RemoveBatches(this->batches.begin()->first);
     }
   }
   else
@@ -332,7 +615,20 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
 void MarkerManagerPrivate::OnMarkerMsg(const ignition::msgs::Marker &_req)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
-  this->markerMsgs.push_back(_req);
+  this->markerMsgs.emplace_back();
+  *this->markerMsgs.back().markers.add_marker() = _req;
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::OnMarkerArrayMsg(
+    const ignition::msgs::Marker_V &_req, ignition::msgs::Boolean &_rep)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->markerMsgs.emplace_back();
+  this->markerMsgs.back().markers = _req;
+  this->markerMsgs.back().batch = true;
+  _rep.set_data(true);
+  return true;
 }
 
 /////////////////////////////////////////////////
@@ -355,6 +651,20 @@ bool MarkerManagerPrivate::OnList(ignition::msgs::Marker_V &_rep)
     }
   }
 
+  for (auto const &nsIter : this->batches)
+  {
+    for (auto const &batch : nsIter.second)
+    {
+      for (auto const id : batch.second->Ids())
+      {
+        ignition::msgs::Marker *markerMsg = _rep.add_marker();
+        markerMsg->set_ns(nsIter.first);
+        markerMsg->set_id(id);
+        batch.second->FillMsg(id, *markerMsg);
+      }
+    }
+  }
+
   return true;
 }
 
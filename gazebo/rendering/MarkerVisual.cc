@@ -14,9 +14,9 @@
  * limitations under the License.
  *
 */
-#include <ignition/common/Profiler.hh>
 
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/rendering/RenderEvents.hh"
 #include "gazebo/rendering/DynamicLines.hh"
 #include "gazebo/rendering/Scene.hh"
@@ -14,13 +14,14 @@
  * limitations under the License.
  *
 */
-#include <ignition/common/Profiler.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/common/Console.hh"
 #include "gazebo/rendering/RenderEngine.hh"
 #include "gazebo/rendering/Conversions.hh"
 #include "gazebo/rendering/Material.hh"
+#include "gazebo/rendering/TextureLoader.hh"
 
 using namespace gazebo;
 using namespace rendering;
@@ -184,6 +185,11 @@ void Material::Update(const gazebo::common::Material *_mat)
   {
     // Make sure to add the path to the texture image.
     RenderEngine::Instance()->AddResourcePath(_mat->GetTextureImage());
+
+    // Decode the image in the background, the material shows a placeholder
+    // until it is uploaded.
+    TextureLoader::Instance()->Queue(_mat->GetTextureImage());
+
     Ogre::TextureUnitState *texState = pass->createTextureUnitState(
         _mat->GetTextureImage());
     texState->setTextureName(_mat->GetTextureImage());
@@ -31,8 +31,7 @@
 
 #include <mutex>
 
-#include <ignition/common/Profiler.hh>
-
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/common/common.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/rendering/MovableText.hh"
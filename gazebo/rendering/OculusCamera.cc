@@ -17,7 +17,6 @@
 
 #include <sstream>
 #include <string>
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Matrix4.hh>
 #include <ignition/math/Pose3.hh>
@@ -25,6 +24,7 @@
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Vector4.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 
 #include "gazebo/common/Assert.hh"
@@ -16,10 +16,11 @@
 */
 
 #include <sys/stat.h>
+#include <algorithm>
+#include <functional>
+#include <sstream>
 #include <boost/filesystem.hpp>
 
-#include <ignition/common/Profiler.hh>
-
 #if defined(HAVE_OPENGL)
 
 #if defined(__APPLE__)
@@ -39,6 +40,7 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/CustomPSSMShadowCameraSetup.hh"
 #include "gazebo/rendering/Light.hh"
@@ -99,6 +101,7 @@ void RTShaderSystem::Init()
 
     // Set shader cache path.
     this->dataPtr->shaderGenerator->setShaderCachePath(cachePath);
+    this->LoadProgramCache(cachePath);
 
 #if OGRE_VERSION_MAJOR >= 1 && OGRE_VERSION_MINOR <= 8
     this->dataPtr->programWriterFactory =
@@ -141,6 +144,8 @@ void RTShaderSystem::Fini()
   Ogre::MaterialManager::getSingleton().setActiveScheme(
       Ogre::MaterialManager::DEFAULT_SCHEME_NAME);
 
+  this->SaveProgramCache();
+
   // Finalize RTShader system.
   if (this->dataPtr->shaderGenerator != NULL)
   {
@@ -273,6 +278,19 @@ void RTShaderSystem::GenerateShaders(const VisualPtr &_vis)
     if (!entity)
       continue;
 
+    // Skinned entities, such as actors, are deformed in the vertex shader
+    // so that the CPU only uploads the bone palette of each frame.
+    // Entities that share a mesh also share its vertex buffers.
+#if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR >= 9 &&\
+    defined(RTSHADER_SYSTEM_BUILD_EXT_SHADERS)
+    const bool hardwareSkinning = entity->hasSkeleton();
+    if (hardwareSkinning)
+    {
+      Ogre::RTShader::HardwareSkinningFactory::getSingleton().
+          prepareEntityForSkinning(entity);
+    }
+#endif
+
     for (unsigned int i = 0; i < entity->getNumSubEntities(); ++i)
     {
       Ogre::SubEntity* curSubEntity = entity->getSubEntity(i);
@@ -372,6 +390,17 @@ void RTShaderSystem::GenerateShaders(const VisualPtr &_vis)
             renderState->addTemplateSubRenderState(perPixelLightModel);
           }
 
+#if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR >= 9 &&\
+    defined(RTSHADER_SYSTEM_BUILD_EXT_SHADERS)
+          if (hardwareSkinning)
+          {
+            Ogre::RTShader::SubRenderState *skinningSubRS =
+              this->dataPtr->shaderGenerator->createSubRenderState(
+                  Ogre::RTShader::HardwareSkinning::Type);
+
+            renderState->addTemplateSubRenderState(skinningSubRS);
+          }
+#endif
 
           // Invalidate this material in order to re-generate its shaders.
           this->dataPtr->shaderGenerator->invalidateMaterial(
@@ -592,6 +621,39 @@ void RTShaderSystem::ReapplyShadows()
   }
 }
 
+/////////////////////////////////////////////////
+void RTShaderSystem::SetLightCount(ScenePtr _scene, const unsigned int _count)
+{
+  if (!this->dataPtr->initialized)
+    return;
+
+  Ogre::RTShader::RenderState *schemeRenderState =
+    this->dataPtr->shaderGenerator->getRenderState(_scene->Name() +
+        Ogre::RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME);
+
+  if (_count == 0u)
+  {
+    schemeRenderState->setLightCountAutoUpdate(true);
+  }
+  else
+  {
+    // Point, directional and spot lights. The lights missing from an
+    // object's light list are passed to the shaders as black lights.
+    const int count = static_cast<int>(_count);
+#if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR >= 12
+    schemeRenderState->setLightCount(Ogre::Vector3i(count, 1, count));
+#else
+    const int lightCount[3] = {count, 1, count};
+    schemeRenderState->setLightCount(lightCount);
+#endif
+    schemeRenderState->setLightCountAutoUpdate(false);
+  }
+
+  this->dataPtr->shaderGenerator->invalidateScheme(_scene->Name() +
+      Ogre::RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME);
+  this->UpdateShaders();
+}
+
 /////////////////////////////////////////////////
 Ogre::PSSMShadowCameraSetup *RTShaderSystem::GetPSSMShadowCameraSetup() const
 {
@@ -635,9 +697,154 @@ void RTShaderSystem::Update()
         this->UpdateShaders(vis);
       }
     }
+
+    // Build the programs of the new material and light permutations now
+    // rather than stalling the first camera that renders them.
+    IGN_PROFILE_BEGIN("PrecompileShaders");
+    for (const auto &scene : this->dataPtr->scenes)
+    {
+      this->PrecompileShaders(scene->WorldVisual(), scene->Name() +
+          Ogre::RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME);
+    }
+    IGN_PROFILE_END();
   }
 }
 
+/////////////////////////////////////////////////
+void RTShaderSystem::PrecompileShaders(const VisualPtr &_vis,
+    const std::string &_scheme)
+{
+  if (!this->dataPtr->initialized || !_vis)
+    return;
+
+  for (unsigned int k = 0; _vis->UseRTShader() && _vis->GetSceneNode() &&
+      k < _vis->GetSceneNode()->numAttachedObjects(); ++k)
+  {
+    Ogre::Entity *entity = dynamic_cast<Ogre::Entity*>(
+        _vis->GetSceneNode()->getAttachedObject(k));
+    if (!entity)
+      continue;
+
+    for (unsigned int i = 0; i < entity->getNumSubEntities(); ++i)
+    {
+      const Ogre::MaterialPtr &material =
+          entity->getSubEntity(i)->getMaterial();
+      if (material.isNull())
+        continue;
+
+      try
+      {
+        // Generates the shader source of the scheme technique if the
+        // material was invalidated since it was last rendered.
+        this->dataPtr->shaderGenerator->validateMaterial(_scheme,
+            material->getName(), material->getGroup());
+      }
+      catch(Ogre::Exception &e)
+      {
+        gzerr << "Unable to validate shaders for material["
+          << material->getName() << "]\n";
+        continue;
+      }
+
+      for (unsigned int t = 0; t < material->getNumTechniques(); ++t)
+      {
+        Ogre::Technique *technique = material->getTechnique(t);
+        if (technique->getSchemeName() != _scheme)
+          continue;
+
+        for (unsigned int p = 0; p < technique->getNumPasses(); ++p)
+        {
+          Ogre::Pass *pass = technique->getPass(p);
+          if (pass->hasVertexProgram() &&
+              !pass->getVertexProgram()->isLoaded())
+          {
+            pass->getVertexProgram()->load();
+            this->dataPtr->precompiledProgramCount++;
+          }
+          if (pass->hasFragmentProgram() &&
+              !pass->getFragmentProgram()->isLoaded())
+          {
+            pass->getFragmentProgram()->load();
+            this->dataPtr->precompiledProgramCount++;
+          }
+        }
+      }
+    }
+  }
+
+  for (unsigned int i = 0; i < _vis->GetChildCount(); ++i)
+    this->PrecompileShaders(_vis->GetChild(i), _scheme);
+}
+
+/////////////////////////////////////////////////
+unsigned int RTShaderSystem::PrecompiledProgramCount() const
+{
+  return this->dataPtr->precompiledProgramCount;
+}
+
+/////////////////////////////////////////////////
+void RTShaderSystem::LoadProgramCache(const std::string &_cachePath)
+{
+#if OGRE_VERSION >= ((1 << 16) | (9 << 8) | 0)
+  Ogre::GpuProgramManager &programMgr =
+      Ogre::GpuProgramManager::getSingleton();
+  if (_cachePath.empty() || !programMgr.canGetCompiledShaderBuffer())
+    return;
+
+  // Program binaries are only valid for the driver that produced them, so
+  // key the cache file on the device and driver version.
+  const Ogre::RenderSystemCapabilities *capabilities =
+      Ogre::Root::getSingleton().getRenderSystem()->getCapabilities();
+  std::ostringstream stream;
+  stream << _cachePath << "programs-" << std::hex << std::hash<std::string>()(
+      capabilities->getDeviceName() +
+      capabilities->getDriverVersion().toString()) << ".cache";
+  this->dataPtr->programCacheFile = stream.str();
+
+  programMgr.setSaveMicrocodesToCache(true);
+
+  if (!boost::filesystem::exists(this->dataPtr->programCacheFile))
+    return;
+
+  try
+  {
+    Ogre::DataStreamPtr cache = Ogre::Root::getSingleton().openFileStream(
+        this->dataPtr->programCacheFile,
+        Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    programMgr.loadMicrocodeCache(cache);
+  }
+  catch(Ogre::Exception &e)
+  {
+    gzwarn << "Unable to load shader program cache ["
+      << this->dataPtr->programCacheFile << "]: " << e.what() << "\n";
+  }
+#endif
+}
+
+/////////////////////////////////////////////////
+void RTShaderSystem::SaveProgramCache()
+{
+#if OGRE_VERSION >= ((1 << 16) | (9 << 8) | 0)
+  Ogre::GpuProgramManager &programMgr =
+      Ogre::GpuProgramManager::getSingleton();
+  if (this->dataPtr->programCacheFile.empty() || !programMgr.isCacheDirty())
+    return;
+
+  try
+  {
+    Ogre::DataStreamPtr cache = Ogre::Root::getSingleton().createFileStream(
+        this->dataPtr->programCacheFile,
+        Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, true);
+    programMgr.saveMicrocodeCache(cache);
+  }
+  catch(Ogre::Exception &e)
+  {
+    gzwarn << "Unable to save shader program cache ["
+      << this->dataPtr->programCacheFile << "]: " << e.what() << "\n";
+  }
+#endif
+}
+
 /////////////////////////////////////////////////
 bool RTShaderSystem::SetShadowTextureSize(const unsigned int _size)
 {
@@ -752,6 +959,15 @@ void RTShaderSystem::UpdateShadows(ScenePtr _scene)
   // \todo(anyone) make point light shadows work
   sceneMgr->setShadowTextureCountPerLightType(Ogre::Light::LT_POINT, 6);
 
+  // Lights beyond the scene's limit don't render their shadow, see
+  // Scene::CullShadowLights.
+  const unsigned int maxShadowLights = _scene->MaxShadowLights();
+  if (maxShadowLights > 0u)
+  {
+    spotLightCount = std::min(spotLightCount, maxShadowLights);
+    pointLightCount = std::min(pointLightCount, maxShadowLights);
+  }
+
   // \todo(anyone) include point light shadows when it is working
   unsigned int dirShadowCount = 3 * dirLightCount;
   unsigned int spotShadowCount = spotLightCount;
@@ -122,6 +122,15 @@ namespace gazebo
       /// \param[in] _scene The scene to remove shadows from.
       public: void RemoveShadows(ScenePtr _scene);
 
+      /// \brief Set the number of point and spot lights the shaders of a
+      /// scene are generated for. By default, the shaders are generated for
+      /// the lights in view and generated again when that number changes.
+      /// \param[in] _scene The scene.
+      /// \param[in] _count Number of lights of each type, 0 for the lights
+      /// in view.
+      /// \sa Scene::SetLightsPerObject
+      public: void SetLightCount(ScenePtr _scene, const unsigned int _count);
+
       /// \brief Get the Ogre PSSM Shadows camera setup.
       /// \return The Ogre PSSM Shadows camera setup.
       public: Ogre::PSSMShadowCameraSetup *GetPSSMShadowCameraSetup() const;
@@ -169,6 +178,11 @@ namespace gazebo
       /// \return PSSM split point overlap.
       public: double ShadowSplitPadding() const;
 
+      /// \brief Get the number of GPU programs that were compiled when
+      /// their material was generated rather than when first rendered.
+      /// \return Number of precompiled programs.
+      public: unsigned int PrecompiledProgramCount() const;
+
       /// \brief Get paths for the shader system
       /// \param[out] _coreLibsPath Path to the core libraries.
       /// \param[out] _cachePath Path to where the generated shaders are
@@ -184,6 +198,22 @@ namespace gazebo
       /// \param[in] _scene Pointer to the scene to update
       private: void UpdateShadows(ScenePtr _scene);
 
+      /// \brief Generate and compile the shader programs of every material
+      /// used by a visual and its children, so that they are built at load
+      /// time instead of when a camera first renders them.
+      /// \param[in] _vis Pointer to the visual to precompile.
+      /// \param[in] _scheme Name of the scene's shader scheme.
+      private: void PrecompileShaders(const VisualPtr &_vis,
+                                      const std::string &_scheme);
+
+      /// \brief Load compiled program binaries saved by a previous run.
+      /// \param[in] _cachePath Path to where the generated shaders are
+      /// stored.
+      private: void LoadProgramCache(const std::string &_cachePath);
+
+      /// \brief Save compiled program binaries for the next run.
+      private: void SaveProgramCache();
+
       /// \brief Re-apply shadows. Call this if a shadow paramenter is changed.
       private: void ReapplyShadows();
 
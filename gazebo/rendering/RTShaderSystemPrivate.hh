@@ -86,6 +86,13 @@ namespace gazebo
 
       /// \brief Mutex to protect shaders and shadows update
       public: std::mutex updateMutex;
+
+      /// \brief File that persists compiled program binaries across runs.
+      /// Empty if the render system cannot retrieve program binaries.
+      public: std::string programCacheFile;
+
+      /// \brief Number of GPU programs compiled ahead of first use.
+      public: unsigned int precompiledProgramCount = 0u;
     };
   }
 }
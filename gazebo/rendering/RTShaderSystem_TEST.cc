@@ -55,6 +55,31 @@ TEST_F(RTShaderSystem_TEST, Shadows)
   EXPECT_DOUBLE_EQ(4.8, shaderSys->ShadowSplitPadding());
 }
 
+/////////////////////////////////////////////////
+TEST_F(RTShaderSystem_TEST, PrecompileShaders)
+{
+  Load("worlds/shapes.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  // Wait for the shapes to be loaded and their shaders generated
+  int sleep = 0;
+  int maxSleep = 50;
+  while (!scene->GetVisual("sphere") && sleep++ < maxSleep)
+    common::Time::MSleep(100);
+  ASSERT_TRUE(scene->GetVisual("sphere") != nullptr);
+
+  rendering::RTShaderSystem *shaderSys =
+      rendering::RTShaderSystem::Instance();
+  shaderSys->UpdateShaders();
+  shaderSys->Update();
+
+  // Programs of the generated materials are compiled without a camera
+  // rendering them.
+  EXPECT_GT(shaderSys->PrecompiledProgramCount(), 0u);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
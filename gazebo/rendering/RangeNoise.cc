@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <ignition/math/Rand.hh>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/RangeNoise.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+//////////////////////////////////////////////////
+void RangeNoise::SetShaderParams(Ogre::Pass *_pass) const
+{
+  GZ_ASSERT(_pass, "Null OGRE material pass");
+  Ogre::GpuProgramParametersSharedPtr params =
+      _pass->getFragmentProgramParameters();
+  GZ_ASSERT(!params.isNull(), "Null OGRE material GPU parameters");
+
+  // The offsets seed the pseudo random generator of the shader, so each
+  // frame gets a different noise pattern.
+  Ogre::Vector3 offsets;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    offsets[i] = this->uniform ? this->uniform() :
+        ignition::math::Rand::DblUniform(0.0, 1.0);
+  }
+
+  // These parameters are declared in media/materials/scripts/gazebo.material
+  // and in the depth_map.frag and laser_1st_pass.frag shaders.
+  params->setNamedConstant("noiseOffsets", offsets);
+  params->setNamedConstant("noiseMean", static_cast<Ogre::Real>(this->mean));
+  params->setNamedConstant("noiseStdDev",
+      static_cast<Ogre::Real>(this->stdDev));
+  params->setNamedConstant("noiseRangeStdDev",
+      static_cast<Ogre::Real>(this->rangeStdDev));
+  params->setNamedConstant("noiseDropout",
+      static_cast<Ogre::Real>(this->dropout));
+  params->setNamedConstant("noiseRangeDropout",
+      static_cast<Ogre::Real>(this->rangeDropout));
+  params->setNamedConstant("noisePrecision",
+      static_cast<Ogre::Real>(this->precision));
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_RANGENOISE_HH_
+#define GAZEBO_RENDERING_RANGENOISE_HH_
+
+#include <functional>
+
+#include "gazebo/util/system.hh"
+
+namespace Ogre
+{
+  class Pass;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \addtogroup gazebo_rendering
+    /// \{
+
+    /// \class RangeNoise RangeNoise.hh rendering/rendering.hh
+    /// \brief Parameters of the noise that the shaders of GpuLaser and
+    /// DepthCamera add to ranges as they render them, so the noisy values
+    /// are read back directly.
+    ///
+    /// A range r becomes r + mean + (stdDev + rangeStdDev * r) * n, where
+    /// n is a standard normal value, rounded to precision if it is not
+    /// zero. With probability dropout + rangeDropout * r the reading is
+    /// dropped and reported as the far clip distance, as if there were no
+    /// return.
+    class GZ_RENDERING_VISIBLE RangeNoise
+    {
+      /// \brief Check if the parameters add any noise.
+      /// \return True if the noise is not zero.
+      public: bool Enabled() const
+      {
+        return this->mean != 0.0 || this->stdDev > 0.0 ||
+          this->rangeStdDev > 0.0 || this->dropout > 0.0 ||
+          this->rangeDropout > 0.0 || this->precision > 0.0;
+      }
+
+      /// \brief Set the noise parameters of a pass that renders with the
+      /// Gazebo/DepthMapFS or Gazebo/LaserScan1stFS fragment programs, with
+      /// fresh random offsets.
+      /// \param[in] _pass Pass to update.
+      public: void SetShaderParams(Ogre::Pass *_pass) const;
+
+      /// \brief Offset added to all ranges, in meters.
+      public: double mean = 0.0;
+
+      /// \brief Standard deviation of the noise, in meters.
+      public: double stdDev = 0.0;
+
+      /// \brief Standard deviation added per meter of range.
+      public: double rangeStdDev = 0.0;
+
+      /// \brief Probability of dropping a reading.
+      public: double dropout = 0.0;
+
+      /// \brief Probability of dropping a reading added per meter of
+      /// range.
+      public: double rangeDropout = 0.0;
+
+      /// \brief Precision the ranges are rounded to, zero to disable.
+      public: double precision = 0.0;
+
+      /// \brief Draws uniform values in [0, 1) that seed the pseudo random
+      /// generator of the shaders on each frame. If empty, the renderer
+      /// uses ignition::math::Rand.
+      public: std::function<double ()> uniform;
+    };
+    /// \}
+  }
+}
+#endif
@@ -18,6 +18,7 @@
 #include <ignition/math/Triangle.hh>
 #include <ignition/math/Vector3.hh>
 
+#include "gazebo/common/MeshBVH.hh"
 #include "gazebo/common/MeshManager.hh"
 
 #include "gazebo/rendering/Camera.hh"
@@ -65,79 +66,53 @@ bool RayQuery::SelectMeshTriangle(const int _x, const int _y,
   std::vector<rendering::VisualPtr> visuals;
   this->MeshVisuals(_visual, visuals);
 
-  Ogre::Real closestDistance = -1.0f;
-  Ogre::Vector3 closestResult;
-  bool newClosestFound = false;
-  std::vector<Ogre::Vector3> vertices;
+  double closestDistance = -1.0;
+  ignition::math::Triangle3d closestTriangle;
 
   for (unsigned int i = 0; i < visuals.size(); ++i)
   {
-    const common::Mesh *mesh =
-        common::MeshManager::Instance()->GetMesh(visuals[i]->GetMeshName());
+    std::shared_ptr<const common::MeshBVH> bvh =
+        common::MeshManager::Instance()->BVH(visuals[i]->GetMeshName());
+    if (!bvh)
+      continue;
 
-    if (!mesh)
+    // Cast the ray in the frame of the mesh, where the hierarchy was built.
+    // The direction is transformed without normalizing it, so the distance
+    // to the hit is the same in both frames.
+    const Ogre::Matrix4 &transform =
+        visuals[i]->GetSceneNode()->_getFullTransform();
+    const Ogre::Matrix4 inverse = transform.inverseAffine();
+    Ogre::Matrix3 inverseRot;
+    inverse.extract3x3Matrix(inverseRot);
+
+    double distance;
+    ignition::math::Triangle3d triangle;
+    if (!bvh->Intersect(
+        Conversions::ConvertIgn(inverse.transformAffine(ray.getOrigin())),
+        Conversions::ConvertIgn(inverseRot * ray.getDirection()),
+        distance, triangle))
+    {
       continue;
+    }
 
-    Ogre::Matrix4 transform = visuals[i]->GetSceneNode()->_getFullTransform();
-    // test for hitting individual triangles on the mesh
-    for (unsigned int j = 0; j < mesh->GetSubMeshCount(); ++j)
+    if (closestDistance < 0.0 || distance < closestDistance)
     {
-      const common::SubMesh *submesh = mesh->GetSubMesh(j);
-      if (submesh->GetVertexCount() < 3u)
-        continue;
-      unsigned int indexCount = submesh->GetIndexCount();
-      for (unsigned int k = 0; k < indexCount; k += 3)
-      {
-        if (indexCount <= k+2)
-          continue;
-
-        ignition::math::Vector3d vertexA =
-          submesh->Vertex(submesh->GetIndex(k));
-        ignition::math::Vector3d vertexB =
-          submesh->Vertex(submesh->GetIndex(k+1));
-        ignition::math::Vector3d vertexC =
-          submesh->Vertex(submesh->GetIndex(k+2));
-
-        Ogre::Vector3 worldVertexA = transform * Conversions::Convert(vertexA);
-        Ogre::Vector3 worldVertexB = transform * Conversions::Convert(vertexB);
-        Ogre::Vector3 worldVertexC = transform * Conversions::Convert(vertexC);
-
-        // check for a hit against this triangle
-        std::pair<bool, Ogre::Real> hit = Ogre::Math::intersects(ray,
-            worldVertexA, worldVertexB, worldVertexC,
-           (worldVertexB - worldVertexA).crossProduct(
-           worldVertexC - worldVertexA));
-
-        // if it was a hit check if its the closest
-        if (hit.first &&
-            (closestDistance < 0.0f || hit.second < closestDistance))
-        {
-          // this is the closest so far, save it off
-          closestDistance = hit.second;
-          vertices.clear();
-          vertices.push_back(worldVertexA);
-          vertices.push_back(worldVertexB);
-          vertices.push_back(worldVertexC);
-          newClosestFound = true;
-        }
-      }
+      closestDistance = distance;
+      closestTriangle.Set(
+          Conversions::ConvertIgn(transform.transformAffine(
+          Conversions::Convert(triangle[0]))),
+          Conversions::ConvertIgn(transform.transformAffine(
+          Conversions::Convert(triangle[1]))),
+          Conversions::ConvertIgn(transform.transformAffine(
+          Conversions::Convert(triangle[2]))));
     }
   }
 
-  // if we found a new closest raycast for this object, update the
-  // closestResult before moving on to the next object.
-  if (newClosestFound)
-    closestResult = ray.getPoint(closestDistance);
-
-  // return the result
-  if (closestDistance >= 0.0f && vertices.size() == 3u)
+  if (closestDistance >= 0.0)
   {
     // raycast success
-    _intersect = Conversions::ConvertIgn(closestResult);
-    _triangle.Set(
-        Conversions::ConvertIgn(vertices[0]),
-        Conversions::ConvertIgn(vertices[1]),
-        Conversions::ConvertIgn(vertices[2]));
+    _intersect = Conversions::ConvertIgn(ray.getPoint(closestDistance));
+    _triangle = closestTriangle;
     return true;
   }
   // raycast failed
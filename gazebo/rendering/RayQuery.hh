@@ -48,7 +48,9 @@ namespace gazebo
       /// \brief Destructor
       public: ~RayQuery();
 
-      /// \brief Select a triangle on mesh given screen coordinates
+      /// \brief Select a triangle on mesh given screen coordinates. The
+      /// ray is cast in the frame of each mesh, against the bounding volume
+      /// hierarchy cached by common::MeshManager::BVH.
       /// \param[in] _x X position on screen in pixels.
       /// \param[in] _y Y position on screen in pixels.
       /// \param[in] _visual Visual containing the mesh to be selected.
@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <cstdlib>
 #include <string>
 #include <iostream>
 #include <functional>
@@ -33,9 +34,13 @@
   #include "gazebo/common/win_dirent.h"
 #endif
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/gazebo_config.h"
 
-#include <ignition/common/Profiler.hh>
+#ifdef HAVE_EGL
+# include <EGL/egl.h>
+# include <EGL/eglext.h>
+#endif
 
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Events.hh"
@@ -47,6 +52,7 @@
 #include "gazebo/rendering/Material.hh"
 #include "gazebo/rendering/RenderEvents.hh"
 #include "gazebo/rendering/RTShaderSystem.hh"
+#include "gazebo/rendering/TextureLoader.hh"
 #include "gazebo/rendering/WindowManager.hh"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/rendering/RenderTypes.hh"
@@ -68,6 +74,7 @@ RenderEngine::RenderEngine()
 #endif
 
   this->dummyDisplay = NULL;
+  this->dummyWindowId = 0;
 
   this->dataPtr->initialized = false;
 
@@ -86,7 +93,8 @@ void RenderEngine::Load()
 {
   if (!this->CreateContext())
   {
-    gzwarn << "Unable to create X window. Rendering will be disabled\n";
+    gzwarn << "Unable to create a rendering context. "
+           << "Rendering will be disabled\n";
     return;
   }
 
@@ -264,6 +272,7 @@ unsigned int RenderEngine::SceneCount() const
 void RenderEngine::PreRender()
 {
   IGN_PROFILE("rendering::RenderEngine::PreRender");
+  TextureLoader::Instance()->Update();
   this->dataPtr->root->_fireFrameStarted();
 }
 
@@ -335,6 +344,7 @@ void RenderEngine::Fini()
   this->dataPtr->connections.clear();
 
   RTShaderSystem::Instance()->Fini();
+  TextureLoader::Instance()->Fini();
 
   // Deallocate memory for every scene
   while (!this->dataPtr->scenes.empty())
@@ -391,6 +401,24 @@ void RenderEngine::Fini()
   }
 # endif
 
+#ifdef HAVE_EGL
+  if (this->dataPtr->eglDisplay)
+  {
+    EGLDisplay display = static_cast<EGLDisplay>(this->dataPtr->eglDisplay);
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (this->dataPtr->eglContext)
+      eglDestroyContext(display,
+          static_cast<EGLContext>(this->dataPtr->eglContext));
+    if (this->dataPtr->eglSurface)
+      eglDestroySurface(display,
+          static_cast<EGLSurface>(this->dataPtr->eglSurface));
+    eglTerminate(display);
+    this->dataPtr->eglDisplay = nullptr;
+    this->dataPtr->eglSurface = nullptr;
+    this->dataPtr->eglContext = nullptr;
+  }
+#endif
+
   this->dataPtr->initialized = false;
 }
 
@@ -550,6 +578,18 @@ void RenderEngine::AddResourcePath(const std::string &_uri)
   }
 }
 
+//////////////////////////////////////////////////
+bool RenderEngine::UsesEGL() const
+{
+  return this->dataPtr->eglContext != nullptr;
+}
+
+//////////////////////////////////////////////////
+int RenderEngine::EGLDevice() const
+{
+  return this->UsesEGL() ? this->dataPtr->eglDevice : -1;
+}
+
 //////////////////////////////////////////////////
 RenderEngine::RenderPathType RenderEngine::GetRenderPathType() const
 {
@@ -736,11 +776,35 @@ void RenderEngine::SetupRenderSystem()
 /////////////////////////////////////////////////
 bool RenderEngine::CreateContext()
 {
-  bool result = true;
-
 #if defined __APPLE__ || _WIN32
   this->dummyDisplay = 0;
+  return true;
 #else
+  // Render nodes often have a GPU but no X server, EGL renders without one
+  const char *env = std::getenv("GAZEBO_EGL");
+  if (env && std::string(env) == "1")
+    return this->CreateEGLContext();
+
+  if (this->CreateGLXContext())
+    return true;
+
+# ifdef HAVE_EGL
+  if (this->CreateEGLContext())
+  {
+    gzmsg << "No X display, rendering with an EGL pbuffer context\n";
+    return true;
+  }
+# endif
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool RenderEngine::CreateGLXContext()
+{
+  bool result = true;
+
+#if not defined(__APPLE__) && not defined(_WIN32)
   try
   {
     this->dummyDisplay = XOpenDisplay(0);
@@ -792,6 +856,134 @@ bool RenderEngine::CreateContext()
   return result;
 }
 
+/////////////////////////////////////////////////
+bool RenderEngine::CreateEGLContext()
+{
+#ifdef HAVE_EGL
+  EGLDisplay display = EGL_NO_DISPLAY;
+
+  // Prefer a display bound to a GPU device, which needs no window system
+  auto queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(
+      eglGetProcAddress("eglQueryDevicesEXT"));
+  auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+      eglGetProcAddress("eglGetPlatformDisplayEXT"));
+  if (queryDevices && getPlatformDisplay)
+  {
+    EGLDeviceEXT devices[16];
+    EGLint deviceCount = 0;
+    if (queryDevices(16, devices, &deviceCount))
+    {
+      // Processes sharing a machine can each render on their own GPU
+      EGLint first = 0;
+      const char *deviceEnv = std::getenv("GAZEBO_EGL_DEVICE");
+      if (deviceEnv)
+      {
+        try
+        {
+          first = std::stoi(deviceEnv);
+        }
+        catch(...)
+        {
+          first = -1;
+        }
+        if (first < 0 || first >= deviceCount)
+        {
+          gzwarn << "GAZEBO_EGL_DEVICE [" << deviceEnv << "] is not one of "
+                 << "the " << deviceCount << " EGL devices, using the first "
+                 << "device that works\n";
+          first = 0;
+        }
+      }
+
+      for (EGLint n = 0; n < deviceCount && display == EGL_NO_DISPLAY; ++n)
+      {
+        const EGLint i = (first + n) % deviceCount;
+        EGLDisplay deviceDisplay = getPlatformDisplay(
+            EGL_PLATFORM_DEVICE_EXT, devices[i], nullptr);
+        if (deviceDisplay != EGL_NO_DISPLAY &&
+            eglInitialize(deviceDisplay, nullptr, nullptr))
+        {
+          display = deviceDisplay;
+          this->dataPtr->eglDevice = i;
+        }
+        else if (deviceEnv && n == 0)
+        {
+          gzwarn << "Unable to render on EGL device [" << i << "]\n";
+        }
+      }
+    }
+  }
+
+  if (display == EGL_NO_DISPLAY)
+  {
+    display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+    {
+      gzerr << "Unable to initialize an EGL display\n";
+      return false;
+    }
+  }
+  this->dataPtr->eglDisplay = display;
+
+  const EGLint configAttribs[] = {
+    EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+    EGL_RED_SIZE, 8,
+    EGL_GREEN_SIZE, 8,
+    EGL_BLUE_SIZE, 8,
+    EGL_DEPTH_SIZE, 16,
+    EGL_STENCIL_SIZE, 8,
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_NONE};
+  EGLConfig config;
+  EGLint configCount = 0;
+  if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) ||
+      configCount < 1)
+  {
+    gzerr << "Unable to find an EGL pbuffer configuration\n";
+    return false;
+  }
+
+  // Sensors render to textures, the surface is only needed to make the
+  // context current.
+  const EGLint pbufferAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+  EGLSurface surface = eglCreatePbufferSurface(display, config,
+      pbufferAttribs);
+  if (surface == EGL_NO_SURFACE)
+  {
+    gzerr << "Unable to create an EGL pbuffer surface\n";
+    return false;
+  }
+  this->dataPtr->eglSurface = surface;
+
+  if (!eglBindAPI(EGL_OPENGL_API))
+  {
+    gzerr << "Unable to bind the OpenGL API to EGL\n";
+    return false;
+  }
+
+  EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT,
+      nullptr);
+  if (context == EGL_NO_CONTEXT)
+  {
+    gzerr << "Unable to create an EGL context\n";
+    return false;
+  }
+  this->dataPtr->eglContext = context;
+
+  if (!eglMakeCurrent(display, surface, surface, context))
+  {
+    gzerr << "Unable to make the EGL context current\n";
+    return false;
+  }
+
+  return true;
+#else
+  gzerr << "Gazebo was built without EGL, unable to render without an X "
+        << "server\n";
+  return false;
+#endif
+}
+
 /////////////////////////////////////////////////
 void RenderEngine::CheckSystemCapabilities()
 {
@@ -876,6 +1068,52 @@ std::vector<unsigned int> RenderEngine::FSAALevels() const
   return this->dataPtr->fsaaLevels;
 }
 
+/////////////////////////////////////////////////
+void RenderEngine::SetMeshLod(const bool _enable)
+{
+  this->dataPtr->meshLod = _enable;
+}
+
+/////////////////////////////////////////////////
+bool RenderEngine::MeshLod() const
+{
+  return this->dataPtr->meshLod;
+}
+
+/////////////////////////////////////////////////
+bool RenderEngine::SetMeshLodDistances(const std::vector<double> &_distances)
+{
+  for (unsigned int i = 0; i < _distances.size(); ++i)
+  {
+    if (_distances[i] <= 0 || (i > 0 && _distances[i] <= _distances[i-1]))
+    {
+      gzerr << "Mesh LOD distances must be positive and increasing\n";
+      return false;
+    }
+  }
+
+  this->dataPtr->meshLodDistances = _distances;
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::vector<double> RenderEngine::MeshLodDistances() const
+{
+  return this->dataPtr->meshLodDistances;
+}
+
+/////////////////////////////////////////////////
+void RenderEngine::SetMeshLodMinVertices(const unsigned int _count)
+{
+  this->dataPtr->meshLodMinVertices = _count;
+}
+
+/////////////////////////////////////////////////
+unsigned int RenderEngine::MeshLodMinVertices() const
+{
+  return this->dataPtr->meshLodMinVertices;
+}
+
 #if (OGRE_VERSION >= ((1 << 16) | (9 << 8) | 0))
 /////////////////////////////////////////////////
 Ogre::OverlaySystem *RenderEngine::OverlaySystem() const
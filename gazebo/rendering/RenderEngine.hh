@@ -124,6 +124,21 @@ namespace gazebo
       /// \return The RenderPathType
       public: RenderPathType GetRenderPathType() const;
 
+      /// \brief Does the engine render through an EGL pbuffer context
+      /// instead of an X window? EGL is used when no X display can be
+      /// opened, or when the GAZEBO_EGL environment variable is 1. The OGRE
+      /// GL render system must then be built with EGL support.
+      /// \return True if EGL is in use.
+      public: bool UsesEGL() const;
+
+      /// \brief Get the GPU rendered on by the EGL context. All the scenes
+      /// and sensors of a process share one OGRE root, hence one GPU. Set
+      /// the GAZEBO_EGL_DEVICE environment variable to a device index to
+      /// choose it, and run one process per GPU to use several of them.
+      /// \return Index of the EGL device, -1 if EGL is not used or renders
+      /// on the default display.
+      public: int EGLDevice() const;
+
       /// \brief Get a pointer to the window manager.
       /// \return Pointer to the window manager.
       public: WindowManagerPtr GetWindowManager() const;
@@ -136,6 +151,39 @@ namespace gazebo
       /// \return a list of FSAA levels
       public: std::vector<unsigned int> FSAALevels() const;
 
+      /// \brief Generate levels of detail for the meshes loaded from now
+      /// on. Each level removes more triangles and is used beyond one of
+      /// the MeshLodDistances(). Levels stored in Ogre mesh files are
+      /// always used. Generating levels requires Ogre 1.9 or newer.
+      /// \param[in] _enable True to generate levels of detail. Disabled by
+      /// default.
+      /// \sa Camera::SetLodBias(const double _bias)
+      public: void SetMeshLod(const bool _enable);
+
+      /// \brief Get whether levels of detail are generated for meshes.
+      /// \return True if levels of detail are generated.
+      public: bool MeshLod() const;
+
+      /// \brief Set the camera distances at which the generated levels of
+      /// detail start. Level i keeps 1 / 2^(i+1) of the vertices.
+      /// \param[in] _distances Increasing distances in meters.
+      /// \return False if the distances are not positive and increasing.
+      public: bool SetMeshLodDistances(const std::vector<double> &_distances);
+
+      /// \brief Get the camera distances of the generated levels of detail.
+      /// \return Distances in meters. The default is 20, 50 and 100.
+      public: std::vector<double> MeshLodDistances() const;
+
+      /// \brief Set the number of vertices below which a mesh gets no
+      /// generated levels of detail.
+      /// \param[in] _count Number of vertices.
+      public: void SetMeshLodMinVertices(const unsigned int _count);
+
+      /// \brief Get the number of vertices below which a mesh gets no
+      /// generated levels of detail.
+      /// \return Number of vertices. The default is 2000.
+      public: unsigned int MeshLodMinVertices() const;
+
 #if OGRE_VERSION_MAJOR > 1 || OGRE_VERSION_MINOR >= 9
       /// \internal
       /// \brief Get a pointer to the Ogre overlay system.
@@ -168,6 +216,14 @@ namespace gazebo
       /// \brief Check the rendering capabilities of the system.
       private: void CheckSystemCapabilities();
 
+      /// \brief Create the dummy GLX window and context.
+      /// \return True on success.
+      private: bool CreateGLXContext();
+
+      /// \brief Create an EGL pbuffer context, which needs no X server.
+      /// \return True on success.
+      private: bool CreateEGLContext();
+
       /// \brief ID for a dummy window. Used for gui-less operation
       protected: uint64_t dummyWindowId;
 
@@ -55,6 +55,19 @@ namespace gazebo
       /// \brief True if initialized.
       public: bool initialized;
 
+      /// \brief EGL display, when rendering without an X server.
+      public: void *eglDisplay = nullptr;
+
+      /// \brief EGL pbuffer surface, when rendering without an X server.
+      public: void *eglSurface = nullptr;
+
+      /// \brief EGL context, when rendering without an X server.
+      public: void *eglContext = nullptr;
+
+      /// \brief Index of the EGL device rendered on, -1 for the default
+      /// display.
+      public: int eglDevice = -1;
+
       /// \brief All the event connections.
       public: std::vector<event::ConnectionPtr> connections;
 
@@ -67,6 +80,15 @@ namespace gazebo
       /// \brief A list of supported fsaa levels
       public: std::vector<unsigned int> fsaaLevels;
 
+      /// \brief True to generate levels of detail for meshes.
+      public: bool meshLod = false;
+
+      /// \brief Camera distances of the generated levels of detail.
+      public: std::vector<double> meshLodDistances = {20.0, 50.0, 100.0};
+
+      /// \brief Meshes with fewer vertices get no levels of detail.
+      public: unsigned int meshLodMinVertices = 2000;
+
 #if OGRE_VERSION_MAJOR > 1 || OGRE_VERSION_MINOR >= 9
       /// \brief Ogre overlay system needed for initialization of Ogre
       public: Ogre::OverlaySystem *overlaySystem;
@@ -17,7 +17,11 @@
 
 #include <gtest/gtest.h>
 #include "gazebo/test/ServerFixture.hh"
+#include "gazebo/common/MeshManager.hh"
+#include "gazebo/rendering/Camera.hh"
 #include "gazebo/rendering/RenderEngine.hh"
+#include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/Visual.hh"
 
 using namespace gazebo;
 class RenderEngine_TEST : public RenderingFixture
@@ -50,6 +54,71 @@ TEST_F(RenderEngine_TEST, FSAATest)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(RenderEngine_TEST, MeshLod)
+{
+  Load("worlds/empty.world");
+
+  rendering::ScenePtr scene = rendering::get_scene("default");
+  if (!scene)
+    scene = rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::RenderEngine *engine = rendering::RenderEngine::Instance();
+  EXPECT_FALSE(engine->MeshLod());
+  EXPECT_EQ(2000u, engine->MeshLodMinVertices());
+  EXPECT_EQ(3u, engine->MeshLodDistances().size());
+
+  // distances must be positive and increasing
+  EXPECT_FALSE(engine->SetMeshLodDistances({10.0, 5.0}));
+  EXPECT_FALSE(engine->SetMeshLodDistances({-1.0}));
+  EXPECT_EQ(3u, engine->MeshLodDistances().size());
+  EXPECT_TRUE(engine->SetMeshLodDistances({10.0, 30.0}));
+  EXPECT_EQ(2u, engine->MeshLodDistances().size());
+
+  // meshes loaded before enabling get no levels of detail
+  common::MeshManager::Instance()->CreateSphere("lod_sphere_off", 1.0,
+      64, 64);
+  rendering::Visual::InsertMesh(
+      common::MeshManager::Instance()->GetMesh("lod_sphere_off"));
+  Ogre::MeshPtr mesh =
+      Ogre::MeshManager::getSingleton().getByName("lod_sphere_off");
+  ASSERT_FALSE(mesh.isNull());
+  EXPECT_EQ(1u, mesh->getNumLodLevels());
+
+  engine->SetMeshLod(true);
+  EXPECT_TRUE(engine->MeshLod());
+  common::MeshManager::Instance()->CreateSphere("lod_sphere", 1.0, 64, 64);
+  rendering::Visual::InsertMesh(
+      common::MeshManager::Instance()->GetMesh("lod_sphere"));
+  mesh = Ogre::MeshManager::getSingleton().getByName("lod_sphere");
+  ASSERT_FALSE(mesh.isNull());
+#if OGRE_VERSION_MAJOR > 1 || OGRE_VERSION_MINOR >= 9
+  EXPECT_EQ(3u, mesh->getNumLodLevels());
+#endif
+
+  // small meshes are left untouched
+  common::MeshManager::Instance()->CreateSphere("lod_sphere_small", 1.0,
+      8, 8);
+  rendering::Visual::InsertMesh(
+      common::MeshManager::Instance()->GetMesh("lod_sphere_small"));
+  mesh = Ogre::MeshManager::getSingleton().getByName("lod_sphere_small");
+  ASSERT_FALSE(mesh.isNull());
+  EXPECT_EQ(1u, mesh->getNumLodLevels());
+
+  engine->SetMeshLod(false);
+
+  // per camera bias
+  rendering::CameraPtr camera = scene->CreateCamera("lod_camera", false);
+  ASSERT_TRUE(camera != nullptr);
+  EXPECT_DOUBLE_EQ(1.0, camera->LodBias());
+  camera->SetLodBias(0.25);
+  EXPECT_DOUBLE_EQ(0.25, camera->LodBias());
+  camera->SetLodBias(0.0);
+  EXPECT_DOUBLE_EQ(0.25, camera->LodBias());
+  scene->RemoveCamera("lod_camera");
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
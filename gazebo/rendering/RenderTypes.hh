@@ -29,6 +29,11 @@
 /// \brief Renders only objects that can be selected.
 #define GZ_VISIBILITY_SELECTION       0x10000000
 
+/// \def GZ_VISIBILITY_STATIC
+/// \brief Objects of static visuals, which cast the cached static shadows.
+/// It lies outside GZ_VISIBILITY_ALL, so camera masks are not affected.
+#define GZ_VISIBILITY_STATIC          0x20000000
+
 /// \def GZ_VISIBILITY_GUI
 /// \brief Render GUI visuals mask.
 #define GZ_VISIBILITY_GUI             0x00000001
@@ -72,6 +77,8 @@ namespace gazebo
     class Distortion;
     class LensFlare;
     class Road2d;
+    class CameraAtlas;
+    class Frame;
 
 #ifdef HAVE_OCULUS
     class OculusCamera;
@@ -205,6 +212,14 @@ namespace gazebo
     /// \brief Shared pointer to Road2d
     typedef std::shared_ptr<Road2d> Road2dPtr;
 
+    /// \def CameraAtlasPtr
+    /// \brief Shared pointer to CameraAtlas
+    typedef std::shared_ptr<CameraAtlas> CameraAtlasPtr;
+
+    /// \def FramePtr
+    /// \brief Shared pointer to a const Frame
+    typedef std::shared_ptr<const Frame> FramePtr;
+
 #ifdef HAVE_OCULUS
     /// \def OculusCameraPtr
     /// \brief Shared pointer to OculusCamera
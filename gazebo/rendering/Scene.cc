@@ -15,22 +15,30 @@
  *
 */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <functional>
+#include <numeric>
+#include <set>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Color.hh>
 #include <ignition/math/Helpers.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/rendering/skyx/include/SkyX.h"
 #include "gazebo/rendering/ogre_gazebo.h"
 
 #include "gazebo/msgs/msgs.hh"
 
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MeshBVH.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/rendering/Road2d.hh"
 #include "gazebo/rendering/Projector.hh"
 #include "gazebo/rendering/Heightmap.hh"
@@ -52,6 +60,7 @@
 #include "gazebo/rendering/RenderEngine.hh"
 #include "gazebo/rendering/UserCamera.hh"
 #include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/CameraAtlas.hh"
 #include "gazebo/rendering/WideAngleCamera.hh"
 #include "gazebo/rendering/DepthCamera.hh"
 #include "gazebo/rendering/GpuLaser.hh"
@@ -97,6 +106,66 @@ struct VisualMessageLess {
     }
 } VisualMessageLessOp;
 
+//////////////////////////////////////////////////
+/// \brief Load the queued mesh files until asked to stop. Parsing a mesh
+/// is the slow part of creating a visual, here it happens off the render
+/// thread, which then finds the mesh in the MeshManager.
+/// \param[in] _data Scene data with the mesh queue.
+static void RunMeshLoader(ScenePrivate *_data)
+{
+  while (true)
+  {
+    std::string uri;
+    {
+      std::unique_lock<std::mutex> lock(_data->meshMutex);
+      _data->meshCondition.wait(lock, [_data]
+          {
+            return _data->meshStop || !_data->meshQueue.empty();
+          });
+      if (_data->meshStop)
+        return;
+
+      uri = _data->meshQueue.front();
+      _data->meshQueue.pop_front();
+    }
+
+    // Visual::GetMeshName uses the same name
+    const std::string filename = common::find_file(uri);
+    common::MeshManager *meshManager = common::MeshManager::Instance();
+    if (!filename.empty() && meshManager->IsValidFilename(filename) &&
+        !meshManager->HasMesh(filename))
+    {
+      meshManager->Load(filename);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Queue the mesh of a visual to load it in the background.
+/// \param[in] _data Scene data with the mesh queue.
+/// \param[in] _msg Visual message.
+static void QueueMesh(ScenePrivate *_data, const msgs::Visual &_msg)
+{
+  if (!_msg.has_geometry() || !_msg.geometry().has_mesh() ||
+      _msg.geometry().mesh().filename().empty())
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(_data->meshMutex);
+  if (!_data->meshRequested.insert(_msg.geometry().mesh().filename()).second)
+    return;
+
+  if (!_data->meshThread.joinable())
+  {
+    _data->meshStop = false;
+    _data->meshThread = std::thread(RunMeshLoader, _data);
+  }
+
+  _data->meshQueue.push_back(_msg.geometry().mesh().filename());
+  _data->meshCondition.notify_one();
+}
+
 //////////////////////////////////////////////////
 Scene::Scene()
   : dataPtr(new ScenePrivate)
@@ -178,10 +247,15 @@ Scene::Scene(const std::string &_name, const bool _enableVisualizations,
   this->dataPtr->skeletonPoseSub =
       this->dataPtr->node->Subscribe("~/skeleton_pose/info",
       &Scene::OnSkeletonPoseMsg, this);
+  this->dataPtr->skeletonPoseBatchSub =
+      this->dataPtr->node->Subscribe("~/skeleton_pose/batch",
+      &Scene::OnSkeletonPoseBatchMsg, this);
   this->dataPtr->skySub =
       this->dataPtr->node->Subscribe("~/sky", &Scene::OnSkyMsg, this);
   this->dataPtr->modelInfoSub = this->dataPtr->node->Subscribe("~/model/info",
                                              &Scene::OnModelMsg, this);
+  this->dataPtr->modelInfoVSub = this->dataPtr->node->Subscribe(
+      "~/model/info_v", &Scene::OnModelVMsg, this);
 
   this->dataPtr->roadSub =
       this->dataPtr->node->Subscribe("~/roads", &Scene::OnRoadMsg, this, true);
@@ -263,6 +337,7 @@ void Scene::Clear()
   this->dataPtr->sensorSub.reset();
   this->dataPtr->sceneSub.reset();
   this->dataPtr->skeletonPoseSub.reset();
+  this->dataPtr->skeletonPoseBatchSub.reset();
   this->dataPtr->visSub.reset();
   this->dataPtr->skySub.reset();
   this->dataPtr->lightFactorySub.reset();
@@ -270,6 +345,7 @@ void Scene::Clear()
   this->dataPtr->requestSub.reset();
   this->dataPtr->responseSub.reset();
   this->dataPtr->modelInfoSub.reset();
+  this->dataPtr->modelInfoVSub.reset();
   this->dataPtr->responsePub.reset();
   this->dataPtr->requestPub.reset();
   this->dataPtr->roadSub.reset();
@@ -294,18 +370,34 @@ void Scene::Clear()
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
     this->dataPtr->poseMsgs.clear();
+    this->dataPtr->pendingPoseMsgs.clear();
+    this->dataPtr->poseInterpolants.clear();
   }
 
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->meshMutex);
+    this->dataPtr->meshStop = true;
+    this->dataPtr->meshQueue.clear();
+    this->dataPtr->meshRequested.clear();
+  }
+  this->dataPtr->meshCondition.notify_all();
+  if (this->dataPtr->meshThread.joinable())
+    this->dataPtr->meshThread.join();
+
   this->dataPtr->joints.clear();
 
   delete this->dataPtr->terrain;
   this->dataPtr->terrain = NULL;
   this->dataPtr->terrainVisualId.reset();
 
+  this->dataPtr->visualBatches.reset();
+
   while (!this->dataPtr->visuals.empty())
     this->RemoveVisual(this->dataPtr->visuals.begin()->first);
 
   this->dataPtr->visuals.clear();
+  this->dataPtr->visualIndex.clear();
+  this->dataPtr->visualIndexDirty = true;
 
   if (this->dataPtr->originVisual)
   {
@@ -331,6 +423,7 @@ void Scene::Clear()
   for (unsigned int i = 0; i < this->dataPtr->cameras.size(); ++i)
     this->dataPtr->cameras[i]->Fini();
   this->dataPtr->cameras.clear();
+  this->dataPtr->cameraAtlases.clear();
 
   for (unsigned int i = 0; i < this->dataPtr->userCameras.size(); ++i)
     this->dataPtr->userCameras[i]->Fini();
@@ -354,6 +447,7 @@ void Scene::Clear()
 Scene::~Scene()
 {
   this->Clear();
+  this->dataPtr->shadowCache.reset();
 
   this->dataPtr->requestMsg.reset(nullptr);
   delete this->dataPtr->receiveMutex;
@@ -379,12 +473,15 @@ void Scene::Load()
   this->dataPtr->initialized = false;
   Ogre::Root *root = RenderEngine::Instance()->Root();
 
+  this->dataPtr->visualBatches.reset();
+  this->dataPtr->shadowCache.reset();
   if (this->dataPtr->manager)
     root->destroySceneManager(this->dataPtr->manager);
 
   this->dataPtr->manager = root->createSceneManager(Ogre::ST_GENERIC);
   this->dataPtr->manager->setAmbientLight(
       Ogre::ColourValue(0.1, 0.1, 0.1, 0.1));
+  this->dataPtr->shadowCache.reset(new ShadowCache(this->dataPtr->manager));
 
 #if OGRE_VERSION_MAJOR > 1 || OGRE_VERSION_MINOR >= 9
   this->dataPtr->manager->addRenderQueueListener(
@@ -485,6 +582,42 @@ bool Scene::Initialized() const
   return this->dataPtr->initialized;
 }
 
+//////////////////////////////////////////////////
+void Scene::SetLoadBudget(const double _budget)
+{
+  std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  this->dataPtr->loadBudget = std::max(_budget, 0.0);
+}
+
+//////////////////////////////////////////////////
+double Scene::LoadBudget() const
+{
+  std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  return this->dataPtr->loadBudget;
+}
+
+//////////////////////////////////////////////////
+size_t Scene::PendingVisualCount() const
+{
+  std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  return this->dataPtr->modelVisualMsgs.size() +
+      this->dataPtr->linkVisualMsgs.size() +
+      this->dataPtr->visualMsgs.size() +
+      this->dataPtr->collisionVisualMsgs.size();
+}
+
+/////////////////////////////////////////////////
+uint64_t Scene::ChangeCount() const
+{
+  return this->dataPtr->changeCount;
+}
+
+/////////////////////////////////////////////////
+void Scene::MarkChanged()
+{
+  ++this->dataPtr->changeCount;
+}
+
 //////////////////////////////////////////////////
 void Scene::InitDeferredShading()
 {
@@ -681,6 +814,30 @@ uint32_t Scene::CameraCount() const
   return this->dataPtr->cameras.size();
 }
 
+//////////////////////////////////////////////////
+CameraAtlasPtr Scene::AtlasForCamera(const unsigned int _width,
+    const unsigned int _height, const int _format, const unsigned int _fsaa,
+    const double _near, const double _far)
+{
+  for (auto const &atlas : this->dataPtr->cameraAtlases)
+  {
+    if (atlas->Compatible(_width, _height, _format, _fsaa, _near, _far) &&
+        atlas->UsedTileCount() < atlas->TileCount())
+    {
+      return atlas;
+    }
+  }
+
+  CameraAtlasPtr atlas(new CameraAtlas(this->Name() + "::camera_atlas_" +
+      std::to_string(this->dataPtr->cameraAtlasCount++),
+      _width, _height, _format, _fsaa, _near, _far));
+  if (atlas->TileCount() == 0u)
+    return CameraAtlasPtr();
+
+  this->dataPtr->cameraAtlases.push_back(atlas);
+  return atlas;
+}
+
 //////////////////////////////////////////////////
 CameraPtr Scene::GetCamera(const uint32_t index) const
 {
@@ -1148,6 +1305,33 @@ Ogre::Entity *Scene::OgreEntityAt(CameraPtr _camera,
 
       Ogre::Entity *ogreEntity = static_cast<Ogre::Entity*>(iter->movable);
 
+      // Meshes created from a common::Mesh are tested in their own frame
+      // against the cached bounding volume hierarchy, front faces only.
+      std::shared_ptr<const common::MeshBVH> bvh =
+          common::MeshManager::Instance()->BVH(
+          ogreEntity->getMesh()->getName());
+      if (bvh)
+      {
+        const Ogre::Matrix4 &transform =
+            ogreEntity->getParentNode()->_getFullTransform();
+        const Ogre::Matrix4 inverse = transform.inverseAffine();
+        Ogre::Matrix3 inverseRot;
+        inverse.extract3x3Matrix(inverseRot);
+
+        double distance;
+        ignition::math::Triangle3d triangle;
+        if (bvh->Intersect(Conversions::ConvertIgn(
+            inverse.transformAffine(mouseRay.getOrigin())),
+            Conversions::ConvertIgn(inverseRot * mouseRay.getDirection()),
+            distance, triangle, false) &&
+            (closest_distance < 0.0f || distance < closest_distance))
+        {
+          closest_distance = distance;
+          closestEntity = ogreEntity;
+        }
+        continue;
+      }
+
       // mesh data to retrieve
       size_t vertex_count;
       size_t index_count;
@@ -1298,7 +1482,7 @@ bool Scene::FirstContact(CameraPtr _camera,
   {
     // The terrain uses a special ray intersection test.
     Ogre::TerrainGroup::RayResult terrainResult =
-      this->dataPtr->terrain->OgreTerrain()->rayIntersects(mouseRay);
+      this->dataPtr->terrain->RayIntersects(mouseRay);
 
     if (terrainResult.hit)
     {
@@ -1586,9 +1770,32 @@ void Scene::MeshInformation(const Ogre::Mesh *_mesh,
 /////////////////////////////////////////////////
 bool Scene::ProcessSceneMsg(ConstScenePtr &_msg)
 {
+  // Queue the models nearest to the user camera first, their visuals are
+  // then created and their meshes loaded before the others.
+  ignition::math::Vector3d cameraPos;
+  if (!this->dataPtr->userCameras.empty())
+    cameraPos = this->dataPtr->userCameras[0]->WorldPosition();
+
+  std::vector<int> modelOrder(_msg->model_size());
+  std::iota(modelOrder.begin(), modelOrder.end(), 0);
+  std::vector<double> modelDist(_msg->model_size(), 0.0);
+  for (int i = 0; i < _msg->model_size(); ++i)
+  {
+    if (_msg->model(i).has_pose())
+    {
+      modelDist[i] = cameraPos.Distance(
+          msgs::ConvertIgn(_msg->model(i).pose().position()));
+    }
+  }
+  std::stable_sort(modelOrder.begin(), modelOrder.end(),
+      [&modelDist](const int _a, const int _b)
+      {
+        return modelDist[_a] < modelDist[_b];
+      });
+
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
-    for (int i = 0; i < _msg->model_size(); ++i)
+    for (int i : modelOrder)
     {
       PoseMsgs_M::iterator iter =
           this->dataPtr->poseMsgs.find(_msg->model(i).id());
@@ -1691,6 +1898,7 @@ bool Scene::ProcessModelMsg(const msgs::Model &_msg)
   {
     boost::shared_ptr<msgs::Visual> vm(new msgs::Visual(
           _msg.visual(j)));
+    QueueMesh(this->dataPtr.get(), *vm);
     this->dataPtr->modelVisualMsgs.push_back(vm);
   }
 
@@ -1755,6 +1963,7 @@ bool Scene::ProcessModelMsg(const msgs::Model &_msg)
       // note: the first visual in the link is the link visual
       msgs::VisualPtr vm(new msgs::Visual(
             _msg.link(j).visual(0)));
+      QueueMesh(this->dataPtr.get(), *vm);
       this->dataPtr->linkVisualMsgs.push_back(vm);
     }
 
@@ -1762,6 +1971,7 @@ bool Scene::ProcessModelMsg(const msgs::Model &_msg)
     {
       boost::shared_ptr<msgs::Visual> vm(new msgs::Visual(
             _msg.link(j).visual(k)));
+      QueueMesh(this->dataPtr.get(), *vm);
       this->dataPtr->visualMsgs.push_back(vm);
     }
 
@@ -1772,6 +1982,7 @@ bool Scene::ProcessModelMsg(const msgs::Model &_msg)
       {
         boost::shared_ptr<msgs::Visual> vm(new msgs::Visual(
               _msg.link(j).collision(k).visual(l)));
+        QueueMesh(this->dataPtr.get(), *vm);
         this->dataPtr->collisionVisualMsgs.push_back(vm);
       }
     }
@@ -1809,6 +2020,7 @@ void Scene::OnSensorMsg(ConstSensorPtr &_msg)
 //////////////////////////////////////////////////
 void Scene::OnVisualMsg(ConstVisualPtr &_msg)
 {
+  QueueMesh(this->dataPtr.get(), *_msg);
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
   this->dataPtr->visualMsgs.push_back(_msg);
 }
@@ -1886,10 +2098,14 @@ void Scene::PreRender()
   LinkMsgs_L linkMsgsCopy;
   RoadMsgs_L roadMsgsCopy;
 
+  double loadBudget = 0.0;
+
   IGN_PROFILE_BEGIN("copyMsgs");
   {
     std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
 
+    loadBudget = this->dataPtr->loadBudget;
+
     std::copy(this->dataPtr->sceneMsgs.begin(), this->dataPtr->sceneMsgs.end(),
               std::back_inserter(sceneMsgsCopy));
     this->dataPtr->sceneMsgs.clear();
@@ -1948,6 +2164,19 @@ void Scene::PreRender()
   }
   IGN_PROFILE_END();
 
+  // Any message changes what the next frame shows. Poses are counted by
+  // the visuals they move.
+  if (!sceneMsgsCopy.empty() || !modelMsgsCopy.empty() ||
+      !sensorMsgsCopy.empty() || !lightFactoryMsgsCopy.empty() ||
+      !lightModifyMsgsCopy.empty() || !modelVisualMsgsCopy.empty() ||
+      !linkVisualMsgsCopy.empty() || !visualMsgsCopy.empty() ||
+      !collisionVisualMsgsCopy.empty() || !jointMsgsCopy.empty() ||
+      !linkMsgsCopy.empty() || !roadMsgsCopy.empty() ||
+      !this->dataPtr->requestMsgs.empty())
+  {
+    this->MarkChanged();
+  }
+
   // Process the scene messages. DO THIS FIRST
   IGN_PROFILE_BEGIN("processMsgs");
   for (sIter = sceneMsgsCopy.begin(); sIter != sceneMsgsCopy.end();)
@@ -1981,9 +2210,24 @@ void Scene::PreRender()
       ++sensorIter;
   }
 
+  // Create visuals until the load budget is spent, the remaining messages
+  // are put back in the queues for the next frames.
+  const auto loadStart = std::chrono::steady_clock::now();
+  // At least one message is processed in each frame.
+  auto withinBudget = [loadStart, loadBudget, first = true]() mutable
+  {
+    if (first)
+    {
+      first = false;
+      return true;
+    }
+    return loadBudget <= 0.0 || std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - loadStart).count() < loadBudget;
+  };
+
   // Process the model visual messages.
   for (visualIter = modelVisualMsgsCopy.begin();
-      visualIter != modelVisualMsgsCopy.end();)
+      visualIter != modelVisualMsgsCopy.end() && withinBudget();)
   {
     if (this->ProcessVisualMsg(*visualIter, Visual::VT_MODEL))
       modelVisualMsgsCopy.erase(visualIter++);
@@ -1993,7 +2237,7 @@ void Scene::PreRender()
 
   // Process the link visual messages.
   for (visualIter = linkVisualMsgsCopy.begin();
-      visualIter != linkVisualMsgsCopy.end();)
+      visualIter != linkVisualMsgsCopy.end() && withinBudget();)
   {
     if (this->ProcessVisualMsg(*visualIter, Visual::VT_LINK))
       linkVisualMsgsCopy.erase(visualIter++);
@@ -2002,7 +2246,8 @@ void Scene::PreRender()
   }
 
   // Process the visual messages.
-  for (visualIter = visualMsgsCopy.begin(); visualIter != visualMsgsCopy.end();)
+  for (visualIter = visualMsgsCopy.begin();
+      visualIter != visualMsgsCopy.end() && withinBudget();)
   {
     Visual::VisualType visualType = Visual::VT_VISUAL;
     if ((*visualIter)->has_type())
@@ -2016,7 +2261,7 @@ void Scene::PreRender()
 
   // Process the collision visual messages.
   for (visualIter = collisionVisualMsgsCopy.begin();
-      visualIter != collisionVisualMsgsCopy.end();)
+      visualIter != collisionVisualMsgsCopy.end() && withinBudget();)
   {
     if (this->ProcessVisualMsg(*visualIter, Visual::VT_COLLISION))
       collisionVisualMsgsCopy.erase(visualIter++);
@@ -2118,11 +2363,22 @@ void Scene::PreRender()
   RTShaderSystem::Instance()->Update();
   IGN_PROFILE_END();
 
+  IGN_PROFILE_BEGIN("cullShadowLights");
+  this->CullShadowLights();
+  IGN_PROFILE_END();
+
   {
     IGN_PROFILE_BEGIN("poseMsgMutex");
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
     IGN_PROFILE_END();
 
+    // Apply the newest pose of every visual from the queued pose messages.
+    // Older poses of the same visual are stale and skipped. Poses without
+    // a visual yet go to poseMsgs and are processed below.
+    IGN_PROFILE_BEGIN("pendingPoseMsgs");
+    this->ApplyPendingPoseMsgs();
+    IGN_PROFILE_END();
+
     // Process all the model messages last. Remove pose message from the list
     // only when a corresponding visual exits. We may receive pose updates
     // over the wire before  we recieve the visual
@@ -2157,6 +2413,7 @@ void Scene::PreRender()
           ignition::math::Pose3d pose = msgs::ConvertIgn(pIter->second);
           lIter->second->SetPosition(pose.Pos());
           lIter->second->SetRotation(pose.Rot());
+          this->MarkChanged();
           auto prev = pIter++;
           this->dataPtr->poseMsgs.erase(prev);
         }
@@ -2233,6 +2490,42 @@ void Scene::PreRender()
         this->dataPtr->sceneSimTimePosesReceived;
     IGN_PROFILE_END();
   }
+
+  if (this->dataPtr->hierarchicalCulling &&
+      (this->dataPtr->visuals.size() >= 2 * this->dataPtr->cullingFitCount ||
+       2 * this->dataPtr->visuals.size() < this->dataPtr->cullingFitCount))
+  {
+    IGN_PROFILE("fitCulling");
+    this->FitCulling();
+  }
+
+  IGN_PROFILE_BEGIN("visualBatches");
+  if ((this->dataPtr->visualBatching || this->dataPtr->staticBatching) &&
+      !this->dataPtr->visualBatches && this->dataPtr->manager)
+  {
+    this->dataPtr->visualBatches.reset(
+        new VisualBatches(this->dataPtr->manager));
+    this->dataPtr->visualBatches->SetEnabled(this->dataPtr->visuals,
+        this->dataPtr->visualBatching);
+    this->dataPtr->visualBatches->SetStaticEnabled(this->dataPtr->visuals,
+        this->dataPtr->staticBatching);
+  }
+
+  if (this->dataPtr->visualBatches)
+  {
+    this->dataPtr->visualBatches->SetThreshold(
+        this->dataPtr->visualBatchThreshold);
+    this->dataPtr->visualBatches->SetRegionSize(
+        this->dataPtr->staticBatchRegionSize);
+    this->dataPtr->visualBatches->Update(this->dataPtr->visuals);
+  }
+  IGN_PROFILE_END();
+
+  if (this->dataPtr->shadowCache)
+  {
+    IGN_PROFILE("shadowCache");
+    this->dataPtr->shadowCache->Update(this->dataPtr->visuals);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -2813,6 +3106,7 @@ bool Scene::ProcessVisualMsg(ConstVisualPtr &_msg, Visual::VisualType _type)
     if (iter != this->dataPtr->visuals.end())
     {
       this->dataPtr->visuals.erase(iter);
+      this->dataPtr->visualIndexDirty = true;
       return true;
     }
     else
@@ -2934,6 +3228,8 @@ bool Scene::ProcessVisualMsg(ConstVisualPtr &_msg, Visual::VisualType _type)
     this->dataPtr->terrain->SetLOD(this->dataPtr->heightmapLOD);
     const double skirtLen = this->dataPtr->heightmapSkirtLength;
     this->dataPtr->terrain->SetSkirtLength(skirtLen);
+    this->dataPtr->terrain->SetClipmapEnabled(
+        this->dataPtr->heightmapClipmap);
     this->dataPtr->terrain->LoadFromMsg(_msg);
   }
   visual->SetType(_type);
@@ -2966,15 +3262,340 @@ void Scene::OnPoseMsg(ConstPosesStampedPtr &_msg)
   this->dataPtr->sceneSimTimePosesReceived =
     common::Time(_msg->time().sec(), _msg->time().nsec());
 
-  for (int i = 0; i < _msg->pose_size(); ++i)
+  this->dataPtr->poseMsgWallTimes[0] = this->dataPtr->poseMsgWallTimes[1];
+  this->dataPtr->poseMsgWallTimes[1] = common::Time::GetWallTime();
+
+  // Keep the message as it is. PreRender picks the newest pose of every
+  // visual out of all the messages queued since the last frame.
+  this->dataPtr->pendingPoseMsgs.push_back(_msg);
+}
+
+/////////////////////////////////////////////////
+void Scene::OnPoseDeltaMsg(ConstPosesDeltaPtr &_msg)
+{
+  ConstPosesStampedPtr msg =
+      boost::make_shared<const msgs::PosesStamped>(msgs::Convert(*_msg));
+  this->OnPoseMsg(msg);
+}
+
+/////////////////////////////////////////////////
+void Scene::SetPoseDeltaStream(const bool _enable)
+{
+  if (_enable == this->dataPtr->poseDeltaStream)
+    return;
+
+  this->dataPtr->poseDeltaStream = _enable;
+  this->dataPtr->poseSub.reset();
+
+  if (_enable)
   {
-    auto p = _msg->pose(i);
-    PoseMsgs_M::iterator iter =
-        this->dataPtr->poseMsgs.find(p.id());
-    if (iter != this->dataPtr->poseMsgs.end())
-      iter->second.CopyFrom(p);
-    else
-      this->dataPtr->poseMsgs.insert(std::make_pair(p.id(), p));
+    this->dataPtr->poseSub = this->dataPtr->node->Subscribe("~/pose/delta/info",
+        &Scene::OnPoseDeltaMsg, this);
+  }
+  else if (this->dataPtr->isServer && !rendering::lockstep_enabled())
+  {
+    this->dataPtr->poseSub = this->dataPtr->node->Subscribe("~/pose/local/info",
+        &Scene::OnPoseMsg, this);
+  }
+  else if (!this->dataPtr->isServer)
+  {
+    this->dataPtr->poseSub = this->dataPtr->node->Subscribe("~/pose/info",
+        &Scene::OnPoseMsg, this);
+  }
+}
+
+/////////////////////////////////////////////////
+bool Scene::PoseDeltaStream() const
+{
+  return this->dataPtr->poseDeltaStream;
+}
+
+/////////////////////////////////////////////////
+void Scene::SetVisualBatching(const bool _enable)
+{
+  this->dataPtr->visualBatching = _enable;
+  if (this->dataPtr->visualBatches)
+    this->dataPtr->visualBatches->SetEnabled(this->dataPtr->visuals, _enable);
+}
+
+/////////////////////////////////////////////////
+bool Scene::VisualBatching() const
+{
+  return this->dataPtr->visualBatching;
+}
+
+/////////////////////////////////////////////////
+void Scene::SetVisualBatchThreshold(const unsigned int _threshold)
+{
+  this->dataPtr->visualBatchThreshold = std::max(2u, _threshold);
+}
+
+/////////////////////////////////////////////////
+unsigned int Scene::VisualBatchThreshold() const
+{
+  return this->dataPtr->visualBatchThreshold;
+}
+
+/////////////////////////////////////////////////
+void Scene::SetStaticBatching(const bool _enable)
+{
+  this->dataPtr->staticBatching = _enable;
+  if (this->dataPtr->visualBatches)
+  {
+    this->dataPtr->visualBatches->SetStaticEnabled(this->dataPtr->visuals,
+        _enable);
+  }
+}
+
+/////////////////////////////////////////////////
+bool Scene::StaticBatching() const
+{
+  return this->dataPtr->staticBatching;
+}
+
+/////////////////////////////////////////////////
+void Scene::SetStaticBatchRegionSize(const double _size)
+{
+  if (_size <= 0)
+  {
+    gzerr << "Static batch region size must be positive, got ["
+          << _size << "]\n";
+    return;
+  }
+  this->dataPtr->staticBatchRegionSize = _size;
+}
+
+/////////////////////////////////////////////////
+double Scene::StaticBatchRegionSize() const
+{
+  return this->dataPtr->staticBatchRegionSize;
+}
+
+/////////////////////////////////////////////////
+bool Scene::SetHierarchicalCulling(const bool _enable)
+{
+  if (!this->dataPtr->manager || !this->dataPtr->manager->hasOption("Size") ||
+      !this->dataPtr->manager->hasOption("Depth"))
+  {
+    gzerr << "Hierarchical culling requires the octree scene manager\n";
+    return false;
+  }
+
+  this->dataPtr->hierarchicalCulling = _enable;
+  this->dataPtr->cullingFitCount = 0;
+  if (_enable)
+    return true;
+
+  // Ogre's default octree
+  Ogre::AxisAlignedBox bounds(-10000, -10000, -10000, 10000, 10000, 10000);
+  int depth = 8;
+  this->dataPtr->manager->setOption("Depth", &depth);
+  this->dataPtr->manager->setOption("Size", &bounds);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool Scene::HierarchicalCulling() const
+{
+  return this->dataPtr->hierarchicalCulling;
+}
+
+/////////////////////////////////////////////////
+void Scene::FitCulling()
+{
+  this->dataPtr->cullingFitCount = std::max<size_t>(1u,
+      this->dataPtr->visuals.size());
+
+  if (!this->dataPtr->worldVisual)
+    return;
+
+  Ogre::SceneNode *node = this->dataPtr->worldVisual->GetSceneNode();
+  node->_update(true, false);
+  Ogre::AxisAlignedBox bounds = node->_getWorldAABB();
+  if (!bounds.isFinite())
+    return;
+
+  // Leave room for visuals that move a little out of the scene
+  Ogre::Vector3 size = bounds.getSize();
+  double extent = std::max(1.0, static_cast<double>(std::max(size.x,
+      std::max(size.y, size.z))));
+  Ogre::Vector3 half(extent * 0.6);
+  Ogre::AxisAlignedBox fitted(bounds.getCenter() - half,
+      bounds.getCenter() + half);
+
+  // The smallest cells are about one meter wide
+  int depth = ignition::math::clamp(
+      static_cast<int>(std::ceil(std::log2(extent))), 1, 10);
+
+  this->dataPtr->manager->setOption("Depth", &depth);
+  this->dataPtr->manager->setOption("Size", &fitted);
+}
+
+/////////////////////////////////////////////////
+unsigned int Scene::BatchedVisualCount() const
+{
+  if (!this->dataPtr->visualBatches)
+    return 0;
+  return this->dataPtr->visualBatches->VisualCount();
+}
+
+/////////////////////////////////////////////////
+void Scene::SetPoseInterpolation(const bool _enable)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
+  this->dataPtr->poseInterpolation = _enable;
+  if (!_enable)
+  {
+    for (const auto &interpolant : this->dataPtr->poseInterpolants)
+    {
+      VisualPtr vis = this->GetVisual(interpolant.first);
+      if (vis)
+        vis->SetPose(interpolant.second.end);
+    }
+    this->dataPtr->poseInterpolants.clear();
+  }
+}
+
+/////////////////////////////////////////////////
+bool Scene::PoseInterpolation() const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
+  return this->dataPtr->poseInterpolation;
+}
+
+/////////////////////////////////////////////////
+void Scene::ApplyPendingPoseMsgs()
+{
+  // Rebuild the flat index when visuals were added or removed.
+  if (this->dataPtr->visualIndexDirty ||
+      this->dataPtr->visualIndexSize != this->dataPtr->visuals.size())
+  {
+    this->dataPtr->visualIndex.clear();
+    size_t count = this->dataPtr->visuals.size();
+    uint32_t maxId = count > 0u ? this->dataPtr->visuals.rbegin()->first : 0u;
+
+    // Only keep a flat index while it stays reasonably dense.
+    if (count > 0u && maxId < 4u * count + 65536u)
+    {
+      this->dataPtr->visualIndex.resize(maxId + 1u);
+      for (const auto &vis : this->dataPtr->visuals)
+        this->dataPtr->visualIndex[vis.first] = vis.second;
+    }
+    this->dataPtr->visualIndexFrames.assign(
+        this->dataPtr->visualIndex.size(), 0u);
+    this->dataPtr->visualIndexSize = count;
+    this->dataPtr->visualIndexDirty = false;
+  }
+
+  VisualPtr noVisual;
+  auto findVisual = [&](const uint32_t _id) -> const VisualPtr &
+  {
+    if (!this->dataPtr->visualIndex.empty())
+    {
+      return _id < this->dataPtr->visualIndex.size() ?
+          this->dataPtr->visualIndex[_id] : noVisual;
+    }
+    auto iter = this->dataPtr->visuals.find(_id);
+    return iter != this->dataPtr->visuals.end() ? iter->second : noVisual;
+  };
+
+  // If an object is selected, don't let the physics engine move it.
+  auto movable = [this](const VisualPtr &_vis)
+  {
+    return !this->dataPtr->selectedVis ||
+        this->dataPtr->selectionMode != "move" ||
+        (_vis->GetId() != this->dataPtr->selectedVis->GetId() &&
+        !this->dataPtr->selectedVis->IsAncestorOf(_vis));
+  };
+
+  common::Time now = common::Time::GetWallTime();
+  double interval = std::min(0.25, std::max(0.0,
+      (this->dataPtr->poseMsgWallTimes[1] -
+       this->dataPtr->poseMsgWallTimes[0]).Double()));
+
+  if (!this->dataPtr->pendingPoseMsgs.empty())
+  {
+    uint64_t frame = ++this->dataPtr->poseFrame;
+    std::set<uint32_t> seen;
+    auto firstSeen = [&](const uint32_t _id)
+    {
+      if (_id < this->dataPtr->visualIndexFrames.size())
+      {
+        if (this->dataPtr->visualIndexFrames[_id] == frame)
+          return false;
+        this->dataPtr->visualIndexFrames[_id] = frame;
+        return true;
+      }
+      return seen.insert(_id).second;
+    };
+
+    // Newest message first
+    for (auto msgIter = this->dataPtr->pendingPoseMsgs.rbegin();
+         msgIter != this->dataPtr->pendingPoseMsgs.rend(); ++msgIter)
+    {
+      const msgs::PosesStamped &msg = **msgIter;
+      for (int i = msg.pose_size() - 1; i >= 0; --i)
+      {
+        const msgs::Pose &p = msg.pose(i);
+        uint32_t id = p.id();
+        if (!firstSeen(id))
+          continue;
+
+        const VisualPtr &vis = findVisual(id);
+        if (!vis || !movable(vis))
+        {
+          this->dataPtr->poseMsgs[id].CopyFrom(p);
+          continue;
+        }
+
+        // This pose is newer than anything still waiting in poseMsgs.
+        if (!this->dataPtr->poseMsgs.empty())
+          this->dataPtr->poseMsgs.erase(id);
+
+        ignition::math::Pose3d pose = msgs::ConvertIgn(p);
+        if (this->dataPtr->poseInterpolation && interval > 0.0)
+        {
+          auto &interpolant = this->dataPtr->poseInterpolants[id];
+          interpolant.start = vis->Pose();
+          interpolant.end = pose;
+          interpolant.startTime = now;
+          interpolant.duration = interval;
+        }
+        else
+        {
+          vis->SetPose(pose);
+        }
+      }
+    }
+    this->dataPtr->pendingPoseMsgs.clear();
+  }
+
+  // Move the interpolated visuals along
+  auto iter = this->dataPtr->poseInterpolants.begin();
+  while (iter != this->dataPtr->poseInterpolants.end())
+  {
+    const VisualPtr &vis = findVisual(iter->first);
+    if (!vis || !movable(vis))
+    {
+      iter = this->dataPtr->poseInterpolants.erase(iter);
+      continue;
+    }
+
+    const auto &interpolant = iter->second;
+    double t = (now - interpolant.startTime).Double() / interpolant.duration;
+    if (t >= 1.0)
+    {
+      vis->SetPose(interpolant.end);
+      iter = this->dataPtr->poseInterpolants.erase(iter);
+      continue;
+    }
+
+    vis->SetPose(ignition::math::Pose3d(
+        interpolant.start.Pos() +
+        (interpolant.end.Pos() - interpolant.start.Pos()) * t,
+        ignition::math::Quaterniond::Slerp(t, interpolant.start.Rot(),
+          interpolant.end.Rot(), true)));
+    ++iter;
   }
 }
 
@@ -2989,6 +3610,12 @@ void Scene::UpdatePoses(const msgs::PosesStamped &_msg)
   this->dataPtr->newPoseCondition.notify_all();
 }
 
+/////////////////////////////////////////////////
+void Scene::UpdatePoses(const msgs::PosesDelta &_msg)
+{
+  this->UpdatePoses(msgs::Convert(_msg));
+}
+
 /////////////////////////////////////////////////
 bool Scene::WaitForRenderRequest(double _timeoutsec)
 {
@@ -3027,6 +3654,17 @@ void Scene::OnSkeletonPoseMsg(ConstPoseAnimationPtr &_msg)
   this->dataPtr->skeletonPoseMsgs.push_back(_msg);
 }
 
+/////////////////////////////////////////////////
+void Scene::OnSkeletonPoseBatchMsg(ConstPoseAnimation_VPtr &_msg)
+{
+  for (int i = 0; i < _msg->pose_animation_size(); ++i)
+  {
+    // Share ownership of the batch instead of copying each pose.
+    ConstPoseAnimationPtr poseMsg(_msg, &_msg->pose_animation(i));
+    this->OnSkeletonPoseMsg(poseMsg);
+  }
+}
+
 /////////////////////////////////////////////////
 void Scene::OnRoadMsg(ConstRoadPtr &_msg)
 {
@@ -3109,6 +3747,17 @@ void Scene::OnModelMsg(ConstModelPtr &_msg)
   this->dataPtr->modelMsgs.push_back(_msg);
 }
 
+/////////////////////////////////////////////////
+void Scene::OnModelVMsg(ConstModel_VPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  for (int i = 0; i < _msg->models_size(); ++i)
+  {
+    this->dataPtr->modelMsgs.push_back(
+        boost::make_shared<const msgs::Model>(_msg->models(i)));
+  }
+}
+
 /////////////////////////////////////////////////
 void Scene::OnSkyMsg(ConstSkyPtr &_msg)
 {
@@ -3329,6 +3978,8 @@ void Scene::SetShadowsEnabled(bool _value)
     else
       this->dataPtr->manager->setShadowTechnique(Ogre::SHADOWTYPE_NONE);
   }
+
+  this->InvalidateStaticShadows();
 }
 
 /////////////////////////////////////////////////
@@ -3373,6 +4024,7 @@ bool Scene::SetShadowTextureSize(const unsigned int _size)
     this->dataPtr->manager->setShadowTextureSize(
         this->dataPtr->shadowTextureSize);
   }
+  this->InvalidateStaticShadows();
   return true;
 }
 
@@ -3386,6 +4038,140 @@ unsigned int Scene::ShadowTextureSize() const
     return this->dataPtr->shadowTextureSize;
 }
 
+/////////////////////////////////////////////////
+void Scene::SetStaticShadowsOnly(const Ogre::Camera *_camera,
+    const bool _enable)
+{
+  if (this->dataPtr->shadowCache)
+    this->dataPtr->shadowCache->SetStaticOnly(_camera, _enable);
+}
+
+/////////////////////////////////////////////////
+void Scene::InvalidateStaticShadows()
+{
+  if (this->dataPtr->shadowCache)
+    this->dataPtr->shadowCache->Invalidate();
+}
+
+/////////////////////////////////////////////////
+uint64_t Scene::CachedShadowCount() const
+{
+  if (!this->dataPtr->shadowCache)
+    return 0;
+  return this->dataPtr->shadowCache->HitCount();
+}
+
+/////////////////////////////////////////////////
+void Scene::SetMaxShadowLights(const unsigned int _count)
+{
+  if (this->dataPtr->maxShadowLights == _count)
+    return;
+
+  this->dataPtr->maxShadowLights = _count;
+
+  // Without a limit every light renders its shadow again.
+  if (_count == 0u)
+  {
+    for (auto const &iter : this->dataPtr->lights)
+      iter.second->SetShadowActive(true);
+  }
+
+  RTShaderSystem::Instance()->UpdateShadows();
+  this->InvalidateStaticShadows();
+  this->MarkChanged();
+}
+
+/////////////////////////////////////////////////
+unsigned int Scene::MaxShadowLights() const
+{
+  return this->dataPtr->maxShadowLights;
+}
+
+/////////////////////////////////////////////////
+void Scene::SetLightsPerObject(const unsigned int _count)
+{
+  if (this->dataPtr->lightsPerObject == _count)
+    return;
+
+  this->dataPtr->lightsPerObject = _count;
+  RTShaderSystem::Instance()->SetLightCount(shared_from_this(), _count);
+  this->MarkChanged();
+}
+
+/////////////////////////////////////////////////
+unsigned int Scene::LightsPerObject() const
+{
+  return this->dataPtr->lightsPerObject;
+}
+
+/////////////////////////////////////////////////
+void Scene::CullShadowLights()
+{
+  const unsigned int maxLights = this->dataPtr->maxShadowLights;
+  if (maxLights == 0u)
+    return;
+
+  CameraPtr camera;
+  if (!this->dataPtr->userCameras.empty())
+    camera = this->dataPtr->userCameras[0];
+  else if (!this->dataPtr->cameras.empty())
+    camera = this->dataPtr->cameras[0];
+
+  if (!camera)
+    return;
+
+  struct ShadowLight
+  {
+    Light *light;
+    double priority;
+    double distance;
+  };
+
+  const ignition::math::Vector3d cameraPos = camera->WorldPosition();
+  std::vector<ShadowLight> shadowLights;
+  for (auto const &iter : this->dataPtr->lights)
+  {
+    const LightPtr &light = iter.second;
+    if (!light->CastShadows() || light->LightType() == "directional")
+      continue;
+
+    double distance = cameraPos.Distance(light->WorldPose().Pos());
+
+    // Favor the lights already shadowed, so that lights at about the same
+    // distance don't trade their shadow every frame.
+    if (light->ShadowActive())
+      distance *= 0.9;
+
+    shadowLights.push_back({light.get(), light->ShadowPriority(), distance});
+  }
+
+  if (shadowLights.size() > maxLights)
+  {
+    std::nth_element(shadowLights.begin(), shadowLights.begin() + maxLights,
+        shadowLights.end(),
+        [](const ShadowLight &_a, const ShadowLight &_b)
+        {
+          if (_a.priority != _b.priority)
+            return _a.priority > _b.priority;
+          return _a.distance < _b.distance;
+        });
+  }
+
+  bool changed = false;
+  for (std::size_t i = 0; i < shadowLights.size(); ++i)
+  {
+    const bool active = i < maxLights;
+    if (shadowLights[i].light->ShadowActive() != active)
+    {
+      shadowLights[i].light->SetShadowActive(active);
+      changed = true;
+    }
+  }
+
+  if (changed)
+    this->InvalidateStaticShadows();
+}
+
 /////////////////////////////////////////////////
 std::string Scene::ShadowCasterMaterialName() const
 {
@@ -3408,6 +4194,7 @@ void Scene::AddVisual(VisualPtr _vis)
   }
 
   this->dataPtr->visuals[_vis->GetId()] = _vis;
+  this->MarkChanged();
 }
 
 /////////////////////////////////////////////////
@@ -3442,6 +4229,8 @@ void Scene::RemoveVisual(uint32_t _id)
         ++piter;
     }
     this->dataPtr->visuals.erase(iter);
+    this->dataPtr->visualIndexDirty = true;
+    this->MarkChanged();
 
     this->RemoveVisualizations(vis);
     vis->Fini();
@@ -3469,6 +4258,7 @@ void Scene::SetVisualId(VisualPtr _vis, uint32_t _id)
   {
     this->dataPtr->visuals.erase(_vis->GetId());
     this->dataPtr->visuals[_id] = _vis;
+    this->dataPtr->visualIndexDirty = true;
     _vis->SetId(_id);
   }
 }
@@ -3568,6 +4358,21 @@ double Scene::HeightmapSkirtLength() const
   return this->dataPtr->heightmapSkirtLength;
 }
 
+/////////////////////////////////////////////////
+void Scene::SetHeightmapClipmapEnabled(const bool _enabled)
+{
+  this->dataPtr->heightmapClipmap = _enabled;
+}
+
+/////////////////////////////////////////////////
+bool Scene::HeightmapClipmapEnabled() const
+{
+  if (this->dataPtr->terrain)
+    return this->dataPtr->terrain->ClipmapEnabled();
+
+  return this->dataPtr->heightmapClipmap;
+}
+
 /////////////////////////////////////////////////
 void Scene::CreateCOMVisual(ConstLinkPtr &_msg, VisualPtr _linkVisual)
 {
@@ -231,6 +231,22 @@ namespace gazebo
       /// \return Pointer to the camera. Or NULL if the name is invalid.
       public: CameraPtr GetCamera(const std::string &_name) const;
 
+      /// \brief Get a camera atlas with a free tile for cameras with the
+      /// given properties. A new atlas is created if all compatible
+      /// atlases are full.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _format Ogre pixel format.
+      /// \param[in] _fsaa Anti-aliasing level.
+      /// \param[in] _near Near clip distance.
+      /// \param[in] _far Far clip distance.
+      /// \return Pointer to the atlas, or NULL if the image is too large
+      /// for an atlas.
+      public: CameraAtlasPtr AtlasForCamera(const unsigned int _width,
+                  const unsigned int _height, const int _format,
+                  const unsigned int _fsaa, const double _near,
+                  const double _far);
+
       /// \brief Create a user camera.
       ///
       /// A user camera is one design for use with a GUI.
@@ -414,6 +430,96 @@ namespace gazebo
       /// \return True if shadows are enabled.
       public: bool ShadowsEnabled() const;
 
+      /// \brief Interpolate visual poses between pose messages. A visual
+      /// then moves from its displayed pose to a new pose over the wall time
+      /// between the last two pose messages, which smooths motion when the
+      /// scene renders faster than poses arrive, at the cost of showing
+      /// poses one message late.
+      /// \param[in] _enable True to enable interpolation.
+      /// \sa PoseInterpolation()
+      public: void SetPoseInterpolation(const bool _enable);
+
+      /// \brief Get whether visual poses are interpolated.
+      /// \return True if poses are interpolated.
+      /// \sa SetPoseInterpolation(const bool _enable)
+      public: bool PoseInterpolation() const;
+
+      /// \brief Read visual poses from the compact pose stream published
+      /// by the world on ~/pose/delta/info instead of the full
+      /// msgs::PosesStamped stream. The compact stream only carries the
+      /// entities that moved noticeably, with quantized positions.
+      /// \param[in] _enable True to use the compact stream.
+      /// \sa PoseDeltaStream()
+      public: void SetPoseDeltaStream(const bool _enable);
+
+      /// \brief Get whether visual poses are read from the compact pose
+      /// stream.
+      /// \return True if the compact stream is used.
+      /// \sa SetPoseDeltaStream(const bool _enable)
+      public: bool PoseDeltaStream() const;
+
+      /// \brief Render resting visuals that share a mesh and a material
+      /// with a few merged draw calls, see VisualBatches. Selection,
+      /// visibility and pose of each visual are kept: a visual that
+      /// changes leaves its batch.
+      /// \param[in] _enable True to batch visuals. Disabled by default.
+      /// \sa VisualBatching()
+      public: void SetVisualBatching(const bool _enable);
+
+      /// \brief Get whether resting visuals are batched.
+      /// \return True if visuals are batched.
+      /// \sa SetVisualBatching(const bool _enable)
+      public: bool VisualBatching() const;
+
+      /// \brief Set the smallest number of identical visuals that are
+      /// batched together.
+      /// \param[in] _threshold Number of visuals, at least 2.
+      public: void SetVisualBatchThreshold(const unsigned int _threshold);
+
+      /// \brief Get the smallest number of identical visuals that are
+      /// batched together.
+      /// \return Number of visuals. The default is 16.
+      public: unsigned int VisualBatchThreshold() const;
+
+      /// \brief Merge the static visuals into static geometry regions, see
+      /// Visual::MakeStatic. Editing or deleting a static visual only
+      /// rebuilds its region.
+      /// \param[in] _enable True to batch static visuals. Disabled by
+      /// default.
+      /// \sa StaticBatching()
+      public: void SetStaticBatching(const bool _enable);
+
+      /// \brief Get whether static visuals are merged by region.
+      /// \return True if static visuals are batched.
+      /// \sa SetStaticBatching(const bool _enable)
+      public: bool StaticBatching() const;
+
+      /// \brief Set the edge length of the static geometry regions.
+      /// \param[in] _size Edge length in meters, must be positive.
+      public: void SetStaticBatchRegionSize(const double _size);
+
+      /// \brief Get the edge length of the static geometry regions.
+      /// \return Edge length in meters. The default is 50.
+      public: double StaticBatchRegionSize() const;
+
+      /// \brief Fit the octree that culls the scene to the bounds of the
+      /// visuals, and deepen it with the size of the scene. The octree is
+      /// fitted again when the number of visuals doubles or halves.
+      /// Disabling it restores the default octree of Ogre.
+      /// \param[in] _enable True to fit the octree. Disabled by default.
+      /// \return False if the scene manager is not an octree.
+      /// \sa HierarchicalCulling()
+      public: bool SetHierarchicalCulling(const bool _enable);
+
+      /// \brief Get whether the culling octree is fitted to the scene.
+      /// \return True if fitted.
+      /// \sa SetHierarchicalCulling(const bool _enable)
+      public: bool HierarchicalCulling() const;
+
+      /// \brief Get the number of visuals rendered by a batch.
+      /// \return Number of batched visuals, static visuals included.
+      public: unsigned int BatchedVisualCount() const;
+
       /// \brief Set the shadow texture size
       /// \param[in] _size Size to set the shadow texture to. This must be a
       /// power of 2. The default size is 1024.
@@ -424,6 +530,53 @@ namespace gazebo
       /// \return Size of the shadow texture. The default size is 1024.
       public: unsigned int ShadowTextureSize() const;
 
+      /// \brief Set whether a camera renders the static shadow casters
+      /// only. Their shadow maps are cached and rendered again only when a
+      /// static visual, a light or the camera changes, see ShadowCache.
+      /// Use Camera::SetShadowQuality instead of calling this directly.
+      /// \param[in] _camera The Ogre camera.
+      /// \param[in] _enable True to render static shadows only.
+      public: void SetStaticShadowsOnly(const Ogre::Camera *_camera,
+                  const bool _enable);
+
+      /// \brief Discard the cached static shadow maps, they are rendered
+      /// again on the next frame.
+      public: void InvalidateStaticShadows();
+
+      /// \brief Get the number of shadow texture renders skipped because
+      /// the cached static shadow map was still valid.
+      /// \return Number of skipped renders since the scene was loaded.
+      public: uint64_t CachedShadowCount() const;
+
+      /// \brief Set the maximum number of point and spot lights that render
+      /// their shadow. Every frame, the lights that cast shadows are ranked
+      /// by Light::ShadowPriority, then by distance to the camera, and the
+      /// shadows of the others are culled. Each shadowed spot light renders
+      /// a shadow map, and each point light six.
+      /// \param[in] _count Maximum number of shadowed lights, 0 for no
+      /// limit (default).
+      public: void SetMaxShadowLights(const unsigned int _count);
+
+      /// \brief Get the maximum number of point and spot lights that render
+      /// their shadow.
+      /// \return Maximum number of shadowed lights, 0 for no limit.
+      public: unsigned int MaxShadowLights() const;
+
+      /// \brief Set the number of point and spot lights that light each
+      /// object. Shaders are then generated for a fixed number of lights
+      /// instead of the number of lights in view, so lights entering or
+      /// leaving the view don't regenerate every shader. Each object is lit
+      /// by the lights closest to it.
+      /// \param[in] _count Number of lights of each type per object, 0 to
+      /// generate shaders for the lights in view (default).
+      public: void SetLightsPerObject(const unsigned int _count);
+
+      /// \brief Get the number of point and spot lights that light each
+      /// object.
+      /// \return Number of lights of each type, 0 if shaders are generated
+      /// for the lights in view.
+      public: unsigned int LightsPerObject() const;
+
       /// \brief Get the shadow caster material name
       /// \return Name of the shadow caster material
       public: std::string ShadowCasterMaterialName() const;
@@ -500,6 +653,17 @@ namespace gazebo
       /// \sa Heightmap::SkirtLength
       public: double HeightmapSkirtLength() const;
 
+      /// \brief Set whether heightmaps loaded from now on are rendered
+      /// with a GPU clipmap instead of the Ogre terrain.
+      /// \param[in] _enabled True to use the GPU clipmap.
+      /// \sa Heightmap::SetClipmapEnabled
+      public: void SetHeightmapClipmapEnabled(const bool _enabled);
+
+      /// \brief Get whether heightmaps are rendered with a GPU clipmap.
+      /// \return True if the GPU clipmap is used.
+      /// \sa Heightmap::ClipmapEnabled
+      public: bool HeightmapClipmapEnabled() const;
+
       /// \brief Clear rendering::Scene
       public: void Clear();
 
@@ -570,6 +734,33 @@ namespace gazebo
       /// \return True if the scene has been initialized.
       public: bool Initialized() const;
 
+      /// \brief Set the wall time spent creating visuals in each frame.
+      /// Visuals of the models nearest to the user camera are created
+      /// first, and the remaining ones in the following frames, while their
+      /// meshes load on a background thread.
+      /// \param[in] _budget Time in seconds, 0 to create every queued visual
+      /// in the same frame.
+      public: void SetLoadBudget(const double _budget);
+
+      /// \brief Get the wall time spent creating visuals in each frame.
+      /// \return Time in seconds, 0 if unlimited.
+      public: double LoadBudget() const;
+
+      /// \brief Get the number of visual messages waiting to be processed.
+      /// \return Number of queued visual messages.
+      public: size_t PendingVisualCount() const;
+
+      /// \brief Get a counter of the changes to the scene. It increases
+      /// when the scene processes messages, when a visual moves or changes
+      /// appearance, and when a visualization reports new data. Views that
+      /// render on change compare it with the count of their last frame.
+      /// \return Change counter.
+      public: uint64_t ChangeCount() const;
+
+      /// \brief Report a change made outside of the scene messages, such as
+      /// new data of a sensor visualization. Thread safe.
+      public: void MarkChanged();
+
       /// \brief Get the scene simulation time.
       /// Note this is different from World::GetSimTime() because
       /// there is a lag between the time new poses are sent out by World
@@ -582,6 +773,11 @@ namespace gazebo
       /// \param[in] _msg The message data.
       public: void UpdatePoses(const msgs::PosesStamped& _msg);
 
+      /// \brief Update Poses of objects in the scene from a compact pose
+      /// message via direct API call instead of transport.
+      /// \param[in] _msg The message data.
+      public: void UpdatePoses(const msgs::PosesDelta &_msg);
+
       /// \brief Get the number of visuals.
       /// \return The number of visuals in the Scene.
       public: uint32_t VisualCount() const;
@@ -746,14 +942,40 @@ namespace gazebo
       /// \param[in] _msg The message data.
       private: void OnModelMsg(ConstModelPtr &_msg);
 
+      /// \brief Model batch message callback.
+      /// \param[in] _msg The message data.
+      private: void OnModelVMsg(ConstModel_VPtr &_msg);
+
       /// \brief Pose message callback.
       /// \param[in] _msg The message data.
       private: void OnPoseMsg(ConstPosesStampedPtr &_msg);
 
+      /// \brief Compact pose message callback.
+      /// \param[in] _msg The message data.
+      private: void OnPoseDeltaMsg(ConstPosesDeltaPtr &_msg);
+
+      /// \brief Apply the newest pose of every visual in the pose messages
+      /// queued since the last frame, and advance interpolated poses.
+      /// Must be called with the pose message mutex locked.
+      private: void ApplyPendingPoseMsgs();
+
+      /// \brief Cull the shadows of the lights beyond the maximum number
+      /// of shadowed lights.
+      /// \sa SetMaxShadowLights
+      private: void CullShadowLights();
+
+      /// \brief Fit the culling octree to the bounds of the visuals.
+      /// \sa SetHierarchicalCulling(const bool _enable)
+      private: void FitCulling();
+
       /// \brief Skeleton animation callback.
       /// \param[in] _msg The message data.
       private: void OnSkeletonPoseMsg(ConstPoseAnimationPtr &_msg);
 
+      /// \brief Callback for the skeleton poses of a crowd of actors.
+      /// \param[in] _msg The message data.
+      private: void OnSkeletonPoseBatchMsg(ConstPoseAnimation_VPtr &_msg);
+
       /// \brief Road message callback.
       /// \param[in] _msg The message data.
       private: void OnRoadMsg(ConstRoadPtr &_msg);
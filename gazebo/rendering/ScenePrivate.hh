@@ -17,13 +17,17 @@
 #ifndef GAZEBO_RENDERING_SCENE_PRIVATE_HH_
 #define GAZEBO_RENDERING_SCENE_PRIVATE_HH_
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <boost/unordered/unordered_map.hpp>
@@ -35,6 +39,8 @@
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/rendering/MarkerManager.hh"
 #include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/rendering/ShadowCache.hh"
+#include "gazebo/rendering/VisualBatches.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
 namespace SkyX
@@ -142,6 +148,12 @@ namespace gazebo
       /// \brief All the user cameras.
       public: std::vector<UserCameraPtr> userCameras;
 
+      /// \brief Render textures shared by compatible cameras.
+      public: std::vector<CameraAtlasPtr> cameraAtlases;
+
+      /// \brief Number of camera atlases created, used for unique names.
+      public: unsigned int cameraAtlasCount = 0u;
+
 #ifdef HAVE_OCULUS
       /// \brief All the oculus cameras.
       public: std::vector<OculusCameraPtr> oculusCameras;
@@ -186,6 +198,53 @@ namespace gazebo
       /// \brief List of pose message to process.
       public: PoseMsgs_M poseMsgs;
 
+      /// \brief Pose messages received since the last PreRender, oldest
+      /// first. Only the newest pose of each visual is applied.
+      public: std::vector<ConstPosesStampedPtr> pendingPoseMsgs;
+
+      /// \brief Flat index of visuals by id, used to apply poses. Empty if
+      /// the ids are too sparse for a flat index.
+      public: std::vector<VisualPtr> visualIndex;
+
+      /// \brief Pose frame in which each entry of visualIndex last
+      /// received a pose.
+      public: std::vector<uint64_t> visualIndexFrames;
+
+      /// \brief Number of visuals when visualIndex was built.
+      public: size_t visualIndexSize = 0u;
+
+      /// \brief True if a visual was removed since visualIndex was built.
+      public: bool visualIndexDirty = true;
+
+      /// \brief Incremented every time queued pose messages are applied.
+      public: uint64_t poseFrame = 0u;
+
+      /// \brief True to interpolate visual poses between pose messages.
+      public: bool poseInterpolation = false;
+
+      /// \brief Wall time at which the previous and the latest pose
+      /// messages arrived.
+      public: common::Time poseMsgWallTimes[2];
+
+      /// \brief Pose of a visual moving from one pose message to the next.
+      public: struct PoseInterpolant
+              {
+                /// \brief Pose when the new pose arrived.
+                ignition::math::Pose3d start;
+
+                /// \brief Newest pose.
+                ignition::math::Pose3d end;
+
+                /// \brief Wall time when the new pose arrived.
+                common::Time startTime;
+
+                /// \brief Wall time to move from start to end.
+                double duration;
+              };
+
+      /// \brief Visuals moving between two poses, by id.
+      public: std::map<uint32_t, PoseInterpolant> poseInterpolants;
+
       /// \brief List of pose message to process.
       public: LightPoseMsgs_M lightPoseMsgs;
 
@@ -258,6 +317,34 @@ namespace gazebo
       /// \brief Subscribe to pose updates
       public: transport::SubscriberPtr poseSub;
 
+      /// \brief True if poses are read from the compact pose stream.
+      public: bool poseDeltaStream = false;
+
+      /// \brief True if resting identical visuals are batched.
+      public: bool visualBatching = false;
+
+      /// \brief Smallest number of visuals in a batch.
+      public: unsigned int visualBatchThreshold = 16;
+
+      /// \brief True if the culling octree is fitted to the visuals.
+      public: bool hierarchicalCulling = false;
+
+      /// \brief Number of visuals when the octree was last fitted.
+      public: size_t cullingFitCount = 0;
+
+      /// \brief True if static visuals are merged by region.
+      public: bool staticBatching = false;
+
+      /// \brief Edge length of the static geometry regions.
+      public: double staticBatchRegionSize = 50.0;
+
+      /// \brief Batches of identical visuals and regions of static
+      /// visuals, created once batching is enabled.
+      public: std::unique_ptr<VisualBatches> visualBatches;
+
+      /// \brief Cached shadow maps of the static visuals.
+      public: std::unique_ptr<ShadowCache> shadowCache;
+
       /// \brief Subscribe to joint updates.
       public: transport::SubscriberPtr jointSub;
 
@@ -267,12 +354,18 @@ namespace gazebo
       /// \brief Subscribe to skeleton pose updates.
       public: transport::SubscriberPtr skeletonPoseSub;
 
+      /// \brief Subscribe to skeleton pose updates of actor crowds.
+      public: transport::SubscriberPtr skeletonPoseBatchSub;
+
       /// \brief Subscribe to sky updates.
       public: transport::SubscriberPtr skySub;
 
       /// \brief Subscribe to model info updates
       public: transport::SubscriberPtr modelInfoSub;
 
+      /// \brief Subscribe to model batch info updates
+      public: transport::SubscriberPtr modelInfoVSub;
+
       /// \brief Respond to requests.
       public: transport::PublisherPtr responsePub;
 
@@ -322,6 +415,9 @@ namespace gazebo
       /// \brief The heightmap skirt length
       public: double heightmapSkirtLength = 1.0;
 
+      /// \brief True to render heightmaps with a GPU clipmap.
+      public: bool heightmapClipmap = false;
+
       /// \brief All the projectors.
       public: std::map<std::string, Projector *> projectors;
 
@@ -358,6 +454,30 @@ namespace gazebo
       /// \brief Initialized.
       public: bool initialized;
 
+      /// \brief Wall time spent creating visuals in each PreRender, in
+      /// seconds. The remaining visual messages are processed in the
+      /// following frames, so large scenes start rendering early.
+      public: double loadBudget = 0.05;
+
+      /// \brief Thread that loads the meshes of the queued visuals, so the
+      /// render thread only uploads them.
+      public: std::thread meshThread;
+
+      /// \brief Mutex to protect the mesh queue.
+      public: std::mutex meshMutex;
+
+      /// \brief Signaled when meshes are queued or the thread must stop.
+      public: std::condition_variable meshCondition;
+
+      /// \brief Mesh files to load. Nearest models are queued first.
+      public: std::deque<std::string> meshQueue;
+
+      /// \brief Mesh files already queued.
+      public: std::set<std::string> meshRequested;
+
+      /// \brief True to stop the mesh thread.
+      public: bool meshStop = false;
+
       /// \brief SimTime of this Scene, as we receive PosesStamped from
       /// the world, we update this time accordingly.
       public: common::Time sceneSimTimePosesReceived;
@@ -366,6 +486,9 @@ namespace gazebo
       /// scene, we update this time accordingly.
       public: common::Time sceneSimTimePosesApplied;
 
+      /// \brief Number of changes to the scene, see Scene::ChangeCount.
+      public: std::atomic<uint64_t> changeCount{0};
+
       /// \brief Keeps track of the visual ID for contact visualization.
       public: uint32_t contactVisId;
 
@@ -375,6 +498,14 @@ namespace gazebo
       /// \brief Size of shadow texture
       public: unsigned int shadowTextureSize = 1024u;
 
+      /// \brief Maximum number of shadowed point and spot lights, 0 for no
+      /// limit.
+      public: unsigned int maxShadowLights = 0u;
+
+      /// \brief Number of point and spot lights per object, 0 for the
+      /// lights in view.
+      public: unsigned int lightsPerObject = 0u;
+
       /// \brief Manager of marker visuals
       public: MarkerManager markerManager;
 
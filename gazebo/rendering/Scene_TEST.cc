@@ -16,6 +16,8 @@
 */
 
 #include <gtest/gtest.h>
+#include <string>
+#include <vector>
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -100,6 +102,45 @@ TEST_F(Scene_TEST, AddRemoveVisuals)
   EXPECT_FALSE(scene->GetVisual("visual1"));
 }
 
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, LoadBudget)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  EXPECT_DOUBLE_EQ(scene->LoadBudget(), 0.05);
+  scene->SetLoadBudget(-1.0);
+  EXPECT_DOUBLE_EQ(scene->LoadBudget(), 0.0);
+
+  // With a tiny budget, visuals are created over several frames, and all
+  // of them are eventually created
+  scene->SetLoadBudget(1e-9);
+  const unsigned int boxCount = 10u;
+  for (unsigned int i = 0; i < boxCount; ++i)
+  {
+    SpawnBox("box_" + std::to_string(i), ignition::math::Vector3d::One,
+        ignition::math::Vector3d(i * 2.0, 0, 0.5),
+        ignition::math::Vector3d::Zero);
+  }
+
+  int sleep = 0;
+  int maxSleep = 100;
+  unsigned int found = 0u;
+  while (found < boxCount && sleep++ < maxSleep)
+  {
+    found = 0u;
+    for (unsigned int i = 0; i < boxCount; ++i)
+    {
+      if (scene->GetVisual("box_" + std::to_string(i) + "::body"))
+        ++found;
+    }
+    common::Time::MSleep(100);
+  }
+  EXPECT_EQ(found, boxCount);
+}
+
 /////////////////////////////////////////////////
 TEST_F(Scene_TEST, RemoveModelVisual)
 {
@@ -365,6 +406,99 @@ TEST_F(Scene_TEST, Shadows)
   EXPECT_TRUE(scene->ShadowsEnabled());
 }
 
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, VisualBatching)
+{
+  Load("worlds/shapes.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  // Batching is disabled by default
+  EXPECT_FALSE(scene->VisualBatching());
+  EXPECT_EQ(16u, scene->VisualBatchThreshold());
+  EXPECT_EQ(0u, scene->BatchedVisualCount());
+
+  scene->SetVisualBatchThreshold(0u);
+  EXPECT_EQ(2u, scene->VisualBatchThreshold());
+  scene->SetVisualBatchThreshold(4u);
+  EXPECT_EQ(4u, scene->VisualBatchThreshold());
+
+  scene->SetVisualBatching(true);
+  EXPECT_TRUE(scene->VisualBatching());
+
+  // The world has fewer identical shapes than the threshold
+  for (unsigned int i = 0; i < 100; ++i)
+    scene->PreRender();
+  EXPECT_EQ(0u, scene->BatchedVisualCount());
+
+  scene->SetVisualBatching(false);
+  EXPECT_FALSE(scene->VisualBatching());
+  EXPECT_EQ(0u, scene->BatchedVisualCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, StaticBatching)
+{
+  Load("worlds/shapes.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  // Wait for the ground plane, the only static model of the world
+  gazebo::rendering::VisualPtr ground;
+  int sleep = 0;
+  while (!ground && sleep++ < 100)
+  {
+    event::Events::preRender();
+    ground = scene->GetVisual("ground_plane::link::visual");
+    common::Time::MSleep(30);
+  }
+  ASSERT_TRUE(ground != nullptr);
+  EXPECT_TRUE(ground->IsStatic());
+
+  gazebo::rendering::VisualPtr box = scene->GetVisual("box::link::visual");
+  ASSERT_TRUE(box != nullptr);
+  EXPECT_FALSE(box->IsStatic());
+
+  EXPECT_FALSE(scene->StaticBatching());
+  EXPECT_DOUBLE_EQ(50.0, scene->StaticBatchRegionSize());
+  scene->SetStaticBatchRegionSize(-1.0);
+  EXPECT_DOUBLE_EQ(50.0, scene->StaticBatchRegionSize());
+  scene->SetStaticBatchRegionSize(20.0);
+  EXPECT_DOUBLE_EQ(20.0, scene->StaticBatchRegionSize());
+
+  // Static visuals are batched without waiting for them to rest
+  scene->SetStaticBatching(true);
+  EXPECT_TRUE(scene->StaticBatching());
+  scene->PreRender();
+  EXPECT_EQ(1u, scene->BatchedVisualCount());
+
+  scene->SetStaticBatching(false);
+  EXPECT_EQ(0u, scene->BatchedVisualCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, HierarchicalCulling)
+{
+  Load("worlds/shapes.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+  EXPECT_FALSE(scene->HierarchicalCulling());
+
+  if (!scene->SetHierarchicalCulling(true))
+  {
+    gzwarn << "No octree scene manager, skipping test\n";
+    return;
+  }
+  EXPECT_TRUE(scene->HierarchicalCulling());
+  scene->PreRender();
+
+  EXPECT_TRUE(scene->SetHierarchicalCulling(false));
+  EXPECT_FALSE(scene->HierarchicalCulling());
+}
+
 /////////////////////////////////////////////////
 TEST_F(Scene_TEST, AddRemoveLights)
 {
@@ -403,6 +537,145 @@ TEST_F(Scene_TEST, AddRemoveLights)
   EXPECT_FALSE(scene->LightByName("light1"));
 }
 
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, MaxShadowLights)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+  EXPECT_EQ(scene->MaxShadowLights(), 0u);
+
+  rendering::CameraPtr camera = scene->CreateCamera("test_camera", false);
+  camera->Load();
+  camera->Init();
+  camera->SetWorldPosition(ignition::math::Vector3d::Zero);
+
+  // Shadowed spot lights further and further from the camera
+  std::vector<rendering::LightPtr> lights;
+  for (int i = 0; i < 4; ++i)
+  {
+    rendering::LightPtr light(new rendering::Light(scene));
+    msgs::Light msg;
+    msg.set_name("spot" + std::to_string(i));
+    msg.set_type(msgs::Light::SPOT);
+    msg.set_cast_shadows(true);
+    msgs::Set(msg.mutable_pose(),
+        ignition::math::Pose3d(i + 1.0, 0, 0, 0, 0, 0));
+    light->LoadFromMsg(msg);
+    scene->AddLight(light);
+    lights.push_back(light);
+  }
+
+  // Every light renders its shadow without a limit
+  event::Events::preRender();
+  for (auto const &light : lights)
+    EXPECT_TRUE(light->ShadowActive());
+
+  // The closest lights keep their shadow
+  scene->SetMaxShadowLights(2u);
+  EXPECT_EQ(scene->MaxShadowLights(), 2u);
+  event::Events::preRender();
+  EXPECT_TRUE(lights[0]->ShadowActive());
+  EXPECT_TRUE(lights[1]->ShadowActive());
+  EXPECT_FALSE(lights[2]->ShadowActive());
+  EXPECT_FALSE(lights[3]->ShadowActive());
+  for (auto const &light : lights)
+    EXPECT_TRUE(light->CastShadows());
+
+  // A higher priority wins over distance
+  lights[3]->SetShadowPriority(1.0);
+  event::Events::preRender();
+  EXPECT_TRUE(lights[0]->ShadowActive());
+  EXPECT_FALSE(lights[1]->ShadowActive());
+  EXPECT_TRUE(lights[3]->ShadowActive());
+
+  // Removing the limit restores every shadow
+  scene->SetMaxShadowLights(0u);
+  for (auto const &light : lights)
+    EXPECT_TRUE(light->ShadowActive());
+
+  for (auto const &light : lights)
+    scene->RemoveLight(light);
+  scene->RemoveCamera(camera->Name());
+}
+
+/////////////////////////////////////////////////
+/// \brief Wait for the render loop to move a visual to a pose.
+/// \param[in] _vis The visual.
+/// \param[in] _pose Expected pose.
+/// \return True if the visual reached the pose.
+static bool WaitForPose(rendering::VisualPtr _vis,
+    const ignition::math::Pose3d &_pose)
+{
+  for (int i = 0; i < 200; ++i)
+  {
+    if (_vis->Pose() == _pose)
+      return true;
+    common::Time::MSleep(10);
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, PoseMsgs)
+{
+  Load("worlds/empty.world", true);
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::VisualPtr visual;
+  visual.reset(new rendering::Visual("pose_visual", scene));
+  visual->Load();
+  scene->AddVisual(visual);
+
+  // Only the newest of several queued poses is applied.
+  ignition::math::Pose3d pose1(1, 2, 3, 0, 0, 0);
+  ignition::math::Pose3d pose2(4, 5, 6, 0, 0, 0.5);
+  for (const auto &pose : {pose1, pose2})
+  {
+    msgs::PosesStamped msg;
+    msgs::Set(msg.mutable_time(), common::Time(1, 0));
+    msgs::Pose *poseMsg = msg.add_pose();
+    msgs::Set(poseMsg, pose);
+    poseMsg->set_id(visual->GetId());
+    poseMsg->set_name(visual->Name());
+    scene->UpdatePoses(msg);
+  }
+  EXPECT_TRUE(WaitForPose(visual, pose2));
+
+  // A pose that arrives before its visual is applied once the visual exists.
+  ignition::math::Pose3d pose3(-1, -2, 0.5, 0, 0, 0);
+  msgs::PosesStamped msg;
+  msgs::Set(msg.mutable_time(), common::Time(2, 0));
+  msgs::Pose *poseMsg = msg.add_pose();
+  msgs::Set(poseMsg, pose3);
+  poseMsg->set_id(123456u);
+  poseMsg->set_name("late_visual");
+  scene->UpdatePoses(msg);
+
+  rendering::VisualPtr lateVisual;
+  lateVisual.reset(new rendering::Visual("late_visual", scene));
+  lateVisual->Load();
+  lateVisual->SetId(123456u);
+  scene->AddVisual(lateVisual);
+  EXPECT_TRUE(WaitForPose(lateVisual, pose3));
+
+  // Interpolated poses end at the newest pose.
+  EXPECT_FALSE(scene->PoseInterpolation());
+  scene->SetPoseInterpolation(true);
+  EXPECT_TRUE(scene->PoseInterpolation());
+  ignition::math::Pose3d pose4(0, 0, 1, 0, 0, 0);
+  msgs::Set(msg.mutable_time(), common::Time(3, 0));
+  msgs::Set(poseMsg, pose4);
+  poseMsg->set_id(visual->GetId());
+  poseMsg->set_name(visual->Name());
+  scene->UpdatePoses(msg);
+  EXPECT_TRUE(WaitForPose(visual, pose4));
+  scene->SetPoseInterpolation(false);
+  EXPECT_FALSE(scene->PoseInterpolation());
+}
 
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
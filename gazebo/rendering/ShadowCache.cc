@@ -0,0 +1,304 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <set>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/Visual.hh"
+#include "gazebo/rendering/ShadowCache.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \brief What a shadow texture holds.
+    class ShadowMapEntry
+    {
+      /// \brief True if the texture holds the static casters, as seen by
+      /// the shadow camera below.
+      public: bool valid = false;
+
+      /// \brief View matrix of the shadow camera.
+      public: Ogre::Matrix4 view;
+
+      /// \brief Projection matrix of the shadow camera.
+      public: Ogre::Matrix4 projection;
+
+      /// \brief Cache version when the texture was rendered.
+      public: uint64_t version = 0;
+    };
+
+    /// \brief State of a static visual that shows in its shadows.
+    class StaticVisualState
+    {
+      /// \brief Equality operator.
+      /// \param[in] _other State to compare with.
+      /// \return True if both states cast the same shadows.
+      public: bool operator==(const StaticVisualState &_other) const
+      {
+        return this->position == _other.position &&
+            this->orientation == _other.orientation &&
+            this->scale == _other.scale &&
+            this->visible == _other.visible &&
+            this->castShadows == _other.castShadows;
+      }
+
+      /// \brief Derived position of the scene node.
+      public: Ogre::Vector3 position;
+
+      /// \brief Derived orientation of the scene node.
+      public: Ogre::Quaternion orientation;
+
+      /// \brief Derived scale of the scene node.
+      public: Ogre::Vector3 scale;
+
+      /// \brief True if the visual is visible.
+      public: bool visible = true;
+
+      /// \brief True if the visual casts shadows.
+      public: bool castShadows = true;
+    };
+
+    /// \internal
+    /// \brief Private data of ShadowCache.
+    class ShadowCachePrivate : public Ogre::SceneManager::Listener
+    {
+      // Documentation inherited
+      public: virtual void shadowTextureCasterPreViewProj(Ogre::Light *_light,
+                  Ogre::Camera *_camera, size_t _iteration);
+
+      /// \brief Scene manager that renders the shadows.
+      public: Ogre::SceneManager *manager = nullptr;
+
+      /// \brief Cameras that render static shadows only.
+      public: std::set<const Ogre::Camera *> staticCameras;
+
+      /// \brief What each shadow texture holds, by shadow viewport.
+      public: std::map<Ogre::Viewport *, ShadowMapEntry> entries;
+
+      /// \brief Static visuals at the last update, by visual id.
+      public: std::map<uint32_t, StaticVisualState> statics;
+
+      /// \brief True if the static visuals must be searched again.
+      public: bool rescan = true;
+
+      /// \brief Number of visuals at the last update.
+      public: size_t visualCount = 0;
+
+      /// \brief Number of times the cache was discarded.
+      public: uint64_t version = 0;
+
+      /// \brief Number of shadow texture renders skipped.
+      public: uint64_t hits = 0;
+
+      /// \brief Number of shadow texture renders of the static casters.
+      public: uint64_t misses = 0;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a visual or one of its parents is static.
+/// \param[in] _visual The visual.
+/// \return True if the visual is static.
+static bool IsStaticVisual(VisualPtr _visual)
+{
+  for (; _visual; _visual = _visual->GetParent())
+  {
+    if (_visual->IsStatic())
+      return true;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the state of a visual that shows in its shadows.
+/// \param[in] _visual The visual.
+/// \return The state.
+static StaticVisualState VisualState(const VisualPtr &_visual)
+{
+  StaticVisualState state;
+  Ogre::SceneNode *node = _visual->GetSceneNode();
+  if (node)
+  {
+    state.position = node->_getDerivedPosition();
+    state.orientation = node->_getDerivedOrientation();
+    state.scale = node->_getDerivedScale();
+  }
+  state.visible = _visual->GetVisible();
+  state.castShadows = _visual->GetCastShadows();
+  return state;
+}
+
+/////////////////////////////////////////////////
+void ShadowCachePrivate::shadowTextureCasterPreViewProj(
+    Ogre::Light * /*_light*/, Ogre::Camera *_camera, size_t /*_iteration*/)
+{
+  Ogre::Viewport *viewport = _camera->getViewport();
+  if (!viewport)
+    return;
+
+  ShadowMapEntry &entry = this->entries[viewport];
+
+  // The scene manager makes the viewer the LOD camera of the shadow camera
+  const Ogre::Camera *viewer = _camera->getLodCamera();
+  if (!viewer || this->staticCameras.count(viewer) == 0)
+  {
+    viewport->setVisibilityMask(0xFFFFFFFF);
+    viewport->setClearEveryFrame(true);
+    entry.valid = false;
+    return;
+  }
+
+  const Ogre::Matrix4 &view = _camera->getViewMatrix();
+  const Ogre::Matrix4 &projection = _camera->getProjectionMatrix();
+  if (entry.valid && entry.version == this->version &&
+      entry.view == view && entry.projection == projection)
+  {
+    // Render nothing and keep the previous contents of the texture
+    viewport->setVisibilityMask(0);
+    viewport->setClearEveryFrame(false);
+    ++this->hits;
+    return;
+  }
+
+  viewport->setVisibilityMask(GZ_VISIBILITY_STATIC);
+  viewport->setClearEveryFrame(true);
+  entry.valid = true;
+  entry.view = view;
+  entry.projection = projection;
+  entry.version = this->version;
+  ++this->misses;
+}
+
+/////////////////////////////////////////////////
+ShadowCache::ShadowCache(Ogre::SceneManager *_manager)
+  : dataPtr(new ShadowCachePrivate)
+{
+  this->dataPtr->manager = _manager;
+  if (this->dataPtr->manager)
+    this->dataPtr->manager->addListener(this->dataPtr.get());
+}
+
+/////////////////////////////////////////////////
+ShadowCache::~ShadowCache()
+{
+  if (this->dataPtr->manager)
+    this->dataPtr->manager->removeListener(this->dataPtr.get());
+}
+
+/////////////////////////////////////////////////
+void ShadowCache::SetStaticOnly(const Ogre::Camera *_camera,
+    const bool _staticOnly)
+{
+  if (!_camera)
+    return;
+
+  if (_staticOnly)
+    this->dataPtr->staticCameras.insert(_camera);
+  else
+    this->dataPtr->staticCameras.erase(_camera);
+}
+
+/////////////////////////////////////////////////
+bool ShadowCache::StaticOnly(const Ogre::Camera *_camera) const
+{
+  return this->dataPtr->staticCameras.count(_camera) > 0;
+}
+
+/////////////////////////////////////////////////
+void ShadowCache::Invalidate()
+{
+  // The shadow textures may have been recreated
+  this->dataPtr->entries.clear();
+  ++this->dataPtr->version;
+  this->dataPtr->rescan = true;
+}
+
+/////////////////////////////////////////////////
+void ShadowCache::Update(const std::map<uint32_t, VisualPtr> &_visuals)
+{
+  if (this->dataPtr->staticCameras.empty())
+  {
+    // Nothing is cached, search the static visuals once needed
+    this->dataPtr->statics.clear();
+    this->dataPtr->rescan = true;
+    return;
+  }
+
+  bool changed = false;
+  if (this->dataPtr->rescan || _visuals.size() != this->dataPtr->visualCount)
+  {
+    std::map<uint32_t, StaticVisualState> statics;
+    for (auto const &vis : _visuals)
+    {
+      if (IsStaticVisual(vis.second))
+        statics[vis.first] = VisualState(vis.second);
+    }
+
+    changed = statics != this->dataPtr->statics;
+    this->dataPtr->statics.swap(statics);
+    this->dataPtr->visualCount = _visuals.size();
+    this->dataPtr->rescan = false;
+  }
+  else
+  {
+    for (auto &state : this->dataPtr->statics)
+    {
+      auto iter = _visuals.find(state.first);
+      if (iter == _visuals.end())
+      {
+        // Replaced by another visual, search again on the next update
+        this->dataPtr->rescan = true;
+        changed = true;
+        continue;
+      }
+
+      StaticVisualState current = VisualState(iter->second);
+      if (!(current == state.second))
+      {
+        state.second = current;
+        changed = true;
+      }
+    }
+  }
+
+  if (changed)
+    ++this->dataPtr->version;
+}
+
+/////////////////////////////////////////////////
+uint64_t ShadowCache::Version() const
+{
+  return this->dataPtr->version;
+}
+
+/////////////////////////////////////////////////
+uint64_t ShadowCache::HitCount() const
+{
+  return this->dataPtr->hits;
+}
+
+/////////////////////////////////////////////////
+uint64_t ShadowCache::MissCount() const
+{
+  return this->dataPtr->misses;
+}
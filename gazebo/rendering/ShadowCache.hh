@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_SHADOWCACHE_HH_
+#define GAZEBO_RENDERING_SHADOWCACHE_HH_
+
+#include <map>
+#include <memory>
+
+#include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace Ogre
+{
+  class Camera;
+  class SceneManager;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    class ShadowCachePrivate;
+
+    /// \addtogroup gazebo_rendering
+    /// \{
+
+    /// \class ShadowCache ShadowCache.hh rendering/rendering.hh
+    /// \brief Keeps the shadow maps of static casters between frames.
+    ///
+    /// The shadow textures of a scene are shared by all its cameras, and
+    /// each camera re-renders every split of every light before its own
+    /// render. Cameras that only need static shadows, see
+    /// Camera::SetShadowQuality, render the objects flagged with
+    /// GZ_VISIBILITY_STATIC into the shadow textures. Such a shadow texture
+    /// is left untouched on the next frame if its shadow camera has the
+    /// same view and projection, and if no static visual changed in
+    /// between. The shadow textures are still rendered every frame for the
+    /// other cameras.
+    class GZ_RENDERING_VISIBLE ShadowCache
+    {
+      /// \brief Constructor.
+      /// \param[in] _manager Scene manager that renders the shadows.
+      public: explicit ShadowCache(Ogre::SceneManager *_manager);
+
+      /// \brief Destructor.
+      public: ~ShadowCache();
+
+      /// \brief Set whether a camera renders static shadows only.
+      /// \param[in] _camera The camera.
+      /// \param[in] _staticOnly True to render and cache the static
+      /// casters only, false to render all the casters every frame.
+      public: void SetStaticOnly(const Ogre::Camera *_camera,
+                  const bool _staticOnly);
+
+      /// \brief Get whether a camera renders static shadows only.
+      /// \param[in] _camera The camera.
+      /// \return True if the camera renders static shadows only.
+      public: bool StaticOnly(const Ogre::Camera *_camera) const;
+
+      /// \brief Discard the cached shadow maps, they are rendered again on
+      /// the next frame.
+      public: void Invalidate();
+
+      /// \brief Discard the cached shadow maps if a static visual was
+      /// added, removed, moved, scaled or hidden since the last update.
+      /// Nothing is checked while no camera renders static shadows only.
+      /// \param[in] _visuals All the visuals of the scene.
+      public: void Update(const std::map<uint32_t, VisualPtr> &_visuals);
+
+      /// \brief Get the number of times the cached shadow maps were
+      /// discarded.
+      /// \return Number of times, starts at 0.
+      public: uint64_t Version() const;
+
+      /// \brief Get the number of shadow texture renders skipped because
+      /// the cached shadow map was still valid.
+      /// \return Number of skipped renders.
+      public: uint64_t HitCount() const;
+
+      /// \brief Get the number of shadow texture renders of the static
+      /// casters.
+      /// \return Number of renders.
+      public: uint64_t MissCount() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ShadowCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -14,9 +14,9 @@
  * limitations under the License.
  *
 */
-#include <ignition/common/Profiler.hh>
 
 #include "gazebo/common/MeshManager.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/transport/transport.hh"
 
 #include "gazebo/rendering/Conversions.hh"
@@ -96,6 +96,10 @@ void SonarVisual::Update()
   if (!dPtr->sonarMsg || !dPtr->receivedMsg)
     return;
 
+  // New data changes the frame of views that render on change.
+  if (dPtr->scene)
+    dPtr->scene->MarkChanged();
+
   // Skip the update if the user is moving the sonar.
   if (this->GetScene()->SelectedVisual() &&
       this->GetRootVisual()->Name() ==
@@ -0,0 +1,353 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/TraceCapture.hh"
+#include "gazebo/rendering/TextureLoaderPrivate.hh"
+#include "gazebo/rendering/TextureLoader.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+//////////////////////////////////////////////////
+/// \brief Check whether the GPU can sample a compressed DDS texture.
+/// \param[in] _file Path of the DDS file.
+/// \param[in] _caps Capabilities of the render system.
+/// \return True if the compression format of the file is supported.
+static bool SupportedDds(const std::string &_file,
+    const Ogre::RenderSystemCapabilities *_caps)
+{
+  std::ifstream file(_file, std::ios::binary);
+  unsigned char header[148];
+  file.read(reinterpret_cast<char *>(header), sizeof(header));
+  if (file.gcount() < 128 || std::string(header, header + 4) != "DDS ")
+    return false;
+
+  // Pixel format four character code, then the DXGI format of DX10 headers
+  const std::string fourCC(header + 84, header + 88);
+  if (fourCC == "DXT1" || fourCC == "DXT3" || fourCC == "DXT5")
+    return _caps->hasCapability(Ogre::RSC_TEXTURE_COMPRESSION_DXT);
+  if (fourCC == "ATI1" || fourCC == "ATI2" || fourCC == "BC4U" ||
+      fourCC == "BC5U")
+  {
+    return _caps->hasCapability(Ogre::RSC_TEXTURE_COMPRESSION_BC4_BC5);
+  }
+  if (fourCC != "DX10" || file.gcount() < 148)
+    return false;
+
+  const unsigned int dxgiFormat = header[128] | (header[129] << 8) |
+      (header[130] << 16) | (header[131] << 24);
+  // BC1 to BC3
+  if (dxgiFormat >= 70 && dxgiFormat <= 78)
+    return _caps->hasCapability(Ogre::RSC_TEXTURE_COMPRESSION_DXT);
+  // BC4 and BC5
+  if (dxgiFormat >= 79 && dxgiFormat <= 84)
+    return _caps->hasCapability(Ogre::RSC_TEXTURE_COMPRESSION_BC4_BC5);
+  // BC6H and BC7
+  if (dxgiFormat >= 94 && dxgiFormat <= 99)
+    return _caps->hasCapability(Ogre::RSC_TEXTURE_COMPRESSION_BC6H_BC7);
+  return false;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the compressed copy of a texture, written next to it by
+/// gztexture, if the GPU can sample its format.
+/// \param[in] _file Path of the texture image.
+/// \return Path of the compressed copy, empty if there is none usable.
+static std::string CompressedVariant(const std::string &_file)
+{
+  const size_t dot = _file.rfind('.');
+  if (dot == std::string::npos || !Ogre::Root::getSingletonPtr())
+    return std::string();
+
+  const Ogre::RenderSystem *renderSystem =
+      Ogre::Root::getSingleton().getRenderSystem();
+  if (!renderSystem || !renderSystem->getCapabilities())
+    return std::string();
+  const Ogre::RenderSystemCapabilities *caps =
+      renderSystem->getCapabilities();
+
+  const std::string base = _file.substr(0, dot);
+  const std::string dds = base + ".dds";
+  if (dds != _file && common::isFile(dds) && SupportedDds(dds, caps))
+    return dds;
+
+#if OGRE_VERSION >= ((1 << 16) | (10 << 8) | 0)
+  const std::string astc = base + ".astc";
+  if (astc != _file && common::isFile(astc) &&
+      caps->hasCapability(Ogre::RSC_TEXTURE_COMPRESSION_ASTC))
+  {
+    return astc;
+  }
+#endif
+
+  return std::string();
+}
+
+//////////////////////////////////////////////////
+TextureLoader::TextureLoader()
+  : dataPtr(new TextureLoaderPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+TextureLoader::~TextureLoader()
+{
+  this->Fini();
+}
+
+//////////////////////////////////////////////////
+void TextureLoader::Fini()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+    this->dataPtr->toDecode.clear();
+    this->dataPtr->toUpload.clear();
+    this->dataPtr->pending.clear();
+  }
+  this->dataPtr->condition.notify_all();
+
+  for (auto &worker : this->dataPtr->workers)
+  {
+    if (worker.joinable())
+      worker.join();
+  }
+  this->dataPtr->workers.clear();
+}
+
+//////////////////////////////////////////////////
+bool TextureLoader::Queue(const std::string &_name)
+{
+  if (_name.empty())
+    return false;
+
+  Ogre::TextureManager *textureManager = Ogre::TextureManager::getSingletonPtr();
+  if (!textureManager)
+    return false;
+
+  // Already loaded, or queued
+  if (textureManager->resourceExists(_name))
+    return true;
+
+  if (!this->Enabled())
+    return false;
+
+  // Only files the workers can read and Ogre can decode, the others are left
+  // to the resource system.
+  std::string path = common::find_file(_name);
+  if (path.empty())
+    return false;
+
+  if (this->CompressedVariants())
+  {
+    const std::string compressed = CompressedVariant(path);
+    if (!compressed.empty())
+      path = compressed;
+  }
+
+  std::string extension = path.substr(path.rfind('.') + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+      ::tolower);
+  if (!Ogre::Codec::isCodecRegistered(extension))
+    return false;
+
+  // The placeholder is replaced once the image is decoded
+  unsigned char white[4] = {255, 255, 255, 255};
+  Ogre::Image placeholder;
+  placeholder.loadDynamicImage(white, 1, 1, 1, Ogre::PF_R8G8B8A8);
+  textureManager->loadImage(_name,
+      Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, placeholder);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->workers.empty())
+  {
+    this->dataPtr->stop = false;
+    const unsigned int count = std::max(1u,
+        std::min(2u, std::thread::hardware_concurrency() / 2));
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      this->dataPtr->workers.push_back(
+          std::thread(&TextureLoaderPrivate::RunWorker, this->dataPtr.get()));
+    }
+  }
+
+  this->dataPtr->pending.insert(_name);
+  this->dataPtr->toDecode.push_back(std::make_pair(_name, path));
+  this->dataPtr->condition.notify_one();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void TextureLoaderPrivate::RunWorker()
+{
+  while (true)
+  {
+    std::pair<std::string, std::string> texture;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->condition.wait(lock, [this]
+          {
+            return this->stop || !this->toDecode.empty();
+          });
+      if (this->stop)
+        return;
+
+      texture = this->toDecode.front();
+      this->toDecode.pop_front();
+    }
+
+    // A null image makes the render thread fall back to Ogre's loader
+    std::shared_ptr<Ogre::Image> image;
+
+    std::ifstream file(texture.second, std::ios::binary);
+    std::vector<char> buffer((std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    if (!buffer.empty())
+    {
+      std::string extension =
+          texture.second.substr(texture.second.rfind('.') + 1);
+      std::transform(extension.begin(), extension.end(), extension.begin(),
+          ::tolower);
+      try
+      {
+        Ogre::DataStreamPtr stream(OGRE_NEW Ogre::MemoryDataStream(
+            buffer.data(), buffer.size(), false, true));
+        image = std::make_shared<Ogre::Image>();
+        image->load(stream, extension);
+      }
+      catch(Ogre::Exception &_e)
+      {
+        gzwarn << "Unable to decode texture [" << texture.second << "]: "
+               << _e.getDescription() << std::endl;
+        image.reset();
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->pending.count(texture.first) > 0)
+      this->toUpload.push_back(std::make_pair(texture.first, image));
+  }
+}
+
+//////////////////////////////////////////////////
+void TextureLoader::Update()
+{
+  IGN_PROFILE("rendering::TextureLoader::Update");
+
+  const auto start = std::chrono::steady_clock::now();
+  double budget;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->toUpload.empty())
+      return;
+    budget = this->dataPtr->uploadBudget;
+  }
+
+  // At least one image is uploaded in each frame
+  bool first = true;
+  while (first || budget <= 0.0 || std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count() < budget)
+  {
+    first = false;
+
+    std::pair<std::string, std::shared_ptr<Ogre::Image>> texture;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      if (this->dataPtr->toUpload.empty())
+        return;
+      texture = this->dataPtr->toUpload.front();
+      this->dataPtr->toUpload.pop_front();
+      this->dataPtr->pending.erase(texture.first);
+    }
+
+    Ogre::TexturePtr tex =
+        Ogre::TextureManager::getSingleton().getByName(texture.first);
+    if (tex.isNull())
+      continue;
+
+    // Materials refer to the texture object, replacing its content updates
+    // all of them.
+    try
+    {
+      tex->unload();
+      if (texture.second)
+        tex->loadImage(*texture.second);
+      else
+        tex->load();
+    }
+    catch(Ogre::Exception &_e)
+    {
+      gzwarn << "Unable to load texture [" << texture.first << "]: "
+             << _e.getDescription() << std::endl;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void TextureLoader::SetUploadBudget(const double _budget)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->uploadBudget = std::max(_budget, 0.0);
+}
+
+//////////////////////////////////////////////////
+double TextureLoader::UploadBudget() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->uploadBudget;
+}
+
+//////////////////////////////////////////////////
+void TextureLoader::SetEnabled(const bool _enabled)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->enabled = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool TextureLoader::Enabled() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->enabled;
+}
+
+//////////////////////////////////////////////////
+void TextureLoader::SetCompressedVariants(const bool _enabled)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->compressedVariants = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool TextureLoader::CompressedVariants() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->compressedVariants;
+}
+
+//////////////////////////////////////////////////
+unsigned int TextureLoader::PendingCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return static_cast<unsigned int>(this->dataPtr->pending.size());
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_TEXTURELOADER_HH_
+#define GAZEBO_RENDERING_TEXTURELOADER_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_RENDERING_VISIBLE, gazebo, rendering, TextureLoader)
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    class TextureLoaderPrivate;
+
+    /// \addtogroup gazebo_rendering
+    /// \{
+
+    /// \class TextureLoader TextureLoader.hh rendering/rendering.hh
+    /// \brief Loads texture images in the background.
+    ///
+    /// A queued texture is created right away in Ogre as a 1x1 white
+    /// placeholder, which materials can refer to by name. Its image file is
+    /// read and decoded on worker threads, and the render thread uploads the
+    /// decoded images once per frame, within a time budget, replacing the
+    /// content of the placeholders. Compressed files are uploaded as is, and
+    /// the compressed copy of an image is preferred when the GPU supports it.
+    class GZ_RENDERING_VISIBLE TextureLoader :
+      public SingletonT<TextureLoader>
+    {
+      /// \brief Constructor.
+      private: TextureLoader();
+
+      /// \brief Destructor.
+      private: virtual ~TextureLoader();
+
+      /// \brief Stop the worker threads and drop the queued textures.
+      public: void Fini();
+
+      /// \brief Queue a texture to load in the background. Must be called
+      /// on the render thread.
+      /// \param[in] _name Name of the texture in Ogre, which is the path of
+      /// its image file, absolute or relative to the resource paths.
+      /// \return True if the texture is queued or already loaded, false if
+      /// the file was not found and the texture should be loaded by Ogre.
+      public: bool Queue(const std::string &_name);
+
+      /// \brief Upload decoded images until the upload budget is spent.
+      /// Called by the render engine before each frame.
+      public: void Update();
+
+      /// \brief Set the time spent uploading textures in each frame.
+      /// \param[in] _budget Time in seconds, 0 to upload every decoded image
+      /// in the same frame.
+      public: void SetUploadBudget(const double _budget);
+
+      /// \brief Get the time spent uploading textures in each frame.
+      /// \return Time in seconds, 0 if unlimited.
+      public: double UploadBudget() const;
+
+      /// \brief Enable background loading. When disabled, Queue returns false
+      /// and textures are loaded by Ogre when first used.
+      /// \param[in] _enabled True to load textures in the background.
+      public: void SetEnabled(const bool _enabled);
+
+      /// \brief Get whether background loading is enabled.
+      /// \return True if textures are loaded in the background.
+      public: bool Enabled() const;
+
+      /// \brief Load the compressed copy of a texture instead of its image,
+      /// if the GPU supports the format of the copy. Copies are written
+      /// next to the images by the gztexture tool: BC formats in a .dds
+      /// file, ASTC in a .astc file, with the same base name.
+      /// \param[in] _enabled True to use the compressed copies.
+      public: void SetCompressedVariants(const bool _enabled);
+
+      /// \brief Get whether the compressed copies of textures are used.
+      /// \return True if the compressed copies are used.
+      public: bool CompressedVariants() const;
+
+      /// \brief Get the number of queued textures not uploaded yet.
+      /// \return Number of pending textures.
+      public: unsigned int PendingCount() const;
+
+      /// \brief This is a singleton class.
+      private: friend class SingletonT<TextureLoader>;
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<TextureLoaderPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_TEXTURELOADERPRIVATE_HH_
+#define GAZEBO_RENDERING_TEXTURELOADERPRIVATE_HH_
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Private data for the TextureLoader class
+    class TextureLoaderPrivate
+    {
+      /// \brief Read and decode queued images until asked to stop.
+      public: void RunWorker();
+
+      /// \brief Worker threads.
+      public: std::vector<std::thread> workers;
+
+      /// \brief Mutex to protect the queues.
+      public: mutable std::mutex mutex;
+
+      /// \brief Signaled when a texture is queued or the workers must stop.
+      public: std::condition_variable condition;
+
+      /// \brief Textures to decode, with the path of their image file.
+      public: std::deque<std::pair<std::string, std::string>> toDecode;
+
+      /// \brief Decoded images to upload, by texture name.
+      public: std::deque<std::pair<std::string,
+              std::shared_ptr<Ogre::Image>>> toUpload;
+
+      /// \brief Textures queued and not uploaded yet.
+      public: std::set<std::string> pending;
+
+      /// \brief Upload budget in seconds per frame.
+      public: double uploadBudget = 0.004;
+
+      /// \brief True if textures are loaded in the background.
+      public: bool enabled = true;
+
+      /// \brief True to load the compressed copies of textures, when the
+      /// GPU supports them.
+      public: bool compressedVariants = true;
+
+      /// \brief True to stop the workers.
+      public: bool stop = false;
+    };
+  }
+}
+#endif
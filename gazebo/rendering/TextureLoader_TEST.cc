@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/TextureLoader.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+#include "test_config.h"
+
+using namespace gazebo;
+class TextureLoader_TEST : public RenderingFixture
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(TextureLoader_TEST, Budget)
+{
+  rendering::TextureLoader *loader = rendering::TextureLoader::Instance();
+  EXPECT_TRUE(loader->Enabled());
+  EXPECT_DOUBLE_EQ(loader->UploadBudget(), 0.004);
+
+  loader->SetUploadBudget(-1.0);
+  EXPECT_DOUBLE_EQ(loader->UploadBudget(), 0.0);
+  loader->SetUploadBudget(0.004);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TextureLoader_TEST, Queue)
+{
+  Load("worlds/empty.world");
+
+  rendering::TextureLoader *loader = rendering::TextureLoader::Instance();
+
+  // unknown files are left to Ogre
+  EXPECT_FALSE(loader->Queue(""));
+  EXPECT_FALSE(loader->Queue("no_such_texture.png"));
+
+  std::string texture = TEST_PATH;
+  texture += "/data/cordless_drill/materials/textures/cordless_drill.png";
+
+  // a placeholder is available right away
+  EXPECT_TRUE(loader->Queue(texture));
+  Ogre::TexturePtr tex =
+      Ogre::TextureManager::getSingleton().getByName(texture);
+  ASSERT_FALSE(tex.isNull());
+
+  // queuing again is a no-op
+  EXPECT_TRUE(loader->Queue(texture));
+
+  // wait for the image to be decoded and uploaded
+  int sleep = 0;
+  int maxSleep = 50;
+  while (loader->PendingCount() > 0u && sleep++ < maxSleep)
+  {
+    common::Time::MSleep(100);
+    loader->Update();
+  }
+  EXPECT_EQ(loader->PendingCount(), 0u);
+  EXPECT_GT(tex->getWidth(), 1u);
+  EXPECT_GT(tex->getHeight(), 1u);
+
+  // disabled loading leaves textures to Ogre
+  loader->SetEnabled(false);
+  std::string other = TEST_PATH;
+  other += "/data/cordless_drill/materials/textures/cordless_drill_other.png";
+  EXPECT_FALSE(loader->Queue(other));
+  loader->SetEnabled(true);
+
+  // compressed copies are preferred by default
+  EXPECT_TRUE(loader->CompressedVariants());
+  loader->SetCompressedVariants(false);
+  EXPECT_FALSE(loader->CompressedVariants());
+  loader->SetCompressedVariants(true);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -16,8 +16,7 @@
 */
 #include <boost/bind/bind.hpp>
 
-#include <ignition/common/Profiler.hh>
-
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/transport/transport.hh"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/rendering/DynamicLines.hh"
@@ -101,6 +100,10 @@ void TransmitterVisual::Update()
   if (!dPtr->gridMsg || !dPtr->receivedMsg)
     return;
 
+  // New data changes the frame of views that render on change.
+  if (dPtr->scene)
+    dPtr->scene->MarkChanged();
+
   // Update the visualization of the last propagation grid received
   dPtr->receivedMsg = false;
 
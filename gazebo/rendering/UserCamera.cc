@@ -15,7 +15,6 @@
  *
 */
 #include <boost/bind/bind.hpp>
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Color.hh>
 #include <ignition/math/Matrix4.hh>
@@ -23,6 +22,7 @@
 #include <ignition/math/Vector2.hh>
 #include <ignition/math/Vector3.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 
 #include "gazebo/common/Assert.hh"
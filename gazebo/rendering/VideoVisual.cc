@@ -16,9 +16,8 @@
 */
 #include <boost/bind/bind.hpp>
 
-#include <ignition/common/Profiler.hh>
-
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/common/Video.hh"
 
 #include "gazebo/rendering/ogre_gazebo.h"
@@ -117,6 +116,8 @@ void VideoVisual::PreRender()
       reinterpret_cast<VideoVisualPrivate *>(this->dataPtr);
 
   dPtr->video->GetNextFrame(&dPtr->imageBuffer);
+  if (dPtr->scene)
+    dPtr->scene->MarkChanged();
 
   // Get the pixel buffer
   Ogre::HardwarePixelBufferSharedPtr pixelBuffer = dPtr->texture->getBuffer();
@@ -18,7 +18,6 @@
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
 
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/Color.hh>
 #include <ignition/math/Helpers.hh>
@@ -31,6 +30,7 @@
 #include <ignition/transport/Node.hh>
 #include <ignition/transport/TopicUtils.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/msgs/msgs.hh"
 
 #include "gazebo/common/Assert.hh"
@@ -68,6 +68,124 @@ using namespace rendering;
 // Note: The value of ignition::math::MAX_UI32 is reserved as a flag.
 uint32_t VisualPrivate::visualIdCount = ignition::math::MAX_UI32 - 1;
 
+//////////////////////////////////////////////////
+/// \brief Generate the levels of detail of a mesh, if enabled in the
+/// render engine.
+/// \param[in] _ogreMesh The loaded Ogre mesh.
+/// \param[in] _mesh The mesh it was made of.
+static void GenerateMeshLod(Ogre::MeshPtr _ogreMesh,
+    const common::Mesh *_mesh)
+{
+  RenderEngine *engine = RenderEngine::Instance();
+  if (!engine->MeshLod() || _mesh->HasSkeleton() ||
+      _ogreMesh->getNumLodLevels() > 1)
+  {
+    return;
+  }
+
+  size_t vertexCount = 0;
+  for (unsigned int i = 0; i < _ogreMesh->getNumSubMeshes(); ++i)
+  {
+    Ogre::SubMesh *subMesh = _ogreMesh->getSubMesh(i);
+    if (subMesh->vertexData)
+      vertexCount += subMesh->vertexData->vertexCount;
+  }
+  if (vertexCount < engine->MeshLodMinVertices())
+    return;
+
+#if OGRE_VERSION_MAJOR > 1 || OGRE_VERSION_MINOR >= 9
+  Ogre::LodConfig config;
+  config.mesh = _ogreMesh;
+  config.strategy = Ogre::DistanceLodSphereStrategy::getSingletonPtr();
+
+  // Each level keeps half of the vertices of the previous one
+  double kept = 1.0;
+  for (auto const distance : engine->MeshLodDistances())
+  {
+    kept *= 0.5;
+    Ogre::LodLevel level;
+    level.distance = distance;
+    level.reductionMethod = Ogre::LodLevel::VRM_PROPORTIONAL;
+    level.reductionValue = 1.0 - kept;
+    config.levels.push_back(level);
+  }
+
+  if (config.levels.empty())
+    return;
+
+  try
+  {
+    Ogre::ProgressiveMeshGenerator generator;
+    generator.generateLodLevels(config);
+  }
+  catch(Ogre::Exception &_e)
+  {
+    gzerr << "Unable to generate levels of detail for mesh["
+          << _mesh->GetName() << "]: " << _e.getDescription() << std::endl;
+  }
+#else
+  static bool warned = false;
+  if (!warned)
+  {
+    gzwarn << "Generating mesh levels of detail requires Ogre 1.9\n";
+    warned = true;
+  }
+#endif
+}
+
+//////////////////////////////////////////////////
+/// \brief Check whether a visual or one of its parents is static.
+/// \param[in] _visual The visual.
+/// \return True if the visual is static.
+static bool InStaticVisual(const Visual *_visual)
+{
+  if (_visual->IsStatic())
+    return true;
+
+  for (VisualPtr vis = _visual->GetParent(); vis; vis = vis->GetParent())
+  {
+    if (vis->IsStatic())
+      return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+/// \brief Flag an object of a static visual as a static shadow caster if
+/// cameras render it, see ShadowCache.
+/// \param[in] _flags Visibility flags of the object.
+/// \return The flags, with GZ_VISIBILITY_STATIC added if needed.
+static uint32_t StaticVisibilityFlags(const uint32_t _flags)
+{
+  if (_flags & GZ_VISIBILITY_ALL &
+      ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE))
+  {
+    return _flags | GZ_VISIBILITY_STATIC;
+  }
+  return _flags;
+}
+
+//////////////////////////////////////////////////
+/// \brief Flag the objects of a scene node and of its descendants as
+/// static shadow casters.
+/// \param[in] _node The scene node.
+static void AddStaticVisibilityFlags(Ogre::SceneNode *_node)
+{
+  for (unsigned int i = 0; i < _node->numAttachedObjects(); ++i)
+  {
+    Ogre::MovableObject *obj = _node->getAttachedObject(i);
+    obj->setVisibilityFlags(StaticVisibilityFlags(obj->getVisibilityFlags()));
+  }
+
+  for (unsigned int i = 0; i < _node->numChildren(); ++i)
+  {
+    Ogre::SceneNode *child =
+        dynamic_cast<Ogre::SceneNode *>(_node->getChild(i));
+    if (child)
+      AddStaticVisibilityFlags(child);
+  }
+}
+
 //////////////////////////////////////////////////
 Visual::Visual(const std::string &_name, VisualPtr _parent, bool _useRTShader)
   : dataPtr(new VisualPrivate)
@@ -742,7 +860,10 @@ void Visual::AttachObject(Ogre::MovableObject *_obj)
     gzerr << "Visual[" << this->Name() << "] already has object["
           << _obj->getName() << "] attached.";
 
-  _obj->setVisibilityFlags(GZ_VISIBILITY_ALL);
+  if (InStaticVisual(this))
+    _obj->setVisibilityFlags(StaticVisibilityFlags(GZ_VISIBILITY_ALL));
+  else
+    _obj->setVisibilityFlags(GZ_VISIBILITY_ALL);
 }
 
 //////////////////////////////////////////////////
@@ -792,21 +913,18 @@ VisualPtr Visual::GetChild(unsigned int _num)
 //////////////////////////////////////////////////
 void Visual::MakeStatic()
 {
-  /*if (!this->staticGeom)
-    this->staticGeom =
-    this->dataPtr->sceneNode->getCreator()->createStaticGeometry(
-    this->dataPtr->sceneNode->getName() + "_Static");
-
-  // Add the scene node to the static geometry
-  this->staticGeom->addSceneNode(this->dataPtr->sceneNode);
-
-  // Build the static geometry
-  this->staticGeom->build();
+  // The scene merges static visuals into static geometry regions, see
+  // Scene::SetStaticBatching. The scene node and its entities are kept
+  // for selection and for editing.
+  if (this->dataPtr->isStatic)
+    return;
+  this->dataPtr->isStatic = true;
 
-  // Prevent double rendering
-  this->dataPtr->sceneNode->setVisible(false);
-  this->dataPtr->sceneNode->detachAllObjects();
-  */
+  // The objects cast the cached static shadows, see ShadowCache
+  if (this->dataPtr->sceneNode)
+    AddStaticVisibilityFlags(this->dataPtr->sceneNode);
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->InvalidateStaticShadows();
 }
 
 //////////////////////////////////////////////////
@@ -877,6 +995,9 @@ void Visual::SetScale(const ignition::math::Vector3d &_scale)
   if (this->dataPtr->scale == _scale)
     return;
 
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->MarkChanged();
+
   // update geom size based on scale.
   this->UpdateGeomSize(this->DerivedScale() / this->dataPtr->scale * _scale);
 
@@ -1079,6 +1200,9 @@ void Visual::SetMaterial(const std::string &_materialName, bool _unique,
   if (_materialName.empty() || _materialName == "__default__")
     return;
 
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->MarkChanged();
+
   ignition::math::Color matAmbient;
   ignition::math::Color matDiffuse;
   ignition::math::Color matSpecular;
@@ -1822,6 +1946,9 @@ void Visual::SetTransparency(float _trans)
   if (ignition::math::equal(this->dataPtr->transparency, _trans))
     return;
 
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->MarkChanged();
+
   this->dataPtr->transparency = std::min(
       std::max(_trans, static_cast<float>(0.0)), static_cast<float>(1.0));
 
@@ -1843,6 +1970,9 @@ bool Visual::InheritTransparency() const
 //////////////////////////////////////////////////
 void Visual::SetHighlighted(bool _highlighted)
 {
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->MarkChanged();
+
   if (_highlighted)
   {
     auto bbox = this->BoundingBox();
@@ -1941,6 +2071,9 @@ void Visual::SetVisible(bool _visible, bool _cascade)
   if (this->dataPtr->sceneNode)
     this->dataPtr->sceneNode->setVisible(_visible, _cascade);
 
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->MarkChanged();
+
   if (_cascade)
   {
     for (auto child: this->dataPtr->children)
@@ -1974,6 +2107,9 @@ void Visual::SetPosition(const ignition::math::Vector3d &_pos)
   GZ_ASSERT(this->dataPtr->sceneNode, "Visual SceneNode is NULL");
   this->dataPtr->sceneNode->setPosition(_pos.X(), _pos.Y(), _pos.Z());
 
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->MarkChanged();
+
   this->dataPtr->sdf->GetElement("pose")->Set(this->Pose());
 }
 
@@ -1984,6 +2120,9 @@ void Visual::SetRotation(const ignition::math::Quaterniond &_rot)
   this->dataPtr->sceneNode->setOrientation(
       Ogre::Quaternion(_rot.W(), _rot.X(), _rot.Y(), _rot.Z()));
 
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->MarkChanged();
+
   this->dataPtr->sdf->GetElement("pose")->Set(this->Pose());
 }
 
@@ -2038,6 +2177,9 @@ void Visual::SetWorldPosition(const ignition::math::Vector3d &_pos)
   if (!this->dataPtr->sceneNode)
     return;
   this->dataPtr->sceneNode->_setDerivedPosition(Conversions::Convert(_pos));
+
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->MarkChanged();
 }
 
 //////////////////////////////////////////////////
@@ -2046,6 +2188,9 @@ void Visual::SetWorldRotation(const ignition::math::Quaterniond &_q)
   if (!this->dataPtr->sceneNode)
     return;
   this->dataPtr->sceneNode->_setDerivedOrientation(Conversions::Convert(_q));
+
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->MarkChanged();
 }
 
 //////////////////////////////////////////////////
@@ -2624,6 +2769,10 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
 
     // this line makes clear the mesh is loaded (avoids memory leaks)
     ogreMesh->load();
+
+    // Levels of detail are generated once, and shared by all the visuals
+    // of the mesh
+    GenerateMeshLod(ogreMesh, _mesh);
   }
   catch(Ogre::Exception &e)
   {
@@ -2634,10 +2783,8 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
 //////////////////////////////////////////////////
 void Visual::UpdateFromMsg(const boost::shared_ptr< msgs::Visual const> &_msg)
 {
-  // TODO: Put back in, and check for performance improvements.
-  /*if (msg->has_is_static() && msg->is_static())
+  if (_msg->has_is_static() && _msg->is_static())
     this->MakeStatic();
-    */
 
   // Set meta information
   if (_msg->has_meta())
@@ -3283,9 +3430,13 @@ void Visual::SetVisibilityFlags(uint32_t _flags)
     (*iter)->SetVisibilityFlags(_flags);
   }
 
+  // Static visuals keep casting the cached static shadows
+  const uint32_t flags =
+      InStaticVisual(this) ? StaticVisibilityFlags(_flags) : _flags;
+
   for (int i = 0; i < this->dataPtr->sceneNode->numAttachedObjects(); ++i)
   {
-    this->dataPtr->sceneNode->getAttachedObject(i)->setVisibilityFlags(_flags);
+    this->dataPtr->sceneNode->getAttachedObject(i)->setVisibilityFlags(flags);
   }
 
   for (unsigned int i = 0; i < this->dataPtr->sceneNode->numChildren(); ++i)
@@ -3294,7 +3445,7 @@ void Visual::SetVisibilityFlags(uint32_t _flags)
         (Ogre::SceneNode*)(this->dataPtr->sceneNode->getChild(i));
 
     for (int j = 0; j < sn->numAttachedObjects(); ++j)
-      sn->getAttachedObject(j)->setVisibilityFlags(_flags);
+      sn->getAttachedObject(j)->setVisibilityFlags(flags);
   }
 
   this->dataPtr->visibilityFlags = _flags;
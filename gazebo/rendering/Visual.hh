@@ -389,7 +389,10 @@ namespace gazebo
       /// \return The Ogre scene node.
       public: Ogre::SceneNode *GetSceneNode() const;
 
-      /// \brief Make the visual objects static renderables.
+      /// \brief Make the visual objects static renderables. Static visuals
+      /// are merged into static geometry regions when the scene enables
+      /// static batching.
+      /// \sa Scene::SetStaticBatching(const bool _enable)
       public: void MakeStatic();
 
       /// \brief Return true if the  visual is a static geometry.
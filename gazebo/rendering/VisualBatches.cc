@@ -0,0 +1,721 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ignition/msgs/material.pb.h>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/Visual.hh"
+#include "gazebo/rendering/VisualBatches.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \brief A visual rendered by a batch.
+    class BatchMember
+    {
+      /// \brief Entity of the visual.
+      public: Ogre::Entity *entity = nullptr;
+
+      /// \brief Visibility flags of the entity before it was batched.
+      public: uint32_t visibilityFlags = 0;
+
+      /// \brief Derived position of the entity when batched.
+      public: Ogre::Vector3 position;
+
+      /// \brief Derived orientation of the entity when batched.
+      public: Ogre::Quaternion orientation;
+
+      /// \brief Derived scale of the entity when batched.
+      public: Ogre::Vector3 scale;
+
+      /// \brief Material of each sub entity when batched.
+      public: std::vector<std::string> materials;
+
+      /// \brief Key of the mesh and material, members with the same key
+      /// share the merged materials.
+      public: std::string materialKey;
+    };
+
+    /// \brief Visuals that share a mesh and a material, merged in a
+    /// static geometry.
+    class VisualBatch
+    {
+      /// \brief The merged geometry, null until built.
+      public: Ogre::StaticGeometry *geometry = nullptr;
+
+      /// \brief Materials cloned for the merged meshes.
+      public: std::vector<std::string> materials;
+
+      /// \brief Merged materials of each material key, one per sub entity.
+      public: std::map<std::string, std::vector<std::string>> shared;
+
+      /// \brief True if the batch holds the static visuals of a region.
+      public: bool region = false;
+
+      /// \brief Batched visuals, by visual id.
+      public: std::map<uint32_t, BatchMember> members;
+
+      /// \brief Visibility flags of the merged geometry.
+      public: uint32_t visibilityFlags = 0;
+
+      /// \brief True if the geometry needs to be rebuilt.
+      public: bool dirty = true;
+    };
+
+    /// \brief Visuals ready to join a batch.
+    class BatchGroup
+    {
+      /// \brief True if the group is a region of static visuals.
+      public: bool region = false;
+
+      /// \brief The visuals and their entities.
+      public: std::vector<std::pair<VisualPtr, Ogre::Entity *>> visuals;
+    };
+
+    /// \brief A visual that may join a batch once it rests.
+    class BatchCandidate
+    {
+      /// \brief Derived position at the last scan.
+      public: Ogre::Vector3 position;
+
+      /// \brief Derived orientation at the last scan.
+      public: Ogre::Quaternion orientation;
+
+      /// \brief Number of scans without motion.
+      public: unsigned int restScans = 0;
+    };
+
+    /// \internal
+    /// \brief Private data of VisualBatches.
+    class VisualBatchesPrivate
+    {
+      /// \brief Restore the entity of a member, if it is still the
+      /// visual's entity.
+      /// \param[in] _visual The visual, may be null.
+      /// \param[in] _member The member to restore.
+      public: void Restore(const VisualPtr &_visual,
+                  const BatchMember &_member);
+
+      /// \brief Destroy the geometry and materials of a batch.
+      /// \param[in] _batch The batch.
+      public: void Destroy(VisualBatch &_batch);
+
+      /// \brief Rebuild the geometry of a batch.
+      /// \param[in] _batch The batch.
+      public: void Build(VisualBatch &_batch);
+
+      /// \brief Get the merged materials of a member, cloned on first use.
+      /// \param[in] _batch The batch of the member.
+      /// \param[in] _member The member.
+      /// \return One material per sub entity.
+      public: const std::vector<std::string> &SharedMaterials(
+                  VisualBatch &_batch, const BatchMember &_member);
+
+      /// \brief Restore the visuals of some batches and destroy them.
+      /// \param[in] _visuals All the visuals of the scene.
+      /// \param[in] _region True to dissolve the regions, false to
+      /// dissolve the other batches.
+      public: void Dissolve(const std::map<uint32_t, VisualPtr> &_visuals,
+                  const bool _region);
+
+      /// \brief Scene manager that owns the geometries.
+      public: Ogre::SceneManager *manager = nullptr;
+
+      /// \brief True if batching is enabled.
+      public: bool enabled = false;
+
+      /// \brief True if static visuals are batched by region.
+      public: bool staticEnabled = false;
+
+      /// \brief Edge length of the regions of static visuals.
+      public: double regionSize = 50.0;
+
+      /// \brief Smallest number of visuals in a batch.
+      public: unsigned int threshold = 16;
+
+      /// \brief Frame counter, candidates are scanned periodically.
+      public: unsigned int frame = 0;
+
+      /// \brief Counter used to name the geometries.
+      public: unsigned int counter = 0;
+
+      /// \brief Batches, by mesh and material key, or by region key.
+      public: std::map<std::string, VisualBatch> batches;
+
+      /// \brief Key of the batch of each batched visual.
+      public: std::map<uint32_t, std::string> batchOf;
+
+      /// \brief Visuals that are not batched yet, by id.
+      public: std::map<uint32_t, BatchCandidate> candidates;
+    };
+  }
+}
+
+/// \brief Frames between two scans for resting visuals.
+static const unsigned int kScanPeriod = 30;
+
+/// \brief Scans without motion before a visual is batched.
+static const unsigned int kRestScans = 2;
+
+/////////////////////////////////////////////////
+/// \brief Get the entity of a visual that can be batched.
+/// \param[in] _visual The visual.
+/// \return The entity, or null if the visual can't be batched.
+static Ogre::Entity *BatchableEntity(const VisualPtr &_visual)
+{
+  if (!_visual || _visual->GetType() != Visual::VT_VISUAL ||
+      _visual->GetTransparency() > 0 || !_visual->GetSceneNode() ||
+      _visual->GetSceneNode()->numAttachedObjects() != 1)
+  {
+    return nullptr;
+  }
+
+  Ogre::Entity *entity = dynamic_cast<Ogre::Entity *>(
+      _visual->GetSceneNode()->getAttachedObject(0));
+  if (!entity || entity->hasSkeleton() || !entity->getVisible())
+    return nullptr;
+
+  // Only the visuals that are rendered by cameras and picked by the
+  // selection buffer.
+  uint32_t flags = entity->getVisibilityFlags();
+  if (!(flags & GZ_VISIBILITY_SELECTABLE) ||
+      !(flags & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE)))
+  {
+    return nullptr;
+  }
+
+  return entity;
+}
+
+/////////////////////////////////////////////////
+/// \brief Is a visual, or one of its parents, static?
+/// \param[in] _visual The visual.
+/// \return True if static.
+static bool IsStaticVisual(VisualPtr _visual)
+{
+  for (; _visual; _visual = _visual->GetParent())
+  {
+    if (_visual->IsStatic())
+      return true;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the material key of a visual.
+/// \param[in] _visual The visual.
+/// \return Key made of the mesh and the material.
+static std::string MaterialKey(const VisualPtr &_visual)
+{
+  ignition::msgs::Material material;
+  _visual->FillMaterialMsg(material);
+
+  return _visual->GetMeshName() + "::" + _visual->GetSubMeshName() + "|" +
+      material.SerializeAsString();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the batch key of a visual.
+/// \param[in] _visual The visual.
+/// \param[in] _entity Its entity.
+/// \return Key made of the visibility flags, the mesh and the material.
+static std::string BatchKey(const VisualPtr &_visual,
+    const Ogre::Entity *_entity)
+{
+  return std::to_string(_entity->getVisibilityFlags()) + "|" +
+      MaterialKey(_visual);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the region key of a static visual.
+/// \param[in] _visual The visual.
+/// \param[in] _entity Its entity.
+/// \param[in] _size Edge length of the regions.
+/// \return Key made of the visibility flags and the region indices.
+static std::string RegionKey(const VisualPtr &_visual,
+    const Ogre::Entity *_entity, const double _size)
+{
+  Ogre::Vector3 pos = _visual->GetSceneNode()->_getDerivedPosition();
+
+  std::ostringstream key;
+  key << "__static|" << _entity->getVisibilityFlags() << "|"
+      << static_cast<int64_t>(std::floor(pos.x / _size)) << ","
+      << static_cast<int64_t>(std::floor(pos.y / _size)) << ","
+      << static_cast<int64_t>(std::floor(pos.z / _size));
+  return key.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Has a batched visual changed since it was batched?
+/// \param[in] _visual The visual.
+/// \param[in] _member Its batch member.
+/// \return True if it must leave the batch.
+static bool Changed(const VisualPtr &_visual, const BatchMember &_member)
+{
+  Ogre::SceneNode *node = _visual->GetSceneNode();
+  if (!node || node->numAttachedObjects() != 1 ||
+      node->getAttachedObject(0) != _member.entity)
+  {
+    return true;
+  }
+
+  if (!_member.entity->getVisible() ||
+      _member.entity->getVisibilityFlags() != GZ_VISIBILITY_SELECTABLE ||
+      _member.entity->getNumSubEntities() != _member.materials.size())
+  {
+    return true;
+  }
+
+  if (node->_getDerivedPosition() != _member.position ||
+      node->_getDerivedOrientation() != _member.orientation ||
+      node->_getDerivedScale() != _member.scale)
+  {
+    return true;
+  }
+
+  for (unsigned int i = 0; i < _member.materials.size(); ++i)
+  {
+    if (_member.entity->getSubEntity(i)->getMaterialName() !=
+        _member.materials[i])
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/////////////////////////////////////////////////
+void VisualBatchesPrivate::Restore(const VisualPtr &_visual,
+    const BatchMember &_member)
+{
+  if (!_visual || !_visual->GetSceneNode())
+    return;
+
+  Ogre::SceneNode *node = _visual->GetSceneNode();
+  if (node->numAttachedObjects() != 1 ||
+      node->getAttachedObject(0) != _member.entity)
+  {
+    return;
+  }
+
+  // Keep flags that were changed while batched
+  if (_member.entity->getVisibilityFlags() == GZ_VISIBILITY_SELECTABLE)
+    _member.entity->setVisibilityFlags(_member.visibilityFlags);
+}
+
+/////////////////////////////////////////////////
+void VisualBatchesPrivate::Destroy(VisualBatch &_batch)
+{
+  if (_batch.geometry)
+  {
+    this->manager->destroyStaticGeometry(_batch.geometry);
+    _batch.geometry = nullptr;
+  }
+
+  for (auto const &material : _batch.materials)
+    Ogre::MaterialManager::getSingleton().remove(material);
+  _batch.materials.clear();
+  _batch.shared.clear();
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::string> &VisualBatchesPrivate::SharedMaterials(
+    VisualBatch &_batch, const BatchMember &_member)
+{
+  auto iter = _batch.shared.find(_member.materialKey);
+  if (iter != _batch.shared.end())
+    return iter->second;
+
+  // Members with the same key share a copy of the first one's materials
+  std::vector<std::string> &shared = _batch.shared[_member.materialKey];
+  for (auto const &original : _member.materials)
+  {
+    Ogre::MaterialPtr material =
+        Ogre::MaterialManager::getSingleton().getByName(original);
+    if (material.isNull())
+    {
+      shared.push_back(original);
+      continue;
+    }
+
+    std::string materialName = _batch.geometry->getName() + "_MATERIAL_" +
+        std::to_string(_batch.materials.size());
+    material->clone(materialName);
+    _batch.materials.push_back(materialName);
+    shared.push_back(materialName);
+  }
+  return shared;
+}
+
+/////////////////////////////////////////////////
+void VisualBatchesPrivate::Dissolve(
+    const std::map<uint32_t, VisualPtr> &_visuals, const bool _region)
+{
+  auto batchIter = this->batches.begin();
+  while (batchIter != this->batches.end())
+  {
+    if (batchIter->second.region != _region)
+    {
+      ++batchIter;
+      continue;
+    }
+
+    for (auto const &member : batchIter->second.members)
+    {
+      auto vis = _visuals.find(member.first);
+      if (vis != _visuals.end())
+        this->Restore(vis->second, member.second);
+      this->batchOf.erase(member.first);
+    }
+    this->Destroy(batchIter->second);
+    batchIter = this->batches.erase(batchIter);
+  }
+}
+
+/////////////////////////////////////////////////
+void VisualBatchesPrivate::Build(VisualBatch &_batch)
+{
+  _batch.dirty = false;
+  if (_batch.members.empty())
+    return;
+
+  const BatchMember &first = _batch.members.begin()->second;
+
+  if (!_batch.geometry)
+  {
+    std::ostringstream name;
+    name << "__GZ_VISUAL_BATCH_" << this->counter++;
+    _batch.geometry = this->manager->createStaticGeometry(name.str());
+
+    // A single region covers all its static visuals
+    if (_batch.region)
+    {
+      _batch.geometry->setRegionDimensions(Ogre::Vector3(
+          this->regionSize, this->regionSize, this->regionSize));
+    }
+  }
+  else
+  {
+    _batch.geometry->reset();
+  }
+
+  _batch.geometry->setCastShadows(first.entity->getCastShadows());
+
+  try
+  {
+    for (auto &member : _batch.members)
+    {
+      const std::vector<std::string> &shared =
+          this->SharedMaterials(_batch, member.second);
+      Ogre::Entity *entity = member.second.entity;
+      for (unsigned int i = 0; i < entity->getNumSubEntities() &&
+          i < shared.size(); ++i)
+      {
+        entity->getSubEntity(i)->setMaterialName(shared[i]);
+      }
+
+      _batch.geometry->addEntity(entity, member.second.position,
+          member.second.orientation, member.second.scale);
+
+      for (unsigned int i = 0; i < entity->getNumSubEntities(); ++i)
+        entity->getSubEntity(i)->setMaterialName(member.second.materials[i]);
+    }
+
+    _batch.geometry->build();
+  }
+  catch(Ogre::Exception &_e)
+  {
+    gzerr << "Unable to build a visual batch: " << _e.getFullDescription()
+          << std::endl;
+    _batch.geometry->reset();
+  }
+
+  // The selection buffer picks the entities, not the batch.
+  _batch.geometry->setVisibilityFlags(
+      _batch.visibilityFlags & ~GZ_VISIBILITY_SELECTABLE);
+}
+
+/////////////////////////////////////////////////
+VisualBatches::VisualBatches(Ogre::SceneManager *_manager)
+  : dataPtr(new VisualBatchesPrivate)
+{
+  this->dataPtr->manager = _manager;
+}
+
+/////////////////////////////////////////////////
+VisualBatches::~VisualBatches()
+{
+  for (auto &batch : this->dataPtr->batches)
+    this->dataPtr->Destroy(batch.second);
+}
+
+/////////////////////////////////////////////////
+void VisualBatches::SetEnabled(const std::map<uint32_t, VisualPtr> &_visuals,
+    const bool _enabled)
+{
+  if (this->dataPtr->enabled == _enabled)
+    return;
+
+  this->dataPtr->enabled = _enabled;
+  if (_enabled)
+    return;
+
+  this->dataPtr->Dissolve(_visuals, false);
+  this->dataPtr->candidates.clear();
+}
+
+/////////////////////////////////////////////////
+bool VisualBatches::Enabled() const
+{
+  return this->dataPtr->enabled;
+}
+
+/////////////////////////////////////////////////
+void VisualBatches::SetStaticEnabled(
+    const std::map<uint32_t, VisualPtr> &_visuals, const bool _enabled)
+{
+  if (this->dataPtr->staticEnabled == _enabled)
+    return;
+
+  this->dataPtr->staticEnabled = _enabled;
+  if (!_enabled)
+    this->dataPtr->Dissolve(_visuals, true);
+}
+
+/////////////////////////////////////////////////
+bool VisualBatches::StaticEnabled() const
+{
+  return this->dataPtr->staticEnabled;
+}
+
+/////////////////////////////////////////////////
+void VisualBatches::SetRegionSize(const double _size)
+{
+  if (_size <= 0)
+  {
+    gzerr << "Region size must be positive, got [" << _size << "]\n";
+    return;
+  }
+  this->dataPtr->regionSize = _size;
+}
+
+/////////////////////////////////////////////////
+double VisualBatches::RegionSize() const
+{
+  return this->dataPtr->regionSize;
+}
+
+/////////////////////////////////////////////////
+void VisualBatches::SetThreshold(const unsigned int _threshold)
+{
+  this->dataPtr->threshold = std::max(2u, _threshold);
+}
+
+/////////////////////////////////////////////////
+unsigned int VisualBatches::Threshold() const
+{
+  return this->dataPtr->threshold;
+}
+
+/////////////////////////////////////////////////
+void VisualBatches::Update(const std::map<uint32_t, VisualPtr> &_visuals)
+{
+  if ((!this->dataPtr->enabled && !this->dataPtr->staticEnabled) ||
+      !this->dataPtr->manager)
+  {
+    return;
+  }
+
+  // Release the visuals that changed or were removed
+  for (auto &batch : this->dataPtr->batches)
+  {
+    auto memberIter = batch.second.members.begin();
+    while (memberIter != batch.second.members.end())
+    {
+      auto vis = _visuals.find(memberIter->first);
+      if (vis == _visuals.end() || Changed(vis->second, memberIter->second))
+      {
+        if (vis != _visuals.end())
+          this->dataPtr->Restore(vis->second, memberIter->second);
+        this->dataPtr->batchOf.erase(memberIter->first);
+        memberIter = batch.second.members.erase(memberIter);
+        batch.second.dirty = true;
+      }
+      else
+        ++memberIter;
+    }
+  }
+
+  // Periodically look for static and resting visuals to batch
+  if (this->dataPtr->frame++ % kScanPeriod == 0)
+  {
+    std::map<std::string, BatchGroup> ready;
+    std::map<uint32_t, BatchCandidate> candidates;
+
+    for (auto const &vis : _visuals)
+    {
+      if (this->dataPtr->batchOf.count(vis.first))
+        continue;
+
+      Ogre::Entity *entity = BatchableEntity(vis.second);
+      if (!entity)
+        continue;
+
+      // Static visuals don't need to rest
+      if (this->dataPtr->staticEnabled && IsStaticVisual(vis.second))
+      {
+        BatchGroup &group = ready[RegionKey(vis.second, entity,
+            this->dataPtr->regionSize)];
+        group.region = true;
+        group.visuals.push_back({vis.second, entity});
+        continue;
+      }
+
+      if (!this->dataPtr->enabled)
+        continue;
+
+      Ogre::SceneNode *node = vis.second->GetSceneNode();
+      BatchCandidate candidate;
+      candidate.position = node->_getDerivedPosition();
+      candidate.orientation = node->_getDerivedOrientation();
+
+      auto previous = this->dataPtr->candidates.find(vis.first);
+      if (previous != this->dataPtr->candidates.end() &&
+          previous->second.position == candidate.position &&
+          previous->second.orientation == candidate.orientation)
+      {
+        candidate.restScans = previous->second.restScans + 1;
+      }
+
+      if (candidate.restScans >= kRestScans)
+      {
+        ready[BatchKey(vis.second, entity)].visuals.push_back(
+            {vis.second, entity});
+      }
+      candidates[vis.first] = candidate;
+    }
+    this->dataPtr->candidates.swap(candidates);
+
+    for (auto const &group : ready)
+    {
+      auto batch = this->dataPtr->batches.find(group.first);
+      unsigned int size = group.second.visuals.size() +
+          (batch == this->dataPtr->batches.end() ? 0 :
+           batch->second.members.size());
+      if (!group.second.region && size < this->dataPtr->threshold)
+        continue;
+
+      VisualBatch &target = this->dataPtr->batches[group.first];
+      target.region = group.second.region;
+      for (auto const &vis : group.second.visuals)
+      {
+        Ogre::Entity *entity = vis.second;
+        Ogre::SceneNode *node = vis.first->GetSceneNode();
+
+        BatchMember member;
+        member.entity = entity;
+        member.visibilityFlags = entity->getVisibilityFlags();
+        member.position = node->_getDerivedPosition();
+        member.orientation = node->_getDerivedOrientation();
+        member.scale = node->_getDerivedScale();
+        member.materialKey = MaterialKey(vis.first);
+        for (unsigned int i = 0; i < entity->getNumSubEntities(); ++i)
+        {
+          member.materials.push_back(
+              entity->getSubEntity(i)->getMaterialName());
+        }
+
+        target.visibilityFlags = member.visibilityFlags;
+        target.members[vis.first->GetId()] = member;
+        target.dirty = true;
+        this->dataPtr->batchOf[vis.first->GetId()] = group.first;
+        this->dataPtr->candidates.erase(vis.first->GetId());
+
+        // Only the selection buffer renders the entity now
+        entity->setVisibilityFlags(GZ_VISIBILITY_SELECTABLE);
+      }
+    }
+  }
+
+  // Rebuild the batches that changed, and dissolve the small ones. Only
+  // the regions that changed are rebuilt.
+  auto batchIter = this->dataPtr->batches.begin();
+  while (batchIter != this->dataPtr->batches.end())
+  {
+    VisualBatch &batch = batchIter->second;
+    unsigned int minimum = batch.region ? 1u : this->dataPtr->threshold;
+    if (batch.dirty && batch.members.size() < minimum)
+    {
+      for (auto const &member : batch.members)
+      {
+        auto vis = _visuals.find(member.first);
+        if (vis != _visuals.end())
+          this->dataPtr->Restore(vis->second, member.second);
+        this->dataPtr->batchOf.erase(member.first);
+      }
+      this->dataPtr->Destroy(batch);
+      batchIter = this->dataPtr->batches.erase(batchIter);
+      continue;
+    }
+
+    if (batch.dirty)
+      this->dataPtr->Build(batch);
+    ++batchIter;
+  }
+}
+
+/////////////////////////////////////////////////
+unsigned int VisualBatches::BatchCount() const
+{
+  return this->dataPtr->batches.size();
+}
+
+/////////////////////////////////////////////////
+unsigned int VisualBatches::RegionCount() const
+{
+  unsigned int count = 0;
+  for (auto const &batch : this->dataPtr->batches)
+  {
+    if (batch.second.region)
+      ++count;
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+unsigned int VisualBatches::VisualCount() const
+{
+  return this->dataPtr->batchOf.size();
+}
+
+/////////////////////////////////////////////////
+bool VisualBatches::IsBatched(const uint32_t _id) const
+{
+  return this->dataPtr->batchOf.count(_id) > 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_VISUALBATCHES_HH_
+#define GAZEBO_RENDERING_VISUALBATCHES_HH_
+
+#include <map>
+#include <memory>
+
+#include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace Ogre
+{
+  class SceneManager;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    class VisualBatchesPrivate;
+
+    /// \addtogroup gazebo_rendering
+    /// \{
+
+    /// \class VisualBatches VisualBatches.hh rendering/rendering.hh
+    /// \brief Renders many resting visuals that share a mesh and a material
+    /// with a few draw calls.
+    ///
+    /// Visuals that have not moved for a while are grouped by mesh and
+    /// material. Once a group is large enough, its meshes are merged into an
+    /// Ogre::StaticGeometry. The entities of the visuals stay attached to
+    /// their scene nodes, but only the selection buffer renders them, so
+    /// picking and ray queries still find each visual. A visual leaves its
+    /// batch as soon as its pose, scale, visibility, material or entity
+    /// changes, and the batch is rebuilt without it.
+    ///
+    /// Static visuals, see Visual::MakeStatic, can also be merged by
+    /// region. They are batched as soon as they are found, whatever their
+    /// mesh, and each cubic region of the scene gets its own geometry, so
+    /// that editing or deleting a static visual only rebuilds its region.
+    class GZ_RENDERING_VISIBLE VisualBatches
+    {
+      /// \brief Constructor.
+      /// \param[in] _manager Scene manager that owns the batches.
+      public: explicit VisualBatches(Ogre::SceneManager *_manager);
+
+      /// \brief Destructor. Destroys the batches, the visuals are left
+      /// untouched.
+      public: ~VisualBatches();
+
+      /// \brief Enable or disable batching. Disabling it restores all the
+      /// batched visuals.
+      /// \param[in] _visuals All the visuals of the scene.
+      /// \param[in] _enabled True to batch visuals.
+      public: void SetEnabled(const std::map<uint32_t, VisualPtr> &_visuals,
+                  const bool _enabled);
+
+      /// \brief Is batching enabled?
+      /// \return True if enabled. Disabled by default.
+      public: bool Enabled() const;
+
+      /// \brief Enable or disable the batching of static visuals by
+      /// region. Disabling it restores all the static visuals.
+      /// \param[in] _visuals All the visuals of the scene.
+      /// \param[in] _enabled True to batch static visuals.
+      public: void SetStaticEnabled(
+                  const std::map<uint32_t, VisualPtr> &_visuals,
+                  const bool _enabled);
+
+      /// \brief Is the batching of static visuals enabled?
+      /// \return True if enabled. Disabled by default.
+      public: bool StaticEnabled() const;
+
+      /// \brief Set the edge length of the regions of static visuals.
+      /// Regions that are already built keep their size until rebuilt.
+      /// \param[in] _size Edge length in meters, must be positive.
+      public: void SetRegionSize(const double _size);
+
+      /// \brief Get the edge length of the regions of static visuals.
+      /// \return Edge length in meters. The default is 50.
+      public: double RegionSize() const;
+
+      /// \brief Set the smallest number of visuals in a batch.
+      /// Regions of static visuals have no minimum.
+      /// \param[in] _threshold Number of visuals, at least 2.
+      public: void SetThreshold(const unsigned int _threshold);
+
+      /// \brief Get the smallest number of visuals in a batch.
+      /// \return Number of visuals.
+      public: unsigned int Threshold() const;
+
+      /// \brief Update the batches. Called once per frame.
+      /// \param[in] _visuals All the visuals of the scene.
+      public: void Update(const std::map<uint32_t, VisualPtr> &_visuals);
+
+      /// \brief Get the number of batches.
+      /// \return Number of built batches, regions included.
+      public: unsigned int BatchCount() const;
+
+      /// \brief Get the number of regions of static visuals.
+      /// \return Number of built regions.
+      public: unsigned int RegionCount() const;
+
+      /// \brief Get the number of batched visuals.
+      /// \return Number of visuals rendered by a batch.
+      public: unsigned int VisualCount() const;
+
+      /// \brief Is a visual rendered by a batch?
+      /// \param[in] _id Id of the visual.
+      /// \return True if batched.
+      public: bool IsBatched(const uint32_t _id) const;
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<VisualBatchesPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
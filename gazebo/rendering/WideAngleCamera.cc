@@ -30,6 +30,11 @@
 
 #endif /* HAVE_OPENGL */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include <ignition/math/Color.hh>
 
 #include "gazebo/rendering/ogre_gazebo.h"
@@ -709,8 +714,17 @@ void WideAngleCamera::RenderImpl()
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->renderMutex);
 
+  this->UpdateEnvFaces();
+
+  unsigned int skipped = 0;
   for (int i = 0; i < 6; ++i)
-    this->dataPtr->envRenderTargets[i]->update();
+  {
+    if (this->dataPtr->envFaceVisible[i])
+      this->dataPtr->envRenderTargets[i]->update();
+    else
+      ++skipped;
+  }
+  this->dataPtr->skippedFaces = skipped;
 
   this->dataPtr->compMat->getTechnique(0)->getPass(0)->getTextureUnitState(0)->
       setTextureName(this->dataPtr->envCubeMapTexture->getName());
@@ -718,6 +732,125 @@ void WideAngleCamera::RenderImpl()
   this->renderTarget->update();
 }
 
+//////////////////////////////////////////////////
+void WideAngleCamera::UpdateEnvFaces()
+{
+  CameraLens *lens = this->Lens();
+  if (!lens)
+    return;
+
+  const double c1 = lens->C1();
+  const double c2 = lens->C2();
+  const double c3 = lens->C3();
+  const double hfov = this->HFOV().Radian();
+  const double ratio = this->AspectRatio();
+  CameraLensPrivate::MapFunctionEnum fun(lens->Fun());
+  const ignition::math::Vector3d funVec = fun.AsVector3d();
+
+  std::vector<double> params = {c1, c2, c3, lens->F(), lens->CutOffAngle(),
+      lens->ScaleToHFOV() ? 1.0 : 0.0, hfov, ratio,
+      funVec.X(), funVec.Y(), funVec.Z(),
+      this->dataPtr->faceCulling ? 1.0 : 0.0,
+      static_cast<double>(this->EnvTextureSize())};
+  if (params == this->dataPtr->envFaceParams)
+    return;
+  this->dataPtr->envFaceParams = params;
+
+  for (int i = 0; i < 6; ++i)
+    this->dataPtr->envFaceVisible[i] = !this->dataPtr->faceCulling;
+
+  if (!this->dataPtr->faceCulling)
+    return;
+
+  // Same focal length and cut off radius as wide_lens_map_fp.glsl
+  double f = lens->F();
+  if (lens->ScaleToHFOV())
+    f = 1.0 / (c1 * fun.Apply(static_cast<float>((hfov / 2) / c2 + c3)));
+  double cutRadius = c1 * f *
+      fun.Apply(static_cast<float>(lens->CutOffAngle() / c2 + c3));
+  if (!std::isfinite(cutRadius) || cutRadius <= 0)
+    cutRadius = std::numeric_limits<double>::max();
+
+  // A face is also rendered when a sampled direction is close to its edge,
+  // since filtering reads texels across the edge, and to cover the space
+  // between two sampled directions.
+  const double margin = 2.0 / std::max(this->EnvTextureSize(), 1) + 0.02;
+
+  // Walk from the center of the image to its border, or to the cut off
+  // radius, in many directions. The angle from the optical axis grows with
+  // the distance to the center, so these rays cover all the directions
+  // that the lens samples.
+  const int azimuthSteps = 256;
+  const int radialSteps = 256;
+  for (int a = 0; a < azimuthSteps; ++a)
+  {
+    const double phi = 2.0 * IGN_PI * a / azimuthSteps;
+    const double dx = std::cos(phi);
+    const double dy = std::sin(phi);
+
+    // frag_pos spans [-1, 1] horizontally and [-1/ratio, 1/ratio]
+    // vertically
+    double edge = cutRadius;
+    if (std::fabs(dx) > 1e-9)
+      edge = std::min(edge, 1.0 / std::fabs(dx));
+    if (std::fabs(dy) > 1e-9)
+      edge = std::min(edge, 1.0 / (ratio * std::fabs(dy)));
+
+    for (int s = 0; s <= radialSteps; ++s)
+    {
+      const double param = edge * s / radialSteps / (c1 * f);
+      double theta = param;
+      if (funVec.X() > 0)
+      {
+        // The lens does not reach further from the axis
+        if (std::fabs(param) > 1.0)
+          break;
+        theta = std::asin(param);
+      }
+      else if (funVec.Y() > 0)
+        theta = std::atan(param);
+      theta = (theta - c3) * c2;
+
+      // Direction sampled in the cube map
+      const double dir[3] = {-std::sin(theta) * dx, std::sin(theta) * dy,
+          std::cos(theta)};
+
+      int major = 0;
+      for (int k = 1; k < 3; ++k)
+      {
+        if (std::fabs(dir[k]) > std::fabs(dir[major]))
+          major = k;
+      }
+
+      // Faces are ordered +X, -X, +Y, -Y, +Z, -Z
+      for (int k = 0; k < 3; ++k)
+      {
+        if (std::fabs(dir[k]) >= std::fabs(dir[major]) * (1.0 - margin))
+          this->dataPtr->envFaceVisible[2 * k + (dir[k] < 0 ? 1 : 0)] = true;
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void WideAngleCamera::SetFaceCulling(const bool _enable)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->renderMutex);
+  this->dataPtr->faceCulling = _enable;
+}
+
+//////////////////////////////////////////////////
+bool WideAngleCamera::FaceCulling() const
+{
+  return this->dataPtr->faceCulling;
+}
+
+//////////////////////////////////////////////////
+unsigned int WideAngleCamera::SkippedFaceCount() const
+{
+  return this->dataPtr->skippedFaces;
+}
+
 //////////////////////////////////////////////////
 void WideAngleCamera::notifyMaterialRender(Ogre::uint32 /*_pass_id*/,
                                            Ogre::MaterialPtr &_material)
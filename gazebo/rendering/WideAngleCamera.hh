@@ -213,6 +213,21 @@ namespace gazebo
       /// \param[in] _size Texture size
       public: void SetEnvTextureSize(const int _size);
 
+      /// \brief Only render the faces of the cube map that the lens samples.
+      /// For example a lens with a 120 degree field of view never samples
+      /// the back face. Enabled by default.
+      /// \param[in] _enable False to always render the six faces.
+      public: void SetFaceCulling(const bool _enable);
+
+      /// \brief Are the faces that the lens does not sample skipped?
+      /// \return True if enabled.
+      public: bool FaceCulling() const;
+
+      /// \brief Get the number of cube map faces that the last frame did not
+      /// render.
+      /// \return Number of skipped faces, between 0 and 5.
+      public: unsigned int SkippedFaceCount() const;
+
       /// \brief Creates a set of 6 cameras pointing in different directions
       protected: void CreateEnvCameras();
 
@@ -246,6 +261,10 @@ namespace gazebo
       // Documentation inherited
       protected: void UpdateFOV() override;
 
+      /// \brief Find the faces of the cube map that the lens samples, if the
+      /// lens or the camera changed since the last call.
+      private: void UpdateEnvFaces();
+
       /// \bried Callback that is used to set mapping material uniform values,
       ///   implements Ogre::CompositorInstance::Listener interface
       /// \param[in] _pass_id Pass identifier
@@ -18,6 +18,7 @@
 #define _GAZEBO_RENDERING_WIDE_ANGLE_CAMERA_CAMERA_PRIVATE_HH_
 
 #include <mutex>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
@@ -60,6 +61,19 @@ namespace gazebo
       /// \brief Viewports for the render targets
       public: Ogre::Viewport *envViewports[6];
 
+      /// \brief True for the faces of the cube map that the lens samples.
+      /// Only those faces are rendered.
+      public: bool envFaceVisible[6] = {true, true, true, true, true, true};
+
+      /// \brief Lens and camera parameters envFaceVisible was computed for.
+      public: std::vector<double> envFaceParams;
+
+      /// \brief True to only render the faces that the lens samples.
+      public: bool faceCulling = true;
+
+      /// \brief Number of faces skipped by the last frame.
+      public: unsigned int skippedFaces = 0;
+
       /// \brief Pixel format for cube map texture
       public: Ogre::PixelFormat envCubeMapTextureFormat;
 
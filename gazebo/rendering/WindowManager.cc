@@ -100,7 +100,11 @@ int WindowManager::CreateWindow(const std::string &_ogreHandle,
 #if defined(__APPLE__) || defined(_MSC_VER)
   params["externalWindowHandle"] = _ogreHandle;
 #else
-  params["parentWindowHandle"] = _ogreHandle;
+  // Without an X server, OGRE adopts the EGL context of the render engine
+  if (RenderEngine::Instance()->UsesEGL())
+    params["currentGLContext"] = "true";
+  else
+    params["parentWindowHandle"] = _ogreHandle;
 #endif
   params["FSAA"] = "4";
   params["stereoMode"] = "Frame Sequential";
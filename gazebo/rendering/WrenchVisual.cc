@@ -16,9 +16,8 @@
 */
 #include <boost/bind/bind.hpp>
 
-#include <ignition/common/Profiler.hh>
-
 #include "gazebo/common/MeshManager.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/transport/transport.hh"
 
 #include "gazebo/rendering/Conversions.hh"
@@ -171,6 +170,10 @@ void WrenchVisual::Update()
   if (!dPtr->wrenchMsg || !dPtr->receivedMsg)
     return;
 
+  // New data changes the frame of views that render on change.
+  if (dPtr->scene)
+    dPtr->scene->MarkChanged();
+
   double magScale = 100;
   double vMax = 0.5;
   double vMin = 0.1;
@@ -82,6 +82,12 @@
 #include <OGRE/OgreFontManager.h>
 #endif
 
+#if OGRE_VERSION_MAJOR > 1 || OGRE_VERSION_MINOR >= 9
+#include <OGRE/OgreDistanceLodStrategy.h>
+#include <OGRE/OgreLodConfig.h>
+#include <OGRE/OgreProgressiveMeshGenerator.h>
+#endif
+
 #if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR < 11
 // The  <OGRE/OgreWindowEventUtilities.h> header has always been included in
 // public headers for Gazebo <= 10, but was moved to the Bites component in
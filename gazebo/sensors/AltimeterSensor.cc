@@ -16,8 +16,7 @@
 */
 #include <boost/algorithm/string.hpp>
 
-#include <ignition/common/Profiler.hh>
-
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/common/common.hh"
 #include "gazebo/physics/physics.hh"
 #include "gazebo/transport/transport.hh"
@@ -71,6 +70,9 @@ void AltimeterSensor::Load(const std::string &_worldName)
   this->dataPtr->parentLink =
     boost::dynamic_pointer_cast<physics::Link>(parentEntity);
 
+  // Read the parent link through consistent per step snapshots
+  this->world->SetSnapshotsEnabled(true);
+
   this->dataPtr->altPub =
     this->node->Advertise<msgs::Altimeter>(this->Topic(), 50);
 
@@ -132,13 +134,14 @@ bool AltimeterSensor::UpdateImpl(const bool /*_force*/)
   // Get latest pose information
   if (this->dataPtr->parentLink)
   {
-    ignition::math::Pose3d parentPose = this->dataPtr->parentLink->WorldPose();
+    physics::LinkSnapshot parentState =
+      this->LinkState(this->dataPtr->parentLink);
 
     // Get pose in gazebo reference frame
-    ignition::math::Pose3d altPose = this->pose + parentPose;
+    ignition::math::Pose3d altPose = this->pose + parentState.pose;
 
     ignition::math::Vector3d altVel =
-      this->dataPtr->parentLink->WorldLinearVel(this->pose.Pos());
+      parentState.WorldLinearVel(this->pose.Pos());
 
     // Apply noise to the position and velocity
     if (this->noises.find(ALTIMETER_POSITION_NOISE_METERS) !=
@@ -172,8 +175,8 @@ bool AltimeterSensor::UpdateImpl(const bool /*_force*/)
   msgs::Set(this->dataPtr->altMsg.mutable_time(), this->world->SimTime());
 
   // Publish the message if needed
-  if (this->dataPtr->altPub)
-    this->dataPtr->altPub->Publish(this->dataPtr->altMsg);
+  this->PublishSample(this->dataPtr->altPub, this->dataPtr->altMsg,
+      msgs::Convert(this->dataPtr->altMsg.time()));
   IGN_PROFILE_END();
   return true;
 }
@@ -15,14 +15,18 @@
  *
 */
 #include <boost/algorithm/string.hpp>
+#include <cmath>
 #include <functional>
-#include <ignition/common/Profiler.hh>
+#include <string>
+#include <vector>
 #include <ignition/msgs/Utility.hh>
 
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Image.hh"
 #include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/PixelConversions.hh"
+#include "gazebo/common/TraceCapture.hh"
 
 #include "gazebo/msgs/msgs.hh"
 
@@ -110,6 +114,13 @@ void CameraSensor::Load(const std::string &_worldName)
 
   this->imagePub = this->node->Advertise<msgs::ImageStamped>(this->Topic(), 50);
 
+  if (!this->dataPtr->compressedFormat.empty())
+  {
+    this->dataPtr->compressedPub =
+      this->node->Advertise<msgs::CompressedImage>(this->CompressedTopic(),
+          50);
+  }
+
   ignition::transport::AdvertiseMessageOptions opts;
   opts.SetMsgsPerSec(50);
   this->imagePubIgn = this->nodeIgn.Advertise<ignition::msgs::Image>(
@@ -196,6 +207,8 @@ void CameraSensor::Init()
 void CameraSensor::Fini()
 {
   this->imagePub.reset();
+  this->dataPtr->compressedPub.reset();
+  this->dataPtr->encoder.reset();
 
   if (this->camera)
   {
@@ -339,47 +352,74 @@ bool CameraSensor::UpdateImpl(const bool /*_force*/)
 
   IGN_PROFILE_BEGIN("fillarray");
 
-  if ((this->imagePub && this->imagePub->HasConnections()) ||
-      this->imagePubIgn.HasConnections())
+  size_t copied = 0;
+  const bool publishGz = this->imagePub && this->imagePub->HasConnections();
+  const bool publishIgn = this->imagePubIgn.HasConnections();
+  if (publishGz || publishIgn)
   {
     auto simTime = this->scene->SimTime();
-    if (this->imagePub && this->imagePub->HasConnections())
+    const unsigned int width = this->camera->ImageWidth();
+    const unsigned int height = this->camera->ImageHeight();
+    const unsigned int step = width * this->camera->ImageDepth();
+    const size_t size = static_cast<size_t>(step) * height;
+    const char *data =
+        reinterpret_cast<const char *>(this->camera->ImageData());
+
+    // The frame is copied once into the gazebo message, which is handed to
+    // the publisher without another copy. The ignition message borrows the
+    // same buffer while it is published.
+    boost::shared_ptr<msgs::ImageStamped> msg;
+    std::string *frame = nullptr;
+    if (publishGz)
     {
-      msgs::ImageStamped msg;
-      msgs::Set(msg.mutable_time(), simTime);
-      msg.mutable_image()->set_width(this->camera->ImageWidth());
-      msg.mutable_image()->set_height(this->camera->ImageHeight());
-      msg.mutable_image()->set_pixel_format(common::Image::ConvertPixelFormat(
-            this->camera->ImageFormat()));
-
-      msg.mutable_image()->set_step(this->camera->ImageWidth() *
-          this->camera->ImageDepth());
-      msg.mutable_image()->set_data(this->camera->ImageData(),
-          msg.image().width() * this->camera->ImageDepth() *
-          msg.image().height());
-
-      this->imagePub->Publish(msg);
+      msg.reset(new msgs::ImageStamped);
+      msgs::Set(msg->mutable_time(), simTime);
+      msg->mutable_image()->set_width(width);
+      msg->mutable_image()->set_height(height);
+      msg->mutable_image()->set_pixel_format(
+          common::Image::ConvertPixelFormat(this->camera->ImageFormat()));
+      msg->mutable_image()->set_step(step);
+      msg->mutable_image()->set_data(data, size);
+      frame = msg->mutable_image()->mutable_data();
+      copied += size;
     }
 
-    if (this->imagePubIgn.HasConnections())
+    if (publishIgn)
     {
-      ignition::msgs::Image msg;
-      msg.mutable_header()->mutable_stamp()->set_sec(simTime.sec);
-      msg.mutable_header()->mutable_stamp()->set_nsec(simTime.nsec);
+      ignition::msgs::Image &msgIgn = this->dataPtr->imageMsgIgn;
+      msgIgn.mutable_header()->mutable_stamp()->set_sec(simTime.sec);
+      msgIgn.mutable_header()->mutable_stamp()->set_nsec(simTime.nsec);
 
-      msg.set_width(this->camera->ImageWidth());
-      msg.set_height(this->camera->ImageHeight());
-      msg.set_pixel_format_type(ignition::msgs::ConvertPixelFormatType(
+      msgIgn.set_width(width);
+      msgIgn.set_height(height);
+      msgIgn.set_pixel_format_type(ignition::msgs::ConvertPixelFormatType(
             this->camera->ImageFormat()));
+      msgIgn.set_step(step);
 
-      msg.set_step(this->camera->ImageWidth() *
-          this->camera->ImageDepth());
-      msg.set_data(this->camera->ImageData(),
-          msg.width() * this->camera->ImageDepth() *
-          msg.height());
-
-      this->imagePubIgn.Publish(msg);
+      if (frame)
+      {
+        msgIgn.set_allocated_data(frame);
+        this->imagePubIgn.Publish(msgIgn);
+        msgIgn.release_data();
+      }
+      else
+      {
+        msgIgn.set_data(data, size);
+        copied += size;
+        this->imagePubIgn.Publish(msgIgn);
+      }
     }
+
+    if (msg)
+      this->imagePub->Publish(msg);
+  }
+
+  this->dataPtr->imageBytesCopied = copied;
+
+  if (this->dataPtr->compressedPub &&
+      this->dataPtr->compressedPub->HasConnections())
+  {
+    this->PublishCompressed();
   }
 
   this->dataPtr->rendered = false;
@@ -387,6 +427,125 @@ bool CameraSensor::UpdateImpl(const bool /*_force*/)
   return true;
 }
 
+//////////////////////////////////////////////////
+void CameraSensor::PublishCompressed()
+{
+  IGN_PROFILE("CameraSensor::PublishCompressed");
+
+  const std::string format = this->camera->ImageFormat();
+  const bool bgr = format == "B8G8R8" || format == "BGR_INT8";
+  if (!bgr && format != "R8G8B8" && format != "RGB_INT8")
+  {
+    gzerr << "Compressed streams need R8G8B8 or B8G8R8 images, not ["
+          << this->camera->ImageFormat() << "], disabling the stream of ["
+          << this->ScopedName() << "]\n";
+    this->SetCompressedStream("");
+    return;
+  }
+
+  const unsigned int width = this->camera->ImageWidth();
+  const unsigned int height = this->camera->ImageHeight();
+
+  if (!this->dataPtr->encoder)
+  {
+    const double rate = this->UpdateRate();
+    const unsigned int fps =
+      rate > 0 ? static_cast<unsigned int>(std::ceil(rate)) : 30;
+
+    this->dataPtr->encoder.reset(new common::VideoStreamEncoder);
+    if (!this->dataPtr->encoder->Start(this->dataPtr->compressedFormat,
+          width, height, fps, this->dataPtr->compressedBitRate,
+          this->dataPtr->compressedGop))
+    {
+      gzerr << "Unable to start the compressed stream of ["
+            << this->ScopedName() << "]\n";
+      this->SetCompressedStream("");
+      return;
+    }
+    this->dataPtr->compressedSubscribers = 0;
+  }
+
+  // Video decoders need a key frame to join the stream, so send one as
+  // soon as a new subscriber connects. Local subscribers wait for the
+  // next key frame of the group of pictures.
+  const unsigned int subscribers =
+    this->dataPtr->compressedPub->GetRemoteSubscriptionCount();
+  if (subscribers > this->dataPtr->compressedSubscribers)
+    this->dataPtr->encoder->RequestKeyFrame();
+  this->dataPtr->compressedSubscribers = subscribers;
+
+  // The encoders take RGB frames
+  const unsigned char *frame = this->camera->ImageData();
+  if (bgr)
+  {
+    std::vector<unsigned char> &rgb = this->dataPtr->compressedFrame;
+    rgb.resize(static_cast<size_t>(width) * height * 3);
+    common::ConvertRGBToBGR(frame, rgb.data(),
+        static_cast<size_t>(width) * height);
+    frame = rgb.data();
+  }
+
+  msgs::CompressedImage msg;
+  bool keyFrame = false;
+  if (!this->dataPtr->encoder->Encode(frame, width, height,
+        *msg.mutable_data(), keyFrame))
+  {
+    return;
+  }
+
+  msgs::Set(msg.mutable_time(), this->scene->SimTime());
+  msg.set_format(this->dataPtr->compressedFormat);
+  msg.set_width(width);
+  msg.set_height(height);
+  msg.set_key_frame(keyFrame);
+  msg.set_sequence(this->dataPtr->compressedSequence++);
+  this->dataPtr->compressedPub->Publish(msg);
+}
+
+//////////////////////////////////////////////////
+bool CameraSensor::SetCompressedStream(const std::string &_format,
+    const unsigned int _bitRate, const unsigned int _gop)
+{
+  if (!_format.empty() && _format != "h264" && _format != "h265" &&
+      _format != "jpeg")
+  {
+    gzerr << "Unknown compressed stream format [" << _format
+          << "], use h264, h265 or jpeg\n";
+    return false;
+  }
+
+  this->dataPtr->encoder.reset();
+  this->dataPtr->compressedFormat = _format;
+  this->dataPtr->compressedBitRate = _bitRate;
+  this->dataPtr->compressedGop = _gop;
+  this->dataPtr->compressedSequence = 0;
+
+  if (_format.empty())
+  {
+    this->dataPtr->compressedPub.reset();
+  }
+  else if (!this->dataPtr->compressedPub && this->node)
+  {
+    this->dataPtr->compressedPub =
+      this->node->Advertise<msgs::CompressedImage>(this->CompressedTopic(),
+          50);
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::string CameraSensor::CompressedStreamFormat() const
+{
+  return this->dataPtr->compressedFormat;
+}
+
+//////////////////////////////////////////////////
+std::string CameraSensor::CompressedTopic() const
+{
+  return this->Topic() + "/compressed";
+}
+
 //////////////////////////////////////////////////
 unsigned int CameraSensor::ImageWidth() const
 {
@@ -421,6 +580,12 @@ unsigned int CameraSensor::ImageHeight() const
   return 0;
 }
 
+//////////////////////////////////////////////////
+size_t CameraSensor::ImageBytesCopied() const
+{
+  return this->dataPtr->imageBytesCopied;
+}
+
 //////////////////////////////////////////////////
 const unsigned char *CameraSensor::ImageData() const
 {
@@ -446,9 +611,29 @@ bool CameraSensor::IsActive() const
 {
   return Sensor::IsActive() ||
     (this->imagePub && this->imagePub->HasConnections()) ||
+    (this->dataPtr->compressedPub &&
+     this->dataPtr->compressedPub->HasConnections()) ||
     this->imagePubIgn.HasConnections();
 }
 
+//////////////////////////////////////////////////
+bool CameraSensor::HasConsumers() const
+{
+  return Sensor::HasConsumers() ||
+    (this->imagePub && this->imagePub->HasConnections()) ||
+    (this->dataPtr->compressedPub &&
+     this->dataPtr->compressedPub->HasConnections()) ||
+    this->imagePubIgn.HasConnections() ||
+    (this->camera &&
+     this->camera->FrameListenerCount() > this->OwnFrameListenerCount());
+}
+
+//////////////////////////////////////////////////
+unsigned int CameraSensor::OwnFrameListenerCount() const
+{
+  return 0;
+}
+
 //////////////////////////////////////////////////
 rendering::CameraPtr CameraSensor::Camera() const
 {
@@ -104,6 +104,36 @@ namespace gazebo
       /// \return The pointer to the image data array.
       public: const unsigned char *ImageData() const;
 
+      /// \brief Get the number of image bytes copied to publish the last
+      /// frame. A frame is copied at most once, whatever the transports
+      /// that publish it, and not at all when no one subscribes.
+      /// \return Number of bytes.
+      public: size_t ImageBytesCopied() const;
+
+      /// \brief Also publish the images compressed, on CompressedTopic().
+      /// Video formats use a hardware encoder when one is available. A key
+      /// frame is sent when a remote subscriber connects, and every _gop
+      /// frames. Frames are only encoded while the topic has subscribers.
+      /// The camera must produce R8G8B8 or B8G8R8 images.
+      /// \param[in] _format "h264", "h265", "jpeg", or empty to stop
+      /// publishing compressed images.
+      /// \param[in] _bitRate Bit rate of the stream. Zero computes a bit
+      /// rate from the image size.
+      /// \param[in] _gop Number of frames between two key frames.
+      /// \return True on success.
+      /// \sa common::VideoStreamDecoder
+      public: bool SetCompressedStream(const std::string &_format,
+                  const unsigned int _bitRate = 0,
+                  const unsigned int _gop = 30);
+
+      /// \brief Get the format of the compressed stream.
+      /// \return Format given to SetCompressedStream, empty if disabled.
+      public: std::string CompressedStreamFormat() const;
+
+      /// \brief Get the topic of the compressed images.
+      /// \return Topic() followed by "/compressed".
+      public: std::string CompressedTopic() const;
+
       /// \brief Saves the image to the disk.
       /// \param[in] _filename The name of the file to be saved.
       /// \return True if successful, false if unsuccessful.
@@ -112,6 +142,15 @@ namespace gazebo
       // Documentation inherited
       public: virtual bool IsActive() const override;
 
+      // Documentation inherited
+      public: virtual bool HasConsumers() const override;
+
+      /// \brief Get the number of connections this sensor makes itself to
+      /// the frame events of its camera, which are not consumers.
+      /// \return Number of connections.
+      /// \sa HasConsumers
+      protected: virtual unsigned int OwnFrameListenerCount() const;
+
       // Documentation inherited
       protected: virtual bool UpdateImpl(const bool _force) override;
 
@@ -131,6 +170,9 @@ namespace gazebo
       /// \brief Handle the prerenderEnded event.
       protected: void PrerenderEnded();
 
+      /// \brief Encode the last image and publish it on CompressedTopic().
+      private: void PublishCompressed();
+
       /// \brief Pointer to the camera.
       protected: rendering::CameraPtr camera;
 
@@ -17,7 +17,16 @@
 #ifndef GAZEBO_SENSORS_CAMERASENSOR_PRIVATE_HH_
 #define GAZEBO_SENSORS_CAMERASENSOR_PRIVATE_HH_
 
+#include <atomic>
 #include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/msgs/image.pb.h>
+
+#include "gazebo/common/VideoStreamEncoder.hh"
+#include "gazebo/transport/TransportTypes.hh"
 
 namespace gazebo
 {
@@ -36,6 +45,40 @@ namespace gazebo
       /// \brief Timestamp of the forthcoming rendering
       public: double nextRenderingTime
                            = std::numeric_limits<double>::quiet_NaN();
+
+      /// \brief Outgoing image message on the ignition topic. It is
+      /// reused, so that the image buffer is only allocated once when only
+      /// the ignition topic has subscribers.
+      public: ignition::msgs::Image imageMsgIgn;
+
+      /// \brief Image bytes copied to publish the last frame.
+      public: std::atomic<size_t> imageBytesCopied{0};
+
+      /// \brief Publisher of compressed image messages.
+      public: transport::PublisherPtr compressedPub;
+
+      /// \brief Encoder of the compressed stream, started when the first
+      /// subscriber connects.
+      public: std::unique_ptr<common::VideoStreamEncoder> encoder;
+
+      /// \brief Format of the compressed stream, empty if disabled.
+      public: std::string compressedFormat;
+
+      /// \brief Bit rate of the compressed stream, 0 for a default.
+      public: unsigned int compressedBitRate = 0;
+
+      /// \brief Frames between two key frames of the compressed stream.
+      public: unsigned int compressedGop = 30;
+
+      /// \brief Sequence number of the next compressed frame.
+      public: uint32_t compressedSequence = 0;
+
+      /// \brief Remote subscribers of the compressed stream at the last
+      /// frame.
+      public: unsigned int compressedSubscribers = 0;
+
+      /// \brief BGR frames converted to RGB before they are encoded.
+      public: std::vector<unsigned char> compressedFrame;
     };
   }
 }
@@ -15,11 +15,12 @@
  *
 */
 #include <boost/algorithm/string.hpp>
+#include <functional>
 #include <sstream>
-
-#include <ignition/common/Profiler.hh>
+#include <vector>
 
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/TraceCapture.hh"
 
 #include "gazebo/transport/Node.hh"
 
@@ -94,7 +95,6 @@ void ContactSensor::Load(const std::string &_worldName)
 
   std::string entityName =
       this->world->EntityByName(this->ParentName())->GetScopedName();
-  this->dataPtr->filterName = entityName + "::" + this->Name();
 
   // Get all the collision elements
   while (collisionElem)
@@ -109,18 +109,28 @@ void ContactSensor::Load(const std::string &_worldName)
     collisionElem = collisionElem->GetNextElement("collision");
   }
 
-  if (!this->dataPtr->collisions.empty())
+  if (!this->dataPtr->collisions.empty() && !this->dataPtr->contactQuery)
   {
-    // request the contact manager to publish messages to a custom topic for
-    // this sensor
-    physics::ContactManager *mgr = this->world->Physics()->GetContactManager();
-    std::string topic = mgr->CreateFilter(this->dataPtr->filterName,
-        this->dataPtr->collisions);
-    if (!this->dataPtr->contactSub)
+    std::vector<physics::CollisionPtr> collisions;
+    for (auto const &name : this->dataPtr->collisions)
     {
-      this->dataPtr->contactSub = this->node->Subscribe(topic,
-          &ContactSensor::OnContacts, this);
+      physics::CollisionPtr collision =
+        boost::dynamic_pointer_cast<physics::Collision>(
+            this->world->EntityByName(name));
+      if (collision)
+        collisions.push_back(collision);
+      else
+        gzerr << "Contact sensor [" << this->Name()
+              << "] is unable to find collision [" << name << "]\n";
     }
+
+    // Request the contact manager to hand the contacts of the collisions
+    // directly to this sensor. Only the output of the sensor is published.
+    physics::ContactManager *mgr = this->world->Physics()->GetContactManager();
+    physics::ContactQueryPtr query = mgr->CreateQuery(collisions);
+    query->onContacts = std::bind(&ContactSensor::OnContacts, this,
+        std::placeholders::_1);
+    this->dataPtr->contactQuery = query;
   }
 }
 
@@ -142,53 +152,16 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
   if (this->dataPtr->incomingContacts.empty())
     return false;
 
-  std::vector<std::string>::iterator collIter;
-  std::string collision1;
-
   // Clear the outgoing contact message.
   this->dataPtr->contactsMsg.clear_contact();
 
-  // Iterate over all the contact messages
-  for (auto iter = this->dataPtr->incomingContacts.begin();
-       iter != this->dataPtr->incomingContacts.end(); ++iter)
+  // Move the contacts of all the steps since the last update to the
+  // outgoing message. The contact query only holds contacts that involve
+  // the collisions of this sensor.
+  for (auto &msg : this->dataPtr->incomingContacts)
   {
-    // Iterate over all the contacts in the message
-    for (int i = 0; i < (*iter)->contact_size(); ++i)
-    {
-      collision1 = (*iter)->contact(i).collision1();
-
-      // Try to find the first collision's name
-      collIter = std::find(this->dataPtr->collisions.begin(),
-          this->dataPtr->collisions.end(), collision1);
-
-      // If unable to find the first collision's name, try the second
-      if (collIter == this->dataPtr->collisions.end())
-      {
-        collision1 = (*iter)->contact(i).collision2();
-        collIter = std::find(this->dataPtr->collisions.begin(),
-            this->dataPtr->collisions.end(), collision1);
-      }
-
-      // If this sensor is monitoring one of the collision's in the
-      // contact, then add the contact to our outgoing message.
-      if (collIter != this->dataPtr->collisions.end())
-      {
-        int count = (*iter)->contact(i).position_size();
-
-        // Check to see if the contact arrays all have the same size.
-        if (count != (*iter)->contact(i).normal_size() ||
-            count != (*iter)->contact(i).wrench_size() ||
-            count != (*iter)->contact(i).depth_size())
-        {
-          gzerr << "Contact message has invalid array sizes\n";
-          continue;
-        }
-
-        // Copy the contact message.
-        msgs::Contact *contactMsg = this->dataPtr->contactsMsg.add_contact();
-        contactMsg->CopyFrom((*iter)->contact(i));
-      }
-    }
+    for (auto &contact : *msg.mutable_contact())
+      this->dataPtr->contactsMsg.add_contact()->Swap(&contact);
   }
 
   IGN_PROFILE_END();
@@ -202,10 +175,10 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
             this->lastMeasurementTime);
 
   // Generate a outgoing message only if someone is listening.
-  if (this->dataPtr->contactsPub &&
-      this->dataPtr->contactsPub->HasConnections())
+  if (this->HasSampleConnections(this->dataPtr->contactsPub))
   {
-    this->dataPtr->contactsPub->Publish(this->dataPtr->contactsMsg);
+    this->PublishSample(this->dataPtr->contactsPub,
+        this->dataPtr->contactsMsg, this->lastMeasurementTime);
   }
 
   IGN_PROFILE_END();
@@ -215,14 +188,16 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
 //////////////////////////////////////////////////
 void ContactSensor::Fini()
 {
-  if (this->world && this->world->Running())
+  // The query must be removed even if the world stopped, since it calls
+  // back into this sensor.
+  if (this->dataPtr->contactQuery && this->world && this->world->Physics())
   {
     physics::ContactManager *mgr =
         this->world->Physics()->GetContactManager();
-    mgr->RemoveFilter(this->dataPtr->filterName);
+    mgr->RemoveQuery(this->dataPtr->contactQuery);
   }
+  this->dataPtr->contactQuery.reset();
 
-  this->dataPtr->contactSub.reset();
   this->dataPtr->contactsPub.reset();
   Sensor::Fini();
 }
@@ -304,15 +279,23 @@ std::map<std::string, gazebo::physics::Contact> ContactSensor::Contacts(
 }
 
 //////////////////////////////////////////////////
-void ContactSensor::OnContacts(ConstContactsPtr &_msg)
+void ContactSensor::OnContacts(
+    const std::vector<physics::Contact *> &_contacts)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Only store information if the sensor is active
   if (this->IsActive())
   {
-    // Store the contacts message for processing in UpdateImpl
-    this->dataPtr->incomingContacts.push_back(_msg);
+    // Copy the contacts for processing in UpdateImpl, the contact manager
+    // reuses them in the next step.
+    this->dataPtr->incomingContacts.emplace_back();
+    msgs::Contacts &msg = this->dataPtr->incomingContacts.back();
+    for (auto const contact : _contacts)
+    {
+      if (contact->count > 0)
+        contact->FillMsg(*msg.add_contact());
+    }
 
     // Prevent the incomingContacts list to grow indefinitely.
     if (this->dataPtr->incomingContacts.size() > 100)
@@ -324,6 +307,5 @@ void ContactSensor::OnContacts(ConstContactsPtr &_msg)
 bool ContactSensor::IsActive() const
 {
   return this->active ||
-    (this->dataPtr->contactsPub &&
-     this->dataPtr->contactsPub->HasConnections());
+    this->HasSampleConnections(this->dataPtr->contactsPub);
 }
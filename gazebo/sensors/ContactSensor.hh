@@ -20,6 +20,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 
@@ -94,10 +95,11 @@ namespace gazebo
       /// to publish all contacts generated within a timestep onto
       /// Gazebo topic ~/physics/contacts.
       ///
-      /// Each ContactSensor subscribes to the Gazebo ~/physics/contacts topic,
-      /// retrieves all contact pairs in a time step and filters them wthin
-      /// ContactSensor::OnContacts against <collision> body name
-      /// specified by the ContactSensor SDF.
+      /// Each ContactSensor registers a physics::ContactQuery for the
+      /// <collision> bodies specified by the ContactSensor SDF. In the same
+      /// call, the ContactManager hands the contacts of these collisions to
+      /// ContactSensor::OnContacts, which copies them without going through
+      /// transport.
       /// All collision pairs between ContactSensor <collision> body and
       /// other bodies in the world are stored in an array inside
       /// contacts.proto.
@@ -133,8 +135,11 @@ namespace gazebo
       // Documentation inherited.
       public: virtual bool IsActive() const;
 
-      /// \brief Callback for contact messages from the physics engine.
-      private: void OnContacts(ConstContactsPtr &_msg);
+      /// \brief Callback for the contacts of a physics step, called on the
+      /// physics thread by the contact manager.
+      /// \param[in] _contacts Contacts of the collisions of the sensor.
+      private: void OnContacts(
+                   const std::vector<physics::Contact *> &_contacts);
 
       /// \internal
       /// \brief Private data pointer
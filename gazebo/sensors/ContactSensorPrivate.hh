@@ -24,6 +24,7 @@
 
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/ContactManager.hh"
 
 namespace gazebo
 {
@@ -39,8 +40,9 @@ namespace gazebo
       /// \brief Output contact information.
       public: transport::PublisherPtr contactsPub;
 
-      /// \brief Subscription to contact messages from the physics engine
-      public: transport::SubscriberPtr contactSub;
+      /// \brief Query through which the contact manager hands the contacts
+      /// of the collisions to the sensor, without publishing them.
+      public: physics::ContactQueryPtr contactQuery;
 
       /// \brief Mutex to protect reads and writes.
       public: mutable std::mutex mutex;
@@ -48,15 +50,9 @@ namespace gazebo
       /// \brief Contacts message used to output sensor data.
       public: msgs::Contacts contactsMsg;
 
-      /// \type ContactMsgs_L
-      /// List of contact messages
-      typedef std::list<boost::shared_ptr<msgs::Contacts const> > ContactMsgs_L;
-
-      /// \brief List of incoming messages.
-      public: ContactMsgs_L incomingContacts;
-
-      /// \brief Name of filter used to filter contact messages.
-      public: std::string filterName;
+      /// \brief Contacts of each physics step since the last update, one
+      /// message per step.
+      public: std::list<msgs::Contacts> incomingContacts;
     };
   }
 }
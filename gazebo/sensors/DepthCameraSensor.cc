@@ -14,9 +14,16 @@
  * limitations under the License.
  *
 */
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <string>
+#include <vector>
 
-#include "ignition/common/Profiler.hh"
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Image.hh"
+#include "gazebo/common/PixelConversions.hh"
+#include "gazebo/common/TraceCapture.hh"
 
 #include "gazebo/physics/World.hh"
 
@@ -29,6 +36,8 @@
 
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/sensors/CameraSensor.hh"
+#include "gazebo/sensors/GaussianNoiseModel.hh"
+#include "gazebo/sensors/Noise.hh"
 #include "gazebo/sensors/DepthCameraSensorPrivate.hh"
 #include "gazebo/sensors/DepthCameraSensor.hh"
 
@@ -37,6 +46,49 @@ using namespace sensors;
 
 GZ_REGISTER_STATIC_SENSOR("depth", DepthCameraSensor)
 
+/// \brief Convert a float to an IEEE 754 half float, rounding to nearest.
+/// \param[in] _value Value to convert.
+/// \return Bits of the half float.
+static uint16_t FloatToHalf(const float _value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &_value, sizeof(bits));
+
+  uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+  uint32_t floatExponent = (bits >> 23) & 0xffu;
+  uint32_t mantissa = bits & 0x7fffffu;
+  int exponent = static_cast<int>(floatExponent) - 127 + 15;
+
+  // Infinity and NaN
+  if (floatExponent == 0xffu)
+    return sign | 0x7c00u | (mantissa ? 0x200u : 0u);
+
+  // Too large, becomes infinity
+  if (exponent >= 31)
+    return sign | 0x7c00u;
+
+  // Too small for a normal half float, becomes subnormal or zero
+  if (exponent <= 0)
+  {
+    if (exponent < -10)
+      return sign;
+
+    mantissa |= 0x800000u;
+    unsigned int shift = 14 - exponent;
+    uint16_t half = static_cast<uint16_t>(mantissa >> shift);
+    if ((mantissa >> (shift - 1)) & 1u)
+      ++half;
+    return sign | half;
+  }
+
+  // A carry out of the mantissa correctly increments the exponent.
+  uint16_t half = sign | static_cast<uint16_t>(exponent << 10) |
+      static_cast<uint16_t>(mantissa >> 13);
+  if (mantissa & 0x1000u)
+    ++half;
+  return half;
+}
+
 //////////////////////////////////////////////////
 DepthCameraSensor::DepthCameraSensor()
     : CameraSensor(),
@@ -107,6 +159,33 @@ void DepthCameraSensor::Init()
     this->dataPtr->depthCamera->CreateNormalsTexture(
         this->Name() + "_RttTex_Normals");
 
+    // Gazebo specific opt-in
+    sdf::ElementPtr depthElem = cameraSdf->GetElement("depth_camera");
+    if (depthElem->HasElement("depth_image_uint16"))
+    {
+      this->dataPtr->depthImageUInt16 =
+          depthElem->Get<bool>("depth_image_uint16");
+    }
+
+    if (this->dataPtr->depthCamera->OutputPoints())
+    {
+      if (depthElem->HasElement("point_cloud_half_float"))
+      {
+        this->dataPtr->pointCloudHalfFloat =
+            depthElem->Get<bool>("point_cloud_half_float");
+      }
+
+      this->dataPtr->pointCloudPub =
+          this->node->Advertise<msgs::PointCloudPacked>(
+          this->PointCloudTopic(), 50);
+
+      this->dataPtr->pointCloudConnection =
+          this->dataPtr->depthCamera->ConnectNewRGBPointCloud(
+          std::bind(&DepthCameraSensor::OnNewRGBPointCloud, this,
+            std::placeholders::_1, std::placeholders::_2,
+            std::placeholders::_3));
+    }
+
     ignition::math::Pose3d cameraPose = this->pose;
     if (cameraSdf->HasElement("pose"))
       cameraPose = cameraSdf->Get<ignition::math::Pose3d>("pose") + cameraPose;
@@ -118,6 +197,19 @@ void DepthCameraSensor::Init()
         this->dataPtr->depthCamera);
 
     GZ_ASSERT(this->camera, "Unable to cast depth camera to camera");
+
+    // Gaussian noise is added to the depth image by the depth shader
+    if (cameraSdf->HasElement("noise"))
+    {
+      this->noises[CAMERA_NOISE] =
+        NoiseFactory::NewNoiseModel(cameraSdf->GetElement("noise"),
+        this->Type());
+      if (std::dynamic_pointer_cast<RangeGaussianNoiseModel>(
+          this->noises[CAMERA_NOISE]))
+      {
+        this->noises[CAMERA_NOISE]->SetCamera(this->camera);
+      }
+    }
   }
   else
   {
@@ -155,11 +247,6 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
     msgs::Set(msg.mutable_time(), this->scene->SimTime());
     msg.mutable_image()->set_width(this->camera->ImageWidth());
     msg.mutable_image()->set_height(this->camera->ImageHeight());
-    msg.mutable_image()->set_pixel_format(common::Image::R_FLOAT32);
-
-
-    msg.mutable_image()->set_step(this->camera->ImageWidth() *
-        this->camera->ImageDepth());
 
     unsigned int depthSamples = msg.image().width() * msg.image().height();
     float f;
@@ -172,22 +259,50 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
     memcpy(this->dataPtr->depthBuffer, this->dataPtr->depthCamera->DepthData(),
         depthBufferSize);
 
+    // Mask ranges outside of min/max to +/- inf, as per REP 117
+    const float farClip = this->camera->FarClip();
+    const float nearClip = this->camera->NearClip();
+    float *depth = this->dataPtr->depthBuffer;
     for (unsigned int i = 0; i < depthSamples; ++i)
     {
-      // Mask ranges outside of min/max to +/- inf, as per REP 117
-      if (this->dataPtr->depthBuffer[i] >= this->camera->FarClip())
-      {
-        this->dataPtr->depthBuffer[i] = ignition::math::INF_D;
-      }
-      else if (this->dataPtr->depthBuffer[i] <= this->camera->NearClip())
-      {
-        this->dataPtr->depthBuffer[i] = -ignition::math::INF_D;
-      }
+      const float d = depth[i];
+      depth[i] = d >= farClip ? ignition::math::INF_F :
+          (d <= nearClip ? -ignition::math::INF_F : d);
+    }
+
+    if (this->dataPtr->depthImageUInt16)
+    {
+      std::vector<uint16_t> &depth16 = this->dataPtr->depthBufferUInt16;
+      depth16.resize(depthSamples);
+      common::ConvertDepthToUInt16(this->dataPtr->depthCamera->DepthData(),
+          depth16.data(), depthSamples, 1000.0f, this->camera->NearClip(),
+          this->camera->FarClip());
+
+      msg.mutable_image()->set_pixel_format(common::Image::L_INT16);
+      msg.mutable_image()->set_step(
+          this->camera->ImageWidth() * sizeof(uint16_t));
+      msg.mutable_image()->set_data(depth16.data(),
+          depthSamples * sizeof(uint16_t));
+    }
+    else
+    {
+      msg.mutable_image()->set_pixel_format(common::Image::R_FLOAT32);
+      msg.mutable_image()->set_step(this->camera->ImageWidth() *
+          this->camera->ImageDepth());
+      msg.mutable_image()->set_data(this->dataPtr->depthBuffer,
+          depthBufferSize);
     }
-    msg.mutable_image()->set_data(this->dataPtr->depthBuffer, depthBufferSize);
     this->imagePub->Publish(msg);
   }
 
+  if (this->dataPtr->pointCloudReady)
+  {
+    msgs::Set(this->dataPtr->pointCloudMsg.mutable_time(),
+        this->scene->SimTime());
+    this->dataPtr->pointCloudPub->Publish(this->dataPtr->pointCloudMsg);
+    this->dataPtr->pointCloudReady = false;
+  }
+
   this->SetRendered(false);
   IGN_PROFILE_END();
   return true;
@@ -204,3 +319,144 @@ rendering::DepthCameraPtr DepthCameraSensor::DepthCamera() const
 {
   return this->dataPtr->depthCamera;
 }
+
+//////////////////////////////////////////////////
+bool DepthCameraSensor::HasConsumers() const
+{
+  return CameraSensor::HasConsumers() ||
+    (this->dataPtr->pointCloudPub &&
+     this->dataPtr->pointCloudPub->HasConnections());
+}
+
+//////////////////////////////////////////////////
+unsigned int DepthCameraSensor::OwnFrameListenerCount() const
+{
+  // The point cloud is packed for the point cloud topic.
+  return this->dataPtr->pointCloudConnection ? 1u : 0u;
+}
+
+//////////////////////////////////////////////////
+void DepthCameraSensor::Fini()
+{
+  this->dataPtr->pointCloudConnection.reset();
+  this->dataPtr->pointCloudPub.reset();
+
+  CameraSensor::Fini();
+}
+
+//////////////////////////////////////////////////
+std::string DepthCameraSensor::PointCloudTopic() const
+{
+  std::string topicName = "~/";
+  topicName += this->ParentName() + "/" + this->Name() + "/points";
+  common::replaceAll(topicName, topicName, "::", "/");
+
+  return topicName;
+}
+
+//////////////////////////////////////////////////
+void DepthCameraSensor::SetPointCloudHalfFloat(const bool _enable)
+{
+  this->dataPtr->pointCloudHalfFloat = _enable;
+}
+
+//////////////////////////////////////////////////
+bool DepthCameraSensor::PointCloudHalfFloat() const
+{
+  return this->dataPtr->pointCloudHalfFloat;
+}
+
+//////////////////////////////////////////////////
+void DepthCameraSensor::SetDepthImageUInt16(const bool _enable)
+{
+  this->dataPtr->depthImageUInt16 = _enable;
+}
+
+//////////////////////////////////////////////////
+bool DepthCameraSensor::DepthImageUInt16() const
+{
+  return this->dataPtr->depthImageUInt16;
+}
+
+//////////////////////////////////////////////////
+void DepthCameraSensor::OnNewRGBPointCloud(const float *_pcd,
+    const unsigned int _width, const unsigned int _height)
+{
+  // Only pay for the packing when somebody listens.
+  if (!this->dataPtr->pointCloudPub ||
+      !this->dataPtr->pointCloudPub->HasConnections())
+  {
+    return;
+  }
+
+  IGN_PROFILE("DepthCameraSensor::OnNewRGBPointCloud");
+
+  bool half = this->dataPtr->pointCloudHalfFloat;
+  unsigned int coordSize = half ? 2u : 4u;
+  msgs::PointCloudPacked::Field::DataType coordType = half ?
+      msgs::PointCloudPacked::Field::FLOAT16 :
+      msgs::PointCloudPacked::Field::FLOAT32;
+
+  // XYZ followed by one byte per color channel and one byte of padding,
+  // which keeps the coordinates aligned.
+  unsigned int rgbOffset = 3u * coordSize;
+  unsigned int pointStep = rgbOffset + 4u;
+
+  msgs::PointCloudPacked &msg = this->dataPtr->pointCloudMsg;
+  if (msg.field_size() == 0 || msg.point_step() != pointStep)
+  {
+    msg.clear_field();
+    const char *names[] = {"x", "y", "z"};
+    for (unsigned int i = 0; i < 3u; ++i)
+    {
+      msgs::PointCloudPacked::Field *field = msg.add_field();
+      field->set_name(names[i]);
+      field->set_offset(i * coordSize);
+      field->set_datatype(coordType);
+      field->set_count(1);
+    }
+    msgs::PointCloudPacked::Field *field = msg.add_field();
+    field->set_name("rgb");
+    field->set_offset(rgbOffset);
+    field->set_datatype(msgs::PointCloudPacked::Field::UINT8);
+    field->set_count(3);
+  }
+
+  msg.set_width(_width);
+  msg.set_height(_height);
+  msg.set_point_step(pointStep);
+  msg.set_row_step(pointStep * _width);
+
+  // Fill the message buffer in place, so the cloud is copied only once.
+  std::string *data = msg.mutable_data();
+  data->resize(static_cast<size_t>(pointStep) * _width * _height);
+  char *dst = &(*data)[0];
+
+  unsigned int count = _width * _height;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    const float *point = _pcd + 4 * i;
+    if (half)
+    {
+      uint16_t coords[3] = {FloatToHalf(point[0]), FloatToHalf(point[1]),
+          FloatToHalf(point[2])};
+      std::memcpy(dst, coords, sizeof(coords));
+    }
+    else
+    {
+      std::memcpy(dst, point, 3 * sizeof(float));
+    }
+
+    // See DepthCamera::ConnectNewRGBPointCloud for the color packing.
+    uint32_t rgb = static_cast<uint32_t>(point[3]);
+    uint8_t *color = reinterpret_cast<uint8_t *>(dst + rgbOffset);
+    color[0] = static_cast<uint8_t>((rgb >> 16) & 0xffu);
+    color[1] = static_cast<uint8_t>((rgb >> 8) & 0xffu);
+    color[2] = static_cast<uint8_t>(rgb & 0xffu);
+    color[3] = 0u;
+
+    dst += pointStep;
+  }
+
+  this->dataPtr->pointCloudReady = true;
+}
@@ -59,6 +59,39 @@ namespace gazebo
       /// \return Depth Camera pointer
       public: virtual rendering::DepthCameraPtr DepthCamera() const;
 
+      /// \brief Get the topic of the packed point cloud. The point cloud is
+      /// published when the depth camera outputs points.
+      /// \return Topic name.
+      public: std::string PointCloudTopic() const;
+
+      /// \brief Pack the point coordinates of the published point cloud as
+      /// half floats, which shrinks a point from 16 to 10 bytes.
+      /// \param[in] _enable True to use half floats.
+      /// \sa PointCloudHalfFloat()
+      public: void SetPointCloudHalfFloat(const bool _enable);
+
+      /// \brief Get whether point coordinates are packed as half floats.
+      /// \return True if half floats are used.
+      /// \sa SetPointCloudHalfFloat(const bool _enable)
+      public: bool PointCloudHalfFloat() const;
+
+      /// \brief Publish depth images as 16 bit unsigned integers in
+      /// millimeters, the L_INT16 format, instead of floats in meters. This
+      /// halves the size of the images. Depths outside of the clip range
+      /// are 0.
+      /// \param[in] _enable True to publish 16 bit depth images.
+      /// \sa DepthImageUInt16()
+      public: void SetDepthImageUInt16(const bool _enable);
+
+      /// \brief Get whether depth images are published as 16 bit unsigned
+      /// integers.
+      /// \return True if 16 bit depth images are published.
+      /// \sa SetDepthImageUInt16(const bool _enable)
+      public: bool DepthImageUInt16() const;
+
+      // Documentation inherited
+      public: virtual bool HasConsumers() const override;
+
       /// \brief Load the sensor with default parameters
       /// \param[in] _worldName Name of world to load from
       protected: virtual void Load(const std::string &_worldName);
@@ -66,6 +99,19 @@ namespace gazebo
       // Documentation inherited
       protected: virtual bool UpdateImpl(const bool _force);
 
+      // Documentation inherited
+      protected: virtual void Fini() override;
+
+      // Documentation inherited
+      protected: virtual unsigned int OwnFrameListenerCount() const override;
+
+      /// \brief Pack a new point cloud of the depth camera into a message.
+      /// \param[in] _pcd Points as XYZ and packed RGB floats.
+      /// \param[in] _width Number of points in a row.
+      /// \param[in] _height Number of rows.
+      private: void OnNewRGBPointCloud(const float *_pcd,
+                   const unsigned int _width, const unsigned int _height);
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<DepthCameraSensorPrivate> dataPtr;
@@ -17,7 +17,14 @@
 #ifndef _GAZEBO_SENSORS_DEPTHCAMERASENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_DEPTHCAMERASENSOR_PRIVATE_HH_
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Event.hh"
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/transport/TransportTypes.hh"
 
 namespace gazebo
 {
@@ -32,6 +39,28 @@ namespace gazebo
 
       /// \brief Local pointer to the depthCamera.
       public: rendering::DepthCameraPtr depthCamera;
+
+      /// \brief Publisher of the packed point cloud.
+      public: transport::PublisherPtr pointCloudPub;
+
+      /// \brief Connection to the point cloud event of the depth camera.
+      public: event::ConnectionPtr pointCloudConnection;
+
+      /// \brief True to pack the point coordinates as half floats.
+      public: bool pointCloudHalfFloat = false;
+
+      /// \brief Point cloud waiting to be published.
+      public: msgs::PointCloudPacked pointCloudMsg;
+
+      /// \brief True if pointCloudMsg holds a new point cloud.
+      public: bool pointCloudReady = false;
+
+      /// \brief True to publish depth images as millimeters in 16 bit
+      /// unsigned integers.
+      public: bool depthImageUInt16 = false;
+
+      /// \brief Depth image in millimeters.
+      public: std::vector<uint16_t> depthBufferUInt16;
     };
   }
 }
@@ -15,6 +15,7 @@
  *
 */
 
+#include <cstdint>
 #include <functional>
 #include <mutex>
 
@@ -113,6 +114,65 @@ TEST_F(DepthCameraSensor_TEST, CreateDepthCamera)
     delete [] g_depthBuffer;
 }
 
+std::mutex g_depthImageMutex;
+unsigned int g_depthImageCounter = 0;
+msgs::Image g_depthImage;
+
+/////////////////////////////////////////////////
+void OnDepthImage(ConstImageStampedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_depthImageMutex);
+  g_depthImage = _msg->image();
+  g_depthImageCounter++;
+}
+
+/////////////////////////////////////////////////
+/// \brief Test the 16 bit depth images, in millimeters
+TEST_F(DepthCameraSensor_TEST, DepthImageUInt16)
+{
+  Load("worlds/depth_camera.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+
+  std::string sensorName = "default::camera_model::my_link::camera";
+  sensors::DepthCameraSensorPtr sensor =
+     std::dynamic_pointer_cast<sensors::DepthCameraSensor>
+     (mgr->GetSensor(sensorName));
+  ASSERT_NE(nullptr, sensor);
+
+  EXPECT_FALSE(sensor->DepthImageUInt16());
+  sensor->SetDepthImageUInt16(true);
+  EXPECT_TRUE(sensor->DepthImageUInt16());
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub = node->Subscribe(sensor->Topic(),
+      &OnDepthImage);
+
+  int i = 0;
+  while (i < 300 && g_depthImageCounter < 5)
+  {
+    common::Time::MSleep(20);
+    i++;
+  }
+  EXPECT_GE(g_depthImageCounter, 5u);
+
+  std::lock_guard<std::mutex> lock(g_depthImageMutex);
+  EXPECT_EQ(common::Image::L_INT16,
+      static_cast<int>(g_depthImage.pixel_format()));
+  EXPECT_EQ(sensor->ImageWidth() * 2u, g_depthImage.step());
+  ASSERT_EQ(sensor->ImageWidth() * sensor->ImageHeight() * 2u,
+      g_depthImage.data().size());
+
+  // sphere with radius 1m is at 2m in front of depth camera
+  const uint16_t *depth =
+    reinterpret_cast<const uint16_t *>(g_depthImage.data().data());
+  unsigned int halfHeight = sensor->ImageHeight() / 2 - 1;
+  unsigned int center = sensor->ImageWidth() * halfHeight +
+    sensor->ImageWidth() / 2;
+  EXPECT_GE(depth[center], 1000u);
+  EXPECT_LT(depth[center], 2000u);
+}
+
 class DepthCameraReflectanceSensor_TEST : public ServerFixture
 {
 };
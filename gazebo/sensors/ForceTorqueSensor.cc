@@ -14,18 +14,24 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
 #include <boost/algorithm/string.hpp>
 
-#include <ignition/common/Profiler.hh>
+#include <ignition/math/Helpers.hh>
 #include <ignition/math/Matrix3.hh>
 #include <ignition/math/Quaternion.hh>
 #include <ignition/math/Vector3.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/Joint.hh"
 
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/Events.hh"
 
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publisher.hh"
@@ -45,6 +51,7 @@ ForceTorqueSensor::ForceTorqueSensor()
 : Sensor(sensors::OTHER),
   dataPtr(new ForceTorqueSensorPrivate)
 {
+  this->dataPtr->update.SetName("forceTorqueUpdate");
 }
 
 //////////////////////////////////////////////////
@@ -63,6 +70,66 @@ std::string ForceTorqueSensor::Topic() const
   return topicName;
 }
 
+//////////////////////////////////////////////////
+std::string ForceTorqueSensor::BatchTopic() const
+{
+  return this->Topic() + "/batch";
+}
+
+//////////////////////////////////////////////////
+/// \brief Express a joint wrench in the measure frame of a sensor.
+/// \param[in] _data Sensor data, with the frame and direction.
+/// \param[in] _wrench Joint wrench.
+/// \param[out] _force Measured force.
+/// \param[out] _torque Measured torque.
+static void MeasureWrench(const ForceTorqueSensorPrivate &_data,
+    const physics::JointWrench &_wrench, ignition::math::Vector3d &_force,
+    ignition::math::Vector3d &_torque)
+{
+  if (_data.measureFrame == ForceTorqueSensorPrivate::PARENT_LINK)
+  {
+    if (_data.parentToChild)
+    {
+      _force = _wrench.body1Force;
+      _torque = _wrench.body1Torque;
+    }
+    else
+    {
+      _force = -1*_wrench.body1Force;
+      _torque = -1*_wrench.body1Torque;
+    }
+  }
+  else if (_data.measureFrame == ForceTorqueSensorPrivate::CHILD_LINK)
+  {
+    if (!_data.parentToChild)
+    {
+      _force = _wrench.body2Force;
+      _torque = _wrench.body2Torque;
+    }
+    else
+    {
+      _force = -1*_wrench.body2Force;
+      _torque = -1*_wrench.body2Torque;
+    }
+  }
+  else
+  {
+    GZ_ASSERT(_data.measureFrame == ForceTorqueSensorPrivate::SENSOR,
+        "measureFrame must be PARENT_LINK, CHILD_LINK or SENSOR");
+
+    if (!_data.parentToChild)
+    {
+      _force = _data.rotationSensorChild * _wrench.body2Force;
+      _torque = _data.rotationSensorChild * _wrench.body2Torque;
+    }
+    else
+    {
+      _force = _data.rotationSensorChild * (-1*_wrench.body2Force);
+      _torque = _data.rotationSensorChild * (-1*_wrench.body2Torque);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 void ForceTorqueSensor::Load(const std::string &_worldName,
                              sdf::ElementPtr _sdf)
@@ -145,6 +212,17 @@ void ForceTorqueSensor::Load(const std::string &_worldName,
   {
     this->dataPtr->parentToChild = defaultDirectionIsParentToChild;
   }
+
+  // Gazebo specific opt-in
+  if (forceTorqueElem->HasElement("filter_cutoff"))
+  {
+    this->SetFilterCutoff(forceTorqueElem->Get<double>("filter_cutoff"));
+  }
+  if (forceTorqueElem->HasElement("buffer_size"))
+  {
+    this->SetBufferSize(
+        forceTorqueElem->Get<unsigned int>("buffer_size"));
+  }
 }
 
 //////////////////////////////////////////////////
@@ -166,19 +244,29 @@ void ForceTorqueSensor::Load(const std::string &_worldName)
 
   this->dataPtr->wrenchPub =
     this->node->Advertise<msgs::WrenchStamped>(this->Topic());
+  this->dataPtr->batchPub =
+    this->node->Advertise<msgs::WrenchStamped_V>(this->BatchTopic());
 }
 
 //////////////////////////////////////////////////
 void ForceTorqueSensor::Init()
 {
   Sensor::Init();
+  this->dataPtr->parentJoint->AddFeedbackSubscriber();
   this->dataPtr->parentJoint->SetProvideFeedback(true);
 }
 
 //////////////////////////////////////////////////
 void ForceTorqueSensor::Fini()
 {
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->worldUpdateConnection.reset();
+  }
   this->dataPtr->wrenchPub.reset();
+  this->dataPtr->batchPub.reset();
+  if (this->dataPtr->parentJoint)
+    this->dataPtr->parentJoint->RemoveFeedbackSubscriber();
   this->dataPtr->parentJoint.reset();
 
   Sensor::Fini();
@@ -203,69 +291,167 @@ ignition::math::Vector3d ForceTorqueSensor::Torque() const
 }
 
 //////////////////////////////////////////////////
-bool ForceTorqueSensor::UpdateImpl(const bool /*_force*/)
+void ForceTorqueSensor::SetBufferSize(const unsigned int _size)
 {
-  IGN_PROFILE("ForceTorqueSensor::UpdateImpl");
-  IGN_PROFILE_BEGIN("Update");
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->samples.assign(_size, ForceTorqueSensorPrivate::Sample());
+  this->dataPtr->sampleStart = 0;
+  this->dataPtr->sampleCount = 0;
+  this->dataPtr->filterPrimed = false;
+  this->dataPtr->batchMsg.Clear();
 
+  if (_size == 0)
+  {
+    this->dataPtr->worldUpdateConnection.reset();
+  }
+  else if (!this->dataPtr->worldUpdateConnection)
+  {
+    this->dataPtr->worldUpdateConnection =
+      event::Events::ConnectWorldUpdateEnd(
+          std::bind(&ForceTorqueSensor::OnWorldUpdateEnd, this));
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int ForceTorqueSensor::BufferSize() const
+{
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->samples.size();
+}
 
-  this->lastMeasurementTime = this->world->SimTime();
-  msgs::Set(this->dataPtr->wrenchMsg.mutable_time(),
-      this->lastMeasurementTime);
+//////////////////////////////////////////////////
+void ForceTorqueSensor::SetFilterCutoff(const double _cutoff)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->filterCutoff = std::max(_cutoff, 0.0);
+  this->dataPtr->filterPrimed = false;
+}
 
-  physics::JointWrench wrench = this->dataPtr->parentJoint->GetForceTorque(0u);
+//////////////////////////////////////////////////
+double ForceTorqueSensor::FilterCutoff() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->filterCutoff;
+}
 
-  // Get the force and torque in the appropriate frame.
-  ignition::math::Vector3d measuredForce;
-  ignition::math::Vector3d measuredTorque;
+//////////////////////////////////////////////////
+msgs::WrenchStamped_V ForceTorqueSensor::Samples() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->batchMsg;
+}
 
-  if (this->dataPtr->measureFrame == ForceTorqueSensorPrivate::PARENT_LINK)
+//////////////////////////////////////////////////
+uint64_t ForceTorqueSensor::DroppedSamples() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->droppedSamples;
+}
+
+//////////////////////////////////////////////////
+void ForceTorqueSensor::OnWorldUpdateEnd()
+{
+  // The event fires for every world, sample once per step of this one
+  const uint64_t iteration = this->world->Iterations();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->samples.empty() || !this->dataPtr->parentJoint ||
+      iteration == this->dataPtr->lastSampleIteration)
   {
-    if (this->dataPtr->parentToChild)
-    {
-      measuredForce = wrench.body1Force;
-      measuredTorque = wrench.body1Torque;
-    }
-    else
-    {
-      measuredForce = -1*wrench.body1Force;
-      measuredTorque = -1*wrench.body1Torque;
-    }
+    return;
   }
-  else if (this->dataPtr->measureFrame == ForceTorqueSensorPrivate::CHILD_LINK)
+  this->dataPtr->lastSampleIteration = iteration;
+
+  ForceTorqueSensorPrivate::Sample sample;
+  sample.time = this->world->SimTime();
+  MeasureWrench(*this->dataPtr,
+      this->dataPtr->parentJoint->GetForceTorque(0u), sample.force,
+      sample.torque);
+
+  if (this->dataPtr->filterCutoff > 0)
   {
-    if (!this->dataPtr->parentToChild)
+    ForceTorqueSensorPrivate::Sample &filtered = this->dataPtr->filtered;
+    const double dt = (sample.time - filtered.time).Double();
+    if (this->dataPtr->filterPrimed && dt > 0)
     {
-      measuredForce = wrench.body2Force;
-      measuredTorque = wrench.body2Torque;
+      // Exact discretization of a first order low pass filter
+      const double alpha =
+        1.0 - std::exp(-2.0 * IGN_PI * this->dataPtr->filterCutoff * dt);
+      filtered.force += (sample.force - filtered.force) * alpha;
+      filtered.torque += (sample.torque - filtered.torque) * alpha;
     }
     else
     {
-      measuredForce = -1*wrench.body2Force;
-      measuredTorque = -1*wrench.body2Torque;
+      // The first step, or time went back after a reset
+      filtered.force = sample.force;
+      filtered.torque = sample.torque;
+      this->dataPtr->filterPrimed = true;
     }
+    filtered.time = sample.time;
+    sample = filtered;
   }
-  else
+
+  const size_t capacity = this->dataPtr->samples.size();
+  if (this->dataPtr->sampleCount == capacity)
   {
-    GZ_ASSERT(this->dataPtr->measureFrame == ForceTorqueSensorPrivate::SENSOR,
-        "measureFrame must be PARENT_LINK, CHILD_LINK or SENSOR");
+    this->dataPtr->sampleStart = (this->dataPtr->sampleStart + 1) % capacity;
+    --this->dataPtr->sampleCount;
+    ++this->dataPtr->droppedSamples;
+  }
+  this->dataPtr->samples[(this->dataPtr->sampleStart +
+      this->dataPtr->sampleCount) % capacity] = sample;
+  ++this->dataPtr->sampleCount;
+}
 
-    if (!this->dataPtr->parentToChild)
-    {
-      measuredForce = this->dataPtr->rotationSensorChild *
-        wrench.body2Force;
-      measuredTorque = this->dataPtr->rotationSensorChild *
-        wrench.body2Torque;
-    }
-    else
+//////////////////////////////////////////////////
+bool ForceTorqueSensor::UpdateImpl(const bool /*_force*/)
+{
+  IGN_PROFILE("ForceTorqueSensor::UpdateImpl");
+  IGN_PROFILE_BEGIN("Update");
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Get the force and torque in the appropriate frame.
+  ignition::math::Vector3d measuredForce;
+  ignition::math::Vector3d measuredTorque;
+
+  const bool buffered = !this->dataPtr->samples.empty();
+  if (buffered)
+  {
+    // Move the samples since the last update to the batch, the latest one
+    // is the measure of this update.
+    this->dataPtr->batchMsg.Clear();
+    const size_t capacity = this->dataPtr->samples.size();
+    for (size_t i = 0; i < this->dataPtr->sampleCount; ++i)
     {
-      measuredForce = this->dataPtr->rotationSensorChild *
-        (-1*wrench.body2Force);
-      measuredTorque = this->dataPtr->rotationSensorChild *
-        (-1*wrench.body2Torque);
+      const ForceTorqueSensorPrivate::Sample &sample =
+        this->dataPtr->samples[(this->dataPtr->sampleStart + i) % capacity];
+      msgs::WrenchStamped *msg = this->dataPtr->batchMsg.add_wrench();
+      msgs::Set(msg->mutable_time(), sample.time);
+      msgs::Set(msg->mutable_wrench()->mutable_force(), sample.force);
+      msgs::Set(msg->mutable_wrench()->mutable_torque(), sample.torque);
     }
+    this->dataPtr->sampleStart = 0;
+    this->dataPtr->sampleCount = 0;
+  }
+
+  if (buffered && this->dataPtr->batchMsg.wrench_size() > 0)
+  {
+    const msgs::WrenchStamped &latest = this->dataPtr->batchMsg.wrench(
+        this->dataPtr->batchMsg.wrench_size() - 1);
+    this->lastMeasurementTime = msgs::Convert(latest.time());
+    measuredForce = msgs::ConvertIgn(latest.wrench().force());
+    measuredTorque = msgs::ConvertIgn(latest.wrench().torque());
   }
+  else
+  {
+    this->lastMeasurementTime = this->world->SimTime();
+    MeasureWrench(*this->dataPtr,
+        this->dataPtr->parentJoint->GetForceTorque(0u), measuredForce,
+        measuredTorque);
+  }
+  msgs::Set(this->dataPtr->wrenchMsg.mutable_time(),
+      this->lastMeasurementTime);
 
   IGN_PROFILE_END();
   IGN_PROFILE_BEGIN("Publish");
@@ -279,6 +465,8 @@ bool ForceTorqueSensor::UpdateImpl(const bool /*_force*/)
 
   if (this->dataPtr->wrenchPub)
     this->dataPtr->wrenchPub->Publish(this->dataPtr->wrenchMsg);
+  if (this->dataPtr->batchPub && this->dataPtr->batchMsg.wrench_size() > 0)
+    this->dataPtr->batchPub->Publish(this->dataPtr->batchMsg);
   IGN_PROFILE_END();
 
   return true;
@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_SENSORS_FORCETORQUESENSOR_HH_
 #define _GAZEBO_SENSORS_FORCETORQUESENSOR_HH_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -41,6 +42,14 @@ namespace gazebo
 
     /// \class ForceTorqueSensor ForceTorqueSensor.hh sensors/sensors.hh
     /// \brief Sensor for measure force and torque on a joint.
+    ///
+    /// By default the sensor reads the joint wrench once per update. With a
+    /// buffer, it samples the wrench at every physics step instead, and each
+    /// update publishes the samples since the previous one as a
+    /// msgs::WrenchStamped_V on BatchTopic(). This keeps a 1 kHz signal
+    /// while the sensor updates at a much lower rate. The samples can go
+    /// through a first order low pass filter. The buffer and the filter are
+    /// set with <buffer_size> and <filter_cutoff> in <force_torque>.
     class GZ_SENSORS_VISIBLE ForceTorqueSensor: public Sensor
     {
       /// \brief Constructor.
@@ -61,6 +70,41 @@ namespace gazebo
       // Documentation inherited.
       public: virtual std::string Topic() const;
 
+      /// \brief Get the topic of the batches of samples.
+      /// \return Topic() followed by /batch.
+      public: std::string BatchTopic() const;
+
+      /// \brief Set the number of physics steps buffered between two
+      /// updates. When more steps run between two updates, the oldest
+      /// samples are dropped.
+      /// \param[in] _size Number of samples, 0 reads the joint once per
+      /// update.
+      public: void SetBufferSize(const unsigned int _size);
+
+      /// \brief Get the number of physics steps buffered between two
+      /// updates.
+      /// \return Number of samples, 0 if samples are not buffered.
+      public: unsigned int BufferSize() const;
+
+      /// \brief Set the cutoff frequency of the low pass filter applied to
+      /// the buffered samples.
+      /// \param[in] _cutoff Cutoff frequency in Hz, 0 disables the filter.
+      public: void SetFilterCutoff(const double _cutoff);
+
+      /// \brief Get the cutoff frequency of the low pass filter.
+      /// \return Cutoff frequency in Hz, 0 if the filter is disabled.
+      public: double FilterCutoff() const;
+
+      /// \brief Get the samples published by the last update, oldest
+      /// first.
+      /// \return The samples, empty if samples are not buffered.
+      public: msgs::WrenchStamped_V Samples() const;
+
+      /// \brief Get the number of samples dropped because the buffer was
+      /// full.
+      /// \return Number of samples.
+      public: uint64_t DroppedSamples() const;
+
       /// \brief Get the current joint torque.
       /// \return The latest measured torque.
       public: ignition::math::Vector3d Torque() const;
@@ -88,6 +132,9 @@ namespace gazebo
       // Documentation inherited.
       protected: virtual void Fini();
 
+      /// \brief Sample the joint wrench at the end of a physics step.
+      private: void OnWorldUpdateEnd();
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<ForceTorqueSensorPrivate> dataPtr;
@@ -17,8 +17,14 @@
 #ifndef _GAZEBO_SENSORS_FORCETORQUESENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_FORCETORQUESENSOR_PRIVATE_HH_
 
+#include <cstdint>
+#include <limits>
 #include <mutex>
+#include <vector>
 #include <ignition/math/Matrix3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Time.hh"
 
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/transport/TransportTypes.hh"
@@ -66,6 +72,53 @@ namespace gazebo
       ///        orientation in a vector expressed in joint orientation.
       ///        Necessary is the measure is specified in joint frame.
       public: ignition::math::Matrix3d rotationSensorChild;
+
+      /// \brief Wrench sampled at the end of a physics step.
+      public: struct Sample
+      {
+        /// \brief Simulation time of the step.
+        common::Time time;
+
+        /// \brief Measured force.
+        ignition::math::Vector3d force;
+
+        /// \brief Measured torque.
+        ignition::math::Vector3d torque;
+      };
+
+      /// \brief Ring buffer of samples, bufferSize long.
+      public: std::vector<Sample> samples;
+
+      /// \brief Index of the oldest sample in the ring buffer.
+      public: size_t sampleStart = 0;
+
+      /// \brief Number of samples in the ring buffer.
+      public: size_t sampleCount = 0;
+
+      /// \brief Number of samples dropped because the buffer was full.
+      public: uint64_t droppedSamples = 0;
+
+      /// \brief Cutoff frequency of the low pass filter, 0 if disabled.
+      public: double filterCutoff = 0;
+
+      /// \brief Output of the low pass filter.
+      public: Sample filtered;
+
+      /// \brief True once the low pass filter has an output.
+      public: bool filterPrimed = false;
+
+      /// \brief World iteration of the last sample.
+      public: uint64_t lastSampleIteration =
+              std::numeric_limits<uint64_t>::max();
+
+      /// \brief Samples on every physics step while buffering.
+      public: event::ConnectionPtr worldUpdateConnection;
+
+      /// \brief Publishes the batches of samples.
+      public: transport::PublisherPtr batchPub;
+
+      /// \brief Samples published by the last update.
+      public: msgs::WrenchStamped_V batchMsg;
     };
   }
 }
@@ -25,6 +25,7 @@ class ForceTorqueSensor_TEST : public ServerFixture,
                                public testing::WithParamInterface<const char*>
 {
     public: void ForceTorqueTest(const std::string &_physicsEngine);
+    public: void BufferTest(const std::string &_physicsEngine);
 };
 
 static std::string forceTorqueSensorString =
@@ -76,12 +77,91 @@ void ForceTorqueSensor_TEST::ForceTorqueTest(const std::string &_physicsEngine)
   EXPECT_TRUE(sensor->IsActive());
 }
 
+/////////////////////////////////////////////////
+/// \brief Buffer the wrench of every physics step between two updates
+void ForceTorqueSensor_TEST::BufferTest(const std::string &_physicsEngine)
+{
+  Load("worlds/pioneer2dx.world", true, _physicsEngine);
+
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+
+  // A low rate, so only forced updates run during the test
+  const std::string sensorString =
+    "<sdf version='1.4'>"
+    "  <sensor name='force_torque' type='force_torque'>"
+    "    <update_rate>0.1</update_rate>"
+    "    <always_on>true</always_on>"
+    "    <force_torque>"
+    "      <buffer_size>100</buffer_size>"
+    "    </force_torque>"
+    "  </sensor>"
+    "</sdf>";
+  sdf::ElementPtr sdf(new sdf::Element);
+  sdf::initFile("sensor.sdf", sdf);
+  sdf::readString(sensorString, sdf);
+
+  physics::WorldPtr world = physics::get_world("default");
+  physics::ModelPtr model = world->ModelByName("pioneer2dx");
+  physics::JointPtr joint = model->GetJoint("left_wheel_hinge");
+
+  std::string sensorName = mgr->CreateSensor(sdf, "default",
+      "pioneer2dx::left_wheel_hinge", joint->GetId());
+  mgr->Update();
+
+  sensors::ForceTorqueSensorPtr sensor =
+    std::dynamic_pointer_cast<sensors::ForceTorqueSensor>(
+        mgr->GetSensor(sensorName));
+  ASSERT_TRUE(sensor != nullptr);
+
+  // The sdf opt-in may be dropped by the parser, set it again
+  sensor->SetBufferSize(100);
+  EXPECT_EQ(100u, sensor->BufferSize());
+  EXPECT_DOUBLE_EQ(0.0, sensor->FilterCutoff());
+
+  // One sample per step, in order, the latest is the measure
+  world->Step(10);
+  sensor->Update(true);
+  msgs::WrenchStamped_V samples = sensor->Samples();
+  ASSERT_EQ(10, samples.wrench_size());
+  for (int i = 1; i < samples.wrench_size(); ++i)
+  {
+    EXPECT_LT(msgs::Convert(samples.wrench(i - 1).time()),
+        msgs::Convert(samples.wrench(i).time()));
+  }
+  EXPECT_EQ(world->SimTime(),
+      msgs::Convert(samples.wrench(samples.wrench_size() - 1).time()));
+  EXPECT_EQ(sensor->Force(), msgs::ConvertIgn(
+        samples.wrench(samples.wrench_size() - 1).wrench().force()));
+  EXPECT_EQ(0u, sensor->DroppedSamples());
+
+  // A full buffer keeps the latest samples
+  sensor->SetBufferSize(4);
+  world->Step(10);
+  sensor->Update(true);
+  samples = sensor->Samples();
+  ASSERT_EQ(4, samples.wrench_size());
+  EXPECT_EQ(world->SimTime(), msgs::Convert(samples.wrench(3).time()));
+  EXPECT_EQ(6u, sensor->DroppedSamples());
+
+  // Without a buffer, the joint is read once per update
+  sensor->SetBufferSize(0);
+  world->Step(10);
+  sensor->Update(true);
+  EXPECT_EQ(0, sensor->Samples().wrench_size());
+}
+
 /////////////////////////////////////////////////
 TEST_P(ForceTorqueSensor_TEST, ForceTorqueTest)
 {
   ForceTorqueTest(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(ForceTorqueSensor_TEST, BufferTest)
+{
+  BufferTest(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines,
                         ForceTorqueSensor_TEST,
                         PHYSICS_ENGINE_VALUES,);  // NOLINT
@@ -14,13 +14,17 @@
  * limitations under the License.
  *
 */
+#include <functional>
+#include <vector>
+
 #include <ignition/math/Helpers.hh>
-#include <ignition/math/Rand.hh>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/DepthCamera.hh"
+#include "gazebo/rendering/GpuLaser.hh"
 #include "gazebo/sensors/GaussianNoiseModel.hh"
 
 namespace gazebo
@@ -31,9 +35,14 @@ namespace gazebo
     : public Ogre::CompositorInstance::Listener
   {
     /// \brief Constructor, setting mean and standard deviation.
+    /// \param[in] _mean Mean.
+    /// \param[in] _stddev Standard deviation.
+    /// \param[in] _uniform Draws uniform values in [0, 1) from the stream
+    /// of the noise model.
     public: GaussianNoiseCompositorListener(const double &_mean,
-                                            const double &_stddev):
-        mean(_mean), stddev(_stddev) {}
+                                            const double &_stddev,
+                                            std::function<double ()> _uniform):
+        mean(_mean), stddev(_stddev), uniform(_uniform) {}
 
     /// \brief Callback that OGRE will invoke for us on each render call
     /// \param[in] _passID OGRE material pass ID.
@@ -48,9 +57,8 @@ namespace gazebo
       // Sample three values within the range [0,1.0] and set them for use in
       // the fragment shader, which will interpret them as offsets from (0,0)
       // to use when computing pseudo-random values.
-      Ogre::Vector3 offsets(ignition::math::Rand::DblUniform(0.0, 1.0),
-                            ignition::math::Rand::DblUniform(0.0, 1.0),
-                            ignition::math::Rand::DblUniform(0.0, 1.0));
+      Ogre::Vector3 offsets(this->uniform(), this->uniform(),
+                            this->uniform());
       // These calls are setting parameters that are declared in two places:
       // 1. media/materials/scripts/gazebo.material, in
       //    fragment_program Gazebo/GaussianCameraNoiseFS
@@ -73,6 +81,9 @@ namespace gazebo
     /// \brief Standard deviation that we'll pass down to the GLSL fragment
     /// shader.
     private: const double &stddev;
+
+    /// \brief Draws uniform values of the noise model.
+    private: std::function<double ()> uniform;
   };
 }  // namespace gazebo
 
@@ -148,7 +159,7 @@ void GaussianNoiseModel::Fini()
 double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
 {
   // Add independent (uncorrelated) Gaussian noise to each input value.
-  double whiteNoise = ignition::math::Rand::DblNormal(this->mean, this->stdDev);
+  double whiteNoise = this->mean + this->stdDev * this->Normal();
 
   // Generate varying (correlated) bias for each input value.
   // This implementation is based on the one available in Rotors:
@@ -158,19 +169,7 @@ double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
   //
   //  https://github.com/ethz-asl/kalibr/wiki/IMU-Noise-Model
   //
-  if (this->dynamicBiasStdDev > 0 &&
-      this->dynamicBiasCorrTime > 0)
-  {
-    const double sigmaB = this->dynamicBiasStdDev;
-    const double tau = this->dynamicBiasCorrTime;
-
-    const double sigmaBD = sqrt(-sigmaB * sigmaB *
-        tau / 2 * expm1(-2 * _dt / tau));
-
-    const double phiD = exp(-_dt / tau);
-    this->bias = phiD * this->bias +
-      ignition::math::Rand::DblNormal(0, sigmaBD);
-  }
+  this->UpdateDynamicBias(_dt);
 
   double output = _in + this->bias + whiteNoise;
   if (this->quantized)
@@ -184,6 +183,54 @@ double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
   return output;
 }
 
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyBatchImpl(double *_values, const size_t _count,
+    const double _dt)
+{
+  // The dynamic bias walks once per value, so it cannot be batched
+  if (this->dynamicBiasStdDev > 0 && this->dynamicBiasCorrTime > 0)
+  {
+    Noise::ApplyBatchImpl(_values, _count, _dt);
+    return;
+  }
+
+  // Draw the white noise in blocks, then add it in a loop that vectorizes
+  static thread_local std::vector<double> whiteNoise;
+  whiteNoise.resize(_count);
+  this->Normals(whiteNoise.data(), _count);
+
+  const double offset = this->mean + this->bias;
+  for (size_t i = 0; i < _count; ++i)
+    _values[i] += offset + this->stdDev * whiteNoise[i];
+
+  if (this->quantized &&
+      !ignition::math::equal(this->precision, 0.0, 1e-6))
+  {
+    for (size_t i = 0; i < _count; ++i)
+    {
+      _values[i] = std::round(_values[i] / this->precision) *
+        this->precision;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::UpdateDynamicBias(const double _dt)
+{
+  if (this->dynamicBiasStdDev > 0 &&
+      this->dynamicBiasCorrTime > 0)
+  {
+    const double sigmaB = this->dynamicBiasStdDev;
+    const double tau = this->dynamicBiasCorrTime;
+
+    const double sigmaBD = sqrt(-sigmaB * sigmaB *
+        tau / 2 * expm1(-2 * _dt / tau));
+
+    const double phiD = exp(-_dt / tau);
+    this->bias = phiD * this->bias + sigmaBD * this->Normal();
+  }
+}
+
 //////////////////////////////////////////////////
 double GaussianNoiseModel::GetMean() const
 {
@@ -221,12 +268,11 @@ void GaussianNoiseModel::SampleBias()
 {
   if(!ignition::math::equal(0.0, this->biasStdDev, 1e-6))
   {
-    this->bias =
-        ignition::math::Rand::DblNormal(this->biasMean, this->biasStdDev);
+    this->bias = this->biasMean + this->biasStdDev * this->Normal();
     // With equal probability, we pick a negative bias (by convention,
     // rateBiasMean should be positive, though it would work fine if
     // negative).
-    if (ignition::math::Rand::DblUniform() < 0.5)
+    if (this->Uniform() < 0.5)
       this->bias = -this->bias;
   }
 }
@@ -266,7 +312,8 @@ void ImageGaussianNoiseModel::SetCamera(rendering::CameraPtr _camera)
   GZ_ASSERT(_camera, "Unable to apply gaussian noise, camera is null");
 
   this->gaussianNoiseCompositorListener.reset(new
-        GaussianNoiseCompositorListener(this->mean, this->stdDev));
+        GaussianNoiseCompositorListener(this->mean, this->stdDev,
+          [this]() {return this->Uniform();}));
 
   this->gaussianNoiseInstance =
     Ogre::CompositorManager::getSingleton().addCompositor(
@@ -291,3 +338,86 @@ void ImageGaussianNoiseModel::Print(std::ostream &_out) const
     << "precision[" << this->precision << "] "
     << "quantized[" << this->quantized << "]";
 }
+
+//////////////////////////////////////////////////
+RangeGaussianNoiseModel::RangeGaussianNoiseModel()
+  : GaussianNoiseModel()
+{
+}
+
+//////////////////////////////////////////////////
+RangeGaussianNoiseModel::~RangeGaussianNoiseModel()
+{
+}
+
+//////////////////////////////////////////////////
+void RangeGaussianNoiseModel::Load(sdf::ElementPtr _sdf)
+{
+  GaussianNoiseModel::Load(_sdf);
+
+  // Gazebo specific opt-in
+  if (_sdf->HasElement("range_stddev"))
+    this->rangeStdDev = _sdf->Get<double>("range_stddev");
+  if (_sdf->HasElement("dropout"))
+    this->dropout = _sdf->Get<double>("dropout");
+  if (_sdf->HasElement("range_dropout"))
+    this->rangeDropout = _sdf->Get<double>("range_dropout");
+
+  if (this->GetDynamicBiasStdDev() > 0 &&
+      this->GetDynamicBiasCorrelationTime() > 0)
+  {
+    gzwarn << "The dynamic bias of range noise is not supported, "
+      << "only the initial bias is applied" << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+void RangeGaussianNoiseModel::SetCamera(rendering::CameraPtr _camera)
+{
+  GZ_ASSERT(_camera, "Unable to apply range noise, camera is null");
+
+  if (auto depthCamera =
+      boost::dynamic_pointer_cast<rendering::DepthCamera>(_camera))
+  {
+    depthCamera->SetRangeNoise(this->ShaderNoise());
+  }
+  else if (auto gpuLaser =
+      boost::dynamic_pointer_cast<rendering::GpuLaser>(_camera))
+  {
+    gpuLaser->SetRangeNoise(this->ShaderNoise());
+  }
+  else
+  {
+    gzerr << "Range noise needs a depth camera or a GPU laser" << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+rendering::RangeNoise RangeGaussianNoiseModel::ShaderNoise()
+{
+  rendering::RangeNoise noise;
+  noise.mean = this->mean + this->bias;
+  noise.stdDev = this->stdDev;
+  noise.rangeStdDev = this->rangeStdDev;
+  noise.dropout = this->dropout;
+  noise.rangeDropout = this->rangeDropout;
+  if (this->quantized)
+    noise.precision = this->precision;
+
+  // The shaders draw their offsets from the stream of this noise model,
+  // which the sensor keeps alive as long as its camera.
+  noise.uniform = [this]() {return this->Uniform();};
+  return noise;
+}
+
+//////////////////////////////////////////////////
+void RangeGaussianNoiseModel::Print(std::ostream &_out) const
+{
+  _out << "Range Gaussian noise, mean[" << this->mean << "], "
+    << "stdDev[" << this->stdDev << "] "
+    << "bias[" << this->bias << "] "
+    << "precision[" << this->precision << "] "
+    << "rangeStdDev[" << this->rangeStdDev << "] "
+    << "dropout[" << this->dropout << "] "
+    << "rangeDropout[" << this->rangeDropout << "]";
+}
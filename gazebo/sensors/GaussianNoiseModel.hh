@@ -23,6 +23,7 @@
 
 #include <sdf/sdf.hh>
 
+#include "gazebo/rendering/RangeNoise.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/sensors/Noise.hh"
 #include "gazebo/util/system.hh"
@@ -57,6 +58,10 @@ namespace gazebo
         // Documentation inherited.
         public: double ApplyImpl(double _in, double _dt);
 
+        // Documentation inherited.
+        public: virtual void ApplyBatchImpl(double *_values,
+                    const size_t _count, const double _dt);
+
         /// \brief Accessor for mean.
         /// \return Mean of Gaussian noise.
         public: double GetMean() const;
@@ -99,6 +104,10 @@ namespace gazebo
         /// \brief Sample the bias.
         private: void SampleBias();
 
+        /// \brief Step the dynamic bias process.
+        /// \param[in] _dt Time step.
+        private: void UpdateDynamicBias(const double _dt);
+
         /// \brief If type starts with GAUSSIAN, the mean of the distribution
         /// from which we sample when adding noise.
         protected: double mean;
@@ -163,6 +172,49 @@ namespace gazebo
       public: boost::shared_ptr<GaussianNoiseCompositorListener>
         gaussianNoiseCompositorListener;
     };
+
+    /// \class RangeGaussianNoiseModel
+    /// \brief Gaussian noise class for the ranges of depth cameras and GPU
+    /// ray sensors. The noise is added by the shaders that render the
+    /// ranges, so the readback is already noisy.
+    ///
+    /// On top of the Gaussian parameters, the optional range_stddev,
+    /// dropout and range_dropout elements make the standard deviation and
+    /// the probability of dropping a reading grow with the range, see
+    /// rendering::RangeNoise. The dynamic bias is not supported.
+    class GZ_SENSORS_VISIBLE RangeGaussianNoiseModel : public GaussianNoiseModel
+    {
+      /// \brief Constructor.
+      public: RangeGaussianNoiseModel();
+
+      /// \brief Destructor.
+      public: virtual ~RangeGaussianNoiseModel();
+
+      // Documentation inherited.
+      public: virtual void Load(sdf::ElementPtr _sdf);
+
+      /// \brief Pass the noise to the shaders of the camera, which must be
+      /// a rendering::DepthCamera or a rendering::GpuLaser.
+      /// \param[in] _camera Camera associated to the sensor.
+      public: virtual void SetCamera(rendering::CameraPtr _camera);
+
+      /// \brief Get the parameters of the shader noise.
+      /// \return Noise parameters.
+      public: rendering::RangeNoise ShaderNoise();
+
+      /// Documentation inherited
+      public: virtual void Print(std::ostream &_out) const;
+
+      /// \brief Standard deviation added per meter of range.
+      private: double rangeStdDev = 0.0;
+
+      /// \brief Probability of dropping a reading.
+      private: double dropout = 0.0;
+
+      /// \brief Probability of dropping a reading added per meter of
+      /// range.
+      private: double rangeDropout = 0.0;
+    };
     /// \}
   }
 }
@@ -16,8 +16,7 @@
 */
 #include <boost/algorithm/string.hpp>
 
-#include <ignition/common/Profiler.hh>
-
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/sensors/SensorFactory.hh"
 
 #include "gazebo/common/common.hh"
@@ -61,6 +60,9 @@ void GpsSensor::Load(const std::string &_worldName)
   this->dataPtr->parentLink =
     boost::dynamic_pointer_cast<physics::Link>(parentEntity);
 
+  // Read the parent link through consistent per step snapshots
+  this->world->SetSnapshotsEnabled(true);
+
   this->dataPtr->lastGpsMsg.set_link_name(this->ParentName());
 
   this->dataPtr->topicName = "~/" + this->ParentName() + '/' + this->Name();
@@ -131,11 +133,13 @@ bool GpsSensor::UpdateImpl(const bool /*_force*/)
   // Get latest pose information
   if (this->dataPtr->parentLink)
   {
+    physics::LinkSnapshot parentState =
+      this->LinkState(this->dataPtr->parentLink);
+
     // Measure position and apply noise
     {
       // Get postion in Cartesian gazebo frame
-      ignition::math::Pose3d gpsPose = this->pose +
-        this->dataPtr->parentLink->WorldPose();
+      ignition::math::Pose3d gpsPose = this->pose + parentState.pose;
 
       // Apply position noise before converting to global frame
       gpsPose.Pos().X(
@@ -159,7 +163,7 @@ bool GpsSensor::UpdateImpl(const bool /*_force*/)
     // Measure velocity and apply noise
     {
       ignition::math::Vector3d gpsVelocity =
-        this->dataPtr->parentLink->WorldLinearVel(this->pose.Pos());
+        parentState.WorldLinearVel(this->pose.Pos());
 
       // Convert to global frame
       gpsVelocity =
@@ -187,8 +191,8 @@ bool GpsSensor::UpdateImpl(const bool /*_force*/)
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("Publish");
-  if (this->dataPtr->gpsPub)
-    this->dataPtr->gpsPub->Publish(this->dataPtr->lastGpsMsg);
+  this->PublishSample(this->dataPtr->gpsPub, this->dataPtr->lastGpsMsg,
+      this->lastMeasurementTime);
   IGN_PROFILE_END();
   return true;
 }
@@ -15,10 +15,10 @@
  *
 */
 #include <boost/algorithm/string.hpp>
-#include <ignition/common/Profiler.hh>
 #include <functional>
 #include <ignition/math.hh>
 #include <ignition/math/Helpers.hh>
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Entity.hh"
 #include "gazebo/physics/Model.hh"
@@ -34,6 +34,7 @@
 #include "gazebo/rendering/RenderEngine.hh"
 #include "gazebo/rendering/GpuLaser.hh"
 
+#include "gazebo/sensors/GaussianNoiseModel.hh"
 #include "gazebo/sensors/Noise.hh"
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/sensors/GpuRaySensorPrivate.hh"
@@ -328,6 +329,12 @@ void GpuRaySensor::Init()
         this->RangeCount(),
         this->VerticalRangeCount());
     this->dataPtr->laserCam->SetClipDist(this->RangeMin(), this->RangeMax());
+
+    // Gazebo specific opt-in, renders all first pass cameras in one pass.
+    sdf::ElementPtr rayElem = this->sdf->GetElement("ray");
+    if (rayElem->HasElement("single_pass"))
+      this->dataPtr->laserCam->SetSinglePass(rayElem->Get<bool>("single_pass"));
+
     this->dataPtr->laserCam->CreateLaserTexture(
         this->ScopedName() + "_RttTex_Laser");
     this->dataPtr->laserCam->CreateRenderTexture(
@@ -335,6 +342,14 @@ void GpuRaySensor::Init()
     this->dataPtr->laserCam->SetWorldPose(this->pose);
     this->dataPtr->laserCam->AttachToVisual(this->ParentId(), true, 0, 0);
 
+    // Gaussian noise is added by the first pass shader
+    auto noiseIter = this->noises.find(GPU_RAY_NOISE);
+    if (noiseIter != this->noises.end() &&
+        std::dynamic_pointer_cast<RangeGaussianNoiseModel>(noiseIter->second))
+    {
+      noiseIter->second->SetCamera(this->dataPtr->laserCam);
+    }
+
     this->dataPtr->laserMsg.mutable_scan()->set_frame(this->ParentName());
   }
   else
@@ -741,22 +756,28 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
   if (scan->ranges_size() != numRays)
   {
     // gzdbg << "Size mismatch; allocating memory\n";
-    scan->clear_ranges();
-    scan->clear_intensities();
-    for (int i = 0; i < numRays; ++i)
-    {
-      scan->add_ranges(ignition::math::NAN_F);
-      scan->add_intensities(ignition::math::NAN_F);
-    }
+    scan->mutable_ranges()->Resize(numRays, ignition::math::NAN_D);
+    scan->mutable_intensities()->Resize(numRays, ignition::math::NAN_D);
   }
 
+  // Write the readback of the laser camera straight into the message
+  double *ranges = scan->mutable_ranges()->mutable_data();
+  double *intensities = scan->mutable_intensities()->mutable_data();
+
+  // Only custom noise is left to apply on the CPU, Gaussian noise is
+  // already in the readback.
+  auto noiseIter = this->noises.find(GPU_RAY_NOISE);
+  NoisePtr noise = noiseIter != this->noises.end() ? noiseIter->second :
+      NoisePtr();
+  if (noise && noise->GetNoiseType() != Noise::CUSTOM)
+    noise.reset();
+
   auto dataIter = this->dataPtr->laserCam->LaserDataBegin();
   auto dataEnd = this->dataPtr->laserCam->LaserDataEnd();
-  for (int i = 0; dataIter != dataEnd; ++dataIter, ++i)
+  for (int i = 0; dataIter != dataEnd && i < numRays; ++dataIter, ++i)
   {
     const rendering::GpuLaserData data = *dataIter;
     double range = data.range;
-    double intensity = data.intensity;
 
     // Mask ranges outside of min/max to +/- inf, as per REP 117
     if (range >= this->dataPtr->rangeMax)
@@ -767,16 +788,15 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
     {
       range = -ignition::math::INF_D;
     }
-    else if (this->noises.find(GPU_RAY_NOISE) != this->noises.end())
+    else if (noise)
     {
-      range = this->noises[GPU_RAY_NOISE]->Apply(range);
+      range = noise->Apply(range);
       range = ignition::math::clamp(range,
           this->dataPtr->rangeMin, this->dataPtr->rangeMax);
     }
 
-    range = ignition::math::isnan(range) ? this->dataPtr->rangeMax : range;
-    scan->set_ranges(i, range);
-    scan->set_intensities(i, intensity);
+    ranges[i] = ignition::math::isnan(range) ? this->dataPtr->rangeMax : range;
+    intensities[i] = data.intensity;
   }
 
   if (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
@@ -794,6 +814,15 @@ bool GpuRaySensor::IsActive() const
     (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections());
 }
 
+//////////////////////////////////////////////////
+bool GpuRaySensor::HasConsumers() const
+{
+  return Sensor::HasConsumers() ||
+    (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections()) ||
+    (this->dataPtr->laserCam &&
+     this->dataPtr->laserCam->FrameListenerCount() > 0);
+}
+
 //////////////////////////////////////////////////
 rendering::GpuLaserPtr GpuRaySensor::LaserCamera() const
 {
@@ -15,14 +15,15 @@
  *
 */
 #include <boost/algorithm/string.hpp>
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Rand.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publisher.hh"
 
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 
 #include "gazebo/sensors/Noise.hh"
@@ -40,10 +41,6 @@ ImuSensor::ImuSensor()
 : Sensor(sensors::OTHER),
   dataPtr(new ImuSensorPrivate)
 {
-  this->dataPtr->dataIndex = 0;
-  this->dataPtr->dataDirty = false;
-  this->dataPtr->incomingLinkData[0].reset();
-  this->dataPtr->incomingLinkData[1].reset();
 }
 
 //////////////////////////////////////////////////
@@ -184,12 +181,8 @@ void ImuSensor::Load(const std::string &_worldName, sdf::ElementPtr _sdf)
     gzlog << out.str();
   }
 
-  // Start publishing measurements on the topic.
-  this->dataPtr->parentEntity->SetPublishData(true);
-
-  std::string topic = "~/" + this->dataPtr->parentEntity->GetScopedName();
-  this->dataPtr->linkDataSub = this->node->Subscribe(topic,
-    &ImuSensor::OnLinkData, this);
+  // The state of the parent link comes from the world snapshots
+  this->world->SetSnapshotsEnabled(true);
 }
 
 //////////////////////////////////////////////////
@@ -226,18 +219,9 @@ void ImuSensor::Init()
 void ImuSensor::Fini()
 {
   // Clean transport
-  {
-    this->dataPtr->pub.reset();
-    this->dataPtr->linkDataSub.reset();
-  }
-
-  if (this->dataPtr->parentEntity)
-    this->dataPtr->parentEntity->SetPublishData(false);
+  this->dataPtr->pub.reset();
   this->dataPtr->parentEntity.reset();
 
-  this->dataPtr->incomingLinkData[0].reset();
-  this->dataPtr->incomingLinkData[1].reset();
-
   Sensor::Fini();
 }
 
@@ -248,15 +232,6 @@ msgs::IMU ImuSensor::ImuMessage() const
   return this->dataPtr->imuMsg;
 }
 
-//////////////////////////////////////////////////
-void ImuSensor::OnLinkData(ConstLinkDataPtr &_msg)
-{
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  // Store the contacts message for processing in UpdateImpl
-  this->dataPtr->incomingLinkData[this->dataPtr->dataIndex] = _msg;
-  this->dataPtr->dataDirty = true;
-}
-
 //////////////////////////////////////////////////
 ignition::math::Vector3d ImuSensor::AngularVelocity(const bool _noiseFree) const
 {
@@ -303,25 +278,21 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
 {
   IGN_PROFILE("ImuSensor::UpdateImpl");
   IGN_PROFILE_BEGIN("Update");
-  msgs::LinkData msg;
-  int readIndex = 0;
+  physics::WorldSnapshotPtr snapshot = this->Snapshot();
+  if (!snapshot || !this->dataPtr->parentEntity)
+    return false;
 
-  {
-    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-    // Don't do anything if there is no new data to process.
-    if (!this->dataPtr->dataDirty)
-      return false;
-
-    readIndex = this->dataPtr->dataIndex;
-    this->dataPtr->dataIndex ^= 1;
-    this->dataPtr->dataDirty = false;
-  }
+  // Don't do anything if there is no new data to process.
+  if (snapshot->Iterations() == this->dataPtr->lastIterations)
+    return false;
 
-  // toggle the index
-  msg.CopyFrom(*this->dataPtr->incomingLinkData[readIndex].get());
+  const physics::LinkSnapshot *linkState =
+    snapshot->Link(this->dataPtr->parentEntity->GetId());
+  if (!linkState)
+    return false;
+  this->dataPtr->lastIterations = snapshot->Iterations();
 
-  common::Time timestamp = msgs::Convert(msg.time());
+  common::Time timestamp = snapshot->SimTime();
 
   double dt = (timestamp - this->lastMeasurementTime).Double();
 
@@ -337,13 +308,11 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
 
     msgs::Set(this->dataPtr->imuMsg.mutable_stamp(), timestamp);
 
-    ignition::math::Pose3d parentEntityPose =
-      this->dataPtr->parentEntity->WorldPose();
+    ignition::math::Pose3d parentEntityPose = linkState->pose;
     ignition::math::Pose3d imuWorldPose = this->pose + parentEntityPose;
 
     // Get the angular velocity
-    ignition::math::Vector3d linkWorldAngularVel = msgs::ConvertIgn(
-        msg.angular_velocity());
+    ignition::math::Vector3d linkWorldAngularVel = linkState->angularVel;
 
     /////////////////////////////////////////////////////////////////////
     // Set the IMU angular velocity (defined in imu's local frame)
@@ -356,14 +325,10 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
     /////////////////////////////////////////////////////////////////////
     // Compute and set the IMU linear acceleration in the imu local frame
     /////////////////////////////////////////////////////////////////////
-    // first get imu link's linear velocity in world frame
-    ignition::math::Vector3d linkWorldLinearVel
-        = msgs::ConvertIgn(msg.linear_velocity());
-    // next, account for vel in world frame of the imu
-    // given the imu frame is offset from link frame, and link is rotating
-    // compute the velocity of the imu axis origin in world frame
-    ignition::math::Vector3d imuWorldLinearVel = linkWorldLinearVel +
-        linkWorldAngularVel.Cross(imuWorldPose.Pos() - parentEntityPose.Pos());
+    // velocity in world frame of the imu axis origin, which is offset from
+    // the link frame while the link rotates
+    ignition::math::Vector3d imuWorldLinearVel =
+      linkState->WorldLinearVel(this->pose.Pos());
     // compute acceleration by differentiating velocity in world frame,
     // and rotate into imu local frame
     this->dataPtr->linearAcc = imuWorldPose.Rot().Inverse().RotateVector(
@@ -437,8 +402,8 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
 
     IGN_PROFILE_BEGIN("Publish");
     // Publish the message
-    if (this->dataPtr->pub)
-      this->dataPtr->pub->Publish(this->dataPtr->imuMsg);
+    this->PublishSample(this->dataPtr->pub, this->dataPtr->imuMsg,
+        this->lastMeasurementTime);
     IGN_PROFILE_END();
   }
 
@@ -448,6 +413,5 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
 //////////////////////////////////////////////////
 bool ImuSensor::IsActive() const
 {
-  return this->active ||
-         (this->dataPtr->pub && this->dataPtr->pub->HasConnections());
+  return this->active || this->HasSampleConnections(this->dataPtr->pub);
 }
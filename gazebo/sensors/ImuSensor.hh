@@ -108,10 +108,6 @@ namespace gazebo
       public: void SetWorldToReferenceOrientation(
         const ignition::math::Quaterniond &_orientation);
 
-      /// \brief Callback when link data is received
-      /// \param[in] _msg Message containing link data
-      private: void OnLinkData(ConstLinkDataPtr &_msg);
-
       /// \internal
       /// \brief Private data pointer.
       private: std::unique_ptr<ImuSensorPrivate> dataPtr;
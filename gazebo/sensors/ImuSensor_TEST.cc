@@ -18,10 +18,14 @@
 #ifndef _WIN32
 #include <sys/time.h>
 #endif
+#include <mutex>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/test/helper_physics_generator.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 #include "gazebo/sensors/ImuSensor.hh"
 
 #define TOL 1e-4
@@ -32,6 +36,18 @@ class ImuSensor_TEST : public ServerFixture,
 {
   public: void BasicImuSensorCheck(const std::string &_physicsEngine);
   public: void LinearAccelerationTest(const std::string &_physicsEngine);
+  public: void SnapshotTest(const std::string &_physicsEngine);
+  public: void BatchTest(const std::string &_physicsEngine);
+
+  /// \brief Receive the samples of a batched topic.
+  /// \param[in] _msg Imu sample.
+  public: void OnImu(ConstIMUPtr &_msg);
+
+  /// \brief Received samples.
+  public: std::vector<msgs::IMU> samples;
+
+  /// \brief Protects samples.
+  public: std::mutex samplesMutex;
 };
 
 static std::string imuSensorString =
@@ -146,6 +162,96 @@ void ImuSensor_TEST::LinearAccelerationTest(const std::string &_physicsEngine)
   EXPECT_NEAR(imuSensor->LinearAcceleration().Z(), -gravityZ, 0.4);
 }
 
+/////////////////////////////////////////////////
+// The imu samples its link from the world snapshot given to the update
+void ImuSensor_TEST::SnapshotTest(const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  SpawnUnitImuSensor("imuModel", "imuSensor", "box", "~/imu_snapshot",
+      ignition::math::Vector3d(0, 0, 3), ignition::math::Vector3d::Zero);
+  sensors::ImuSensorPtr imuSensor =
+    std::dynamic_pointer_cast<sensors::ImuSensor>(
+        sensors::get_sensor("imuSensor"));
+  ASSERT_TRUE(imuSensor != nullptr);
+  EXPECT_TRUE(world->SnapshotsEnabled());
+
+  sensors::SensorManager::Instance()->Init();
+  imuSensor->SetActive(true);
+
+  world->Step(10);
+  physics::WorldSnapshotPtr snapshot = world->Snapshot();
+  ASSERT_TRUE(snapshot != nullptr);
+
+  imuSensor->Update(true, snapshot);
+  EXPECT_EQ(snapshot->SimTime(),
+      msgs::Convert(imuSensor->ImuMessage().stamp()));
+
+  // Free fall, the imu measures no acceleration
+  world->Step(1);
+  imuSensor->Update(true, world->Snapshot());
+  EXPECT_EQ(world->Snapshot()->SimTime(),
+      msgs::Convert(imuSensor->ImuMessage().stamp()));
+  EXPECT_NEAR(imuSensor->LinearAcceleration().Length(), 0, TOL);
+}
+
+/////////////////////////////////////////////////
+void ImuSensor_TEST::OnImu(ConstIMUPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->samplesMutex);
+  this->samples.push_back(*_msg);
+}
+
+/////////////////////////////////////////////////
+void ImuSensor_TEST::BatchTest(const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  SpawnUnitImuSensor("imuModel", "imuSensor", "box", "~/imu_batch",
+      ignition::math::Vector3d(0, 0, 3), ignition::math::Vector3d::Zero);
+  sensors::ImuSensorPtr imuSensor =
+    std::dynamic_pointer_cast<sensors::ImuSensor>(
+        sensors::get_sensor("imuSensor"));
+  ASSERT_TRUE(imuSensor != nullptr);
+  EXPECT_EQ(1u, imuSensor->BatchSize());
+  imuSensor->SetBatchSize(4);
+  EXPECT_EQ(4u, imuSensor->BatchSize());
+
+  transport::SubscriberPtr sub = this->node->SubscribeBatch(
+      "~/imu_batch", &ImuSensor_TEST::OnImu, this);
+
+  sensors::SensorManager::Instance()->Init();
+  imuSensor->SetActive(true);
+
+  // Two full batches, the samples of the next one are still pending
+  std::vector<common::Time> stamps;
+  for (int i = 0; i < 10; ++i)
+  {
+    world->Step(1);
+    imuSensor->Update(true, world->Snapshot());
+    stamps.push_back(msgs::Convert(imuSensor->ImuMessage().stamp()));
+  }
+
+  for (int i = 0; i < 100; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->samplesMutex);
+      if (this->samples.size() >= 8u)
+        break;
+    }
+    common::Time::MSleep(20);
+  }
+
+  std::lock_guard<std::mutex> lock(this->samplesMutex);
+  ASSERT_EQ(8u, this->samples.size());
+  for (size_t i = 0; i < this->samples.size(); ++i)
+    EXPECT_EQ(stamps[i], msgs::Convert(this->samples[i].stamp())) << i;
+}
+
 /////////////////////////////////////////////////
 TEST_P(ImuSensor_TEST, BasicImuSensorCheck)
 {
@@ -158,6 +264,18 @@ TEST_P(ImuSensor_TEST, LinearAccelerationTest)
   LinearAccelerationTest(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(ImuSensor_TEST, SnapshotTest)
+{
+  SnapshotTest(GetParam());
+}
+
+/////////////////////////////////////////////////
+TEST_P(ImuSensor_TEST, BatchTest)
+{
+  BatchTest(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, ImuSensor_TEST,
                         PHYSICS_ENGINE_VALUES,);  // NOLINT
 
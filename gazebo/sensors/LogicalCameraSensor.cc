@@ -14,12 +14,15 @@
  * limitations under the License.
  *
 */
+#include <cmath>
+
 #include <boost/algorithm/string.hpp>
-#include <ignition/common/Profiler.hh>
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/transport/transport.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Model.hh"
+#include "gazebo/physics/ModelBoxIndex.hh"
 
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/sensors/LogicalCameraSensorPrivate.hh"
@@ -81,6 +84,9 @@ void LogicalCameraSensor::Load(const std::string &_worldName)
   // Create publisher of the logical camera images
   this->dataPtr->pub =
     this->node->Advertise<msgs::LogicalCameraImage>(this->Topic(), 50);
+
+  // Only test the models around the camera
+  this->world->SetBoxIndexEnabled(true);
 }
 
 //////////////////////////////////////////////////
@@ -116,19 +122,8 @@ void LogicalCameraSensorPrivate::AddVisibleModels(
 {
   for (auto const &model : _models)
   {
-    auto const &scopedName = model->GetScopedName();
-    auto const aabb = model->BoundingBox();
-
-    if (this->modelName != scopedName && this->frustum.Contains(aabb))
-    {
-      // Add new model msg
-      msgs::LogicalCameraImage::Model *modelMsg = this->msg.add_model();
+    this->AddVisibleModel(_myPose, model);
 
-      // Set the name and pose reported by the sensor.
-      modelMsg->set_name(scopedName);
-      msgs::Set(modelMsg->mutable_pose(),
-          model->WorldPose() - _myPose);
-    }
     // Check nested models
     // Note, the model AABB does not necessarily contain the nested model
     // so nested models must be searched even if the frustum does not contain
@@ -137,6 +132,54 @@ void LogicalCameraSensorPrivate::AddVisibleModels(
   }
 }
 
+//////////////////////////////////////////////////
+void LogicalCameraSensorPrivate::AddVisibleModel(
+    const ignition::math::Pose3d &_myPose, const physics::ModelPtr &_model)
+{
+  auto const &scopedName = _model->GetScopedName();
+  auto const aabb = _model->BoundingBox();
+
+  if (this->modelName != scopedName && this->frustum.Contains(aabb))
+  {
+    // Add new model msg
+    msgs::LogicalCameraImage::Model *modelMsg = this->msg.add_model();
+
+    // Set the name and pose reported by the sensor.
+    modelMsg->set_name(scopedName);
+    msgs::Set(modelMsg->mutable_pose(),
+        _model->WorldPose() - _myPose);
+  }
+}
+
+//////////////////////////////////////////////////
+ignition::math::AxisAlignedBox LogicalCameraSensorPrivate::FrustumBox() const
+{
+  // The frustum looks down its X axis
+  const double halfWidth = std::tan(this->frustum.FOV().Radian() * 0.5);
+  const double halfHeight = halfWidth / this->frustum.AspectRatio();
+  const ignition::math::Pose3d &pose = this->frustum.Pose();
+
+  ignition::math::Vector3d min(ignition::math::MAX_D,
+      ignition::math::MAX_D, ignition::math::MAX_D);
+  ignition::math::Vector3d max(ignition::math::LOW_D,
+      ignition::math::LOW_D, ignition::math::LOW_D);
+  for (const double depth : {this->frustum.Near(), this->frustum.Far()})
+  {
+    for (const double y : {-1.0, 1.0})
+    {
+      for (const double z : {-1.0, 1.0})
+      {
+        const ignition::math::Vector3d corner = pose.CoordPositionAdd(
+            ignition::math::Vector3d(depth, y * depth * halfWidth,
+              z * depth * halfHeight));
+        min.Min(corner);
+        max.Max(corner);
+      }
+    }
+  }
+  return ignition::math::AxisAlignedBox(min, max);
+}
+
 //////////////////////////////////////////////////
 bool LogicalCameraSensor::UpdateImpl(const bool _force)
 {
@@ -158,8 +201,18 @@ bool LogicalCameraSensor::UpdateImpl(const bool _force)
     // Set the camera's pose in the message.
     msgs::Set(this->dataPtr->msg.mutable_pose(), myPose);
 
-    // Recursively check if models and nested models are in the frustum.
-    this->dataPtr->AddVisibleModels(myPose, this->world->Models());
+    physics::ModelBoxIndexPtr boxIndex = this->world->BoxIndex();
+    if (boxIndex)
+    {
+      // The index holds nested models too, test each candidate on its own.
+      for (auto const &model : boxIndex->Query(this->dataPtr->FrustumBox()))
+        this->dataPtr->AddVisibleModel(myPose, model);
+    }
+    else
+    {
+      // Recursively check if models and nested models are in the frustum.
+      this->dataPtr->AddVisibleModels(myPose, this->world->Models());
+    }
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("Publish");
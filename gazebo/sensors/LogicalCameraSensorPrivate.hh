@@ -19,6 +19,7 @@
 
 #include <mutex>
 #include <string>
+#include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/Frustum.hh>
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
@@ -38,6 +39,17 @@ namespace gazebo
       public: void AddVisibleModels(ignition::math::Pose3d &_myPose,
         const physics::Model_V &_models);
 
+      /// \brief Add a model to the message if it is visible to the camera.
+      /// Its nested models are not tested.
+      /// \param[in] _myPose pose of the logical camera
+      /// \param[in] _model model to test against frustum
+      public: void AddVisibleModel(const ignition::math::Pose3d &_myPose,
+        const physics::ModelPtr &_model);
+
+      /// \brief Get a box in the world frame containing the frustum.
+      /// \return Box around the frustum, at its current pose.
+      public: ignition::math::AxisAlignedBox FrustumBox() const;
+
       /// \brief Publisher of msgs::LogicalCameraImage messages.
       public: transport::PublisherPtr pub;
 
@@ -15,9 +15,9 @@
  *
 */
 #include <boost/algorithm/string.hpp>
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Pose3.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/World.hh"
@@ -72,6 +72,9 @@ void MagnetometerSensor::Load(const std::string &_worldName)
   this->dataPtr->parentLink =
     boost::dynamic_pointer_cast<physics::Link>(parentEntity);
 
+  // Read the parent link through consistent per step snapshots
+  this->world->SetSnapshotsEnabled(true);
+
   this->dataPtr->magPub = this->node->Advertise<msgs::Magnetometer>(
       this->GetTopic(), 50);
 
@@ -137,7 +140,7 @@ bool MagnetometerSensor::UpdateImpl(const bool /*_force*/)
   {
     // Get pose in gazebo reference frame
     ignition::math::Pose3d magPose =
-      this->pose + this->dataPtr->parentLink->WorldPose();
+      this->pose + this->LinkState(this->dataPtr->parentLink).pose;
 
     // Get the reference magnetic field
     ignition::math::Vector3d field =
@@ -178,8 +181,8 @@ bool MagnetometerSensor::UpdateImpl(const bool /*_force*/)
 
   IGN_PROFILE_BEGIN("Publish");
   // Publish the message if needed
-  if (this->dataPtr->magPub)
-    this->dataPtr->magPub->Publish(this->dataPtr->magMsg);
+  this->PublishSample(this->dataPtr->magPub, this->dataPtr->magMsg,
+      msgs::Convert(this->dataPtr->magMsg.time()));
   IGN_PROFILE_END();
 
   return true;
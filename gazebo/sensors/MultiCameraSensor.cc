@@ -16,12 +16,12 @@
 */
 #include <boost/algorithm/string.hpp>
 #include <functional>
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Pose3.hh>
 
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/EnumIface.hh"
 #include "gazebo/common/Image.hh"
+#include "gazebo/common/TraceCapture.hh"
 
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/World.hh"
@@ -465,6 +465,24 @@ bool MultiCameraSensor::IsActive() const
     (this->dataPtr->imagePub && this->dataPtr->imagePub->HasConnections());
 }
 
+//////////////////////////////////////////////////
+bool MultiCameraSensor::HasConsumers() const
+{
+  if (Sensor::HasConsumers() ||
+      (this->dataPtr->imagePub && this->dataPtr->imagePub->HasConnections()))
+  {
+    return true;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->cameraMutex);
+  for (const auto &cam : this->dataPtr->cameras)
+  {
+    if (cam->FrameListenerCount() > 0)
+      return true;
+  }
+  return false;
+}
+
 //////////////////////////////////////////////////
 double MultiCameraSensor::NextRequiredTimestamp() const
 {
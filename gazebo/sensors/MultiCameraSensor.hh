@@ -111,6 +111,9 @@ namespace gazebo
       // Documentation inherited.
       public: virtual bool IsActive() const override;
 
+      // Documentation inherited.
+      public: virtual bool HasConsumers() const override;
+
       // Documentation inherited.
       protected: virtual bool UpdateImpl(const bool _force) override;
 
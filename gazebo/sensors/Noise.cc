@@ -15,7 +15,13 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
 #include <boost/function.hpp>
+#include <ignition/math/Rand.hh>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 
@@ -25,6 +31,68 @@
 using namespace gazebo;
 using namespace sensors;
 
+/// \brief Number of Philox blocks drawn at once by Noise::Normals.
+static const size_t kNoiseBlocks = 64;
+
+/// \brief Noise models created so far, to give each a distinct default
+/// stream.
+static std::atomic<uint64_t> g_noiseStreams{0};
+
+/// \brief Philox4x32-10 counter based random generator. Block _counter
+/// of the stream _key is always the same, whatever was drawn before.
+/// \param[in] _counter Block counter.
+/// \param[in] _key Stream key.
+/// \param[out] _out Four random values.
+static void Philox(const uint64_t _counter, const uint64_t _key,
+    uint32_t _out[4])
+{
+  uint32_t c0 = static_cast<uint32_t>(_counter);
+  uint32_t c1 = static_cast<uint32_t>(_counter >> 32);
+  uint32_t c2 = 0;
+  uint32_t c3 = 0;
+  uint32_t k0 = static_cast<uint32_t>(_key);
+  uint32_t k1 = static_cast<uint32_t>(_key >> 32);
+
+  for (int round = 0; round < 10; ++round)
+  {
+    const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+    const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+    const uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+    const uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+    c1 = static_cast<uint32_t>(p1);
+    c3 = static_cast<uint32_t>(p0);
+    c0 = n0;
+    c2 = n2;
+    k0 += 0x9E3779B9u;
+    k1 += 0xBB67AE85u;
+  }
+
+  _out[0] = c0;
+  _out[1] = c1;
+  _out[2] = c2;
+  _out[3] = c3;
+}
+
+/// \brief Box-Muller transform of random values into standard normal
+/// values. The loop has no branches, so that it vectorizes.
+/// \param[in] _in Random values, an even number.
+/// \param[out] _out Normal values, as many as _in.
+/// \param[in] _count Number of values.
+static void BoxMuller(const uint32_t *_in, double *_out, const size_t _count)
+{
+  const double scale = 1.0 / 4294967296.0;
+  for (size_t i = 0; i + 1 < _count; i += 2)
+  {
+    // Offset by half a step so that the logarithm is finite
+    const double u1 = (_in[i] + 0.5) * scale;
+    const double u2 = _in[i + 1] * scale;
+    const double r = std::sqrt(-2.0 * std::log(u1));
+    const double theta = 2.0 * M_PI * u2;
+    _out[i] = r * std::cos(theta);
+    _out[i + 1] = r * std::sin(theta);
+  }
+}
+
 //////////////////////////////////////////////////
 NoisePtr NoiseFactory::NewNoiseModel(sdf::ElementPtr _sdf,
     const std::string &_sensorType)
@@ -41,11 +109,15 @@ NoisePtr NoiseFactory::NewNoiseModel(sdf::ElementPtr _sdf,
   if (typeString == "gaussian" ||
       typeString == "gaussian_quantized")
   {
-    if (_sensorType == "camera" || _sensorType == "depth" ||
-      _sensorType == "multicamera" || _sensorType == "wideanglecamera")
+    if (_sensorType == "camera" || _sensorType == "multicamera" ||
+        _sensorType == "wideanglecamera")
     {
       noise.reset(new ImageGaussianNoiseModel());
     }
+    else if (_sensorType == "depth" || _sensorType == "gpu_ray")
+    {
+      noise.reset(new RangeGaussianNoiseModel());
+    }
     else
       noise.reset(new GaussianNoiseModel());
 
@@ -75,6 +147,8 @@ NoisePtr NoiseFactory::NewNoiseModel(sdf::ElementPtr _sdf,
 Noise::Noise(NoiseType _type)
   : type(_type)
 {
+  this->seed = (static_cast<uint64_t>(ignition::math::Rand::Seed()) << 32) ^
+    g_noiseStreams++;
 }
 
 //////////////////////////////////////////////////
@@ -124,6 +198,91 @@ double Noise::ApplyImpl(double _in, double /*_dt*/)
   return _in;
 }
 
+//////////////////////////////////////////////////
+void Noise::Apply(double *_values, const size_t _count, const double _dt)
+{
+  if (this->type == NONE || _count == 0)
+    return;
+  else if (this->type == CUSTOM)
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _values[i] = this->Apply(_values[i], _dt);
+  }
+  else
+    this->ApplyBatchImpl(_values, _count, _dt);
+}
+
+//////////////////////////////////////////////////
+void Noise::ApplyBatchImpl(double *_values, const size_t _count,
+    const double _dt)
+{
+  for (size_t i = 0; i < _count; ++i)
+    _values[i] = this->ApplyImpl(_values[i], _dt);
+}
+
+//////////////////////////////////////////////////
+void Noise::SetSeed(const uint64_t _seed)
+{
+  this->seed = _seed;
+  this->counter = 0;
+  this->normalCacheSize = 0;
+}
+
+//////////////////////////////////////////////////
+uint64_t Noise::Seed() const
+{
+  return this->seed;
+}
+
+//////////////////////////////////////////////////
+double Noise::Uniform()
+{
+  uint32_t block[4];
+  Philox(this->counter++, this->seed, block);
+  // 53 random bits, as many as a double holds
+  return ((block[0] >> 5) * 67108864.0 + (block[1] >> 6)) /
+    9007199254740992.0;
+}
+
+//////////////////////////////////////////////////
+double Noise::Normal()
+{
+  if (this->normalCacheSize == 0)
+  {
+    uint32_t block[4];
+    Philox(this->counter++, this->seed, block);
+    BoxMuller(block, this->normalCache, 4);
+    this->normalCacheSize = 4;
+  }
+  return this->normalCache[--this->normalCacheSize];
+}
+
+//////////////////////////////////////////////////
+void Noise::Normals(double *_values, const size_t _count)
+{
+  uint32_t blocks[kNoiseBlocks * 4];
+  size_t done = 0;
+  while (done < _count)
+  {
+    const size_t count = std::min(_count - done, kNoiseBlocks * 4);
+    const size_t blockCount = (count + 3) / 4;
+    for (size_t b = 0; b < blockCount; ++b)
+      Philox(this->counter++, this->seed, blocks + b * 4);
+
+    if (count == blockCount * 4)
+    {
+      BoxMuller(blocks, _values + done, count);
+    }
+    else
+    {
+      double last[kNoiseBlocks * 4];
+      BoxMuller(blocks, last, blockCount * 4);
+      std::copy(last, last + count, _values + done);
+    }
+    done += count;
+  }
+}
+
 //////////////////////////////////////////////////
 Noise::NoiseType Noise::GetNoiseType() const
 {
@@ -18,6 +18,8 @@
 #ifndef _GAZEBO_NOISE_HH_
 #define _GAZEBO_NOISE_HH_
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -88,6 +90,35 @@ namespace gazebo
       /// \return Data with noise applied.
       public: virtual double ApplyImpl(double _in, double _dt = 0.0);
 
+      /// \brief Apply noise to an array of input values, in place. This is
+      /// cheaper than calling Apply for each value.
+      /// \param[in,out] _values Values.
+      /// \param[in] _count Number of values.
+      /// \param[in] _dt Time since the previous values.
+      public: void Apply(double *_values, const size_t _count,
+                  const double _dt = 0.0);
+
+      /// \brief Apply noise to an array of input values. This gets
+      /// overriden by derived classes, and called by Apply. The default
+      /// calls ApplyImpl for each value.
+      /// \param[in,out] _values Values.
+      /// \param[in] _count Number of values.
+      /// \param[in] _dt Time since the previous values.
+      public: virtual void ApplyBatchImpl(double *_values,
+                  const size_t _count, const double _dt);
+
+      /// \brief Seed the random stream of this noise model. Each noise
+      /// model has its own stream, so its noise does not depend on the
+      /// order in which sensors update. Sensors seed their noise models
+      /// from the global seed, their name and the noise type.
+      /// \param[in] _seed Seed.
+      public: void SetSeed(const uint64_t _seed);
+
+      /// \brief Get the seed of the random stream.
+      /// \return Seed.
+      /// \sa SetSeed
+      public: uint64_t Seed() const;
+
       /// \brief Finalize the noise model
       public: virtual void Fini();
 
@@ -123,9 +154,34 @@ namespace gazebo
       /// \param[in] _out Output stream
       public: virtual void Print(std::ostream &_out) const;
 
+      /// \brief Draw a uniform value from the random stream.
+      /// \return Value in [0, 1).
+      protected: double Uniform();
+
+      /// \brief Draw a standard normal value from the random stream.
+      /// \return Value.
+      protected: double Normal();
+
+      /// \brief Draw standard normal values from the random stream.
+      /// \param[out] _values Values.
+      /// \param[in] _count Number of values.
+      protected: void Normals(double *_values, const size_t _count);
+
       /// \brief Which type of noise we're applying
       private: NoiseType type;
 
+      /// \brief Seed of the random stream, used as Philox key.
+      private: uint64_t seed;
+
+      /// \brief Counter of the next Philox block of the random stream.
+      private: uint64_t counter = 0;
+
+      /// \brief Normal values left from the last block drawn by Normal.
+      private: double normalCache[4];
+
+      /// \brief Number of values in normalCache.
+      private: unsigned int normalCacheSize = 0;
+
       /// \brief Noise sdf element.
       private: sdf::ElementPtr sdf;
 
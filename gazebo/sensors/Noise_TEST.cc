@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
@@ -105,6 +108,44 @@ TEST_F(NoiseTest, Types)
   }
 }
 
+//////////////////////////////////////////////////
+// Test the noise that depth cameras and GPU ray sensors pass to shaders
+TEST_F(NoiseTest, RangeNoise)
+{
+  for (const std::string sensorType : {"depth", "gpu_ray"})
+  {
+    sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+        NoiseSdf("gaussian_quantized", 0.1, 0.2, 0, 0, 0.01), sensorType);
+    sensors::RangeGaussianNoiseModelPtr rangeNoise =
+        std::dynamic_pointer_cast<sensors::RangeGaussianNoiseModel>(noise);
+    ASSERT_NE(rangeNoise, nullptr);
+
+    rendering::RangeNoise shaderNoise = rangeNoise->ShaderNoise();
+    EXPECT_TRUE(shaderNoise.Enabled());
+    EXPECT_DOUBLE_EQ(shaderNoise.mean, 0.1);
+    EXPECT_DOUBLE_EQ(shaderNoise.stdDev, 0.2);
+    EXPECT_DOUBLE_EQ(shaderNoise.precision, 0.01);
+    EXPECT_DOUBLE_EQ(shaderNoise.rangeStdDev, 0.0);
+    EXPECT_DOUBLE_EQ(shaderNoise.dropout, 0.0);
+    EXPECT_DOUBLE_EQ(shaderNoise.rangeDropout, 0.0);
+
+    // The shader offsets come from the stream of the noise model
+    ASSERT_TRUE(static_cast<bool>(shaderNoise.uniform));
+    noise->SetSeed(7);
+    const double u = shaderNoise.uniform();
+    EXPECT_GE(u, 0.0);
+    EXPECT_LT(u, 1.0);
+    noise->SetSeed(7);
+    EXPECT_DOUBLE_EQ(shaderNoise.uniform(), u);
+  }
+
+  // Other sensors keep the plain Gaussian model
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", 0, 0, 0, 0, 0), "ray");
+  EXPECT_EQ(std::dynamic_pointer_cast<sensors::RangeGaussianNoiseModel>(noise),
+      nullptr);
+}
+
 //////////////////////////////////////////////////
 // Helper function for testing no noise
 void NoNoise(sensors::NoisePtr _noise, unsigned int _count)
@@ -374,6 +415,89 @@ TEST_F(NoiseTest, OnApplyNoise)
   }
 }
 
+TEST_F(NoiseTest, ApplyBatch)
+{
+  const double mean = 10.0;
+  const double stddev = 5.0;
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", mean, stddev, 0, 0, 0));
+  ASSERT_TRUE(noise != nullptr);
+
+  // An odd count exercises the partial last block
+  const size_t count = 100001;
+  std::vector<double> values(count, 1.0);
+  noise->Apply(values.data(), values.size());
+
+  boost::accumulators::accumulator_set<double,
+    boost::accumulators::stats<boost::accumulators::tag::mean,
+                               boost::accumulators::tag::variance > > acc;
+  for (auto const value : values)
+    acc(value);
+
+  double sampleStdDev = g_sigma * stddev / sqrt(count);
+  EXPECT_NEAR(boost::accumulators::mean(acc), 1.0 + mean, sampleStdDev);
+
+  double variance = stddev * stddev;
+  double sampleVariance2 = 2 * variance * variance / (count - 1);
+  EXPECT_NEAR(boost::accumulators::variance(acc),
+              variance, g_sigma * sqrt(sampleVariance2));
+
+  // Quantized
+  noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", mean, stddev, 0, 0, 0.5));
+  noise->Apply(values.data(), values.size());
+  for (auto const value : values)
+    EXPECT_DOUBLE_EQ(value, std::round(value / 0.5) * 0.5);
+
+  // No noise leaves the values unchanged
+  noise.reset(new sensors::Noise(sensors::Noise::NONE));
+  values.assign(10, 3.0);
+  noise->Apply(values.data(), values.size());
+  for (auto const value : values)
+    EXPECT_DOUBLE_EQ(3.0, value);
+
+  // Custom noise goes through the callback
+  noise->SetCustomNoiseCallback(
+    boost::bind(&OnApplyCustomNoise, boost::placeholders::_1));
+  noise->Apply(values.data(), values.size());
+  for (auto const value : values)
+    EXPECT_DOUBLE_EQ(6.0, value);
+}
+
+TEST_F(NoiseTest, Seed)
+{
+  sensors::NoisePtr first = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", 0, 1, 0, 0, 0));
+  sensors::NoisePtr second = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", 0, 1, 0, 0, 0));
+
+  // Each model has its own stream
+  EXPECT_NE(first->Seed(), second->Seed());
+
+  // Models with the same seed produce the same noise, whatever the other
+  // models draw in between
+  first->SetSeed(42);
+  second->SetSeed(42);
+  EXPECT_EQ(42u, first->Seed());
+
+  std::vector<double> a(10, 0.0);
+  std::vector<double> b(10, 0.0);
+  first->Apply(a.data(), a.size());
+  ignition::math::Rand::DblNormal(0, 1);
+  second->Apply(b.data(), b.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    EXPECT_DOUBLE_EQ(a[i], b[i]);
+
+  const double next = first->Apply(0.0);
+  EXPECT_DOUBLE_EQ(next, second->Apply(0.0));
+
+  // Another seed gives other noise
+  second->SetSeed(43);
+  b.assign(10, 0.0);
+  second->Apply(b.data(), b.size());
+  EXPECT_NE(a, b);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -14,8 +14,8 @@
  * limitations under the License.
  *
 */
-#include <ignition/common/Profiler.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/transport.hh"
 #include "gazebo/physics/World.hh"
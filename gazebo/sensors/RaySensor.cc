@@ -16,8 +16,7 @@
 */
 #include <boost/algorithm/string.hpp>
 
-#include <ignition/common/Profiler.hh>
-
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/MultiRayShape.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
@@ -379,6 +378,12 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
 
   scan->clear_ranges();
   scan->clear_intensities();
+  this->dataPtr->noiseIndices.clear();
+
+  // currently supports only one noise model per laser sensor
+  auto noiseIter = this->noises.find(RAY_NOISE);
+  NoisePtr noise = noiseIter != this->noises.end() ? noiseIter->second :
+    NoisePtr();
 
   unsigned int rayCount = this->RayCount();
   unsigned int rangeCount = this->RangeCount();
@@ -487,24 +492,41 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
       {
         range = -ignition::math::INF_D;
       }
-      else if (this->noises.find(RAY_NOISE) !=
-               this->noises.end())
+      else if (noise)
       {
-        // currently supports only one noise model per laser sensor
-        range = this->noises[RAY_NOISE]->Apply(range);
-        range = ignition::math::clamp(range,
-            this->RangeMin(), this->RangeMax());
+        // Noise is applied to the whole scan below
+        this->dataPtr->noiseIndices.push_back(scan->ranges_size());
       }
 
       scan->add_ranges(range);
       scan->add_intensities(intensity);
     }
   }
+
+  if (noise && !this->dataPtr->noiseIndices.empty())
+  {
+    std::vector<double> &noisy = this->dataPtr->noisyRanges;
+    noisy.resize(this->dataPtr->noiseIndices.size());
+    for (size_t k = 0; k < noisy.size(); ++k)
+      noisy[k] = scan->ranges(this->dataPtr->noiseIndices[k]);
+
+    noise->Apply(noisy.data(), noisy.size());
+
+    for (size_t k = 0; k < noisy.size(); ++k)
+    {
+      scan->set_ranges(this->dataPtr->noiseIndices[k],
+          ignition::math::clamp(noisy[k], this->RangeMin(),
+            this->RangeMax()));
+    }
+  }
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("Publish");
-  if (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
-    this->dataPtr->scanPub->Publish(this->dataPtr->laserMsg);
+  if (this->HasSampleConnections(this->dataPtr->scanPub))
+  {
+    this->PublishSample(this->dataPtr->scanPub, this->dataPtr->laserMsg,
+        this->lastMeasurementTime);
+  }
   IGN_PROFILE_END();
 
   return true;
@@ -514,7 +536,7 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
 bool RaySensor::IsActive() const
 {
   return Sensor::IsActive() ||
-    (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections());
+    this->HasSampleConnections(this->dataPtr->scanPub);
 }
 
 //////////////////////////////////////////////////
@@ -18,6 +18,7 @@
 #define _GAZEBO_SENSORS_RAYSENSOR_PRIVATE_HH_
 
 #include <mutex>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -48,6 +49,12 @@ namespace gazebo
 
       /// \brief Laser message.
       public: msgs::LaserScanStamped laserMsg;
+
+      /// \brief Indices of the ranges that get noise in the current scan.
+      public: std::vector<int> noiseIndices;
+
+      /// \brief Ranges that get noise in the current scan.
+      public: std::vector<double> noisyRanges;
     };
   }
 }
@@ -14,8 +14,12 @@
  * limitations under the License.
  *
 */
-#include "ignition/common/Profiler.hh"
+#include <algorithm>
+#include <string>
 
+#include <ignition/math/Rand.hh>
+
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/transport/transport.hh"
 
 #include "gazebo/physics/PhysicsIface.hh"
@@ -28,6 +32,7 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/PluginStats.hh"
 #include "gazebo/common/SdfFrameSemantics.hh"
 
 #include "gazebo/rendering/Camera.hh"
@@ -35,6 +40,8 @@
 #include "gazebo/rendering/RenderingIface.hh"
 #include "gazebo/rendering/Scene.hh"
 
+#include "gazebo/util/TimingStats.hh"
+
 #include "gazebo/sensors/CameraSensor.hh"
 #include "gazebo/sensors/LogicalCameraSensor.hh"
 #include "gazebo/sensors/Noise.hh"
@@ -71,6 +78,8 @@ Sensor::Sensor(SensorCategory _cat)
   this->updatePeriod = common::Time(0.0);
 
   this->dataPtr->id = physics::getUniqueId();
+
+  this->updated.SetName("sensorUpdated");
 }
 
 //////////////////////////////////////////////////
@@ -155,6 +164,10 @@ void Sensor::Load(const std::string &_worldName)
   this->node->Init(this->world->Name());
   this->dataPtr->sensorPub =
     this->node->Advertise<msgs::Sensor>("~/sensor");
+
+  // Gazebo specific opt-in
+  if (this->sdf->HasElement("batch"))
+    this->SetBatchSize(this->sdf->Get<unsigned int>("batch"));
 }
 
 //////////////////////////////////////////////////
@@ -162,6 +175,24 @@ void Sensor::Init()
 {
   this->SetUpdateRate(this->sdf->Get<double>("update_rate"));
 
+  // Sensors of a type share a stage, so the number of stages stays small.
+  this->dataPtr->timingStage =
+    util::TimingStats::Instance()->Stage("Sensor::Update/" + this->Type());
+
+  // Give each noise model its own stream, derived from the global seed, so
+  // that the noise does not depend on the order in which sensors update.
+  const std::string scopedName = this->ScopedName();
+  for (auto &noise : this->noises)
+  {
+    if (!noise.second)
+      continue;
+    uint64_t seed = 14695981039346656037ull ^ ignition::math::Rand::Seed();
+    for (const char c : scopedName)
+      seed = (seed ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    seed = (seed ^ static_cast<uint64_t>(noise.first)) * 1099511628211ull;
+    noise.second->SetSeed(seed);
+  }
+
   // Load the plugins
   if (this->sdf->HasElement("plugin"))
   {
@@ -227,10 +258,71 @@ bool Sensor::NeedsUpdate()
     return false;
   }
 
+  // Skip the rendering of image sensors whose data nobody uses.
+  if (this->dataPtr->category == IMAGE &&
+      SensorManager::Instance()->RenderOnDemand() && !this->HasConsumers())
+  {
+    return false;
+  }
+
   return (simTime - this->lastMeasurementTime +
       this->dataPtr->updateDelay) >= this->updatePeriod;
 }
 
+//////////////////////////////////////////////////
+void Sensor::Update(const bool _force,
+    const physics::WorldSnapshotPtr &_snapshot)
+{
+  this->dataPtr->updateSnapshot = _snapshot;
+  this->Update(_force);
+  this->dataPtr->updateSnapshot.reset();
+}
+
+//////////////////////////////////////////////////
+physics::WorldSnapshotPtr Sensor::Snapshot() const
+{
+  if (this->dataPtr->updateSnapshot)
+    return this->dataPtr->updateSnapshot;
+  return this->world->Snapshot();
+}
+
+//////////////////////////////////////////////////
+physics::LinkSnapshot Sensor::LinkState(const physics::LinkPtr &_link) const
+{
+  physics::WorldSnapshotPtr snapshot = this->Snapshot();
+  if (snapshot)
+  {
+    const physics::LinkSnapshot *state = snapshot->Link(_link->GetId());
+    if (state)
+      return *state;
+  }
+
+  physics::LinkSnapshot state;
+  state.pose = _link->WorldPose();
+  state.linearVel = _link->WorldLinearVel(ignition::math::Vector3d::Zero);
+  state.angularVel = _link->WorldAngularVel();
+  return state;
+}
+
+//////////////////////////////////////////////////
+bool Sensor::TimedUpdateImpl(const bool _force)
+{
+  common::Timer timer;
+  timer.Start();
+  bool result = this->UpdateImpl(_force);
+  common::Time duration = timer.GetElapsed();
+
+  if (duration >= common::Time::Zero)
+  {
+    util::TimingStats::Instance()->Record(this->dataPtr->timingStage,
+        static_cast<uint64_t>(duration.sec) * 1000000000ull + duration.nsec);
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  this->dataPtr->lastUpdateDuration = duration;
+  return result;
+}
+
 //////////////////////////////////////////////////
 void Sensor::Update(const bool _force)
 {
@@ -238,7 +330,7 @@ void Sensor::Update(const bool _force)
   {
     if (this->useStrictRate)
     {
-      if (this->UpdateImpl(_force))
+      if (this->TimedUpdateImpl(_force))
         this->updated();
     }
     else
@@ -273,10 +365,13 @@ void Sensor::Update(const bool _force)
         // an inactive to an active state, or the sensor just cannot hit its
         // target update rate (worst case).
         if (this->dataPtr->updateDelay >= this->updatePeriod)
+        {
           this->dataPtr->updateDelay = common::Time::Zero;
+          ++this->dataPtr->overrunCount;
+        }
       }
 
-      if (this->UpdateImpl(_force))
+      if (this->TimedUpdateImpl(_force))
       {
         std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
         this->lastUpdateTime = simTime;
@@ -289,6 +384,12 @@ void Sensor::Update(const bool _force)
 //////////////////////////////////////////////////
 void Sensor::Fini()
 {
+  this->FlushBatches();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->batchMutex);
+    this->dataPtr->batches.clear();
+  }
+
   if (this->node)
     this->node->Fini();
   this->node.reset();
@@ -343,6 +444,8 @@ void Sensor::LoadPlugin(sdf::ElementPtr _sdf)
       return;
     }
 
+    // The callbacks connected by the plugin are charged to it
+    common::PluginScope scope(filename, name);
     SensorPtr myself = shared_from_this();
     plugin->Load(myself, _sdf);
     plugin->Init();
@@ -362,6 +465,12 @@ bool Sensor::IsActive() const
   return this->active;
 }
 
+//////////////////////////////////////////////////
+bool Sensor::HasConsumers() const
+{
+  return this->updated.ConnectionCount() > 0;
+}
+
 //////////////////////////////////////////////////
 ignition::math::Pose3d Sensor::Pose() const
 {
@@ -418,6 +527,20 @@ common::Time Sensor::LastMeasurementTime() const
   return this->lastMeasurementTime;
 }
 
+//////////////////////////////////////////////////
+common::Time Sensor::LastUpdateDuration() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  return this->dataPtr->lastUpdateDuration;
+}
+
+//////////////////////////////////////////////////
+unsigned int Sensor::OverrunCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  return this->dataPtr->overrunCount;
+}
+
 //////////////////////////////////////////////////
 std::string Sensor::Type() const
 {
@@ -540,3 +663,104 @@ bool Sensor::StrictRate() const
 {
   return this->useStrictRate;
 }
+
+//////////////////////////////////////////////////
+void Sensor::SetBatchSize(const unsigned int _size)
+{
+  this->FlushBatches();
+  std::lock_guard<std::mutex> lock(this->dataPtr->batchMutex);
+  this->dataPtr->batchSize = std::max(_size, 1u);
+}
+
+//////////////////////////////////////////////////
+unsigned int Sensor::BatchSize() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->batchMutex);
+  return this->dataPtr->batchSize;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the batch of a sensor topic, advertised on first use.
+/// \param[in] _data Private data of the sensor, with batchMutex locked.
+/// \param[in] _node Node of the sensor.
+/// \param[in] _pub Publisher of the sensor topic.
+/// \return The batch, null if the sensor has no node.
+static SensorPrivate::SampleBatch *BatchOf(SensorPrivate &_data,
+    const transport::NodePtr &_node, const transport::PublisherPtr &_pub)
+{
+  const std::string topic = _pub->GetTopic();
+  auto iter = _data.batches.find(topic);
+  if (iter != _data.batches.end())
+    return &iter->second;
+
+  if (!_node)
+    return nullptr;
+
+  SensorPrivate::SampleBatch &batch = _data.batches[topic];
+  batch.pub = _node->Advertise<msgs::SensorBatch>(topic + "/batch");
+  return &batch;
+}
+
+//////////////////////////////////////////////////
+void Sensor::PublishSample(const transport::PublisherPtr &_pub,
+    const google::protobuf::Message &_msg, const common::Time &_stamp)
+{
+  if (!_pub)
+    return;
+
+  std::unique_lock<std::mutex> lock(this->dataPtr->batchMutex);
+  if (this->dataPtr->batchSize <= 1)
+  {
+    lock.unlock();
+    _pub->Publish(_msg);
+    return;
+  }
+
+  SensorPrivate::SampleBatch *batch =
+    BatchOf(*this->dataPtr, this->node, _pub);
+  if (!batch)
+    return;
+
+  if (!msgs::AddToBatch(batch->msg, _msg, _stamp))
+  {
+    gzerr << "Sample of type " << _msg.GetTypeName() << " does not match "
+          << "the batch of topic " << _pub->GetTopic() << std::endl;
+    return;
+  }
+
+  if (static_cast<unsigned int>(batch->msg.sample_size()) >=
+      this->dataPtr->batchSize)
+  {
+    batch->pub->Publish(batch->msg);
+    batch->msg.Clear();
+  }
+}
+
+//////////////////////////////////////////////////
+bool Sensor::HasSampleConnections(const transport::PublisherPtr &_pub) const
+{
+  if (!_pub)
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->batchMutex);
+  if (this->dataPtr->batchSize <= 1)
+    return _pub->HasConnections();
+
+  SensorPrivate::SampleBatch *batch =
+    BatchOf(*this->dataPtr, this->node, _pub);
+  return batch && batch->pub->HasConnections();
+}
+
+//////////////////////////////////////////////////
+void Sensor::FlushBatches()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->batchMutex);
+  for (auto &batch : this->dataPtr->batches)
+  {
+    if (batch.second.msg.sample_size() > 0)
+    {
+      batch.second.pub->Publish(batch.second.msg);
+      batch.second.msg.Clear();
+    }
+  }
+}
@@ -27,6 +27,7 @@
 #include <ignition/transport/Node.hh>
 
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/sensors/SensorTypes.hh"
 
@@ -85,6 +86,16 @@ namespace gazebo
       /// \param[in] _force True to force update, false otherwise.
       public: virtual void Update(const bool _force);
 
+      /// \brief Update the sensor from a given world snapshot. Sensors
+      /// which read link states, such as IMU, altimeter, magnetometer and
+      /// GPS, read them from _snapshot instead of loading the latest one of
+      /// the world, so a batch of sensors samples the same step and shares
+      /// one load of the snapshot.
+      /// \param[in] _force True to force update, false otherwise.
+      /// \param[in] _snapshot Snapshot of the world, may be null.
+      public: void Update(const bool _force,
+                  const physics::WorldSnapshotPtr &_snapshot);
+
       /// \brief Get the update rate of the sensor.
       /// \return _hz update rate of sensor.  Returns 0 if unthrottled.
       public: double UpdateRate() const;
@@ -122,6 +133,15 @@ namespace gazebo
       /// \return True if active, false if not.
       public: virtual bool IsActive() const;
 
+      /// \brief Is anything consuming the data of this sensor? This is a
+      /// subscriber to one of its topics, a connection to its update event,
+      /// for example from a sensor plugin, or for rendering sensors frames
+      /// being saved or recorded. Unlike IsActive, the always on flag is
+      /// not a consumer.
+      /// \return True if the data of the sensor is used.
+      /// \sa SensorManager::SetRenderOnDemand
+      public: virtual bool HasConsumers() const;
+
       /// \brief Get sensor type.
       /// \return Type of sensor.
       public: std::string Type() const;
@@ -134,6 +154,16 @@ namespace gazebo
       /// \return Time of last measurement.
       public: common::Time LastMeasurementTime() const;
 
+      /// \brief Get the wall clock time the last call to UpdateImpl took.
+      /// \return Duration of the last update.
+      public: common::Time LastUpdateDuration() const;
+
+      /// \brief Get the number of times the sensor fell a full update
+      /// period behind its update rate and gave up catching up. This also
+      /// counts the first update after the sensor was inactive.
+      /// \return Number of overruns since the sensor was created.
+      public: unsigned int OverrunCount() const;
+
       /// \brief Return true if user requests the sensor to be visualized
       ///        via tag:  <visualize>true</visualize> in SDF.
       /// \return True if visualized, false if not.
@@ -189,6 +219,21 @@ namespace gazebo
       /// \return True when sensor should follow strict update rate
       public: bool StrictRate() const;
 
+      /// \brief Set the number of consecutive samples packed in each
+      /// message. With more than one sample, the samples of a sensor topic
+      /// are published together on <topic>/batch as msgs::SensorBatch
+      /// instead of one by one on the topic. Use
+      /// transport::Node::SubscribeBatch to receive them one by one.
+      /// This is also set with <batch> in the sensor SDF.
+      /// \param[in] _size Samples per message, 0 and 1 disable batching.
+      public: void SetBatchSize(const unsigned int _size);
+
+      /// \brief Get the number of consecutive samples packed in each
+      /// message.
+      /// \return Samples per message, 1 when batching is disabled.
+      /// \sa SetBatchSize
+      public: unsigned int BatchSize() const;
+
       /// \brief This gets overwritten by derived sensor types.
       ///        This function is called during Sensor::Update.
       ///        And in turn, Sensor::Update is called by
@@ -201,6 +246,46 @@ namespace gazebo
       /// \return True when sensor should be updated.
       protected: virtual bool NeedsUpdate();
 
+      /// \brief Call UpdateImpl and record how long it took.
+      /// \param[in] _force Passed to UpdateImpl.
+      /// \return Result of UpdateImpl.
+      private: bool TimedUpdateImpl(const bool _force);
+
+      /// \brief Get the snapshot given to the update in progress, or else
+      /// the latest snapshot of the world.
+      /// \return The snapshot, null if snapshots are disabled or no step
+      /// ran yet.
+      protected: physics::WorldSnapshotPtr Snapshot() const;
+
+      /// \brief Publish a sample of the sensor, or add it to the batch of
+      /// the publisher topic when batching is enabled.
+      /// \param[in] _pub Publisher of the sensor topic.
+      /// \param[in] _msg The sample.
+      /// \param[in] _stamp Time of the sample.
+      /// \sa SetBatchSize
+      protected: void PublishSample(const transport::PublisherPtr &_pub,
+                     const google::protobuf::Message &_msg,
+                     const common::Time &_stamp);
+
+      /// \brief Get whether anyone receives the samples of a publisher,
+      /// one by one or in batches.
+      /// \param[in] _pub Publisher of the sensor topic.
+      /// \return True if the samples have subscribers.
+      protected: bool HasSampleConnections(
+                     const transport::PublisherPtr &_pub) const;
+
+      /// \brief Publish the incomplete sample batches.
+      private: void FlushBatches();
+
+      /// \brief Get the state of a link at the end of the last world step.
+      /// The state comes from World::Snapshot when snapshots are enabled,
+      /// so pose and velocity belong to the same step even while physics
+      /// runs the next one. Otherwise the live link is read.
+      /// \param[in] _link Link to read.
+      /// \return State of the link.
+      protected: physics::LinkSnapshot LinkState(
+                     const physics::LinkPtr &_link) const;
+
       /// \brief Load a plugin for this sensor.
       /// \param[in] _sdf SDF parameters.
       private: void LoadPlugin(sdf::ElementPtr _sdf);
@@ -15,9 +15,14 @@
  *
 */
 
+#include <algorithm>
 #include <functional>
 #include <boost/bind/bind.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
+#include "gazebo/common/ThreadRoles.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/PhysicsIface.hh"
@@ -25,6 +30,7 @@
 #include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/WideAngleCamera.hh"
 #include "gazebo/sensors/CameraSensor.hh"
 #include "gazebo/sensors/Sensor.hh"
 #include "gazebo/sensors/SensorFactory.hh"
@@ -33,8 +39,6 @@
 #include "gazebo/transport/transport.hh"
 #include "gazebo/util/LogPlay.hh"
 
-#include "ignition/common/Profiler.hh"
-
 using namespace gazebo;
 using namespace sensors;
 
@@ -88,7 +92,7 @@ common::Time lastRealTime;
 
 //////////////////////////////////////////////////
 SensorManager::SensorManager()
-  : initialized(false), removeAllSensors(false)
+  : initialized(false), removeAllSensors(false), renderOnDemand(false)
 {
   // sensors::IMAGE container
   this->sensorContainers.push_back(new ImageSensorContainer());
@@ -131,6 +135,7 @@ void SensorManager::RunThreads()
     GZ_ASSERT((*iter) != nullptr, "Sensor Constainer is null");
     (*iter)->Run();
   }
+  this->threadsRunning = true;
 }
 
 //////////////////////////////////////////////////
@@ -143,6 +148,7 @@ void SensorManager::Stop()
     GZ_ASSERT((*iter) != nullptr, "Sensor Constainer is null");
     (*iter)->Stop();
   }
+  this->threadsRunning = false;
 
   if (!physics::worlds_running())
     this->worlds.clear();
@@ -287,6 +293,38 @@ void PublishPerformanceMetrics()
       performanceSensorMetricsMsg->set_fps(
         sensorPerformanceMetric.second.sensorAvgFPS);
     }
+
+    sensors::SensorPtr sensor =
+      sensors::get_sensor(sensorPerformanceMetric.first);
+    if (sensor)
+    {
+      performanceSensorMetricsMsg->set_update_duration(
+          sensor->LastUpdateDuration().Double());
+      performanceSensorMetricsMsg->set_overruns(sensor->OverrunCount());
+
+      // Render statistics are collected once someone listens to them
+      sensors::CameraSensorPtr cameraSensor =
+          std::dynamic_pointer_cast<sensors::CameraSensor>(sensor);
+      if (cameraSensor && cameraSensor->Camera())
+      {
+        rendering::CameraPtr camera = cameraSensor->Camera();
+        camera->SetRenderStatsEnabled(true);
+        performanceSensorMetricsMsg->set_visible_objects(
+            camera->VisibleObjectCount());
+        performanceSensorMetricsMsg->set_batches(camera->BatchCount());
+        performanceSensorMetricsMsg->set_triangles(camera->TriangleCount());
+        performanceSensorMetricsMsg->set_render_duration(
+            camera->RenderDuration().Double());
+
+        rendering::WideAngleCameraPtr wideAngleCamera =
+            boost::dynamic_pointer_cast<rendering::WideAngleCamera>(camera);
+        if (wideAngleCamera)
+        {
+          performanceSensorMetricsMsg->set_skipped_cube_faces(
+              wideAngleCamera->SkippedFaceCount());
+        }
+      }
+    }
   }
 
   // Publish data
@@ -318,7 +356,7 @@ void SensorManager::Update(bool _force)
             "Sensor container is null");
 
         sensor->Init();
-        this->sensorContainers[sensor->Category()]->AddSensor(sensor);
+        this->Container(sensor)->AddSensor(sensor);
       }
       this->initSensors.clear();
       for (auto &worldName_worldPtr : this->worlds)
@@ -508,16 +546,28 @@ std::string SensorManager::CreateSensor(sdf::ElementPtr _elem,
 
   // Provide the wait function to the given world
   if (sensor->StrictRate())
+  {
     this->worlds[_worldName]->SetSensorWaitFunc(
         std::bind(&SensorManager::WaitForSensors, this,
           std::placeholders::_1, std::placeholders::_2));
 
+    // Adaptive steps end at the next required timestamp
+    this->worlds[_worldName]->SetStepSizeCriterion("sensors",
+        [this](const common::Time &_simTime)
+        {
+          const double next = this->NextRequiredTimestamp();
+          if (std::isnan(next) || next <= _simTime.Double())
+            return 0.0;
+          return next - _simTime.Double();
+        });
+  }
+
   // If the SensorManager has not been initialized, then it's okay to push
   // the sensor into one of the sensor vectors because the sensor will get
   // initialized in SensorManager::Init
   if (!this->initialized)
   {
-    this->sensorContainers[sensor->Category()]->AddSensor(sensor);
+    this->Container(sensor)->AddSensor(sensor);
   }
   // Otherwise the SensorManager is already running, and the sensor will get
   // initialized during the next SensorManager::Update call.
@@ -643,6 +693,7 @@ SensorManager::SensorContainer::SensorContainer()
   this->stop = true;
   this->initialized = false;
   this->runThread = nullptr;
+  this->parallelThreshold = 0;
 }
 
 //////////////////////////////////////////////////
@@ -716,12 +767,81 @@ bool SensorManager::SensorContainer::Running() const
   return !this->stop;
 }
 
+//////////////////////////////////////////////////
+void SensorManager::SetParallelUpdateThreshold(const unsigned int _threshold)
+{
+  // Only the OTHER containers, rendering sensors must run in the main
+  // thread and ray sensors serialize on the physics engine lock.
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  this->sensorContainers[sensors::OTHER]->parallelThreshold = _threshold;
+  for (auto &worldContainers : this->worldContainers)
+    worldContainers.second[sensors::OTHER]->parallelThreshold = _threshold;
+}
+
+//////////////////////////////////////////////////
+unsigned int SensorManager::ParallelUpdateThreshold() const
+{
+  return this->sensorContainers[sensors::OTHER]->parallelThreshold;
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SetRenderOnDemand(const bool _enable)
+{
+  this->renderOnDemand = _enable;
+}
+
+//////////////////////////////////////////////////
+bool SensorManager::RenderOnDemand() const
+{
+  return this->renderOnDemand;
+}
+
+//////////////////////////////////////////////////
+SensorManager::SensorContainer *SensorManager::Container(
+    const SensorPtr &_sensor)
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+
+  const SensorCategory category = _sensor->Category();
+  const std::string worldName = _sensor->WorldName();
+  if (category == sensors::IMAGE || worldName.empty() ||
+      worldName == physics::get_world()->Name())
+  {
+    return this->sensorContainers[category];
+  }
+
+  auto iter = this->worldContainers.find(worldName);
+  if (iter == this->worldContainers.end())
+  {
+    SensorContainer_V containers(CATEGORY_COUNT, nullptr);
+    for (int i = sensors::RAY; i < CATEGORY_COUNT; ++i)
+    {
+      SensorContainer *container = new SensorContainer();
+      container->worldName = worldName;
+      container->parallelThreshold.store(
+          this->sensorContainers[i]->parallelThreshold);
+      if (this->initialized)
+        container->Init();
+      if (this->threadsRunning)
+        container->Run();
+
+      containers[i] = container;
+      this->sensorContainers.push_back(container);
+    }
+    iter = this->worldContainers.emplace(worldName, containers).first;
+  }
+
+  return iter->second[category];
+}
+
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::RunLoop()
 {
   this->stop = false;
 
-  physics::WorldPtr world = physics::get_world();
+  common::ThreadRoles::Instance()->Apply("sensors");
+
+  physics::WorldPtr world = physics::get_world(this->worldName);
   GZ_ASSERT(world != nullptr, "Pointer to World is null");
 
   physics::PhysicsEnginePtr engine = world->Physics();
@@ -835,7 +955,7 @@ void SensorManager::SensorContainer::RunLoop()
     // Add an event to trigger when the appropriate simulation time has been
     // reached.
     SensorManager::Instance()->simTimeEventHandler->AddRelativeEvent(
-        eventTime, &this->runCondition);
+        eventTime, &this->runCondition, this->worldName);
 
     // This if statement helps prevent deadlock on osx during teardown.
     IGN_PROFILE_BEGIN("Sleeping");
@@ -855,13 +975,47 @@ void SensorManager::SensorContainer::Update(bool _force)
   if (this->sensors.empty())
     gzlog << "Updating a sensor container without any sensors.\n";
 
+  physics::WorldPtr world = physics::get_world(this->worldName);
+  GZ_ASSERT(world != nullptr, "Pointer to World is null");
+
+  // One snapshot for the whole pass, so the sensors which read link states
+  // sample the same step
+  const physics::WorldSnapshotPtr snapshot = world->Snapshot();
+
+  const unsigned int threshold = this->parallelThreshold;
+  if (threshold > 0 && this->sensors.size() >= threshold)
+  {
+    physics::PhysicsEnginePtr engine = world->Physics();
+
+    // Sensors that are not due return from Sensor::Update right away, so
+    // work stealing spreads the due ones over the workers.
+    common::ThreadRoles::Instance()->Execute("sensors", [&]()
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, this->sensors.size()),
+          [&](const tbb::blocked_range<size_t> &_r)
+      {
+        // Some sensors cast rays through the physics engine.
+        engine->InitForThread();
+
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          GZ_ASSERT(this->sensors[i] != nullptr, "Sensor is null");
+          IGN_PROFILE_BEGIN(this->sensors[i]->Name().c_str());
+          this->sensors[i]->Update(_force, snapshot);
+          IGN_PROFILE_END();
+        }
+      });
+    });
+    return;
+  }
+
   // Update all the sensors in this container.
   for (Sensor_V::iterator iter = this->sensors.begin();
        iter != this->sensors.end(); ++iter)
   {
     GZ_ASSERT((*iter) != nullptr, "Sensor is null");
     IGN_PROFILE_BEGIN((*iter)->Name().c_str());
-    (*iter)->Update(_force);
+    (*iter)->Update(_force, snapshot);
     IGN_PROFILE_END();
   }
 }
@@ -936,6 +1090,22 @@ bool SensorManager::SensorContainer::RemoveSensor(const std::string &_name)
   return removed;
 }
 
+//////////////////////////////////////////////////
+bool SensorManager::SensorContainer::HasConsumers() const
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+
+  for (const auto &sensor : this->sensors)
+  {
+    GZ_ASSERT(sensor != nullptr, "Sensor is null");
+
+    // Lockstep sensors render whether or not they have consumers.
+    if (sensor->StrictRate() || sensor->HasConsumers())
+      return true;
+  }
+  return false;
+}
+
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::ResetLastUpdateTimes()
 {
@@ -976,6 +1146,16 @@ void SensorManager::SensorContainer::RemoveSensors()
 //////////////////////////////////////////////////
 void SensorManager::ImageSensorContainer::Update(bool _force)
 {
+  // All the cameras due this frame share the prerender phase, skip it when
+  // rendering on demand and no camera would render.
+  if (!_force && SensorManager::Instance()->RenderOnDemand() &&
+      !this->HasConsumers())
+  {
+    this->conditionPrerendered.notify_all();
+    SensorContainer::Update(_force);
+    return;
+  }
+
   // Prerender phase
   event::Events::preRender();
 
@@ -1016,58 +1196,79 @@ SimTimeEventHandler::SimTimeEventHandler()
 /////////////////////////////////////////////////
 SimTimeEventHandler::~SimTimeEventHandler()
 {
-  // Cleanup the events.
-  for (std::list<SimTimeEvent*>::iterator iter = this->events.begin();
-       iter != this->events.end(); ++iter)
-  {
-    GZ_ASSERT(*iter != nullptr, "SimTimeEvent is null");
-    delete *iter;
-  }
   this->events.clear();
 }
 
+/////////////////////////////////////////////////
+/// \brief Order of the event heaps, which puts the earliest event first.
+/// \param[in] _a First event.
+/// \param[in] _b Second event.
+/// \return True if _a is later than _b.
+static bool LaterEvent(const SimTimeEvent &_a, const SimTimeEvent &_b)
+{
+  return _a.time > _b.time;
+}
+
 /////////////////////////////////////////////////
 void SimTimeEventHandler::AddRelativeEvent(const common::Time &_time,
-                                           boost::condition_variable *_var)
+                                           boost::condition_variable *_var,
+                                           const std::string &_worldName)
 {
   boost::mutex::scoped_lock lock(this->mutex);
 
-  physics::WorldPtr world = physics::get_world();
+  physics::WorldPtr world = physics::get_world(_worldName);
   GZ_ASSERT(world != nullptr, "World pointer is null");
+  GZ_ASSERT(_var != nullptr, "Condition is null");
 
   // Create the new event.
-  SimTimeEvent *event = new SimTimeEvent;
-  event->time = world->SimTime() + _time;
-  event->condition = _var;
+  SimTimeEvent event;
+  event.time = world->SimTime() + _time;
+  event.condition = _var;
+  event.worldName = world->Name();
+
+  // Add the event to the heap of its world.
+  std::vector<SimTimeEvent> &heap = this->events[event.worldName];
+  heap.push_back(event);
+  std::push_heap(heap.begin(), heap.end(), LaterEvent);
+}
 
-  // Add the event to the list.
-  this->events.push_back(event);
+/////////////////////////////////////////////////
+size_t SimTimeEventHandler::EventCount() const
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  size_t count = 0;
+  for (const auto &heap : this->events)
+    count += heap.second.size();
+  return count;
 }
 
 /////////////////////////////////////////////////
 void SimTimeEventHandler::OnUpdate(const common::UpdateInfo &_info)
 {
+  // Most updates trigger no event, look at the earliest one before taking
+  // the timing mutex, which the sensor threads hold while they update.
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    auto iter = this->events.find(_info.worldName);
+    if (iter == this->events.end() || iter->second.empty() ||
+        iter->second.front().time > _info.simTime)
+    {
+      return;
+    }
+  }
+
   boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
   boost::mutex::scoped_lock lock(this->mutex);
 
-  // Iterate over all the events.
-  for (std::list<SimTimeEvent*>::iterator iter = this->events.begin();
-      iter != this->events.end();)
+  // Pop the events whose time is less than or equal to simulation time.
+  // Each world triggers the events of its own sensors.
+  std::vector<SimTimeEvent> &heap = this->events[_info.worldName];
+  while (!heap.empty() && heap.front().time <= _info.simTime)
   {
-    GZ_ASSERT(*iter != nullptr, "SimTimeEvent is null");
-
-    // Find events that have a time less than or equal to simulation
-    // time.
-    if ((*iter)->time <= _info.simTime)
-    {
-      // Notify the event by triggering its condition.
-      (*iter)->condition->notify_all();
+    // Notify the event by triggering its condition.
+    heap.front().condition->notify_all();
 
-      // Remove the event.
-      delete *iter;
-      this->events.erase(iter++);
-    }
-    else
-      ++iter;
+    std::pop_heap(heap.begin(), heap.end(), LaterEvent);
+    heap.pop_back();
   }
 }
@@ -18,6 +18,7 @@
 #define _GAZEBO_SENSORMANAGER_HH_
 
 #include <boost/thread.hpp>
+#include <atomic>
 #include <string>
 #include <vector>
 #include <list>
@@ -51,6 +52,10 @@ namespace gazebo
 
       /// \brief The condition to notify.
       public: boost::condition_variable *condition;
+
+      /// \brief Name of the world whose simulation time is compared to
+      /// time.
+      public: std::string worldName;
     };
 
     /// \brief Monitors simulation time, and notifies conditions when
@@ -68,18 +73,27 @@ namespace gazebo
       /// be add to this time.
       /// \param[in] _var Condition to notify when the time has been
       /// reached.
+      /// \param[in] _worldName Name of the world whose simulation time
+      /// is used, empty for the first world.
       public: void AddRelativeEvent(const common::Time &_time,
-                  boost::condition_variable *_var);
+                  boost::condition_variable *_var,
+                  const std::string &_worldName = "");
+
+      /// \brief Get the number of events waiting for their time.
+      /// \return Number of pending events, of all worlds.
+      public: size_t EventCount() const;
 
       /// \brief Called when the world is updated.
       /// \param[in] _info Update timing information.
       private: void OnUpdate(const common::UpdateInfo &_info);
 
       /// \brief Mutex to mantain thread safety.
-      private: boost::mutex mutex;
+      private: mutable boost::mutex mutex;
 
-      /// \brief The list of events to handle.
-      private: std::list<SimTimeEvent*> events;
+      /// \brief The events to handle, by world name. Each vector is a
+      /// heap whose front is the earliest event, so an update only looks
+      /// at the events that expire.
+      private: std::map<std::string, std::vector<SimTimeEvent>> events;
 
       /// \brief Connect to the World::UpdateBegin event.
       private: event::ConnectionPtr updateConnection;
@@ -179,6 +193,32 @@ namespace gazebo
       /// \brief Reset last update times in all sensors.
       public: void ResetLastUpdateTimes();
 
+      /// \brief Set the minimum number of sensors in the container of
+      /// non-rendering, non-ray sensors for them to be updated in parallel
+      /// on a TBB work stealing pool. Zero (the default) keeps the serial
+      /// update. Sensor plugins of such sensors may then be called from
+      /// several threads at once, one sensor per thread.
+      /// \param[in] _threshold Minimum number of sensors.
+      public: void SetParallelUpdateThreshold(const unsigned int _threshold);
+
+      /// \brief Get the parallel update threshold.
+      /// \return Minimum number of sensors for a parallel update.
+      /// \sa SetParallelUpdateThreshold
+      public: unsigned int ParallelUpdateThreshold() const;
+
+      /// \brief Render image sensors only when their data is used, see
+      /// Sensor::HasConsumers. When no image sensor has a consumer, the
+      /// scene is not even prepared for rendering. Sensors with a strict
+      /// update rate keep rendering in lockstep with physics. Off by
+      /// default.
+      /// \param[in] _enable True to render on demand.
+      public: void SetRenderOnDemand(const bool _enable);
+
+      /// \brief Get whether image sensors render on demand.
+      /// \return True if rendering on demand.
+      /// \sa SetRenderOnDemand
+      public: bool RenderOnDemand() const;
+
       /// \brief Block until all sensors do not need current world tick
       /// \param[in] _clk simulated clock of the world
       /// \param[in] _dt world time step
@@ -251,6 +291,19 @@ namespace gazebo
                  /// \brief Reset last update times in all sensors.
                  public: void ResetLastUpdateTimes();
 
+                 /// \brief Does a sensor in this container have a consumer?
+                 /// \return True if Sensor::HasConsumers is true for one
+                 /// of the sensors, or if sensors keep a strict rate.
+                 public: bool HasConsumers() const;
+
+                 /// \brief Minimum number of sensors to update them in
+                 /// parallel, zero to always update them serially.
+                 public: std::atomic<unsigned int> parallelThreshold;
+
+                 /// \brief Name of the world whose simulation time paces
+                 /// the container, empty for the first world.
+                 public: std::string worldName;
+
                  /// \brief A loop to update the sensor. Used by the
                  /// runThread.
                  private: void RunLoop();
@@ -304,6 +357,9 @@ namespace gazebo
       /// \brief True removes all sensors from all sensor containers.
       private: bool removeAllSensors;
 
+      /// \brief True to render image sensors only when they have consumers.
+      private: std::atomic<bool> renderOnDemand;
+
       /// \brief Mutex used when adding and removing sensors.
       private: mutable boost::recursive_mutex mutex;
 
@@ -316,9 +372,28 @@ namespace gazebo
       /// \brief A vector of SensorContainer pointers.
       private: typedef std::vector<SensorContainer*> SensorContainer_V;
 
-      /// \brief The sensor manager's vector of sensor containers.
+      /// \brief The sensor manager's vector of sensor containers. The
+      /// first CATEGORY_COUNT containers serve the first world and all
+      /// image sensors, the others serve the threaded sensors of the other
+      /// worlds.
       private: SensorContainer_V sensorContainers;
 
+      /// \brief Containers of the threaded sensors of each world but the
+      /// first, indexed by category. The IMAGE entry is unused, image
+      /// sensors are rendered by the main thread. The containers are owned
+      /// by sensorContainers.
+      private: std::map<std::string, SensorContainer_V> worldContainers;
+
+      /// \brief True while the threads of the containers run.
+      private: bool threadsRunning = false;
+
+      /// \brief Get the container that updates a sensor. Containers for
+      /// the threaded sensors of a world get created on first use, so each
+      /// world steps its sensors against its own simulation time.
+      /// \param[in] _sensor Sensor.
+      /// \return Container of the sensor.
+      private: SensorContainer *Container(const SensorPtr &_sensor);
+
       /// \brief This is a singleton class.
       private: friend class SingletonT<SensorManager>;
 
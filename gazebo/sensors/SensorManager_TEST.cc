@@ -16,7 +16,12 @@
 */
 
 #include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/World.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -159,6 +164,90 @@ TEST_F(SensorManager_TEST, InitRemove)
   printf("Done done\n");
 }
 
+/////////////////////////////////////////////////
+/// \brief Test updating non-rendering sensors in parallel
+TEST_F(SensorManager_TEST, ParallelUpdate)
+{
+  Load("worlds/empty.world", true);
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  EXPECT_EQ(mgr->ParallelUpdateThreshold(), 0u);
+  mgr->SetParallelUpdateThreshold(2);
+  EXPECT_EQ(mgr->ParallelUpdateThreshold(), 2u);
+
+  const unsigned int sensorCount = 4;
+  for (unsigned int i = 0; i < sensorCount; ++i)
+  {
+    std::string index = std::to_string(i);
+    SpawnUnitImuSensor("imu_model_" + index, "imu_sensor_" + index, "box",
+        "~/imu_" + index, ignition::math::Vector3d(i * 2.0, 0, 0.5));
+  }
+
+  std::vector<sensors::SensorPtr> sensors;
+  for (unsigned int i = 0; i < sensorCount; ++i)
+  {
+    sensors::SensorPtr sensor =
+        mgr->GetSensor("imu_sensor_" + std::to_string(i));
+    ASSERT_TRUE(sensor != nullptr);
+    sensors.push_back(sensor);
+  }
+
+  world->Step(100);
+
+  // Wait for every sensor to be updated.
+  int i = 0;
+  bool updated = false;
+  while (!updated && i < 100)
+  {
+    updated = true;
+    for (const auto &sensor : sensors)
+      updated = updated && sensor->LastMeasurementTime() > common::Time::Zero;
+    if (!updated)
+    {
+      common::Time::MSleep(100);
+      ++i;
+    }
+  }
+  EXPECT_TRUE(updated);
+
+  for (const auto &sensor : sensors)
+    EXPECT_GE(sensor->LastUpdateDuration(), common::Time::Zero);
+
+  mgr->SetParallelUpdateThreshold(0);
+  EXPECT_EQ(mgr->ParallelUpdateThreshold(), 0u);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that sim time events expire in time order, whatever the
+/// order they were added in.
+TEST_F(SensorManager_TEST, SimTimeEvents)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  const double stepSize = world->Physics()->GetMaxStepSize();
+
+  sensors::SimTimeEventHandler handler;
+  boost::condition_variable condition;
+  for (const int step : {30, 10, 20, 10})
+  {
+    handler.AddRelativeEvent(common::Time(stepSize * step), &condition,
+        "default");
+  }
+  EXPECT_EQ(4u, handler.EventCount());
+
+  world->Step(9);
+  EXPECT_EQ(4u, handler.EventCount());
+  world->Step(1);
+  EXPECT_EQ(2u, handler.EventCount());
+  world->Step(10);
+  EXPECT_EQ(1u, handler.EventCount());
+  world->Step(10);
+  EXPECT_EQ(0u, handler.EventCount());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -17,16 +17,20 @@
 #ifndef GAZEBO_SENSORS_SENSOR_PRIVATE_HH_
 #define GAZEBO_SENSORS_SENSOR_PRIVATE_HH_
 
+#include <map>
 #include <mutex>
+#include <string>
 #include <sdf/sdf.hh>
 
 #include "gazebo/rendering/RenderTypes.hh"
 
 #include "gazebo/common/Event.hh"
 #include "gazebo/common/Time.hh"
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/sensors/SensorTypes.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/transport/TransportTypes.hh"
+#include "gazebo/util/TimingStats.hh"
 
 namespace gazebo
 {
@@ -48,9 +52,43 @@ namespace gazebo
       /// \brief Keep track how much the update has been delayed.
       public: common::Time updateDelay;
 
+      /// \brief Wall clock duration of the last UpdateImpl call. Protected
+      /// by mutexLastUpdateTime.
+      public: common::Time lastUpdateDuration;
+
+      /// \brief Number of update overruns. Protected by
+      /// mutexLastUpdateTime.
+      public: unsigned int overrunCount = 0;
+
+      /// \brief util::TimingStats id of the updates of this type of
+      /// sensor, util::TimingStats::kMaxStages until Init.
+      public: unsigned int timingStage = util::TimingStats::kMaxStages;
+
       /// \brief The sensors unique ID.
       public: uint32_t id;
 
+      /// \brief Samples of a sensor topic waiting to be published.
+      public: class SampleBatch
+      {
+        /// \brief Publisher of the batches.
+        public: transport::PublisherPtr pub;
+
+        /// \brief Samples collected so far.
+        public: msgs::SensorBatch msg;
+      };
+
+      /// \brief Number of samples in each batch, 1 to disable batching.
+      public: unsigned int batchSize = 1;
+
+      /// \brief Batches, by sensor topic. Protected by batchMutex.
+      public: std::map<std::string, SampleBatch> batches;
+
+      /// \brief Protects batchSize and batches.
+      public: mutable std::mutex batchMutex;
+
+      /// \brief Snapshot given to the update in progress.
+      public: physics::WorldSnapshotPtr updateSnapshot;
+
       /// \brief An SDF pointer that allows us to only read the sensor.sdf
       /// file once, which in turns limits disk reads.
       public: static sdf::ElementPtr sdfSensor;
@@ -50,6 +50,7 @@ namespace gazebo
     class Noise;
     class GaussianNoiseModel;
     class ImageGaussianNoiseModel;
+    class RangeGaussianNoiseModel;
     class WideAngleCameraSensor;
     class WirelessTransceiver;
     class WirelessTransmitter;
@@ -131,6 +132,10 @@ namespace gazebo
     typedef std::shared_ptr<ImageGaussianNoiseModel>
         ImageGaussianNoiseModelPtr;
 
+    /// \brief Shared pointer to Noise
+    typedef std::shared_ptr<RangeGaussianNoiseModel>
+        RangeGaussianNoiseModelPtr;
+
     /// \def WirelessTransceiverPtr
     /// \brief Shared pointer to WirelessTransceiver
     typedef std::shared_ptr<WirelessTransceiver> WirelessTransceiverPtr;
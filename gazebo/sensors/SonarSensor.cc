@@ -16,9 +16,9 @@
 */
 #include <boost/algorithm/string.hpp>
 
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Vector3.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/SurfaceParams.hh"
 #include "gazebo/physics/MeshShape.hh"
@@ -46,6 +46,7 @@ SonarSensor::SonarSensor()
   dataPtr(new SonarSensorPrivate)
 {
   this->dataPtr->emptyContactCount = 0;
+  this->dataPtr->update.SetName("sonarUpdate");
 }
 
 //////////////////////////////////////////////////
@@ -230,8 +231,8 @@ void SonarSensor::Init()
   msgs::Set(this->dataPtr->sonarMsg.mutable_time(), this->world->SimTime());
   this->dataPtr->sonarMsg.mutable_sonar()->set_range(this->dataPtr->rangeMax);
 
-  if (this->dataPtr->sonarPub)
-    this->dataPtr->sonarPub->Publish(this->dataPtr->sonarMsg);
+  this->PublishSample(this->dataPtr->sonarPub, this->dataPtr->sonarMsg,
+      msgs::Convert(this->dataPtr->sonarMsg.time()));
 }
 
 //////////////////////////////////////////////////
@@ -356,8 +357,8 @@ bool SonarSensor::UpdateImpl(const bool /*_force*/)
   IGN_PROFILE_BEGIN("Publish");
   this->dataPtr->update(this->dataPtr->sonarMsg);
 
-  if (this->dataPtr->sonarPub)
-    this->dataPtr->sonarPub->Publish(this->dataPtr->sonarMsg);
+  this->PublishSample(this->dataPtr->sonarPub, this->dataPtr->sonarMsg,
+      msgs::Convert(this->dataPtr->sonarMsg.time()));
   IGN_PROFILE_END();
 
   return true;
@@ -366,7 +367,8 @@ bool SonarSensor::UpdateImpl(const bool /*_force*/)
 //////////////////////////////////////////////////
 bool SonarSensor::IsActive() const
 {
-  return Sensor::IsActive() || this->dataPtr->sonarPub->HasConnections();
+  return Sensor::IsActive() ||
+    this->HasSampleConnections(this->dataPtr->sonarPub);
 }
 
 //////////////////////////////////////////////////
@@ -19,11 +19,10 @@
 
 #include <boost/algorithm/string.hpp>
 
-#include <ignition/common/Profiler.hh>
-
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Image.hh"
+#include "gazebo/common/TraceCapture.hh"
 
 #include "gazebo/transport/transport.hh"
 #include "gazebo/msgs/msgs.hh"
@@ -14,9 +14,9 @@
  * limitations under the License.
  *
 */
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Pose3.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/sensors/SensorManager.hh"
@@ -18,6 +18,7 @@
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/physics.hh"
+#include "gazebo/physics/ModelBoxIndex.hh"
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publisher.hh"
@@ -37,6 +38,9 @@ const double WirelessTransmitterPrivate::ModelStdDev = 6.0;
 const double WirelessTransmitterPrivate::Step = 1.0;
 const double WirelessTransmitterPrivate::MaxRadius = 10.0;
 
+/// \brief Largest number of cached occlusion tests per transmitter.
+static const size_t kMaxCachedOcclusions = 4096;
+
 /////////////////////////////////////////////////
 WirelessTransmitter::WirelessTransmitter()
 : WirelessTransceiver(),
@@ -83,6 +87,9 @@ void WirelessTransmitter::Init()
   // between the transmitter and a given point.
   this->dataPtr->testRay = boost::dynamic_pointer_cast<RayShape>(
       this->world->Physics()->CreateShape("ray", CollisionPtr()));
+
+  // Tells which occlusion tests are still valid
+  this->world->SetBoxIndexEnabled(true);
 }
 
 //////////////////////////////////////////////////
@@ -160,21 +167,71 @@ double WirelessTransmitter::SignalStrength(
     end.Z() += 0.00001;
   }
 
-  // Acquire the mutex for avoiding race condition with the physics engine
-  boost::recursive_mutex::scoped_lock lock(*(
-        this->world->Physics()->GetPhysicsUpdateMutex()));
-
   // Compute the value of n depending on the obstacles between Tx and Rx
   double n = WirelessTransmitterPrivate::NEmpty;
 
-  // Looking for obstacles between start and end points
-  this->dataPtr->testRay->SetPoints(start, end);
-  this->dataPtr->testRay->GetIntersection(dist, entityName);
+  // Reuse the last test of this ray while nothing moves around it. Static
+  // surroundings make the visualization grid a precomputed radio map.
+  physics::ModelBoxIndexPtr boxIndex = this->world->BoxIndex();
+  bool cached = false;
+  uint64_t change = 0;
+  const auto key = std::make_tuple(end.X(), end.Y(), end.Z());
+  if (boxIndex)
+  {
+    ignition::math::Vector3d low = start;
+    ignition::math::Vector3d high = start;
+    low.Min(end);
+    high.Max(end);
+    change = boxIndex->LastChange(ignition::math::AxisAlignedBox(low, high));
+
+    std::lock_guard<std::mutex> cacheLock(this->dataPtr->cacheMutex);
+    if (this->dataPtr->cachePosition != start ||
+        this->dataPtr->occlusionCache.size() >= kMaxCachedOcclusions)
+    {
+      this->dataPtr->occlusionCache.clear();
+      this->dataPtr->cachePosition = start;
+    }
+
+    auto entry = this->dataPtr->occlusionCache.find(key);
+    if (entry != this->dataPtr->occlusionCache.end() &&
+        entry->second.change == change)
+    {
+      ++this->dataPtr->cacheHits;
+      if (entry->second.occluded)
+        n = WirelessTransmitterPrivate::NObstacle;
+      cached = true;
+    }
+  }
 
-  // ToDo: The ray intersects with my own collision model. Fix it.
-  if (entityName != "")
+  if (!cached)
   {
-    n = WirelessTransmitterPrivate::NObstacle;
+    {
+      // Acquire the mutex for avoiding race condition with the physics
+      // engine
+      boost::recursive_mutex::scoped_lock lock(*(
+            this->world->Physics()->GetPhysicsUpdateMutex()));
+
+      // Looking for obstacles between start and end points
+      this->dataPtr->testRay->SetPoints(start, end);
+      this->dataPtr->testRay->GetIntersection(dist, entityName);
+    }
+
+    // ToDo: The ray intersects with my own collision model. Fix it.
+    if (entityName != "")
+    {
+      n = WirelessTransmitterPrivate::NObstacle;
+    }
+
+    if (boxIndex)
+    {
+      std::lock_guard<std::mutex> cacheLock(this->dataPtr->cacheMutex);
+      ++this->dataPtr->cacheMisses;
+      if (this->dataPtr->cachePosition == start)
+      {
+        this->dataPtr->occlusionCache[key] =
+          {entityName != "", change};
+      }
+    }
   }
 
   double distance = std::max(1.0,
@@ -190,6 +247,13 @@ double WirelessTransmitter::SignalStrength(
   return rxPower;
 }
 
+/////////////////////////////////////////////////
+uint64_t WirelessTransmitter::OcclusionCacheHits() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->cacheMutex);
+  return this->dataPtr->cacheHits;
+}
+
 /////////////////////////////////////////////////
 double WirelessTransmitter::ModelStdDev() const
 {
@@ -73,6 +73,13 @@ namespace gazebo
       /// \return The standard deviation of the propagation model.
       public: double ModelStdDev() const;
 
+      /// \brief Get the number of SignalStrength calls that reused a cached
+      /// occlusion test instead of casting a ray. A test stays valid while
+      /// the transmitter stays in place and no model moves around the ray,
+      /// see physics::ModelBoxIndex::LastChange.
+      /// \return Number of cache hits.
+      public: uint64_t OcclusionCacheHits() const;
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<WirelessTransmitterPrivate> dataPtr;
@@ -17,7 +17,12 @@
 #ifndef _GAZEBO_SENSORS_WIRELESSTRANSMITTER_PRIVATE_HH_
 #define _GAZEBO_SENSORS_WIRELESSTRANSMITTER_PRIVATE_HH_
 
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <ignition/math/Vector3.hh>
 #include "gazebo/physics/PhysicsTypes.hh"
 
 namespace gazebo
@@ -59,6 +64,36 @@ namespace gazebo
 
       // \brief Ray used to test for collisions when placing entities
       public: physics::RayShapePtr testRay;
+
+      /// \brief Result of an occlusion test between the transmitter and a
+      /// receiver position.
+      public: struct Occlusion
+              {
+                /// \brief True if an entity is on the way.
+                bool occluded;
+
+                /// \brief ModelBoxIndex::LastChange around the ray when
+                /// the test was made.
+                uint64_t change;
+              };
+
+      /// \brief Occlusion tests by receiver position, valid for
+      /// cachePosition while nothing moves around the ray.
+      public: std::map<std::tuple<double, double, double>, Occlusion>
+              occlusionCache;
+
+      /// \brief Transmitter position of the cached occlusion tests.
+      public: ignition::math::Vector3d cachePosition;
+
+      /// \brief Protects the occlusion cache, receivers query the
+      /// transmitter from their own update.
+      public: std::mutex cacheMutex;
+
+      /// \brief Number of occlusion tests answered by the cache.
+      public: uint64_t cacheHits = 0;
+
+      /// \brief Number of occlusion tests cast through the physics engine.
+      public: uint64_t cacheMisses = 0;
     };
   }
 }
@@ -157,6 +157,9 @@ void WirelessTransmitter_TEST::TestSignalStrength()
   signStrengthAvg /= samples;
 
   EXPECT_NEAR(signStrengthAvg, -62.0, this->tx->ModelStdDev());
+
+  // Nothing moves, the occlusion test is reused
+  EXPECT_GT(this->tx->OcclusionCacheHits(), 0u);
 }
 
 /////////////////////////////////////////////////
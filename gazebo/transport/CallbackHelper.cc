@@ -15,6 +15,8 @@
  *
 */
 
+#include <algorithm>
+
 #include "gazebo/transport/CallbackHelper.hh"
 
 using namespace gazebo;
@@ -22,6 +24,20 @@ using namespace transport;
 
 unsigned int CallbackHelper::idCounter = 0;
 
+/////////////////////////////////////////////////
+void SubscriptionQoS::Merge(const SubscriptionQoS &_other)
+{
+  if (this->maxRate > 0)
+    this->maxRate = _other.maxRate > 0 ?
+        std::max(this->maxRate, _other.maxRate) : 0;
+
+  this->keepLatest = this->keepLatest && _other.keepLatest;
+
+  if (this->queueDepth > 0)
+    this->queueDepth = _other.queueDepth > 0 ?
+        std::max(this->queueDepth, _other.queueDepth) : 0;
+}
+
 /////////////////////////////////////////////////
 CallbackHelper::CallbackHelper(bool _latching)
   : latching(_latching), id(idCounter++)
@@ -58,3 +74,25 @@ unsigned int CallbackHelper::GetId() const
 {
   return this->id;
 }
+
+/////////////////////////////////////////////////
+bool CallbackHelper::HandleBuffer(
+    const std::shared_ptr<const std::string> &_newdata,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  return this->HandleData(*_newdata, _cb, _id);
+}
+
+/////////////////////////////////////////////////
+SubscriptionQoS CallbackHelper::QoS() const
+{
+  std::lock_guard<std::mutex> lock(this->latchingMutex);
+  return this->qos;
+}
+
+/////////////////////////////////////////////////
+void CallbackHelper::SetQoS(const SubscriptionQoS &_qos)
+{
+  std::lock_guard<std::mutex> lock(this->latchingMutex);
+  this->qos = _qos;
+}
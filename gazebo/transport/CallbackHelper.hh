@@ -21,6 +21,7 @@
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <mutex>
@@ -39,6 +40,33 @@ namespace gazebo
     /// \addtogroup gazebo_transport Transport
     /// \{
 
+    /// \class SubscriptionQoS CallbackHelper.hh transport/transport.hh
+    /// \brief Quality of service of a remote subscription. It is sent to
+    /// the publisher with the subscription, and the publisher enforces it
+    /// before a message is queued on the connection, so that messages
+    /// which would be dropped are never sent.
+    class GZ_TRANSPORT_VISIBLE SubscriptionQoS
+    {
+      /// \brief Combine with the QoS of another subscription sharing the
+      /// same connection. The result is the least restrictive of the two.
+      /// \param[in] _other QoS of the other subscription.
+      public: void Merge(const SubscriptionQoS &_other);
+
+      /// \brief Largest number of messages per second, zero for no limit.
+      /// Messages published faster are dropped.
+      public: double maxRate = 0;
+
+      /// \brief If true, messages waiting on a slow connection are dropped
+      /// in favour of newer ones, so that at most queueDepth messages (at
+      /// least one) wait. If false, new messages are dropped while
+      /// queueDepth messages wait.
+      public: bool keepLatest = false;
+
+      /// \brief Largest number of messages waiting on the connection, zero
+      /// for no limit.
+      public: unsigned int queueDepth = 0;
+    };
+
     /// \class CallbackHelper CallbackHelper.hh transport/transport.hh
     /// \brief A helper class to handle callbacks when messages arrive
     class GZ_TRANSPORT_VISIBLE CallbackHelper
@@ -64,6 +92,19 @@ namespace gazebo
       public: virtual bool HandleData(const std::string &_newdata,
                   boost::function<void(uint32_t)> _cb, uint32_t _id) = 0;
 
+      /// \brief Process new incoming data held in a shared buffer. The
+      /// buffer is shared by all the callbacks of a publication, so a
+      /// callback that keeps the data must keep the pointer instead of
+      /// copying it. By default this calls HandleData.
+      /// \param[in] _newdata Incoming data to be processed
+      /// \return true if successfully processed; false otherwise
+      /// \param[in] _cb If non-null, callback to be invoked which signals
+      /// that transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      public: virtual bool HandleBuffer(
+                  const std::shared_ptr<const std::string> &_newdata,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       /// \brief Process new incoming message
       /// \param[in] _newMsg Incoming message to be processed
       /// \return true if successfully processed; false otherwise
@@ -87,10 +128,21 @@ namespace gazebo
       /// \return The unique ID of this callback.
       public: unsigned int GetId() const;
 
+      /// \brief Get the quality of service of this callback.
+      /// \return The quality of service.
+      public: SubscriptionQoS QoS() const;
+
+      /// \brief Set the quality of service of this callback.
+      /// \param[in] _qos The quality of service.
+      public: void SetQoS(const SubscriptionQoS &_qos);
+
       /// \brief True means that the callback helper will get the last
       /// published message on the topic.
       protected: bool latching;
 
+      /// \brief Quality of service of the subscription.
+      protected: SubscriptionQoS qos;
+
       /// \brief Mutex to protect the latching variable.
       protected: mutable std::mutex latchingMutex;
 
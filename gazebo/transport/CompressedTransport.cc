@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/CompressedTransport.hh"
+#include "gazebo/transport/ShmTransport.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+namespace
+{
+  /// \brief Prefix of a compressed message. Starts with a zero byte, which
+  /// is not a valid protobuf field tag.
+  const char kMagic[] = {'\0', 'G', 'Z', 'Z', 'L', 'B'};
+
+  /// \brief Size of the header: magic, flags and raw size.
+  const std::size_t kHeaderSize = sizeof(kMagic) + 1 + 4;
+
+  /// \brief Flag of a message compressed on its own.
+  const char kIndependent = 1;
+
+  /// \brief Smallest message that is compressed.
+  const std::size_t kMinSize = 32;
+
+  /// \brief Tail of a sync flush, which is stripped from the messages.
+  const char kSyncTail[] = {'\0', '\0', '\xff', '\xff'};
+
+  /// \brief Process wide statistics, in nanoseconds for the times.
+  std::atomic<uint64_t> compressedMessages(0);
+  std::atomic<uint64_t> rawBytes(0);
+  std::atomic<uint64_t> compressedBytes(0);
+  std::atomic<uint64_t> compressNs(0);
+  std::atomic<uint64_t> decompressedMessages(0);
+  std::atomic<uint64_t> decompressNs(0);
+
+  /////////////////////////////////////////////////
+  /// \brief Get the nanoseconds elapsed since a time.
+  /// \param[in] _start Start time.
+  /// \return Nanoseconds.
+  uint64_t ElapsedNs(const std::chrono::steady_clock::time_point &_start)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - _start).count();
+  }
+}
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Private data for MessageCompressor.
+    class MessageCompressorPrivate
+    {
+      /// \brief Deflate stream.
+      public: z_stream stream;
+
+      /// \brief True if the stream was initialized.
+      public: bool valid = false;
+
+      /// \brief True if the next message must be compressed on its own,
+      /// because the stream history differs from the subscriber's.
+      public: bool needReset = true;
+    };
+
+    /// \internal
+    /// \brief Private data for MessageDecompressor.
+    class MessageDecompressorPrivate
+    {
+      /// \brief Inflate stream.
+      public: z_stream stream;
+
+      /// \brief True if the stream was initialized.
+      public: bool valid = false;
+
+      /// \brief Compressed data followed by the sync flush tail.
+      public: std::string input;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+double CompressionStatistics::Ratio() const
+{
+  if (this->compressedBytes == 0)
+    return 1.0;
+  return static_cast<double>(this->rawBytes) / this->compressedBytes;
+}
+
+/////////////////////////////////////////////////
+int transport::CompressionRequested(const std::string &_topic,
+    const ConnectionPtr &_conn)
+{
+  const char *env = std::getenv("GAZEBO_TRANSPORT_COMPRESSION");
+  if (!env || !*env || !_conn || ShmConnectionIsLocal(_conn))
+    return 0;
+
+  const int level = std::atoi(env);
+  if (level < 1 || level > 9)
+    return 0;
+
+  const char *topicsEnv = std::getenv("GAZEBO_TRANSPORT_COMPRESSION_TOPICS");
+  if (!topicsEnv || !*topicsEnv)
+    return level;
+
+  std::vector<std::string> topics;
+  boost::split(topics, topicsEnv, boost::is_any_of(","));
+  for (auto topic : topics)
+  {
+    boost::trim(topic);
+    if (topic.empty())
+      continue;
+
+    if ((topic[0] == '/' && _topic == topic) ||
+        (topic[0] != '/' && boost::ends_with(_topic, "/" + topic)))
+    {
+      return level;
+    }
+  }
+  return 0;
+}
+
+/////////////////////////////////////////////////
+CompressionStatistics transport::TransportCompressionStatistics()
+{
+  CompressionStatistics stats;
+  stats.compressedMessages = compressedMessages;
+  stats.rawBytes = rawBytes;
+  stats.compressedBytes = compressedBytes;
+  stats.compressTime = compressNs * 1e-9;
+  stats.decompressedMessages = decompressedMessages;
+  stats.decompressTime = decompressNs * 1e-9;
+  return stats;
+}
+
+/////////////////////////////////////////////////
+MessageCompressor::MessageCompressor(const int _level)
+  : dataPtr(new MessageCompressorPrivate)
+{
+  std::memset(&this->dataPtr->stream, 0, sizeof(z_stream));
+
+  // Raw deflate, the header and checksum of zlib would be sent with every
+  // message.
+  this->dataPtr->valid = deflateInit2(&this->dataPtr->stream,
+      std::max(1, std::min(9, _level)), Z_DEFLATED, -15, 8,
+      Z_DEFAULT_STRATEGY) == Z_OK;
+  if (!this->dataPtr->valid)
+    gzerr << "Unable to initialize message compression\n";
+}
+
+/////////////////////////////////////////////////
+MessageCompressor::~MessageCompressor()
+{
+  if (this->dataPtr->valid)
+    deflateEnd(&this->dataPtr->stream);
+}
+
+/////////////////////////////////////////////////
+bool MessageCompressor::Compress(const std::string &_data,
+    const bool _independent, std::string &_out)
+{
+  if (!this->dataPtr->valid || _data.size() < kMinSize ||
+      _data.size() > 0xFFFFFFFFu)
+  {
+    return false;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  z_stream &z = this->dataPtr->stream;
+  const bool independent = _independent || this->dataPtr->needReset;
+  if (independent)
+    deflateReset(&z);
+
+  const uint32_t size = static_cast<uint32_t>(_data.size());
+  _out.assign(kMagic, sizeof(kMagic));
+  _out.push_back(independent ? kIndependent : 0);
+  for (int i = 0; i < 4; ++i)
+    _out.push_back(static_cast<char>((size >> (8 * i)) & 0xFF));
+
+  z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(_data.data()));
+  z.avail_in = size;
+
+  // The flush is complete once deflate leaves room in the output.
+  std::size_t used = kHeaderSize;
+  do
+  {
+    _out.resize(used + std::max<std::size_t>(
+          deflateBound(&z, z.avail_in) + 16, 1024));
+    z.next_out = reinterpret_cast<Bytef *>(&_out[used]);
+    z.avail_out = static_cast<uInt>(_out.size() - used);
+
+    if (deflate(&z, Z_SYNC_FLUSH) == Z_STREAM_ERROR)
+    {
+      this->dataPtr->needReset = true;
+      return false;
+    }
+    used = _out.size() - z.avail_out;
+  }
+  while (z.avail_out == 0);
+  this->dataPtr->needReset = false;
+
+  // Every message ends with the same sync flush tail.
+  if (used >= kHeaderSize + sizeof(kSyncTail) &&
+      std::memcmp(&_out[used - sizeof(kSyncTail)], kSyncTail,
+        sizeof(kSyncTail)) == 0)
+  {
+    used -= sizeof(kSyncTail);
+  }
+  _out.resize(used);
+
+  ++compressedMessages;
+  rawBytes += _data.size();
+  compressedBytes += _out.size();
+  compressNs += ElapsedNs(start);
+  return true;
+}
+
+/////////////////////////////////////////////////
+MessageDecompressor::MessageDecompressor()
+  : dataPtr(new MessageDecompressorPrivate)
+{
+  std::memset(&this->dataPtr->stream, 0, sizeof(z_stream));
+  this->dataPtr->valid =
+    inflateInit2(&this->dataPtr->stream, -15) == Z_OK;
+  if (!this->dataPtr->valid)
+    gzerr << "Unable to initialize message decompression\n";
+}
+
+/////////////////////////////////////////////////
+MessageDecompressor::~MessageDecompressor()
+{
+  if (this->dataPtr->valid)
+    inflateEnd(&this->dataPtr->stream);
+}
+
+/////////////////////////////////////////////////
+bool MessageDecompressor::IsCompressed(const std::string &_data)
+{
+  return _data.size() >= kHeaderSize &&
+    _data.compare(0, sizeof(kMagic), kMagic, sizeof(kMagic)) == 0;
+}
+
+/////////////////////////////////////////////////
+bool MessageDecompressor::Decompress(const std::string &_data,
+    std::string &_out)
+{
+  if (!this->dataPtr->valid || !IsCompressed(_data))
+    return false;
+
+  const auto start = std::chrono::steady_clock::now();
+
+  z_stream &z = this->dataPtr->stream;
+  if (_data[sizeof(kMagic)] & kIndependent)
+    inflateReset(&z);
+
+  uint32_t size = 0;
+  for (int i = 0; i < 4; ++i)
+  {
+    size |= static_cast<uint32_t>(
+        static_cast<unsigned char>(_data[sizeof(kMagic) + 1 + i])) << (8 * i);
+  }
+
+  std::string &input = this->dataPtr->input;
+  input.assign(_data, kHeaderSize, std::string::npos);
+  input.append(kSyncTail, sizeof(kSyncTail));
+
+  // One spare byte tells a complete message from a truncated one.
+  _out.resize(static_cast<std::size_t>(size) + 1);
+  z.next_in = reinterpret_cast<Bytef *>(&input[0]);
+  z.avail_in = static_cast<uInt>(input.size());
+  z.next_out = reinterpret_cast<Bytef *>(&_out[0]);
+  z.avail_out = static_cast<uInt>(_out.size());
+
+  const int ret = inflate(&z, Z_SYNC_FLUSH);
+  if ((ret != Z_OK && ret != Z_BUF_ERROR) || z.avail_in != 0 ||
+      z.avail_out != 1)
+  {
+    return false;
+  }
+  _out.resize(size);
+
+  ++decompressedMessages;
+  decompressNs += ElapsedNs(start);
+  return true;
+}
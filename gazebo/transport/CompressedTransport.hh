@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_COMPRESSEDTRANSPORT_HH_
+#define GAZEBO_TRANSPORT_COMPRESSEDTRANSPORT_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/transport/TransportTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Compression of the messages sent to remote subscribers, for
+    /// clients connected over slow links.
+    ///
+    /// A subscriber asks for compression in its msgs::Subscribe request
+    /// when GAZEBO_TRANSPORT_COMPRESSION is set to a zlib level from 1 to
+    /// 9, and the publisher's connection is not local. Set
+    /// GAZEBO_TRANSPORT_COMPRESSION_TOPICS to a comma separated list of
+    /// topic names, or of topic suffixes when they don't start with a
+    /// slash, to only compress those topics.
+    ///
+    /// The publisher keeps one deflate stream per subscription and flushes
+    /// it after each message. Each message is compressed against the ones
+    /// sent before, which act as the dictionary of small, repetitive
+    /// messages such as poses. Subscriptions that drop queued messages
+    /// (keep latest) compress each message on its own instead. Messages
+    /// of less than 32 bytes are sent as they are.
+
+    /// \brief Statistics of the compression done by this process.
+    class GZ_TRANSPORT_VISIBLE CompressionStatistics
+    {
+      /// \brief Number of messages compressed.
+      public: uint64_t compressedMessages = 0;
+
+      /// \brief Size of the compressed messages before compression.
+      public: uint64_t rawBytes = 0;
+
+      /// \brief Size of the compressed messages after compression.
+      public: uint64_t compressedBytes = 0;
+
+      /// \brief Seconds spent compressing.
+      public: double compressTime = 0;
+
+      /// \brief Number of messages decompressed.
+      public: uint64_t decompressedMessages = 0;
+
+      /// \brief Seconds spent decompressing.
+      public: double decompressTime = 0;
+
+      /// \brief Get the compression ratio.
+      /// \return Raw bytes divided by compressed bytes, 1 if nothing was
+      /// compressed.
+      public: double Ratio() const;
+    };
+
+    /// \brief Get the zlib level subscribers should request for a topic.
+    /// \param[in] _topic Fully qualified topic name.
+    /// \param[in] _conn Connection to the publisher.
+    /// \return Level from 1 to 9, or 0 for no compression.
+    GZ_TRANSPORT_VISIBLE
+    int CompressionRequested(const std::string &_topic,
+        const ConnectionPtr &_conn);
+
+    /// \brief Get the statistics of the compression done by this process,
+    /// over all topics.
+    /// \return Statistics.
+    GZ_TRANSPORT_VISIBLE
+    CompressionStatistics TransportCompressionStatistics();
+
+    // Forward declare private data classes
+    class MessageCompressorPrivate;
+    class MessageDecompressorPrivate;
+
+    /// \internal
+    /// \brief Publisher side of the compression.
+    class GZ_TRANSPORT_VISIBLE MessageCompressor
+    {
+      /// \brief Constructor.
+      /// \param[in] _level zlib level from 1 to 9.
+      public: explicit MessageCompressor(const int _level);
+
+      /// \brief Destructor.
+      public: ~MessageCompressor();
+
+      /// \brief Compress a message.
+      /// \param[in] _data Serialized message.
+      /// \param[in] _independent True to compress the message on its own,
+      /// for subscriptions that may drop it.
+      /// \param[out] _out Compressed message.
+      /// \return False if the message is too small, or couldn't be
+      /// compressed. _data must then be sent as it is.
+      public: bool Compress(const std::string &_data, const bool _independent,
+                  std::string &_out);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MessageCompressorPrivate> dataPtr;
+    };
+
+    /// \internal
+    /// \brief Subscriber side of the compression.
+    class GZ_TRANSPORT_VISIBLE MessageDecompressor
+    {
+      /// \brief Constructor.
+      public: MessageDecompressor();
+
+      /// \brief Destructor.
+      public: ~MessageDecompressor();
+
+      /// \brief Check if data received over a socket is compressed.
+      /// Serialized protobuf messages never start with a zero byte, so
+      /// compressed data can not be confused with a message.
+      /// \param[in] _data Data received over the socket.
+      /// \return True if _data is compressed.
+      public: static bool IsCompressed(const std::string &_data);
+
+      /// \brief Decompress a message. Messages must be decompressed in the
+      /// order they were compressed.
+      /// \param[in] _data Compressed message.
+      /// \param[out] _out Serialized message.
+      /// \return False if the data is corrupted.
+      public: bool Decompress(const std::string &_data, std::string &_out);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MessageDecompressorPrivate> dataPtr;
+    };
+  }
+}
+#endif
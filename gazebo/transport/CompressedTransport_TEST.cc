@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/CompressedTransport.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class CompressedTransport : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Serialize the poses of a few models.
+/// \param[in] _step Step that moves the models.
+/// \return Serialized msgs::PosesStamped.
+static std::string Poses(const int _step)
+{
+  msgs::PosesStamped msg;
+  msgs::Set(msg.mutable_time(), common::Time(_step, 0));
+  for (int i = 0; i < 5; ++i)
+  {
+    msgs::Pose *pose = msg.add_pose();
+    pose->set_name("model_" + std::to_string(i));
+    pose->set_id(i);
+    msgs::Set(pose, ignition::math::Pose3d(i, _step * 0.001, 0.5, 0, 0, 0));
+  }
+  return msg.SerializeAsString();
+}
+
+/////////////////////////////////////////////////
+TEST_F(CompressedTransport, Stream)
+{
+  transport::MessageCompressor compressor(1);
+  transport::MessageDecompressor decompressor;
+
+  // Tiny messages are sent as they are.
+  std::string out;
+  EXPECT_FALSE(compressor.Compress("pose", false, out));
+
+  const transport::CompressionStatistics before =
+    transport::TransportCompressionStatistics();
+
+  for (int i = 0; i < 50; ++i)
+  {
+    const std::string data = Poses(i);
+    EXPECT_FALSE(transport::MessageDecompressor::IsCompressed(data));
+
+    ASSERT_TRUE(compressor.Compress(data, false, out));
+    EXPECT_TRUE(transport::MessageDecompressor::IsCompressed(out));
+
+    // Messages after the first are compressed against the previous ones.
+    if (i > 0)
+      EXPECT_LT(out.size(), data.size() / 3) << i;
+
+    std::string decompressed;
+    ASSERT_TRUE(decompressor.Decompress(out, decompressed)) << i;
+    EXPECT_EQ(decompressed, data);
+  }
+
+  const transport::CompressionStatistics after =
+    transport::TransportCompressionStatistics();
+  EXPECT_EQ(after.compressedMessages - before.compressedMessages, 50u);
+  EXPECT_EQ(after.decompressedMessages - before.decompressedMessages, 50u);
+  EXPECT_GT(after.rawBytes - before.rawBytes,
+      3 * (after.compressedBytes - before.compressedBytes));
+  EXPECT_GT(after.Ratio(), 1.0);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CompressedTransport, Independent)
+{
+  transport::MessageCompressor compressor(6);
+
+  std::string first, second, third;
+  ASSERT_TRUE(compressor.Compress(Poses(0), false, first));
+  ASSERT_TRUE(compressor.Compress(Poses(1), false, second));
+  ASSERT_TRUE(compressor.Compress(Poses(2), true, third));
+
+  // A message that follows a dropped one can't be decompressed, unless it
+  // was compressed on its own.
+  transport::MessageDecompressor decompressor;
+  std::string out;
+  EXPECT_FALSE(decompressor.Decompress(second, out));
+
+  transport::MessageDecompressor other;
+  ASSERT_TRUE(other.Decompress(third, out));
+  EXPECT_EQ(out, Poses(2));
+
+  // Corrupted data is rejected.
+  std::string corrupted = third;
+  corrupted.resize(corrupted.size() - 3);
+  EXPECT_FALSE(other.Decompress(corrupted, out));
+  EXPECT_FALSE(other.Decompress(Poses(3), out));
+}
+
+/////////////////////////////////////////////////
+TEST_F(CompressedTransport, Large)
+{
+  msgs::Image msg;
+  msg.set_width(320);
+  msg.set_height(240);
+  msg.set_pixel_format(3);
+  msg.set_step(320 * 3);
+  std::string pixels(320 * 240 * 3, '\0');
+  for (std::size_t i = 0; i < pixels.size(); ++i)
+    pixels[i] = static_cast<char>((i / 3) % 320);
+  msg.set_data(pixels);
+  const std::string data = msg.SerializeAsString();
+
+  transport::MessageCompressor compressor(1);
+  transport::MessageDecompressor decompressor;
+  std::string out, decompressed;
+  ASSERT_TRUE(compressor.Compress(data, false, out));
+  EXPECT_LT(out.size(), data.size() / 4);
+  ASSERT_TRUE(decompressor.Decompress(out, decompressed));
+  EXPECT_EQ(decompressed, data);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CompressedTransport, Requested)
+{
+  unsetenv("GAZEBO_TRANSPORT_COMPRESSION");
+  EXPECT_EQ(transport::CompressionRequested("/gazebo/default/pose/info",
+        transport::ConnectionPtr()), 0);
+
+  // There is no connection to compress.
+  setenv("GAZEBO_TRANSPORT_COMPRESSION", "1", 1);
+  EXPECT_EQ(transport::CompressionRequested("/gazebo/default/pose/info",
+        transport::ConnectionPtr()), 0);
+  unsetenv("GAZEBO_TRANSPORT_COMPRESSION");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
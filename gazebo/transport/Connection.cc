@@ -47,6 +47,7 @@
 #endif
 
 #include <stdio.h>
+#include <algorithm>
 #include <stdlib.h>
 
 #include <boost/bind/bind.hpp>
@@ -94,6 +95,7 @@ Connection::Connection()
     iomanager = new IOManager();
 
   this->socket = new boost::asio::ip::tcp::socket(iomanager->GetIO());
+  this->strand = new boost::asio::io_service::strand(iomanager->GetIO());
 
   iomanager->IncCount();
   this->id = idCounter++;
@@ -126,6 +128,9 @@ Connection::~Connection()
 {
   this->Shutdown();
 
+  delete this->strand;
+  this->strand = NULL;
+
   if (iomanager)
   {
     iomanager->DecCount();
@@ -185,9 +190,9 @@ bool Connection::Connect(const std::string &_host, unsigned int _port)
 
   // Use async connect so that we can use a custom timeout. This is useful
   // when trying to detect network errors.
-  this->socket->async_connect(*endpointIter++,
+  this->socket->async_connect(*endpointIter++, this->strand->wrap(
       common::weakBind(&Connection::OnConnect, this->shared_from_this(),
-        boost::asio::placeholders::error, endpointIter));
+        boost::asio::placeholders::error, endpointIter)));
 
   // Wait for at most 60 seconds for a connection to be established.
   // The connectionCondition notification occurs in ::OnConnect.
@@ -233,8 +238,9 @@ void Connection::Listen(unsigned int port, const AcceptCallback &_acceptCB)
   this->acceptConn = ConnectionPtr(new Connection());
 
   this->acceptor->async_accept(*this->acceptConn->socket,
-      common::weakBind(&Connection::OnAccept, this->shared_from_this(),
-                  boost::asio::placeholders::error));
+      this->strand->wrap(
+        common::weakBind(&Connection::OnAccept, this->shared_from_this(),
+                    boost::asio::placeholders::error)));
 }
 
 //////////////////////////////////////////////////
@@ -262,8 +268,9 @@ void Connection::OnAccept(const boost::system::error_code &e)
     this->acceptConn = ConnectionPtr(new Connection());
 
     this->acceptor->async_accept(*this->acceptConn->socket,
-        common::weakBind(&Connection::OnAccept, this->shared_from_this(),
-          boost::asio::placeholders::error));
+        this->strand->wrap(
+          common::weakBind(&Connection::OnAccept, this->shared_from_this(),
+            boost::asio::placeholders::error)));
   }
   else
   {
@@ -303,26 +310,39 @@ void Connection::EnqueueMsg(const std::string &_buffer,
     return;
   }
 
-  char headerBuffer[HEADER_LENGTH + 1];
-  snprintf(headerBuffer, HEADER_LENGTH + 1, "%08x",
-      static_cast<unsigned int>(_buffer.size()));
+  this->EnqueueMsg(std::make_shared<const std::string>(_buffer), _cb, _id,
+      _force);
+}
+
+//////////////////////////////////////////////////
+void Connection::EnqueueMsg(const std::shared_ptr<const std::string> &_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id, bool _force)
+{
+  // Don't enqueue empty messages
+  if (!_buffer || _buffer->empty() || !this->IsOpen())
+  {
+    return;
+  }
 
   {
     boost::recursive_mutex::scoped_lock lock(this->writeMutex);
 
+    // Small messages are batched. The 4096 byte limit also keeps the
+    // number of buffers in a gather write well below IOV_MAX.
     if (this->writeQueue.empty() ||
         (this->writeCount > 0 && this->writeQueue.size() == 1) ||
-        (this->writeQueue.back().size() + HEADER_LENGTH + _buffer.size() >
+        (this->writeQueue.back().size + HEADER_LENGTH + _buffer->size() >
          4096))
     {
-      this->writeQueue.push_back(std::string(headerBuffer) + _buffer);
+      this->writeQueue.emplace_back();
       this->callbacks.push_back({std::make_pair(_cb, _id)});
     }
     else
     {
-      this->writeQueue.back() += std::string(headerBuffer) + _buffer;
       this->callbacks.back().push_back(std::make_pair(_cb, _id));
     }
+    this->writeQueue.back().Add(_buffer);
+    this->writeQueueMemory.Add(HEADER_LENGTH + _buffer->size(), 1);
   }
 
   if (_force)
@@ -361,18 +381,16 @@ void Connection::ProcessWriteQueue(bool _blocking)
   if (!_blocking)
   {
     boost::asio::async_write(*this->socket,
-        boost::asio::buffer(this->writeQueue.front().c_str(),
-          this->writeQueue.front().size()),
-          common::weakBind(&Connection::OnWrite, this->shared_from_this(),
-            boost::asio::placeholders::error));
+        this->writeQueue.front().Buffers(),
+          this->strand->wrap(
+            common::weakBind(&Connection::OnWrite, this->shared_from_this(),
+              boost::asio::placeholders::error)));
   }
   else
   {
     try
     {
-      boost::asio::write(*this->socket,
-          boost::asio::buffer(this->writeQueue.front().c_str(),
-            this->writeQueue.front().size()));
+      boost::asio::write(*this->socket, this->writeQueue.front().Buffers());
     }
     catch(...)
     {
@@ -383,6 +401,96 @@ void Connection::ProcessWriteQueue(bool _blocking)
   }
 }
 
+//////////////////////////////////////////////////
+unsigned int Connection::PendingMsgCount()
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+
+  unsigned int count = 0;
+  // The front batch is not pending while it is being written.
+  for (std::size_t i = this->writeCount > 0 ? 1 : 0;
+       i < this->writeQueue.size(); ++i)
+  {
+    count += this->writeQueue[i].payloads.size();
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+unsigned int Connection::DropPendingMsgs(const unsigned int _keep,
+    const boost::function<void(const std::string &)> &_dropped)
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+
+  unsigned int pending = this->PendingMsgCount();
+  if (pending <= _keep)
+    return 0;
+
+  unsigned int toDrop = pending - _keep;
+  unsigned int dropped = 0;
+  std::size_t first = this->writeCount > 0 ? 1 : 0;
+  while (dropped < toDrop && first < this->writeQueue.size())
+  {
+    WriteBatch &batch = this->writeQueue[first];
+    auto &batchCallbacks = this->callbacks[first];
+    std::size_t count = std::min(batch.payloads.size(),
+        static_cast<std::size_t>(toDrop - dropped));
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      batch.size -= HEADER_LENGTH + batch.payloads[i]->size();
+      this->writeQueueMemory.Add(
+          -static_cast<int64_t>(HEADER_LENGTH + batch.payloads[i]->size()),
+          -1);
+      if (!_dropped.empty())
+        _dropped(*batch.payloads[i]);
+      if (i < batchCallbacks.size() && !batchCallbacks[i].first.empty())
+        batchCallbacks[i].first(batchCallbacks[i].second);
+    }
+    batch.headers.erase(batch.headers.begin(), batch.headers.begin() + count);
+    batch.payloads.erase(batch.payloads.begin(),
+        batch.payloads.begin() + count);
+    batchCallbacks.erase(batchCallbacks.begin(), batchCallbacks.begin() +
+        std::min(count, batchCallbacks.size()));
+    dropped += count;
+
+    if (batch.payloads.empty())
+    {
+      this->writeQueue.erase(this->writeQueue.begin() + first);
+      this->callbacks.erase(this->callbacks.begin() + first);
+    }
+  }
+  return dropped;
+}
+
+//////////////////////////////////////////////////
+void Connection::WriteBatch::Add(
+    const std::shared_ptr<const std::string> &_payload)
+{
+  char headerBuffer[HEADER_LENGTH + 1];
+  snprintf(headerBuffer, HEADER_LENGTH + 1, "%08x",
+      static_cast<unsigned int>(_payload->size()));
+
+  this->headers.emplace_back();
+  std::copy(headerBuffer, headerBuffer + HEADER_LENGTH,
+      this->headers.back().begin());
+  this->payloads.push_back(_payload);
+  this->size += HEADER_LENGTH + _payload->size();
+}
+
+//////////////////////////////////////////////////
+std::vector<boost::asio::const_buffer> Connection::WriteBatch::Buffers() const
+{
+  std::vector<boost::asio::const_buffer> result;
+  result.reserve(this->payloads.size() * 2);
+  for (std::size_t i = 0; i < this->payloads.size(); ++i)
+  {
+    result.push_back(boost::asio::buffer(this->headers[i]));
+    result.push_back(boost::asio::buffer(*this->payloads[i]));
+  }
+  return result;
+}
+
 //////////////////////////////////////////////////
 std::string Connection::GetLocalURI() const
 {
@@ -408,7 +516,12 @@ void Connection::PostWrite()
   }
 
   if (!this->writeQueue.empty())
+  {
+    this->writeQueueMemory.Add(
+        -static_cast<int64_t>(this->writeQueue.front().size),
+        -static_cast<int64_t>(this->writeQueue.front().payloads.size()));
     this->writeQueue.pop_front();
+  }
   this->writeCount--;
 }
 
@@ -490,6 +603,7 @@ void Connection::Close()
 
   boost::recursive_mutex::scoped_lock lock2(this->writeMutex);
   this->writeQueue.clear();
+  this->writeQueueMemory.Clear();
   this->callbacks.clear();
 }
 
@@ -39,16 +39,19 @@
 #include <boost/thread.hpp>
 #include <boost/tuple/tuple.hpp>
 
+#include <array>
 #include <string>
 #include <vector>
 #include <iostream>
 #include <iomanip>
 #include <deque>
+#include <memory>
 #include <utility>
 
 #include "gazebo/common/Event.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/MemoryStats.hh"
 #include "gazebo/common/WeakBind.hh"
 #if TBB_VERSION_MAJOR >= 2021
 #include "gazebo/transport/TaskGroup.hh"
@@ -187,6 +190,18 @@ namespace gazebo
                   boost::function<void(uint32_t)> _cb, uint32_t _id,
                   bool _force = false);
 
+      /// \brief Write shared data to the socket. The data is not copied,
+      /// it is kept alive until it has been written to the socket.
+      /// \param[in] _buffer Data to write
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \param[in] _force If true, block until the data has been written
+      /// to the socket, otherwise just enqueue the data for asynchronous write
+      public: void EnqueueMsg(const std::shared_ptr<const std::string> &_buffer,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id,
+                  bool _force = false);
+
       /// \brief Write data to the socket
       /// \param[in] _buffer Data to write
       /// \param[in] _force If true, block until the data has been written
@@ -243,9 +258,10 @@ namespace gazebo
                 this->inboundHeader.resize(HEADER_LENGTH);
                 boost::asio::async_read(*this->socket,
                     boost::asio::buffer(this->inboundHeader),
-                    common::weakBind(f, this->shared_from_this(),
-                                boost::asio::placeholders::error,
-                                boost::make_tuple(_handler)));
+                    this->strand->wrap(
+                      common::weakBind(f, this->shared_from_this(),
+                                  boost::asio::placeholders::error,
+                                  boost::make_tuple(_handler))));
               }
 
       /// \brief Handle a completed read of a message header.
@@ -284,9 +300,10 @@ namespace gazebo
 
                     boost::asio::async_read(*this->socket,
                         boost::asio::buffer(this->inboundData),
-                        common::weakBind(f, this->shared_from_this(),
-                                    boost::asio::placeholders::error,
-                                    _handler));
+                        this->strand->wrap(
+                          common::weakBind(f, this->shared_from_this(),
+                                      boost::asio::placeholders::error,
+                                      _handler)));
                   }
                   else
                   {
@@ -358,6 +375,22 @@ namespace gazebo
       /// \brief Handle on-write callbacks
       public: void ProcessWriteQueue(bool _blocking = false);
 
+      /// \brief Get the number of queued messages that are not being
+      /// written yet.
+      /// \return Number of pending messages.
+      public: unsigned int PendingMsgCount();
+
+      /// \brief Drop the oldest queued messages that are not being written
+      /// yet. The write callbacks of the dropped messages are invoked, as
+      /// if they had been sent.
+      /// \param[in] _keep Number of the newest pending messages to keep.
+      /// \param[in] _dropped Optional function called with the payload of
+      /// each dropped message, before its write callback.
+      /// \return Number of dropped messages.
+      public: unsigned int DropPendingMsgs(const unsigned int _keep,
+                  const boost::function<void(const std::string &)> &_dropped =
+                  boost::function<void(const std::string &)>());
+
       /// \brief Get the ID of the connection.
       /// \return The connection's unique ID.
       public: unsigned int GetId() const;
@@ -417,8 +450,36 @@ namespace gazebo
       /// \brief Accepts new connections.
       private: boost::asio::ip::tcp::acceptor *acceptor;
 
+      /// \brief Messages that are sent with a single gather write. Headers
+      /// and payloads are kept in separate buffers, so payloads are never
+      /// copied. The wire format is unchanged: each payload is preceded by
+      /// its HEADER_LENGTH hex size.
+      private: class WriteBatch
+      {
+        /// \brief Append a message to the batch.
+        /// \param[in] _payload Serialized message.
+        public: void Add(const std::shared_ptr<const std::string> &_payload);
+
+        /// \brief Get the buffer sequence to pass to asio.
+        /// \return Header and payload buffers, in order.
+        public: std::vector<boost::asio::const_buffer> Buffers() const;
+
+        /// \brief Header of each message.
+        public: std::vector<std::array<char, HEADER_LENGTH>> headers;
+
+        /// \brief Payload of each message.
+        public: std::vector<std::shared_ptr<const std::string>> payloads;
+
+        /// \brief Number of bytes in the batch, headers included.
+        public: std::size_t size = 0;
+      };
+
       /// \brief Outgoing data queue
-      private: std::deque<std::string> writeQueue;
+      private: std::deque<WriteBatch> writeQueue;
+
+      /// \brief Memory held by writeQueue, protected by writeMutex.
+      private: common::MemoryCharge writeQueueMemory{
+                 "Connection/write_queues"};
 
       /// \brief List of callbacks, paired with writeQueue. The callbacks
       /// are used to notify a publisher when a message is successfully sent.
@@ -468,6 +529,10 @@ namespace gazebo
       /// \brief Pointer to the IO manager
       private: static IOManager *iomanager;
 
+      /// \brief Serializes the asynchronous handlers of this connection
+      /// when the IO manager runs more than one thread.
+      private: boost::asio::io_service::strand *strand;
+
       /// \brief Number of writes that are being processed.
       private: unsigned int writeCount;
 
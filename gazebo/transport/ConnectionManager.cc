@@ -14,13 +14,18 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+
 #include <boost/bind/bind.hpp>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/transport/TopicManager.hh"
+#include "gazebo/transport/CompressedTransport.hh"
 #include "gazebo/transport/ConnectionManager.hh"
+#include "gazebo/transport/MulticastTransport.hh"
+#include "gazebo/transport/ShmTransport.hh"
 
 #include "gazebo/gazebo_config.h"
 
@@ -493,8 +498,23 @@ void ConnectionManager::OnRead(ConnectionPtr _connection,
 
     // Create a transport link for the publisher to the remote subscriber
     // via the connection
+    SubscriptionQoS qos;
+    qos.maxRate = sub.max_rate();
+    qos.keepLatest = sub.keep_latest();
+    qos.queueDepth = sub.queue_depth();
+
+    // One multicast stream serves all the subscribers of a topic that
+    // accept it.
+    std::shared_ptr<MulticastSender> multicast;
+    if (sub.multicast() && MulticastTopic(sub.topic()))
+      multicast = MulticastSender::ForTopic(sub.topic());
+
+    // Local subscribers never get compressed messages.
+    const bool local = ShmConnectionIsLocal(_connection);
+
     SubscriptionTransportPtr subLink(new SubscriptionTransport());
-    subLink->Init(_connection, sub.latching());
+    subLink->Init(_connection, sub.latching(), sub.shm() && local, qos,
+        multicast, local ? 0 : sub.compression());
 
     // Connect the publisher to this transport mechanism
     TopicManager::Instance()->ConnectPubToSub(sub.topic(), subLink);
@@ -712,3 +732,26 @@ void ConnectionManager::TriggerUpdate()
 {
   this->updateCondition.notify_all();
 }
+
+//////////////////////////////////////////////////
+unsigned int ConnectionManager::ConnectionCount()
+{
+  boost::recursive_mutex::scoped_lock lock(this->connectionMutex);
+  return static_cast<unsigned int>(this->connections.size());
+}
+
+//////////////////////////////////////////////////
+unsigned int ConnectionManager::PendingMsgCount(unsigned int &_max)
+{
+  boost::recursive_mutex::scoped_lock lock(this->connectionMutex);
+
+  unsigned int total = 0;
+  _max = 0;
+  for (auto &conn : this->connections)
+  {
+    const unsigned int count = conn->PendingMsgCount();
+    total += count;
+    _max = std::max(_max, count);
+  }
+  return total;
+}
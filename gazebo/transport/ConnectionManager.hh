@@ -145,6 +145,17 @@ namespace gazebo
       /// \brief Inform the connection manager that it needs an update.
       public: void TriggerUpdate();
 
+      /// \brief Get the number of connections to other nodes.
+      /// \return Number of connections, the master connection excluded.
+      public: unsigned int ConnectionCount();
+
+      /// \brief Get the number of messages waiting to be written, see
+      /// Connection::PendingMsgCount.
+      /// \param[out] _max Largest number of messages waiting on a single
+      /// connection.
+      /// \return Number of messages waiting on all the connections.
+      public: unsigned int PendingMsgCount(unsigned int &_max);
+
       /// \brief Callback function called when we have read data from the
       /// master
       /// \param[in] _data String of incoming data
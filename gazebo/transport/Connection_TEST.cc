@@ -16,10 +16,13 @@
 */
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <string>
 #include <stdlib.h>
 
+#include "gazebo/common/Time.hh"
 #include "gazebo/transport/Connection.hh"
+#include "gazebo/transport/IOManager.hh"
 #include "test/util.hh"
 
 using namespace gazebo;
@@ -64,6 +67,54 @@ TEST_F(Connection, IPWhiteList)
     setenv("GAZEBO_IP_WHITE_LIST", ipEnv, 1);
 }
 
+/////////////////////////////////////////////////
+TEST_F(Connection, IOThreads)
+{
+  // Get original value
+  char *threadsEnv = getenv("GAZEBO_IO_THREADS");
+  std::string originalThreads = threadsEnv ? threadsEnv : "";
+
+  setenv("GAZEBO_IO_THREADS", "3", 1);
+  {
+    transport::IOManager manager;
+    EXPECT_EQ(manager.ThreadCount(), 3u);
+  }
+
+  setenv("GAZEBO_IO_THREADS", "garbage", 1);
+  {
+    transport::IOManager manager;
+    EXPECT_EQ(manager.ThreadCount(), 1u);
+  }
+
+  // Two handlers that wait for each other can only finish if they run on
+  // different threads.
+  {
+    transport::IOManager manager(2);
+    EXPECT_EQ(manager.ThreadCount(), 2u);
+
+    std::atomic<int> entered(0);
+    std::atomic<int> done(0);
+    auto handler = [&entered, &done]()
+    {
+      ++entered;
+      for (int i = 0; i < 500 && entered < 2; ++i)
+        common::Time::MSleep(10);
+      if (entered == 2)
+        ++done;
+    };
+    manager.GetIO().post(handler);
+    manager.GetIO().post(handler);
+
+    for (int i = 0; i < 500 && done < 2; ++i)
+      common::Time::MSleep(10);
+    EXPECT_EQ(done, 2);
+  }
+
+  // Restore value
+  setenv("GAZEBO_IO_THREADS", originalThreads.c_str(), 1);
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -15,9 +15,14 @@
  *
 */
 #include <atomic>
+#include <cstdlib>
+#include <string>
+#include <vector>
 #include <boost/bind/bind.hpp>
 #include <boost/thread/thread.hpp>
 #include <iostream>
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/ThreadRoles.hh"
 #include "gazebo/transport/IOManager.hh"
 
 namespace gazebo
@@ -36,20 +41,61 @@ class IOManagerPrivate
   /// \brief Reference count of connections using this IOManager.
   public: std::atomic_int count;
 
-  /// \brief Thread for IOManager.
-  public: boost::thread *thread = nullptr;
+  /// \brief Threads that run the io_service.
+  public: std::vector<boost::thread *> threads;
+
+  /// \brief Number of threads in the pool.
+  public: unsigned int threadCount = 1;
 };
 
 /////////////////////////////////////////////////
 IOManager::IOManager()
+  : IOManager(0u)
+{
+}
+
+/////////////////////////////////////////////////
+IOManager::IOManager(const unsigned int _threadCount)
   : dataPtr(new IOManagerPrivate)
 {
-  this->dataPtr->io_service = new boost::asio::io_service;
+  this->dataPtr->threadCount = _threadCount;
+  if (this->dataPtr->threadCount == 0)
+  {
+    this->dataPtr->threadCount = 1;
+
+    const char *threadsEnv = std::getenv("GAZEBO_IO_THREADS");
+    if (threadsEnv && *threadsEnv)
+    {
+      try
+      {
+        int threads = std::stoi(threadsEnv);
+        if (threads > 0)
+          this->dataPtr->threadCount = threads;
+        else
+          throw std::invalid_argument(threadsEnv);
+      }
+      catch(...)
+      {
+        gzwarn << "Invalid GAZEBO_IO_THREADS value[" << threadsEnv
+               << "], using 1 IO thread." << std::endl;
+      }
+    }
+  }
+
+  this->dataPtr->io_service = new boost::asio::io_service(
+      this->dataPtr->threadCount);
   this->dataPtr->work = new boost::asio::io_service::work(
       *this->dataPtr->io_service);
   this->dataPtr->count = 0;
-  this->dataPtr->thread = new boost::thread(boost::bind(
-      &boost::asio::io_service::run, this->dataPtr->io_service));
+  for (unsigned int i = 0; i < this->dataPtr->threadCount; ++i)
+  {
+    boost::asio::io_service *service = this->dataPtr->io_service;
+    this->dataPtr->threads.push_back(new boost::thread([service]()
+    {
+      common::ThreadRoles::Instance()->Apply("io");
+      service->run();
+    }));
+  }
 }
 
 /////////////////////////////////////////////////
@@ -72,12 +118,12 @@ void IOManager::Stop()
 {
   this->dataPtr->io_service->reset();
   this->dataPtr->io_service->stop();
-  if (this->dataPtr->thread)
+  for (auto &thread : this->dataPtr->threads)
   {
-    this->dataPtr->thread->join();
-    delete this->dataPtr->thread;
-    this->dataPtr->thread = nullptr;
+    thread->join();
+    delete thread;
   }
+  this->dataPtr->threads.clear();
 }
 
 /////////////////////////////////////////////////
@@ -103,5 +149,11 @@ unsigned int IOManager::GetCount() const
 {
   return this->dataPtr->count;
 }
+
+/////////////////////////////////////////////////
+unsigned int IOManager::ThreadCount() const
+{
+  return this->dataPtr->threadCount;
+}
 }
 }
@@ -32,11 +32,22 @@ namespace gazebo
 
     /// \class IOManager IOManager.hh transport/transport.hh
     /// \brief Manages boost::asio IO
+    ///
+    /// The IO service is run by a pool of threads. The size of the pool is
+    /// read from the GAZEBO_IO_THREADS environment variable and defaults to
+    /// one thread. Handlers of a single Connection are serialized with a
+    /// strand, so messages on a connection keep their order while different
+    /// connections are serviced in parallel.
     class GZ_TRANSPORT_VISIBLE IOManager
     {
       /// \brief Constructor
       public: IOManager();
 
+      /// \brief Constructor
+      /// \param[in] _threadCount Number of threads that run the IO service.
+      /// Zero uses the GAZEBO_IO_THREADS environment variable.
+      public: explicit IOManager(const unsigned int _threadCount);
+
       /// \brief Destructor
       public: ~IOManager();
 
@@ -54,6 +65,10 @@ namespace gazebo
       /// \return The event count
       public: unsigned int GetCount() const;
 
+      /// \brief Get the number of threads running the IO service.
+      /// \return Number of IO threads.
+      public: unsigned int ThreadCount() const;
+
       /// \brief Stop the IO service
       public: void Stop();
 
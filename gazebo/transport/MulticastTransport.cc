@@ -0,0 +1,447 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <sstream>
+
+#include <boost/algorithm/string.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/MulticastTransport.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+namespace
+{
+  /// \brief Prefix of a descriptor. Starts with a zero byte, which is not a
+  /// valid protobuf field tag.
+  const char kDescriptorMagic[] = {'\0', 'G', 'Z', 'M', 'C', 'A'};
+
+  /// \brief Start of every datagram.
+  const char kDatagramMagic[] = {'G', 'Z', 'M', 'C'};
+
+  /// \brief Size of the datagram header: magic, stream id, sequence,
+  /// fragment index, fragment count and message size.
+  const std::size_t kHeaderSize = 4 + 4 + 4 + 2 + 2 + 4;
+
+  /// \brief Payload of each datagram but the last of a message. Keeps the
+  /// datagrams within a 1500 byte MTU.
+  const std::size_t kFragmentSize = 1400;
+
+  /// \brief Largest number of fragments of a message.
+  const std::size_t kMaxFragments = 0xFFFF;
+
+  /// \brief Default value of GAZEBO_MULTICAST_ADDRESS.
+  const char kDefaultAddress[] = "239.255.11.46:11346";
+
+  /// \brief Default value of GAZEBO_MULTICAST_TOPICS.
+  const char kDefaultTopics[] = "pose/info";
+
+  /// \brief Senders shared by the subscribers of each topic.
+  std::map<std::string, std::weak_ptr<MulticastSender>> senders;
+
+  /// \brief Protects the senders.
+  std::mutex sendersMutex;
+
+  /////////////////////////////////////////////////
+  /// \brief Write a little endian integer.
+  /// \param[in] _value Value.
+  /// \param[in] _bytes Number of bytes.
+  /// \param[out] _out Destination.
+  void Put(const uint32_t _value, const std::size_t _bytes, char *_out)
+  {
+    for (std::size_t i = 0; i < _bytes; ++i)
+      _out[i] = static_cast<char>((_value >> (8 * i)) & 0xFF);
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Read a little endian integer.
+  /// \param[in] _in Source.
+  /// \param[in] _bytes Number of bytes.
+  /// \return Value.
+  uint32_t Get(const char *_in, const std::size_t _bytes)
+  {
+    uint32_t value = 0;
+    for (std::size_t i = 0; i < _bytes; ++i)
+      value |= static_cast<uint32_t>(static_cast<unsigned char>(_in[i])) <<
+        (8 * i);
+    return value;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Get the number of fragments of a message.
+  /// \param[in] _size Message size.
+  /// \return Number of fragments, at least one.
+  std::size_t FragmentCount(const std::size_t _size)
+  {
+    return _size == 0 ? 1 : (_size + kFragmentSize - 1) / kFragmentSize;
+  }
+}
+
+/////////////////////////////////////////////////
+bool transport::MulticastRequested()
+{
+  const char *env = std::getenv("GAZEBO_MULTICAST_TRANSPORT");
+  return env && std::string(env) == "1";
+}
+
+/////////////////////////////////////////////////
+bool transport::MulticastTopic(const std::string &_topic)
+{
+  const char *env = std::getenv("GAZEBO_MULTICAST_TOPICS");
+  std::vector<std::string> topics;
+  boost::split(topics, env ? env : kDefaultTopics, boost::is_any_of(","));
+
+  for (auto topic : topics)
+  {
+    boost::trim(topic);
+    if (topic.empty())
+      continue;
+
+    if (topic[0] == '/')
+    {
+      if (_topic == topic)
+        return true;
+    }
+    else if (boost::ends_with(_topic, "/" + topic))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+MulticastSender::MulticastSender(const std::string &_address)
+  : socket(io)
+{
+  std::string address = _address;
+  if (address.empty())
+  {
+    const char *env = std::getenv("GAZEBO_MULTICAST_ADDRESS");
+    address = env && *env ? env : kDefaultAddress;
+  }
+
+  const std::size_t colon = address.rfind(':');
+  boost::system::error_code ec;
+  boost::asio::ip::address group;
+  unsigned int port = 0;
+  if (colon != std::string::npos)
+  {
+    group = boost::asio::ip::address::from_string(address.substr(0, colon),
+        ec);
+    try
+    {
+      port = std::stoul(address.substr(colon + 1));
+    }
+    catch(...)
+    {
+      port = 0;
+    }
+  }
+
+  if (colon == std::string::npos || ec || !group.is_v4() || port == 0 ||
+      port > 0xFFFF)
+  {
+    gzerr << "Invalid multicast address[" << address << "]\n";
+    return;
+  }
+
+  this->endpoint = boost::asio::ip::udp::endpoint(group,
+      static_cast<uint16_t>(port));
+
+  this->socket.open(boost::asio::ip::udp::v4(), ec);
+  if (ec)
+  {
+    gzerr << "Unable to open the multicast socket: " << ec.message() << "\n";
+    return;
+  }
+
+  if (group.is_multicast())
+  {
+    // Stay on the local network unless told otherwise.
+    int ttl = 1;
+    const char *env = std::getenv("GAZEBO_MULTICAST_TTL");
+    if (env && *env)
+      ttl = std::atoi(env);
+    this->socket.set_option(boost::asio::ip::multicast::hops(ttl), ec);
+    this->socket.set_option(
+        boost::asio::ip::multicast::enable_loopback(true), ec);
+  }
+  this->socket.set_option(
+      boost::asio::socket_base::send_buffer_size(1 << 20), ec);
+
+  std::random_device device;
+  this->streamId = device();
+
+  std::ostringstream stream;
+  stream << group.to_string() << " " << port << " " << this->streamId;
+  this->descriptor.assign(kDescriptorMagic, sizeof(kDescriptorMagic));
+  this->descriptor += stream.str();
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<MulticastSender> MulticastSender::ForTopic(
+    const std::string &_topic)
+{
+  std::lock_guard<std::mutex> lock(sendersMutex);
+
+  std::shared_ptr<MulticastSender> sender = senders[_topic].lock();
+  if (!sender)
+  {
+    sender = std::make_shared<MulticastSender>();
+    if (!sender->Valid())
+      return nullptr;
+    senders[_topic] = sender;
+  }
+  return sender;
+}
+
+/////////////////////////////////////////////////
+bool MulticastSender::Valid() const
+{
+  return this->socket.is_open();
+}
+
+/////////////////////////////////////////////////
+const std::string &MulticastSender::Descriptor() const
+{
+  return this->descriptor;
+}
+
+/////////////////////////////////////////////////
+bool MulticastSender::Send(const std::shared_ptr<const std::string> &_data)
+{
+  const std::size_t count = FragmentCount(_data->size());
+  if (!this->Valid() || count > kMaxFragments)
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  // The subscribers of a topic share the buffer of a message.
+  if (_data == this->lastData)
+    return true;
+  this->lastData = _data;
+
+  char header[kHeaderSize];
+  std::memcpy(header, kDatagramMagic, sizeof(kDatagramMagic));
+  Put(this->streamId, 4, header + 4);
+  Put(this->sequence++, 4, header + 8);
+  Put(static_cast<uint32_t>(count), 2, header + 14);
+  Put(static_cast<uint32_t>(_data->size()), 4, header + 16);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    Put(static_cast<uint32_t>(i), 2, header + 12);
+
+    const std::size_t offset = i * kFragmentSize;
+    const std::size_t size = std::min(kFragmentSize, _data->size() - offset);
+    std::array<boost::asio::const_buffer, 2> buffers = {{
+      boost::asio::buffer(header, kHeaderSize),
+      boost::asio::buffer(_data->data() + offset, size)}};
+
+    // A datagram that can't be sent is a lost datagram, which the
+    // subscribers recover from at the next message.
+    boost::system::error_code ec;
+    this->socket.send_to(buffers, this->endpoint, 0, ec);
+  }
+
+  ++this->sentCount;
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint64_t MulticastSender::SentCount() const
+{
+  return this->sentCount;
+}
+
+/////////////////////////////////////////////////
+MulticastReceiver::MulticastReceiver()
+  : socket(io), datagram(kHeaderSize + kFragmentSize)
+{
+}
+
+/////////////////////////////////////////////////
+MulticastReceiver::~MulticastReceiver()
+{
+  this->io.stop();
+  if (this->thread.joinable())
+    this->thread.join();
+
+  boost::system::error_code ec;
+  this->socket.close(ec);
+}
+
+/////////////////////////////////////////////////
+bool MulticastReceiver::IsDescriptor(const std::string &_data)
+{
+  return _data.size() > sizeof(kDescriptorMagic) &&
+    _data.compare(0, sizeof(kDescriptorMagic), kDescriptorMagic,
+        sizeof(kDescriptorMagic)) == 0;
+}
+
+/////////////////////////////////////////////////
+bool MulticastReceiver::Join(const std::string &_descriptor,
+    const std::function<void(const std::string &)> &_callback)
+{
+  if (!IsDescriptor(_descriptor) || this->socket.is_open())
+    return false;
+
+  std::istringstream stream(_descriptor.substr(sizeof(kDescriptorMagic)));
+  std::string groupStr;
+  unsigned int port = 0;
+  uint32_t id = 0;
+  if (!(stream >> groupStr >> port >> id) || port == 0 || port > 0xFFFF)
+  {
+    gzerr << "Invalid multicast descriptor\n";
+    return false;
+  }
+
+  boost::system::error_code ec;
+  boost::asio::ip::address group =
+    boost::asio::ip::address::from_string(groupStr, ec);
+  if (ec || !group.is_v4())
+  {
+    gzerr << "Invalid multicast group[" << groupStr << "]\n";
+    return false;
+  }
+
+  // Several subscribers on a host share the port.
+  this->socket.open(boost::asio::ip::udp::v4(), ec);
+  if (!ec)
+  {
+    this->socket.set_option(
+        boost::asio::ip::udp::socket::reuse_address(true), ec);
+    this->socket.set_option(
+        boost::asio::socket_base::receive_buffer_size(4 << 20), ec);
+    this->socket.bind(boost::asio::ip::udp::endpoint(
+          boost::asio::ip::address_v4::any(), static_cast<uint16_t>(port)),
+        ec);
+  }
+  if (!ec && group.is_multicast())
+    this->socket.set_option(boost::asio::ip::multicast::join_group(group), ec);
+
+  if (ec)
+  {
+    gzwarn << "Unable to join multicast group[" << groupStr << ":" << port
+           << "]: " << ec.message() << "\n";
+    this->socket.close(ec);
+    return false;
+  }
+
+  this->streamId = id;
+  this->callback = _callback;
+  this->Receive();
+  this->thread = std::thread([this]()
+      {
+        this->io.run();
+      });
+  return true;
+}
+
+/////////////////////////////////////////////////
+void MulticastReceiver::Receive()
+{
+  this->socket.async_receive_from(
+      boost::asio::buffer(this->datagram), this->remote,
+      [this](const boost::system::error_code &_ec, std::size_t _size)
+      {
+        if (_ec == boost::asio::error::operation_aborted)
+          return;
+
+        if (!_ec)
+          this->OnDatagram(_size);
+        this->Receive();
+      });
+}
+
+/////////////////////////////////////////////////
+void MulticastReceiver::OnDatagram(const std::size_t _size)
+{
+  const char *data = this->datagram.data();
+  if (_size < kHeaderSize ||
+      std::memcmp(data, kDatagramMagic, sizeof(kDatagramMagic)) != 0 ||
+      Get(data + 4, 4) != this->streamId)
+  {
+    return;
+  }
+
+  const uint32_t seq = Get(data + 8, 4);
+  const std::size_t index = Get(data + 12, 2);
+  const std::size_t count = Get(data + 14, 2);
+  const std::size_t size = Get(data + 16, 4);
+
+  const std::size_t offset = index * kFragmentSize;
+  if (count != FragmentCount(size) || index >= count ||
+      _size - kHeaderSize != std::min(kFragmentSize, size - offset))
+  {
+    return;
+  }
+
+  if (!this->started || seq != this->sequence)
+  {
+    // Datagrams of older messages arrive too late to be used.
+    if (this->started && static_cast<int32_t>(seq - this->sequence) < 0)
+      return;
+
+    // The message being reassembled, and those not seen at all, are lost.
+    if (this->started)
+    {
+      if (this->missing > 0)
+        ++this->lostCount;
+      this->lostCount += seq - this->sequence - 1;
+    }
+
+    this->started = true;
+    this->sequence = seq;
+    this->message.resize(size);
+    this->fragments.assign(count, false);
+    this->missing = count;
+  }
+
+  if (this->missing == 0 || this->fragments[index])
+    return;
+
+  std::memcpy(&this->message[offset], data + kHeaderSize,
+      _size - kHeaderSize);
+  this->fragments[index] = true;
+
+  if (--this->missing == 0)
+  {
+    ++this->receivedCount;
+    if (this->callback)
+      this->callback(this->message);
+  }
+}
+
+/////////////////////////////////////////////////
+uint64_t MulticastReceiver::ReceivedCount() const
+{
+  return this->receivedCount;
+}
+
+/////////////////////////////////////////////////
+uint64_t MulticastReceiver::LostCount() const
+{
+  return this->lostCount;
+}
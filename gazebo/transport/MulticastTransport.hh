@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_MULTICASTTRANSPORT_HH_
+#define GAZEBO_TRANSPORT_MULTICASTTRANSPORT_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief UDP multicast path for high rate topics with many remote
+    /// subscribers, such as ~/pose/info with many gzclients.
+    ///
+    /// A subscriber asks for multicast in its msgs::Subscribe request when
+    /// GAZEBO_MULTICAST_TRANSPORT is set to 1. The publisher accepts for the
+    /// topics listed in GAZEBO_MULTICAST_TOPICS, a comma separated list of
+    /// topic names, or of topic suffixes when they don't start with a
+    /// slash ("pose/info" by default). It then sends the subscriber a
+    /// descriptor over the socket naming the group and stream of the
+    /// topic, and sends each message once to the group
+    /// (GAZEBO_MULTICAST_ADDRESS, 239.255.11.46:11346 by default) for all
+    /// such subscribers. Messages are split into datagrams that fit the
+    /// usual Ethernet MTU.
+    ///
+    /// Every message is complete, so a subscriber that joins late or lost
+    /// datagrams resyncs at the next message it fully receives. Latched
+    /// messages are still sent over the socket, so a late subscriber gets
+    /// the last message right away. A message too large for the datagram
+    /// numbering goes over the socket as usual.
+
+    /// \brief Return true if subscribers should request multicast.
+    /// \return Value of the GAZEBO_MULTICAST_TRANSPORT environment variable.
+    GZ_TRANSPORT_VISIBLE
+    bool MulticastRequested();
+
+    /// \brief Return true if a topic may be sent by multicast.
+    /// \param[in] _topic Fully qualified topic name.
+    /// \return True if the topic matches GAZEBO_MULTICAST_TOPICS.
+    GZ_TRANSPORT_VISIBLE
+    bool MulticastTopic(const std::string &_topic);
+
+    /// \internal
+    /// \brief Publisher side of the multicast transport. One sender serves
+    /// all the multicast subscribers of a topic.
+    class GZ_TRANSPORT_VISIBLE MulticastSender
+    {
+      /// \brief Constructor.
+      /// \param[in] _address Group and port, such as 239.255.11.46:11346.
+      /// A unicast address sends to a single host. If empty, the value of
+      /// GAZEBO_MULTICAST_ADDRESS or the default group is used.
+      public: explicit MulticastSender(const std::string &_address = "");
+
+      /// \brief Get the sender of a topic, shared by its subscribers.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \return The sender, or null if the socket could not be opened.
+      public: static std::shared_ptr<MulticastSender> ForTopic(
+                  const std::string &_topic);
+
+      /// \brief Return true if the socket is open.
+      /// \return True if messages can be sent.
+      public: bool Valid() const;
+
+      /// \brief Get the descriptor to send to a subscriber, so it joins
+      /// the stream.
+      /// \return Descriptor.
+      public: const std::string &Descriptor() const;
+
+      /// \brief Send a message to the group. The message is only sent once
+      /// when several subscribers pass the same buffer.
+      /// \param[in] _data Serialized message.
+      /// \return False if the message is too large for multicast and must
+      /// be sent over the socket.
+      public: bool Send(const std::shared_ptr<const std::string> &_data);
+
+      /// \brief Get the number of messages sent.
+      /// \return Number of messages.
+      public: uint64_t SentCount() const;
+
+      /// \brief Used by the socket.
+      private: boost::asio::io_service io;
+
+      /// \brief UDP socket.
+      private: boost::asio::ip::udp::socket socket;
+
+      /// \brief Group and port the messages are sent to.
+      private: boost::asio::ip::udp::endpoint endpoint;
+
+      /// \brief Descriptor sent to subscribers.
+      private: std::string descriptor;
+
+      /// \brief Identifies the messages of this sender in the group.
+      private: uint32_t streamId = 0;
+
+      /// \brief Sequence number of the next message.
+      private: uint32_t sequence = 0;
+
+      /// \brief Last message sent, to send it only once.
+      private: std::shared_ptr<const std::string> lastData;
+
+      /// \brief Number of messages sent.
+      private: std::atomic<uint64_t> sentCount{0};
+
+      /// \brief Protects the socket and the sequence.
+      private: std::mutex mutex;
+    };
+
+    /// \internal
+    /// \brief Subscriber side of the multicast transport. Receives the
+    /// datagrams of a stream on a thread of its own and reassembles the
+    /// messages.
+    class GZ_TRANSPORT_VISIBLE MulticastReceiver
+    {
+      /// \brief Constructor.
+      public: MulticastReceiver();
+
+      /// \brief Destructor. Leaves the group and stops the thread.
+      public: ~MulticastReceiver();
+
+      /// \brief Check if data received over a socket is a descriptor.
+      /// Serialized protobuf messages never start with a zero byte, so the
+      /// descriptor can not be confused with a message.
+      /// \param[in] _data Data received over the socket.
+      /// \return True if _data is a multicast descriptor.
+      public: static bool IsDescriptor(const std::string &_data);
+
+      /// \brief Join the stream named by a descriptor.
+      /// \param[in] _descriptor Descriptor received over the socket.
+      /// \param[in] _callback Called with each complete message, from the
+      /// receiving thread.
+      /// \return False if the descriptor is invalid, the socket could not
+      /// be opened, or a stream was already joined.
+      public: bool Join(const std::string &_descriptor,
+                  const std::function<void(const std::string &)> &_callback);
+
+      /// \brief Get the number of complete messages received.
+      /// \return Number of messages.
+      public: uint64_t ReceivedCount() const;
+
+      /// \brief Get the number of messages lost, partly or completely.
+      /// \return Number of messages.
+      public: uint64_t LostCount() const;
+
+      /// \brief Wait for the next datagram.
+      private: void Receive();
+
+      /// \brief Handle a datagram.
+      /// \param[in] _size Size of the datagram.
+      private: void OnDatagram(const std::size_t _size);
+
+      /// \brief Used by the socket, run by the thread.
+      private: boost::asio::io_service io;
+
+      /// \brief UDP socket.
+      private: boost::asio::ip::udp::socket socket;
+
+      /// \brief Sender of the last datagram.
+      private: boost::asio::ip::udp::endpoint remote;
+
+      /// \brief Receive buffer.
+      private: std::vector<char> datagram;
+
+      /// \brief Stream of the joined sender.
+      private: uint32_t streamId = 0;
+
+      /// \brief Sequence number of the message being reassembled.
+      private: uint32_t sequence = 0;
+
+      /// \brief True once a datagram of the stream was received.
+      private: bool started = false;
+
+      /// \brief Message being reassembled.
+      private: std::string message;
+
+      /// \brief Fragments of the message received so far.
+      private: std::vector<bool> fragments;
+
+      /// \brief Number of fragments still missing.
+      private: std::size_t missing = 0;
+
+      /// \brief Called with each complete message.
+      private: std::function<void(const std::string &)> callback;
+
+      /// \brief Runs the io service.
+      private: std::thread thread;
+
+      /// \brief Number of complete messages.
+      private: std::atomic<uint64_t> receivedCount{0};
+
+      /// \brief Number of lost messages.
+      private: std::atomic<uint64_t> lostCount{0};
+    };
+  }
+}
+#endif
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/transport/MulticastTransport.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MulticastTransport : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(MulticastTransport, Topics)
+{
+  unsetenv("GAZEBO_MULTICAST_TOPICS");
+  EXPECT_TRUE(transport::MulticastTopic("/gazebo/default/pose/info"));
+  EXPECT_FALSE(transport::MulticastTopic("/gazebo/default/pose/local/info"));
+
+  setenv("GAZEBO_MULTICAST_TOPICS", "/gazebo/default/world_stats, cmd", 1);
+  EXPECT_TRUE(transport::MulticastTopic("/gazebo/default/world_stats"));
+  EXPECT_FALSE(transport::MulticastTopic("/gazebo/other/world_stats"));
+  EXPECT_TRUE(transport::MulticastTopic("/gazebo/default/robot/cmd"));
+  EXPECT_FALSE(transport::MulticastTopic("/gazebo/default/robot/xcmd"));
+  EXPECT_FALSE(transport::MulticastTopic("/gazebo/default/pose/info"));
+  unsetenv("GAZEBO_MULTICAST_TOPICS");
+}
+
+/////////////////////////////////////////////////
+// The stream is sent to a unicast address on the loopback interface, which
+// goes through the same code as a group and works without a multicast
+// route.
+TEST_F(MulticastTransport, RoundTrip)
+{
+  transport::MulticastSender sender("127.0.0.1:11399");
+  ASSERT_TRUE(sender.Valid());
+  EXPECT_TRUE(transport::MulticastReceiver::IsDescriptor(sender.Descriptor()));
+  EXPECT_FALSE(transport::MulticastReceiver::IsDescriptor("\x0a\x03pose"));
+
+  std::mutex mutex;
+  std::vector<std::string> received;
+  transport::MulticastReceiver receiver;
+  ASSERT_TRUE(receiver.Join(sender.Descriptor(),
+        [&](const std::string &_data)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          received.push_back(_data);
+        }));
+
+  // A stream can only be joined once.
+  EXPECT_FALSE(receiver.Join(sender.Descriptor(), nullptr));
+
+  // Small, empty and fragmented messages.
+  std::vector<std::string> sent = {"pose", "", std::string(10000, 'x')};
+  sent[2][1399] = 'a';
+  sent[2][1400] = 'b';
+  sent[2][9999] = 'c';
+  for (auto const &data : sent)
+  {
+    auto buffer = std::make_shared<const std::string>(data);
+    EXPECT_TRUE(sender.Send(buffer));
+
+    // Subscribers sharing the buffer don't send it again.
+    EXPECT_TRUE(sender.Send(buffer));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(sender.SentCount(), sent.size());
+
+  for (int i = 0; i < 100 && receiver.ReceivedCount() < sent.size(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ(received, sent);
+  EXPECT_EQ(receiver.LostCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MulticastTransport, OtherStream)
+{
+  transport::MulticastSender sender("127.0.0.1:11398");
+  transport::MulticastSender other("127.0.0.1:11398");
+  ASSERT_TRUE(sender.Valid());
+  ASSERT_TRUE(other.Valid());
+
+  transport::MulticastReceiver receiver;
+  ASSERT_TRUE(receiver.Join(sender.Descriptor(), nullptr));
+
+  // Messages of another stream on the same port are ignored.
+  other.Send(std::make_shared<const std::string>("other"));
+  sender.Send(std::make_shared<const std::string>("mine"));
+
+  for (int i = 0; i < 100 && receiver.ReceivedCount() < 1u; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(receiver.ReceivedCount(), 1u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -28,6 +28,7 @@ extern void dummy_callback_fn(uint32_t);
 
 /////////////////////////////////////////////////
 Node::Node()
+  : publishBatchDepth(0)
 {
   this->id = idCounter++;
   this->topicNamespace = "";
@@ -191,6 +192,36 @@ void Node::ProcessPublishers()
     this->publishers[i]->SendMessage();
 }
 
+/////////////////////////////////////////////////
+void Node::BeginPublishBatch()
+{
+  this->publishBatchDepth++;
+}
+
+/////////////////////////////////////////////////
+void Node::EndPublishBatch()
+{
+  if (this->publishBatchDepth <= 0)
+  {
+    gzerr << "EndPublishBatch called without a matching BeginPublishBatch\n";
+    return;
+  }
+
+  if (--this->publishBatchDepth == 0 && this->initialized)
+  {
+    // Have the connection manager send all the queued messages in one
+    // pass.
+    TopicManager::Instance()->AddNodeToProcess(shared_from_this());
+    ConnectionManager::Instance()->TriggerUpdate();
+  }
+}
+
+/////////////////////////////////////////////////
+bool Node::InPublishBatch() const
+{
+  return this->publishBatchDepth > 0;
+}
+
 /////////////////////////////////////////////////
 bool Node::HandleData(const std::string &_topic, const std::string &_msg)
 {
@@ -362,6 +393,21 @@ bool Node::HasLatchedSubscriber(const std::string &_topic) const
   return false;
 }
 
+/////////////////////////////////////////////////
+bool Node::SubscriberQoS(const std::string &_topic,
+    SubscriptionQoS &_qos) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+  Callback_M::const_iterator iter = this->callbacks.find(_topic);
+  if (iter == this->callbacks.end() || iter->second.empty())
+    return false;
+
+  _qos = iter->second.front()->QoS();
+  for (auto const &callback : iter->second)
+    _qos.Merge(callback->QoS());
+  return true;
+}
+
 /////////////////////////////////////////////////
 void Node::RemoveCallback(const std::string &_topic, unsigned int _id)
 {
@@ -32,9 +32,11 @@
 
 #include <boost/bind.hpp>
 #include <boost/enable_shared_from_this.hpp>
+#include <atomic>
 #include <map>
 #include <list>
 #include <string>
+#include <utility>
 #include <vector>
 #if TBB_VERSION_MAJOR >= 2021
 #include "gazebo/transport/TaskGroup.hh"
@@ -141,6 +143,22 @@ namespace gazebo
       /// \brief Finalize the node
       public: void Fini();
 
+      /// \brief Start collecting the messages published by this node.
+      /// Non-blocking publishes are queued but not sent until the matching
+      /// EndPublishBatch, which flushes them together, so that the small
+      /// messages of a world step share one framed write per connection.
+      /// Batches can be nested; only the outermost batch flushes.
+      public: void BeginPublishBatch();
+
+      /// \brief End a batch started with BeginPublishBatch, and send the
+      /// collected messages if it is the outermost batch.
+      public: void EndPublishBatch();
+
+      /// \brief Is a publish batch open?
+      /// \return True between BeginPublishBatch and the matching
+      /// EndPublishBatch.
+      public: bool InPublishBatch() const;
+
       /// \brief Get the topic namespace for this node
       /// \return The namespace
       public: std::string GetTopicNamespace() const;
@@ -171,6 +189,13 @@ namespace gazebo
       /// \return True if a latched subscriber exists.
       public: bool HasLatchedSubscriber(const std::string &_topic) const;
 
+      /// \brief Get the combined quality of service of the subscribers on a
+      /// specific topic, see SubscriptionQoS::Merge.
+      /// \param[in] _topic Name of the topic to check.
+      /// \param[out] _qos The combined quality of service.
+      /// \return True if the node has a subscriber on the topic.
+      public: bool SubscriberQoS(const std::string &_topic,
+                  SubscriptionQoS &_qos) const;
 
       /// \brief A convenience function for a one-time publication of
       /// a message. This is inefficient, compared to
@@ -289,6 +314,83 @@ namespace gazebo
         return result;
       }
 
+      /// \brief Subscribe to the batches of a sensor topic. Each sample of
+      /// a batch is given to the callback as if it was published on the
+      /// sensor topic. See sensors::Sensor::SetBatchSize.
+      /// \param[in] _topic The sensor topic, without the /batch suffix.
+      /// \param[in] _fp Class method to be called for each sample.
+      /// \param[in] _obj Class instance to be used for each sample.
+      /// \return Pointer to new Subscriber object
+      public: template<typename M, typename T>
+      SubscriberPtr SubscribeBatch(const std::string &_topic,
+          void(T::*_fp)(const boost::shared_ptr<M const> &), T *_obj)
+      {
+        SubscribeOptions ops;
+        std::string decodedTopic = this->DecodeTopicName(_topic + "/batch");
+        ops.template Init<msgs::SensorBatch>(decodedTopic, shared_from_this(),
+            false);
+
+        {
+          boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+          this->callbacks[decodedTopic].push_back(CallbackHelperPtr(
+                new CallbackHelperT<msgs::SensorBatch>(
+                  [_fp, _obj](ConstSensorBatchPtr &_batch)
+                  {
+                    for (auto &sample : msgs::UnpackBatch<M>(*_batch))
+                    {
+                      boost::shared_ptr<M const> msg(new M(std::move(sample)));
+                      (_obj->*_fp)(msg);
+                    }
+                  })));
+        }
+
+        SubscriberPtr result =
+          transport::TopicManager::Instance()->Subscribe(ops);
+
+        result->SetCallbackId(this->callbacks[decodedTopic].back()->GetId());
+
+        return result;
+      }
+
+      /// \brief Subscribe to a topic using a class method as the callback,
+      /// with a quality of service enforced by remote publishers. Remote
+      /// publishers on this topic share one connection per process, so they
+      /// apply the least restrictive QoS of the process' subscribers at the
+      /// time the connection is made.
+      /// \param[in] _topic The topic to subscribe to
+      /// \param[in] _fp Class method to be called on receipt of new message
+      /// \param[in] _obj Class instance to be used on receipt of new message
+      /// \param[in] _qos Rate and queue limits for remote publishers.
+      /// \param[in] _latching If true, latch latest incoming message;
+      /// otherwise don't latch
+      /// \return Pointer to new Subscriber object
+      public: template<typename M, typename T>
+      SubscriberPtr Subscribe(const std::string &_topic,
+          void(T::*_fp)(const boost::shared_ptr<M const> &), T *_obj,
+          const SubscriptionQoS &_qos, bool _latching = false)
+      {
+        SubscribeOptions ops;
+        std::string decodedTopic = this->DecodeTopicName(_topic);
+        ops.template Init<M>(decodedTopic, shared_from_this(), _latching);
+        ops.SetQoS(_qos);
+
+        {
+          using namespace boost::placeholders;
+          boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+          CallbackHelperPtr helper(
+                new CallbackHelperT<M>(boost::bind(_fp, _obj, _1), _latching));
+          helper->SetQoS(_qos);
+          this->callbacks[decodedTopic].push_back(helper);
+        }
+
+        SubscriberPtr result =
+          transport::TopicManager::Instance()->Subscribe(ops);
+
+        result->SetCallbackId(this->callbacks[decodedTopic].back()->GetId());
+
+        return result;
+      }
+
       /// \brief Subscribe to a topic using a bare function as the callback
       /// \param[in] _topic The topic to subscribe to
       /// \param[in] _fp Function to be called on receipt of new message
@@ -456,13 +558,16 @@ namespace gazebo
 
       private: boost::mutex publisherMutex;
       private: boost::mutex publisherDeleteMutex;
-      private: boost::recursive_mutex incomingMutex;
+      private: mutable boost::recursive_mutex incomingMutex;
 
       /// \brief make sure we don't call ProcessingIncoming simultaneously
       /// from separate threads.
       private: boost::recursive_mutex processIncomingMutex;
 
       private: bool initialized;
+
+      /// \brief Depth of nested publish batches.
+      private: std::atomic<int> publishBatchDepth;
     };
     /// \}
   }
@@ -30,7 +30,8 @@ unsigned int Publication::idCounter = 0;
 
 //////////////////////////////////////////////////
 Publication::Publication(const std::string &_topic, const std::string &_msgType)
-  : topic(_topic), msgType(_msgType), locallyAdvertised(false)
+  : topic(_topic), msgType(_msgType), locallyAdvertised(false),
+    serializeCount(0), serializedBytes(0)
 {
   this->id = idCounter++;
 }
@@ -321,14 +322,20 @@ int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
 
     if (!this->callbacks.empty())
     {
+      // Serialize once, and share the buffer with all the callbacks.
       std::string data;
       _msg->SerializeToString(&data);
+      this->serializeCount++;
+      this->serializedBytes += data.size();
+      std::shared_ptr<const std::string> buffer =
+          std::make_shared<const std::string>(std::move(data));
+
       std::list<CallbackHelperPtr>::iterator cbIter;
       cbIter = this->callbacks.begin();
 
       while (cbIter != this->callbacks.end())
       {
-        if ((*cbIter)->HandleData(data, _cb, _id))
+        if ((*cbIter)->HandleBuffer(buffer, _cb, _id))
         {
           ++result;
           ++cbIter;
@@ -400,6 +407,18 @@ unsigned int Publication::GetRemoteSubscriptionCount()
   return count;
 }
 
+//////////////////////////////////////////////////
+uint64_t Publication::SerializeCount() const
+{
+  return this->serializeCount;
+}
+
+//////////////////////////////////////////////////
+uint64_t Publication::SerializedBytes() const
+{
+  return this->serializedBytes;
+}
+
 //////////////////////////////////////////////////
 bool Publication::GetLocallyAdvertised() const
 {
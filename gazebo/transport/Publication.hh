@@ -18,6 +18,7 @@
 #ifndef _PUBLICATION_HH_
 #define _PUBLICATION_HH_
 
+#include <atomic>
 #include <utility>
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
@@ -26,6 +27,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
 #include "gazebo/transport/CallbackHelper.hh"
 #include "gazebo/transport/TransportTypes.hh"
@@ -102,6 +104,17 @@ namespace gazebo
       /// \return The number of remote subscriptions
       public: unsigned int GetRemoteSubscriptionCount();
 
+      /// \brief Get the number of times a message has been serialized for
+      /// the subscribers of this topic. Each published message is
+      /// serialized at most once, whatever the number of subscribers.
+      /// \return Number of serializations.
+      public: uint64_t SerializeCount() const;
+
+      /// \brief Get the number of bytes serialized for the subscribers of
+      /// this topic.
+      /// \return Number of serialized bytes.
+      public: uint64_t SerializedBytes() const;
+
       /// \brief Was the topic has been advertised from this process?
       /// \return true if the topic has been advertised from this process,
       /// false otherwise
@@ -211,6 +224,12 @@ namespace gazebo
 
       /// \brief Publishers and their last messages.
       private: std::map<uint32_t, MessagePtr> prevMsgs;
+
+      /// \brief Number of messages serialized by Publish.
+      private: std::atomic<uint64_t> serializeCount;
+
+      /// \brief Number of bytes serialized by Publish.
+      private: std::atomic<uint64_t> serializedBytes;
     };
     /// \}
   }
@@ -17,7 +17,10 @@
 #include <boost/function.hpp>
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/ConnectionManager.hh"
+#include "gazebo/transport/CompressedTransport.hh"
+#include "gazebo/transport/MulticastTransport.hh"
 #include "gazebo/transport/PublicationTransport.hh"
+#include "gazebo/transport/ShmTransport.hh"
 #include "gazebo/common/WeakBind.hh"
 
 using namespace gazebo;
@@ -37,6 +40,9 @@ PublicationTransport::PublicationTransport(const std::string &_topic,
 /////////////////////////////////////////////////
 PublicationTransport::~PublicationTransport()
 {
+  // Stop the multicast callbacks first.
+  this->multicastReceiver.reset();
+
   if (this->connection)
   {
     msgs::Subscribe sub;
@@ -54,7 +60,8 @@ PublicationTransport::~PublicationTransport()
 }
 
 /////////////////////////////////////////////////
-void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
+void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched,
+    const SubscriptionQoS &_qos)
 {
   this->connection = _conn;
   msgs::Subscribe sub;
@@ -63,6 +70,31 @@ void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
   sub.set_host(this->connection->GetLocalAddress());
   sub.set_port(this->connection->GetLocalPort());
   sub.set_latching(_latched);
+  if (_qos.maxRate > 0)
+    sub.set_max_rate(_qos.maxRate);
+  if (_qos.keepLatest)
+    sub.set_keep_latest(true);
+  if (_qos.queueDepth > 0)
+    sub.set_queue_depth(_qos.queueDepth);
+
+  if (ShmRequested() && ShmConnectionIsLocal(this->connection))
+  {
+    this->shmReader = std::make_shared<ShmReader>();
+    sub.set_shm(true);
+  }
+
+  const int compression = CompressionRequested(this->topic, this->connection);
+  if (compression > 0)
+  {
+    this->decompressor = std::make_shared<MessageDecompressor>();
+    sub.set_compression(compression);
+  }
+
+  if (MulticastRequested())
+  {
+    this->multicastReceiver = std::make_shared<MulticastReceiver>();
+    sub.set_multicast(true);
+  }
 
   this->connection->EnqueueMsg(msgs::Package("sub", sub));
 
@@ -91,9 +123,41 @@ void PublicationTransport::OnPublish(const std::string &_data)
         common::weakBind(&PublicationTransport::OnPublish,
             this->shared_from_this(), _1));
 
-    if (!_data.empty())
+    if (!_data.empty() && this->callback)
     {
-      if (this->callback)
+      if (this->shmReader && ShmReader::IsDescriptor(_data))
+      {
+        std::string data;
+        if (this->shmReader->Read(_data, data))
+          (this->callback)(data);
+      }
+      else if (this->decompressor &&
+          MessageDecompressor::IsCompressed(_data))
+      {
+        std::string data;
+        if (this->decompressor->Decompress(_data, data))
+          (this->callback)(data);
+        else
+          gzerr << "Unable to decompress a message of[" << this->topic << "]\n";
+      }
+      else if (this->multicastReceiver &&
+          MulticastReceiver::IsDescriptor(_data))
+      {
+        // The publisher now sends to the stream. If it can't be joined,
+        // only latched messages arrive over the connection.
+        auto cb = this->callback;
+        if (!this->multicastReceiver->Join(_data,
+              [cb](const std::string &_msg)
+              {
+                cb(_msg);
+              }))
+        {
+          gzerr << "Unable to receive topic[" << this->topic
+                << "] by multicast. Unset GAZEBO_MULTICAST_TRANSPORT to "
+                << "receive it over TCP.\n";
+        }
+      }
+      else
         (this->callback)(_data);
     }
   }
@@ -20,8 +20,10 @@
 
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
+#include <memory>
 #include <string>
 
+#include "gazebo/transport/CallbackHelper.hh"
 #include "gazebo/transport/Connection.hh"
 #include "gazebo/common/Event.hh"
 #include "gazebo/util/system.hh"
@@ -30,6 +32,10 @@ namespace gazebo
 {
   namespace transport
   {
+    class MessageDecompressor;
+    class MulticastReceiver;
+    class ShmReader;
+
     /// \addtogroup gazebo_transport
     /// \{
 
@@ -53,7 +59,9 @@ namespace gazebo
       /// \param[in] _conn The underlying connection.
       /// \param[in] _latched True to grab the last message sent on the
       /// topic.
-      public: void Init(const ConnectionPtr &_conn, bool _latched);
+      /// \param[in] _qos Quality of service requested from the publisher.
+      public: void Init(const ConnectionPtr &_conn, bool _latched,
+                  const SubscriptionQoS &_qos = SubscriptionQoS());
 
       /// \brief Finalize the transport
       public: void Fini();
@@ -96,6 +104,18 @@ namespace gazebo
 
       /// \brief The unique id for the publication transport.
       private: int id;
+
+      /// \brief Reads messages the publisher sent through shared memory.
+      /// Only set if shared memory was requested.
+      private: std::shared_ptr<ShmReader> shmReader;
+
+      /// \brief Receives the messages the publisher sends by multicast.
+      /// Only set if multicast was requested.
+      private: std::shared_ptr<MulticastReceiver> multicastReceiver;
+
+      /// \brief Decompresses the messages sent by the publisher. Only set if
+      /// compression was requested.
+      private: std::shared_ptr<MessageDecompressor> decompressor;
     };
     /// \}
   }
@@ -85,6 +85,28 @@ bool Publisher::WaitForConnection(const common::Time &_timeout) const
 //////////////////////////////////////////////////
 void Publisher::PublishImpl(const google::protobuf::Message &_message,
                             bool _block)
+{
+  if (!this->Accept(_message))
+    return;
+
+  // Save the latest message
+  MessagePtr msgPtr(_message.New());
+  msgPtr->CopyFrom(_message);
+
+  this->Enqueue(msgPtr, _block);
+}
+
+//////////////////////////////////////////////////
+void Publisher::PublishImpl(MessagePtr _message, bool _block)
+{
+  if (!_message || !this->Accept(*_message))
+    return;
+
+  this->Enqueue(_message, _block);
+}
+
+//////////////////////////////////////////////////
+bool Publisher::Accept(const google::protobuf::Message &_message)
 {
   if (_message.GetTypeName() != this->msgType)
     gzthrow("Invalid message type\n");
@@ -94,7 +116,7 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
     gzerr << "Publishing an uninitialized message on topic[" <<
       this->topic << "]. Required field [" <<
       _message.InitializationErrorString() << "] missing.\n";
-    return;
+    return false;
   }
 
   // Check if a throttling rate has been set
@@ -108,23 +130,25 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
         (this->currentTime - this->prevPublishTime).Double() <
         this->updatePeriod)
     {
-      return;
+      return false;
     }
 
     // Set the previous time a message was published
     this->prevPublishTime = this->currentTime;
   }
 
-  // Save the latest message
-  MessagePtr msgPtr(_message.New());
-  msgPtr->CopyFrom(_message);
+  return true;
+}
 
-  this->publication->SetPrevMsg(this->id, msgPtr);
+//////////////////////////////////////////////////
+void Publisher::Enqueue(MessagePtr _message, bool _block)
+{
+  this->publication->SetPrevMsg(this->id, _message);
 
   {
     boost::mutex::scoped_lock lock(this->mutex);
 
-    this->messages.push_back(msgPtr);
+    this->messages.push_back(_message);
 
     if (this->messages.size() > this->queueLimit)
     {
@@ -141,6 +165,10 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
     }
   }
 
+  // Messages published in a batch are sent when the batch ends.
+  if (!_block && this->node && this->node->InPublishBatch())
+    return;
+
   TopicManager::Instance()->AddNodeToProcess(this->node);
 
   if (_block)
@@ -90,6 +90,15 @@ namespace gazebo
                  bool _block = false)
               { this->PublishImpl(_message, _block); }
 
+      /// \brief Publish a message without copying it. The publisher keeps
+      /// the message until it is sent, so the caller must not modify it
+      /// afterwards.
+      /// \param[in] _message Message to be published.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written into the local message buffer, and SendMessage() is called.
+      public: void Publish(MessagePtr _message, bool _block = false)
+              { this->PublishImpl(_message, _block); }
+
       /// \brief Publish an arbitrary message on the topic
       /// \param[in] _message Message to be published
       /// \param[in] _block Whether to block until the message is actually
@@ -147,6 +156,24 @@ namespace gazebo
       private: void PublishImpl(const google::protobuf::Message &_message,
                                 bool _block);
 
+      /// \brief Implementation of Publish without a copy.
+      /// \param[in] _message Message to be published.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void PublishImpl(MessagePtr _message, bool _block);
+
+      /// \brief Check that a message can be published now.
+      /// \param[in] _message Message to be published.
+      /// \return False if the message is invalid or throttled.
+      private: bool Accept(const google::protobuf::Message &_message);
+
+      /// \brief Queue a message and trigger its publication.
+      /// \param[in] _message Message to be published, owned by the
+      /// publisher from now on.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void Enqueue(MessagePtr _message, bool _block);
+
       /// \brief Callback when a publish is completed
       /// \param[in] _id ID associated with the publication.
       private: void OnPublishComplete(uint32_t _id);
@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef _WIN32
+  #include <process.h>
+  #define getpid _getpid
+#else
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/Connection.hh"
+#include "gazebo/transport/ShmTransport.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+namespace
+{
+  /// \brief Header at the start of every shared memory segment.
+  struct SlotHeader
+  {
+    /// \brief 0 if the slot is free, 1 if it holds a message.
+    std::atomic<uint32_t> state;
+
+    /// \brief Unused, keeps size 8 byte aligned.
+    uint32_t reserved;
+
+    /// \brief Number of payload bytes that follow the header.
+    uint64_t size;
+  };
+
+  /// \brief Prefix of a descriptor. Starts with a zero byte, which is not a
+  /// valid protobuf field tag.
+  const char kDescriptorMagic[] = {'\0', 'G', 'Z', 'S', 'H', 'M'};
+
+  /// \brief Default value of GAZEBO_SHM_THRESHOLD.
+  const std::size_t kDefaultThreshold = 1024 * 1024;
+
+  /// \brief Used to create unique segment names.
+  std::atomic<unsigned int> writerCounter(0);
+}
+
+/////////////////////////////////////////////////
+bool transport::ShmRequested()
+{
+  const char *env = std::getenv("GAZEBO_SHM_TRANSPORT");
+  return env && std::string(env) == "1";
+}
+
+/////////////////////////////////////////////////
+bool transport::ShmConnectionIsLocal(const ConnectionPtr &_conn)
+{
+  if (!_conn)
+    return false;
+
+  std::string remote = _conn->GetRemoteAddress();
+  return remote == _conn->GetLocalAddress() || remote.find("127.") == 0;
+}
+
+/////////////////////////////////////////////////
+ShmWriter::ShmWriter(const unsigned int _slotCount)
+  : slots(_slotCount == 0 ? 1 : _slotCount), threshold(kDefaultThreshold)
+{
+  this->prefix = "gz_shm_" + std::to_string(getpid()) + "_" +
+    std::to_string(writerCounter++) + "_";
+
+  const char *env = std::getenv("GAZEBO_SHM_THRESHOLD");
+  if (env && *env)
+  {
+    try
+    {
+      this->threshold = std::stoul(env);
+    }
+    catch(...)
+    {
+      gzwarn << "Invalid GAZEBO_SHM_THRESHOLD value[" << env << "]\n";
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+ShmWriter::~ShmWriter()
+{
+  for (auto &slot : this->slots)
+  {
+    slot.region.reset();
+    if (!slot.name.empty())
+      boost::interprocess::shared_memory_object::remove(slot.name.c_str());
+  }
+}
+
+/////////////////////////////////////////////////
+std::size_t ShmWriter::Threshold() const
+{
+  return this->threshold;
+}
+
+/////////////////////////////////////////////////
+bool ShmWriter::Write(const std::string &_data, std::string &_descriptor)
+{
+  if (_data.size() < this->threshold)
+    return false;
+
+  Slot &slot = this->slots[this->nextSlot];
+
+  // The subscriber has not consumed this slot yet.
+  if (slot.region && static_cast<SlotHeader *>(
+        slot.region->get_address())->state.load(std::memory_order_acquire))
+  {
+    return false;
+  }
+
+  try
+  {
+    // Create or enlarge the segment. The subscriber keeps its mapping of
+    // an old segment valid until it sees the new name.
+    if (!slot.region || slot.capacity < _data.size())
+    {
+      slot.region.reset();
+      if (!slot.name.empty())
+        boost::interprocess::shared_memory_object::remove(slot.name.c_str());
+
+      slot.capacity = std::max(_data.size() + _data.size() / 2,
+          slot.capacity);
+      slot.name = this->prefix + std::to_string(this->nextSlot) + "_" +
+        std::to_string(slot.generation++);
+
+      boost::interprocess::shared_memory_object shm(
+          boost::interprocess::create_only, slot.name.c_str(),
+          boost::interprocess::read_write);
+      shm.truncate(sizeof(SlotHeader) + slot.capacity);
+
+      slot.region.reset(new boost::interprocess::mapped_region(
+            shm, boost::interprocess::read_write));
+      new (slot.region->get_address()) SlotHeader();
+    }
+  }
+  catch(const boost::interprocess::interprocess_exception &_e)
+  {
+    gzwarn << "Unable to create shared memory segment[" << slot.name
+           << "]: " << _e.what() << std::endl;
+    slot.region.reset();
+    return false;
+  }
+
+  SlotHeader *header = static_cast<SlotHeader *>(slot.region->get_address());
+  std::memcpy(reinterpret_cast<char *>(header + 1), _data.data(),
+      _data.size());
+  header->size = _data.size();
+  header->state.store(1, std::memory_order_release);
+
+  uint64_t size = _data.size();
+  _descriptor.assign(kDescriptorMagic, sizeof(kDescriptorMagic));
+  _descriptor.append(reinterpret_cast<const char *>(&size), sizeof(size));
+  _descriptor.append(slot.name);
+
+  this->nextSlot = (this->nextSlot + 1) % this->slots.size();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ShmWriter::Release(const std::string &_descriptor)
+{
+  if (!ShmReader::IsDescriptor(_descriptor))
+    return false;
+
+  std::string name = _descriptor.substr(
+      sizeof(kDescriptorMagic) + sizeof(uint64_t));
+
+  for (auto &slot : this->slots)
+  {
+    if (slot.region && slot.name == name)
+    {
+      SlotHeader *header = static_cast<SlotHeader *>(
+          slot.region->get_address());
+      return header->state.exchange(0, std::memory_order_acq_rel) == 1;
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+bool ShmReader::IsDescriptor(const std::string &_data)
+{
+  return _data.size() > sizeof(kDescriptorMagic) + sizeof(uint64_t) &&
+    std::memcmp(_data.data(), kDescriptorMagic, sizeof(kDescriptorMagic)) == 0;
+}
+
+/////////////////////////////////////////////////
+bool ShmReader::Read(const std::string &_descriptor, std::string &_data)
+{
+  if (!IsDescriptor(_descriptor))
+    return false;
+
+  uint64_t size = 0;
+  std::memcpy(&size, _descriptor.data() + sizeof(kDescriptorMagic),
+      sizeof(size));
+  std::string name = _descriptor.substr(
+      sizeof(kDescriptorMagic) + sizeof(size));
+
+  auto iter = this->regions.find(name);
+  if (iter == this->regions.end())
+  {
+    // Segments that were enlarged are never used again, drop them from
+    // time to time.
+    if (this->regions.size() > 32)
+      this->regions.clear();
+
+    try
+    {
+      boost::interprocess::shared_memory_object shm(
+          boost::interprocess::open_only, name.c_str(),
+          boost::interprocess::read_write);
+      iter = this->regions.emplace(name,
+          std::unique_ptr<boost::interprocess::mapped_region>(
+            new boost::interprocess::mapped_region(
+              shm, boost::interprocess::read_write))).first;
+    }
+    catch(const boost::interprocess::interprocess_exception &_e)
+    {
+      gzerr << "Unable to open shared memory segment[" << name << "]: "
+            << _e.what() << std::endl;
+      return false;
+    }
+  }
+
+  SlotHeader *header = static_cast<SlotHeader *>(iter->second->get_address());
+  if (iter->second->get_size() < sizeof(SlotHeader) + size ||
+      header->state.load(std::memory_order_acquire) != 1 ||
+      header->size != size)
+  {
+    gzerr << "Invalid shared memory segment[" << name << "]\n";
+    return false;
+  }
+
+  _data.assign(reinterpret_cast<const char *>(header + 1), size);
+  header->state.store(0, std::memory_order_release);
+
+  return true;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_SHMTRANSPORT_HH_
+#define GAZEBO_TRANSPORT_SHMTRANSPORT_HH_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "gazebo/transport/TransportTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Shared memory path for large messages sent to subscribers on
+    /// the same host.
+    ///
+    /// A subscriber asks for shared memory in its msgs::Subscribe request
+    /// when GAZEBO_SHM_TRANSPORT is set to 1 and the publisher's connection
+    /// is local. For such a subscription the publisher copies every message
+    /// of at least GAZEBO_SHM_THRESHOLD bytes (1 MiB by default) into one
+    /// slot of a small ring of shared memory segments. Only a descriptor
+    /// naming the slot is sent over the socket. Each slot has a state flag:
+    /// the publisher only fills free slots, and the subscriber frees a slot
+    /// once it has copied the message out. When all slots are still in
+    /// use, because the subscriber is slow, the message goes over the
+    /// socket as usual, so a subscriber is never blocked or starved.
+
+    /// \brief Return true if subscribers should request shared memory.
+    /// \return Value of the GAZEBO_SHM_TRANSPORT environment variable.
+    GZ_TRANSPORT_VISIBLE
+    bool ShmRequested();
+
+    /// \brief Return true if the remote end of a connection is on this host.
+    /// \param[in] _conn Connection to check.
+    /// \return True if the remote address is a local address.
+    GZ_TRANSPORT_VISIBLE
+    bool ShmConnectionIsLocal(const ConnectionPtr &_conn);
+
+    /// \internal
+    /// \brief Publisher side of the shared memory transport.
+    class GZ_TRANSPORT_VISIBLE ShmWriter
+    {
+      /// \brief Constructor
+      /// \param[in] _slotCount Number of shared memory segments in the ring.
+      public: explicit ShmWriter(const unsigned int _slotCount = 4u);
+
+      /// \brief Destructor. Removes the shared memory segments.
+      public: ~ShmWriter();
+
+      /// \brief Copy a message to shared memory.
+      /// \param[in] _data Serialized message.
+      /// \param[out] _descriptor Descriptor to send instead of _data.
+      /// \return False if _data is too small for shared memory or no slot
+      /// is free. _data must then be sent over the socket.
+      public: bool Write(const std::string &_data, std::string &_descriptor);
+
+      /// \brief Free the slot of a descriptor that will never reach the
+      /// subscriber, e.g. because it was dropped from the send queue.
+      /// \param[in] _descriptor Descriptor returned by Write.
+      /// \return True if _descriptor named a slot of this writer that
+      /// was waiting for the subscriber.
+      public: bool Release(const std::string &_descriptor);
+
+      /// \brief Minimum message size that is sent through shared memory.
+      /// \return Size in bytes.
+      public: std::size_t Threshold() const;
+
+      /// \brief A shared memory segment.
+      private: struct Slot
+      {
+        /// \brief Name of the segment.
+        std::string name;
+
+        /// \brief Number of payload bytes the segment can hold.
+        std::size_t capacity = 0;
+
+        /// \brief Number of times the segment was enlarged.
+        unsigned int generation = 0;
+
+        /// \brief Mapping of the segment.
+        std::unique_ptr<boost::interprocess::mapped_region> region;
+      };
+
+      /// \brief Ring of segments.
+      private: std::vector<Slot> slots;
+
+      /// \brief Slot to try next.
+      private: unsigned int nextSlot = 0;
+
+      /// \brief Prefix of the segment names, unique to this writer.
+      private: std::string prefix;
+
+      /// \brief Minimum message size sent through shared memory.
+      private: std::size_t threshold;
+    };
+
+    /// \internal
+    /// \brief Subscriber side of the shared memory transport.
+    class GZ_TRANSPORT_VISIBLE ShmReader
+    {
+      /// \brief Check if data received over a socket is a descriptor.
+      /// Serialized protobuf messages never start with a zero byte, so the
+      /// descriptor can not be confused with a message.
+      /// \param[in] _data Data received over the socket.
+      /// \return True if _data is a shared memory descriptor.
+      public: static bool IsDescriptor(const std::string &_data);
+
+      /// \brief Copy the message named by a descriptor out of shared memory
+      /// and release its slot.
+      /// \param[in] _descriptor Descriptor received over the socket.
+      /// \param[out] _data Serialized message.
+      /// \return True if the message was read.
+      public: bool Read(const std::string &_descriptor, std::string &_data);
+
+      /// \brief Mapped segments, by name.
+      private: std::map<std::string,
+               std::unique_ptr<boost::interprocess::mapped_region>> regions;
+    };
+  }
+}
+#endif
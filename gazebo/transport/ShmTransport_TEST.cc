@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/ShmTransport.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ShmTransport : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(ShmTransport, RoundTrip)
+{
+  transport::ShmWriter writer(2);
+  transport::ShmReader reader;
+
+  // Small messages stay on the socket
+  std::string descriptor;
+  EXPECT_FALSE(writer.Write("small", descriptor));
+
+  msgs::GzString msg;
+  msg.set_data(std::string(writer.Threshold(), 'x'));
+  std::string data;
+  msg.SerializeToString(&data);
+  EXPECT_FALSE(transport::ShmReader::IsDescriptor(data));
+
+  for (int i = 0; i < 5; ++i)
+  {
+    // Grow the message to force larger segments
+    data.append(i * 1000, 'y');
+
+    ASSERT_TRUE(writer.Write(data, descriptor));
+    EXPECT_TRUE(transport::ShmReader::IsDescriptor(descriptor));
+    EXPECT_LT(descriptor.size(), 128u);
+
+    std::string out;
+    EXPECT_TRUE(reader.Read(descriptor, out));
+    EXPECT_EQ(out, data);
+
+    // A slot can only be read once
+    EXPECT_FALSE(reader.Read(descriptor, out));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmTransport, SlotsFull)
+{
+  transport::ShmWriter writer(2);
+  transport::ShmReader reader;
+  std::string data(writer.Threshold(), 'x');
+
+  std::string first, second, third;
+  EXPECT_TRUE(writer.Write(data, first));
+  EXPECT_TRUE(writer.Write(data, second));
+
+  // Both slots wait for the reader, the message must use the socket
+  EXPECT_FALSE(writer.Write(data, third));
+
+  std::string out;
+  EXPECT_TRUE(reader.Read(first, out));
+  EXPECT_EQ(out, data);
+
+  // The first slot is free again
+  EXPECT_TRUE(writer.Write(data, third));
+  EXPECT_TRUE(reader.Read(second, out));
+  EXPECT_TRUE(reader.Read(third, out));
+  EXPECT_EQ(out, data);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmTransport, ReleaseDropped)
+{
+  transport::ShmWriter writer(2);
+  transport::ShmReader reader;
+  std::string data(writer.Threshold(), 'x');
+
+  std::string first, second, third;
+  EXPECT_TRUE(writer.Write(data, first));
+  EXPECT_TRUE(writer.Write(data, second));
+  EXPECT_FALSE(writer.Write(data, third));
+
+  // Drop the first descriptor from the send queue, as a keep latest
+  // subscription does. The next message must still use shared memory.
+  EXPECT_TRUE(writer.Release(first));
+  EXPECT_FALSE(writer.Release(first));
+  ASSERT_TRUE(writer.Write(data + "y", third));
+  EXPECT_TRUE(transport::ShmReader::IsDescriptor(third));
+
+  std::string out;
+  EXPECT_TRUE(reader.Read(second, out));
+  EXPECT_EQ(out, data);
+  EXPECT_TRUE(reader.Read(third, out));
+  EXPECT_EQ(out, data + "y");
+
+  // Descriptors that were read or come from another writer are ignored
+  EXPECT_FALSE(writer.Release(second));
+  transport::ShmWriter other(1);
+  std::string foreign;
+  EXPECT_TRUE(other.Write(data, foreign));
+  EXPECT_FALSE(writer.Release(foreign));
+  EXPECT_FALSE(writer.Release("not a descriptor"));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -103,10 +103,29 @@ namespace gazebo
                 return this->latching;
               }
 
+      /// \brief Get the quality of service requested from remote
+      /// publishers.
+      /// \return The quality of service.
+      public: const SubscriptionQoS &GetQoS() const
+              {
+                return this->qos;
+              }
+
+      /// \brief Set the quality of service requested from remote
+      /// publishers.
+      /// \param[in] _qos The quality of service.
+      public: void SetQoS(const SubscriptionQoS &_qos)
+              {
+                this->qos = _qos;
+              }
+
       private: std::string topic;
       private: std::string msgType;
       private: NodePtr node;
       private: bool latching;
+
+      /// \brief Quality of service requested from remote publishers.
+      private: SubscriptionQoS qos;
     };
     /// \}
   }
@@ -16,7 +16,11 @@
 */
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
+#include <algorithm>
+#include "gazebo/transport/CompressedTransport.hh"
 #include "gazebo/transport/ConnectionManager.hh"
+#include "gazebo/transport/MulticastTransport.hh"
+#include "gazebo/transport/ShmTransport.hh"
 #include "gazebo/transport/SubscriptionTransport.hh"
 
 using namespace gazebo;
@@ -37,10 +41,26 @@ SubscriptionTransport::~SubscriptionTransport()
 }
 
 //////////////////////////////////////////////////
-void SubscriptionTransport::Init(ConnectionPtr _conn, bool _latching)
+void SubscriptionTransport::Init(ConnectionPtr _conn, bool _latching,
+    bool _shm, const SubscriptionQoS &_qos,
+    const std::shared_ptr<MulticastSender> &_multicast,
+    const unsigned int _compression)
 {
   this->connection = _conn;
   this->latching = _latching;
+  this->SetQoS(_qos);
+  if (_shm)
+    this->shmWriter = std::make_shared<ShmWriter>();
+  if (_compression > 0)
+  {
+    this->compressor.reset(
+        new MessageCompressor(static_cast<int>(_compression)));
+  }
+
+  // Tell the subscriber to join the stream.
+  this->multicastSender = _multicast;
+  if (this->multicastSender)
+    this->connection->EnqueueMsg(this->multicastSender->Descriptor());
 }
 
 //////////////////////////////////////////////////
@@ -48,6 +68,24 @@ bool SubscriptionTransport::HandleMessage(MessagePtr _newMsg)
 {
   std::string data;
   _newMsg->SerializeToString(&data);
+
+  // Latched messages only go to this subscriber, over the connection.
+  if (this->multicastSender)
+  {
+    if (!this->connection->IsOpen())
+      return false;
+
+    std::string compressed;
+    if (this->compressor && this->compressor->Compress(data, false,
+          compressed))
+    {
+      this->connection->EnqueueMsg(compressed);
+    }
+    else
+      this->connection->EnqueueMsg(data);
+    return true;
+  }
+
   using namespace boost::placeholders;
   return this->HandleData(data, boost::bind(&dummy_callback_fn, _1), 0);
 }
@@ -55,11 +93,73 @@ bool SubscriptionTransport::HandleMessage(MessagePtr _newMsg)
 //////////////////////////////////////////////////
 bool SubscriptionTransport::HandleData(const std::string &_newdata,
     boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  return this->HandleBuffer(std::make_shared<const std::string>(_newdata),
+      _cb, _id);
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::HandleBuffer(
+    const std::shared_ptr<const std::string> &_newdata,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
 {
   bool result = false;
   if (this->connection->IsOpen())
   {
-    this->connection->EnqueueMsg(_newdata, _cb, _id);
+    if (this->multicastSender && this->multicastSender->Send(_newdata))
+    {
+      if (!_cb.empty())
+        _cb(_id);
+      return true;
+    }
+
+    SubscriptionQoS qos = this->QoS();
+
+    // Drop messages that arrive faster than the subscriber wants them.
+    if (qos.maxRate > 0)
+    {
+      common::Time now = common::Time::GetWallTime();
+      if (this->lastSendTime != common::Time::Zero &&
+          (now - this->lastSendTime).Double() < 1.0 / qos.maxRate)
+      {
+        if (!_cb.empty())
+          _cb(_id);
+        return true;
+      }
+      this->lastSendTime = now;
+    }
+
+    // Bound the number of messages waiting on the connection. Dropped
+    // shared memory descriptors give their slot back to the writer, or
+    // the slot would wait for a read that never comes.
+    if (qos.keepLatest)
+    {
+      this->connection->DropPendingMsgs(std::max(1u, qos.queueDepth) - 1,
+          [this](const std::string &_payload)
+          {
+            if (this->shmWriter && ShmReader::IsDescriptor(_payload))
+              this->shmWriter->Release(_payload);
+          });
+    }
+    else if (qos.queueDepth > 0 &&
+        this->connection->PendingMsgCount() >= qos.queueDepth)
+    {
+      if (!_cb.empty())
+        _cb(_id);
+      return true;
+    }
+
+    // Subscriptions that drop queued messages get messages compressed on
+    // their own, so the next ones can still be decompressed.
+    std::string descriptor;
+    std::string compressed;
+    if (this->shmWriter && this->shmWriter->Write(*_newdata, descriptor))
+      this->connection->EnqueueMsg(descriptor, _cb, _id);
+    else if (this->compressor &&
+        this->compressor->Compress(*_newdata, qos.keepLatest, compressed))
+      this->connection->EnqueueMsg(compressed, _cb, _id);
+    else
+      this->connection->EnqueueMsg(_newdata, _cb, _id);
     result = true;
   }
   else
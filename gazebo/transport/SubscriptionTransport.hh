@@ -19,16 +19,22 @@
 
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
+#include <memory>
 #include <string>
 
 #include "Connection.hh"
 #include "CallbackHelper.hh"
+#include "gazebo/common/Time.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
 {
   namespace transport
   {
+    class MessageCompressor;
+    class MulticastSender;
+    class ShmWriter;
+
     /// \addtogroup gazebo_transport
     /// \{
 
@@ -48,7 +54,19 @@ namespace gazebo
       /// \param[in] _conn The connection to use
       /// \param[in] _latching If true, latch the latest message; if false,
       /// don't latch
-      public: void Init(ConnectionPtr _conn, bool _latching);
+      /// \param[in] _shm If true, send large messages through shared memory.
+      /// \param[in] _qos Quality of service requested by the subscriber.
+      /// \param[in] _multicast If set, messages are sent to this multicast
+      /// stream instead of the connection, and the subscriber is told to
+      /// join it. The quality of service doesn't apply to the stream.
+      /// \param[in] _compression zlib level from 1 to 9 to compress the
+      /// messages sent over the connection with, 0 for no compression.
+      public: void Init(ConnectionPtr _conn, bool _latching,
+                  bool _shm = false,
+                  const SubscriptionQoS &_qos = SubscriptionQoS(),
+                  const std::shared_ptr<MulticastSender> &_multicast =
+                      nullptr,
+                  const unsigned int _compression = 0);
 
       /// \brief Output a message to a connection
       /// \param[in] _newdata The message to be handled
@@ -59,6 +77,17 @@ namespace gazebo
       public: virtual bool HandleData(const std::string &_newdata,
                   boost::function<void(uint32_t)> _cb, uint32_t _id);
 
+      /// \brief Output a message in a shared buffer to a connection. The
+      /// buffer is queued on the connection without a copy.
+      /// \param[in] _newdata The message to be handled
+      /// \return true if the message was handled successfully, false otherwise
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      public: virtual bool HandleBuffer(
+                  const std::shared_ptr<const std::string> &_newdata,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       // Documentation inherited
       public: virtual bool HandleMessage(MessagePtr _newMsg);
 
@@ -72,6 +101,22 @@ namespace gazebo
       public: virtual bool IsLocal() const;
 
       private: ConnectionPtr connection;
+
+      /// \brief Writes large messages to shared memory. Only set if the
+      /// subscriber requested shared memory.
+      private: std::shared_ptr<ShmWriter> shmWriter;
+
+      /// \brief Multicast stream of the topic, shared with its other
+      /// subscribers. Only set if the subscriber accepted multicast.
+      private: std::shared_ptr<MulticastSender> multicastSender;
+
+      /// \brief Compresses the messages sent over the connection. Only set
+      /// if the subscriber requested compression.
+      private: std::unique_ptr<MessageCompressor> compressor;
+
+      /// \brief Wall time of the last message sent to the subscriber, used
+      /// to enforce the subscriber's maximum rate.
+      private: common::Time lastSendTime;
     };
     /// \}
   }
@@ -17,7 +17,11 @@
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
 
+#include <chrono>
+
 #include <boost/function.hpp>
+
+#include "gazebo/common/ThreadRoles.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publication.hh"
@@ -48,6 +52,13 @@ class NodeProcess_TBB
   private: std::vector<NodePtr> *nodes;
 };
 
+/// \brief Smallest number of nodes flushed in parallel. Fewer nodes are
+/// flushed on the calling thread.
+static const size_t kParallelFlushNodes = 16u;
+
+/// \brief Number of nodes flushed by one task.
+static const size_t kFlushGrainSize = 4u;
+
 
 //////////////////////////////////////////////////
 TopicManager::TopicManager()
@@ -153,36 +164,58 @@ void TopicManager::AddNodeToProcess(NodePtr _ptr)
 void TopicManager::ProcessNodes(bool _onlyOut)
 {
   {
-    boost::mutex::scoped_lock lock(this->processNodesMutex);
-    for (boost::unordered_set<NodePtr>::iterator iter =
-        this->nodesToProcess.begin();
-        iter != this->nodesToProcess.end(); ++iter)
+    // One flush at a time, so the messages of a node keep their order.
+    boost::mutex::scoped_lock flushLock(this->flushMutex);
+
+    // Take the marked nodes, nodes can be marked again during the flush.
+    std::vector<NodePtr> toFlush;
     {
-      (*iter)->ProcessPublishers();
+      boost::mutex::scoped_lock lock(this->processNodesMutex);
+      toFlush.assign(this->nodesToProcess.begin(),
+          this->nodesToProcess.end());
+      this->nodesToProcess.clear();
     }
-    this->nodesToProcess.clear();
-  }
 
-  // Note: In general there are very few nodes. So, parallelization is not
-  // needed. Keeping this code for posterity.
-  // int s;
-  // {
-  //   boost::recursive_mutex::scoped_lock lock(this->nodeMutex);
-  //   // store as size might change (spawning)
-  //   s = this->nodes.size();
-  // }
-  // Process nodes in parallel
-  // try
-  // {
-  //   boost::mutex::scoped_lock lock(this->processNodesMutex);
-  //   tbb::parallel_for(tbb::blocked_range<size_t>(0, this->nodes.size(), 10),
-  //       NodeProcess_TBB(&this->nodes));
-  // }
-  // catch(...)
-  // {
-  //   /// Failed to process the nodes this time around. But not to
-  //   /// worry. This function is called again.
-  // }
+    if (!toFlush.empty())
+    {
+      auto start = std::chrono::steady_clock::now();
+      if (toFlush.size() < kParallelFlushNodes)
+      {
+        for (auto &node : toFlush)
+          node->ProcessPublishers();
+      }
+      else
+      {
+        try
+        {
+          common::ThreadRoles::Instance()->Execute("transport_flush",
+              [&toFlush]()
+              {
+                tbb::parallel_for(tbb::blocked_range<size_t>(0,
+                      toFlush.size(), kFlushGrainSize),
+                    NodeProcess_TBB(&toFlush));
+              });
+        }
+        catch(...)
+        {
+          // Failed to flush some of the nodes this time around, flush them
+          // all again on the next call.
+          gzerr << "Failed to flush the publishers of " << toFlush.size()
+                << " nodes" << std::endl;
+          boost::mutex::scoped_lock lock(this->processNodesMutex);
+          this->nodesToProcess.insert(toFlush.begin(), toFlush.end());
+        }
+      }
+
+      const uint64_t ns = static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+      ++this->flushCount;
+      this->flushedNodeCount += toFlush.size();
+      this->flushTime += ns;
+      this->lastFlushTime = ns;
+    }
+  }
 
   if (!this->pauseIncoming && !_onlyOut)
   {
@@ -201,6 +234,30 @@ void TopicManager::ProcessNodes(bool _onlyOut)
   }
 }
 
+//////////////////////////////////////////////////
+uint64_t TopicManager::FlushCount() const
+{
+  return this->flushCount;
+}
+
+//////////////////////////////////////////////////
+uint64_t TopicManager::FlushedNodeCount() const
+{
+  return this->flushedNodeCount;
+}
+
+//////////////////////////////////////////////////
+uint64_t TopicManager::FlushTime() const
+{
+  return this->flushTime;
+}
+
+//////////////////////////////////////////////////
+uint64_t TopicManager::LastFlushTime() const
+{
+  return this->lastFlushTime;
+}
+
 //////////////////////////////////////////////////
 void TopicManager::Publish(const std::string &_topic, MessagePtr _message,
     boost::function<void(uint32_t)> _cb, uint32_t _id)
@@ -343,22 +400,36 @@ void TopicManager::ConnectSubToPub(const msgs::Publish &_pub)
             _pub.msg_type()));
 
       bool latched = false;
+      SubscriptionQoS qos;
+      bool hasQoS = false;
       boost::mutex::scoped_lock lock(this->subscriberMutex);
       SubNodeMap::iterator nodeIter = this->subscribedNodes.find(_pub.topic());
 
       // Find if any local node has a latched subscriber for the new topic
-      // publication transport.
+      // publication transport, and combine the QoS of all subscribers
+      // since they share the transport.
       if (nodeIter != this->subscribedNodes.end())
       {
         std::list<NodePtr>::iterator cbIter;
         for (cbIter = nodeIter->second.begin();
-             cbIter != nodeIter->second.end() && !latched; ++cbIter)
+             cbIter != nodeIter->second.end(); ++cbIter)
         {
-          latched = (*cbIter)->HasLatchedSubscriber(_pub.topic());
+          if (!latched)
+            latched = (*cbIter)->HasLatchedSubscriber(_pub.topic());
+
+          SubscriptionQoS nodeQoS;
+          if ((*cbIter)->SubscriberQoS(_pub.topic(), nodeQoS))
+          {
+            if (hasQoS)
+              qos.Merge(nodeQoS);
+            else
+              qos = nodeQoS;
+            hasQoS = true;
+          }
         }
       }
 
-      publink->Init(conn, latched);
+      publink->Init(conn, latched, qos);
 
       publication->AddTransport(publink);
     }
@@ -23,6 +23,8 @@
 #endif
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <list>
 #include <string>
@@ -80,11 +82,33 @@ namespace gazebo
       /// \param[in] _id The ID of the node to be removed
       public: void RemoveNode(unsigned int _id);
 
-      /// \brief Process all nodes under management
+      /// \brief Process all nodes under management. The publishers of the
+      /// nodes marked by AddNodeToProcess are flushed first. Many nodes are
+      /// flushed in parallel, in the TBB arena of the "transport_flush"
+      /// thread role when it sets a concurrency, see common::ThreadRoles.
+      /// Every node is flushed by a single task and flushes do not overlap,
+      /// so the messages of a node are sent in order.
       /// \param[in] _onlyOut True means only outbound messages on nodes will be
       /// sent. False means nodes process both outbound and inbound messages
       public: void ProcessNodes(bool _onlyOut = false);
 
+      /// \brief Get the number of publisher flushes done by ProcessNodes,
+      /// not counting calls with no node to flush.
+      /// \return Number of flushes.
+      public: uint64_t FlushCount() const;
+
+      /// \brief Get the number of nodes flushed by ProcessNodes.
+      /// \return Number of flushed nodes.
+      public: uint64_t FlushedNodeCount() const;
+
+      /// \brief Get the total wall time spent flushing publishers.
+      /// \return Time in nanoseconds.
+      public: uint64_t FlushTime() const;
+
+      /// \brief Get the wall time of the last flush.
+      /// \return Time in nanoseconds.
+      public: uint64_t LastFlushTime() const;
+
       /// \brief Subscribe to a topic
       /// \param[in] _options The options to use for the subscription
       /// \return Pointer to the newly created subscriber
@@ -264,6 +288,22 @@ namespace gazebo
       /// \brief Mutex to protect node processing
       private: boost::mutex processNodesMutex;
 
+      /// \brief Held while flushing publishers, so that flushes started by
+      /// different threads do not reorder the messages of a node.
+      private: boost::mutex flushMutex;
+
+      /// \brief Number of flushes.
+      private: std::atomic<uint64_t> flushCount{0u};
+
+      /// \brief Number of flushed nodes.
+      private: std::atomic<uint64_t> flushedNodeCount{0u};
+
+      /// \brief Total flush time in nanoseconds.
+      private: std::atomic<uint64_t> flushTime{0u};
+
+      /// \brief Last flush time in nanoseconds.
+      private: std::atomic<uint64_t> lastFlushTime{0u};
+
       private: bool pauseIncoming;
 
       // Singleton implementation
@@ -20,6 +20,7 @@
 #include <boost/lexical_cast.hpp>
 #include <string>
 
+#include "gazebo/transport/CompressedTransport.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publisher.hh"
 #include "gazebo/transport/Subscriber.hh"
@@ -140,6 +141,15 @@ void transport::fini()
   }
   transport::TopicManager::Instance()->Fini();
   transport::ConnectionManager::Instance()->Fini();
+
+  const CompressionStatistics stats = TransportCompressionStatistics();
+  if (stats.compressedMessages > 0 || stats.decompressedMessages > 0)
+  {
+    gzlog << "Transport compression: " << stats.compressedMessages
+          << " messages compressed " << stats.Ratio() << ":1 in "
+          << stats.compressTime << " s, " << stats.decompressedMessages
+          << " messages decompressed in " << stats.decompressTime << " s\n";
+  }
 }
 
 /////////////////////////////////////////////////
@@ -14,9 +14,13 @@
  * limitations under the License.
  *
  */
+#include <chrono>
+#include <cmath>
 #include <functional>
+#include <map>
 #include <set>
 #include <string>
+#include <vector>
 #include <ignition/math/Rand.hh>
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
@@ -32,6 +36,29 @@
 using namespace gazebo;
 using namespace gazebo::util;
 
+/// \brief Parse the value of a "rate" filter parameter.
+/// \param[in] _value Rate in Hz, zero disables the rate limit.
+/// \param[out] _rate Parsed rate.
+/// \return True if _value is a non-negative number.
+static bool ParseRate(const std::string &_value, double &_rate)
+{
+  try
+  {
+    _rate = std::stod(_value);
+  }
+  catch(...)
+  {
+    _rate = -1;
+  }
+
+  if (!std::isfinite(_rate) || _rate < 0)
+  {
+    gzwarn << "Invalid rate [" << _value << "]." << std::endl;
+    return false;
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 IntrospectionManager::IntrospectionManager()
   : dataPtr(new IntrospectionManagerPrivate)
@@ -114,6 +141,7 @@ bool IntrospectionManager::Register(const std::string &_item,
   this->dataPtr->allItems[_item] = _cb;
 
   this->dataPtr->itemsUpdated = true;
+  this->dataPtr->planDirty = true;
 
   return true;
 }
@@ -135,6 +163,7 @@ bool IntrospectionManager::Unregister(const std::string &_item)
   this->dataPtr->allItems.erase(_item);
 
   this->dataPtr->itemsUpdated = true;
+  this->dataPtr->planDirty = true;
 
   return true;
 }
@@ -146,6 +175,7 @@ void IntrospectionManager::Clear()
   this->dataPtr->allItemsKeys.clear();
   this->dataPtr->allItems.clear();
   this->dataPtr->itemsUpdated = true;
+  this->dataPtr->planDirty = true;
 }
 
 //////////////////////////////////////////////////
@@ -162,90 +192,136 @@ std::set<std::string> IntrospectionManager::Items() const
 }
 
 //////////////////////////////////////////////////
-void IntrospectionManager::Update()
+void IntrospectionManagerPrivate::RebuildPlan()
 {
-  std::map<std::string, IntrospectionFilter> filtersCopy;
-  std::map<std::string, ObservedItem> observedItemsCopy;
-  std::map<std::string, std::function <gazebo::msgs::Any ()>> usedItemsCopy;
+  // Keep the schedule of the rate limited filters.
+  std::map<std::string, std::chrono::steady_clock::time_point> schedule;
+  for (auto const &filter : this->planFilters)
+    schedule[filter.topic] = filter.next;
+
+  this->planItems.clear();
+  this->planFilters.clear();
 
+  std::map<std::string, size_t> indices;
+  for (auto const &observedItem : this->observedItems)
   {
-    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto &item = observedItem.first;
+    auto itemIter = this->allItems.find(item);
 
-    filtersCopy = this->dataPtr->filters;
-    observedItemsCopy = this->dataPtr->observedItems;
+    // Sanity check: Make sure that someone registered this item.
+    if (itemIter == this->allItems.end())
+      continue;
 
-    for (const auto &observedItem: this->dataPtr->observedItems)
-    {
-      auto &item = observedItem.first;
-      // Sanity check: Make sure that someone registered this item.
-      if (this->dataPtr->allItemsKeys.count(item) == 0)
-      {
-        continue;
-      }
+    indices[item] = this->planItems.size();
+    PlannedItem planned;
+    planned.name = item;
+    planned.cb = itemIter->second;
+    this->planItems.push_back(std::move(planned));
+  }
 
-      usedItemsCopy[item] = this->dataPtr->allItems[item];
-    }
+  for (auto const &filter : this->filters)
+  {
+    PlannedFilter planned;
+    planned.topic = this->prefix + "filter/" + filter.first;
 
-    for (auto& filter: filtersCopy)
+    auto pubIter = this->filterPubs.find(planned.topic);
+    if (pubIter == this->filterPubs.end())
     {
-      for (auto const &item : filter.second.items)
-      {
-        // Sanity check: Make sure that someone registered this item.
-        if (this->dataPtr->allItemsKeys.count(item) == 0)
-        {
-          continue;
-        }
-        usedItemsCopy[item] = this->dataPtr->allItems[item];
-      }
+      gzerr << "No publisher for topic [" << planned.topic << "]"
+        << std::endl;
+      continue;
     }
-  }
+    planned.pub = pubIter->second;
 
-  for (auto &observedItem : observedItemsCopy)
-  {
-    auto &item = observedItem.first;
-    auto itemIter = usedItemsCopy.find(item);
+    for (auto const &item : filter.second.items)
+    {
+      auto index = indices.find(item);
+      if (index != indices.end())
+        planned.items.push_back(index->second);
+    }
 
-    // Sanity check: Make sure that we can update the item.
-    if (itemIter == usedItemsCopy.end())
+    // Nothing to publish until one of the items is registered.
+    if (planned.items.empty())
       continue;
 
-    try
+    if (filter.second.rate > 0)
     {
-      // Update the values of the items under observation.
-      gazebo::msgs::Any value = itemIter->second();
-      auto &lastValue = observedItem.second.lastValue;
-      lastValue.CopyFrom(value);
+      planned.period =
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / filter.second.rate));
     }
-    catch(...)
+
+    auto next = schedule.find(planned.topic);
+    if (next != schedule.end())
+      planned.next = next->second;
+
+    this->planFilters.push_back(std::move(planned));
+  }
+}
+
+//////////////////////////////////////////////////
+void IntrospectionManager::Update()
+{
+  std::lock_guard<std::mutex> updateLock(this->dataPtr->updateMutex);
+
+  // The plan only changes when filters or items are added or removed, so
+  // most updates evaluate it without copying anything.
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->planDirty)
     {
-      gzerr << "Exception caught calling user callback" << std::endl;
-      continue;
+      this->dataPtr->RebuildPlan();
+      this->dataPtr->planDirty = false;
     }
   }
 
-  // Prepare the next message to be sent in each filter.
-  for (auto &filter : filtersCopy)
+  const auto now = std::chrono::steady_clock::now();
+  const uint64_t updateCount = ++this->dataPtr->updateCount;
+
+  for (auto &filter : this->dataPtr->planFilters)
   {
+    // Skip rate limited filters that published recently.
+    if (now < filter.next)
+      continue;
+
+    if (filter.period > std::chrono::steady_clock::duration::zero())
+    {
+      filter.next += filter.period;
+      if (filter.next <= now)
+        filter.next = now + filter.period;
+    }
+
     // First of all, clear the old message.
-    auto &nextMsg = filter.second.msg;
+    auto &nextMsg = filter.msg;
     nextMsg.Clear();
 
-    // Insert the last value of each item under observation for this filter.
-    for (auto const &item : filter.second.items)
+    for (auto const index : filter.items)
     {
-      // Sanity check: Make sure that someone registered this item.
-      if (usedItemsCopy.find(item) == usedItemsCopy.end())
-        continue;
+      auto &item = this->dataPtr->planItems[index];
+
+      // Items shared by several filters are evaluated once per update.
+      if (item.evaluated != updateCount)
+      {
+        item.evaluated = updateCount;
+        try
+        {
+          item.value = item.cb();
+        }
+        catch(...)
+        {
+          gzerr << "Exception caught calling user callback" << std::endl;
+          item.value.Clear();
+        }
+      }
 
       // Sanity check: Make sure that the value was updated.
       // (e.g.: an exception was not raised).
-      auto &lastValue = observedItemsCopy[item].lastValue;
-      if (lastValue.type() == gazebo::msgs::Any::NONE)
+      if (item.value.type() == gazebo::msgs::Any::NONE)
         continue;
 
       auto nextParam = nextMsg.add_param();
-      nextParam->set_name(item);
-      nextParam->mutable_value()->CopyFrom(lastValue);
+      nextParam->set_name(item.name);
+      nextParam->mutable_value()->CopyFrom(item.value);
     }
 
     // Sanity check: Make sure that we have at least one item updated.
@@ -253,17 +329,10 @@ void IntrospectionManager::Update()
       continue;
 
     // Publish the update for this filter.
-    std::string topicName = this->dataPtr->prefix + "filter/" + filter.first;
-
+    if (!filter.pub.Publish(nextMsg))
     {
-      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-      if (this->dataPtr->filterPubs.find(topicName) ==
-          this->dataPtr->filterPubs.end() ||
-          !this->dataPtr->filterPubs[topicName].Publish(nextMsg))
-      {
-        gzerr << "Error publishing update for topic [" << topicName << "]"
-          << std::endl;
-      }
+      gzerr << "Error publishing update for topic [" << filter.topic << "]"
+        << std::endl;
     }
   }
 
@@ -298,7 +367,7 @@ void IntrospectionManager::NotifyUpdates()
 
 //////////////////////////////////////////////////
 bool IntrospectionManager::NewFilterImpl(const std::set<std::string> &_newItems,
-    std::string &_filterId)
+    std::string &_filterId, const double _rate)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
@@ -331,6 +400,8 @@ bool IntrospectionManager::NewFilterImpl(const std::set<std::string> &_newItems,
 
   // Add the items to the new filter.
   this->dataPtr->filters[_filterId].items = _newItems;
+  this->dataPtr->filters[_filterId].rate = _rate;
+  this->dataPtr->planDirty = true;
 
   // Register the new filter in the list of observed items.
   for (auto const &item : _newItems)
@@ -341,7 +412,7 @@ bool IntrospectionManager::NewFilterImpl(const std::set<std::string> &_newItems,
 
 //////////////////////////////////////////////////
 bool IntrospectionManager::UpdateFilterImpl(const std::string &_filterId,
-    const std::set<std::string> &_newItems)
+    const std::set<std::string> &_newItems, const double _rate)
 {
   // Sanity check: Make sure that we have at least one item to be observed.
   if (_newItems.empty())
@@ -366,6 +437,9 @@ bool IntrospectionManager::UpdateFilterImpl(const std::string &_filterId,
 
   // Update the list of items for this filter.
   this->dataPtr->filters[_filterId].items = _newItems;
+  if (_rate >= 0)
+    this->dataPtr->filters[_filterId].rate = _rate;
+  this->dataPtr->planDirty = true;
 
   // The next block is needed for updating the 'observedItems' data structure
   // that contains references to the filters.
@@ -429,6 +503,7 @@ bool IntrospectionManager::RemoveFilterImpl(const std::string &_filterId)
 
   // Let's remove the filter.
   this->dataPtr->filters.erase(_filterId);
+  this->dataPtr->planDirty = true;
 
   // Remove any reference to this filter inside observedItems.
   for (auto const &oldItem : oldItems)
@@ -459,24 +534,43 @@ bool IntrospectionManager::NewFilter(const gazebo::msgs::Param_V &_req,
   }
 
   std::set<std::string> requestedItems;
+  double rate = 0;
 
   // Store the new filter.
   for (auto i = 0; i < _req.param_size(); ++i)
   {
     auto param = _req.param(i);
-    if (!this->ValidateParameter(param, {"item"}))
+    if (!this->ValidateParameter(param, {"item", "rate"}))
     {
       gzwarn << "Invalid parameter[" << param.name() << "] "
         << "Ignoring request." << std::endl;
       return false;
     }
 
+    if (param.name() == "rate")
+    {
+      if (!ParseRate(param.value().string_value(), rate))
+      {
+        gzwarn << "Ignoring request." << std::endl;
+        return false;
+      }
+      continue;
+    }
+
     auto item = param.value().string_value();
     requestedItems.emplace(item);
   }
 
+  // Sanity check: Make sure that we have at least one item to be observed.
+  if (requestedItems.empty())
+  {
+    gzwarn << "Filter request with empty list of items." << std::endl;
+    gzwarn << "Ignoring request." << std::endl;
+    return false;
+  }
+
   std::string topicName;
-  if (!this->NewFilterImpl(requestedItems, topicName))
+  if (!this->NewFilterImpl(requestedItems, topicName, rate))
   {
     gzwarn << "Ignoring request." << std::endl;
     return false;
@@ -501,11 +595,12 @@ bool IntrospectionManager::UpdateFilter(const gazebo::msgs::Param_V &_req,
 
   std::set<std::string> newItems;
   std::string filterId;
+  double rate = -1;
 
   for (auto i = 0; i < _req.param_size(); ++i)
   {
     auto param = _req.param(i);
-    if (!this->ValidateParameter(param, {"item", "filter_id"}))
+    if (!this->ValidateParameter(param, {"item", "filter_id", "rate"}))
     {
       gzwarn << "Ignoring request." << std::endl;
       return false;
@@ -529,6 +624,14 @@ bool IntrospectionManager::UpdateFilter(const gazebo::msgs::Param_V &_req,
       // Save filter ID to be updated.
       filterId = param.value().string_value();
     }
+    else if (param.name() == "rate")
+    {
+      if (!ParseRate(param.value().string_value(), rate))
+      {
+        gzwarn << "Ignoring request." << std::endl;
+        return false;
+      }
+    }
     else
     {
       gzwarn << "Unexpected param name [" << param.name() << "]." << std::endl;
@@ -545,7 +648,7 @@ bool IntrospectionManager::UpdateFilter(const gazebo::msgs::Param_V &_req,
     return false;
   }
 
-  return this->UpdateFilterImpl(filterId, newItems);
+  return this->UpdateFilterImpl(filterId, newItems, rate);
 }
 
 //////////////////////////////////////////////////
@@ -86,7 +86,8 @@ namespace gazebo
       /// \brief Update all the items under observation and publish updates
       /// through all the topics. The message received in the update will
       /// contain the name and latest values of all the items specified
-      /// in the filter.
+      /// in the filter. Only the items of the filters due for publication
+      /// are evaluated, each of them once.
       /// If there are changes in the items list since the last update,
       /// a new message is published under the topic
       /// "/introspection/<manager_id>/items_update".
@@ -119,16 +120,22 @@ namespace gazebo
       /// for future filter updates or for removing it. After the filter
       /// creation, a client should subscribe to the topic
       /// /introspection/filter/<filter_id> for receiving updates.
+      /// \param[in] _rate Maximum publication rate in Hz, zero publishes on
+      /// every update.
       /// \return True if the filter was successfully created or false otherwise
       private: bool NewFilterImpl(const std::set<std::string> &_newItems,
-                                  std::string &_filterId);
+                                  std::string &_filterId,
+                                  const double _rate = 0);
 
       /// \brief Update an existing filter with a different set of items.
       /// \param[in] _filterId ID of the filter to update.
       /// \param[in] _newItems Non-empty set of items to be observed.
+      /// \param[in] _rate Maximum publication rate in Hz, zero publishes on
+      /// every update. A negative rate keeps the current one.
       /// \return True if the filter was successfuly updated or false otherwise.
       private: bool UpdateFilterImpl(const std::string &_filterId,
-                                     const std::set<std::string> &_newItems);
+                                     const std::set<std::string> &_newItems,
+                                     const double _rate = -1);
 
       /// \brief Remove an existing filter.
       /// \param[in] _filterId ID of the filter to remove.
@@ -139,6 +146,8 @@ namespace gazebo
       /// \param[in] _req Input parameter of the service request. The service
       /// expects a collection of one or more parameters with name "item" and a
       /// value of type STRING containing the name of the item to observe.
+      /// An optional parameter with name "rate" and a STRING value such as
+      /// "10" limits the publications of the filter to a rate in Hz.
       /// \param[out] _rep Output parameter of the service request. It contains
       /// the filter ID created.
       /// \return True when the operation succeed or false
@@ -152,6 +161,7 @@ namespace gazebo
       /// containing the filter ID to be updated. Also, it's expected to have
       /// a collection of one or more parameters with name "item" and a
       /// value of type STRING containing the name of the item to observe.
+      /// An optional "rate" parameter changes the rate limit of the filter.
       /// \param[out] _rep Not used.
       /// \return True when the filter was successfully updated or
       /// false otherwise.
@@ -17,11 +17,14 @@
 #ifndef GAZEBO_UTIL_INTROSPECTION_MANAGER_PRIVATE_HH_
 #define GAZEBO_UTIL_INTROSPECTION_MANAGER_PRIVATE_HH_
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 #include <ignition/transport.hh>
 #include "gazebo/msgs/any.pb.h"
 #include "gazebo/msgs/param_v.pb.h"
@@ -37,24 +40,68 @@ namespace gazebo
       /// \brief Items observed by this filter.
       std::set<std::string> items;
 
-      /// \brief Message containing the next update. A message is a collection
-      /// of items and values.
-      msgs::Param_V msg;
+      /// \brief Maximum publication rate in Hz, zero publishes on every
+      /// update.
+      double rate = 0;
     };
 
-    /// \brief Todo.
+    /// \brief An item with at least one active observer.
     struct ObservedItem
     {
-      /// \brief ToDo.
-      gazebo::msgs::Any lastValue;
-
-      /// \brief ToDo.
+      /// \brief Filters that contain the item.
       std::set<std::string> filters;
     };
 
+    /// \brief An observed item, as evaluated by
+    /// IntrospectionManager::Update.
+    struct PlannedItem
+    {
+      /// \brief Name of the item.
+      std::string name;
+
+      /// \brief Callback returning the value of the item.
+      std::function<gazebo::msgs::Any ()> cb;
+
+      /// \brief Last value of the item.
+      gazebo::msgs::Any value;
+
+      /// \brief Update during which the value was last evaluated.
+      uint64_t evaluated = 0;
+    };
+
+    /// \brief A filter, as published by IntrospectionManager::Update.
+    struct PlannedFilter
+    {
+      /// \brief Topic of the filter.
+      std::string topic;
+
+      /// \brief Publisher of the filter.
+      ignition::transport::Node::Publisher pub;
+
+      /// \brief Indices in IntrospectionManagerPrivate::planItems of the
+      /// items of the filter.
+      std::vector<size_t> items;
+
+      /// \brief Message containing the next update. A message is a collection
+      /// of items and values.
+      msgs::Param_V msg;
+
+      /// \brief Minimum time between two publications, zero if the filter
+      /// is not rate limited.
+      std::chrono::steady_clock::duration period =
+          std::chrono::steady_clock::duration::zero();
+
+      /// \brief Earliest time of the next publication.
+      std::chrono::steady_clock::time_point next;
+    };
+
     /// \brief Private data for the IntrospectionManager class.
     class IntrospectionManagerPrivate
     {
+      /// \brief Rebuild planItems and planFilters from the filters and the
+      /// registered items. Must be called with mutex locked.
+      public: void RebuildPlan();
+
       /// \brief List of active filters.
       /// The key is the topic where the filter publishes updates.
       /// The value is the associated introspection filter.
@@ -102,6 +149,25 @@ namespace gazebo
 
       /// \brief Items update publisher for ignition transport.
       public: ignition::transport::Node::Publisher itemsUpdatePub;
+
+      /// \brief True when the filters or the registered items changed since
+      /// the plan was built.
+      public: bool planDirty = true;
+
+      /// \brief Observed items that are registered, evaluated by Update.
+      /// Only accessed by Update, with updateMutex locked.
+      public: std::vector<PlannedItem> planItems;
+
+      /// \brief Filters with at least one registered item, published by
+      /// Update. Only accessed by Update, with updateMutex locked.
+      public: std::vector<PlannedFilter> planFilters;
+
+      /// \brief Number of calls to Update.
+      public: uint64_t updateCount = 0;
+
+      /// \brief Serializes calls to Update, so the plan can be evaluated
+      /// without holding mutex.
+      public: std::mutex updateMutex;
     };
   }
 }
@@ -15,12 +15,18 @@
  *
 */
 
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Quaternion.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/transport.hh>
 #include <gtest/gtest.h>
 #include "gazebo/msgs/any.pb.h"
+#include "gazebo/msgs/empty.pb.h"
+#include "gazebo/msgs/gz_string.pb.h"
+#include "gazebo/msgs/param_v.pb.h"
 #include "gazebo/util/IntrospectionManager.hh"
 #include "test/util.hh"
 
@@ -240,6 +246,70 @@ TEST_F(IntrospectionManagerTest, UpdateItems)
   EXPECT_EQ(items.param_size(), 0);
 }
 
+/////////////////////////////////////////////////
+TEST_F(IntrospectionManagerTest, FilterRate)
+{
+  const std::string prefix = "/introspection/" + this->manager->Id() + "/";
+  ignition::transport::Node node;
+
+  // Observe two items at 1 Hz.
+  gazebo::msgs::Param_V req;
+  for (auto const &item : {"item1", "item2"})
+  {
+    auto param = req.add_param();
+    param->set_name("item");
+    param->mutable_value()->set_type(gazebo::msgs::Any::STRING);
+    param->mutable_value()->set_string_value(item);
+  }
+  auto param = req.add_param();
+  param->set_name("rate");
+  param->mutable_value()->set_type(gazebo::msgs::Any::STRING);
+  param->mutable_value()->set_string_value("1");
+
+  gazebo::msgs::GzString rep;
+  bool result = false;
+  ASSERT_TRUE(node.Request(prefix + "filter_new", req, 1000u, rep, result));
+  ASSERT_TRUE(result);
+  const std::string filterId = rep.data();
+
+  std::atomic<int> count(0);
+  std::function<void(const gazebo::msgs::Param_V&)> subCb =
+    [&count](const gazebo::msgs::Param_V &_msg)
+    {
+      EXPECT_EQ(_msg.param_size(), 2);
+      ++count;
+    };
+  EXPECT_TRUE(node.Subscribe(prefix + "filter/" + filterId, subCb));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  // Only the first of many quick updates is published.
+  for (int i = 0; i < 10; ++i)
+    this->manager->Update();
+
+  // Wait for asynchronous comms
+  for (int i = 0; i < 10 && count == 0; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(count, 1);
+
+  // An invalid rate is rejected.
+  req.mutable_param(2)->mutable_value()->set_string_value("-1");
+  result = true;
+  node.Request(prefix + "filter_new", req, 1000u, rep, result);
+  EXPECT_FALSE(result);
+
+  // Remove the filter.
+  gazebo::msgs::Param_V removeReq;
+  param = removeReq.add_param();
+  param->set_name("filter_id");
+  param->mutable_value()->set_type(gazebo::msgs::Any::STRING);
+  param->mutable_value()->set_string_value(filterId);
+  gazebo::msgs::Empty removeRep;
+  EXPECT_TRUE(node.Request(prefix + "filter_remove", removeReq, 1000u,
+        removeRep, result));
+  EXPECT_TRUE(result);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
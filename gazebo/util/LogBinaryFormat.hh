@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_UTIL_LOGBINARYFORMAT_HH_
+#define _GAZEBO_UTIL_LOGBINARYFORMAT_HH_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Layout of log files recorded with the "bin" encoding.
+    ///
+    /// A binary log starts with kMagic, the uint32 format version and the
+    /// length prefixed XML <header> block. It is followed by a sequence of
+    /// chunks, each one a ChunkHeader and the zlib compressed state data.
+    /// Closing the log appends the time index: one IndexEntry per chunk,
+    /// then a Footer. Integers are stored in host byte order, which is
+    /// little endian on all supported platforms.
+    ///
+    /// The state data inside a chunk is the same <sdf> text stored by the
+    /// XML encodings, so LogPlay can hand it out unchanged. Only the
+    /// container is binary, which removes the Base64 overhead and lets a
+    /// reader locate any chunk from the footer without parsing the file.
+    namespace logbin
+    {
+      /// \brief Marks the start of a binary log file.
+      static const char kMagic[8] = {'G', 'Z', 'L', 'O', 'G', 'B', 'I', 'N'};
+
+      /// \brief Marks the end of the time index.
+      static const char kIndexMagic[8] =
+          {'G', 'Z', 'L', 'O', 'G', 'I', 'D', 'X'};
+
+      /// \brief Version of the binary container.
+      static const uint32_t kVersion = 1u;
+
+      /// \brief Name of the encoding in LogRecord and LogPlay.
+      static const char kEncoding[] = "bin";
+
+      /// \brief Header written in front of every chunk.
+      struct ChunkHeader
+      {
+        /// \brief Number of compressed bytes that follow the header.
+        uint32_t compressedSize;
+
+        /// \brief Number of bytes after decompression.
+        uint32_t size;
+      };
+
+      /// \brief Time index entry for a single chunk.
+      struct IndexEntry
+      {
+        /// \brief File offset of the chunk header.
+        uint64_t offset;
+
+        /// \brief Seconds of the first <sim_time> in the chunk.
+        int32_t sec;
+
+        /// \brief Nanoseconds of the first <sim_time> in the chunk.
+        int32_t nsec;
+
+        /// \brief 1 if the chunk contains a <sim_time>, 0 otherwise.
+        uint32_t hasTime;
+
+        /// \brief Unused, keeps the entry 8 byte aligned.
+        uint32_t reserved;
+      };
+
+      /// \brief Trailer at the very end of a closed binary log.
+      struct Footer
+      {
+        /// \brief File offset of the first IndexEntry.
+        uint64_t indexOffset;
+
+        /// \brief Number of IndexEntry records.
+        uint64_t count;
+
+        /// \brief Always kIndexMagic.
+        char magic[8];
+      };
+
+      static_assert(sizeof(ChunkHeader) == 8, "Unexpected ChunkHeader size");
+      static_assert(sizeof(IndexEntry) == 24, "Unexpected IndexEntry size");
+      static_assert(sizeof(Footer) == 24, "Unexpected Footer size");
+
+      /// \brief Append the raw bytes of a POD value to a buffer.
+      /// \param[in] _value Value to append.
+      /// \param[out] _buffer Buffer to append to.
+      template<typename T>
+      void Append(const T &_value, std::string &_buffer)
+      {
+        _buffer.append(reinterpret_cast<const char *>(&_value), sizeof(T));
+      }
+    }
+  }
+}
+#endif
@@ -23,6 +23,8 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
@@ -35,6 +37,9 @@
 #include <boost/archive/iterators/istream_iterator.hpp>
 #include <boost/archive/iterators/transform_width.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <ignition/math/Rand.hh>
 
 #include "gazebo/common/Exception.hh"
@@ -72,6 +77,23 @@ void LogPlay::Open(const std::string &_logFile)
   if (boost::filesystem::is_directory(path))
     gzthrow("Invalid logfile [" + _logFile + "]. This is a directory.");
 
+  // Binary logs are recognized by their magic number.
+  {
+    char magic[sizeof(logbin::kMagic)] = {0};
+    std::ifstream inFile(_logFile, std::ios::binary);
+    inFile.read(magic, sizeof(magic));
+    if (inFile && std::memcmp(magic, logbin::kMagic, sizeof(magic)) == 0)
+    {
+      this->OpenBinary(_logFile);
+      return;
+    }
+  }
+
+  this->dataPtr->binary = false;
+  this->dataPtr->index.clear();
+  if (this->dataPtr->binFile.is_open())
+    this->dataPtr->binFile.close();
+
   // Flag use to indicate if a parser failure has occurred
   bool xmlParserFail = this->dataPtr->xmlDoc.LoadFile(_logFile.c_str()) !=
     tinyxml2::XML_SUCCESS;
@@ -147,24 +169,101 @@ void LogPlay::Open(const std::string &_logFile)
   // Read in the header.
   this->ReadHeader();
 
-  this->dataPtr->logCurrXml = this->dataPtr->logStartXml;
   this->dataPtr->encoding.clear();
 
+  // Keep the chunk elements, so chunks can be accessed by index.
+  this->dataPtr->chunkXmls.clear();
+  for (auto xml = this->dataPtr->logStartXml->FirstChildElement("chunk");
+       xml; xml = xml->NextSiblingElement("chunk"))
+  {
+    this->dataPtr->chunkXmls.push_back(xml);
+  }
+  this->dataPtr->ClearChunkCache();
+
+  // The time index of XML logs is built on the first seek, unless it was
+  // saved next to the log file by a previous session.
+  this->dataPtr->indexValid = this->dataPtr->ReadIndexFile();
+
   // Extract the start/end log times from the log.
   this->ReadLogTimes();
 
   // Extract the initial "iterations" value from the log.
   this->dataPtr->iterationsFound = this->ReadIterations();
 
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->FirstChildElement("chunk");
+  if (this->dataPtr->chunkXmls.empty())
+    gzthrow("Unable to find the first chunk");
+
+  this->dataPtr->chunkIndex = 0;
+  if (!this->dataPtr->LoadChunk(0, this->dataPtr->currentChunk))
+    gzthrow("Unable to decode log file");
 
-  if (!this->dataPtr->logCurrXml)
+  this->dataPtr->start = 0;
+  this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
+}
+
+/////////////////////////////////////////////////
+void LogPlay::OpenBinary(const std::string &_logFile)
+{
+  this->dataPtr->logStartXml = nullptr;
+  this->dataPtr->chunkXmls.clear();
+  this->dataPtr->index.clear();
+  this->dataPtr->ClearChunkCache();
+
+  if (this->dataPtr->binFile.is_open())
+    this->dataPtr->binFile.close();
+  this->dataPtr->binFile.clear();
+  this->dataPtr->binFile.open(_logFile, std::ios::binary);
+
+  char magic[sizeof(logbin::kMagic)];
+  uint32_t version = 0;
+  uint32_t headerSize = 0;
+  this->dataPtr->binFile.read(magic, sizeof(magic));
+  this->dataPtr->binFile.read(reinterpret_cast<char *>(&version),
+      sizeof(version));
+  this->dataPtr->binFile.read(reinterpret_cast<char *>(&headerSize),
+      sizeof(headerSize));
+
+  if (!this->dataPtr->binFile)
+    gzthrow("Unable to read binary log file[" + _logFile + "]");
+
+  if (version != logbin::kVersion)
+  {
+    gzthrow("Unsupported binary log version[" + std::to_string(version) +
+        "] in file[" + _logFile + "]");
+  }
+
+  std::string header(headerSize, '\0');
+  this->dataPtr->binFile.read(&header[0], headerSize);
+  if (!this->dataPtr->binFile)
+    gzthrow("Binary log file[" + _logFile + "] has a truncated header");
+
+  // Parse the header with the same code used for XML logs.
+  header = "<gazebo_log>" + header + "</gazebo_log>";
+  if (this->dataPtr->xmlDoc.Parse(header.c_str()) != tinyxml2::XML_SUCCESS)
+    gzthrow("Error parsing header of log file[" + _logFile + "]");
+
+  this->dataPtr->logStartXml =
+    this->dataPtr->xmlDoc.FirstChildElement("gazebo_log");
+  this->dataPtr->filename = _logFile;
+  this->dataPtr->binary = true;
+  this->dataPtr->encoding.clear();
+
+  if (!this->dataPtr->ReadBinaryIndex(
+        static_cast<uint64_t>(this->dataPtr->binFile.tellg())))
+  {
+    this->dataPtr->logStartXml = nullptr;
     gzthrow("Unable to find the first chunk");
+  }
+  this->dataPtr->indexValid = true;
 
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+  this->ReadHeader();
+  this->ReadLogTimes();
+  this->dataPtr->iterationsFound = this->ReadIterations();
+
+  this->dataPtr->chunkIndex = 0;
+  if (!this->dataPtr->LoadChunk(0, this->dataPtr->currentChunk))
   {
+    this->dataPtr->logStartXml = nullptr;
     gzthrow("Unable to decode log file");
   }
 
@@ -261,7 +360,11 @@ void LogPlay::ReadLogTimes()
   std::string chunk;
   bool found = false;
 
-  auto chunkXml = this->dataPtr->logStartXml->FirstChildElement("chunk");
+  if (this->ChunkCount() == 0)
+  {
+    gzerr << "Unable to find the first chunk" << std::endl;
+    return;
+  }
 
   // Try to read the start time of the log.
   auto numChunksToTry =
@@ -269,13 +372,7 @@ void LogPlay::ReadLogTimes()
 
   for (unsigned int i = 0; i < numChunksToTry; ++i)
   {
-    if (!chunkXml)
-    {
-      gzerr << "Unable to find the first chunk" << std::endl;
-      return;
-    }
-
-    if (!this->dataPtr->ChunkData(chunkXml, chunk))
+    if (!this->dataPtr->LoadChunk(i, chunk))
       return;
 
     // Find the first <sim_time> of the log.
@@ -292,24 +389,18 @@ void LogPlay::ReadLogTimes()
       found = true;
       break;
     }
-
-    chunkXml = chunkXml->NextSiblingElement("chunk");
   }
 
   if (!found)
     gzwarn << "Unable to find <sim_time> tags in any chunk." << std::endl;
 
   // Jump to the last chunk for finding the last <sim_time>.
-  auto lastChunk = this->dataPtr->logStartXml->LastChildElement("chunk");
-  if (!lastChunk)
+  if (!this->dataPtr->LoadChunk(this->ChunkCount() - 1, chunk))
   {
     gzerr << "Unable to jump to the last chunk of the log file\n";
     return;
   }
 
-  if (!this->dataPtr->ChunkData(lastChunk, chunk))
-    return;
-
   // Update the last <sim_time> of the log.
   auto to = chunk.rfind(this->dataPtr->kEndTime);
   auto from = chunk.rfind(this->dataPtr->kStartTime, to - 1);
@@ -336,22 +427,14 @@ bool LogPlay::ReadIterations()
   const std::string kStartDelim = "<iterations>";
   const std::string kEndDelim = "</iterations>";
 
-  auto chunkXml = this->dataPtr->logStartXml->FirstChildElement("chunk");
-
   // Read the first "iterations" value of the log from the first chunk.
   auto numChunksToTry =
     std::min(this->ChunkCount(), this->dataPtr->kNumChunksToTry);
 
   for (unsigned int i = 0; i < numChunksToTry; ++i)
   {
-    if (!chunkXml)
-    {
-      gzerr << "Unable to find the first chunk" << std::endl;
-      return false;
-    }
-
     std::string chunk;
-    if (!this->dataPtr->ChunkData(chunkXml, chunk))
+    if (!this->dataPtr->LoadChunk(i, chunk))
       return false;
 
     // Find the first <iterations> of the log.
@@ -365,8 +448,6 @@ bool LogPlay::ReadIterations()
       ss >> this->dataPtr->initialIterations;
       return true;
     }
-
-    chunkXml = chunkXml->NextSiblingElement("chunk");
   }
 
   gzwarn << "Unable to find <iterations>...</iterations> tags in the first "
@@ -536,20 +617,15 @@ bool LogPlay::Rewind()
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   this->dataPtr->currentChunk.clear();
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->FirstChildElement("chunk");
-
-  if (!this->dataPtr->logCurrXml)
+  if (this->ChunkCount() == 0)
   {
     gzerr << "Unable to jump to the beginning of the log file\n";
     return false;
   }
 
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
-  {
+  this->dataPtr->chunkIndex = 0;
+  if (!this->dataPtr->LoadChunk(0, this->dataPtr->currentChunk))
     return false;
-  }
 
   // Skip first <sdf> block (it doesn't have a world state).
   this->dataPtr->end = this->dataPtr->currentChunk.find(
@@ -576,16 +652,14 @@ bool LogPlay::Forward()
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Get the last chunk.
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->LastChildElement("chunk");
-
-  if (!this->dataPtr->logCurrXml)
+  if (this->ChunkCount() == 0)
   {
     gzerr << "Unable to jump to the end of the log file\n";
     return false;
   }
 
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+  this->dataPtr->chunkIndex = this->ChunkCount() - 1;
+  if (!this->dataPtr->LoadChunk(this->dataPtr->chunkIndex,
                                 this->dataPtr->currentChunk))
   {
     return false;
@@ -608,58 +682,14 @@ bool LogPlay::Seek(const common::Time &_time)
     return true;
   }
 
-  common::Time logTime = this->dataPtr->logStartTime;
-
   // 1st step: Locate the chunk: We're looking for the first chunk that has
   // a time greater than the target time.
-  int64_t imin = 0;
-  int64_t imax = this->ChunkCount() - 1;
-  while (imin <= imax)
-  {
-    int64_t imid = imin + ((imax - imin) / 2);
-    this->Chunk(imid, this->dataPtr->currentChunk);
-
-    this->dataPtr->start = 0;
-    this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
-
-    // We try a few times looking for <sim_time>.
-    for (unsigned int i = 0; i < 2; ++i)
-    {
-      std::string frame;
-      if (!this->Step(frame))
-        return false;
-
-      // Search the <sim_time> in the first frame of the current chunk.
-      auto from = frame.find(this->dataPtr->kStartTime);
-      auto to = frame.find(
-          this->dataPtr->kEndTime, from + this->dataPtr->kStartTime.size());
-      if (from != std::string::npos && to != std::string::npos)
-      {
-        auto length = to - from - this->dataPtr->kStartTime.size();
-        auto logTimeStr = frame.substr(
-            from + this->dataPtr->kStartTime.size(), length);
-        std::stringstream ss(logTimeStr);
-        ss >> logTime;
-        break;
-      }
-    }
-
-    // Chunk found.
-    if (logTime == _time)
-      break;
-    else if (logTime < _time)
-      imin = imid + 1;
-    else
-      imax = imid - 1;
-  }
-
-  if (logTime < _time)
-  {
-    if (!this->NextChunk())
-      this->Forward();
-  }
+  if (!this->dataPtr->indexValid && !this->dataPtr->BuildIndex())
+    return false;
+  this->SeekChunk(_time);
 
   // 2nd step: Locate the frame in the previous chunk.
+  common::Time logTime;
   while (true)
   {
     std::string frame;
@@ -688,23 +718,82 @@ bool LogPlay::Seek(const common::Time &_time)
 }
 
 /////////////////////////////////////////////////
-bool LogPlay::Chunk(unsigned int _index, std::string &_data) const
+void LogPlay::SeekChunk(const common::Time &_time)
 {
-  unsigned int count = 0;
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->FirstChildElement("chunk");
+  // Chunks without a <sim_time> only appear at the start of the log, so
+  // they compare lower than any time.
+  auto it = std::upper_bound(
+      this->dataPtr->index.begin(), this->dataPtr->index.end(), _time,
+      [](const common::Time &_t, const logbin::IndexEntry &_entry)
+      {
+        return _entry.hasTime && _t < common::Time(_entry.sec, _entry.nsec);
+      });
 
-  while (this->dataPtr->logCurrXml && count < _index)
+  if (it == this->dataPtr->index.end())
   {
-    count++;
-    this->dataPtr->logCurrXml =
-      this->dataPtr->logCurrXml->NextSiblingElement("chunk");
+    this->Forward();
+    return;
   }
 
-  if (this->dataPtr->logCurrXml && count == _index)
-    return this->dataPtr->ChunkData(this->dataPtr->logCurrXml, _data);
-  else
+  this->dataPtr->chunkIndex = it - this->dataPtr->index.begin();
+  this->dataPtr->LoadChunk(this->dataPtr->chunkIndex,
+      this->dataPtr->currentChunk);
+  this->dataPtr->start = 0;
+  this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::Chunk(unsigned int _index, std::string &_data) const
+{
+  if (_index >= this->ChunkCount())
     return false;
+
+  this->dataPtr->chunkIndex = _index;
+  return this->dataPtr->LoadChunk(_index, _data);
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::DecodeChunks(const unsigned int _start,
+    const unsigned int _count,
+    const std::function<void (const unsigned int, const std::string &)>
+    &_func) const
+{
+  if (_start >= this->ChunkCount() || _count > this->ChunkCount() - _start)
+    return false;
+
+  // Reading the log file is not thread safe, get the compressed data of
+  // every chunk first.
+  std::vector<std::string> encodings(_count);
+  std::vector<std::string> payloads(_count);
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    if (!this->dataPtr->ReadChunk(_start + i, encodings[i], payloads[i]))
+      return false;
+  }
+
+  std::atomic<bool> result(true);
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, _count, 1),
+      [&](const tbb::blocked_range<unsigned int> &_r)
+      {
+        for (unsigned int i = _r.begin(); i != _r.end(); ++i)
+        {
+          std::string data;
+          if (!LogPlayPrivate::DecodeChunk(encodings[i], payloads[i], data))
+          {
+            gzerr << "Invalid encoding[" << encodings[i] << "] in log file["
+              << this->dataPtr->filename << "]\n";
+            result = false;
+            continue;
+          }
+
+          // Release the compressed data as soon as possible.
+          std::string().swap(payloads[i]);
+
+          _func(_start + i, data);
+        }
+      });
+
+  return result;
 }
 
 /////////////////////////////////////////////////
@@ -728,15 +817,27 @@ bool LogPlayPrivate::ChunkData(
     gzthrow("Encoding missing for a chunk in log file[" + this->filename + "]");
   }
 
-  if (this->encoding == "txt")
-    _data = _xml->GetText();
-  else if (this->encoding == "bz2")
+  if (this->encoding == logbin::kEncoding ||
+      !DecodeChunk(this->encoding, _xml->GetText(), _data))
   {
-    std::string data = _xml->GetText();
-    std::string buffer;
+    gzerr << "Invalid encoding[" << this->encoding << "] in log file["
+      << this->filename << "]\n";
+    return false;
+  }
+
+  return true;
+}
 
+/////////////////////////////////////////////////
+bool LogPlayPrivate::DecodeChunk(const std::string &_encoding,
+    const std::string &_payload, std::string &_data)
+{
+  if (_encoding == "txt")
+    _data = _payload;
+  else if (_encoding == "bz2")
+  {
     // Decode the base64 string
-    buffer = Base64Decode(data);
+    std::string buffer = Base64Decode(_payload);
 
     // Decompress the bz2 data
     {
@@ -749,13 +850,10 @@ bool LogPlayPrivate::ChunkData(
       _data += '\0';
     }
   }
-  else if (this->encoding == "zlib")
+  else if (_encoding == "zlib")
   {
-    std::string data = _xml->GetText();
-    std::string buffer;
-
     // Decode the base64 string
-    buffer = Base64Decode(data);
+    std::string buffer = Base64Decode(_payload);
 
     // Decompress the zlib data
     {
@@ -768,50 +866,382 @@ bool LogPlayPrivate::ChunkData(
       _data += '\0';
     }
   }
+  else if (_encoding == logbin::kEncoding)
+  {
+    // Binary chunks are not base64 encoded.
+    _data.clear();
+    boost::iostreams::filtering_istream in;
+    in.push(boost::iostreams::zlib_decompressor());
+    in.push(boost::make_iterator_range(_payload));
+    boost::iostreams::copy(in, std::back_inserter(_data));
+  }
   else
+    return false;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::ReadChunk(const size_t _index, std::string &_encoding,
+    std::string &_payload)
+{
+  std::lock_guard<std::mutex> lock(this->cacheMutex);
+
+  if (this->binary)
   {
-    gzerr << "Invalid encoding[" << this->encoding << "] in log file["
+    uint32_t size = 0;
+    _encoding = logbin::kEncoding;
+    return this->ReadBinaryChunk(_index, _payload, size);
+  }
+
+  if (_index >= this->chunkXmls.size())
+    return false;
+
+  const char *encodingAttr = this->chunkXmls[_index]->Attribute("encoding");
+  const char *text = this->chunkXmls[_index]->GetText();
+  if (!encodingAttr || !text)
+  {
+    gzerr << "Invalid chunk[" << _index << "] in log file["
       << this->filename << "]\n";
     return false;
   }
 
+  _encoding = encodingAttr;
+  _payload = text;
   return true;
 }
 
 /////////////////////////////////////////////////
-std::string LogPlay::Encoding() const
+bool LogPlayPrivate::ReadBinaryChunk(const size_t _index,
+    std::string &_payload, uint32_t &_size)
 {
-  return this->dataPtr->encoding;
+  if (_index >= this->index.size())
+  {
+    gzerr << "Invalid chunk index[" << _index << "]" << std::endl;
+    return false;
+  }
+
+  logbin::ChunkHeader header;
+  this->binFile.clear();
+  this->binFile.seekg(this->index[_index].offset);
+  this->binFile.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+  _payload.assign(header.compressedSize, '\0');
+  if (this->binFile)
+    this->binFile.read(&_payload[0], header.compressedSize);
+
+  if (!this->binFile)
+  {
+    gzerr << "Unable to read chunk[" << _index << "] from log file["
+          << this->filename << "]\n";
+    return false;
+  }
+
+  _size = header.size;
+  return true;
 }
 
 /////////////////////////////////////////////////
-unsigned int LogPlay::ChunkCount() const
+bool LogPlayPrivate::BinaryChunkData(const size_t _index, std::string &_data)
 {
-  unsigned int count = 0;
-  auto xml = this->dataPtr->logStartXml->FirstChildElement("chunk");
+  std::string buffer;
+  uint32_t size = 0;
+  if (!this->ReadBinaryChunk(_index, buffer, size))
+    return false;
+
+  this->encoding = logbin::kEncoding;
 
-  while (xml)
+  _data.reserve(size);
+  return DecodeChunk(this->encoding, buffer, _data);
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::ReadBinaryIndex(const uint64_t _dataOffset)
+{
+  this->index.clear();
+
+  this->binFile.clear();
+  this->binFile.seekg(0, std::ios::end);
+  const uint64_t fileSize = this->binFile.tellg();
+
+  // Use the index stored at the end of the file.
+  logbin::Footer footer;
+  if (fileSize >= _dataOffset + sizeof(footer))
   {
-    count++;
-    xml = xml->NextSiblingElement("chunk");
+    this->binFile.seekg(fileSize - sizeof(footer));
+    this->binFile.read(reinterpret_cast<char *>(&footer), sizeof(footer));
+
+    if (this->binFile &&
+        std::memcmp(footer.magic, logbin::kIndexMagic,
+                    sizeof(footer.magic)) == 0 &&
+        footer.indexOffset + footer.count * sizeof(logbin::IndexEntry) +
+        sizeof(footer) == fileSize)
+    {
+      this->index.resize(footer.count);
+      this->binFile.seekg(footer.indexOffset);
+      this->binFile.read(reinterpret_cast<char *>(this->index.data()),
+          footer.count * sizeof(logbin::IndexEntry));
+      if (this->binFile)
+        return !this->index.empty();
+
+      this->index.clear();
+    }
   }
 
-  return count;
+  // The log was not closed properly, rebuild the index from the chunks.
+  gzwarn << "Log file[" << this->filename << "] has no time index. "
+         << "Rebuilding it, this may take a while.\n";
+
+  uint64_t offset = _dataOffset;
+  while (offset + sizeof(logbin::ChunkHeader) <= fileSize)
+  {
+    logbin::ChunkHeader header;
+    this->binFile.clear();
+    this->binFile.seekg(offset);
+    this->binFile.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!this->binFile ||
+        offset + sizeof(header) + header.compressedSize > fileSize)
+    {
+      break;
+    }
+
+    logbin::IndexEntry entry;
+    entry.offset = offset;
+    entry.sec = 0;
+    entry.nsec = 0;
+    entry.hasTime = 0;
+    entry.reserved = 0;
+    this->index.push_back(entry);
+
+    std::string chunk;
+    if (!this->BinaryChunkData(this->index.size() - 1, chunk))
+    {
+      this->index.pop_back();
+      break;
+    }
+
+    auto from = chunk.find(this->kStartTime);
+    if (from != std::string::npos)
+    {
+      std::istringstream ss(chunk.substr(from + this->kStartTime.size(), 32));
+      common::Time time;
+      ss >> time;
+      this->index.back().sec = time.sec;
+      this->index.back().nsec = time.nsec;
+      this->index.back().hasTime = 1;
+    }
+
+    offset += sizeof(header) + header.compressedSize;
+  }
+
+  return !this->index.empty();
 }
 
 /////////////////////////////////////////////////
-bool LogPlay::NextChunk()
+bool LogPlayPrivate::LoadChunk(const size_t _index, std::string &_data)
+{
+  std::lock_guard<std::mutex> lock(this->cacheMutex);
+
+  auto cached = this->chunkCacheMap.find(_index);
+  if (cached != this->chunkCacheMap.end())
+  {
+    // Move the chunk to the front of the cache.
+    this->chunkCache.splice(this->chunkCache.begin(), this->chunkCache,
+        cached->second);
+    _data = cached->second->second.first;
+    this->encoding = cached->second->second.second;
+    return true;
+  }
+
+  bool result = false;
+  if (this->binary)
+    result = this->BinaryChunkData(_index, _data);
+  else if (_index < this->chunkXmls.size())
+    result = this->ChunkData(this->chunkXmls[_index], _data);
+
+  if (!result || this->chunkCacheSize == 0)
+    return result;
+
+  // Evict the least recently used chunk.
+  if (this->chunkCache.size() >= this->chunkCacheSize)
+  {
+    this->chunkCacheMap.erase(this->chunkCache.back().first);
+    this->chunkCache.pop_back();
+  }
+
+  this->chunkCache.emplace_front(_index, CachedChunk(_data, this->encoding));
+  this->chunkCacheMap[_index] = this->chunkCache.begin();
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::ClearChunkCache()
+{
+  std::lock_guard<std::mutex> lock(this->cacheMutex);
+  this->chunkCache.clear();
+  this->chunkCacheMap.clear();
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::BuildIndex()
 {
-  auto next = this->dataPtr->logCurrXml->NextSiblingElement("chunk");
-  if (!next)
+  // Binary logs always have an index.
+  if (this->binary)
+    return this->indexValid;
+
+  gzmsg << "Building time index for log file[" << this->filename << "]\n";
+
+  // Decompress the chunks without going through the cache, so that the
+  // chunks around the current position stay cached.
+  std::string currentEncoding = this->encoding;
+  this->index.clear();
+  this->index.reserve(this->chunkXmls.size());
+  for (size_t i = 0; i < this->chunkXmls.size(); ++i)
+  {
+    std::string chunk;
+    if (!this->ChunkData(this->chunkXmls[i], chunk))
+    {
+      this->index.clear();
+      this->encoding = currentEncoding;
+      return false;
+    }
+
+    logbin::IndexEntry entry;
+    entry.offset = i;
+    entry.sec = 0;
+    entry.nsec = 0;
+    entry.hasTime = 0;
+    entry.reserved = 0;
+
+    auto from = chunk.find(this->kStartTime);
+    if (from != std::string::npos)
+    {
+      std::istringstream ss(chunk.substr(from + this->kStartTime.size(), 32));
+      common::Time time;
+      ss >> time;
+      entry.sec = time.sec;
+      entry.nsec = time.nsec;
+      entry.hasTime = 1;
+    }
+    this->index.push_back(entry);
+  }
+  this->encoding = currentEncoding;
+  this->indexValid = true;
+
+  if (this->persistIndex)
+    this->WriteIndexFile();
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::ReadIndexFile()
+{
+  this->index.clear();
+
+  std::ifstream in(this->filename + ".idx", std::ios::binary);
+  if (!in)
     return false;
 
-  this->dataPtr->logCurrXml = next;
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+  // The index file is only valid for the exact log file it was built from.
+  char magic[sizeof(logbin::kIndexMagic)];
+  uint64_t fileSize = 0;
+  int64_t writeTime = 0;
+  uint64_t count = 0;
+  in.read(magic, sizeof(magic));
+  in.read(reinterpret_cast<char *>(&fileSize), sizeof(fileSize));
+  in.read(reinterpret_cast<char *>(&writeTime), sizeof(writeTime));
+  in.read(reinterpret_cast<char *>(&count), sizeof(count));
+
+  if (!in || std::memcmp(magic, logbin::kIndexMagic, sizeof(magic)) != 0 ||
+      fileSize != boost::filesystem::file_size(this->filename) ||
+      writeTime != boost::filesystem::last_write_time(this->filename) ||
+      count != this->chunkXmls.size())
+  {
+    gzlog << "Ignoring stale index file for log[" << this->filename
+          << "]\n";
+    return false;
+  }
+
+  this->index.resize(count);
+  in.read(reinterpret_cast<char *>(this->index.data()),
+      count * sizeof(logbin::IndexEntry));
+  if (!in)
+  {
+    this->index.clear();
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::WriteIndexFile() const
+{
+  std::ofstream out(this->filename + ".idx", std::ios::binary);
+  if (!out)
+  {
+    gzwarn << "Unable to write index file for log[" << this->filename
+           << "]\n";
+    return;
+  }
+
+  uint64_t fileSize = boost::filesystem::file_size(this->filename);
+  int64_t writeTime = boost::filesystem::last_write_time(this->filename);
+  uint64_t count = this->index.size();
+  out.write(logbin::kIndexMagic, sizeof(logbin::kIndexMagic));
+  out.write(reinterpret_cast<const char *>(&fileSize), sizeof(fileSize));
+  out.write(reinterpret_cast<const char *>(&writeTime), sizeof(writeTime));
+  out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+  out.write(reinterpret_cast<const char *>(this->index.data()),
+      count * sizeof(logbin::IndexEntry));
+}
+
+/////////////////////////////////////////////////
+void LogPlay::SetChunkCacheSize(const unsigned int _size)
+{
+  this->dataPtr->chunkCacheSize = _size;
+  this->dataPtr->ClearChunkCache();
+}
+
+/////////////////////////////////////////////////
+unsigned int LogPlay::ChunkCacheSize() const
+{
+  return this->dataPtr->chunkCacheSize;
+}
+
+/////////////////////////////////////////////////
+void LogPlay::SetPersistIndex(const bool _persist)
+{
+  this->dataPtr->persistIndex = _persist;
+}
+
+/////////////////////////////////////////////////
+std::string LogPlay::Encoding() const
+{
+  return this->dataPtr->encoding;
+}
+
+/////////////////////////////////////////////////
+unsigned int LogPlay::ChunkCount() const
+{
+  if (this->dataPtr->binary)
+    return this->dataPtr->index.size();
+
+  return this->dataPtr->chunkXmls.size();
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::NextChunk()
+{
+  if (this->dataPtr->chunkIndex + 1 >= this->ChunkCount() ||
+      !this->dataPtr->LoadChunk(this->dataPtr->chunkIndex + 1,
                                 this->dataPtr->currentChunk))
   {
     return false;
   }
+  ++this->dataPtr->chunkIndex;
 
   this->dataPtr->start = 0;
   this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
@@ -822,16 +1252,13 @@ bool LogPlay::NextChunk()
 /////////////////////////////////////////////////
 bool LogPlay::PrevChunk()
 {
-  auto prev = this->dataPtr->logCurrXml->PreviousSiblingElement("chunk");
-  if (!prev)
-    return false;
-
-  this->dataPtr->logCurrXml = prev;
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+  if (this->dataPtr->chunkIndex == 0 ||
+      !this->dataPtr->LoadChunk(this->dataPtr->chunkIndex - 1,
                                 this->dataPtr->currentChunk))
   {
     return false;
   }
+  --this->dataPtr->chunkIndex;
 
   this->dataPtr->start = this->dataPtr->currentChunk.size() - 1;
   this->dataPtr->end = this->dataPtr->currentChunk.size() - 1;
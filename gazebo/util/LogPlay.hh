@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_UTIL_LOGPLAY_HH_
 #define _GAZEBO_UTIL_LOGPLAY_HH_
 
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -140,6 +141,39 @@ namespace gazebo
       /// \return True if the _index was valid.
       public: bool Chunk(const unsigned int _index, std::string &_data) const;
 
+      /// \brief Decompress a range of chunks in parallel. The chunks do
+      /// not go through the chunk cache and the current position in the log
+      /// is not changed.
+      /// \param[in] _start Index of the first chunk.
+      /// \param[in] _count Number of chunks.
+      /// \param[in] _func Function called with the index and the data of
+      /// each chunk. It is called concurrently from several threads, in no
+      /// particular order.
+      /// \return False if the range is not valid or a chunk could not be
+      /// read.
+      public: bool DecodeChunks(const unsigned int _start,
+                  const unsigned int _count,
+                  const std::function<void (const unsigned int,
+                    const std::string &)> &_func) const;
+
+      /// \brief Set the number of decompressed chunks kept in memory.
+      /// Seeking and stepping backwards reuse the cached chunks instead of
+      /// decompressing them again. The default is 16 chunks.
+      /// \param[in] _size Number of chunks to cache, 0 disables the cache.
+      public: void SetChunkCacheSize(const unsigned int _size);
+
+      /// \brief Get the number of decompressed chunks kept in memory.
+      /// \return Maximum number of cached chunks.
+      /// \sa SetChunkCacheSize
+      public: unsigned int ChunkCacheSize() const;
+
+      /// \brief Save the time index of XML log files next to the log file,
+      /// as <log file>.idx, once it has been built. An index file that
+      /// matches the log file is always used when the log is opened.
+      /// Binary logs store their index in the log file itself.
+      /// \param[in] _persist True to save the index.
+      public: void SetPersistIndex(const bool _persist);
+
       /// \brief Get the type of encoding used for current chunck in the
       /// open log file.
       /// \return The type of encoding. An empty string will be returned if
@@ -161,6 +195,16 @@ namespace gazebo
       /// false otherwise.
       public: bool HasIterations() const;
 
+      /// \brief Open a log file that uses the binary container.
+      /// \param[in] _logFile The file to load
+      /// \throws Exception When the log file could not be read.
+      private: void OpenBinary(const std::string &_logFile);
+
+      /// \brief Load the first chunk whose start time follows _time, using
+      /// the time index.
+      /// \param[in] _time Target simulation time.
+      private: void SeekChunk(const common::Time &_time);
+
       /// \brief Read the header from the log file.
       private: void ReadHeader();
 
@@ -25,10 +25,16 @@
 #include <tinyxml2.h>
 #endif
 
+#include <fstream>
+#include <list>
+#include <map>
 #include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "gazebo/common/Time.hh"
+#include "gazebo/util/LogBinaryFormat.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -47,6 +53,64 @@ namespace gazebo
                   tinyxml2::XMLElement *_xml,
                   std::string &_data);
 
+      /// \brief Helper function to get chunk data from a binary log.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the chunk was successfully read.
+      public: bool BinaryChunkData(const size_t _index, std::string &_data);
+
+      /// \brief Decompress the data of a chunk.
+      /// \param[in] _encoding Encoding of the chunk.
+      /// \param[in] _payload Data of the chunk, as stored in the log file.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return False if the encoding is not valid.
+      public: static bool DecodeChunk(const std::string &_encoding,
+                  const std::string &_payload, std::string &_data);
+
+      /// \brief Read the compressed data of a chunk, without decompressing
+      /// it and without going through the chunk cache.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _encoding Encoding of the chunk.
+      /// \param[out] _payload Data of the chunk, as stored in the log file.
+      /// \return True if the chunk was successfully read.
+      public: bool ReadChunk(const size_t _index, std::string &_encoding,
+                  std::string &_payload);
+
+      /// \brief Read the compressed data of a chunk from a binary log.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _payload Compressed data of the chunk.
+      /// \param[out] _size Size of the decompressed data.
+      /// \return True if the chunk was successfully read.
+      public: bool ReadBinaryChunk(const size_t _index, std::string &_payload,
+                  uint32_t &_size);
+
+      /// \brief Get the data of a chunk, from the chunk cache if possible.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the chunk was successfully read.
+      public: bool LoadChunk(const size_t _index, std::string &_data);
+
+      /// \brief Remove all the chunks from the chunk cache.
+      public: void ClearChunkCache();
+
+      /// \brief Build the time index of an XML log by reading the first
+      /// <sim_time> of every chunk.
+      /// \return True if the index was built.
+      public: bool BuildIndex();
+
+      /// \brief Read the time index of an XML log from the index file.
+      /// \return True if an index file that matches the log was read.
+      public: bool ReadIndexFile();
+
+      /// \brief Write the time index of an XML log to the index file.
+      public: void WriteIndexFile() const;
+
+      /// \brief Read the time index of a binary log. If the log was not
+      /// closed properly the index is rebuilt by scanning the chunks.
+      /// \param[in] _dataOffset File offset of the first chunk.
+      /// \return True if at least one chunk was found.
+      public: bool ReadBinaryIndex(const uint64_t _dataOffset);
+
       /// \brief Max number of chunks to inspect when looking for XML elements.
       public: const unsigned int kNumChunksToTry = 2u;
 
@@ -68,8 +132,8 @@ namespace gazebo
       /// \brief Start of the log.
       public: tinyxml2::XMLElement *logStartXml = nullptr;
 
-      /// \brief Current position in the log file.
-      public: tinyxml2::XMLElement *logCurrXml = nullptr;
+      /// \brief All the <chunk> elements of an XML log, in order.
+      public: std::vector<tinyxml2::XMLElement *> chunkXmls;
 
       /// \brief Name of the log file.
       public: std::string filename;
@@ -111,6 +175,41 @@ namespace gazebo
       /// may not include this tag in the log files.
       public: bool iterationsFound = false;
 
+      /// \brief True if the open log file uses the binary container.
+      public: bool binary = false;
+
+      /// \brief Binary log file stream.
+      public: std::ifstream binFile;
+
+      /// \brief Time index of the log, one entry per chunk. For XML logs
+      /// the offset is the chunk index.
+      public: std::vector<logbin::IndexEntry> index;
+
+      /// \brief True if the time index has been read or built.
+      public: bool indexValid = false;
+
+      /// \brief True to save the time index of XML logs to a file.
+      public: bool persistIndex = false;
+
+      /// \brief Index of the current chunk.
+      public: size_t chunkIndex = 0;
+
+      /// \brief A decompressed chunk and its encoding.
+      public: typedef std::pair<std::string, std::string> CachedChunk;
+
+      /// \brief Decompressed chunks, most recently used first.
+      public: std::list<std::pair<size_t, CachedChunk>> chunkCache;
+
+      /// \brief Chunk index to position in chunkCache.
+      public: std::map<size_t,
+          std::list<std::pair<size_t, CachedChunk>>::iterator> chunkCacheMap;
+
+      /// \brief Maximum number of chunks in chunkCache.
+      public: unsigned int chunkCacheSize = 16u;
+
+      /// \brief Protects the chunk cache.
+      public: std::mutex cacheMutex;
+
       /// \brief A mutex to avoid race conditions.
       public: std::mutex mutex;
     };
@@ -17,10 +17,17 @@
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <cstring>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Time.hh"
+#include "gazebo/util/LogBinaryFormat.hh"
 #include "gazebo/util/LogPlay.hh"
 #include "test_config.h"
 #include "test/util.hh"
@@ -146,6 +153,58 @@ TEST_F(LogPlay_TEST, Chunks)
   EXPECT_FALSE(player->Chunk(player->ChunkCount(), chunk));
 }
 
+/////////////////////////////////////////////////
+/// \brief Test decoding chunks in parallel.
+TEST_F(LogPlay_TEST, DecodeChunks)
+{
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("state.log");
+
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+  const unsigned int chunkCount = player->ChunkCount();
+  ASSERT_GT(chunkCount, 1u);
+
+  std::vector<std::string> chunks(chunkCount);
+  std::mutex mutex;
+  EXPECT_TRUE(player->DecodeChunks(0, chunkCount,
+      [&](const unsigned int _index, const std::string &_data)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        ASSERT_LT(_index, chunkCount);
+        EXPECT_TRUE(chunks[_index].empty());
+        chunks[_index] = _data;
+      }));
+
+  // The chunks match the ones read sequentially.
+  for (unsigned int i = 0; i < chunkCount; ++i)
+  {
+    std::string chunk;
+    EXPECT_TRUE(player->Chunk(i, chunk));
+    EXPECT_EQ(chunk, chunks[i]);
+  }
+
+  // The position in the log is not changed.
+  std::string first, second, frame;
+  EXPECT_TRUE(player->Rewind());
+  EXPECT_TRUE(player->Step(first));
+  EXPECT_TRUE(player->Step(second));
+
+  auto noop = [](const unsigned int, const std::string &) {};
+  EXPECT_TRUE(player->Rewind());
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(first, frame);
+  EXPECT_TRUE(player->DecodeChunks(0, chunkCount, noop));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(second, frame);
+
+  // Invalid ranges.
+  EXPECT_FALSE(player->DecodeChunks(chunkCount, 1, noop));
+  EXPECT_FALSE(player->DecodeChunks(1, chunkCount, noop));
+}
+
 /////////////////////////////////////////////////
 /// \brief Test Rewind().
 TEST_F(LogPlay_TEST, Rewind)
@@ -457,6 +516,195 @@ TEST_F(LogPlay_TEST, NoEndTag)
 #endif
 }
 
+/////////////////////////////////////////////////
+/// \brief Test playing back a log that uses the binary container.
+TEST_F(LogPlay_TEST, Binary)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  using namespace gazebo::util;
+  LogPlay *player = LogPlay::Instance();
+
+  // Convert the XML test log to the binary container.
+  std::string xmlFilename = std::string(TEST_PATH) + "/logs/state.log";
+  EXPECT_NO_THROW(player->Open(xmlFilename));
+  const unsigned int chunkCount = player->ChunkCount();
+  const std::string xmlHeader = player->Header();
+  const common::Time startTime = player->LogStartTime();
+  const common::Time endTime = player->LogEndTime();
+  ASSERT_GT(chunkCount, 1u);
+
+  std::string header = xmlHeader.substr(xmlHeader.find("<header>"));
+  std::string data(logbin::kMagic, sizeof(logbin::kMagic));
+  logbin::Append(logbin::kVersion, data);
+  logbin::Append(static_cast<uint32_t>(header.size()), data);
+  data += header;
+
+  std::vector<logbin::IndexEntry> index;
+  for (unsigned int i = 0; i < chunkCount; ++i)
+  {
+    std::string chunk;
+    EXPECT_TRUE(player->Chunk(i, chunk));
+
+    std::string compressed;
+    {
+      boost::iostreams::filtering_ostream out;
+      out.push(boost::iostreams::zlib_compressor());
+      out.push(std::back_inserter(compressed));
+      boost::iostreams::copy(boost::make_iterator_range(chunk), out);
+    }
+
+    logbin::IndexEntry entry = {data.size(), 0, 0, 0, 0};
+    auto from = chunk.find("<sim_time>");
+    if (from != std::string::npos)
+    {
+      std::istringstream ss(chunk.substr(from + 10, 32));
+      common::Time time;
+      ss >> time;
+      entry.sec = time.sec;
+      entry.nsec = time.nsec;
+      entry.hasTime = 1;
+    }
+    index.push_back(entry);
+
+    logbin::ChunkHeader chunkHeader = {
+        static_cast<uint32_t>(compressed.size()),
+        static_cast<uint32_t>(chunk.size())};
+    logbin::Append(chunkHeader, data);
+    data += compressed;
+  }
+
+  std::string footer;
+  for (auto const &entry : index)
+    logbin::Append(entry, footer);
+  logbin::Footer trailer = {data.size(), index.size(), {0}};
+  std::memcpy(trailer.magic, logbin::kIndexMagic, sizeof(trailer.magic));
+  logbin::Append(trailer, footer);
+
+  std::ostringstream stream;
+  stream << "/tmp/__gz_log_bin_test" << std::this_thread::get_id();
+  std::string tmpFilename = stream.str();
+
+  for (bool withIndex : {true, false})
+  {
+    {
+      std::ofstream destFile(tmpFilename, std::ios::binary);
+      ASSERT_TRUE(destFile.good());
+      destFile << data;
+      // The index is rebuilt when the log was not closed properly.
+      if (withIndex)
+        destFile << footer;
+    }
+
+    EXPECT_NO_THROW(player->Open(tmpFilename));
+    EXPECT_TRUE(player->IsOpen());
+    EXPECT_EQ(player->ChunkCount(), chunkCount);
+    EXPECT_EQ(player->Header(), xmlHeader);
+    EXPECT_EQ(player->LogStartTime(), startTime);
+    EXPECT_EQ(player->LogEndTime(), endTime);
+
+    std::string frame;
+    EXPECT_TRUE(player->Seek(common::Time(30.0)));
+    EXPECT_TRUE(player->Step(frame));
+    EXPECT_EQ(player->Encoding(), "bin");
+    EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame),
+        "a2af44bc561194dfeae9526c224d56bb332a4233");
+
+    EXPECT_TRUE(player->Seek(common::Time(31.5)));
+    EXPECT_TRUE(player->Step(frame));
+    EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame),
+        "113748a3c02575f514b27bc5b4307f621644ad41");
+
+    EXPECT_TRUE(player->Seek(common::Time(25.0)));
+    EXPECT_TRUE(player->Step(frame));
+    EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame),
+        "0a61e946f14f7395a8bdb7974cb1e18c0d9e3d22");
+
+    EXPECT_TRUE(player->Seek(common::Time(35.0)));
+    EXPECT_TRUE(player->Step(frame));
+    EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame),
+        "961cf9dcd38c12f33a8b2f3a3a6fdb879b2faa98");
+  }
+
+  std::remove(tmpFilename.c_str());
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Test the chunk cache and the persisted time index.
+TEST_F(LogPlay_TEST, IndexAndCache)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+  EXPECT_EQ(player->ChunkCacheSize(), 16u);
+
+  // Copy the log, so the index file is written to a temporary location.
+  std::ifstream srcFile(std::string(TEST_PATH) + "/logs/state.log",
+      std::ios::binary);
+  ASSERT_TRUE(srcFile.good());
+
+  std::ostringstream stream;
+  stream << "/tmp/__gz_log_idx_test" << std::this_thread::get_id();
+  std::string tmpFilename = stream.str();
+  std::string idxFilename = tmpFilename + ".idx";
+  {
+    std::ofstream destFile(tmpFilename, std::ios::binary);
+    ASSERT_TRUE(destFile.good());
+    destFile << srcFile.rdbuf();
+  }
+
+  const std::string expectedShasum1 =
+    "a2af44bc561194dfeae9526c224d56bb332a4233";
+  const std::string expectedShasum2 =
+    "113748a3c02575f514b27bc5b4307f621644ad41";
+
+  // The index is built and saved on the first seek.
+  player->SetPersistIndex(true);
+  EXPECT_NO_THROW(player->Open(tmpFilename));
+  EXPECT_FALSE(boost::filesystem::exists(idxFilename));
+
+  std::string frame;
+  EXPECT_TRUE(player->Seek(common::Time(30.0)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame), expectedShasum1);
+  EXPECT_TRUE(boost::filesystem::exists(idxFilename));
+
+  // Reopen with the saved index, and without a chunk cache.
+  player->SetPersistIndex(false);
+  player->SetChunkCacheSize(0);
+  EXPECT_EQ(player->ChunkCacheSize(), 0u);
+  EXPECT_NO_THROW(player->Open(tmpFilename));
+
+  EXPECT_TRUE(player->Seek(common::Time(31.5)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame), expectedShasum2);
+
+  EXPECT_TRUE(player->Seek(common::Time(30.0)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame), expectedShasum1);
+
+  // Stepping back over a chunk boundary and forward again gives the same
+  // frames with the cache enabled.
+  player->SetChunkCacheSize(2);
+  EXPECT_TRUE(player->Rewind());
+  std::vector<std::string> frames;
+  while (player->Step(frame))
+    frames.push_back(frame);
+  ASSERT_GT(frames.size(), 2u);
+
+  for (auto it = frames.rbegin() + 1; it != frames.rend(); ++it)
+  {
+    EXPECT_TRUE(player->StepBack(frame));
+    EXPECT_EQ(frame, *it);
+  }
+
+  player->SetChunkCacheSize(16);
+  std::remove(tmpFilename.c_str());
+  std::remove(idxFilename.c_str());
+#endif
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -25,7 +25,11 @@
   #define access _access
 #endif
 
+#include <algorithm>
+#include <cstdlib>
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include <boost/archive/iterators/base64_from_binary.hpp>
 #include <boost/archive/iterators/insert_linebreaks.hpp>
@@ -50,6 +54,7 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/ThreadRoles.hh"
 #include "gazebo/gazebo_config.h"
 #include "gazebo/transport/transport.hh"
 #include "gazebo/util/LogRecordPrivate.hh"
@@ -140,6 +145,27 @@ bool LogRecord::Start(const LogRecordParams &_params)
   this->dataPtr->period = _params.period;
   this->dataPtr->filter = _params.filter;
   this->dataPtr->recordResources = _params.recordResources;
+
+  if (_params.overflowPolicy != "block" && _params.overflowPolicy != "drop")
+  {
+    gzerr << "Invalid log overflow policy[" << _params.overflowPolicy
+          << "]. Must be one of [block, drop]" << std::endl;
+    return false;
+  }
+
+  if (_params.stateBufferSize == 0)
+  {
+    gzerr << "Log state buffer size must be greater than zero" << std::endl;
+    return false;
+  }
+
+  this->dataPtr->overflowPolicy = _params.overflowPolicy;
+  this->dataPtr->stateBufferSize = _params.stateBufferSize;
+  this->dataPtr->topics = _params.topics;
+  this->dataPtr->segmentSize = _params.segmentSize;
+  this->dataPtr->segmentDuration = std::max(_params.segmentDuration, 0.0);
+  this->dataPtr->uploadCommand = _params.uploadCommand;
+  this->dataPtr->maxDiskUsage = _params.maxDiskUsage;
   return this->Start(_params.encoding, _params.path);
 }
 
@@ -186,20 +212,48 @@ bool LogRecord::Start(const std::string &_encoding, const std::string &_path)
   if (!boost::filesystem::exists(this->dataPtr->logCompletePath))
     boost::filesystem::create_directories(this->dataPtr->logCompletePath);
 
-  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib")
+  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib" &&
+      _encoding != logbin::kEncoding)
+  {
     gzthrow("Invalid log encoding[" + _encoding +
-            "]. Must be one of [bz2, zlib, txt]");
+            "]. Must be one of [bz2, zlib, txt, bin]");
+  }
 
   this->dataPtr->encoding = _encoding;
 
+  // Sensor topics are subscribed by the update thread once advertised.
+  if (!this->dataPtr->topics.empty())
+  {
+    const boost::filesystem::path bagPath =
+      this->dataPtr->logCompletePath / "sensors.bag";
+    if (this->dataPtr->topicBag.Open(bagPath.string()))
+    {
+      this->dataPtr->pendingTopics = this->dataPtr->topics;
+      this->dataPtr->nextTopicLookup = common::Time::Zero;
+    }
+    else
+      gzerr << "Unable to create sensor log[" << bagPath << "]\n";
+  }
+
   {
     std::unique_lock<std::mutex> logLock(this->dataPtr->writeMutex);
     this->dataPtr->logsEnd = this->dataPtr->logs.end();
 
     // Start all the logs
+    this->dataPtr->segmentIndex = 0;
+    this->dataPtr->segmentStartTime = common::Time::GetWallTime();
+    const int segment = this->dataPtr->Segmented() ? 0 : -1;
     for (LogRecordPrivate::Log_M::iterator iter = this->dataPtr->logs.begin();
          iter != this->dataPtr->logsEnd; ++iter)
-      iter->second->Start(this->dataPtr->logCompletePath);
+      iter->second->Start(this->dataPtr->logCompletePath, segment);
+  }
+
+  // Start the upload thread if it has not already been started
+  if (!this->dataPtr->uploadCommand.empty() && !this->dataPtr->uploadThread)
+  {
+    this->dataPtr->stopUpload = false;
+    this->dataPtr->uploadThread.reset(new std::thread(
+        std::bind(&LogRecordPrivate::RunUpload, this->dataPtr.get())));
   }
 
   this->dataPtr->running = true;
@@ -209,6 +263,8 @@ bool LogRecord::Start(const std::string &_encoding, const std::string &_path)
   this->dataPtr->readyToStart = false;
 
   this->dataPtr->startTime = this->dataPtr->currTime = common::Time();
+  this->dataPtr->capturedStates = 0;
+  this->dataPtr->droppedStates = 0;
 
   // Create a thread to cleanup recording.
   this->dataPtr->cleanupThread.reset(new std::thread(
@@ -265,6 +321,16 @@ void LogRecord::Fini()
   std::lock_guard<std::mutex> lock(this->dataPtr->controlMutex);
   this->dataPtr->connections.clear();
 
+  // Let the upload thread finish the completed segments.
+  {
+    std::lock_guard<std::mutex> segmentLock(this->dataPtr->segmentMutex);
+    this->dataPtr->stopUpload = true;
+    this->dataPtr->uploadCondition.notify_all();
+  }
+  if (this->dataPtr->uploadThread && this->dataPtr->uploadThread->joinable())
+    this->dataPtr->uploadThread->join();
+  this->dataPtr->uploadThread.reset();
+
   // Remove all the logs.
   this->ClearLogs();
 }
@@ -340,6 +406,38 @@ bool LogRecord::Running() const
   return this->dataPtr->running;
 }
 
+//////////////////////////////////////////////////
+unsigned int LogRecord::StateBufferSize() const
+{
+  return this->dataPtr->stateBufferSize;
+}
+
+//////////////////////////////////////////////////
+const std::string &LogRecord::OverflowPolicy() const
+{
+  return this->dataPtr->overflowPolicy;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::NotifyStateCapture(const bool _dropped)
+{
+  ++this->dataPtr->capturedStates;
+  if (_dropped)
+    ++this->dataPtr->droppedStates;
+}
+
+//////////////////////////////////////////////////
+uint64_t LogRecord::CapturedStateCount() const
+{
+  return this->dataPtr->capturedStates;
+}
+
+//////////////////////////////////////////////////
+uint64_t LogRecord::DroppedStateCount() const
+{
+  return this->dataPtr->droppedStates;
+}
+
 //////////////////////////////////////////////////
 bool LogRecord::RecordResources() const
 {
@@ -390,7 +488,8 @@ void LogRecord::Add(const std::string &_name, const std::string &_filename,
   }
 
   if (this->dataPtr->running)
-    newLog->Start(this->dataPtr->logCompletePath);
+    newLog->Start(this->dataPtr->logCompletePath,
+        this->dataPtr->Segmented() ? this->dataPtr->segmentIndex : -1);
 
   // Add the log to our map
   this->dataPtr->logs[_name] = newLog;
@@ -521,7 +620,7 @@ std::string LogRecord::BasePath() const
 //////////////////////////////////////////////////
 bool LogRecord::FirstUpdate() const
 {
-  return this->dataPtr->firstUpdate;
+  return this->dataPtr->firstUpdate || this->dataPtr->segmentStart;
 }
 
 //////////////////////////////////////////////////
@@ -680,6 +779,8 @@ void LogRecord::Notify()
 //////////////////////////////////////////////////
 void LogRecord::RunUpdate()
 {
+  common::ThreadRoles::Instance()->Apply("log_update");
+
   std::unique_lock<std::mutex> updateLock(this->dataPtr->updateMutex);
   this->dataPtr->startThreadCondition.notify_all();
 
@@ -697,6 +798,8 @@ void LogRecord::RunUpdate()
 //////////////////////////////////////////////////
 void LogRecord::Update()
 {
+  this->UpdateTopics(this->dataPtr->paused);
+
   if (!this->dataPtr->paused)
   {
     unsigned int size = 0;
@@ -704,6 +807,21 @@ void LogRecord::Update()
     {
       std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
 
+      // Start new segments once the current ones are large or old enough.
+      // The logs then see FirstUpdate and write their full state again.
+      if (this->dataPtr->RotationDue())
+      {
+        ++this->dataPtr->segmentIndex;
+        for (auto iter = this->dataPtr->logs.begin();
+             iter != this->dataPtr->logsEnd; ++iter)
+        {
+          this->dataPtr->CloseSegment(
+              iter->second->Rotate(this->dataPtr->segmentIndex));
+        }
+        this->dataPtr->segmentStartTime = common::Time::GetWallTime();
+        this->dataPtr->segmentStart = true;
+      }
+
       // Collect all the new log data. This will not write data to disk.
       for (this->dataPtr->updateIter = this->dataPtr->logs.begin();
            this->dataPtr->updateIter != this->dataPtr->logsEnd;
@@ -711,6 +829,7 @@ void LogRecord::Update()
       {
         size += this->dataPtr->updateIter->second->Update();
       }
+      this->dataPtr->segmentStart = false;
     }
 
     if (this->dataPtr->firstUpdate)
@@ -730,9 +849,64 @@ void LogRecord::Update()
   }
 }
 
+//////////////////////////////////////////////////
+void LogRecord::UpdateTopics(const bool _discard)
+{
+  if (!this->dataPtr->pendingTopics.empty() && this->dataPtr->node &&
+      common::Time::GetWallTime() >= this->dataPtr->nextTopicLookup)
+  {
+    this->dataPtr->nextTopicLookup =
+      common::Time::GetWallTime() + common::Time(1, 0);
+
+    auto iter = this->dataPtr->pendingTopics.begin();
+    while (iter != this->dataPtr->pendingTopics.end())
+    {
+      const std::string name = this->dataPtr->node->DecodeTopicName(*iter);
+      const std::string type = transport::getTopicMsgType(name);
+      if (type.empty())
+      {
+        ++iter;
+        continue;
+      }
+
+      std::unique_ptr<LogRecordPrivate::TopicStream> stream(
+          new LogRecordPrivate::TopicStream(type));
+      stream->topic = this->dataPtr->topicBag.AddTopic(name,
+          stream->codec.BagType());
+      this->dataPtr->topicSubs.push_back(this->dataPtr->node->Subscribe(name,
+            &LogRecordPrivate::TopicStream::OnData, stream.get()));
+      this->dataPtr->topicStreams.push_back(std::move(stream));
+      iter = this->dataPtr->pendingTopics.erase(iter);
+    }
+  }
+
+  for (auto &stream : this->dataPtr->topicStreams)
+  {
+    std::vector<std::string> pending;
+    {
+      std::lock_guard<std::mutex> lock(stream->mutex);
+      pending.swap(stream->pending);
+    }
+
+    if (_discard)
+      continue;
+
+    // Messages without a time keep the one of the previous message.
+    common::Time stamp;
+    std::string encoded;
+    for (const auto &data : pending)
+    {
+      if (stream->codec.Encode(data, encoded, stamp))
+        this->dataPtr->topicBag.Write(stream->topic, stamp, encoded);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 void LogRecord::RunWrite()
 {
+  common::ThreadRoles::Instance()->Apply("log_write");
+
   // Wait for new data.
   std::unique_lock<std::mutex> lock(this->dataPtr->runWriteMutex);
   this->dataPtr->startThreadCondition.notify_all();
@@ -792,7 +966,11 @@ unsigned int LogRecordPrivate::Log::Update()
   if (this->logCB(stream))
   {
     std::string data = stream.str();
-    if (!data.empty())
+    if (!data.empty() && this->binary)
+    {
+      this->AppendBinaryChunk(data);
+    }
+    else if (!data.empty())
     {
       const std::string &encodingLocal = this->parent->Encoding();
 
@@ -842,9 +1020,49 @@ unsigned int LogRecordPrivate::Log::Update()
     }
   }
 
+  this->bufferMemory.Set(this->buffer.capacity());
   return this->buffer.size();
 }
 
+//////////////////////////////////////////////////
+void LogRecordPrivate::Log::AppendBinaryChunk(const std::string &_data)
+{
+  std::string compressed;
+  {
+    boost::iostreams::filtering_ostream out;
+    out.push(boost::iostreams::zlib_compressor());
+    out.push(std::back_inserter(compressed));
+    boost::iostreams::copy(boost::make_iterator_range(_data), out);
+  }
+
+  logbin::IndexEntry entry;
+  entry.offset = this->bytesWritten + this->buffer.size();
+  entry.sec = 0;
+  entry.nsec = 0;
+  entry.hasTime = 0;
+  entry.reserved = 0;
+
+  // Index the chunk by the first simulation time it contains.
+  const std::string startTime = "<sim_time>";
+  auto from = _data.find(startTime);
+  if (from != std::string::npos)
+  {
+    std::istringstream ss(_data.substr(from + startTime.size(), 32));
+    common::Time time;
+    ss >> time;
+    entry.sec = time.sec;
+    entry.nsec = time.nsec;
+    entry.hasTime = 1;
+  }
+  this->index.push_back(entry);
+
+  logbin::ChunkHeader header;
+  header.compressedSize = static_cast<uint32_t>(compressed.size());
+  header.size = static_cast<uint32_t>(_data.size());
+  logbin::Append(header, this->buffer);
+  this->buffer.append(compressed);
+}
+
 //////////////////////////////////////////////////
 void LogRecordPrivate::Log::ClearBuffer()
 {
@@ -876,37 +1094,106 @@ void LogRecordPrivate::Log::Stop()
   {
     this->Update();
     this->Write();
+  }
+  this->Finish();
+
+  // Give back the memory of the buffer until the next recording
+  std::string().swap(this->buffer);
+  this->bufferMemory.Clear();
+
+  this->completePath.clear();
+  this->index.clear();
+  this->bytesWritten = 0;
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::Log::Finish()
+{
+  if (!this->logFile.is_open())
+    return;
 
+  if (this->binary)
+  {
+    // Append the time index, so readers can seek without a full scan.
+    std::string footer;
+    for (auto const &entry : this->index)
+      logbin::Append(entry, footer);
+
+    logbin::Footer trailer;
+    trailer.indexOffset = this->bytesWritten;
+    trailer.count = this->index.size();
+    std::memcpy(trailer.magic, logbin::kIndexMagic, sizeof(trailer.magic));
+    logbin::Append(trailer, footer);
+
+    this->logFile.write(footer.c_str(), footer.size());
+  }
+  else
+  {
     std::string xmlEnd = "</gazebo_log>";
     this->logFile.write(xmlEnd.c_str(), xmlEnd.size());
-
-    this->logFile.close();
   }
 
-  this->completePath.clear();
+  this->logFile.close();
+}
+
+//////////////////////////////////////////////////
+boost::filesystem::path LogRecordPrivate::Log::Rotate(const int _segment)
+{
+  const boost::filesystem::path closed = this->completePath;
+
+  // Flush the collected chunks into the closing segment.
+  this->Write();
+  this->Finish();
+
+  this->Start(this->directory, _segment);
+  return closed;
 }
 
 //////////////////////////////////////////////////
-void LogRecordPrivate::Log::Start(const boost::filesystem::path &_path)
+void LogRecordPrivate::Log::Start(const boost::filesystem::path &_path,
+    const int _segment)
 {
-  // Make the full path for the log file
+  // Make the full path for the log file. Segments are numbered before the
+  // extension, such as state.0003.log.
+  this->directory = _path;
   this->completePath = _path / this->relativeFilename;
+  if (_segment >= 0)
+  {
+    std::ostringstream name;
+    name << this->completePath.stem().string() << "."
+         << std::setw(4) << std::setfill('0') << _segment
+         << this->completePath.extension().string();
+    this->completePath = this->completePath.parent_path() / name.str();
+  }
 
   // Make sure the file does not exist
   if (boost::filesystem::exists(this->completePath))
     gzlog << "Filename [" + this->completePath.string() + "], already exists."
           << " The log file will be overwritten.\n";
 
-  std::ostringstream stream;
-  stream << "<?xml version='1.0'?>\n"
-         << "<gazebo_log>\n"
-         << "<header>\n"
+  this->binary = this->parent->Encoding() == logbin::kEncoding;
+  this->index.clear();
+  this->bytesWritten = 0;
+
+  std::ostringstream header;
+  header << "<header>\n"
          << "<log_version>" << GZ_LOG_VERSION << "</log_version>\n"
          << "<gazebo_version>" << GAZEBO_VERSION_FULL << "</gazebo_version>\n"
          << "<rand_seed>" << ignition::math::Rand::Seed() << "</rand_seed>\n"
          << "</header>\n";
 
-  this->buffer.append(stream.str());
+  if (this->binary)
+  {
+    this->buffer.append(logbin::kMagic, sizeof(logbin::kMagic));
+    logbin::Append(logbin::kVersion, this->buffer);
+    logbin::Append(static_cast<uint32_t>(header.str().size()), this->buffer);
+    this->buffer.append(header.str());
+  }
+  else
+  {
+    this->buffer.append("<?xml version='1.0'?>\n<gazebo_log>\n");
+    this->buffer.append(header.str());
+  }
 }
 
 //////////////////////////////////////////////////
@@ -940,9 +1227,11 @@ void LogRecordPrivate::Log::Write()
   // Write out the contents of the buffer.
   this->logFile.write(this->buffer.c_str(), this->buffer.size());
   this->logFile.flush();
+  this->bytesWritten += this->buffer.size();
 
-  // Clear the buffer.
+  // Clear the buffer, its capacity is kept for the next chunks.
   this->buffer.clear();
+  this->bufferMemory.Set(this->buffer.capacity());
 }
 
 //////////////////////////////////////////////////
@@ -1024,12 +1313,18 @@ void LogRecord::PublishLogStatus()
     msg.mutable_log_file()->set_size_units(msgs::LogStatus::LogFile::G_BYTES);
   }
 
+  // Report how well the recorder keeps up with the simulation
+  msg.set_captured_states(this->dataPtr->capturedStates);
+  msg.set_dropped_states(this->dataPtr->droppedStates);
+
   this->dataPtr->logStatusPub->Publish(msg);
 }
 
 //////////////////////////////////////////////////
 void LogRecord::Cleanup()
 {
+  common::ThreadRoles::Instance()->Apply("log_cleanup");
+
   std::unique_lock<std::mutex> lock(this->dataPtr->controlMutex);
   this->dataPtr->startThreadCondition.notify_all();
 
@@ -1076,9 +1371,18 @@ void LogRecord::Cleanup()
   for (LogRecordPrivate::Log_M::iterator iter = this->dataPtr->logs.begin();
       iter != this->dataPtr->logsEnd; ++iter)
   {
+    const boost::filesystem::path path = iter->second->CompleteFilename();
     iter->second->Stop();
+    this->dataPtr->CloseSegment(path);
   }
 
+  // Close the sensor log
+  this->dataPtr->topicSubs.clear();
+  this->UpdateTopics(false);
+  this->dataPtr->topicStreams.clear();
+  this->dataPtr->pendingTopics.clear();
+  this->dataPtr->topicBag.Close();
+
   // Reset the times
   this->dataPtr->startTime = this->dataPtr->currTime = common::Time();
 
@@ -1110,3 +1414,144 @@ unsigned int LogRecord::BufferSize() const
 
   return size;
 }
+
+//////////////////////////////////////////////////
+bool LogRecordPrivate::Segmented() const
+{
+  return this->segmentSize > 0 || this->segmentDuration > 0;
+}
+
+//////////////////////////////////////////////////
+bool LogRecordPrivate::RotationDue() const
+{
+  if (!this->running || !this->Segmented())
+    return false;
+
+  if (this->segmentDuration > 0 &&
+      (common::Time::GetWallTime() - this->segmentStartTime).Double() >=
+      this->segmentDuration)
+  {
+    return true;
+  }
+
+  if (this->segmentSize > 0)
+  {
+    for (auto iter = this->logs.begin(); iter != this->logsEnd; ++iter)
+    {
+      if (iter->second->bytesWritten + iter->second->buffer.size() >=
+          this->segmentSize)
+      {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::CloseSegment(const boost::filesystem::path &_path)
+{
+  if ((this->uploadCommand.empty() && this->maxDiskUsage == 0) ||
+      _path.empty() || !boost::filesystem::exists(_path))
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->segmentMutex);
+  Segment segment;
+  segment.path = _path;
+  segment.size = boost::filesystem::file_size(_path);
+  this->segments.push_back(segment);
+
+  if (!this->uploadCommand.empty())
+  {
+    this->uploadQueue.push_back(_path);
+    this->uploadCondition.notify_all();
+  }
+
+  this->TrimSegments();
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::TrimSegments()
+{
+  if (this->maxDiskUsage == 0)
+    return;
+
+  uint64_t total = 0;
+  for (auto const &segment : this->segments)
+    total += segment.size;
+
+  // Uploaded segments go first, then the oldest ones. The segment being
+  // uploaded is kept.
+  for (const bool uploadedOnly : {true, false})
+  {
+    auto iter = this->segments.begin();
+    while (total > this->maxDiskUsage && iter != this->segments.end())
+    {
+      if ((uploadedOnly && !iter->uploaded) || iter->path == this->uploading)
+      {
+        ++iter;
+        continue;
+      }
+
+      if (!iter->uploaded && !this->uploadCommand.empty())
+      {
+        gzwarn << "Deleting log segment[" << iter->path
+               << "] before its upload to bound the disk usage\n";
+        this->uploadQueue.remove(iter->path);
+      }
+
+      boost::system::error_code ec;
+      boost::filesystem::remove(iter->path, ec);
+      total -= iter->size;
+      iter = this->segments.erase(iter);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::RunUpload()
+{
+  common::ThreadRoles::Instance()->Apply("log_upload");
+
+  std::unique_lock<std::mutex> lock(this->segmentMutex);
+  while (true)
+  {
+    this->uploadCondition.wait(lock, [this]
+        {
+          return this->stopUpload || !this->uploadQueue.empty();
+        });
+
+    // Pending segments are uploaded before the thread stops.
+    if (this->uploadQueue.empty())
+      break;
+
+    this->uploading = this->uploadQueue.front();
+    this->uploadQueue.pop_front();
+    const std::string command = common::replaceAll(this->uploadCommand,
+        "{}", "'" + this->uploading.string() + "'");
+
+    lock.unlock();
+    const int status = std::system(command.c_str());
+    lock.lock();
+
+    if (status != 0)
+    {
+      gzerr << "Upload of log segment[" << this->uploading
+            << "] failed with status[" << status << "]\n";
+    }
+    else
+    {
+      for (auto &segment : this->segments)
+      {
+        if (segment.path == this->uploading)
+          segment.uploaded = true;
+      }
+    }
+
+    this->uploading.clear();
+    this->TrimSegments();
+  }
+}
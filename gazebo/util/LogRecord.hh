@@ -20,6 +20,7 @@
 #include <fstream>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/SingletonT.hh"
@@ -38,7 +39,7 @@ namespace gazebo
     /// \sa LogRecord::Start
     class LogRecordParams
     {
-      /// \brief The type of encoding (txt, zlib, or bz2).
+      /// \brief The type of encoding (txt, zlib, bz2, or bin).
       public: std::string encoding = "zlib";
 
       /// \brief Path in which to store log files.
@@ -54,6 +55,45 @@ namespace gazebo
       /// \brief Recording resources. True will record state logs
       /// together with model meshes and materials.
       public: bool recordResources = false;
+
+      /// \brief Maximum number of captured states waiting to be
+      /// serialized.
+      public: unsigned int stateBufferSize = 256;
+
+      /// \brief What to do when the state buffer is full (block or drop).
+      /// "block" pauses the simulation until the log catches up. "drop"
+      /// discards the new state so simulation is never slowed down by
+      /// recording.
+      public: std::string overflowPolicy = "block";
+
+      /// \brief Sensor topics recorded in sensors.bag next to the state
+      /// log. Images and laser scans are compressed, see LogTopicCodec.
+      /// The messages are stamped with their time field, so
+      /// TopicBagReader::FrameAt finds the data of a state played back by
+      /// LogPlay. Topics not advertised yet are subscribed once they are.
+      public: std::vector<std::string> topics;
+
+      /// \brief Size in bytes at which the logs are closed and new segments
+      /// started, 0 to never rotate by size. Segments are named after the
+      /// log with a sequence number, such as state.0003.log, and each one
+      /// is a complete log with its own header, world and index, so it can
+      /// be played back alone.
+      public: uint64_t segmentSize = 0;
+
+      /// \brief Wall time in seconds after which new segments are started,
+      /// 0 to never rotate by time.
+      public: double segmentDuration = 0;
+
+      /// \brief Shell command run on a background thread for each
+      /// completed segment, with {} replaced by the quoted path of the
+      /// segment. For example "aws s3 cp {} s3://bucket/logs/". A segment
+      /// counts as uploaded once the command exits with 0.
+      public: std::string uploadCommand;
+
+      /// \brief Largest number of bytes of completed segments kept on
+      /// disk, 0 for no bound. Uploaded segments are deleted first, then
+      /// the oldest ones.
+      public: uint64_t maxDiskUsage = 0;
     };
 
     // Forward declare private data class
@@ -153,6 +193,32 @@ namespace gazebo
       /// \param[in] _filter New log record filter regex string
       public: void SetFilter(const std::string &_filter);
 
+      /// \brief Get the maximum number of captured states waiting to be
+      /// serialized.
+      /// \return State buffer size.
+      /// \sa LogRecordParams::stateBufferSize
+      public: unsigned int StateBufferSize() const;
+
+      /// \brief Get the policy applied when the state buffer is full.
+      /// \return Either "block" or "drop".
+      /// \sa LogRecordParams::overflowPolicy
+      public: const std::string &OverflowPolicy() const;
+
+      /// \brief Tell the recorder about a state capture. Used to report
+      /// recording statistics in the log status message.
+      /// \param[in] _dropped True if the state was discarded because the
+      /// state buffer was full.
+      public: void NotifyStateCapture(const bool _dropped);
+
+      /// \brief Get the number of states captured since the logger
+      /// started, including the dropped ones.
+      /// \return Number of captured states.
+      public: uint64_t CapturedStateCount() const;
+
+      /// \brief Get the number of states dropped since the logger started.
+      /// \return Number of dropped states.
+      public: uint64_t DroppedStateCount() const;
+
       /// \brief Get whether the model meshes and materials are saved when
       /// recording.
       /// \return True if model meshes and materials are saved when recording.
@@ -176,14 +242,15 @@ namespace gazebo
       public: bool Start(const LogRecordParams &_params);
 
       /// \brief Start the logger.
-      /// \param[in] _encoding The type of encoding (txt, zlib, or bz2).
+      /// \param[in] _encoding The type of encoding (txt, zlib, bz2, or bin).
       /// \param[in] _path Path in which to store log files.
       public: bool Start(const std::string &_encoding="zlib",
                          const std::string &_path="");
 
       /// \brief Get the encoding used.
-      /// \return Either [txt, zlib, or bz2], where txt is plain txt and bz2
-      /// and zlib are compressed data with Base64 encoding.
+      /// \return Either [txt, zlib, bz2, or bin], where txt is plain txt,
+      /// bz2 and zlib are compressed data with Base64 encoding, and bin is
+      /// a binary file of zlib compressed chunks with a time index.
       public: const std::string &Encoding() const;
 
       /// \brief Get the filename for a log object.
@@ -238,6 +305,11 @@ namespace gazebo
       /// the data to their respective log files.
       private: void Update();
 
+      /// \brief Subscribe to the sensor topics advertised since the last
+      /// attempt, and write the messages received since the last call.
+      /// \param[in] _discard True to drop the received messages.
+      private: void UpdateTopics(const bool _discard);
+
       /// \brief Function used by the update thread.
       private: void RunUpdate();
 
@@ -17,15 +17,23 @@
 #ifndef _GAZEBO_UTIL_LOGRECORD_PRIVATE_HH_
 #define _GAZEBO_UTIL_LOGRECORD_PRIVATE_HH_
 
+#include <atomic>
 #include <list>
+#include <memory>
 #include <map>
 #include <set>
 #include <string>
 #include <thread>
+#include <vector>
 #include <functional>
 #include <condition_variable>
 #include <boost/filesystem.hpp>
 
+#include "gazebo/common/MemoryStats.hh"
+#include "gazebo/util/LogBinaryFormat.hh"
+#include "gazebo/util/LogTopicCodec.hh"
+#include "gazebo/util/TopicBag.hh"
+
 namespace gazebo
 {
   namespace util
@@ -56,11 +64,23 @@ namespace gazebo
 
         /// \brief Start the log.
         /// \param[in] _path The complete path in which to put the log file.
-        public: void Start(const boost::filesystem::path &_path);
+        /// \param[in] _segment Sequence number added to the file name, or
+        /// -1 if the log isn't split in segments.
+        public: void Start(const boost::filesystem::path &_path,
+                    const int _segment = -1);
 
         /// \brief Stop logging.
         public: void Stop();
 
+        /// \brief Close the current segment and start the next one.
+        /// \param[in] _segment Sequence number of the next segment.
+        /// \return Path of the closed segment.
+        public: boost::filesystem::path Rotate(const int _segment);
+
+        /// \brief Write the time index or the closing tag, and close the
+        /// file.
+        public: void Finish();
+
         /// \brief Write data to disk.
         public: void Write();
 
@@ -68,6 +88,11 @@ namespace gazebo
         /// \return The size of the data buffer.
         public: unsigned int Update();
 
+        /// \brief Compress a block of log data and append it to the buffer
+        /// as a binary chunk. The chunk is added to the time index.
+        /// \param[in] _data Uncompressed log data.
+        public: void AppendBinaryChunk(const std::string &_data);
+
         /// \brief Clear the data buffer.
         public: void ClearBuffer();
 
@@ -93,6 +118,9 @@ namespace gazebo
         /// \brief Data buffer.
         public: std::string buffer;
 
+        /// \brief Memory reserved by buffer.
+        public: common::MemoryCharge bufferMemory{"LogRecord/buffers"};
+
         /// \brief The log file.
         public: std::ofstream logFile;
 
@@ -101,6 +129,18 @@ namespace gazebo
 
         /// \brief Complete file path.
         public: boost::filesystem::path completePath;
+
+        /// \brief Directory of the log file.
+        public: boost::filesystem::path directory;
+
+        /// \brief True if the log uses the binary container.
+        public: bool binary = false;
+
+        /// \brief Number of bytes written to logFile so far.
+        public: uint64_t bytesWritten = 0;
+
+        /// \brief Offsets and start times of the chunks of a binary log.
+        public: std::vector<logbin::IndexEntry> index;
       };
 
       /// \def Log_M
@@ -217,6 +257,144 @@ namespace gazebo
 
       /// \brief List of saved files if record with resources is enabled.
       public: std::set<std::string> savedFiles;
+
+      /// \brief Maximum number of captured states waiting to be serialized.
+      public: unsigned int stateBufferSize = 256;
+
+      /// \brief Policy applied when the state buffer is full.
+      public: std::string overflowPolicy = "block";
+
+      /// \brief Number of states captured since the logger started.
+      public: std::atomic<uint64_t> capturedStates{0};
+
+      /// \brief Number of states dropped since the logger started.
+      public: std::atomic<uint64_t> droppedStates{0};
+
+      /// \brief A sensor topic recorded next to the state log.
+      public: class TopicStream
+      {
+        /// \brief Constructor.
+        /// \param[in] _type Message type name.
+        public: explicit TopicStream(const std::string &_type)
+                : codec(_type)
+        {
+        }
+
+        /// \brief Queue a message. Encoding is left to the update thread
+        /// so that the transport thread isn't held up.
+        /// \param[in] _data Serialized message.
+        public: void OnData(const std::string &_data)
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          this->pending.push_back(_data);
+        }
+
+        /// \brief Compresses the messages of the topic.
+        public: LogTopicCodec codec;
+
+        /// \brief Index of the topic in the bag.
+        public: uint32_t topic = 0;
+
+        /// \brief Messages received since the last update.
+        public: std::vector<std::string> pending;
+
+        /// \brief Protects pending.
+        public: std::mutex mutex;
+      };
+
+      /// \brief A completed log segment on disk.
+      public: class Segment
+      {
+        /// \brief Path of the file.
+        public: boost::filesystem::path path;
+
+        /// \brief Size of the file in bytes.
+        public: uint64_t size = 0;
+
+        /// \brief True once uploaded.
+        public: bool uploaded = false;
+      };
+
+      /// \brief Get whether the logs are split in segments.
+      /// \return True if a segment size or duration is set.
+      public: bool Segmented() const;
+
+      /// \brief Get whether the current segments should be closed. Call
+      /// with writeMutex locked.
+      /// \return True if a segment is too large or too old.
+      public: bool RotationDue() const;
+
+      /// \brief Hand a closed log file over for upload and disk bounding.
+      /// \param[in] _path Path of the file.
+      public: void CloseSegment(const boost::filesystem::path &_path);
+
+      /// \brief Delete segments until the disk bound holds. Call with
+      /// segmentMutex locked.
+      public: void TrimSegments();
+
+      /// \brief Body of the upload thread.
+      public: void RunUpload();
+
+      /// \brief Segment size in bytes, 0 to not rotate by size.
+      public: uint64_t segmentSize = 0;
+
+      /// \brief Segment duration in seconds, 0 to not rotate by time.
+      public: double segmentDuration = 0;
+
+      /// \brief Command that uploads a segment.
+      public: std::string uploadCommand;
+
+      /// \brief Bound of the disk space of completed segments, 0 for none.
+      public: uint64_t maxDiskUsage = 0;
+
+      /// \brief Sequence number of the current segments.
+      public: int segmentIndex = 0;
+
+      /// \brief Wall time at which the current segments started.
+      public: common::Time segmentStartTime;
+
+      /// \brief True while the logs collect the first data of a new
+      /// segment, so that FirstUpdate lets them write their full state.
+      public: bool segmentStart = false;
+
+      /// \brief Completed segments kept on disk, oldest first.
+      public: std::list<Segment> segments;
+
+      /// \brief Segments waiting for upload, oldest first.
+      public: std::list<boost::filesystem::path> uploadQueue;
+
+      /// \brief Segment being uploaded.
+      public: boost::filesystem::path uploading;
+
+      /// \brief True to stop the upload thread once the queue is empty.
+      public: bool stopUpload = false;
+
+      /// \brief Uploads the completed segments.
+      public: std::unique_ptr<std::thread> uploadThread;
+
+      /// \brief Signals segments to upload.
+      public: std::condition_variable uploadCondition;
+
+      /// \brief Protects the segments and upload data.
+      public: std::mutex segmentMutex;
+
+      /// \brief Sensor topics to record.
+      public: std::vector<std::string> topics;
+
+      /// \brief Sensor topics not advertised yet.
+      public: std::vector<std::string> pendingTopics;
+
+      /// \brief Wall time of the next lookup of the pending topics.
+      public: common::Time nextTopicLookup;
+
+      /// \brief Bag of the sensor topics, next to the state log.
+      public: TopicBagWriter topicBag;
+
+      /// \brief Recorded sensor topics.
+      public: std::vector<std::unique_ptr<TopicStream>> topicStreams;
+
+      /// \brief Subscribers of the recorded sensor topics.
+      public: std::vector<transport::SubscriberPtr> topicSubs;
     };
     /// \}
   }
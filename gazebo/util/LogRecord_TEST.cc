@@ -226,6 +226,36 @@ TEST_F(LogRecord_TEST, RecordResources)
   EXPECT_FALSE(recorder->RecordResources());
 }
 
+/////////////////////////////////////////////////
+/// \brief Test LogRecord state buffer parameters
+TEST_F(LogRecord_TEST, StateBuffer)
+{
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+
+  // check default values
+  EXPECT_EQ(recorder->StateBufferSize(), 256u);
+  EXPECT_EQ(recorder->OverflowPolicy(), "block");
+
+  // invalid parameters
+  gazebo::util::LogRecordParams params;
+  params.overflowPolicy = "garbage";
+  EXPECT_FALSE(recorder->Start(params));
+  EXPECT_EQ(recorder->OverflowPolicy(), "block");
+
+  params.overflowPolicy = "drop";
+  params.stateBufferSize = 0;
+  EXPECT_FALSE(recorder->Start(params));
+  EXPECT_EQ(recorder->StateBufferSize(), 256u);
+
+  // counters
+  uint64_t captured = recorder->CapturedStateCount();
+  uint64_t dropped = recorder->DroppedStateCount();
+  recorder->NotifyStateCapture(false);
+  recorder->NotifyStateCapture(true);
+  EXPECT_EQ(recorder->CapturedStateCount(), captured + 2);
+  EXPECT_EQ(recorder->DroppedStateCount(), dropped + 1);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,512 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "gazebo/common/TraceCapture.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/msgs/MsgFactory.hh"
+#include "gazebo/util/LogTopicCodec.hh"
+
+using namespace gazebo;
+using namespace util;
+
+/// \brief Number of scans between two keyframes.
+static const unsigned int kScanKeyframeInterval = 32u;
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Private data for the LogTopicCodec class
+    class LogTopicCodecPrivate
+    {
+      /// \brief Message type name.
+      public: std::string type;
+
+      /// \brief Encoding of the messages.
+      public: std::string encoding;
+
+      /// \brief Bits of the ranges of the previous scan.
+      public: std::vector<uint64_t> ranges;
+
+      /// \brief Bits of the intensities of the previous scan.
+      public: std::vector<uint64_t> intensities;
+
+      /// \brief True if ranges and intensities hold the previous scan.
+      public: bool hasReference = false;
+
+      /// \brief Number of scans encoded since the last keyframe.
+      public: unsigned int sinceKeyframe = 0u;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Deflate data.
+/// \param[in] _data Data to compress.
+/// \return Compressed data.
+static std::string Deflate(const std::string &_data)
+{
+  std::string compressed;
+  {
+    boost::iostreams::filtering_ostream out;
+    out.push(boost::iostreams::zlib_compressor());
+    out.push(std::back_inserter(compressed));
+    boost::iostreams::copy(boost::make_iterator_range(_data), out);
+  }
+  return compressed;
+}
+
+/////////////////////////////////////////////////
+/// \brief Inflate data.
+/// \param[in] _data Compressed data.
+/// \param[out] _out Decompressed data.
+/// \return False if the data is not valid zlib data.
+static bool Inflate(const std::string &_data, std::string &_out)
+{
+  _out.clear();
+  try
+  {
+    boost::iostreams::filtering_istream in;
+    in.push(boost::iostreams::zlib_decompressor());
+    in.push(boost::make_iterator_range(_data));
+    boost::iostreams::copy(in, std::back_inserter(_out));
+  }
+  catch(...)
+  {
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Paeth predictor of PNG.
+/// \param[in] _a Byte to the left.
+/// \param[in] _b Byte above.
+/// \param[in] _c Byte above and to the left.
+/// \return Predicted byte.
+static unsigned char Paeth(const int _a, const int _b, const int _c)
+{
+  const int p = _a + _b - _c;
+  const int pa = std::abs(p - _a);
+  const int pb = std::abs(p - _b);
+  const int pc = std::abs(p - _c);
+  if (pa <= pb && pa <= pc)
+    return static_cast<unsigned char>(_a);
+  if (pb <= pc)
+    return static_cast<unsigned char>(_b);
+  return static_cast<unsigned char>(_c);
+}
+
+/////////////////////////////////////////////////
+/// \brief Replace the bytes of an image by their difference with the Paeth
+/// prediction, or restore them.
+/// \param[in,out] _data Rows of the image.
+/// \param[in] _rows Number of rows.
+/// \param[in] _step Bytes per row.
+/// \param[in] _bpp Bytes per pixel.
+/// \param[in] _forward True to filter, false to restore.
+static void FilterImage(std::string &_data, const unsigned int _rows,
+    const unsigned int _step, const unsigned int _bpp, const bool _forward)
+{
+  unsigned char *bytes = reinterpret_cast<unsigned char *>(&_data[0]);
+
+  // Filtering runs backwards so that the predictions read unfiltered
+  // bytes; restoring runs forwards for the same reason.
+  for (unsigned int n = 0; n < _rows; ++n)
+  {
+    const unsigned int y = _forward ? _rows - 1 - n : n;
+    unsigned char *row = bytes + y * _step;
+    const unsigned char *up = y > 0 ? row - _step : nullptr;
+    for (unsigned int m = 0; m < _step; ++m)
+    {
+      const unsigned int x = _forward ? _step - 1 - m : m;
+      const int a = x >= _bpp ? row[x - _bpp] : 0;
+      const int b = up ? up[x] : 0;
+      const int c = up && x >= _bpp ? up[x - _bpp] : 0;
+      const unsigned char p = Paeth(a, b, c);
+      row[x] = _forward ? row[x] - p : row[x] + p;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a little endian 32 bit value.
+/// \param[in] _value Value.
+/// \param[in,out] _out Buffer.
+static void PutU32(const uint32_t _value, std::string &_out)
+{
+  for (int i = 0; i < 4; ++i)
+    _out.push_back(static_cast<char>((_value >> (8 * i)) & 0xff));
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a little endian 32 bit value.
+/// \param[in] _in Buffer.
+/// \param[in,out] _pos Offset of the value, moved past it.
+/// \param[out] _value Value.
+/// \return False if the buffer is too short.
+static bool GetU32(const std::string &_in, size_t &_pos, uint32_t &_value)
+{
+  if (_pos + 4 > _in.size())
+    return false;
+  _value = 0;
+  for (int i = 0; i < 4; ++i)
+  {
+    _value |= static_cast<uint32_t>(
+        static_cast<unsigned char>(_in[_pos + i])) << (8 * i);
+  }
+  _pos += 4;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the bits of repeated doubles.
+/// \param[in] _values Values.
+/// \return Bit patterns.
+static std::vector<uint64_t> Bits(
+    const google::protobuf::RepeatedField<double> &_values)
+{
+  std::vector<uint64_t> bits(_values.size());
+  if (!bits.empty())
+    std::memcpy(bits.data(), _values.data(), bits.size() * sizeof(uint64_t));
+  return bits;
+}
+
+/////////////////////////////////////////////////
+/// \brief Append values XORed with a reference, one byte plane after the
+/// other so that the unchanged high bytes deflate to almost nothing.
+/// \param[in] _values Bits of the values.
+/// \param[in] _reference Bits of the reference, empty for none.
+/// \param[in,out] _out Buffer.
+static void PutPlanes(const std::vector<uint64_t> &_values,
+    const std::vector<uint64_t> &_reference, std::string &_out)
+{
+  for (int b = 0; b < 8; ++b)
+  {
+    for (size_t i = 0; i < _values.size(); ++i)
+    {
+      const uint64_t v = _reference.empty() ?
+          _values[i] : _values[i] ^ _reference[i];
+      _out.push_back(static_cast<char>((v >> (8 * b)) & 0xff));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Read values written by PutPlanes.
+/// \param[in] _in Buffer.
+/// \param[in,out] _pos Offset of the planes, moved past them.
+/// \param[in] _count Number of values.
+/// \param[in] _reference Bits of the reference, empty for none.
+/// \param[out] _values Bits of the values.
+/// \return False if the buffer is too short.
+static bool GetPlanes(const std::string &_in, size_t &_pos,
+    const uint32_t _count, const std::vector<uint64_t> &_reference,
+    std::vector<uint64_t> &_values)
+{
+  if (_pos + 8u * _count > _in.size())
+    return false;
+  _values.assign(_count, 0u);
+  for (int b = 0; b < 8; ++b)
+  {
+    for (uint32_t i = 0; i < _count; ++i)
+    {
+      _values[i] |= static_cast<uint64_t>(
+          static_cast<unsigned char>(_in[_pos++])) << (8 * b);
+    }
+  }
+  if (!_reference.empty())
+  {
+    for (uint32_t i = 0; i < _count; ++i)
+      _values[i] ^= _reference[i];
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the time of a message, from its time field or the stamp of
+/// its header.
+/// \param[in] _msg Message.
+/// \param[out] _stamp Time, untouched if the message has none.
+static void ReadStamp(const google::protobuf::Message &_msg,
+    common::Time &_stamp)
+{
+  const google::protobuf::Descriptor *desc = _msg.GetDescriptor();
+  const google::protobuf::Reflection *refl = _msg.GetReflection();
+  const google::protobuf::FieldDescriptor *field =
+    desc->FindFieldByName("time");
+  const google::protobuf::Message *holder = &_msg;
+  if (!field)
+  {
+    const google::protobuf::FieldDescriptor *header =
+      desc->FindFieldByName("header");
+    if (!header || header->is_repeated() ||
+        header->message_type() != msgs::Header::descriptor() ||
+        !refl->HasField(_msg, header))
+    {
+      return;
+    }
+    holder = &refl->GetMessage(_msg, header);
+    field = holder->GetDescriptor()->FindFieldByName("stamp");
+  }
+
+  if (!field || field->is_repeated() ||
+      field->message_type() != msgs::Time::descriptor() ||
+      !holder->GetReflection()->HasField(*holder, field))
+  {
+    return;
+  }
+
+  _stamp = msgs::Convert(static_cast<const msgs::Time &>(
+        holder->GetReflection()->GetMessage(*holder, field)));
+}
+
+/////////////////////////////////////////////////
+LogTopicCodec::LogTopicCodec(const std::string &_type)
+  : dataPtr(new LogTopicCodecPrivate)
+{
+  this->dataPtr->type = _type;
+  if (_type == msgs::ImageStamped::descriptor()->full_name())
+    this->dataPtr->encoding = "image";
+  else if (_type == msgs::LaserScanStamped::descriptor()->full_name())
+    this->dataPtr->encoding = "scan";
+  else
+    this->dataPtr->encoding = "zlib";
+}
+
+/////////////////////////////////////////////////
+LogTopicCodec::LogTopicCodec(const std::string &_type,
+    const std::string &_encoding)
+  : dataPtr(new LogTopicCodecPrivate)
+{
+  this->dataPtr->type = _type;
+  this->dataPtr->encoding = _encoding;
+}
+
+/////////////////////////////////////////////////
+LogTopicCodec::~LogTopicCodec()
+{
+}
+
+/////////////////////////////////////////////////
+const std::string &LogTopicCodec::Type() const
+{
+  return this->dataPtr->type;
+}
+
+/////////////////////////////////////////////////
+const std::string &LogTopicCodec::Encoding() const
+{
+  return this->dataPtr->encoding;
+}
+
+/////////////////////////////////////////////////
+std::string LogTopicCodec::BagType() const
+{
+  return this->dataPtr->type + ";" + this->dataPtr->encoding;
+}
+
+/////////////////////////////////////////////////
+void LogTopicCodec::ParseBagType(const std::string &_bagType,
+    std::string &_type, std::string &_encoding)
+{
+  const size_t sep = _bagType.find(';');
+  _type = _bagType.substr(0, sep);
+  _encoding = sep == std::string::npos ? "" : _bagType.substr(sep + 1);
+}
+
+/////////////////////////////////////////////////
+bool LogTopicCodec::Encode(const std::string &_data, std::string &_out,
+    common::Time &_stamp)
+{
+  IGN_PROFILE("util::LogTopicCodec::Encode");
+
+  if (this->dataPtr->encoding == "image")
+  {
+    msgs::ImageStamped msg;
+    if (!msg.ParseFromString(_data))
+      return false;
+    _stamp = msgs::Convert(msg.time());
+
+    // Images whose rows don't match their size are deflated unfiltered.
+    msgs::Image *image = msg.mutable_image();
+    const bool filtered = image->width() > 0 &&
+        image->step() >= image->width() &&
+        image->data().size() ==
+        static_cast<size_t>(image->step()) * image->height();
+    if (filtered)
+    {
+      FilterImage(*image->mutable_data(), image->height(), image->step(),
+          image->step() / image->width(), true);
+    }
+
+    _out.assign(1, filtered ? 1 : 0);
+    _out += Deflate(msg.SerializeAsString());
+    return true;
+  }
+  else if (this->dataPtr->encoding == "scan")
+  {
+    msgs::LaserScanStamped msg;
+    if (!msg.ParseFromString(_data))
+      return false;
+    _stamp = msgs::Convert(msg.time());
+
+    std::vector<uint64_t> ranges = Bits(msg.scan().ranges());
+    std::vector<uint64_t> intensities = Bits(msg.scan().intensities());
+    msg.mutable_scan()->clear_ranges();
+    msg.mutable_scan()->clear_intensities();
+    const std::string header = msg.SerializeAsString();
+
+    const bool keyframe = !this->dataPtr->hasReference ||
+        this->dataPtr->sinceKeyframe + 1 >= kScanKeyframeInterval ||
+        ranges.size() != this->dataPtr->ranges.size() ||
+        intensities.size() != this->dataPtr->intensities.size();
+    const std::vector<uint64_t> none;
+
+    std::string raw;
+    raw.reserve(13 + header.size() +
+        8 * (ranges.size() + intensities.size()));
+    raw.push_back(keyframe ? 1 : 0);
+    PutU32(static_cast<uint32_t>(header.size()), raw);
+    PutU32(static_cast<uint32_t>(ranges.size()), raw);
+    PutU32(static_cast<uint32_t>(intensities.size()), raw);
+    raw += header;
+    PutPlanes(ranges, keyframe ? none : this->dataPtr->ranges, raw);
+    PutPlanes(intensities, keyframe ? none : this->dataPtr->intensities, raw);
+    _out = Deflate(raw);
+
+    this->dataPtr->sinceKeyframe = keyframe ? 0 :
+        this->dataPtr->sinceKeyframe + 1;
+    this->dataPtr->ranges.swap(ranges);
+    this->dataPtr->intensities.swap(intensities);
+    this->dataPtr->hasReference = true;
+    return true;
+  }
+
+  auto msg = msgs::MsgFactory::NewMsg(this->dataPtr->type);
+  if (msg && msg->ParseFromString(_data))
+    ReadStamp(*msg, _stamp);
+  _out = Deflate(_data);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogTopicCodec::Decode(const std::string &_data, std::string &_out)
+{
+  IGN_PROFILE("util::LogTopicCodec::Decode");
+
+  if (this->dataPtr->encoding.empty())
+  {
+    _out = _data;
+    return true;
+  }
+  else if (this->dataPtr->encoding == "zlib")
+  {
+    return Inflate(_data, _out);
+  }
+  else if (this->dataPtr->encoding == "image")
+  {
+    std::string raw;
+    msgs::ImageStamped msg;
+    if (_data.empty() || !Inflate(_data.substr(1), raw) ||
+        !msg.ParseFromString(raw))
+    {
+      return false;
+    }
+
+    if (_data[0])
+    {
+      msgs::Image *image = msg.mutable_image();
+      if (image->width() == 0 || image->data().size() !=
+          static_cast<size_t>(image->step()) * image->height())
+      {
+        return false;
+      }
+      FilterImage(*image->mutable_data(), image->height(), image->step(),
+          image->step() / image->width(), false);
+    }
+    return msg.SerializeToString(&_out);
+  }
+  else if (this->dataPtr->encoding == "scan")
+  {
+    std::string raw;
+    if (!Inflate(_data, raw) || raw.empty())
+      return false;
+
+    size_t pos = 1;
+    uint32_t headerSize, rangeCount, intensityCount;
+    if (!GetU32(raw, pos, headerSize) || !GetU32(raw, pos, rangeCount) ||
+        !GetU32(raw, pos, intensityCount) || pos + headerSize > raw.size())
+    {
+      return false;
+    }
+
+    const bool keyframe = raw[0] != 0;
+    if (!keyframe && (!this->dataPtr->hasReference ||
+        rangeCount != this->dataPtr->ranges.size() ||
+        intensityCount != this->dataPtr->intensities.size()))
+    {
+      return false;
+    }
+
+    msgs::LaserScanStamped msg;
+    if (!msg.ParseFromArray(raw.data() + pos, headerSize))
+      return false;
+    pos += headerSize;
+
+    const std::vector<uint64_t> none;
+    std::vector<uint64_t> ranges, intensities;
+    if (!GetPlanes(raw, pos, rangeCount,
+          keyframe ? none : this->dataPtr->ranges, ranges) ||
+        !GetPlanes(raw, pos, intensityCount,
+          keyframe ? none : this->dataPtr->intensities, intensities))
+    {
+      this->dataPtr->hasReference = false;
+      return false;
+    }
+
+    msgs::LaserScan *scan = msg.mutable_scan();
+    scan->mutable_ranges()->Resize(rangeCount, 0.0);
+    scan->mutable_intensities()->Resize(intensityCount, 0.0);
+    if (rangeCount > 0)
+    {
+      std::memcpy(scan->mutable_ranges()->mutable_data(), ranges.data(),
+          rangeCount * sizeof(uint64_t));
+    }
+    if (intensityCount > 0)
+    {
+      std::memcpy(scan->mutable_intensities()->mutable_data(),
+          intensities.data(), intensityCount * sizeof(uint64_t));
+    }
+
+    this->dataPtr->ranges.swap(ranges);
+    this->dataPtr->intensities.swap(intensities);
+    this->dataPtr->hasReference = true;
+    return msg.SerializeToString(&_out);
+  }
+
+  return false;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_LOGTOPICCODEC_HH_
+#define GAZEBO_UTIL_LOGTOPICCODEC_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    // Forward declare private data class
+    class LogTopicCodecPrivate;
+
+    /// \addtogroup gazebo_util
+    /// \{
+
+    /// \class LogTopicCodec LogTopicCodec.hh util/util.hh
+    /// \brief Compresses the messages of a topic recorded next to a state
+    /// log, and restores them.
+    ///
+    /// The encoding depends on the message type:
+    ///   - "image": the pixels of an ImageStamped are filtered with the
+    ///     Paeth predictor of PNG and deflated. Lossless, for any pixel
+    ///     format including float depth images.
+    ///   - "scan": the ranges and intensities of a LaserScanStamped are
+    ///     XORed with the ones of the previous scan, then deflated. Every
+    ///     32nd scan, and any scan whose size changed, is a keyframe
+    ///     stored without a reference.
+    ///   - "zlib": any other message is deflated as is.
+    ///
+    /// A codec keeps the previous scan, so use one codec per topic, and
+    /// decode the frames of a topic in order, starting from a keyframe.
+    class GZ_UTIL_VISIBLE LogTopicCodec
+    {
+      /// \brief Constructor, picks the encoding of a message type.
+      /// \param[in] _type Message type name, such as
+      /// gazebo.msgs.ImageStamped.
+      public: explicit LogTopicCodec(const std::string &_type);
+
+      /// \brief Constructor for a topic read from a bag.
+      /// \param[in] _type Message type name.
+      /// \param[in] _encoding Encoding of the recorded messages.
+      public: LogTopicCodec(const std::string &_type,
+                  const std::string &_encoding);
+
+      /// \brief Destructor.
+      public: ~LogTopicCodec();
+
+      /// \brief Get the message type name.
+      /// \return Message type name.
+      public: const std::string &Type() const;
+
+      /// \brief Get the encoding.
+      /// \return One of image, scan or zlib.
+      public: const std::string &Encoding() const;
+
+      /// \brief Get the type recorded in a bag for the topic, the message
+      /// type and encoding separated by a semicolon.
+      /// \return Type name for TopicBagWriter::AddTopic.
+      public: std::string BagType() const;
+
+      /// \brief Split a type read from a bag.
+      /// \param[in] _bagType Type of a TopicBagTopic.
+      /// \param[out] _type Message type name.
+      /// \param[out] _encoding Encoding, empty if the messages are not
+      /// encoded.
+      public: static void ParseBagType(const std::string &_bagType,
+                  std::string &_type, std::string &_encoding);
+
+      /// \brief Encode a message.
+      /// \param[in] _data Serialized message.
+      /// \param[out] _out Encoded message.
+      /// \param[out] _stamp Time of the message's time field. Left
+      /// untouched if the message has none.
+      /// \return False if the message could not be parsed.
+      public: bool Encode(const std::string &_data, std::string &_out,
+                  common::Time &_stamp);
+
+      /// \brief Decode a message.
+      /// \param[in] _data Encoded message.
+      /// \param[out] _out Serialized message.
+      /// \return False if the data is corrupted, or is a scan that follows
+      /// a frame not decoded by this codec.
+      public: bool Decode(const std::string &_data, std::string &_out);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LogTopicCodecPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/LogTopicCodec.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LogTopicCodec_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(LogTopicCodec_TEST, BagType)
+{
+  util::LogTopicCodec image("gazebo.msgs.ImageStamped");
+  EXPECT_EQ(image.Encoding(), "image");
+  EXPECT_EQ(image.BagType(), "gazebo.msgs.ImageStamped;image");
+
+  util::LogTopicCodec scan("gazebo.msgs.LaserScanStamped");
+  EXPECT_EQ(scan.Encoding(), "scan");
+
+  util::LogTopicCodec other("gazebo.msgs.PointCloud");
+  EXPECT_EQ(other.Encoding(), "zlib");
+
+  std::string type, encoding;
+  util::LogTopicCodec::ParseBagType(scan.BagType(), type, encoding);
+  EXPECT_EQ(type, "gazebo.msgs.LaserScanStamped");
+  EXPECT_EQ(encoding, "scan");
+
+  util::LogTopicCodec::ParseBagType("gazebo.msgs.Pose", type, encoding);
+  EXPECT_EQ(type, "gazebo.msgs.Pose");
+  EXPECT_TRUE(encoding.empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogTopicCodec_TEST, Image)
+{
+  msgs::ImageStamped msg;
+  msgs::Set(msg.mutable_time(), common::Time(3, 500));
+  msgs::Image *image = msg.mutable_image();
+  image->set_width(64);
+  image->set_height(48);
+  image->set_pixel_format(3);
+  image->set_step(64 * 3);
+  std::string pixels;
+  for (unsigned int y = 0; y < 48; ++y)
+  {
+    for (unsigned int x = 0; x < 64; ++x)
+    {
+      pixels.push_back(static_cast<char>(x * 4));
+      pixels.push_back(static_cast<char>(y * 5));
+      pixels.push_back(static_cast<char>((x + y) % 7));
+    }
+  }
+  image->set_data(pixels);
+  const std::string data = msg.SerializeAsString();
+
+  util::LogTopicCodec encoder(msg.GetTypeName());
+  std::string encoded;
+  common::Time stamp;
+  ASSERT_TRUE(encoder.Encode(data, encoded, stamp));
+  EXPECT_EQ(stamp, common::Time(3, 500));
+
+  // A smooth image filters to almost nothing.
+  EXPECT_LT(encoded.size(), data.size() / 10);
+
+  util::LogTopicCodec decoder(msg.GetTypeName(), "image");
+  std::string decoded;
+  ASSERT_TRUE(decoder.Decode(encoded, decoded));
+  EXPECT_EQ(decoded, data);
+
+  // An image whose data doesn't match its rows is kept as is.
+  image->set_data("abc");
+  const std::string odd = msg.SerializeAsString();
+  ASSERT_TRUE(encoder.Encode(odd, encoded, stamp));
+  ASSERT_TRUE(decoder.Decode(encoded, decoded));
+  EXPECT_EQ(decoded, odd);
+
+  EXPECT_FALSE(decoder.Decode("garbage", decoded));
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogTopicCodec_TEST, Scan)
+{
+  util::LogTopicCodec encoder("gazebo.msgs.LaserScanStamped");
+  util::LogTopicCodec decoder("gazebo.msgs.LaserScanStamped", "scan");
+
+  std::vector<std::string> encoded;
+  std::vector<std::string> originals;
+  for (int i = 0; i < 40; ++i)
+  {
+    msgs::LaserScanStamped msg;
+    msgs::Set(msg.mutable_time(), common::Time(i, 0));
+    msgs::LaserScan *scan = msg.mutable_scan();
+    scan->set_frame("lidar");
+    msgs::Set(scan->mutable_world_pose(), ignition::math::Pose3d::Zero);
+    scan->set_angle_min(-1.0);
+    scan->set_angle_max(1.0);
+    scan->set_angle_step(0.01);
+    scan->set_range_min(0.1);
+    scan->set_range_max(10.0);
+
+    // The scan grows once, which forces a keyframe.
+    const unsigned int count = i < 20 ? 200u : 201u;
+    scan->set_count(count);
+    for (unsigned int j = 0; j < count; ++j)
+    {
+      scan->add_ranges(static_cast<float>(5.0 + (j == 7u ? i * 0.01 : 0.0)));
+      scan->add_intensities(j % 3);
+    }
+
+    originals.push_back(msg.SerializeAsString());
+    std::string out;
+    common::Time stamp;
+    ASSERT_TRUE(encoder.Encode(originals.back(), out, stamp));
+    EXPECT_EQ(stamp, common::Time(i, 0));
+    encoded.push_back(out);
+  }
+
+  // Delta frames are much smaller than the scan.
+  EXPECT_LT(encoded[5].size(), originals[5].size() / 10);
+
+  for (size_t i = 0; i < encoded.size(); ++i)
+  {
+    std::string decoded;
+    ASSERT_TRUE(decoder.Decode(encoded[i], decoded)) << i;
+    EXPECT_EQ(decoded, originals[i]) << i;
+  }
+
+  // A delta frame can't be decoded without its reference, a keyframe can.
+  util::LogTopicCodec late("gazebo.msgs.LaserScanStamped", "scan");
+  std::string decoded;
+  EXPECT_FALSE(late.Decode(encoded[5], decoded));
+  EXPECT_TRUE(late.Decode(encoded[20], decoded));
+  EXPECT_EQ(decoded, originals[20]);
+  EXPECT_TRUE(late.Decode(encoded[21], decoded));
+  EXPECT_EQ(decoded, originals[21]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogTopicCodec_TEST, Other)
+{
+  msgs::PosesStamped msg;
+  msgs::Set(msg.mutable_time(), common::Time(7, 1));
+  msgs::Pose *pose = msg.add_pose();
+  pose->set_name("box");
+  msgs::Set(pose, ignition::math::Pose3d(1, 2, 3, 0, 0, 0));
+  const std::string data = msg.SerializeAsString();
+
+  util::LogTopicCodec encoder(msg.GetTypeName());
+  std::string encoded;
+  common::Time stamp;
+  ASSERT_TRUE(encoder.Encode(data, encoded, stamp));
+  EXPECT_EQ(stamp, common::Time(7, 1));
+
+  util::LogTopicCodec decoder(msg.GetTypeName(), encoder.Encoding());
+  std::string decoded;
+  ASSERT_TRUE(decoder.Decode(encoded, decoded));
+  EXPECT_EQ(decoded, data);
+
+  // Messages read from a plain bag are returned as is.
+  util::LogTopicCodec plain(msg.GetTypeName(), "");
+  ASSERT_TRUE(plain.Decode(data, decoded));
+  EXPECT_EQ(decoded, data);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
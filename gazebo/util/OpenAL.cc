@@ -34,6 +34,8 @@
 #endif
 #endif
 
+#include <algorithm>
+
 #include <ignition/math/Matrix3.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
@@ -107,12 +109,36 @@ bool OpenAL::Load(sdf::ElementPtr _sdf)
 
   alDistanceModel(AL_EXPONENT_DISTANCE);
 
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+    if (!this->dataPtr->audioThread.joinable())
+    {
+      this->dataPtr->stop = false;
+      this->dataPtr->audioThread =
+          std::thread(&OpenAL::RunAudioThread, this);
+    }
+  }
+
   return true;
 }
 
 /////////////////////////////////////////////////
 void OpenAL::Fini()
 {
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->queueCondition.notify_all();
+  if (this->dataPtr->audioThread.joinable())
+    this->dataPtr->audioThread.join();
+
+  this->dataPtr->sourceUpdates.clear();
+  this->dataPtr->sourceIndices.clear();
+  this->dataPtr->plays.clear();
+  this->dataPtr->queuedSink.reset();
+  this->dataPtr->sources.clear();
+
   if (this->dataPtr->audioDevice)
   {
     alcCloseDevice(this->dataPtr->audioDevice);
@@ -168,6 +194,11 @@ OpenALSourcePtr OpenAL::CreateSource(sdf::ElementPtr _sdf)
     gzerr << "Unable to load OpenAL source from SDF\n";
     source.reset();
   }
+  else
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+    this->dataPtr->sources.push_back(source);
+  }
 
   // Return a pointer to the source
   return source;
@@ -187,6 +218,176 @@ std::set<std::string> OpenAL::DeviceList() const
   return deviceList;
 }
 
+/////////////////////////////////////////////////
+void OpenAL::QueueSourceUpdate(const OpenALSourcePtr &_source,
+    const ignition::math::Pose3d &_pose, const ignition::math::Vector3d &_vel)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+    if (!this->dataPtr->audioThread.joinable())
+      return;
+
+    auto iter = this->dataPtr->sourceIndices.find(_source.get());
+    if (iter != this->dataPtr->sourceIndices.end())
+    {
+      OpenALSourceUpdate &update = this->dataPtr->sourceUpdates[iter->second];
+      update.pose = _pose;
+      update.vel = _vel;
+      return;
+    }
+
+    this->dataPtr->sourceIndices[_source.get()] =
+        this->dataPtr->sourceUpdates.size();
+    this->dataPtr->sourceUpdates.push_back({_source, _pose, _vel});
+  }
+  this->dataPtr->queueCondition.notify_one();
+}
+
+/////////////////////////////////////////////////
+void OpenAL::QueueSinkUpdate(const OpenALSinkPtr &_sink,
+    const ignition::math::Pose3d &_pose, const ignition::math::Vector3d &_vel)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+    if (!this->dataPtr->audioThread.joinable())
+      return;
+
+    this->dataPtr->queuedSink = _sink;
+    this->dataPtr->sinkPose = _pose;
+    this->dataPtr->sinkVel = _vel;
+  }
+  this->dataPtr->queueCondition.notify_one();
+}
+
+/////////////////////////////////////////////////
+void OpenAL::QueuePlay(const OpenALSourcePtr &_source)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+    if (!this->dataPtr->audioThread.joinable())
+      return;
+
+    this->dataPtr->plays.push_back(_source);
+  }
+  this->dataPtr->queueCondition.notify_one();
+}
+
+/////////////////////////////////////////////////
+void OpenAL::Flush()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->queueMutex);
+  this->dataPtr->appliedCondition.wait(lock, [this]
+      {
+        return !this->dataPtr->audioThread.joinable() ||
+            this->dataPtr->stop ||
+            (!this->dataPtr->applying &&
+             this->dataPtr->sourceUpdates.empty() &&
+             this->dataPtr->plays.empty() && !this->dataPtr->queuedSink);
+      });
+}
+
+/////////////////////////////////////////////////
+void OpenAL::SetCullDistance(const double _distance)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+  this->dataPtr->cullDistance = std::max(_distance, 0.0);
+}
+
+/////////////////////////////////////////////////
+double OpenAL::CullDistance() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+  return this->dataPtr->cullDistance;
+}
+
+/////////////////////////////////////////////////
+void OpenAL::RunAudioThread()
+{
+  std::vector<OpenALSourceUpdate> updates;
+  std::vector<OpenALSourcePtr> plays;
+  std::vector<OpenALSourcePtr> culling;
+
+  std::unique_lock<std::mutex> lock(this->dataPtr->queueMutex);
+  while (true)
+  {
+    this->dataPtr->queueCondition.wait(lock, [this]
+        {
+          return this->dataPtr->stop ||
+              !this->dataPtr->sourceUpdates.empty() ||
+              !this->dataPtr->plays.empty() || this->dataPtr->queuedSink;
+        });
+    if (this->dataPtr->stop)
+      break;
+
+    updates.swap(this->dataPtr->sourceUpdates);
+    this->dataPtr->sourceIndices.clear();
+    plays.swap(this->dataPtr->plays);
+    OpenALSinkPtr sink = std::move(this->dataPtr->queuedSink);
+    this->dataPtr->queuedSink.reset();
+    const ignition::math::Pose3d sinkPose = this->dataPtr->sinkPose;
+    const ignition::math::Vector3d sinkVel = this->dataPtr->sinkVel;
+    const double cullDistance = this->dataPtr->cullDistance;
+
+    // When the sink moves every source may change its culling state,
+    // otherwise only the sources that moved.
+    culling.clear();
+    if (cullDistance > 0 && sink)
+    {
+      auto &sources = this->dataPtr->sources;
+      sources.erase(std::remove_if(sources.begin(), sources.end(),
+          [](const std::weak_ptr<OpenALSource> &_source)
+          {
+            return _source.expired();
+          }), sources.end());
+      for (auto const &source : sources)
+        culling.push_back(source.lock());
+    }
+    this->dataPtr->applying = true;
+    lock.unlock();
+
+    // Defer the processing of the context until the whole batch is set.
+    alcSuspendContext(this->dataPtr->context);
+
+    if (sink)
+    {
+      sink->SetPose(sinkPose);
+      sink->SetVelocity(sinkVel);
+      this->dataPtr->sinkPosition = sinkPose.Pos();
+    }
+
+    for (auto const &update : updates)
+    {
+      update.source->SetPose(update.pose);
+      update.source->SetVelocity(update.vel);
+      if (cullDistance > 0 && !sink)
+        culling.push_back(update.source);
+    }
+
+    if (cullDistance > 0)
+    {
+      for (auto const &source : culling)
+      {
+        source->SetCulled(source->Position().Distance(
+            this->dataPtr->sinkPosition) > cullDistance);
+      }
+    }
+
+    for (auto const &source : plays)
+      source->Play();
+
+    alcProcessContext(this->dataPtr->context);
+
+    updates.clear();
+    plays.clear();
+    culling.clear();
+
+    lock.lock();
+    this->dataPtr->applying = false;
+    this->dataPtr->appliedCondition.notify_all();
+  }
+  this->dataPtr->appliedCondition.notify_all();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 //                      OPENAL LISTENER
@@ -347,6 +548,8 @@ bool OpenALSource::SetPose(const ignition::math::Pose3d &_pose)
     return false;
   }
 
+  std::lock_guard<std::mutex> lock(this->dataPtr->cullMutex);
+  this->dataPtr->position = _pose.Pos();
   return true;
 }
 
@@ -444,6 +647,15 @@ bool OpenALSource::OnContact() const
 /////////////////////////////////////////////////
 void OpenALSource::Play()
 {
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->cullMutex);
+    if (this->dataPtr->culled)
+    {
+      this->dataPtr->resume = true;
+      return;
+    }
+  }
+
   int sourceState;
   alGetSourcei(this->dataPtr->alSource, AL_SOURCE_STATE, &sourceState);
 
@@ -455,6 +667,11 @@ void OpenALSource::Play()
 /////////////////////////////////////////////////
 void OpenALSource::Pause()
 {
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->cullMutex);
+    this->dataPtr->resume = false;
+  }
+
   int sourceState;
   alGetSourcei(this->dataPtr->alSource, AL_SOURCE_STATE, &sourceState);
 
@@ -466,6 +683,11 @@ void OpenALSource::Pause()
 /////////////////////////////////////////////////
 void OpenALSource::Stop()
 {
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->cullMutex);
+    this->dataPtr->resume = false;
+  }
+
   int sourceState;
   alGetSourcei(this->dataPtr->alSource, AL_SOURCE_STATE, &sourceState);
 
@@ -483,12 +705,55 @@ void OpenALSource::Rewind()
 /////////////////////////////////////////////////
 bool OpenALSource::IsPlaying()
 {
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->cullMutex);
+    if (this->dataPtr->culled)
+      return this->dataPtr->resume;
+  }
+
   int sourceState;
   alGetSourcei(this->dataPtr->alSource, AL_SOURCE_STATE, &sourceState);
 
   return sourceState == AL_PLAYING;
 }
 
+/////////////////////////////////////////////////
+void OpenALSource::SetCulled(const bool _culled)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->cullMutex);
+  if (_culled == this->dataPtr->culled)
+    return;
+
+  this->dataPtr->culled = _culled;
+  if (_culled)
+  {
+    int sourceState;
+    alGetSourcei(this->dataPtr->alSource, AL_SOURCE_STATE, &sourceState);
+    this->dataPtr->resume = sourceState == AL_PLAYING;
+    if (this->dataPtr->resume)
+      alSourcePause(this->dataPtr->alSource);
+  }
+  else if (this->dataPtr->resume)
+  {
+    alSourcePlay(this->dataPtr->alSource);
+    this->dataPtr->resume = false;
+  }
+}
+
+/////////////////////////////////////////////////
+bool OpenALSource::IsCulled() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->cullMutex);
+  return this->dataPtr->culled;
+}
+
+/////////////////////////////////////////////////
+ignition::math::Vector3d OpenALSource::Position() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->cullMutex);
+  return this->dataPtr->position;
+}
+
 /////////////////////////////////////////////////
 bool OpenALSource::FillBufferFromPCM(uint8_t *_pcmData,
     unsigned int _dataCount, int _sampleRate)
@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_UTIL_OPENAL_HH_
 #define _GAZEBO_UTIL_OPENAL_HH_
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -81,6 +82,49 @@ namespace gazebo
       /// \return A list of audio device names
       public: std::set<std::string> DeviceList() const;
 
+      /// \brief Queue a pose and velocity update of a source. Queued
+      /// updates are applied in a batch by the audio thread, which only
+      /// applies the latest update of each source.
+      /// \param[in] _source The source.
+      /// \param[in] _pose New pose of the source.
+      /// \param[in] _vel New velocity of the source.
+      public: void QueueSourceUpdate(const OpenALSourcePtr &_source,
+                  const ignition::math::Pose3d &_pose,
+                  const ignition::math::Vector3d &_vel);
+
+      /// \brief Queue a pose and velocity update of the sink.
+      /// \param[in] _sink The sink.
+      /// \param[in] _pose New pose of the sink.
+      /// \param[in] _vel New velocity of the sink.
+      /// \sa QueueSourceUpdate
+      public: void QueueSinkUpdate(const OpenALSinkPtr &_sink,
+                  const ignition::math::Pose3d &_pose,
+                  const ignition::math::Vector3d &_vel);
+
+      /// \brief Queue the playback of a source, after the queued pose
+      /// updates.
+      /// \param[in] _source The source.
+      public: void QueuePlay(const OpenALSourcePtr &_source);
+
+      /// \brief Wait until the audio thread applied all queued updates.
+      public: void Flush();
+
+      /// \brief Set the distance from the sink beyond which sources are
+      /// culled. A culled source is paused, and resumes when it gets back
+      /// within the distance. Culling is evaluated on queued updates.
+      /// \param[in] _distance Cull distance in meters, zero to disable
+      /// culling.
+      public: void SetCullDistance(const double _distance);
+
+      /// \brief Get the cull distance.
+      /// \return Cull distance in meters, zero if culling is disabled.
+      /// \sa SetCullDistance
+      public: double CullDistance() const;
+
+      /// \brief Apply queued updates until Fini is called. Runs on the
+      /// audio thread.
+      private: void RunAudioThread();
+
       /// \internal
       /// \brief Private data pointer.
       private: std::unique_ptr<OpenALPrivate> dataPtr;
@@ -182,6 +226,20 @@ namespace gazebo
       /// \brief Is the audio playing
       public: bool IsPlaying();
 
+      /// \brief Set whether the source is culled. A culled source that is
+      /// playing is paused, and resumes when it is no longer culled.
+      /// \param[in] _culled True to cull the source.
+      /// \sa OpenAL::SetCullDistance
+      public: void SetCulled(const bool _culled);
+
+      /// \brief Get whether the source is culled.
+      /// \return True if the source is culled.
+      public: bool IsCulled() const;
+
+      /// \brief Get the position of the source.
+      /// \return Position set by the last successful SetPose.
+      public: ignition::math::Vector3d Position() const;
+
       /// \brief Fill the OpenAL audio buffer from PCM data
       /// \param[in] _pcmData Pointer to the PCM audio data.
       /// \param[in] _dataCount Size of the PCM data.
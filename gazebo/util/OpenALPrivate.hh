@@ -17,9 +17,17 @@
 #ifndef _GAZEBO_UTIL_OPENAL_PRIVATE_HH_
 #define _GAZEBO_UTIL_OPENAL_PRIVATE_HH_
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
 #include "gazebo/gazebo_config.h"
 #include "gazebo/util/UtilTypes.hh"
 
@@ -29,6 +37,20 @@ namespace gazebo
 {
   namespace util
   {
+    /// \internal
+    /// \brief Queued pose and velocity update of a source.
+    class OpenALSourceUpdate
+    {
+      /// \brief The source.
+      public: OpenALSourcePtr source;
+
+      /// \brief New pose of the source.
+      public: ignition::math::Pose3d pose;
+
+      /// \brief New velocity of the source.
+      public: ignition::math::Vector3d vel;
+    };
+
     /// \internal
     /// \brief Private dat for OpenAL
     class OpenALPrivate
@@ -41,6 +63,52 @@ namespace gazebo
 
       /// \brief OpenAL sink pointer.
       public: OpenALSinkPtr sink;
+
+      /// \brief Sources created by CreateSource, checked for culling when
+      /// the sink moves.
+      public: std::vector<std::weak_ptr<OpenALSource>> sources;
+
+      /// \brief Applies the queued updates.
+      public: std::thread audioThread;
+
+      /// \brief True to stop the audio thread.
+      public: bool stop = false;
+
+      /// \brief True while the audio thread applies a batch of updates.
+      public: bool applying = false;
+
+      /// \brief Protects the queued updates and the thread state.
+      public: std::mutex queueMutex;
+
+      /// \brief Signals the audio thread that updates were queued.
+      public: std::condition_variable queueCondition;
+
+      /// \brief Signals Flush that a batch of updates was applied.
+      public: std::condition_variable appliedCondition;
+
+      /// \brief Queued source updates.
+      public: std::vector<OpenALSourceUpdate> sourceUpdates;
+
+      /// \brief Index of the queued update of each source.
+      public: std::unordered_map<const OpenALSource *, size_t> sourceIndices;
+
+      /// \brief Sources queued for playback.
+      public: std::vector<OpenALSourcePtr> plays;
+
+      /// \brief Sink with a queued update, nullptr if none.
+      public: OpenALSinkPtr queuedSink;
+
+      /// \brief Queued pose of the sink.
+      public: ignition::math::Pose3d sinkPose;
+
+      /// \brief Queued velocity of the sink.
+      public: ignition::math::Vector3d sinkVel;
+
+      /// \brief Position of the sink, as of the last applied update.
+      public: ignition::math::Vector3d sinkPosition;
+
+      /// \brief Cull distance, zero to disable culling.
+      public: double cullDistance = 0;
     };
 
     /// \internal
@@ -56,6 +124,18 @@ namespace gazebo
       /// \brief Names of collision objects that should trigger audio
       /// playback.
       public: std::vector<std::string> collisionNames;
+
+      /// \brief Protects the culling state.
+      public: mutable std::mutex cullMutex;
+
+      /// \brief True if the source is culled.
+      public: bool culled = false;
+
+      /// \brief True if a culled source plays when it is no longer culled.
+      public: bool resume = false;
+
+      /// \brief Position of the source.
+      public: ignition::math::Vector3d position;
     };
   }
 }
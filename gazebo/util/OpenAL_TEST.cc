@@ -342,6 +342,66 @@ TEST_F(OpenAL, SinkVelPose)
   EXPECT_TRUE(sink->SetVelocity(ignition::math::Vector3d(1, 1, 1)));
   EXPECT_TRUE(sink->SetPose(ignition::math::Pose3d(1, 1, 1, 0, 0, 0)));
 }
+
+/////////////////////////////////////////////////
+TEST_F(OpenAL, QueuedUpdates)
+{
+  common::load();
+
+  sdf::SDFPtr sdf(new sdf::SDF);
+  sdf::initFile("audio_source.sdf", sdf->Root());
+
+  std::string sdfString = "<sdf version='1.4'>"
+    "<audio_source>"
+    "<uri>file://media/audio/cheer.wav</uri>"
+    "<loop>true</loop>"
+    "</audio_source>"
+    "</sdf>";
+
+  EXPECT_TRUE(sdf::readString(sdfString, sdf->Root()));
+
+  util::OpenAL *openAL = util::OpenAL::Instance();
+  EXPECT_TRUE(openAL->Load());
+  util::OpenALSinkPtr sink = openAL->CreateSink(sdf::ElementPtr());
+  util::OpenALSourcePtr source = openAL->CreateSource(sdf->Root());
+  ASSERT_TRUE(sink != NULL);
+  ASSERT_TRUE(source != NULL);
+  EXPECT_TRUE(source->IsPlaying());
+
+  // Only the last queued update of a source is applied
+  openAL->QueueSourceUpdate(source, ignition::math::Pose3d(1, 0, 0, 0, 0, 0),
+      ignition::math::Vector3d::Zero);
+  openAL->QueueSourceUpdate(source, ignition::math::Pose3d(2, 0, 0, 0, 0, 0),
+      ignition::math::Vector3d::Zero);
+  openAL->Flush();
+  EXPECT_EQ(ignition::math::Vector3d(2, 0, 0), source->Position());
+
+  // A sink far away culls the source, which resumes when the sink is back
+  EXPECT_DOUBLE_EQ(0.0, openAL->CullDistance());
+  openAL->SetCullDistance(10);
+  EXPECT_DOUBLE_EQ(10.0, openAL->CullDistance());
+  openAL->QueueSinkUpdate(sink, ignition::math::Pose3d(100, 0, 0, 0, 0, 0),
+      ignition::math::Vector3d::Zero);
+  openAL->Flush();
+  EXPECT_TRUE(source->IsCulled());
+  EXPECT_TRUE(source->IsPlaying());
+
+  openAL->QueueSinkUpdate(sink, ignition::math::Pose3d::Zero,
+      ignition::math::Vector3d::Zero);
+  openAL->Flush();
+  EXPECT_FALSE(source->IsCulled());
+  EXPECT_TRUE(source->IsPlaying());
+
+  // A source moving away is culled as well
+  openAL->QueueSourceUpdate(source, ignition::math::Pose3d(0, 20, 0, 0, 0, 0),
+      ignition::math::Vector3d::Zero);
+  openAL->QueuePlay(source);
+  openAL->Flush();
+  EXPECT_TRUE(source->IsCulled());
+
+  openAL->SetCullDistance(0);
+  ASSERT_NO_THROW(openAL->Fini());
+}
 #endif
 
 /////////////////////////////////////////////////
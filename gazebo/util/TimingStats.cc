@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef _MSC_VER
+  #include <intrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/util/TimingStatsPrivate.hh"
+#include "gazebo/util/TimingStats.hh"
+
+using namespace gazebo;
+using namespace util;
+
+const unsigned int TimingHistogram::kBucketCount;
+const unsigned int TimingStats::kMaxStages;
+
+/// \brief Counters of the calling thread, registered on first use.
+static thread_local ThreadCounters *threadCounters = nullptr;
+
+/// \brief Get the index of the highest set bit.
+/// \param[in] _value Non-zero value.
+/// \return Index between 0 and 63.
+static unsigned int HighestBit(const uint64_t _value)
+{
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanReverse64(&index, _value);
+  return static_cast<unsigned int>(index);
+#else
+  return 63u - static_cast<unsigned int>(__builtin_clzll(_value));
+#endif
+}
+
+//////////////////////////////////////////////////
+TimingHistogram::TimingHistogram()
+  : buckets(kBucketCount, 0)
+{
+}
+
+//////////////////////////////////////////////////
+void TimingHistogram::Add(const uint64_t _ns, const uint64_t _count)
+{
+  this->buckets[Bucket(_ns)] += _count;
+  this->sum += _ns * _count;
+  this->count += _count;
+}
+
+//////////////////////////////////////////////////
+uint64_t TimingHistogram::Count() const
+{
+  return this->count;
+}
+
+//////////////////////////////////////////////////
+uint64_t TimingHistogram::Sum() const
+{
+  return this->sum;
+}
+
+//////////////////////////////////////////////////
+uint64_t TimingHistogram::Percentile(const double _q) const
+{
+  if (this->count == 0)
+    return 0;
+
+  // Rank of the sample holding the percentile, between 1 and count.
+  const double rank = std::ceil(std::min(std::max(_q, 0.0), 1.0) *
+      static_cast<double>(this->count));
+  const uint64_t target = std::max(static_cast<uint64_t>(rank), uint64_t(1));
+
+  uint64_t seen = 0;
+  for (unsigned int i = 0; i < kBucketCount; ++i)
+  {
+    seen += this->buckets[i];
+    if (seen >= target)
+      return BucketUpperBound(i);
+  }
+  return BucketUpperBound(kBucketCount - 1);
+}
+
+//////////////////////////////////////////////////
+uint64_t TimingHistogram::BucketValue(const unsigned int _bucket) const
+{
+  if (_bucket >= kBucketCount)
+    return 0;
+  return this->buckets[_bucket];
+}
+
+//////////////////////////////////////////////////
+unsigned int TimingHistogram::Bucket(const uint64_t _ns)
+{
+  if (_ns < 8)
+    return static_cast<unsigned int>(_ns);
+
+  // The 3 bits below the highest set bit select one of 8 sub-buckets.
+  const unsigned int exponent = HighestBit(_ns);
+  const unsigned int sub =
+    static_cast<unsigned int>(_ns >> (exponent - 3)) & 7u;
+  return (exponent - 2) * 8 + sub;
+}
+
+//////////////////////////////////////////////////
+uint64_t TimingHistogram::BucketUpperBound(const unsigned int _bucket)
+{
+  if (_bucket < 8)
+    return _bucket;
+
+  const unsigned int bucket = std::min(_bucket, kBucketCount - 1);
+  const unsigned int shift = bucket / 8 - 1;
+  const uint64_t lower = static_cast<uint64_t>(8 + bucket % 8) << shift;
+  return lower + ((uint64_t(1) << shift) - 1);
+}
+
+//////////////////////////////////////////////////
+TimingHistogram &TimingHistogram::operator+=(const TimingHistogram &_other)
+{
+  for (unsigned int i = 0; i < kBucketCount; ++i)
+    this->buckets[i] += _other.buckets[i];
+  this->sum += _other.sum;
+  this->count += _other.count;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+TimingHistogram &TimingHistogram::operator-=(const TimingHistogram &_older)
+{
+  for (unsigned int i = 0; i < kBucketCount; ++i)
+  {
+    this->buckets[i] -= std::min(this->buckets[i], _older.buckets[i]);
+  }
+  this->sum -= std::min(this->sum, _older.sum);
+  this->count -= std::min(this->count, _older.count);
+  return *this;
+}
+
+//////////////////////////////////////////////////
+TimingStats::TimingStats()
+  : dataPtr(new TimingStatsPrivate)
+{
+  this->dataPtr->previousTime = std::chrono::steady_clock::now();
+}
+
+//////////////////////////////////////////////////
+TimingStats::~TimingStats()
+{
+}
+
+//////////////////////////////////////////////////
+unsigned int TimingStats::Stage(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto iter = std::find(this->dataPtr->names.begin(),
+      this->dataPtr->names.end(), _name);
+  if (iter != this->dataPtr->names.end())
+    return static_cast<unsigned int>(iter - this->dataPtr->names.begin());
+
+  if (this->dataPtr->names.size() >= kMaxStages)
+  {
+    gzerr << "Too many timing stages, [" << _name << "] is not recorded"
+      << std::endl;
+    return kMaxStages;
+  }
+
+  this->dataPtr->names.push_back(_name);
+  return static_cast<unsigned int>(this->dataPtr->names.size() - 1);
+}
+
+//////////////////////////////////////////////////
+void TimingStats::Record(const unsigned int _stage, const uint64_t _ns)
+{
+  if (_stage >= kMaxStages)
+    return;
+
+  if (!threadCounters)
+  {
+    std::unique_ptr<ThreadCounters> counters(new ThreadCounters);
+    threadCounters = counters.get();
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->threads.push_back(std::move(counters));
+  }
+
+  StageCounters *stage =
+    threadCounters->stages[_stage].load(std::memory_order_relaxed);
+  if (!stage)
+  {
+    stage = new StageCounters;
+    threadCounters->stages[_stage].store(stage, std::memory_order_release);
+  }
+
+  // Only this thread writes the counters, readers may lag by a sample.
+  auto &bucket = stage->buckets[TimingHistogram::Bucket(_ns)];
+  bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+      std::memory_order_relaxed);
+  stage->sum.store(stage->sum.load(std::memory_order_relaxed) + _ns,
+      std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> TimingStats::StageNames() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->names;
+}
+
+//////////////////////////////////////////////////
+TimingHistogram TimingStats::Histogram(const unsigned int _stage) const
+{
+  TimingHistogram result;
+  if (_stage >= kMaxStages)
+    return result;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto const &thread : this->dataPtr->threads)
+  {
+    const StageCounters *stage =
+      thread->stages[_stage].load(std::memory_order_acquire);
+    if (!stage)
+      continue;
+
+    for (unsigned int i = 0; i < TimingHistogram::kBucketCount; ++i)
+    {
+      const uint64_t value =
+        stage->buckets[i].load(std::memory_order_relaxed);
+      result.buckets[i] += value;
+      result.count += value;
+    }
+    result.sum += stage->sum.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+void TimingStats::FillMsg(msgs::TimingStatistics &_msg)
+{
+  const std::vector<std::string> names = this->StageNames();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->fillMutex);
+
+  const auto now = std::chrono::steady_clock::now();
+  _msg.set_interval(std::chrono::duration<double>(
+        now - this->dataPtr->previousTime).count());
+  this->dataPtr->previousTime = now;
+  this->dataPtr->previous.resize(names.size());
+  _msg.clear_stage();
+
+  for (unsigned int i = 0; i < names.size(); ++i)
+  {
+    TimingHistogram total = this->Histogram(i);
+    TimingHistogram interval = total;
+    interval -= this->dataPtr->previous[i];
+    this->dataPtr->previous[i] = total;
+
+    if (total.Count() == 0)
+      continue;
+
+    auto stage = _msg.add_stage();
+    stage->set_name(names[i]);
+    stage->set_count(total.Count());
+    stage->set_total(total.Sum() * 1e-9);
+    stage->set_interval_count(interval.Count());
+
+    if (interval.Count() == 0)
+      continue;
+
+    stage->set_mean(interval.Sum() * 1e-9 / interval.Count());
+    stage->set_p50(interval.Percentile(0.5) * 1e-9);
+    stage->set_p90(interval.Percentile(0.9) * 1e-9);
+    stage->set_p99(interval.Percentile(0.99) * 1e-9);
+    stage->set_p999(interval.Percentile(0.999) * 1e-9);
+    stage->set_max(interval.Percentile(1.0) * 1e-9);
+  }
+}
+
+//////////////////////////////////////////////////
+StageTimer::StageTimer()
+  : start(std::chrono::steady_clock::now())
+{
+}
+
+//////////////////////////////////////////////////
+void StageTimer::Lap(const unsigned int _stage)
+{
+  const auto now = std::chrono::steady_clock::now();
+  TimingStats::Instance()->Record(_stage, static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          now - this->start).count()));
+  this->start = now;
+}
+
+//////////////////////////////////////////////////
+void StageTimer::Restart()
+{
+  this->start = std::chrono::steady_clock::now();
+}
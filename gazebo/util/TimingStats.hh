@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_TIMINGSTATS_HH_
+#define GAZEBO_UTIL_TIMINGSTATS_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/msgs/timing_stats.pb.h"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_UTIL_VISIBLE, gazebo, util, TimingStats)
+
+namespace gazebo
+{
+  namespace util
+  {
+    // Forward declare private data class
+    class TimingStatsPrivate;
+
+    /// \addtogroup gazebo_util
+    /// \{
+
+    /// \class TimingHistogram TimingStats.hh util/util.hh
+    /// \brief Histogram of durations in nanoseconds. Values below 8 ns have
+    /// their own bucket, larger values are split in 8 buckets per power of
+    /// two, so a bucket is at most 12.5% wider than its lower bound.
+    class GZ_UTIL_VISIBLE TimingHistogram
+    {
+      /// \brief Number of buckets, enough for any 64 bit value.
+      public: static const unsigned int kBucketCount = 496;
+
+      /// \brief Constructor, all buckets are empty.
+      public: TimingHistogram();
+
+      /// \brief Add samples.
+      /// \param[in] _ns Duration in nanoseconds.
+      /// \param[in] _count Number of samples of this duration.
+      public: void Add(const uint64_t _ns, const uint64_t _count = 1);
+
+      /// \brief Get the number of samples.
+      /// \return Number of samples.
+      public: uint64_t Count() const;
+
+      /// \brief Get the sum of the samples.
+      /// \return Sum in nanoseconds.
+      public: uint64_t Sum() const;
+
+      /// \brief Get a percentile of the samples.
+      /// \param[in] _q Quantile between 0 and 1, e.g. 0.99.
+      /// \return Upper bound of the bucket holding the percentile, in
+      /// nanoseconds. Zero if there are no samples.
+      public: uint64_t Percentile(const double _q) const;
+
+      /// \brief Get the number of samples in a bucket.
+      /// \param[in] _bucket Bucket index, less than kBucketCount.
+      /// \return Number of samples.
+      public: uint64_t BucketValue(const unsigned int _bucket) const;
+
+      /// \brief Get the bucket of a duration.
+      /// \param[in] _ns Duration in nanoseconds.
+      /// \return Bucket index.
+      public: static unsigned int Bucket(const uint64_t _ns);
+
+      /// \brief Get the largest duration of a bucket.
+      /// \param[in] _bucket Bucket index, less than kBucketCount.
+      /// \return Duration in nanoseconds.
+      public: static uint64_t BucketUpperBound(const unsigned int _bucket);
+
+      /// \brief Add the samples of another histogram.
+      /// \param[in] _other Histogram to add.
+      /// \return Reference to this histogram.
+      public: TimingHistogram &operator+=(const TimingHistogram &_other);
+
+      /// \brief Remove the samples of an older copy of this histogram,
+      /// leaving the samples added since then.
+      /// \param[in] _older Histogram to remove.
+      /// \return Reference to this histogram.
+      public: TimingHistogram &operator-=(const TimingHistogram &_older);
+
+      /// \brief TimingStats fills histograms from its counters.
+      private: friend class TimingStats;
+
+      /// \brief Number of samples per bucket.
+      private: std::vector<uint64_t> buckets;
+
+      /// \brief Sum of the samples in nanoseconds.
+      private: uint64_t sum = 0;
+
+      /// \brief Number of samples.
+      private: uint64_t count = 0;
+    };
+
+    /// \class TimingStats TimingStats.hh util/util.hh
+    /// \brief Always on histograms of the durations of named stages, such
+    /// as the phases of World::Update and the sensor updates.
+    ///
+    /// Unlike DiagnosticManager, timings are kept whatever the build flags,
+    /// and are not written to disk. Each thread records into its own
+    /// counters without locking, histograms are merged when read.
+    class GZ_UTIL_VISIBLE TimingStats : public SingletonT<TimingStats>
+    {
+      /// \brief Maximum number of stages.
+      public: static const unsigned int kMaxStages = 128;
+
+      /// \brief Get the id of a stage, registering it on first use.
+      /// Call it once and keep the id, e.g. when loading.
+      /// \param[in] _name Name of the stage.
+      /// \return Stage id, kMaxStages if too many stages were registered.
+      public: unsigned int Stage(const std::string &_name);
+
+      /// \brief Record a duration. Does not lock.
+      /// \param[in] _stage Stage id returned by Stage.
+      /// \param[in] _ns Duration in nanoseconds.
+      public: void Record(const unsigned int _stage, const uint64_t _ns);
+
+      /// \brief Get the names of the registered stages.
+      /// \return Names, indexed by stage id.
+      public: std::vector<std::string> StageNames() const;
+
+      /// \brief Get the durations recorded for a stage by all threads since
+      /// the server started.
+      /// \param[in] _stage Stage id.
+      /// \return Merged histogram.
+      public: TimingHistogram Histogram(const unsigned int _stage) const;
+
+      /// \brief Fill a message with the totals of every stage, and with the
+      /// statistics of the durations recorded since the previous call.
+      /// \param[out] _msg Message to fill, sim_time is not set.
+      public: void FillMsg(msgs::TimingStatistics &_msg);
+
+      /// \brief Constructor.
+      private: TimingStats();
+
+      /// \brief Destructor.
+      private: virtual ~TimingStats();
+
+      /// \brief This is a singleton.
+      private: friend class SingletonT<TimingStats>;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<TimingStatsPrivate> dataPtr;
+    };
+
+    /// \class StageTimer TimingStats.hh util/util.hh
+    /// \brief Records the time between laps in TimingStats, like
+    /// DIAG_TIMER_LAP does for DiagnosticManager.
+    class GZ_UTIL_VISIBLE StageTimer
+    {
+      /// \brief Constructor, starts the first lap.
+      public: StageTimer();
+
+      /// \brief Record the time since the previous lap, or since the
+      /// timer was created, and start a new lap.
+      /// \param[in] _stage Stage id returned by TimingStats::Stage.
+      public: void Lap(const unsigned int _stage);
+
+      /// \brief Start a new lap without recording the current one.
+      public: void Restart();
+
+      /// \brief Start of the current lap.
+      private: std::chrono::steady_clock::time_point start;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_TIMINGSTATSPRIVATE_HH_
+#define GAZEBO_UTIL_TIMINGSTATSPRIVATE_HH_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gazebo/util/TimingStats.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \brief Counters of one stage in one thread. Only the owning thread
+    /// writes them, so increments do not need atomic read-modify-writes.
+    class StageCounters
+    {
+      /// \brief Constructor, all counters are zero.
+      public: StageCounters()
+      {
+        for (auto &bucket : this->buckets)
+          bucket.store(0, std::memory_order_relaxed);
+      }
+
+      /// \brief Number of samples per bucket.
+      public: std::atomic<uint64_t> buckets[TimingHistogram::kBucketCount];
+
+      /// \brief Sum of the samples in nanoseconds.
+      public: std::atomic<uint64_t> sum{0};
+    };
+
+    /// \brief Counters of all stages in one thread, allocated on first use.
+    class ThreadCounters
+    {
+      /// \brief Constructor.
+      public: ThreadCounters()
+      {
+        for (auto &stage : this->stages)
+          stage.store(nullptr, std::memory_order_relaxed);
+      }
+
+      /// \brief Destructor.
+      public: ~ThreadCounters()
+      {
+        for (auto &stage : this->stages)
+          delete stage.load();
+      }
+
+      /// \brief Counters of each stage, null until the thread records it.
+      public: std::atomic<StageCounters *> stages[TimingStats::kMaxStages];
+    };
+
+    /// \brief Private data for the TimingStats class.
+    class TimingStatsPrivate
+    {
+      /// \brief Protects names and threads.
+      public: mutable std::mutex mutex;
+
+      /// \brief Names of the registered stages, indexed by stage id.
+      public: std::vector<std::string> names;
+
+      /// \brief Counters of every thread that recorded a duration. They
+      /// are kept after the thread exits so totals never decrease.
+      public: std::vector<std::unique_ptr<ThreadCounters>> threads;
+
+      /// \brief Protects previous and previousTime.
+      public: std::mutex fillMutex;
+
+      /// \brief Histograms at the previous call to FillMsg.
+      public: std::vector<TimingHistogram> previous;
+
+      /// \brief Time of the previous call to FillMsg.
+      public: std::chrono::steady_clock::time_point previousTime;
+    };
+  }
+}
+#endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "gazebo/util/TimingStats.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TimingStatsTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(TimingStatsTest, Buckets)
+{
+  // Small values are exact
+  for (uint64_t i = 0; i < 16; ++i)
+  {
+    EXPECT_EQ(i, util::TimingHistogram::BucketUpperBound(
+          util::TimingHistogram::Bucket(i)));
+  }
+
+  // Every value is at most 12.5% below the bound of its bucket
+  for (uint64_t value : {17ull, 100ull, 1000ull, 123456ull, 1000000007ull,
+      0xffffffffffffffffull})
+  {
+    const unsigned int bucket = util::TimingHistogram::Bucket(value);
+    EXPECT_LT(bucket, util::TimingHistogram::kBucketCount);
+
+    const uint64_t bound = util::TimingHistogram::BucketUpperBound(bucket);
+    EXPECT_GE(bound, value);
+    EXPECT_LE(bound - value, value / 8);
+  }
+
+  // Buckets are ordered
+  for (unsigned int i = 1; i < util::TimingHistogram::kBucketCount; ++i)
+  {
+    EXPECT_LT(util::TimingHistogram::BucketUpperBound(i - 1),
+        util::TimingHistogram::BucketUpperBound(i));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(TimingStatsTest, Histogram)
+{
+  util::TimingHistogram histogram;
+  EXPECT_EQ(0u, histogram.Count());
+  EXPECT_EQ(0u, histogram.Percentile(0.5));
+
+  for (uint64_t i = 1; i <= 1000; ++i)
+    histogram.Add(i * 1000);
+
+  EXPECT_EQ(1000u, histogram.Count());
+  EXPECT_EQ(500500000u, histogram.Sum());
+  EXPECT_NEAR(500000.0, histogram.Percentile(0.5), 500000.0 / 8);
+  EXPECT_NEAR(990000.0, histogram.Percentile(0.99), 990000.0 / 8);
+  EXPECT_GE(histogram.Percentile(1.0), 1000000u);
+
+  util::TimingHistogram older = histogram;
+  histogram.Add(5, 10);
+  histogram -= older;
+  EXPECT_EQ(10u, histogram.Count());
+  EXPECT_EQ(50u, histogram.Sum());
+  EXPECT_EQ(5u, histogram.Percentile(0.5));
+
+  histogram += older;
+  EXPECT_EQ(1010u, histogram.Count());
+}
+
+/////////////////////////////////////////////////
+TEST_F(TimingStatsTest, Record)
+{
+  util::TimingStats *stats = util::TimingStats::Instance();
+  ASSERT_TRUE(stats != nullptr);
+
+  const unsigned int stage = stats->Stage("test/record");
+  EXPECT_LT(stage, util::TimingStats::kMaxStages);
+  EXPECT_EQ(stage, stats->Stage("test/record"));
+  EXPECT_EQ("test/record", stats->StageNames()[stage]);
+
+  // Invalid stages are ignored
+  stats->Record(util::TimingStats::kMaxStages, 1);
+
+  // Histograms merge the samples of every thread
+  stats->Record(stage, 1000);
+  std::thread thread([&]()
+      {
+        for (int i = 0; i < 99; ++i)
+          stats->Record(stage, 2000);
+      });
+  thread.join();
+
+  util::TimingHistogram histogram = stats->Histogram(stage);
+  EXPECT_EQ(100u, histogram.Count());
+  EXPECT_EQ(199000u, histogram.Sum());
+
+  // The message covers the samples since the previous one
+  msgs::TimingStatistics msg;
+  stats->FillMsg(msg);
+  EXPECT_GE(msg.interval(), 0.0);
+
+  stats->Record(stage, 4000);
+  stats->FillMsg(msg);
+
+  bool found = false;
+  for (int i = 0; i < msg.stage_size(); ++i)
+  {
+    if (msg.stage(i).name() != "test/record")
+      continue;
+    found = true;
+    EXPECT_EQ(101u, msg.stage(i).count());
+    EXPECT_EQ(1u, msg.stage(i).interval_count());
+    EXPECT_NEAR(4e-6, msg.stage(i).p50(), 4e-6 / 8);
+  }
+  EXPECT_TRUE(found);
+
+  // Laps are recorded
+  util::StageTimer timer;
+  timer.Lap(stage);
+  EXPECT_EQ(102u, stats->Histogram(stage).Count());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
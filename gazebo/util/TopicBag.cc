@@ -0,0 +1,417 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/util/TopicBagPrivate.hh"
+#include "gazebo/util/TopicBag.hh"
+
+using namespace gazebo;
+using namespace util;
+
+/////////////////////////////////////////////////
+/// \brief Append a record to a bag.
+/// \param[in] _file Bag file.
+/// \param[in] _header Record header, its size is the size of _data.
+/// \param[in] _data Record data.
+/// \return Size of the record, padding included.
+static uint64_t WriteRecord(std::ofstream &_file,
+    const topicbag::RecordHeader &_header, const std::string &_data)
+{
+  static const char padding[topicbag::kAlignment] = {0};
+
+  const uint64_t size = topicbag::RecordSize(_data.size());
+  _file.write(reinterpret_cast<const char *>(&_header), sizeof(_header));
+  _file.write(_data.data(), _data.size());
+  _file.write(padding, size - sizeof(_header) - _data.size());
+  return size;
+}
+
+/////////////////////////////////////////////////
+/// \brief Append the record of a topic to a bag.
+/// \param[in] _file Bag file.
+/// \param[in] _topic Topic.
+/// \param[in] _stamp Time of the record.
+/// \return Size of the record, padding included.
+static uint64_t WriteTopicRecord(std::ofstream &_file,
+    const TopicBagTopic &_topic, const common::Time &_stamp)
+{
+  std::string data = _topic.name;
+  data.push_back('\0');
+  data += _topic.type;
+  data.push_back('\0');
+
+  topicbag::RecordHeader header;
+  header.sec = _stamp.sec;
+  header.nsec = _stamp.nsec;
+  header.topic = topicbag::kTopicRecord;
+  header.size = static_cast<uint32_t>(data.size());
+  return WriteRecord(_file, header, data);
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the record of a topic.
+/// \param[in] _data Record data.
+/// \param[in] _size Size of the data.
+/// \return The topic.
+static TopicBagTopic ReadTopicRecord(const char *_data, const uint32_t _size)
+{
+  const char *end = _data + _size;
+  const char *nameEnd = std::find(_data, end, '\0');
+
+  TopicBagTopic topic;
+  topic.name.assign(_data, nameEnd);
+  if (nameEnd < end)
+    topic.type.assign(nameEnd + 1, std::find(nameEnd + 1, end, '\0'));
+  return topic;
+}
+
+/////////////////////////////////////////////////
+TopicBagWriter::TopicBagWriter()
+  : dataPtr(new TopicBagWriterPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+TopicBagWriter::~TopicBagWriter()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool TopicBagWriter::Open(const std::string &_filename)
+{
+  this->Close();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->file.open(_filename.c_str(),
+      std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!this->dataPtr->file.is_open())
+  {
+    gzerr << "Unable to create topic bag[" << _filename << "]\n";
+    return false;
+  }
+
+  topicbag::FileHeader header;
+  std::memcpy(header.magic, topicbag::kMagic, sizeof(header.magic));
+  header.version = topicbag::kVersion;
+  header.reserved = 0;
+  this->dataPtr->file.write(reinterpret_cast<const char *>(&header),
+      sizeof(header));
+
+  this->dataPtr->offset = sizeof(header);
+  this->dataPtr->topics.clear();
+  this->dataPtr->index.clear();
+  this->dataPtr->lastStamp = common::Time::Zero;
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint32_t TopicBagWriter::AddTopic(const std::string &_name,
+    const std::string &_type)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  TopicBagTopic topic;
+  topic.name = _name;
+  topic.type = _type;
+  if (this->dataPtr->file.is_open())
+  {
+    this->dataPtr->offset += WriteTopicRecord(this->dataPtr->file, topic,
+        this->dataPtr->lastStamp);
+  }
+
+  this->dataPtr->topics.push_back(topic);
+  return static_cast<uint32_t>(this->dataPtr->topics.size() - 1);
+}
+
+/////////////////////////////////////////////////
+bool TopicBagWriter::Write(const uint32_t _topic, const common::Time &_stamp,
+    const std::string &_data)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->file.is_open() ||
+      _topic >= this->dataPtr->topics.size())
+  {
+    return false;
+  }
+
+  this->dataPtr->lastStamp = std::max(this->dataPtr->lastStamp, _stamp);
+
+  topicbag::RecordHeader header;
+  header.sec = this->dataPtr->lastStamp.sec;
+  header.nsec = this->dataPtr->lastStamp.nsec;
+  header.topic = _topic;
+  header.size = static_cast<uint32_t>(_data.size());
+
+  this->dataPtr->index.push_back(this->dataPtr->offset);
+  this->dataPtr->offset += WriteRecord(this->dataPtr->file, header, _data);
+  return static_cast<bool>(this->dataPtr->file);
+}
+
+/////////////////////////////////////////////////
+uint64_t TopicBagWriter::FrameCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->index.size();
+}
+
+/////////////////////////////////////////////////
+bool TopicBagWriter::Close()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->file.is_open())
+    return true;
+
+  // The topics are repeated at the end, so that a reader finds them
+  // without scanning the messages
+  topicbag::Footer footer;
+  footer.topicsOffset = this->dataPtr->offset;
+  for (const auto &topic : this->dataPtr->topics)
+  {
+    this->dataPtr->offset += WriteTopicRecord(this->dataPtr->file, topic,
+        this->dataPtr->lastStamp);
+  }
+  footer.indexOffset = this->dataPtr->offset;
+  footer.count = this->dataPtr->index.size();
+  std::memcpy(footer.magic, topicbag::kIndexMagic, sizeof(footer.magic));
+
+  this->dataPtr->file.write(
+      reinterpret_cast<const char *>(this->dataPtr->index.data()),
+      this->dataPtr->index.size() * sizeof(uint64_t));
+  this->dataPtr->file.write(reinterpret_cast<const char *>(&footer),
+      sizeof(footer));
+
+  const bool result = static_cast<bool>(this->dataPtr->file);
+  this->dataPtr->file.close();
+  this->dataPtr->index.clear();
+  return result;
+}
+
+/////////////////////////////////////////////////
+TopicBagReader::TopicBagReader()
+  : dataPtr(new TopicBagReaderPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+TopicBagReader::~TopicBagReader()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool TopicBagReader::Open(const std::string &_filename)
+{
+  this->Close();
+
+#ifndef _WIN32
+  const int fd = open(_filename.c_str(), O_RDONLY);
+  struct stat info;
+  if (fd < 0 || fstat(fd, &info) != 0)
+  {
+    if (fd >= 0)
+      close(fd);
+    gzerr << "Unable to open topic bag[" << _filename << "]\n";
+    return false;
+  }
+
+  if (info.st_size > 0)
+  {
+    void *data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED)
+    {
+      this->dataPtr->data = static_cast<const char *>(data);
+      this->dataPtr->size = info.st_size;
+    }
+  }
+  close(fd);
+#endif
+
+  // Read the bag in memory where it can't be mapped
+  if (!this->dataPtr->data)
+  {
+    std::ifstream in(_filename.c_str(), std::ios::in | std::ios::binary);
+    if (!in)
+    {
+      gzerr << "Unable to open topic bag[" << _filename << "]\n";
+      return false;
+    }
+    this->dataPtr->buffer.assign(std::istreambuf_iterator<char>(in),
+        std::istreambuf_iterator<char>());
+    this->dataPtr->data = this->dataPtr->buffer.data();
+    this->dataPtr->size = this->dataPtr->buffer.size();
+  }
+
+  const char *data = this->dataPtr->data;
+  const uint64_t size = this->dataPtr->size;
+
+  topicbag::FileHeader header;
+  if (size < sizeof(header))
+  {
+    gzerr << "File[" << _filename << "] is not a topic bag\n";
+    this->Close();
+    return false;
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, topicbag::kMagic, sizeof(header.magic)) != 0 ||
+      header.version != topicbag::kVersion)
+  {
+    gzerr << "File[" << _filename << "] is not a topic bag of version "
+          << topicbag::kVersion << "\n";
+    this->Close();
+    return false;
+  }
+
+  // A closed bag ends with the topics, the index and the footer
+  topicbag::Footer footer;
+  bool indexed = false;
+  if (size >= sizeof(header) + sizeof(footer))
+  {
+    std::memcpy(&footer, data + size - sizeof(footer), sizeof(footer));
+    indexed =
+      std::memcmp(footer.magic, topicbag::kIndexMagic,
+          sizeof(footer.magic)) == 0 &&
+      footer.topicsOffset >= sizeof(header) &&
+      footer.indexOffset >= footer.topicsOffset &&
+      footer.count <= size / sizeof(uint64_t) &&
+      footer.indexOffset + footer.count * sizeof(uint64_t) + sizeof(footer) ==
+      size;
+  }
+
+  // Scan the records, only the topics of a closed bag, and everything in a
+  // bag that was not closed. A truncated record ends the scan.
+  uint64_t offset = indexed ? footer.topicsOffset : sizeof(header);
+  const uint64_t end = indexed ? footer.indexOffset : size;
+  const uint64_t messagesEnd = indexed ? footer.topicsOffset : size;
+  while (offset + sizeof(topicbag::RecordHeader) <= end)
+  {
+    topicbag::RecordHeader record;
+    std::memcpy(&record, data + offset, sizeof(record));
+    const uint64_t recordSize = topicbag::RecordSize(record.size);
+    if (offset + recordSize > end)
+      break;
+
+    if (record.topic == topicbag::kTopicRecord)
+    {
+      this->dataPtr->topics.push_back(
+          ReadTopicRecord(data + offset + sizeof(record), record.size));
+    }
+    else if (!indexed)
+    {
+      this->dataPtr->index.push_back(offset);
+    }
+    offset += recordSize;
+  }
+
+  if (indexed)
+  {
+    this->dataPtr->index.resize(footer.count);
+    std::memcpy(this->dataPtr->index.data(), data + footer.indexOffset,
+        footer.count * sizeof(uint64_t));
+
+    // Drop the entries outside of the messages
+    this->dataPtr->index.erase(std::remove_if(this->dataPtr->index.begin(),
+          this->dataPtr->index.end(), [messagesEnd](const uint64_t _offset)
+          {
+            return _offset + sizeof(topicbag::RecordHeader) > messagesEnd;
+          }), this->dataPtr->index.end());
+  }
+  else
+  {
+    gzwarn << "Topic bag[" << _filename << "] has no index, it was not "
+           << "closed properly. " << this->dataPtr->index.size()
+           << " messages were recovered.\n";
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TopicBagReader::Close()
+{
+#ifndef _WIN32
+  if (this->dataPtr->data && this->dataPtr->buffer.empty())
+  {
+    munmap(const_cast<char *>(this->dataPtr->data), this->dataPtr->size);
+  }
+#endif
+  this->dataPtr->data = nullptr;
+  this->dataPtr->size = 0;
+  this->dataPtr->buffer.clear();
+  this->dataPtr->topics.clear();
+  this->dataPtr->index.clear();
+}
+
+/////////////////////////////////////////////////
+const std::vector<TopicBagTopic> &TopicBagReader::Topics() const
+{
+  return this->dataPtr->topics;
+}
+
+/////////////////////////////////////////////////
+uint64_t TopicBagReader::FrameCount() const
+{
+  return this->dataPtr->index.size();
+}
+
+/////////////////////////////////////////////////
+bool TopicBagReader::Frame(const uint64_t _index, TopicBagFrame &_frame) const
+{
+  if (_index >= this->dataPtr->index.size())
+    return false;
+
+  const uint64_t offset = this->dataPtr->index[_index];
+  if (offset + sizeof(topicbag::RecordHeader) > this->dataPtr->size)
+    return false;
+
+  topicbag::RecordHeader record;
+  std::memcpy(&record, this->dataPtr->data + offset, sizeof(record));
+  if (offset + sizeof(record) + record.size > this->dataPtr->size)
+    return false;
+
+  _frame.topic = record.topic;
+  _frame.stamp.Set(record.sec, record.nsec);
+  _frame.data = this->dataPtr->data + offset + sizeof(record);
+  _frame.size = record.size;
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint64_t TopicBagReader::FrameAt(const common::Time &_stamp) const
+{
+  // The times never decrease, see TopicBagWriter::Write
+  auto iter = std::lower_bound(this->dataPtr->index.begin(),
+      this->dataPtr->index.end(), _stamp,
+      [this](const uint64_t _offset, const common::Time &_time)
+      {
+        topicbag::RecordHeader record;
+        std::memcpy(&record, this->dataPtr->data + _offset, sizeof(record));
+        return common::Time(record.sec, record.nsec) < _time;
+      });
+  return iter - this->dataPtr->index.begin();
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_TOPICBAG_HH_
+#define GAZEBO_UTIL_TOPICBAG_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    // Forward declare private data classes
+    class TopicBagReaderPrivate;
+    class TopicBagWriterPrivate;
+
+    /// \addtogroup gazebo_util
+    /// \{
+
+    /// \brief A topic recorded in a bag.
+    class GZ_UTIL_VISIBLE TopicBagTopic
+    {
+      /// \brief Fully qualified topic name.
+      public: std::string name;
+
+      /// \brief Message type name.
+      public: std::string type;
+    };
+
+    /// \brief A message recorded in a bag. The data points into the bag,
+    /// and is valid until the reader is closed.
+    class GZ_UTIL_VISIBLE TopicBagFrame
+    {
+      /// \brief Index of the topic in TopicBagReader::Topics.
+      public: uint32_t topic = 0;
+
+      /// \brief Time the message was received.
+      public: common::Time stamp;
+
+      /// \brief Serialized message.
+      public: const char *data = nullptr;
+
+      /// \brief Number of bytes of the serialized message.
+      public: uint32_t size = 0;
+    };
+
+    /// \class TopicBagWriter TopicBag.hh util/util.hh
+    /// \brief Records serialized transport messages with their receive time
+    /// in a binary bag file.
+    ///
+    /// A bag starts with a magic string and the format version, followed
+    /// by records: each one a header with the time, topic and size, and the
+    /// bytes padded to 8 bytes. Topics are records too, so that a bag not
+    /// closed properly can be read by scanning it. Closing the bag appends
+    /// the index of the messages and a footer, which let a reader map the
+    /// file and access any message without parsing the file.
+    class GZ_UTIL_VISIBLE TopicBagWriter
+    {
+      /// \brief Constructor.
+      public: TopicBagWriter();
+
+      /// \brief Destructor, closes the bag.
+      public: ~TopicBagWriter();
+
+      /// \brief Create a bag, replacing an existing file.
+      /// \param[in] _filename Path of the bag.
+      /// \return False if the file can't be created.
+      public: bool Open(const std::string &_filename);
+
+      /// \brief Add a topic.
+      /// \param[in] _name Fully qualified topic name.
+      /// \param[in] _type Message type name.
+      /// \return Index of the topic, used by Write.
+      public: uint32_t AddTopic(const std::string &_name,
+                  const std::string &_type);
+
+      /// \brief Record a message. Safe to call from several threads.
+      /// \param[in] _topic Index returned by AddTopic.
+      /// \param[in] _stamp Time the message was received. A time earlier
+      /// than the one of the previous message is replaced by the latter, so
+      /// that the times never decrease.
+      /// \param[in] _data Serialized message.
+      /// \return False if the bag is not open or the topic is unknown.
+      public: bool Write(const uint32_t _topic, const common::Time &_stamp,
+                  const std::string &_data);
+
+      /// \brief Get the number of recorded messages.
+      /// \return Number of messages.
+      public: uint64_t FrameCount() const;
+
+      /// \brief Write the index and close the bag.
+      /// \return False if the bag could not be written.
+      public: bool Close();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<TopicBagWriterPrivate> dataPtr;
+    };
+
+    /// \class TopicBagReader TopicBag.hh util/util.hh
+    /// \brief Reads a bag recorded by TopicBagWriter. The file is mapped in
+    /// memory, so messages are accessed without copies.
+    class GZ_UTIL_VISIBLE TopicBagReader
+    {
+      /// \brief Constructor.
+      public: TopicBagReader();
+
+      /// \brief Destructor, closes the bag.
+      public: ~TopicBagReader();
+
+      /// \brief Open a bag. A bag without an index, e.g. because the
+      /// recording was interrupted, is scanned instead.
+      /// \param[in] _filename Path of the bag.
+      /// \return False if the file is not a bag.
+      public: bool Open(const std::string &_filename);
+
+      /// \brief Close the bag. The data of the frames becomes invalid.
+      public: void Close();
+
+      /// \brief Get the recorded topics.
+      /// \return The topics, indexed by TopicBagFrame::topic.
+      public: const std::vector<TopicBagTopic> &Topics() const;
+
+      /// \brief Get the number of recorded messages.
+      /// \return Number of messages.
+      public: uint64_t FrameCount() const;
+
+      /// \brief Get a recorded message.
+      /// \param[in] _index Index of the message, in recording order.
+      /// \param[out] _frame The message.
+      /// \return False if the index is out of range.
+      public: bool Frame(const uint64_t _index, TopicBagFrame &_frame) const;
+
+      /// \brief Find the first message received at or after a time.
+      /// \param[in] _stamp Time.
+      /// \return Index of the message, FrameCount() if there is none.
+      public: uint64_t FrameAt(const common::Time &_stamp) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<TopicBagReaderPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_TOPICBAGPRIVATE_HH_
+#define GAZEBO_UTIL_TOPICBAGPRIVATE_HH_
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gazebo/util/TopicBag.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Layout of topic bags. Integers are stored in host byte order,
+    /// which is little endian on all supported platforms.
+    namespace topicbag
+    {
+      /// \brief Marks the start of a bag.
+      static const char kMagic[8] = {'G', 'Z', 'T', 'O', 'P', 'B', 'A', 'G'};
+
+      /// \brief Marks the end of the index.
+      static const char kIndexMagic[8] =
+          {'G', 'Z', 'B', 'A', 'G', 'I', 'D', 'X'};
+
+      /// \brief Version of the format.
+      static const uint32_t kVersion = 1u;
+
+      /// \brief Topic of the records defining a topic. Their data is the
+      /// topic name and the message type, each followed by a null
+      /// character.
+      static const uint32_t kTopicRecord = 0xffffffffu;
+
+      /// \brief Records are padded to a multiple of this size, so that the
+      /// headers of a mapped bag are aligned.
+      static const uint64_t kAlignment = 8u;
+
+      /// \brief Start of the bag.
+      struct FileHeader
+      {
+        /// \brief Always kMagic.
+        char magic[8];
+
+        /// \brief Always kVersion.
+        uint32_t version;
+
+        /// \brief Unused, keeps the records 8 byte aligned.
+        uint32_t reserved;
+      };
+
+      /// \brief Header written in front of every record.
+      struct RecordHeader
+      {
+        /// \brief Seconds of the receive time.
+        int32_t sec;
+
+        /// \brief Nanoseconds of the receive time.
+        int32_t nsec;
+
+        /// \brief Index of the topic, or kTopicRecord.
+        uint32_t topic;
+
+        /// \brief Number of bytes that follow the header, before padding.
+        uint32_t size;
+      };
+
+      /// \brief Trailer at the very end of a closed bag. It is preceded by
+      /// the records of all the topics, then by the index, which holds the
+      /// uint64 file offset of every message record.
+      struct Footer
+      {
+        /// \brief File offset of the topic records.
+        uint64_t topicsOffset;
+
+        /// \brief File offset of the index.
+        uint64_t indexOffset;
+
+        /// \brief Number of messages.
+        uint64_t count;
+
+        /// \brief Always kIndexMagic.
+        char magic[8];
+      };
+
+      static_assert(sizeof(FileHeader) == 16, "Unexpected FileHeader size");
+      static_assert(sizeof(RecordHeader) == 16,
+          "Unexpected RecordHeader size");
+      static_assert(sizeof(Footer) == 32, "Unexpected Footer size");
+
+      /// \brief Get the size of a record, padding included.
+      /// \param[in] _size Number of bytes after the header.
+      /// \return Size of the record.
+      inline uint64_t RecordSize(const uint64_t _size)
+      {
+        return sizeof(RecordHeader) +
+          (_size + kAlignment - 1) / kAlignment * kAlignment;
+      }
+    }
+
+    /// \internal
+    /// \brief Private data for the TopicBagWriter class.
+    class TopicBagWriterPrivate
+    {
+      /// \brief Bag file.
+      public: std::ofstream file;
+
+      /// \brief Offset of the end of the file.
+      public: uint64_t offset = 0;
+
+      /// \brief Topics.
+      public: std::vector<TopicBagTopic> topics;
+
+      /// \brief Offset of each message record.
+      public: std::vector<uint64_t> index;
+
+      /// \brief Time of the last message.
+      public: common::Time lastStamp;
+
+      /// \brief Protects the members.
+      public: mutable std::mutex mutex;
+    };
+
+    /// \internal
+    /// \brief Private data for the TopicBagReader class.
+    class TopicBagReaderPrivate
+    {
+      /// \brief Start of the bag in memory.
+      public: const char *data = nullptr;
+
+      /// \brief Size of the bag.
+      public: uint64_t size = 0;
+
+      /// \brief Bag read in memory, where it can't be mapped.
+      public: std::string buffer;
+
+      /// \brief Topics.
+      public: std::vector<TopicBagTopic> topics;
+
+      /// \brief Offset of each message record.
+      public: std::vector<uint64_t> index;
+    };
+  }
+}
+#endif
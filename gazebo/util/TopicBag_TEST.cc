@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "gazebo/util/TopicBag.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TopicBag_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Get a temporary file name for a bag.
+/// \return File name.
+static std::string BagFilename()
+{
+  std::ostringstream stream;
+  stream << "/tmp/__gz_topic_bag_test" << std::this_thread::get_id();
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Record a few messages of two topics.
+/// \param[in] _filename Bag file name.
+/// \param[in] _close True to close the bag, false to leave it without an
+/// index.
+static void RecordBag(const std::string &_filename, const bool _close)
+{
+  util::TopicBagWriter writer;
+  ASSERT_TRUE(writer.Open(_filename));
+  const uint32_t pose = writer.AddTopic("/gazebo/default/pose/info",
+      "gazebo.msgs.PosesStamped");
+  EXPECT_EQ(0u, pose);
+
+  EXPECT_TRUE(writer.Write(pose, common::Time(1, 0), "first"));
+  const uint32_t image = writer.AddTopic("/gazebo/default/camera/image",
+      "gazebo.msgs.ImageStamped");
+  EXPECT_EQ(1u, image);
+
+  // Binary data, with a null character
+  EXPECT_TRUE(writer.Write(image, common::Time(1, 500),
+        std::string("ab\0cd", 5)));
+
+  // An earlier time becomes the time of the previous message
+  EXPECT_TRUE(writer.Write(pose, common::Time(0, 900), ""));
+  EXPECT_TRUE(writer.Write(pose, common::Time(2, 0), "last message"));
+  EXPECT_FALSE(writer.Write(5, common::Time(3, 0), "unknown topic"));
+  EXPECT_EQ(4u, writer.FrameCount());
+
+  if (_close)
+  {
+    EXPECT_TRUE(writer.Close());
+  }
+  else
+  {
+    // Drop the writer without writing the index
+    writer.Close();
+    std::ifstream in(_filename, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    in.close();
+
+    // Remove the topics, the index and the footer, whose offset starts the
+    // footer, and cut the last message in half
+    uint64_t topicsOffset;
+    ASSERT_GE(data.size(), 32u);
+    std::memcpy(&topicsOffset, data.data() + data.size() - 32,
+        sizeof(topicsOffset));
+    ASSERT_GT(topicsOffset, 8u);
+    data.resize(topicsOffset - 8);
+    std::ofstream out(_filename, std::ios::binary | std::ios::trunc);
+    out << data;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(TopicBag_TEST, WriteRead)
+{
+  const std::string filename = BagFilename();
+  RecordBag(filename, true);
+
+  util::TopicBagReader reader;
+  ASSERT_TRUE(reader.Open(filename));
+
+  ASSERT_EQ(2u, reader.Topics().size());
+  EXPECT_EQ("/gazebo/default/pose/info", reader.Topics()[0].name);
+  EXPECT_EQ("gazebo.msgs.PosesStamped", reader.Topics()[0].type);
+  EXPECT_EQ("/gazebo/default/camera/image", reader.Topics()[1].name);
+  EXPECT_EQ("gazebo.msgs.ImageStamped", reader.Topics()[1].type);
+
+  ASSERT_EQ(4u, reader.FrameCount());
+  util::TopicBagFrame frame;
+  ASSERT_TRUE(reader.Frame(0, frame));
+  EXPECT_EQ(0u, frame.topic);
+  EXPECT_EQ(common::Time(1, 0), frame.stamp);
+  EXPECT_EQ("first", std::string(frame.data, frame.size));
+
+  ASSERT_TRUE(reader.Frame(1, frame));
+  EXPECT_EQ(1u, frame.topic);
+  EXPECT_EQ(std::string("ab\0cd", 5), std::string(frame.data, frame.size));
+
+  ASSERT_TRUE(reader.Frame(2, frame));
+  EXPECT_EQ(common::Time(1, 500), frame.stamp);
+  EXPECT_EQ(0u, frame.size);
+
+  ASSERT_TRUE(reader.Frame(3, frame));
+  EXPECT_EQ(common::Time(2, 0), frame.stamp);
+  EXPECT_EQ("last message", std::string(frame.data, frame.size));
+  EXPECT_FALSE(reader.Frame(4, frame));
+
+  // Look up by time
+  EXPECT_EQ(0u, reader.FrameAt(common::Time::Zero));
+  EXPECT_EQ(1u, reader.FrameAt(common::Time(1, 1)));
+  EXPECT_EQ(3u, reader.FrameAt(common::Time(1, 501)));
+  EXPECT_EQ(4u, reader.FrameAt(common::Time(5, 0)));
+
+  reader.Close();
+  EXPECT_EQ(0u, reader.FrameCount());
+  boost::filesystem::remove(filename);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TopicBag_TEST, Recover)
+{
+  // A bag without index is scanned, up to its last complete message
+  const std::string filename = BagFilename();
+  RecordBag(filename, false);
+
+  util::TopicBagReader reader;
+  ASSERT_TRUE(reader.Open(filename));
+  EXPECT_EQ(2u, reader.Topics().size());
+  ASSERT_EQ(3u, reader.FrameCount());
+
+  util::TopicBagFrame frame;
+  ASSERT_TRUE(reader.Frame(1, frame));
+  EXPECT_EQ(1u, frame.topic);
+  EXPECT_EQ(std::string("ab\0cd", 5), std::string(frame.data, frame.size));
+  boost::filesystem::remove(filename);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TopicBag_TEST, Invalid)
+{
+  util::TopicBagReader reader;
+  EXPECT_FALSE(reader.Open("/tmp/__gz_topic_bag_missing"));
+
+  const std::string filename = BagFilename();
+  {
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out << "not a topic bag";
+  }
+  EXPECT_FALSE(reader.Open(filename));
+  EXPECT_EQ(0u, reader.FrameCount());
+  boost::filesystem::remove(filename);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
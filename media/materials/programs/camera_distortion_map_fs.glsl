@@ -1,20 +1,84 @@
 // The input texture, which is set up by the Ogre Compositor infrastructure.
 uniform sampler2D RT;
 
-// Mapping of undistorted to distorted uv coordinates.
+// Coarse mapping of distorted to undistorted uv coordinates. Only bound
+// when the image is cropped, it gives the first guess of the inverse.
 uniform sampler2D distortionMap;
 
+// 1.0 if distortionMap is bound.
+uniform float useDistortionMap;
+
+// Radial distortion coefficients k1, k2 and k3.
+uniform vec3 radial;
+
+// Tangential distortion coefficients p1 and p2.
+uniform vec2 tangential;
+
+// Normalized distortion center.
+uniform vec2 center;
+
+// Ratio of the image width to the focal length, 1.0 in legacy mode.
+uniform float normalization;
+
 // Scale the input texture if necessary to crop black border
 uniform vec3 scale;
 
+// Brown's distortion model, the point is relative to the center.
+vec2 distort(vec2 p)
+{
+  float r2 = dot(p, p);
+  float r = 1.0 + r2 * (radial.x + r2 * (radial.y + r2 * radial.z));
+  return p * r + vec2(
+      tangential.y * (r2 + 2.0 * p.x * p.x) + 2.0 * tangential.x * p.x * p.y,
+      tangential.x * (r2 + 2.0 * p.y * p.y) + 2.0 * tangential.y * p.x * p.y);
+}
+
 void main()
 {
   vec2 scaleCenter = vec2(0.5, 0.5);
   vec2 inputUV = (gl_TexCoord[0].xy - scaleCenter) / scale.xy + scaleCenter;
-  vec4 mapUV = texture2D(distortionMap, inputUV);
 
-  if (mapUV.x < 0.0 || mapUV.y < 0.0)
+  vec2 guess = inputUV;
+  if (useDistortionMap > 0.5)
+  {
+    vec4 mapUV = texture2D(distortionMap, inputUV);
+    if (mapUV.x >= 0.0 && mapUV.y >= 0.0)
+      guess = mapUV.xy;
+  }
+
+  // Find the undistorted point that lands on this pixel with Newton's
+  // method.
+  vec2 target = (inputUV - center) * normalization;
+  vec2 p = (guess - center) * normalization;
+  for (int i = 0; i < 8; ++i)
+  {
+    float r2 = dot(p, p);
+    float r = 1.0 + r2 * (radial.x + r2 * (radial.y + r2 * radial.z));
+    float dr = radial.x + r2 * (2.0 * radial.y + 3.0 * r2 * radial.z);
+
+    // Jacobian of the distortion
+    float dxdx = r + 2.0 * dr * p.x * p.x +
+        6.0 * tangential.y * p.x + 2.0 * tangential.x * p.y;
+    float dxdy = 2.0 * dr * p.x * p.y +
+        2.0 * tangential.y * p.y + 2.0 * tangential.x * p.x;
+    float dydx = 2.0 * dr * p.x * p.y +
+        2.0 * tangential.x * p.x + 2.0 * tangential.y * p.y;
+    float dydy = r + 2.0 * dr * p.y * p.y +
+        6.0 * tangential.x * p.y + 2.0 * tangential.y * p.x;
+    float det = dxdx * dydy - dxdy * dydx;
+    if (abs(det) < 1e-8)
+      break;
+
+    vec2 f = distort(p) - target;
+    p -= vec2(dydy * f.x - dxdy * f.y, dxdx * f.y - dydx * f.x) / det;
+  }
+
+  vec2 mapUV = center + p / normalization;
+  float error = length(distort(p) - target) / normalization;
+
+  if (error > 1e-3 || mapUV.x < 0.0 || mapUV.y < 0.0 ||
+      mapUV.x > 1.0 || mapUV.y > 1.0)
     gl_FragColor = vec4(0.0, 0.0, 0.0, 1.0);
   else
-    gl_FragColor = texture2D(RT, mapUV.xy);
+    gl_FragColor = texture2D(RT, mapUV);
 }
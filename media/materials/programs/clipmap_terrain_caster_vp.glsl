@@ -0,0 +1,51 @@
+#version 120
+
+// Shadow caster vertex program of the GPU heightmap terrain, see
+// clipmap_terrain_vp.glsl. Writes the depth expected by
+// shadow_caster_fp.glsl.
+
+uniform vec4 nodeParams;
+uniform vec4 morphParams;
+uniform vec4 eyePosition;
+uniform vec4 terrainParams;
+uniform vec4 heightParams;
+
+uniform mat4 worldViewProj;
+uniform vec4 texel_offsets;
+
+uniform sampler2D heightMap;
+
+varying vec4 vertex_depth;
+
+vec2 gridToWorld(vec2 _grid)
+{
+  return nodeParams.xy + _grid / terrainParams.w * nodeParams.z;
+}
+
+float terrainHeight(vec2 _pos)
+{
+  vec2 uv = clamp((_pos - terrainParams.xy) / terrainParams.z, 0.0, 1.0);
+  float n = heightParams.y;
+  vec2 texel = (uv * (n - 1.0) + 0.5) / n;
+  return texture2DLod(heightMap, texel, 0.0).r + heightParams.x;
+}
+
+void main()
+{
+  vec2 grid = gl_Vertex.xy;
+  vec2 pos = gridToWorld(grid);
+  float height = terrainHeight(pos);
+
+  // Morph with the distance to the viewer, not to the light, so that the
+  // shadow matches the rendered terrain
+  float dist = distance(eyePosition.xyz, vec3(pos, height));
+  float morph = clamp((dist - morphParams.x) /
+      max(morphParams.y - morphParams.x, 1e-6), 0.0, 1.0);
+
+  grid -= fract(grid * 0.5) * 2.0 * morph;
+  pos = gridToWorld(grid);
+
+  vertex_depth = worldViewProj * vec4(pos, terrainHeight(pos), 1.0);
+  gl_Position = vertex_depth;
+  gl_Position.xy += texel_offsets.zw * gl_Position.w;
+}
@@ -0,0 +1,82 @@
+#version 120
+
+// Fragment program of the GPU heightmap terrain. The normal is computed
+// from the height texture, and up to three diffuse layers are blended by
+// height.
+
+// xy: minimum corner of the terrain, z: size of the terrain,
+// w: number of quads per side of the grid
+uniform vec4 terrainParams;
+
+// x: height offset, y: number of samples per side of the height texture
+uniform vec4 heightParams;
+
+// World size of the texture of each layer
+uniform vec4 layerSizes;
+
+// Height at which layers 1 and 2 start
+uniform vec4 blendHeights;
+
+// Height over which layers 1 and 2 fade in
+uniform vec4 blendFades;
+
+// Number of layers
+uniform float layerCount;
+
+uniform vec4 lightPosition;
+uniform vec4 lightDiffuse;
+uniform vec4 ambient;
+
+uniform sampler2D heightMapFiltered;
+uniform sampler2D layer0;
+uniform sampler2D layer1;
+uniform sampler2D layer2;
+
+varying vec2 terrainUV;
+varying vec3 worldPos;
+
+float sampleHeight(vec2 _uv)
+{
+  float n = heightParams.y;
+  vec2 texel = (clamp(_uv, 0.0, 1.0) * (n - 1.0) + 0.5) / n;
+  return texture2D(heightMapFiltered, texel).r;
+}
+
+void main()
+{
+  float n = heightParams.y;
+  float du = 1.0 / (n - 1.0);
+  float spacing = terrainParams.z * du;
+
+  vec3 normal = normalize(vec3(
+      sampleHeight(terrainUV - vec2(du, 0.0)) -
+      sampleHeight(terrainUV + vec2(du, 0.0)),
+      sampleHeight(terrainUV - vec2(0.0, du)) -
+      sampleHeight(terrainUV + vec2(0.0, du)),
+      2.0 * spacing));
+
+  // The blend heights are relative to the height offset
+  vec2 pos = worldPos.xy;
+  float height = worldPos.z - heightParams.x;
+  vec3 diffuse = texture2D(layer0, pos / layerSizes.x).rgb;
+  if (layerCount > 1.5)
+  {
+    float w = clamp((height - blendHeights.y) /
+        max(blendFades.y, 1e-6), 0.0, 1.0);
+    diffuse = mix(diffuse, texture2D(layer1, pos / layerSizes.y).rgb, w);
+  }
+  if (layerCount > 2.5)
+  {
+    float w = clamp((height - blendHeights.z) /
+        max(blendFades.z, 1e-6), 0.0, 1.0);
+    diffuse = mix(diffuse, texture2D(layer2, pos / layerSizes.z).rgb, w);
+  }
+
+  // Directional lights have w = 0
+  vec3 lightDir = normalize(lightPosition.xyz -
+      worldPos * lightPosition.w);
+  float lambert = max(dot(normal, lightDir), 0.0);
+
+  gl_FragColor = vec4(diffuse * (ambient.rgb + lightDiffuse.rgb * lambert),
+      1.0);
+}
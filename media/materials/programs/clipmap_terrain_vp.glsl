@@ -0,0 +1,67 @@
+#version 120
+
+// Vertex program of the GPU heightmap terrain. Every node of the terrain
+// quadtree is drawn with the same flat grid, whose vertices are displaced
+// with the height texture. Odd vertices slide onto the even ones as the
+// distance to the viewer approaches the end of the node's LOD range, so
+// that neighbouring nodes of different levels meet without cracks.
+
+// xy: minimum corner of the node, z: size of the node
+uniform vec4 nodeParams;
+
+// x: distance at which the morph starts, y: distance at which it ends
+uniform vec4 morphParams;
+
+// Position of the viewer
+uniform vec4 eyePosition;
+
+// xy: minimum corner of the terrain, z: size of the terrain,
+// w: number of quads per side of the grid
+uniform vec4 terrainParams;
+
+// x: height offset, y: number of samples per side of the height texture
+uniform vec4 heightParams;
+
+uniform mat4 worldViewProj;
+
+uniform sampler2D heightMap;
+
+varying vec2 terrainUV;
+varying vec3 worldPos;
+
+vec2 gridToWorld(vec2 _grid)
+{
+  return nodeParams.xy + _grid / terrainParams.w * nodeParams.z;
+}
+
+vec2 worldToUV(vec2 _pos)
+{
+  return clamp((_pos - terrainParams.xy) / terrainParams.z, 0.0, 1.0);
+}
+
+float terrainHeight(vec2 _uv)
+{
+  // Sample at the texel centers
+  float n = heightParams.y;
+  vec2 texel = (_uv * (n - 1.0) + 0.5) / n;
+  return texture2DLod(heightMap, texel, 0.0).r + heightParams.x;
+}
+
+void main()
+{
+  vec2 grid = gl_Vertex.xy;
+  vec2 pos = gridToWorld(grid);
+  float height = terrainHeight(worldToUV(pos));
+
+  float dist = distance(eyePosition.xyz, vec3(pos, height));
+  float morph = clamp((dist - morphParams.x) /
+      max(morphParams.y - morphParams.x, 1e-6), 0.0, 1.0);
+
+  grid -= fract(grid * 0.5) * 2.0 * morph;
+  pos = gridToWorld(grid);
+  terrainUV = worldToUV(pos);
+  height = terrainHeight(terrainUV);
+
+  worldPos = vec3(pos, height);
+  gl_Position = worldViewProj * vec4(worldPos, 1.0);
+}
@@ -1,6 +1,41 @@
 uniform float pNear;
 uniform float pFar;
 
+// Range noise, see gazebo::rendering::RangeNoise. The parameters are set
+// in C++ on each frame, with fresh random offsets.
+uniform vec3 noiseOffsets;
+uniform float noiseMean;
+uniform float noiseStdDev;
+uniform float noiseRangeStdDev;
+uniform float noiseDropout;
+uniform float noiseRangeDropout;
+uniform float noisePrecision;
+
+#define PI 3.14159265358979323846264
+
+// Pseudo random value in (0, 1), see camera_noise_gaussian_fs.glsl
+float rand(vec2 co)
+{
+  float r = fract(sin(dot(co.xy, vec2(12.9898, 78.233))) * 43758.5453);
+  return max(r, 0.000000000001);
+}
+
+// Add noise to a range, or drop it by returning _far.
+float rangeNoise(float _range, vec2 _co, float _near, float _far)
+{
+  float u0 = rand(_co + noiseOffsets.xx);
+  if (u0 < noiseDropout + noiseRangeDropout * _range)
+    return _far;
+
+  float u1 = rand(_co + noiseOffsets.yy);
+  float u2 = rand(_co + noiseOffsets.zz);
+  float n = sqrt(-2.0 * log(u1)) * cos(2.0 * PI * u2);
+  float r = _range + noiseMean + (noiseStdDev + noiseRangeStdDev * _range) * n;
+  if (noisePrecision > 0.0)
+    r = floor(r / noisePrecision + 0.5) * noisePrecision;
+  return clamp(r, _near, _far);
+}
+
 varying float depth;
 
 void main()
@@ -9,5 +44,6 @@ void main()
   //gl_FragColor = vec4(vec3(depth / (pFar - pNear)), 1.0);
 
   // This returns the world position
-  gl_FragColor = vec4(vec3(depth), 1.0);
+  gl_FragColor = vec4(vec3(rangeNoise(depth, gl_FragCoord.xy, pNear, pFar)),
+      1.0);
 }
@@ -133,6 +133,18 @@ void FFP_Modulate(in vec4 vIn0, in vec4 vIn1, out vec4 vOut)
 	vOut = vIn0 * vIn1;
 }
 
+//-----------------------------------------------------------------------------
+void FFP_Modulate(in float vIn0, in vec3 vIn1, out vec3 vOut)
+{
+	vOut = vIn0 * vIn1;
+}
+
+//-----------------------------------------------------------------------------
+void FFP_Modulate(in float vIn0, in vec4 vIn1, out vec4 vOut)
+{
+	vOut = vIn0 * vIn1;
+}
+
 //-----------------------------------------------------------------------------
 void FFP_Add(in float vIn0, in float vIn1, out float vOut)
 {
@@ -60,6 +60,16 @@ void FFP_Transform(in mat3x4 m,
 	vOut = mat3(m) * v;
 }
 
+//-----------------------------------------------------------------------------
+// Transforms by a row major 3x4 matrix of a bone palette, as used by
+// hardware skinning.
+void FFP_Transform(in mat3x4 m, 
+				   in vec4 v, 
+				   out vec3 vOut)
+{
+	vOut = v * m;
+}
+
 
 //-----------------------------------------------------------------------------
 void FFP_Transform(in mat4 m, 
@@ -22,7 +22,7 @@
 #include <ignition/math/Quaternion.hh>
 #include <ignition/math/Rand.hh>
 #include <ignition/math/Vector3.hh>
-#include <ignition/common/Profiler.hh>
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/physics.hh"
 #include "plugins/ActorPlugin.hh"
 
@@ -17,8 +17,7 @@
 
 #include <functional>
 
-#include <ignition/common/Profiler.hh>
-
+#include "gazebo/common/TraceCapture.hh"
 #include "ActuatorPlugin.hh"
 
 using namespace gazebo;
@@ -31,16 +31,33 @@
   using raw_type = void;
 #endif
 
+#ifdef __linux__
+  #include <linux/futex.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
 #if defined(_MSC_VER)
 #include <BaseTsd.h>
 typedef SSIZE_T ssize_t;
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 #include <sdf/sdf.hh>
-#include <ignition/common/Profiler.hh>
+#include "gazebo/common/TraceCapture.hh"
 #include <ignition/math/Filter.hh>
 #include <gazebo/common/Assert.hh>
 #include <gazebo/common/Plugin.hh>
@@ -51,6 +68,12 @@ typedef SSIZE_T ssize_t;
 
 #define MAX_MOTORS 255
 
+/// \brief Number of vehicles a lockstep shared memory segment can hold.
+#define MAX_SHM_VEHICLES 64
+
+/// \brief Marks an initialized lockstep shared memory segment ("GZAC").
+#define SHM_MAGIC 0x475a4143
+
 using namespace gazebo;
 
 GZ_REGISTER_MODEL_PLUGIN(ArduCopterPlugin)
@@ -110,6 +133,356 @@ struct fdmPacket
   double positionXYZ[3];
 };
 
+/// \brief One vehicle's slot in the lockstep shared memory segment.
+/// SITL writes servo and then increments servoSeq; gazebo writes fdm and
+/// then increments fdmSeq. Both sequence words double as futex words, so
+/// each side sleeps in the kernel until the other has published.
+struct ShmChannel
+{
+  /// \brief Sequence number of the last servo packet written by SITL.
+  std::atomic<uint32_t> servoSeq;
+
+  /// \brief Sequence number of the last fdm packet written by gazebo.
+  std::atomic<uint32_t> fdmSeq;
+
+  /// \brief Number of valid entries in servo.motorSpeed.
+  uint32_t motorCount;
+
+  /// \brief Latest servo packet.
+  ServoPacket servo;
+
+  /// \brief Latest fdm packet.
+  fdmPacket fdm;
+};
+
+/// \brief Layout of the lockstep shared memory segment.
+struct ShmSegment
+{
+  /// \brief SHM_MAGIC once the segment has been initialized.
+  uint32_t magic;
+
+  /// \brief Number of channels in the segment.
+  uint32_t channelCount;
+
+  /// \brief Incremented by SITL after every servo packet of any vehicle.
+  /// Batched waits sleep on this word.
+  std::atomic<uint32_t> servoFutex;
+
+  /// \brief Incremented by gazebo once every vehicle of a batch has been
+  /// sent its fdm packet.
+  std::atomic<uint32_t> fdmFutex;
+
+  /// \brief Per vehicle channels.
+  ShmChannel channels[MAX_SHM_VEHICLES];
+};
+
+#ifdef __linux__
+/// \brief Sleep until _word no longer holds _expected, or until _timeoutMs
+/// elapse.
+/// \param[in] _word Futex word in shared memory.
+/// \param[in] _expected Value the caller last observed.
+/// \param[in] _timeoutMs Milliseconds to wait.
+static void FutexWait(std::atomic<uint32_t> *_word, const uint32_t _expected,
+    const uint32_t _timeoutMs)
+{
+  struct timespec ts;
+  ts.tv_sec = _timeoutMs / 1000;
+  ts.tv_nsec = (_timeoutMs % 1000) * 1000000L;
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(_word), FUTEX_WAIT,
+      _expected, &ts, nullptr, 0);
+}
+
+/// \brief Wake every process sleeping on _word.
+/// \param[in] _word Futex word in shared memory.
+static void FutexWake(std::atomic<uint32_t> *_word)
+{
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(_word), FUTEX_WAKE,
+      INT_MAX, nullptr, nullptr, 0);
+}
+#endif
+
+/// \brief Lockstep shared memory channel to ArduPilot SITL, replacing the
+/// UDP socket when <transport> is "shm". One instance exists per segment
+/// name and is shared by every vehicle mapped into that segment, which is
+/// what lets batched mode service all of them with a single wait.
+class ArduCopterLockstep
+{
+  /// \brief Get the channel for a segment, mapping it on first use.
+  /// \param[in] _name POSIX shared memory object name.
+  /// \return The channel, or nullptr if the segment could not be mapped.
+  public: static std::shared_ptr<ArduCopterLockstep> Open(
+      const std::string &_name)
+  {
+    static std::mutex registryMutex;
+    static std::map<std::string, std::weak_ptr<ArduCopterLockstep>> registry;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto existing = registry[_name].lock();
+    if (existing)
+      return existing;
+
+#ifdef __linux__
+    int fd = shm_open(_name.c_str(), O_RDWR | O_CREAT, 0600);
+    if (fd < 0)
+    {
+      gzerr << "shm_open [" << _name << "] failed: "
+            << strerror(errno) << "\n";
+      return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        (static_cast<size_t>(st.st_size) < sizeof(ShmSegment) &&
+         ftruncate(fd, sizeof(ShmSegment)) != 0))
+    {
+      gzerr << "Unable to size shared memory [" << _name << "]\n";
+      close(fd);
+      return nullptr;
+    }
+
+    void *addr = mmap(nullptr, sizeof(ShmSegment), PROT_READ | PROT_WRITE,
+        MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+      gzerr << "mmap [" << _name << "] failed: " << strerror(errno) << "\n";
+      close(fd);
+      return nullptr;
+    }
+
+    std::shared_ptr<ArduCopterLockstep> result(new ArduCopterLockstep);
+    result->fd = fd;
+    result->segment = static_cast<ShmSegment *>(addr);
+
+    // A freshly truncated object is zero filled, which is a valid initial
+    // state for every sequence word.
+    if (result->segment->magic != SHM_MAGIC)
+    {
+      result->segment->channelCount = MAX_SHM_VEHICLES;
+      result->segment->magic = SHM_MAGIC;
+    }
+
+    registry[_name] = result;
+    return result;
+#else
+    gzerr << "Shared memory lockstep is only supported on Linux.\n";
+    return nullptr;
+#endif
+  }
+
+  /// \brief Destructor. Unmaps the segment.
+  public: ~ArduCopterLockstep()
+  {
+#ifdef __linux__
+    if (this->segment)
+      munmap(this->segment, sizeof(ShmSegment));
+    if (this->fd >= 0)
+      close(this->fd);
+#endif
+  }
+
+  /// \brief Add a vehicle to the set serviced by batched waits.
+  /// \param[in] _instance Channel index of the vehicle.
+  /// \return False if the channel is out of range or already in use.
+  public: bool Register(const unsigned int _instance)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (_instance >= MAX_SHM_VEHICLES || this->instances.count(_instance))
+      return false;
+
+    this->instances.insert(_instance);
+    // Ignore anything SITL wrote before we attached.
+    this->lastServoSeq[_instance] =
+      this->segment->channels[_instance].servoSeq.load(
+          std::memory_order_acquire);
+    return true;
+  }
+
+  /// \brief Remove a vehicle added with Register.
+  /// \param[in] _instance Channel index of the vehicle.
+  public: void Unregister(const unsigned int _instance)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->instances.erase(_instance) && this->pending.erase(_instance))
+      this->FlushLocked();
+  }
+
+  /// \brief Wait for the next servo packet of a single vehicle.
+  /// \param[in] _instance Channel index of the vehicle.
+  /// \param[out] _pkt Received servo packet.
+  /// \param[in] _timeoutMs Milliseconds to wait.
+  /// \return Number of valid bytes in _pkt, -1 on timeout.
+  public: ssize_t Recv(const unsigned int _instance, ServoPacket &_pkt,
+      const uint32_t _timeoutMs)
+  {
+    ShmChannel &channel = this->segment->channels[_instance];
+    auto deadline = std::chrono::steady_clock::now() +
+      std::chrono::milliseconds(_timeoutMs);
+
+    // Only this vehicle touches its own channel state, no lock needed.
+    uint32_t seq = channel.servoSeq.load(std::memory_order_acquire);
+    while (seq == this->lastServoSeq[_instance])
+    {
+      auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline - std::chrono::steady_clock::now()).count();
+      if (remaining <= 0)
+        return -1;
+#ifdef __linux__
+      FutexWait(&channel.servoSeq, seq, static_cast<uint32_t>(remaining));
+#endif
+      seq = channel.servoSeq.load(std::memory_order_acquire);
+    }
+
+    return this->Consume(_instance, seq, _pkt);
+  }
+
+  /// \brief Batched counterpart of Recv. The first vehicle to call this
+  /// in a world iteration sleeps until every registered vehicle has a
+  /// fresh servo packet, or until the timeout; the others only copy out
+  /// what that single wait collected.
+  /// \param[in] _instance Channel index of the vehicle.
+  /// \param[in] _iteration Current world iteration.
+  /// \param[out] _pkt Received servo packet.
+  /// \param[in] _timeoutMs Milliseconds to wait.
+  /// \return Number of valid bytes in _pkt, -1 on timeout.
+  public: ssize_t RecvBatched(const unsigned int _instance,
+      const uint64_t _iteration, ServoPacket &_pkt,
+      const uint32_t _timeoutMs)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->waited || this->waitedIteration != _iteration)
+    {
+      this->waited = true;
+      this->waitedIteration = _iteration;
+      this->WaitAllLocked(_timeoutMs);
+    }
+
+    ShmChannel &channel = this->segment->channels[_instance];
+    uint32_t seq = channel.servoSeq.load(std::memory_order_acquire);
+    if (seq == this->lastServoSeq[_instance])
+      return -1;
+
+    this->pending.insert(_instance);
+    return this->Consume(_instance, seq, _pkt);
+  }
+
+  /// \brief Publish a fdm packet to a vehicle. In batched mode SITL is
+  /// woken once, after the last vehicle of the batch has published.
+  /// \param[in] _instance Channel index of the vehicle.
+  /// \param[in] _pkt Packet to publish.
+  /// \param[in] _batched True if the vehicle uses batched mode.
+  public: void Send(const unsigned int _instance, const fdmPacket &_pkt,
+      const bool _batched)
+  {
+    ShmChannel &channel = this->segment->channels[_instance];
+    channel.fdm = _pkt;
+    channel.fdmSeq.fetch_add(1, std::memory_order_release);
+
+    if (!_batched)
+    {
+#ifdef __linux__
+      FutexWake(&channel.fdmSeq);
+#endif
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->pending.erase(_instance) && this->pending.empty())
+      this->FlushLocked();
+  }
+
+  /// \brief Constructor, use Open.
+  private: ArduCopterLockstep() = default;
+
+  /// \brief Sleep on the segment wide servo futex until every registered
+  /// vehicle has published a new servo packet.
+  /// \param[in] _timeoutMs Milliseconds to wait.
+  private: void WaitAllLocked(const uint32_t _timeoutMs)
+  {
+    auto deadline = std::chrono::steady_clock::now() +
+      std::chrono::milliseconds(_timeoutMs);
+
+    while (true)
+    {
+      // Sample the futex word before scanning so a packet published
+      // during the scan makes the wait below return immediately.
+      uint32_t word =
+        this->segment->servoFutex.load(std::memory_order_acquire);
+
+      bool ready = true;
+      for (auto instance : this->instances)
+      {
+        if (this->segment->channels[instance].servoSeq.load(
+              std::memory_order_acquire) == this->lastServoSeq[instance])
+        {
+          ready = false;
+          break;
+        }
+      }
+      if (ready)
+        return;
+
+      auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline - std::chrono::steady_clock::now()).count();
+      if (remaining <= 0)
+        return;
+#ifdef __linux__
+      FutexWait(&this->segment->servoFutex, word,
+          static_cast<uint32_t>(remaining));
+#endif
+    }
+  }
+
+  /// \brief Copy the servo packet of a vehicle out of shared memory.
+  /// \param[in] _instance Channel index of the vehicle.
+  /// \param[in] _seq Sequence number observed for the packet.
+  /// \param[out] _pkt Received servo packet.
+  /// \return Number of valid bytes in _pkt.
+  private: ssize_t Consume(const unsigned int _instance, const uint32_t _seq,
+      ServoPacket &_pkt)
+  {
+    const ShmChannel &channel = this->segment->channels[_instance];
+    uint32_t count = std::min<uint32_t>(channel.motorCount, MAX_MOTORS);
+    memcpy(_pkt.motorSpeed, channel.servo.motorSpeed,
+        count * sizeof(_pkt.motorSpeed[0]));
+    this->lastServoSeq[_instance] = _seq;
+    return count * sizeof(_pkt.motorSpeed[0]);
+  }
+
+  /// \brief Wake SITL after all fdm packets of a batch are published.
+  private: void FlushLocked()
+  {
+    this->segment->fdmFutex.fetch_add(1, std::memory_order_release);
+#ifdef __linux__
+    FutexWake(&this->segment->fdmFutex);
+#endif
+  }
+
+  /// \brief Mapped segment.
+  private: ShmSegment *segment = nullptr;
+
+  /// \brief Shared memory file descriptor.
+  private: int fd = -1;
+
+  /// \brief Protects the members below, plugins may update concurrently.
+  private: std::mutex mutex;
+
+  /// \brief Registered channel indices.
+  private: std::set<unsigned int> instances;
+
+  /// \brief Vehicles that received a servo packet in the current batch
+  /// and have not yet published their fdm packet.
+  private: std::set<unsigned int> pending;
+
+  /// \brief Last consumed servo sequence number per channel.
+  private: uint32_t lastServoSeq[MAX_SHM_VEHICLES] = {};
+
+  /// \brief True once a batched wait has happened.
+  private: bool waited = false;
+
+  /// \brief World iteration of the last batched wait.
+  private: uint64_t waitedIteration = 0;
+};
+
 /// \brief Rotor class
 class Rotor
 {
@@ -261,6 +634,15 @@ class gazebo::ArduCopterPluginPrivate
   /// \brief number of times ArduCotper skips update
   /// before marking ArduCopter offline
   public: int connectionTimeoutMaxCount;
+
+  /// \brief Shared memory lockstep channel, null when using UDP.
+  public: std::shared_ptr<ArduCopterLockstep> lockstep;
+
+  /// \brief Channel index of this vehicle in the lockstep segment.
+  public: unsigned int shmInstance = 0;
+
+  /// \brief True to service all vehicles of the segment in one wait.
+  public: bool shmBatched = false;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -303,6 +685,8 @@ ArduCopterPlugin::ArduCopterPlugin()
 /////////////////////////////////////////////////
 ArduCopterPlugin::~ArduCopterPlugin()
 {
+  if (this->dataPtr->lockstep)
+    this->dataPtr->lockstep->Unregister(this->dataPtr->shmInstance);
 }
 
 /////////////////////////////////////////////////
@@ -455,6 +839,35 @@ void ArduCopterPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
   getSdfParam<int>(_sdf, "connectionTimeoutMaxCount",
     this->dataPtr->connectionTimeoutMaxCount, 10);
 
+  // Optional shared memory lockstep channel to SITL.
+  std::string transport;
+  getSdfParam<std::string>(_sdf, "transport", transport, "udp");
+  if (transport == "shm")
+  {
+    std::string shmName;
+    int shmInstance;
+    getSdfParam<std::string>(_sdf, "shm_name", shmName, "/gazebo_arducopter");
+    getSdfParam<int>(_sdf, "shm_instance", shmInstance, 0);
+    getSdfParam<bool>(_sdf, "shm_batched", this->dataPtr->shmBatched, false);
+
+    auto lockstep = ArduCopterLockstep::Open(shmName);
+    if (!lockstep || shmInstance < 0 ||
+        !lockstep->Register(static_cast<unsigned int>(shmInstance)))
+    {
+      gzerr << "Unable to use shared memory channel [" << shmName
+            << "] instance [" << shmInstance << "], falling back to UDP.\n";
+    }
+    else
+    {
+      this->dataPtr->lockstep = lockstep;
+      this->dataPtr->shmInstance = static_cast<unsigned int>(shmInstance);
+    }
+  }
+  else if (transport != "udp")
+  {
+    gzerr << "Unknown transport [" << transport << "], using UDP.\n";
+  }
+
   // Listen to the update event. This event is broadcast every simulation
   // iteration.
   this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
@@ -547,7 +960,21 @@ void ArduCopterPlugin::ReceiveMotorCommand()
     // Otherwise skip quickly and do not set control force.
     waitMs = 1;
   }
-  ssize_t recvSize = this->dataPtr->Recv(&pkt, sizeof(ServoPacket), waitMs);
+  ssize_t recvSize;
+  if (!this->dataPtr->lockstep)
+  {
+    recvSize = this->dataPtr->Recv(&pkt, sizeof(ServoPacket), waitMs);
+  }
+  else if (this->dataPtr->shmBatched)
+  {
+    recvSize = this->dataPtr->lockstep->RecvBatched(this->dataPtr->shmInstance,
+        this->dataPtr->model->GetWorld()->Iterations(), pkt, waitMs);
+  }
+  else
+  {
+    recvSize = this->dataPtr->lockstep->Recv(this->dataPtr->shmInstance, pkt,
+        waitMs);
+  }
   ssize_t expectedPktSize =
     sizeof(pkt.motorSpeed[0])*this->dataPtr->rotors.size();
   if ((recvSize == -1) || (recvSize < expectedPktSize))
@@ -699,6 +1126,13 @@ void ArduCopterPlugin::SendState() const
   pkt.velocityXYZ[1] = velNEDFrame.Y();
   pkt.velocityXYZ[2] = velNEDFrame.Z();
 
+  if (this->dataPtr->lockstep)
+  {
+    this->dataPtr->lockstep->Send(this->dataPtr->shmInstance, pkt,
+        this->dataPtr->shmBatched);
+    return;
+  }
+
   struct sockaddr_in sockaddr;
   this->dataPtr->MakeSockAddr("127.0.0.1", 9003, sockaddr);
 
@@ -45,6 +45,15 @@ namespace gazebo
   /// <imuName>     scoped name for the imu sensor
   /// <connectionTimeoutMaxCount> timeout before giving up on
   ///                             controller synchronization
+  ///
+  /// Optional parameters:
+  /// <transport>    'udp' (default) or 'shm'. 'shm' exchanges packets with
+  ///                SITL through a futex signalled shared memory segment
+  ///                (Linux only) instead of UDP ports 9002/9003.
+  /// <shm_name>     shared memory object name, default /gazebo_arducopter
+  /// <shm_instance> channel index of this vehicle in the segment
+  /// <shm_batched>  true to wait once per step for every vehicle sharing
+  ///                the segment instead of once per vehicle
   class GZ_PLUGIN_VISIBLE ArduCopterPlugin : public ModelPlugin
   {
     /// \brief Constructor.
@@ -15,20 +15,573 @@
  *
 */
 
-#include "ignition/common/Profiler.hh"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "plugins/BuoyancyPlugin.hh"
+#include "gazebo/common/TraceCapture.hh"
+
+namespace gazebo
+{
+  /// \brief Triangles of the collision shapes of a link, in the link
+  /// frame, used to compute the part of the link below the fluid surface.
+  class BuoyancyHull
+  {
+    /// \brief Build the hull from the collision shapes of a link.
+    /// \param[in] _link The link.
+    /// \return False if a shape is not supported or the hull is empty.
+    public: bool Load(const physics::LinkPtr &_link);
+
+    /// \brief Compute the part of the hull below a plane.
+    /// \param[in] _pose Pose of the link in the world.
+    /// \param[in] _point A point of the plane, in the world.
+    /// \param[in] _normal Unit normal of the plane, pointing out of the
+    /// fluid, in the world.
+    /// \param[out] _center Center of the submerged volume, in the world.
+    /// \return The submerged volume.
+    public: double Submerged(const ignition::math::Pose3d &_pose,
+                const ignition::math::Vector3d &_point,
+                const ignition::math::Vector3d &_normal,
+                ignition::math::Vector3d &_center);
+
+    /// \brief Add the triangles of a mesh.
+    /// \param[in] _mesh The mesh, used if _submesh is null.
+    /// \param[in] _submesh The submesh, or null to use all of _mesh.
+    /// \param[in] _pose Pose of the mesh in the link frame.
+    /// \param[in] _scale Scale of the mesh.
+    private: void AddMesh(const common::Mesh *_mesh,
+                 const common::SubMesh *_submesh,
+                 const ignition::math::Pose3d &_pose,
+                 const ignition::math::Vector3d &_scale);
+
+    /// \brief Vertices in the link frame, one array per axis.
+    private: std::vector<double> x, y, z;
+
+    /// \brief Vertex indices, three per triangle.
+    private: std::vector<unsigned int> indices;
+
+    /// \brief Signed distance of each vertex to the plane.
+    private: std::vector<double> distance;
+
+    /// \brief 1 if the triangles wind outward, -1 otherwise.
+    private: double winding = 1.0;
+
+    /// \brief Distance from the link origin to the farthest vertex.
+    private: double radius = 0.0;
+
+    /// \brief Volume of the whole hull.
+    private: double volume = 0.0;
+
+    /// \brief Center of volume of the whole hull, in the link frame.
+    private: ignition::math::Vector3d center;
+  };
+
+  /// \brief Buoyancy plugins of one world. The links of all the plugins
+  /// are gathered into arrays each step, so that the forces are computed
+  /// in a single loop the compiler can vectorize.
+  class BuoyancyPluginBatch
+  {
+    /// \brief Get the batch of a world, creating it if needed.
+    /// \param[in] _world The world.
+    /// \return The batch shared by the plugins of the world.
+    public: static std::shared_ptr<BuoyancyPluginBatch> Get(
+                const physics::WorldPtr &_world);
+
+    /// \brief Add a plugin to the batch.
+    /// \param[in] _plugin Plugin to evaluate each step.
+    public: void Add(BuoyancyPlugin *_plugin);
+
+    /// \brief Remove a plugin from the batch.
+    /// \param[in] _plugin Plugin to remove.
+    public: void Remove(BuoyancyPlugin *_plugin);
+
+    /// \brief Compute and apply the forces of plugins.
+    /// \param[in] _plugins The plugins.
+    public: void Evaluate(const std::vector<BuoyancyPlugin *> &_plugins);
+
+    /// \brief Callback for World Update events.
+    private: void OnUpdate();
+
+    /// \brief Get the height of the fluid surface of a plugin.
+    /// \param[in] _plugin The plugin.
+    /// \param[in] _x X coordinate in the world.
+    /// \param[in] _y Y coordinate in the world.
+    /// \param[in] _time Simulation time in seconds.
+    /// \param[out] _gradient Slope of the surface along X and Y.
+    /// \return Height of the surface.
+    private: static double SurfaceHeight(const BuoyancyPlugin *_plugin,
+                 const double _x, const double _y, const double _time,
+                 ignition::math::Vector2d &_gradient);
+
+    /// \brief The world of the plugins.
+    private: physics::WorldPtr world;
+
+    /// \brief Plugins of the world that are BuoyancyPlugin instances.
+    private: std::vector<BuoyancyPlugin *> plugins;
+
+    /// \brief Plugins of the world that are instances of a subclass, which
+    /// may override BuoyancyPlugin::OnUpdate.
+    private: std::vector<BuoyancyPlugin *> subclassPlugins;
+
+    /// \brief Protects plugins and subclassPlugins.
+    private: std::mutex mutex;
+
+    /// \brief Connection to World Update events.
+    private: event::ConnectionPtr updateConnection;
+
+    /// \brief Links gathered in the current step.
+    private: std::vector<physics::LinkPtr> links;
+
+    /// \brief Center of volume of each link, in the link frame.
+    private: std::vector<ignition::math::Vector3d> covs;
+
+    /// \brief Displaced fluid mass of each link.
+    private: std::vector<double> mass;
+
+    /// \brief Orientation of each link in the world, one array per
+    /// quaternion component.
+    private: std::vector<double> qw, qx, qy, qz;
+
+    /// \brief Force of each link in the link frame, one array per axis.
+    private: std::vector<double> fx, fy, fz;
+
+    /// \brief Links gathered in the current step whose submerged volume is
+    /// computed.
+    private: std::vector<physics::LinkPtr> hullLinks;
+
+    /// \brief Plugin of each link in hullLinks.
+    private: std::vector<const BuoyancyPlugin *> hullPlugins;
+
+    /// \brief Hull of each link in hullLinks.
+    private: std::vector<BuoyancyHull *> hulls;
+  };
+}
 
 using namespace gazebo;
 
 GZ_REGISTER_MODEL_PLUGIN(BuoyancyPlugin)
 
+/////////////////////////////////////////////////
+/// \brief Add the signed volume of the tetrahedron of a triangle and a
+/// reference point, and its first moment.
+static inline void addTetrahedron(const ignition::math::Vector3d &_ref,
+    const ignition::math::Vector3d &_a, const ignition::math::Vector3d &_b,
+    const ignition::math::Vector3d &_c, double &_volume,
+    ignition::math::Vector3d &_moment)
+{
+  const double v = (_a - _ref).Dot((_b - _ref).Cross(_c - _ref)) / 6.0;
+  _volume += v;
+  _moment += v * 0.25 * (_ref + _a + _b + _c);
+}
+
+/////////////////////////////////////////////////
+bool BuoyancyHull::Load(const physics::LinkPtr &_link)
+{
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  for (const auto &collision : _link->GetCollisions())
+  {
+    const physics::ShapePtr shape = collision->GetShape();
+    const ignition::math::Pose3d pose = collision->RelativePose();
+    if (shape->HasType(physics::Base::BOX_SHAPE))
+    {
+      this->AddMesh(meshManager->GetMesh("unit_box"), nullptr, pose,
+          boost::static_pointer_cast<physics::BoxShape>(shape)->Size());
+    }
+    else if (shape->HasType(physics::Base::SPHERE_SHAPE))
+    {
+      const double diameter = 2.0 *
+          boost::static_pointer_cast<physics::SphereShape>(shape)->GetRadius();
+      this->AddMesh(meshManager->GetMesh("unit_sphere"), nullptr, pose,
+          ignition::math::Vector3d(diameter, diameter, diameter));
+    }
+    else if (shape->HasType(physics::Base::CYLINDER_SHAPE))
+    {
+      physics::CylinderShapePtr cylinder =
+          boost::static_pointer_cast<physics::CylinderShape>(shape);
+      const double diameter = 2.0 * cylinder->GetRadius();
+      this->AddMesh(meshManager->GetMesh("unit_cylinder"), nullptr, pose,
+          ignition::math::Vector3d(diameter, diameter, cylinder->GetLength()));
+    }
+    else if (shape->HasType(physics::Base::MESH_SHAPE))
+    {
+      physics::MeshShapePtr mesh =
+          boost::static_pointer_cast<physics::MeshShape>(shape);
+      this->AddMesh(mesh->MeshData(), mesh->SubMeshData(), pose,
+          mesh->Size());
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  if (this->indices.empty())
+    return false;
+
+  // Volume of the whole hull, with the link origin as reference
+  double sum = 0;
+  ignition::math::Vector3d moment;
+  for (size_t i = 0; i + 2 < this->indices.size(); i += 3)
+  {
+    const unsigned int a = this->indices[i];
+    const unsigned int b = this->indices[i + 1];
+    const unsigned int c = this->indices[i + 2];
+    addTetrahedron(ignition::math::Vector3d::Zero,
+        ignition::math::Vector3d(this->x[a], this->y[a], this->z[a]),
+        ignition::math::Vector3d(this->x[b], this->y[b], this->z[b]),
+        ignition::math::Vector3d(this->x[c], this->y[c], this->z[c]),
+        sum, moment);
+  }
+
+  if (ignition::math::equal(sum, 0.0))
+    return false;
+
+  this->winding = sum > 0 ? 1.0 : -1.0;
+  this->volume = std::fabs(sum);
+  this->center = moment / sum;
+
+  for (size_t i = 0; i < this->x.size(); ++i)
+  {
+    this->radius = std::max(this->radius, std::sqrt(this->x[i] * this->x[i] +
+          this->y[i] * this->y[i] + this->z[i] * this->z[i]));
+  }
+  this->distance.resize(this->x.size());
+  return true;
+}
+
+/////////////////////////////////////////////////
+void BuoyancyHull::AddMesh(const common::Mesh *_mesh,
+    const common::SubMesh *_submesh, const ignition::math::Pose3d &_pose,
+    const ignition::math::Vector3d &_scale)
+{
+  if (!_mesh && !_submesh)
+    return;
+
+  const unsigned int count = _submesh ? 1 : _mesh->GetSubMeshCount();
+  for (unsigned int s = 0; s < count; ++s)
+  {
+    const common::SubMesh *submesh = _submesh ? _submesh : _mesh->GetSubMesh(s);
+    if (submesh->GetPrimitiveType() != common::SubMesh::TRIANGLES)
+      continue;
+
+    const unsigned int offset = this->x.size();
+    for (unsigned int i = 0; i < submesh->GetVertexCount(); ++i)
+    {
+      const ignition::math::Vector3d v =
+          _pose.CoordPositionAdd(submesh->Vertex(i) * _scale);
+      this->x.push_back(v.X());
+      this->y.push_back(v.Y());
+      this->z.push_back(v.Z());
+    }
+
+    if (submesh->GetIndexCount() > 0)
+    {
+      for (unsigned int i = 0; i + 2 < submesh->GetIndexCount(); i += 3)
+      {
+        this->indices.push_back(offset + submesh->GetIndex(i));
+        this->indices.push_back(offset + submesh->GetIndex(i + 1));
+        this->indices.push_back(offset + submesh->GetIndex(i + 2));
+      }
+    }
+    else
+    {
+      for (unsigned int i = 0; i + 2 < submesh->GetVertexCount(); i += 3)
+      {
+        this->indices.push_back(offset + i);
+        this->indices.push_back(offset + i + 1);
+        this->indices.push_back(offset + i + 2);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+double BuoyancyHull::Submerged(const ignition::math::Pose3d &_pose,
+    const ignition::math::Vector3d &_point,
+    const ignition::math::Vector3d &_normal,
+    ignition::math::Vector3d &_center)
+{
+  // The plane in the link frame: n.v = d
+  const ignition::math::Vector3d n = _pose.Rot().RotateVectorReverse(_normal);
+  const double d = _normal.Dot(_point - _pose.Pos());
+
+  // Fully above or below the fluid surface
+  if (-d >= this->radius)
+    return 0.0;
+  if (d >= this->radius)
+  {
+    _center = _pose.CoordPositionAdd(this->center);
+    return this->volume;
+  }
+
+  // Signed distance of every vertex, negative below the surface
+  const size_t count = this->x.size();
+  const double nx = n.X();
+  const double ny = n.Y();
+  const double nz = n.Z();
+  const double *vx = this->x.data();
+  const double *vy = this->y.data();
+  const double *vz = this->z.data();
+  double *dist = this->distance.data();
+  for (size_t i = 0; i < count; ++i)
+    dist[i] = nx * vx[i] + ny * vy[i] + nz * vz[i] - d;
+
+  // Clip every triangle to the part below the plane. With a reference
+  // point on the plane, the cap of the submerged volume adds nothing, so
+  // the volume is the sum over the clipped triangles.
+  const ignition::math::Vector3d ref = n * d;
+  double sum = 0;
+  ignition::math::Vector3d moment;
+  ignition::math::Vector3d polygon[4];
+  for (size_t t = 0; t + 2 < this->indices.size(); t += 3)
+  {
+    const unsigned int *tri = &this->indices[t];
+    const int below = (dist[tri[0]] < 0) + (dist[tri[1]] < 0) +
+        (dist[tri[2]] < 0);
+    if (below == 0)
+      continue;
+
+    unsigned int size = 0;
+    for (unsigned int e = 0; e < 3; ++e)
+    {
+      const unsigned int i = tri[e];
+      const unsigned int j = tri[(e + 1) % 3];
+      const ignition::math::Vector3d vi(vx[i], vy[i], vz[i]);
+      if (dist[i] < 0)
+        polygon[size++] = vi;
+      if ((dist[i] < 0) != (dist[j] < 0))
+      {
+        const double s = dist[i] / (dist[i] - dist[j]);
+        polygon[size++] = vi +
+            s * (ignition::math::Vector3d(vx[j], vy[j], vz[j]) - vi);
+      }
+    }
+
+    for (unsigned int k = 1; k + 1 < size; ++k)
+      addTetrahedron(ref, polygon[0], polygon[k], polygon[k + 1], sum, moment);
+  }
+
+  const double submerged = this->winding * sum;
+  if (submerged <= 0)
+    return 0.0;
+
+  _center = _pose.CoordPositionAdd(moment / sum);
+  return std::min(submerged, this->volume);
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<BuoyancyPluginBatch> BuoyancyPluginBatch::Get(
+    const physics::WorldPtr &_world)
+{
+  static std::mutex batchesMutex;
+  static std::map<std::string, std::weak_ptr<BuoyancyPluginBatch>> batches;
+
+  std::lock_guard<std::mutex> lock(batchesMutex);
+  std::shared_ptr<BuoyancyPluginBatch> batch = batches[_world->Name()].lock();
+  if (!batch || batch->world != _world)
+  {
+    batch.reset(new BuoyancyPluginBatch);
+    batch->world = _world;
+    batch->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&BuoyancyPluginBatch::OnUpdate, batch.get()));
+    batches[_world->Name()] = batch;
+  }
+  return batch;
+}
+
+/////////////////////////////////////////////////
+void BuoyancyPluginBatch::Add(BuoyancyPlugin *_plugin)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (typeid(*_plugin) == typeid(BuoyancyPlugin))
+    this->plugins.push_back(_plugin);
+  else
+    this->subclassPlugins.push_back(_plugin);
+}
+
+/////////////////////////////////////////////////
+void BuoyancyPluginBatch::Remove(BuoyancyPlugin *_plugin)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->plugins.erase(std::remove(this->plugins.begin(), this->plugins.end(),
+        _plugin), this->plugins.end());
+  this->subclassPlugins.erase(std::remove(this->subclassPlugins.begin(),
+        this->subclassPlugins.end(), _plugin), this->subclassPlugins.end());
+}
+
+/////////////////////////////////////////////////
+void BuoyancyPluginBatch::OnUpdate()
+{
+  IGN_PROFILE("BuoyancyPluginBatch::OnUpdate");
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  this->Evaluate(this->plugins);
+
+  // Subclasses get their own update, which they may override
+  for (const auto plugin : this->subclassPlugins)
+    plugin->OnUpdate();
+}
+
+/////////////////////////////////////////////////
+void BuoyancyPluginBatch::Evaluate(
+    const std::vector<BuoyancyPlugin *> &_plugins)
+{
+  // Gather the links of every plugin
+  IGN_PROFILE_BEGIN("Gather");
+  this->links.clear();
+  this->covs.clear();
+  this->mass.clear();
+  this->qw.clear();
+  this->qx.clear();
+  this->qy.clear();
+  this->qz.clear();
+  this->hullLinks.clear();
+  this->hullPlugins.clear();
+  this->hulls.clear();
+  for (const auto plugin : _plugins)
+  {
+    for (const auto &link : plugin->model->GetLinks())
+    {
+      auto hull = plugin->hulls.find(link->GetId());
+      if (hull != plugin->hulls.end())
+      {
+        this->hullLinks.push_back(link);
+        this->hullPlugins.push_back(plugin);
+        this->hulls.push_back(hull->second.get());
+        continue;
+      }
+
+      auto iter = plugin->volPropsMap.find(link->GetId());
+      GZ_ASSERT(iter != plugin->volPropsMap.end() && iter->second.volume > 0,
+          "Nonpositive volume found in volume properties!");
+      if (iter == plugin->volPropsMap.end())
+        continue;
+
+      const ignition::math::Quaterniond &rot = link->WorldPose().Rot();
+      this->links.push_back(link);
+      this->covs.push_back(iter->second.cov);
+      this->mass.push_back(plugin->fluidDensity * iter->second.volume);
+      this->qw.push_back(rot.W());
+      this->qx.push_back(rot.X());
+      this->qy.push_back(rot.Y());
+      this->qz.push_back(rot.Z());
+    }
+  }
+  IGN_PROFILE_END();
+
+  IGN_PROFILE_BEGIN("Forces");
+  const size_t count = this->links.size();
+  this->fx.resize(count);
+  this->fy.resize(count);
+  this->fz.resize(count);
+
+  const ignition::math::Vector3d gravity = this->world->Gravity();
+  const double gx = gravity.X();
+  const double gy = gravity.Y();
+  const double gz = gravity.Z();
+  const double *m = this->mass.data();
+  const double *w = this->qw.data();
+  const double *x = this->qx.data();
+  const double *y = this->qy.data();
+  const double *z = this->qz.data();
+  double *outX = this->fx.data();
+  double *outY = this->fy.data();
+  double *outZ = this->fz.data();
+  for (size_t i = 0; i < count; ++i)
+  {
+    // By Archimedes' principle, buoyancy = -fluid_density*volume*gravity
+    const double bx = -m[i] * gx;
+    const double by = -m[i] * gy;
+    const double bz = -m[i] * gz;
+
+    // Rotate buoyancy into the link frame by the inverse orientation,
+    // whose vector part is u = -q.xyz: b' = b + w*t + u x t, t = 2 u x b.
+    const double ux = -x[i];
+    const double uy = -y[i];
+    const double uz = -z[i];
+    const double tx = 2.0 * (uy * bz - uz * by);
+    const double ty = 2.0 * (uz * bx - ux * bz);
+    const double tz = 2.0 * (ux * by - uy * bx);
+    outX[i] = bx + w[i] * tx + (uy * tz - uz * ty);
+    outY[i] = by + w[i] * ty + (uz * tx - ux * tz);
+    outZ[i] = bz + w[i] * tz + (ux * ty - uy * tx);
+  }
+  IGN_PROFILE_END();
+
+  IGN_PROFILE_BEGIN("Apply");
+  for (size_t i = 0; i < count; ++i)
+  {
+    this->links[i]->AddLinkForce(
+        ignition::math::Vector3d(outX[i], outY[i], outZ[i]), this->covs[i]);
+  }
+  IGN_PROFILE_END();
+
+  // Buoyancy of the submerged part of each hull, at its center
+  IGN_PROFILE_BEGIN("Submersion");
+  const double time = this->world->SimTime().Double();
+  for (size_t i = 0; i < this->hulls.size(); ++i)
+  {
+    const ignition::math::Pose3d &pose = this->hullLinks[i]->WorldPose();
+
+    // The surface is approximated by its tangent plane below the link
+    ignition::math::Vector2d gradient;
+    const double height = SurfaceHeight(this->hullPlugins[i],
+        pose.Pos().X(), pose.Pos().Y(), time, gradient);
+    const ignition::math::Vector3d point(pose.Pos().X(), pose.Pos().Y(),
+        height);
+    const ignition::math::Vector3d normal = ignition::math::Vector3d(
+        -gradient.X(), -gradient.Y(), 1.0).Normalize();
+
+    ignition::math::Vector3d center;
+    const double volume = this->hulls[i]->Submerged(pose, point, normal,
+        center);
+    if (volume <= 0)
+      continue;
+
+    this->hullLinks[i]->AddForceAtWorldPosition(
+        -this->hullPlugins[i]->fluidDensity * volume * gravity, center);
+  }
+  IGN_PROFILE_END();
+}
+
+/////////////////////////////////////////////////
+double BuoyancyPluginBatch::SurfaceHeight(const BuoyancyPlugin *_plugin,
+    const double _x, const double _y, const double _time,
+    ignition::math::Vector2d &_gradient)
+{
+  double height = _plugin->fluidLevel;
+  _gradient.Set(0, 0);
+  for (const auto &wave : _plugin->waves)
+  {
+    const double phase = wave.wavenumber * (wave.direction.X() * _x +
+        wave.direction.Y() * _y) - wave.angularFrequency * _time;
+    height += wave.amplitude * std::sin(phase);
+    _gradient += wave.direction *
+        (wave.amplitude * wave.wavenumber * std::cos(phase));
+  }
+  return height;
+}
+
 /////////////////////////////////////////////////
 BuoyancyPlugin::BuoyancyPlugin()
   // Density of liquid water at 1 atm pressure and 15 degrees Celsius.
-  : fluidDensity(999.1026)
+  : fluidDensity(999.1026), submersion(false), fluidLevel(0)
+{
+}
+
+/////////////////////////////////////////////////
+BuoyancyPlugin::~BuoyancyPlugin()
 {
+  if (this->batch)
+    this->batch->Remove(this);
 }
 
 /////////////////////////////////////////////////
@@ -47,6 +600,49 @@ void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
     this->fluidDensity = this->sdf->Get<double>("fluid_density");
   }
 
+  if (this->sdf->HasElement("submersion"))
+    this->submersion = this->sdf->Get<bool>("submersion");
+
+  if (this->sdf->HasElement("fluid_level"))
+    this->fluidLevel = this->sdf->Get<double>("fluid_level");
+
+  if (this->sdf->HasElement("wave"))
+  {
+    for (sdf::ElementPtr waveElem = this->sdf->GetElement("wave"); waveElem;
+         waveElem = waveElem->GetNextElement("wave"))
+    {
+      if (!waveElem->HasElement("amplitude") ||
+          !waveElem->HasElement("wavelength") ||
+          !waveElem->HasElement("period"))
+      {
+        gzwarn << "A wave requires amplitude, wavelength and period elements "
+               << "in BuoyancyPlugin SDF" << std::endl;
+        continue;
+      }
+
+      const double wavelength = waveElem->Get<double>("wavelength");
+      const double period = waveElem->Get<double>("period");
+      if (wavelength <= 0 || period <= 0)
+      {
+        gzwarn << "Nonpositive wavelength or period specified in "
+               << "BuoyancyPlugin!" << std::endl;
+        continue;
+      }
+
+      FluidWave wave;
+      wave.amplitude = waveElem->Get<double>("amplitude");
+      wave.wavenumber = 2.0 * M_PI / wavelength;
+      wave.angularFrequency = 2.0 * M_PI / period;
+      if (waveElem->HasElement("direction"))
+      {
+        wave.direction =
+            waveElem->Get<ignition::math::Vector2d>("direction");
+        wave.direction.Normalize();
+      }
+      this->waves.push_back(wave);
+    }
+  }
+
   // Get "center of volume" and "volume" that were inputted in SDF
   // SDF input is recommended for mesh or polylines collision shapes
   if (this->sdf->HasElement("link"))
@@ -118,6 +714,28 @@ void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
     }
   }
 
+  // In submersion mode, build the hulls of the links the user didn't input
+  if (this->submersion)
+  {
+    for (auto link : this->model->GetLinks())
+    {
+      if (this->volPropsMap.find(link->GetId()) != this->volPropsMap.end())
+        continue;
+
+      std::shared_ptr<BuoyancyHull> hull(new BuoyancyHull);
+      if (hull->Load(link))
+      {
+        this->hulls[link->GetId()] = hull;
+      }
+      else
+      {
+        gzwarn << "Link [" << link->GetName() << "] has collision shapes "
+               << "that BuoyancyPlugin can't submerge, using a fixed volume"
+               << std::endl;
+      }
+    }
+  }
+
   // For links the user didn't input, precompute the center of volume and
   // density. This will be accurate for simple shapes.
   for (auto link : this->model->GetLinks())
@@ -147,34 +765,17 @@ void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
 /////////////////////////////////////////////////
 void BuoyancyPlugin::Init()
 {
-  this->updateConnection = event::Events::ConnectWorldUpdateBegin(
-      std::bind(&BuoyancyPlugin::OnUpdate, this));
+  if (this->batch)
+    return;
+
+  this->batch = BuoyancyPluginBatch::Get(this->model->GetWorld());
+  this->batch->Add(this);
 }
 
 /////////////////////////////////////////////////
 void BuoyancyPlugin::OnUpdate()
 {
   IGN_PROFILE("BuoyancyPlugin::OnUpdate");
-  IGN_PROFILE_BEGIN("Update");
-  for (auto link : this->model->GetLinks())
-  {
-    VolumeProperties volumeProperties = this->volPropsMap[link->GetId()];
-    double volume = volumeProperties.volume;
-    GZ_ASSERT(volume > 0, "Nonpositive volume found in volume properties!");
-
-    // By Archimedes' principle,
-    // buoyancy = -(mass*gravity)*fluid_density/object_density
-    // object_density = mass/volume, so the mass term cancels.
-    // Therefore,
-    ignition::math::Vector3d buoyancy =
-        -this->fluidDensity * volume * this->model->GetWorld()->Gravity();
-
-    ignition::math::Pose3d linkFrame = link->WorldPose();
-    // rotate buoyancy into the link frame before applying the force.
-    ignition::math::Vector3d buoyancyLinkFrame =
-        linkFrame.Rot().Inverse().RotateVector(buoyancy);
-
-    link->AddLinkForce(buoyancyLinkFrame, volumeProperties.cov);
-  }
-  IGN_PROFILE_END();
+  if (this->batch)
+    this->batch->Evaluate({this});
 }
@@ -19,6 +19,9 @@
 #define GAZEBO_PLUGINS_BUOYANCYPLUGIN_HH_
 
 #include <map>
+#include <memory>
+#include <vector>
+#include <ignition/math/Vector2.hh>
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/common/Event.hh"
@@ -27,6 +30,9 @@
 
 namespace gazebo
 {
+  class BuoyancyHull;
+  class BuoyancyPluginBatch;
+
   /// \brief A class for storing the volume properties of a link.
   class VolumeProperties
   {
@@ -40,6 +46,26 @@ namespace gazebo
     public: double volume;
   };
 
+  /// \brief A sinusoidal wave on the surface of the fluid.
+  class FluidWave
+  {
+    /// \brief Default constructor.
+    public: FluidWave() : amplitude(0), wavenumber(0), angularFrequency(0),
+                          direction(1, 0) {}
+
+    /// \brief Amplitude in meters.
+    public: double amplitude;
+
+    /// \brief Wavenumber, 2*pi over the wavelength.
+    public: double wavenumber;
+
+    /// \brief Angular frequency, 2*pi over the period.
+    public: double angularFrequency;
+
+    /// \brief Unit direction of propagation in the XY plane.
+    public: ignition::math::Vector2d direction;
+  };
+
   /// \brief A plugin that simulates buoyancy of an object immersed in fluid.
   /// All SDF parameters are optional.
   /// <fluid_density> sets the density of the fluid that surrounds the buoyant
@@ -57,11 +83,34 @@ namespace gazebo
   /// to compute these properties from the link collision shapes. This
   /// computation will not be accurate if the object is not composed of simple
   /// collision shapes.
+  ///
+  /// <submersion> If true, the buoyancy of each link is computed every
+  /// step from the part of its collision shapes that is below the fluid
+  /// surface, and is applied at the center of that part. Boxes, spheres,
+  /// cylinders and closed meshes are supported. Links with other shapes,
+  /// or with a <link> volume block, keep the fixed volume.
+  /// <fluid_level> Height of the fluid surface at rest, 0 by default.
+  /// <wave> elements add sinusoidal waves to the fluid surface, which is
+  /// approximated by its tangent plane below each link. For example:
+  /// <wave>
+  ///   <amplitude>0.5</amplitude>
+  ///   <wavelength>20</wavelength>
+  ///   <period>5</period>
+  ///   <direction>1 0</direction>
+  /// </wave>
+  ///
+  /// The plugins of a world are evaluated together: a single world update
+  /// callback gathers the links of every instance and computes their
+  /// forces in one pass. Instances of subclasses are updated one by one
+  /// through OnUpdate.
   class GZ_PLUGIN_VISIBLE BuoyancyPlugin : public ModelPlugin
   {
     /// \brief Constructor.
     public: BuoyancyPlugin();
 
+    /// \brief Destructor.
+    public: virtual ~BuoyancyPlugin();
+
     /// \brief Read the model SDF to compute volume and center of volume for
     /// each link, and store those properties in volPropsMap.
     public: virtual void Load(physics::ModelPtr _model, sdf::ElementPtr _sdf);
@@ -69,10 +118,14 @@ namespace gazebo
     // Documentation inherited
     public: virtual void Init();
 
-    /// \brief Callback for World Update events.
+    /// \brief Compute and apply the forces of this plugin. The world
+    /// update callback evaluates the BuoyancyPlugin instances of a world
+    /// together, and calls OnUpdate of each instance of a subclass instead,
+    /// so subclasses can override it.
     protected: virtual void OnUpdate();
 
-    /// \brief Connection to World Update events.
+    /// \brief Connection to World Update events. Not used, the plugins of
+    /// a world share one connection.
     protected: event::ConnectionPtr updateConnection;
 
     /// \brief Pointer to model containing the plugin.
@@ -88,6 +141,25 @@ namespace gazebo
     /// \brief Map of <link ID, point> pairs mapping link IDs to the CoV (center
     /// of volume) and volume of the link.
     protected: std::map<int, VolumeProperties> volPropsMap;
+
+    /// \brief True to compute the submerged volume of the links each step.
+    protected: bool submersion;
+
+    /// \brief Height of the fluid surface at rest.
+    protected: double fluidLevel;
+
+    /// \brief Waves on the fluid surface.
+    protected: std::vector<FluidWave> waves;
+
+    /// \brief Map of link IDs to the hulls of their collision shapes, for
+    /// the links whose submerged volume is computed.
+    private: std::map<int, std::shared_ptr<BuoyancyHull>> hulls;
+
+    /// \brief Plugins of the world, evaluated together.
+    private: std::shared_ptr<BuoyancyPluginBatch> batch;
+
+    /// \brief The batch reads the properties of its plugins.
+    private: friend class BuoyancyPluginBatch;
   };
 }
 
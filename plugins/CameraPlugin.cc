@@ -30,12 +30,13 @@ CameraPlugin::CameraPlugin()
 CameraPlugin::~CameraPlugin()
 {
   this->newFrameConnection.reset();
+  this->newFrameHandleConnection.reset();
   this->parentSensor.reset();
   this->camera.reset();
 }
 
 /////////////////////////////////////////////////
-void CameraPlugin::Load(sensors::SensorPtr _sensor, sdf::ElementPtr /*_sdf*/)
+void CameraPlugin::Load(sensors::SensorPtr _sensor, sdf::ElementPtr _sdf)
 {
   if (!_sensor)
     gzerr << "Invalid sensor pointer.\n";
@@ -68,6 +69,14 @@ void CameraPlugin::Load(sensors::SensorPtr _sensor, sdf::ElementPtr /*_sdf*/)
         std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
         std::placeholders::_4, std::placeholders::_5));
 
+  if (_sdf && _sdf->HasElement("frame_handles") &&
+      _sdf->Get<bool>("frame_handles"))
+  {
+    this->newFrameHandleConnection = this->camera->ConnectNewImageFrameHandle(
+        std::bind(&CameraPlugin::OnNewFrameHandle, this,
+          std::placeholders::_1));
+  }
+
   this->parentSensor->SetActive(true);
 }
 
@@ -83,3 +92,8 @@ void CameraPlugin::OnNewFrame(const unsigned char * /*_image*/,
     "/tmp/camera/me.jpg");
     */
 }
+
+/////////////////////////////////////////////////
+void CameraPlugin::OnNewFrameHandle(rendering::FramePtr /*_frame*/)
+{
+}
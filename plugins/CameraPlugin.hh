@@ -26,6 +26,12 @@
 
 namespace gazebo
 {
+  /// \brief Base plugin for camera sensors.
+  ///
+  /// Set <frame_handles>true</frame_handles> to also receive every image
+  /// as a rendering::FramePtr through OnNewFrameHandle. The frame is shared
+  /// with the camera and not overwritten while it is held, so derived
+  /// plugins can keep or publish it without copying the image.
   class GZ_PLUGIN_VISIBLE CameraPlugin : public SensorPlugin
   {
     public: CameraPlugin();
@@ -39,6 +45,11 @@ namespace gazebo
                               unsigned int _width, unsigned int _height,
                               unsigned int _depth, const std::string &_format);
 
+    /// \brief Called with a shared frame for every new image when
+    /// <frame_handles> is enabled.
+    /// \param[in] _frame The new image.
+    public: virtual void OnNewFrameHandle(rendering::FramePtr _frame);
+
     protected: unsigned int width, height, depth;
     protected: std::string format;
 
@@ -46,6 +57,9 @@ namespace gazebo
     protected: rendering::CameraPtr camera;
 
     private: event::ConnectionPtr newFrameConnection;
+
+    /// \brief Connection to the camera's frame handle event.
+    private: event::ConnectionPtr newFrameHandleConnection;
   };
 }
 #endif
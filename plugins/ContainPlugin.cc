@@ -15,8 +15,10 @@
  *
 */
 
+#include <cmath>
 #include <string>
 
+#include <ignition/math/Matrix3.hh>
 #include <ignition/math/OrientedBox.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/msgs/boolean.pb.h>
@@ -26,6 +28,8 @@
 #include "gazebo/common/UpdateInfo.hh"
 
 #include "gazebo/physics/Entity.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/TriggerVolumes.hh"
 #include "gazebo/physics/World.hh"
 
 #include "ContainPlugin.hh"
@@ -74,6 +78,16 @@ namespace gazebo
 
     /// \brief 1 if contains, 0 if doesn't contain, -1 if unset
     public: int contain = -1;
+
+    /// \brief True while the plugin is enabled.
+    public: bool enabled = false;
+
+    /// \brief Trigger volumes of the world, used when the box does not
+    /// move.
+    public: physics::TriggerVolumesPtr triggers;
+
+    /// \brief Id of the trigger volume around the box.
+    public: unsigned int triggerId = 0;
   };
 }
 
@@ -182,14 +196,14 @@ bool ContainPlugin::EnableIgn(const ignition::msgs::Boolean &_req,
 bool ContainPlugin::Enable(const bool _enable)
 {
   // Already started
-  if (_enable && this->dataPtr->updateConnection)
+  if (_enable && this->dataPtr->enabled)
   {
     gzwarn << "Contain plugin is already enabled." << std::endl;
     return false;
   }
 
   // Already stopped
-  if (!_enable && !this->dataPtr->updateConnection)
+  if (!_enable && !this->dataPtr->enabled)
   {
     gzwarn << "Contain plugin is already disabled." << std::endl;
     return false;
@@ -198,15 +212,34 @@ bool ContainPlugin::Enable(const bool _enable)
   // Start
   if (_enable)
   {
-    // Start update
-    this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
-        std::bind(&ContainPlugin::OnUpdate, this, std::placeholders::_1));
+    this->dataPtr->enabled = true;
 
     auto topic = "/" + this->dataPtr->ns + "/contain";
 
     this->dataPtr->containIgnPub =
         this->dataPtr->ignNode.Advertise<ignition::msgs::Boolean>(topic);
 
+    if (this->dataPtr->containerEntityName.empty())
+    {
+      // A box fixed in the world only needs checking while the entity's
+      // model overlaps it, the trigger volume reports when that starts.
+      this->dataPtr->triggers = this->dataPtr->world->TriggerVolumes();
+      this->dataPtr->triggerId = this->dataPtr->triggers->Add(
+          this->WorldBox(), std::bind(&ContainPlugin::OnTrigger, this,
+            std::placeholders::_1, std::placeholders::_2));
+
+      physics::ModelPtr model = this->EntityModel();
+      if (model && model->BoundingBox().Intersects(this->WorldBox()))
+        this->Track(true);
+      else
+        this->PublishContains(false);
+    }
+    else
+    {
+      // The box moves with its frame, check every iteration
+      this->Track(true);
+    }
+
     gzmsg << "Started contain plugin [" << this->dataPtr->ns << "]"
           << std::endl;
 
@@ -215,7 +248,13 @@ bool ContainPlugin::Enable(const bool _enable)
 
   // Stop
   {
-    this->dataPtr->updateConnection.reset();
+    this->dataPtr->enabled = false;
+    if (this->dataPtr->triggers)
+    {
+      this->dataPtr->triggers->Remove(this->dataPtr->triggerId);
+      this->dataPtr->triggers.reset();
+    }
+    this->Track(false);
     this->dataPtr->containIgnPub = ignition::transport::Node::Publisher();
     this->dataPtr->contain = -1;
 
@@ -226,6 +265,76 @@ bool ContainPlugin::Enable(const bool _enable)
   }
 }
 
+/////////////////////////////////////////////////
+void ContainPlugin::Track(const bool _track)
+{
+  if (_track && !this->dataPtr->updateConnection)
+  {
+    this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&ContainPlugin::OnUpdate, this, std::placeholders::_1));
+  }
+  else if (!_track)
+  {
+    this->dataPtr->updateConnection.reset();
+  }
+}
+
+/////////////////////////////////////////////////
+ignition::math::AxisAlignedBox ContainPlugin::WorldBox() const
+{
+  const auto &box = this->dataPtr->box;
+  const ignition::math::Matrix3d rot(box.Pose().Rot());
+  const ignition::math::Vector3d half = box.Size() * 0.5;
+
+  // Extent of the rotated box along each world axis
+  ignition::math::Vector3d extent;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    extent[i] = std::abs(rot(i, 0)) * half.X() +
+      std::abs(rot(i, 1)) * half.Y() + std::abs(rot(i, 2)) * half.Z();
+  }
+
+  return ignition::math::AxisAlignedBox(box.Pose().Pos() - extent,
+      box.Pose().Pos() + extent);
+}
+
+/////////////////////////////////////////////////
+physics::ModelPtr ContainPlugin::EntityModel()
+{
+  physics::EntityPtr entity = this->dataPtr->entity.lock();
+  if (!entity)
+  {
+    this->dataPtr->entity = this->dataPtr->world->EntityByName(
+        this->dataPtr->entityName);
+    entity = this->dataPtr->entity.lock();
+  }
+
+  return entity ? entity->GetParentModel() : physics::ModelPtr();
+}
+
+/////////////////////////////////////////////////
+void ContainPlugin::OnTrigger(const physics::ModelPtr &_model,
+    const bool _inside)
+{
+  physics::ModelPtr model = this->EntityModel();
+  if (!model)
+  {
+    // The entity was removed
+    this->Track(false);
+    this->PublishContains(false);
+    return;
+  }
+
+  if (model != _model)
+    return;
+
+  // The origin may still be outside the box while the model's bounding box
+  // overlaps it, so check it every iteration until the model leaves.
+  this->Track(_inside);
+  if (!_inside)
+    this->PublishContains(false);
+}
+
 /////////////////////////////////////////////////
 void ContainPlugin::OnUpdate(const common::UpdateInfo &/*_info*/)
 {
@@ -20,6 +20,8 @@
 
 #include <memory>
 
+#include <ignition/math/AxisAlignedBox.hh>
+
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/msgs/msgs.hh"
 
@@ -31,6 +33,11 @@ namespace gazebo
   /// an entity's origin is inside or outside a given volume. A message is only
   /// published when the state changes.
   ///
+  /// A volume fixed in the world is watched through the world's trigger
+  /// volumes, and the entity is only checked every iteration while its
+  /// model's bounding box overlaps the volume. A volume attached to a frame
+  /// is checked every iteration.
+  ///
   /// Example usage:
   ///
   ///  <plugin name="containRobotArm" filename="libContainPlugin.so">
@@ -74,10 +81,30 @@ namespace gazebo
     // Documentation inherited
     public: void Load(physics::WorldPtr _world, sdf::ElementPtr _sdf) override;
 
-    /// \brief Called every world iteration on world update begin.
+    /// \brief Called every world iteration on world update begin, while
+    /// the entity may be inside the box.
     /// \param[in] _info Update info.
     private: void OnUpdate(const common::UpdateInfo &_info);
 
+    /// \brief Called when a model enters or leaves the trigger volume
+    /// around a box fixed in the world.
+    /// \param[in] _model The model.
+    /// \param[in] _inside True if the model entered the volume.
+    private: void OnTrigger(const physics::ModelPtr &_model,
+                 const bool _inside);
+
+    /// \brief Start or stop checking the entity every iteration.
+    /// \param[in] _track True to check every iteration.
+    private: void Track(const bool _track);
+
+    /// \brief Get the world axis aligned box around the volume.
+    /// \return Box around the volume.
+    private: ignition::math::AxisAlignedBox WorldBox() const;
+
+    /// \brief Get the model of the entity being checked.
+    /// \return The model, null if the entity is not found.
+    private: physics::ModelPtr EntityModel();
+
     /// \brief Enables or disables the plugin.
     /// \param[in] _enable False to disable and true to enable the plugin.
     /// \return True when the operation succeed or false otherwise
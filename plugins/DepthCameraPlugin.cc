@@ -43,6 +43,7 @@ DepthCameraPlugin::~DepthCameraPlugin()
   this->newDepthFrameConnection.reset();
   this->newRGBPointCloudConnection.reset();
   this->newImageFrameConnection.reset();
+  this->newDepthFrameHandleConnection.reset();
 
   std::lock_guard<std::mutex> guard{global_maps_mutex};
   connection_reflectance_map.erase(this);
@@ -54,7 +55,7 @@ DepthCameraPlugin::~DepthCameraPlugin()
 
 /////////////////////////////////////////////////
 void DepthCameraPlugin::Load(sensors::SensorPtr _sensor,
-                              sdf::ElementPtr /*_sdf*/)
+                              sdf::ElementPtr _sdf)
 {
   this->parentSensor =
     std::dynamic_pointer_cast<sensors::DepthCameraSensor>(_sensor);
@@ -76,6 +77,15 @@ void DepthCameraPlugin::Load(sensors::SensorPtr _sensor,
         this, std::placeholders::_1, std::placeholders::_2,
         std::placeholders::_3, std::placeholders::_4, std::placeholders::_5));
 
+  if (_sdf && _sdf->HasElement("frame_handles") &&
+      _sdf->Get<bool>("frame_handles"))
+  {
+    this->newDepthFrameHandleConnection =
+      this->depthCamera->ConnectNewDepthFrameHandle(
+          std::bind(&DepthCameraPlugin::OnNewDepthFrameHandle, this,
+            std::placeholders::_1));
+  }
+
   this->newRGBPointCloudConnection = this->depthCamera->ConnectNewRGBPointCloud(
       std::bind(&DepthCameraPlugin::OnNewRGBPointCloud,
         this, std::placeholders::_1, std::placeholders::_2,
@@ -138,6 +148,11 @@ void DepthCameraPlugin::OnNewDepthFrame(const float *_image,
     */
 }
 
+/////////////////////////////////////////////////
+void DepthCameraPlugin::OnNewDepthFrameHandle(rendering::FramePtr /*_frame*/)
+{
+}
+
 /////////////////////////////////////////////////
 void DepthCameraPlugin::OnNewRGBPointCloud(const float * /*_pcd*/,
                 unsigned int /*_width*/, unsigned int /*_height*/,
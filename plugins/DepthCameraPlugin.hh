@@ -28,6 +28,11 @@
 
 namespace gazebo
 {
+  /// \brief Base plugin for depth camera sensors.
+  ///
+  /// Set <frame_handles>true</frame_handles> to also receive every depth
+  /// image as a rendering::FramePtr through OnNewDepthFrameHandle. The
+  /// frame is shared with the camera and not overwritten while it is held.
   class GZ_PLUGIN_VISIBLE DepthCameraPlugin : public SensorPlugin
   {
     /// \brief Constructor
@@ -42,6 +47,11 @@ namespace gazebo
                 unsigned int _width, unsigned int _height,
                 unsigned int _depth, const std::string &_format);
 
+    /// \brief Called with a shared frame for every new depth image when
+    /// <frame_handles> is enabled.
+    /// \param[in] _frame The new depth image, one float per pixel.
+    public: virtual void OnNewDepthFrameHandle(rendering::FramePtr _frame);
+
     /// \brief Update the controller
     public: virtual void OnNewRGBPointCloud(const float *_pcd,
                 unsigned int _width, unsigned int _height,
@@ -70,6 +80,9 @@ namespace gazebo
     private: event::ConnectionPtr newDepthFrameConnection;
     private: event::ConnectionPtr newRGBPointCloudConnection;
     private: event::ConnectionPtr newImageFrameConnection;
+
+    /// \brief Connection to the depth camera's depth frame handle event.
+    private: event::ConnectionPtr newDepthFrameHandleConnection;
   };
 }
 #endif
@@ -17,9 +17,9 @@
 
 #include <functional>
 
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/AxisAlignedBox.hh>
 
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/physics.hh"
 #include "gazebo/transport/transport.hh"
 #include "plugins/DiffDrivePlugin.hh"
@@ -67,7 +67,8 @@ void DiffDrivePlugin::Load(physics::ModelPtr _model,
     gzerr << "Unable to find right joint["
           << _sdf->GetElement("right_joint")->Get<std::string>() << "]\n";
 
-  this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+  // OnUpdate only sets the velocities of the model's own joints.
+  this->updateConnection = event::Events::ConnectWorldUpdateBeginModelLocal(
           std::bind(&DiffDrivePlugin::OnUpdate, this));
 }
 
@@ -18,7 +18,7 @@
 #include <vector>
 #include <functional>
 
-#include <ignition/common/Profiler.hh>
+#include "gazebo/common/TraceCapture.hh"
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Vector2.hh>
 
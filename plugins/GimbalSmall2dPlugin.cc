@@ -17,8 +17,8 @@
 #include <string>
 #include <vector>
 
-#include "ignition/common/Profiler.hh"
 #include "gazebo/common/PID.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/physics.hh"
 #include "gazebo/transport/transport.hh"
 #include "GimbalSmall2dPlugin.hh"
@@ -15,6 +15,7 @@
  *
 */
 #include <functional>
+#include "gazebo/rendering/GpuLaser.hh"
 #include "plugins/GpuRayPlugin.hh"
 #include "gazebo/sensors/GpuRaySensor.hh"
 
@@ -31,11 +32,12 @@ GpuRayPlugin::GpuRayPlugin()
 GpuRayPlugin::~GpuRayPlugin()
 {
   this->newLaserFrameConnection.reset();
+  this->newLaserFrameHandleConnection.reset();
 }
 
 /////////////////////////////////////////////////
 void GpuRayPlugin::Load(sensors::SensorPtr _sensor,
-                              sdf::ElementPtr /*_sdf*/)
+                              sdf::ElementPtr _sdf)
 {
   this->parentSensor =
     std::dynamic_pointer_cast<sensors::GpuRaySensor>(_sensor);
@@ -54,6 +56,15 @@ void GpuRayPlugin::Load(sensors::SensorPtr _sensor,
         std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
         std::placeholders::_4, std::placeholders::_5));
 
+  if (_sdf && _sdf->HasElement("frame_handles") &&
+      _sdf->Get<bool>("frame_handles"))
+  {
+    this->newLaserFrameHandleConnection =
+      this->parentSensor->LaserCamera()->ConnectNewLaserFrameHandle(
+          std::bind(&GpuRayPlugin::OnNewLaserFrameHandle, this,
+            std::placeholders::_1));
+  }
+
   this->parentSensor->SetActive(true);
 }
 
@@ -63,3 +74,8 @@ void GpuRayPlugin::OnNewLaserFrame(const float * /*_image*/,
     unsigned int /*_depth*/, const std::string &/*_format*/)
 {
 }
+
+/////////////////////////////////////////////////
+void GpuRayPlugin::OnNewLaserFrameHandle(rendering::FramePtr /*_frame*/)
+{
+}
@@ -27,6 +27,11 @@
 
 namespace gazebo
 {
+  /// \brief Base plugin for GPU ray sensors.
+  ///
+  /// Set <frame_handles>true</frame_handles> to also receive every laser
+  /// frame as a rendering::FramePtr through OnNewLaserFrameHandle. The
+  /// frame is shared with the sensor and not overwritten while it is held.
   class GZ_PLUGIN_VISIBLE GpuRayPlugin : public SensorPlugin
   {
     public: GpuRayPlugin();
@@ -39,11 +44,19 @@ namespace gazebo
                 unsigned int _width, unsigned int _height,
                 unsigned int _depth, const std::string &_format);
 
+    /// \brief Called with a shared frame for every new laser frame when
+    /// <frame_handles> is enabled.
+    /// \param[in] _frame The new laser frame, three floats per ray.
+    public: virtual void OnNewLaserFrameHandle(rendering::FramePtr _frame);
+
     protected: unsigned int width, height/*, depth*/;
 
     protected: sensors::GpuRaySensorPtr parentSensor;
 
     private: event::ConnectionPtr newLaserFrameConnection;
+
+    /// \brief Connection to the laser's frame handle event.
+    private: event::ConnectionPtr newLaserFrameHandleConnection;
   };
 }
 #endif
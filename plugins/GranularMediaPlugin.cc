@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Events.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/transport/transport.hh"
+
+#include "plugins/GranularMediaPlugin.hh"
+
+namespace gazebo
+{
+  /// \brief A collision of a link coupled to the grains.
+  class GranularMediaCollision
+  {
+    /// \brief The collision.
+    public: physics::CollisionPtr collision;
+
+    /// \brief Link of the collision.
+    public: physics::LinkPtr link;
+
+    /// \brief Index of the body of the collision in the grains.
+    public: size_t body = 0;
+  };
+
+  /// \brief Private data class for the GranularMediaPlugin class
+  class GranularMediaPluginPrivate
+  {
+    /// \brief Connection to world update.
+    public: event::ConnectionPtr updateConnection;
+
+    /// \brief Pointer to the world.
+    public: physics::WorldPtr world;
+
+    /// \brief The grains.
+    public: physics::GranularMedia media;
+
+    /// \brief Scoped names of the links that were not found yet.
+    public: std::vector<std::string> linkNames;
+
+    /// \brief Collisions coupled to the grains.
+    public: std::vector<GranularMediaCollision> collisions;
+
+    /// \brief Sim time of the last update.
+    public: common::Time lastTime;
+
+    /// \brief Transport node.
+    public: transport::NodePtr node;
+
+    /// \brief Publisher of the point cloud of the grains.
+    public: transport::PublisherPtr pub;
+
+    /// \brief Period of the point cloud, 0 to not publish.
+    public: common::Time publishPeriod;
+
+    /// \brief Sim time of the last point cloud.
+    public: common::Time lastPublishTime;
+
+    /// \brief Locations of the grains, reused by each point cloud.
+    public: std::vector<ignition::math::Vector3d> positions;
+  };
+}
+
+using namespace gazebo;
+
+GZ_REGISTER_WORLD_PLUGIN(GranularMediaPlugin)
+
+/////////////////////////////////////////////////
+GranularMediaPlugin::GranularMediaPlugin()
+  : dataPtr(new GranularMediaPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+GranularMediaPlugin::~GranularMediaPlugin()
+{
+  this->dataPtr->updateConnection.reset();
+  if (this->dataPtr->node)
+    this->dataPtr->node->Fini();
+}
+
+/////////////////////////////////////////////////
+void GranularMediaPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
+{
+  GZ_ASSERT(_world, "GranularMediaPlugin world pointer is NULL");
+  GZ_ASSERT(_sdf, "GranularMediaPlugin sdf pointer is NULL");
+  this->dataPtr->world = _world;
+
+  physics::GranularMedia &media = this->dataPtr->media;
+  if (_sdf->HasElement("density"))
+    media.SetDensity(_sdf->Get<double>("density"));
+  if (_sdf->HasElement("stiffness"))
+    media.SetStiffness(_sdf->Get<double>("stiffness"));
+  if (_sdf->HasElement("restitution"))
+    media.SetRestitution(_sdf->Get<double>("restitution"));
+  if (_sdf->HasElement("friction"))
+    media.SetFriction(_sdf->Get<double>("friction"));
+  media.SetGravity(_world->Gravity());
+
+  const double radius = _sdf->Get<double>("grain_radius", 0.02).first;
+  if (radius <= 0)
+  {
+    gzerr << "GranularMediaPlugin <grain_radius> must be positive\n";
+    return;
+  }
+
+  for (auto region = _sdf->HasElement("region") ?
+       _sdf->GetElement("region") : sdf::ElementPtr(); region;
+       region = region->GetNextElement("region"))
+  {
+    if (!region->HasElement("min") || !region->HasElement("max"))
+    {
+      gzerr << "GranularMediaPlugin <region> requires a <min> and a <max>\n";
+      continue;
+    }
+    media.FillBox(region->Get<ignition::math::Vector3d>("min"),
+        region->Get<ignition::math::Vector3d>("max"), radius);
+  }
+
+  if (media.GrainCount() == 0)
+  {
+    gzerr << "GranularMediaPlugin has no grains, add a <region>\n";
+    return;
+  }
+
+  media.AddPlane(ignition::math::Vector3d::UnitZ,
+      _sdf->Get<double>("ground", 0.0).first);
+
+  for (auto link = _sdf->HasElement("link") ?
+       _sdf->GetElement("link") : sdf::ElementPtr(); link;
+       link = link->GetNextElement("link"))
+  {
+    this->dataPtr->linkNames.push_back(link->Get<std::string>());
+  }
+
+  const double rate = _sdf->Get<double>("publish_rate", 10.0).first;
+  if (rate > 0)
+  {
+    this->dataPtr->publishPeriod = common::Time(1.0 / rate);
+    this->dataPtr->node = transport::NodePtr(new transport::Node());
+    this->dataPtr->node->Init(_world->Name());
+    this->dataPtr->pub = this->dataPtr->node->Advertise<msgs::PointCloud>(
+        _sdf->Get<std::string>("topic", "~/granular_media").first);
+  }
+
+  gzmsg << "GranularMediaPlugin simulating " << media.GrainCount()
+        << " grains, critical time step " << media.CriticalTimeStep()
+        << " s\n";
+
+  this->dataPtr->lastTime = _world->SimTime();
+  this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
+      std::bind(&GranularMediaPlugin::OnUpdate, this, std::placeholders::_1));
+}
+
+/////////////////////////////////////////////////
+void GranularMediaPlugin::FindLinks()
+{
+  // Links of models inserted after the plugin are found once they exist.
+  auto name = this->dataPtr->linkNames.begin();
+  while (name != this->dataPtr->linkNames.end())
+  {
+    physics::LinkPtr link = boost::dynamic_pointer_cast<physics::Link>(
+        this->dataPtr->world->EntityByName(*name));
+    if (!link)
+    {
+      ++name;
+      continue;
+    }
+
+    for (const auto &collision : link->GetCollisions())
+    {
+      physics::ShapePtr shape = collision->GetShape();
+      GranularMediaCollision coupled;
+      coupled.collision = collision;
+      coupled.link = link;
+      if (collision->GetShapeType() & physics::Base::BOX_SHAPE)
+      {
+        coupled.body = this->dataPtr->media.AddBoxBody(
+            boost::dynamic_pointer_cast<physics::BoxShape>(shape)->Size());
+      }
+      else if (collision->GetShapeType() & physics::Base::SPHERE_SHAPE)
+      {
+        coupled.body = this->dataPtr->media.AddSphereBody(
+            boost::dynamic_pointer_cast<physics::SphereShape>(
+              shape)->GetRadius());
+      }
+      else if (collision->GetShapeType() & physics::Base::CYLINDER_SHAPE)
+      {
+        auto cylinder =
+            boost::dynamic_pointer_cast<physics::CylinderShape>(shape);
+        coupled.body = this->dataPtr->media.AddCylinderBody(
+            cylinder->GetRadius(), cylinder->GetLength());
+      }
+      else
+      {
+        gzwarn << "GranularMediaPlugin ignores collision ["
+               << collision->GetScopedName()
+               << "], only boxes, spheres and cylinders touch the grains\n";
+        continue;
+      }
+      this->dataPtr->collisions.push_back(coupled);
+    }
+    name = this->dataPtr->linkNames.erase(name);
+  }
+}
+
+/////////////////////////////////////////////////
+void GranularMediaPlugin::OnUpdate(const common::UpdateInfo &_info)
+{
+  const double dt = (_info.simTime - this->dataPtr->lastTime).Double();
+  this->dataPtr->lastTime = _info.simTime;
+
+  // Time went backwards after a reset, or the world is paused.
+  if (dt <= 0)
+    return;
+
+  if (!this->dataPtr->linkNames.empty())
+    this->FindLinks();
+
+  physics::GranularMedia &media = this->dataPtr->media;
+  for (const auto &coupled : this->dataPtr->collisions)
+  {
+    media.SetBodyState(coupled.body, coupled.collision->WorldPose(),
+        coupled.collision->WorldLinearVel(),
+        coupled.collision->WorldAngularVel());
+  }
+
+  media.Step(dt);
+
+  // The forces act about the center of each collision.
+  for (const auto &coupled : this->dataPtr->collisions)
+  {
+    coupled.link->AddForceAtWorldPosition(media.BodyForce(coupled.body),
+        coupled.collision->WorldPose().Pos());
+    coupled.link->AddTorque(media.BodyTorque(coupled.body));
+  }
+
+  if (this->dataPtr->pub && this->dataPtr->pub->HasConnections() &&
+      _info.simTime - this->dataPtr->lastPublishTime >=
+      this->dataPtr->publishPeriod)
+  {
+    this->dataPtr->lastPublishTime = _info.simTime;
+    media.GrainPositions(this->dataPtr->positions);
+
+    msgs::PointCloud msg;
+    for (const auto &pos : this->dataPtr->positions)
+      msgs::Set(msg.add_points(), pos);
+    this->dataPtr->pub->Publish(msg);
+  }
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_GRANULARMEDIAPLUGIN_HH_
+#define GAZEBO_PLUGINS_GRANULARMEDIAPLUGIN_HH_
+
+#include <memory>
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/common/UpdateInfo.hh"
+
+namespace gazebo
+{
+  // Forward declare private data class.
+  class GranularMediaPluginPrivate;
+
+  /// \brief A plugin that fills regions of the world with grains of sand,
+  /// soil or rubble, simulated with physics::GranularMedia, and couples
+  /// them to links. Each world step, the grains are advanced with the pose
+  /// and velocity of the box, sphere and cylinder collisions of the links,
+  /// and the forces of the grains are applied back to the links. It is an
+  /// alternative to RubblePlugin and MudPlugin for vehicles and tools that
+  /// dig into or roll over loose terrain.
+  ///
+  /// Example:
+  ///
+  ///    <plugin name="sand" filename="libGranularMediaPlugin.so">
+  ///      <!-- Radius of the grains, defaults to 0.02 m -->
+  ///      <grain_radius>0.02</grain_radius>
+  ///      <!-- Density of the grains, defaults to 2600 kg/m^3 -->
+  ///      <density>2600</density>
+  ///      <!-- Contact stiffness, defaults to 1e4 N/m -->
+  ///      <stiffness>1e4</stiffness>
+  ///      <!-- Coefficient of restitution, defaults to 0.3 -->
+  ///      <restitution>0.3</restitution>
+  ///      <!-- Friction coefficient, defaults to 0.5 -->
+  ///      <friction>0.5</friction>
+  ///      <!-- Boxes filled with grains, can be repeated -->
+  ///      <region>
+  ///        <min>-1 -1 0</min>
+  ///        <max>1 1 0.2</max>
+  ///      </region>
+  ///      <!-- Height of the ground under the grains, defaults to 0 -->
+  ///      <ground>0</ground>
+  ///      <!-- Links in contact with the grains, can be repeated -->
+  ///      <link>rover::wheel_front_left</link>
+  ///      <!-- Topic of the point cloud of the grains, defaults to
+  ///           ~/granular_media -->
+  ///      <topic>~/granular_media</topic>
+  ///      <!-- Rate of the point cloud in Hz, defaults to 10, 0 to not
+  ///           publish -->
+  ///      <publish_rate>10</publish_rate>
+  ///    </plugin>
+  class GZ_PLUGIN_VISIBLE GranularMediaPlugin : public WorldPlugin
+  {
+    /// \brief Constructor.
+    public: GranularMediaPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~GranularMediaPlugin();
+
+    // Documentation inherited
+    public: virtual void Load(physics::WorldPtr _world, sdf::ElementPtr _sdf);
+
+    /// \brief Advance the grains, called at the start of each world update.
+    /// \param[in] _info World update information.
+    private: void OnUpdate(const common::UpdateInfo &_info);
+
+    /// \brief Add the collisions of the links that were not found yet.
+    private: void FindLinks();
+
+    /// \internal
+    /// \brief Private data pointer.
+    private: std::unique_ptr<GranularMediaPluginPrivate> dataPtr;
+  };
+}
+#endif
@@ -36,6 +36,9 @@ namespace gazebo
 
     /// \brief Default skirt length
     public: double skirtLength = 1.0;
+
+    /// \brief True to render the heightmap with a GPU clipmap.
+    public: bool clipmap = false;
   };
 }
 
@@ -92,6 +95,16 @@ void HeightmapLODPlugin::Load(rendering::VisualPtr _visual,
     this->dataPtr->skirtLength = serverGui->Get<double>("skirt_length");
   }
 
+  if (_sdf->HasElement("clipmap"))
+  {
+    this->dataPtr->clipmap = _sdf->Get<bool>("clipmap");
+  }
+  else if (serverGui && serverGui->HasElement("clipmap"))
+  {
+    this->dataPtr->clipmap = serverGui->Get<bool>("clipmap");
+  }
+
   scene->SetHeightmapLOD(this->dataPtr->lod);
   scene->SetHeightmapSkirtLength(this->dataPtr->skirtLength);
+  scene->SetHeightmapClipmapEnabled(this->dataPtr->clipmap);
 }
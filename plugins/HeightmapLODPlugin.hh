@@ -28,6 +28,9 @@ namespace gazebo
   /// \brief Plugin that sets the heightmap Level of Detail (LOD) parameters.
   /// `lod`: a render-engine specific value used to compute Level of Detail.
   /// `skirt_length`: length of skirts on LOD tiles.
+  /// `clipmap`: true to render the heightmap with a GPU clipmap instead of
+  /// the Ogre terrain, see rendering::Heightmap::SetClipmapEnabled. The
+  /// `lod` and `skirt_length` parameters do not apply to the clipmap.
   /// These parameters can be set uniformly for all scenes in a simulation
   /// by specifying the parameters directly under the <plugin /> element:
   /** \verbatim
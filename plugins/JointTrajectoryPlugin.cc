@@ -17,8 +17,7 @@
 
 #include <functional>
 
-#include <ignition/common/Profiler.hh>
-
+#include "gazebo/common/TraceCapture.hh"
 #include <plugins/JointTrajectoryPlugin.hh>
 
 namespace gazebo
@@ -16,22 +16,392 @@
 */
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <string>
+#include <typeinfo>
+#include <vector>
 
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Pose3.hh>
 
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/physics.hh"
 #include "gazebo/sensors/SensorManager.hh"
 #include "gazebo/transport/transport.hh"
 #include "plugins/LiftDragPlugin.hh"
 
+namespace gazebo
+{
+  /// \brief Lift drag plugins of one world. The links of all the plugins
+  /// are gathered into arrays each step, so that the forces are computed
+  /// in a single loop over contiguous data the compiler can vectorize.
+  class LiftDragPluginBatch
+  {
+    /// \brief Get the batch of a world, creating it if needed.
+    /// \param[in] _world The world.
+    /// \return The batch shared by the plugins of the world.
+    public: static std::shared_ptr<LiftDragPluginBatch> Get(
+                const physics::WorldPtr &_world);
+
+    /// \brief Add a plugin to the batch.
+    /// \param[in] _plugin Plugin to evaluate each step.
+    public: void Add(LiftDragPlugin *_plugin);
+
+    /// \brief Remove a plugin from the batch.
+    /// \param[in] _plugin Plugin to remove.
+    public: void Remove(LiftDragPlugin *_plugin);
+
+    /// \brief Compute and apply the forces of plugins.
+    /// \param[in] _plugins The plugins.
+    public: void Evaluate(const std::vector<LiftDragPlugin *> &_plugins);
+
+    /// \brief Callback for World Update events.
+    private: void OnUpdate();
+
+    /// \brief Resize the arrays.
+    /// \param[in] _size Number of plugins.
+    private: void Resize(const size_t _size);
+
+    /// \brief The world of the plugins.
+    private: physics::WorldPtr world;
+
+    /// \brief Plugins of the world that are LiftDragPlugin instances.
+    private: std::vector<LiftDragPlugin *> plugins;
+
+    /// \brief Plugins of the world that are instances of a subclass, which
+    /// may override LiftDragPlugin::OnUpdate.
+    private: std::vector<LiftDragPlugin *> subclassPlugins;
+
+    /// \brief Protects plugins and subclassPlugins.
+    private: std::mutex mutex;
+
+    /// \brief Connection to World Update events.
+    private: event::ConnectionPtr updateConnection;
+
+    /// \brief Linear velocity at the center of pressure of each link, in
+    /// the world frame, one array per axis.
+    private: std::vector<double> vx, vy, vz;
+
+    /// \brief Orientation of each link, one array per quaternion component.
+    private: std::vector<double> qw, qx, qy, qz;
+
+    /// \brief Forward directions in the link frame.
+    private: std::vector<double> forwardX, forwardY, forwardZ;
+
+    /// \brief Upward directions in the link frame.
+    private: std::vector<double> upwardX, upwardY, upwardZ;
+
+    /// \brief 1 if the shape is radially symmetric, 0 otherwise.
+    private: std::vector<double> radial;
+
+    /// \brief Coefficients of the plugins.
+    private: std::vector<double> alpha0, cla, cda, claStall, cdaStall;
+
+    /// \brief Stall angle of the plugins.
+    private: std::vector<double> alphaStall;
+
+    /// \brief Half of the fluid density times the area of the plugins.
+    private: std::vector<double> qScale;
+
+    /// \brief Lift coefficient added by the control joint.
+    private: std::vector<double> clControl;
+
+    /// \brief Computed sine of the sweep angle and angle of attack.
+    private: std::vector<double> sinSweep, alpha;
+
+    /// \brief Computed force in the world frame, one array per axis.
+    private: std::vector<double> fx, fy, fz;
+  };
+}
+
+/////////////////////////////////////////////////
+/// \brief Rotate a vector by a unit quaternion.
+static inline void rotate(const double _w, const double _x, const double _y,
+    const double _z, const double _vx, const double _vy, const double _vz,
+    double &_ox, double &_oy, double &_oz)
+{
+  // v' = v + w*t + q.xyz x t, with t = 2 q.xyz x v
+  const double tx = 2.0 * (_y * _vz - _z * _vy);
+  const double ty = 2.0 * (_z * _vx - _x * _vz);
+  const double tz = 2.0 * (_x * _vy - _y * _vx);
+  _ox = _vx + _w * tx + (_y * tz - _z * ty);
+  _oy = _vy + _w * ty + (_z * tx - _x * tz);
+  _oz = _vz + _w * tz + (_x * ty - _y * tx);
+}
+
+/////////////////////////////////////////////////
+/// \brief Normalize a vector in place, like ignition::math::Vector3::Normalize
+/// which leaves vectors of zero length unchanged.
+static inline void normalize(double &_x, double &_y, double &_z)
+{
+  const double length = std::sqrt(_x * _x + _y * _y + _z * _z);
+  const double scale = length > 1e-6 ? 1.0 / length : 1.0;
+  _x *= scale;
+  _y *= scale;
+  _z *= scale;
+}
+
+/////////////////////////////////////////////////
+/// \brief Wrap an angle to within +/-90 deg by steps of 180 deg.
+static inline double wrapHalfPi(const double _angle)
+{
+  const double above = _angle - M_PI * std::ceil((_angle - 0.5 * M_PI) / M_PI);
+  const double below = _angle + M_PI * std::ceil((-0.5 * M_PI - _angle) / M_PI);
+  return _angle > 0.5 * M_PI ? above : (_angle < -0.5 * M_PI ? below : _angle);
+}
+
 using namespace gazebo;
 
 GZ_REGISTER_MODEL_PLUGIN(LiftDragPlugin)
 
+/////////////////////////////////////////////////
+std::shared_ptr<LiftDragPluginBatch> LiftDragPluginBatch::Get(
+    const physics::WorldPtr &_world)
+{
+  static std::mutex batchesMutex;
+  static std::map<std::string, std::weak_ptr<LiftDragPluginBatch>> batches;
+
+  std::lock_guard<std::mutex> lock(batchesMutex);
+  std::shared_ptr<LiftDragPluginBatch> batch = batches[_world->Name()].lock();
+  if (!batch || batch->world != _world)
+  {
+    batch.reset(new LiftDragPluginBatch);
+    batch->world = _world;
+    batch->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&LiftDragPluginBatch::OnUpdate, batch.get()));
+    batches[_world->Name()] = batch;
+  }
+  return batch;
+}
+
+/////////////////////////////////////////////////
+void LiftDragPluginBatch::Add(LiftDragPlugin *_plugin)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (typeid(*_plugin) == typeid(LiftDragPlugin))
+    this->plugins.push_back(_plugin);
+  else
+    this->subclassPlugins.push_back(_plugin);
+}
+
+/////////////////////////////////////////////////
+void LiftDragPluginBatch::Remove(LiftDragPlugin *_plugin)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->plugins.erase(std::remove(this->plugins.begin(), this->plugins.end(),
+        _plugin), this->plugins.end());
+  this->subclassPlugins.erase(std::remove(this->subclassPlugins.begin(),
+        this->subclassPlugins.end(), _plugin), this->subclassPlugins.end());
+}
+
+/////////////////////////////////////////////////
+void LiftDragPluginBatch::Resize(const size_t _size)
+{
+  for (auto array : {&this->vx, &this->vy, &this->vz,
+      &this->qw, &this->qx, &this->qy, &this->qz,
+      &this->forwardX, &this->forwardY, &this->forwardZ,
+      &this->upwardX, &this->upwardY, &this->upwardZ, &this->radial,
+      &this->alpha0, &this->cla, &this->cda, &this->claStall, &this->cdaStall,
+      &this->alphaStall, &this->qScale, &this->clControl,
+      &this->sinSweep, &this->alpha, &this->fx, &this->fy, &this->fz})
+  {
+    array->resize(_size);
+  }
+}
+
+/////////////////////////////////////////////////
+void LiftDragPluginBatch::OnUpdate()
+{
+  IGN_PROFILE("LiftDragPluginBatch::OnUpdate");
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  this->Evaluate(this->plugins);
+
+  // Subclasses get their own update, which they may override
+  for (const auto plugin : this->subclassPlugins)
+    plugin->OnUpdate();
+}
+
+/////////////////////////////////////////////////
+void LiftDragPluginBatch::Evaluate(
+    const std::vector<LiftDragPlugin *> &_plugins)
+{
+  const size_t count = _plugins.size();
+  this->Resize(count);
+
+  // Gather the state of every link and the parameters of its plugin
+  IGN_PROFILE_BEGIN("Gather");
+  for (size_t i = 0; i < count; ++i)
+  {
+    const LiftDragPlugin *plugin = _plugins[i];
+    const ignition::math::Vector3d vel =
+        plugin->link->WorldLinearVel(plugin->cp);
+    const ignition::math::Quaterniond &rot = plugin->link->WorldPose().Rot();
+
+    this->vx[i] = vel.X();
+    this->vy[i] = vel.Y();
+    this->vz[i] = vel.Z();
+    this->qw[i] = rot.W();
+    this->qx[i] = rot.X();
+    this->qy[i] = rot.Y();
+    this->qz[i] = rot.Z();
+    this->forwardX[i] = plugin->forward.X();
+    this->forwardY[i] = plugin->forward.Y();
+    this->forwardZ[i] = plugin->forward.Z();
+    this->upwardX[i] = plugin->upward.X();
+    this->upwardY[i] = plugin->upward.Y();
+    this->upwardZ[i] = plugin->upward.Z();
+    this->radial[i] = plugin->radialSymmetry ? 1.0 : 0.0;
+    this->alpha0[i] = plugin->alpha0;
+    this->cla[i] = plugin->cla;
+    this->cda[i] = plugin->cda;
+    this->claStall[i] = plugin->claStall;
+    this->cdaStall[i] = plugin->cdaStall;
+    this->alphaStall[i] = plugin->alphaStall;
+    this->qScale[i] = 0.5 * plugin->rho * plugin->area;
+    this->clControl[i] = plugin->controlJoint ?
+        plugin->controlJointRadToCL * plugin->controlJoint->Position(0) : 0.0;
+  }
+  IGN_PROFILE_END();
+
+  // Evaluate the forces, with the branches written as selects so that the
+  // loop vectorizes.
+  IGN_PROFILE_BEGIN("Forces");
+  for (size_t i = 0; i < count; ++i)
+  {
+    const double velX = this->vx[i];
+    const double velY = this->vy[i];
+    const double velZ = this->vz[i];
+    double velIX = velX;
+    double velIY = velY;
+    double velIZ = velZ;
+    normalize(velIX, velIY, velIZ);
+
+    const double w = this->qw[i];
+    const double x = this->qx[i];
+    const double y = this->qy[i];
+    const double z = this->qz[i];
+
+    // rotate forward and upward vectors into inertial frame
+    double fwdX, fwdY, fwdZ;
+    rotate(w, x, y, z, this->forwardX[i], this->forwardY[i],
+        this->forwardZ[i], fwdX, fwdY, fwdZ);
+
+    double upX, upY, upZ;
+    rotate(w, x, y, z, this->upwardX[i], this->upwardY[i],
+        this->upwardZ[i], upX, upY, upZ);
+
+    // for radially symmetric shapes, upward is the component of inflow
+    // perpendicular to forward direction
+    const double tmpX = fwdY * velIZ - fwdZ * velIY;
+    const double tmpY = fwdZ * velIX - fwdX * velIZ;
+    const double tmpZ = fwdX * velIY - fwdY * velIX;
+    double radialX = fwdY * tmpZ - fwdZ * tmpY;
+    double radialY = fwdZ * tmpX - fwdX * tmpZ;
+    double radialZ = fwdX * tmpY - fwdY * tmpX;
+    normalize(radialX, radialY, radialZ);
+
+    const bool isRadial = this->radial[i] > 0.5;
+    upX = isRadial ? radialX : upX;
+    upY = isRadial ? radialY : upY;
+    upZ = isRadial ? radialZ : upZ;
+
+    // spanwise: a vector normal to lift-drag-plane
+    double spanX = fwdY * upZ - fwdZ * upY;
+    double spanY = fwdZ * upX - fwdX * upZ;
+    double spanZ = fwdX * upY - fwdY * upX;
+    normalize(spanX, spanY, spanZ);
+
+    // sweep (angle between velI and lift-drag-plane)
+    const double sinSweepAngle = std::min(1.0, std::max(-1.0,
+          spanX * velIX + spanY * velIY + spanZ * velIZ));
+    const double cosSweepAngle = 1.0 - sinSweepAngle * sinSweepAngle;
+    this->sinSweep[i] = sinSweepAngle;
+
+    // removing spanwise velocity from vel
+    const double velSpan = velX * spanX + velY * spanY + velZ * spanZ;
+    const double ldX = velX - velSpan * velIX;
+    const double ldY = velY - velSpan * velIY;
+    const double ldZ = velZ - velSpan * velIZ;
+
+    double dragX = -ldX;
+    double dragY = -ldY;
+    double dragZ = -ldZ;
+    normalize(dragX, dragY, dragZ);
+
+    double liftX = spanY * ldZ - spanZ * ldY;
+    double liftY = spanZ * ldX - spanX * ldZ;
+    double liftZ = spanX * ldY - spanY * ldX;
+    normalize(liftX, liftY, liftZ);
+
+    // angle of attack, positive if lift is in the forward direction
+    const double cosAlpha = std::min(1.0, std::max(-1.0,
+          liftX * upX + liftY * upY + liftZ * upZ));
+    const double angle = std::acos(cosAlpha);
+    const bool positive = liftX * fwdX + liftY * fwdY + liftZ * fwdZ >= 0.0;
+    const double a = wrapHalfPi(
+        this->alpha0[i] + (positive ? angle : -angle));
+    this->alpha[i] = a;
+
+    // dynamic pressure times area
+    const double qa = this->qScale[i] * (ldX * ldX + ldY * ldY + ldZ * ldZ);
+
+    // cl and cd at cp, with stall, corrected for sweep
+    const double stall = this->alphaStall[i];
+    const bool above = a > stall;
+    const bool below = a < -stall;
+
+    const double clAbove = std::max(0.0, (this->cla[i] * stall +
+          this->claStall[i] * (a - stall)) * cosSweepAngle);
+    const double clBelow = std::min(0.0, (-this->cla[i] * stall +
+          this->claStall[i] * (a + stall)) * cosSweepAngle);
+    const double clLinear = this->cla[i] * a * cosSweepAngle;
+    const double cl = (above ? clAbove : (below ? clBelow : clLinear)) +
+        this->clControl[i];
+
+    const double cdAbove = (this->cda[i] * stall +
+          this->cdaStall[i] * (a - stall)) * cosSweepAngle;
+    const double cdBelow = (-this->cda[i] * stall +
+          this->cdaStall[i] * (a + stall)) * cosSweepAngle;
+    const double cdLinear = this->cda[i] * a * cosSweepAngle;
+    const double cd = std::fabs(
+        above ? cdAbove : (below ? cdBelow : cdLinear));
+
+    // lift plus drag at cp, in the inertial frame. The moment coefficient
+    // is not implemented, so there is no torque.
+    this->fx[i] = (cl * liftX + cd * dragX) * qa;
+    this->fy[i] = (cl * liftY + cd * dragY) * qa;
+    this->fz[i] = (cl * liftZ + cd * dragZ) * qa;
+  }
+  IGN_PROFILE_END();
+
+  IGN_PROFILE_BEGIN("Apply");
+  for (size_t i = 0; i < count; ++i)
+  {
+    LiftDragPlugin *plugin = _plugins[i];
+
+    // Lift and drag are only applied above a minimum speed
+    const double speed2 = this->vx[i] * this->vx[i] +
+        this->vy[i] * this->vy[i] + this->vz[i] * this->vz[i];
+    if (speed2 <= 0.01 * 0.01)
+      continue;
+
+    plugin->sweep = std::asin(this->sinSweep[i]);
+    plugin->alpha = this->alpha[i];
+
+    // Correct for nan or inf
+    ignition::math::Vector3d force(this->fx[i], this->fy[i], this->fz[i]);
+    force.Correct();
+    plugin->cp.Correct();
+
+    plugin->link->AddForceAtRelativePosition(force, plugin->cp);
+  }
+  IGN_PROFILE_END();
+}
+
 /////////////////////////////////////////////////
 LiftDragPlugin::LiftDragPlugin() : cla(1.0), cda(0.01), cma(0.01), rho(1.2041)
 {
@@ -61,6 +431,8 @@ LiftDragPlugin::LiftDragPlugin() : cla(1.0), cda(0.01), cma(0.01), rho(1.2041)
 /////////////////////////////////////////////////
 LiftDragPlugin::~LiftDragPlugin()
 {
+  if (this->batch)
+    this->batch->Remove(this);
 }
 
 /////////////////////////////////////////////////
@@ -141,8 +513,8 @@ void LiftDragPlugin::Load(physics::ModelPtr _model,
     }
     else
     {
-      this->updateConnection = event::Events::ConnectWorldUpdateBegin(
-          std::bind(&LiftDragPlugin::OnUpdate, this));
+      this->batch = LiftDragPluginBatch::Get(this->world);
+      this->batch->Add(this);
     }
   }
 
@@ -163,242 +535,7 @@ void LiftDragPlugin::Load(physics::ModelPtr _model,
 /////////////////////////////////////////////////
 void LiftDragPlugin::OnUpdate()
 {
-  GZ_ASSERT(this->link, "Link was NULL");
-  // get linear velocity at cp in inertial frame
-  ignition::math::Vector3d vel = this->link->WorldLinearVel(this->cp);
-  ignition::math::Vector3d velI = vel;
-  velI.Normalize();
-
-  // smoothing
-  // double e = 0.8;
-  // this->velSmooth = e*vel + (1.0 - e)*velSmooth;
-  // vel = this->velSmooth;
-
-  if (vel.Length() <= 0.01)
-    return;
-
   IGN_PROFILE("LiftDragPlugin::OnUpdate");
-  IGN_PROFILE_BEGIN(std::string(this->link->GetName()).c_str());
-
-  // pose of body
-  ignition::math::Pose3d pose = this->link->WorldPose();
-
-  // rotate forward and upward vectors into inertial frame
-  ignition::math::Vector3d forwardI = pose.Rot().RotateVector(this->forward);
-
-  ignition::math::Vector3d upwardI;
-  if (this->radialSymmetry)
-  {
-    // use inflow velocity to determine upward direction
-    // which is the component of inflow perpendicular to forward direction.
-    ignition::math::Vector3d tmp = forwardI.Cross(velI);
-    upwardI = forwardI.Cross(tmp).Normalize();
-  }
-  else
-  {
-    upwardI = pose.Rot().RotateVector(this->upward);
-  }
-
-  // spanwiseI: a vector normal to lift-drag-plane described in inertial frame
-  ignition::math::Vector3d spanwiseI = forwardI.Cross(upwardI).Normalize();
-
-  const double minRatio = -1.0;
-  const double maxRatio = 1.0;
-  // check sweep (angle between velI and lift-drag-plane)
-  double sinSweepAngle = ignition::math::clamp(
-      spanwiseI.Dot(velI), minRatio, maxRatio);
-
-  // get cos from trig identity
-  double cosSweepAngle = 1.0 - sinSweepAngle * sinSweepAngle;
-  this->sweep = asin(sinSweepAngle);
-
-  // truncate sweep to within +/-90 deg
-  while (fabs(this->sweep) > 0.5 * M_PI)
-    this->sweep = this->sweep > 0 ? this->sweep - M_PI
-                                  : this->sweep + M_PI;
-
-  // angle of attack is the angle between
-  // velI projected into lift-drag plane
-  //  and
-  // forward vector
-  //
-  // projected = spanwiseI Xcross ( vector Xcross spanwiseI)
-  //
-  // so,
-  // removing spanwise velocity from vel
-  ignition::math::Vector3d velInLDPlane = vel - vel.Dot(spanwiseI)*velI;
-
-  // get direction of drag
-  ignition::math::Vector3d dragDirection = -velInLDPlane;
-  dragDirection.Normalize();
-
-  // get direction of lift
-  ignition::math::Vector3d liftI = spanwiseI.Cross(velInLDPlane);
-  liftI.Normalize();
-
-  // get direction of moment
-  ignition::math::Vector3d momentDirection = spanwiseI;
-
-  // compute angle between upwardI and liftI
-  // in general, given vectors a and b:
-  //   cos(theta) = a.Dot(b)/(a.Length()*b.Lenghth())
-  // given upwardI and liftI are both unit vectors, we can drop the denominator
-  //   cos(theta) = a.Dot(b)
-  double cosAlpha =
-    ignition::math::clamp(liftI.Dot(upwardI), minRatio, maxRatio);
-
-  // Is alpha positive or negative? Test:
-  // forwardI points toward zero alpha
-  // if forwardI is in the same direction as lift, alpha is positive.
-  // liftI is in the same direction as forwardI?
-  if (liftI.Dot(forwardI) >= 0.0)
-    this->alpha = this->alpha0 + acos(cosAlpha);
-  else
-    this->alpha = this->alpha0 - acos(cosAlpha);
-
-  // normalize to within +/-90 deg
-  while (fabs(this->alpha) > 0.5 * M_PI)
-    this->alpha = this->alpha > 0 ? this->alpha - M_PI
-                                  : this->alpha + M_PI;
-
-  // compute dynamic pressure
-  double speedInLDPlane = velInLDPlane.Length();
-  double q = 0.5 * this->rho * speedInLDPlane * speedInLDPlane;
-
-  // compute cl at cp, check for stall, correct for sweep
-  double cl;
-  if (this->alpha > this->alphaStall)
-  {
-    cl = (this->cla * this->alphaStall +
-          this->claStall * (this->alpha - this->alphaStall))
-         * cosSweepAngle;
-    // make sure cl is still great than 0
-    cl = std::max(0.0, cl);
-  }
-  else if (this->alpha < -this->alphaStall)
-  {
-    cl = (-this->cla * this->alphaStall +
-          this->claStall * (this->alpha + this->alphaStall))
-         * cosSweepAngle;
-    // make sure cl is still less than 0
-    cl = std::min(0.0, cl);
-  }
-  else
-    cl = this->cla * this->alpha * cosSweepAngle;
-
-  // modify cl per control joint value
-  if (this->controlJoint)
-  {
-    double controlAngle = this->controlJoint->Position(0);
-    cl = cl + this->controlJointRadToCL * controlAngle;
-    /// \TODO: also change cm and cd
-  }
-
-  // compute lift force at cp
-  ignition::math::Vector3d lift = cl * q * this->area * liftI;
-
-  // compute cd at cp, check for stall, correct for sweep
-  double cd;
-  if (this->alpha > this->alphaStall)
-  {
-    cd = (this->cda * this->alphaStall +
-          this->cdaStall * (this->alpha - this->alphaStall))
-         * cosSweepAngle;
-  }
-  else if (this->alpha < -this->alphaStall)
-  {
-    cd = (-this->cda * this->alphaStall +
-          this->cdaStall * (this->alpha + this->alphaStall))
-         * cosSweepAngle;
-  }
-  else
-    cd = (this->cda * this->alpha) * cosSweepAngle;
-
-  // make sure drag is positive
-  cd = fabs(cd);
-
-  // drag at cp
-  ignition::math::Vector3d drag = cd * q * this->area * dragDirection;
-
-  // compute cm at cp, check for stall, correct for sweep
-  double cm;
-  if (this->alpha > this->alphaStall)
-  {
-    cm = (this->cma * this->alphaStall +
-          this->cmaStall * (this->alpha - this->alphaStall))
-         * cosSweepAngle;
-    // make sure cm is still great than 0
-    cm = std::max(0.0, cm);
-  }
-  else if (this->alpha < -this->alphaStall)
-  {
-    cm = (-this->cma * this->alphaStall +
-          this->cmaStall * (this->alpha + this->alphaStall))
-         * cosSweepAngle;
-    // make sure cm is still less than 0
-    cm = std::min(0.0, cm);
-  }
-  else
-    cm = this->cma * this->alpha * cosSweepAngle;
-
-  /// \TODO: implement cm
-  /// for now, reset cm to zero, as cm needs testing
-  cm = 0.0;
-
-  // compute moment (torque) at cp
-  ignition::math::Vector3d moment = cm * q * this->area * momentDirection;
-
-  // moment arm from cg to cp in inertial plane
-  ignition::math::Vector3d momentArm = pose.Rot().RotateVector(
-    this->cp - this->link->GetInertial()->CoG());
-  // gzerr << this->cp << " : " << this->link->GetInertial()->GetCoG() << "\n";
-
-  // force and torque about cg in inertial frame
-  ignition::math::Vector3d force = lift + drag;
-  // + moment.Cross(momentArm);
-
-  ignition::math::Vector3d torque = moment;
-  // - lift.Cross(momentArm) - drag.Cross(momentArm);
-
-  // debug
-  //
-  // if ((this->link->GetName() == "wing_1" ||
-  //      this->link->GetName() == "wing_2") &&
-  //     (vel.Length() > 50.0 &&
-  //      vel.Length() < 50.0))
-  if (0)
-  {
-    gzdbg << "=============================\n";
-    gzdbg << "sensor: [" << this->GetHandle() << "]\n";
-    gzdbg << "Link: [" << this->link->GetName()
-          << "] pose: [" << pose
-          << "] dynamic pressure: [" << q << "]\n";
-    gzdbg << "spd: [" << vel.Length()
-          << "] vel: [" << vel << "]\n";
-    gzdbg << "LD plane spd: [" << velInLDPlane.Length()
-          << "] vel : [" << velInLDPlane << "]\n";
-    gzdbg << "forward (inertial): " << forwardI << "\n";
-    gzdbg << "upward (inertial): " << upwardI << "\n";
-    gzdbg << "lift dir (inertial): " << liftI << "\n";
-    gzdbg << "Span direction (normal to LD plane): " << spanwiseI << "\n";
-    gzdbg << "sweep: " << this->sweep << "\n";
-    gzdbg << "alpha: " << this->alpha << "\n";
-    gzdbg << "lift: " << lift << "\n";
-    gzdbg << "drag: " << drag << " cd: "
-          << cd << " cda: " << this->cda << "\n";
-    gzdbg << "moment: " << moment << "\n";
-    gzdbg << "cp momentArm: " << momentArm << "\n";
-    gzdbg << "force: " << force << "\n";
-    gzdbg << "torque: " << torque << "\n";
-  }
-
-  // Correct for nan or inf
-  force.Correct();
-  this->cp.Correct();
-  torque.Correct();
-
-  // apply forces at cg (with torques for position shift)
-  this->link->AddForceAtRelativePosition(force, this->cp);
-  this->link->AddTorque(torque);
-  IGN_PROFILE_END();
+  if (this->batch)
+    this->batch->Evaluate({this});
 }
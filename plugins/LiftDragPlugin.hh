@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PLUGINS_LIFTDRAGPLUGIN_HH_
 #define GAZEBO_PLUGINS_LIFTDRAGPLUGIN_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -28,7 +29,14 @@
 
 namespace gazebo
 {
+  class LiftDragPluginBatch;
+
   /// \brief A plugin that simulates lift and drag.
+  ///
+  /// The plugins of a world are evaluated together: a single world update
+  /// callback gathers the links of every instance and computes their
+  /// forces in one pass. Instances of subclasses are updated one by one
+  /// through OnUpdate.
   class GZ_PLUGIN_VISIBLE LiftDragPlugin : public ModelPlugin
   {
     /// \brief Constructor.
@@ -40,10 +48,14 @@ namespace gazebo
     // Documentation Inherited.
     public: virtual void Load(physics::ModelPtr _model, sdf::ElementPtr _sdf);
 
-    /// \brief Callback for World Update events.
+    /// \brief Compute and apply the forces of this plugin. The world
+    /// update callback evaluates the LiftDragPlugin instances of a world
+    /// together, and calls OnUpdate of each instance of a subclass instead,
+    /// so subclasses can override it.
     protected: virtual void OnUpdate();
 
-    /// \brief Connection to World Update events.
+    /// \brief Connection to World Update events. Not used, the plugins of
+    /// a world share one connection.
     protected: event::ConnectionPtr updateConnection;
 
     /// \brief Pointer to world.
@@ -136,6 +148,12 @@ namespace gazebo
 
     /// \brief SDF for this plugin;
     protected: sdf::ElementPtr sdf;
+
+    /// \brief Plugins of the world, evaluated together.
+    private: std::shared_ptr<LiftDragPluginBatch> batch;
+
+    /// \brief The batch reads the properties of its plugins.
+    private: friend class LiftDragPluginBatch;
   };
 }
 #endif
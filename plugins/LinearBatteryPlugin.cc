@@ -17,11 +17,10 @@
 #include <string>
 #include <functional>
 
-#include <ignition/common/Profiler.hh>
-
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/Battery.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/physics.hh"
 #include "plugins/LinearBatteryPlugin.hh"
 
@@ -19,7 +19,6 @@
 #include <string>
 #include <vector>
 
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/msgs.hh>
@@ -27,6 +26,7 @@
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/physics.hh"
 #include "plugins/LinkPlot3DPlugin.hh"
 
@@ -0,0 +1,507 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Events.hh"
+#include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/sensors/Sensor.hh"
+#include "gazebo/sensors/SensorManager.hh"
+#include "gazebo/transport/ConnectionManager.hh"
+#include "gazebo/transport/TopicManager.hh"
+#include "gazebo/util/LogRecord.hh"
+#include "gazebo/util/TimingStats.hh"
+#include "MetricsPlugin.hh"
+
+using namespace gazebo;
+using boost::asio::ip::tcp;
+
+GZ_REGISTER_SYSTEM_PLUGIN(MetricsPlugin)
+
+namespace gazebo
+{
+  /// \brief Private data for the MetricsPlugin class.
+  class MetricsPluginPrivate
+  {
+    /// \brief Accept the next connection.
+    public: void Accept();
+
+    /// \brief Read a request and answer it.
+    /// \param[in] _socket Accepted connection.
+    public: void Serve(std::shared_ptr<tcp::socket> _socket);
+
+    /// \brief Build the response to a request.
+    /// \param[in] _method HTTP method, e.g. "GET".
+    /// \param[in] _target Requested path, e.g. "/metrics".
+    /// \return HTTP response.
+    public: std::string Response(const std::string &_method,
+                const std::string &_target);
+
+    /// \brief Build the metrics page.
+    /// \return Metrics in OpenMetrics text format.
+    public: std::string Metrics();
+
+    /// \brief Runs the handlers of the endpoint.
+    public: boost::asio::io_service io;
+
+    /// \brief Listening socket.
+    public: std::unique_ptr<tcp::acceptor> acceptor;
+
+    /// \brief Thread running io.
+    public: std::thread thread;
+
+    /// \brief Protects worldNames.
+    public: std::mutex mutex;
+
+    /// \brief Names of the worlds created since the plugin was loaded.
+    public: std::set<std::string> worldNames;
+
+    /// \brief Simulation and real times of each world at the previous
+    /// scrape, to compute the real time factor. Only used by thread.
+    public: std::map<std::string, std::pair<double, double>> previousTimes;
+
+    /// \brief Connection to the world created event.
+    public: event::ConnectionPtr worldCreatedConn;
+  };
+}
+
+/// \brief Upper bounds of the buckets of the exported histograms.
+static const std::vector<std::pair<const char *, uint64_t>> kBounds =
+{
+  {"1e-05", 10000ull},
+  {"0.0001", 100000ull},
+  {"0.00025", 250000ull},
+  {"0.0005", 500000ull},
+  {"0.001", 1000000ull},
+  {"0.0025", 2500000ull},
+  {"0.005", 5000000ull},
+  {"0.01", 10000000ull},
+  {"0.025", 25000000ull},
+  {"0.05", 50000000ull},
+  {"0.1", 100000000ull},
+  {"0.25", 250000000ull},
+  {"0.5", 500000000ull},
+  {"1.0", 1000000000ull},
+  {"2.5", 2500000000ull},
+  {"5.0", 5000000000ull},
+  {"10.0", 10000000000ull}
+};
+
+/// \brief Escape a label value.
+/// \param[in] _value Raw value.
+/// \return Value with backslashes, quotes and new lines escaped.
+static std::string Escape(const std::string &_value)
+{
+  std::string result;
+  result.reserve(_value.size());
+  for (const char c : _value)
+  {
+    if (c == '\\')
+      result += "\\\\";
+    else if (c == '"')
+      result += "\\\"";
+    else if (c == '\n')
+      result += "\\n";
+    else
+      result += c;
+  }
+  return result;
+}
+
+/// \brief Write the TYPE and HELP lines of a metric family.
+/// \param[in] _out Stream to write to.
+/// \param[in] _name Name of the family.
+/// \param[in] _type "gauge", "counter" or "histogram".
+/// \param[in] _help Description.
+static void Family(std::ostream &_out, const std::string &_name,
+    const std::string &_type, const std::string &_help)
+{
+  _out << "# TYPE " << _name << " " << _type << "\n"
+       << "# HELP " << _name << " " << _help << "\n";
+}
+
+/////////////////////////////////////////////////
+MetricsPlugin::MetricsPlugin()
+  : dataPtr(new MetricsPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+MetricsPlugin::~MetricsPlugin()
+{
+  this->dataPtr->worldCreatedConn.reset();
+  this->dataPtr->io.stop();
+  if (this->dataPtr->thread.joinable())
+    this->dataPtr->thread.join();
+}
+
+/////////////////////////////////////////////////
+void MetricsPlugin::Load(int /*_argc*/, char ** /*_argv*/)
+{
+  this->dataPtr->worldCreatedConn = event::Events::ConnectWorldCreated(
+      [this](const std::string &_name)
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+        this->dataPtr->worldNames.insert(_name);
+      });
+
+  unsigned int port = 9464;
+  const char *portEnv = std::getenv("GAZEBO_METRICS_PORT");
+  if (portEnv)
+  {
+    try
+    {
+      port = std::stoul(portEnv);
+    }
+    catch(...)
+    {
+      gzerr << "Invalid GAZEBO_METRICS_PORT [" << portEnv << "]" << std::endl;
+      return;
+    }
+  }
+
+  std::string address = "0.0.0.0";
+  const char *addressEnv = std::getenv("GAZEBO_METRICS_ADDRESS");
+  if (addressEnv)
+    address = addressEnv;
+
+  boost::system::error_code ec;
+  tcp::endpoint endpoint(boost::asio::ip::address::from_string(address, ec),
+      static_cast<uint16_t>(port));
+  if (ec)
+  {
+    gzerr << "Invalid GAZEBO_METRICS_ADDRESS [" << address << "]" << std::endl;
+    return;
+  }
+
+  this->dataPtr->acceptor.reset(new tcp::acceptor(this->dataPtr->io));
+  this->dataPtr->acceptor->open(endpoint.protocol(), ec);
+  if (!ec)
+    this->dataPtr->acceptor->set_option(tcp::acceptor::reuse_address(true), ec);
+  if (!ec)
+    this->dataPtr->acceptor->bind(endpoint, ec);
+  if (!ec)
+    this->dataPtr->acceptor->listen(boost::asio::socket_base::max_connections,
+        ec);
+  if (ec)
+  {
+    gzerr << "Unable to serve metrics on " << address << ":" << port
+      << ": " << ec.message() << std::endl;
+    this->dataPtr->acceptor.reset();
+    return;
+  }
+
+  this->dataPtr->Accept();
+  this->dataPtr->thread = std::thread([this]()
+      {
+        this->dataPtr->io.run();
+      });
+
+  gzmsg << "Serving metrics on http://" << address << ":" << port
+    << "/metrics" << std::endl;
+}
+
+/////////////////////////////////////////////////
+void MetricsPluginPrivate::Accept()
+{
+  auto socket = std::make_shared<tcp::socket>(this->io);
+  this->acceptor->async_accept(*socket,
+      [this, socket](const boost::system::error_code &_ec)
+      {
+        if (_ec == boost::asio::error::operation_aborted)
+          return;
+        if (!_ec)
+          this->Serve(socket);
+        this->Accept();
+      });
+}
+
+/////////////////////////////////////////////////
+void MetricsPluginPrivate::Serve(std::shared_ptr<tcp::socket> _socket)
+{
+  // Drop clients that do not complete their request in time.
+  auto timer = std::make_shared<boost::asio::steady_timer>(this->io,
+      std::chrono::seconds(5));
+  timer->async_wait([_socket](const boost::system::error_code &_ec)
+      {
+        boost::system::error_code ignored;
+        if (!_ec)
+          _socket->close(ignored);
+      });
+
+  auto request = std::make_shared<boost::asio::streambuf>(8192);
+  boost::asio::async_read_until(*_socket, *request, "\r\n\r\n",
+      [this, _socket, request, timer](const boost::system::error_code &_ec,
+        std::size_t /*_size*/)
+      {
+        if (_ec)
+        {
+          timer->cancel();
+          return;
+        }
+
+        std::istream stream(request.get());
+        std::string method, target;
+        stream >> method >> target;
+
+        auto response =
+          std::make_shared<std::string>(this->Response(method, target));
+        boost::asio::async_write(*_socket, boost::asio::buffer(*response),
+            [_socket, response, timer](const boost::system::error_code &,
+              std::size_t)
+            {
+              timer->cancel();
+              boost::system::error_code ignored;
+              _socket->shutdown(tcp::socket::shutdown_both, ignored);
+              _socket->close(ignored);
+            });
+      });
+}
+
+/////////////////////////////////////////////////
+std::string MetricsPluginPrivate::Response(const std::string &_method,
+    const std::string &_target)
+{
+  std::string status = "200 OK";
+  std::string type =
+    "application/openmetrics-text; version=1.0.0; charset=utf-8";
+  std::string body;
+
+  if (_method != "GET")
+  {
+    status = "405 Method Not Allowed";
+    type = "text/plain";
+  }
+  else if (_target != "/metrics" && _target.compare(0, 9, "/metrics?") != 0)
+  {
+    status = "404 Not Found";
+    type = "text/plain";
+  }
+  else
+    body = this->Metrics();
+
+  return "HTTP/1.1 " + status + "\r\n" +
+    "Content-Type: " + type + "\r\n" +
+    "Content-Length: " + std::to_string(body.size()) + "\r\n" +
+    "Connection: close\r\n\r\n" + body;
+}
+
+/////////////////////////////////////////////////
+std::string MetricsPluginPrivate::Metrics()
+{
+  std::ostringstream out;
+  out << std::setprecision(12);
+
+  // World statistics
+  struct WorldSample
+  {
+    std::string name;
+    double simTime;
+    double realTime;
+    double factor;
+    uint64_t iterations;
+    bool paused;
+    unsigned int models;
+  };
+  std::vector<WorldSample> worlds;
+
+  std::set<std::string> names;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    names = this->worldNames;
+  }
+
+  for (auto const &name : names)
+  {
+    if (!physics::has_world(name))
+      continue;
+    physics::WorldPtr world = physics::get_world(name);
+
+    WorldSample sample;
+    sample.name = Escape(name);
+    sample.simTime = world->SimTime().Double();
+    sample.realTime = world->RealTime().Double();
+    sample.iterations = world->Iterations();
+    sample.paused = world->IsPaused();
+    sample.models = world->ModelCount();
+
+    // Real time factor since the previous scrape
+    auto &previous = this->previousTimes[name];
+    const double realElapsed = sample.realTime - previous.second;
+    sample.factor = realElapsed > 0 ?
+      (sample.simTime - previous.first) / realElapsed : 0.0;
+    previous = std::make_pair(sample.simTime, sample.realTime);
+
+    worlds.push_back(sample);
+  }
+
+  if (!worlds.empty())
+  {
+    Family(out, "gazebo_sim_time_seconds", "gauge", "Simulation time.");
+    for (auto const &w : worlds)
+    {
+      out << "gazebo_sim_time_seconds{world=\"" << w.name << "\"} "
+          << w.simTime << "\n";
+    }
+
+    Family(out, "gazebo_real_time_seconds", "gauge",
+        "Real time elapsed while the world was running.");
+    for (auto const &w : worlds)
+    {
+      out << "gazebo_real_time_seconds{world=\"" << w.name << "\"} "
+          << w.realTime << "\n";
+    }
+
+    Family(out, "gazebo_real_time_factor", "gauge",
+        "Simulation time over real time since the previous scrape.");
+    for (auto const &w : worlds)
+    {
+      out << "gazebo_real_time_factor{world=\"" << w.name << "\"} "
+          << w.factor << "\n";
+    }
+
+    Family(out, "gazebo_iterations", "counter", "World iterations.");
+    for (auto const &w : worlds)
+    {
+      out << "gazebo_iterations_total{world=\"" << w.name << "\"} "
+          << w.iterations << "\n";
+    }
+
+    Family(out, "gazebo_paused", "gauge", "1 if the world is paused.");
+    for (auto const &w : worlds)
+    {
+      out << "gazebo_paused{world=\"" << w.name << "\"} "
+          << (w.paused ? 1 : 0) << "\n";
+    }
+
+    Family(out, "gazebo_models", "gauge", "Number of models.");
+    for (auto const &w : worlds)
+    {
+      out << "gazebo_models{world=\"" << w.name << "\"} "
+          << w.models << "\n";
+    }
+  }
+
+  // Stage durations. The buckets of util::TimingHistogram are merged into
+  // fixed buckets, a sample may be counted in the next larger bucket.
+  util::TimingStats *stats = util::TimingStats::Instance();
+  const std::vector<std::string> stages = stats->StageNames();
+  Family(out, "gazebo_stage_duration_seconds", "histogram",
+      "Duration of the stages of the world and sensor updates.");
+  for (unsigned int i = 0; i < stages.size(); ++i)
+  {
+    const util::TimingHistogram histogram = stats->Histogram(i);
+    const std::string label = "stage=\"" + Escape(stages[i]) + "\"";
+
+    uint64_t cumulative = 0;
+    unsigned int bucket = 0;
+    for (auto const &bound : kBounds)
+    {
+      while (bucket < util::TimingHistogram::kBucketCount &&
+          util::TimingHistogram::BucketUpperBound(bucket) <= bound.second)
+      {
+        cumulative += histogram.BucketValue(bucket);
+        ++bucket;
+      }
+      out << "gazebo_stage_duration_seconds_bucket{" << label << ",le=\""
+          << bound.first << "\"} " << cumulative << "\n";
+    }
+    out << "gazebo_stage_duration_seconds_bucket{" << label
+        << ",le=\"+Inf\"} " << histogram.Count() << "\n"
+        << "gazebo_stage_duration_seconds_count{" << label << "} "
+        << histogram.Count() << "\n"
+        << "gazebo_stage_duration_seconds_sum{" << label << "} "
+        << histogram.Sum() * 1e-9 << "\n";
+  }
+
+  // Sensor overruns
+  sensors::Sensor_V sensors = sensors::SensorManager::Instance()->GetSensors();
+  if (!sensors.empty())
+  {
+    Family(out, "gazebo_sensor_overruns", "counter",
+        "Updates of a sensor that were late by a full update period.");
+    for (auto const &sensor : sensors)
+    {
+      out << "gazebo_sensor_overruns_total{sensor=\""
+          << Escape(sensor->ScopedName()) << "\",type=\""
+          << Escape(sensor->Type()) << "\"} " << sensor->OverrunCount()
+          << "\n";
+    }
+  }
+
+  // Log recorder
+  Family(out, "gazebo_log_dropped_states", "counter",
+      "States dropped by the log recorder because its buffer was full.");
+  out << "gazebo_log_dropped_states_total "
+      << util::LogRecord::Instance()->DroppedStateCount() << "\n";
+
+  // Transport
+  transport::ConnectionManager *connections =
+    transport::ConnectionManager::Instance();
+  unsigned int maxPending = 0;
+  const unsigned int pending = connections->PendingMsgCount(maxPending);
+
+  Family(out, "gazebo_transport_connections", "gauge",
+      "Connections to other transport nodes.");
+  out << "gazebo_transport_connections " << connections->ConnectionCount()
+      << "\n";
+
+  Family(out, "gazebo_transport_pending_messages", "gauge",
+      "Messages waiting to be written on all connections.");
+  out << "gazebo_transport_pending_messages " << pending << "\n";
+
+  Family(out, "gazebo_transport_max_pending_messages", "gauge",
+      "Messages waiting to be written on the most loaded connection.");
+  out << "gazebo_transport_max_pending_messages " << maxPending << "\n";
+
+  transport::TopicManager *topics = transport::TopicManager::Instance();
+  Family(out, "gazebo_transport_flushes", "counter",
+      "Flushes of the publishers of the nodes with queued messages.");
+  out << "gazebo_transport_flushes_total " << topics->FlushCount() << "\n";
+
+  Family(out, "gazebo_transport_flushed_nodes", "counter",
+      "Nodes whose publishers were flushed.");
+  out << "gazebo_transport_flushed_nodes_total "
+      << topics->FlushedNodeCount() << "\n";
+
+  Family(out, "gazebo_transport_flush_seconds", "counter",
+      "Wall time spent flushing publishers.");
+  out << "gazebo_transport_flush_seconds_total "
+      << topics->FlushTime() * 1e-9 << "\n";
+
+  Family(out, "gazebo_transport_last_flush_seconds", "gauge",
+      "Wall time of the last publisher flush.");
+  out << "gazebo_transport_last_flush_seconds "
+      << topics->LastFlushTime() * 1e-9 << "\n";
+
+  out << "# EOF\n";
+  return out.str();
+}
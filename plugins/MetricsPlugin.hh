@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_METRICSPLUGIN_HH_
+#define GAZEBO_PLUGINS_METRICSPLUGIN_HH_
+
+#include <memory>
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  class MetricsPluginPrivate;
+
+  /// \brief System plugin that serves the performance counters of the
+  /// server over HTTP, in the OpenMetrics text format read by Prometheus.
+  ///
+  /// Example usage:
+  ///
+  ///   GAZEBO_METRICS_PORT=9464 gzserver -s libMetricsPlugin.so my.world
+  ///   curl http://localhost:9464/metrics
+  ///
+  /// The endpoint exposes, for each world, the simulation and real times,
+  /// the iterations, the real time factor since the previous scrape and
+  /// the model count. It also exposes the histograms of util::TimingStats,
+  /// the update overruns of each sensor, the states dropped by the log
+  /// recorder and the messages waiting on the transport connections.
+  ///
+  /// Environment variables:
+  ///   GAZEBO_METRICS_PORT: TCP port, 9464 by default.
+  ///   GAZEBO_METRICS_ADDRESS: Address to listen on, 0.0.0.0 by default.
+  class GZ_PLUGIN_VISIBLE MetricsPlugin : public SystemPlugin
+  {
+    /// \brief Constructor.
+    public: MetricsPlugin();
+
+    /// \brief Destructor, stops the endpoint.
+    public: virtual ~MetricsPlugin();
+
+    // Documentation inherited
+    public: virtual void Load(int _argc, char **_argv);
+
+    /// \internal
+    /// \brief Private data pointer.
+    private: std::unique_ptr<MetricsPluginPrivate> dataPtr;
+  };
+}
+#endif
@@ -17,10 +17,10 @@
 
 #include <string>
 
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Pose3.hh>
 
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/Entity.hh"
@@ -21,12 +21,12 @@
 
 #include <boost/algorithm/string.hpp>
 
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Quaternion.hh>
 
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/physics.hh"
 #include "gazebo/sensors/SensorManager.hh"
 #include "gazebo/sensors/ContactSensor.hh"
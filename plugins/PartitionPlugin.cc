@@ -0,0 +1,539 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Events.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/ModelState.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/transport/transport.hh"
+
+#include "PartitionPlugin.hh"
+
+namespace gazebo
+{
+  /// \brief Neighbor regions of a region.
+  enum PartitionSide
+  {
+    /// \brief Region with the next lower index, towards -X.
+    PARTITION_LOWER = 0,
+
+    /// \brief Region with the next higher index, towards +X.
+    PARTITION_UPPER = 1,
+
+    /// \brief Number of sides.
+    PARTITION_SIDE_COUNT = 2
+  };
+
+  /// \brief Private data class for the PartitionPlugin class
+  class PartitionPluginPrivate
+  {
+    /// \brief Pointer to the world.
+    public: physics::WorldPtr world;
+
+    /// \brief Connections to the world update events.
+    public: std::vector<event::ConnectionPtr> connections;
+
+    /// \brief Transport node.
+    public: transport::NodePtr node;
+
+    /// \brief Publishers of the state to each neighbor.
+    public: transport::PublisherPtr statePubs[PARTITION_SIDE_COUNT];
+
+    /// \brief Subscribers to the state of each neighbor.
+    public: transport::SubscriberPtr stateSubs[PARTITION_SIDE_COUNT];
+
+    /// \brief Publisher of factory messages, to insert ghosts and migrants.
+    public: transport::PublisherPtr factoryPub;
+
+    /// \brief Index of this region.
+    public: int region = 0;
+
+    /// \brief True if the region has a neighbor on a side.
+    public: bool hasNeighbor[PARTITION_SIDE_COUNT] = {false, false};
+
+    /// \brief Lower X bound of the region.
+    public: double minX = -ignition::math::INF_D;
+
+    /// \brief Upper X bound of the region.
+    public: double maxX = ignition::math::INF_D;
+
+    /// \brief Width of the ghost band on each side of a boundary.
+    public: double halo = 5.0;
+
+    /// \brief True to step in lockstep with the neighbors.
+    public: bool sync = true;
+
+    /// \brief Time to wait for a neighbor, in seconds of wall time.
+    public: double syncTimeout = 1.0;
+
+    /// \brief Protects received and lastIteration.
+    public: std::mutex mutex;
+
+    /// \brief Notified when a state is received.
+    public: std::condition_variable condition;
+
+    /// \brief States received and not applied yet.
+    public: std::deque<msgs::PartitionState> received;
+
+    /// \brief Last iteration received from each neighbor, -1 until a
+    /// neighbor is heard from, or after it timed out.
+    public: int64_t lastIteration[PARTITION_SIDE_COUNT] = {-1, -1};
+
+    /// \brief Names of the ghost models of this region.
+    public: std::set<std::string> ghosts;
+
+    /// \brief Names of the owned models each neighbor has a ghost of.
+    public: std::set<std::string> sent[PARTITION_SIDE_COUNT];
+
+    /// \brief Owned models that migrated, removed before the next step.
+    public: std::vector<std::string> migrated;
+
+    /// \brief States of migrants waiting for their insertion.
+    public: std::map<std::string, physics::ModelState> pendingStates;
+  };
+}
+
+using namespace gazebo;
+
+GZ_REGISTER_WORLD_PLUGIN(PartitionPlugin)
+
+/// \brief Topic of the state a region sends to another.
+/// \param[in] _from Index of the sending region.
+/// \param[in] _to Index of the receiving region.
+/// \return Topic name.
+static std::string StateTopic(const int _from, const int _to)
+{
+  return "/gazebo/partition/" + std::to_string(_from) + "/to/" +
+      std::to_string(_to);
+}
+
+/// \brief Get the SDF string of a model at its current pose.
+/// \param[in] _model Model.
+/// \param[in] _ghost True to make a static copy without plugins or
+/// sensors.
+/// \return SDF string.
+static std::string ModelSdf(const physics::ModelPtr &_model,
+    const bool _ghost)
+{
+  sdf::ElementPtr elem = _model->GetSDF()->Clone();
+  elem->GetElement("pose")->Set(_model->WorldPose());
+
+  if (_ghost)
+  {
+    elem->GetElement("static")->Set(true);
+    while (elem->HasElement("plugin"))
+      elem->RemoveChild(elem->GetElement("plugin"));
+
+    sdf::ElementPtr linkElem = elem->HasElement("link") ?
+        elem->GetElement("link") : sdf::ElementPtr();
+    while (linkElem)
+    {
+      while (linkElem->HasElement("sensor"))
+        linkElem->RemoveChild(linkElem->GetElement("sensor"));
+      linkElem = linkElem->GetNextElement("link");
+    }
+  }
+
+  std::ostringstream stream;
+  stream << "<sdf version='" << SDF_VERSION << "'>"
+         << elem->ToString("") << "</sdf>";
+  return stream.str();
+}
+
+/// \brief Get the state of a model, with the state of its links, joints
+/// and nested models.
+/// \param[in] _model Model.
+/// \return A <model> element of an SDF <state>, as a string.
+static std::string ModelStateSdf(const physics::ModelPtr &_model)
+{
+  physics::ModelState state(_model);
+  sdf::ElementPtr elem(new sdf::Element);
+  sdf::initFile("model_state.sdf", elem);
+  state.FillSDF(elem);
+  return elem->ToString("");
+}
+
+/// \brief Parse a model state sent by ModelStateSdf.
+/// \param[in] _state The <model> element of an SDF <state>.
+/// \param[out] _modelState The parsed state.
+/// \return True on success.
+static bool ParseModelState(const std::string &_state,
+    physics::ModelState &_modelState)
+{
+  std::ostringstream stream;
+  stream << "<sdf version='" << SDF_VERSION << "'>"
+         << "<world name='default'><state world_name='default'>"
+         << _state << "</state></world></sdf>";
+
+  sdf::SDFPtr stateSdf(new sdf::SDF);
+  stateSdf->SetFromString(stream.str());
+  sdf::ElementPtr worldElem = stateSdf->Root()->HasElement("world") ?
+      stateSdf->Root()->GetElement("world") : sdf::ElementPtr();
+  if (!worldElem || !worldElem->HasElement("state") ||
+      !worldElem->GetElement("state")->HasElement("model"))
+  {
+    return false;
+  }
+
+  _modelState.Load(worldElem->GetElement("state")->GetElement("model"));
+  return true;
+}
+
+/// \brief Fill an entity of a partition state.
+/// \param[out] _entity Entity to fill.
+/// \param[in] _model Model.
+/// \param[in] _sdf SDF of the model, or empty.
+/// \param[in] _state State of the model, or empty.
+static void FillEntity(msgs::PartitionState::Entity *_entity,
+    const physics::ModelPtr &_model, const std::string &_sdf,
+    const std::string &_state = std::string())
+{
+  _entity->set_name(_model->GetName());
+  msgs::Set(_entity->mutable_pose(), _model->WorldPose());
+  msgs::Set(_entity->mutable_linear_velocity(), _model->WorldLinearVel());
+  msgs::Set(_entity->mutable_angular_velocity(), _model->WorldAngularVel());
+  if (!_sdf.empty())
+    _entity->set_sdf(_sdf);
+  if (!_state.empty())
+    _entity->set_state(_state);
+}
+
+/////////////////////////////////////////////////
+PartitionPlugin::PartitionPlugin()
+  : dataPtr(new PartitionPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+PartitionPlugin::~PartitionPlugin()
+{
+  // Release a world thread waiting for a neighbor
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->connections.clear();
+  }
+  this->dataPtr->condition.notify_all();
+}
+
+/////////////////////////////////////////////////
+void PartitionPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
+{
+  this->dataPtr->world = _world;
+
+  if (!_sdf->HasElement("region") || !_sdf->HasElement("region_count"))
+  {
+    gzerr << "Missing required parameters <region> and <region_count>, "
+          << "plugin will not be initialized." << std::endl;
+    return;
+  }
+
+  const int region = _sdf->Get<int>("region");
+  const int regionCount = _sdf->Get<int>("region_count");
+  if (regionCount < 1 || region < 0 || region >= regionCount)
+  {
+    gzerr << "Region [" << region << "] is not within [0, " << regionCount
+          << "), plugin will not be initialized." << std::endl;
+    return;
+  }
+
+  std::vector<double> boundaries;
+  if (_sdf->HasElement("boundaries"))
+  {
+    std::istringstream stream(_sdf->Get<std::string>("boundaries"));
+    double boundary;
+    while (stream >> boundary)
+      boundaries.push_back(boundary);
+  }
+
+  if (boundaries.size() != static_cast<size_t>(regionCount - 1) ||
+      !std::is_sorted(boundaries.begin(), boundaries.end()))
+  {
+    gzerr << "<boundaries> must hold " << regionCount - 1 << " increasing "
+          << "values, plugin will not be initialized." << std::endl;
+    return;
+  }
+
+  this->dataPtr->region = region;
+  this->dataPtr->hasNeighbor[PARTITION_LOWER] = region > 0;
+  this->dataPtr->hasNeighbor[PARTITION_UPPER] = region < regionCount - 1;
+  if (region > 0)
+    this->dataPtr->minX = boundaries[region - 1];
+  if (region < regionCount - 1)
+    this->dataPtr->maxX = boundaries[region];
+
+  if (_sdf->HasElement("halo"))
+    this->dataPtr->halo = std::max(_sdf->Get<double>("halo"), 0.0);
+  if (_sdf->HasElement("sync"))
+    this->dataPtr->sync = _sdf->Get<bool>("sync");
+  if (_sdf->HasElement("sync_timeout"))
+  {
+    this->dataPtr->syncTimeout =
+        std::max(_sdf->Get<double>("sync_timeout"), 0.0);
+  }
+
+  this->dataPtr->node = transport::NodePtr(new transport::Node());
+  this->dataPtr->node->Init(_world->Name());
+  this->dataPtr->factoryPub =
+      this->dataPtr->node->Advertise<msgs::Factory>("~/factory");
+
+  for (int side = 0; side < PARTITION_SIDE_COUNT; ++side)
+  {
+    if (!this->dataPtr->hasNeighbor[side])
+      continue;
+
+    const int neighbor = side == PARTITION_LOWER ? region - 1 : region + 1;
+    this->dataPtr->statePubs[side] =
+        this->dataPtr->node->Advertise<msgs::PartitionState>(
+        StateTopic(region, neighbor));
+    this->dataPtr->stateSubs[side] = this->dataPtr->node->Subscribe(
+        StateTopic(neighbor, region), &PartitionPlugin::OnState, this);
+  }
+
+  this->dataPtr->connections.push_back(
+      event::Events::ConnectWorldUpdateBegin(
+      std::bind(&PartitionPlugin::OnUpdateBegin, this)));
+  this->dataPtr->connections.push_back(
+      event::Events::ConnectWorldUpdateEnd(
+      std::bind(&PartitionPlugin::OnUpdateEnd, this)));
+
+  gzmsg << "World [" << _world->Name() << "] simulates region [" << region
+        << "] from x = " << this->dataPtr->minX << " to x = "
+        << this->dataPtr->maxX << std::endl;
+}
+
+/////////////////////////////////////////////////
+void PartitionPlugin::OnState(ConstPartitionStatePtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  const int side = _msg->region() < this->dataPtr->region ?
+      PARTITION_LOWER : PARTITION_UPPER;
+  this->dataPtr->lastIteration[side] = std::max(
+      this->dataPtr->lastIteration[side],
+      static_cast<int64_t>(_msg->iteration()));
+  this->dataPtr->received.push_back(*_msg);
+  this->dataPtr->condition.notify_all();
+}
+
+/////////////////////////////////////////////////
+void PartitionPlugin::OnUpdateBegin()
+{
+  auto &world = this->dataPtr->world;
+
+  // The migrants left at the end of the previous step
+  for (auto const &name : this->dataPtr->migrated)
+    world->RemoveModel(name);
+  this->dataPtr->migrated.clear();
+
+  std::deque<msgs::PartitionState> states;
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+
+    // Wait until each neighbor we heard from has finished the step we
+    // finished. A neighbor that does not answer in time is dropped until
+    // it sends again.
+    if (this->dataPtr->sync)
+    {
+      const int64_t iterations = world->Iterations();
+      for (int side = 0; side < PARTITION_SIDE_COUNT; ++side)
+      {
+        if (!this->dataPtr->hasNeighbor[side] ||
+            this->dataPtr->lastIteration[side] < 0)
+        {
+          continue;
+        }
+
+        const bool caughtUp = this->dataPtr->condition.wait_for(lock,
+            std::chrono::duration<double>(this->dataPtr->syncTimeout),
+            [&]()
+            {
+              return this->dataPtr->lastIteration[side] >= iterations ||
+                  this->dataPtr->connections.empty();
+            });
+
+        if (!caughtUp)
+        {
+          gzwarn << "Region [" << this->dataPtr->region << "] stopped "
+                 << "waiting for its neighbor at iteration [" << iterations
+                 << "]" << std::endl;
+          this->dataPtr->lastIteration[side] = -1;
+        }
+      }
+    }
+
+    states.swap(this->dataPtr->received);
+  }
+
+  for (auto const &state : states)
+  {
+    for (auto const &ghost : state.ghost())
+    {
+      physics::ModelPtr model = world->ModelByName(ghost.name());
+      if (model)
+      {
+        if (this->dataPtr->ghosts.count(ghost.name()))
+          model->SetWorldPose(msgs::ConvertIgn(ghost.pose()));
+      }
+      else if (ghost.has_sdf() && !this->dataPtr->ghosts.count(ghost.name()))
+      {
+        msgs::Factory msg;
+        msg.set_sdf(ghost.sdf());
+        msg.set_allow_renaming(false);
+        this->dataPtr->factoryPub->Publish(msg);
+        this->dataPtr->ghosts.insert(ghost.name());
+      }
+    }
+
+    for (auto const &name : state.removed())
+    {
+      if (this->dataPtr->ghosts.erase(name))
+        world->RemoveModel(name);
+    }
+
+    for (auto const &migrant : state.migrant())
+    {
+      if (this->dataPtr->ghosts.erase(migrant.name()))
+        world->RemoveModel(migrant.name());
+
+      msgs::Factory msg;
+      msg.set_sdf(migrant.sdf());
+      msg.set_allow_renaming(false);
+      this->dataPtr->factoryPub->Publish(msg);
+
+      physics::ModelState modelState;
+      if (!ParseModelState(migrant.state(), modelState))
+      {
+        gzerr << "Invalid state of migrant [" << migrant.name() << "]"
+              << std::endl;
+      }
+      this->dataPtr->pendingStates[migrant.name()] = modelState;
+    }
+  }
+
+  // Give the migrants inserted since the previous step the state of their
+  // links
+  for (auto iter = this->dataPtr->pendingStates.begin();
+       iter != this->dataPtr->pendingStates.end();)
+  {
+    physics::ModelPtr model = world->ModelByName(iter->first);
+    if (model)
+    {
+      if (iter->second.GetLinkStateCount() > 0)
+        model->SetState(iter->second);
+      iter = this->dataPtr->pendingStates.erase(iter);
+    }
+    else
+      ++iter;
+  }
+}
+
+/////////////////////////////////////////////////
+void PartitionPlugin::OnUpdateEnd()
+{
+  auto &world = this->dataPtr->world;
+
+  msgs::PartitionState states[PARTITION_SIDE_COUNT];
+  std::set<std::string> seen[PARTITION_SIDE_COUNT];
+  for (int side = 0; side < PARTITION_SIDE_COUNT; ++side)
+  {
+    states[side].set_region(this->dataPtr->region);
+    states[side].set_iteration(world->Iterations());
+    msgs::Set(states[side].mutable_time(), world->SimTime());
+  }
+
+  for (auto const &model : world->Models())
+  {
+    const std::string &name = model->GetName();
+    if (model->IsStatic() || this->dataPtr->ghosts.count(name) ||
+        this->dataPtr->pendingStates.count(name))
+    {
+      continue;
+    }
+
+    const double x = model->WorldPose().Pos().X();
+
+    // Migrate the models that left the region
+    int destination = -1;
+    if (this->dataPtr->hasNeighbor[PARTITION_LOWER] && x < this->dataPtr->minX)
+      destination = PARTITION_LOWER;
+    else if (this->dataPtr->hasNeighbor[PARTITION_UPPER] &&
+             x >= this->dataPtr->maxX)
+      destination = PARTITION_UPPER;
+
+    if (destination >= 0)
+    {
+      FillEntity(states[destination].add_migrant(), model,
+          ModelSdf(model, false), ModelStateSdf(model));
+      this->dataPtr->migrated.push_back(name);
+      continue;
+    }
+
+    // Send the models within the halo of each neighbor
+    const bool inHalo[PARTITION_SIDE_COUNT] = {
+        x < this->dataPtr->minX + this->dataPtr->halo,
+        x >= this->dataPtr->maxX - this->dataPtr->halo};
+    for (int side = 0; side < PARTITION_SIDE_COUNT; ++side)
+    {
+      if (!this->dataPtr->hasNeighbor[side] || !inHalo[side])
+        continue;
+
+      const bool known = this->dataPtr->sent[side].count(name) > 0;
+      FillEntity(states[side].add_ghost(), model,
+          known ? std::string() : ModelSdf(model, true));
+      seen[side].insert(name);
+    }
+  }
+
+  for (int side = 0; side < PARTITION_SIDE_COUNT; ++side)
+  {
+    if (!this->dataPtr->hasNeighbor[side])
+      continue;
+
+    // The ghosts of models that left the halo, that migrated or that were
+    // deleted get removed, unless the neighbor receives the model itself.
+    for (auto const &name : this->dataPtr->sent[side])
+    {
+      if (seen[side].count(name))
+        continue;
+
+      bool migrant = false;
+      for (auto const &entity : states[side].migrant())
+        migrant = migrant || entity.name() == name;
+      if (!migrant)
+        states[side].add_removed(name);
+    }
+    this->dataPtr->sent[side].swap(seen[side]);
+
+    this->dataPtr->statePubs[side]->Publish(states[side]);
+  }
+}
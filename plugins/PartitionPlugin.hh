@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_PARTITIONPLUGIN_HH_
+#define GAZEBO_PLUGINS_PARTITIONPLUGIN_HH_
+
+#include <memory>
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  class PartitionPluginPrivate;
+
+  /// \brief World plugin that splits one large world into regions along
+  /// the X axis, each simulated by its own gzserver. All servers load the
+  /// same world file with a different <region>, and share one Master, on
+  /// one machine or through GAZEBO_MASTER_URI.
+  ///
+  /// A region owns the dynamic models whose origin lies within its bounds.
+  /// After each step it sends to each neighbor the owned models within
+  /// <halo> meters of their common boundary, and the neighbor keeps a
+  /// static ghost copy of each, which its own models collide with. A model
+  /// that crosses a boundary migrates: the region removes it and the
+  /// neighbor replaces its ghost with a dynamic copy, and gives it the
+  /// model state of the sender, with the pose, velocity, acceleration and
+  /// wrench of each link. Static models are left to the world file of
+  /// each region.
+  ///
+  /// With <sync>, a region waits for the state of step N of its neighbors
+  /// before it runs step N + 1, so the regions step in lockstep.
+  ///
+  /// Example usage:
+  ///
+  ///  <plugin name="partition" filename="libPartitionPlugin.so">
+  ///    <!-- Index of this region, from 0 to region_count - 1 -->
+  ///    <region>1</region>
+  ///    <region_count>3</region_count>
+  ///
+  ///    <!-- Boundaries between the regions, region_count - 1 values.
+  ///         Region i spans from boundary i - 1 to boundary i. -->
+  ///    <boundaries>-100 100</boundaries>
+  ///
+  ///    <!-- Width of the ghost band on each side of a boundary, in
+  ///         meters - 5 by default -->
+  ///    <halo>5</halo>
+  ///
+  ///    <!-- Step in lockstep with the neighbors - true by default -->
+  ///    <sync>true</sync>
+  ///
+  ///    <!-- Time to wait for a neighbor before stepping anyway, in
+  ///         seconds of wall time - 1 by default -->
+  ///    <sync_timeout>1.0</sync_timeout>
+  ///  </plugin>
+  ///
+  /// The state of region i to region j is published on
+  /// /gazebo/partition/<i>/to/<j> as msgs::PartitionState.
+  class GZ_PLUGIN_VISIBLE PartitionPlugin : public WorldPlugin
+  {
+    /// \brief Constructor.
+    public: PartitionPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~PartitionPlugin();
+
+    // Documentation inherited
+    public: void Load(physics::WorldPtr _world, sdf::ElementPtr _sdf) override;
+
+    /// \brief Called before each step. Waits for the neighbors, then
+    /// applies their states.
+    private: void OnUpdateBegin();
+
+    /// \brief Called after each step. Sends the border models and the
+    /// migrants to the neighbors.
+    private: void OnUpdateEnd();
+
+    /// \brief Receive the state of a neighbor.
+    /// \param[in] _msg State message.
+    private: void OnState(ConstPartitionStatePtr &_msg);
+
+    /// \brief Pointer to private data
+    private: std::unique_ptr<PartitionPluginPrivate> dataPtr;
+  };
+}
+#endif
@@ -18,12 +18,12 @@
 #include <chrono>
 #include <functional>
 #include <thread>
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Pose3.hh>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/PID.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/transport/transport.hh"
 #include "plugins/PlaneDemoPlugin.hh"
 
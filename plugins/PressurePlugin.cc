@@ -17,7 +17,7 @@
 
 #include <functional>
 #include <boost/algorithm/string.hpp>
-#include <ignition/common/Profiler.hh>
+#include "gazebo/common/TraceCapture.hh"
 #include <ignition/math/Vector3.hh>
 #include <gazebo/physics/Base.hh>
 #include "PressurePlugin.hh"
@@ -20,7 +20,6 @@
 
 #include <boost/version.hpp>
 
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Pose3.hh>
 
@@ -28,6 +27,7 @@
 #include "joints/contact.h"
 
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/transport/transport.hh"
 
 #include "plugins/SimpleTrackedVehiclePlugin.hh"
@@ -58,6 +58,8 @@ GZ_REGISTER_MODEL_PLUGIN(SimpleTrackedVehiclePlugin)
 
 SimpleTrackedVehiclePlugin::~SimpleTrackedVehiclePlugin()
 {
+  this->RemoveContactModifiers();
+
   if (this->body != nullptr)
   {
     if (globalTracks.find(this->body) != globalTracks.end())
@@ -203,10 +205,9 @@ void SimpleTrackedVehiclePlugin::Init()
 
   physics::ModelPtr model = this->body->GetModel();
 
-  this->contactManager = model->GetWorld()->Physics()->GetContactManager();
-  // otherwise contact manager would not publish any contacts (since we are not
-  // a real contact subscriber)
-  this->contactManager->SetNeverDropContacts(true);
+  this->odePhysics = boost::dynamic_pointer_cast<physics::ODEPhysics>(
+      model->GetWorld()->Physics());
+  GZ_ASSERT(this->odePhysics, "SimpleTrackedVehiclePlugin needs ODE");
 
   // set correct categories and collide bitmasks
   this->SetGeomCategories();
@@ -215,16 +216,53 @@ void SimpleTrackedVehiclePlugin::Init()
   // SDF model)
   this->UpdateTrackSurface();
 
+  // adjust the contacts of the tracks right when ODE creates their contact
+  // joints; the other collision pairs never reach this plugin
+  this->RemoveContactModifiers();
+  auto& gtracks = globalTracks.at(this->body);
+  for (auto trackSide : gtracks)
+  {
+    for (auto trackLink : trackSide.second)
+    {
+      for (auto const &collision : trackLink->GetCollisions())
+      {
+        auto odeCollision =
+          boost::static_pointer_cast<physics::ODECollision>(collision);
+        const size_t index = this->trackCollisions.size();
+        this->trackCollisions.push_back(odeCollision.get());
+        this->odePhysics->SetContactModifier(odeCollision.get(),
+            [this, index](physics::ODECollision *_collision,
+                          physics::ODECollision *_other,
+                          dContact *_contacts, unsigned int _count)
+            {
+              this->ModifyContacts(index, _collision, _other, _contacts,
+                                   _count);
+            });
+      }
+    }
+  }
+  this->trackBeltSpeeds.assign(this->trackCollisions.size(), 0);
+  this->trackPositions.assign(this->trackCollisions.size(),
+      ignition::math::Vector3d::Zero);
+
   // initialize Gazebo node, subscribers and publishers and event connections
   this->node = transport::NodePtr(new transport::Node());
   this->node->Init(model->GetWorld()->Name());
 
-  this->beforePhysicsUpdateConnection =
-      event::Events::ConnectBeforePhysicsUpdate(
+  // the motion has to be known before the collisions are processed
+  this->updateConnection =
+      event::Events::ConnectWorldUpdateBegin(
           std::bind(&SimpleTrackedVehiclePlugin::DriveTracks, this,
                     std::placeholders::_1));
 }
 
+void SimpleTrackedVehiclePlugin::RemoveContactModifiers()
+{
+  for (auto collision : this->trackCollisions)
+    this->odePhysics->SetContactModifier(collision, nullptr);
+  this->trackCollisions.clear();
+}
+
 void SimpleTrackedVehiclePlugin::Reset()
 {
   TrackedVehiclePlugin::Reset();
@@ -302,11 +340,7 @@ size_t SimpleTrackedVehiclePlugin::GetNumTracks(const Tracks side) const
 void SimpleTrackedVehiclePlugin::DriveTracks(
     const common::UpdateInfo &/*_unused*/)
 {
-  if (this->contactManager->GetContactCount() == 0)
-    return;
-
   IGN_PROFILE("SimpleTrackedVehiclePlugin::DriveTracks");
-  IGN_PROFILE_BEGIN("Update");
 
   /////////////////////////////////////////////
   // Calculate the desired center of rotation
@@ -316,175 +350,121 @@ void SimpleTrackedVehiclePlugin::DriveTracks(
   const auto rightBeltSpeed = -this->trackVelocity[Tracks::RIGHT];
 
   // the desired linear and angular speeds (set by desired track velocities)
-  const auto linearSpeed = (leftBeltSpeed + rightBeltSpeed) / 2;
-  const auto angularSpeed = -(leftBeltSpeed - rightBeltSpeed) *
+  this->linearSpeed = (leftBeltSpeed + rightBeltSpeed) / 2;
+  this->angularSpeed = -(leftBeltSpeed - rightBeltSpeed) *
     this->GetSteeringEfficiency() / this->GetTracksSeparation();
 
   // radius of the turn the robot is doing
   const auto desiredRotationRadiusSigned =
-                               (fabs(angularSpeed) < 0.1) ?
+                               (fabs(this->angularSpeed) < 0.1) ?
                                // is driving straight
                                dInfinity :
                                (
-                                 (fabs(linearSpeed) < 0.1) ?
+                                 (fabs(this->linearSpeed) < 0.1) ?
                                  // is rotating about a single point
                                  0 :
                                  // general movement
-                                 linearSpeed / angularSpeed);
-
-  const auto bodyPose = this->body->WorldPose();
-  const auto bodyYAxisGlobal =
-    bodyPose.Rot().RotateVector(ignition::math::Vector3d(0, 1, 0));
-  const auto centerOfRotation =
-    (bodyYAxisGlobal * desiredRotationRadiusSigned) + bodyPose.Pos();
-
-  ////////////////////////////////////////////////////////////////////////
-  // For each contact, compute the friction force direction and speed of
-  // surface movement.
-  ////////////////////////////////////////////////////////////////////////
-  size_t i = 0;
-  const auto contacts = this->contactManager->GetContacts();
-  const auto model = this->body->GetModel();
-
-  for (auto contact : contacts)
+                                 this->linearSpeed / this->angularSpeed);
+  this->drivingStraight = desiredRotationRadiusSigned == dInfinity;
+
+  this->bodyPose = this->body->WorldPose();
+  this->bodyYAxisGlobal =
+    this->bodyPose.Rot().RotateVector(ignition::math::Vector3d(0, 1, 0));
+  this->centerOfRotation =
+    (this->bodyYAxisGlobal * desiredRotationRadiusSigned) +
+    this->bodyPose.Pos();
+
+  // speed and position of each track collision, shared by all its contacts
+  for (size_t i = 0; i < this->trackCollisions.size(); ++i)
   {
-    // Beware! There may be invalid contacts beyond GetContactCount()...
-    if (i == this->contactManager->GetContactCount())
-      break;
-
-    ++i;
-
-    if (contact->collision1->GetSurface()->collideWithoutContact ||
-      contact->collision2->GetSurface()->collideWithoutContact)
-      continue;
-
-    if (!contact->collision1->GetLink()->GetEnabled() ||
-      !contact->collision2->GetLink()->GetEnabled())
-      continue;
-
-    if (contact->collision1->IsStatic() && contact->collision2->IsStatic())
-    {
-      // we're not interested in static model collisions
-      // (they do not have any ODE bodies).
-      continue;
-    }
-
-    if (model != contact->collision1->GetLink()->GetModel() &&
-        model != contact->collision2->GetLink()->GetModel())
-    {
-      // Verify one of the collisions' bodies is a track of this vehicle
-      continue;
-    }
-
-    dBodyID body1 = dynamic_cast<physics::ODELink&>(
-      *contact->collision1->GetLink()).GetODEId();
-    dBodyID body2 = dynamic_cast<physics::ODELink& >(
-      *contact->collision2->GetLink()).GetODEId();
-
-    dGeomID geom1 = dynamic_cast<physics::ODECollision& >(
-      *contact->collision1).GetCollisionId();
-    dGeomID geom2 = dynamic_cast<physics::ODECollision& >(
-      *contact->collision2).GetCollisionId();
-
-    bool bodiesSwapped = false;
-    if (body1 == 0)
-    {
-      std::swap(body1, body2);
-      std::swap(geom1, geom2);
-
-      // we'll take care of the normal flipping later
-      bodiesSwapped = true;
-    }
-
-    // determine if track is the first or second collision element
-    const bool isGeom1Track = (dGeomGetCategoryBits(geom1) & BELT_CATEGORY) > 0;
-    const bool isGeom2Track = (dGeomGetCategoryBits(geom2) & BELT_CATEGORY) > 0;
-
-    if (!isGeom1Track && !isGeom2Track)
-      continue;
-
-    // speed and geometry of the track in collision
-    const auto trackGeom = (isGeom1Track ? geom1 : geom2);
-    // the != means XOR here; we basically want to get the collision belonging
-    // to the track, but we might have swapped the ODE bodies in between,
-    // so we have to account for it
-    const physics::Collision* trackCollision =
-      ((isGeom1Track != bodiesSwapped) ? contact->collision1
-                                       : contact->collision2);
-    const dReal beltSpeed =
-      (dGeomGetCategoryBits(trackGeom) & LEFT_CATEGORY) != 0 ?
+    const auto collision = this->trackCollisions[i];
+    this->trackBeltSpeeds[i] =
+      (dGeomGetCategoryBits(collision->GetCollisionId()) & LEFT_CATEGORY) != 0 ?
       leftBeltSpeed : rightBeltSpeed;
+    this->trackPositions[i] = collision->WorldPose().Pos();
+  }
+}
 
-    // remember if we've found at least one contact joint (we should!)
-    bool foundContact = false;
-    for (auto contactIterator = ContactIterator::begin(body1, geom1, geom2);
-         contactIterator != ContactIterator::end();
-         ++contactIterator)
-    {
-      dContact* odeContact = contactIterator.getPointer();
-
-      // now we're sure it is a contact between our two geometries
-      foundContact = true;
-
-      const ignition::math::Vector3d contactWorldPosition(
-        odeContact->geom.pos[0],
-        odeContact->geom.pos[1],
-        odeContact->geom.pos[2]);
-
-      ignition::math::Vector3d contactNormal(
-        odeContact->geom.normal[0],
-        odeContact->geom.normal[1],
-        odeContact->geom.normal[2]);
-
-      // We always want contactNormal to point "inside" the track.
-      // The dot product is 1 for co-directional vectors and -1 for
-      // opposite-pointing vectors.
-      // The contact can be flipped either by swapping body1 and body2 above,
-      // or by having some flipped faces on collision meshes.
-      const double normalToTrackCenterDot =
-        contactNormal.Dot(
-          trackCollision->WorldPose().Pos() - contactWorldPosition);
-      if (normalToTrackCenterDot < 0)
-      {
-        contactNormal = -contactNormal;
-      }
-
-      // vector tangent to the belt pointing in the belt's movement direction
-      auto beltDirection(contactNormal.Cross(bodyYAxisGlobal));
-
-      if (beltSpeed > 0)
-        beltDirection = -beltDirection;
+void SimpleTrackedVehiclePlugin::ModifyContacts(const size_t _track,
+    physics::ODECollision *_collision, physics::ODECollision *_other,
+    dContact *_contacts, const unsigned int _count)
+{
+  if (_collision->GetSurface()->collideWithoutContact ||
+    _other->GetSurface()->collideWithoutContact)
+    return;
 
-      const auto frictionDirection =
-        this->ComputeFrictionDirection(linearSpeed,
-                                       angularSpeed,
-                                       desiredRotationRadiusSigned == dInfinity,
-                                       bodyPose,
-                                       bodyYAxisGlobal,
-                                       centerOfRotation,
-                                       contactWorldPosition,
-                                       contactNormal,
-                                       beltDirection);
+  if (!_collision->GetLink()->GetEnabled() ||
+    !_other->GetLink()->GetEnabled())
+    return;
 
-      odeContact->fdir1[0] = frictionDirection.X();
-      odeContact->fdir1[1] = frictionDirection.Y();
-      odeContact->fdir1[2] = frictionDirection.Z();
+  if (_collision->IsStatic() && _other->IsStatic())
+  {
+    // we're not interested in static model collisions
+    // (they do not have any ODE bodies).
+    return;
+  }
 
-      // use friction direction and motion1 to simulate the track movement
-      odeContact->surface.mode |= dContactFDir1 | dContactMotion1;
+  // contacts between two tracks are processed by only one of them
+  if ((dGeomGetCategoryBits(_other->GetCollisionId()) & BELT_CATEGORY) != 0 &&
+      _other < _collision)
+    return;
 
-      odeContact->surface.motion1 = this->ComputeSurfaceMotion(
-        beltSpeed, beltDirection, frictionDirection);
-    }
+  const double beltSpeed = this->trackBeltSpeeds[_track];
+  const auto &trackPosition = this->trackPositions[_track];
 
-    if (!foundContact)
-    {
-      gzwarn << "No ODE contact joint found for contact " <<
-             contact->DebugString() << std::endl;
-      continue;
-    }
+  ////////////////////////////////////////////////////////////////////////
+  // For each contact, compute the friction force direction and speed of
+  // surface movement.
+  ////////////////////////////////////////////////////////////////////////
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    dContact &odeContact = _contacts[i];
+
+    const ignition::math::Vector3d contactWorldPosition(
+      odeContact.geom.pos[0],
+      odeContact.geom.pos[1],
+      odeContact.geom.pos[2]);
+
+    ignition::math::Vector3d contactNormal(
+      odeContact.geom.normal[0],
+      odeContact.geom.normal[1],
+      odeContact.geom.normal[2]);
+
+    // We always want contactNormal to point "inside" the track.
+    // The dot product is 1 for co-directional vectors and -1 for
+    // opposite-pointing vectors.
+    // The contact can be flipped either by the order of the geometries,
+    // or by having some flipped faces on collision meshes.
+    if (contactNormal.Dot(trackPosition - contactWorldPosition) < 0)
+      contactNormal = -contactNormal;
+
+    // vector tangent to the belt pointing in the belt's movement direction
+    auto beltDirection(contactNormal.Cross(this->bodyYAxisGlobal));
+
+    if (beltSpeed > 0)
+      beltDirection = -beltDirection;
+
+    const auto frictionDirection =
+      this->ComputeFrictionDirection(this->linearSpeed,
+                                     this->angularSpeed,
+                                     this->drivingStraight,
+                                     this->bodyPose,
+                                     this->bodyYAxisGlobal,
+                                     this->centerOfRotation,
+                                     contactWorldPosition,
+                                     contactNormal,
+                                     beltDirection);
+
+    odeContact.fdir1[0] = frictionDirection.X();
+    odeContact.fdir1[1] = frictionDirection.Y();
+    odeContact.fdir1[2] = frictionDirection.Z();
+
+    // use friction direction and motion1 to simulate the track movement
+    odeContact.surface.mode |= dContactFDir1 | dContactMotion1;
+
+    odeContact.surface.motion1 = this->ComputeSurfaceMotion(
+      beltSpeed, beltDirection, frictionDirection);
   }
-  IGN_PROFILE_END();
 }
 
 ignition::math::Vector3d SimpleTrackedVehiclePlugin::ComputeFrictionDirection(
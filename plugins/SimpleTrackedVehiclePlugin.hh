@@ -20,12 +20,14 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
 
 #include <gazebo/physics/ode/ode_inc.h>
 #include <gazebo/physics/ode/ODELink.hh>
 #include <gazebo/physics/ode/ODECollision.hh>
+#include <gazebo/physics/ode/ODEPhysics.hh>
 #include <gazebo/ode/contact.h>
 
 #include "gazebo/common/Plugin.hh"
@@ -97,7 +99,9 @@ namespace gazebo {
     /// \brief Desired velocities of the tracks.
     protected: std::unordered_map<Tracks, double> trackVelocity;
 
-    /// \brief Compute and apply the forces that make the tracks move.
+    /// \brief Compute the desired motion of the vehicle for the current
+    ///        step. The ODE contact modifiers of the tracks then apply it
+    ///        to the contacts of the tracks.
     protected: void DriveTracks(const common::UpdateInfo &/*_unused*/);
 
     /// \brief Return the number of tracks on the given side. Should always be
@@ -142,9 +146,24 @@ namespace gazebo {
       const ignition::math::Vector3d &_beltDirection,
       const ignition::math::Vector3d &_frictionDirection) const;
 
+    /// \brief Set the friction direction and surface motion of the
+    ///        contacts of a track collision.
+    /// \param[in] _track Index of the collision in trackCollisions.
+    /// \param[in] _collision The track collision.
+    /// \param[in] _other The other collision of the pair.
+    /// \param[in,out] _contacts The contacts of the pair.
+    /// \param[in] _count Number of contacts.
+    private: void ModifyContacts(size_t _track,
+                 physics::ODECollision *_collision,
+                 physics::ODECollision *_other,
+                 dContact *_contacts, unsigned int _count);
+
+    /// \brief Remove the contact modifiers of the track collisions.
+    private: void RemoveContactModifiers();
+
     private: transport::NodePtr node;
 
-    private: event::ConnectionPtr beforePhysicsUpdateConnection;
+    private: event::ConnectionPtr updateConnection;
 
     /// \brief This bitmask will be set to the whole vehicle body.
     protected: unsigned int collideWithoutContactBitmask;
@@ -155,7 +174,36 @@ namespace gazebo {
     /// \brief Category for all items on the left side.
     protected: static const unsigned int LEFT_CATEGORY = 0x40000000;
 
-    private: physics::ContactManager *contactManager;
+    /// \brief The physics engine the contact modifiers are set on.
+    private: physics::ODEPhysicsPtr odePhysics;
+
+    /// \brief Collisions of all tracks and flippers.
+    private: std::vector<physics::ODECollision *> trackCollisions;
+
+    /// \brief Desired belt speed of each collision in trackCollisions.
+    private: std::vector<double> trackBeltSpeeds;
+
+    /// \brief World position of each collision in trackCollisions in the
+    ///        current step.
+    private: std::vector<ignition::math::Vector3d> trackPositions;
+
+    /// \brief Desired linear speed of the vehicle in the current step.
+    private: double linearSpeed = 0;
+
+    /// \brief Desired angular speed of the vehicle in the current step.
+    private: double angularSpeed = 0;
+
+    /// \brief Whether the vehicle drives straight in the current step.
+    private: bool drivingStraight = true;
+
+    /// \brief Pose of the body in the current step.
+    private: ignition::math::Pose3d bodyPose;
+
+    /// \brief World direction of the y-axis of the body in the current step.
+    private: ignition::math::Vector3d bodyYAxisGlobal;
+
+    /// \brief Center of the circle the vehicle follows in the current step.
+    private: ignition::math::Vector3d centerOfRotation;
 
     /// \class ContactIterator
     /// \brief An iterator over all contacts between two geometries.
@@ -17,8 +17,7 @@
 
 #include <string>
 
-#include <ignition/common/Profiler.hh>
-
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/physics.hh"
 #include "gazebo/transport/transport.hh"
 #include "plugins/SkidSteerDrivePlugin.hh"
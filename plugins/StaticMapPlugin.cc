@@ -18,6 +18,15 @@
 #include <curl/curl.h>
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/SphericalCoordinates.hh>
@@ -50,9 +59,42 @@ namespace gazebo
   };
 
 
+  /// \brief Download of one map tile into the tile cache.
+  class TileDownload
+  {
+    /// \brief URL of the tile.
+    public: std::string url;
+
+    /// \brief Path of the tile in the tile cache.
+    public: std::string cachePath;
+
+    /// \brief File the response body is written to.
+    public: FILE *file = nullptr;
+
+    /// \brief ETag header of the response.
+    public: std::string etag;
+
+    /// \brief Request headers.
+    public: struct curl_slist *headers = nullptr;
+
+    /// \brief True once the cache holds a valid copy of the tile.
+    public: bool done = false;
+  };
+
   /// \brief Private data class for StaticMapPlugin
   class StaticMapPluginPrivate
   {
+    /// \brief Download tiles into the tile cache, several at a time. A tile
+    /// that is already cached is revalidated with its ETag and
+    /// modification time, and only downloaded again if it changed.
+    /// \param[in,out] _downloads Tiles to download.
+    public: void FetchTiles(std::vector<TileDownload> &_downloads);
+
+    /// \brief Download the map tiles, create the map model and spawn it.
+    /// Runs on loadThread.
+    /// \param[in] _modelPath Path of the model in the gazebo model path.
+    public: void BuildMap(const boost::filesystem::path &_modelPath);
+
     /// \brief Download map tiles.
     /// \param[in] _centerLat Latitude of center point of map
     /// \param[in] _centerLon Longitude of center point of map
@@ -66,6 +108,8 @@ namespace gazebo
     /// \param[in] _apiKey Google API key
     /// \param[in] _saveDirPath Location in local filesystem to save tile
     /// images.
+    /// \return Filenames of the tiles in _saveDirPath, empty if the
+    /// download was stopped.
     public: std::vector<std::string> DownloadMapTiles(const double _centerLat,
         const double _centerLon, const unsigned int _zoom,
         const unsigned int _tileSizePx,
@@ -146,6 +190,19 @@ namespace gazebo
 
     /// \brief True if the plugin is loaded successfully
     public: bool loaded = false;
+
+    /// \brief Maximum number of concurrent tile downloads.
+    public: unsigned int maxConnections = 8u;
+
+    /// \brief Directory of downloaded tiles, shared by all maps.
+    public: boost::filesystem::path tileCachePath;
+
+    /// \brief Downloads the tiles and builds the map model while the world
+    /// runs.
+    public: std::thread loadThread;
+
+    /// \brief True to stop the downloads of loadThread.
+    public: std::atomic<bool> stop{false};
   };
 }
 
@@ -163,59 +220,26 @@ size_t WriteData(void *_ptr, size_t _size, size_t _nmemb, FILE *_stream)
 }
 
 /////////////////////////////////////////////////
-bool DownloadFile(const std::string &_url, const std::string &_outputFile)
+size_t WriteHeader(char *_buffer, size_t _size, size_t _nitems, void *_data)
 {
-  if (_url.empty())
-    return false;
-
-  CURL *curl = curl_easy_init();
-
-  curl_easy_setopt(curl, CURLOPT_URL, _url.c_str());
-  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteData);
-
-  FILE *fp = fopen(_outputFile.c_str(), "wb");
-  if (!fp)
-  {
-    gzerr << "Could not download model[" << _url << "] because we were"
-      << "unable to write to file[" << _outputFile << "]."
-      << "Please fix file permissions.";
-    return false;
-  }
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
-
-  char errbuf[CURL_ERROR_SIZE];
-  // provide a buffer to store errors in
-  curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, errbuf);
-  // set the error buffer as empty before performing a request
-  errbuf[0] = 0;
-
-  CURLcode success = curl_easy_perform(curl);
-  if (success != CURLE_OK)
+  const size_t length = _size * _nitems;
+  std::string header(_buffer, length);
+  const std::string name = "etag:";
+  if (header.size() > name.size() &&
+      std::equal(name.begin(), name.end(), header.begin(),
+        [](const char _a, const char _b)
+        {
+          return _a == std::tolower(static_cast<unsigned char>(_b));
+        }))
   {
-    gzerr << "Error in REST request" << std::endl;
-    size_t len = strlen(errbuf);
-    fprintf(stderr, "\nlibcurl: (%d) ", success);
-    if (len)
-    {
-      fprintf(stderr, "%s%s", errbuf,
-              ((errbuf[len - 1] != '\n') ? "\n" : ""));
-    }
-    else
-      fprintf(stderr, "%s\n", curl_easy_strerror(success));
+    std::string value = header.substr(name.size());
+    value.erase(0, value.find_first_not_of(" \t"));
+    value.erase(value.find_last_not_of(" \t\r\n") + 1);
+    static_cast<TileDownload *>(_data)->etag = value;
   }
-  fclose(fp);
-
-  // Update the status code.
-  int statusCode = 0;
-  curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
-
-  // Cleaning.
-  curl_easy_cleanup(curl);
-
-  return true;
+  return length;
 }
 
-
 /////////////////////////////////////////////////
 ignition::math::Vector2d MercatorProjection::LatLonToPoint(
     const ignition::math::SphericalCoordinates &_latLon)
@@ -261,6 +285,14 @@ StaticMapPlugin::StaticMapPlugin()
 {
 }
 
+/////////////////////////////////////////////////
+StaticMapPlugin::~StaticMapPlugin()
+{
+  this->dataPtr->stop = true;
+  if (this->dataPtr->loadThread.joinable())
+    this->dataPtr->loadThread.join();
+}
+
 /////////////////////////////////////////////////
 void StaticMapPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
 {
@@ -322,6 +354,12 @@ void StaticMapPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
   if (_sdf->HasElement("use_cache"))
     this->dataPtr->useCache = _sdf->Get<bool>("use_cache");
 
+  if (_sdf->HasElement("max_connections"))
+  {
+    this->dataPtr->maxConnections =
+        std::max(_sdf->Get<unsigned int>("max_connections"), 1u);
+  }
+
   if (_sdf->HasElement("pose"))
     this->dataPtr->modelPose = _sdf->Get<ignition::math::Pose3d>("pose");
 
@@ -367,56 +405,68 @@ void StaticMapPlugin::Init()
     return;
   }
 
+  // Download the tiles and build the model while the world runs
+  this->dataPtr->tileCachePath =
+      common::SystemPaths::Instance()->GetLogPath() /
+      boost::filesystem::path("static_map_tiles");
+  this->dataPtr->loadThread = std::thread(
+      &StaticMapPluginPrivate::BuildMap, this->dataPtr.get(), modelPath);
+}
 
+/////////////////////////////////////////////////
+void StaticMapPluginPrivate::BuildMap(const boost::filesystem::path &_modelPath)
+{
   // create tmp dir to save model files
   boost::filesystem::path tmpModelPath =
-      boost::filesystem::temp_directory_path() / this->dataPtr->modelName;
+      boost::filesystem::temp_directory_path() / this->modelName;
   boost::filesystem::path scriptsPath(tmpModelPath / "materials" / "scripts");
   boost::filesystem::create_directories(scriptsPath);
   boost::filesystem::path texturesPath(tmpModelPath / "materials" / "textures");
   boost::filesystem::create_directories(texturesPath);
 
   // download map tile images into model/materials/textures
-  std::vector<std::string> tiles = this->dataPtr->DownloadMapTiles(
-      this->dataPtr->center.X(),
-      this->dataPtr->center.Y(),
-      this->dataPtr->zoom,
-      this->dataPtr->tileSizePx,
-      this->dataPtr->worldSize,
-      this->dataPtr->mapType,
-      this->dataPtr->apiKey,
+  std::vector<std::string> tiles = this->DownloadMapTiles(
+      this->center.X(),
+      this->center.Y(),
+      this->zoom,
+      this->tileSizePx,
+      this->worldSize,
+      this->mapType,
+      this->apiKey,
       texturesPath.string());
+  if (tiles.empty())
+    return;
 
   // assume square model for now
   unsigned int xNumTiles = std::sqrt(tiles.size());
   unsigned int yNumTiles = xNumTiles;
 
-  double tileWorldSize = this->dataPtr->GroundResolution(
-      IGN_DTOR(this->dataPtr->center.X()), this->dataPtr->zoom)
-      * this->dataPtr->tileSizePx;
+  double tileWorldSize = this->GroundResolution(
+      IGN_DTOR(this->center.X()), this->zoom)
+      * this->tileSizePx;
 
   // create model and spawn it into the world
-  if (this->dataPtr->CreateMapTileModel(
-      this->dataPtr->modelName, tileWorldSize,
+  if (this->CreateMapTileModel(
+      this->modelName, tileWorldSize,
       xNumTiles, yNumTiles, tiles, tmpModelPath.string()))
   {
     // verify model dir is created
     if (common::exists(tmpModelPath.string()))
     {
       // remove existing map model
-      if (common::exists(modelPath.string()))
-        boost::filesystem::remove_all(modelPath);
+      if (common::exists(_modelPath.string()))
+        boost::filesystem::remove_all(_modelPath);
 
       try
       {
         // move new map model to gazebo model path
-        boost::filesystem::rename(tmpModelPath, modelPath);
+        boost::filesystem::rename(tmpModelPath, _modelPath);
       }
       catch(boost::filesystem::filesystem_error &_e)
       {
         // rename failed. Could be an invalid cross-device link error
         // try copy and remove method
-        bool result = common::copyDir(tmpModelPath, modelPath);
+        bool result = common::copyDir(tmpModelPath, _modelPath);
         if (result)
         {
           boost::filesystem::remove_all(tmpModelPath);
@@ -424,13 +474,13 @@ void StaticMapPlugin::Init()
         else
         {
           gzerr<< "Unable to copy model from '" << tmpModelPath.string()
-                 << "' to '" << modelPath.string() << "'" << std::endl;
+                 << "' to '" << _modelPath.string() << "'" << std::endl;
           return;
         }
       }
       // spawn the model
-      this->dataPtr->SpawnModel("model://" + this->dataPtr->modelName,
-          this->dataPtr->modelPose);
+      this->SpawnModel("model://" + this->modelName,
+          this->modelPose);
     }
     else
       gzerr << "Failed to create model: " << tmpModelPath.string() << std::endl;
@@ -495,6 +545,8 @@ std::vector<std::string> StaticMapPluginPrivate::DownloadMapTiles(
 
   // download map tiles using google static map API
   std::string url = "https://maps.googleapis.com/maps/api/staticmap";
+  std::vector<TileDownload> downloads;
+  std::vector<std::string> filenames;
   for (unsigned int i = 0; i < yNumTiles; ++i)
   {
     for (unsigned int j = 0; j < xNumTiles; ++j)
@@ -520,17 +572,166 @@ std::vector<std::string> StaticMapPluginPrivate::DownloadMapTiles(
       filename << "tile_"
                << std::setprecision(9) << latLon.LatitudeReference().Degree()
                << "_" << latLon.LongitudeReference().Degree() << ".png";
-      std::string fullPath = _saveDirPath + "/" + filename.str();
-      DownloadFile(fullURL, fullPath);
-      gzmsg << "Downloading map tile: " << filename.str() << std::endl;
-      mapTileFilenames.push_back(filename.str());
+
+      // Tiles are cached by everything the image depends on
+      std::stringstream cacheName;
+      cacheName << _mapType << "_" << _zoom << "_" << _tileSizePx << "_"
+                << std::setprecision(9) << latLon.LatitudeReference().Degree()
+                << "_" << latLon.LongitudeReference().Degree() << ".png";
+
+      TileDownload download;
+      download.url = fullURL;
+      download.cachePath = (this->tileCachePath / cacheName.str()).string();
+      downloads.push_back(download);
+      filenames.push_back(filename.str());
 
       x += _tileSizePx;
     }
     x = startx;
     y += _tileSizePx;
   }
-  return mapTileFilenames;
+
+  gzmsg << "Downloading " << downloads.size() << " map tiles" << std::endl;
+  this->FetchTiles(downloads);
+  if (this->stop)
+    return std::vector<std::string>();
+
+  for (size_t i = 0; i < downloads.size(); ++i)
+  {
+    if (!downloads[i].done)
+    {
+      gzerr << "Unable to download map tile: " << filenames[i] << std::endl;
+      continue;
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::copy_file(downloads[i].cachePath,
+        boost::filesystem::path(_saveDirPath) / filenames[i],
+        boost::filesystem::copy_option::overwrite_if_exists, ec);
+    if (ec)
+    {
+      gzerr << "Unable to copy map tile[" << downloads[i].cachePath
+            << "]: " << ec.message() << std::endl;
+    }
+  }
+
+  this->mapTileFilenames = filenames;
+  return this->mapTileFilenames;
+}
+
+/////////////////////////////////////////////////
+void StaticMapPluginPrivate::FetchTiles(std::vector<TileDownload> &_downloads)
+{
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(this->tileCachePath, ec);
+
+  CURLM *multi = curl_multi_init();
+  curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS,
+      static_cast<long>(this->maxConnections));
+
+  for (auto &download : _downloads)
+  {
+    const std::string partPath = download.cachePath + ".part";
+    download.file = fopen(partPath.c_str(), "wb");
+    if (!download.file)
+    {
+      gzerr << "Unable to write map tile to file[" << partPath << "]"
+            << std::endl;
+      continue;
+    }
+
+    CURL *curl = curl_easy_init();
+    curl_easy_setopt(curl, CURLOPT_URL, download.url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteData);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, download.file);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, WriteHeader);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &download);
+    curl_easy_setopt(curl, CURLOPT_PRIVATE, &download);
+
+    // Revalidate a cached tile instead of downloading it again
+    if (common::isFile(download.cachePath))
+    {
+      std::ifstream etagFile(download.cachePath + ".etag");
+      std::string etag;
+      if (std::getline(etagFile, etag) && !etag.empty())
+      {
+        download.headers = curl_slist_append(download.headers,
+            ("If-None-Match: " + etag).c_str());
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, download.headers);
+      }
+      curl_easy_setopt(curl, CURLOPT_TIMECONDITION, CURL_TIMECOND_IFMODSINCE);
+      curl_easy_setopt(curl, CURLOPT_TIMEVALUE, static_cast<long>(
+          boost::filesystem::last_write_time(download.cachePath, ec)));
+    }
+    curl_multi_add_handle(multi, curl);
+  }
+
+  int running = 0;
+  do
+  {
+    curl_multi_perform(multi, &running);
+
+    CURLMsg *msg;
+    int queued;
+    while ((msg = curl_multi_info_read(multi, &queued)))
+    {
+      if (msg->msg != CURLMSG_DONE)
+        continue;
+
+      CURL *curl = msg->easy_handle;
+      char *data = nullptr;
+      curl_easy_getinfo(curl, CURLINFO_PRIVATE, &data);
+      TileDownload *download = reinterpret_cast<TileDownload *>(data);
+      fclose(download->file);
+      download->file = nullptr;
+
+      long statusCode = 0;
+      curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
+      const std::string partPath = download->cachePath + ".part";
+      const bool cached = common::isFile(download->cachePath);
+      if (msg->data.result == CURLE_OK && statusCode == 200)
+      {
+        boost::filesystem::rename(partPath, download->cachePath, ec);
+        download->done = !ec;
+        std::ofstream etagFile(download->cachePath + ".etag");
+        etagFile << download->etag << std::endl;
+      }
+      else
+      {
+        boost::filesystem::remove(partPath, ec);
+        if (msg->data.result != CURLE_OK)
+        {
+          gzwarn << "Map tile download failed: "
+                 << curl_easy_strerror(msg->data.result) << std::endl;
+        }
+        // Not modified, or a failure with a copy to fall back on
+        download->done = cached;
+      }
+
+      curl_multi_remove_handle(multi, curl);
+      curl_easy_cleanup(curl);
+      curl_slist_free_all(download->headers);
+      download->headers = nullptr;
+    }
+
+    if (running > 0)
+      curl_multi_wait(multi, nullptr, 0, 100, nullptr);
+  }
+  while (running > 0 && !this->stop);
+
+  // Handles of a stopped download
+  for (auto &download : _downloads)
+  {
+    if (download.file)
+    {
+      fclose(download.file);
+      download.file = nullptr;
+      boost::filesystem::remove(download.cachePath + ".part", ec);
+    }
+    curl_slist_free_all(download.headers);
+    download.headers = nullptr;
+  }
+  curl_multi_cleanup(multi);
 }
 
 /////////////////////////////////////////////////
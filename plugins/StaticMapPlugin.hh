@@ -52,11 +52,21 @@ namespace gazebo
   ///              API documentation for more details.
   /// <use_cache>  Use model in gazebo model path if exists, otherwise
   ///              recreate the model and save it in <HOME>/.gazebo/models
+  /// <max_connections> Maximum number of tiles downloaded at a time,
+  ///              8 by default.
+  ///
+  /// The tiles are downloaded and the model is created on a separate
+  /// thread, so the world runs while the map loads. Downloaded tiles are
+  /// kept in <HOME>/.gazebo/static_map_tiles, and revalidated with the
+  /// server when a map needs them again.
   class GZ_PLUGIN_VISIBLE StaticMapPlugin : public WorldPlugin
   {
     /// \brief Constructor.
     public: StaticMapPlugin();
 
+    /// \brief Destructor. Stops the tile downloads.
+    public: virtual ~StaticMapPlugin();
+
     /// \brief Load the plugin.
     /// \param[in] _world Pointer to world
     /// \param[in] _sdf Pointer to the SDF configuration.
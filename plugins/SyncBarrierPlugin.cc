@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Events.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/transport/transport.hh"
+
+#include "SyncBarrierPlugin.hh"
+
+namespace gazebo
+{
+  /// \brief Acknowledgement state of a sensor host.
+  class SyncBarrierHost
+  {
+    /// \brief Time of the latest acknowledged poses.
+    public: common::Time time;
+
+    /// \brief True once the host is heard from.
+    public: bool heard = false;
+
+    /// \brief True after the host timed out, until it acknowledges newer
+    /// poses.
+    public: bool dropped = false;
+
+    /// \brief Wall time spent waiting for the host.
+    public: common::Time waitTime;
+
+    /// \brief Number of timeouts.
+    public: unsigned int timeouts = 0;
+  };
+
+  /// \brief Private data class for the SyncBarrierPlugin class
+  class SyncBarrierPluginPrivate
+  {
+    /// \brief Pointer to the world.
+    public: physics::WorldPtr world;
+
+    /// \brief Connection to the world update begin event.
+    public: event::ConnectionPtr updateConnection;
+
+    /// \brief Transport node.
+    public: transport::NodePtr node;
+
+    /// \brief Acknowledgement publisher, on a sensor host.
+    public: transport::PublisherPtr ackPub;
+
+    /// \brief Status publisher, on the physics server.
+    public: transport::PublisherPtr statusPub;
+
+    /// \brief Acknowledgement or poses subscriber.
+    public: transport::SubscriberPtr sub;
+
+    /// \brief Name of the sensor host.
+    public: std::string host;
+
+    /// \brief Lag allowed, in seconds of simulation time.
+    public: double maxLag = 0.02;
+
+    /// \brief Time to wait for a host, in seconds of wall time.
+    public: double timeout = 1.0;
+
+    /// \brief Protects hosts and latestPoses.
+    public: std::mutex mutex;
+
+    /// \brief Notified when an acknowledgement is received.
+    public: std::condition_variable condition;
+
+    /// \brief Required hosts, on the physics server.
+    public: std::map<std::string, SyncBarrierHost> hosts;
+
+    /// \brief Time of the latest poses received, on a sensor host.
+    public: common::Time latestPoses;
+
+    /// \brief Time of the poses the sensors were updated with during the
+    /// last step, on a sensor host.
+    public: common::Time renderedPoses;
+
+    /// \brief True once poses were received before the last step.
+    public: bool hasRenderedPoses = false;
+
+    /// \brief True while the plugin is being destroyed.
+    public: bool stop = false;
+  };
+}
+
+using namespace gazebo;
+
+GZ_REGISTER_WORLD_PLUGIN(SyncBarrierPlugin)
+
+/////////////////////////////////////////////////
+SyncBarrierPlugin::SyncBarrierPlugin()
+  : dataPtr(new SyncBarrierPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+SyncBarrierPlugin::~SyncBarrierPlugin()
+{
+  // Release a world thread waiting for a host
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->condition.notify_all();
+  this->dataPtr->updateConnection.reset();
+}
+
+/////////////////////////////////////////////////
+void SyncBarrierPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
+{
+  this->dataPtr->world = _world;
+
+  const std::string role = _sdf->HasElement("role") ?
+      _sdf->Get<std::string>("role") : "physics";
+
+  this->dataPtr->node = transport::NodePtr(new transport::Node());
+  this->dataPtr->node->Init(_world->Name());
+
+  if (role == "sensor")
+  {
+    if (!_sdf->HasElement("host"))
+    {
+      gzerr << "Missing required parameter <host>, "
+            << "plugin will not be initialized." << std::endl;
+      return;
+    }
+    this->dataPtr->host = _sdf->Get<std::string>("host");
+
+    // Without lockstep, the start of a step does not mean the sensors
+    // rendered the poses received before the previous step
+    if (!rendering::lockstep_enabled())
+    {
+      gzerr << "The sensor role requires gzserver --lockstep, "
+            << "plugin will not be initialized." << std::endl;
+      return;
+    }
+
+    const std::string topic = _sdf->HasElement("topic") ?
+        _sdf->Get<std::string>("topic") : "~/pose/local/info";
+
+    this->dataPtr->ackPub =
+        this->dataPtr->node->Advertise<msgs::SyncAck>("~/sync_barrier/ack");
+    this->dataPtr->sub = this->dataPtr->node->Subscribe(topic,
+        &SyncBarrierPlugin::OnPoses, this);
+
+    this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&SyncBarrierPlugin::OnSensorUpdate, this));
+  }
+  else if (role == "physics")
+  {
+    for (sdf::ElementPtr hostElem = _sdf->HasElement("host") ?
+         _sdf->GetElement("host") : sdf::ElementPtr(); hostElem;
+         hostElem = hostElem->GetNextElement("host"))
+    {
+      this->dataPtr->hosts[hostElem->Get<std::string>()];
+    }
+
+    if (this->dataPtr->hosts.empty())
+    {
+      gzerr << "No <host> to wait for, "
+            << "plugin will not be initialized." << std::endl;
+      return;
+    }
+
+    if (_sdf->HasElement("max_lag"))
+      this->dataPtr->maxLag = std::max(_sdf->Get<double>("max_lag"), 0.0);
+    if (_sdf->HasElement("timeout"))
+      this->dataPtr->timeout = std::max(_sdf->Get<double>("timeout"), 0.0);
+
+    this->dataPtr->statusPub =
+        this->dataPtr->node->Advertise<msgs::SyncStatus>(
+        "~/sync_barrier/status", 10, 10);
+    this->dataPtr->sub = this->dataPtr->node->Subscribe(
+        "~/sync_barrier/ack", &SyncBarrierPlugin::OnAck, this);
+
+    this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&SyncBarrierPlugin::OnPhysicsUpdate, this));
+  }
+  else
+  {
+    gzerr << "Unknown <role> [" << role << "], expected [physics] or "
+          << "[sensor], plugin will not be initialized." << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+void SyncBarrierPlugin::OnAck(ConstSyncAckPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto iter = this->dataPtr->hosts.find(_msg->host());
+  if (iter == this->dataPtr->hosts.end())
+    return;
+
+  // A host that timed out rejoins once it makes progress, a repeated
+  // acknowledgement of the same poses does not bring it back.
+  SyncBarrierHost &host = iter->second;
+  const common::Time time = msgs::Convert(_msg->time());
+  if (!host.heard || time > host.time)
+  {
+    if (host.dropped)
+    {
+      gzmsg << "Sensor host [" << iter->first << "] rejoined at time ["
+            << time << "]" << std::endl;
+    }
+    host.time = time;
+    host.dropped = false;
+  }
+  host.heard = true;
+  this->dataPtr->condition.notify_all();
+}
+
+/////////////////////////////////////////////////
+void SyncBarrierPlugin::OnPoses(ConstPosesStampedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->latestPoses = msgs::Convert(_msg->time());
+}
+
+/////////////////////////////////////////////////
+void SyncBarrierPlugin::OnPhysicsUpdate()
+{
+  const common::Time simTime = this->dataPtr->world->SimTime();
+  const common::Time maxLag(this->dataPtr->maxLag);
+
+  msgs::SyncStatus status;
+  msgs::Set(status.mutable_time(), simTime);
+
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  for (auto &iter : this->dataPtr->hosts)
+  {
+    SyncBarrierHost &host = iter.second;
+    if (host.heard && !host.dropped && simTime - host.time > maxLag)
+    {
+      const common::Time start = common::Time::GetWallTime();
+      const bool caughtUp = this->dataPtr->condition.wait_for(lock,
+          std::chrono::duration<double>(this->dataPtr->timeout),
+          [&]()
+          {
+            return simTime - host.time <= maxLag || this->dataPtr->stop;
+          });
+      host.waitTime += common::Time::GetWallTime() - start;
+
+      if (!caughtUp)
+      {
+        gzwarn << "Stopped waiting for sensor host [" << iter.first
+               << "] at time [" << simTime << "], it lags by ["
+               << (simTime - host.time).Double() << "] s" << std::endl;
+        host.dropped = true;
+        ++host.timeouts;
+      }
+    }
+
+    msgs::SyncStatus::Host *hostMsg = status.add_host();
+    hostMsg->set_name(iter.first);
+    hostMsg->set_lag(host.heard ? (simTime - host.time).Double() : -1.0);
+    hostMsg->set_dropped(host.dropped);
+    hostMsg->set_wait_time(host.waitTime.Double());
+    hostMsg->set_timeouts(host.timeouts);
+  }
+  lock.unlock();
+
+  this->dataPtr->statusPub->Publish(status);
+}
+
+/////////////////////////////////////////////////
+void SyncBarrierPlugin::OnSensorUpdate()
+{
+  // The strict rate sensors are done with the previous step, so the poses
+  // received before it have been rendered.
+  msgs::SyncAck ack;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->hasRenderedPoses)
+      msgs::Set(ack.mutable_time(), this->dataPtr->renderedPoses);
+    this->dataPtr->renderedPoses = this->dataPtr->latestPoses;
+    this->dataPtr->hasRenderedPoses = this->dataPtr->latestPoses !=
+        common::Time::Zero;
+  }
+
+  if (!ack.has_time())
+    return;
+
+  ack.set_host(this->dataPtr->host);
+  msgs::Set(ack.mutable_host_time(), this->dataPtr->world->SimTime());
+  this->dataPtr->ackPub->Publish(ack);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_SYNCBARRIERPLUGIN_HH_
+#define GAZEBO_PLUGINS_SYNCBARRIERPLUGIN_HH_
+
+#include <memory>
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  class SyncBarrierPluginPrivate;
+
+  /// \brief World plugin that keeps sensor hosts in lockstep with a physics
+  /// server. A sensor host is a gzserver that loads the same world and
+  /// mirrors the poses of the physics server from ~/pose/local/info to
+  /// update its rendering sensors.
+  ///
+  /// On a sensor host, the plugin acknowledges on ~/sync_barrier/ack the
+  /// time of the latest poses its sensors were updated with. It sends the
+  /// acknowledgement at the start of each step of the host, once the
+  /// strict rate sensors of the host are done, see
+  /// SensorManager::WaitForSensors. Only lockstep makes the step wait for
+  /// the sensors, so the sensor role requires gzserver --lockstep and
+  /// is not initialized without it.
+  ///
+  /// On the physics server, the plugin blocks each step until every
+  /// required host lags by at most <max_lag> seconds of simulation time,
+  /// and publishes the lag of each host on ~/sync_barrier/status as
+  /// msgs::SyncStatus. A host not heard from yet is not waited for. A
+  /// host that does not catch up within <timeout> seconds of wall time is
+  /// dropped: it is not waited for until it acknowledges poses newer than
+  /// the ones it timed out with, and then it rejoins.
+  ///
+  /// Example usage on the physics server:
+  ///
+  ///  <plugin name="sync" filename="libSyncBarrierPlugin.so">
+  ///    <role>physics</role>
+  ///
+  ///    <!-- Names of the hosts to wait for -->
+  ///    <host>camera_host</host>
+  ///    <host>lidar_host</host>
+  ///
+  ///    <!-- Lag allowed before blocking, in seconds of simulation time -
+  ///         0.02 by default -->
+  ///    <max_lag>0.02</max_lag>
+  ///
+  ///    <!-- Time to wait for a host, in seconds of wall time -
+  ///         1 by default -->
+  ///    <timeout>1.0</timeout>
+  ///  </plugin>
+  ///
+  /// Example usage on a sensor host:
+  ///
+  ///  <plugin name="sync" filename="libSyncBarrierPlugin.so">
+  ///    <role>sensor</role>
+  ///    <host>camera_host</host>
+  ///  </plugin>
+  class GZ_PLUGIN_VISIBLE SyncBarrierPlugin : public WorldPlugin
+  {
+    /// \brief Constructor.
+    public: SyncBarrierPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~SyncBarrierPlugin();
+
+    // Documentation inherited
+    public: void Load(physics::WorldPtr _world, sdf::ElementPtr _sdf) override;
+
+    /// \brief Called before each step of the physics server. Waits for the
+    /// hosts that lag too much.
+    private: void OnPhysicsUpdate();
+
+    /// \brief Called before each step of a sensor host. Acknowledges the
+    /// poses the sensors were updated with.
+    private: void OnSensorUpdate();
+
+    /// \brief Receive an acknowledgement, on the physics server.
+    /// \param[in] _msg Acknowledgement message.
+    private: void OnAck(ConstSyncAckPtr &_msg);
+
+    /// \brief Receive the poses of the physics server, on a sensor host.
+    /// \param[in] _msg Poses message.
+    private: void OnPoses(ConstPosesStampedPtr &_msg);
+
+    /// \brief Pointer to private data
+    private: std::unique_ptr<SyncBarrierPluginPrivate> dataPtr;
+  };
+}
+#endif
@@ -17,7 +17,7 @@
 
 #include <functional>
 #include <string>
-#include <ignition/common/Profiler.hh>
+#include "gazebo/common/TraceCapture.hh"
 #include <gazebo/common/Assert.hh>
 #include <gazebo/physics/Model.hh>
 #include <gazebo/sensors/SensorManager.hh>
@@ -17,8 +17,7 @@
 #include <map>
 #include <mutex>
 
-#include <ignition/common/Profiler.hh>
-
+#include "gazebo/common/TraceCapture.hh"
 #include <gazebo/common/Assert.hh>
 #include <gazebo/common/CommonTypes.hh>
 #include <gazebo/common/Console.hh>
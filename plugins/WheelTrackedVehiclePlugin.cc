@@ -17,9 +17,8 @@
 
 #include <boost/pointer_cast.hpp>
 
-#include <ignition/common/Profiler.hh>
-
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/TraceCapture.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 
 #include "WheelTrackedVehiclePlugin.hh"
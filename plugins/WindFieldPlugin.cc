@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/common/CommonIface.hh"
+
+#include "plugins/WindFieldPlugin.hh"
+
+using namespace gazebo;
+
+GZ_REGISTER_WORLD_PLUGIN(WindFieldPlugin)
+
+/////////////////////////////////////////////////
+WindFieldPlugin::~WindFieldPlugin()
+{
+  if (this->world && this->field && this->world->Wind().Field() == this->field)
+    this->world->Wind().SetField(physics::WindFieldPtr());
+}
+
+/////////////////////////////////////////////////
+void WindFieldPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
+{
+  GZ_ASSERT(_world, "WindFieldPlugin world pointer is NULL");
+  this->world = _world;
+
+  if (!_sdf->HasElement("uri"))
+  {
+    gzerr << "WindFieldPlugin requires a <uri>\n";
+    return;
+  }
+
+  const std::string uri = _sdf->Get<std::string>("uri");
+  const std::string path = common::find_file(uri);
+  if (path.empty())
+  {
+    gzerr << "Unable to find wind field [" << uri << "]\n";
+    return;
+  }
+
+  physics::WindFieldPtr windField(new physics::WindField());
+  if (!windField->Load(path))
+    return;
+
+  if (_sdf->HasElement("loop"))
+    windField->SetLoop(_sdf->Get<bool>("loop"));
+
+  this->field = windField;
+  this->world->Wind().SetField(this->field);
+
+  gzmsg << "Loaded wind field [" << path << "] with "
+        << this->field->FrameCount() << " frames over ["
+        << this->field->Min() << "] [" << this->field->Max() << "]\n";
+}
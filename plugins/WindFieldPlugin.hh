@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_WINDFIELDPLUGIN_HH_
+#define GAZEBO_PLUGINS_WINDFIELDPLUGIN_HH_
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/physics/physics.hh"
+
+namespace gazebo
+{
+  /// \brief A plugin that loads a gridded wind field, see
+  /// physics::WindField, and sets it as the wind of the world. The links
+  /// with wind enabled then get the wind of the field at their location.
+  ///
+  /// Example:
+  ///
+  ///    <plugin name="wind_field" filename="libWindFieldPlugin.so">
+  ///      <!-- Wind field file, absolute or in the resource paths -->
+  ///      <uri>file://media/wind/canyon.gzwind</uri>
+  ///      <!-- Repeat the frames of the field, defaults to false -->
+  ///      <loop>true</loop>
+  ///    </plugin>
+  class GZ_PLUGIN_VISIBLE WindFieldPlugin : public WorldPlugin
+  {
+    /// \brief Destructor.
+    public: virtual ~WindFieldPlugin();
+
+    // Documentation inherited
+    public: virtual void Load(physics::WorldPtr _world, sdf::ElementPtr _sdf);
+
+    /// \brief World whose wind uses the field.
+    private: physics::WorldPtr world;
+
+    /// \brief The loaded field.
+    private: physics::WindFieldPtr field;
+  };
+}
+#endif
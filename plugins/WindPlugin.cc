@@ -17,11 +17,10 @@
 
 #include <functional>
 
-#include <ignition/common/Profiler.hh>
-
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Event.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/TraceCapture.hh"
 
 #include "gazebo/sensors/Noise.hh"
 
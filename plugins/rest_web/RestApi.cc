@@ -14,12 +14,19 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <cstring>
+#include <memory>
 #include <stdlib.h>
 #include <curl/curl.h>
 #include <cinttypes>
 
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
 #include "RestApi.hh"
 
 using namespace gazebo;
@@ -182,15 +189,44 @@ static size_t WriteMemoryCallback(void *_contents,
   return realsize;
 }
 
+/////////////////////////////////////////////////
+// gzip encode a request body
+static std::string Compress(const std::string &_data)
+{
+  std::string out;
+  {
+    boost::iostreams::filtering_ostream os;
+    os.push(boost::iostreams::gzip_compressor());
+    os.push(boost::iostreams::back_inserter(out));
+    os.write(_data.data(), _data.size());
+  }
+  return out;
+}
+
+/// \brief Largest number of requests in progress at the same time.
+static const size_t kMaxTransfers = 4u;
+
+/// \brief Longest wait before a failed request is sent again.
+static const double kMaxRetryDelay = 30.0;
+
 /////////////////////////////////////////////////
 RestApi::RestApi()
   :isLoggedIn(false)
 {
+  curl_global_init(CURL_GLOBAL_ALL);
 }
 
 /////////////////////////////////////////////////
 RestApi::~RestApi()
 {
+  {
+    std::lock_guard<std::mutex> lock(this->postsMutex);
+    this->stopSender = true;
+  }
+  this->postsCondition.notify_all();
+  if (this->senderThread.joinable())
+    this->senderThread.join();
+
   curl_global_cleanup();
 }
 
@@ -200,11 +236,98 @@ void RestApi::PostJsonData(const char *_route, const char *_json)
   Post post;
   post.route = _route;
   post.json = _json;
+  bool full = false;
   {
     std::lock_guard<std::mutex> lock(this->postsMutex);
+    if (this->posts.size() >= this->maxQueuedPosts)
+    {
+      this->posts.pop_front();
+      full = true;
+    }
     this->posts.push_back(post);
   }
-  this->SendUnpostedPosts();
+  if (full)
+    this->DropPosts(1u, "queue is full");
+
+  if (this->isLoggedIn)
+    this->postsCondition.notify_one();
+}
+
+/////////////////////////////////////////////////
+void RestApi::SetBatchSize(const unsigned int _size)
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  this->batchSize = std::max(1u, _size);
+}
+
+/////////////////////////////////////////////////
+unsigned int RestApi::BatchSize() const
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  return this->batchSize;
+}
+
+/////////////////////////////////////////////////
+void RestApi::SetCompression(const bool _enable)
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  this->compression = _enable;
+}
+
+/////////////////////////////////////////////////
+bool RestApi::Compression() const
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  return this->compression;
+}
+
+/////////////////////////////////////////////////
+void RestApi::SetMaxQueuedPosts(const unsigned int _count)
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  this->maxQueuedPosts = std::max(1u, _count);
+}
+
+/////////////////////////////////////////////////
+void RestApi::SetMaxRetries(const unsigned int _count)
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  this->maxRetries = _count;
+}
+
+/////////////////////////////////////////////////
+void RestApi::SetErrorCallback(
+    std::function<void (const std::string &)> _cb)
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  this->errorCallback = _cb;
+}
+
+/////////////////////////////////////////////////
+size_t RestApi::QueuedPostCount() const
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  return this->posts.size();
+}
+
+/////////////////////////////////////////////////
+uint64_t RestApi::DroppedPostCount() const
+{
+  return this->droppedPosts;
+}
+
+/////////////////////////////////////////////////
+void RestApi::DropPosts(const unsigned int _count, const std::string &_reason)
+{
+  uint64_t before = this->droppedPosts.fetch_add(_count);
+
+  // Warn on the first drop and then once every 1000 dropped posts.
+  if (before == 0u || before / 1000u != (before + _count) / 1000u)
+  {
+    gzwarn << "REST service: dropped " << _count << " post(s), "
+           << _reason << ". " << before + _count << " dropped in total."
+           << std::endl;
+  }
 }
 
 /////////////////////////////////////////////////
@@ -214,9 +337,12 @@ std::string RestApi::Login(const std::string &_urlStr,
                            const std::string &_passStr)
 {
   this->isLoggedIn = false;
-  this->url = _urlStr;
-  this->user = _userStr;
-  this->pass = _passStr;
+  {
+    std::lock_guard<std::mutex> lock(this->postsMutex);
+    this->url = _urlStr;
+    this->user = _userStr;
+    this->pass = _passStr;
+  }
 
   // at this point we want to test the (user supplied) login data
   // so we're hitting the server on the login route ('/login')
@@ -228,7 +354,9 @@ std::string RestApi::Login(const std::string &_urlStr,
   gzmsg << "login response: " << resp << std::endl;
 
   this->isLoggedIn = true;
-  this->SendUnpostedPosts();
+  if (!this->senderThread.joinable())
+    this->senderThread = std::thread(&RestApi::RunSender, this);
+  this->postsCondition.notify_one();
   return resp;
 }
 
@@ -240,29 +368,207 @@ void RestApi::Logout()
 }
 
 /////////////////////////////////////////////////
-void RestApi::SendUnpostedPosts()
+bool RestApi::NextBatch(Batch &_batch)
 {
-  if (this->isLoggedIn)
+  common::Time now = common::Time::GetWallTime();
+  for (auto it = this->retries.begin(); it != this->retries.end(); ++it)
+  {
+    if (it->retryTime <= now)
+    {
+      _batch = *it;
+      this->retries.erase(it);
+      return true;
+    }
+  }
+
+  if (this->posts.empty())
+    return false;
+
+  // Combine consecutive posts to the same route
+  _batch = Batch();
+  _batch.route = this->posts.front().route;
+  std::string body;
+  while (!this->posts.empty() && _batch.postCount < this->batchSize &&
+         this->posts.front().route == _batch.route)
+  {
+    if (this->batchSize > 1u)
+      body += _batch.postCount == 0u ? "[" : ",";
+    body += this->posts.front().json;
+    this->posts.pop_front();
+    ++_batch.postCount;
+  }
+  if (this->batchSize > 1u)
+    body += "]";
+
+  if (this->compression)
+  {
+    _batch.body = Compress(body);
+    _batch.compressed = true;
+  }
+  else
+  {
+    _batch.body = body;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void RestApi::RunSender()
+{
+  // A request in progress
+  struct Transfer
+  {
+    Batch batch;
+    CURL *curl = nullptr;
+    struct curl_slist *headers = nullptr;
+    std::string path;
+    std::string userpass;
+    std::string response;
+  };
+
+  CURLM *multi = curl_multi_init();
+  std::list<std::unique_ptr<Transfer>> transfers;
+
+  while (true)
   {
-    while (!this->posts.empty())
     {
-      Post post;
+      std::unique_lock<std::mutex> lock(this->postsMutex);
+      this->postsCondition.wait_for(lock, std::chrono::milliseconds(100),
+          [this, &transfers]
+          {
+            return this->stopSender || !transfers.empty() ||
+                (this->isLoggedIn && !this->posts.empty());
+          });
+      if (this->stopSender)
+        break;
+
+      Batch batch;
+      while (this->isLoggedIn && transfers.size() < kMaxTransfers &&
+             this->NextBatch(batch))
       {
-        std::lock_guard<std::mutex> lock(this->postsMutex);
-        post = this->posts.front();
+        std::unique_ptr<Transfer> t(new Transfer);
+        t->batch = batch;
+        t->path = this->url + batch.route;
+        t->userpass = this->user + ":" + this->pass;
+        t->curl = curl_easy_init();
 
         //  You can generate a similar request on the cmd line like so:
         //  curl --verbose --connect-timeout 5 -X POST
         //    -H \"Content-Type: application/json \" -k --user"
-        this->Request(post.route, post.json);
-        this->posts.pop_front();
+        curl_easy_setopt(t->curl, CURLOPT_URL, t->path.c_str());
+        curl_easy_setopt(t->curl, CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(t->curl, CURLOPT_SSL_VERIFYHOST, 0L);
+        curl_easy_setopt(t->curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
+        curl_easy_setopt(t->curl, CURLOPT_HTTPAUTH, CURLAUTH_BASIC);
+        curl_easy_setopt(t->curl, CURLOPT_USERPWD, t->userpass.c_str());
+        curl_easy_setopt(t->curl, CURLOPT_CONNECTTIMEOUT, 10L);
+        curl_easy_setopt(t->curl, CURLOPT_TIMEOUT, 60L);
+        curl_easy_setopt(t->curl, CURLOPT_POST, 1L);
+        curl_easy_setopt(t->curl, CURLOPT_POSTFIELDS, t->batch.body.data());
+        curl_easy_setopt(t->curl, CURLOPT_POSTFIELDSIZE,
+            static_cast<long>(t->batch.body.size()));
+        curl_easy_setopt(t->curl, CURLOPT_WRITEFUNCTION,
+            static_cast<size_t (*)(char *, size_t, size_t, void *)>(
+            [](char *_data, size_t _size, size_t _n, void *_userp) -> size_t
+            {
+              static_cast<std::string *>(_userp)->append(_data, _size * _n);
+              return _size * _n;
+            }));
+        curl_easy_setopt(t->curl, CURLOPT_WRITEDATA, &t->response);
+        curl_easy_setopt(t->curl, CURLOPT_PRIVATE, t.get());
+
+        t->headers = curl_slist_append(t->headers,
+            "Content-Type: application/json");
+        t->headers = curl_slist_append(t->headers, "charsets: utf-8");
+        if (t->batch.compressed)
+        {
+          t->headers = curl_slist_append(t->headers,
+              "Content-Encoding: gzip");
+        }
+        curl_easy_setopt(t->curl, CURLOPT_HTTPHEADER, t->headers);
+
+        ++t->batch.attempts;
+        curl_multi_add_handle(multi, t->curl);
+        transfers.push_back(std::move(t));
       }
     }
+
+    if (transfers.empty())
+      continue;
+
+    int running = 0;
+    curl_multi_perform(multi, &running);
+    curl_multi_wait(multi, nullptr, 0, 100, nullptr);
+    curl_multi_perform(multi, &running);
+
+    CURLMsg *msg;
+    int left;
+    while ((msg = curl_multi_info_read(multi, &left)))
+    {
+      if (msg->msg != CURLMSG_DONE)
+        continue;
+
+      char *priv = nullptr;
+      curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &priv);
+      Transfer *t = reinterpret_cast<Transfer *>(priv);
+
+      long httpCode = 0;
+      curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &httpCode);
+
+      std::string error;
+      if (msg->data.result != CURLE_OK)
+        error = curl_easy_strerror(msg->data.result);
+      else if (httpCode != 200)
+        error = t->response;
+
+      curl_multi_remove_handle(multi, t->curl);
+      curl_easy_cleanup(t->curl);
+      curl_slist_free_all(t->headers);
+
+      if (!error.empty())
+      {
+        gzerr << "Request to " << t->path << " failed: " << error
+              << std::endl;
+
+        std::function<void (const std::string &)> cb;
+        bool drop = false;
+        {
+          std::lock_guard<std::mutex> lock(this->postsMutex);
+          cb = this->errorCallback;
+          if (t->batch.attempts > this->maxRetries)
+          {
+            drop = true;
+          }
+          else
+          {
+            // Exponential back off, starting at half a second
+            double delay = std::min(kMaxRetryDelay,
+                0.5 * (1u << std::min(t->batch.attempts - 1u, 6u)));
+            t->batch.retryTime = common::Time::GetWallTime() +
+                common::Time(delay);
+            this->retries.push_back(t->batch);
+          }
+        }
+        if (drop)
+          this->DropPosts(t->batch.postCount, "out of retries");
+        if (cb)
+          cb(error);
+      }
+
+      transfers.remove_if([t](const std::unique_ptr<Transfer> &_t)
+          {
+            return _t.get() == t;
+          });
+    }
   }
-  else
+
+  for (auto &t : transfers)
   {
-    gzmsg << posts.size() << " post(s) queued to be sent" << std::endl;
+    curl_multi_remove_handle(multi, t->curl);
+    curl_easy_cleanup(t->curl);
+    curl_slist_free_all(t->headers);
   }
+  curl_multi_cleanup(multi);
 }
 
 /////////////////////////////////////////////////
@@ -18,10 +18,16 @@
 #ifndef GAZEBO_PLUGINS_REST_WEB_RESTAPI_HH_
 #define GAZEBO_PLUGINS_REST_WEB_RESTAPI_HH_
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <list>
 #include <mutex>
+#include <thread>
 #include <gazebo/common/Console.hh>
+#include <gazebo/common/Time.hh>
 
 #include "RestException.hh"
 
@@ -29,6 +35,14 @@ namespace gazebo
 {
   /// \class RestApi RestApi.hh RestApi.hh
   /// \brief REST interface
+  ///
+  /// Posts are queued and sent by a background thread with a curl multi
+  /// handle, so posting never blocks the caller on the network. Consecutive
+  /// posts to the same route are combined into one request of up to
+  /// BatchSize posts, sent as a JSON array when the batch size is larger
+  /// than one, and optionally gzip encoded. The queue and the number of
+  /// retries of a failed request are bounded, posts beyond these limits
+  /// are dropped and counted.
   class RestApi
   {
     /// \brief Constructor
@@ -62,6 +76,51 @@ namespace gazebo
     /// \return The user name
     public: std::string GetUser() const;
 
+    /// \brief Set the largest number of posts sent in one request. With a
+    /// batch size of one every post is sent as is, otherwise the posts of
+    /// a request are sent as a JSON array. The default is one.
+    /// \param[in] _size Posts per request, at least one.
+    public: void SetBatchSize(const unsigned int _size);
+
+    /// \brief Get the largest number of posts sent in one request.
+    /// \return Posts per request.
+    public: unsigned int BatchSize() const;
+
+    /// \brief Enable gzip content encoding of the posted data. Disabled by
+    /// default because the server has to accept gzip encoded requests.
+    /// \param[in] _enable True to gzip the posted data.
+    public: void SetCompression(const bool _enable);
+
+    /// \brief Get whether posted data are gzip encoded.
+    /// \return True if posted data are gzip encoded.
+    public: bool Compression() const;
+
+    /// \brief Set the largest number of posts waiting to be sent. The
+    /// oldest post is dropped when a new post would exceed it.
+    /// \param[in] _count Number of queued posts, at least one.
+    public: void SetMaxQueuedPosts(const unsigned int _count);
+
+    /// \brief Set how many times a failed request is sent again before
+    /// its posts are dropped.
+    /// \param[in] _count Number of retries.
+    public: void SetMaxRetries(const unsigned int _count);
+
+    /// \brief Set a function called from the sending thread when a
+    /// request fails.
+    /// \param[in] _cb Callback that receives the error message.
+    public: void SetErrorCallback(
+                std::function<void (const std::string &)> _cb);
+
+    /// \brief Get the number of posts waiting to be sent, not counting
+    /// posts of requests in progress or waiting for a retry.
+    /// \return Number of queued posts.
+    public: size_t QueuedPostCount() const;
+
+    /// \brief Get the number of posts dropped because the queue was full
+    /// or a request ran out of retries.
+    /// \return Number of dropped posts.
+    public: uint64_t DroppedPostCount() const;
+
     /// \brief A Request/Respone (can be used for GET and POST)
     /// \param[in] _requestUrl The request url.
     /// \param[in] _postStr The data to post
@@ -71,8 +130,42 @@ namespace gazebo
     private: std::string Request(const std::string &_requestUrl,
                                  const std::string &_postStr);
 
-    /// \brief Sends unposted posts
-    private: void SendUnpostedPosts();
+    /// \brief Entry point of the thread that sends the queued posts.
+    private: void RunSender();
+
+    /// \brief A request of one or more posts to the same route.
+    private: struct Batch
+      {
+        /// \brief Route on the web server
+        std::string route;
+
+        /// \brief Request body, gzip encoded if compressed is true.
+        std::string body;
+
+        /// \brief True if body is gzip encoded.
+        bool compressed = false;
+
+        /// \brief Number of posts in the request.
+        unsigned int postCount = 0;
+
+        /// \brief Number of times the request was sent.
+        unsigned int attempts = 0;
+
+        /// \brief Wall time before which the request is not sent again.
+        common::Time retryTime;
+      };
+
+    /// \brief Take the next request to send. Must be called with
+    /// postsMutex locked.
+    /// \param[out] _batch The request.
+    /// \return False if there is nothing to send now.
+    private: bool NextBatch(Batch &_batch);
+
+    /// \brief Count posts that are dropped and warn about it.
+    /// \param[in] _count Number of dropped posts.
+    /// \param[in] _reason Why the posts are dropped.
+    private: void DropPosts(const unsigned int _count,
+                            const std::string &_reason);
 
     /// \brief Login information: REST service host url
     private: std::string url;
@@ -87,7 +180,7 @@ namespace gazebo
     private: std::string loginRoute;
 
     /// \brief True when a previous Login attempt was successful
-    private: bool isLoggedIn;
+    private: std::atomic<bool> isLoggedIn;
 
     /// \brief A post: what (json) and where (route)
     private: struct Post
@@ -99,8 +192,39 @@ namespace gazebo
     /// \brief List of unposted posts. Posts await when isLoggedIn is false
     private: std::list<Post> posts;
 
-    /// \brief A mutex to ensure integrity of the post list
-    private: std::mutex postsMutex;
+    /// \brief Requests that failed and wait to be sent again.
+    private: std::list<Batch> retries;
+
+    /// \brief A mutex to ensure integrity of the post list, the retries
+    /// and the login information.
+    private: mutable std::mutex postsMutex;
+
+    /// \brief Wakes the sending thread when posts are queued.
+    private: std::condition_variable postsCondition;
+
+    /// \brief Thread that sends the queued posts.
+    private: std::thread senderThread;
+
+    /// \brief True to stop the sending thread.
+    private: bool stopSender = false;
+
+    /// \brief Largest number of posts in one request.
+    private: unsigned int batchSize = 1u;
+
+    /// \brief True to gzip the posted data.
+    private: bool compression = false;
+
+    /// \brief Largest number of queued posts.
+    private: unsigned int maxQueuedPosts = 10000u;
+
+    /// \brief Number of retries of a failed request.
+    private: unsigned int maxRetries = 5u;
+
+    /// \brief Number of dropped posts.
+    private: std::atomic<uint64_t> droppedPosts{0u};
+
+    /// \brief Called when a request fails.
+    private: std::function<void (const std::string &)> errorCallback;
   };
 }
 
@@ -29,6 +29,8 @@
 
 #endif
 
+#include <cstdlib>
+
 #include "RestWebPlugin.hh"
 
 
@@ -114,7 +116,35 @@ void RestWebPlugin::Init()
 //////////////////////////////////////////////////
 void RestWebPlugin::Load(int /*_argc*/, char ** /*_argv*/)
 {
-  // nothing to do for now
+  // Upload settings
+  const char *env = getenv("GAZEBO_REST_BATCH_SIZE");
+  if (env)
+    this->restApi.SetBatchSize(std::strtoul(env, nullptr, 10));
+
+  env = getenv("GAZEBO_REST_GZIP");
+  if (env)
+    this->restApi.SetCompression(std::string(env) == "1");
+
+  env = getenv("GAZEBO_REST_MAX_QUEUED");
+  if (env)
+    this->restApi.SetMaxQueuedPosts(std::strtoul(env, nullptr, 10));
+
+  env = getenv("GAZEBO_REST_MAX_RETRIES");
+  if (env)
+    this->restApi.SetMaxRetries(std::strtoul(env, nullptr, 10));
+
+  // Posts are sent asynchronously, report failed requests to the UI
+  this->restApi.SetErrorCallback([this](const std::string &_error)
+      {
+        if (!this->pub)
+          return;
+        gazebo::msgs::RestResponse msg;
+        msg.set_type(msgs::RestResponse::ERR);
+        msg.set_msg(
+            "There was a problem trying to send data to the server: " +
+            _error);
+        this->pub->Publish(msg);
+      });
 }
 
 //////////////////////////////////////////////////
@@ -33,6 +33,16 @@ namespace gazebo
 {
   /// \class RestWebPlugin RestWebPlugin.hh RestWebPlugin.hh
   /// \brief REST web plugin
+  ///
+  /// Events are uploaded asynchronously. The upload is configured with
+  /// environment variables:
+  ///   GAZEBO_REST_BATCH_SIZE: largest number of events per request, sent
+  ///     as a JSON array when larger than 1 (default 1).
+  ///   GAZEBO_REST_GZIP: 1 to gzip encode requests (default 0).
+  ///   GAZEBO_REST_MAX_QUEUED: largest number of events waiting to be
+  ///     sent, older events are dropped (default 10000).
+  ///   GAZEBO_REST_MAX_RETRIES: number of times a failed request is sent
+  ///     again before its events are dropped (default 5).
   class GZ_PLUGIN_VISIBLE RestWebPlugin : public SystemPlugin
   {
     /// \brief Constructor
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class BuoyancyPluginTest : public ServerFixture
+{
+  /// \brief Spawn a 1 m cube with a submersion mode buoyancy plugin.
+  /// \param[in] _name Model name.
+  /// \param[in] _y Y position of the cube, centered on the fluid surface.
+  /// \param[in] _mass Mass of the cube.
+  public: void SpawnCube(const std::string &_name, const double _y,
+              const double _mass)
+  {
+    std::ostringstream modelStr;
+    modelStr
+      << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='" << _name << "'>"
+      << "  <pose>0 " << _y << " 0 0 0 0</pose>"
+      << "  <link name='link'>"
+      << "    <inertial>"
+      << "      <mass>" << _mass << "</mass>"
+      << "      <inertia>"
+      << "        <ixx>" << _mass / 6.0 << "</ixx>"
+      << "        <iyy>" << _mass / 6.0 << "</iyy>"
+      << "        <izz>" << _mass / 6.0 << "</izz>"
+      << "      </inertia>"
+      << "    </inertial>"
+      << "    <collision name='collision'>"
+      << "      <geometry><box><size>1 1 1</size></box></geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "  <plugin name='buoyancy' filename='libBuoyancyPlugin.so'>"
+      << "    <fluid_density>1000</fluid_density>"
+      << "    <submersion>true</submersion>"
+      << "  </plugin>"
+      << "</model>"
+      << "</sdf>";
+    this->SpawnSDF(modelStr.str());
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(BuoyancyPluginTest, Submersion)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Half of the floating cube is submerged, so it is at equilibrium. The
+  // light cube displaces twice its weight and rises.
+  this->SpawnCube("floating", 0, 500);
+  this->SpawnCube("light", 5, 250);
+
+  physics::ModelPtr floating = world->ModelByName("floating");
+  physics::ModelPtr light = world->ModelByName("light");
+  ASSERT_TRUE(floating != nullptr);
+  ASSERT_TRUE(light != nullptr);
+
+  world->Step(100);
+
+  EXPECT_NEAR(0.0, floating->WorldPose().Pos().Z(), 1e-3);
+  EXPECT_NEAR(0.0, floating->WorldLinearVel().Z(), 1e-2);
+  EXPECT_GT(light->WorldPose().Pos().Z(), 0.01);
+  EXPECT_GT(light->WorldLinearVel().Z(), 0.1);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -23,6 +23,7 @@
 #include "gazebo/sensors/sensors.hh"
 #include "gazebo/common/common.hh"
 #include "gazebo/common/Timer.hh"
+#include "gazebo/common/VideoStreamDecoder.hh"
 #include "gazebo/rendering/Camera.hh"
 #include "gazebo/sensors/CameraSensor.hh"
 
@@ -51,6 +52,9 @@ std::string pixelFormat = "";
 // list of timestamped images used by the Timestamp test
 std::vector<gazebo::msgs::ImageStamped> g_imagesStamped;
 
+// list of compressed images used by the CompressedStream test
+std::vector<gazebo::msgs::CompressedImage> g_compressedImages;
+
 float *depthImg = nullptr;
 
 /////////////////////////////////////////////////
@@ -66,6 +70,13 @@ void OnNewCameraFrame(int* _imageCounter, unsigned char* _imageDest,
   *_imageCounter += 1;
 }
 
+/////////////////////////////////////////////////
+void OnCompressedImage(ConstCompressedImagePtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  g_compressedImages.push_back(*_msg);
+}
+
 /////////////////////////////////////////////////
 void OnImage(ConstImageStampedPtr &_msg)
 {
@@ -460,6 +471,229 @@ TEST_F(CameraSensor, FillMsg)
   EXPECT_EQ(cameraMsg.far_clip(), cam->FarClip());
 }
 
+/////////////////////////////////////////////////
+TEST_F(CameraSensor, ImageBytesCopied)
+{
+  Load("worlds/empty_test.world");
+
+  // Make sure the render engine is available.
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run camera test\n";
+    return;
+  }
+
+  std::string modelName = "camera_model";
+  std::string cameraName = "camera_sensor";
+  unsigned int width  = 320;
+  unsigned int height = 240;
+  double updateRate = 10;
+  ignition::math::Pose3d setPose(ignition::math::Vector3d(-5, 0, 5),
+      ignition::math::Quaterniond(0, IGN_DTOR(15), 0));
+  SpawnCamera(modelName, cameraName, setPose.Pos(),
+      setPose.Rot().Euler(), width, height, updateRate);
+  sensors::SensorPtr sensor = sensors::get_sensor(cameraName);
+  sensors::CameraSensorPtr camSensor =
+    std::dynamic_pointer_cast<sensors::CameraSensor>(sensor);
+  ASSERT_TRUE(camSensor != nullptr);
+
+  // No subscribers, no copies
+  common::Time::MSleep(500);
+  EXPECT_EQ(0u, camSensor->ImageBytesCopied());
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    g_imagesStamped.clear();
+  }
+  transport::SubscriberPtr sub = this->node->Subscribe(
+      camSensor->Topic(), OnImage);
+
+  int sleep = 0;
+  while (sleep++ < 100)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (g_imagesStamped.size() >= 3)
+        break;
+    }
+    common::Time::MSleep(50);
+  }
+
+  // One copy of the frame, the received images are complete
+  EXPECT_EQ(width * height * 3u, camSensor->ImageBytesCopied());
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_GE(g_imagesStamped.size(), 3u);
+  for (auto const &image : g_imagesStamped)
+    EXPECT_EQ(width * height * 3u, image.image().data().size());
+}
+
+/////////////////////////////////////////////////
+TEST_F(CameraSensor, CompressedStream)
+{
+  Load("worlds/empty_test.world");
+
+  // Make sure the render engine is available.
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run camera test\n";
+    return;
+  }
+
+  std::string modelName = "camera_model";
+  std::string cameraName = "camera_sensor";
+  unsigned int width  = 320;
+  unsigned int height = 240;
+  double updateRate = 10;
+  ignition::math::Pose3d setPose(ignition::math::Vector3d(-5, 0, 5),
+      ignition::math::Quaterniond(0, IGN_DTOR(15), 0));
+  SpawnCamera(modelName, cameraName, setPose.Pos(),
+      setPose.Rot().Euler(), width, height, updateRate);
+  sensors::SensorPtr sensor = sensors::get_sensor(cameraName);
+  sensors::CameraSensorPtr camSensor =
+    std::dynamic_pointer_cast<sensors::CameraSensor>(sensor);
+  ASSERT_TRUE(camSensor != nullptr);
+
+  EXPECT_TRUE(camSensor->CompressedStreamFormat().empty());
+  EXPECT_EQ(camSensor->Topic() + "/compressed", camSensor->CompressedTopic());
+  EXPECT_FALSE(camSensor->SetCompressedStream("bogus"));
+  EXPECT_TRUE(camSensor->SetCompressedStream("jpeg"));
+  EXPECT_EQ("jpeg", camSensor->CompressedStreamFormat());
+
+#ifndef HAVE_FFMPEG
+  gzwarn << "No FFMPEG, skipping compressed stream test\n";
+  return;
+#endif
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    g_compressedImages.clear();
+  }
+  transport::SubscriberPtr sub = this->node->Subscribe(
+      camSensor->CompressedTopic(), OnCompressedImage);
+
+  int sleep = 0;
+  while (sleep++ < 100)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (g_compressedImages.size() >= 3)
+        break;
+    }
+    common::Time::MSleep(50);
+  }
+
+  // Only the compressed topic has subscribers, the raw image is not copied
+  EXPECT_EQ(0u, camSensor->ImageBytesCopied());
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_GE(g_compressedImages.size(), 3u);
+
+  common::VideoStreamDecoder decoder;
+  ASSERT_TRUE(decoder.Start("jpeg"));
+  for (size_t i = 0; i < g_compressedImages.size(); ++i)
+  {
+    const msgs::CompressedImage &image = g_compressedImages[i];
+    EXPECT_EQ("jpeg", image.format());
+    EXPECT_EQ(width, image.width());
+    EXPECT_EQ(height, image.height());
+    EXPECT_TRUE(image.key_frame());
+    EXPECT_LT(image.data().size(), width * height * 3u);
+    if (i > 0)
+      EXPECT_GT(image.sequence(), g_compressedImages[i-1].sequence());
+
+    std::vector<unsigned char> frame;
+    unsigned int frameWidth = 0;
+    unsigned int frameHeight = 0;
+    EXPECT_TRUE(decoder.Decode(image.data(), frame, frameWidth,
+          frameHeight));
+    EXPECT_EQ(width, frameWidth);
+    EXPECT_EQ(height, frameHeight);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(CameraSensor, RenderOnDemand)
+{
+  Load("worlds/empty_test.world");
+
+  // Make sure the render engine is available.
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run camera test\n";
+    return;
+  }
+
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  EXPECT_FALSE(mgr->RenderOnDemand());
+  mgr->SetRenderOnDemand(true);
+  EXPECT_TRUE(mgr->RenderOnDemand());
+
+  std::string modelName = "camera_model";
+  std::string cameraName = "camera_sensor";
+  unsigned int width  = 320;
+  unsigned int height = 240;
+  double updateRate = 10;
+  ignition::math::Pose3d setPose(ignition::math::Vector3d(-5, 0, 5),
+      ignition::math::Quaterniond(0, IGN_DTOR(15), 0));
+  SpawnCamera(modelName, cameraName, setPose.Pos(),
+      setPose.Rot().Euler(), width, height, updateRate);
+  sensors::SensorPtr sensor = sensors::get_sensor(cameraName);
+  sensors::CameraSensorPtr camSensor =
+    std::dynamic_pointer_cast<sensors::CameraSensor>(sensor);
+  ASSERT_TRUE(camSensor != nullptr);
+
+  // The camera is always on, but nothing uses its images.
+  EXPECT_FALSE(camSensor->HasConsumers());
+  common::Time::MSleep(1000);
+  EXPECT_EQ(common::Time::Zero, camSensor->LastMeasurementTime());
+
+  // A connection to the camera is a consumer.
+  int imageCount = 0;
+  unsigned char *img = new unsigned char[width * height * 3];
+  event::ConnectionPtr c = camSensor->Camera()->ConnectNewImageFrame(
+      std::bind(&::OnNewCameraFrame, &imageCount, img,
+        std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+        std::placeholders::_4, std::placeholders::_5));
+  EXPECT_TRUE(camSensor->HasConsumers());
+
+  int sleep = 0;
+  while (sleep++ < 100)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (imageCount >= 3)
+        break;
+    }
+    common::Time::MSleep(50);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_GE(imageCount, 3);
+  }
+  EXPECT_GT(camSensor->LastMeasurementTime(), common::Time::Zero);
+
+  // Rendering stops again with the last consumer.
+  c.reset();
+  EXPECT_FALSE(camSensor->HasConsumers());
+  common::Time::MSleep(200);
+  int stoppedCount;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stoppedCount = imageCount;
+  }
+  common::Time::MSleep(1000);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(stoppedCount, imageCount);
+  }
+
+  mgr->SetRenderOnDemand(false);
+  delete [] img;
+}
+
 /////////////////////////////////////////////////
 TEST_F(CameraSensor, UnlimitedTest)
 {
@@ -1089,6 +1323,93 @@ TEST_F(CameraSensor, CompareSideBySideCamera)
   delete[] prevImg2;
 }
 
+/////////////////////////////////////////////////
+TEST_F(CameraSensor, AsyncReadback)
+{
+  Load("worlds/empty.world");
+
+  // Make sure the render engine is available.
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run camera test\n";
+    return;
+  }
+
+  // Spawn two cameras at the same pose, one of them reads its frames back
+  // asynchronously.
+  std::string modelName = "camera_model";
+  std::string cameraName = "camera_sensor";
+  std::string modelName2 = "camera_model2";
+  std::string cameraName2 = "camera_sensor2";
+  unsigned int width  = 320;
+  unsigned int height = 240;
+  double updateRate = 10;
+
+  ignition::math::Pose3d testPose(ignition::math::Vector3d(0, 0, 0.5),
+      ignition::math::Quaterniond::Identity);
+  SpawnCamera(modelName, cameraName, testPose.Pos(),
+      testPose.Rot().Euler(), width, height, updateRate);
+  SpawnCamera(modelName2, cameraName2, testPose.Pos(),
+      testPose.Rot().Euler(), width, height, updateRate);
+
+  // Spawn a box in front of the cameras
+  SpawnBox("test_box", ignition::math::Vector3d(1, 1, 1),
+      ignition::math::Vector3d(4, 0, 0.5), ignition::math::Vector3d::Zero);
+
+  sensors::SensorPtr sensor = sensors::get_sensor(cameraName);
+  sensors::CameraSensorPtr camSensor =
+    std::dynamic_pointer_cast<sensors::CameraSensor>(sensor);
+  ASSERT_TRUE(camSensor != nullptr);
+  sensor = sensors::get_sensor(cameraName2);
+  sensors::CameraSensorPtr camSensor2 =
+    std::dynamic_pointer_cast<sensors::CameraSensor>(sensor);
+  ASSERT_TRUE(camSensor2 != nullptr);
+
+  EXPECT_FALSE(camSensor2->Camera()->AsyncReadback());
+  camSensor2->Camera()->SetAsyncReadback(true);
+  EXPECT_TRUE(camSensor2->Camera()->AsyncReadback());
+
+  imageCount = 0;
+  imageCount2 = 0;
+  img = new unsigned char[width * height*3];
+  img2 = new unsigned char[width * height*3];
+  event::ConnectionPtr c =
+    camSensor->Camera()->ConnectNewImageFrame(
+        std::bind(&::OnNewCameraFrame, &imageCount, img,
+          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+          std::placeholders::_4, std::placeholders::_5));
+  event::ConnectionPtr c2 =
+    camSensor2->Camera()->ConnectNewImageFrame(
+        std::bind(&::OnNewCameraFrame, &imageCount2, img2,
+          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+          std::placeholders::_4, std::placeholders::_5));
+
+  int sleep = 0;
+  while ((imageCount < 10 || imageCount2 < 10) && sleep++ < 1000)
+    common::Time::MSleep(10);
+  EXPECT_GE(imageCount, 10);
+  EXPECT_GE(imageCount2, 10);
+
+  // The scene is static, so a frame that is one frame late must match the
+  // synchronous image.
+  {
+    unsigned int diffMax = 0;
+    unsigned int diffSum = 0;
+    double diffAvg = 0.0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    this->ImageCompare(img, img2, width, height, 3,
+                       diffMax, diffSum, diffAvg);
+    EXPECT_LE(diffSum, 10u);
+  }
+
+  c.reset();
+  c2.reset();
+  delete[] img;
+  delete[] img2;
+}
+
 /////////////////////////////////////////////////
 TEST_F(CameraSensor, PointCloud)
 {
@@ -260,13 +260,13 @@ void ContactSensor::MultipleSensors(const std::string &_physicsEngine)
     ASSERT_TRUE(contactSensor2 != NULL);
   }
 
-  // There should be 5 topics advertising Contacts messages
+  // The sensors read their contacts in process, so they create no contact
+  // filter and there should be 3 topics advertising Contacts messages
+  EXPECT_EQ(0u, world->Physics()->GetContactManager()->GetFilterCount());
   std::list<std::string> topicsExpected;
   std::string prefix = "/gazebo/default/";
   topicsExpected.push_back(prefix+"physics/contacts");
-  topicsExpected.push_back(prefix+"sensor_box/link/box_contact/contacts");
   topicsExpected.push_back(prefix+"sensor_box/link/box_contact");
-  topicsExpected.push_back(prefix+"sensor_box/link/box_contact2/contacts");
   topicsExpected.push_back(prefix+"sensor_box/link/box_contact2");
   topicsExpected.sort();
 
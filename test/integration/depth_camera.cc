@@ -15,6 +15,10 @@
  *
 */
 
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/sensors/sensors.hh"
 
@@ -30,6 +34,13 @@ class DepthCameraSensorTest : public ServerFixture
   /// \brief Verify point cloud color generated by depth camera
   public: void PointCloudColor();
 
+  /// \brief Verify the packed point cloud published by the sensor
+  public: void PointCloudPacked();
+
+  /// \brief Packed point cloud callback
+  /// \param[in] _msg Packed point cloud message.
+  public: void OnPointCloudPacked(ConstPointCloudPackedPtr &_msg);
+
   /// \brief Depth camera image callback
   /// \param[in] _msg Message with image data containing raw depth values.
   public: void OnImage(ConstImageStampedPtr &_msg);
@@ -55,8 +66,32 @@ class DepthCameraSensorTest : public ServerFixture
 
   /// \brief Point cloud buffer
   public: float *pcBuffer = nullptr;
+
+  /// \brief Counter for the number of packed point clouds received.
+  public: unsigned int packedCount = 0u;
+
+  /// \brief Last packed point cloud received.
+  public: msgs::PointCloudPacked packedMsg;
+
+  /// \brief Protects packedMsg.
+  public: std::mutex packedMutex;
 };
 
+/// \brief Convert an IEEE 754 half float to a float.
+/// \param[in] _half Bits of the half float.
+/// \return The value.
+static float HalfToFloat(const uint16_t _half)
+{
+  float sign = (_half & 0x8000u) ? -1.0f : 1.0f;
+  int exponent = (_half >> 10) & 0x1f;
+  int mantissa = _half & 0x3ff;
+  if (exponent == 0)
+    return sign * std::ldexp(static_cast<float>(mantissa), -24);
+  if (exponent == 31)
+    return mantissa ? NAN : sign * INFINITY;
+  return sign * std::ldexp(static_cast<float>(mantissa + 1024), exponent - 25);
+}
+
 /////////////////////////////////////////////////
 void DepthCameraSensorTest::OnImage(ConstImageStampedPtr &_msg)
 {
@@ -301,6 +336,100 @@ TEST_F(DepthCameraSensorTest, PointCloudColor)
   PointCloudColor();
 }
 
+/////////////////////////////////////////////////
+void DepthCameraSensorTest::OnPointCloudPacked(
+    ConstPointCloudPackedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->packedMutex);
+  this->packedMsg = *_msg;
+  this->packedCount++;
+}
+
+/////////////////////////////////////////////////
+void DepthCameraSensorTest::PointCloudPacked()
+{
+  Load("worlds/depth_camera2.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+
+  std::string sensorName = "default::camera_model::my_link::camera";
+  sensors::DepthCameraSensorPtr sensor =
+     std::dynamic_pointer_cast<sensors::DepthCameraSensor>
+     (mgr->GetSensor(sensorName));
+  ASSERT_NE(nullptr, sensor);
+
+  EXPECT_FALSE(sensor->PointCloudHalfFloat());
+  sensor->SetPointCloudHalfFloat(true);
+  EXPECT_TRUE(sensor->PointCloudHalfFloat());
+
+  rendering::DepthCameraPtr depthCamera = sensor->DepthCamera();
+  ASSERT_NE(nullptr, depthCamera);
+  EXPECT_TRUE(depthCamera->OutputPoints());
+  EXPECT_EQ(depthCamera->PointCloudDecimation(), 1u);
+
+  event::ConnectionPtr c = depthCamera->ConnectNewRGBPointCloud(
+      std::bind(&DepthCameraSensorTest::OnNewPointCloud, this,
+      std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+      std::placeholders::_4, std::placeholders::_5));
+
+  transport::SubscriberPtr sub = this->node->Subscribe(
+      sensor->PointCloudTopic(),
+      &DepthCameraSensorTest::OnPointCloudPacked, this);
+
+  unsigned int framesToWait = 10;
+  int i = 0;
+  while (i < 300 && this->packedCount < framesToWait)
+  {
+    common::Time::MSleep(20);
+    i++;
+  }
+  EXPECT_GE(this->packedCount, framesToWait);
+  ASSERT_NE(nullptr, this->pcBuffer);
+
+  std::lock_guard<std::mutex> lock(this->packedMutex);
+  const msgs::PointCloudPacked &msg = this->packedMsg;
+  unsigned int width = sensor->ImageWidth();
+  unsigned int height = sensor->ImageHeight();
+  EXPECT_EQ(msg.width(), width);
+  EXPECT_EQ(msg.height(), height);
+  EXPECT_EQ(msg.point_step(), 10u);
+  EXPECT_EQ(msg.row_step(), 10u * width);
+  ASSERT_EQ(msg.field_size(), 4);
+  EXPECT_EQ(msg.field(0).name(), "x");
+  EXPECT_EQ(msg.field(0).datatype(), msgs::PointCloudPacked::Field::FLOAT16);
+  EXPECT_EQ(msg.field(3).name(), "rgb");
+  EXPECT_EQ(msg.field(3).offset(), 6u);
+  ASSERT_EQ(msg.data().size(), 10u * width * height);
+
+  // The world is static, so the packed cloud matches the float cloud of the
+  // depth camera within half float precision.
+  const char *data = msg.data().data();
+  for (unsigned int p = 0; p < width * height; ++p)
+  {
+    uint16_t coords[3];
+    std::memcpy(coords, data + 10 * p, sizeof(coords));
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      float expected = this->pcBuffer[4 * p + k];
+      EXPECT_NEAR(HalfToFloat(coords[k]), expected,
+          1e-3 * std::abs(expected) + 1e-4);
+    }
+
+    unsigned int color = static_cast<unsigned int>(this->pcBuffer[4 * p + 3]);
+    const unsigned char *rgb =
+        reinterpret_cast<const unsigned char *>(data + 10 * p + 6);
+    EXPECT_EQ(rgb[0], (color >> 16) & 0xffu);
+    EXPECT_EQ(rgb[1], (color >> 8) & 0xffu);
+    EXPECT_EQ(rgb[2], color & 0xffu);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Test the packed point cloud published by the depth camera sensor
+TEST_F(DepthCameraSensorTest, PointCloudPacked)
+{
+  PointCloudPacked();
+}
+
 
 int main(int argc, char **argv)
 {
@@ -1213,6 +1213,18 @@ TEST_F(FactoryTest, FilenameModelDatabase)
 
   // Check model was spawned
   ASSERT_NE(nullptr, world->ModelByName("cococan"));
+
+  // Spawn the same file again, it is reused from the parsed file cache and
+  // the new model is renamed
+  unsigned int modelCount = world->ModelCount();
+  pub->Publish(msg);
+
+  sleep = 0;
+  while (world->ModelCount() == modelCount && sleep++ < maxSleep)
+  {
+    common::Time::MSleep(100);
+  }
+  EXPECT_EQ(modelCount + 1, world->ModelCount());
 }
 
 //////////////////////////////////////////////////
@@ -1642,6 +1654,88 @@ TEST_P(FactoryTest, InvalidMeshInsertionWithWorld)
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, FactoryTest, PHYSICS_ENGINE_VALUES,);  // NOLINT
 
 /////////////////////////////////////////////////
+TEST_F(FactoryTest, ModelPool)
+{
+  this->Load("worlds/empty.world", false, "ode");
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+  EXPECT_EQ(0u, world->ModelPoolSize());
+  world->SetModelPoolSize(1);
+  EXPECT_EQ(1u, world->ModelPoolSize());
+
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='box'>"
+    << "  <pose>0 0 0.5 0 0 0</pose>"
+    << "  <link name='link'>"
+    << "    <collision name='collision'>"
+    << "      <geometry><box><size>1 1 1</size></box></geometry>"
+    << "    </collision>"
+    << "  </link>"
+    << "</model>"
+    << "</sdf>";
+
+  auto pub = this->node->Advertise<msgs::Factory>("~/factory");
+  auto spawn = [&](const ignition::math::Pose3d *_pose)
+  {
+    msgs::Factory msg;
+    msg.set_sdf(sdfStr.str());
+    if (_pose)
+      msgs::Set(msg.mutable_pose(), *_pose);
+    pub->Publish(msg);
+
+    int sleep = 0;
+    while (!world->ModelByName("box") && sleep++ < 50)
+      common::Time::MSleep(100);
+    return world->ModelByName("box");
+  };
+  auto remove = [&]()
+  {
+    this->RemoveModel("box");
+    int sleep = 0;
+    while (world->ModelByName("box") && sleep++ < 50)
+      common::Time::MSleep(100);
+  };
+
+  physics::ModelPtr model = spawn(nullptr);
+  ASSERT_NE(nullptr, model);
+  model->SetWorldPose(ignition::math::Pose3d(3, 0, 2, 0, 0.3, 0));
+  model->SetLinearVel(ignition::math::Vector3d(1, 0, 0));
+
+  // The deleted model is kept, and reused for the same SDF
+  remove();
+  EXPECT_EQ(nullptr, world->ModelByName("box"));
+  EXPECT_EQ(1u, world->ModelCount());
+
+  physics::ModelPtr reused = spawn(nullptr);
+  ASSERT_NE(nullptr, reused);
+  EXPECT_EQ(model, reused);
+  EXPECT_EQ(2u, world->ModelCount());
+  EXPECT_NEAR(0.0, reused->WorldPose().Pos().X(), g_tolerance);
+  EXPECT_LT(reused->WorldPose().Pos().Z(), 0.5 + g_tolerance);
+  EXPECT_NEAR(0.0, reused->WorldPose().Rot().Euler().Y(), g_tolerance);
+
+  // The pose of the factory message is used
+  remove();
+  const ignition::math::Pose3d pose(0, 2, 0.5, 0, 0, 0);
+  reused = spawn(&pose);
+  ASSERT_NE(nullptr, reused);
+  EXPECT_EQ(model, reused);
+  EXPECT_NEAR(2.0, reused->WorldPose().Pos().Y(), g_tolerance);
+
+  // The reused model collides with the ground
+  common::Time::MSleep(1000);
+  EXPECT_NEAR(0.5, reused->WorldPose().Pos().Z(), 0.01);
+
+  // Without a pool, the model is loaded again
+  world->SetModelPoolSize(0);
+  remove();
+  reused = spawn(nullptr);
+  ASSERT_NE(nullptr, reused);
+  EXPECT_NE(model, reused);
+}
+
+//////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -149,6 +149,43 @@ TEST_F(GripperTest, CloseOpen)
 
   // The gripper should release the box.
   EXPECT_FALSE(gripper->IsAttached());
+
+  // Close the gripper again, the fixed joint is reused for the new grasp.
+  msg.set_name("simple_gripper::palm_right_finger");
+  msg.mutable_force_optional()->set_data(0.6);
+  jointPub.Publish(msg);
+
+  msg.set_name("simple_gripper::palm_left_finger");
+  msg.mutable_force_optional()->set_data(-0.6);
+  jointPub.Publish(msg);
+
+  i = 0;
+  while (!gripper->IsAttached() && i < 100)
+  {
+    common::Time::MSleep(500);
+    ++i;
+  }
+  EXPECT_LT(i, 100);
+  EXPECT_TRUE(gripper->IsAttached());
+}
+
+/////////////////////////////////////////////////
+// \brief The gripper reads its contacts in process, without a contact topic
+TEST_F(GripperTest, ContactQuery)
+{
+  Load("worlds/gripper.world");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr model = world->ModelByName("simple_gripper");
+  ASSERT_TRUE(model != NULL);
+
+  physics::GripperPtr gripper = model->GetGripper(0);
+  ASSERT_TRUE(gripper != NULL);
+
+  physics::ContactManager *mgr = world->Physics()->GetContactManager();
+  ASSERT_TRUE(mgr != NULL);
+  EXPECT_FALSE(mgr->HasFilter(gripper->Name()));
 }
 
 /////////////////////////////////////////////////
@@ -88,6 +88,9 @@ class HeightmapTest : public ServerFixture,
 
   public: void NotSquareImage();
   public: void InvalidSizeImage();
+
+  /// \brief Test a heightmap with a decimated collision table.
+  public: void CollisionDecimation();
   // public: void Heights(const std::string &_physicsEngine);
 };
 
@@ -310,6 +313,65 @@ void HeightmapTest::InvalidSizeImage()
   delete this->server;
 }
 
+/////////////////////////////////////////////////
+void HeightmapTest::CollisionDecimation()
+{
+  Load("worlds/heightmap_test.world", true);
+
+  physics::ModelPtr model = GetModel("heightmap");
+  ASSERT_NE(model, nullptr);
+  physics::HeightmapShapePtr full =
+    boost::dynamic_pointer_cast<physics::HeightmapShape>(
+        model->GetLink("link")->GetCollision("collision")->GetShape());
+  ASSERT_NE(full, nullptr);
+  EXPECT_EQ(full->CollisionDecimation(), 1u);
+
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='decimated'>"
+    << "  <static>true</static>"
+    << "  <link name='link'>"
+    << "    <collision name='collision'>"
+    << "      <geometry>"
+    << "        <heightmap>"
+    << "          <uri>file://media/materials/textures/heightmap_bowl.png"
+    << "          </uri>"
+    << "          <size>129 129 10</size>"
+    << "          <pos>0 0 0</pos>"
+    << "          <collision_decimation>4</collision_decimation>"
+    << "        </heightmap>"
+    << "      </geometry>"
+    << "    </collision>"
+    << "  </link>"
+    << "</model>"
+    << "</sdf>";
+  SpawnSDF(sdfStr.str());
+
+  physics::WorldPtr world = physics::get_world();
+  int i = 0;
+  while (!world->ModelByName("decimated") && i++ < 50)
+    common::Time::MSleep(100);
+  model = world->ModelByName("decimated");
+  ASSERT_NE(model, nullptr);
+
+  physics::HeightmapShapePtr decimated =
+    boost::dynamic_pointer_cast<physics::HeightmapShape>(
+        model->GetLink("link")->GetCollision("collision")->GetShape());
+  ASSERT_NE(decimated, nullptr);
+  EXPECT_EQ(decimated->CollisionDecimation(), 4u);
+
+  // Same terrain at a quarter of the resolution
+  ignition::math::Vector2i fullCount = full->VertexCount();
+  ignition::math::Vector2i count = decimated->VertexCount();
+  EXPECT_EQ(count.X(), (fullCount.X() - 1) / 4 + 1);
+  EXPECT_EQ(count.Y(), (fullCount.Y() - 1) / 4 + 1);
+  for (int y = 0; y < count.Y(); y += 7)
+  {
+    for (int x = 0; x < count.X(); x += 5)
+      EXPECT_FLOAT_EQ(decimated->GetHeight(x, y), full->GetHeight(x*4, y*4));
+  }
+}
+
 /////////////////////////////////////////////////
 void HeightmapTest::Volume(const std::string &_physicsEngine)
 {
@@ -1008,6 +1070,12 @@ TEST_P(HeightmapTest, PhysicsLoad)
   PhysicsLoad(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_F(HeightmapTest, CollisionDecimation)
+{
+  CollisionDecimation();
+}
+
 /////////////////////////////////////////////////
 TEST_P(HeightmapTest, WhiteAlpha)
 {
@@ -1088,6 +1156,10 @@ TEST_F(HeightmapTest, DartCollisionDetectorSelectionBullet)
   std::string cd = dartEngine->CollisionDetectorInUse();
   EXPECT_FALSE(cd.empty());
   EXPECT_EQ(cd, "bullet");
+
+  boost::any param;
+  EXPECT_TRUE(dartEngine->GetParam("collision_detector", param));
+  EXPECT_EQ(boost::any_cast<std::string>(param), "bullet");
 #endif
 }
 
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/JointBatch.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/test/helper_physics_generator.hh"
+
+using namespace gazebo;
+
+class JointBatchTest : public ServerFixture,
+                       public testing::WithParamInterface<const char*>
+{
+  /// \brief Compare the state read in bulk with the state of each joint,
+  /// and apply forces through the batch.
+  /// \param[in] _physicsEngine Type of physics engine to use.
+  public: void ReadWrite(const std::string &_physicsEngine);
+};
+
+/////////////////////////////////////////////////
+void JointBatchTest::ReadWrite(const std::string &_physicsEngine)
+{
+  Load("worlds/simple_arm_test.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  physics::ModelPtr model = world->ModelByName("simple_arm");
+  ASSERT_TRUE(model != nullptr);
+
+  EXPECT_EQ(model->CreateJointBatch({"arm_shoulder_pan_joint", "missing"}),
+      nullptr);
+
+  std::vector<std::string> names = {"arm_shoulder_pan_joint",
+      "simple_arm::arm_elbow_pan_joint", "arm_wrist_lift_joint"};
+  physics::JointBatchPtr batch = model->CreateJointBatch(names);
+  ASSERT_TRUE(batch != nullptr);
+  ASSERT_EQ(batch->Joints().size(), names.size());
+  EXPECT_EQ(batch->AxisCount(), 3u);
+
+  std::vector<double> forces = {1.0, -1.0, 0.5};
+  std::vector<double> positions;
+  std::vector<double> velocities;
+  for (int i = 0; i < 200; ++i)
+  {
+    EXPECT_TRUE(batch->SetForces(forces));
+    world->Step(1);
+
+    batch->Positions(positions);
+    batch->Velocities(velocities);
+    ASSERT_EQ(positions.size(), batch->AxisCount());
+    ASSERT_EQ(velocities.size(), batch->AxisCount());
+    for (size_t j = 0; j < names.size(); ++j)
+    {
+      physics::JointPtr joint = batch->Joints()[j];
+      EXPECT_DOUBLE_EQ(positions[j], joint->Position(0));
+      EXPECT_DOUBLE_EQ(velocities[j], joint->GetVelocity(0));
+    }
+  }
+
+  // The forces moved the joints
+  EXPECT_GT(std::abs(velocities[0]) + std::abs(positions[0]), 0.0);
+
+  EXPECT_FALSE(batch->SetForces({1.0}));
+}
+
+/////////////////////////////////////////////////
+TEST_P(JointBatchTest, ReadWrite)
+{
+  ReadWrite(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(PhysicsEngines, JointBatchTest,
+                        PHYSICS_ENGINE_VALUES,);  // NOLINT
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <map>
+#include <string>
+
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/JointController.hh"
@@ -61,6 +64,58 @@ TEST_F(JointControllerTest, PositionControl)
   EXPECT_NEAR(angle, 1.0, 0.1);
 }
 
+/////////////////////////////////////////////////
+TEST_F(JointControllerTest, SetJointPositionsBatch)
+{
+  Load("worlds/simple_arm_test.world", true);
+  gazebo::physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  gazebo::physics::ModelPtr model = world->ModelByName("simple_arm");
+  ASSERT_TRUE(model != NULL);
+
+  // Set every hinge and slider joint of the arm
+  std::map<std::string, double> positions;
+  double position = 0.1;
+  for (const auto &joint : model->GetJoints())
+  {
+    if (joint->HasType(physics::Base::HINGE_JOINT) ||
+        joint->HasType(physics::Base::SLIDER_JOINT))
+    {
+      positions[joint->GetName()] = position;
+      position += 0.1;
+    }
+  }
+  ASSERT_GT(positions.size(), 1u);
+
+  // All joints in one pass
+  model->SetJointPositions(positions);
+  std::map<std::string, ignition::math::Pose3d> batchPoses;
+  for (const auto &link : model->GetLinks())
+    batchPoses[link->GetName()] = link->WorldPose();
+  std::map<std::string, double> batchPositions;
+  for (const auto &joint : positions)
+    batchPositions[joint.first] = model->GetJoint(joint.first)->Position(0);
+
+  // One joint at a time must reach the same configuration
+  world->Reset();
+  for (const auto &joint : positions)
+    model->GetJoint(joint.first)->SetPosition(0, joint.second);
+
+  for (const auto &link : model->GetLinks())
+  {
+    const ignition::math::Pose3d &pose = batchPoses[link->GetName()];
+    EXPECT_TRUE(link->WorldPose().Pos().Equal(pose.Pos(), 1e-6))
+      << link->GetName() << " " << link->WorldPose() << " " << pose;
+    EXPECT_TRUE(link->WorldPose().Rot().Equal(pose.Rot(), 1e-6))
+      << link->GetName() << " " << link->WorldPose() << " " << pose;
+  }
+  for (const auto &joint : positions)
+  {
+    EXPECT_NEAR(model->GetJoint(joint.first)->Position(0),
+        batchPositions[joint.first], 1e-6) << joint.first;
+  }
+}
+
 /////////////////////////////////////////////////
 TEST_F(JointControllerTest, VelocityControl)
 {
@@ -92,6 +147,35 @@ TEST_F(JointControllerTest, VelocityControl)
   EXPECT_NEAR(vel, 0.2, 0.05);
 }
 
+/////////////////////////////////////////////////
+TEST_F(JointControllerTest, Retarget)
+{
+  Load("worlds/simple_arm_test.world", true);
+  gazebo::physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  gazebo::physics::ModelPtr model = world->ModelByName("simple_arm");
+  gazebo::physics::JointControllerPtr jointController =
+    model->GetJointController();
+
+  const std::string jointName = "simple_arm::arm_shoulder_pan_joint";
+  jointController->SetPositionPID(jointName, common::PID(10, 0.1, 4.5));
+  EXPECT_TRUE(jointController->SetPositionTarget(jointName, 1.0));
+
+  world->Step(5000);
+  auto joint = model->GetJoint("arm_shoulder_pan_joint");
+  EXPECT_NEAR(joint->Position(0), 1.0, 0.1);
+
+  // Changing the target of a joint that is already controlled applies on
+  // the next step
+  EXPECT_TRUE(jointController->SetPositionTarget(jointName, -0.5));
+  world->Step(5000);
+  EXPECT_NEAR(joint->Position(0), -0.5, 0.1);
+
+  // Removing the joint stops controlling it
+  jointController->RemoveJoint(joint.get());
+  EXPECT_NO_THROW(world->Step(10));
+}
+
 /////////////////////////////////////////////////
 TEST_F(JointControllerTest, JointCmd)
 {
@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <cmath>
+#include <vector>
+
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Rand.hh>
 
@@ -38,6 +41,7 @@ class LaserTest : public ServerFixture,
   public: void LaserVertical(const std::string &_physicsEngine);
   public: void LaserScanResolution(const std::string &_physicsEngine);
   public: void LaserStrictUpdateRate(const std::string &_physicsEngine);
+  public: void LaserParallelRays(const std::string &_physicsEngine);
 
   private: void OnNewUpdate(int* _msgCounter);
 };
@@ -669,6 +673,63 @@ TEST_P(LaserTest, LaserStrictUpdateRate)
   LaserStrictUpdateRate(GetParam());
 }
 
+/////////////////////////////////////////////////
+void LaserTest::LaserParallelRays(const std::string &_physicsEngine)
+{
+  if (_physicsEngine != "ode")
+  {
+    gzerr << "Parallel ray narrow phase is only implemented for ODE\n";
+    return;
+  }
+
+  Load("worlds/shapes.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != NULL);
+
+  // Sensor behind the box, sweeping over the box, sphere, cylinder and
+  // ground plane
+  std::string raySensorName = "ray_sensor";
+  SpawnRaySensor("ray_model", raySensorName,
+      ignition::math::Vector3d(-3, 0, 1), ignition::math::Vector3d::Zero,
+      -1.0, 1.0, -0.5, 0.2, 0.0, 10.0, 0.01, 320, 8, 1, 1);
+
+  sensors::RaySensorPtr laser =
+    std::static_pointer_cast<sensors::RaySensor>(
+        sensors::SensorManager::Instance()->GetSensor(raySensorName));
+  ASSERT_TRUE(laser != NULL);
+  laser->Init();
+
+  laser->Update(true);
+  std::vector<double> serialRanges;
+  laser->Ranges(serialRanges);
+  ASSERT_EQ(serialRanges.size(), 320u * 8u);
+
+  int hits = 0;
+  for (const auto range : serialRanges)
+  {
+    if (!std::isinf(range))
+      ++hits;
+  }
+  EXPECT_GT(hits, 0);
+
+  EXPECT_TRUE(physics->SetParam("parallel_ray_threshold", 1));
+  laser->Update(true);
+  std::vector<double> parallelRanges;
+  laser->Ranges(parallelRanges);
+  ASSERT_EQ(parallelRanges.size(), serialRanges.size());
+
+  for (unsigned int i = 0; i < serialRanges.size(); ++i)
+    EXPECT_DOUBLE_EQ(serialRanges[i], parallelRanges[i]) << i;
+}
+
+/////////////////////////////////////////////////
+TEST_P(LaserTest, LaserParallelRays)
+{
+  LaserParallelRays(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, LaserTest, PHYSICS_ENGINE_VALUES,);  // NOLINT
 
 int main(int argc, char **argv)
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <set>
+#include <string>
+#include <boost/filesystem.hpp>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/util/LogPlay.hh"
+#include "gazebo/util/LogRecord.hh"
+
+using namespace gazebo;
+
+class LogRotationTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the state log segments of a directory.
+/// \param[in] _dir Directory.
+/// \return Paths of the segments, in order.
+static std::set<std::string> Segments(const boost::filesystem::path &_dir)
+{
+  std::set<std::string> result;
+  for (boost::filesystem::directory_iterator iter(_dir), end;
+       iter != end; ++iter)
+  {
+    const std::string name = iter->path().filename().string();
+    if (name.find("state.") == 0 && iter->path().extension() == ".log")
+      result.insert(iter->path().string());
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+// Record with small segments, upload them with cp and bound the disk usage.
+TEST_F(LogRotationTest, SegmentsUploadAndBound)
+{
+  const boost::filesystem::path dir =
+    boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gazebo_log_rotation_%%%%%%");
+  const boost::filesystem::path uploads = dir / "uploads";
+  boost::filesystem::create_directories(uploads);
+
+  this->Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  util::LogRecord *recorder = util::LogRecord::Instance();
+  recorder->Init("test");
+
+  util::LogRecordParams params;
+  params.encoding = "bin";
+  params.path = dir.string();
+  params.segmentSize = 20000;
+  params.uploadCommand = "cp {} '" + uploads.string() + "'";
+  params.maxDiskUsage = 60000;
+  ASSERT_TRUE(recorder->Start(params));
+
+  for (int i = 0; i < 40; ++i)
+  {
+    world->Step(100);
+    common::Time::MSleep(10);
+  }
+
+  recorder->Stop();
+  recorder->Fini();
+
+  // Every completed segment was uploaded before Fini returned.
+  const std::set<std::string> uploaded = Segments(uploads);
+  EXPECT_GT(uploaded.size(), 2u);
+
+  // The local segments stay within the bound, the oldest ones are gone.
+  const std::set<std::string> local = Segments(dir);
+  uint64_t total = 0;
+  for (auto const &path : local)
+    total += boost::filesystem::file_size(path);
+  EXPECT_LE(total, params.maxDiskUsage);
+  EXPECT_LT(local.size(), uploaded.size());
+
+  // Each segment is a log of its own that starts with the world.
+  for (auto const &path : uploaded)
+  {
+    util::LogPlay *player = util::LogPlay::Instance();
+    player->Open(path);
+    EXPECT_TRUE(player->IsOpen()) << path;
+    std::string data;
+    EXPECT_TRUE(player->Step(data)) << path;
+    EXPECT_NE(data.find("<world name='default'>"), std::string::npos)
+      << path;
+  }
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
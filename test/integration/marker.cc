@@ -598,5 +598,133 @@ void Marker_TEST::CornerCases()
   delete mainWindow;
 }
 
+/////////////////////////////////////////////////
+void Marker_TEST::Batch()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  this->Load("worlds/empty_bright.world", false, false, false);
+
+  gazebo::gui::MainWindow *mainWindow = new gazebo::gui::MainWindow();
+  QVERIFY(mainWindow != nullptr);
+
+  // Create the main window.
+  mainWindow->Load();
+  mainWindow->Init();
+  mainWindow->show();
+
+  this->ProcessEventsAndDraw(mainWindow);
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  QVERIFY(scene != nullptr);
+
+  // Create our node for communication
+  ignition::transport::Node node;
+
+  std::string markerTopic = "/marker";
+  std::string arrayTopic = "/marker_array";
+  std::string listTopic = "/marker/list";
+
+  std::vector<std::string> serviceList;
+  node.ServiceList(serviceList);
+  QVERIFY(std::find(serviceList.begin(), serviceList.end(), arrayTopic)
+          != serviceList.end());
+
+  auto visCount = scene->VisualCount();
+
+  // Boxes of one material share a visual, spheres get another one
+  {
+    ignition::msgs::Marker_V markersMsg;
+    for (unsigned int i = 1; i <= 200; ++i)
+    {
+      ignition::msgs::Marker *markerMsg = markersMsg.add_marker();
+      markerMsg->set_ns("batch");
+      markerMsg->set_id(i);
+      markerMsg->set_action(ignition::msgs::Marker::ADD_MODIFY);
+      markerMsg->set_type(i <= 100 ? ignition::msgs::Marker::BOX :
+          ignition::msgs::Marker::SPHERE);
+      ignition::msgs::Set(markerMsg->mutable_pose(),
+          ignition::math::Pose3d(i * 0.1, 0, 0.5, 0, 0, 0));
+      ignition::msgs::Set(markerMsg->mutable_material()->mutable_diffuse(),
+          ignition::math::Color(1, 0, 0, 1));
+    }
+
+    ignition::msgs::Boolean rep;
+    bool result;
+    QVERIFY(node.Request(arrayTopic, markersMsg, 5000u, rep, result));
+    QVERIFY(result);
+
+    this->ProcessEventsAndDraw(mainWindow);
+
+    QCOMPARE(scene->VisualCount(), visCount + 2);
+  }
+
+  // Batched markers are listed
+  {
+    ignition::msgs::Marker_V rep;
+    bool result;
+    QVERIFY(node.Request(listTopic, 5000u, rep, result));
+    QCOMPARE(rep.marker().size(), 200);
+  }
+
+  // Move a box, then delete it
+  {
+    ignition::msgs::Marker_V markersMsg;
+    ignition::msgs::Marker *markerMsg = markersMsg.add_marker();
+    markerMsg->set_ns("batch");
+    markerMsg->set_id(1);
+    markerMsg->set_action(ignition::msgs::Marker::ADD_MODIFY);
+    ignition::msgs::Set(markerMsg->mutable_pose(),
+        ignition::math::Pose3d(0, 1, 0.5, 0, 0, 0));
+
+    ignition::msgs::Boolean boolRep;
+    bool result;
+    QVERIFY(node.Request(arrayTopic, markersMsg, 5000u, boolRep, result));
+    this->ProcessEventsAndDraw(mainWindow);
+
+    ignition::msgs::Marker_V rep;
+    QVERIFY(node.Request(listTopic, 5000u, rep, result));
+    QCOMPARE(rep.marker().size(), 200);
+    bool found = false;
+    for (auto const &listed : rep.marker())
+    {
+      if (listed.id() == 1u)
+      {
+        found = true;
+        QVERIFY(listed.type() == ignition::msgs::Marker::BOX);
+        QVERIFY(ignition::msgs::Convert(listed.pose()) ==
+            ignition::math::Pose3d(0, 1, 0.5, 0, 0, 0));
+      }
+    }
+    QVERIFY(found);
+
+    ignition::msgs::Marker deleteMsg;
+    deleteMsg.set_ns("batch");
+    deleteMsg.set_id(1);
+    deleteMsg.set_action(ignition::msgs::Marker::DELETE_MARKER);
+    QVERIFY(node.Request(markerTopic, deleteMsg));
+    this->ProcessEventsAndDraw(mainWindow);
+
+    QVERIFY(node.Request(listTopic, 5000u, rep, result));
+    QCOMPARE(rep.marker().size(), 199);
+    QCOMPARE(scene->VisualCount(), visCount + 2);
+  }
+
+  // Delete the namespace
+  {
+    ignition::msgs::Marker deleteMsg;
+    deleteMsg.set_ns("batch");
+    deleteMsg.set_action(ignition::msgs::Marker::DELETE_ALL);
+    QVERIFY(node.Request(markerTopic, deleteMsg));
+    this->ProcessEventsAndDraw(mainWindow);
+
+    QCOMPARE(scene->VisualCount(), visCount);
+  }
+
+  mainWindow->close();
+  delete mainWindow;
+}
+
 // Generate a main function for the test
 QTEST_MAIN(Marker_TEST)
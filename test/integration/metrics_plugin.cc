@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include <boost/asio.hpp>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+using boost::asio::ip::tcp;
+
+class MetricsPluginTest : public ServerFixture
+{
+  /// \brief Send a GET request to the metrics endpoint.
+  /// \param[in] _target Requested path.
+  /// \return Response, empty on error.
+  public: std::string Get(const std::string &_target)
+  {
+    boost::asio::io_service io;
+    tcp::socket socket(io);
+    boost::system::error_code ec;
+    socket.connect(tcp::endpoint(
+          boost::asio::ip::address::from_string("127.0.0.1"), 19464), ec);
+    if (ec)
+      return "";
+
+    const std::string request = "GET " + _target +
+      " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    boost::asio::write(socket, boost::asio::buffer(request), ec);
+    if (ec)
+      return "";
+
+    // The server closes the connection after the response.
+    boost::asio::streambuf response;
+    boost::asio::read(socket, response, ec);
+    return std::string(boost::asio::buffers_begin(response.data()),
+        boost::asio::buffers_end(response.data()));
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(MetricsPluginTest, Scrape)
+{
+  setenv("GAZEBO_METRICS_PORT", "19464", 1);
+  setenv("GAZEBO_METRICS_ADDRESS", "127.0.0.1", 1);
+  this->LoadArgs("-u -s libMetricsPlugin.so worlds/empty.world");
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  world->Step(100);
+
+  std::string response = this->Get("/metrics");
+  ASSERT_FALSE(response.empty());
+  EXPECT_EQ(0u, response.find("HTTP/1.1 200 OK\r\n"));
+  EXPECT_NE(std::string::npos,
+      response.find("application/openmetrics-text"));
+
+  EXPECT_NE(std::string::npos,
+      response.find("gazebo_sim_time_seconds{world=\"default\"} 0.1\n"));
+  EXPECT_NE(std::string::npos,
+      response.find("gazebo_iterations_total{world=\"default\"} 100\n"));
+  EXPECT_NE(std::string::npos,
+      response.find("gazebo_paused{world=\"default\"} 1\n"));
+  EXPECT_NE(std::string::npos, response.find(
+        "gazebo_stage_duration_seconds_count{stage=\"World::Update\"} "));
+  EXPECT_NE(std::string::npos, response.find(
+        "gazebo_stage_duration_seconds_bucket{stage=\"World::Update\","
+        "le=\"+Inf\"} "));
+  EXPECT_NE(std::string::npos,
+      response.find("gazebo_log_dropped_states_total 0\n"));
+  EXPECT_NE(std::string::npos,
+      response.find("gazebo_transport_pending_messages "));
+
+  // OpenMetrics requires the terminating line
+  const std::string eof = "# EOF\n";
+  ASSERT_GE(response.size(), eof.size());
+  EXPECT_EQ(eof, response.substr(response.size() - eof.size()));
+
+  // Other paths are not served
+  response = this->Get("/other");
+  EXPECT_EQ(0u, response.find("HTTP/1.1 404 Not Found\r\n"));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
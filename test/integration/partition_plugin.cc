@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class PartitionPluginTest : public ServerFixture
+{
+  /// \brief Load the world of one of two regions split at x = 0, and run
+  /// it paused next to the world of the fixture.
+  /// \param[in] _region Index of the region, 0 or 1.
+  /// \param[in] _box True to add a box at x = -0.5.
+  /// \return The world, named region_<_region>.
+  public: physics::WorldPtr LoadRegion(const int _region, const bool _box)
+  {
+    std::ostringstream worldStr;
+    worldStr
+      << "<sdf version='" << SDF_VERSION << "'>"
+      << "<world name='region_" << _region << "'>"
+      << "  <gravity>0 0 0</gravity>"
+      << "  <plugin name='partition' filename='libPartitionPlugin.so'>"
+      << "    <region>" << _region << "</region>"
+      << "    <region_count>2</region_count>"
+      << "    <boundaries>0</boundaries>"
+      << "    <halo>2</halo>"
+      << "    <sync>false</sync>"
+      << "  </plugin>";
+    if (_box)
+    {
+      worldStr
+        << "  <model name='box'>"
+        << "    <pose>-0.5 0 0.5 0 0 0</pose>"
+        << "    <link name='link'>"
+        << "      <collision name='collision'>"
+        << "        <geometry><box><size>1 1 1</size></box></geometry>"
+        << "      </collision>"
+        << "    </link>"
+        << "  </model>";
+    }
+    worldStr << "</world></sdf>";
+
+    sdf::SDFPtr worldSdf(new sdf::SDF);
+    worldSdf->SetFromString(worldStr.str());
+
+    physics::WorldPtr world = physics::create_world();
+    physics::load_world(world, worldSdf->Root()->GetElement("world"));
+    physics::init_world(world, nullptr);
+
+    // The sensor manager only tracks the first world of the process, and
+    // world plugins load once sensors are initialized
+    world->_SetSensorsInitialized(true);
+    world->SetPaused(true);
+    physics::run_world(world);
+    return world;
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(PartitionPluginTest, Handoff)
+{
+  this->Load("worlds/empty.world", true);
+
+  physics::WorldPtr lower = this->LoadRegion(0, true);
+  physics::WorldPtr upper = this->LoadRegion(1, false);
+  ASSERT_TRUE(lower != nullptr);
+  ASSERT_TRUE(upper != nullptr);
+
+  physics::ModelPtr box = lower->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  const ignition::math::Vector3d linearVel(2, 0, 0);
+  const ignition::math::Vector3d angularVel(0, 0, 1);
+  box->SetLinearVel(linearVel);
+  box->SetAngularVel(angularVel);
+
+  // Step the regions in turn until the upper region owns the box. Before
+  // that, it keeps a static ghost of the box.
+  physics::ModelPtr migrant;
+  for (int i = 0; i < 5000 && !migrant; ++i)
+  {
+    lower->Step(1);
+    upper->Step(1);
+
+    physics::ModelPtr model = upper->ModelByName("box");
+    if (model && !model->IsStatic())
+      migrant = model;
+  }
+  ASSERT_TRUE(migrant != nullptr);
+
+  // The migrant gets the state of the box on the step after its insertion,
+  // and the lower region removes its copy
+  lower->Step(1);
+  upper->Step(1);
+  EXPECT_TRUE(lower->ModelByName("box") == nullptr);
+
+  EXPECT_GT(migrant->WorldPose().Pos().X(), -0.1);
+  EXPECT_NEAR(migrant->WorldPose().Pos().Y(), 0.0, 1e-3);
+  EXPECT_NEAR(migrant->WorldPose().Pos().Z(), 0.5, 1e-3);
+  EXPECT_NEAR(migrant->WorldLinearVel().X(), linearVel.X(), 1e-2);
+  EXPECT_NEAR(migrant->WorldLinearVel().Y(), 0.0, 1e-2);
+  EXPECT_NEAR(migrant->WorldAngularVel().Z(), angularVel.Z(), 1e-2);
+  EXPECT_NEAR(migrant->GetLink("link")->WorldLinearVel().X(),
+      linearVel.X(), 1e-2);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
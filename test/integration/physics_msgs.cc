@@ -668,6 +668,23 @@ void PhysicsMsgsTest::SimpleShapeResize(const std::string &_physicsEngine)
           EXPECT_DOUBLE_EQ(geomMsg.cylinder().length(),
               modelSize[name].Z() * scaleFactor);
         }
+
+        // the collision visual geometry is cached between FillMsg calls
+        // and must follow the resized shape.
+        for (int k = 0; k < collisionMsg.visual_size(); ++k)
+        {
+          msgs::Geometry visGeomMsg = collisionMsg.visual(k).geometry();
+          if (visGeomMsg.has_box())
+          {
+            EXPECT_EQ(msgs::ConvertIgn(visGeomMsg.box().size()),
+                modelSize[name] * scaleFactor);
+          }
+          else if (visGeomMsg.has_sphere())
+          {
+            EXPECT_DOUBLE_EQ(visGeomMsg.sphere().radius(),
+                modelSize[name].X() * 0.5 * scaleFactor);
+          }
+        }
       }
     }
   }
@@ -79,6 +79,10 @@ TEST_F(StaticMapTest, StaticMapPlugin)
   EXPECT_TRUE(common::isFile(
       modelPath + "/materials/textures/" + centerTileName));
 
+  // the tile is kept in the tile cache
+  EXPECT_TRUE(common::isFile(basePath + "/static_map_tiles/satellite_21_640_" +
+      centerTileName.substr(5)));
+
   // done testing, remove cache
   boost::filesystem::remove_all(modelPath);
   EXPECT_FALSE(common::exists(modelPath));
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <mutex>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class SyncBarrierPluginTest : public ServerFixture
+{
+  /// \brief Load the world, whose plugin waits for host_a, and connect to
+  /// the topics of the plugin.
+  public: void LoadBarrier()
+  {
+    this->Load("test/worlds/sync_barrier_plugin.world", true);
+    this->world = physics::get_world("default");
+    ASSERT_TRUE(this->world != nullptr);
+
+    this->ackPub = this->node->Advertise<msgs::SyncAck>(
+        "~/sync_barrier/ack");
+    this->statusSub = this->node->Subscribe("~/sync_barrier/status",
+        &SyncBarrierPluginTest::OnStatus, this);
+    this->ackPub->WaitForConnection();
+  }
+
+  /// \brief Acknowledge poses as host_a, and give the plugin time to
+  /// receive the acknowledgement.
+  /// \param[in] _time Time of the poses.
+  public: void Ack(const common::Time &_time)
+  {
+    msgs::SyncAck ack;
+    ack.set_host("host_a");
+    msgs::Set(ack.mutable_time(), _time);
+    this->ackPub->Publish(ack);
+    common::Time::MSleep(100);
+  }
+
+  /// \brief Step the world.
+  /// \param[in] _steps Number of steps.
+  /// \return Wall time the steps took, in seconds.
+  public: double TimedStep(const unsigned int _steps)
+  {
+    const common::Time start = common::Time::GetWallTime();
+    this->world->Step(_steps);
+    return (common::Time::GetWallTime() - start).Double();
+  }
+
+  /// \brief Step once and get the status of host_a after the step. The
+  /// status publisher is throttled, so wait first.
+  /// \return Status of host_a.
+  public: msgs::SyncStatus::Host Status()
+  {
+    common::Time::MSleep(150);
+    const common::Time expected = this->world->SimTime();
+    this->world->Step(1);
+
+    for (int i = 0; i < 200; ++i)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->status.has_time() &&
+            msgs::Convert(this->status.time()) >= expected &&
+            this->status.host_size() == 1)
+        {
+          return this->status.host(0);
+        }
+      }
+      common::Time::MSleep(10);
+    }
+    ADD_FAILURE() << "No status received";
+    return msgs::SyncStatus::Host();
+  }
+
+  /// \brief Receive a status.
+  /// \param[in] _msg Status message.
+  private: void OnStatus(ConstSyncStatusPtr &_msg)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->status = *_msg;
+  }
+
+  /// \brief The world.
+  protected: physics::WorldPtr world;
+
+  /// \brief Publisher of acknowledgements.
+  private: transport::PublisherPtr ackPub;
+
+  /// \brief Subscriber to the status.
+  private: transport::SubscriberPtr statusSub;
+
+  /// \brief Protects status.
+  private: std::mutex mutex;
+
+  /// \brief Latest status.
+  private: msgs::SyncStatus status;
+};
+
+/////////////////////////////////////////////////
+TEST_F(SyncBarrierPluginTest, TimeoutAndRejoin)
+{
+  this->LoadBarrier();
+
+  // A host not heard from yet is not waited for
+  EXPECT_LT(this->TimedStep(50), 0.4);
+  msgs::SyncStatus::Host host = this->Status();
+  EXPECT_EQ(host.name(), "host_a");
+  EXPECT_LT(host.lag(), 0.0);
+  EXPECT_EQ(host.timeouts(), 0u);
+
+  // Within the allowed lag of 10 steps, the host is not waited for
+  const common::Time acked = this->world->SimTime();
+  this->Ack(acked);
+  EXPECT_LT(this->TimedStep(5), 0.4);
+
+  // Beyond it, the world waits for the timeout of 0.5 s and drops the host
+  EXPECT_GT(this->TimedStep(50), 0.45);
+  host = this->Status();
+  EXPECT_TRUE(host.dropped());
+  EXPECT_EQ(host.timeouts(), 1u);
+  EXPECT_GT(host.lag(), 0.01);
+
+  // A dropped host is not waited for
+  EXPECT_LT(this->TimedStep(50), 0.4);
+
+  // Acknowledging the same poses again does not bring it back
+  this->Ack(acked);
+  EXPECT_LT(this->TimedStep(50), 0.4);
+  host = this->Status();
+  EXPECT_TRUE(host.dropped());
+
+  // Newer poses do, and the world waits for the host again
+  this->Ack(this->world->SimTime());
+  host = this->Status();
+  EXPECT_FALSE(host.dropped());
+  EXPECT_LT(host.lag(), 0.01);
+  EXPECT_EQ(host.timeouts(), 1u);
+
+  EXPECT_GT(this->TimedStep(50), 0.45);
+  host = this->Status();
+  EXPECT_TRUE(host.dropped());
+  EXPECT_EQ(host.timeouts(), 2u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -18,12 +18,26 @@
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "gazebo/test/ServerFixture.hh"
 
 using namespace gazebo;
 
 class TransportTest : public ServerFixture
 {
+  /// \brief Callback for subscribers with a quality of service.
+  /// \param[in] _msg Received message.
+  public: void OnQoSString(ConstGzStringPtr &/*_msg*/)
+          {
+            ++this->qosCount;
+          }
+
+  /// \brief Number of messages received by OnQoSString.
+  public: int qosCount = 0;
 };
 
 bool g_worldStatsMsg2 = false;
@@ -788,6 +802,244 @@ TEST_F(TransportTest, TryInit)
   EXPECT_EQ(physics::get_world()->Name(), node->GetTopicNamespace());
 }
 
+/////////////////////////////////////////////////
+TEST_F(TransportTest, SubscriptionQoS)
+{
+  transport::SubscriptionQoS limited;
+  limited.maxRate = 10;
+  limited.queueDepth = 2;
+  limited.keepLatest = true;
+
+  transport::SubscriptionQoS faster;
+  faster.maxRate = 30;
+  faster.queueDepth = 1;
+  faster.keepLatest = true;
+
+  // The least restrictive limits win.
+  transport::SubscriptionQoS merged = limited;
+  merged.Merge(faster);
+  EXPECT_DOUBLE_EQ(30, merged.maxRate);
+  EXPECT_EQ(2u, merged.queueDepth);
+  EXPECT_TRUE(merged.keepLatest);
+
+  // No limit beats any limit.
+  merged.Merge(transport::SubscriptionQoS());
+  EXPECT_DOUBLE_EQ(0, merged.maxRate);
+  EXPECT_EQ(0u, merged.queueDepth);
+  EXPECT_FALSE(merged.keepLatest);
+
+  this->Load("worlds/empty.world");
+  transport::NodePtr node = transport::NodePtr(new transport::Node());
+  node->Init();
+
+  transport::SubscriptionQoS qos;
+  EXPECT_FALSE(node->SubscriberQoS("/gazebo/test/qos", qos));
+
+  transport::SubscriberPtr sub1 = node->Subscribe("/gazebo/test/qos",
+      &TransportTest::OnQoSString, this, limited);
+  ASSERT_TRUE(node->SubscriberQoS("/gazebo/test/qos", qos));
+  EXPECT_DOUBLE_EQ(10, qos.maxRate);
+  EXPECT_EQ(2u, qos.queueDepth);
+  EXPECT_TRUE(qos.keepLatest);
+
+  transport::SubscriberPtr sub2 = node->Subscribe("/gazebo/test/qos",
+      &TransportTest::OnQoSString, this, faster);
+  ASSERT_TRUE(node->SubscriberQoS("/gazebo/test/qos", qos));
+  EXPECT_DOUBLE_EQ(30, qos.maxRate);
+  EXPECT_EQ(2u, qos.queueDepth);
+
+  // Local subscribers are not limited.
+  transport::PublisherPtr pub =
+      node->Advertise<msgs::GzString>("/gazebo/test/qos");
+  msgs::GzString msg;
+  msg.set_data("qos");
+  for (int i = 0; i < 5; ++i)
+    pub->Publish(msg);
+
+  int sleep = 0;
+  while (this->qosCount < 10 && sleep++ < 50)
+    common::Time::MSleep(10);
+  EXPECT_EQ(10, this->qosCount);
+
+  pub.reset();
+  sub1.reset();
+  sub2.reset();
+  node.reset();
+}
+
+/////////////////////////////////////////////////
+// Local subscribers receive the message itself, so nothing is serialized.
+TEST_F(TransportTest, SerializeCount)
+{
+  this->Load("worlds/empty.world");
+  transport::NodePtr node = transport::NodePtr(new transport::Node());
+  node->Init();
+
+  transport::PublisherPtr pub =
+      node->Advertise<msgs::GzString>("/gazebo/test/serialize");
+  transport::SubscriberPtr sub = node->Subscribe("/gazebo/test/serialize",
+      &TransportTest::OnQoSString, this);
+
+  transport::PublicationPtr publication =
+      transport::TopicManager::Instance()->FindPublication(
+      "/gazebo/test/serialize");
+  ASSERT_TRUE(publication != nullptr);
+  EXPECT_EQ(0u, publication->SerializeCount());
+  EXPECT_EQ(0u, publication->SerializedBytes());
+
+  msgs::GzString msg;
+  msg.set_data("serialize");
+  for (int i = 0; i < 5; ++i)
+    pub->Publish(msg);
+
+  int sleep = 0;
+  while (this->qosCount < 5 && sleep++ < 50)
+    common::Time::MSleep(10);
+  EXPECT_EQ(5, this->qosCount);
+  EXPECT_EQ(0u, publication->SerializeCount());
+  EXPECT_EQ(0u, publication->SerializedBytes());
+
+  pub.reset();
+  sub.reset();
+  node.reset();
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportTest, PublishBatch)
+{
+  this->Load("worlds/empty.world");
+  transport::NodePtr node = transport::NodePtr(new transport::Node());
+  node->Init();
+
+  transport::PublisherPtr pub =
+      node->Advertise<msgs::GzString>("/gazebo/test/batch");
+  transport::SubscriberPtr sub = node->Subscribe("/gazebo/test/batch",
+      &TransportTest::OnQoSString, this);
+
+  EXPECT_FALSE(node->InPublishBatch());
+  node->BeginPublishBatch();
+  node->BeginPublishBatch();
+  EXPECT_TRUE(node->InPublishBatch());
+
+  msgs::GzString msg;
+  msg.set_data("batch");
+  for (int i = 0; i < 5; ++i)
+    pub->Publish(msg);
+
+  // Nothing is sent until the outermost batch ends.
+  common::Time::MSleep(100);
+  EXPECT_EQ(0, this->qosCount);
+  EXPECT_EQ(5u, pub->GetOutgoingCount());
+
+  node->EndPublishBatch();
+  EXPECT_TRUE(node->InPublishBatch());
+  common::Time::MSleep(100);
+  EXPECT_EQ(0, this->qosCount);
+
+  node->EndPublishBatch();
+  EXPECT_FALSE(node->InPublishBatch());
+
+  int sleep = 0;
+  while (this->qosCount < 5 && sleep++ < 50)
+    common::Time::MSleep(10);
+  EXPECT_EQ(5, this->qosCount);
+
+  pub.reset();
+  sub.reset();
+  node.reset();
+}
+
+/////////////////////////////////////////////////
+/// \brief Records the messages received on one topic.
+class FlushReceiver
+{
+  /// \brief Message callback.
+  /// \param[in] _msg Received message.
+  public: void OnMsg(ConstIntPtr &_msg)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->received.push_back(_msg->data());
+  }
+
+  /// \brief Get the number of received messages.
+  /// \return Number of messages.
+  public: size_t Count()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->received.size();
+  }
+
+  /// \brief Received values, in order.
+  public: std::vector<int> received;
+
+  /// \brief Protects received.
+  public: std::mutex mutex;
+};
+
+/////////////////////////////////////////////////
+TEST_F(TransportTest, ParallelFlushKeepsOrder)
+{
+  this->Load("worlds/empty.world");
+
+  // Enough nodes for TopicManager::ProcessNodes to flush them in parallel
+  const int nodeCount = 64;
+  const int msgCount = 20;
+
+  std::vector<std::unique_ptr<FlushReceiver>> receivers;
+  std::vector<transport::NodePtr> nodes;
+  std::vector<transport::PublisherPtr> pubs;
+  std::vector<transport::SubscriberPtr> subs;
+  for (int n = 0; n < nodeCount; ++n)
+  {
+    transport::NodePtr node(new transport::Node());
+    node->Init();
+    std::string topic = "/gazebo/test/flush" + std::to_string(n);
+    receivers.emplace_back(new FlushReceiver);
+    pubs.push_back(node->Advertise<msgs::Int>(topic));
+    subs.push_back(node->Subscribe(topic, &FlushReceiver::OnMsg,
+        receivers.back().get()));
+    nodes.push_back(node);
+  }
+
+  transport::TopicManager *topics = transport::TopicManager::Instance();
+  const uint64_t flushedNodes = topics->FlushedNodeCount();
+
+  // Queue the messages of every node, then flush all nodes at once
+  for (auto &node : nodes)
+    node->BeginPublishBatch();
+  msgs::Int msg;
+  for (int i = 0; i < msgCount; ++i)
+  {
+    msg.set_data(i);
+    for (auto &pub : pubs)
+      pub->Publish(msg);
+  }
+  for (auto &node : nodes)
+    node->EndPublishBatch();
+
+  int sleep = 0;
+  bool done = false;
+  while (!done && sleep++ < 100)
+  {
+    common::Time::MSleep(10);
+    done = true;
+    for (auto &r : receivers)
+      done = done && r->Count() == static_cast<size_t>(msgCount);
+  }
+  EXPECT_TRUE(done);
+
+  // Every node sent its messages in order
+  for (auto &r : receivers)
+  {
+    std::lock_guard<std::mutex> lock(r->mutex);
+    ASSERT_EQ(msgCount, static_cast<int>(r->received.size()));
+    for (int i = 0; i < msgCount; ++i)
+      EXPECT_EQ(i, r->received[i]);
+  }
+  EXPECT_GE(topics->FlushedNodeCount(), flushedNodes + nodeCount);
+  EXPECT_GT(topics->FlushTime(), 0u);
+}
+
 /////////////////////////////////////////////////
 // Main
 int main(int argc, char **argv)
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/transport/transport.hh"
+
+using namespace gazebo;
+class WarmRestart : public ServerFixture
+{
+};
+
+/// \brief Number of warm restart results received.
+std::atomic<int> g_warmResults(0);
+
+/// \brief Last warm restart result.
+std::atomic<bool> g_warmRestarted(false);
+
+/////////////////////////////////////////////////
+void OnWorldModify(ConstWorldModifyPtr &_msg)
+{
+  if (!_msg->has_warm_restarted())
+    return;
+
+  g_warmRestarted = _msg->warm_restarted();
+  ++g_warmResults;
+}
+
+/////////////////////////////////////////////////
+TEST_F(WarmRestart, Restore)
+{
+  LoadArgs(" -u --warm worlds/shapes.world");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != NULL);
+  const ignition::math::Pose3d initialPose = box->WorldPose();
+  const unsigned int modelCount = world->ModelCount();
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::PublisherPtr serverControlPub =
+    node->Advertise<msgs::ServerControl>("/gazebo/server/control");
+  transport::SubscriberPtr worldModSub =
+    node->Subscribe("/gazebo/world/modify", &OnWorldModify);
+
+  // A session moves a model, inserts another one and runs the world
+  SpawnBox("session_box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(5, 0, 0.5));
+  box->SetWorldPose(ignition::math::Pose3d(1, 2, 3, 0, 0, 0));
+  world->Step(100);
+  EXPECT_EQ(modelCount + 1u, world->ModelCount());
+  EXPECT_LT(0.0, world->SimTime().Double());
+
+  msgs::ServerControl msg;
+  msg.set_warm_restart(true);
+  serverControlPub->Publish(msg);
+
+  int retries = 0;
+  while (g_warmResults == 0 && retries++ < 200)
+    common::Time::MSleep(20);
+  ASSERT_EQ(1, g_warmResults);
+  EXPECT_TRUE(g_warmRestarted);
+
+  EXPECT_EQ(modelCount, world->ModelCount());
+  EXPECT_TRUE(world->ModelByName("session_box") == NULL);
+  EXPECT_EQ(initialPose, box->WorldPose());
+  EXPECT_DOUBLE_EQ(0.0, world->SimTime().Double());
+  EXPECT_TRUE(world->IsPaused());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
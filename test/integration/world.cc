@@ -34,6 +34,10 @@ class WorldTest : public ServerFixture,
   /// \brief Test MagneticField, SetMagneticField
   /// \param[in] _physicsEngine Physics engine to use.
   public: void MagneticField(const std::string &_physicsEngine);
+
+  /// \brief Test StateSnapshot, RestoreStateSnapshot
+  /// \param[in] _physicsEngine Physics engine to use.
+  public: void StateSnapshot(const std::string &_physicsEngine);
 };
 
 /// \brief Pose after physics update
@@ -269,6 +273,61 @@ TEST_P(WorldTest, MagneticField)
   MagneticField(GetParam());
 }
 
+/////////////////////////////////////////////////
+void WorldTest::StateSnapshot(const std::string &_physicsEngine)
+{
+  this->Load("worlds/shapes.world", true, _physicsEngine);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != NULL);
+  physics::LinkPtr link = box->GetLink("link");
+  ASSERT_TRUE(link != NULL);
+
+  // Lift the box so that it falls
+  box->SetWorldPose(ignition::math::Pose3d(0, 0, 2, 0, 0, 0));
+  world->Step(100);
+  const ignition::math::Pose3d pose = link->WorldPose();
+  const ignition::math::Vector3d linearVel = link->WorldLinearVel();
+  const common::Time simTime = world->SimTime();
+  const uint64_t iterations = world->Iterations();
+  EXPECT_LT(linearVel.Z(), -0.5);
+
+  const std::string snapshot = world->StateSnapshot();
+  EXPECT_FALSE(snapshot.empty());
+
+  world->Step(200);
+  EXPECT_NE(pose, link->WorldPose());
+
+  // Restoring brings back the state of the snapshot
+  EXPECT_TRUE(world->RestoreStateSnapshot(snapshot));
+  EXPECT_EQ(pose, link->WorldPose());
+  EXPECT_EQ(linearVel, link->WorldLinearVel());
+  EXPECT_EQ(simTime, world->SimTime());
+  EXPECT_EQ(iterations, world->Iterations());
+
+  // The restored state evolves like the original one
+  world->Step(10);
+  EXPECT_LT(link->WorldLinearVel().Z(), linearVel.Z());
+
+  // Invalid snapshots are rejected
+  EXPECT_FALSE(world->RestoreStateSnapshot(""));
+  EXPECT_FALSE(world->RestoreStateSnapshot(std::string(100, 'x')));
+  EXPECT_FALSE(world->RestoreStateSnapshot(
+        snapshot.substr(0, snapshot.size() - 1)));
+
+  // So are snapshots of other models
+  world->RemoveModel("sphere");
+  EXPECT_FALSE(world->RestoreStateSnapshot(snapshot));
+}
+
+/////////////////////////////////////////////////
+TEST_P(WorldTest, StateSnapshot)
+{
+  StateSnapshot(GetParam());
+}
+
 /////////////////////////////////////////////////
 TEST_F(WorldTest, ModifyLight)
 {
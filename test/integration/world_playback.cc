@@ -303,6 +303,38 @@ INSTANTIATE_TEST_CASE_P(LogFiles,
                                           "state2.log",
                                           "state3.log"),);  // NOLINT
 
+/// \brief Helper class that plays a segment of a log.
+class WorldPlaybackSegmentTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Check that the world stops at the end of the played segment.
+TEST_F(WorldPlaybackSegmentTest, PlayRange)
+{
+  boost::filesystem::path logPath = TEST_PATH;
+  logPath /= "logs/state3.log";
+
+  this->LoadArgs("-u -p " + logPath.string() +
+      " --play_start 15 --play_end 19");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  EXPECT_EQ(common::Time(19.0), world->LogPlayEndTime());
+
+  world->SetPaused(false);
+  int sleep = 0;
+  while (world->Running() && sleep < 3000)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    sleep++;
+  }
+  EXPECT_FALSE(world->Running());
+
+  // Frame #4 is played, the states past the end are not
+  EXPECT_GE(world->SimTime(), common::Time(18.376));
+  EXPECT_LE(world->SimTime(), common::Time(19.0));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
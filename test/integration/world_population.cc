@@ -15,6 +15,7 @@
  *
 */
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <boost/lexical_cast.hpp>
@@ -27,8 +28,26 @@ class WorldEnvPopulationTest : public ServerFixture,
 {
   public: void LoadEnvironment(const std::string &_physicsType);
   public: void EmptyPopulation(const std::string &_physicsType);
+  public: void InsertModels(const std::string &_physicsType);
+
+  /// \brief Callback for the model batch messages.
+  /// \param[in] _msg The models.
+  public: void OnModelV(ConstModel_VPtr &_msg);
+
+  /// \brief Number of models announced in batch messages.
+  public: std::atomic<int> batchModels{0};
+
+  /// \brief Number of batch messages received.
+  public: std::atomic<int> batchMsgs{0};
 };
 
+/////////////////////////////////////////////////
+void WorldEnvPopulationTest::OnModelV(ConstModel_VPtr &_msg)
+{
+  this->batchModels += _msg->models_size();
+  ++this->batchMsgs;
+}
+
 ////////////////////////////////////////////////////////////////////////
 // EmptyPopulation: Try to generate a population with an incorrect 'model_count'
 // value.
@@ -162,6 +181,68 @@ void WorldEnvPopulationTest::LoadEnvironment(const std::string &/*_physicsEng*/)
   }
 }
 
+////////////////////////////////////////////////////////////////////////
+// InsertModels: Insert a batch of models cloned from a single element, and
+// check that they are announced in one message.
+////////////////////////////////////////////////////////////////////////
+void WorldEnvPopulationTest::InsertModels(const std::string &_physicsEng)
+{
+  Load("worlds/empty.world", false, _physicsEng);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  transport::SubscriberPtr sub = this->node->Subscribe("~/model/info_v",
+      &WorldEnvPopulationTest::OnModelV, this);
+
+  sdf::SDFPtr modelSdf(new sdf::SDF);
+  modelSdf->SetFromString(std::string("<sdf version='") + SDF_VERSION + "'>"
+      "<model name='box'>"
+      "  <link name='link'>"
+      "    <collision name='collision'>"
+      "      <geometry><box><size>0.1 0.1 0.1</size></box></geometry>"
+      "    </collision>"
+      "  </link>"
+      "</model>"
+      "</sdf>");
+  sdf::ElementPtr modelElem = modelSdf->Root()->GetElement("model");
+
+  const int count = 100;
+  std::vector<sdf::ElementPtr> models;
+  for (int i = 0; i < count; ++i)
+  {
+    sdf::ElementPtr clone = modelElem->Clone();
+    clone->GetAttribute("name")->Set("box_" + std::to_string(i));
+    clone->GetElement("pose")->Set(
+        ignition::math::Pose3d(i * 0.2, 0, 0.05, 0, 0, 0));
+    models.push_back(clone);
+  }
+
+  // A name that already exists is skipped
+  models.push_back(modelElem->Clone());
+  models.back()->GetAttribute("name")->Set("box_0");
+
+  world->InsertModels(models);
+
+  int i = 0;
+  int retries = 200;
+  while ((world->ModelCount() < count + 1u || this->batchMsgs == 0) &&
+      i < retries)
+  {
+    common::Time::MSleep(100);
+    ++i;
+  }
+  ASSERT_LT(i, retries);
+
+  EXPECT_EQ(count + 1u, world->ModelCount());
+  EXPECT_EQ(1, this->batchMsgs);
+  EXPECT_EQ(count, this->batchModels);
+
+  physics::ModelPtr model = world->ModelByName("box_42");
+  ASSERT_TRUE(model != NULL);
+  EXPECT_NEAR(42 * 0.2, model->WorldPose().Pos().X(), 1e-3);
+  EXPECT_NEAR(0.0, model->WorldPose().Pos().Y(), 1e-3);
+}
+
 ////////////////////////////////////////////////////////////////////////
 TEST_P(WorldEnvPopulationTest, EmptyPopulation)
 {
@@ -174,6 +255,12 @@ TEST_P(WorldEnvPopulationTest, LoadEnvironment)
   LoadEnvironment(GetParam());
 }
 
+////////////////////////////////////////////////////////////////////////
+TEST_P(WorldEnvPopulationTest, InsertModels)
+{
+  InsertModels(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, WorldEnvPopulationTest,
                         PHYSICS_ENGINE_VALUES,);  // NOLINT
 
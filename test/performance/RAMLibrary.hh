@@ -58,6 +58,37 @@ namespace gazebo
           return 0;  // nothing found
       }
 
+      /// \brief Parse /proc/self/status and return the value corresponding
+      ///        to the key given.
+      /// \param[in] _key string represent keys in status ended with a colon
+      ///        example: "VmRSS:"
+      uint64_t ParseProcSelfStatus(const std::string &_key)
+      {
+          std::string token;
+          std::ifstream file("/proc/self/status");
+          while (file >> token)
+          {
+              if (token == _key)
+              {
+                  uint64_t mem;
+                  if (file >> mem)
+                      return mem;
+                  else
+                      return 0;
+              }
+              // ignore rest of the line
+              file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+          }
+          return 0;  // nothing found
+      }
+
+      /// \brief Get the resident memory of this process
+      /// \return Resident memory in kilobytes
+      uint64_t GetProcessResidentMemory()
+      {
+          return ParseProcSelfStatus("VmRSS:");
+      }
+
       /// \brief Get the RAM memory available at the moment
       /// \return RAM ammount in Megabytes
       uint64_t GetMemoryAvailable()
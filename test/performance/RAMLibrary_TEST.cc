@@ -51,6 +51,16 @@ TEST(RAMLibrary, IsMemoryAvailable_CrazyHighNumber_False)
   ASSERT_FALSE(IsMemoryAvailable(9999999999));
 }
 
+TEST(RAMLibrary, GetProcessResidentMemory_NoZero)
+{
+  ASSERT_GT(GetProcessResidentMemory(), 0u);
+}
+
+TEST(RAMLibrary, GetProcessResidentMemory_LessThanTotal)
+{
+  ASSERT_LT(GetProcessResidentMemory() / 1024, GetTotalMemory());
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
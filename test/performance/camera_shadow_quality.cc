@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <string>
+
+#include "gazebo/common/Timer.hh"
+#include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/Scene.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class CameraShadowQualityTest : public ServerFixture
+{
+  /// \brief Count the frames of a camera.
+  public: void OnNewFrame(const unsigned char * /*_image*/,
+              unsigned int /*_width*/, unsigned int /*_height*/,
+              unsigned int /*_depth*/, const std::string &/*_format*/)
+  {
+    ++this->frames;
+  }
+
+  /// \brief Number of frames received.
+  public: std::atomic<unsigned int> frames{0};
+};
+
+/////////////////////////////////////////////////
+/// Compare the frame rate of a camera sensor with each shadow quality.
+TEST_F(CameraShadowQualityTest, FrameRate)
+{
+  Load("worlds/shapes.world");
+
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run shadow quality test\n";
+    return;
+  }
+
+  const std::string cameraName = "camera_sensor";
+  SpawnCamera("camera_model", cameraName,
+      ignition::math::Vector3d(-5, 0, 1), ignition::math::Vector3d::Zero,
+      640, 480, 0);
+
+  sensors::CameraSensorPtr sensor =
+      std::dynamic_pointer_cast<sensors::CameraSensor>(
+      sensors::get_sensor(cameraName));
+  ASSERT_TRUE(sensor != nullptr);
+  rendering::CameraPtr camera = sensor->Camera();
+  ASSERT_TRUE(camera != nullptr);
+  rendering::ScenePtr scene = camera->GetScene();
+  ASSERT_TRUE(scene != nullptr);
+
+  event::ConnectionPtr connection = camera->ConnectNewImageFrame(
+      std::bind(&CameraShadowQualityTest::OnNewFrame, this,
+        std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+        std::placeholders::_4, std::placeholders::_5));
+
+  const rendering::Camera::ShadowQualityLevel levels[] = {
+      rendering::Camera::SHADOW_FULL,
+      rendering::Camera::SHADOW_STATIC,
+      rendering::Camera::SHADOW_OFF};
+  const std::string names[] = {"full", "static", "off"};
+
+  double fps[3];
+  uint64_t cached[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    camera->SetShadowQuality(levels[i]);
+
+    // Let the setting reach a frame
+    common::Time::MSleep(200);
+
+    const uint64_t cachedStart = scene->CachedShadowCount();
+    this->frames = 0;
+    common::Timer timer;
+    timer.Start();
+    common::Time::MSleep(3000);
+    fps[i] = this->frames / timer.GetElapsed().Double();
+    cached[i] = scene->CachedShadowCount() - cachedStart;
+  }
+
+  // Only the static shadow maps are cached
+  EXPECT_EQ(0u, cached[0]);
+  if (scene->ShadowsEnabled())
+    EXPECT_GT(cached[1], 0u);
+  EXPECT_EQ(0u, cached[2]);
+
+  for (int i = 0; i < 3; ++i)
+  {
+    gzmsg << "Shadow quality [" << names[i] << "] fps [" << fps[i]
+          << "], cached shadow maps [" << cached[i] << "]\n";
+  }
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
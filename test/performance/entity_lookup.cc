@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/Base.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class EntityLookupTest : public ServerFixture {};
+
+/// \brief Number of models of the tree.
+static const unsigned int kModels = 100;
+
+/// \brief Number of links of each model, 10k entities in total.
+static const unsigned int kLinks = 100;
+
+/// \brief Create a child entity with a name.
+/// \param[in] _parent Parent entity.
+/// \param[in] _name Name of the child.
+/// \return The child.
+static physics::BasePtr AddEntity(const physics::BasePtr &_parent,
+    const std::string &_name)
+{
+  physics::BasePtr entity(new physics::Base(_parent));
+  entity->Load(sdf::ElementPtr());
+  entity->SetName(_name);
+  return entity;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compare the lookup of scoped names through the name indices with
+/// the depth first search of the tree, at 10k entities.
+TEST_F(EntityLookupTest, ScopedNames)
+{
+  physics::BasePtr root(new physics::Base(physics::BasePtr()));
+  root->SetName("default");
+
+  std::vector<std::string> names;
+  for (unsigned int m = 0; m < kModels; ++m)
+  {
+    const std::string modelName = "model_" + std::to_string(m);
+    physics::BasePtr model = AddEntity(root, modelName);
+    for (unsigned int l = 0; l < kLinks; ++l)
+    {
+      const std::string linkName = "link_" + std::to_string(l);
+      AddEntity(model, linkName);
+      names.push_back(modelName + "::" + linkName);
+    }
+  }
+
+  const unsigned int lookups = 100000;
+
+  // Local names of nested entities are not in the indices of the root, so
+  // they are searched depth first, as all names used to be.
+  common::Time startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < lookups / 100; ++i)
+    EXPECT_NE(nullptr, root->GetByName("link_" + std::to_string(i % kLinks)));
+  const common::Time searchTime =
+      (common::Time::GetWallTime() - startTime) * 100.0;
+
+  startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < lookups; ++i)
+  {
+    const std::string &name = names[(i * 7919) % names.size()];
+    physics::BasePtr entity = root->GetByName(name);
+    ASSERT_NE(nullptr, entity);
+    EXPECT_EQ(name, entity->GetScopedName());
+  }
+  const common::Time indexTime = common::Time::GetWallTime() - startTime;
+
+  gzmsg << "[" << lookups << "] lookups among [" << names.size()
+        << "] entities: depth first search [" << searchTime
+        << "] s (extrapolated), name index [" << indexTime << "] s\n";
+
+  EXPECT_LT(indexTime, searchTime);
+  EXPECT_EQ(nullptr, root->GetByName("model_0::missing"));
+
+  // Teardown must not be quadratic
+  startTime = common::Time::GetWallTime();
+  root->Fini();
+  EXPECT_LT(common::Time::GetWallTime() - startTime, common::Time(5, 0));
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,12 +14,21 @@
  * limitations under the License.
  *
 */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
 #include <boost/shared_ptr.hpp>
 
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/common.hh"
+#include "gazebo/common/PixelConversions.hh"
 
 using namespace std;
 using namespace gazebo;
@@ -62,6 +71,103 @@ TEST_F(ImageConvertStressTest, ManyConversions)
   EXPECT_LE(memAfter - memBefore, 2000);
 }
 
+/////////////////////////////////////////////////
+/// \brief Time a conversion, and print its throughput as a JSON object on
+/// one line. When the GAZEBO_BENCHMARK_JSON environment variable is set,
+/// the line is also appended to the file it names.
+/// \param[in] _name Name of the conversion.
+/// \param[in] _width Image width.
+/// \param[in] _height Image height.
+/// \param[in] _func Conversion to time.
+static void Throughput(const std::string &_name, const unsigned int _width,
+    const unsigned int _height, const std::function<void()> &_func)
+{
+  // Warm up the caches and the page tables of the buffers
+  _func();
+
+  const unsigned int iterations = 50;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+    _func();
+  const double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  const double pixels = static_cast<double>(_width) * _height * iterations;
+  std::ostringstream json;
+  json << "{\"conversion\": \"" << _name << "\""
+       << ", \"width\": " << _width
+       << ", \"height\": " << _height
+       << ", \"iterations\": " << iterations
+       << ", \"time_per_frame_us\": " << seconds / iterations * 1e6
+       << ", \"megapixels_per_second\": " << pixels / seconds * 1e-6
+       << "}";
+
+  std::cout << json.str() << std::endl;
+
+  const char *output = std::getenv("GAZEBO_BENCHMARK_JSON");
+  if (output && output[0] != '\0')
+  {
+    std::ofstream file(output, std::ios::app);
+    EXPECT_TRUE(file.good()) << output;
+    file << json.str() << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageConvertStressTest, Throughput)
+{
+  const std::vector<std::pair<unsigned int, unsigned int>> sizes =
+    {{640, 480}, {1280, 960}, {1920, 1080}};
+
+  for (const auto &size : sizes)
+  {
+    const unsigned int width = size.first;
+    const unsigned int height = size.second;
+    const size_t count = static_cast<size_t>(width) * height;
+
+    std::vector<unsigned char> rgba(count * 4);
+    for (size_t i = 0; i < rgba.size(); ++i)
+      rgba[i] = static_cast<unsigned char>(i * 31);
+    std::vector<unsigned char> rgb(rgba.begin(), rgba.begin() + count * 3);
+    std::vector<unsigned char> out(count * 4);
+    std::vector<float> depth(count);
+    for (size_t i = 0; i < count; ++i)
+      depth[i] = 0.05f + (i % 1000) * 0.01f;
+    std::vector<uint16_t> depth16(count);
+
+    Throughput("rgb_to_bgr", width, height, [&]()
+    {
+      common::ConvertRGBToBGR(rgb.data(), out.data(), count);
+    });
+    Throughput("rgba_to_rgb", width, height, [&]()
+    {
+      common::ConvertRGBAToRGB(rgba.data(), out.data(), count);
+    });
+    Throughput("bayer_rggb8", width, height, [&]()
+    {
+      common::ConvertRGBToBayer(rgb.data(), out.data(), width, height,
+          "BAYER_RGGB8");
+    });
+    Throughput("depth_to_uint16", width, height, [&]()
+    {
+      common::ConvertDepthToUInt16(depth.data(), depth16.data(), count,
+          1000.0f, 0.1f, 10.0f);
+    });
+    Throughput("resize_half_rgb", width, height, [&]()
+    {
+      common::ResizeImage(rgb.data(), width, height, width * 3, out.data(),
+          width / 2, height / 2, width / 2 * 3, 3);
+    });
+
+    // Conversion through FreeImage, for reference
+    Throughput("image_set_from_data_rgb", width, height, [&]()
+    {
+      common::Image image;
+      image.SetFromData(rgb.data(), width, height, common::Image::RGB_INT8);
+    });
+  }
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Number of heap allocations made by the process.
+static std::atomic<uint64_t> g_allocations(0);
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  ++g_allocations;
+  void *ptr = std::malloc(_size == 0 ? 1 : _size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+class MessageAllocationsTest : public ServerFixture
+{
+  /// \brief Callback for the pose topic.
+  /// \param[in] _msg Received message.
+  public: void OnPoses(ConstPosesStampedPtr &/*_msg*/) {}
+
+  /// \brief Callback for the contact topic.
+  /// \param[in] _msg Received message.
+  public: void OnContacts(ConstContactsPtr &/*_msg*/) {}
+};
+
+/// \brief Fill a pose message like World::ProcessMessages does.
+/// \param[in] _msg Message to fill.
+/// \param[in] _count Number of poses.
+static void FillPoses(msgs::PosesStamped &_msg, const unsigned int _count)
+{
+  msgs::Set(_msg.mutable_time(), common::Time(1, 0));
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    msgs::Pose *poseMsg = _msg.add_pose();
+    poseMsg->set_name("model");
+    poseMsg->set_id(i);
+    msgs::Set(poseMsg, ignition::math::Pose3d(i, 0, 0, 0, 0, 0));
+  }
+}
+
+/////////////////////////////////////////////////
+/// Compare a pose message built from scratch every step, the way the
+/// world used to build it, with a message that is cleared and refilled.
+TEST_F(MessageAllocationsTest, PosesStamped)
+{
+  const unsigned int steps = 100;
+  const unsigned int poses = 1000;
+
+  uint64_t start = g_allocations;
+  for (unsigned int i = 0; i < steps; ++i)
+  {
+    msgs::PosesStamped msg;
+    FillPoses(msg, poses);
+  }
+  uint64_t fresh = g_allocations - start;
+
+  msgs::PosesStamped reused;
+  FillPoses(reused, poses);
+  start = g_allocations;
+  for (unsigned int i = 0; i < steps; ++i)
+  {
+    reused.Clear();
+    FillPoses(reused, poses);
+  }
+  uint64_t cleared = g_allocations - start;
+
+  EXPECT_LT(cleared * 10, fresh);
+
+  gzmsg << poses << " poses, allocations per step: new message ["
+        << fresh / steps << "], reused message [" << cleared / steps
+        << "]\n";
+}
+
+/////////////////////////////////////////////////
+/// Report the allocations per step of a world publishing poses and
+/// contacts.
+TEST_F(MessageAllocationsTest, WorldStep)
+{
+  Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  transport::SubscriberPtr poseSub = this->node->Subscribe("~/pose/info",
+      &MessageAllocationsTest::OnPoses, this);
+  transport::SubscriberPtr contactSub = this->node->Subscribe(
+      "~/physics/contacts", &MessageAllocationsTest::OnContacts, this);
+
+  // Let the shapes settle, so that contacts are steady.
+  world->Step(500);
+
+  const unsigned int steps = 1000;
+  uint64_t start = g_allocations;
+  world->Step(steps);
+  uint64_t allocations = g_allocations - start;
+
+  gzmsg << "allocations per step [" << allocations / steps << "]\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
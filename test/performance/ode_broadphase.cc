@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ODEBroadphaseTest
+  : public ServerFixture, public testing::WithParamInterface<const char*>
+{
+};
+
+/////////////////////////////////////////////////
+/// Step a wide world with thousands of static boxes using each top-level
+/// space type, and report the time spent in the simulation loop. The
+/// spheres dropped between the boxes must come to rest on the ground with
+/// any broadphase.
+TEST_P(ODEBroadphaseTest, StaticField)
+{
+  const std::string spaceType = GetParam();
+
+  Load("worlds/ode_broadphase.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Populations are inserted through the factory, wait for all of them:
+  // the ground plane, 2000 boxes and 64 spheres.
+  const unsigned int modelCount = 2065;
+  for (unsigned int i = 0; i < 300 && world->ModelCount() < modelCount; ++i)
+    common::Time::MSleep(100);
+  ASSERT_EQ(modelCount, world->ModelCount());
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  ASSERT_EQ("ode", physics->GetType());
+
+  // Bound the quadtree to the populated area
+  physics->SetParam("space_quadtree_extents",
+      ignition::math::Vector3d(110, 90, 10));
+  physics->SetParam("space_quadtree_depth", 6);
+  ASSERT_TRUE(physics->SetParam("space_type", spaceType));
+
+  const unsigned int steps = 1000;
+  common::Time start = common::Time::GetWallTime();
+  world->Step(steps);
+  common::Time wallTime = common::Time::GetWallTime() - start;
+
+  unsigned int spheres = 0;
+  for (const auto &model : world->Models())
+  {
+    if (model->IsStatic() || model->GetName().find("sphere") != 0)
+      continue;
+    ++spheres;
+    EXPECT_NEAR(0.1, model->WorldPose().Pos().Z(), 1e-2)
+        << model->GetName();
+  }
+  EXPECT_EQ(64u, spheres);
+
+  gzmsg << "space [" << spaceType << "], " << world->ModelCount()
+        << " models, " << steps << " steps [" << wallTime.Double()
+        << " s]\n";
+}
+
+INSTANTIATE_TEST_CASE_P(SpaceTypes, ODEBroadphaseTest,
+    ::testing::Values("hash", "sap", "quadtree", "simple"));
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ODEDeterministicThreadsTest
+  : public ServerFixture, public testing::WithParamInterface<const char*>
+{
+  /// \brief State of every link in the world.
+  public: typedef std::vector<double> State;
+
+  /// \brief Reset the world, set the island threads and step it.
+  /// \param[in] _world World to step.
+  /// \param[in] _threads Number of island threads.
+  /// \param[in] _steps Number of steps.
+  /// \return Pose and velocity of all links after _steps.
+  public: State Run(physics::WorldPtr _world, const int _threads,
+                    const unsigned int _steps);
+
+  /// \brief Check that deterministic island threads reproduce the serial
+  /// solver bit for bit.
+  /// \param[in] _worldFile World to load.
+  /// \param[in] _threads Number of island threads.
+  /// \param[in] _steps Number of steps to compare.
+  public: void MatchSerial(const std::string &_worldFile, const int _threads,
+                           const unsigned int _steps);
+};
+
+/////////////////////////////////////////////////
+ODEDeterministicThreadsTest::State ODEDeterministicThreadsTest::Run(
+    physics::WorldPtr _world, const int _threads, const unsigned int _steps)
+{
+  _world->Reset();
+  _world->Physics()->SetParam("island_threads", _threads);
+  _world->Step(_steps);
+
+  State state;
+  for (const auto &model : _world->Models())
+  {
+    for (const auto &link : model->GetLinks())
+    {
+      ignition::math::Pose3d pose = link->WorldPose();
+      ignition::math::Vector3d vel = link->WorldLinearVel();
+      ignition::math::Vector3d angVel = link->WorldAngularVel();
+      state.insert(state.end(), {pose.Pos().X(), pose.Pos().Y(),
+          pose.Pos().Z(), pose.Rot().W(), pose.Rot().X(), pose.Rot().Y(),
+          pose.Rot().Z(), vel.X(), vel.Y(), vel.Z(),
+          angVel.X(), angVel.Y(), angVel.Z()});
+    }
+  }
+  return state;
+}
+
+/////////////////////////////////////////////////
+void ODEDeterministicThreadsTest::MatchSerial(const std::string &_worldFile,
+    const int _threads, const unsigned int _steps)
+{
+  Load(_worldFile, true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  physics->SetParam("solver_type", std::string("quick"));
+  EXPECT_TRUE(physics->SetParam("deterministic_threads", true));
+
+  // The serial solver must be repeatable for the comparison to mean
+  // anything.
+  State serial = Run(world, 0, _steps);
+  ASSERT_FALSE(serial.empty());
+  ASSERT_EQ(serial, Run(world, 0, _steps));
+
+  // Compare exactly, not within a tolerance.
+  for (int i = 0; i < 3; ++i)
+  {
+    State threaded = Run(world, _threads, _steps);
+    ASSERT_EQ(serial.size(), threaded.size());
+    for (size_t j = 0; j < serial.size(); ++j)
+      EXPECT_EQ(serial[j], threaded[j]) << "run " << i << " value " << j;
+  }
+
+  // Threaded position correction solves differently from the serial
+  // solver, but must still give the same result on every run.
+  physics->SetParam("thread_position_correction", true);
+  State correction = Run(world, _threads, _steps);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_EQ(correction, Run(world, _threads, _steps)) << "run " << i;
+}
+
+/////////////////////////////////////////////////
+TEST_P(ODEDeterministicThreadsTest, MatchSerial)
+{
+  MatchSerial(GetParam(), 4, 500);
+}
+
+INSTANTIATE_TEST_CASE_P(Worlds, ODEDeterministicThreadsTest,
+    ::testing::Values("worlds/revolute_joint_test_with_large_gap.world",
+                      "worlds/dual_pr2.world"));
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
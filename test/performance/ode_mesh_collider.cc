@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include "gazebo/gazebo_config.h"
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ODEMeshColliderTest
+  : public ServerFixture, public testing::WithParamInterface<const char*>
+{
+};
+
+/////////////////////////////////////////////////
+/// Drop a grid of dense triangle mesh cubes on a triangle mesh floor with
+/// each ODE mesh collider, and report the time spent in the simulation
+/// loop. The cubes must come to rest on the floor with any collider.
+TEST_P(ODEMeshColliderTest, MeshPile)
+{
+  const std::string collider = GetParam();
+
+  Load("worlds/empty.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  ASSERT_EQ("ode", physics->GetType());
+  ASSERT_TRUE(physics->SetParam("mesh_collider", collider));
+  EXPECT_EQ(collider,
+      boost::any_cast<std::string>(physics->GetParam("mesh_collider")));
+
+  // The mesh is a 2 m cube with 13664 triangles
+  const std::string mesh = "file://media/models/cube_20k/meshes/cube_20k.stl";
+  SpawnTrimesh("floor", mesh, ignition::math::Vector3d(3, 3, 0.1),
+      ignition::math::Vector3d(0, 0, 0.9), ignition::math::Vector3d::Zero,
+      true);
+
+  const int side = 4;
+  for (int i = 0; i < side; ++i)
+  {
+    for (int j = 0; j < side; ++j)
+    {
+      SpawnTrimesh("cube_" + std::to_string(i * side + j), mesh,
+          ignition::math::Vector3d(0.1, 0.1, 0.1),
+          ignition::math::Vector3d(i * 0.5 - 0.75, j * 0.5 - 0.75, 1.3),
+          ignition::math::Vector3d::Zero);
+    }
+  }
+
+  const unsigned int steps = 1000;
+  common::Time start = common::Time::GetWallTime();
+  world->Step(steps);
+  common::Time wallTime = common::Time::GetWallTime() - start;
+
+  // The top of the floor is at 1 m
+  unsigned int cubes = 0;
+  for (const auto &model : world->Models())
+  {
+    if (model->GetName().find("cube_") != 0)
+      continue;
+    ++cubes;
+    EXPECT_NEAR(1.1, model->WorldPose().Pos().Z(), 2e-2)
+        << model->GetName();
+  }
+  EXPECT_EQ(static_cast<unsigned int>(side * side), cubes);
+
+  gzmsg << "mesh collider [" << collider << "], " << cubes
+        << " cubes, " << steps << " steps [" << wallTime.Double()
+        << " s]\n";
+}
+
+#ifdef HAVE_FCL
+INSTANTIATE_TEST_CASE_P(MeshColliders, ODEMeshColliderTest,
+    ::testing::Values("ode", "fcl"));
+#else
+INSTANTIATE_TEST_CASE_P(MeshColliders, ODEMeshColliderTest,
+    ::testing::Values("ode"));
+#endif
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/test/helper_physics_generator.hh"
+#include "RAMLibrary.hh"
+
+using namespace gazebo;
+
+/// \brief Number of steps timed for each scenario.
+static const unsigned int kBenchmarkSteps = 1000;
+
+/// \brief Number of steps run before timing, so that falling objects
+/// settle and the caches of the engines are warm.
+static const unsigned int kWarmupSteps = 100;
+
+typedef std::tuple<const char *, const char *> BenchmarkParam;
+
+/// \brief Physics throughput benchmarks. Each scenario loads a canonical
+/// world from test/worlds/physics_benchmark_<scenario>.world with each
+/// physics engine. The steps per second, the percentiles of the step time
+/// and the resident memory are printed as a JSON object on one line. When
+/// the GAZEBO_BENCHMARK_JSON environment variable is set, the line is also
+/// appended to the file it names, so that results can be compared across
+/// releases.
+class PhysicsBenchmark
+  : public ServerFixture, public testing::WithParamInterface<BenchmarkParam>
+{
+  /// \brief Load a scenario and time its steps.
+  /// \param[in] _engine Physics engine.
+  /// \param[in] _scenario Name of the scenario.
+  public: void Run(const std::string &_engine, const std::string &_scenario);
+};
+
+/////////////////////////////////////////////////
+/// \brief Get a percentile of sorted durations.
+/// \param[in] _sorted Durations sorted in increasing order.
+/// \param[in] _percentile Percentile in [0, 100].
+/// \return The duration.
+static double Percentile(const std::vector<double> &_sorted,
+    const double _percentile)
+{
+  if (_sorted.empty())
+    return 0.0;
+
+  size_t rank = static_cast<size_t>(
+      std::ceil(_percentile / 100.0 * _sorted.size()));
+  rank = std::min(std::max(rank, static_cast<size_t>(1)), _sorted.size());
+  return _sorted[rank - 1];
+}
+
+/////////////////////////////////////////////////
+void PhysicsBenchmark::Run(const std::string &_engine,
+    const std::string &_scenario)
+{
+  // Simbody has no triangle mesh or heightmap collisions
+  if (_engine == "simbody" &&
+      (_scenario == "mesh_rubble" || _scenario == "heightmap_vehicles"))
+  {
+    gzerr << "Aborting test for " << _engine << ", scenario [" << _scenario
+          << "] is not supported.\n";
+    return;
+  }
+
+  const uint64_t memoryBefore =
+    test::memory::GetProcessResidentMemory();
+
+  Load("worlds/physics_benchmark_" + _scenario + ".world", true, _engine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  ASSERT_EQ(_engine, physics->GetType());
+
+  // Populations are inserted on the first update
+  world->Step(1);
+  const unsigned int modelCount = world->ModelCount();
+  EXPECT_GT(modelCount, 1u);
+
+  // Robots drive along circles
+  std::vector<physics::JointPtr> leftWheels;
+  std::vector<physics::JointPtr> rightWheels;
+  for (auto const &model : world->Models())
+  {
+    physics::JointPtr left = model->GetJoint("left_wheel_joint");
+    physics::JointPtr right = model->GetJoint("right_wheel_joint");
+    if (left && right)
+    {
+      leftWheels.push_back(left);
+      rightWheels.push_back(right);
+    }
+  }
+  auto drive = [&]()
+  {
+    for (auto &joint : leftWheels)
+      joint->SetForce(0, 0.2);
+    for (auto &joint : rightWheels)
+      joint->SetForce(0, 0.15);
+  };
+
+  for (unsigned int i = 0; i < kWarmupSteps; ++i)
+  {
+    drive();
+    world->Step(1);
+  }
+
+  std::vector<double> stepTimes;
+  stepTimes.reserve(kBenchmarkSteps);
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < kBenchmarkSteps; ++i)
+  {
+    drive();
+    auto stepStart = std::chrono::steady_clock::now();
+    world->Step(1);
+    stepTimes.push_back(std::chrono::duration<double, std::micro>(
+          std::chrono::steady_clock::now() - stepStart).count());
+  }
+  const double wallTime = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  const uint64_t memoryAfter =
+    test::memory::GetProcessResidentMemory();
+
+  std::sort(stepTimes.begin(), stepTimes.end());
+  const double stepSize = physics->GetMaxStepSize();
+
+  std::ostringstream json;
+  json << "{\"engine\": \"" << _engine << "\""
+       << ", \"scenario\": \"" << _scenario << "\""
+       << ", \"models\": " << modelCount
+       << ", \"steps\": " << kBenchmarkSteps
+       << ", \"step_size\": " << stepSize
+       << ", \"wall_time\": " << wallTime
+       << ", \"steps_per_second\": " << kBenchmarkSteps / wallTime
+       << ", \"real_time_factor\": "
+       << kBenchmarkSteps * stepSize / wallTime
+       << ", \"step_time_us\": {"
+       << "\"p50\": " << Percentile(stepTimes, 50)
+       << ", \"p90\": " << Percentile(stepTimes, 90)
+       << ", \"p99\": " << Percentile(stepTimes, 99)
+       << ", \"max\": " << stepTimes.back() << "}"
+       << ", \"memory_kb\": {"
+       << "\"resident\": " << memoryAfter
+       << ", \"world\": "
+       << (memoryAfter > memoryBefore ? memoryAfter - memoryBefore : 0)
+       << "}}";
+
+  std::cout << json.str() << std::endl;
+
+  const char *output = std::getenv("GAZEBO_BENCHMARK_JSON");
+  if (output && output[0] != '\0')
+  {
+    std::ofstream file(output, std::ios::app);
+    EXPECT_TRUE(file.good()) << output;
+    file << json.str() << std::endl;
+  }
+
+  // Nothing may explode
+  for (auto const &model : world->Models())
+  {
+    EXPECT_FALSE(std::isnan(model->WorldPose().Pos().Z()))
+        << model->GetName();
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsBenchmark, Scenario)
+{
+  this->Run(std::get<0>(GetParam()), std::get<1>(GetParam()));
+}
+
+INSTANTIATE_TEST_CASE_P(PhysicsEngines, PhysicsBenchmark,
+    ::testing::Combine(PHYSICS_ENGINE_VALUES,
+    ::testing::Values("box_stacks", "diff_drive", "humanoids", "mesh_rubble",
+      "heightmap_vehicles")));
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,338 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/rendering/rendering.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Number of frames timed for each case.
+static const unsigned int kBenchmarkFrames = 100;
+
+/// \brief Number of frames rendered before timing, so that the shaders
+/// are compiled and the render targets allocated.
+static const unsigned int kWarmupFrames = 10;
+
+/// \brief Longest time to wait for the messages of one frame.
+static const double kFrameTimeout = 10.0;
+
+/// \brief Sensor type, image width and sensor count.
+typedef std::tuple<const char *, unsigned int, unsigned int> BenchmarkParam;
+
+/// \brief Records the arrival of the messages of a sensor.
+class SensorReceiver
+{
+  /// \brief Callback for the raw messages of the sensor.
+  /// \param[in] _data Serialized message.
+  public: void OnMsg(const std::string &/*_data*/)
+  {
+    this->received = std::chrono::steady_clock::now();
+    ++this->count;
+  }
+
+  /// \brief Subscriber to the topic of the sensor.
+  public: transport::SubscriberPtr sub;
+
+  /// \brief Sensor that publishes the messages.
+  public: sensors::SensorPtr sensor;
+
+  /// \brief Number of messages received.
+  public: std::atomic<unsigned int> count{0};
+
+  /// \brief Arrival time of the last message.
+  public: std::chrono::steady_clock::time_point received;
+};
+
+/// \brief Rendering sensor benchmarks. Each case spawns a number of
+/// sensors of one type around a field of static shapes, see
+/// test/worlds/sensor_benchmark.world. The world stays paused and is
+/// stepped once per frame; all sensors update at every sim time step, so
+/// each step renders exactly one frame per sensor. The frame rate, the
+/// latency between the step and the arrival of the messages, the render
+/// time and the readback and publish time of the sensors are printed as a
+/// JSON object on one line. When the GAZEBO_BENCHMARK_JSON environment
+/// variable is set, the line is also appended to the file it names.
+class SensorBenchmark
+  : public ServerFixture, public testing::WithParamInterface<BenchmarkParam>
+{
+  /// \brief Spawn the sensors and time their frames.
+  /// \param[in] _type Sensor type.
+  /// \param[in] _width Image width, or number of samples of a GPU ray
+  /// sensor.
+  /// \param[in] _count Number of sensors.
+  public: void Run(const std::string &_type, const unsigned int _width,
+              const unsigned int _count);
+
+  /// \brief Spawn one sensor.
+  /// \param[in] _type Sensor type.
+  /// \param[in] _name Name of the sensor.
+  /// \param[in] _pos Position of the sensor.
+  /// \param[in] _rpy Orientation of the sensor.
+  /// \param[in] _width Image width, or number of samples.
+  private: void Spawn(const std::string &_type, const std::string &_name,
+               const ignition::math::Vector3d &_pos,
+               const ignition::math::Vector3d &_rpy,
+               const unsigned int _width);
+};
+
+/////////////////////////////////////////////////
+/// \brief Get a percentile of sorted durations.
+/// \param[in] _sorted Durations sorted in increasing order.
+/// \param[in] _percentile Percentile in [0, 100].
+/// \return The duration.
+static double Percentile(const std::vector<double> &_sorted,
+    const double _percentile)
+{
+  if (_sorted.empty())
+    return 0.0;
+
+  size_t rank = static_cast<size_t>(
+      std::ceil(_percentile / 100.0 * _sorted.size()));
+  rank = std::min(std::max(rank, static_cast<size_t>(1)), _sorted.size());
+  return _sorted[rank - 1];
+}
+
+/////////////////////////////////////////////////
+/// \brief Print the percentiles of durations as a JSON object.
+/// \param[in] _durations Durations, sorted in place.
+/// \return The JSON object.
+static std::string Percentiles(std::vector<double> &_durations)
+{
+  std::sort(_durations.begin(), _durations.end());
+
+  std::ostringstream json;
+  json << "{\"p50\": " << Percentile(_durations, 50)
+       << ", \"p90\": " << Percentile(_durations, 90)
+       << ", \"p99\": " << Percentile(_durations, 99)
+       << ", \"max\": " << (_durations.empty() ? 0.0 : _durations.back())
+       << "}";
+  return json.str();
+}
+
+/////////////////////////////////////////////////
+void SensorBenchmark::Spawn(const std::string &_type,
+    const std::string &_name, const ignition::math::Vector3d &_pos,
+    const ignition::math::Vector3d &_rpy, const unsigned int _width)
+{
+  const std::string modelName = _name + "_model";
+  const unsigned int height = _width * 3 / 4;
+
+  if (_type == "camera")
+  {
+    SpawnCamera(modelName, _name, _pos, _rpy, _width, height, 0);
+  }
+  else if (_type == "depth")
+  {
+    SpawnDepthCameraSensor(modelName, _name, _pos, _rpy, _width, height, 0,
+        0.1, 20);
+  }
+  else if (_type == "gpu_ray")
+  {
+    SpawnGpuRaySensor(modelName, _name, _pos, _rpy, -1.5, 1.5, 0.1, 20,
+        0.01, _width);
+  }
+  else if (_type == "wide_angle")
+  {
+    SpawnWideAngleCamera(modelName, _name, _pos, _rpy, _width, height, 0,
+        M_PI);
+  }
+}
+
+/////////////////////////////////////////////////
+void SensorBenchmark::Run(const std::string &_type,
+    const unsigned int _width, const unsigned int _count)
+{
+  Load("worlds/sensor_benchmark.world", true);
+
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run sensor benchmark\n";
+    return;
+  }
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Populations are inserted on the first update
+  world->Step(1);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+
+  // A ring of sensors looking at the center of the field
+  std::vector<std::unique_ptr<SensorReceiver>> receivers;
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    const double angle = 2.0 * M_PI * i / _count;
+    const std::string name = _type + "_" + std::to_string(i);
+    this->Spawn(_type, name,
+        ignition::math::Vector3d(8 * cos(angle), 8 * sin(angle), 1.0),
+        ignition::math::Vector3d(0, 0.1, angle + M_PI), _width);
+
+    std::unique_ptr<SensorReceiver> receiver(new SensorReceiver);
+    receiver->sensor = sensors::get_sensor(name);
+    ASSERT_TRUE(receiver->sensor != nullptr) << name;
+    receiver->sub = node->Subscribe(receiver->sensor->Topic(),
+        &SensorReceiver::OnMsg, receiver.get());
+
+    sensors::CameraSensorPtr cameraSensor =
+        std::dynamic_pointer_cast<sensors::CameraSensor>(receiver->sensor);
+    if (cameraSensor && cameraSensor->Camera())
+      cameraSensor->Camera()->SetRenderStatsEnabled(true);
+    sensors::GpuRaySensorPtr raySensor =
+        std::dynamic_pointer_cast<sensors::GpuRaySensor>(receiver->sensor);
+    if (raySensor && raySensor->LaserCamera())
+      raySensor->LaserCamera()->SetRenderStatsEnabled(true);
+
+    receivers.push_back(std::move(receiver));
+  }
+
+  // Step once and wait for one message of every sensor.
+  // Returns the time spent stepping, or a negative value on timeout.
+  unsigned int expected = 0;
+  auto frame = [&]() -> std::chrono::steady_clock::time_point
+  {
+    for (auto &receiver : receivers)
+      expected = std::max(expected, receiver->count.load());
+    ++expected;
+
+    auto start = std::chrono::steady_clock::now();
+    world->Step(1);
+
+    for (auto &receiver : receivers)
+    {
+      while (receiver->count < expected)
+      {
+        if (std::chrono::duration<double>(
+              std::chrono::steady_clock::now() - start).count() >
+            kFrameTimeout)
+        {
+          return std::chrono::steady_clock::time_point();
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+    }
+    return start;
+  };
+
+  for (unsigned int i = 0; i < kWarmupFrames; ++i)
+  {
+    ASSERT_NE(std::chrono::steady_clock::time_point(), frame())
+        << "Sensors stopped publishing during warmup";
+  }
+
+  std::vector<double> latencies;
+  std::vector<double> renderTimes;
+  std::vector<double> updateTimes;
+  latencies.reserve(kBenchmarkFrames * _count);
+  renderTimes.reserve(kBenchmarkFrames * _count);
+  updateTimes.reserve(kBenchmarkFrames * _count);
+
+  auto benchmarkStart = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < kBenchmarkFrames; ++i)
+  {
+    auto start = frame();
+    ASSERT_NE(std::chrono::steady_clock::time_point(), start)
+        << "Sensors stopped publishing at frame " << i;
+
+    for (auto &receiver : receivers)
+    {
+      latencies.push_back(std::chrono::duration<double, std::micro>(
+            receiver->received - start).count());
+
+      // Readback of the render target and publication of the message
+      updateTimes.push_back(
+          receiver->sensor->LastUpdateDuration().Double() * 1e6);
+
+      rendering::CameraPtr camera;
+      sensors::CameraSensorPtr cameraSensor =
+          std::dynamic_pointer_cast<sensors::CameraSensor>(receiver->sensor);
+      if (cameraSensor)
+        camera = cameraSensor->Camera();
+      sensors::GpuRaySensorPtr raySensor =
+          std::dynamic_pointer_cast<sensors::GpuRaySensor>(receiver->sensor);
+      if (raySensor)
+        camera = raySensor->LaserCamera();
+      if (camera)
+        renderTimes.push_back(camera->RenderDuration().Double() * 1e6);
+    }
+  }
+  const double wallTime = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - benchmarkStart).count();
+
+  std::ostringstream json;
+  json << "{\"sensor\": \"" << _type << "\""
+       << ", \"width\": " << _width
+       << ", \"height\": " << (_type == "gpu_ray" ? 1 : _width * 3 / 4)
+       << ", \"sensors\": " << _count
+       << ", \"frames\": " << kBenchmarkFrames
+       << ", \"wall_time\": " << wallTime
+       << ", \"fps_per_sensor\": " << kBenchmarkFrames / wallTime
+       << ", \"fps_total\": " << kBenchmarkFrames * _count / wallTime
+       << ", \"latency_us\": " << Percentiles(latencies)
+       << ", \"render_time_us\": " << Percentiles(renderTimes)
+       << ", \"readback_publish_time_us\": " << Percentiles(updateTimes)
+       << "}";
+
+  std::cout << json.str() << std::endl;
+
+  const char *output = std::getenv("GAZEBO_BENCHMARK_JSON");
+  if (output && output[0] != '\0')
+  {
+    std::ofstream file(output, std::ios::app);
+    EXPECT_TRUE(file.good()) << output;
+    file << json.str() << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(SensorBenchmark, Frames)
+{
+  this->Run(std::get<0>(GetParam()), std::get<1>(GetParam()),
+      std::get<2>(GetParam()));
+}
+
+INSTANTIATE_TEST_CASE_P(Sensors, SensorBenchmark,
+    ::testing::Combine(
+    ::testing::Values("camera", "depth", "gpu_ray", "wide_angle"),
+    ::testing::Values(320u, 640u, 1280u),
+    ::testing::Values(1u, 4u, 16u, 64u)));
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
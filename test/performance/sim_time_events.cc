@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/sensors/SensorManager.hh"
+
+using namespace gazebo;
+
+class SimTimeEventsTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Time the world steps while a number of sim time events are
+/// pending, and print the cost of a step as a JSON object on one line.
+/// When the GAZEBO_BENCHMARK_JSON environment variable is set, the line is
+/// also appended to the file it names.
+/// \param[in] _world The world, paused.
+/// \param[in] _events Number of pending events.
+/// \param[in] _steps Number of steps over which the events expire.
+/// \return Wall time of a step, in microseconds.
+static double TimeSteps(physics::WorldPtr _world, const unsigned int _events,
+    const unsigned int _steps)
+{
+  sensors::SimTimeEventHandler handler;
+  boost::condition_variable condition;
+
+  // Spread the events over the steps, in a shuffled order
+  const double stepSize = _world->Physics()->GetMaxStepSize();
+  for (unsigned int i = 0; i < _events; ++i)
+  {
+    const unsigned int step = (i * 7919u) % _steps + 1;
+    handler.AddRelativeEvent(common::Time(stepSize * step), &condition,
+        _world->Name());
+  }
+  EXPECT_EQ(_events, handler.EventCount());
+
+  auto start = std::chrono::steady_clock::now();
+  _world->Step(_steps);
+  const double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  // One more step in case the sim time of the last step was rounded down
+  _world->Step(1);
+  EXPECT_EQ(0u, handler.EventCount());
+
+  const double stepUs = seconds / _steps * 1e6;
+  std::ostringstream json;
+  json << "{\"benchmark\": \"sim_time_events\""
+       << ", \"events\": " << _events
+       << ", \"steps\": " << _steps
+       << ", \"time_per_step_us\": " << stepUs
+       << "}";
+
+  std::cout << json.str() << std::endl;
+
+  const char *output = std::getenv("GAZEBO_BENCHMARK_JSON");
+  if (output && output[0] != '\0')
+  {
+    std::ofstream file(output, std::ios::app);
+    EXPECT_TRUE(file.good()) << output;
+    file << json.str() << std::endl;
+  }
+  return stepUs;
+}
+
+/////////////////////////////////////////////////
+TEST_F(SimTimeEventsTest, PendingEvents)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const unsigned int steps = 1000;
+  const double baseline = TimeSteps(world, 0, steps);
+
+  // With a heap, the cost of a step grows with the log of the number of
+  // pending events, not with the number itself
+  for (const unsigned int events : {10u, 100u, 1000u, 10000u, 100000u})
+  {
+    const double stepUs = TimeSteps(world, events, steps);
+    std::cout << events << " events add " << stepUs - baseline
+              << " us per step" << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class SimbodyParallelForcesTest : public ServerFixture
+{
+  /// \brief Reset the world, set the force threads and step it.
+  /// \param[in] _world World to step.
+  /// \param[in] _threads Number of force threads.
+  /// \param[in] _steps Number of steps.
+  /// \param[out] _wallTime Time spent stepping.
+  /// \return Position of all links after _steps.
+  public: std::vector<ignition::math::Vector3d> Run(physics::WorldPtr _world,
+              const int _threads, const unsigned int _steps,
+              common::Time &_wallTime);
+};
+
+/////////////////////////////////////////////////
+std::vector<ignition::math::Vector3d> SimbodyParallelForcesTest::Run(
+    physics::WorldPtr _world, const int _threads, const unsigned int _steps,
+    common::Time &_wallTime)
+{
+  _world->Reset();
+  EXPECT_TRUE(_world->Physics()->SetParam("parallel_force_threads",
+      _threads));
+
+  common::Time start = common::Time::GetWallTime();
+  _world->Step(_steps);
+  _wallTime = common::Time::GetWallTime() - start;
+
+  std::vector<ignition::math::Vector3d> positions;
+  for (const auto &model : _world->Models())
+  {
+    for (const auto &link : model->GetLinks())
+      positions.push_back(link->WorldPose().Pos());
+  }
+  return positions;
+}
+
+/////////////////////////////////////////////////
+/// Compare the serial and the parallel force evaluation on a pile of
+/// resting boxes. The parallel sum of forces may round differently, so the
+/// poses only need to agree closely.
+TEST_F(SimbodyParallelForcesTest, ContactPile)
+{
+  Load("worlds/simbody_contact_pile.world", true, "simbody");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  ASSERT_EQ("simbody", physics->GetType());
+  EXPECT_EQ(1, boost::any_cast<int>(physics->GetParam(
+      "parallel_force_threads")));
+  EXPECT_FALSE(physics->SetParam("parallel_force_threads", 0));
+
+  const unsigned int steps = 2000;
+  common::Time serialTime;
+  std::vector<ignition::math::Vector3d> serial =
+      Run(world, 1, steps, serialTime);
+  ASSERT_FALSE(serial.empty());
+
+  common::Time parallelTime;
+  std::vector<ignition::math::Vector3d> parallel =
+      Run(world, 4, steps, parallelTime);
+  ASSERT_EQ(serial.size(), parallel.size());
+  EXPECT_EQ(4, boost::any_cast<int>(physics->GetParam(
+      "parallel_force_threads")));
+
+  for (size_t i = 0; i < serial.size(); ++i)
+  {
+    EXPECT_NEAR(serial[i].X(), parallel[i].X(), 1e-6) << "link " << i;
+    EXPECT_NEAR(serial[i].Y(), parallel[i].Y(), 1e-6) << "link " << i;
+    EXPECT_NEAR(serial[i].Z(), parallel[i].Z(), 1e-6) << "link " << i;
+  }
+
+  gzmsg << steps << " steps, serial forces [" << serialTime.Double()
+        << " s], parallel forces [" << parallelTime.Double() << " s]\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
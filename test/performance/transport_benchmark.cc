@@ -0,0 +1,857 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <dirent.h>
+#include <limits.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/transport/ShmTransport.hh"
+#include "RAMLibrary.hh"
+
+using namespace gazebo;
+
+/// \brief Topic of the throughput benchmark.
+static const char kDataTopic[] = "~/benchmark/data";
+
+/// \brief Topic of the latency requests.
+static const char kPingTopic[] = "~/benchmark/ping";
+
+/// \brief Topic of the latency replies.
+static const char kPongTopic[] = "~/benchmark/pong";
+
+/// \brief Longest time to wait for a client or a message, in ms.
+static const int kTimeout = 30000;
+
+/// \brief GAZEBO_SHM_THRESHOLD of the shared memory cases, in bytes. The
+/// message sizes of these cases are above it.
+static const char kShmThreshold[] = "65536";
+
+/// \brief Message size, publisher count, subscriber count and whether the
+/// subscribers run in other processes.
+typedef std::tuple<unsigned int, unsigned int, unsigned int, bool>
+  ThroughputParam;
+
+/// \brief Message size, publisher count and subscriber count.
+typedef std::tuple<unsigned int, unsigned int, unsigned int>
+  ShmThroughputParam;
+
+/// \brief Message size and whether the echo runs in another process.
+typedef std::tuple<unsigned int, bool> LatencyParam;
+
+/// \brief Where the subscribers or the echo run, and how messages reach
+/// them.
+enum class TransportMode
+{
+  /// \brief In this process.
+  LOCAL,
+
+  /// \brief In child processes, over TCP.
+  REMOTE,
+
+  /// \brief In child processes, through the shared memory transport.
+  SHM
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the name of a mode in the results.
+/// \param[in] _mode The mode.
+/// \return Name of the mode.
+static const char *ModeName(const TransportMode _mode)
+{
+  switch (_mode)
+  {
+    case TransportMode::REMOTE:
+      return "remote";
+    case TransportMode::SHM:
+      return "shm";
+    default:
+      return "local";
+  }
+}
+
+/// \brief Enables the shared memory transport while it exists. The
+/// environment is inherited by the clients, which then request shared
+/// memory from this process, and this process from them.
+class ShmEnvironment
+{
+  /// \brief Constructor.
+  /// \param[in] _enable False to leave the environment unchanged.
+  public: explicit ShmEnvironment(const bool _enable)
+          : enabled(_enable)
+  {
+    if (!this->enabled)
+      return;
+
+    this->Save("GAZEBO_SHM_TRANSPORT", this->transport);
+    this->Save("GAZEBO_SHM_THRESHOLD", this->threshold);
+    setenv("GAZEBO_SHM_TRANSPORT", "1", 1);
+    setenv("GAZEBO_SHM_THRESHOLD", kShmThreshold, 1);
+  }
+
+  /// \brief Destructor, restores the environment.
+  public: ~ShmEnvironment()
+  {
+    if (!this->enabled)
+      return;
+
+    this->Restore("GAZEBO_SHM_TRANSPORT", this->transport);
+    this->Restore("GAZEBO_SHM_THRESHOLD", this->threshold);
+  }
+
+  /// \brief Save a variable.
+  /// \param[in] _name Name of the variable.
+  /// \param[out] _value Value, null if not set.
+  private: void Save(const char *_name, std::unique_ptr<std::string> &_value)
+  {
+    const char *value = std::getenv(_name);
+    if (value)
+      _value.reset(new std::string(value));
+  }
+
+  /// \brief Restore a variable.
+  /// \param[in] _name Name of the variable.
+  /// \param[in] _value Saved value, null if it was not set.
+  private: void Restore(const char *_name,
+               const std::unique_ptr<std::string> &_value)
+  {
+    if (_value)
+      setenv(_name, _value->c_str(), 1);
+    else
+      unsetenv(_name);
+  }
+
+  /// \brief True if the environment was changed.
+  private: bool enabled;
+
+  /// \brief Saved GAZEBO_SHM_TRANSPORT.
+  private: std::unique_ptr<std::string> transport;
+
+  /// \brief Saved GAZEBO_SHM_THRESHOLD.
+  private: std::unique_ptr<std::string> threshold;
+};
+
+/// \brief Counts the messages received by a subscriber.
+class MessageCounter
+{
+  /// \brief Callback for the messages.
+  /// \param[in] _msg The message.
+  public: void OnMsg(ConstImagePtr &/*_msg*/)
+  {
+    ++this->count;
+  }
+
+  /// \brief Number of messages received.
+  public: std::atomic<unsigned int> count{0};
+};
+
+/// \brief Sends back every message it receives.
+class MessageEcho
+{
+  /// \brief Callback for the requests.
+  /// \param[in] _msg The request.
+  public: void OnMsg(ConstImagePtr &_msg)
+  {
+    this->pub->Publish(*_msg);
+    ++this->count;
+  }
+
+  /// \brief Publisher of the replies.
+  public: transport::PublisherPtr pub;
+
+  /// \brief Number of messages sent back.
+  public: std::atomic<unsigned int> count{0};
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the number of messages sent for a message size, so that
+/// each case moves a comparable amount of data.
+/// \param[in] _size Message size in bytes.
+/// \return Number of messages.
+static unsigned int MessageCount(const unsigned int _size)
+{
+  const unsigned int count = (64u << 20) / std::max(_size, 1u);
+  return std::min(std::max(count, 10u), 2000u);
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a message with a payload.
+/// \param[in] _size Size of the payload in bytes.
+/// \return The message.
+static msgs::Image PayloadMessage(const unsigned int _size)
+{
+  msgs::Image msg;
+  msg.set_width(_size);
+  msg.set_height(1);
+  msg.set_pixel_format(0);
+  msg.set_step(_size);
+  msg.set_data(std::string(_size, 'x'));
+  return msg;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the CPU time used by this process or its waited children.
+/// \param[in] _who RUSAGE_SELF or RUSAGE_CHILDREN.
+/// \return User and system time in seconds.
+static double CpuTime(const int _who)
+{
+  struct rusage usage;
+  if (getrusage(_who, &usage) != 0)
+    return 0.0;
+
+  return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6 +
+      usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get a percentile of sorted durations.
+/// \param[in] _sorted Durations sorted in increasing order.
+/// \param[in] _percentile Percentile in [0, 100].
+/// \return The duration.
+static double Percentile(const std::vector<double> &_sorted,
+    const double _percentile)
+{
+  if (_sorted.empty())
+    return 0.0;
+
+  size_t rank = static_cast<size_t>(
+      std::ceil(_percentile / 100.0 * _sorted.size()));
+  rank = std::min(std::max(rank, static_cast<size_t>(1)), _sorted.size());
+  return _sorted[rank - 1];
+}
+
+/////////////////////////////////////////////////
+/// \brief Print a result line, and append it to the file named by the
+/// GAZEBO_BENCHMARK_JSON environment variable if set.
+/// \param[in] _json JSON object on one line.
+static void Report(const std::string &_json)
+{
+  std::cout << _json << std::endl;
+
+  const char *output = std::getenv("GAZEBO_BENCHMARK_JSON");
+  if (output && output[0] != '\0')
+  {
+    std::ofstream file(output, std::ios::app);
+    EXPECT_TRUE(file.good()) << output;
+    file << _json << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Count the shared memory segments created by a process.
+/// \param[in] _pid Process id of the publisher.
+/// \return Number of segments in /dev/shm.
+static unsigned int ShmSegmentCount(const pid_t _pid)
+{
+  const std::string prefix = "gz_shm_" + std::to_string(_pid) + "_";
+  unsigned int count = 0;
+  DIR *dir = opendir("/dev/shm");
+  if (!dir)
+    return 0;
+
+  while (struct dirent *entry = readdir(dir))
+  {
+    if (std::string(entry->d_name).compare(0, prefix.size(), prefix) == 0)
+      ++count;
+  }
+  closedir(dir);
+  return count;
+}
+
+/////////////////////////////////////////////////
+/// \brief Run this executable as a transport client in a child process.
+/// The client writes one byte to a pipe once ready and one once done.
+/// \param[in] _args Arguments of the client.
+/// \param[out] _fd Read end of the pipe.
+/// \return Process id of the client, or -1 on error.
+static pid_t SpawnClient(const std::vector<std::string> &_args, int &_fd)
+{
+  char exe[PATH_MAX];
+  const ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+  if (len <= 0)
+    return -1;
+  exe[len] = '\0';
+
+  int fds[2];
+  if (pipe(fds) != 0)
+    return -1;
+
+  std::vector<std::string> args(_args);
+  args.push_back(std::to_string(fds[1]));
+
+  const pid_t pid = fork();
+  if (pid == 0)
+  {
+    close(fds[0]);
+    std::vector<char *> argv;
+    argv.push_back(exe);
+    for (auto &arg : args)
+      argv.push_back(&arg[0]);
+    argv.push_back(nullptr);
+    execv(exe, argv.data());
+    _exit(127);
+  }
+
+  close(fds[1]);
+  if (pid < 0)
+  {
+    close(fds[0]);
+    return -1;
+  }
+
+  _fd = fds[0];
+  return pid;
+}
+
+/////////////////////////////////////////////////
+/// \brief Wait for a byte written by a client.
+/// \param[in] _fd Read end of the pipe of the client.
+/// \param[out] _byte The byte, if not null.
+/// \return True if the byte was read before the timeout.
+static bool WaitForClient(const int _fd, char *_byte = nullptr)
+{
+  struct pollfd pfd = {_fd, POLLIN, 0};
+  if (poll(&pfd, 1, kTimeout) <= 0)
+    return false;
+
+  char byte;
+  if (read(_fd, &byte, 1) != 1)
+    return false;
+
+  if (_byte)
+    *_byte = byte;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the byte a client writes once done. With the shared memory
+/// transport, 's' tells that the segments of the publishers were found
+/// while the client was still connected, since they are removed with the
+/// connections.
+/// \param[in] _pids Process ids of the publishers to the client.
+/// \return 's' or 'd'.
+static char DoneByte(const std::vector<pid_t> &_pids)
+{
+  if (!transport::ShmRequested())
+    return 'd';
+
+  for (auto pid : _pids)
+  {
+    if (ShmSegmentCount(pid) == 0)
+      return 'd';
+  }
+  return 's';
+}
+
+/////////////////////////////////////////////////
+/// \brief Wait for the clients to exit, kill them on timeout.
+/// \param[in] _pids Process ids of the clients.
+/// \param[in] _fds Pipes of the clients.
+static void ReapClients(const std::vector<pid_t> &_pids,
+    const std::vector<int> &_fds)
+{
+  for (auto fd : _fds)
+    close(fd);
+
+  for (auto pid : _pids)
+  {
+    int status = 0;
+    int waited = 0;
+    while (waitpid(pid, &status, WNOHANG) == 0)
+    {
+      if (++waited > kTimeout)
+      {
+        kill(pid, SIGKILL);
+        waitpid(pid, &status, 0);
+        break;
+      }
+      common::Time::MSleep(1);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Client that counts the messages of the data topic.
+/// \param[in] _expected Number of messages to receive before exiting.
+/// \param[in] _fd Write end of the pipe.
+/// \return Exit code.
+static int RunSink(const unsigned int _expected, const int _fd)
+{
+  if (!transport::init())
+    return 1;
+  transport::run();
+
+  {
+    transport::NodePtr node(new transport::Node());
+    node->Init("default");
+
+    MessageCounter counter;
+    transport::SubscriberPtr sub = node->Subscribe(kDataTopic,
+        &MessageCounter::OnMsg, &counter);
+
+    if (write(_fd, "r", 1) != 1)
+      return 1;
+
+    // Give up if the messages stop coming, e.g. when the benchmark failed
+    unsigned int last = 0;
+    int stalled = 0;
+    while (counter.count < _expected)
+    {
+      if (counter.count != last)
+      {
+        last = counter.count;
+        stalled = 0;
+      }
+      else if (++stalled > kTimeout)
+        return 1;
+      common::Time::MSleep(1);
+    }
+
+    const char done = DoneByte({getppid()});
+    if (write(_fd, &done, 1) != 1)
+      return 1;
+  }
+
+  transport::fini();
+  return 0;
+}
+
+/////////////////////////////////////////////////
+/// \brief Client that sends back the requests of the ping topic.
+/// \param[in] _expected Number of requests to answer before exiting.
+/// \param[in] _fd Write end of the pipe.
+/// \return Exit code.
+static int RunEcho(const unsigned int _expected, const int _fd)
+{
+  if (!transport::init())
+    return 1;
+  transport::run();
+
+  {
+    transport::NodePtr node(new transport::Node());
+    node->Init("default");
+
+    MessageEcho echo;
+    echo.pub = node->Advertise<msgs::Image>(kPongTopic);
+    transport::SubscriberPtr sub = node->Subscribe(kPingTopic,
+        &MessageEcho::OnMsg, &echo);
+
+    if (!echo.pub->WaitForConnection(common::Time(kTimeout / 1000, 0)))
+      return 1;
+
+    if (write(_fd, "r", 1) != 1)
+      return 1;
+
+    // Give up if the messages stop coming, e.g. when the benchmark failed
+    unsigned int last = 0;
+    int stalled = 0;
+    while (echo.count < _expected)
+    {
+      if (echo.count != last)
+      {
+        last = echo.count;
+        stalled = 0;
+      }
+      else if (++stalled > kTimeout)
+        return 1;
+      common::Time::MSleep(1);
+    }
+
+    // Let the last reply leave
+    common::Time::MSleep(100);
+
+    // The requests come through the segments of the benchmark, the
+    // replies go through the ones of this process
+    const char done = DoneByte({getppid(), getpid()});
+    if (write(_fd, &done, 1) != 1)
+      return 1;
+  }
+
+  transport::fini();
+  return 0;
+}
+
+/// \brief Transport benchmarks. The throughput cases publish a payload
+/// from one or more publisher threads to one or more subscribers, which
+/// live either in this process or in child processes connected through
+/// the master. The latency cases time round trips to an echo. The
+/// shared memory cases run the child processes with GAZEBO_SHM_TRANSPORT
+/// set, and are reported with the "shm" mode next to the "remote" TCP
+/// results. The results, including the CPU time spent per delivered
+/// message by all the processes involved, are printed as JSON objects on
+/// one line. When the GAZEBO_BENCHMARK_JSON environment variable is set,
+/// the lines are also appended to the file it names.
+class TransportBenchmark : public ServerFixture
+{
+  /// \brief Publish messages to subscribers and report the throughput.
+  /// \param[in] _size Message size in bytes.
+  /// \param[in] _pubCount Number of publisher threads.
+  /// \param[in] _subCount Number of subscribers.
+  /// \param[in] _mode Where the subscribers run.
+  protected: void Throughput(const unsigned int _size,
+                 const unsigned int _pubCount, const unsigned int _subCount,
+                 const TransportMode _mode);
+
+  /// \brief Time round trips to an echo and report the latency.
+  /// \param[in] _size Message size in bytes.
+  /// \param[in] _mode Where the echo runs.
+  protected: void Latency(const unsigned int _size,
+                 const TransportMode _mode);
+};
+
+/// \brief Throughput benchmark.
+class TransportThroughput : public TransportBenchmark,
+  public testing::WithParamInterface<ThroughputParam>
+{
+};
+
+/// \brief Throughput benchmark of the shared memory transport.
+class TransportShmThroughput : public TransportBenchmark,
+  public testing::WithParamInterface<ShmThroughputParam>
+{
+};
+
+/// \brief Latency benchmark.
+class TransportLatency : public TransportBenchmark,
+  public testing::WithParamInterface<LatencyParam>
+{
+};
+
+/// \brief Latency benchmark of the shared memory transport.
+class TransportShmLatency : public TransportBenchmark,
+  public testing::WithParamInterface<unsigned int>
+{
+};
+
+/////////////////////////////////////////////////
+void TransportBenchmark::Throughput(const unsigned int _size,
+    const unsigned int _pubCount, const unsigned int _subCount,
+    const TransportMode _mode)
+{
+  const bool remote = _mode != TransportMode::LOCAL;
+  const bool shm = _mode == TransportMode::SHM;
+  const unsigned int msgCount = MessageCount(_size);
+
+  // Each publisher holds its queue, each remote connection a copy
+  const unsigned int requiredMB = static_cast<unsigned int>(
+      (static_cast<uint64_t>(_size) * msgCount * _pubCount * 3) >> 20);
+  if (!test::memory::IsMemoryAvailable(requiredMB))
+  {
+    gzdbg << "Skipped test since " << requiredMB <<
+              "Mb of RAM were not available \n";
+    SUCCEED();
+    return;
+  }
+
+  Load("worlds/empty.world");
+  ShmEnvironment shmEnvironment(shm);
+
+  const unsigned int expected = _pubCount * msgCount;
+
+  std::vector<transport::NodePtr> nodes;
+  std::vector<transport::PublisherPtr> pubs;
+  for (unsigned int i = 0; i < _pubCount; ++i)
+  {
+    nodes.push_back(transport::NodePtr(new transport::Node()));
+    nodes.back()->Init("default");
+    pubs.push_back(nodes.back()->Advertise<msgs::Image>(kDataTopic,
+          msgCount + 1));
+  }
+
+  std::vector<std::unique_ptr<MessageCounter>> counters;
+  std::vector<transport::SubscriberPtr> subs;
+  std::vector<pid_t> pids;
+  std::vector<int> fds;
+  for (unsigned int i = 0; i < _subCount; ++i)
+  {
+    if (remote)
+    {
+      int fd = -1;
+      pid_t pid = SpawnClient(
+          {"--transport-sink", std::to_string(expected)}, fd);
+      ASSERT_GT(pid, 0);
+      pids.push_back(pid);
+      fds.push_back(fd);
+      ASSERT_TRUE(WaitForClient(fd)) << "Sink " << i << " did not start";
+    }
+    else
+    {
+      counters.push_back(
+          std::unique_ptr<MessageCounter>(new MessageCounter));
+      nodes.push_back(transport::NodePtr(new transport::Node()));
+      nodes.back()->Init("default");
+      subs.push_back(nodes.back()->Subscribe(kDataTopic,
+            &MessageCounter::OnMsg, counters.back().get()));
+    }
+  }
+
+  // Wait until every subscriber is connected
+  for (auto &pub : pubs)
+  {
+    int waited = 0;
+    while ((remote ? pub->GetRemoteSubscriptionCount() < _subCount
+                   : !pub->HasConnections()) && waited++ < kTimeout)
+    {
+      common::Time::MSleep(1);
+    }
+    ASSERT_LT(waited, kTimeout) << "Subscribers did not connect";
+  }
+
+  const msgs::Image msg = PayloadMessage(_size);
+  const double cpuStart = CpuTime(RUSAGE_SELF);
+  const double childCpuStart = CpuTime(RUSAGE_CHILDREN);
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (auto &pub : pubs)
+  {
+    threads.push_back(std::thread([&pub, &msg, msgCount]()
+    {
+      for (unsigned int i = 0; i < msgCount; ++i)
+        pub->Publish(msg);
+    }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  bool complete = true;
+  if (remote)
+  {
+    for (auto fd : fds)
+    {
+      char done = 0;
+      complete = WaitForClient(fd, &done) && complete;
+      if (shm)
+        EXPECT_EQ('s', done) << "Messages were not sent through shared memory";
+    }
+  }
+  else
+  {
+    for (auto &counter : counters)
+    {
+      int waited = 0;
+      while (counter->count < expected && waited++ < kTimeout * 10)
+        common::Time::NSleep(100000);
+      complete = counter->count >= expected && complete;
+    }
+  }
+  const double wallTime = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  const double cpuTime = CpuTime(RUSAGE_SELF) - cpuStart;
+
+  ReapClients(pids, fds);
+  const double childCpuTime = CpuTime(RUSAGE_CHILDREN) - childCpuStart;
+
+  EXPECT_TRUE(complete) << "Messages were lost";
+
+  const double delivered = static_cast<double>(expected) * _subCount;
+  std::ostringstream json;
+  json << "{\"benchmark\": \"throughput\""
+       << ", \"mode\": \"" << ModeName(_mode) << "\""
+       << ", \"message_bytes\": " << _size
+       << ", \"publishers\": " << _pubCount
+       << ", \"subscribers\": " << _subCount
+       << ", \"messages\": " << delivered
+       << ", \"wall_time\": " << wallTime
+       << ", \"messages_per_second\": " << delivered / wallTime
+       << ", \"megabytes_per_second\": "
+       << delivered * _size / wallTime / (1 << 20)
+       << ", \"cpu_per_message_us\": "
+       << (cpuTime + childCpuTime) / delivered * 1e6
+       << "}";
+  Report(json.str());
+}
+
+/////////////////////////////////////////////////
+void TransportBenchmark::Latency(const unsigned int _size,
+    const TransportMode _mode)
+{
+  const bool remote = _mode != TransportMode::LOCAL;
+  const bool shm = _mode == TransportMode::SHM;
+  const unsigned int roundTrips = std::min(MessageCount(_size), 1000u);
+
+  Load("worlds/empty.world");
+  ShmEnvironment shmEnvironment(shm);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init("default");
+
+  transport::PublisherPtr ping =
+    node->Advertise<msgs::Image>(kPingTopic, roundTrips + 1);
+  MessageCounter replies;
+  transport::SubscriberPtr pongSub = node->Subscribe(kPongTopic,
+      &MessageCounter::OnMsg, &replies);
+
+  std::vector<pid_t> pids;
+  std::vector<int> fds;
+  MessageEcho echo;
+  transport::SubscriberPtr pingSub;
+  if (remote)
+  {
+    int fd = -1;
+    pid_t pid = SpawnClient(
+        {"--transport-echo", std::to_string(roundTrips)}, fd);
+    ASSERT_GT(pid, 0);
+    pids.push_back(pid);
+    fds.push_back(fd);
+    ASSERT_TRUE(WaitForClient(fd)) << "Echo did not start";
+  }
+  else
+  {
+    echo.pub = node->Advertise<msgs::Image>(kPongTopic, roundTrips + 1);
+    pingSub = node->Subscribe(kPingTopic, &MessageEcho::OnMsg, &echo);
+  }
+  ASSERT_TRUE(ping->WaitForConnection(common::Time(kTimeout / 1000, 0)));
+
+  const msgs::Image msg = PayloadMessage(_size);
+  std::vector<double> times;
+  times.reserve(roundTrips);
+
+  const double cpuStart = CpuTime(RUSAGE_SELF);
+  const double childCpuStart = CpuTime(RUSAGE_CHILDREN);
+  for (unsigned int i = 0; i < roundTrips; ++i)
+  {
+    auto start = std::chrono::steady_clock::now();
+    ping->Publish(msg);
+    while (replies.count <= i &&
+        std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start).count() < kTimeout)
+    {
+      std::this_thread::yield();
+    }
+    ASSERT_GT(replies.count, i) << "No reply to request " << i;
+    times.push_back(std::chrono::duration<double, std::micro>(
+          std::chrono::steady_clock::now() - start).count());
+  }
+  const double cpuTime = CpuTime(RUSAGE_SELF) - cpuStart;
+
+  if (remote)
+  {
+    char done = 0;
+    EXPECT_TRUE(WaitForClient(fds[0], &done));
+    if (shm)
+      EXPECT_EQ('s', done) << "Messages were not sent through shared memory";
+  }
+  ReapClients(pids, fds);
+  const double childCpuTime = CpuTime(RUSAGE_CHILDREN) - childCpuStart;
+
+  std::sort(times.begin(), times.end());
+  std::ostringstream json;
+  json << "{\"benchmark\": \"latency\""
+       << ", \"mode\": \"" << ModeName(_mode) << "\""
+       << ", \"message_bytes\": " << _size
+       << ", \"round_trips\": " << roundTrips
+       << ", \"round_trip_us\": {"
+       << "\"p50\": " << Percentile(times, 50)
+       << ", \"p90\": " << Percentile(times, 90)
+       << ", \"p99\": " << Percentile(times, 99)
+       << ", \"max\": " << times.back() << "}"
+       << ", \"cpu_per_message_us\": "
+       << (cpuTime + childCpuTime) / (2.0 * roundTrips) * 1e6
+       << "}";
+  Report(json.str());
+}
+
+/////////////////////////////////////////////////
+TEST_P(TransportThroughput, Publish)
+{
+  this->Throughput(std::get<0>(GetParam()), std::get<1>(GetParam()),
+      std::get<2>(GetParam()), std::get<3>(GetParam()) ?
+      TransportMode::REMOTE : TransportMode::LOCAL);
+}
+
+/////////////////////////////////////////////////
+TEST_P(TransportShmThroughput, Publish)
+{
+  this->Throughput(std::get<0>(GetParam()), std::get<1>(GetParam()),
+      std::get<2>(GetParam()), TransportMode::SHM);
+}
+
+/////////////////////////////////////////////////
+TEST_P(TransportLatency, RoundTrip)
+{
+  this->Latency(std::get<0>(GetParam()), std::get<1>(GetParam()) ?
+      TransportMode::REMOTE : TransportMode::LOCAL);
+}
+
+/////////////////////////////////////////////////
+TEST_P(TransportShmLatency, RoundTrip)
+{
+  this->Latency(GetParam(), TransportMode::SHM);
+}
+
+/////////////////////////////////////////////////
+INSTANTIATE_TEST_CASE_P(MessageSizes, TransportThroughput,
+    ::testing::Combine(
+    ::testing::Values(64u, 1024u, 65536u, 1048576u, 8388608u),
+    ::testing::Values(1u, 4u),
+    ::testing::Values(1u, 4u),
+    ::testing::Bool()));
+
+INSTANTIATE_TEST_CASE_P(MessageSizes, TransportLatency,
+    ::testing::Combine(
+    ::testing::Values(64u, 1024u, 65536u, 1048576u, 8388608u),
+    ::testing::Bool()));
+
+// Sizes above kShmThreshold, comparable to the remote TCP cases
+INSTANTIATE_TEST_CASE_P(MessageSizes, TransportShmThroughput,
+    ::testing::Combine(
+    ::testing::Values(1048576u, 8388608u),
+    ::testing::Values(1u, 4u),
+    ::testing::Values(1u, 4u)));
+
+INSTANTIATE_TEST_CASE_P(MessageSizes, TransportShmLatency,
+    ::testing::Values(1048576u, 8388608u));
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  // Child processes of the remote cases
+  if (argc == 4)
+  {
+    const std::string mode = argv[1];
+    const unsigned int expected = std::stoul(argv[2]);
+    const int fd = std::stoi(argv[3]);
+    if (mode == "--transport-sink")
+      return RunSink(expected, fd);
+    if (mode == "--transport-echo")
+      return RunEcho(expected, fd);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <string>
+#include <tuple>
+
+#include "gazebo/common/Timer.hh"
+#include "gazebo/rendering/WideAngleCamera.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class WideAngleCameraFacesTest : public ServerFixture,
+  public ::testing::WithParamInterface<std::tuple<std::string, double>>
+{
+  /// \brief Count the frames of a camera.
+  public: void OnNewFrame(const unsigned char * /*_image*/,
+              unsigned int /*_width*/, unsigned int /*_height*/,
+              unsigned int /*_depth*/, const std::string &/*_format*/)
+  {
+    ++this->frames;
+  }
+
+  /// \brief Number of frames received.
+  public: std::atomic<unsigned int> frames{0};
+};
+
+/////////////////////////////////////////////////
+/// Compare the frame rate of a wide angle camera that renders the six faces
+/// of its cube map with one that only renders the faces its lens samples.
+TEST_P(WideAngleCameraFacesTest, FrameRate)
+{
+  const std::string lensType = std::get<0>(GetParam());
+  const double hfov = std::get<1>(GetParam());
+
+  Load("worlds/shapes.world");
+
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run wide angle camera test\n";
+    return;
+  }
+
+  const std::string cameraName = "camera_sensor";
+  SpawnWideAngleCamera("camera_model", cameraName,
+      ignition::math::Vector3d(-5, 0, 1), ignition::math::Vector3d::Zero,
+      640, 480, 0, hfov, lensType, true, IGN_PI, 512);
+
+  sensors::WideAngleCameraSensorPtr sensor =
+      std::dynamic_pointer_cast<sensors::WideAngleCameraSensor>(
+      sensors::get_sensor(cameraName));
+  ASSERT_TRUE(sensor != nullptr);
+  rendering::WideAngleCameraPtr camera =
+      boost::dynamic_pointer_cast<rendering::WideAngleCamera>(
+      sensor->Camera());
+  ASSERT_TRUE(camera != nullptr);
+
+  event::ConnectionPtr connection = camera->ConnectNewImageFrame(
+      std::bind(&WideAngleCameraFacesTest::OnNewFrame, this,
+        std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+        std::placeholders::_4, std::placeholders::_5));
+
+  double fps[2];
+  unsigned int skipped[2];
+  for (int culling = 0; culling < 2; ++culling)
+  {
+    camera->SetFaceCulling(culling == 1);
+
+    // Let the setting reach a frame
+    common::Time::MSleep(200);
+
+    this->frames = 0;
+    common::Timer timer;
+    timer.Start();
+    common::Time::MSleep(3000);
+    fps[culling] = this->frames / timer.GetElapsed().Double();
+    skipped[culling] = camera->SkippedFaceCount();
+  }
+
+  EXPECT_EQ(0u, skipped[0]);
+  if (hfov <= IGN_DTOR(120))
+    EXPECT_GT(skipped[1], 0u);
+
+  gzmsg << lensType << " lens, hfov [" << IGN_RTOD(hfov)
+        << "] fps: six faces [" << fps[0] << "], culled faces [" << fps[1]
+        << "], skipped faces [" << skipped[1] << "]\n";
+}
+
+INSTANTIATE_TEST_CASE_P(Lenses, WideAngleCameraFacesTest, ::testing::Values(
+    std::make_tuple("gnomonical", IGN_DTOR(90)),
+    std::make_tuple("stereographic", IGN_DTOR(120)),
+    std::make_tuple("equidistant", IGN_DTOR(120)),
+    std::make_tuple("equisolid_angle", IGN_DTOR(180)),
+    std::make_tuple("equidistant", IGN_DTOR(360))));
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
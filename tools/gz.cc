@@ -217,7 +217,14 @@ WorldCommand::WorldCommand()
      "Step simulation mulitple iteration.")
     ("reset-all,r", "Reset time and model poses")
     ("reset-time,t", "Reset time")
-    ("reset-models,o", "Reset models");
+    ("reset-models,o", "Reset models")
+    ("trace", po::value<std::string>()->implicit_value(""),
+     "Capture the profiler zones to a Chrome trace file on the server, by "
+     "default under the traces directory of its log path.")
+    ("trace-duration", po::value<double>(),
+     "Duration of the trace capture (seconds), 0 to capture until "
+     "--trace-stop. Default 10.")
+    ("trace-stop", "Stop the trace capture and write its file.");
 }
 
 /////////////////////////////////////////////////
@@ -284,6 +291,29 @@ bool WorldCommand::RunImpl()
     good = true;
   }
 
+  if (this->vm.count("trace") || this->vm.count("trace-stop"))
+  {
+    msgs::Request *request;
+    if (this->vm.count("trace-stop"))
+      request = msgs::CreateRequest("trace_stop");
+    else
+    {
+      request = msgs::CreateRequest("trace_start",
+          this->vm["trace"].as<std::string>());
+      if (this->vm.count("trace-duration"))
+        request->set_dbl_data(this->vm["trace-duration"].as<double>());
+    }
+
+    transport::PublisherPtr requestPub =
+      node->Advertise<msgs::Request>("~/request");
+    requestPub->WaitForConnection();
+    requestPub->Publish(*request, true);
+    delete request;
+
+    if (!good)
+      return true;
+  }
+
   if (good)
     pub->Publish(msg, true);
   else
@@ -901,7 +931,12 @@ StatsCommand::StatsCommand()
     ("world-name,w", po::value<std::string>(), "World name.")
     ("duration,d", po::value<uint64_t>(), "Duration (seconds) to run.")
     ("plot,p", "Output comma-separated values, useful for processing and "
-     "plotting.");
+     "plotting.")
+    ("timing,t", "Print the durations of the world update stages and of "
+     "the sensor updates instead.")
+    ("memory,m", "Print the memory held by each subsystem instead.")
+    ("plugins", "Print the time spent by each plugin in the callbacks of "
+     "each event instead, from the most to the least.");
 }
 
 /////////////////////////////////////////////////
@@ -911,6 +946,14 @@ void StatsCommand::HelpDetailed()
     "\tPrint gzserver statics to standard out. If a name for the world, \n"
     "\toption -w, is not specified, the first world found on \n"
     "\tthe Gazebo master will be used.\n"
+    "\tWith option -t, the percentiles of the duration of each stage\n"
+    "\tof the world update are printed every second.\n"
+    "\tWith option -m, the memory held by the meshes, contacts,\n"
+    "\ttransport queues, log buffers and camera images is printed\n"
+    "\tevery second.\n"
+    "\tWith option --plugins, the time spent by each plugin instance in\n"
+    "\tthe callbacks of each event is ranked every second. Callbacks are\n"
+    "\tonly timed while a client asks for them.\n"
     << std::endl;
 }
 
@@ -925,8 +968,15 @@ bool StatsCommand::RunImpl()
   transport::NodePtr node(new transport::Node());
   node->Init(worldName);
 
-  transport::SubscriberPtr sub =
-    node->Subscribe("~/world_stats", &StatsCommand::CB, this);
+  transport::SubscriberPtr sub;
+  if (this->vm.count("timing"))
+    sub = node->Subscribe("~/timing_stats", &StatsCommand::TimingCB, this);
+  else if (this->vm.count("memory"))
+    sub = node->Subscribe("~/memory_stats", &StatsCommand::MemoryCB, this);
+  else if (this->vm.count("plugins"))
+    sub = node->Subscribe("~/plugin_stats", &StatsCommand::PluginsCB, this);
+  else
+    sub = node->Subscribe("~/world_stats", &StatsCommand::CB, this);
 
   boost::mutex::scoped_lock lock(this->sigMutex);
   if (this->vm.count("duration"))
@@ -1003,6 +1053,154 @@ void StatsCommand::CB(ConstWorldStatisticsPtr &_msg)
         percent, simTime.Double(), realTime.Double(), paused);
 }
 
+/////////////////////////////////////////////////
+void StatsCommand::TimingCB(ConstTimingStatisticsPtr &_msg)
+{
+  GZ_ASSERT(_msg, "Invalid message received");
+
+  if (this->vm.count("plot"))
+  {
+    static bool first = true;
+    if (first)
+    {
+      std::cout << "# simtime (sec), stage, samples, mean (ms), p50 (ms), "
+        << "p90 (ms), p99 (ms), max (ms)\n";
+      first = false;
+    }
+  }
+  else
+  {
+    printf("SimTime[%4.2f] Interval[%4.2f]\n",
+        msgs::Convert(_msg->sim_time()).Double(), _msg->interval());
+    printf("  %-44s %8s %9s %9s %9s %9s %9s\n", "Stage", "Samples",
+        "Mean(ms)", "P50(ms)", "P90(ms)", "P99(ms)", "Max(ms)");
+  }
+
+  for (auto const &stage : _msg->stage())
+  {
+    if (stage.interval_count() == 0)
+      continue;
+
+    if (this->vm.count("plot"))
+    {
+      printf("%16.6f, %s, %llu, %f, %f, %f, %f, %f\n",
+          msgs::Convert(_msg->sim_time()).Double(), stage.name().c_str(),
+          static_cast<unsigned long long>(stage.interval_count()),
+          stage.mean() * 1e3, stage.p50() * 1e3, stage.p90() * 1e3,
+          stage.p99() * 1e3, stage.max() * 1e3);
+    }
+    else
+    {
+      printf("  %-44s %8llu %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+          stage.name().c_str(),
+          static_cast<unsigned long long>(stage.interval_count()),
+          stage.mean() * 1e3, stage.p50() * 1e3, stage.p90() * 1e3,
+          stage.p99() * 1e3, stage.max() * 1e3);
+    }
+  }
+  fflush(stdout);
+}
+
+/////////////////////////////////////////////////
+void StatsCommand::MemoryCB(ConstMemoryStatisticsPtr &_msg)
+{
+  GZ_ASSERT(_msg, "Invalid message received");
+
+  const double simTime = msgs::Convert(_msg->sim_time()).Double();
+  const double mb = 1.0 / (1024.0 * 1024.0);
+
+  if (this->vm.count("plot"))
+  {
+    static bool first = true;
+    if (first)
+    {
+      std::cout << "# simtime (sec), tag, bytes, peak bytes, objects\n";
+      first = false;
+    }
+    printf("%16.6f, resident, %llu, 0, 0\n", simTime,
+        static_cast<unsigned long long>(_msg->resident_bytes()));
+  }
+  else
+  {
+    printf("SimTime[%4.2f] Resident[%.1f MB]\n", simTime,
+        _msg->resident_bytes() * mb);
+    printf("  %-32s %12s %12s %10s\n", "Tag", "Size(MB)", "Peak(MB)",
+        "Objects");
+  }
+
+  for (auto const &tag : _msg->tag())
+  {
+    if (this->vm.count("plot"))
+    {
+      printf("%16.6f, %s, %lld, %lld, %lld\n", simTime, tag.name().c_str(),
+          static_cast<long long>(tag.bytes()),
+          static_cast<long long>(tag.peak_bytes()),
+          static_cast<long long>(tag.objects()));
+    }
+    else
+    {
+      printf("  %-32s %12.3f %12.3f %10lld\n", tag.name().c_str(),
+          tag.bytes() * mb, tag.peak_bytes() * mb,
+          static_cast<long long>(tag.objects()));
+    }
+  }
+  fflush(stdout);
+}
+
+/////////////////////////////////////////////////
+void StatsCommand::PluginsCB(ConstPluginStatisticsPtr &_msg)
+{
+  GZ_ASSERT(_msg, "Invalid message received");
+
+  const double simTime = msgs::Convert(_msg->sim_time()).Double();
+
+  if (this->vm.count("plot"))
+  {
+    static bool first = true;
+    if (first)
+    {
+      std::cout << "# simtime (sec), filename, name, event, calls, "
+        << "time (ms), total calls, total time (sec)\n";
+      first = false;
+    }
+  }
+  else
+  {
+    printf("SimTime[%4.2f] Interval[%4.2f]\n", simTime, _msg->interval());
+    printf("  %-24s %-24s %-20s %8s %9s %6s %9s\n", "Plugin", "Instance",
+        "Event", "Calls", "Time(ms)", "Load%", "Total(s)");
+  }
+
+  // The callbacks are ranked by the server
+  for (auto const &callback : _msg->callback())
+  {
+    if (callback.interval_count() == 0)
+      continue;
+
+    if (this->vm.count("plot"))
+    {
+      printf("%16.6f, %s, %s, %s, %llu, %f, %llu, %f\n", simTime,
+          callback.filename().c_str(), callback.name().c_str(),
+          callback.event().c_str(),
+          static_cast<unsigned long long>(callback.interval_count()),
+          callback.interval_total() * 1e3,
+          static_cast<unsigned long long>(callback.count()),
+          callback.total());
+    }
+    else
+    {
+      const double load = _msg->interval() > 0 ?
+        100.0 * callback.interval_total() / _msg->interval() : 0.0;
+      printf("  %-24s %-24s %-20s %8llu %9.3f %6.2f %9.3f\n",
+          callback.filename().c_str(), callback.name().c_str(),
+          callback.event().empty() ? "-" : callback.event().c_str(),
+          static_cast<unsigned long long>(callback.interval_count()),
+          callback.interval_total() * 1e3, load, callback.total());
+    }
+  }
+  fflush(stdout);
+}
+
 /////////////////////////////////////////////////
 SDFCommand::SDFCommand()
   : Command("sdf",
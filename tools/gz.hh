@@ -195,6 +195,18 @@ namespace gazebo
     /// \param[in] _msg World statistics message.
     private: void CB(ConstWorldStatisticsPtr &_msg);
 
+    /// \brief Timing statistics callback.
+    /// \param[in] _msg Timing statistics message.
+    private: void TimingCB(ConstTimingStatisticsPtr &_msg);
+
+    /// \brief Memory statistics callback.
+    /// \param[in] _msg Memory statistics message.
+    private: void MemoryCB(ConstMemoryStatisticsPtr &_msg);
+
+    /// \brief Plugin statistics callback.
+    /// \param[in] _msg Plugin statistics message.
+    private: void PluginsCB(ConstPluginStatisticsPtr &_msg);
+
     /// \brief Sim time buffer
     private: std::list<common::Time> simTimes;
 
@@ -14,7 +14,19 @@
  * limitations under the License.
  *
 */
+#include <tinyxml.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <boost/algorithm/string.hpp>
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/date_time/posix_time/posix_time_io.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
@@ -32,6 +44,219 @@ sdf::ElementPtr g_stateSdf;
 
 using namespace gazebo;
 
+/////////////////////////////////////////////////
+/// \brief Writes 1-D float64 arrays to an uncompressed NumPy .npz file,
+/// which is a zip archive of .npy files.
+class NpzWriter
+{
+  /// \brief Constructor.
+  /// \param[in] _filename Name of the file to create.
+  public: explicit NpzWriter(const std::string &_filename)
+          : file(_filename, std::ios::out | std::ios::binary)
+  {
+  }
+
+  /// \brief Destructor, writes the zip directory.
+  public: ~NpzWriter()
+  {
+    this->Close();
+  }
+
+  /// \brief Get whether the file could be created.
+  /// \return True if the file is open.
+  public: bool IsOpen() const
+  {
+    return this->file.is_open();
+  }
+
+  /// \brief Add an array to the file.
+  /// \param[in] _name Name of the array.
+  /// \param[in] _values Values of the array.
+  public: void Write(const std::string &_name,
+              const std::vector<double> &_values)
+  {
+    // The header must be padded so that the data is aligned.
+    const uint16_t one = 1;
+    const bool little = *reinterpret_cast<const char *>(&one) == 1;
+    std::string header = std::string("{'descr': '") + (little ? "<" : ">") +
+      "f8', 'fortran_order': False, 'shape': (" +
+      std::to_string(_values.size()) + ",), }";
+    header.append(63 - (10 + header.size()) % 64, ' ');
+    header += '\n';
+
+    std::string npy("\x93NUMPY\x01\x00", 8);
+    this->Append(static_cast<uint16_t>(header.size()), npy);
+    npy += header;
+    npy.append(reinterpret_cast<const char *>(_values.data()),
+        _values.size() * sizeof(double));
+
+    boost::crc_32_type crc;
+    crc.process_bytes(npy.data(), npy.size());
+
+    Entry entry;
+    entry.name = _name + ".npy";
+    entry.crc = crc.checksum();
+    entry.size = static_cast<uint32_t>(npy.size());
+    entry.offset = static_cast<uint32_t>(this->file.tellp());
+
+    // Local file header, the data is stored without compression.
+    std::string local;
+    this->Append(static_cast<uint32_t>(0x04034b50), local);
+    this->AppendEntry(entry, local);
+    local += entry.name;
+
+    this->file.write(local.data(), local.size());
+    this->file.write(npy.data(), npy.size());
+    this->entries.push_back(entry);
+  }
+
+  /// \brief Write the zip directory and close the file.
+  public: void Close()
+  {
+    if (!this->file.is_open())
+      return;
+
+    const uint32_t offset = static_cast<uint32_t>(this->file.tellp());
+    std::string directory;
+    for (const auto &entry : this->entries)
+    {
+      this->Append(static_cast<uint32_t>(0x02014b50), directory);
+      // Version made by
+      this->Append(static_cast<uint16_t>(20), directory);
+      this->AppendEntry(entry, directory);
+      // Comment length, disk number, internal and external attributes.
+      this->Append(static_cast<uint16_t>(0), directory);
+      this->Append(static_cast<uint16_t>(0), directory);
+      this->Append(static_cast<uint16_t>(0), directory);
+      this->Append(static_cast<uint32_t>(0), directory);
+      this->Append(entry.offset, directory);
+      directory += entry.name;
+    }
+
+    // End of central directory record.
+    const uint32_t size = static_cast<uint32_t>(directory.size());
+    const uint16_t count = static_cast<uint16_t>(this->entries.size());
+    this->Append(static_cast<uint32_t>(0x06054b50), directory);
+    this->Append(static_cast<uint16_t>(0), directory);
+    this->Append(static_cast<uint16_t>(0), directory);
+    this->Append(count, directory);
+    this->Append(count, directory);
+    this->Append(size, directory);
+    this->Append(offset, directory);
+    this->Append(static_cast<uint16_t>(0), directory);
+
+    this->file.write(directory.data(), directory.size());
+    this->file.close();
+  }
+
+  /// \brief An array stored in the file.
+  private: struct Entry
+  {
+    /// \brief Name of the file in the archive.
+    std::string name;
+
+    /// \brief CRC-32 of the data.
+    uint32_t crc;
+
+    /// \brief Size of the data.
+    uint32_t size;
+
+    /// \brief Offset of the local file header.
+    uint32_t offset;
+  };
+
+  /// \brief Append a little endian integer to a buffer.
+  /// \param[in] _value Value to append.
+  /// \param[in,out] _buffer Buffer to append to.
+  private: template<typename T>
+           static void Append(T _value, std::string &_buffer)
+  {
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+      _buffer += static_cast<char>(_value & 0xff);
+      _value = static_cast<T>(_value >> 8);
+    }
+  }
+
+  /// \brief Append the fields shared by the local file header and the
+  /// central directory to a buffer.
+  /// \param[in] _entry Entry to write.
+  /// \param[in,out] _buffer Buffer to append to.
+  private: static void AppendEntry(const Entry &_entry, std::string &_buffer)
+  {
+    // Version needed, flags, compression method, time and date (1980-01-01).
+    Append(static_cast<uint16_t>(20), _buffer);
+    Append(static_cast<uint16_t>(0), _buffer);
+    Append(static_cast<uint16_t>(0), _buffer);
+    Append(static_cast<uint16_t>(0), _buffer);
+    Append(static_cast<uint16_t>(0x21), _buffer);
+    Append(_entry.crc, _buffer);
+    Append(_entry.size, _buffer);
+    Append(_entry.size, _buffer);
+    Append(static_cast<uint16_t>(_entry.name.size()), _buffer);
+    // Extra field length
+    Append(static_cast<uint16_t>(0), _buffer);
+  }
+
+  /// \brief Output file.
+  private: std::ofstream file;
+
+  /// \brief Arrays written so far.
+  private: std::vector<Entry> entries;
+};
+
+/////////////////////////////////////////////////
+/// \brief Values of the exported columns of a state.
+typedef std::vector<std::pair<std::string, double>> ExportRow;
+
+/////////////////////////////////////////////////
+/// \brief Add the columns of a pose to an exported row.
+/// \param[in] _prefix Prefix of the column names.
+/// \param[in] _pose Pose to export.
+/// \param[in,out] _row Row to complete.
+static void exportPose(const std::string &_prefix,
+    const ignition::math::Pose3d &_pose, ExportRow &_row)
+{
+  const ignition::math::Vector3d rpy = _pose.Rot().Euler();
+  _row.emplace_back(_prefix + ".x", _pose.Pos().X());
+  _row.emplace_back(_prefix + ".y", _pose.Pos().Y());
+  _row.emplace_back(_prefix + ".z", _pose.Pos().Z());
+  _row.emplace_back(_prefix + ".roll", rpy.X());
+  _row.emplace_back(_prefix + ".pitch", rpy.Y());
+  _row.emplace_back(_prefix + ".yaw", rpy.Z());
+}
+
+/////////////////////////////////////////////////
+/// \brief Add the columns of a model, its links, joints and nested models
+/// to an exported row.
+/// \param[in] _name Scoped name of the model.
+/// \param[in] _state State of the model.
+/// \param[in,out] _row Row to complete.
+static void exportModel(const std::string &_name,
+    const gazebo::physics::ModelState &_state, ExportRow &_row)
+{
+  exportPose(_name + ".pose", _state.Pose(), _row);
+
+  for (const auto &link : _state.GetLinkStates())
+  {
+    const std::string prefix = _name + "::" + link.first;
+    exportPose(prefix + ".pose", link.second.Pose(), _row);
+    exportPose(prefix + ".velocity", link.second.Velocity(), _row);
+    exportPose(prefix + ".acceleration", link.second.Acceleration(), _row);
+    exportPose(prefix + ".wrench", link.second.Wrench(), _row);
+  }
+
+  for (const auto &joint : _state.GetJointStates())
+  {
+    const std::string prefix = _name + "::" + joint.first + ".position.";
+    for (unsigned int i = 0; i < joint.second.GetAngleCount(); ++i)
+      _row.emplace_back(prefix + std::to_string(i), joint.second.Position(i));
+  }
+
+  for (const auto &model : _state.NestedModelStates())
+    exportModel(_name + "::" + model.first, model.second, _row);
+}
+
 /////////////////////////////////////////////////
 FilterBase::FilterBase(bool _xmlOutput, const std::string &_stamp)
 : xmlOutput(_xmlOutput), stamp(_stamp)
@@ -522,6 +747,68 @@ std::string ModelFilter::Filter(gazebo::physics::WorldState &_state)
   return result.str();
 }
 
+/////////////////////////////////////////////////
+/// \brief Remove the children of an XML element whose name does not match
+/// a filter pattern.
+/// \param[in] _elem Parent element.
+/// \param[in] _tag Tag of the children to check.
+/// \param[in] _pattern Name pattern, where '*' matches any string. All the
+/// children are removed if the pattern is empty.
+static void project(TiXmlElement *_elem, const std::string &_tag,
+    const std::string &_pattern)
+{
+  std::string regexStr = _pattern;
+  boost::replace_all(regexStr, "*", ".*");
+  boost::regex regex(regexStr);
+
+  TiXmlElement *child = _elem->FirstChildElement(_tag);
+  while (child)
+  {
+    TiXmlElement *next = child->NextSiblingElement(_tag);
+
+    const char *name = child->Attribute("name");
+    if (_pattern.empty() ||
+        !boost::regex_match(std::string(name ? name : ""), regex))
+    {
+      _elem->RemoveChild(child);
+    }
+
+    child = next;
+  }
+}
+
+/////////////////////////////////////////////////
+void ModelFilter::Project(TiXmlElement *_state) const
+{
+  if (this->parts.empty() || this->parts.front().empty())
+    project(_state, "model", "*");
+  else
+    project(_state, "model", this->parts.front());
+
+  // Lights are never output.
+  project(_state, "light", "");
+
+  // The whole state of the models is output.
+  if (!this->linkFilter && !this->jointFilter && this->parts.size() <= 1)
+    return;
+
+  // Otherwise only the model parts and the filtered links and joints are
+  // output.
+  for (TiXmlElement *modelXml = _state->FirstChildElement("model");
+       modelXml; modelXml = modelXml->NextSiblingElement("model"))
+  {
+    std::string linkPattern, jointPattern;
+    if (this->linkFilter && !this->linkFilter->parts.empty())
+      linkPattern = this->linkFilter->parts.front();
+    if (this->jointFilter && !this->jointFilter->parts.empty())
+      jointPattern = this->jointFilter->parts.front();
+
+    project(modelXml, "link", linkPattern);
+    project(modelXml, "joint", jointPattern);
+    project(modelXml, "model", "");
+  }
+}
+
 /////////////////////////////////////////////////
 StateFilter::StateFilter(bool _xmlOutput, const std::string &_stamp,
               double _hz)
@@ -533,6 +820,7 @@ StateFilter::StateFilter(bool _xmlOutput, const std::string &_stamp,
 void StateFilter::Init(const std::string &_filter)
 {
   this->filter.Init(_filter);
+  this->project = !_filter.empty() && _filter != "*";
 }
 
 /////////////////////////////////////////////////
@@ -541,31 +829,70 @@ std::string StateFilter::Filter(const std::string &_stateString)
   gazebo::physics::WorldState state;
 
   // Read and parse the state information
-  g_stateSdf->Clear();
-  sdf::readString(_stateString, g_stateSdf);
-  state.Load(g_stateSdf);
+  this->Load(_stateString, g_stateSdf, state);
 
-  std::ostringstream result;
+  if (!this->Accept(state.GetSimTime()))
+    return std::string();
 
-  if (this->hz > 0.0 && this->prevTime != gazebo::common::Time::Zero)
+  return this->Format(state);
+}
+
+/////////////////////////////////////////////////
+void StateFilter::Load(const std::string &_stateString,
+    sdf::ElementPtr _sdf, gazebo::physics::WorldState &_state) const
+{
+  std::string projected;
+  if (this->project)
   {
-    if ((state.GetSimTime() - this->prevTime).Double() <
-        1.0 / this->hz)
+    TiXmlDocument doc;
+    doc.Parse(_stateString.c_str());
+
+    TiXmlElement *sdfXml = doc.FirstChildElement("sdf");
+    TiXmlElement *stateXml =
+      sdfXml ? sdfXml->FirstChildElement("state") : nullptr;
+    if (!doc.Error() && stateXml)
     {
-      return result.str();
+      this->filter.Project(stateXml);
+
+      TiXmlPrinter printer;
+      doc.Accept(&printer);
+      projected = printer.Str();
     }
   }
 
+  _sdf->Clear();
+  sdf::readString(projected.empty() ? _stateString : projected, _sdf);
+  _state.Load(_sdf);
+}
+
+/////////////////////////////////////////////////
+bool StateFilter::Accept(const gazebo::common::Time &_simTime)
+{
+  if (this->hz > 0.0 && this->prevTime != gazebo::common::Time::Zero)
+  {
+    if ((_simTime - this->prevTime).Double() < 1.0 / this->hz)
+      return false;
+  }
+
+  this->prevTime = _simTime;
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string StateFilter::Format(gazebo::physics::WorldState &_state)
+{
+  std::ostringstream result;
+
   if (this->xmlOutput)
   {
     result << "<sdf version='" << SDF_VERSION << "'>\n"
-      << "<state world_name='" << state.GetName() << "'>\n"
-      << "<sim_time>" << state.GetSimTime() << "</sim_time>\n"
-      << "<real_time>" << state.GetRealTime() << "</real_time>\n"
-      << "<wall_time>" << state.GetWallTime() << "</wall_time>\n"
-      << "<iterations>" << state.GetIterations() << "</iterations>\n";
+      << "<state world_name='" << _state.GetName() << "'>\n"
+      << "<sim_time>" << _state.GetSimTime() << "</sim_time>\n"
+      << "<real_time>" << _state.GetRealTime() << "</real_time>\n"
+      << "<wall_time>" << _state.GetWallTime() << "</wall_time>\n"
+      << "<iterations>" << _state.GetIterations() << "</iterations>\n";
 
-    auto insertions = state.Insertions();
+    auto insertions = _state.Insertions();
     if (insertions.size() > 0)
       result << "<insertions>" << std::endl;
     for (auto insertion : insertions)
@@ -573,7 +900,7 @@ std::string StateFilter::Filter(const std::string &_stateString)
     if (insertions.size() > 0)
       result << "</insertions>" << std::endl;
 
-    auto deletions = state.Deletions();
+    auto deletions = _state.Deletions();
     if (deletions.size() > 0)
       result << "<deletions>" << std::endl;
     for (auto deletion : deletions)
@@ -582,12 +909,11 @@ std::string StateFilter::Filter(const std::string &_stateString)
       result << "</deletions>" << std::endl;
   }
 
-  result << this->filter.Filter(state);
+  result << this->filter.Filter(_state);
 
   if (this->xmlOutput)
     result << "</state></sdf>\n";
 
-  this->prevTime = state.GetSimTime();
   return result.str();
 }
 
@@ -622,7 +948,12 @@ LogCommand::LogCommand()
      "Valid in conjunction with the output command. See also the "
      "--output argument.")
     ("filter", po::value<std::string>(),
-     "Filter output. Valid only with the echo, step, and output commands");
+     "Filter output. Valid only with the echo, step, and output commands")
+    ("export", po::value<std::string>(),
+     "Export the model, link and joint states selected by the filter to "
+     "the output file as columnar arrays, one column per field, indexed by "
+     "sim_time. Valid values are (npz). Rows are split into files named "
+     "<output stem>_00000.npz, <output stem>_00001.npz...");
 }
 
 /////////////////////////////////////////////////
@@ -692,7 +1023,19 @@ bool LogCommand::RunImpl()
   g_stateSdf.reset(new sdf::Element);
   sdf::initFile("state.sdf", g_stateSdf);
 
-  if (this->vm.count("output"))
+  if (this->vm.count("output") && this->vm.count("export"))
+  {
+    const std::string format = this->vm["export"].as<std::string>();
+    if (format != "npz")
+    {
+      std::cerr << "Invalid export format[" << format << "]. "
+        << "Use one of: npz.\n";
+      return false;
+    }
+
+    this->Export(this->vm["output"].as<std::string>(), filter, hz);
+  }
+  else if (this->vm.count("output"))
   {
     std::string encoding = this->vm.count("encoding") ?
       this->vm["encoding"].as<std::string>() : "";
@@ -817,6 +1160,99 @@ void LogCommand::Info(const std::string &_filename)
     << "\n";
 }
 
+/////////////////////////////////////////////////
+template<typename T>
+void LogCommand::FilterLog(StateFilter &_filter,
+    const std::function<void (const std::string &)> &_world,
+    const std::function<T (gazebo::physics::WorldState &)> &_convert,
+    const std::function<void (T &)> &_output)
+{
+  gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
+
+  const std::string startFrame = "<sdf ";
+  const std::string endFrame = "</sdf>";
+
+  /// \brief A state that has been converted, but not rate limited yet.
+  struct FilteredState
+  {
+    /// \brief Simulation time of the state.
+    gazebo::common::Time simTime;
+
+    /// \brief Converted state.
+    T value;
+  };
+
+  // Only a few chunks per thread are kept in memory.
+  const unsigned int batchSize =
+    std::max(1u, std::thread::hardware_concurrency()) * 4u;
+  const unsigned int chunkCount = play->ChunkCount();
+
+  for (unsigned int first = 0; first < chunkCount; first += batchSize)
+  {
+    const unsigned int count = std::min(batchSize, chunkCount - first);
+    std::vector<std::vector<FilteredState>> states(count);
+    std::string world;
+
+    bool result = play->DecodeChunks(first, count,
+        [&](const unsigned int _index, const std::string &_data)
+        {
+          // Each chunk is parsed into its own element.
+          sdf::ElementPtr stateSdf = g_stateSdf->Clone();
+          std::vector<FilteredState> &chunkStates = states[_index - first];
+
+          // The first frame of the log is the world description.
+          const size_t worldFrame =
+            _index == 0 ? _data.find(startFrame) : std::string::npos;
+
+          size_t end = 0;
+          while (true)
+          {
+            const size_t from = _data.find(startFrame, end);
+            const size_t to = from == std::string::npos ?
+              std::string::npos : _data.find(endFrame, from);
+            if (to == std::string::npos)
+              break;
+
+            end = to + endFrame.size();
+
+            if (from == worldFrame)
+            {
+              world = _data.substr(from, end - from);
+              continue;
+            }
+
+            gazebo::physics::WorldState state;
+            _filter.Load(_data.substr(from, end - from), stateSdf, state);
+
+            FilteredState filtered;
+            filtered.simTime = state.GetSimTime();
+            filtered.value = _convert(state);
+            chunkStates.push_back(std::move(filtered));
+          }
+        });
+
+    if (!result)
+    {
+      std::cerr << "Unable to read chunks [" << first << ", "
+        << first + count << ") of the log file.\n";
+      return;
+    }
+
+    if (!world.empty() && _world)
+      _world(world);
+
+    // The Hz rate depends on the previous output state, apply it in order.
+    for (auto &chunkStates : states)
+    {
+      for (auto &state : chunkStates)
+      {
+        if (_filter.Accept(state.simTime))
+          _output(state.value);
+      }
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 void LogCommand::Output(const std::string &_outFilename,
     const std::string &_filter, const bool _raw,
@@ -838,7 +1274,7 @@ void LogCommand::Output(const std::string &_outFilename,
     return;
   }
 
-  std::string stateString, bufferString;
+  std::string bufferString;
 
   std::string encoding = _encoding.empty() ? play->Encoding() : _encoding;
   if (encoding != "txt" && encoding != "zlib" && encoding != "bz2")
@@ -860,25 +1296,29 @@ void LogCommand::Output(const std::string &_outFilename,
   filter.Init(_filter);
 
   unsigned int i = 0;
-  while (play->Step(stateString))
-  {
-    if (i == 0 && !_raw)
-    {
-      this->OutputWriter(outFile, stateString, _raw, encoding);
-    }
-    else
-    {
-      bufferString += filter.Filter(stateString);
-
-      if (i%1000 == 0 && !bufferString.empty())
+  this->FilterLog<std::string>(filter,
+      [&](const std::string &_world)
       {
-        this->OutputWriter(outFile, bufferString, _raw, encoding);
-        bufferString.clear();
-      }
-    }
+        if (!_raw)
+          this->OutputWriter(outFile, _world, _raw, encoding);
+      },
+      [&](gazebo::physics::WorldState &_state)
+      {
+        return filter.Format(_state);
+      },
+      [&](std::string &_stateString)
+      {
+        if (_stateString.empty())
+          return;
 
-    ++i;
-  }
+        bufferString += _stateString;
+
+        if (++i % 1000 == 0)
+        {
+          this->OutputWriter(outFile, bufferString, _raw, encoding);
+          bufferString.clear();
+        }
+      });
 
   if (!bufferString.empty())
     this->OutputWriter(outFile, bufferString, _raw, encoding);
@@ -897,7 +1337,6 @@ void LogCommand::Echo(const std::string &_filter, bool _raw,
     const std::string &_stamp, double _hz)
 {
   gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
-  std::string stateString;
 
   // Output the header
   if (!_raw)
@@ -906,32 +1345,132 @@ void LogCommand::Echo(const std::string &_filter, bool _raw,
   StateFilter filter(!_raw, _stamp, _hz);
   filter.Init(_filter);
 
-  unsigned int i = 0;
-  while (play->Step(stateString))
+  auto print = [&](const std::string &_stateString)
   {
-    if (i > 0)
-      stateString = filter.Filter(stateString);
-    else if (i == 0 && _raw)
-      stateString.clear();
+    if (_stateString.empty())
+      return;
 
-    if (!stateString.empty())
-    {
-      if (!_raw)
-        std::cout << "<chunk encoding='txt'><![CDATA[\n";
+    if (!_raw)
+      std::cout << "<chunk encoding='txt'><![CDATA[\n";
 
-      std::cout << stateString;
+    std::cout << _stateString;
 
-      if (!_raw)
-        std::cout << "]]></chunk>\n";
-    }
+    if (!_raw)
+      std::cout << "]]></chunk>\n";
+  };
 
-    ++i;
-  }
+  this->FilterLog<std::string>(filter,
+      [&](const std::string &_world)
+      {
+        if (!_raw)
+          print(_world);
+      },
+      [&](gazebo::physics::WorldState &_state)
+      {
+        return filter.Format(_state);
+      },
+      print);
 
   if (!_raw)
     std::cout << "</gazebo_log>\n";
 }
 
+/////////////////////////////////////////////////
+void LogCommand::Export(const std::string &_outFilename,
+    const std::string &_filter, const double _hz)
+{
+  gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
+  if (!play->IsOpen())
+  {
+    std::cerr << "No source log file specified. Use the -f command line "
+      << "argument.\n";
+    return;
+  }
+
+  // Rows are written to a new file when one of these limits is reached.
+  const size_t maxRows = 100000;
+  const size_t maxValues = 32 * 1024 * 1024;
+
+  boost::filesystem::path outPath(_outFilename);
+  const boost::filesystem::path stem = outPath.parent_path() / outPath.stem();
+
+  StateFilter filter(false, "", _hz);
+  filter.Init(_filter);
+
+  // The columns of the current file. A column that is missing from a row
+  // holds NaN.
+  std::map<std::string, std::vector<double>> columns;
+  std::vector<double> simTimes;
+  size_t values = 0;
+  unsigned int fileCount = 0;
+  bool ok = true;
+
+  auto flush = [&]()
+  {
+    if (simTimes.empty() || !ok)
+      return;
+
+    std::ostringstream filename;
+    filename << stem.string() << "_" << std::setfill('0') << std::setw(5)
+      << fileCount++ << ".npz";
+
+    NpzWriter writer(filename.str());
+    if (!writer.IsOpen())
+    {
+      std::cerr << "Unable to open file[" << filename.str()
+        << "] for writing.\n";
+      ok = false;
+      return;
+    }
+
+    writer.Write("sim_time", simTimes);
+    for (auto &column : columns)
+    {
+      column.second.resize(simTimes.size(),
+          std::numeric_limits<double>::quiet_NaN());
+      writer.Write(column.first, column.second);
+    }
+
+    columns.clear();
+    simTimes.clear();
+    values = 0;
+  };
+
+  this->FilterLog<ExportRow>(filter, nullptr,
+      [&](gazebo::physics::WorldState &_state)
+      {
+        ExportRow row;
+        row.emplace_back("sim_time", _state.GetSimTime().Double());
+
+        // The filter has already removed the models, links and joints that
+        // are not selected.
+        for (const auto &model : _state.GetModelStates())
+          exportModel(model.first, model.second, row);
+
+        return row;
+      },
+      [&](ExportRow &_row)
+      {
+        if (!ok || _row.empty())
+          return;
+
+        simTimes.push_back(_row.front().second);
+        for (size_t i = 1; i < _row.size(); ++i)
+        {
+          std::vector<double> &column = columns[_row[i].first];
+          column.resize(simTimes.size() - 1,
+              std::numeric_limits<double>::quiet_NaN());
+          column.push_back(_row[i].second);
+        }
+
+        values += _row.size();
+        if (simTimes.size() >= maxRows || values >= maxValues)
+          flush();
+      });
+
+  flush();
+}
+
 /////////////////////////////////////////////////
 void LogCommand::Step(const std::string &_filter, bool _raw,
     const std::string &_stamp, double _hz)
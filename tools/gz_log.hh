@@ -17,12 +17,15 @@
 #ifndef GAZEBO_TOOLS_GZLOG_HH_
 #define GAZEBO_TOOLS_GZLOG_HH_
 
+#include <functional>
 #include <string>
 #include <list>
 
 #include <gazebo/physics/WorldState.hh>
 #include "gz.hh"
 
+class TiXmlElement;
+
 namespace gazebo
 {
   /// \brief Base class for all filters.
@@ -148,6 +151,11 @@ namespace gazebo
     /// \return Filtered string.
     public: std::string Filter(gazebo::physics::WorldState &_state);
 
+    /// \brief Remove the elements that are not used by the filter from the
+    /// XML of a World state, so that they are not parsed.
+    /// \param[in] _state The <state> element.
+    public: void Project(TiXmlElement *_state) const;
+
     /// \brief The list of model parts to filter.
     public: std::list<std::string> parts;
 
@@ -177,9 +185,31 @@ namespace gazebo
     /// \return Filtered string
     public: std::string Filter(const std::string &_stateString);
 
+    /// \brief Parse a state. Only the models, links and joints used by
+    /// the filter are loaded. This function can be called concurrently.
+    /// \param[in] _stateString The state to parse.
+    /// \param[in] _sdf State element to parse into.
+    /// \param[out] _state The parsed state.
+    public: void Load(const std::string &_stateString, sdf::ElementPtr _sdf,
+                gazebo::physics::WorldState &_state) const;
+
+    /// \brief Format a parsed state, without applying the Hz rate. This
+    /// function can be called concurrently.
+    /// \param[in] _state The state to format.
+    /// \return Filtered string
+    public: std::string Format(gazebo::physics::WorldState &_state);
+
+    /// \brief Apply the Hz rate. States must be given in log order.
+    /// \param[in] _simTime Simulation time of a state.
+    /// \return True if the state should be output.
+    public: bool Accept(const gazebo::common::Time &_simTime);
+
     /// \brief Filter for a model.
     private: ModelFilter filter;
 
+    /// \brief True to remove the unused parts of a state before parsing it.
+    private: bool project = false;
+
     /// \brief Rate at which to output states.
     private: double hz;
 
@@ -240,6 +270,33 @@ namespace gazebo
     private: void Step(const std::string &_filter, bool _raw,
                  const std::string &_stamp, double _hz);
 
+    /// \brief Export the link and joint states selected by a filter to
+    /// NumPy .npz files, with one column per field.
+    /// \param[in] _outFilename Output filename. The rows are split into
+    /// several files, named <stem>_00000.npz, <stem>_00001.npz...
+    /// \param[in] _filter Filter string
+    /// \param[in] _hz Hertz rate.
+    private: void Export(const std::string &_outFilename,
+                 const std::string &_filter, const double _hz);
+
+    /// \brief Process all the states of the open log file. Chunks are
+    /// decompressed and converted in parallel, a batch at a time, and the
+    /// output is in log order.
+    /// \param[in] _filter Filter that parses the states and applies the Hz
+    /// rate.
+    /// \param[in] _world Function called with the world description, can
+    /// be empty.
+    /// \param[in] _convert Function that converts a state. It is called
+    /// concurrently from several threads.
+    /// \param[in] _output Function called with every converted state that
+    /// is not skipped by the Hz rate, in log order.
+    private: template<typename T>
+             void FilterLog(StateFilter &_filter,
+                 const std::function<void (const std::string &)> &_world,
+                 const std::function<T (gazebo::physics::WorldState &)>
+                 &_convert,
+                 const std::function<void (T &)> &_output);
+
     /// \brief Start or stop logging
     /// \param[in] _start True to start logging
     private: void Record(bool _start);
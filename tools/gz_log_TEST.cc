@@ -24,6 +24,9 @@
 #include <sdf/sdf_config.h>
 
 #include <stdio.h>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <string>
 
 // This header file isn't needed if shasums are used
@@ -474,6 +477,53 @@ TEST(gz_log, Output)
 #endif
 }
 
+/////////////////////////////////////////////////
+/// Check that 'gz log --export npz' writes the selected states as arrays
+TEST(gz_log, ExportNpz)
+{
+#ifndef _WIN32
+  std::ostringstream stem;
+  stem << "/tmp/__gz_log_export_test" << std::this_thread::get_id();
+
+  custom_exec(std::string(GZ_LOG_PATH + " --export npz --filter pr2 -o ") +
+      stem.str() + ".npz -f " + PROJECT_SOURCE_PATH +
+      "/test/data/pr2_state.log");
+
+  const std::string filename = stem.str() + "_00000.npz";
+  std::ifstream file(filename, std::ios::binary);
+  ASSERT_TRUE(file.is_open());
+  std::string data((std::istreambuf_iterator<char>(file)),
+      std::istreambuf_iterator<char>());
+  file.close();
+  std::remove(filename.c_str());
+
+  // A zip archive of .npy files
+  EXPECT_EQ(0u, data.find("PK\x03\x04"));
+  EXPECT_NE(std::string::npos, data.find("pr2.pose.x.npy"));
+  EXPECT_NE(std::string::npos, data.find("pr2::base_footprint.pose.x.npy"));
+  EXPECT_EQ(std::string::npos, data.find("ground_plane"));
+
+  // The first array is the sim time of every state
+  auto npy = data.find("sim_time.npy");
+  ASSERT_NE(std::string::npos, npy);
+  npy = data.find("\x93NUMPY", npy);
+  ASSERT_NE(std::string::npos, npy);
+
+  const uint16_t headerSize =
+    static_cast<unsigned char>(data[npy + 8]) |
+    static_cast<unsigned char>(data[npy + 9]) << 8;
+  const std::string header = data.substr(npy + 10, headerSize);
+  EXPECT_NE(std::string::npos, header.find("f8'"));
+  EXPECT_NE(std::string::npos, header.find("'shape': (2,)"));
+  EXPECT_EQ(0u, (10u + headerSize) % 64u);
+
+  double simTimes[2];
+  memcpy(simTimes, data.data() + npy + 10 + headerSize, sizeof(simTimes));
+  EXPECT_NEAR(0.021344, simTimes[0], 1e-6);
+  EXPECT_NEAR(0.028958, simTimes[1], 1e-6);
+#endif
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
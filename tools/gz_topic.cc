@@ -16,11 +16,16 @@
 */
 #include <google/protobuf/text_format.h>
 
+#include <algorithm>
+#include <memory>
+
 #include <gazebo/gui/qt.h>
 #include <gazebo/gui/TopicSelector.hh>
 #include <gazebo/gui/viewers/TopicView.hh>
 #include <gazebo/gui/viewers/ViewFactory.hh>
 #include <gazebo/gazebo_client.hh>
+#include <gazebo/util/LogTopicCodec.hh>
+#include <gazebo/util/TopicBag.hh>
 
 #include "gz_topic.hh"
 
@@ -54,9 +59,18 @@ TopicCommand::TopicCommand()
     ("bw,b", po::value<std::string>(), "Get topic bandwidth.")
     ("publish,p", po::value<std::string>(), "Publish message on a topic.")
     ("request,r", po::value<std::string>(), "Send a request.")
+    ("record", po::value<std::string>(), "Record the raw messages of the "
+     "topics given with --topic to a bag file.")
+    ("play", po::value<std::string>(), "Republish the messages of a bag "
+     "file.")
     ("unformatted,u", "Output data from echo without formatting.")
     ("duration,d", po::value<uint64_t>(), "Duration (seconds) to run. "
-     "Applicable with echo, hz, and bw")
+     "Applicable with echo, hz, bw and record")
+    ("topic,t", po::value<std::vector<std::string>>()->composing(),
+     "Topic to record, may be repeated. Applicable with record")
+    ("rate", po::value<double>()->default_value(1.0), "Playback rate, 1 is "
+     "the recorded rate and 0 publishes as fast as possible. Applicable with "
+     "play")
     ("msg,m", po::value<std::string>(), "Message to send on topic. "
      "Applicable with publish and request")
     ("file,f", po::value<std::string>(), "Path to a file containing the "
@@ -102,6 +116,10 @@ bool TopicCommand::RunImpl()
     this->Publish(this->vm["publish"].as<std::string>());
   else if (this->vm.count("request"))
     this->Request(worldName, this->vm["request"].as<std::string>());
+  else if (this->vm.count("record"))
+    this->Record(this->vm["record"].as<std::string>());
+  else if (this->vm.count("play"))
+    this->Play(this->vm["play"].as<std::string>());
   else
     this->Help();
 
@@ -230,6 +248,161 @@ void TopicCommand::Echo(const std::string &_topic)
     this->sigCondition.wait(lock);
 }
 
+/////////////////////////////////////////////////
+/// \brief Records the raw messages of a topic.
+class TopicRecorder
+{
+  /// \brief Constructor.
+  /// \param[in] _bag Bag to record to.
+  /// \param[in] _topic Index of the topic in the bag.
+  public: TopicRecorder(util::TopicBagWriter &_bag, const uint32_t _topic)
+          : bag(_bag), topic(_topic)
+  {
+  }
+
+  /// \brief Record a message, without parsing it.
+  /// \param[in] _data Serialized message.
+  public: void OnData(const std::string &_data)
+  {
+    this->bag.Write(this->topic, common::Time::GetWallTime(), _data);
+  }
+
+  /// \brief Bag to record to.
+  private: util::TopicBagWriter &bag;
+
+  /// \brief Index of the topic in the bag.
+  private: uint32_t topic;
+};
+
+/////////////////////////////////////////////////
+bool TopicCommand::Record(const std::string &_filename)
+{
+  if (!this->vm.count("topic"))
+  {
+    std::cerr << "Error: Missing topics to record, use --topic.\n";
+    return false;
+  }
+
+  util::TopicBagWriter bag;
+  if (!bag.Open(_filename))
+    return false;
+
+  std::vector<std::unique_ptr<TopicRecorder>> recorders;
+  std::vector<transport::SubscriberPtr> subs;
+  for (const auto &topic : this->vm["topic"].as<std::vector<std::string>>())
+  {
+    const std::string topicName = this->node->DecodeTopicName(topic);
+    const std::string msgTypeName =
+      gazebo::transport::getTopicMsgType(topicName);
+    if (msgTypeName.empty())
+    {
+      gzerr << "Unable to get message type for topic[" << topic << "]\n";
+      continue;
+    }
+
+    recorders.emplace_back(
+        new TopicRecorder(bag, bag.AddTopic(topicName, msgTypeName)));
+    subs.push_back(this->node->Subscribe(topicName, &TopicRecorder::OnData,
+          recorders.back().get()));
+  }
+
+  if (subs.empty())
+    return false;
+
+  {
+    boost::mutex::scoped_lock lock(this->sigMutex);
+    if (this->vm.count("duration"))
+      this->sigCondition.timed_wait(lock,
+          boost::posix_time::seconds(this->vm["duration"].as<uint64_t>()));
+    else
+      this->sigCondition.wait(lock);
+  }
+
+  // Stop the callbacks before the index is written
+  subs.clear();
+  std::cout << "Recorded " << bag.FrameCount() << " messages to ["
+            << _filename << "]\n";
+  return bag.Close();
+}
+
+/////////////////////////////////////////////////
+bool TopicCommand::Play(const std::string &_filename)
+{
+  util::TopicBagReader bag;
+  if (!bag.Open(_filename))
+    return false;
+
+  // Publishers and messages of the topics. Publishers only take messages,
+  // so the frames are parsed again before being published. Topics
+  // recorded next to a state log are decoded first.
+  std::vector<transport::PublisherPtr> pubs;
+  std::vector<boost::shared_ptr<google::protobuf::Message>> messages;
+  std::vector<std::unique_ptr<util::LogTopicCodec>> codecs;
+  for (const auto &topic : bag.Topics())
+  {
+    std::string type, encoding;
+    util::LogTopicCodec::ParseBagType(topic.type, type, encoding);
+    codecs.emplace_back(new util::LogTopicCodec(type, encoding));
+    messages.push_back(msgs::MsgFactory::NewMsg(type));
+    if (messages.back())
+      pubs.push_back(this->node->Advertise(topic.name, type));
+    else
+    {
+      std::cerr << "Unable to create message of type[" << type
+                << "], topic[" << topic.name << "] is skipped.\n";
+      pubs.push_back(transport::PublisherPtr());
+    }
+  }
+
+  const double rate = std::max(this->vm["rate"].as<double>(), 0.0);
+  util::TopicBagFrame frame;
+  if (!bag.Frame(0, frame))
+    return true;
+  const common::Time firstStamp = frame.stamp;
+  const common::Time start = common::Time::GetWallTime();
+
+  for (uint64_t i = 0; i < bag.FrameCount(); ++i)
+  {
+    if (!bag.Frame(i, frame) || frame.topic >= pubs.size() ||
+        !pubs[frame.topic])
+    {
+      continue;
+    }
+
+    // Wait for the time of the message, scaled by the rate. A signal stops
+    // the playback.
+    if (rate > 0)
+    {
+      const common::Time target =
+        start + common::Time((frame.stamp - firstStamp).Double() / rate);
+      const common::Time wait = target - common::Time::GetWallTime();
+      if (wait > common::Time::Zero)
+      {
+        boost::mutex::scoped_lock lock(this->sigMutex);
+        if (this->sigCondition.timed_wait(lock,
+              boost::posix_time::microseconds(
+                static_cast<int64_t>(wait.Double() * 1e6))))
+        {
+          break;
+        }
+      }
+    }
+
+    auto &msg = messages[frame.topic];
+    std::string data;
+    if (!codecs[frame.topic]->Decode(std::string(frame.data, frame.size),
+          data) || !msg->ParseFromString(data))
+    {
+      std::cerr << "Unable to parse message " << i << " of topic["
+                << bag.Topics()[frame.topic].name << "]\n";
+      continue;
+    }
+    pubs[frame.topic]->Publish(*msg);
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 void TopicCommand::HzCB(const std::string &/*_data*/)
 {
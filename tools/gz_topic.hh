@@ -89,6 +89,18 @@ namespace gazebo
     private: bool Request(const std::string &_space,
                      const std::string &_requestType);
 
+    /// \brief Record the raw messages of the topics given with --topic,
+    /// until the duration elapses or the command is interrupted.
+    /// \param[in] _filename Path of the bag to create.
+    /// \return True on success
+    private: bool Record(const std::string &_filename);
+
+    /// \brief Republish the messages of a bag at the rate given with
+    /// --rate.
+    /// \param[in] _filename Path of the bag.
+    /// \return True on success
+    private: bool Play(const std::string &_filename);
+
     /// \brief Message used to hold data received from EchoCB().
     private: boost::shared_ptr<google::protobuf::Message> echoMsg;
 